@@ -170,6 +170,18 @@ if (WITH_ARM_DOTPROD)
     add_definitions("-DWITH_ARM_DOTPROD")
 endif()
 
+if (WITH_ARM_I8MM)
+    add_definitions("-DWITH_ARM_I8MM")
+endif()
+
+if (WITH_ARM_BF16)
+    add_definitions("-DWITH_ARM_BF16")
+endif()
+
+if (WITH_ARM_SVE)
+    add_definitions("-DWITH_ARM_SVE")
+endif()
+
 if (LITE_WITH_NPU)
     add_definitions("-DLITE_WITH_NPU")
 endif()
@@ -182,6 +194,10 @@ if (LITE_WITH_OPENCL)
     add_definitions("-DLITE_WITH_OPENCL")
 endif()
 
+if (LITE_WITH_VULKAN)
+    add_definitions("-DLITE_WITH_VULKAN")
+endif()
+
 if (LITE_WITH_METAL)
     find_library(METAL_LIBRARY Metal REQUIRED)
     find_library(GRAPHIC CoreGraphics REQUIRED)
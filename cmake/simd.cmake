@@ -16,6 +16,8 @@ if(CMAKE_COMPILER_IS_GNUCC OR CMAKE_COMPILER_IS_GNUCXX OR CMAKE_CXX_COMPILER_ID
     set(AVX_FLAG "-mavx")
     set(AVX2_FLAG "-mavx2")
     set(AVX512F_FLAG "-mavx512f")
+    set(AVX512VNNI_FLAG "-mavx512f -mavx512bw -mavx512vl -mavx512vnni")
+    set(AMX_FLAG "-mamx-tile -mamx-int8 -mamx-bf16")
 elseif(MSVC)
     set(MMX_FLAG "/arch:MMX")
     set(SSE2_FLAG "/arch:SSE2")
@@ -114,8 +116,30 @@ int main()
     return 0;
 }" AVX512F_FOUND)
 
+# Check AVX512VNNI, only compiled since the kernels are dispatched at runtime
+set(CMAKE_REQUIRED_FLAGS ${AVX512VNNI_FLAG})
+CHECK_CXX_SOURCE_COMPILES("
+#include <immintrin.h>
+int main()
+{
+    __m256i a = _mm256_set1_epi32(1);
+    __m256i result = _mm256_dpbusd_epi32(a, a, a);
+    return 0;
+}" AVX512VNNI_FOUND)
+
+# Check AMX, only compiled since the kernels are dispatched at runtime
+set(CMAKE_REQUIRED_FLAGS ${AMX_FLAG})
+CHECK_CXX_SOURCE_COMPILES("
+#include <immintrin.h>
+int main()
+{
+    _tile_zero(0);
+    _tile_release();
+    return 0;
+}" AMX_FOUND)
+
 set(CMAKE_REQUIRED_FLAGS ${CMAKE_REQUIRED_FLAGS_RETAINED})
-mark_as_advanced(MMX_FOUND SSE2_FOUND SSE3_FOUND AVX_FOUND AVX2_FOUND AVX512F_FOUND)
+mark_as_advanced(MMX_FOUND SSE2_FOUND SSE3_FOUND AVX_FOUND AVX2_FOUND AVX512F_FOUND AVX512VNNI_FOUND AMX_FOUND)
 
 if(WITH_AVX AND AVX_FOUND)
     add_definitions(-DLITE_WITH_AVX)
@@ -208,6 +208,48 @@ Java_com_baidu_paddle_lite_Tensor_getLongData(JNIEnv *env, jobject jtensor) {
   }
 }
 
+JNIEXPORT jboolean JNICALL
+Java_com_baidu_paddle_lite_Tensor_nativeShareDirectBuffer(JNIEnv *env,
+                                                          jobject jtensor,
+                                                          jobject buf,
+                                                          jint precision) {
+  std::unique_ptr<Tensor> *tensor = get_writable_tensor_pointer(env, jtensor);
+  if (tensor == nullptr || (*tensor == nullptr)) {
+    return JNI_FALSE;
+  }
+  void *data = env->GetDirectBufferAddress(buf);
+  if (data == nullptr) {
+    return JNI_FALSE;
+  }
+  PrecisionType type = static_cast<PrecisionType>(precision);
+  int64_t size = product((*tensor)->shape()) * PrecisionTypeLength(type);
+  if (size <= 0 || env->GetDirectBufferCapacity(buf) < size) {
+    return JNI_FALSE;
+  }
+
+  (*tensor)->ShareExternalMemory(data, size, TargetType::kHost);
+  (*tensor)->SetPrecision(type);
+  return JNI_TRUE;
+}
+
+JNIEXPORT jobject JNICALL
+Java_com_baidu_paddle_lite_Tensor_nativeGetDirectBuffer(JNIEnv *env,
+                                                        jobject jtensor) {
+  const Tensor *tensor = nullptr;
+  if (is_const_tensor(env, jtensor)) {
+    tensor = get_read_only_tensor_pointer(env, jtensor)->get();
+  } else {
+    tensor = get_writable_tensor_pointer(env, jtensor)->get();
+  }
+  if (tensor == nullptr || !tensor->IsInitialized()) {
+    return nullptr;
+  }
+  int64_t size =
+      product(tensor->shape()) * PrecisionTypeLength(tensor->precision());
+  void *data = const_cast<int8_t *>(tensor->data<int8_t>());
+  return env->NewDirectByteBuffer(data, size);
+}
+
 JNIEXPORT jboolean JNICALL Java_com_baidu_paddle_lite_Tensor_deleteCppTensor(
     JNIEnv *env, jobject jtensor, jlong java_pointer) {
   if (java_pointer == 0) {
@@ -105,6 +105,25 @@ JNIEXPORT jboolean JNICALL Java_com_baidu_paddle_lite_Tensor_nativeSetData___3I(
 JNIEXPORT jboolean JNICALL Java_com_baidu_paddle_lite_Tensor_nativeSetData___3L(
     JNIEnv *, jobject, jlongArray);
 
+/*
+ * Class:     com_baidu_paddle_lite_Tensor
+ * Method:    nativeShareDirectBuffer
+ * Signature: (Ljava/nio/ByteBuffer;I)Z
+ */
+JNIEXPORT jboolean JNICALL
+Java_com_baidu_paddle_lite_Tensor_nativeShareDirectBuffer(JNIEnv *,
+                                                          jobject,
+                                                          jobject,
+                                                          jint);
+
+/*
+ * Class:     com_baidu_paddle_lite_Tensor
+ * Method:    nativeGetDirectBuffer
+ * Signature: ()Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL
+Java_com_baidu_paddle_lite_Tensor_nativeGetDirectBuffer(JNIEnv *, jobject);
+
 /*
  * Class:     com_baidu_paddle_lite_Tensor
  * Method:    deleteCppTensor
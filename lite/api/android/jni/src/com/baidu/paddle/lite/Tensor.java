@@ -13,6 +13,9 @@ limitations under the License. */
 
 package com.baidu.paddle.lite;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
 /**
  * Tensor class provides the Java APIs that users can get or set the shape or
  * the data of a Tensor.
@@ -43,6 +46,12 @@ public class Tensor {
      */
     private PaddlePredictor predictor;
 
+    /**
+     * The direct buffer shared by {@link #setData(ByteBuffer)}, referenced here
+     * so that it is not collected while the C++ Tensor uses its memory.
+     */
+    private ByteBuffer sharedBuffer;
+
     /**
      * Accessed by package only to prevent public users to create it wrongly. A
      * Tensor can be created by {@link com.baidu.paddle.lite.PaddlePredictor} only
@@ -121,6 +130,56 @@ public class Tensor {
         return nativeSetData(buf);
     }
 
+    /**
+     * Share a direct buffer of float data with the tensor without copying.
+     *
+     * @param buf the direct buffer, see {@link #setData(ByteBuffer, Place.PrecisionType)}.
+     * @return true if set data successfully.
+     */
+    public boolean setData(ByteBuffer buf) {
+        return setData(buf, Place.PrecisionType.FLOAT);
+    }
+
+    /**
+     * Share a direct buffer with the tensor without copying, e.g. a camera
+     * frame. The buffer is used by the following runs, so it should not be
+     * changed while the predictor is running. The data should be in the native
+     * byte order, see {@link ByteOrder#nativeOrder()}.
+     *
+     * @param buf       the direct buffer which holds at least the elements of the
+     *                  shape of the tensor, so resize the tensor first.
+     * @param precision the data type of the elements.
+     * @return true if set data successfully.
+     */
+    public boolean setData(ByteBuffer buf, Place.PrecisionType precision) {
+        if (readOnly || buf == null || !buf.isDirect()) {
+            return false;
+        }
+        if (!nativeShareDirectBuffer(buf, precision.value)) {
+            return false;
+        }
+        sharedBuffer = buf;
+        return true;
+    }
+
+    /**
+     * Get the data of the tensor as a direct buffer over its memory without
+     * copying. The buffer is read-only for a read-only tensor, e.g. an output,
+     * and is only valid until the next run of the predictor, so copy the data
+     * to keep it.
+     *
+     * @return the direct buffer in the native byte order, or null if the tensor
+     *         holds no data.
+     */
+    public ByteBuffer getDirectBuffer() {
+        ByteBuffer buf = nativeGetDirectBuffer();
+        if (buf == null) {
+            return null;
+        }
+        buf.order(ByteOrder.nativeOrder());
+        return readOnly ? buf.asReadOnlyBuffer().order(ByteOrder.nativeOrder()) : buf;
+    }
+
     /**
      * @return shape of the tensor as long array.
      */
@@ -156,6 +215,10 @@ public class Tensor {
 
     private native boolean nativeSetData(long[] buf);
 
+    private native boolean nativeShareDirectBuffer(ByteBuffer buf, int precision);
+
+    private native ByteBuffer nativeGetDirectBuffer();
+
     /**
      * Delete C++ Tenor object pointed by the input pointer, which is presented by a
      * long value.
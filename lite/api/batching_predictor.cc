@@ -0,0 +1,288 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/batching_predictor.h"
+#include <algorithm>
+#include <chrono>  //NOLINT
+#include <cstring>
+#include <utility>
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite_api {
+
+namespace {
+
+size_t ElementSize(PrecisionType precision) {
+  if (precision == PrecisionType::kBool) return sizeof(bool);
+  size_t size = PrecisionTypeLength(precision);
+  CHECK_GT(size, 0u) << "Unsupported precision "
+                     << static_cast<int>(precision) << " in batching";
+  return size;
+}
+
+// The bytes of the elements in one row along dim 0.
+size_t RowBytes(const shape_t& shape, PrecisionType precision) {
+  CHECK(!shape.empty()) << "The tensors to batch must have dim 0";
+  size_t bytes = ElementSize(precision);
+  for (size_t i = 1; i < shape.size(); i++) {
+    bytes *= shape[i];
+  }
+  return bytes;
+}
+
+void* MutableData(Tensor* tensor, PrecisionType precision) {
+  switch (precision) {
+    case PrecisionType::kFloat:
+      return tensor->mutable_data<float>();
+    case PrecisionType::kFP64:
+      return tensor->mutable_data<double>();
+    case PrecisionType::kInt64:
+      return tensor->mutable_data<int64_t>();
+    case PrecisionType::kInt32:
+      return tensor->mutable_data<int32_t>();
+    case PrecisionType::kInt16:
+      return tensor->mutable_data<int16_t>();
+    case PrecisionType::kInt8:
+      return tensor->mutable_data<int8_t>();
+    case PrecisionType::kUInt8:
+      return tensor->mutable_data<uint8_t>();
+    case PrecisionType::kBool:
+      return tensor->mutable_data<bool>();
+    default:
+      LOG(FATAL) << "Unsupported precision " << static_cast<int>(precision)
+                 << " in batching";
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+BatchingPredictor::BatchingPredictor(
+    const std::shared_ptr<PaddlePredictor>& predictor,
+    const BatchingConfig& config)
+    : predictor_(predictor), config_(config) {
+  CHECK(predictor_) << "The predictor to batch can not be nullptr";
+  CHECK_GT(config_.max_batch_size, 0);
+  CHECK_GE(config_.max_wait_us, 0);
+  worker_ = std::thread(&BatchingPredictor::Loop, this);
+}
+
+BatchingPredictor::~BatchingPredictor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  worker_.join();
+}
+
+std::future<std::vector<BatchTensor>> BatchingPredictor::Submit(
+    std::vector<BatchTensor> inputs) {
+  for (auto& input : inputs) {
+    CHECK_EQ(input.data.size(),
+             RowBytes(input.shape, input.precision) * input.shape[0])
+        << "The data size mismatches the shape";
+    for (auto& level : input.lod) {
+      CHECK(!level.empty()) << "The levels of LoD can not be empty";
+    }
+    if (!input.lod.empty()) {
+      CHECK_EQ(input.lod.back().back(), static_cast<uint64_t>(input.shape[0]))
+          << "The last level of LoD mismatches dim 0";
+    }
+  }
+  std::unique_ptr<Request> request(new Request);
+  request->inputs = std::move(inputs);
+  auto future = request->outputs.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK(!stop_) << "Submit to a destroyed BatchingPredictor";
+    queue_.push_back(std::move(request));
+  }
+  cv_.notify_one();
+  return future;
+}
+
+bool BatchingPredictor::Mergeable(const Request& a, const Request& b) const {
+  if (a.inputs.size() != b.inputs.size()) return false;
+  for (size_t i = 0; i < a.inputs.size(); i++) {
+    auto& x = a.inputs[i];
+    auto& y = b.inputs[i];
+    if (x.precision != y.precision || x.lod.size() != y.lod.size() ||
+        x.shape.size() != y.shape.size() ||
+        !std::equal(x.shape.begin() + 1, x.shape.end(), y.shape.begin() + 1)) {
+      return false;
+    }
+    // The outputs without LoD are split evenly.
+    if (x.lod.empty() && x.shape[0] != y.shape[0]) return false;
+  }
+  return true;
+}
+
+void BatchingPredictor::Loop() {
+  const size_t max_batch_size = config_.max_batch_size;
+  while (true) {
+    std::vector<std::unique_ptr<Request>> batch;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) return;
+      auto deadline = std::chrono::steady_clock::now() +
+                      std::chrono::microseconds(config_.max_wait_us);
+      cv_.wait_until(lock, deadline, [&] {
+        return stop_ || queue_.size() >= max_batch_size;
+      });
+      // Take the oldest request and the mergeable ones in arrival order.
+      batch.push_back(std::move(queue_.front()));
+      queue_.pop_front();
+      for (auto it = queue_.begin();
+           it != queue_.end() && batch.size() < max_batch_size;) {
+        if (Mergeable(*batch.front(), **it)) {
+          batch.push_back(std::move(*it));
+          it = queue_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+    RunBatch(&batch);
+  }
+}
+
+void BatchingPredictor::RunBatch(
+    std::vector<std::unique_ptr<Request>>* batch) {
+  std::vector<std::vector<BatchTensor>> outputs;
+#ifdef LITE_WITH_EXCEPTION
+  bool merged = false;
+  try {
+    merged = RunMerged(*batch, &outputs);
+  } catch (...) {
+    for (auto& request : *batch) {
+      request->outputs.set_exception(std::current_exception());
+    }
+    return;
+  }
+#else
+  bool merged = RunMerged(*batch, &outputs);
+#endif
+  if (!merged) {
+    // The outputs can't be split back, run the requests one by one.
+    for (auto& request : *batch) {
+      std::vector<std::unique_ptr<Request>> single;
+      single.push_back(std::move(request));
+      RunBatch(&single);
+    }
+    return;
+  }
+  for (size_t r = 0; r < batch->size(); r++) {
+    (*batch)[r]->outputs.set_value(std::move(outputs[r]));
+  }
+}
+
+bool BatchingPredictor::RunMerged(
+    const std::vector<std::unique_ptr<Request>>& batch,
+    std::vector<std::vector<BatchTensor>>* outputs) {
+  const size_t batch_size = batch.size();
+  auto& first = batch.front()->inputs;
+  // The level-0 LoD offsets of the requests in the merged sequences, by the
+  // first input with LoD.
+  std::vector<uint64_t> seq_offsets(1, 0);
+  // Whether all the requests have the same rows, so the outputs without LoD
+  // can be split evenly.
+  bool same_rows = true;
+  for (size_t i = 0; i < first.size(); i++) {
+    shape_t shape = first[i].shape;
+    shape[0] = 0;
+    // The offsets of each level are shifted by the number of the entries
+    // of the level accumulated so far.
+    lod_t lod(first[i].lod.size(), std::vector<uint64_t>(1, 0));
+    for (auto& request : batch) {
+      auto& input = request->inputs[i];
+      shape[0] += input.shape[0];
+      same_rows = same_rows && input.shape[0] == first[i].shape[0];
+      for (size_t level = 0; level < lod.size(); level++) {
+        uint64_t base = lod[level].back();
+        for (size_t k = 1; k < input.lod[level].size(); k++) {
+          lod[level].push_back(base + input.lod[level][k]);
+        }
+      }
+      if (!lod.empty() && seq_offsets.size() <= batch_size) {
+        seq_offsets.push_back(lod.front().size() - 1);
+      }
+    }
+    auto tensor = predictor_->GetInput(i);
+    tensor->Resize(shape);
+    auto* dst =
+        static_cast<uint8_t*>(MutableData(tensor.get(), first[i].precision));
+    for (auto& request : batch) {
+      auto& data = request->inputs[i].data;
+      if (!data.empty()) std::memcpy(dst, data.data(), data.size());
+      dst += data.size();
+    }
+    tensor->SetLoD(lod);
+  }
+
+  predictor_->Run();
+
+  outputs->assign(batch_size, std::vector<BatchTensor>());
+  const size_t output_size = predictor_->GetOutputNames().size();
+  for (size_t j = 0; j < output_size; j++) {
+    auto tensor = predictor_->GetOutput(j);
+    auto shape = tensor->shape();
+    auto precision = tensor->precision();
+    auto lod = tensor->lod();
+    size_t row_bytes = RowBytes(shape, precision);
+    auto* src = static_cast<const uint8_t*>(tensor->data<void>());
+    bool split_by_lod = !lod.empty() && seq_offsets.size() == batch_size + 1 &&
+                        lod.front().size() == seq_offsets.back() + 1;
+    if (!split_by_lod &&
+        (!same_rows || shape[0] % static_cast<int64_t>(batch_size) != 0)) {
+      VLOG(3) << "Can not split the output " << j << " with dim 0 "
+              << shape[0] << " into " << batch_size << " requests";
+      return false;
+    }
+    for (size_t r = 0; r < batch_size; r++) {
+      BatchTensor output;
+      output.precision = precision;
+      output.shape = shape;
+      uint64_t begin = r;
+      uint64_t end = r + 1;
+      if (split_by_lod) {
+        // Narrow the sequences of the request down the levels until it
+        // indexes the rows.
+        begin = seq_offsets[r];
+        end = seq_offsets[r + 1];
+        output.lod.resize(lod.size());
+        for (size_t level = 0; level < lod.size(); level++) {
+          for (uint64_t k = begin; k <= end; k++) {
+            output.lod[level].push_back(lod[level][k] - lod[level][begin]);
+          }
+          begin = lod[level][begin];
+          end = lod[level][end];
+        }
+      } else {
+        uint64_t rows = shape[0] / batch_size;
+        begin *= rows;
+        end *= rows;
+      }
+      output.shape[0] = end - begin;
+      output.data.assign(src + begin * row_bytes, src + end * row_bytes);
+      (*outputs)[r].push_back(std::move(output));
+    }
+  }
+  return true;
+}
+
+}  // namespace lite_api
+}  // namespace paddle
@@ -0,0 +1,98 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * This file implements an optional dynamic batching layer on top of a
+ * PaddlePredictor. The single-sample requests submitted from many threads are
+ * merged along dim 0, run once, and the outputs are split back.
+ */
+#pragma once
+
+#include <condition_variable>  //NOLINT
+#include <cstdint>
+#include <deque>
+#include <future>  //NOLINT
+#include <memory>
+#include <mutex>   //NOLINT
+#include <thread>  //NOLINT
+#include <vector>
+#include "lite/api/paddle_api.h"
+
+namespace paddle {
+namespace lite_api {
+
+struct LITE_API BatchingConfig {
+  // The maximum number of requests merged into one Run().
+  int max_batch_size{8};
+  // The maximum time in microseconds the oldest request waits for the others
+  // before the batch is run.
+  int max_wait_us{1000};
+};
+
+// A host tensor owned by a request, `data` holds the elements in row-major
+// order, and `lod` is empty for the tensors without LoD.
+struct LITE_API BatchTensor {
+  shape_t shape;
+  PrecisionType precision{PrecisionType::kFloat};
+  lod_t lod;
+  std::vector<uint8_t> data;
+};
+
+/// The BatchingPredictor collects the requests until `max_batch_size` ones
+/// arrive or the oldest one waits `max_wait_us`, concatenates the inputs of
+/// the requests along dim 0 into the inputs of the predictor, and splits its
+/// outputs back to the requests. The outputs are split by the level-0 LoD if
+/// it has the sequences of the requests' inputs, otherwise evenly along dim
+/// 0, and the requests are run one by one if neither fits. Only the requests
+/// whose inputs have the same precisions, trailing dims and LoD levels, and
+/// the same dim 0 for the inputs without LoD, are merged, the others are left
+/// to the next batches. With LITE_WITH_EXCEPTION, the exception of a run is
+/// delivered to the futures of all the requests in the batch.
+/// The predictor must run on host and must not be used by others meanwhile.
+class LITE_API BatchingPredictor {
+ public:
+  explicit BatchingPredictor(
+      const std::shared_ptr<PaddlePredictor>& predictor,
+      const BatchingConfig& config = BatchingConfig());
+  // The pending requests are completed before the destruction.
+  ~BatchingPredictor();
+
+  /// Submit the inputs of one request in the order of GetInputNames(), the
+  /// future becomes ready with the outputs in the order of GetOutputNames().
+  std::future<std::vector<BatchTensor>> Submit(std::vector<BatchTensor> inputs);
+
+ private:
+  struct Request {
+    std::vector<BatchTensor> inputs;
+    std::promise<std::vector<BatchTensor>> outputs;
+  };
+
+  void Loop();
+  bool Mergeable(const Request& a, const Request& b) const;
+  void RunBatch(std::vector<std::unique_ptr<Request>>* batch);
+  // Returns false if the outputs can't be split back to the requests.
+  bool RunMerged(const std::vector<std::unique_ptr<Request>>& batch,
+                 std::vector<std::vector<BatchTensor>>* outputs);
+
+  std::shared_ptr<PaddlePredictor> predictor_;
+  BatchingConfig config_;
+  std::deque<std::unique_ptr<Request>> queue_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_{false};
+  std::thread worker_;
+};
+
+}  // namespace lite_api
+}  // namespace paddle
@@ -22,6 +22,10 @@
 #include <vector>
 
 #include "lite/api/paddle_use_passes.h"
+#include "lite/backends/host/memory_pool.h"
+#ifdef LITE_WITH_OPENCL
+#include "lite/backends/opencl/target_wrapper.h"
+#endif
 #include "lite/utils/io.h"
 
 namespace paddle {
@@ -72,7 +76,8 @@ bool IsQuantizedMode(const std::shared_ptr<cpp::ProgramDesc> &program_desc) {
 
 void Predictor::SaveModel(const std::string &dir,
                           lite_api::LiteModelType model_type,
-                          bool record_info) {
+                          bool record_info,
+                          bool compress_weights) {
   if (!program_) {
     GenRuntimeProgram();
   }
@@ -82,7 +87,10 @@ void Predictor::SaveModel(const std::string &dir,
       SaveModelPb(dir, *program_->exec_scope(), *program_desc_.get(), true);
       break;
     case lite_api::LiteModelType::kNaiveBuffer:
-      SaveModelNaive(dir, *program_->exec_scope(), *program_desc_.get());
+      SaveModelNaive(dir,
+                     *program_->exec_scope(),
+                     *program_desc_.get(),
+                     compress_weights);
       break;
     default:
       LOG(FATAL) << "Unknown model type";
@@ -176,7 +184,8 @@ lite::Tensor *Predictor::GetInput(size_t offset) {
   CHECK(input_names_.size() > offset)
       << "The network has " << input_names_.size() << " inputs"
       << ", the offset should be less than this.";
-  auto *in_var = exec_scope_->FindVar(input_names_[offset]);
+  auto *in_var = input_vars_[offset];
+  if (!in_var) in_var = exec_scope_->FindVar(input_names_[offset]);
   CHECK(in_var) << "no fatch variable " << input_names_[offset]
                 << " in exec_scope";
   return in_var->GetMutable<lite::Tensor>();
@@ -238,6 +247,16 @@ void Predictor::PrepareFeedFetch() {
     output_names_[fetchs[i]->GetAttr<int>("col")] =
         fetchs[i]->Input("X").front();
   }
+  // resolve the feed and fetch variables once instead of on every
+  // GetInput and GetOutput
+  input_vars_.resize(input_names_.size());
+  for (size_t i = 0; i < input_names_.size(); i++) {
+    input_vars_[i] = exec_scope_->FindVar(input_names_[i]);
+  }
+  output_vars_.resize(output_names_.size());
+  for (size_t i = 0; i < output_names_.size(); i++) {
+    output_vars_[i] = exec_scope_->FindVar(output_names_[i]);
+  }
   for (size_t i = 0; i < feeds.size(); i++) {
     input_precisions_[i] = GetInput(i)->precision();
   }
@@ -248,8 +267,9 @@ const lite::Tensor *Predictor::GetOutput(size_t offset) const {
   CHECK(output_names_.size() > offset)
       << "The network has " << output_names_.size() << " outputs"
       << ", the offset should be less than this.";
-  const std::string name = output_names_.at(offset);
-  auto *out_var = exec_scope_->FindVar(name);
+  const std::string &name = output_names_.at(offset);
+  auto *out_var = output_vars_[offset];
+  if (!out_var) out_var = exec_scope_->FindVar(name);
   CHECK(out_var) << "no fatch variable " << name << " in exec_scope";
   return out_var->GetMutable<lite::Tensor>();
 }
@@ -324,6 +344,9 @@ void Predictor::Build(const std::string &model_path,
                       lite_api::LiteModelType model_type,
                       const lite_api::CxxConfig &config,
                       const lite_api::CxxModelBuffer &model_buffer) {
+  auto &build_stats = ThreadBuildStats::Current();
+  uint64_t read_file_ns = build_stats.read_file_ns;
+  uint64_t start = MonotonicNanos();
   switch (model_type) {
     case lite_api::LiteModelType::kProtobuf: {
       bool combined_param = false;
@@ -347,6 +370,9 @@ void Predictor::Build(const std::string &model_path,
     default:
       LOG(FATAL) << "Unknown model type";
   }
+  cold_start_.read_file_ns = build_stats.read_file_ns - read_file_ns;
+  cold_start_.parse_ns =
+      MonotonicNanos() - start - cold_start_.read_file_ns;
   Build(program_desc_, valid_places, passes, config);
 }
 
@@ -363,7 +389,8 @@ void Predictor::Build(const std::shared_ptr<cpp::ProgramDesc> &program_desc,
         Place(TARGET(kHost), valid_place.precision, valid_place.layout));
   }
 
-  if (IsQuantizedMode(program_desc_)) {
+  // post_quant_static_pass quantizes the float model with the calib table
+  if (IsQuantizedMode(program_desc_) || !config.calib_table().empty()) {
     for (auto &valid_place : valid_places) {
       if (valid_place.target == TARGET(kARM)) {
         inner_places.insert(inner_places.begin(),
@@ -386,8 +413,16 @@ void Predictor::Build(const std::shared_ptr<cpp::ProgramDesc> &program_desc,
 
   exec_scope_ = program.exec_scope();
 
+  // The kernels are created by the graphs of the optimizer.
+  auto &build_stats = ThreadBuildStats::Current();
+  uint64_t create_kernels_ns = build_stats.create_kernels_ns;
+  uint64_t start = MonotonicNanos();
   program_ = RunDefaultOptimizer(
       std::move(program), inner_places, factor, passes, config);
+  cold_start_.create_kernels_ns =
+      build_stats.create_kernels_ns - create_kernels_ns;
+  cold_start_.optimize_ns =
+      MonotonicNanos() - start - cold_start_.create_kernels_ns;
 
   if (program_desc->HasVersion())
     program_->set_version(program_desc->Version());
@@ -527,6 +562,12 @@ bool Predictor::TryShrinkMemory() {
       continue;
     }
   }
+  program_->ReleaseMemoryArena();
+  host::MemoryPool::Global().Trim();
+#ifdef LITE_WITH_OPENCL
+  auto cl_memory_pool = CLMemoryPool::Current();
+  if (cl_memory_pool) cl_memory_pool->Trim();
+#endif
   return true;
 }
 
@@ -20,9 +20,15 @@
 #include <utility>
 #include <vector>
 #include "lite/api/paddle_api.h"
+#include "lite/core/adaptive_threads.h"
+#include "lite/core/io_binding.h"
+#include "lite/core/latency_estimator.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/optimizer/optimizer.h"
 #include "lite/core/program.h"
+#include "lite/core/runtime_stats.h"
+#include "lite/core/stream_states.h"
+#include "lite/core/thread_pool.h"
 #include "lite/core/types.h"
 #include "lite/model_parser/model_parser.h"
 
@@ -163,7 +169,10 @@ class LITE_API Predictor {
     if (!program_generated_) {
       GenRuntimeProgram();
     }
+    io_binding_.Apply();
+    stream_states_.Apply();
     CheckInputValid();
+    uint64_t start = MonotonicNanos();
 
 #ifdef LITE_WITH_XPU
     std::vector<std::vector<int64_t>> query_shape;
@@ -174,12 +183,17 @@ class LITE_API Predictor {
 #endif
 
     program_->Run();
+    io_binding_.Sync();
+    stream_states_.Sync();
 
 #ifdef LITE_WITH_XPU
     lite::TargetWrapperXPU::FreeL3Cache();
 #endif
 
     ClearTensorArray(program_desc_);
+    if (!cold_start_.first_run_ns) {
+      cold_start_.first_run_ns = MonotonicNanos() - start;
+    }
   }
 
 #ifdef LITE_WITH_METAL
@@ -199,6 +213,37 @@ class LITE_API Predictor {
   /// \return a boolean variable.
   bool TryShrinkMemory();
 
+  /// \brief Get the peak memory of the input-shape buckets planned in the
+  /// memory arena, which is enabled by LITE_MEMORY_ARENA.
+  std::vector<MemoryPlanStats> GetMemoryPlanStats() const {
+    CHECK(program_) << "The program is not generated";
+    return program_->memory_plan_stats();
+  }
+
+  /// \brief Fill the kernel runs, the peak arena and the cold start of the
+  /// predictor.
+  void CollectRuntimeStats(lite_api::RuntimeStats* stats) const {
+    CHECK(program_) << "The program is not generated";
+    program_->CollectRuntimeStats(stats);
+    stats->cold_start = cold_start_;
+  }
+
+  /// \brief Record the kernel latencies into `table`, see LatencyTable.
+  void SetLatencyTable(LatencyTable* table, int threads) {
+    CHECK(program_) << "The program is not generated";
+    program_->SetLatencyTable(table, threads);
+  }
+  double EstimateLatency(const LatencyTable& table,
+                         int threads,
+                         int* missing) {
+    CHECK(program_) << "The program is not generated";
+    return program_->EstimateLatency(table, threads, missing);
+  }
+  CostEstimate EstimateCost(const LatencyEstimator& estimator) {
+    CHECK(program_) << "The program is not generated";
+    return estimator.Estimate(program_.get());
+  }
+
   // Get offset-th col of feed inputs.
   lite::Tensor* GetInput(size_t offset);
   // get input by name.
@@ -216,6 +261,38 @@ class LITE_API Predictor {
 
   // Get offset-th col of fetch results.
   const lite::Tensor* GetOutput(size_t offset) const;
+  // Bind the caller-owned host buffers to the offset-th input and output,
+  // which are read and written in place by the following runs.
+  void BindInput(size_t offset,
+                 void* data,
+                 size_t memory_size,
+                 const DDim& dims,
+                 PrecisionType precision) {
+    io_binding_.BindInput(GetInput(offset), data, memory_size, dims, precision);
+  }
+  void BindOutput(size_t offset, void* data, size_t memory_size) {
+    CHECK_LT(offset, output_names_.size())
+        << "offset " << offset << " overflow";
+    io_binding_.BindOutput(
+        GetMutableTensor(output_names_[offset]), data, memory_size);
+  }
+  // Feed the state inputs by the state outputs of the previous run of the
+  // same stream, see StreamStates.
+  void SetStreamStates(const std::vector<std::string>& state_inputs,
+                       const std::vector<std::string>& state_outputs) {
+    CHECK_EQ(state_inputs.size(), state_outputs.size())
+        << "Every state input requires a state output";
+    stream_states_.Clear();
+    for (size_t i = 0; i < state_inputs.size(); i++) {
+      auto* input = GetMutableTensor(state_inputs[i]);
+      auto* output = GetMutableTensor(state_outputs[i]);
+      CHECK(input) << "No state input " << state_inputs[i];
+      CHECK(output) << "No state output " << state_outputs[i];
+      stream_states_.AddState(input, output);
+    }
+  }
+  StreamStates* stream_states() { return &stream_states_; }
+
   std::vector<const lite::Tensor*> GetOutputs() const;
 
   const cpp::ProgramDesc& program_desc() const;
@@ -230,7 +307,8 @@ class LITE_API Predictor {
   void SaveModel(
       const std::string& dir,
       lite_api::LiteModelType model_type = lite_api::LiteModelType::kProtobuf,
-      bool record_info = false);
+      bool record_info = false,
+      bool compress_weights = false);
   void SaveOpKernelInfo(const std::string& model_dir);
 
   /////////////////////////////////////////////////////////////////////////////
@@ -265,8 +343,14 @@ class LITE_API Predictor {
   bool program_generated_{false};
   std::vector<std::string> input_names_;
   std::vector<std::string> output_names_;
+  // the variables of input_names_ and output_names_ in the exec scope
+  std::vector<Variable*> input_vars_;
+  std::vector<Variable*> output_vars_;
   std::vector<Place> valid_places_;
   std::vector<PrecisionType> input_precisions_;
+  IoBinding io_binding_;
+  StreamStates stream_states_;
+  lite_api::RuntimeStats::ColdStartStats cold_start_;
 };
 
 class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
@@ -285,6 +369,19 @@ class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
 
   std::unique_ptr<lite_api::Tensor> GetInput(int i) override;
   std::unique_ptr<const lite_api::Tensor> GetOutput(int i) const override;
+  void BindInput(int i,
+                 void* data,
+                 size_t memory_size,
+                 const lite_api::shape_t& shape,
+                 PrecisionType precision) override;
+  void BindOutput(int i, void* data, size_t memory_size) override;
+  void SetStreamStates(const std::vector<std::string>& state_inputs,
+                       const std::vector<std::string>& state_outputs) override;
+  void SelectStream(int64_t id) override;
+  void ResetStream(int64_t id) override;
+  void ReleaseStream(int64_t id) override;
+  bool IsNNAdapterShapeReady(
+      const std::map<std::string, lite_api::shape_t>& input_shapes) override;
 
   std::unique_ptr<lite_api::Tensor> GetInputByName(
       const std::string& name) override;
@@ -299,12 +396,25 @@ class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
   ///
   /// \return a boolean variable.
   bool TryShrinkMemory() override;
+  lite_api::RuntimeStats GetRuntimeStats() override;
+  void StartOpLatencyRecording() override;
+  bool StopOpLatencyRecording(const std::string& path) override;
+  double EstimateLatency(const std::string& path,
+                         int* missing = nullptr) override;
+  /// \brief Estimate the latency and the peak memory of the program by
+  /// `estimator`, used by opt --estimate_latency.
+  CostEstimate EstimateCost(const LatencyEstimator& estimator) {
+    return raw_predictor_->EstimateCost(estimator);
+  }
 
   std::shared_ptr<lite_api::PaddlePredictor> Clone() override;
 
   std::shared_ptr<lite_api::PaddlePredictor> Clone(
       const std::vector<std::string>& var_names) override;
 
+  std::shared_ptr<lite_api::PaddlePredictor> CloneOnNumaNode(
+      int node) override;
+
   std::string GetVersion() const override;
 
   // get inputs names and get outputs names
@@ -330,6 +440,13 @@ class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
   lite_api::CxxConfig config_;
   std::mutex mutex_;
   bool status_is_cloned_;
+  // The thread pool used by the parallel kernels of this predictor.
+  std::shared_ptr<ThreadPool> thread_pool_;
+  // Adjusts the threads between the runs, null if disabled.
+  std::unique_ptr<AdaptiveThreads> adaptive_threads_;
+  std::unique_ptr<LatencyTable> latency_table_;
+  // Keeps the priority of this predictor registered.
+  std::shared_ptr<void> priority_handle_;
 };
 
 /*
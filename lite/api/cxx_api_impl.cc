@@ -13,15 +13,26 @@
 // limitations under the License.
 
 #include "lite/api/cxx_api.h"
+#include <algorithm>
 #include <memory>
 #include <mutex>  //NOLINT
 #include <string>
+#include <thread>  // NOLINT
+#include <vector>
 #include "lite/api/paddle_api.h"
 #include "lite/core/device_info.h"
+#include "lite/core/fast_math.h"
+#include "lite/core/kernel_tuner.h"
+#include "lite/core/optimizer/mir/conv_algorithm_select_pass.h"
+#include "lite/core/optimizer/mir/embedding_quant_pass.h"
 #include "lite/core/optimizer/mir/pass_manager.h"
 #include "lite/core/optimizer/mir/post_quant_dynamic_pass.h"
+#include "lite/core/optimizer/mir/mixed_precision_pass.h"
+#include "lite/core/optimizer/mir/post_quant_static_pass.h"
 #include "lite/core/optimizer/mir/sparse_conv_detect_pass.h"
+#include "lite/core/run_priority.h"
 #include "lite/core/version.h"
+#include "lite/utils/timer.h"
 #ifdef LITE_USE_THREAD_POOL
 #include "lite/core/parallel_defines.h"
 #include "lite/core/thread_pool.h"
@@ -29,6 +40,9 @@
 #ifndef LITE_ON_TINY_PUBLISH
 #include "lite/api/paddle_use_passes.h"
 #endif
+#ifdef LITE_WITH_CUDA
+#include "lite/backends/cuda/math/conv_op_cache_cudnn.h"
+#endif
 
 #if (defined LITE_WITH_X86) && (defined PADDLE_WITH_MKLML) && \
     !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
@@ -36,19 +50,99 @@
 #include <omp.h>
 #endif
 #include "lite/backends/x86/mklml.h"
+#include "lite/backends/x86/parallel.h"
+#endif
+#if (defined LITE_WITH_X86) && !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+#include "lite/backends/x86/numa.h"
 #endif
 namespace paddle {
 namespace lite {
 
+namespace {
+
+// The threads of MKL and the omp regions, which is the thread budget of the
+// whole predictor if they share the threads with the thread pool.
+int X86MathThreads(const lite_api::CxxConfig &config) {
+  int threads = config.x86_unified_threads() ? config.threads()
+                                             : config.x86_math_num_threads();
+  return std::max(threads, 1);
+}
+
+// Bind the calling thread and its x86 math threads to the NUMA node of
+// `config` once, the binding lasts for the following runs of the thread.
+void BindToNumaNode(const lite_api::CxxConfig &config) {
+#if (defined LITE_WITH_X86) && !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+  int node = config.x86_numa_node();
+  static thread_local int bound_node = -1;
+  if (node < 0 || node == bound_node) return;
+  if (x86::BindThreadsToNumaNode(node, X86MathThreads(config))) {
+    bound_node = node;
+  }
+#endif
+}
+
+#if (defined LITE_WITH_X86) && !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+// Bind the calling thread and its x86 math threads to the NUMA node of
+// `config` in the scope, then restore the previous binding of the thread.
+class NumaBindingScope {
+ public:
+  explicit NumaBindingScope(const lite_api::CxxConfig &config) {
+    int node = config.x86_numa_node();
+    if (node < 0) return;
+    omp_threads_ = X86MathThreads(config);
+    cpus_ = x86::ThreadCpus();
+    if (!cpus_.empty() && !x86::BindThreadsToNumaNode(node, omp_threads_)) {
+      cpus_.clear();
+    }
+  }
+
+  ~NumaBindingScope() {
+    if (!cpus_.empty()) x86::BindThreadsToCpus(cpus_, omp_threads_);
+  }
+
+ private:
+  std::vector<int> cpus_;
+  int omp_threads_{1};
+};
+#endif
+
+}  // namespace
+
 void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
   config_ = config;
   mode_ = config.power_mode();
   threads_ = config.threads();
+  priority_handle_ =
+      RunPriorityArbiter::Global().Register(config.run_priority());
 #ifdef LITE_USE_THREAD_POOL
-  int thread_num = ThreadPool::Init(threads_);
-  if (thread_num > 1) {
-    ThreadPool::AcquireThreadPool();
+  std::string shared_key;
+  if (config.share_thread_pool()) {
+    shared_key = "threads:" + std::to_string(threads_) +
+                 ",power_mode:" + std::to_string(static_cast<int>(mode_)) +
+                 ",unified:" + std::to_string(config.x86_unified_threads()) +
+                 ",numa_node:" + std::to_string(config.x86_numa_node());
+  }
+  // The unified pool runs on the omp threads, which MKL runs on as well.
+  thread_pool_ = ThreadPool::Create(threads_,
+                                    config.x86_unified_threads()
+                                        ? ThreadPoolMode::kOpenMP
+                                        : ThreadPoolMode::kPark,
+                                    shared_key);
+#if (defined LITE_WITH_X86) && !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+  // The workers are bound before their first task.
+  if (thread_pool_ && config.x86_numa_node() >= 0) {
+    thread_pool_->SetAffinity(x86::NumaNodeCpus(config.x86_numa_node()));
+  }
+#endif
+#endif
+#ifdef LITE_WITH_ARM
+  if (config.adaptive_threads()) {
+    adaptive_threads_.reset(new AdaptiveThreads(threads_));
   }
+#endif
+#if (defined LITE_WITH_X86) && !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+  // Load the weights on the NUMA node, the clones copy them by themselves.
+  NumaBindingScope numa_binding_scope(config);
 #endif
   if (!status_is_cloned_) {
     auto places = config.valid_places();
@@ -59,6 +153,8 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
     for (auto &p : places) {
       if (p.target == TARGET(kCUDA)) {
         Env<TARGET(kCUDA)>::Init();
+        cuda::math::ConvAlgorithmFileCache::Global().Load(
+            config_.cudnn_algo_cache_file());
         if (config_.multi_stream()) {
           passes.push_back("multi_stream_analysis_pass");
           VLOG(3) << "add pass: " << passes[0];
@@ -101,6 +197,8 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
     Context<TargetType::kNNAdapter>::SetNNAdapterSubgraphPartitionConfigBuffer(
         raw_predictor_->scope(),
         config.nnadapter_subgraph_partition_config_buffer());
+    Context<TargetType::kNNAdapter>::SetNNAdapterSubgraphCostTablePath(
+        raw_predictor_->scope(), config.nnadapter_subgraph_cost_table_path());
     Context<TargetType::kNNAdapter>::
         SetNNAdapterMixedPrecisionQuantizationConfigPath(
             raw_predictor_->scope(),
@@ -111,6 +209,8 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
             config.nnadapter_mixed_precision_quantization_config_buffer());
     Context<TargetType::kNNAdapter>::SetNNAdapterDynamicShapeInfo(
         raw_predictor_->scope(), config.nnadapter_dynamic_shape_info());
+    Context<TargetType::kNNAdapter>::SetNNAdapterPrecompileDynamicShapes(
+        raw_predictor_->scope(), config.nnadapter_precompile_dynamic_shapes());
 #endif
 
     auto use_layout_preprocess_pass =
@@ -130,6 +230,30 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
       pass->SetQuantType(config.quant_type());
     }
 
+    if (config.embedding_quant_bits() != 0) {
+      passes.push_back("embedding_quant_pass");
+      auto *pass = mir::PassManager::Global().LookUp<mir::EmbeddingQuantPass>(
+          "embedding_quant_pass");
+      CHECK(pass);
+      pass->SetQuantBits(config.embedding_quant_bits());
+    }
+
+    if (!config.calib_table().empty()) {
+      passes.push_back("post_quant_static_pass");
+      auto *pass = mir::PassManager::Global().LookUp<mir::PostQuantStaticPass>(
+          "post_quant_static_pass");
+      CHECK(pass);
+      pass->SetCalibTable(config.calib_table());
+    }
+
+    if (!config.mixed_precision_config().empty()) {
+      passes.push_back("mixed_precision_pass");
+      auto *pass = mir::PassManager::Global().LookUp<mir::MixedPrecisionPass>(
+          "mixed_precision_pass");
+      CHECK(pass);
+      pass->SetConfig(config.mixed_precision_config());
+    }
+
     auto *sparse_detect_pass =
         mir::PassManager::Global().LookUp<mir::SparseConvDetectPass>(
             "sparse_conv_detect_pass");
@@ -142,6 +266,15 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
       sparse_detect_pass->SetSparseThreshold(1.5);
     }
 
+    if (config.conv_algorithm_preselect()) {
+      passes.push_back("conv_algorithm_select_pass");
+      auto *pass =
+          mir::PassManager::Global().LookUp<mir::ConvAlgorithmSelectPass>(
+              "conv_algorithm_select_pass");
+      CHECK(pass);
+      pass->SetTargetHasDot(config.target_has_dot());
+    }
+
     raw_predictor_->Build(config, places, passes);
   } else {
     raw_predictor_->PrepareFeedFetch();
@@ -161,8 +294,7 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
 
 #if (defined LITE_WITH_X86) && (defined PADDLE_WITH_MKLML) && \
     !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
-  int num_threads = config.x86_math_num_threads();
-  int real_num_threads = num_threads > 1 ? num_threads : 1;
+  int real_num_threads = X86MathThreads(config);
 #ifdef LITE_WITH_STATIC_MKL
   MKL_Set_Num_Threads(real_num_threads);
 #else
@@ -221,15 +353,61 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
     }
     Run();
   }
+  // The first run of each input shape records the sizes of the L3 cache
+  // blocks, from which the plan of the shape is tuned.
+  auto &input_precisions = raw_predictor_->GetInputPrecisions();
+  for (auto &shapes : config.xpu_l3_autotune_shapes()) {
+    CHECK_EQ(shapes.size(), input_precisions.size())
+        << "The shapes of all the inputs are needed to tune the XPU L3 plan";
+    for (size_t i = 0; i < shapes.size(); i++) {
+      auto *in_tensor = raw_predictor_->GetInput(i);
+      in_tensor->Resize(shapes[i]);
+      in_tensor->set_lod({});
+      in_tensor->set_precision(input_precisions[i]);
+      size_t memory_size = in_tensor->numel() *
+                           lite_api::PrecisionTypeLength(input_precisions[i]);
+      memset(in_tensor->mutable_data(memory_size), 0, memory_size);
+    }
+    Run();
+  }
 #endif
-}
-
-CxxPaddleApiImpl::~CxxPaddleApiImpl() {
-#ifdef LITE_USE_THREAD_POOL
-  ThreadPool::ReleaseThreadPool();
+#ifdef LITE_WITH_OPENCL
+  // Allocate the images for the largest declared shapes, the smaller shapes
+  // run on the sub-regions of them later.
+  const auto &opencl_shapes = config.opencl_dynamic_shape_info();
+  if (!opencl_shapes.empty() && paddle::lite_api::IsOpenCLBackendValid()) {
+    auto input_names = raw_predictor_->GetInputNames();
+    auto &opencl_input_precisions = raw_predictor_->GetInputPrecisions();
+    for (size_t i = 0; i < input_names.size(); i++) {
+      auto it = opencl_shapes.find(input_names[i]);
+      CHECK(it != opencl_shapes.end() && !it->second.empty())
+          << "The shapes of the input " << input_names[i]
+          << " are not declared";
+      auto max_shape = it->second.front();
+      for (auto &shape : it->second) {
+        CHECK_EQ(shape.size(), max_shape.size())
+            << "The ranks of the shapes of the input " << input_names[i]
+            << " differ";
+        for (size_t j = 0; j < shape.size(); j++) {
+          max_shape[j] = (std::max)(max_shape[j], shape[j]);
+        }
+      }
+      auto *in_tensor = raw_predictor_->GetInput(i);
+      in_tensor->Resize(max_shape);
+      in_tensor->set_lod({});
+      in_tensor->set_precision(opencl_input_precisions[i]);
+      size_t memory_size =
+          in_tensor->numel() *
+          lite_api::PrecisionTypeLength(opencl_input_precisions[i]);
+      memset(in_tensor->mutable_data(memory_size), 0, memory_size);
+    }
+    Run();
+  }
 #endif
 }
 
+CxxPaddleApiImpl::~CxxPaddleApiImpl() {}
+
 std::unique_ptr<lite_api::Tensor> CxxPaddleApiImpl::GetInputByName(
     const std::string &name) {
   auto *x = raw_predictor_->GetInputByName(name);
@@ -253,10 +431,50 @@ std::unique_ptr<const lite_api::Tensor> CxxPaddleApiImpl::GetOutput(
   return std::unique_ptr<lite_api::Tensor>(new lite_api::Tensor(x));
 }
 
+void CxxPaddleApiImpl::BindInput(int i,
+                                 void *data,
+                                 size_t memory_size,
+                                 const lite_api::shape_t &shape,
+                                 PrecisionType precision) {
+  raw_predictor_->BindInput(i, data, memory_size, DDim(shape), precision);
+}
+
+void CxxPaddleApiImpl::BindOutput(int i, void *data, size_t memory_size) {
+  raw_predictor_->BindOutput(i, data, memory_size);
+}
+
+void CxxPaddleApiImpl::SetStreamStates(
+    const std::vector<std::string> &state_inputs,
+    const std::vector<std::string> &state_outputs) {
+  raw_predictor_->SetStreamStates(state_inputs, state_outputs);
+}
+
+void CxxPaddleApiImpl::SelectStream(int64_t id) {
+  raw_predictor_->stream_states()->Select(id);
+}
+
+void CxxPaddleApiImpl::ResetStream(int64_t id) {
+  raw_predictor_->stream_states()->Reset(id);
+}
+
+void CxxPaddleApiImpl::ReleaseStream(int64_t id) {
+  raw_predictor_->stream_states()->Release(id);
+}
+
 std::vector<std::string> CxxPaddleApiImpl::GetInputNames() {
   return raw_predictor_->GetInputNames();
 }
 
+bool CxxPaddleApiImpl::IsNNAdapterShapeReady(
+    const std::map<std::string, lite_api::shape_t> &input_shapes) {
+#ifdef LITE_WITH_NNADAPTER
+  return Context<TargetType::kNNAdapter>::NNAdapterShapeReady(
+      raw_predictor_->scope(), input_shapes);
+#else
+  return true;
+#endif
+}
+
 std::vector<std::string> CxxPaddleApiImpl::GetParamNames() {
   return raw_predictor_->GetParamNames();
 }
@@ -266,10 +484,47 @@ std::vector<std::string> CxxPaddleApiImpl::GetOutputNames() {
 }
 
 void CxxPaddleApiImpl::Run() {
+  RunPriorityArbiter::Scope priority_scope(config_.run_priority());
+  FastMath::Scope fast_math_scope(config_.fast_math());
+  BindToNumaNode(config_);
+#if (defined LITE_WITH_X86) && (defined PADDLE_WITH_MKLML) && \
+    !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+  // MKL and omp take the budget of the thread, not the process, so the
+  // predictors run concurrently on their own budgets.
+  if (config_.x86_unified_threads()) {
+    x86::SetLocalNumThreads(X86MathThreads(config_));
+  }
+#endif
 #ifdef LITE_WITH_ARM
-  lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
+  int threads = adaptive_threads_ ? adaptive_threads_->threads() : threads_;
+  lite::DeviceInfo::Global().SetRunMode(
+      RunPriorityArbiter::Global().ReserveCores(config_.run_priority(), mode_),
+      threads);
+  uint64_t start_us = lite::Timer::GetCurrentUS();
+#endif
+#ifdef LITE_USE_THREAD_POOL
+  ThreadPoolGuard thread_pool_guard(thread_pool_.get());
+#ifdef LITE_WITH_ARM
+  if (thread_pool_) {
+    ThreadPool::SetActiveThreads(lite::DeviceInfo::Global().threads());
+  }
+  if (thread_pool_ &&
+      lite::DeviceInfo::Global().mode() != lite_api::LITE_POWER_NO_BIND) {
+    thread_pool_->SetAffinity(lite::DeviceInfo::Global().active_ids());
+    thread_pool_->SetCapacity(lite::DeviceInfo::Global().active_capacities());
+  }
+#endif
 #endif
   raw_predictor_->Run();
+#ifdef LITE_WITH_ARM
+  if (adaptive_threads_) {
+    adaptive_threads_->Update(lite::Timer::GetCurrentUS() - start_us, []() {
+      return lite::DeviceInfo::Global().active_cores_throttled();
+    });
+  }
+#endif
+  // Save the kernels tuned in this run, if any.
+  KernelTuner::Global().Save();
 }
 
 std::shared_ptr<lite_api::PaddlePredictor> CxxPaddleApiImpl::Clone() {
@@ -289,6 +544,30 @@ std::shared_ptr<lite_api::PaddlePredictor> CxxPaddleApiImpl::Clone(
   return predictor;
 }
 
+std::shared_ptr<lite_api::PaddlePredictor> CxxPaddleApiImpl::CloneOnNumaNode(
+    int node) {
+#if (defined LITE_WITH_X86) && !(defined LITE_ON_MODEL_OPTIMIZE_TOOL)
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK_GE(node, 0);
+  CHECK_LT(node, x86::NumaNodeCount()) << "Unknown NUMA node " << node;
+  auto config = config_;
+  config.set_x86_numa_node(node);
+  // Copy the weights on a thread bound to the node, so their pages are
+  // first touched, and placed, there.
+  std::shared_ptr<Predictor> raw_predictor;
+  std::thread thread([&] {
+    x86::BindThreadsToNumaNode(node, 1);
+    raw_predictor = raw_predictor_->Clone(raw_predictor_->GetParamNames());
+  });
+  thread.join();
+  auto predictor = std::make_shared<lite::CxxPaddleApiImpl>(raw_predictor);
+  predictor->Init(config);
+  return predictor;
+#else
+  return lite_api::PaddlePredictor::CloneOnNumaNode(node);
+#endif
+}
+
 std::string CxxPaddleApiImpl::GetVersion() const { return version(); }
 
 std::unique_ptr<const lite_api::Tensor> CxxPaddleApiImpl::GetTensor(
@@ -306,13 +585,40 @@ std::unique_ptr<lite_api::Tensor> CxxPaddleApiImpl::GetMutableTensor(
 void CxxPaddleApiImpl::SaveOptimizedModel(const std::string &model_dir,
                                           lite_api::LiteModelType model_type,
                                           bool record_info) {
-  raw_predictor_->SaveModel(model_dir, model_type, record_info);
+  raw_predictor_->SaveModel(
+      model_dir, model_type, record_info, config_.compress_weights());
 }
 
 bool CxxPaddleApiImpl::TryShrinkMemory() {
   return raw_predictor_->TryShrinkMemory();
 }
 
+lite_api::RuntimeStats CxxPaddleApiImpl::GetRuntimeStats() {
+  auto stats = lite_api::PaddlePredictor::GetRuntimeStats();
+  raw_predictor_->CollectRuntimeStats(&stats);
+  return stats;
+}
+
+void CxxPaddleApiImpl::StartOpLatencyRecording() {
+  latency_table_.reset(new LatencyTable);
+  raw_predictor_->SetLatencyTable(latency_table_.get(), threads_);
+}
+
+bool CxxPaddleApiImpl::StopOpLatencyRecording(const std::string &path) {
+  CHECK(latency_table_) << "The op latency recording is not started";
+  raw_predictor_->SetLatencyTable(nullptr, threads_);
+  bool saved = latency_table_->Save(path);
+  latency_table_.reset();
+  return saved;
+}
+
+double CxxPaddleApiImpl::EstimateLatency(const std::string &path,
+                                         int *missing) {
+  LatencyTable table;
+  CHECK(table.Load(path)) << "Failed to load the op latency table " << path;
+  return raw_predictor_->EstimateLatency(table, threads_, missing);
+}
+
 }  // namespace lite
 
 namespace lite_api {
@@ -15,31 +15,72 @@
 #include "lite/api/light_api.h"
 #include <algorithm>
 #include <map>
+#include <set>
+#include "lite/backends/host/memory_pool.h"
+#ifdef LITE_WITH_OPENCL
+#include "lite/backends/opencl/target_wrapper.h"
+#endif
+#include "lite/core/parallel_defines.h"
+#include "lite/core/shared_memory_weights.h"
+#include "lite/core/shared_weight_store.h"
+#include "lite/utils/timer.h"
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
 #endif
+#ifdef LITE_WITH_ARM
+#include "lite/backends/arm/math/bf16/type_trans_bf16.h"
+#include "lite/core/device_info.h"
+#endif
 
 namespace paddle {
 namespace lite {
 
+namespace {
+// The number of the ops whose mapped weights are read ahead of their runs.
+const size_t kReadAheadOps = 4;
+}  // namespace
+
 void LightPredictor::Build(const std::string& lite_model_file,
-                           bool model_from_memory) {
+                           bool model_from_memory,
+                           bool model_mmap,
+                           bool lazy_load_weights,
+                           bool share_weights,
+                           const std::string& shared_memory_weights) {
+  uint64_t start = Timer::GetCurrentUS();
+  auto& build_stats = ThreadBuildStats::Current();
+  uint64_t read_file_ns = build_stats.read_file_ns;
+  model_mmap_ = model_mmap && !model_from_memory;
   if (model_from_memory) {
     LoadModelNaiveFromMemory(
         lite_model_file, scope_.get(), program_desc_.get());
   } else {
-    LoadModelNaiveFromFile(lite_model_file, scope_.get(), program_desc_.get());
+    LoadModelNaiveFromFile(
+        lite_model_file, scope_.get(), program_desc_.get(), model_mmap);
   }
 
-  // For weight quantization of post training, load the int8/16 weights
-  // for optimized model, and dequant it to fp32.
-  DequantizeWeight();
-#ifdef ENABLE_ARM_FP16
-  // fp16 Weight convert
-  WeightFP32ToFP16();
-#endif
+  uint64_t loaded = Timer::GetCurrentUS();
+
+  if (lazy_load_weights) PrepareLazyWeights();
+  DecodeWeights();
+  if (!shared_memory_weights.empty()) {
+    ShareWeightsThroughSharedMemory(shared_memory_weights);
+  }
+  if (share_weights) ShareWeights();
+  uint64_t decoded = Timer::GetCurrentUS();
+
   BuildRuntimeProgram(program_desc_);
   PrepareFeedFetch();
+  // Decoding the weights is a part of parsing the model.
+  cold_start_.read_file_ns = build_stats.read_file_ns - read_file_ns;
+  cold_start_.parse_ns =
+      (decoded - start) * 1000 - cold_start_.read_file_ns;
+  cold_start_.create_kernels_ns = (Timer::GetCurrentUS() - decoded) * 1000;
+  VLOG(1) << "Build the predictor in "
+          << (Timer::GetCurrentUS() - start) / 1000.f
+          << " ms: loading the model " << (loaded - start) / 1000.f
+          << " ms, decoding the weights " << (decoded - loaded) / 1000.f
+          << " ms, building the runtime program "
+          << (Timer::GetCurrentUS() - decoded) / 1000.f << " ms.";
 }
 
 void LightPredictor::Build(const std::string& model_dir,
@@ -66,12 +107,7 @@ void LightPredictor::Build(const std::string& model_dir,
       LOG(FATAL) << "Unknown model type";
   }
 
-  DequantizeWeight();
-
-#ifdef ENABLE_ARM_FP16
-  // fp16 Weight convert
-  WeightFP32ToFP16();
-#endif
+  DecodeWeights();
   BuildRuntimeProgram(program_desc_);
   PrepareFeedFetch();
 }
@@ -81,7 +117,8 @@ Tensor* LightPredictor::GetInput(size_t offset) {
   CHECK(input_names_.size() > offset)
       << "The network has " << input_names_.size() << " inputs"
       << ", the offset should be less than this.";
-  auto* in_var = program_->exec_scope()->FindVar(input_names_[offset]);
+  auto* in_var = input_vars_[offset];
+  if (!in_var) in_var = program_->exec_scope()->FindVar(input_names_[offset]);
   CHECK(in_var) << "no fatch variable " << input_names_[offset]
                 << " in exec_scope";
   return in_var->GetMutable<lite::Tensor>();
@@ -135,7 +172,10 @@ const Tensor* LightPredictor::GetOutput(size_t offset) {
   CHECK(output_names_.size() > offset)
       << "The network has " << output_names_.size() << " outputs"
       << ", the offset should be less than this.";
-  auto* out_var = program_->exec_scope()->FindVar(output_names_.at(offset));
+  auto* out_var = output_vars_[offset];
+  if (!out_var) {
+    out_var = program_->exec_scope()->FindVar(output_names_.at(offset));
+  }
   CHECK(out_var) << "no fatch variable " << output_names_.at(offset)
                  << " in exec_scope";
   return out_var->GetMutable<lite::Tensor>();
@@ -188,13 +228,24 @@ void LightPredictor::PrepareFeedFetch() {
     output_names_[fetchs[i]->GetAttr<int>("col")] =
         fetchs[i]->Input("X").front();
   }
+  // resolve the feed and fetch variables once instead of on every
+  // GetInput and GetOutput
+  input_vars_.resize(input_names_.size());
+  for (size_t i = 0; i < input_names_.size(); i++) {
+    input_vars_[i] = program_->exec_scope()->FindVar(input_names_[i]);
+  }
+  output_vars_.resize(output_names_.size());
+  for (size_t i = 0; i < output_names_.size(); i++) {
+    output_vars_[i] = program_->exec_scope()->FindVar(output_names_[i]);
+  }
   for (size_t i = 0; i < feeds.size(); i++) {
     input_precisions_[i] = GetInput(i)->precision();
   }
 }
 
 void LightPredictor::BuildRuntimeProgram(
-    const std::shared_ptr<const cpp::ProgramDesc>& program_desc) {
+    const std::shared_ptr<const cpp::ProgramDesc>& program_desc,
+    const std::vector<std::string>& vars_to_clone) {
   auto* exe_scope = &scope_->NewScope();
   // Prepare workspace
   scope_->Var("feed")->GetMutable<std::vector<lite::Tensor>>();
@@ -226,14 +277,66 @@ void LightPredictor::BuildRuntimeProgram(
       if (op_desc->Type() == "lod_array_length") bool_clear_tensor_ = true;
     }
   }
+  // The private copies must be created before the ops are attached to the
+  // exec scope, or they will bind to the shared ones in scope_.
+  for (auto& var_name : vars_to_clone) {
+    auto* var = scope_->FindVar(var_name);
+    CHECK(var) << "no variable " << var_name << " to clone in scope";
+    auto* tensor = var->GetMutable<lite::Tensor>();
+    auto* sub_tensor = exe_scope->LocalVar(var_name)->GetMutable<Tensor>();
+    sub_tensor->CopyDataFrom(*tensor);
+  }
   // Only extracting the ops and generate the runtime program from the main
   // block desc
   program_.reset(new RuntimeProgram(program_desc, exe_scope, kRootBlockIdx));
+  auto* insts = program_->mutable_instructions(kRootBlockIdx);
+  if (lazy_weights_) {
+    CHECK_EQ(insts->size(), lazy_weights_->op_weights.size());
+  }
+  // The weights of each op mapped from the model file, the first run of an op
+  // reads ahead the weights of the op kReadAheadOps later, so the I/O of the
+  // cold run overlaps the compute of the ops before.
+  std::shared_ptr<std::vector<std::vector<const Tensor*>>> mapped_weights;
+  if (model_mmap_) {
+    mapped_weights =
+        std::make_shared<std::vector<std::vector<const Tensor*>>>(
+            insts->size());
+    for (size_t op_idx = 0; op_idx < insts->size(); ++op_idx) {
+      for (auto& name : (*insts)[op_idx].op()->op_info()->input_names()) {
+        auto* var = exe_scope->FindVar(name);
+        if (!var || !var->IsType<Tensor>()) continue;
+        auto& tensor = var->Get<Tensor>();
+        if (tensor.persistable()) {
+          (*mapped_weights)[op_idx].push_back(&tensor);
+        }
+      }
+    }
+  }
+  for (size_t op_idx = 0; op_idx < insts->size(); ++op_idx) {
+    std::shared_ptr<LazyWeights> lazy_weights;
+    if (lazy_weights_ && !lazy_weights_->op_weights[op_idx].empty()) {
+      lazy_weights = lazy_weights_;
+    }
+    if (!lazy_weights && !mapped_weights) continue;
+    (*insts)[op_idx].set_first_run_hook([lazy_weights, mapped_weights, op_idx] {
+      if (mapped_weights) {
+        // The first op starts the whole window.
+        size_t begin = op_idx == 0 ? 0 : op_idx + kReadAheadOps;
+        size_t end =
+            std::min(op_idx + kReadAheadOps + 1, mapped_weights->size());
+        for (size_t i = begin; i < end; ++i) {
+          for (auto* weight : (*mapped_weights)[i]) {
+            if (!weight->IsInitialized()) continue;
+            model_parser::ReadAhead(weight->raw_data(), weight->memory_size());
+          }
+        }
+      }
+      if (lazy_weights) lazy_weights->Materialize(op_idx);
+    });
+  }
 }
 
-void LightPredictor::DequantizeWeight() {
-  std::shared_ptr<const cpp::ProgramDesc> program_desc = program_desc_;
-  CHECK(program_desc != nullptr);
+namespace {
 #define PROCESS_CONV2D_DATA()                                             \
   for (int64_t i = 0; i < ch; ++i) {                                      \
     for (int64_t j = 0; j < offset; ++j) {                                \
@@ -248,6 +351,191 @@ void LightPredictor::DequantizeWeight() {
     }                                                                   \
   }
 
+void DequantizeTensor(Tensor* input_tensor,
+                      const std::string& op_type,
+                      const std::vector<float>& scale_list,
+                      int quantize_weight_bits,
+                      int group_size) {
+  Tensor tmp_tensor;
+  tmp_tensor.CopyDataFrom(*input_tensor);
+  float* fp_data = input_tensor->mutable_data<float>();
+  CHECK(fp_data != nullptr);
+
+  if (quantize_weight_bits == 4) {
+    // the group-wise int4 weight [K, N] with the scales [K / group_size, N]
+    CHECK_EQ(input_tensor->dims().size(), 2UL);
+    int64_t chin = input_tensor->dims()[0];
+    int64_t chout = input_tensor->dims()[1];
+    CHECK_EQ(scale_list.size(),
+             static_cast<size_t>((chin + group_size - 1) / group_size * chout));
+    const int8_t* int_data = tmp_tensor.data<int8_t>();
+    for (int64_t i = 0; i < chin; i++) {
+      const float* scales = scale_list.data() + i / group_size * chout;
+      for (int64_t j = 0; j < chout; j++) {
+        fp_data[i * chout + j] = scales[j] * int_data[i * chout + j];
+      }
+    }
+  } else if (op_type == "conv2d" || op_type == "depthwise_conv2d") {
+    int64_t ch = input_tensor->dims()[0];
+    int64_t offset = input_tensor->numel() / ch;
+    CHECK_EQ(scale_list.size(), ch);
+    if (quantize_weight_bits == 8) {
+      const int8_t* int_data = tmp_tensor.data<int8_t>();
+      CHECK(int_data != nullptr);
+      PROCESS_CONV2D_DATA()
+    } else {
+      const int16_t* int_data = tmp_tensor.data<int16_t>();
+      CHECK(int_data != nullptr);
+      PROCESS_CONV2D_DATA()
+    }
+  } else if (op_type == "fc" || op_type == "mul" ||
+             op_type == "lookup_table") {
+    int64_t chin = input_tensor->dims()[0];
+    int64_t chout = input_tensor->dims()[1];
+    CHECK_EQ(scale_list.size(), chout);
+    if (quantize_weight_bits == 8) {
+      const int8_t* int_data = tmp_tensor.data<int8_t>();
+      CHECK(int_data != nullptr);
+      PROCESS_FC_DATA()
+    } else {
+      const int16_t* int_data = tmp_tensor.data<int16_t>();
+      CHECK(int_data != nullptr);
+      PROCESS_FC_DATA()
+    }
+  }
+}
+
+#undef PROCESS_CONV2D_DATA
+#undef PROCESS_FC_DATA
+}  // namespace
+
+void LightPredictor::LazyWeights::Materialize(size_t op_idx) {
+  if (op_idx >= op_weights.size()) return;
+  for (auto* weight : op_weights[op_idx]) {
+    std::call_once(weight->once, [weight] {
+      for (auto& decoder : weight->decoders) decoder();
+      weight->decoders.clear();
+    });
+  }
+}
+
+void LightPredictor::LazyWeights::MaterializeAll() {
+  for (size_t i = 0; i < op_weights.size(); i++) Materialize(i);
+}
+
+void LightPredictor::DecodeWeights() {
+  // For weight quantization of post training, load the int8/16 weights
+  // for optimized model, and dequant it to fp32.
+  DequantizeWeight();
+#ifdef ENABLE_ARM_FP16
+  // fp16 Weight convert
+  WeightFP32ToFP16();
+#endif
+#ifdef LITE_WITH_ARM
+  WeightFP32ToBF16();
+#endif
+  if (pending_decoders_.empty()) return;
+  // The weights are decoded in parallel, and the decoders of a weight are
+  // called in order on the same thread.
+  std::vector<std::vector<std::function<void()>>*> weights;
+  for (auto& item : pending_decoders_) weights.push_back(&item.second);
+  int weights_size = static_cast<int>(weights.size());
+  LITE_PARALLEL_BEGIN(i, tid, weights_size) {
+    for (auto& decoder : *weights[i]) decoder();
+  }
+  LITE_PARALLEL_END();
+  VLOG(1) << "Decoded " << weights_size << " weights.";
+  pending_decoders_.clear();
+}
+
+void LightPredictor::RunPipelined(size_t requests,
+                                  const std::function<void(size_t)>& feed,
+                                  const std::function<void(size_t)>& fetch) {
+  CHECK(io_binding_.empty())
+      << "The bound inputs and outputs are not supported by the pipelined runs";
+  CHECK(stream_states_.empty())
+      << "The stream states are not supported by the pipelined runs";
+  program_->RunPipelined(requests,
+                         [&](size_t i) {
+                           feed(i);
+                           CheckInputValid();
+                         },
+                         fetch);
+  if (bool_clear_tensor_) ClearTensorArray(program_desc_);
+}
+
+std::set<std::string> LightPredictor::LazyWeightNames() const {
+  std::set<std::string> lazy_weights;
+  if (lazy_weights_) {
+    for (auto& item : lazy_weights_->weights) lazy_weights.insert(item.first);
+  }
+  return lazy_weights;
+}
+
+void LightPredictor::ShareWeights() {
+  SharedWeightStore::Global().ShareScope(scope_.get(), LazyWeightNames());
+}
+
+void LightPredictor::ShareWeightsThroughSharedMemory(const std::string& name) {
+  ShareScopeThroughSharedMemory(name, scope_.get(), LazyWeightNames());
+}
+
+void LightPredictor::AddWeightDecoder(size_t block_idx,
+                                      size_t op_idx,
+                                      const std::string& weight_name,
+                                      const std::function<void()>& decoder) {
+  if (!lazy_weights_) {
+    pending_decoders_[weight_name].push_back(decoder);
+    return;
+  }
+  // The weights of the sub blocks are decoded on the first run of the root
+  // op which owns the blocks, e.g. conditional_block and while.
+  if (block_idx != kRootBlockIdx) {
+    auto it = lazy_weights_->block_owners.find(block_idx);
+    CHECK(it != lazy_weights_->block_owners.end())
+        << "No root op owns block " << block_idx;
+    op_idx = it->second;
+  }
+  auto& weight = lazy_weights_->weights[weight_name];
+  if (!weight) weight.reset(new LazyWeights::Weight);
+  weight->decoders.push_back(decoder);
+  auto& op_weights = lazy_weights_->op_weights;
+  if (op_weights.size() <= op_idx) op_weights.resize(op_idx + 1);
+  auto& weights = op_weights[op_idx];
+  if (std::find(weights.begin(), weights.end(), weight.get()) ==
+      weights.end()) {
+    weights.push_back(weight.get());
+  }
+}
+
+void LightPredictor::PrepareLazyWeights() {
+  lazy_weights_.reset(new LazyWeights);
+  auto* root = program_desc_->GetBlock<cpp::BlockDesc>(kRootBlockIdx);
+  // Find the root ops of the sub blocks, the blocks nested in a sub block
+  // belong to the same root op.
+  std::function<void(size_t, size_t)> own_blocks = [&](size_t block_idx,
+                                                       size_t owner) {
+    auto* block = program_desc_->GetBlock<cpp::BlockDesc>(block_idx);
+    for (size_t k = 0; k < block->OpsSize(); ++k) {
+      auto* op_desc = block->GetOp<cpp::OpDesc>(k);
+      if (!op_desc->HasAttr("sub_block")) continue;
+      size_t sub_block = op_desc->GetAttr<int32_t>("sub_block");
+      if (sub_block >= program_desc_->BlocksSize() ||
+          lazy_weights_->block_owners.count(sub_block)) {
+        continue;
+      }
+      size_t sub_owner = block_idx == kRootBlockIdx ? k : owner;
+      lazy_weights_->block_owners[sub_block] = sub_owner;
+      own_blocks(sub_block, sub_owner);
+    }
+  };
+  own_blocks(kRootBlockIdx, 0);
+  lazy_weights_->op_weights.resize(root->OpsSize());
+}
+
+void LightPredictor::DequantizeWeight() {
+  std::shared_ptr<const cpp::ProgramDesc> program_desc = program_desc_;
+  CHECK(program_desc != nullptr);
   auto is_weight_quantized_op = [](const cpp::OpDesc* op_desc) {
     CHECK(op_desc != nullptr);
     bool result = false;
@@ -260,7 +548,39 @@ void LightPredictor::DequantizeWeight() {
     }
     return result;
   };
-  Tensor tmp_tensor;
+#ifdef LITE_WITH_ARM
+  // The arm fp32 kernels of fc and matmul_v2 run the int4 weight, and those
+  // of fc and conv2d run the channel-wise int8 weight, so the weight is kept
+  // compressed in the memory.
+  auto runs_quantized_weight = [](const cpp::OpDesc* op_desc,
+                                  const std::string& input_name,
+                                  int bits) {
+    if (!op_desc->HasAttr(kKernelTypeAttr) ||
+        op_desc->HasAttr(input_name + "_fp16") ||
+        op_desc->HasAttr(input_name + "_bf16")) {
+      return false;
+    }
+    std::string op_type;
+    std::string alias;
+    Place place;
+    KernelBase::ParseKernelType(
+        op_desc->GetAttr<std::string>(kKernelTypeAttr),
+        &op_type,
+        &alias,
+        &place);
+    if (place.target != TARGET(kARM) || place.precision != PRECISION(kFloat)) {
+      return false;
+    }
+    if (bits == 4) {
+      return op_type == "fc" || op_type == "matmul_v2";
+    }
+    if (bits == 8) {
+      return op_type == "fc" ||
+             (op_type == "conv2d" && op_desc->GetAttr<int>("groups") == 1);
+    }
+    return false;
+  };
+#endif
   for (size_t i = 0; i < program_desc->BlocksSize(); i++) {
     auto* block = program_desc->GetBlock<cpp::BlockDesc>(i);
     CHECK(block != nullptr);
@@ -289,53 +609,37 @@ void LightPredictor::DequantizeWeight() {
             CHECK(scope_var != nullptr);
             auto input_tensor = scope_var->GetMutable<lite::Tensor>();
             CHECK(input_tensor != nullptr);
-            tmp_tensor.CopyDataFrom(*input_tensor);
             auto scale_list =
                 op_desc->GetAttr<std::vector<float>>(input_scale_name);
 
             int quantize_weight_bits =
                 op_desc->GetAttr<int>("quantize_weight_bits");
-            CHECK(quantize_weight_bits == 8 || quantize_weight_bits == 16);
-            float* fp_data = input_tensor->mutable_data<float>();
-            CHECK(fp_data != nullptr);
-
+            CHECK(quantize_weight_bits == 4 || quantize_weight_bits == 8 ||
+                  quantize_weight_bits == 16);
             std::string op_type = op_desc->Type();
-            if (op_type == "conv2d" || op_type == "depthwise_conv2d") {
-              int64_t ch = input_tensor->dims()[0];
-              int64_t offset = input_tensor->numel() / ch;
-              CHECK_EQ(scale_list.size(), ch);
-              if (quantize_weight_bits == 8) {
-                const int8_t* int_data = tmp_tensor.data<int8_t>();
-                CHECK(int_data != nullptr);
-                PROCESS_CONV2D_DATA()
-              } else {
-                const int16_t* int_data = tmp_tensor.data<int16_t>();
-                CHECK(int_data != nullptr);
-                PROCESS_CONV2D_DATA()
-              }
-            } else if (op_type == "fc" || op_type == "mul" ||
-                       op_type == "lookup_table") {
-              int64_t chin = input_tensor->dims()[0];
-              int64_t chout = input_tensor->dims()[1];
-              CHECK_EQ(scale_list.size(), chout);
-              if (quantize_weight_bits == 8) {
-                const int8_t* int_data = tmp_tensor.data<int8_t>();
-                CHECK(int_data != nullptr);
-                PROCESS_FC_DATA()
-              } else {
-                const int16_t* int_data = tmp_tensor.data<int16_t>();
-                CHECK(int_data != nullptr);
-                PROCESS_FC_DATA()
-              }
+            int group_size = 0;
+            if (quantize_weight_bits == 4) {
+              group_size =
+                  op_desc->GetAttr<int>("quantize_weight_group_size");
             }
+#ifdef LITE_WITH_ARM
+            if (runs_quantized_weight(
+                    op_desc, input_name, quantize_weight_bits)) {
+              continue;
+            }
+#endif
+            AddWeightDecoder(i, k, input_name, [=] {
+              DequantizeTensor(input_tensor,
+                               op_type,
+                               scale_list,
+                               quantize_weight_bits,
+                               group_size);
+            });
           }
         }
       }
     }
   }
-
-#undef PROCESS_CONV2D_DATA
-#undef PROCESS_FC_DATA
 }
 
 #ifdef ENABLE_ARM_FP16
@@ -355,7 +659,9 @@ void LightPredictor::WeightFP32ToFP16() {
                                     "elementwise_sub",
                                     "elementwise_div",
                                     "elementwise_mul",
-                                    "prelu"};
+                                    "prelu",
+                                    "sparse_conv2d",
+                                    "sparse_fc"};
   for (size_t i = 0; i < program_desc->BlocksSize(); i++) {
     auto* block = program_desc->GetBlock<cpp::BlockDesc>(i);
     for (size_t k = 0; k < block->OpsSize(); ++k) {
@@ -367,20 +673,22 @@ void LightPredictor::WeightFP32ToFP16() {
         for (auto& input_name : input_names) {
           std::string input_weight_name = input_name + "_fp16";
           if (op_desc->HasAttr(input_weight_name)) {  // the input is fp16
-            Tensor tmp_tensor;
             auto input_tensor =
                 scope_->FindVar(input_name)->GetMutable<lite::Tensor>();
+            // Checked when decoding, since the weight may be dequantized
+            // lazily before.
+            AddWeightDecoder(i, k, input_name, [input_tensor] {
+              if (input_tensor->precision() != PRECISION(kFloat)) return;
+              Tensor tmp_tensor;
+              tmp_tensor.CopyDataFrom(*input_tensor);
+              input_tensor->clear();
+              input_tensor->set_precision(PRECISION(kFP16));
 
-            if (input_tensor->precision() != PRECISION(kFloat)) continue;
-
-            tmp_tensor.CopyDataFrom(*input_tensor);
-            input_tensor->clear();
-            input_tensor->set_precision(PRECISION(kFP16));
-
-            float16_t* fp_data = input_tensor->mutable_data<float16_t>();
-            const float* in_data = tmp_tensor.data<float>();
-            lite::arm::math::fp16::fp32_to_fp16(
-                in_data, fp_data, input_tensor->numel());
+              float16_t* fp_data = input_tensor->mutable_data<float16_t>();
+              const float* in_data = tmp_tensor.data<float>();
+              lite::arm::math::fp16::fp32_to_fp16(
+                  in_data, fp_data, input_tensor->numel());
+            });
           }
         }
       }
@@ -389,6 +697,27 @@ void LightPredictor::WeightFP32ToFP16() {
 }
 #endif
 
+#ifdef LITE_WITH_ARM
+void LightPredictor::WeightFP32ToBF16() {
+  // The bf16 kernels run in fp32 on the cpus without bf16.
+  if (!DeviceInfo::Global().has_bf16()) return;
+  for (size_t i = 0; i < program_desc_->BlocksSize(); i++) {
+    auto* block = program_desc_->GetBlock<cpp::BlockDesc>(i);
+    for (size_t k = 0; k < block->OpsSize(); ++k) {
+      auto* op_desc = block->GetOp<cpp::OpDesc>(k);
+      for (auto& input_name : op_desc->input_vars()) {
+        if (!op_desc->HasAttr(input_name + "_bf16")) continue;
+        auto* input_tensor =
+            scope_->FindVar(input_name)->GetMutable<lite::Tensor>();
+        AddWeightDecoder(i, k, input_name, [input_tensor] {
+          lite::arm::math::bf16::tensor_fp32_to_bf16(input_tensor);
+        });
+      }
+    }
+  }
+}
+#endif
+
 void LightPredictor::CheckInputValid() {
   for (size_t idx = 0; idx < input_precisions_.size(); ++idx) {
     if (GetInput(idx)->precision() != input_precisions_[idx]) {
@@ -430,6 +759,12 @@ bool LightPredictor::TryShrinkMemory() {
       continue;
     }
   }
+  program_->ReleaseMemoryArena();
+  host::MemoryPool::Global().Trim();
+#ifdef LITE_WITH_OPENCL
+  auto cl_memory_pool = CLMemoryPool::Current();
+  if (cl_memory_pool) cl_memory_pool->Trim();
+#endif
   return true;
 }
 void LightPredictor::ClearTensorArray(
@@ -19,15 +19,24 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>  //NOLINT
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include "lite/api/paddle_api.h"
+#include "lite/core/adaptive_threads.h"
 #include "lite/core/context.h"
+#include "lite/core/io_binding.h"
 #include "lite/core/program.h"
+#include "lite/core/runtime_stats.h"
+#include "lite/core/stream_states.h"
 #include "lite/core/tensor.h"
+#include "lite/core/thread_pool.h"
 #include "lite/core/types.h"
 #include "lite/model_parser/model_parser.h"
 
@@ -40,14 +49,45 @@ namespace lite {
  */
 class LITE_API LightPredictor {
  public:
+  // The weights decoded on the first run of the root ops using them, shared
+  // by the cloned predictors.
+  struct LazyWeights {
+    struct Weight {
+      std::once_flag once;
+      std::vector<std::function<void()>> decoders;
+    };
+    std::unordered_map<std::string, std::unique_ptr<Weight>> weights;
+    // The weights used by each op of the root block, including the ones of
+    // the sub blocks it owns.
+    std::vector<std::vector<Weight*>> op_weights;
+    // The root op owning each sub block.
+    std::map<size_t, size_t> block_owners;
+
+    void Materialize(size_t op_idx);
+    void MaterializeAll();
+  };
+
   // constructor function of LightPredictor, `lite_model_file` refers to data in
   // model file or buffer,`model_from_memory` refers to whther to load model
-  // from memory.
+  // from memory, `lazy_load_weights` refers to whether to decode the weights
+  // on the first run of the ops using them, `share_weights` refers to whether
+  // to share the identical weights with the other predictors,
+  // `shared_memory_weights` names the shared memory region to share the
+  // weights with the other processes.
   LightPredictor(const std::string& lite_model_file,
-                 bool model_from_memory = false) {
+                 bool model_from_memory = false,
+                 bool model_mmap = false,
+                 bool lazy_load_weights = false,
+                 bool share_weights = false,
+                 const std::string& shared_memory_weights = "") {
     scope_ = std::make_shared<Scope>();
     program_desc_ = std::make_shared<cpp::ProgramDesc>();
-    Build(lite_model_file, model_from_memory);
+    Build(lite_model_file,
+          model_from_memory,
+          model_mmap,
+          lazy_load_weights,
+          share_weights,
+          shared_memory_weights);
   }
 
   // NOTE: This is a deprecated API and will be removed in latter release.
@@ -62,12 +102,52 @@ class LITE_API LightPredictor {
     Build(model_dir, model_buffer, param_buffer, model_type, model_from_memory);
   }
 
+  // Only be called in Clone, create a predictor from an existed ProgramDesc
+  // and root Scope. The persistable variables in `root` are shared, except the
+  // ones of `var_names`, which are copied into the private exec scope.
+  LightPredictor(const std::shared_ptr<cpp::ProgramDesc>& program_desc,
+                 const std::shared_ptr<Scope>& root,
+                 const std::vector<std::string>& var_names = {},
+                 const std::shared_ptr<LazyWeights>& lazy_weights = nullptr)
+      : scope_(root), program_desc_(program_desc), lazy_weights_(lazy_weights) {
+    CHECK(program_desc_) << "The ProgramDesc can not be nullptr in Clone mode.";
+    CHECK(scope_) << "The Scope can not be nullptr in Clone mode.";
+    BuildRuntimeProgram(program_desc_, var_names);
+    PrepareFeedFetch();
+  }
+
+  // Create a predictor from the current one, the cloned predictor shares the
+  // persistable variables in scope_ but the ones of `var_names`, and only
+  // allocates a new exec scope for the activations.
+  std::unique_ptr<LightPredictor> Clone(
+      const std::vector<std::string>& var_names = {}) {
+    // The copied weights must be decoded first.
+    if (lazy_weights_ && !var_names.empty()) lazy_weights_->MaterializeAll();
+    return std::unique_ptr<LightPredictor>(
+        new LightPredictor(program_desc_, scope_, var_names, lazy_weights_));
+  }
+
   void Run() {
+    io_binding_.Apply();
+    stream_states_.Apply();
     CheckInputValid();
+    uint64_t start = MonotonicNanos();
     program_->Run();
+    io_binding_.Sync();
+    stream_states_.Sync();
     if (bool_clear_tensor_) ClearTensorArray(program_desc_);
+    if (!cold_start_.first_run_ns) {
+      cold_start_.first_run_ns = MonotonicNanos() - start;
+    }
   }
 
+  // Run the requests in a pipeline of the segments of the program on the
+  // different devices, see RuntimeProgram::RunPipelined. The inputs and
+  // outputs can not be bound.
+  void RunPipelined(size_t requests,
+                    const std::function<void(size_t)>& feed,
+                    const std::function<void(size_t)>& fetch);
+
   /// \brief Release all tmp tensor to compress the size of the memory pool.
   /// The memory pool is considered to be composed of a list of chunks, if
   /// the chunk is not occupied, it can be released.
@@ -75,6 +155,29 @@ class LITE_API LightPredictor {
   /// \return a boolean variable.
   bool TryShrinkMemory();
 
+  /// \brief Get the peak memory of the input-shape buckets planned in the
+  /// memory arena, which is enabled by LITE_MEMORY_ARENA.
+  std::vector<MemoryPlanStats> GetMemoryPlanStats() const {
+    return program_->memory_plan_stats();
+  }
+
+  /// \brief Fill the kernel runs, the peak arena and the cold start of the
+  /// predictor.
+  void CollectRuntimeStats(lite_api::RuntimeStats* stats) const {
+    program_->CollectRuntimeStats(stats);
+    stats->cold_start = cold_start_;
+  }
+
+  /// \brief Record the kernel latencies into `table`, see LatencyTable.
+  void SetLatencyTable(LatencyTable* table, int threads) {
+    program_->SetLatencyTable(table, threads);
+  }
+  double EstimateLatency(const LatencyTable& table,
+                         int threads,
+                         int* missing) {
+    return program_->EstimateLatency(table, threads, missing);
+  }
+
   // Get offset-th col of feed inputs.
   Tensor* GetInput(size_t offset);
   // get input by name.
@@ -84,6 +187,42 @@ class LITE_API LightPredictor {
   // Get offset-th col of fetch outputs.
   const Tensor* GetOutput(size_t offset);
 
+  // Bind the caller-owned host buffers to the offset-th input and output,
+  // which are read and written in place by the following runs.
+  void BindInput(size_t offset,
+                 void* data,
+                 size_t memory_size,
+                 const DDim& dims,
+                 PrecisionType precision) {
+    io_binding_.BindInput(GetInput(offset), data, memory_size, dims, precision);
+  }
+  void BindOutput(size_t offset, void* data, size_t memory_size) {
+    CHECK_LT(offset, output_names_.size())
+        << "offset " << offset << " overflow";
+    io_binding_.BindOutput(
+        program_->exec_scope()->FindMutableTensor(output_names_[offset]),
+        data,
+        memory_size);
+  }
+
+  // Feed the state inputs by the state outputs of the previous run of the
+  // same stream, see StreamStates.
+  void SetStreamStates(const std::vector<std::string>& state_inputs,
+                       const std::vector<std::string>& state_outputs) {
+    CHECK_EQ(state_inputs.size(), state_outputs.size())
+        << "Every state input requires a state output";
+    stream_states_.Clear();
+    auto* scope = program_->exec_scope();
+    for (size_t i = 0; i < state_inputs.size(); i++) {
+      auto* input = scope->FindMutableTensor(state_inputs[i]);
+      auto* output = scope->FindMutableTensor(state_outputs[i]);
+      CHECK(input) << "No state input " << state_inputs[i];
+      CHECK(output) << "No state output " << state_outputs[i];
+      stream_states_.AddState(input, output);
+    }
+  }
+  StreamStates* stream_states() { return &stream_states_; }
+
   const lite::Tensor* GetTensor(const std::string& name) const {
     auto* var = program_->exec_scope()->FindVar(name);
     CHECK(var) << "no fatch variable " << name << " in exec_scope";
@@ -114,7 +253,11 @@ class LITE_API LightPredictor {
   void CheckInputValid();
 
   void Build(const std::string& lite_model_file,
-             bool model_from_memory = false);
+             bool model_from_memory = false,
+             bool model_mmap = false,
+             bool lazy_load_weights = false,
+             bool share_weights = false,
+             const std::string& shared_memory_weights = "");
 
   // NOTE: This is a deprecated API and will be removed in latter release.
   void Build(
@@ -125,7 +268,27 @@ class LITE_API LightPredictor {
       bool model_from_memory = false);
 
   void BuildRuntimeProgram(
-      const std::shared_ptr<const cpp::ProgramDesc>& program_desc);
+      const std::shared_ptr<const cpp::ProgramDesc>& program_desc,
+      const std::vector<std::string>& vars_to_clone = {});
+
+  // Find the root ops owning the sub blocks for the lazy weights.
+  void PrepareLazyWeights();
+  // Dequantize the weights and convert them to fp16, which is done in
+  // parallel on the thread pool of the current thread.
+  void DecodeWeights();
+  // Decode the weight of the op_idx-th op in the block_idx-th block in
+  // DecodeWeights, or defer it to the first run of the op in the lazy mode.
+  void AddWeightDecoder(size_t block_idx,
+                        size_t op_idx,
+                        const std::string& weight_name,
+                        const std::function<void()>& decoder);
+
+  // Share the decoded weights through SharedWeightStore.
+  void ShareWeights();
+  // Share the decoded weights through the shared memory region `name`.
+  void ShareWeightsThroughSharedMemory(const std::string& name);
+  // The names of the weights loaded lazily, which are not shared.
+  std::set<std::string> LazyWeightNames() const;
 
   void DequantizeWeight();
 
@@ -133,6 +296,11 @@ class LITE_API LightPredictor {
   void WeightFP32ToFP16();
 #endif
 
+#ifdef LITE_WITH_ARM
+  // Convert the weights marked by bf16_attribute_pass to bf16.
+  void WeightFP32ToBF16();
+#endif
+
   void ClearTensorArray(
       const std::shared_ptr<const cpp::ProgramDesc>& program_desc);
 
@@ -142,20 +310,51 @@ class LITE_API LightPredictor {
   std::shared_ptr<cpp::ProgramDesc> program_desc_;
   std::vector<std::string> input_names_;
   std::vector<std::string> output_names_;
+  // the variables of input_names_ and output_names_ in the exec scope
+  std::vector<Variable*> input_vars_;
+  std::vector<Variable*> output_vars_;
   std::vector<PrecisionType> input_precisions_;
   bool bool_clear_tensor_ = false;
+  IoBinding io_binding_;
+  StreamStates stream_states_;
+  lite_api::RuntimeStats::ColdStartStats cold_start_;
+  std::shared_ptr<LazyWeights> lazy_weights_;
+  // Whether the weights are mapped from the model file, which are read ahead
+  // of the first run of the ops using them.
+  bool model_mmap_{false};
+  // The decoders of the weights not loaded lazily, grouped by the weights.
+  std::map<std::string, std::vector<std::function<void()>>> pending_decoders_;
 };
 
 class LightPredictorImpl : public lite_api::PaddlePredictor {
  public:
   LightPredictorImpl() = default;
+  // Only be called in Clone.
+  explicit LightPredictorImpl(std::unique_ptr<LightPredictor> raw_predictor)
+      : raw_predictor_(std::move(raw_predictor)) {}
   virtual ~LightPredictorImpl();
   std::unique_ptr<lite_api::Tensor> GetInput(int i) override;
   std::unique_ptr<const lite_api::Tensor> GetOutput(int i) const override;
+  void BindInput(int i,
+                 void* data,
+                 size_t memory_size,
+                 const lite_api::shape_t& shape,
+                 PrecisionType precision) override;
+  void BindOutput(int i, void* data, size_t memory_size) override;
+  void SetStreamStates(const std::vector<std::string>& state_inputs,
+                       const std::vector<std::string>& state_outputs) override;
+  void SelectStream(int64_t id) override;
+  void ResetStream(int64_t id) override;
+  void ReleaseStream(int64_t id) override;
+  bool IsNNAdapterShapeReady(
+      const std::map<std::string, lite_api::shape_t>& input_shapes) override;
   std::unique_ptr<lite_api::Tensor> GetInputByName(const std::string& name);
   std::unique_ptr<const lite_api::Tensor> GetOutputByName(
       const std::string& name) const;
   void Run() override;
+  void RunPipelined(int requests,
+                    const std::function<void(int)>& feed,
+                    const std::function<void(int)>& fetch) override;
 
   std::shared_ptr<lite_api::PaddlePredictor> Clone() override;
   std::shared_ptr<lite_api::PaddlePredictor> Clone(
@@ -175,9 +374,38 @@ class LightPredictorImpl : public lite_api::PaddlePredictor {
   ///
   /// \return a boolean variable.
   bool TryShrinkMemory() override;
+  lite_api::RuntimeStats GetRuntimeStats() override;
+  void StartOpLatencyRecording() override;
+  bool StopOpLatencyRecording(const std::string& path) override;
+  double EstimateLatency(const std::string& path,
+                         int* missing = nullptr) override;
 
  private:
+  // Apply the runtime configurations of this predictor, which are shared by
+  // the cloned ones.
+  void InitRuntime(lite_api::PowerMode mode,
+                   int threads,
+                   const std::string& thread_pool_key,
+                   bool adaptive_threads,
+                   lite_api::RunPriority priority,
+                   bool fast_math);
+  // Call `run` with the runtime configurations applied to this thread.
+  void RunOnRuntime(const std::function<void()>& run);
+
   std::unique_ptr<lite::LightPredictor> raw_predictor_;
+  // The thread pool used by the parallel kernels of this predictor.
+  std::shared_ptr<ThreadPool> thread_pool_;
+  std::string thread_pool_key_;
+  lite_api::RunPriority priority_{lite_api::LITE_PRIORITY_NORMAL};
+  // Keeps the priority of this predictor registered.
+  std::shared_ptr<void> priority_handle_;
+  // Whether the runs use the fast approximations, see FastMath.
+  bool fast_math_{false};
+  // Adjusts the threads between the runs, null if disabled.
+  std::unique_ptr<AdaptiveThreads> adaptive_threads_;
+  std::string packed_weight_cache_file_;
+  std::unique_ptr<LatencyTable> latency_table_;
+  std::mutex mutex_;
 };
 
 }  // namespace lite
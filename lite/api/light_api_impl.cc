@@ -16,12 +16,17 @@
 #include <string>
 #include "lite/api/paddle_api.h"
 #include "lite/core/version.h"
+#include "lite/utils/timer.h"
 #include "lite/model_parser/model_parser.h"
 #ifndef LITE_ON_TINY_PUBLISH
 #include "lite/api/paddle_use_kernels.h"
 #include "lite/api/paddle_use_ops.h"
 #endif
+#include "lite/core/kernel_tuner.h"
+#include "lite/core/packed_weight_cache.h"
 #include "lite/core/parallel_defines.h"
+#include "lite/core/fast_math.h"
+#include "lite/core/run_priority.h"
 #include "lite/core/thread_pool.h"
 
 #if (defined LITE_WITH_X86) && (defined PADDLE_WITH_MKLML) && \
@@ -33,6 +38,28 @@ namespace paddle {
 namespace lite {
 
 void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
+  std::string thread_pool_key;
+  if (config.share_thread_pool()) {
+    thread_pool_key =
+        "threads:" + std::to_string(config.threads()) + ",power_mode:" +
+        std::to_string(static_cast<int>(config.power_mode()));
+  }
+  InitRuntime(config.power_mode(),
+              config.threads(),
+              thread_pool_key,
+              config.adaptive_threads(),
+              config.run_priority(),
+              config.fast_math());
+#ifdef LITE_USE_THREAD_POOL
+  // The weights are decoded on the thread pool of this predictor.
+  ThreadPoolGuard thread_pool_guard(thread_pool_.get());
+#endif
+
+  packed_weight_cache_file_ = config.packed_weight_cache_file();
+  if (!packed_weight_cache_file_.empty()) {
+    PackedWeightCache::Global().Load(packed_weight_cache_file_);
+  }
+
   // LightPredictor Only support NaiveBuffer backend in publish lib
   if (config.lite_model_file().empty()) {
     raw_predictor_.reset(
@@ -43,16 +70,12 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
                            lite_api::LiteModelType::kNaiveBuffer));
   } else {
     raw_predictor_.reset(new LightPredictor(config.lite_model_file(),
-                                            config.is_model_from_memory()));
-  }
-  mode_ = config.power_mode();
-  threads_ = config.threads();
-#ifdef LITE_USE_THREAD_POOL
-  int thread_num = ThreadPool::Init(threads_);
-  if (thread_num > 1) {
-    ThreadPool::AcquireThreadPool();
+                                            config.is_model_from_memory(),
+                                            config.model_mmap(),
+                                            config.lazy_load_weights(),
+                                            config.share_weights(),
+                                            config.shared_memory_weights()));
   }
-#endif
 
 #ifdef LITE_WITH_METAL
   raw_predictor_->ConfigMetalContext(config);
@@ -78,6 +101,8 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
       raw_predictor_->scope(), config.nnadapter_model_cache_buffers());
   Context<TargetType::kNNAdapter>::SetNNAdapterDynamicShapeInfo(
       raw_predictor_->scope(), config.nnadapter_dynamic_shape_info());
+  Context<TargetType::kNNAdapter>::SetNNAdapterPrecompileDynamicShapes(
+      raw_predictor_->scope(), config.nnadapter_precompile_dynamic_shapes());
 #endif
 
 #if (defined LITE_WITH_X86) && (defined PADDLE_WITH_MKLML) && \
@@ -95,12 +120,31 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
 #endif
 }
 
-LightPredictorImpl::~LightPredictorImpl() {
+void LightPredictorImpl::InitRuntime(lite_api::PowerMode mode,
+                                     int threads,
+                                     const std::string& thread_pool_key,
+                                     bool adaptive_threads,
+                                     lite_api::RunPriority priority,
+                                     bool fast_math) {
+  mode_ = mode;
+  threads_ = threads;
+  thread_pool_key_ = thread_pool_key;
+  priority_ = priority;
+  fast_math_ = fast_math;
+  priority_handle_ = RunPriorityArbiter::Global().Register(priority_);
 #ifdef LITE_USE_THREAD_POOL
-  ThreadPool::ReleaseThreadPool();
+  thread_pool_ =
+      ThreadPool::Create(threads_, ThreadPoolMode::kPark, thread_pool_key_);
+#endif
+#ifdef LITE_WITH_ARM
+  if (adaptive_threads) {
+    adaptive_threads_.reset(new AdaptiveThreads(threads_));
+  }
 #endif
 }
 
+LightPredictorImpl::~LightPredictorImpl() {}
+
 std::unique_ptr<lite_api::Tensor> LightPredictorImpl::GetInputByName(
     const std::string& name) {
   return std::unique_ptr<lite_api::Tensor>(
@@ -124,22 +168,125 @@ std::unique_ptr<const lite_api::Tensor> LightPredictorImpl::GetOutput(
       new lite_api::Tensor(raw_predictor_->GetOutput(i)));
 }
 
+void LightPredictorImpl::BindInput(int i,
+                                   void* data,
+                                   size_t memory_size,
+                                   const lite_api::shape_t& shape,
+                                   PrecisionType precision) {
+  raw_predictor_->BindInput(i, data, memory_size, DDim(shape), precision);
+}
+
+void LightPredictorImpl::BindOutput(int i, void* data, size_t memory_size) {
+  raw_predictor_->BindOutput(i, data, memory_size);
+}
+
+void LightPredictorImpl::SetStreamStates(
+    const std::vector<std::string>& state_inputs,
+    const std::vector<std::string>& state_outputs) {
+  raw_predictor_->SetStreamStates(state_inputs, state_outputs);
+}
+
+void LightPredictorImpl::SelectStream(int64_t id) {
+  raw_predictor_->stream_states()->Select(id);
+}
+
+void LightPredictorImpl::ResetStream(int64_t id) {
+  raw_predictor_->stream_states()->Reset(id);
+}
+
+void LightPredictorImpl::ReleaseStream(int64_t id) {
+  raw_predictor_->stream_states()->Release(id);
+}
+
+bool LightPredictorImpl::IsNNAdapterShapeReady(
+    const std::map<std::string, lite_api::shape_t>& input_shapes) {
+#ifdef LITE_WITH_NNADAPTER
+  return Context<TargetType::kNNAdapter>::NNAdapterShapeReady(
+      raw_predictor_->scope(), input_shapes);
+#else
+  return true;
+#endif
+}
+
 void LightPredictorImpl::Run() {
+  RunOnRuntime([this]() { raw_predictor_->Run(); });
+}
+
+void LightPredictorImpl::RunPipelined(int requests,
+                                      const std::function<void(int)>& feed,
+                                      const std::function<void(int)>& fetch) {
+  RunOnRuntime([&]() {
+    raw_predictor_->RunPipelined(
+        requests,
+        [&](size_t i) { feed(static_cast<int>(i)); },
+        [&](size_t i) { fetch(static_cast<int>(i)); });
+  });
+}
+
+void LightPredictorImpl::RunOnRuntime(const std::function<void()>& run) {
+  RunPriorityArbiter::Scope priority_scope(priority_);
+  FastMath::Scope fast_math_scope(fast_math_);
+#ifdef LITE_WITH_ARM
+  int threads = adaptive_threads_ ? adaptive_threads_->threads() : threads_;
+  lite::DeviceInfo::Global().SetRunMode(
+      RunPriorityArbiter::Global().ReserveCores(priority_, mode_), threads);
+  uint64_t start_us = lite::Timer::GetCurrentUS();
+#endif
+#ifdef LITE_USE_THREAD_POOL
+  ThreadPoolGuard thread_pool_guard(thread_pool_.get());
 #ifdef LITE_WITH_ARM
-  lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
+  if (thread_pool_) {
+    ThreadPool::SetActiveThreads(lite::DeviceInfo::Global().threads());
+  }
+  if (thread_pool_ &&
+      lite::DeviceInfo::Global().mode() != lite_api::LITE_POWER_NO_BIND) {
+    thread_pool_->SetAffinity(lite::DeviceInfo::Global().active_ids());
+    thread_pool_->SetCapacity(lite::DeviceInfo::Global().active_capacities());
+  }
+#endif
+#endif
+  run();
+#ifdef LITE_WITH_ARM
+  if (adaptive_threads_) {
+    adaptive_threads_->Update(lite::Timer::GetCurrentUS() - start_us, []() {
+      return lite::DeviceInfo::Global().active_cores_throttled();
+    });
+  }
 #endif
-  raw_predictor_->Run();
+  // Save the weights packed by the kernels run for the first time, which is
+  // skipped if nothing new is packed.
+  if (!packed_weight_cache_file_.empty()) {
+    PackedWeightCache::Global().Save(packed_weight_cache_file_);
+  }
+  // Save the kernels tuned in this run, if any.
+  KernelTuner::Global().Save();
 }
 
 std::shared_ptr<lite_api::PaddlePredictor> LightPredictorImpl::Clone() {
-  LOG(FATAL) << "The Clone API is not supported in LigthPredictor";
-  return nullptr;
+  return Clone(std::vector<std::string>());
 }
 
 std::shared_ptr<lite_api::PaddlePredictor> LightPredictorImpl::Clone(
     const std::vector<std::string>& var_names) {
-  LOG(FATAL) << "The Clone API is not supported in LigthPredictor";
+#ifdef LITE_WITH_METAL
+  LOG(FATAL) << "The Clone API is not supported in LigthPredictor with Metal";
   return nullptr;
+#else
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK(raw_predictor_) << "The Predictor can not be nullptr in Clone mode.";
+  // The model-level configurations of NPU and NNAdapter are stored in the
+  // shared root scope, so only the runtime ones need to be applied again.
+  auto predictor = std::make_shared<LightPredictorImpl>(
+      raw_predictor_->Clone(var_names));
+  predictor->InitRuntime(mode_,
+                         threads_,
+                         thread_pool_key_,
+                         adaptive_threads_ != nullptr,
+                         priority_,
+                         fast_math_);
+  predictor->packed_weight_cache_file_ = packed_weight_cache_file_;
+  return predictor;
+#endif
 }
 
 std::string LightPredictorImpl::GetVersion() const { return lite::version(); }
@@ -162,6 +309,32 @@ bool LightPredictorImpl::TryShrinkMemory() {
   return raw_predictor_->TryShrinkMemory();
 }
 
+lite_api::RuntimeStats LightPredictorImpl::GetRuntimeStats() {
+  auto stats = lite_api::PaddlePredictor::GetRuntimeStats();
+  raw_predictor_->CollectRuntimeStats(&stats);
+  return stats;
+}
+
+void LightPredictorImpl::StartOpLatencyRecording() {
+  latency_table_.reset(new LatencyTable);
+  raw_predictor_->SetLatencyTable(latency_table_.get(), threads_);
+}
+
+bool LightPredictorImpl::StopOpLatencyRecording(const std::string& path) {
+  CHECK(latency_table_) << "The op latency recording is not started";
+  raw_predictor_->SetLatencyTable(nullptr, threads_);
+  bool saved = latency_table_->Save(path);
+  latency_table_.reset();
+  return saved;
+}
+
+double LightPredictorImpl::EstimateLatency(const std::string& path,
+                                           int* missing) {
+  LatencyTable table;
+  CHECK(table.Load(path)) << "Failed to load the op latency table " << path;
+  return raw_predictor_->EstimateLatency(table, threads_, missing);
+}
+
 }  // namespace lite
 
 namespace lite_api {
@@ -14,13 +14,31 @@
 
 #include "lite/api/paddle_api.h"
 
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <mutex>  // NOLINT
+#include <numeric>
+#include <string>
 #include <utility>
 
+#include "lite/backends/host/memory_pool.h"
+#include "lite/core/async_executor.h"
 #include "lite/core/context.h"
 #include "lite/core/device_info.h"
+#include "lite/core/kernel_tuner.h"
+#include "lite/core/profile/timeline.h"
+#include "lite/core/run_control.h"
+#include "lite/core/runtime_stats.h"
 #include "lite/core/target_wrapper.h"
 #include "lite/core/tensor.h"
 
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #ifdef LITE_WITH_CUDA
 #include "lite/backends/cuda/target_wrapper.h"
 #endif
@@ -36,12 +54,18 @@
 
 #ifdef LITE_WITH_OPENCL
 #include "lite/backends/opencl/cl_runtime.h"
+#include "lite/backends/opencl/target_wrapper.h"
 #endif
 
 #ifdef LITE_WITH_METAL
 #include "lite/backends/metal/target_wrapper.h"
 #endif
 
+#ifdef LITE_WITH_VULKAN
+#include "lite/backends/vulkan/vk_runtime.h"
+#include "lite/backends/vulkan/vk_wrapper.h"
+#endif
+
 namespace paddle {
 namespace lite_api {
 
@@ -82,6 +106,26 @@ int GetOpenCLDeviceType() {
   return -1;
 }
 
+bool IsVulkanBackendValid() {
+#ifdef LITE_WITH_VULKAN
+  auto *wrapper = paddle::lite::VKWrapper::Global();
+  if (!wrapper->VulkanLibFound() || !wrapper->DlsymSuccess()) return false;
+  return paddle::lite::VKRuntime::Global()->IsInitSuccess();
+#else
+  return false;
+#endif
+}
+
+void StartTimelineProfiling(size_t capacity) {
+  lite::profile::Timeline::Global().Start(capacity);
+}
+
+std::string StopTimelineProfiling() {
+  auto &timeline = lite::profile::Timeline::Global();
+  timeline.Stop();
+  return timeline.ExportChromeTrace();
+}
+
 Tensor::Tensor(void *raw) : raw_tensor_(raw) {}
 
 // TODO(Superjomn) refine this by using another `const void* const_raw`;
@@ -277,6 +321,165 @@ lod_t Tensor::lod() const { return ctensor(raw_tensor_)->lod(); }
 
 void Tensor::SetLoD(const lod_t &lod) { tensor(raw_tensor_)->set_lod(lod); }
 
+PaddlePredictor::PaddlePredictor()
+    : async_strand_(std::make_shared<lite::AsyncExecutor::Strand>()) {}
+
+void PaddlePredictor::RunAsync(std::function<void()> callback) {
+  auto strand =
+      std::static_pointer_cast<lite::AsyncExecutor::Strand>(async_strand_);
+  lite::AsyncExecutor::Global().Submit(strand, [this, callback]() {
+    Run();
+    if (callback) {
+      callback();
+    }
+  });
+}
+
+bool PaddlePredictor::RunWithOptions(const RunOptions &options) {
+  // The runtime programs run on the calling thread check the control.
+  lite::RunControl control(options.deadline, options.cancelled);
+  lite::RunControl::Scope scope(&control);
+  Run();
+  return !control.stopped();
+}
+
+std::future<void> PaddlePredictor::RunAsync() {
+  auto promise = std::make_shared<std::promise<void>>();
+  auto future = promise->get_future();
+  auto strand =
+      std::static_pointer_cast<lite::AsyncExecutor::Strand>(async_strand_);
+  lite::AsyncExecutor::Global().Submit(strand, [this, promise]() {
+#ifdef LITE_WITH_EXCEPTION
+    try {
+      Run();
+    } catch (...) {
+      promise->set_exception(std::current_exception());
+      return;
+    }
+#else
+    Run();
+#endif
+    promise->set_value();
+  });
+  return future;
+}
+
+namespace {
+template <typename T>
+void FillZeros(Tensor *tensor, int64_t numel) {
+  std::fill_n(tensor->mutable_data<T>(), numel, T());
+}
+
+// Fill the inputs with the zeros of `shapes`, keeping their precisions.
+void SetWarmupInputs(PaddlePredictor *predictor,
+                     const std::vector<shape_t> &shapes) {
+  for (size_t i = 0; i < shapes.size(); i++) {
+    auto input = predictor->GetInput(static_cast<int>(i));
+    input->Resize(shapes[i]);
+    int64_t numel = std::accumulate(shapes[i].begin(),
+                                    shapes[i].end(),
+                                    static_cast<int64_t>(1),
+                                    std::multiplies<int64_t>());
+    switch (input->precision()) {
+      case PrecisionType::kInt64:
+        FillZeros<int64_t>(input.get(), numel);
+        break;
+      case PrecisionType::kInt32:
+        FillZeros<int32_t>(input.get(), numel);
+        break;
+      case PrecisionType::kInt8:
+        FillZeros<int8_t>(input.get(), numel);
+        break;
+      case PrecisionType::kUInt8:
+        FillZeros<uint8_t>(input.get(), numel);
+        break;
+      case PrecisionType::kBool:
+        FillZeros<bool>(input.get(), numel);
+        break;
+      default:
+        FillZeros<float>(input.get(), numel);
+        break;
+    }
+  }
+}
+}  // namespace
+
+std::future<void> PaddlePredictor::Warmup(
+    const std::vector<std::vector<shape_t>> &shape_sets) {
+  auto promise = std::make_shared<std::promise<void>>();
+  auto future = promise->get_future();
+  auto warmup = [this, shape_sets, promise]() {
+    auto run = [&]() {
+      for (auto &shapes : shape_sets) {
+        SetWarmupInputs(this, shapes);
+        Run();
+      }
+    };
+#ifdef LITE_WITH_EXCEPTION
+    try {
+      run();
+    } catch (...) {
+      promise->set_exception(std::current_exception());
+      return;
+    }
+#else
+    run();
+#endif
+    promise->set_value();
+  };
+#ifdef LITE_WITH_OPENCL
+  // The OpenCL runtime is bound to the calling thread.
+  warmup();
+#else
+  auto strand =
+      std::static_pointer_cast<lite::AsyncExecutor::Strand>(async_strand_);
+  lite::AsyncExecutor::Global().Submit(strand, warmup);
+#endif
+  return future;
+}
+
+std::shared_ptr<PaddlePredictor> PaddlePredictor::CloneOnNumaNode(int node) {
+  LOG(WARNING) << "The NUMA placement is only supported by the x86 "
+                  "predictors of CxxConfig, fall back to Clone()";
+  return Clone();
+}
+
+RuntimeStats PaddlePredictor::GetRuntimeStats() {
+  RuntimeStats stats;
+  auto &pool = lite::host::MemoryPool::Global();
+  stats.allocated_bytes = pool.allocated_size();
+  stats.peak_used_bytes = pool.peak_used_size();
+  auto &global = lite::RuntimeStats::Global();
+  stats.thread_pool_busy_ns = global.thread_pool_busy_ns.value();
+  stats.thread_pool_idle_ns = global.thread_pool_idle_ns.value();
+  auto CopyCacheStats = [](const lite::CacheCounter &counter,
+                           RuntimeStats::CacheStats *cache_stats) {
+    cache_stats->hits = counter.hits.value();
+    cache_stats->misses = counter.misses.value();
+  };
+  CopyCacheStats(global.opencl_tune_cache, &stats.opencl_tune_cache);
+  CopyCacheStats(global.opencl_memory_pool, &stats.opencl_memory_pool);
+  CopyCacheStats(global.kernel_tune_cache, &stats.kernel_tune_cache);
+  CopyCacheStats(global.nnadapter_model_cache, &stats.nnadapter_model_cache);
+  CopyCacheStats(global.infer_shape_cache, &stats.infer_shape_cache);
+  return stats;
+}
+
+void PaddlePredictor::StartOpLatencyRecording() {
+  LOG(FATAL) << "The op latency table is not supported by this predictor.";
+}
+
+bool PaddlePredictor::StopOpLatencyRecording(const std::string &path) {
+  LOG(FATAL) << "The op latency table is not supported by this predictor.";
+  return false;
+}
+
+double PaddlePredictor::EstimateLatency(const std::string &path,
+                                        int *missing) {
+  LOG(FATAL) << "The op latency table is not supported by this predictor.";
+  return 0;
+}
+
 std::unique_ptr<Tensor> PaddlePredictor::GetMutableTensor(
     const std::string &name) {
   LOG(FATAL)
@@ -284,6 +487,51 @@ std::unique_ptr<Tensor> PaddlePredictor::GetMutableTensor(
   return nullptr;
 }
 
+void PaddlePredictor::BindInput(int i,
+                                void *data,
+                                size_t memory_size,
+                                const shape_t &shape,
+                                PrecisionType precision) {
+  LOG(FATAL) << "The BindInput API is not supported by this predictor.";
+}
+
+void PaddlePredictor::RunPipelined(int requests,
+                                   const std::function<void(int)> &feed,
+                                   const std::function<void(int)> &fetch) {
+  for (int i = 0; i < requests; i++) {
+    feed(i);
+    Run();
+    fetch(i);
+  }
+}
+
+void PaddlePredictor::BindOutput(int i, void *data, size_t memory_size) {
+  LOG(FATAL) << "The BindOutput API is not supported by this predictor.";
+}
+
+void PaddlePredictor::SetStreamStates(
+    const std::vector<std::string> &state_inputs,
+    const std::vector<std::string> &state_outputs) {
+  LOG(FATAL) << "The stream states are not supported by this predictor.";
+}
+
+void PaddlePredictor::SelectStream(int64_t id) {
+  LOG(FATAL) << "The stream states are not supported by this predictor.";
+}
+
+void PaddlePredictor::ResetStream(int64_t id) {
+  LOG(FATAL) << "The stream states are not supported by this predictor.";
+}
+
+void PaddlePredictor::ReleaseStream(int64_t id) {
+  LOG(FATAL) << "The stream states are not supported by this predictor.";
+}
+
+bool PaddlePredictor::IsNNAdapterShapeReady(
+    const std::map<std::string, shape_t> &input_shapes) {
+  return true;
+}
+
 std::vector<std::string> PaddlePredictor::GetParamNames() {
   std::vector<std::string> null_result = {};
   LOG(FATAL)
@@ -347,6 +595,14 @@ void ConfigBase::set_opencl_tune(CLTuneMode tune_mode,
 #endif
 }
 
+void ConfigBase::set_arm_tune(ARMTuneMode tune_mode, const std::string &path) {
+  lite::KernelTuner::Global().SetTuneMode(tune_mode, path);
+#ifdef LITE_WITH_LOG
+  LOG(INFO) << "set arm_tune_mode: " << ARMTuneModeToStr(tune_mode)
+            << ", tuned file: " << path;
+#endif
+}
+
 void ConfigBase::set_opencl_precision(CLPrecisionType p) {
 #ifdef LITE_WITH_OPENCL
   if (paddle::lite_api::IsOpenCLBackendValid()) {
@@ -361,6 +617,33 @@ void ConfigBase::set_opencl_precision(CLPrecisionType p) {
 #endif
 }
 
+void ConfigBase::set_opencl_memory_pool(bool enable, size_t max_cached_mb) {
+#ifdef LITE_WITH_OPENCL
+  opencl_memory_pool_ = enable;
+  lite::CLMemoryPool::set_capacity(max_cached_mb << 20);
+  lite::CLMemoryPool::set_enabled(enable);
+#endif
+}
+
+void ConfigBase::set_opencl_dynamic_shape_info(
+    const std::map<std::string, std::vector<shape_t>>
+        &opencl_dynamic_shape_info) {
+  opencl_dynamic_shape_info_ = opencl_dynamic_shape_info;
+#ifdef LITE_WITH_OPENCL
+  if (paddle::lite_api::IsOpenCLBackendValid()) {
+    lite::CLRuntime::Global()->set_tune_shape_buckets(
+        !opencl_dynamic_shape_info.empty());
+  }
+#endif
+}
+
+void ConfigBase::set_vulkan_pipeline_cache_path(const std::string &path) {
+  vulkan_pipeline_cache_path_ = path;
+#ifdef LITE_WITH_VULKAN
+  lite::VKRuntime::set_pipeline_cache_path(path);
+#endif
+}
+
 void ConfigBase::set_power_mode(paddle::lite_api::PowerMode mode) {
 #ifdef LITE_WITH_ARM
   lite::DeviceInfo::Global().SetRunMode(mode, threads_);
@@ -369,6 +652,19 @@ void ConfigBase::set_power_mode(paddle::lite_api::PowerMode mode) {
 #endif
 }
 
+void ConfigBase::set_host_memory_pool(bool enable, bool use_huge_page) {
+  host_memory_pool_ = enable;
+  host_memory_huge_page_ = use_huge_page;
+  lite::host::MemoryPool::Global().set_use_huge_page(use_huge_page);
+  lite::host::MemoryPool::Global().set_enabled(enable);
+}
+
+void ConfigBase::set_host_allocator(
+    const std::function<void*(size_t)> &malloc_func,
+    const std::function<void(void *)> &free_func) {
+  lite::host::MemoryPool::Global().set_allocator(malloc_func, free_func);
+}
+
 void ConfigBase::set_threads(int threads) {
 #ifdef LITE_WITH_ARM
   lite::DeviceInfo::Global().SetRunMode(mode_, threads);
@@ -625,6 +921,16 @@ void CxxConfig::set_xpu_conv_autotune(bool autotune,
 #endif
 }
 
+void CxxConfig::set_xpu_l3_autotune_file(const std::string &autotune_file) {
+#ifdef LITE_WITH_XPU
+  lite::TargetWrapperXPU::l3_autotune_file = autotune_file;
+#else
+  LOG(WARNING) << "The invoking of the function "
+                  "'set_xpu_l3_autotune_file' is ignored, please "
+                  "rebuild it with LITE_WITH_XPU=ON.";
+#endif
+}
+
 template <class T>
 void CxxConfig::set_preferred_inputs_for_warmup(const int group_idx,
                                                 const int tensor_idx,
@@ -711,5 +1017,202 @@ void MobileConfig::SetArmL3CacheSize(L3CacheSetMethod method,
 #endif
 }
 
+namespace {
+struct PredictorPoolState {
+  std::mutex mutex;
+  // The number of the requests running or waiting on each predictor
+  std::vector<int> loads;
+  std::vector<std::unique_ptr<std::mutex>> run_mutexes;
+  // Where to start looking for the least loaded predictor, which rotates
+  // among the predictors of the same load.
+  size_t next{0};
+};
+
+// Gives back the load of a predictor when the request leaves it, also when
+// feed, Run or fetch throws.
+class PredictorLoadGuard {
+ public:
+  PredictorLoadGuard(PredictorPoolState* state, size_t index)
+      : state_(state), index_(index) {}
+  ~PredictorLoadGuard() {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->loads[index_]--;
+  }
+
+ private:
+  PredictorPoolState* state_;
+  size_t index_;
+};
+}  // namespace
+
+PaddlePredictorPool::PaddlePredictorPool(
+    std::vector<std::shared_ptr<PaddlePredictor>> predictors)
+    : predictors_(std::move(predictors)) {
+  CHECK(!predictors_.empty()) << "No predictor in the pool";
+  auto state = std::make_shared<PredictorPoolState>();
+  state->loads.resize(predictors_.size(), 0);
+  for (size_t i = 0; i < predictors_.size(); i++) {
+    state->run_mutexes.emplace_back(new std::mutex);
+  }
+  state_ = state;
+}
+
+void PaddlePredictorPool::Run(
+    const std::function<void(PaddlePredictor*)>& feed,
+    const std::function<void(PaddlePredictor*)>& fetch) {
+  auto state = std::static_pointer_cast<PredictorPoolState>(state_);
+  size_t count = predictors_.size();
+  size_t index = 0;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    index = state->next % count;
+    for (size_t i = 1; i < count; i++) {
+      size_t j = (state->next + i) % count;
+      if (state->loads[j] < state->loads[index]) index = j;
+    }
+    state->loads[index]++;
+    state->next = index + 1;
+  }
+  PredictorLoadGuard load_guard(state.get(), index);
+  std::lock_guard<std::mutex> lock(*state->run_mutexes[index]);
+  auto* predictor = predictors_[index].get();
+  feed(predictor);
+  predictor->Run();
+  fetch(predictor);
+}
+
+std::string PaddlePredictorPool::DeviceContextProperties(
+    const ConfigBase &config, int device_id) {
+  const auto &device_names = config.nnadapter_device_names();
+  CHECK(!device_names.empty()) << "No NNAdapter device is set";
+  std::string key = device_names[0] + "_SELECTED_DEVICE_IDS";
+  std::transform(key.begin(), key.end(), key.begin(), ::toupper);
+  std::string properties = config.nnadapter_context_properties();
+  if (!properties.empty() && properties.back() != ';') properties += ";";
+  return properties + key + "=" + std::to_string(device_id) + ";";
+}
+
+namespace {
+struct HotSwapState {
+  mutable std::mutex mutex;
+  std::shared_ptr<PaddlePredictor> current;
+  // The reloads, one by one in the order of the calls
+  std::shared_ptr<lite::AsyncExecutor> reloader;
+  // The releases of the swapped-out predictors, at the lowest OS priority
+  std::shared_ptr<lite::AsyncExecutor> releaser;
+};
+
+// Lower the OS priority of the calling thread. It can't be raised back
+// without the privilege, and is inherited by the threads it spawns.
+void LowerThreadPriority() {
+#if defined(__linux__)
+  setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+#endif
+}
+
+// The predictor handed out by Get(), whose last holder hands `predictor` to
+// `releaser`, so its destruction doesn't land on a serving thread. Once the
+// HotSwapPredictor is gone, the last holder releases it.
+std::shared_ptr<PaddlePredictor> ReleaseInBackground(
+    std::shared_ptr<PaddlePredictor> predictor,
+    const std::shared_ptr<lite::AsyncExecutor> &releaser) {
+#ifdef LITE_WITH_OPENCL
+  // The OpenCL runtime is bound to the threads using it, the predictor is
+  // released by the last request holding it.
+  return predictor;
+#else
+  auto *raw = predictor.get();
+  std::weak_ptr<lite::AsyncExecutor> weak_releaser = releaser;
+  return std::shared_ptr<PaddlePredictor>(
+      raw, [predictor, weak_releaser](PaddlePredictor *) mutable {
+        auto releaser = weak_releaser.lock();
+        if (!releaser) {
+          predictor.reset();
+          return;
+        }
+        releaser->Submit([predictor]() mutable {
+          LowerThreadPriority();
+          predictor.reset();
+        });
+      });
+#endif
+}
+}  // namespace
+
+HotSwapPredictor::HotSwapPredictor(std::shared_ptr<PaddlePredictor> predictor) {
+  CHECK(predictor) << "The initial predictor can not be nullptr";
+  auto state = std::make_shared<HotSwapState>();
+#ifndef LITE_WITH_OPENCL
+  state->reloader = std::make_shared<lite::AsyncExecutor>(1);
+  state->releaser = std::make_shared<lite::AsyncExecutor>(1);
+#endif
+  state->current = ReleaseInBackground(std::move(predictor), state->releaser);
+  state_ = state;
+}
+
+HotSwapPredictor::~HotSwapPredictor() {
+  auto state = std::static_pointer_cast<HotSwapState>(state_);
+  // Drain and join the reloads first, which may hand predictors to the
+  // releaser.
+  state->reloader.reset();
+  state->releaser.reset();
+}
+
+std::shared_ptr<PaddlePredictor> HotSwapPredictor::Get() const {
+  auto state = std::static_pointer_cast<HotSwapState>(state_);
+  std::lock_guard<std::mutex> lock(state->mutex);
+  return state->current;
+}
+
+std::future<bool> HotSwapPredictor::Reload(
+    const std::function<std::shared_ptr<PaddlePredictor>()> &create,
+    const std::vector<std::vector<shape_t>> &warmup_shapes) {
+  auto state = std::static_pointer_cast<HotSwapState>(state_);
+  auto promise = std::make_shared<std::promise<bool>>();
+  auto future = promise->get_future();
+  auto reload = [state, create, warmup_shapes, promise]() {
+    std::shared_ptr<PaddlePredictor> old_predictor;
+    std::shared_ptr<PaddlePredictor> predictor;
+    auto build = [&]() {
+      predictor = create();
+      if (!predictor) return;
+      for (auto &shapes : warmup_shapes) {
+        SetWarmupInputs(predictor.get(), shapes);
+        predictor->Run();
+      }
+    };
+#ifdef LITE_WITH_EXCEPTION
+    try {
+      build();
+    } catch (...) {
+      promise->set_exception(std::current_exception());
+      return;
+    }
+#else
+    build();
+#endif
+    if (!predictor) {
+      LOG(WARNING) << "Failed to create the new predictor, keep the current "
+                      "one";
+      promise->set_value(false);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      old_predictor = std::move(state->current);
+      state->current =
+          ReleaseInBackground(std::move(predictor), state->releaser);
+    }
+    promise->set_value(true);
+  };
+#ifdef LITE_WITH_OPENCL
+  // The OpenCL runtime is bound to the calling thread.
+  reload();
+#else
+  state->reloader->Submit(reload);
+#endif
+  return future;
+}
+
 }  // namespace lite_api
 }  // namespace paddle
@@ -19,6 +19,10 @@
 
 #ifndef PADDLE_LITE_API_H_  // NOLINT
 #define PADDLE_LITE_API_H_
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <functional>
+#include <future>  // NOLINT
 #include <map>
 #include <memory>
 #include <string>
@@ -39,7 +43,9 @@ enum class L3CacheSetMethod {
   kDeviceL2Cache = 1,  // Use the system L2 Cache size, trade off performance
                        // with less memory consumption.
   kAbsolute = 2,       // Use the external setting.
-  // kAutoGrow = 3,   // Not supported yet, least memory consumption.
+  kAutoGrow = 3,       // Use the system L2 Cache size, and allocate the
+                       // workspace at the first use and grow it with the
+                       // requests, least memory consumption.
 };
 
 // return true if current device supports OpenCL model
@@ -50,6 +56,17 @@ LITE_API bool IsOpenCLBackendValid(bool check_fp16_valid = false);
 // UNKNOWN:0, QUALCOMM_ADRENO:1, ARM_MALI:2, IMAGINATION_POWERVR:3, OTHERS:4,
 LITE_API int GetOpenCLDeviceType();
 
+// return true if a Vulkan device with compute queues is available
+LITE_API bool IsVulkanBackendValid();
+
+// Start recording the kernel runs of all the predictors into a timeline which
+// keeps the latest `capacity` events.
+LITE_API void StartTimelineProfiling(size_t capacity = 65536);
+
+// Stop recording and return the timeline as a Chrome trace(JSON), which can be
+// loaded by chrome://tracing or Perfetto.
+LITE_API std::string StopTimelineProfiling();
+
 struct LITE_API Tensor {
   explicit Tensor(void* raw);
   explicit Tensor(const void* raw);
@@ -92,11 +109,62 @@ struct LITE_API Tensor {
   void* raw_tensor_;
 };
 
+/// The cumulative statistics which are always collected at runtime, only the
+/// ops and the arena are of the predictor, the others are of the process.
+struct LITE_API RuntimeStats {
+  struct OpStats {
+    std::string op_type;
+    uint64_t calls{0};
+    uint64_t time_ns{0};
+    /// The time spent in PrepareForRun, mostly by the first run.
+    uint64_t prepare_time_ns{0};
+  };
+  /// The phases of building the predictor and its first run, 0 if skipped,
+  /// e.g. no optimization for MobileConfig. Only the naive buffer models of
+  /// opt v2.7+ tell the reading apart, it's counted as parsing for the others.
+  struct ColdStartStats {
+    uint64_t read_file_ns{0};
+    uint64_t parse_ns{0};
+    uint64_t optimize_ns{0};
+    uint64_t create_kernels_ns{0};
+    uint64_t first_run_ns{0};
+  };
+  struct CacheStats {
+    uint64_t hits{0};
+    uint64_t misses{0};
+  };
+  /// The kernel runs of the predictor, aggregated by the op type.
+  std::vector<OpStats> ops;
+  ColdStartStats cold_start;
+  /// The largest memory arena of the predictor, see LITE_MEMORY_ARENA.
+  uint64_t peak_arena_bytes{0};
+  /// The host memory allocated in total and the peak of the memory in use.
+  uint64_t allocated_bytes{0};
+  uint64_t peak_used_bytes{0};
+  /// The time the workers of the thread pools spent on and between the tasks.
+  uint64_t thread_pool_busy_ns{0};
+  uint64_t thread_pool_idle_ns{0};
+  CacheStats opencl_tune_cache;
+  CacheStats opencl_memory_pool;
+  CacheStats kernel_tune_cache;
+  CacheStats nnadapter_model_cache;
+  CacheStats infer_shape_cache;
+};
+
+/// The deadline and the cancellation of a run, see RunWithOptions.
+struct LITE_API RunOptions {
+  /// The run stops once it passes, never by default.
+  std::chrono::steady_clock::time_point deadline{
+      std::chrono::steady_clock::time_point::max()};
+  /// The run stops once it is set, e.g. by another thread.
+  std::shared_ptr<std::atomic<bool>> cancelled;
+};
+
 /// The PaddlePredictor defines the basic interfaces for different kinds of
 /// predictors.
 class LITE_API PaddlePredictor {
  public:
-  PaddlePredictor() = default;
+  PaddlePredictor();
 
   /// Get i-th input.
   virtual std::unique_ptr<Tensor> GetInput(int i) = 0;
@@ -104,10 +172,88 @@ class LITE_API PaddlePredictor {
   /// Get i-th output.
   virtual std::unique_ptr<const Tensor> GetOutput(int i) const = 0;
 
+  /// Bind the caller-owned host buffer to the i-th input, the following runs
+  /// read the input from `data` in place instead of copying it. `shape` and
+  /// `precision` are checked against the model and `memory_size` in bytes.
+  /// Binding nullptr removes the binding.
+  virtual void BindInput(int i,
+                         void* data,
+                         size_t memory_size,
+                         const shape_t& shape,
+                         PrecisionType precision);
+  /// Bind the caller-owned host buffer to the i-th output, the following runs
+  /// write the output into `data` in place, or copy it there at the end of
+  /// the run if the output shares the memory of another tensor. The shape of
+  /// the output is available from GetOutput(i). `memory_size` must be large
+  /// enough for the output. Binding nullptr removes the binding.
+  virtual void BindOutput(int i, void* data, size_t memory_size);
+  /// Make the predictor stateful for the streams fed in chunks, e.g. the
+  /// streaming ASR: the i-th of `state_inputs` is fed by the i-th of
+  /// `state_outputs` of the previous run of the same stream without copies,
+  /// so a chunk only computes its new frames. The initial states of the
+  /// streams are the contents of the state inputs when it's called, e.g.
+  /// zeros. Empty lists make the predictor stateless again.
+  virtual void SetStreamStates(const std::vector<std::string>& state_inputs,
+                               const std::vector<std::string>& state_outputs);
+  /// Run on the states of the stream `id` from now on, a new stream starts
+  /// from the initial states. One predictor keeps the states of many streams.
+  virtual void SelectStream(int64_t id);
+  /// Restart the stream `id` from the initial states.
+  virtual void ResetStream(int64_t id);
+  /// Release the states of the stream `id`.
+  virtual void ReleaseStream(int64_t id);
+
   virtual void Run() = 0;
+  /// Run() which stops at the next op, or the next iteration of the while
+  /// loops, once the deadline of `options` passes or it is cancelled, so the
+  /// abandoned requests release the cores quickly. Returns false if stopped,
+  /// and the outputs are invalid then. The pipelined runs are not stopped.
+  virtual bool RunWithOptions(const RunOptions& options);
+  /// Run() on the internal executor without blocking the caller, `callback`
+  /// is invoked in the executor thread once Run() completes. The calls on the
+  /// same predictor are executed in order, and the inputs must not be touched
+  /// until the run completes. The predictor must outlive its pending runs.
+  /// Not supported by the backends whose runtime is bound to the calling
+  /// thread, such as OpenCL.
+  virtual void RunAsync(std::function<void()> callback);
+  /// Same as RunAsync(callback) but returns a future which becomes ready
+  /// when Run() completes.
+  virtual std::future<void> RunAsync();
+  /// Run `requests` requests, `feed(i)` sets the inputs of the i-th request
+  /// and `fetch(i)` reads its outputs. The light weight predictor pipelines
+  /// the segments of the model on the different devices, e.g. the CPU ops of
+  /// the request i+1 run while the NNAdapter subgraph of the request i is
+  /// executing. Both callbacks are called on the calling thread, and the
+  /// inputs must be copied into the input tensors instead of shared. Runs the
+  /// requests one by one by default.
+  virtual void RunPipelined(int requests,
+                            const std::function<void(int)>& feed,
+                            const std::function<void(int)>& fetch);
+  /// Whether the NNAdapter models are compiled for the inputs of the shapes
+  /// `input_shapes`, keyed by the input names, otherwise the run compiles
+  /// them and blocks. The caller may run such inputs by another predictor,
+  /// e.g. on the cpu, until they are ready. The inputs not in `input_shapes`
+  /// may be of any compiled shape. Always true without NNAdapter.
+  /// Run the predictor once for each of `shape_sets`, whose i-th shape is of
+  /// the i-th input, so the lazy work of the first runs of these shapes is
+  /// done ahead of the real requests, e.g. the allocation of the buffers, the
+  /// OpenCL tuning, the NNAdapter compiling, the XPU L3 planning and the cuDNN
+  /// algorithm search. The inputs are filled with zeros. Returns a future
+  /// which becomes ready once the predictor is hot for all the shapes. The
+  /// runs are executed in order with RunAsync, and the predictor must not be
+  /// touched until then. With OpenCL the runs block the calling thread.
+  virtual std::future<void> Warmup(
+      const std::vector<std::vector<shape_t>>& shape_sets);
+  virtual bool IsNNAdapterShapeReady(
+      const std::map<std::string, shape_t>& input_shapes);
   virtual std::shared_ptr<PaddlePredictor> Clone() = 0;
   virtual std::shared_ptr<PaddlePredictor> Clone(
       const std::vector<std::string>& var_names) = 0;
+  /// Clone() for the NUMA node `node` of the x86 servers, whose weights are
+  /// replicated into the memory of the node, and whose runs are bound to the
+  /// cpus of the node, see ConfigBase::set_x86_numa_node. Run one clone per
+  /// node to avoid the remote memory accesses. Same as Clone() elsewhere.
+  virtual std::shared_ptr<PaddlePredictor> CloneOnNumaNode(int node);
 
   virtual std::string GetVersion() const = 0;
 
@@ -121,6 +267,25 @@ class LITE_API PaddlePredictor {
   /// Release all tmp tensor to compress the size of the memory pool.
   virtual bool TryShrinkMemory() = 0;
 
+  /// Get the statistics collected since the predictor or the process starts,
+  /// which is cheap enough to be polled by the production telemetry.
+  virtual RuntimeStats GetRuntimeStats();
+
+  /// Record the latency of each kernel of the following runs into the op
+  /// latency table of the device, keyed by the kernel, the input shapes and
+  /// the threads. Run the representative inputs on the device, then call
+  /// StopOpLatencyRecording to save the table.
+  virtual void StartOpLatencyRecording();
+  /// Stop the recording and save the table into `path`, merged with the
+  /// latencies saved there before.
+  virtual bool StopOpLatencyRecording(const std::string& path);
+  /// Estimate the latency in ms of a run of the current input shapes by the
+  /// op latency table saved in `path` without running the kernels, e.g. to
+  /// select among the candidate models for the device. The kernels not in the
+  /// table are excluded and counted in `missing`.
+  virtual double EstimateLatency(const std::string& path,
+                                 int* missing = nullptr);
+
   // Get Input by name
   virtual std::unique_ptr<Tensor> GetInputByName(const std::string& name) = 0;
 
@@ -143,6 +308,10 @@ class LITE_API PaddlePredictor {
  protected:
   int threads_{1};
   lite_api::PowerMode mode_{lite_api::LITE_POWER_NO_BIND};
+
+ private:
+  // Keep the asynchronous runs of this predictor in order.
+  std::shared_ptr<void> async_strand_;
 };
 
 /// Base class for all the configs.
@@ -150,11 +319,22 @@ class LITE_API ConfigBase {
   std::string model_dir_;
   int threads_{1};
   PowerMode mode_{LITE_POWER_NO_BIND};
+  bool share_thread_pool_{false};
+  RunPriority run_priority_{LITE_PRIORITY_NORMAL};
+  bool adaptive_threads_{false};
+  bool fast_math_{false};
+  bool host_memory_pool_{false};
+  bool host_memory_huge_page_{false};
   // gpu opencl
   CLTuneMode opencl_tune_mode_{CL_TUNE_NONE};
   std::string opencl_bin_path_{""};
   std::string opencl_bin_name_{""};
   CLPrecisionType opencl_precision_{CL_PRECISION_AUTO};
+  bool opencl_memory_pool_{false};
+  std::string opencl_kernel_latencies_{""};
+  std::map<std::string, std::vector<shape_t>> opencl_dynamic_shape_info_;
+  // gpu vulkan
+  std::string vulkan_pipeline_cache_path_{""};
   // Where to cache the npu/xpu/rknpu/apu offline model to the binary files
   std::string subgraph_model_cache_dir_{""};
   // Set the cached npu/xpu/rknpu/apu offline model from the buffers
@@ -170,10 +350,15 @@ class LITE_API ConfigBase {
   // Dynamic shapes of the NNAdapter model
   std::map<std::string, std::vector<std::vector<int64_t>>>
       nnadapter_dynamic_shape_info_;
+  // Compile the NNAdapter models of the dynamic shapes in the background
+  // when the predictor is created.
+  bool nnadapter_precompile_dynamic_shapes_{false};
   // The buffers for loading the compiled NNAdapter models from memory.
   std::map<std::string, std::vector<char>> nnadapter_model_cache_buffers_{};
   int device_id_{0};
   int x86_math_num_threads_ = 1;
+  int x86_numa_node_{-1};
+  bool x86_unified_threads_{false};
 
   std::string metal_path_;
   bool metal_use_mps_{false};
@@ -194,6 +379,45 @@ class LITE_API ConfigBase {
   // set Power_mode
   void set_power_mode(PowerMode mode);
   PowerMode power_mode() const { return mode_; }
+  // By default every predictor owns a thread pool, so that the predictors in
+  // one process can run concurrently. Set true to share one thread pool among
+  // the predictors with the same threads and power mode, whose Run()s are
+  // serialized then. Only works when compiled with LITE_THREAD_POOL=ON.
+  void set_share_thread_pool(bool share) { share_thread_pool_ = share; }
+  bool share_thread_pool() const { return share_thread_pool_; }
+  // The priority of the runs of the predictor among the predictors in one
+  // process. A run yields between the ops while a run of a higher priority
+  // is in flight. On ARM, a foreground predictor runs on the big cores unless
+  // the power mode is LITE_POWER_FULL or LITE_POWER_RAND_HIGH, and the
+  // background ones run on the little cores while any foreground predictor
+  // exists.
+  void set_run_priority(RunPriority priority) { run_priority_ = priority; }
+  RunPriority run_priority() const { return run_priority_; }
+  // Adjust the threads, up to threads(), and the cores bound between the
+  // runs by the tail latency of the recent runs and the thermal throttling of
+  // the cores, to keep the latency low in the sustained inference. Only works
+  // on ARM.
+  void set_adaptive_threads(bool enable) { adaptive_threads_ = enable; }
+  bool adaptive_threads() const { return adaptive_threads_; }
+  // Compute exp, tanh and erf in the activations, softmax and the RNN gates
+  // by the fast approximations, whose absolute error is below 3e-6 instead
+  // of about 1e-7. Only works on ARM and x86 with AVX.
+  void set_fast_math(bool enable) { fast_math_ = enable; }
+  bool fast_math() const { return fast_math_; }
+  // Cache the freed host(kHost/kARM/kX86) memory in size classes and reuse
+  // it, instead of returning it to the system, which keeps RSS stable and
+  // avoids the page faults of the reallocations. Optionally advise the kernel
+  // to back the blocks of 2MB or more with the huge pages(Linux/Android).
+  // It takes effect immediately and for all the predictors in the process.
+  void set_host_memory_pool(bool enable, bool use_huge_page = false);
+  bool host_memory_pool() const { return host_memory_pool_; }
+  bool host_memory_huge_page() const { return host_memory_huge_page_; }
+  // Allocate the new host memory blocks by the user-supplied functions, the
+  // system allocator is restored if either of them is empty. It takes effect
+  // immediately and for all the predictors in the process, and every block
+  // is returned to the allocator it comes from.
+  void set_host_allocator(const std::function<void*(size_t)>& malloc_func,
+                          const std::function<void(void*)>& free_func);
 
   /// \brief Set path and file name of generated OpenCL compiled kernel binary.
   ///
@@ -227,11 +451,34 @@ class LITE_API ConfigBase {
   /// \param name  File name of OpenCL algorithm selecting file.
   /// \param lws_repeats  Repeat number for find the optimal local work size .
   /// \return void
+  ///
+  /// The tuned results are keyed by the gpu model and the driver version, and
+  /// merged with the ones in the file when saved, so the file can be shared
+  /// by the devices of different models and shipped with the app. An existing
+  /// file is loaded even if `tune_mode` is CL_TUNE_NONE.
   void set_opencl_tune(CLTuneMode tune_mode = CL_TUNE_NONE,
                        const std::string& path = "",
                        const std::string& name = "",
                        size_t lws_repeats = 4);
 
+  /// \brief Set the tune mode and the tuning file of the ARM convs.
+  ///
+  /// The candidate algorithms of each conv are timed on the real shape in the
+  /// first run, and the fastest one is kept. The decisions are keyed by the
+  /// cpu, the power mode, the threads and the shape, and saved into the
+  /// tuning file after each run, so the later processes skip the timing.
+  ///
+  /// \param tune_mode  Set a tune mode:
+  ///        ARM_TUNE_NONE: turn off, select the algorithms by the shape rules
+  ///        ARM_TUNE_RAPID: time each candidate once
+  ///        ARM_TUNE_NORMAL: time each candidate 3 times(suggestion)
+  ///        ARM_TUNE_EXHAUSTIVE: time each candidate 10 times
+  /// \param path  Path of the tuning file, the decisions are kept in memory
+  /// only if it is empty.
+  /// \return void
+  void set_arm_tune(ARMTuneMode tune_mode = ARM_TUNE_NONE,
+                    const std::string& path = "");
+
   /// \brief Set runtime precision on GPU using OpenCL backend.
   ///
   /// \param p
@@ -241,6 +488,72 @@ class LITE_API ConfigBase {
   /// \return void
   void set_opencl_precision(CLPrecisionType p = CL_PRECISION_AUTO);
 
+  /// \brief Cache the freed OpenCL images and buffers and reuse them.
+  ///
+  /// The images and buffers are cached per OpenCL context, i.e. per thread,
+  /// by their exact size, and reused by all the predictors on the thread,
+  /// e.g. when the input shapes alternate or the models are switched. The
+  /// cache is released before an allocation fails for the lack of memory.
+  /// It takes effect immediately and for all the predictors in the process.
+  ///
+  /// \param enable  Whether to cache the freed memory, false by default.
+  /// \param max_cached_mb  The most megabytes kept in the cache.
+  /// \return void
+  void set_opencl_memory_pool(bool enable, size_t max_cached_mb = 256);
+  bool opencl_memory_pool() const { return opencl_memory_pool_; }
+
+  /// \brief Pick the OpenCL buffer or image kernel of each op by the op
+  /// latency table saved in `path`.
+  ///
+  /// Record the table by StartOpLatencyRecording and StopOpLatencyRecording
+  /// on the device, once with the image places first in the valid places and
+  /// once with the buffer places first. The kernel of the lower relative
+  /// latency is picked for each op type measured by both, and the layout
+  /// casts are inserted only where the picked kernels switch. Without the
+  /// table, the kernels known to be faster on the GPU vendor are picked.
+  ///
+  /// \param path  The op latency table, empty to pick by the vendor only.
+  /// \return void
+  void set_opencl_kernel_latencies(const std::string& path) {
+    opencl_kernel_latencies_ = path;
+  }
+  const std::string& opencl_kernel_latencies() const {
+    return opencl_kernel_latencies_;
+  }
+
+  /// \brief Declare the shapes each input may take on OpenCL, e.g. the min
+  /// and the max ones.
+  ///
+  /// The predictor runs once on the largest declared shapes when it's
+  /// created, so the images are allocated for them and the smaller shapes
+  /// run on their sub-regions. The local work sizes are tuned once per bucket
+  /// of the spatial extents, rounded up to the powers of 2, instead of once
+  /// per shape. The bucketing takes effect immediately and for all the
+  /// predictors in the process.
+  ///
+  /// \param opencl_dynamic_shape_info  The shapes keyed by the input names.
+  /// \return void
+  void set_opencl_dynamic_shape_info(
+      const std::map<std::string, std::vector<shape_t>>&
+          opencl_dynamic_shape_info);
+  const std::map<std::string, std::vector<shape_t>>&
+  opencl_dynamic_shape_info() const {
+    return opencl_dynamic_shape_info_;
+  }
+
+  /// \brief Set the file which caches the compiled Vulkan pipelines.
+  ///
+  /// The cache is loaded when the Vulkan runtime is created, i.e. before the
+  /// first predictor with Vulkan kernels, and written back once new pipelines
+  /// are compiled, so the later launches skip the shader compilation.
+  ///
+  /// \param path  Path of the pipeline cache file, empty to disable it.
+  /// \return void
+  void set_vulkan_pipeline_cache_path(const std::string& path);
+  const std::string& vulkan_pipeline_cache_path() const {
+    return vulkan_pipeline_cache_path_;
+  }
+
   // set subgraph_model_dir
   void set_subgraph_model_cache_dir(std::string subgraph_model_cache_dir) {
     subgraph_model_cache_dir_ = subgraph_model_cache_dir;
@@ -292,6 +605,16 @@ class LITE_API ConfigBase {
   nnadapter_dynamic_shape_info() const {
     return nnadapter_dynamic_shape_info_;
   }
+  // Compile the NNAdapter models of all the shapes of
+  // set_nnadapter_dynamic_shape_info in the background when the predictor is
+  // created, instead of at the first run. Use
+  // PaddlePredictor::IsNNAdapterShapeReady to check whether they are ready.
+  void set_nnadapter_precompile_dynamic_shapes(bool precompile) {
+    nnadapter_precompile_dynamic_shapes_ = precompile;
+  }
+  bool nnadapter_precompile_dynamic_shapes() const {
+    return nnadapter_precompile_dynamic_shapes_;
+  }
   // Set the buffers for loading the compiled NNAdapter models from memory.
   void set_nnadapter_model_cache_buffers(
       const std::string& model_cache_token,
@@ -306,6 +629,32 @@ class LITE_API ConfigBase {
   // set x86_math_num_threads
   void set_x86_math_num_threads(int threads);
   int x86_math_num_threads() const;
+  /// \brief Bind the predictor to the NUMA node `node` of the x86 servers.
+  ///
+  /// The threads creating and running the predictor, including the x86 math
+  /// threads and the workers of its thread pool, are bound to the cpus of the
+  /// node, so the weights and the intermediate tensors, first touched by
+  /// them, are placed in the memory of the node. The creating thread gets its
+  /// previous binding back once created.
+  ///
+  /// \note A thread calling Run() stays bound to the node after the run, so
+  /// it isn't rebound on every run. Run the predictor on threads dedicated to
+  /// the node, or restore their affinity after the runs.
+  ///
+  /// -1 by default, which leaves the threads unbound.
+  void set_x86_numa_node(int node) { x86_numa_node_ = node; }
+  int x86_numa_node() const { return x86_numa_node_; }
+  /// \brief Share one set of workers among MKL, the omp regions of the x86
+  /// kernels and the thread pool of the predictor.
+  ///
+  /// The parallel regions of the thread pool run on the OpenMP team of the
+  /// calling thread instead of its own workers, and threads() is the budget
+  /// of all of them, set per run for the calling thread, which replaces
+  /// x86_math_num_threads(). So the cores are not oversubscribed, and the
+  /// predictors run concurrently keep their own budgets. Only for the
+  /// predictors of CxxConfig.
+  void set_x86_unified_threads(bool enable) { x86_unified_threads_ = enable; }
+  bool x86_unified_threads() const { return x86_unified_threads_; }
 
   void set_metal_lib_path(const std::string& path);
   void set_metal_use_mps(bool flag);
@@ -353,12 +702,25 @@ class LITE_API CxxConfig : public ConfigBase {
   std::vector<std::string> passes_internal_{};
   bool quant_model_{false};  // Enable post_quant_dynamic in opt
   QuantType quant_type_{QuantType::QUANT_INT16};
+  // Store the embedding tables row-wise in int8/int4, 0 to disable
+  int embedding_quant_bits_{0};
+  // The calibration table of post_quant_static in opt
+  std::string calib_table_;
+  // The per-op precisions searched by calib_bin
+  std::string mixed_precision_config_;
   bool sparse_model_{false};  // Enable sparse_conv_detect_pass in opt
   float sparse_threshold_{0.6f};
+  // Enable conv_algorithm_select_pass in opt
+  bool conv_algorithm_preselect_{false};
+  bool target_has_dot_{false};
+  // Compress the weights in the saved naive buffer model
+  bool compress_weights_{false};
   std::map<int, std::vector<std::shared_ptr<void>>>
       preferred_inputs_for_warmup_;
+  std::vector<std::vector<shape_t>> xpu_l3_autotune_shapes_;
 #ifdef LITE_WITH_CUDA
   bool multi_stream_{false};
+  std::string cudnn_algo_cache_file_;
 #endif
 #ifdef LITE_WITH_MLU
   lite_api::MLUCoreVersion mlu_core_version_{lite_api::MLUCoreVersion::MLU_270};
@@ -375,6 +737,9 @@ class LITE_API CxxConfig : public ConfigBase {
   // op_type
   std::string nnadapter_subgraph_partition_config_path_;
   std::string nnadapter_subgraph_partition_config_buffer_;
+  // The op costs and transfer costs for the NNAdapter subgraph partition, see
+  // SubgraphFuser::DropUnprofitableSubgraphs for the format
+  std::string nnadapter_subgraph_cost_table_path_;
   std::string mixed_precision_quantization_config_path_;
   std::string mixed_precision_quantization_config_buffer_;
 
@@ -415,6 +780,15 @@ class LITE_API CxxConfig : public ConfigBase {
 #ifdef LITE_WITH_CUDA
   void set_multi_stream(bool multi_stream) { multi_stream_ = multi_stream; }
   bool multi_stream() const { return multi_stream_; }
+  // Save the cudnn conv algorithms found by the exhaustive search for each
+  // shape into `cache_file`, and load them from it when the predictor is
+  // created to skip the search in the later processes.
+  void set_cudnn_algo_cache_file(const std::string& cache_file) {
+    cudnn_algo_cache_file_ = cache_file;
+  }
+  const std::string& cudnn_algo_cache_file() const {
+    return cudnn_algo_cache_file_;
+  }
 #endif
 
 #ifdef LITE_WITH_MLU
@@ -451,6 +825,20 @@ class LITE_API CxxConfig : public ConfigBase {
   void set_xpu_conv_autotune(bool autotune = true,
                              const std::string& autotune_file = "");
 
+  // XPU only, save the L3 cache plans tuned for the input shapes into
+  // `autotune_file`, and load them from it in the later processes to skip
+  // the autotune for the same shapes.
+  void set_xpu_l3_autotune_file(const std::string& autotune_file);
+  // XPU only, tune the L3 cache plans for the expected input shapes when the
+  // predictor is created, each item lists the shapes of all the inputs.
+  void set_xpu_l3_autotune_shapes(
+      const std::vector<std::vector<shape_t>>& shapes) {
+    xpu_l3_autotune_shapes_ = shapes;
+  }
+  const std::vector<std::vector<shape_t>>& xpu_l3_autotune_shapes() const {
+    return xpu_l3_autotune_shapes_;
+  }
+
   // XPU only, specify the target device ID for the current thread.
   // **DEPRECATED**, use xpu_set_device() at the very beginning of each worker
   // thread
@@ -483,6 +871,18 @@ class LITE_API CxxConfig : public ConfigBase {
   bool quant_model() const { return quant_model_; }
   void set_quant_type(QuantType quant_type) { quant_type_ = quant_type; }
   QuantType quant_type() const { return quant_type_; }
+  void set_embedding_quant_bits(int bits) { embedding_quant_bits_ = bits; }
+  int embedding_quant_bits() const { return embedding_quant_bits_; }
+  void set_calib_table(const std::string& calib_table) {
+    calib_table_ = calib_table;
+  }
+  const std::string& calib_table() const { return calib_table_; }
+  void set_mixed_precision_config(const std::string& config_path) {
+    mixed_precision_config_ = config_path;
+  }
+  const std::string& mixed_precision_config() const {
+    return mixed_precision_config_;
+  }
 
   void set_sparse_model(bool sparse_model) { sparse_model_ = sparse_model; }
   bool sparse_model() const { return sparse_model_; }
@@ -491,6 +891,23 @@ class LITE_API CxxConfig : public ConfigBase {
   }
   float sparse_threshold() const { return sparse_threshold_; }
 
+  // Select the implementations of the ARM convs ahead of time and record them
+  // in the optimized model, `target_has_dot` refers to whether the target cpu
+  // supports the dot product instructions.
+  void set_conv_algorithm_preselect(bool enable, bool target_has_dot = false) {
+    conv_algorithm_preselect_ = enable;
+    target_has_dot_ = target_has_dot;
+  }
+  bool conv_algorithm_preselect() const { return conv_algorithm_preselect_; }
+  bool target_has_dot() const { return target_has_dot_; }
+
+  // Save the weights compressed into the naive buffer model, which are
+  // decompressed in parallel when loaded.
+  void set_compress_weights(bool compress_weights) {
+    compress_weights_ = compress_weights;
+  }
+  bool compress_weights() const { return compress_weights_; }
+
   // Enable the custom subgraph partition for NNAdapter by providing the
   // configuration file or buffer
   void set_nnadapter_subgraph_partition_config_path(
@@ -508,6 +925,16 @@ class LITE_API CxxConfig : public ConfigBase {
   const std::string& nnadapter_subgraph_partition_config_buffer() const {
     return nnadapter_subgraph_partition_config_buffer_;
   }
+  // Drop the NNAdapter subgraphs which are slower than the host by providing
+  // the measured op and transfer costs, ignored if the custom subgraph
+  // partition is enabled
+  void set_nnadapter_subgraph_cost_table_path(
+      const std::string& subgraph_cost_table_path) {
+    nnadapter_subgraph_cost_table_path_ = subgraph_cost_table_path;
+  }
+  const std::string& nnadapter_subgraph_cost_table_path() const {
+    return nnadapter_subgraph_cost_table_path_;
+  }
   // Clear some ops' quant information to support mixed precision compute by
   // configuration file or buffer
   void set_nnadapter_mixed_precision_quantization_config_path(
@@ -536,6 +963,16 @@ class LITE_API MobileConfig : public ConfigBase {
   // whether to load data from memory. Model data will be loaded from memory
   // buffer if model_from_memory_ is true.
   bool model_from_memory_{false};
+  // whether to map the model file into memory instead of reading it.
+  bool model_mmap_{false};
+  // whether to decode the weights on the first run of the ops using them.
+  bool lazy_load_weights_{false};
+  // the file caching the weights packed by the kernels.
+  std::string packed_weight_cache_file_;
+  // whether to share the identical weights with the other predictors.
+  bool share_weights_{false};
+  // the shared memory region holding the weights for the other processes.
+  std::string shared_memory_weights_;
 
   // model data readed from file or memory buffer in combined format.
   std::string lite_model_file_;
@@ -561,6 +998,59 @@ class LITE_API MobileConfig : public ConfigBase {
   // abandoned in v3.0.
   bool model_from_memory() const { return model_from_memory_; }
 
+  // Map the model file set by `set_model_from_file` into memory, the weights
+  // share the mapped data in place instead of being copied, which is loaded
+  // lazily and copied on write. It reduces the startup time and the peak
+  // memory of the large models. Not supported on Windows, and the weights of
+  // the models saved by the previous versions of opt may still be copied.
+  void set_model_mmap(bool model_mmap) { model_mmap_ = model_mmap; }
+  bool model_mmap() const { return model_mmap_; }
+
+  // Defer the decoding of the weights(the dequantization of the weights
+  // quantized after training and the conversion to fp16) until the first run
+  // of the ops using them, the weights of the sub blocks are decoded on the
+  // first run of the control flow ops, e.g. conditional_block and while. With
+  // `set_model_mmap`, the undecoded weights are not even read from the file.
+  void set_lazy_load_weights(bool lazy_load_weights) {
+    lazy_load_weights_ = lazy_load_weights;
+  }
+  bool lazy_load_weights() const { return lazy_load_weights_; }
+
+  // Cache the weights packed by the ARM kernels(e.g. the gemm-like and
+  // winograd convs, fc) into `path`, so the later loads map them instead of
+  // packing again. The cache is written after the runs which pack new weights,
+  // and the entries are keyed by the arch and the ISA features of the cpu, so
+  // the file can be shared by different models and devices.
+  void set_packed_weight_cache_file(const std::string& path) {
+    packed_weight_cache_file_ = path;
+  }
+  const std::string& packed_weight_cache_file() const {
+    return packed_weight_cache_file_;
+  }
+
+  // Share the weights identical to the ones loaded by the other predictors in
+  // this process, e.g. the backbone of the models fine-tuned from the same
+  // one, so the memory scales with the unique weights instead of the number
+  // of the models. The weights are compared by the data after decoded, and
+  // the ones loaded lazily by `set_lazy_load_weights` are not shared.
+  void set_share_weights(bool share_weights) { share_weights_ = share_weights; }
+  bool share_weights() const { return share_weights_; }
+
+  // Share the weights with the other processes running the same model
+  // through the shared memory region `name`, which is written by the first
+  // process and mapped copy on write by the later ones, so the memory of a
+  // multi-process deployment scales with the models instead of the
+  // processes. A bare name lives in /dev/shm on Linux, while a path is
+  // required on Android, e.g. in the cache dir of the app. The weights loaded
+  // lazily by `set_lazy_load_weights` are not shared. Not supported on
+  // Windows.
+  void set_shared_memory_weights(const std::string& name) {
+    shared_memory_weights_ = name;
+  }
+  const std::string& shared_memory_weights() const {
+    return shared_memory_weights_;
+  }
+
   // NOTE: This is a deprecated API and will be removed in latter release.
   void set_model_buffer(const char* model_buffer,
                         size_t model_buffer_size,
@@ -582,6 +1072,98 @@ class LITE_API MobileConfig : public ConfigBase {
 template <typename ConfigT>
 LITE_API std::shared_ptr<PaddlePredictor> CreatePaddlePredictor(const ConfigT&);
 
+/// A pool of the predictors of a model, one on each of the NNAdapter devices
+/// of the same type, which runs the concurrent requests on the least loaded
+/// predictor, so the throughput scales with the number of the devices.
+class LITE_API PaddlePredictorPool {
+ public:
+  /// Create a predictor of `config` on each device of `device_ids`, which is
+  /// selected by appending "<DEVICE NAME>_SELECTED_DEVICE_IDS=<id>" to the
+  /// NNAdapter context properties, e.g.
+  /// "HUAWEI_ASCEND_NPU_SELECTED_DEVICE_IDS=1" for the first device name
+  /// "huawei_ascend_npu". Each predictor loads its own copy of the model.
+  template <typename ConfigT>
+  PaddlePredictorPool(const ConfigT& config, const std::vector<int>& device_ids)
+      : PaddlePredictorPool(CreatePredictors(config, device_ids)) {}
+  explicit PaddlePredictorPool(
+      std::vector<std::shared_ptr<PaddlePredictor>> predictors);
+
+  /// Run a request on the least loaded predictor, `feed` sets its inputs and
+  /// `fetch` reads its outputs. It can be called from several threads at the
+  /// same time, each predictor runs one request at a time.
+  void Run(const std::function<void(PaddlePredictor*)>& feed,
+           const std::function<void(PaddlePredictor*)>& fetch);
+
+  size_t size() const { return predictors_.size(); }
+  PaddlePredictor* predictor(size_t i) { return predictors_.at(i).get(); }
+
+  /// The NNAdapter context properties of `config` selecting the device
+  /// `device_id`.
+  static std::string DeviceContextProperties(const ConfigBase& config,
+                                             int device_id);
+
+ private:
+  template <typename ConfigT>
+  static std::vector<std::shared_ptr<PaddlePredictor>> CreatePredictors(
+      const ConfigT& config, const std::vector<int>& device_ids) {
+    std::vector<std::shared_ptr<PaddlePredictor>> predictors;
+    for (int device_id : device_ids) {
+      ConfigT device_config = config;
+      device_config.set_nnadapter_context_properties(
+          DeviceContextProperties(config, device_id));
+      predictors.push_back(CreatePaddlePredictor<ConfigT>(device_config));
+    }
+    return predictors;
+  }
+
+  std::vector<std::shared_ptr<PaddlePredictor>> predictors_;
+  // The loads and the locks of the predictors
+  std::shared_ptr<void> state_;
+};
+
+/// A predictor whose model can be replaced while it's serving, e.g. to roll
+/// out a new model in a long-running service without a restart.
+class LITE_API HotSwapPredictor {
+ public:
+  explicit HotSwapPredictor(std::shared_ptr<PaddlePredictor> predictor);
+  /// Wait for the pending reloads and releases.
+  ~HotSwapPredictor();
+  HotSwapPredictor(const HotSwapPredictor&) = delete;
+  HotSwapPredictor& operator=(const HotSwapPredictor&) = delete;
+
+  /// The current predictor. Hold it for the whole request, which finishes on
+  /// it even if it's swapped out meanwhile. The swapped-out predictor is
+  /// released on a background thread of the lowest OS priority once the last
+  /// request drops it, or by that request if this is already destroyed.
+  std::shared_ptr<PaddlePredictor> Get() const;
+
+  /// Create the predictor of `config` on a background thread, run it once on
+  /// each of `warmup_shapes` as Warmup() does, then swap it in. The serving
+  /// threads never wait for the creation or the warmup. The background
+  /// thread is owned by this and keeps the priority of the thread which
+  /// constructed it, which the threads of the new predictor inherit. The
+  /// reloads are applied in order. The future
+  /// becomes true once swapped, false if the creation returned nullptr, or
+  /// holds the exception of a failed creation, both of which keep the current
+  /// predictor. With OpenCL it all runs on the calling thread, which the
+  /// OpenCL runtime is bound to, and the swapped-out predictor is released by
+  /// the last request holding it.
+  template <typename ConfigT>
+  std::future<bool> Reload(
+      const ConfigT& config,
+      const std::vector<std::vector<shape_t>>& warmup_shapes = {}) {
+    return Reload([config]() { return CreatePaddlePredictor<ConfigT>(config); },
+                  warmup_shapes);
+  }
+  std::future<bool> Reload(
+      const std::function<std::shared_ptr<PaddlePredictor>()>& create,
+      const std::vector<std::vector<shape_t>>& warmup_shapes = {});
+
+ private:
+  // The current predictor and the order of the reloads
+  std::shared_ptr<void> state_;
+};
+
 }  // namespace lite_api
 }  // namespace paddle
 
@@ -41,4 +41,9 @@
   static bool mir_pass_usage##name__ UNUSED =     \
       mir_pass_registry##name__##_fake();
 
+// Links the static kernel table generated for a tailored build.
+#define USE_STATIC_KERNEL_TABLE()         \
+  extern int touch_static_kernel_table(); \
+  int static_kernel_table__use UNUSED = touch_static_kernel_table();
+
 #define LITE_OP_REGISTER_FAKE(op_type__) op_type__##__registry__
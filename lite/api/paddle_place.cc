@@ -86,7 +86,8 @@ const std::string& TargetToStr(TargetType target) {
                                               "imagination_nna",
                                               "intel_fpga",
                                               "metal",
-                                              "nnadapter"};
+                                              "nnadapter",
+                                              "vulkan"};
   auto x = static_cast<int>(target);
 
   CHECK_LT(x, static_cast<int>(TARGET(NUM)));
@@ -104,7 +105,8 @@ const std::string& PrecisionToStr(PrecisionType precision) {
                                                  "int64_t",
                                                  "int16_t",
                                                  "uint8_t",
-                                                 "double"};
+                                                 "double",
+                                                 "bfloat16"};
   auto x = static_cast<int>(precision);
   CHECK_LT(x, static_cast<int>(PRECISION(NUM)));
   return precision2string[x];
@@ -144,7 +146,8 @@ const std::string& TargetRepr(TargetType target) {
                                               "kImaginationNNA",
                                               "kIntelFPGA",
                                               "kMetal",
-                                              "kNNAdapter"};
+                                              "kNNAdapter",
+                                              "kVulkan"};
   auto x = static_cast<int>(target);
   CHECK_LT(x, static_cast<int>(TARGET(NUM)));
   return target2string[x];
@@ -159,7 +162,10 @@ const std::string& PrecisionRepr(PrecisionType precision) {
                                                  "kFP16",
                                                  "kBool",
                                                  "kInt64",
-                                                 "kInt16"};
+                                                 "kInt16",
+                                                 "kUInt8",
+                                                 "kFP64",
+                                                 "kBF16"};
   auto x = static_cast<int>(precision);
   CHECK_LT(x, static_cast<int>(PRECISION(NUM)));
   return precision2string[x];
@@ -187,6 +193,15 @@ const std::string& CLTuneModeToStr(CLTuneMode mode) {
   return cl_tune_mode[x];
 }
 
+const std::string& ARMTuneModeToStr(ARMTuneMode mode) {
+  static const std::string arm_tune_mode[] = {"ARM_TUNE_NONE",
+                                              "ARM_TUNE_RAPID",
+                                              "ARM_TUNE_NORMAL",
+                                              "ARM_TUNE_EXHAUSTIVE"};
+  auto x = static_cast<int>(mode);
+  return arm_tune_mode[x];
+}
+
 const std::string& CLPrecisionTypeToStr(CLPrecisionType type) {
   static const std::string cl_precision_type[] = {
       "CL_PRECISION_AUTO", "CL_PRECISION_FP32", "CL_PRECISION_FP16"};
@@ -211,7 +226,8 @@ std::set<TargetType> ExpandValidTargets(TargetType target) {
                                                TARGET(kImaginationNNA),
                                                TARGET(kIntelFPGA),
                                                TARGET(kMetal),
-                                               TARGET(kNNAdapter)});
+                                               TARGET(kNNAdapter),
+                                               TARGET(kVulkan)});
   if (target == TARGET(kAny)) {
     return valid_set;
   }
@@ -62,7 +62,8 @@ enum class TargetType : int {
   kIntelFPGA = 16,
   kMetal = 17,
   kNNAdapter = 18,
-  NUM = 19,  // number of fields.
+  kVulkan = 19,
+  NUM = 20,  // number of fields.
 };
 enum class PrecisionType : int {
   kUnk = 0,
@@ -76,7 +77,8 @@ enum class PrecisionType : int {
   kInt16 = 8,
   kUInt8 = 9,
   kFP64 = 10,
-  NUM = 11,  // number of fields.
+  kBF16 = 11,
+  NUM = 12,  // number of fields.
 };
 enum class DataLayoutType : int {
   kUnk = 0,
@@ -100,6 +102,14 @@ typedef enum {
   LITE_POWER_RAND_LOW = 5
 } PowerMode;
 
+// The priority of the runs of a predictor among the predictors in one
+// process, see ConfigBase::set_run_priority.
+typedef enum {
+  LITE_PRIORITY_BACKGROUND = 0,
+  LITE_PRIORITY_NORMAL = 1,
+  LITE_PRIORITY_FOREGROUND = 2
+} RunPriority;
+
 typedef enum {
   CL_TUNE_NONE = 0,
   CL_TUNE_RAPID = 1,
@@ -107,6 +117,13 @@ typedef enum {
   CL_TUNE_EXHAUSTIVE = 3
 } CLTuneMode;
 
+typedef enum {
+  ARM_TUNE_NONE = 0,
+  ARM_TUNE_RAPID = 1,
+  ARM_TUNE_NORMAL = 2,
+  ARM_TUNE_EXHAUSTIVE = 3
+} ARMTuneMode;
+
 typedef enum {
   CL_PRECISION_AUTO = 0,
   CL_PRECISION_FP32 = 1,
@@ -158,6 +175,8 @@ static size_t PrecisionTypeLength(PrecisionType type) {
       return 8;
     case PrecisionType::kFP16:
       return 2;
+    case PrecisionType::kBF16:
+      return 2;
     case PrecisionType::kInt16:
       return 2;
     default:
@@ -168,6 +187,9 @@ static size_t PrecisionTypeLength(PrecisionType type) {
 enum class QuantType : int {
   QUANT_INT8,
   QUANT_INT16,
+  // group-wise int4 for the 2-D weights of mul, matmul_v2 and fc, and int8
+  // for the others
+  QUANT_INT4,
 };
 
 template <typename T>
@@ -225,6 +247,8 @@ const std::string& DataLayoutRepr(DataLayoutType layout);
 
 const std::string& CLTuneModeToStr(CLTuneMode mode);
 
+const std::string& ARMTuneModeToStr(ARMTuneMode mode);
+
 const std::string& CLPrecisionTypeToStr(CLPrecisionType type);
 
 // Get a set of all the elements represented by the target.
@@ -18,6 +18,7 @@
 USE_MIR_PASS(demo);
 USE_MIR_PASS(static_kernel_pick_pass);
 USE_MIR_PASS(lite_unsqueeze2_pad3d_squeeze2_fuse_pass);
+USE_MIR_PASS(lite_pad2d_conv_pool_fuse_pass);
 USE_MIR_PASS(op_transformation_pass);
 USE_MIR_PASS(variable_place_inference_pass);
 USE_MIR_PASS(type_target_cast_pass);
@@ -27,15 +28,23 @@ USE_MIR_PASS(generate_program_pass);
 
 USE_MIR_PASS(io_copy_kernel_pick_pass);
 USE_MIR_PASS(argument_type_display_pass);
+USE_MIR_PASS(precision_cast_report_pass);
 USE_MIR_PASS(runtime_context_assign_pass);
 USE_MIR_PASS(graph_visualize_pass);
 
 USE_MIR_PASS(sparse_conv_detect_pass);
+USE_MIR_PASS(conv_algorithm_select_pass);
 USE_MIR_PASS(adaptive_1x1_pool2d_convert_global_pass);
 USE_MIR_PASS(remove_scale1_pass);
 USE_MIR_PASS(remove_tf_redundant_ops_pass);
 USE_MIR_PASS(lite_conv_bn_fuse_pass);
 USE_MIR_PASS(lite_conv_conv_fuse_pass);
+USE_MIR_PASS(lite_depthwise_pointwise_conv_fuse_pass);
+USE_MIR_PASS(lite_conv_resample_fuse_pass);
+USE_MIR_PASS(lite_yolo_box_nms_fuse_pass);
+USE_MIR_PASS(lite_distribute_fpn_roi_align_fuse_pass);
+USE_MIR_PASS(lite_fusion_attention_fuse_pass);
+USE_MIR_PASS(lite_elementwise_add_layer_norm_fuse_pass);
 USE_MIR_PASS(lite_squeeze2_matmul_fuse_pass);
 USE_MIR_PASS(lite_reshape2_matmul_fuse_pass);
 USE_MIR_PASS(lite_matmul_fuse_pass);
@@ -43,6 +52,8 @@ USE_MIR_PASS(lite_fc_fuse_pass);
 USE_MIR_PASS(lite_matmul_element_add_fuse_pass);
 USE_MIR_PASS(lite_shuffle_channel_fuse_pass);
 USE_MIR_PASS(lite_transpose_softmax_transpose_fuse_pass);
+USE_MIR_PASS(lite_transpose_matmul_fuse_pass);
+USE_MIR_PASS(lite_matmul_softmax_fuse_pass);
 USE_MIR_PASS(lite_interpolate_fuse_pass);
 USE_MIR_PASS(lite_sequence_pool_concat_fuse_pass);
 USE_MIR_PASS(identity_scale_eliminate_pass);
@@ -51,18 +62,22 @@ USE_MIR_PASS(lite_conv_elementwise_fuse_pass);
 USE_MIR_PASS(lite_conv_activation_fuse_pass);
 USE_MIR_PASS(lite_var_conv_2d_activation_fuse_pass);
 USE_MIR_PASS(lite_match_matrix_activation_fuse_pass);
+USE_MIR_PASS(lite_elementwise_chain_fuse_pass);
 USE_MIR_PASS(lite_scales_fuse_pass);
 USE_MIR_PASS(lite_scaleacts_fuse_pass);
 USE_MIR_PASS(lite_sequence_reverse_embedding_fuse_pass);
+USE_MIR_PASS(lite_embedding_seq_pool_fuse_pass);
 USE_MIR_PASS(lite_elementwise_activation_fuse_pass);
 USE_MIR_PASS(lite_elementwise_scale_fuse_pass);
 USE_MIR_PASS(lite_conv_scale_fuse_pass);
 USE_MIR_PASS(lite_conv_elementwise_tree_fuse_pass);
+USE_MIR_PASS(lite_conv_elementwise_int8_fuse_pass);
 USE_MIR_PASS(lite_quant_dequant_fuse_pass);
 USE_MIR_PASS(type_precision_cast_pass);
 USE_MIR_PASS(type_layout_cast_pass);
 USE_MIR_PASS(type_layout_cast_preprocess_pass);
 USE_MIR_PASS(memory_optimize_pass);
+USE_MIR_PASS(concat_split_view_pass);
 USE_MIR_PASS(xpu_memory_optimize_pass);
 USE_MIR_PASS(lite_inplace_fuse_pass);
 USE_MIR_PASS(multi_stream_analysis_pass);
@@ -73,7 +88,11 @@ USE_MIR_PASS(mlu_subgraph_pass);
 USE_MIR_PASS(mlu_postprocess_pass);
 USE_MIR_PASS(weight_quantization_preprocess_pass);
 USE_MIR_PASS(post_quant_dynamic_pass);
+USE_MIR_PASS(embedding_quant_pass);
+USE_MIR_PASS(post_quant_static_pass);
+USE_MIR_PASS(mixed_precision_pass);
 USE_MIR_PASS(fp16_attribute_pass);
+USE_MIR_PASS(bf16_attribute_pass);
 USE_MIR_PASS(fpga_concat_fuse_pass);
 USE_MIR_PASS(quantization_parameters_propagation_pass);
 USE_MIR_PASS(quantization_parameters_removal_pass);
@@ -117,4 +136,6 @@ USE_MIR_PASS(p_norm_fill_constant_max_div_fuse_pass);
 USE_MIR_PASS(fill_constant_calc_offline_pass);
 USE_MIR_PASS(unsqueeze_calc_offline_pass);
 USE_MIR_PASS(scale_calc_offline_pass);
+USE_MIR_PASS(constant_folding_pass);
+USE_MIR_PASS(common_subexpression_elimination_pass);
 USE_MIR_PASS(keepdims_convert_pass);
@@ -15,12 +15,16 @@
 #include "lite/api/python/pybind/pybind.h"
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
+#include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <future>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -48,9 +52,11 @@ using lite_api::MobileConfig;
 using lite_api::OptBase;
 using lite_api::Place;
 using lite_api::PowerMode;
+using lite_api::RunPriority;
 using lite_api::PrecisionType;
 using lite_api::TargetType;
 using lite_api::CLTuneMode;
+using lite_api::ARMTuneMode;
 using lite_api::CLPrecisionType;
 using lite_api::Tensor;
 using lite_api::CxxModelBuffer;
@@ -67,12 +73,21 @@ void BindLiteOpt(py::module *m) {
       .def("set_param_file", &OptBase::SetParamFile)
       .def("set_valid_places", &OptBase::SetValidPlaces)
       .def("enable_fp16", &OptBase::EnableFloat16)
+      .def("enable_bf16", &OptBase::EnableBFloat16)
       .def("set_optimize_out", &OptBase::SetOptimizeOut)
       .def("set_model_type", &OptBase::SetModelType)
       .def("set_quant_model", &OptBase::SetQuantModel)
       .def("set_quant_type", &OptBase::SetQuantType)
+      .def("set_embedding_quant_bits", &OptBase::SetEmbeddingQuantBits)
+      .def("set_calib_table", &OptBase::SetCalibTable)
+      .def("set_mixed_precision_config", &OptBase::SetMixedPrecisionConfig)
       .def("set_sparse_model", &OptBase::SetSparseModel)
       .def("set_sparse_threshold", &OptBase::SetSparseThreshold)
+      .def("set_conv_algorithm_preselect",
+           &OptBase::SetConvAlgorithmPreselect,
+           py::arg("enable"),
+           py::arg("target_has_dot") = false)
+      .def("set_compress_weights", &OptBase::SetCompressWeights)
       .def("record_model_info", &OptBase::RecordModelInfo)
       .def("set_passes_internal", &OptBase::SetPassesInternal)
       .def("run", &OptBase::Run)
@@ -93,20 +108,26 @@ static void BindLiteLightPredictor(py::module *m);
 static void BindLiteCxxConfig(py::module *m);
 static void BindLiteMobileConfig(py::module *m);
 static void BindLitePowerMode(py::module *m);
+static void BindLiteRunPriority(py::module *m);
 static void BindLitePlace(py::module *m);
 static void BindLiteCLTuneMode(py::module *m);
+static void BindLiteARMTuneMode(py::module *m);
 static void BindLiteCLPrecisionType(py::module *m);
 static void BindLiteTensor(py::module *m);
+static void BindLiteAsyncRun(py::module *m);
 static void BindLiteMLUCoreVersion(py::module *m);
 
 void BindLiteApi(py::module *m) {
   BindLiteCxxConfig(m);
   BindLiteMobileConfig(m);
   BindLitePowerMode(m);
+  BindLiteRunPriority(m);
   BindLitePlace(m);
   BindLiteCLTuneMode(m);
+  BindLiteARMTuneMode(m);
   BindLiteCLPrecisionType(m);
   BindLiteTensor(m);
+  BindLiteAsyncRun(m);
   BindLiteMLUCoreVersion(m);
 #ifndef LITE_ON_TINY_PUBLISH
   BindLiteCxxPredictor(m);
@@ -153,12 +174,17 @@ void BindLiteCxxConfig(py::module *m) {
   cxx_config.def("set_threads", &CxxConfig::set_threads)
       .def("threads", &CxxConfig::threads)
       .def("set_power_mode", &CxxConfig::set_power_mode)
-      .def("power_mode", &CxxConfig::power_mode);
+      .def("power_mode", &CxxConfig::power_mode)
+      .def("set_run_priority", &CxxConfig::set_run_priority)
+      .def("run_priority", &CxxConfig::run_priority);
 
   cxx_config
       .def("set_opencl_binary_path_name",
            &CxxConfig::set_opencl_binary_path_name)
       .def("set_opencl_tune", &CxxConfig::set_opencl_tune)
+      .def("set_arm_tune", &CxxConfig::set_arm_tune)
+      .def("set_fast_math", &CxxConfig::set_fast_math)
+      .def("fast_math", &CxxConfig::fast_math)
       .def("set_opencl_precision", &CxxConfig::set_opencl_precision);
 
   cxx_config
@@ -176,6 +202,8 @@ void BindLiteCxxConfig(py::module *m) {
            &CxxConfig::set_nnadapter_model_cache_dir)
       .def("set_nnadapter_subgraph_partition_config_path",
            &CxxConfig::set_nnadapter_subgraph_partition_config_path)
+      .def("set_nnadapter_subgraph_cost_table_path",
+           &CxxConfig::set_nnadapter_subgraph_cost_table_path)
       .def("set_nnadapter_mixed_precision_quantization_config_path",
            &CxxConfig::set_nnadapter_mixed_precision_quantization_config_path)
       .def("nnadapter_device_names", &CxxConfig::nnadapter_device_names)
@@ -184,6 +212,8 @@ void BindLiteCxxConfig(py::module *m) {
       .def("nnadapter_model_cache_dir", &CxxConfig::nnadapter_model_cache_dir)
       .def("nnadapter_subgraph_partition_config_path",
            &CxxConfig::nnadapter_subgraph_partition_config_path)
+      .def("nnadapter_subgraph_cost_table_path",
+           &CxxConfig::nnadapter_subgraph_cost_table_path)
       .def("nnadapter_mixed_precision_quantization_config_path",
            &CxxConfig::nnadapter_mixed_precision_quantization_config_path);
 
@@ -212,12 +242,17 @@ void BindLiteMobileConfig(py::module *m) {
   mobile_config.def("set_threads", &MobileConfig::set_threads)
       .def("threads", &MobileConfig::threads)
       .def("set_power_mode", &MobileConfig::set_power_mode)
-      .def("power_mode", &MobileConfig::power_mode);
+      .def("power_mode", &MobileConfig::power_mode)
+      .def("set_run_priority", &MobileConfig::set_run_priority)
+      .def("run_priority", &MobileConfig::run_priority);
 #endif
   mobile_config
       .def("set_opencl_binary_path_name",
            &MobileConfig::set_opencl_binary_path_name)
       .def("set_opencl_tune", &MobileConfig::set_opencl_tune)
+      .def("set_arm_tune", &MobileConfig::set_arm_tune)
+      .def("set_fast_math", &MobileConfig::set_fast_math)
+      .def("fast_math", &MobileConfig::fast_math)
       .def("set_opencl_precision", &MobileConfig::set_opencl_precision);
   mobile_config
       .def("set_metal_use_mps",
@@ -238,6 +273,13 @@ void BindLitePowerMode(py::module *m) {
       .value("LITE_POWER_RAND_LOW", PowerMode::LITE_POWER_RAND_LOW);
 }
 
+void BindLiteRunPriority(py::module *m) {
+  py::enum_<RunPriority>(*m, "RunPriority")
+      .value("LITE_PRIORITY_BACKGROUND", RunPriority::LITE_PRIORITY_BACKGROUND)
+      .value("LITE_PRIORITY_NORMAL", RunPriority::LITE_PRIORITY_NORMAL)
+      .value("LITE_PRIORITY_FOREGROUND", RunPriority::LITE_PRIORITY_FOREGROUND);
+}
+
 void BindLiteCLTuneMode(py::module *m) {
   py::enum_<CLTuneMode>(*m, "CLTuneMode")
       .value("CL_TUNE_NONE", CLTuneMode::CL_TUNE_NONE)
@@ -246,6 +288,14 @@ void BindLiteCLTuneMode(py::module *m) {
       .value("CL_TUNE_EXHAUSTIVE", CLTuneMode::CL_TUNE_EXHAUSTIVE);
 }
 
+void BindLiteARMTuneMode(py::module *m) {
+  py::enum_<ARMTuneMode>(*m, "ARMTuneMode")
+      .value("ARM_TUNE_NONE", ARMTuneMode::ARM_TUNE_NONE)
+      .value("ARM_TUNE_RAPID", ARMTuneMode::ARM_TUNE_RAPID)
+      .value("ARM_TUNE_NORMAL", ARMTuneMode::ARM_TUNE_NORMAL)
+      .value("ARM_TUNE_EXHAUSTIVE", ARMTuneMode::ARM_TUNE_EXHAUSTIVE);
+}
+
 void BindLiteCLPrecisionType(py::module *m) {
   py::enum_<CLPrecisionType>(*m, "CLPrecisionType")
       .value("CL_PRECISION_AUTO", CLPrecisionType::CL_PRECISION_AUTO)
@@ -280,7 +330,8 @@ void BindLitePlace(py::module *m) {
       .value("IMAGINATION_NNA", TargetType::kImaginationNNA)
       .value("INTEL_FPGA", TargetType::kIntelFPGA)
       .value("Metal", TargetType::kMetal)
-      .value("NNAdapter", TargetType::kNNAdapter);
+      .value("NNAdapter", TargetType::kNNAdapter)
+      .value("Vulkan", TargetType::kVulkan);
 
   // PrecisionType
   py::enum_<PrecisionType>(*m, "PrecisionType")
@@ -294,7 +345,8 @@ void BindLitePlace(py::module *m) {
       .value("INT64", PrecisionType::kInt64)
       .value("INT16", PrecisionType::kInt16)
       .value("UINT8", PrecisionType::kUInt8)
-      .value("FP64", PrecisionType::kFP64);
+      .value("FP64", PrecisionType::kFP64)
+      .value("BF16", PrecisionType::kBF16);
 
   // DataLayoutType
   py::enum_<DataLayoutType>(*m, "DataLayoutType")
@@ -318,6 +370,122 @@ void BindLitePlace(py::module *m) {
       .def("is_valid", &Place::is_valid);
 }
 
+// The handle of a run submitted by run_async(), whose wait() releases the
+// GIL.
+class AsyncRun {
+ public:
+  explicit AsyncRun(std::shared_future<void> future) : future_(future) {}
+
+  void Wait() const { future_.wait(); }
+
+  bool Done() const {
+    return future_.wait_for(std::chrono::seconds(0)) ==
+           std::future_status::ready;
+  }
+
+ private:
+  std::shared_future<void> future_;
+};
+
+// Run the predictor on the internal executor, `callback` is called with the
+// GIL held once the run completes. The predictor and its inputs must be
+// kept until then.
+template <typename PredictorT>
+AsyncRun RunAsync(PredictorT *self, py::object callback) {
+  auto promise = std::make_shared<std::promise<void>>();
+  // The callback is released in the executor thread, so take the GIL.
+  std::shared_ptr<py::object> holder(new py::object(callback),
+                                     [](py::object *object) {
+                                       py::gil_scoped_acquire acquire;
+                                       delete object;
+                                     });
+  self->RunAsync([promise, holder]() {
+    {
+      py::gil_scoped_acquire acquire;
+      if (!holder->is_none()) {
+        try {
+          (*holder)();
+        } catch (py::error_already_set &e) {
+          LOG(ERROR) << "The callback of run_async raised: " << e.what();
+        }
+      }
+    }
+    promise->set_value();
+  });
+  return AsyncRun(promise->get_future().share());
+}
+
+// Warm the predictor up for `shape_sets` on the internal executor, the
+// returned handle is done once the predictor is hot.
+template <typename PredictorT>
+AsyncRun Warmup(PredictorT *self,
+                const std::vector<std::vector<lite_api::shape_t>> &shape_sets) {
+  return AsyncRun(self->Warmup(shape_sets).share());
+}
+
+// Run the requests of `batch`, each of which is the list of the inputs, on
+// `parallelism` clones of the predictor in parallel, which share its
+// weights, and return the copied outputs of each request.
+template <typename PredictorT>
+std::vector<std::vector<py::array>> RunBatch(
+    PredictorT *self,
+    const std::vector<std::vector<py::object>> &batch,
+    int parallelism) {
+  std::vector<std::vector<py::array>> results(batch.size());
+  if (batch.empty()) {
+    return results;
+  }
+  if (parallelism <= 0) {
+    parallelism = std::max(1u, std::thread::hardware_concurrency());
+  }
+  size_t workers = std::min(batch.size(), static_cast<size_t>(parallelism));
+  std::vector<std::shared_ptr<lite_api::PaddlePredictor>> predictors;
+  for (size_t i = 0; i < workers; i++) {
+    predictors.push_back(self->Clone());
+  }
+
+  auto ascontiguousarray =
+      py::module::import("numpy").attr("ascontiguousarray");
+  for (size_t start = 0; start < batch.size(); start += workers) {
+    size_t count = std::min(batch.size() - start, workers);
+    // Keep the arrays shared with the inputs until the runs complete.
+    std::vector<py::array> inputs;
+    for (size_t k = 0; k < count; k++) {
+      const auto &request = batch[start + k];
+      for (size_t j = 0; j < request.size(); j++) {
+        py::array array = ascontiguousarray(request[j]);
+        ShareTensorWithPyArray(predictors[k]->GetInput(j).get(), array);
+        inputs.push_back(array);
+      }
+    }
+    {
+      py::gil_scoped_release release;
+      std::vector<std::thread> threads;
+      for (size_t k = 1; k < count; k++) {
+        threads.emplace_back([&predictors, k]() { predictors[k]->Run(); });
+      }
+      predictors[0]->Run();
+      for (auto &thread : threads) {
+        thread.join();
+      }
+    }
+    for (size_t k = 0; k < count; k++) {
+      size_t output_num = predictors[k]->GetOutputNames().size();
+      for (size_t j = 0; j < output_num; j++) {
+        results[start + k].push_back(
+            TensorToPyArray(*predictors[k]->GetOutput(j), true));
+      }
+    }
+  }
+  return results;
+}
+
+void BindLiteAsyncRun(py::module *m) {
+  py::class_<AsyncRun>(*m, "AsyncRun")
+      .def("wait", &AsyncRun::Wait, py::call_guard<py::gil_scoped_release>())
+      .def("done", &AsyncRun::Done);
+}
+
 void BindLiteTensor(py::module *m) {
   auto data_size_func = [](const std::vector<int64_t> &shape) -> int64_t {
     int64_t res = 1;
@@ -330,7 +498,20 @@ void BindLiteTensor(py::module *m) {
   py::class_<Tensor> tensor(*m, "Tensor");
 
   tensor.def("resize", &Tensor::Resize)
-      .def("numpy", [](Tensor &self) { return TensorToPyArray(self); })
+      .def("numpy",
+           [](Tensor &self, bool copy) { return TensorToPyArray(self, copy); },
+           py::arg("copy") = false)
+      .def("__array__",
+           [](Tensor &self, py::object dtype, py::object copy) {
+             bool need_copy = !copy.is_none() && copy.cast<bool>();
+             py::object array = TensorToPyArray(self, need_copy);
+             if (!dtype.is_none()) {
+               array = array.attr("astype")(dtype);
+             }
+             return array;
+           },
+           py::arg("dtype") = py::none(),
+           py::arg("copy") = py::none())
       .def("shape", &Tensor::shape)
       .def("target", &Tensor::target)
       .def("precision", &Tensor::precision)
@@ -339,7 +520,11 @@ void BindLiteTensor(py::module *m) {
       .def("from_numpy",
            SetTensorFromPyArray,
            py::arg("array"),
-           py::arg("place") = TargetType::kHost);
+           py::arg("place") = TargetType::kHost)
+      .def("share_numpy",
+           ShareTensorWithPyArray,
+           py::arg("array"),
+           py::keep_alive<1, 2>());
 
 #define DO_GETTER_ONCE(data_type__, name__)                           \
   tensor.def(#name__, [=](Tensor &self) -> std::vector<data_type__> { \
@@ -389,7 +574,24 @@ void BindLiteCxxPredictor(py::module *m) {
       .def("get_input_names", &CxxPaddleApiImpl::GetInputNames)
       .def("get_input_by_name", &CxxPaddleApiImpl::GetInputByName)
       .def("get_output_by_name", &CxxPaddleApiImpl::GetOutputByName)
-      .def("run", &CxxPaddleApiImpl::Run)
+      .def("run",
+           &CxxPaddleApiImpl::Run,
+           py::call_guard<py::gil_scoped_release>())
+      .def("run_async",
+           &RunAsync<CxxPaddleApiImpl>,
+           py::arg("callback") = py::none())
+      .def("warmup",
+           &Warmup<CxxPaddleApiImpl>,
+           py::arg("shape_sets"),
+           py::call_guard<py::gil_scoped_release>())
+      .def("run_batch",
+           &RunBatch<CxxPaddleApiImpl>,
+           py::arg("batch"),
+           py::arg("parallelism") = 0)
+      .def("set_stream_states", &CxxPaddleApiImpl::SetStreamStates)
+      .def("select_stream", &CxxPaddleApiImpl::SelectStream)
+      .def("reset_stream", &CxxPaddleApiImpl::ResetStream)
+      .def("release_stream", &CxxPaddleApiImpl::ReleaseStream)
       .def("get_version", &CxxPaddleApiImpl::GetVersion)
       .def("save_optimized_pb_model",
            [](CxxPaddleApiImpl &self, const std::string &output_dir) {
@@ -413,7 +615,24 @@ void BindLiteLightPredictor(py::module *m) {
       .def("get_output_names", &LightPredictorImpl::GetOutputNames)
       .def("get_input_by_name", &LightPredictorImpl::GetInputByName)
       .def("get_output_by_name", &LightPredictorImpl::GetOutputByName)
-      .def("run", &LightPredictorImpl::Run)
+      .def("run",
+           &LightPredictorImpl::Run,
+           py::call_guard<py::gil_scoped_release>())
+      .def("run_async",
+           &RunAsync<LightPredictorImpl>,
+           py::arg("callback") = py::none())
+      .def("warmup",
+           &Warmup<LightPredictorImpl>,
+           py::arg("shape_sets"),
+           py::call_guard<py::gil_scoped_release>())
+      .def("run_batch",
+           &RunBatch<LightPredictorImpl>,
+           py::arg("batch"),
+           py::arg("parallelism") = 0)
+      .def("set_stream_states", &LightPredictorImpl::SetStreamStates)
+      .def("select_stream", &LightPredictorImpl::SelectStream)
+      .def("reset_stream", &LightPredictorImpl::ResetStream)
+      .def("release_stream", &LightPredictorImpl::ReleaseStream)
       .def("get_version", &LightPredictorImpl::GetVersion);
 }
 
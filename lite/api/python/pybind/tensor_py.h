@@ -94,12 +94,68 @@ inline py::array TensorToPyArray(const Tensor &tensor,
   }
 
   const void *tensor_buf_ptr = static_cast<const void *>(tensor.data<int8_t>());
+  if (need_deep_copy) {
+    py::array array(py::dtype(py_dtype_str.c_str()), py_dims, py_strides);
+    std::memcpy(array.mutable_data(), tensor_buf_ptr, numel * sizeof_dtype);
+    return array;
+  }
+  // The view is over the memory of the tensor, which is overwritten by the
+  // next run, so it is read-only.
   auto base = py::cast(std::move(tensor));
-  return py::array(py::dtype(py_dtype_str.c_str()),
-                   py_dims,
-                   py_strides,
-                   const_cast<void *>(tensor_buf_ptr),
-                   base);
+  py::array array(py::dtype(py_dtype_str.c_str()),
+                  py_dims,
+                  py_strides,
+                  const_cast<void *>(tensor_buf_ptr),
+                  base);
+  array.attr("flags").attr("writeable") = false;
+  return array;
+}
+
+////////////////////////////////////////////////////////////////
+// Function Name: PyArrayToTensorDType
+// Usage: Transform numpy dtype into corresponding Lite
+//        PrecisionType.
+////////////////////////////////////////////////////////////////
+inline PrecisionType PyArrayToTensorDType(const py::array &array) {
+#define PY_DTYPE_TO_TENSOR_DTYPE(T, proto_type)  \
+  if (py::isinstance<py::array_t<T>>(array)) { \
+    return proto_type;                          \
+  }
+
+  PY_DTYPE_TO_TENSOR_DTYPE(float, PrecisionType::kFloat)
+  PY_DTYPE_TO_TENSOR_DTYPE(double, PrecisionType::kFP64)
+  PY_DTYPE_TO_TENSOR_DTYPE(bool, PrecisionType::kBool)
+  PY_DTYPE_TO_TENSOR_DTYPE(uint8_t, PrecisionType::kUInt8)
+  PY_DTYPE_TO_TENSOR_DTYPE(int8_t, PrecisionType::kInt8)
+  PY_DTYPE_TO_TENSOR_DTYPE(int32_t, PrecisionType::kInt32)
+  PY_DTYPE_TO_TENSOR_DTYPE(int64_t, PrecisionType::kInt64)
+  PY_DTYPE_TO_TENSOR_DTYPE(int16_t, PrecisionType::kInt16)
+
+#undef PY_DTYPE_TO_TENSOR_DTYPE
+  LOG(FATAL) << "Error: Unsupported numpy data type!";
+  return PrecisionType::kUnk;
+}
+
+////////////////////////////////////////////////////////////////
+// Function Name: ShareTensorWithPyArray
+// Usage: Share the memory of a c-contiguous numpy array with
+//        the tensor without copying. The array must be kept
+//        alive and unchanged until the prediction finishes.
+////////////////////////////////////////////////////////////////
+inline void ShareTensorWithPyArray(Tensor *self, const py::array &array) {
+  CHECK(array.flags() & py::array::c_style)
+      << "tensor.share_numpy(numpy.array) requires a c-contiguous array, "
+         "please use numpy.ascontiguousarray or tensor.from_numpy.";
+  PrecisionType precision = PyArrayToTensorDType(array);
+  std::vector<int64_t> dims;
+  dims.reserve(array.ndim());
+  for (decltype(array.ndim()) i = 0; i < array.ndim(); ++i) {
+    dims.push_back(static_cast<int64_t>(array.shape()[i]));
+  }
+  self->Resize(dims);
+  self->ShareExternalMemory(
+      const_cast<void *>(array.data()), array.nbytes(), TargetType::kHost);
+  self->SetPrecision(precision);
 }
 
 ////////////////////////////////////////////////////////////////
@@ -0,0 +1,219 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/batching_predictor.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite_api {
+
+// Doubles the input and records the batch size of every run.
+class DoublePredictor : public PaddlePredictor {
+ public:
+  std::unique_ptr<Tensor> GetInput(int i) override {
+    return std::unique_ptr<Tensor>(new Tensor(&input_));
+  }
+  std::unique_ptr<const Tensor> GetOutput(int i) const override {
+    return std::unique_ptr<const Tensor>(new Tensor(&output_));
+  }
+  void Run() override {
+#ifdef LITE_WITH_EXCEPTION
+    if (throw_in_run) throw std::runtime_error("run failed");
+#endif
+    output_.Resize(input_.dims());
+    if (keep_lod) output_.set_lod(input_.lod());
+    auto* x = input_.data<float>();
+    auto* y = output_.mutable_data<float>();
+    for (int64_t i = 0; i < input_.numel(); i++) {
+      y[i] = x[i] * 2;
+    }
+    batch_sizes.push_back(input_.lod().empty() ? input_.dims()[0]
+                                               : input_.lod()[0].size() - 1);
+  }
+  std::shared_ptr<PaddlePredictor> Clone() override { return nullptr; }
+  std::shared_ptr<PaddlePredictor> Clone(
+      const std::vector<std::string>& var_names) override {
+    return nullptr;
+  }
+  std::string GetVersion() const override { return ""; }
+  std::vector<std::string> GetInputNames() override { return {"x"}; }
+  std::vector<std::string> GetOutputNames() override { return {"y"}; }
+  bool TryShrinkMemory() override { return true; }
+  std::unique_ptr<Tensor> GetInputByName(const std::string& name) override {
+    return GetInput(0);
+  }
+  std::unique_ptr<const Tensor> GetTensor(
+      const std::string& name) const override {
+    return GetOutput(0);
+  }
+
+  std::vector<int64_t> batch_sizes;
+  bool keep_lod{true};
+  bool throw_in_run{false};
+
+ private:
+  lite::Tensor input_;
+  lite::Tensor output_;
+};
+
+BatchTensor MakeTensor(const std::vector<float>& values,
+                       const shape_t& shape,
+                       const lod_t& lod = {}) {
+  BatchTensor tensor;
+  tensor.shape = shape;
+  tensor.lod = lod;
+  tensor.data.resize(values.size() * sizeof(float));
+  std::memcpy(tensor.data.data(), values.data(), tensor.data.size());
+  return tensor;
+}
+
+std::vector<float> Values(const BatchTensor& tensor) {
+  std::vector<float> values(tensor.data.size() / sizeof(float));
+  std::memcpy(values.data(), tensor.data.data(), tensor.data.size());
+  return values;
+}
+
+TEST(BatchingPredictor, dense) {
+  auto predictor = std::make_shared<DoublePredictor>();
+  std::vector<std::future<std::vector<BatchTensor>>> futures;
+  {
+    BatchingConfig config;
+    config.max_batch_size = 4;
+    config.max_wait_us = 100000;
+    BatchingPredictor batching(predictor, config);
+    for (int i = 0; i < 8; i++) {
+      float v = i;
+      futures.push_back(batching.Submit({MakeTensor({v, v + 1}, {1, 2})}));
+    }
+    for (int i = 0; i < 8; i++) {
+      auto outputs = futures[i].get();
+      ASSERT_EQ(outputs.size(), 1u);
+      EXPECT_EQ(outputs[0].shape, shape_t({1, 2}));
+      EXPECT_EQ(Values(outputs[0]), std::vector<float>({2.f * i, 2.f * i + 2}));
+    }
+  }
+  int64_t total = 0;
+  for (auto batch_size : predictor->batch_sizes) {
+    EXPECT_LE(batch_size, 4);
+    total += batch_size;
+  }
+  EXPECT_EQ(total, 8);
+  EXPECT_LT(predictor->batch_sizes.size(), 8u);
+}
+
+TEST(BatchingPredictor, lod) {
+  auto predictor = std::make_shared<DoublePredictor>();
+  BatchingConfig config;
+  config.max_batch_size = 2;
+  config.max_wait_us = 100000;
+  BatchingPredictor batching(predictor, config);
+  auto f0 = batching.Submit({MakeTensor({1, 2, 3}, {3, 1}, {{0, 3}})});
+  auto f1 = batching.Submit({MakeTensor({4, 5}, {2, 1}, {{0, 2}})});
+  auto y0 = f0.get();
+  auto y1 = f1.get();
+  EXPECT_EQ(y0[0].shape, shape_t({3, 1}));
+  EXPECT_EQ(y0[0].lod, lod_t({{0, 3}}));
+  EXPECT_EQ(Values(y0[0]), std::vector<float>({2, 4, 6}));
+  EXPECT_EQ(y1[0].shape, shape_t({2, 1}));
+  EXPECT_EQ(y1[0].lod, lod_t({{0, 2}}));
+  EXPECT_EQ(Values(y1[0]), std::vector<float>({8, 10}));
+  ASSERT_EQ(predictor->batch_sizes.size(), 1u);
+  EXPECT_EQ(predictor->batch_sizes[0], 2);
+}
+
+TEST(BatchingPredictor, unmergeable) {
+  auto predictor = std::make_shared<DoublePredictor>();
+  BatchingConfig config;
+  config.max_batch_size = 2;
+  config.max_wait_us = 1000;
+  BatchingPredictor batching(predictor, config);
+  auto f0 = batching.Submit({MakeTensor({1, 2}, {1, 2})});
+  auto f1 = batching.Submit({MakeTensor({1, 2, 3}, {1, 3})});
+  EXPECT_EQ(Values(f0.get()[0]), std::vector<float>({2, 4}));
+  EXPECT_EQ(Values(f1.get()[0]), std::vector<float>({2, 4, 6}));
+}
+
+TEST(BatchingPredictor, different_rows) {
+  auto predictor = std::make_shared<DoublePredictor>();
+  BatchingConfig config;
+  config.max_batch_size = 2;
+  config.max_wait_us = 100000;
+  BatchingPredictor batching(predictor, config);
+  auto f0 = batching.Submit({MakeTensor({1, 2, 3, 4}, {2, 2})});
+  auto f1 = batching.Submit({MakeTensor({5, 6}, {1, 2})});
+  auto y0 = f0.get();
+  auto y1 = f1.get();
+  EXPECT_EQ(y0[0].shape, shape_t({2, 2}));
+  EXPECT_EQ(Values(y0[0]), std::vector<float>({2, 4, 6, 8}));
+  EXPECT_EQ(y1[0].shape, shape_t({1, 2}));
+  EXPECT_EQ(Values(y1[0]), std::vector<float>({10, 12}));
+  EXPECT_EQ(predictor->batch_sizes, std::vector<int64_t>({2, 1}));
+}
+
+TEST(BatchingPredictor, lod_of_sequences) {
+  auto predictor = std::make_shared<DoublePredictor>();
+  BatchingConfig config;
+  config.max_batch_size = 2;
+  config.max_wait_us = 100000;
+  BatchingPredictor batching(predictor, config);
+  auto f0 = batching.Submit({MakeTensor({1, 2, 3}, {3, 1}, {{0, 1, 3}})});
+  auto f1 = batching.Submit({MakeTensor({4, 5}, {2, 1}, {{0, 2}})});
+  auto y0 = f0.get();
+  auto y1 = f1.get();
+  EXPECT_EQ(y0[0].lod, lod_t({{0, 1, 3}}));
+  EXPECT_EQ(Values(y0[0]), std::vector<float>({2, 4, 6}));
+  EXPECT_EQ(y1[0].lod, lod_t({{0, 2}}));
+  EXPECT_EQ(Values(y1[0]), std::vector<float>({8, 10}));
+  EXPECT_EQ(predictor->batch_sizes, std::vector<int64_t>({3}));
+}
+
+TEST(BatchingPredictor, unsplittable_outputs) {
+  auto predictor = std::make_shared<DoublePredictor>();
+  predictor->keep_lod = false;
+  BatchingConfig config;
+  config.max_batch_size = 2;
+  config.max_wait_us = 100000;
+  BatchingPredictor batching(predictor, config);
+  auto f0 = batching.Submit({MakeTensor({1, 2, 3}, {3, 1}, {{0, 3}})});
+  auto f1 = batching.Submit({MakeTensor({4}, {1, 1}, {{0, 1}})});
+  auto y0 = f0.get();
+  auto y1 = f1.get();
+  EXPECT_EQ(Values(y0[0]), std::vector<float>({2, 4, 6}));
+  EXPECT_EQ(Values(y1[0]), std::vector<float>({8}));
+  // Run one by one after the merged run.
+  EXPECT_EQ(predictor->batch_sizes, std::vector<int64_t>({2, 1, 1}));
+}
+
+#ifdef LITE_WITH_EXCEPTION
+TEST(BatchingPredictor, exception) {
+  auto predictor = std::make_shared<DoublePredictor>();
+  predictor->throw_in_run = true;
+  BatchingConfig config;
+  config.max_batch_size = 2;
+  config.max_wait_us = 100000;
+  BatchingPredictor batching(predictor, config);
+  auto f0 = batching.Submit({MakeTensor({1, 2}, {1, 2})});
+  auto f1 = batching.Submit({MakeTensor({3, 4}, {1, 2})});
+  EXPECT_THROW(f0.get(), std::runtime_error);
+  EXPECT_THROW(f1.get(), std::runtime_error);
+}
+#endif
+
+}  // namespace lite_api
+}  // namespace paddle
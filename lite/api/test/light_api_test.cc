@@ -99,5 +99,35 @@ TEST(LightAPI, loadNaiveBuffer) {
   }
 }
 
+TEST(LightAPI, clone) {
+  if (FLAGS_optimized_model.empty()) {
+    FLAGS_optimized_model = "lite_naive_model";
+  }
+  LightPredictor predictor(FLAGS_optimized_model, "", "");
+  auto cloned = predictor.Clone();
+  ASSERT_EQ(cloned->scope(), predictor.scope());
+  ASSERT_EQ(cloned->GetInputNames(), predictor.GetInputNames());
+  ASSERT_EQ(cloned->GetOutputNames(), predictor.GetOutputNames());
+  // The activations are private to each predictor.
+  ASSERT_NE(cloned->GetInput(0), predictor.GetInput(0));
+
+  for (auto* p : {&predictor, cloned.get()}) {
+    auto* input_tensor = p->GetInput(0);
+    input_tensor->Resize(DDim(std::vector<int64_t>({100, 100})));
+    auto* data = input_tensor->mutable_data<float>();
+    for (int i = 0; i < 100 * 100; i++) {
+      data[i] = i;
+    }
+    p->Run();
+  }
+
+  const auto* output = predictor.GetOutput(0);
+  const auto* cloned_output = cloned->GetOutput(0);
+  ASSERT_EQ(output->numel(), cloned_output->numel());
+  for (int64_t i = 0; i < output->numel(); i++) {
+    EXPECT_FLOAT_EQ(output->data<float>()[i], cloned_output->data<float>()[i]);
+  }
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -14,19 +14,29 @@
 
 #include "lite/api/tools/benchmark/benchmark.h"
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <numeric>
+#include <sstream>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 #ifdef __ANDROID__
 #include "lite/api/tools/benchmark/precision_evaluation/imagenet_image_classification/prepost_process.h"
 #endif
 #include "lite/core/version.h"
+#include "lite/utils/io.h"
 #include "lite/utils/timer.h"
 
 int main(int argc, char* argv[]) {
@@ -110,6 +120,407 @@ void RunImpl(std::shared_ptr<PaddlePredictor> predictor,
 }
 #endif
 
+void SetInputs(std::shared_ptr<PaddlePredictor> predictor,
+               const std::vector<std::vector<int64_t>>& input_shapes) {
+  for (size_t i = 0; i < input_shapes.size(); i++) {
+    auto input_tensor = predictor->GetInput(i);
+    input_tensor->Resize(input_shapes[i]);
+    // NOTE: Change input data type to other type as you need.
+    auto input_data = input_tensor->mutable_data<float>();
+    auto input_num = lite::ShapeProduction(input_shapes[i]);
+    if (FLAGS_input_data_path.empty()) {
+      for (auto j = 0; j < input_num; j++) {
+        input_data[j] = 1.f;
+      }
+    } else {
+      auto paths = lite::Split(FLAGS_input_data_path, ":");
+      std::ifstream fs(paths[i]);
+      if (!fs.is_open()) {
+        std::cerr << "Open input image " << paths[i] << " error." << std::endl;
+      }
+      for (int k = 0; k < input_num; k++) {
+        fs >> input_data[k];
+      }
+      fs.close();
+    }
+  }
+}
+
+std::vector<ReplayRequest> LoadReplayRequests(const std::string& path,
+                                              size_t input_num) {
+  std::vector<ReplayRequest> requests;
+  if (lite::IsDir(path)) {
+    auto files = lite::ListFile(path);
+    files.erase(std::remove_if(files.begin(),
+                               files.end(),
+                               [](const std::string& name) {
+                                 return name.size() < 4 ||
+                                        name.substr(name.size() - 4) != ".npy";
+                               }),
+                files.end());
+    std::sort(files.begin(), files.end());
+    CHECK(input_num > 0 && files.size() % input_num == 0)
+        << "The num of .npy files " << files.size() << " in " << path
+        << " is not a multiple of the num of inputs " << input_num;
+    for (size_t i = 0; i < files.size(); i += input_num) {
+      ReplayRequest request;
+      for (size_t j = 0; j < input_num; j++) {
+        request.files.push_back(path + "/" + files[i + j]);
+      }
+      requests.push_back(request);
+    }
+  } else {
+    for (auto& line : lite::ReadLines(path)) {
+      if (line.empty() || line[0] == '#') continue;
+      ReplayRequest request;
+      request.shapes = lite::GetShapes(line);
+      CHECK_EQ(request.shapes.size(), input_num)
+          << "The num of shapes of the request '" << line
+          << "' mismatches the num of inputs";
+      requests.push_back(request);
+    }
+  }
+  CHECK(!requests.empty()) << "No request to replay in " << path;
+  return requests;
+}
+
+// Load a .npy file of the version 1.0, 2.0 or 3.0 in the C order, see
+// https://numpy.org/doc/stable/reference/generated/numpy.lib.format.html
+void SetNpyInput(Tensor* tensor, const std::string& file) {
+  std::vector<char> buffer;
+  CHECK(lite::ReadFile(file, &buffer)) << "Open " << file << " error.";
+  const std::string magic = "\x93NUMPY";
+  CHECK(buffer.size() > 10 && std::string(buffer.data(), 6) == magic)
+      << file << " is not a .npy file.";
+  auto major = static_cast<uint8_t>(buffer[6]);
+  size_t header_len = static_cast<uint8_t>(buffer[8]) |
+                      static_cast<uint8_t>(buffer[9]) << 8;
+  size_t offset = 10;
+  if (major >= 2) {
+    CHECK_GT(buffer.size(), 12u);
+    header_len |= static_cast<uint8_t>(buffer[10]) << 16 |
+                  static_cast<uint8_t>(buffer[11]) << 24;
+    offset = 12;
+  }
+  CHECK_LE(offset + header_len, buffer.size());
+  std::string header(buffer.data() + offset, header_len);
+  offset += header_len;
+  CHECK(header.find("'fortran_order': False") != std::string::npos)
+      << "Only the C order is supported in " << file;
+  auto descr_pos = header.find("'descr'");
+  CHECK(descr_pos != std::string::npos);
+  auto descr_begin = header.find('\'', header.find(':', descr_pos)) + 1;
+  auto descr = header.substr(descr_begin,
+                             header.find('\'', descr_begin) - descr_begin);
+  auto shape_begin = header.find('(', header.find("'shape'")) + 1;
+  auto shape_str =
+      header.substr(shape_begin, header.find(')', shape_begin) - shape_begin);
+  std::vector<int64_t> shape;
+  for (auto& dim : lite::Split(shape_str, ",")) {
+    if (dim.find_first_of("0123456789") != std::string::npos) {
+      shape.push_back(std::stoll(dim));
+    }
+  }
+  tensor->Resize(shape);
+  size_t num = lite::ShapeProduction(shape);
+  size_t bytes = 0;
+  void* data = nullptr;
+  if (descr == "<f4") {
+    bytes = num * sizeof(float);
+    data = tensor->mutable_data<float>();
+  } else if (descr == "<i8") {
+    bytes = num * sizeof(int64_t);
+    data = tensor->mutable_data<int64_t>();
+  } else if (descr == "<i4") {
+    bytes = num * sizeof(int32_t);
+    data = tensor->mutable_data<int32_t>();
+  } else {
+    LOG(FATAL) << "Unsupported dtype " << descr << " of " << file;
+  }
+  CHECK_EQ(offset + bytes, buffer.size())
+      << "The size of the data mismatches the shape in " << file;
+  memcpy(data, buffer.data() + offset, bytes);
+}
+
+void SetReplayInputs(std::shared_ptr<PaddlePredictor> predictor,
+                     const ReplayRequest& request) {
+  if (!request.shapes.empty()) {
+    for (size_t i = 0; i < request.shapes.size(); i++) {
+      auto input_tensor = predictor->GetInput(i);
+      input_tensor->Resize(request.shapes[i]);
+      auto input_data = input_tensor->mutable_data<float>();
+      auto input_num = lite::ShapeProduction(request.shapes[i]);
+      std::fill(input_data, input_data + input_num, 1.f);
+    }
+    return;
+  }
+  for (size_t i = 0; i < request.files.size(); i++) {
+    SetNpyInput(predictor->GetInput(i).get(), request.files[i]);
+  }
+}
+
+// The peak resident set size in kB read from /proc/self/status, return -1 if
+// it's unavailable.
+int64_t ReadPeakRss() {
+  std::ifstream fs("/proc/self/status");
+  std::string line;
+  while (std::getline(fs, line)) {
+    if (line.compare(0, 6, "VmHWM:") == 0) {
+      return std::stoll(line.substr(6));
+    }
+  }
+  return -1;
+}
+
+// The busy and total jiffies of the online cpus read from /proc/stat.
+std::map<int, std::pair<uint64_t, uint64_t>> ReadCpuTimes() {
+  std::map<int, std::pair<uint64_t, uint64_t>> times;
+  std::ifstream fs("/proc/stat");
+  std::string line;
+  while (std::getline(fs, line)) {
+    if (line.compare(0, 3, "cpu") != 0) break;
+    // Skip the line of all of the cpus.
+    if (line.size() < 4 || !isdigit(line[3])) continue;
+    std::istringstream is(line.substr(3));
+    int cpu = 0;
+    uint64_t user = 0, nice = 0, system = 0, idle = 0, iowait = 0, irq = 0,
+             softirq = 0, steal = 0;
+    is >> cpu >> user >> nice >> system >> idle >> iowait >> irq >> softirq >>
+        steal;
+    uint64_t busy = user + nice + system + irq + softirq + steal;
+    times[cpu] = std::make_pair(busy, busy + idle + iowait);
+  }
+  return times;
+}
+
+// Read the frequency in MHz from /sys/devices/system/cpu/cpu*/cpufreq/`name`,
+// return -1 if it's unavailable.
+int ReadCpuFreq(int cpu, const std::string& name) {
+  std::ifstream fs("/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+                   "/cpufreq/" + name);
+  int khz = -1;
+  if (!(fs >> khz)) return -1;
+  return khz / 1000;
+}
+
+#ifdef __ANDROID__
+// Read a value of /sys/class/power_supply/battery/`name`, return false if it's
+// unavailable.
+bool ReadBatteryValue(const std::string& name, int64_t* value) {
+  std::ifstream fs("/sys/class/power_supply/battery/" + name);
+  return static_cast<bool>(fs >> *value);
+}
+
+// Sample the power drawn from the battery every 10ms between Start and Stop.
+class EnergyMeter {
+ public:
+  void Start() {
+    samples_.clear();
+    stop_ = false;
+    begin_ = std::chrono::steady_clock::now();
+    sampler_ = std::thread([this]() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      do {
+        int64_t current_ua = 0;
+        int64_t voltage_uv = 0;
+        if (ReadBatteryValue("current_now", &current_ua) &&
+            ReadBatteryValue("voltage_now", &voltage_uv)) {
+          // The sign of the discharging current differs by the vendors.
+          samples_.push_back(std::abs(current_ua) * 1e-6 * voltage_uv * 1e-6);
+        }
+      } while (!cv_.wait_for(
+          lock, std::chrono::milliseconds(10), [this]() { return stop_; }));
+    });
+  }
+
+  // Return the average power in W, or -1 if the battery is unavailable.
+  double Stop() {
+    seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             begin_)
+                   .count();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    sampler_.join();
+    if (samples_.empty()) return -1;
+    return std::accumulate(samples_.begin(), samples_.end(), 0.0) /
+           samples_.size();
+  }
+  double seconds() const { return seconds_; }
+
+ private:
+  std::thread sampler_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_{false};
+  std::vector<double> samples_;
+  std::chrono::steady_clock::time_point begin_;
+  double seconds_{0};
+};
+#endif  // __ANDROID__
+
+// The phases of the cold start and the PrepareForRun of the op types taking
+// the most time.
+std::string ColdStartInfo(const RuntimeStats& stats) {
+  auto ms = [](uint64_t ns) { return ns / 1e6; };
+  auto& cold_start = stats.cold_start;
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3) << std::left;
+  ss << "\nCold Start(unit: ms):\n";
+  ss << "read file      = " << std::setw(12) << ms(cold_start.read_file_ns)
+     << std::endl;
+  ss << "parse          = " << std::setw(12) << ms(cold_start.parse_ns)
+     << std::endl;
+  ss << "optimize       = " << std::setw(12) << ms(cold_start.optimize_ns)
+     << std::endl;
+  ss << "create kernels = " << std::setw(12)
+     << ms(cold_start.create_kernels_ns) << std::endl;
+  ss << "first run      = " << std::setw(12) << ms(cold_start.first_run_ns)
+     << std::endl;
+  std::vector<RuntimeStats::OpStats> ops;
+  uint64_t prepare_ns = 0;
+  for (auto& op : stats.ops) {
+    if (op.prepare_time_ns == 0) continue;
+    ops.push_back(op);
+    prepare_ns += op.prepare_time_ns;
+  }
+  std::sort(ops.begin(),
+            ops.end(),
+            [](const RuntimeStats::OpStats& a, const RuntimeStats::OpStats& b) {
+              return a.prepare_time_ns > b.prepare_time_ns;
+            });
+  ss << "  PrepareForRun = " << ms(prepare_ns) << std::endl;
+  for (auto& op : ops) {
+    ss << "    " << std::setw(24) << op.op_type << ms(op.prepare_time_ns)
+       << std::endl;
+  }
+  return ss.str();
+}
+
+std::string RunConcurrently(
+    std::shared_ptr<PaddlePredictor> predictor,
+    const std::vector<std::vector<int64_t>>& input_shapes) {
+  std::vector<std::shared_ptr<PaddlePredictor>> predictors{predictor};
+  for (int i = 1; i < FLAGS_concurrency; i++) {
+    predictors.push_back(predictor->Clone());
+    SetInputs(predictors.back(), input_shapes);
+  }
+  for (auto& p : predictors) {
+    for (int i = 0; i < FLAGS_warmup; i++) p->Run();
+  }
+
+  // Sample the cpu frequencies periodically to detect the throttling.
+  auto cpu_times_begin = ReadCpuTimes();
+  std::map<int, std::vector<int>> freqs;
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool stop = false;
+  std::thread sampler([&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    do {
+      for (auto& item : cpu_times_begin) {
+        int freq = ReadCpuFreq(item.first, "scaling_cur_freq");
+        if (freq > 0) freqs[item.first].push_back(freq);
+      }
+    } while (!cv.wait_for(
+        lock, std::chrono::milliseconds(100), [&]() { return stop; }));
+  });
+
+  std::vector<std::vector<float>> latencies(predictors.size());
+  std::vector<std::thread> workers;
+  auto begin = std::chrono::steady_clock::now();
+  auto deadline =
+      begin + std::chrono::microseconds(
+                  static_cast<int64_t>(FLAGS_duration * 1000000));
+  for (size_t i = 0; i < predictors.size(); i++) {
+    workers.emplace_back([&, i]() {
+      lite::Timer timer;
+      while (std::chrono::steady_clock::now() < deadline) {
+        timer.Start();
+        predictors[i]->Run();
+        latencies[i].push_back(timer.Stop());
+      }
+    });
+  }
+  for (auto& worker : workers) worker.join();
+  auto seconds = std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - begin)
+                     .count();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  cv.notify_all();
+  sampler.join();
+  auto cpu_times_end = ReadCpuTimes();
+
+  std::vector<float> all_latencies;
+  for (auto& item : latencies) {
+    all_latencies.insert(all_latencies.end(), item.begin(), item.end());
+  }
+  std::sort(all_latencies.begin(), all_latencies.end());
+  auto Percentile = [&](double p) {
+    if (all_latencies.empty()) return 0.f;
+    size_t index = static_cast<size_t>(p * all_latencies.size());
+    return all_latencies[std::min(index, all_latencies.size() - 1)];
+  };
+
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3) << std::left;
+  ss << "concurrency: " << predictors.size() << std::endl;
+  ss << "duration(sec): " << seconds << std::endl;
+  ss << "requests: " << all_latencies.size() << std::endl;
+  ss << "qps   = " << std::setw(12) << all_latencies.size() / seconds
+     << std::endl;
+  ss << "Latency(unit: ms):\n";
+  ss << "p50   = " << std::setw(12) << Percentile(0.5) << std::endl;
+  ss << "p90   = " << std::setw(12) << Percentile(0.9) << std::endl;
+  ss << "p99   = " << std::setw(12) << Percentile(0.99) << std::endl;
+  ss << "p999  = " << std::setw(12) << Percentile(0.999) << std::endl;
+  ss << "\nCPU Usage(utilization %, frequency MHz min/avg/max of max):\n";
+  for (auto& item : cpu_times_end) {
+    int cpu = item.first;
+    double utilization = 0;
+    auto it = cpu_times_begin.find(cpu);
+    if (it != cpu_times_begin.end() &&
+        item.second.second > it->second.second) {
+      utilization = 100.0 * (item.second.first - it->second.first) /
+                    (item.second.second - it->second.second);
+    }
+    ss << "cpu" << std::setw(4) << cpu << std::setprecision(1)
+       << std::setw(7) << utilization;
+    auto& samples = freqs[cpu];
+    if (!samples.empty()) {
+      auto minmax = std::minmax_element(samples.begin(), samples.end());
+      auto avg = std::accumulate(samples.begin(), samples.end(), 0.0) /
+                 samples.size();
+      int scaling_max = ReadCpuFreq(cpu, "scaling_max_freq");
+      int cpuinfo_max = ReadCpuFreq(cpu, "cpuinfo_max_freq");
+      ss << " " << *minmax.first << "/" << static_cast<int>(avg) << "/"
+         << *minmax.second << " of " << cpuinfo_max;
+      // The cpu is considered throttled if it's busy but the frequency of the
+      // last quarter of the samples drops by more than 10% from the first
+      // quarter, or it's capped below the hardware maximum.
+      size_t quarter = std::max<size_t>(samples.size() / 4, 1);
+      auto head = std::accumulate(samples.begin(),
+                                  samples.begin() + quarter,
+                                  0.0) / quarter;
+      auto tail = std::accumulate(samples.end() - quarter,
+                                  samples.end(),
+                                  0.0) / quarter;
+      bool capped = scaling_max > 0 && cpuinfo_max > 0 &&
+                    scaling_max < cpuinfo_max * 0.9;
+      if (utilization > 50 && (tail < head * 0.9 || capped)) {
+        ss << " (throttled)";
+      }
+    }
+    ss << std::setprecision(3) << std::endl;
+  }
+  return ss.str();
+}
+
 void Run(const std::string& model_file,
          const std::vector<std::vector<int64_t>>& input_shapes) {
   lite::Timer timer;
@@ -120,6 +531,7 @@ void Run(const std::string& model_file,
 #endif
   std::map<std::string, std::string> config;
   std::vector<std::string> image_files;
+  std::vector<int> image_label_ids;
   std::vector<std::string> word_labels;
 
   // Create predictor
@@ -127,31 +539,13 @@ void Run(const std::string& model_file,
   auto predictor = CreatePredictor(model_file);
   perf_data.set_init_time(timer.Stop());
 
-  // Set inputs
-  if (FLAGS_validation_set.empty()) {
-    for (size_t i = 0; i < input_shapes.size(); i++) {
-      auto input_tensor = predictor->GetInput(i);
-      input_tensor->Resize(input_shapes[i]);
-      // NOTE: Change input data type to other type as you need.
-      auto input_data = input_tensor->mutable_data<float>();
-      auto input_num = lite::ShapeProduction(input_shapes[i]);
-      if (FLAGS_input_data_path.empty()) {
-        for (auto j = 0; j < input_num; j++) {
-          input_data[j] = 1.f;
-        }
-      } else {
-        auto paths = lite::Split(FLAGS_input_data_path, ":");
-        std::ifstream fs(paths[i]);
-        if (!fs.is_open()) {
-          std::cerr << "Open input image " << paths[i] << " error."
-                    << std::endl;
-        }
-        for (int k = 0; k < input_num; k++) {
-          fs >> input_data[k];
-        }
-        fs.close();
-      }
-    }
+  // Set inputs, the recorded requests are replayed in turn before each run
+  std::vector<ReplayRequest> requests;
+  if (!FLAGS_replay_path.empty()) {
+    requests = LoadReplayRequests(FLAGS_replay_path,
+                                  predictor->GetInputNames().size());
+  } else if (FLAGS_validation_set.empty()) {
+    SetInputs(predictor, input_shapes);
   } else {
 #ifdef __ANDROID__
     config = LoadConfigTxt(FLAGS_config_path);
@@ -167,12 +561,50 @@ void Run(const std::string& model_file,
       std::string image_file = line.substr(0, line.find(" "));
       std::string label_id = line.substr(line.find(" ") + 1, line.length());
       image_files.push_back(image_file);
+      image_label_ids.push_back(atoi(label_id.c_str()));
     }
 #endif
   }
 
+  // Run the cloned predictors concurrently in the throughput mode instead of
+  // the sequential runs
+  std::string concurrency_info;
+  int warmup = FLAGS_warmup;
+  int repeats = FLAGS_repeats;
+  if (FLAGS_concurrency > 0) {
+    concurrency_info = RunConcurrently(predictor, input_shapes);
+    warmup = 0;
+    repeats = 0;
+  }
+
+#ifdef __ANDROID__
+  // Evaluate the whole validation set on the cloned predictors instead
+  std::vector<float> evaluated_accuracies;
+  double evaluation_seconds = 0;
+  bool evaluate = !FLAGS_validation_set.empty() &&
+                  FLAGS_validation_loader_threads > 0 && !image_files.empty();
+  if (evaluate) {
+    std::vector<std::shared_ptr<PaddlePredictor>> predictors{predictor};
+    for (int i = 1; i < FLAGS_validation_predictors; i++) {
+      predictors.push_back(predictor->Clone());
+    }
+    timer.Start();
+    evaluated_accuracies = task->Evaluate(predictors,
+                                          config,
+                                          image_files,
+                                          image_label_ids,
+                                          FLAGS_validation_loader_threads);
+    evaluation_seconds = timer.Stop() / 1000.0;
+    warmup = 0;
+    repeats = 0;
+  }
+#endif
+
   // Warmup
-  for (int i = 0; i < FLAGS_warmup; ++i) {
+  for (int i = 0; i < warmup; ++i) {
+    if (!requests.empty()) {
+      SetReplayInputs(predictor, requests[i % requests.size()]);
+    }
 #ifdef __ANDROID__
     RunImpl(predictor,
             &perf_data,
@@ -188,8 +620,24 @@ void Run(const std::string& model_file,
     timer.SleepInMs(FLAGS_run_delay);
   }
 
+#ifdef __ANDROID__
+  // The idle power is sampled ahead to tell the power of the inference apart.
+  EnergyMeter energy_meter;
+  double idle_watts = -1;
+  double run_watts = -1;
+  if (FLAGS_enable_energy_profile && repeats > 0) {
+    energy_meter.Start();
+    timer.SleepInMs(1000);
+    idle_watts = energy_meter.Stop();
+    energy_meter.Start();
+  }
+#endif
+
   // Run
-  for (int i = 0; i < FLAGS_repeats; ++i) {
+  for (int i = 0; i < repeats; ++i) {
+    if (!requests.empty()) {
+      SetReplayInputs(predictor, requests[i % requests.size()]);
+    }
 #ifdef __ANDROID__
     RunImpl(predictor,
             &perf_data,
@@ -204,6 +652,11 @@ void Run(const std::string& model_file,
 #endif
     timer.SleepInMs(FLAGS_run_delay);
   }
+#ifdef __ANDROID__
+  if (FLAGS_enable_energy_profile && repeats > 0) {
+    run_watts = energy_meter.Stop();
+  }
+#endif
 
   // Get output
   size_t output_tensor_num = predictor->GetOutputNames().size();
@@ -255,15 +708,25 @@ void Run(const std::string& model_file,
   } else {
     input_data_path = config.at("ground_truth_images_path");
   }
-  ss << "input_data_path: " << input_data_path << std::endl;
-  ss << "input_shape: " << FLAGS_input_shape << std::endl;
+  if (requests.empty()) {
+    ss << "input_data_path: " << input_data_path << std::endl;
+    ss << "input_shape: " << FLAGS_input_shape << std::endl;
+  } else {
+    ss << "replay_path: " << FLAGS_replay_path << std::endl;
+    ss << "replay requests: " << requests.size() << std::endl;
+  }
   ss << out_ss.str();
   ss << "\n======= Runtime Info =======\n";
   ss << "benchmark_bin version: " << lite::version() << std::endl;
   ss << "threads: " << FLAGS_threads << std::endl;
   ss << "power_mode: " << FLAGS_power_mode << std::endl;
   ss << "warmup: " << FLAGS_warmup << std::endl;
-  ss << "repeats: " << FLAGS_repeats << std::endl;
+  if (FLAGS_concurrency > 0) {
+    ss << "concurrency: " << FLAGS_concurrency << std::endl;
+    ss << "duration(sec): " << FLAGS_duration << std::endl;
+  } else {
+    ss << "repeats: " << FLAGS_repeats << std::endl;
+  }
   if (FLAGS_run_delay > 0.f) {
     ss << "run_delay(sec): " << FLAGS_run_delay << std::endl;
   }
@@ -286,8 +749,10 @@ void Run(const std::string& model_file,
     ss << "config: " << FLAGS_config_path << std::endl;
     ss << lite::ReadFile(FLAGS_config_path) << std::endl;
     ss << std::fixed << std::left;
-    auto topk_accuracies =
-        task->topk_accuracies(stoi(config.at("topk")), FLAGS_repeats);
+    int topk = stoi(config.at("topk"));
+    auto topk_accuracies = evaluate
+                               ? evaluated_accuracies
+                               : task->topk_accuracies(topk, FLAGS_repeats);
     for (int i = 0; i < topk_accuracies.size(); i++) {
       auto str = lite::string_format(
           "Top-%d Accurancy: %.3f", i + 1, topk_accuracies[i]);
@@ -299,17 +764,64 @@ void Run(const std::string& model_file,
 
   ss << "\n======= Perf Info =======\n";
   ss << std::fixed << std::left;
+  if (FLAGS_concurrency > 0) {
+    ss << concurrency_info;
+    std::cout << ss.str() << std::endl;
+    StoreBenchmarkResult(ss.str());
+    return;
+  }
+#ifdef __ANDROID__
+  if (evaluate) {
+    ss << "images: " << image_files.size() << std::endl;
+    ss << "loader threads: " << FLAGS_validation_loader_threads << std::endl;
+    ss << "predictors: " << FLAGS_validation_predictors << std::endl;
+    ss << "duration(sec): " << evaluation_seconds << std::endl;
+    ss << "images/sec = " << std::setw(12)
+       << image_files.size() / std::max(evaluation_seconds, 1e-6)
+       << std::endl;
+    std::cout << ss.str() << std::endl;
+    StoreBenchmarkResult(ss.str());
+    return;
+  }
+#endif
   ss << "Time(unit: ms):\n";
   ss << "init  = " << std::setw(12) << perf_data.init_time() << std::endl;
   ss << "first = " << std::setw(12) << perf_data.first_time() << std::endl;
   ss << "min   = " << std::setw(12) << perf_data.min_run_time() << std::endl;
   ss << "max   = " << std::setw(12) << perf_data.max_run_time() << std::endl;
   ss << "avg   = " << std::setw(12) << perf_data.avg_run_time() << std::endl;
+  ss << ColdStartInfo(predictor->GetRuntimeStats());
+  if (!requests.empty()) {
+    ss << "\nPeak Memory(unit: kB):\n";
+    ss << "VmHWM = " << std::setw(12) << ReadPeakRss() << std::endl;
+  }
   if (FLAGS_enable_memory_profile) {
     ss << "\nMemory Usage(unit: kB):\n";
     ss << "init  = " << std::setw(12) << "Not supported yet" << std::endl;
     ss << "avg   = " << std::setw(12) << "Not supported yet" << std::endl;
   }
+  if (FLAGS_enable_energy_profile) {
+    ss << "\nEnergy(unit: mJ):\n";
+#ifdef __ANDROID__
+    if (idle_watts < 0 || run_watts < 0) {
+      ss << "per inference = " << std::setw(12)
+         << "Battery unavailable" << std::endl;
+    } else {
+      double seconds = energy_meter.seconds();
+      ss << "idle power(mW) = " << std::setw(12) << idle_watts * 1000
+         << std::endl;
+      ss << "run power(mW)  = " << std::setw(12) << run_watts * 1000
+         << std::endl;
+      ss << "per inference  = " << std::setw(12)
+         << run_watts * seconds * 1000 / repeats << std::endl;
+      ss << "above idle     = " << std::setw(12)
+         << (run_watts - idle_watts) * seconds * 1000 / repeats << std::endl;
+    }
+#else
+    ss << "per inference = " << std::setw(12) << "Not supported yet"
+       << std::endl;
+#endif
+  }
   std::cout << ss.str() << std::endl;
   StoreBenchmarkResult(ss.str());
 }
@@ -92,9 +92,23 @@ class PerfData {
   std::vector<float> run_time_;
 };
 
+// The inputs of a recorded request to replay: the shapes filled with 1.f, or
+// the .npy files of each input.
+struct ReplayRequest {
+  std::vector<std::vector<int64_t>> shapes;
+  std::vector<std::string> files;
+};
+
 int Benchmark(int argc, char** argv);
 void Run(const std::string& model_file,
          const std::vector<std::vector<int64_t>>& input_shape);
+std::vector<ReplayRequest> LoadReplayRequests(const std::string& path,
+                                              size_t input_num);
+void SetReplayInputs(std::shared_ptr<PaddlePredictor> predictor,
+                     const ReplayRequest& request);
+std::string RunConcurrently(
+    std::shared_ptr<PaddlePredictor> predictor,
+    const std::vector<std::vector<int64_t>>& input_shapes);
 
 #ifdef __ANDROID__
 std::string GetDeviceInfo() {
@@ -167,10 +181,16 @@ bool CheckFlagsValid() {
     std::cerr << "Must set --backend option!" << std::endl;
     ret = false;
   }
-  if (FLAGS_input_shape.empty()) {
+  if (FLAGS_input_shape.empty() && FLAGS_replay_path.empty()) {
     std::cerr << "Must set --input_shape option!" << std::endl;
     ret = false;
   }
+  if (!FLAGS_replay_path.empty() && !FLAGS_validation_set.empty()) {
+    std::cerr << "Both --replay_path and --validation_set are set. Only need "
+                 "to set one of them!"
+              << std::endl;
+    ret = false;
+  }
   if (!FLAGS_input_data_path.empty()) {
     auto paths = lite::Split(FLAGS_input_data_path, ":");
     auto shapes = lite::Split(FLAGS_input_shape, ":");
@@ -184,6 +204,22 @@ bool CheckFlagsValid() {
       ret = false;
     }
   }
+  if (FLAGS_concurrency > 0) {
+    if (!FLAGS_replay_path.empty()) {
+      std::cerr << "--replay_path is not supported with --concurrency!"
+                << std::endl;
+      ret = false;
+    }
+    if (!FLAGS_validation_set.empty()) {
+      std::cerr << "--validation_set is not supported with --concurrency!"
+                << std::endl;
+      ret = false;
+    }
+    if (FLAGS_duration <= 0) {
+      std::cerr << "--duration must be positive!" << std::endl;
+      ret = false;
+    }
+  }
   if (!FLAGS_validation_set.empty()) {
     if (FLAGS_config_path.empty()) {
       std::cerr
@@ -191,6 +227,11 @@ bool CheckFlagsValid() {
           << std::endl;
       ret = false;
     }
+    if (FLAGS_validation_loader_threads > 0 &&
+        FLAGS_validation_predictors < 1) {
+      std::cerr << "--validation_predictors must be positive!" << std::endl;
+      ret = false;
+    }
   }
 
   return ret;
@@ -14,8 +14,15 @@
 
 #include "lite/api/tools/benchmark/precision_evaluation/imagenet_image_classification/prepost_process.h"
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <mutex>   // NOLINT
+#include <numeric>
+#include <thread>  // NOLINT
 #include <utility>
 #include "lite/api/paddle_api.h"
+#include "lite/utils/cv/paddle_image_pipeline.h"
 #include "lite/utils/model_util.h"
 #include "lite/utils/string.h"
 
@@ -169,5 +176,134 @@ std::vector<float> ImagenetClassification::topk_accuracies(const int k,
   return topk_accuracies_;
 }
 
+std::vector<float> ImagenetClassification::Evaluate(
+    const std::vector<std::shared_ptr<PaddlePredictor>> &predictors,
+    const std::map<std::string, std::string> &config,
+    const std::vector<std::string> &image_files,
+    const std::vector<int> &labels,
+    const int loader_threads) {
+  const int total = static_cast<int>(image_files.size());
+  const int topk = stoi(config.at("topk"));
+  const int resize_short_size = stoi(config.at("resize_short_size"));
+  const int crop_size = stoi(config.at("crop_size"));
+  const auto mean = lite::Split<float>(config.at("mean"), ",");
+  const auto scale = lite::Split<float>(config.at("scale"), ",");
+  if (mean.size() != 3 || scale.size() != 3) {
+    std::cerr << "[ERROR] mean or scale size must equal to 3!" << std::endl;
+    std::abort();
+  }
+
+  // The decoded images are queued by the loaders, at most twice of the
+  // threads, so the memory is bounded when the inference is slower.
+  struct Sample {
+    int index;
+    cv::Mat image;
+  };
+  std::deque<Sample> samples;
+  const size_t capacity = 2 * (predictors.size() + loader_threads);
+  std::mutex mutex;
+  std::condition_variable not_empty;
+  std::condition_variable not_full;
+  int consumed = 0;
+  std::vector<int> hits(topk, 0);
+
+  std::atomic<int> next{0};
+  std::vector<std::thread> loaders;
+  for (int i = 0; i < loader_threads; i++) {
+    loaders.emplace_back([&]() {
+      for (int index = next++; index < total; index = next++) {
+        Sample sample{index, cv::imread(image_files[index], cv::IMREAD_COLOR)};
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [&]() { return samples.size() < capacity; });
+        samples.push_back(std::move(sample));
+        not_empty.notify_one();
+      }
+    });
+  }
+
+  auto infer = [&](PaddlePredictor *predictor) {
+    std::unique_ptr<Tensor> input_tensor(predictor->GetInput(0));
+    while (true) {
+      Sample sample;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(
+            lock, [&]() { return !samples.empty() || consumed == total; });
+        if (samples.empty()) break;
+        sample = std::move(samples.front());
+        samples.pop_front();
+        if (++consumed == total) not_empty.notify_all();
+        not_full.notify_one();
+      }
+      if (sample.image.empty()) {
+        std::cerr << "Failed to read image " << image_files[sample.index]
+                  << std::endl;
+        continue;
+      }
+
+      // Crop the center of the image resized by the short side, in the
+      // coordinates of the image instead.
+      const cv::Mat &img = sample.image;
+      const int short_size = std::min(img.cols, img.rows);
+      const int crop = std::min(
+          static_cast<int>(crop_size * short_size / resize_short_size),
+          short_size);
+      lite::utils::cv::PipelineParam param;
+      param.srcFormat = lite::utils::cv::BGR;
+      param.dstFormat = lite::utils::cv::RGB;
+      param.srcw = img.cols;
+      param.srch = img.rows;
+      param.crop_x = (img.cols - crop) / 2;
+      param.crop_y = (img.rows - crop) / 2;
+      param.crop_w = crop;
+      param.crop_h = crop;
+      param.dstw = crop_size;
+      param.dsth = crop_size;
+      param.layout = DATALAYOUT(kNCHW);
+      param.fp16 = false;
+      // (pixel / 255 - mean) * scale
+      for (int c = 0; c < 3; c++) {
+        param.means[c] = mean[c] * 255.f;
+        param.scales[c] = scale[c] / 255.f;
+      }
+      lite::utils::cv::ImagePipeline pipeline(param);
+      pipeline.Run(img.data, input_tensor.get());
+      predictor->Run();
+
+      std::unique_ptr<const Tensor> output_tensor(predictor->GetOutput(0));
+      const float *output_data = output_tensor->data<float>();
+      const int num = lite::ShapeProduction(output_tensor->shape());
+      const int k = std::min(topk, num);
+      std::vector<int> indices(num);
+      std::iota(indices.begin(), indices.end(), 0);
+      std::partial_sort(indices.begin(),
+                        indices.begin() + k,
+                        indices.end(),
+                        [&](int a, int b) {
+                          return output_data[a] > output_data[b];
+                        });
+      auto it = std::find(
+          indices.begin(), indices.begin() + k, labels[sample.index]);
+      if (it == indices.begin() + k) continue;
+      std::lock_guard<std::mutex> lock(mutex);
+      for (int j = it - indices.begin(); j < topk; j++) hits[j]++;
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < predictors.size(); i++) {
+    workers.emplace_back(infer, predictors[i].get());
+  }
+  infer(predictors[0].get());
+  for (auto &worker : workers) worker.join();
+  for (auto &loader : loaders) loader.join();
+
+  std::vector<float> accuracies(topk, 0.f);
+  for (int j = 0; j < topk && total > 0; j++) {
+    accuracies[j] = static_cast<float>(hits[j]) / total;
+  }
+  return accuracies;
+}
+
 }  // namespace lite_api
 }  // namespace paddle
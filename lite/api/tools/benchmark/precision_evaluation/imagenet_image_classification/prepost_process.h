@@ -51,6 +51,17 @@ class ImagenetClassification {
 
   std::vector<float> topk_accuracies(const int k, const int repeats);
 
+  // Evaluate all of the images, which are decoded by `loader_threads` ahead of
+  // the inference on the predictors running concurrently. The decoded images
+  // are cropped, resized and normalized in one pass by the fused pipeline of
+  // paddle_cv. Return the top-k accuracies of the labels.
+  std::vector<float> Evaluate(
+      const std::vector<std::shared_ptr<PaddlePredictor>> &predictors,
+      const std::map<std::string, std::string> &config,
+      const std::vector<std::string> &image_files,
+      const std::vector<int> &labels,
+      const int loader_threads);
+
  private:
   std::vector<float> topk_accuracies_;
 };
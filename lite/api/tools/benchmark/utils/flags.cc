@@ -25,7 +25,10 @@ DEFINE_string(param_file, "", param_file_msg);
 DEFINE_string(input_shape, "", input_shape_msg);
 DEFINE_string(input_data_path, "", input_data_path_msg);
 DEFINE_string(validation_set, "", validation_set_msg);
+DEFINE_int32(validation_loader_threads, 0, validation_loader_threads_msg);
+DEFINE_int32(validation_predictors, 1, validation_predictors_msg);
 DEFINE_bool(show_output_elem, false, show_output_elem_msg);
+DEFINE_string(replay_path, "", replay_path_msg);
 
 // Common runtime options
 DEFINE_int32(warmup, 0, warmup_msg);
@@ -34,6 +37,8 @@ DEFINE_double(run_delay, -1.0, run_delay_msg);
 DEFINE_int32(power_mode, 0, power_mode_msg);
 DEFINE_int32(threads, 1, threads_msg);
 DEFINE_string(result_path, "", result_path_msg);
+DEFINE_int32(concurrency, 0, concurrency_msg);
+DEFINE_double(duration, 10.0, duration_msg);
 
 // Backend options
 DEFINE_string(backend, "", backend_msg);
@@ -56,6 +61,7 @@ DEFINE_string(nnadapter_context_properties,
 DEFINE_bool(enable_op_time_profile, false, enable_op_time_profile_msg);
 DEFINE_bool(enable_memory_profile, false, enable_memory_profile_msg);
 DEFINE_int32(memory_check_interval_ms, 5, memory_check_interval_ms_msg);
+DEFINE_bool(enable_energy_profile, false, enable_energy_profile_msg);
 
 // Configuration options
 DEFINE_string(config_path, "", config_path_msg);
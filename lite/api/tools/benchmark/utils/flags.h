@@ -47,8 +47,23 @@ static const char validation_set_msg[] =
     "Use validation images and lables as inputs. Only supports a minival "
     "dataset of ILSVRC_2012 as inputs."
     "Supported set: ILSVRC_2012";
+static const char validation_loader_threads_msg[] =
+    "Decode the images of --validation_set on the given number of threads "
+    "ahead of the inference, and evaluate the whole set instead of "
+    "--repeats images. Non-positive values mean the sequential runs.";
+static const char validation_predictors_msg[] =
+    "The number of the cloned predictors evaluating the images concurrently "
+    "when --validation_loader_threads is set.";
 static const char show_output_elem_msg[] =
     "Show each output tensor's all elements.";
+static const char replay_path_msg[] =
+    "Replay the recorded inputs instead of --input_shape and "
+    "--input_data_path, one request per run in turn. Either a shape log "
+    "file, each line of which is the shapes of a request in the format of "
+    "--input_shape and the inputs are filled with 1.0, or a directory of "
+    ".npy files(float32, int32 or int64), every N files in the order of "
+    "the filenames are the N inputs of a request, e.g. 0000_0.npy and "
+    "0000_1.npy.";
 
 // Common runtime options
 static const char warmup_msg[] = "warmup times";
@@ -64,6 +79,13 @@ static const char power_mode_msg[] =
     "3 for no bind";
 static const char threads_msg[] = "threads num";
 static const char result_path_msg[] = "Save benchmark info to the file.";
+static const char concurrency_msg[] =
+    "Run the given number of cloned predictors concurrently for --duration "
+    "seconds, and report the throughput, the latency percentiles, the cpu "
+    "utilization and the cpu frequencies instead of the sequential latency. "
+    "Non-positive values mean the sequential mode.";
+static const char duration_msg[] =
+    "The duration in seconds of the runs when --concurrency is set.";
 
 // Backend options
 static const char backend_msg[] =
@@ -106,6 +128,12 @@ static const char memory_check_interval_ms_msg[] =
     "The interval in millisecond between two consecutive memory "
     "footprint checks. This is only used when "
     "--enable_memory_profile is set to true. Not supported yet.";
+static const char enable_energy_profile_msg[] =
+    "Whether to report the energy per inference by sampling the current and "
+    "the voltage of /sys/class/power_supply/battery during the repeats, "
+    "which includes --run_delay. The device must run on the battery, and "
+    "the repeats should last for seconds since the fuel gauge updates slowly. "
+    "Only supported on Android.";
 
 // Configuration options
 static const char config_path_msg[] = "Configuration options.";
@@ -120,7 +148,10 @@ DECLARE_string(param_file);
 DECLARE_string(input_shape);
 DECLARE_string(input_data_path);
 DECLARE_string(validation_set);
+DECLARE_int32(validation_loader_threads);
+DECLARE_int32(validation_predictors);
 DECLARE_bool(show_output_elem);
+DECLARE_string(replay_path);
 
 // Common runtime options
 DECLARE_int32(warmup);
@@ -129,6 +160,8 @@ DECLARE_double(run_delay);
 DECLARE_int32(power_mode);
 DECLARE_int32(threads);
 DECLARE_string(result_path);
+DECLARE_int32(concurrency);
+DECLARE_double(duration);
 
 // Backend options
 DECLARE_string(backend);
@@ -145,6 +178,7 @@ DECLARE_string(nnadapter_context_properties);
 DECLARE_bool(enable_op_time_profile);
 DECLARE_bool(enable_memory_profile);
 DECLARE_int32(memory_check_interval_ms);
+DECLARE_bool(enable_energy_profile);
 
 // Configuration options
 DECLARE_string(config_path);
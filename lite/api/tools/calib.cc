@@ -0,0 +1,501 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Collect the thresholds of the activations of a fp32 model by running a
+// calibration dataset with the cpu kernels, which are saved as a
+// calibration table for `opt --calib_table` to generate the int8 model.
+// The min of each activation is saved as well, the non-negative ones are
+// quantized asymmetrically on arm.
+//
+// Each line of the calibration data list is a batch, which is the paths of
+// the raw fp32 files of the inputs separated by spaces, in the order and the
+// shapes of --input_shape.
+//
+// With --mixed_precision_config, the precisions of the ops with weights are
+// searched after the calibration. The increase of the relative L2 error of
+// the outputs and the decrease of the latency are measured for each op run
+// in int8 (and fp16 on the arm builds with ENABLE_ARM_FP16) alone, then the
+// ops are lowered greedily by the least error per saved latency under
+// --error_budget. The config is for `opt --mixed_precision_config` with the
+// same calibration table.
+
+#include <gflags/gflags.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "lite/api/cxx_api.h"
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/core/optimizer/mir/mixed_precision_pass.h"
+#include "lite/core/optimizer/mir/pass_manager.h"
+#include "lite/core/optimizer/mir/post_quant_static_pass.h"
+#include "lite/core/profile/timer.h"
+#include "lite/utils/log/cp_logging.h"
+#include "lite/utils/string.h"
+
+DEFINE_string(model_dir, "", "path of the fp32 model in the non-combined form");
+DEFINE_string(model_file, "", "path of the model file in the combined form");
+DEFINE_string(param_file, "", "path of the param file in the combined form");
+DEFINE_string(input_shape,
+              "1,3,224,224",
+              "input shapes, separated by colon and comma");
+DEFINE_string(calib_data, "", "path of the calibration data list");
+DEFINE_string(calib_method,
+              "KL",
+              "the method to compute the thresholds from the histograms of "
+              "the activations, KL, percentile, MSE or abs_max");
+DEFINE_double(percentile, 99.99, "the percentile of the percentile method");
+DEFINE_string(calib_table, "calib_table.txt", "path of the output table");
+DEFINE_string(mixed_precision_config,
+              "",
+              "path of the output mixed precision config, the precisions of "
+              "the ops are searched if it is set");
+DEFINE_double(error_budget,
+              0.01,
+              "the max relative L2 error of the outputs of the mixed "
+              "precision model");
+
+namespace paddle {
+namespace lite {
+
+const int kHistBins = 2048;
+// the levels of the abs values of int8
+const int kQuantBins = 128;
+
+struct ActivationStats {
+  float abs_max{0.f};
+  // the min value, or 0 if it is positive
+  float min{0.f};
+  std::vector<double> hist;
+};
+
+// The threshold minimizing the KL divergence between the histogram clipped
+// at the threshold and its quantization into kQuantBins levels.
+static float ThresholdKL(const std::vector<double>& hist, float bin_width) {
+  int best_bins = kHistBins;
+  double min_kl = std::numeric_limits<double>::max();
+  for (int bins = kQuantBins; bins <= kHistBins; bins++) {
+    std::vector<double> p(hist.begin(), hist.begin() + bins);
+    for (int i = bins; i < kHistBins; i++) {
+      p[bins - 1] += hist[i];
+    }
+    // merge the bins into the levels, and expand them over the nonzero bins
+    std::vector<double> q(bins, 0.0);
+    double stride = static_cast<double>(bins) / kQuantBins;
+    for (int j = 0; j < kQuantBins; j++) {
+      int start = static_cast<int>(j * stride);
+      int end = j == kQuantBins - 1 ? bins : static_cast<int>((j + 1) * stride);
+      double sum = 0.0;
+      int nonzeros = 0;
+      for (int i = start; i < end; i++) {
+        sum += hist[i];
+        nonzeros += hist[i] != 0.0;
+      }
+      for (int i = start; i < end; i++) {
+        q[i] = hist[i] != 0.0 ? sum / nonzeros : 0.0;
+      }
+    }
+    double p_sum = 0.0;
+    double q_sum = 0.0;
+    for (int i = 0; i < bins; i++) {
+      p_sum += p[i];
+      q_sum += q[i];
+    }
+    if (p_sum == 0.0 || q_sum == 0.0) continue;
+    double kl = 0.0;
+    for (int i = 0; i < bins; i++) {
+      if (p[i] == 0.0) continue;
+      double p_i = p[i] / p_sum;
+      double q_i = std::max(q[i] / q_sum, 1e-10);
+      kl += p_i * std::log(p_i / q_i);
+    }
+    if (kl < min_kl) {
+      min_kl = kl;
+      best_bins = bins;
+    }
+  }
+  return (best_bins + 0.5f) * bin_width;
+}
+
+static float ThresholdPercentile(const std::vector<double>& hist,
+                                 float bin_width,
+                                 double percentile) {
+  double total = 0.0;
+  for (auto count : hist) total += count;
+  double target = total * percentile / 100.0;
+  double sum = 0.0;
+  for (int i = 0; i < kHistBins; i++) {
+    sum += hist[i];
+    if (sum >= target) return (i + 1) * bin_width;
+  }
+  return kHistBins * bin_width;
+}
+
+// The threshold minimizing the mean squared error of the quantization
+static float ThresholdMSE(const std::vector<double>& hist, float bin_width) {
+  int best_bins = kHistBins;
+  double min_mse = std::numeric_limits<double>::max();
+  for (int bins = kQuantBins; bins <= kHistBins; bins++) {
+    double threshold = bins * bin_width;
+    double scale = threshold / (kQuantBins - 1);
+    double mse = 0.0;
+    for (int i = 0; i < kHistBins; i++) {
+      if (hist[i] == 0.0) continue;
+      double x = (i + 0.5) * bin_width;
+      double q = x >= threshold ? threshold : std::round(x / scale) * scale;
+      mse += hist[i] * (x - q) * (x - q);
+    }
+    if (mse < min_mse) {
+      min_mse = mse;
+      best_bins = bins;
+    }
+  }
+  return best_bins * bin_width;
+}
+
+// Call func with the fp32 outputs of all the ops of the last run
+static void ForEachActivation(
+    const Predictor& predictor,
+    const std::function<void(const std::string&, const Tensor&)>& func) {
+  std::set<std::string> visited;
+  for (auto& inst : predictor.runtime_program().instructions()) {
+    for (auto& name : inst.op()->op_info()->output_vars()) {
+      if (!visited.insert(name).second) continue;
+      auto* scope = const_cast<OpLite*>(inst.op())->scope();
+      auto* var = scope->FindVar(name);
+      if (!var || !var->IsType<Tensor>()) continue;
+      const auto& tensor = var->Get<Tensor>();
+      if (tensor.precision() != PRECISION(kFloat) || tensor.numel() == 0) {
+        continue;
+      }
+      func(name, tensor);
+    }
+  }
+}
+
+static void FeedBatch(Predictor* predictor,
+                      const std::vector<std::string>& files,
+                      const std::vector<std::vector<int64_t>>& shapes) {
+  CHECK_EQ(files.size(), shapes.size())
+      << "The number of the files of a batch should be the number of the "
+         "input shapes";
+  for (size_t i = 0; i < files.size(); i++) {
+    auto* input = predictor->GetInput(i);
+    input->Resize(shapes[i]);
+    auto* data = input->mutable_data<float>();
+    std::ifstream fin(files[i], std::ios::binary);
+    CHECK(fin.is_open()) << "Can not open " << files[i];
+    fin.read(reinterpret_cast<char*>(data), input->numel() * sizeof(float));
+    CHECK_EQ(fin.gcount(),
+             static_cast<std::streamsize>(input->numel() * sizeof(float)))
+        << "The size of " << files[i] << " does not match its shape";
+  }
+}
+
+// Build the fp32 model, or the mixed precision model of the precisions of
+// the weights with the calibration table if precisions is not empty.
+static std::unique_ptr<Predictor> BuildPredictor(
+    const std::map<std::string, std::string>& precisions,
+    bool keep_activations) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_model_file(FLAGS_model_file);
+  config.set_param_file(FLAGS_param_file);
+  if (keep_activations) {
+    config.add_discarded_pass("memory_optimize_pass");
+  }
+  std::vector<Place> valid_places;
+#ifdef LITE_WITH_ARM
+#ifdef ENABLE_ARM_FP16
+  if (!precisions.empty()) {
+    valid_places.push_back(Place{TARGET(kARM), PRECISION(kFP16)});
+  }
+#endif
+  valid_places.push_back(Place{TARGET(kARM), PRECISION(kFloat)});
+#else
+  valid_places.push_back(Place{TARGET(kX86), PRECISION(kFloat)});
+#endif
+  std::vector<std::string> passes;
+  if (!precisions.empty()) {
+    const std::string config_path = FLAGS_mixed_precision_config + ".trial";
+    std::ofstream fout(config_path);
+    CHECK(fout.is_open()) << "Can not open " << config_path;
+    for (auto& item : precisions) {
+      fout << item.first << " " << item.second << "\n";
+    }
+    fout.close();
+    config.set_calib_table(FLAGS_calib_table);
+    config.set_mixed_precision_config(config_path);
+    passes = {"post_quant_static_pass", "mixed_precision_pass"};
+    auto* pqs_pass =
+        mir::PassManager::Global().LookUp<mir::PostQuantStaticPass>(
+            "post_quant_static_pass");
+    CHECK(pqs_pass);
+    pqs_pass->SetCalibTable(FLAGS_calib_table);
+    auto* mp_pass = mir::PassManager::Global().LookUp<mir::MixedPrecisionPass>(
+        "mixed_precision_pass");
+    CHECK(mp_pass);
+    mp_pass->SetConfig(config_path);
+  }
+  std::unique_ptr<Predictor> predictor(new Predictor);
+  predictor->Build(config, valid_places, passes);
+  return predictor;
+}
+
+// Run all the batches, return the average latency in ms and the outputs of
+// each batch
+static float RunBatches(Predictor* predictor,
+                        const std::vector<std::vector<std::string>>& batches,
+                        const std::vector<std::vector<int64_t>>& shapes,
+                        std::vector<std::vector<float>>* outputs) {
+  // warm up
+  FeedBatch(predictor, batches[0], shapes);
+  predictor->Run();
+  outputs->clear();
+  profile::Timer timer;
+  for (auto& batch : batches) {
+    FeedBatch(predictor, batch, shapes);
+    timer.Start();
+    predictor->Run();
+    timer.Stop();
+    std::vector<float> batch_outputs;
+    for (auto* output : predictor->GetOutputs()) {
+      if (output->precision() != PRECISION(kFloat)) continue;
+      const float* data = output->data<float>();
+      batch_outputs.insert(batch_outputs.end(), data, data + output->numel());
+    }
+    outputs->push_back(batch_outputs);
+  }
+  return timer.LapTimes().Avg();
+}
+
+static double RelativeError(const std::vector<std::vector<float>>& outputs,
+                            const std::vector<std::vector<float>>& refs) {
+  double diff = 0.0;
+  double norm = 0.0;
+  for (size_t i = 0; i < refs.size(); i++) {
+    CHECK_EQ(outputs[i].size(), refs[i].size());
+    for (size_t j = 0; j < refs[i].size(); j++) {
+      double d = outputs[i][j] - refs[i][j];
+      diff += d * d;
+      norm += static_cast<double>(refs[i][j]) * refs[i][j];
+    }
+  }
+  return std::sqrt(diff / std::max(norm, 1e-12));
+}
+
+void SearchMixedPrecision(const std::vector<std::vector<std::string>>& batches,
+                          const std::vector<std::vector<int64_t>>& shapes) {
+  // the ops with weights and the args of their weights
+  const std::map<std::string, std::string> search_ops = {
+      {"conv2d", "Filter"},
+      {"depthwise_conv2d", "Filter"},
+      {"fc", "W"},
+      {"mul", "Y"},
+      {"matmul", "Y"},
+      {"matmul_v2", "Y"}};
+  std::vector<std::string> lowered_precisions{"int8"};
+#ifdef ENABLE_ARM_FP16
+  lowered_precisions.push_back("fp16");
+#endif
+
+  std::vector<std::vector<float>> refs;
+  std::vector<std::vector<float>> outputs;
+  auto ref_predictor = BuildPredictor({}, false);
+  RunBatches(ref_predictor.get(), batches, shapes, &refs);
+  std::vector<std::string> weights;
+  for (auto& inst : ref_predictor->runtime_program().instructions()) {
+    const auto* op_info = inst.op()->op_info();
+    auto iter = search_ops.find(op_info->Type());
+    if (iter == search_ops.end() || !op_info->HasInput(iter->second)) continue;
+    for (auto& name : op_info->Input(iter->second)) {
+      if (ref_predictor->scope()->FindLocalVar(name) &&
+          std::find(weights.begin(), weights.end(), name) == weights.end()) {
+        weights.push_back(name);
+      }
+    }
+  }
+  CHECK(!weights.empty()) << "No op with weights to search";
+
+  // the base model keeps all the searched ops in fp32
+  std::map<std::string, std::string> precisions;
+  for (auto& weight : weights) {
+    precisions[weight] = "fp32";
+  }
+  auto base_predictor = BuildPredictor(precisions, false);
+  float base_latency =
+      RunBatches(base_predictor.get(), batches, shapes, &outputs);
+  double base_error = RelativeError(outputs, refs);
+  base_predictor.reset();
+
+  struct Choice {
+    std::string weight;
+    std::string precision;
+    double error;
+    float gain;
+  };
+  std::vector<Choice> choices;
+  for (auto& weight : weights) {
+    for (auto& precision : lowered_precisions) {
+      precisions[weight] = precision;
+      auto predictor = BuildPredictor(precisions, false);
+      float latency = RunBatches(predictor.get(), batches, shapes, &outputs);
+      double error = RelativeError(outputs, refs) - base_error;
+      VLOG(1) << weight << " " << precision << ": error " << error
+              << ", latency " << latency << " ms";
+      if (latency < base_latency) {
+        choices.push_back(Choice{
+            weight, precision, std::max(error, 0.0), base_latency - latency});
+      }
+    }
+    precisions[weight] = "fp32";
+  }
+
+  std::stable_sort(
+      choices.begin(), choices.end(), [](const Choice& a, const Choice& b) {
+        return a.error * b.gain < b.error * a.gain;
+      });
+  double total_error = base_error;
+  float total_gain = 0.f;
+  for (auto& choice : choices) {
+    if (precisions[choice.weight] != "fp32" ||
+        total_error + choice.error > FLAGS_error_budget) {
+      continue;
+    }
+    precisions[choice.weight] = choice.precision;
+    total_error += choice.error;
+    total_gain += choice.gain;
+  }
+
+  auto predictor = BuildPredictor(precisions, false);
+  float latency = RunBatches(predictor.get(), batches, shapes, &outputs);
+  double error = RelativeError(outputs, refs);
+  std::remove((FLAGS_mixed_precision_config + ".trial").c_str());
+  std::ofstream fout(FLAGS_mixed_precision_config);
+  CHECK(fout.is_open()) << "Can not open " << FLAGS_mixed_precision_config;
+  for (auto& item : precisions) {
+    fout << item.first << " " << item.second << "\n";
+  }
+  LOG(INFO) << "Save the precisions of " << precisions.size() << " ops to "
+            << FLAGS_mixed_precision_config << ", the error is " << error
+            << " (estimated " << total_error << "), the latency is "
+            << latency << " ms (estimated " << base_latency - total_gain
+            << " ms)";
+}
+
+void Calibrate(const std::vector<std::vector<std::string>>& batches,
+               const std::vector<std::vector<int64_t>>& shapes) {
+  CHECK(FLAGS_calib_method == "KL" || FLAGS_calib_method == "percentile" ||
+        FLAGS_calib_method == "MSE" || FLAGS_calib_method == "abs_max")
+      << "Unsupported calib_method " << FLAGS_calib_method;
+  // keep the activations of all the ops after the runs
+  auto predictor_ptr = BuildPredictor({}, true);
+  Predictor& predictor = *predictor_ptr;
+
+  std::map<std::string, ActivationStats> stats;
+  for (auto& batch : batches) {
+    FeedBatch(&predictor, batch, shapes);
+    predictor.Run();
+    ForEachActivation(
+        predictor, [&](const std::string& name, const Tensor& tensor) {
+          const float* data = tensor.data<float>();
+          float& abs_max = stats[name].abs_max;
+          float& min = stats[name].min;
+          for (int64_t i = 0; i < tensor.numel(); i++) {
+            abs_max = std::max(abs_max, std::fabs(data[i]));
+            min = std::min(min, data[i]);
+          }
+        });
+  }
+  if (FLAGS_calib_method != "abs_max") {
+    // the histograms of the abs values in [0, abs_max]
+    for (auto& batch : batches) {
+      FeedBatch(&predictor, batch, shapes);
+      predictor.Run();
+      ForEachActivation(
+          predictor, [&](const std::string& name, const Tensor& tensor) {
+            auto& stat = stats[name];
+            if (stat.abs_max == 0.f) return;
+            stat.hist.resize(kHistBins, 0.0);
+            const float* data = tensor.data<float>();
+            float inv_width = kHistBins / stat.abs_max;
+            for (int64_t i = 0; i < tensor.numel(); i++) {
+              int bin = static_cast<int>(std::fabs(data[i]) * inv_width);
+              stat.hist[std::min(bin, kHistBins - 1)] += 1.0;
+            }
+          });
+    }
+  }
+
+  std::ofstream fout(FLAGS_calib_table);
+  CHECK(fout.is_open()) << "Can not open " << FLAGS_calib_table;
+  for (auto& item : stats) {
+    const auto& stat = item.second;
+    float threshold = stat.abs_max;
+    if (!stat.hist.empty()) {
+      float bin_width = stat.abs_max / kHistBins;
+      if (FLAGS_calib_method == "KL") {
+        threshold = ThresholdKL(stat.hist, bin_width);
+      } else if (FLAGS_calib_method == "percentile") {
+        threshold = ThresholdPercentile(stat.hist, bin_width, FLAGS_percentile);
+      } else if (FLAGS_calib_method == "MSE") {
+        threshold = ThresholdMSE(stat.hist, bin_width);
+      }
+    }
+    fout << item.first << " " << std::min(threshold, stat.abs_max) << " "
+         << stat.min << "\n";
+  }
+  LOG(INFO) << "Save the thresholds of " << stats.size() << " activations of "
+            << batches.size() << " batches to " << FLAGS_calib_table;
+}
+
+}  // namespace lite
+}  // namespace paddle
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  CHECK(!FLAGS_calib_data.empty()) << "--calib_data is required";
+  std::vector<std::vector<int64_t>> shapes;
+  for (auto& shape : paddle::lite::Split(FLAGS_input_shape, ":")) {
+    shapes.push_back(paddle::lite::Split<int64_t>(shape, ","));
+  }
+  std::vector<std::vector<std::string>> batches;
+  std::ifstream fin(FLAGS_calib_data);
+  CHECK(fin.is_open()) << "Can not open " << FLAGS_calib_data;
+  std::string line;
+  while (std::getline(fin, line)) {
+    std::istringstream line_stream(line);
+    std::vector<std::string> files;
+    std::string file;
+    while (line_stream >> file) files.push_back(file);
+    if (!files.empty()) batches.push_back(files);
+  }
+  CHECK(!batches.empty()) << "No batch in " << FLAGS_calib_data;
+
+  paddle::lite::Calibrate(batches, shapes);
+  if (!FLAGS_mixed_precision_config.empty()) {
+    paddle::lite::SearchMixedPrecision(batches, shapes);
+  }
+  return 0;
+}
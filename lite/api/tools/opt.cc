@@ -46,8 +46,27 @@ DEFINE_bool(quant_model,
 DEFINE_string(quant_type,
               "QUANT_INT16",
               "Set the quant_type for post_quant_dynamic, "
-              "and it should be QUANT_INT8 or QUANT_INT16 for now.");
+              "and it should be QUANT_INT8, QUANT_INT16 or QUANT_INT4 for "
+              "now.");
+DEFINE_int32(embedding_quant_bits,
+             0,
+             "Store the weights of lookup_table and lookup_table_v2 row-wise "
+             "in 8 or 4 bits with the scale and bias of each row, "
+             "0 to disable.");
+DEFINE_string(calib_table,
+              "",
+              "Quantize the model to int8 statically with the thresholds of "
+              "the activations in the calibration table, which is generated "
+              "by calib_bin with a calibration dataset.");
+DEFINE_string(mixed_precision_config,
+              "",
+              "Set the precisions (fp32, fp16 or int8) of the ops with the "
+              "weights in the config, which is searched by calib_bin.");
 DEFINE_bool(enable_fp16, false, "Set kernel_type run in FP16.");
+DEFINE_bool(enable_bf16,
+            false,
+            "Run fc, matmul and conv with the bf16 weights on the arm cpus "
+            "supporting the bf16 matrix multiplication.");
 DEFINE_bool(record_tailoring_info,
             false,
             "Record kernels and operators information of the optimized model "
@@ -57,7 +76,7 @@ DEFINE_string(optimize_out, "", "path of the output optimized model");
 DEFINE_string(valid_targets,
               "arm",
               "The targets this model optimized for, should be one of (arm, "
-              "opencl, x86, x86_opencl), splitted by space");
+              "opencl, vulkan, x86, x86_opencl), splitted by space");
 DEFINE_bool(print_supported_ops,
             false,
             "Print supported operators on the inputed target");
@@ -74,6 +93,16 @@ DEFINE_bool(sparse_model,
 DEFINE_double(sparse_threshold,
               0.6,
               "Set 0.6 as the lower bound for the sparse conv pass.");
+DEFINE_bool(preselect_conv_algorithm,
+            false,
+            "Select the implementations of the arm convs ahead of time.");
+DEFINE_bool(compress_weights,
+            false,
+            "Compress the weights in the saved naive buffer model.");
+DEFINE_bool(target_has_dot,
+            false,
+            "Whether the target arm cpu supports the dot product instructions, "
+            "used by preselect_conv_algorithm.");
 DEFINE_string(optimized_nb_model_path,
               "",
               "path of the optimized nb model, this argument is use for the "
@@ -82,6 +111,29 @@ DEFINE_string(visualization_file_output_path,
               "",
               "output path of the visualization file, this argument is use for "
               "the VisualizeOptimizedModel API");
+DEFINE_bool(estimate_latency,
+            false,
+            "Estimate the latency and the peak memory of the optimized model "
+            "on a device instead of saving it.");
+DEFINE_string(estimate_input_shape,
+              "",
+              "The input shapes of the latency estimation, separated by colon "
+              "such as 1,3,224,224:1,10.");
+DEFINE_string(latency_table,
+              "",
+              "The latency table measured on the device, either saved by "
+              "StopOpLatencyRecording or the op benchmark of "
+              "lite/tests/benchmark.");
+DEFINE_double(device_gflops,
+              10.0,
+              "The GFLOPS of the device for the ops not in the latency table.");
+DEFINE_double(device_bandwidth,
+              10.0,
+              "The memory bandwidth in GB/s of the device for the ops not in "
+              "the latency table.");
+DEFINE_int32(estimate_threads,
+             1,
+             "The threads of the kernels to look up in the latency table.");
 
 int main(int argc, char** argv) {
   auto opt = paddle::lite_api::OptBase();
@@ -112,6 +164,7 @@ int main(int argc, char** argv) {
   }
   if (FLAGS_valid_targets != "") {
     if (FLAGS_enable_fp16) opt.EnableFloat16();
+    if (FLAGS_enable_bf16) opt.EnableBFloat16();
     opt.SetValidPlaces(FLAGS_valid_targets);
   }
 
@@ -125,10 +178,25 @@ int main(int argc, char** argv) {
     opt.SetQuantModel(true);
     opt.SetQuantType(FLAGS_quant_type);
   }
+  if (FLAGS_embedding_quant_bits != 0) {
+    opt.SetEmbeddingQuantBits(FLAGS_embedding_quant_bits);
+  }
+  if (FLAGS_calib_table != "") {
+    opt.SetCalibTable(FLAGS_calib_table);
+  }
+  if (FLAGS_mixed_precision_config != "") {
+    opt.SetMixedPrecisionConfig(FLAGS_mixed_precision_config);
+  }
   if (FLAGS_sparse_model) {
     opt.SetSparseModel(true);
     opt.SetSparseThreshold(FLAGS_sparse_threshold);
   }
+  if (FLAGS_preselect_conv_algorithm) {
+    opt.SetConvAlgorithmPreselect(true, FLAGS_target_has_dot);
+  }
+  if (FLAGS_compress_weights) {
+    opt.SetCompressWeights(true);
+  }
   if (FLAGS_print_all_ops) {
     opt.PrintAllOps();
     return 0;
@@ -155,6 +223,18 @@ int main(int argc, char** argv) {
                                   FLAGS_visualization_file_output_path);
     return 0;
   }
+  if (FLAGS_estimate_latency) {
+    std::vector<std::vector<int64_t>> input_shapes;
+    for (auto& shape : paddle::lite::Split(FLAGS_estimate_input_shape, ":")) {
+      input_shapes.push_back(paddle::lite::Split<int64_t>(shape, ","));
+    }
+    paddle::lite::DeviceProfile profile;
+    profile.gflops = FLAGS_device_gflops;
+    profile.bandwidth_gbps = FLAGS_device_bandwidth;
+    profile.threads = FLAGS_estimate_threads;
+    opt.EstimateLatency(input_shapes, FLAGS_latency_table, profile);
+    return 0;
+  }
   if ((FLAGS_model_dir == "" &&
        (FLAGS_model_file == "" || FLAGS_param_file == "") &&
        FLAGS_model_set_dir == "") ||
@@ -15,6 +15,7 @@
 #include "lite/api/tools/opt_base.h"
 #include <fstream>
 #include <memory>
+#include <sstream>
 #include <utility>
 #include "lite/core/optimizer/mir/dot.h"
 #include "lite/core/scope.h"
@@ -53,11 +54,28 @@ void OptBase::SetQuantType(const std::string& quant_type) {
     opt_config_.set_quant_type(lite_api::QuantType::QUANT_INT8);
   } else if (quant_type == "QUANT_INT16") {
     opt_config_.set_quant_type(lite_api::QuantType::QUANT_INT16);
+  } else if (quant_type == "QUANT_INT4") {
+    opt_config_.set_quant_type(lite_api::QuantType::QUANT_INT4);
   } else {
     OPT_LOG_FATAL << "Unsupported quant type: " << quant_type;
   }
 }
 
+void OptBase::SetEmbeddingQuantBits(int bits) {
+  if (bits != 0 && bits != 4 && bits != 8) {
+    OPT_LOG_FATAL << "Unsupported embedding quant bits: " << bits;
+  }
+  opt_config_.set_embedding_quant_bits(bits);
+}
+
+void OptBase::SetCalibTable(const std::string& calib_table) {
+  opt_config_.set_calib_table(calib_table);
+}
+
+void OptBase::SetMixedPrecisionConfig(const std::string& config_path) {
+  opt_config_.set_mixed_precision_config(config_path);
+}
+
 void OptBase::SetSparseModel(bool sparse_model) {
   opt_config_.set_sparse_model(sparse_model);
 }
@@ -82,6 +100,14 @@ void OptBase::SetSparseThreshold(float sparse_threshold) {
   }
 }
 
+void OptBase::SetConvAlgorithmPreselect(bool enable, bool target_has_dot) {
+  opt_config_.set_conv_algorithm_preselect(enable, target_has_dot);
+}
+
+void OptBase::SetCompressWeights(bool compress_weights) {
+  opt_config_.set_compress_weights(compress_weights);
+}
+
 void OptBase::SetPassesInternal(
     const std::vector<std::string>& passes_internal) {
   opt_config_.set_passes_internal(passes_internal);
@@ -97,6 +123,10 @@ void OptBase::SetValidPlaces(const std::string& valid_places) {
         valid_places_.emplace_back(
             Place{TARGET(kARM), PRECISION(kFP16), DATALAYOUT(kNCHW)});
       }
+      if (enable_bf16_) {
+        valid_places_.emplace_back(
+            Place{TARGET(kARM), PRECISION(kBF16), DATALAYOUT(kNCHW)});
+      }
       valid_places_.emplace_back(
           Place{TARGET(kARM), PRECISION(kFloat), DATALAYOUT(kNCHW)});
       valid_places_.emplace_back(
@@ -127,6 +157,13 @@ void OptBase::SetValidPlaces(const std::string& valid_places) {
           TARGET(kMetal), PRECISION(kFloat), DATALAYOUT(kMetalTexture2DArray)});
       valid_places_.emplace_back(Place{
           TARGET(kMetal), PRECISION(kFP16), DATALAYOUT(kMetalTexture2DArray)});
+    } else if (target_repr == "vulkan") {
+      valid_places_.emplace_back(
+          Place{TARGET(kVulkan), PRECISION(kFloat), DATALAYOUT(kNCHW)});
+      valid_places_.emplace_back(
+          Place{TARGET(kVulkan), PRECISION(kAny), DATALAYOUT(kNCHW)});
+      // enable kARM CPU kernel when no vulkan kernel
+      valid_places_.emplace_back(TARGET(kARM));
     } else if (target_repr == "arm_metal") {
       valid_places_.emplace_back(Place{
           TARGET(kMetal), PRECISION(kFloat), DATALAYOUT(kMetalTexture2DArray)});
@@ -288,6 +325,55 @@ void CollectModelMetaInfo(const std::string& output_dir,
                    output_path);
 }
 
+void OptBase::EstimateLatency(
+    const std::vector<std::vector<int64_t>>& input_shapes,
+    const std::string& latency_table,
+    const lite::DeviceProfile& profile) {
+  CheckIfModelSupported(false);
+  opt_config_.set_valid_places(valid_places_);
+  auto opt_predictor = std::static_pointer_cast<lite::CxxPaddleApiImpl>(
+      lite_api::CreatePaddlePredictor(opt_config_));
+  auto input_num = opt_predictor->GetInputNames().size();
+  if (input_shapes.size() != input_num) {
+    OPT_LOG_FATAL << "The model has " << input_num << " inputs, but "
+                  << input_shapes.size() << " shapes are given";
+  }
+  for (size_t i = 0; i < input_num; i++) {
+    opt_predictor->GetInput(i)->Resize(input_shapes[i]);
+  }
+  lite::LatencyEstimator estimator(profile);
+  if (!latency_table.empty() && !estimator.LoadTable(latency_table)) {
+    OPT_LOG_FATAL << "Failed to load the latency table " << latency_table;
+  }
+  auto estimate = opt_predictor->EstimateCost(estimator);
+
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3) << std::left;
+  ss << std::setw(6) << "index" << std::setw(24) << "op_type"
+     << std::setw(48) << "kernel" << std::setw(12) << "latency(ms)"
+     << std::setw(12) << "MFLOPs" << std::setw(12) << "memory(KB)"
+     << "source\n";
+  int measured = 0;
+  for (size_t i = 0; i < estimate.ops.size(); i++) {
+    auto& op = estimate.ops[i];
+    measured += op.measured;
+    ss << std::setw(6) << i << std::setw(24) << op.op_type << std::setw(48)
+       << op.kernel << std::setw(12) << op.ms << std::setw(12)
+       << op.flops / 1e6 << std::setw(12) << op.bytes / 1024.0
+       << (op.measured ? "table" : "model") << "\n";
+  }
+  ss << "estimated latency(ms): " << estimate.total_ms << "\n";
+  ss << "ops looked up in the table: " << measured << "/"
+     << estimate.ops.size() << "\n";
+  ss << "weights(KB): " << estimate.weight_bytes / 1024.0 << "\n";
+  ss << "peak activations(KB): " << estimate.peak_activation_bytes / 1024.0
+     << "\n";
+  ss << "device profile: " << profile.gflops << " GFLOPS, "
+     << profile.bandwidth_gbps << " GB/s, " << profile.threads
+     << " threads\n";
+  OPT_LOG << ss.str();
+}
+
 void OptBase::SetModelSetDir(const std::string& model_set_path) {
   model_set_dir_ = model_set_path;
 }
@@ -359,7 +445,7 @@ void OptBase::PrintHelpInfo() {
       "default\n"
       "        `set_lite_out(output_optimize_model_dir)`\n"
       "        "
-      "`set_valid_places(arm|opencl|x86|metal|xpu|bm|mlu|intel_fpga|"
+      "`set_valid_places(arm|opencl|vulkan|x86|metal|xpu|bm|mlu|intel_fpga|"
       "huawei_ascend_npu|imagination_nna|rockchip_npu|"
       "mediatek_apu|huawei_kirin_npu|amlogic_npu|verisilicon_timvx|"
       "android_nnapi)`"
@@ -404,18 +490,28 @@ void OptBase::PrintExecutableBinHelpInfo() {
       "        `--optimize_out_type=(protobuf|naive_buffer)`\n"
       "        `--optimize_out=<output_optimize_model_dir>`\n"
       "        "
-      "`--valid_targets=(arm|opencl|x86|metal|xpu|bm|mlu|intel_fpga|"
+      "`--valid_targets=(arm|opencl|vulkan|x86|metal|xpu|bm|mlu|intel_fpga|"
       "huawei_ascend_npu|imagination_nna|rockchip_npu|mediatek_apu|"
       "huawei_kirin_npu|amlogic_npu|verisilicon_timvx|android_nnapi)`\n"
       "        `--record_tailoring_info=(true|false)`\n"
       "  Arguments of mode quantization in opt:\n"
       "        `--quant_model=(true|false)`\n"
-      "        `--quant_type=(QUANT_INT8|QUANT_INT16)`\n"
+      "        `--quant_type=(QUANT_INT8|QUANT_INT16|QUANT_INT4)`\n"
+      "        `--embedding_quant_bits=(0|4|8)`\n"
+      "        `--calib_table=<calibration_table_path>`\n"
+      "        `--mixed_precision_config=<mixed_precision_config_path>`\n"
       "  Arguements of sparse convolution in opt: \n"
       "        `--sparse_model=(true|false)`\n"
       "        `--sparse_threshold=(float)`\n"
+      "  Arguments of conv algorithm preselection in opt: \n"
+      "        `--preselect_conv_algorithm=(true|false)`\n"
+      "        `--target_has_dot=(true|false)`\n"
+      "  Arguments of weight compression in opt: \n"
+      "        `--compress_weights=(true|false)`\n"
       "  Arguments of enable_fp16 in opt: \n"
       "        `--enable_fp16=(true|false)`\n"
+      "  Arguments of enable_bf16 in opt: \n"
+      "        `--enable_bf16=(true|false)`\n"
       "  Arguments of model checking and ops information:\n"
       "        `--print_all_ops=true`   Display all the valid operators of "
       "Paddle-Lite\n"
@@ -423,15 +519,20 @@ void OptBase::PrintExecutableBinHelpInfo() {
       "operators of "
       "Paddle-Lite in markdown format\n"
       "        `--print_supported_ops=true  "
-      "--valid_targets=(arm|opencl|x86|metal|xpu|bm|mlu|intel_fpga|"
+      "--valid_targets=(arm|opencl|vulkan|x86|metal|xpu|bm|mlu|intel_fpga|"
       "huawei_ascend_npu|imagination_nna|rockchip_npu|mediatek_apu|"
       "huawei_kirin_npu|amlogic_npu|verisilicon_timvx|android_nnapi)`"
       "  Display valid operators of input targets\n"
       "        `--print_model_ops=true  --model_dir=<model_param_dir> "
-      "--valid_targets=(arm|opencl|x86|metal|xpu|bm|mlu|intel_fpga|"
+      "--valid_targets=(arm|opencl|vulkan|x86|metal|xpu|bm|mlu|intel_fpga|"
       "huawei_ascend_npu|imagination_nna|rockchip_npu|mediatek_apu|"
       "huawei_kirin_npu|amlogic_npu|verisilicon_timvx|android_nnapi)`"
       "  Display operators in the input model\n"
+      "  Arguments of latency estimation: \n"
+      "        `--estimate_latency=true  --estimate_input_shape=<shapes>`\n"
+      "        `--latency_table=<latency_table_path>`\n"
+      "        `--device_gflops=(float)  --device_bandwidth=(float)`\n"
+      "        `--estimate_threads=(int)`\n"
       "  Arguments of optimized nb model visualization: \n"
       "        `--optimized_nb_model_path=<optimized_nb_model_dir>`\n"
       "        "
@@ -641,8 +742,9 @@ void OptBase::CheckIfModelSupported(bool print_ops_info) {
                                                   is_combined_params_form);
 
   lite::cpp::ProgramDesc cpp_prog;
-  framework::proto::ProgramDesc pb_proto_prog = *lite::LoadProgram(prog_path);
-  lite::pb::ProgramDesc pb_prog(&pb_proto_prog);
+  google::protobuf::Arena arena;
+  lite::pb::ProgramDesc pb_prog(
+      lite::LoadProgram(prog_path, lite_api::CxxModelBuffer(), &arena));
   // Transform to cpp::ProgramDesc
   lite::TransformProgramDescAnyToCpp(pb_prog, &cpp_prog);
 
@@ -789,12 +891,14 @@ void OptBase::InitSupportedOpInfo() {
                                               "kRKNPU",
                                               "kIntelFPGA",
                                               "kMetal",
-                                              "kNNAdapter"};
+                                              "kNNAdapter",
+                                              "kVulkan"};
 
   // ignore some old targets
   std::set<std::string> valid_target{"kARM",
                                      "kOpenCL",
                                      "kMetal",
+                                     "kVulkan",
                                      "kXPU",
                                      "kHost",
                                      "kIntelFPGA",
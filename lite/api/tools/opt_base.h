@@ -48,13 +48,19 @@ class LITE_API OptBase {
   void SetModelFile(const std::string &model_path);
   void SetParamFile(const std::string &param_path);
   void EnableFloat16() { enable_fp16_ = true; }
+  void EnableBFloat16() { enable_bf16_ = true; }
   void SetValidPlaces(const std::string &valid_places);
   void SetOptimizeOut(const std::string &lite_out_name);
   void RecordModelInfo(bool record_strip_info = true);
   void SetQuantModel(bool quant_model);
   void SetQuantType(const std::string &quant_type);
+  void SetEmbeddingQuantBits(int bits);
+  void SetCalibTable(const std::string &calib_table);
+  void SetMixedPrecisionConfig(const std::string &config_path);
   void SetSparseModel(bool sparse_model);
   void SetSparseThreshold(const float sparse_threshold = 0.6f);
+  void SetConvAlgorithmPreselect(bool enable, bool target_has_dot = false);
+  void SetCompressWeights(bool compress_weights);
   // set optimized_model type
   void SetModelType(std::string model_type = "naive_buffer");
   // internal inference for developer, not recommanded.
@@ -103,9 +109,16 @@ class LITE_API OptBase {
                                           // modify doc
   std::vector<std::string> VisualizeOptimizedNBModel(
       const std::string &model_dir, const std::string &output_path);
+  // 4. Estimate the latency and the peak memory of the optimized model of the
+  // input shapes on a device without running it, by the latency table
+  // measured on the device if given, or the analytic model of `profile`.
+  void EstimateLatency(const std::vector<std::vector<int64_t>> &input_shapes,
+                       const std::string &latency_table,
+                       const lite::DeviceProfile &profile);
 
  private:
   bool enable_fp16_{false};
+  bool enable_bf16_{false};
   CxxConfig opt_config_;
   // valid places for the optimized_model
   std::vector<Place> valid_places_;
@@ -14,8 +14,10 @@
 
 #include "lite/backends/arm/math/activation.h"
 #include <algorithm>
+#include <cstring>
 #include <string>
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/core/fast_math.h"
 #include "lite/core/parallel_defines.h"
 
 namespace paddle {
@@ -23,6 +25,29 @@ namespace lite {
 namespace arm {
 namespace math {
 
+// Apply `vact` to every 4 floats in the fast-math mode, the tail is padded
+// so that every element goes through the same approximation.
+template <typename VAct>
+static void act_fast(
+    const float* din, float* dout, int size, int threads, VAct vact) {
+  int cnt = size >> 2;
+  int remain = size & 3;
+  int cnt_per_thread = (cnt + threads - 1) / threads;
+  LITE_PARALLEL_BEGIN(i, tid, threads) {
+    int end = std::min(cnt, (i + 1) * cnt_per_thread);
+    for (int k = i * cnt_per_thread; k < end; ++k) {
+      vst1q_f32(dout + 4 * k, vact(vld1q_f32(din + 4 * k)));
+    }
+  }
+  LITE_PARALLEL_END();
+  if (remain > 0) {
+    float buf[4] = {0.f, 0.f, 0.f, 0.f};
+    memcpy(buf, din + size - remain, remain * sizeof(float));
+    vst1q_f32(buf, vact(vld1q_f32(buf)));
+    memcpy(dout + size - remain, buf, remain * sizeof(float));
+  }
+}
+
 template <>
 void act_relu<float>(const float* din, float* dout, int size, int threads) {
   int nums_per_thread = size / threads;
@@ -474,6 +499,12 @@ void act_prelu<float>(const float* din,
 
 template <>
 void act_sigmoid<float>(const float* din, float* dout, int size, int threads) {
+  if (FastMath::Enabled()) {
+    act_fast(din, dout, size, threads, [](float32x4_t x) {
+      return sigmoid_ps_fast(x);
+    });
+    return;
+  }
   int nums_per_thread = size / threads;
   int remain = size - threads * nums_per_thread;
   int neon_loop_cnt_dim4 = nums_per_thread >> 2;
@@ -514,6 +545,12 @@ void act_sigmoid<float>(const float* din, float* dout, int size, int threads) {
 // tanh : (exp(x) - exp(-x)) / (exp(x) + exp(-x))
 template <>
 void act_tanh<float>(const float* din, float* dout, int size, int threads) {
+  if (FastMath::Enabled()) {
+    act_fast(din, dout, size, threads, [](float32x4_t x) {
+      return tanh_ps_fast(x);
+    });
+    return;
+  }
   int nums_per_thread = size / threads;
   int remain = size - threads * nums_per_thread;
   int neon_loop_cnt_dim4 = nums_per_thread >> 2;
@@ -561,6 +598,13 @@ void act_tanh<float>(const float* din, float* dout, int size, int threads) {
 template <>
 void act_swish<float>(
     const float* din, float* dout, int size, float coef, int threads) {
+  if (FastMath::Enabled()) {
+    float32x4_t vcoef = vdupq_n_f32(coef);
+    act_fast(din, dout, size, threads, [vcoef](float32x4_t x) {
+      return vmulq_f32(x, sigmoid_ps_fast(vmulq_f32(x, vcoef)));
+    });
+    return;
+  }
   int nums_per_thread = size / threads;
   int remain = size - threads * nums_per_thread;
   int neon_loop_cnt_dim4 = nums_per_thread >> 2;
@@ -859,8 +903,14 @@ void act_abs<float>(const float* din, float* dout, int size, int threads) {
   }
 }
 
-template <typename T>
-void erf(const T* din, T* dout, int size, int threads) {
+template <>
+void erf<float>(const float* din, float* dout, int size, int threads) {
+  if (FastMath::Enabled()) {
+    act_fast(din, dout, size, threads, [](float32x4_t x) {
+      return erf_ps_fast(x);
+    });
+    return;
+  }
   for (int i = 0; i < size; ++i) {
     dout[0] = std::erf(din[0]);
     din++;
@@ -868,8 +918,6 @@ void erf(const T* din, T* dout, int size, int threads) {
   }
 }
 
-template void erf<float>(const float* din, float* dout, int size, int threads);
-
 template <typename T>
 void sign(const T* din, T* dout, int size, int threads) {
   for (int i = 0; i < size; ++i) {
@@ -993,6 +1041,25 @@ void act_elu<float>(
 template <>
 void act_gelu<float>(
     const float* din, float* dout, int size, bool approximate, int threads) {
+  if (FastMath::Enabled()) {
+    float32x4_t vhalf = vdupq_n_f32(0.5f);
+    if (approximate) {
+      float32x4_t vcoef = vdupq_n_f32(std::sqrt(2.f / 3.14159265358979f));
+      act_fast(din, dout, size, threads, [=](float32x4_t x) {
+        float32x4_t x3 = vmulq_f32(vmulq_f32(x, x), x);
+        float32x4_t t = vmulq_f32(vmlaq_n_f32(x, x3, 0.044715f), vcoef);
+        float32x4_t hx = vmulq_f32(x, vhalf);
+        return vmlaq_f32(hx, hx, tanh_ps_fast(t));
+      });
+    } else {
+      float32x4_t vsqrt1_2 = vdupq_n_f32(0.70710678f);
+      act_fast(din, dout, size, threads, [=](float32x4_t x) {
+        float32x4_t hx = vmulq_f32(x, vhalf);
+        return vmlaq_f32(hx, hx, erf_ps_fast(vmulq_f32(x, vsqrt1_2)));
+      });
+    }
+    return;
+  }
   if (approximate) {
     const float pi = std::atan(1) * 4;
     const float sqrt_2_div_pi = std::sqrt(2 / pi);
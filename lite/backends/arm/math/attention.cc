@@ -0,0 +1,436 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/attention.h"
+#include <arm_neon.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "lite/backends/arm/math/funcs.h"
+#include "lite/core/fast_math.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// The rows of a block of queries and the columns of a tile of keys.
+const int kAttentionRows = 4;
+const int kAttentionCols = 64;
+
+static inline float reduce_add(float32x4_t v) {
+#ifdef __aarch64__
+  return vaddvq_f32(v);
+#else
+  float32x2_t s = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+  return vget_lane_f32(vpadd_f32(s, s), 0);
+#endif
+}
+
+static inline float reduce_max(float32x4_t v) {
+#ifdef __aarch64__
+  return vmaxvq_f32(v);
+#else
+  float32x2_t s = vmax_f32(vget_low_f32(v), vget_high_f32(v));
+  return vget_lane_f32(vpmax_f32(s, s), 0);
+#endif
+}
+
+// s[r][j] = q[r] * k[j] for the kAttentionRows rows of q, the last row is
+// repeated for the missing ones. The rows of k are ldk apart.
+static void attention_scores(const float* const* q,
+                             const float* k,
+                             int cols,
+                             int dim,
+                             int ldk,
+                             float* s) {
+  for (int j = 0; j < cols; j++) {
+    const float* kj = k + static_cast<int64_t>(j) * ldk;
+    float32x4_t acc0 = vdupq_n_f32(0.f);
+    float32x4_t acc1 = vdupq_n_f32(0.f);
+    float32x4_t acc2 = vdupq_n_f32(0.f);
+    float32x4_t acc3 = vdupq_n_f32(0.f);
+    int c = 0;
+    for (; c + 4 <= dim; c += 4) {
+      float32x4_t vk = vld1q_f32(kj + c);
+      acc0 = vmlaq_f32(acc0, vld1q_f32(q[0] + c), vk);
+      acc1 = vmlaq_f32(acc1, vld1q_f32(q[1] + c), vk);
+      acc2 = vmlaq_f32(acc2, vld1q_f32(q[2] + c), vk);
+      acc3 = vmlaq_f32(acc3, vld1q_f32(q[3] + c), vk);
+    }
+    float sum0 = reduce_add(acc0);
+    float sum1 = reduce_add(acc1);
+    float sum2 = reduce_add(acc2);
+    float sum3 = reduce_add(acc3);
+    for (; c < dim; c++) {
+      sum0 += q[0][c] * kj[c];
+      sum1 += q[1][c] * kj[c];
+      sum2 += q[2][c] * kj[c];
+      sum3 += q[3][c] * kj[c];
+    }
+    s[j] = sum0;
+    s[kAttentionCols + j] = sum1;
+    s[2 * kAttentionCols + j] = sum2;
+    s[3 * kAttentionCols + j] = sum3;
+  }
+}
+
+// Scale and mask the scores s of a row, and replace them by the
+// probabilities exp(s - m) with the new running max m. The running sum l and
+// the output o of the row are rescaled to the new max.
+static void attention_online_softmax(bool fast_math,
+                                     float* s,
+                                     int cols,
+                                     const float* mask,
+                                     int mask_col_stride,
+                                     float scale,
+                                     float* m,
+                                     float* l,
+                                     float* o,
+                                     int dim_v) {
+  float32x4_t vscale = vdupq_n_f32(scale);
+  int j = 0;
+  if (mask && mask_col_stride == 1) {
+    for (; j + 4 <= cols; j += 4) {
+      float32x4_t vs = vmulq_f32(vld1q_f32(s + j), vscale);
+      vst1q_f32(s + j, vaddq_f32(vs, vld1q_f32(mask + j)));
+    }
+  } else {
+    float32x4_t vmask = vdupq_n_f32(mask ? mask[0] : 0.f);
+    for (; j + 4 <= cols; j += 4) {
+      float32x4_t vs = vmulq_f32(vld1q_f32(s + j), vscale);
+      vst1q_f32(s + j, vaddq_f32(vs, vmask));
+    }
+  }
+  for (; j < cols; j++) {
+    s[j] = s[j] * scale + (mask ? mask[j * mask_col_stride] : 0.f);
+  }
+
+  float32x4_t vmax = vdupq_n_f32(-std::numeric_limits<float>::infinity());
+  for (j = 0; j + 4 <= cols; j += 4) {
+    vmax = vmaxq_f32(vmax, vld1q_f32(s + j));
+  }
+  float max_val = reduce_max(vmax);
+  for (; j < cols; j++) max_val = std::max(max_val, s[j]);
+  float m_new = std::max(*m, max_val);
+  if (m_new == -std::numeric_limits<float>::infinity()) {
+    // All the keys so far are masked out.
+    memset(s, 0, sizeof(float) * cols);
+    return;
+  }
+
+  float32x4_t vm = vdupq_n_f32(m_new);
+  float32x4_t vsum = vdupq_n_f32(0.f);
+  for (j = 0; j + 4 <= cols; j += 4) {
+    float32x4_t vp = exp_ps(vsubq_f32(vld1q_f32(s + j), vm), fast_math);
+    vst1q_f32(s + j, vp);
+    vsum = vaddq_f32(vsum, vp);
+  }
+  float sum = reduce_add(vsum);
+  for (; j < cols; j++) {
+    s[j] = expf(s[j] - m_new);
+    sum += s[j];
+  }
+  float alpha = expf(*m - m_new);
+  *l = *l * alpha + sum;
+  *m = m_new;
+  if (alpha < 1.f) {
+    float32x4_t valpha = vdupq_n_f32(alpha);
+    int c = 0;
+    for (; c + 4 <= dim_v; c += 4) {
+      vst1q_f32(o + c, vmulq_f32(vld1q_f32(o + c), valpha));
+    }
+    for (; c < dim_v; c++) o[c] *= alpha;
+  }
+}
+
+// o[r] += p[r] * v for the kAttentionRows rows, the accumulators of the four
+// rows are kept in the registers through the keys of the tile. The rows of v
+// are ldv apart.
+static void attention_accumulate(const float* p,
+                                 const float* v,
+                                 int cols,
+                                 int dim_v,
+                                 int ldv,
+                                 float* o) {
+  float* o0 = o;
+  float* o1 = o0 + dim_v;
+  float* o2 = o1 + dim_v;
+  float* o3 = o2 + dim_v;
+  const float* p0 = p;
+  const float* p1 = p0 + kAttentionCols;
+  const float* p2 = p1 + kAttentionCols;
+  const float* p3 = p2 + kAttentionCols;
+  int c = 0;
+  for (; c + 4 <= dim_v; c += 4) {
+    float32x4_t acc0 = vld1q_f32(o0 + c);
+    float32x4_t acc1 = vld1q_f32(o1 + c);
+    float32x4_t acc2 = vld1q_f32(o2 + c);
+    float32x4_t acc3 = vld1q_f32(o3 + c);
+    const float* vj = v + c;
+    for (int j = 0; j < cols; j++, vj += ldv) {
+      float32x4_t vv = vld1q_f32(vj);
+      acc0 = vmlaq_n_f32(acc0, vv, p0[j]);
+      acc1 = vmlaq_n_f32(acc1, vv, p1[j]);
+      acc2 = vmlaq_n_f32(acc2, vv, p2[j]);
+      acc3 = vmlaq_n_f32(acc3, vv, p3[j]);
+    }
+    vst1q_f32(o0 + c, acc0);
+    vst1q_f32(o1 + c, acc1);
+    vst1q_f32(o2 + c, acc2);
+    vst1q_f32(o3 + c, acc3);
+  }
+  for (; c < dim_v; c++) {
+    const float* vj = v + c;
+    for (int j = 0; j < cols; j++, vj += ldv) {
+      o0[c] += p0[j] * vj[0];
+      o1[c] += p1[j] * vj[0];
+      o2[c] += p2[j] * vj[0];
+      o3[c] += p3[j] * vj[0];
+    }
+  }
+}
+
+// The attention of a block of kAttentionRows queries against seq_k keys, the
+// rows of k and v are ldk and ldv apart. The unnormalized outputs are left in
+// o, with the running max and sum of the rows in m and l. s, o, m and l are
+// the workspace of the block.
+static void attention_block(bool fast_math,
+                            const float* const* q_rows,
+                            const float* const* mask_rows,
+                            int mask_col_stride,
+                            const float* k,
+                            int ldk,
+                            const float* v,
+                            int ldv,
+                            int seq_k,
+                            int dim,
+                            int dim_v,
+                            float scale,
+                            float* s,
+                            float* o,
+                            float* m,
+                            float* l) {
+  for (int r = 0; r < kAttentionRows; r++) {
+    m[r] = -std::numeric_limits<float>::infinity();
+    l[r] = 0.f;
+  }
+  memset(o, 0, sizeof(float) * kAttentionRows * dim_v);
+  for (int col0 = 0; col0 < seq_k; col0 += kAttentionCols) {
+    int cols = std::min(kAttentionCols, seq_k - col0);
+    attention_scores(
+        q_rows, k + static_cast<int64_t>(col0) * ldk, cols, dim, ldk, s);
+    for (int r = 0; r < kAttentionRows; r++) {
+      attention_online_softmax(
+          fast_math,
+          s + r * kAttentionCols,
+          cols,
+          mask_rows[r] ? mask_rows[r] + col0 * mask_col_stride : nullptr,
+          mask_col_stride,
+          scale,
+          m + r,
+          l + r,
+          o + r * dim_v,
+          dim_v);
+    }
+    attention_accumulate(
+        s, v + static_cast<int64_t>(col0) * ldv, cols, dim_v, ldv, o);
+  }
+}
+
+// Normalize the first `rows` outputs of a block into out, whose rows are
+// out_row_stride apart.
+static void attention_store(const float* o,
+                            const float* l,
+                            int rows,
+                            int dim_v,
+                            float* out,
+                            int64_t out_row_stride) {
+  for (int r = 0; r < rows; r++) {
+    float* out_r = out + r * out_row_stride;
+    const float* o_r = o + r * dim_v;
+    // The rows whose keys are all masked out are zeros.
+    float inv = l[r] > 0.f ? 1.f / l[r] : 0.f;
+    float32x4_t vinv = vdupq_n_f32(inv);
+    int c = 0;
+    for (; c + 4 <= dim_v; c += 4) {
+      vst1q_f32(out_r + c, vmulq_f32(vld1q_f32(o_r + c), vinv));
+    }
+    for (; c < dim_v; c++) out_r[c] = o_r[c] * inv;
+  }
+}
+
+void fusion_attention(const float* q,
+                      const float* k,
+                      const float* v,
+                      const float* mask,
+                      const int64_t* mask_offsets,
+                      int mask_row_stride,
+                      int mask_col_stride,
+                      float* out,
+                      int batch,
+                      int heads,
+                      int seq_q,
+                      int seq_k,
+                      int kv_stride,
+                      int dim,
+                      int dim_v,
+                      float scale,
+                      bool transpose_out,
+                      ARMContext* ctx) {
+  int blocks = (seq_q + kAttentionRows - 1) / kAttentionRows;
+  // The scores of a tile, the outputs, the running max and sum of a block.
+  int thread_stride = kAttentionRows * (kAttentionCols + dim_v + 2);
+  ctx->ExtendWorkspace(sizeof(float) * ctx->threads() * thread_stride);
+  float* workspace = ctx->workspace_data<float>();
+  int out_row_stride = transpose_out ? heads * dim_v : dim_v;
+  const bool fast_math = FastMath::Enabled();
+
+  LITE_PARALLEL_BEGIN(task, tid, batch * blocks) {
+#ifdef LITE_USE_THREAD_POOL
+    float* s = workspace + tid * thread_stride;
+#elif defined(ARM_WITH_OMP)
+    float* s = workspace + omp_get_thread_num() * thread_stride;
+#else
+    float* s = workspace;
+#endif
+    float* o = s + kAttentionRows * kAttentionCols;
+    float* m = o + kAttentionRows * dim_v;
+    float* l = m + kAttentionRows;
+    int b = task / blocks;
+    int row0 = (task % blocks) * kAttentionRows;
+    int rows = std::min(kAttentionRows, seq_q - row0);
+    const float* q_rows[kAttentionRows];
+    const float* mask_rows[kAttentionRows];
+    for (int r = 0; r < kAttentionRows; r++) {
+      int row = row0 + std::min(r, rows - 1);
+      q_rows[r] = q + (static_cast<int64_t>(b) * seq_q + row) * dim;
+      mask_rows[r] = mask ? mask + mask_offsets[b] + row * mask_row_stride
+                          : nullptr;
+    }
+    attention_block(fast_math,
+                    q_rows,
+                    mask_rows,
+                    mask_col_stride,
+                    k + static_cast<int64_t>(b) * kv_stride * dim,
+                    dim,
+                    v + static_cast<int64_t>(b) * kv_stride * dim_v,
+                    dim_v,
+                    seq_k,
+                    dim,
+                    dim_v,
+                    scale,
+                    s,
+                    o,
+                    m,
+                    l);
+
+    // The rows of a head are interleaved with the other heads if transposed.
+    int64_t out_offset =
+        transpose_out
+            ? (static_cast<int64_t>(b / heads) * seq_q * heads + b % heads) *
+                  dim_v
+            : static_cast<int64_t>(b) * seq_q * dim_v;
+    out_offset += static_cast<int64_t>(row0) * out_row_stride;
+    attention_store(o, l, rows, dim_v, out + out_offset, out_row_stride);
+  }
+  LITE_PARALLEL_END()
+}
+
+void fusion_attention_varlen(const float* q,
+                             const float* k,
+                             const float* v,
+                             const int* cu_seqlens,
+                             float* out,
+                             int batch,
+                             int heads,
+                             int dim,
+                             int dim_v,
+                             float scale,
+                             ARMContext* ctx) {
+  // The first row of each block of the sequences, the blocks of the padding
+  // don't exist at all.
+  std::vector<int> block_rows;
+  std::vector<int> block_seqs;
+  for (int i = 0; i < batch; i++) {
+    for (int row = cu_seqlens[i]; row < cu_seqlens[i + 1];
+         row += kAttentionRows) {
+      block_rows.push_back(row);
+      block_seqs.push_back(i);
+    }
+  }
+  int blocks = static_cast<int>(block_rows.size());
+  int thread_stride = kAttentionRows * (kAttentionCols + dim_v + 2);
+  ctx->ExtendWorkspace(sizeof(float) * ctx->threads() * thread_stride);
+  float* workspace = ctx->workspace_data<float>();
+  int ldq = heads * dim;
+  int ldv = heads * dim_v;
+  const float* no_mask[kAttentionRows] = {nullptr};
+  const bool fast_math = FastMath::Enabled();
+
+  LITE_PARALLEL_BEGIN(task, tid, blocks * heads) {
+#ifdef LITE_USE_THREAD_POOL
+    float* s = workspace + tid * thread_stride;
+#elif defined(ARM_WITH_OMP)
+    float* s = workspace + omp_get_thread_num() * thread_stride;
+#else
+    float* s = workspace;
+#endif
+    float* o = s + kAttentionRows * kAttentionCols;
+    float* m = o + kAttentionRows * dim_v;
+    float* l = m + kAttentionRows;
+    int block = task / heads;
+    int h = task % heads;
+    int seq = block_seqs[block];
+    int begin = cu_seqlens[seq];
+    int row0 = block_rows[block];
+    int rows = std::min(kAttentionRows, cu_seqlens[seq + 1] - row0);
+    const float* q_rows[kAttentionRows];
+    for (int r = 0; r < kAttentionRows; r++) {
+      int row = row0 + std::min(r, rows - 1);
+      q_rows[r] = q + static_cast<int64_t>(row) * ldq + h * dim;
+    }
+    attention_block(fast_math,
+                    q_rows,
+                    no_mask,
+                    0,
+                    k + static_cast<int64_t>(begin) * ldq + h * dim,
+                    ldq,
+                    v + static_cast<int64_t>(begin) * ldv + h * dim_v,
+                    ldv,
+                    cu_seqlens[seq + 1] - begin,
+                    dim,
+                    dim_v,
+                    scale,
+                    s,
+                    o,
+                    m,
+                    l);
+    attention_store(o,
+                    l,
+                    rows,
+                    dim_v,
+                    out + static_cast<int64_t>(row0) * ldv + h * dim_v,
+                    ldv);
+  }
+  LITE_PARALLEL_END()
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
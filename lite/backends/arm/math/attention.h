@@ -0,0 +1,71 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstdint>
+#include "lite/core/context.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// The attention softmax(q * k^T * scale + mask) * v of `batch` heads, q is
+// [batch, seq_q, dim], k is [batch, kv_stride, dim] and v is [batch,
+// kv_stride, dim_v], of which the first seq_k rows of each head are used.
+// The keys are visited in tiles with the online softmax, so only the scores
+// of a block of queries against a tile of keys are kept. The mask of
+// the b-th head starts at mask + mask_offsets[b], with the strides of the
+// rows and columns being 0 if broadcast. out is [batch, seq_q, dim_v], or
+// [batch / heads, seq_q, heads, dim_v] if transpose_out.
+void fusion_attention(const float* q,
+                      const float* k,
+                      const float* v,
+                      const float* mask,
+                      const int64_t* mask_offsets,
+                      int mask_row_stride,
+                      int mask_col_stride,
+                      float* out,
+                      int batch,
+                      int heads,
+                      int seq_q,
+                      int seq_k,
+                      int kv_stride,
+                      int dim,
+                      int dim_v,
+                      float scale,
+                      bool transpose_out,
+                      ARMContext* ctx);
+
+// The attention of `batch` sequences packed without padding, the i-th one is
+// of the rows [cu_seqlens[i], cu_seqlens[i + 1]) of q [total, heads, dim], k
+// [total, heads, dim], v [total, heads, dim_v] and out [total, heads, dim_v].
+// The queries only attend to the keys of their own sequence, so nothing is
+// computed for the padding.
+void fusion_attention_varlen(const float* q,
+                             const float* k,
+                             const float* v,
+                             const int* cu_seqlens,
+                             float* out,
+                             int batch,
+                             int heads,
+                             int dim,
+                             int dim_v,
+                             float scale,
+                             ARMContext* ctx);
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,143 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/bf16/conv_impl_bf16.h"
+#include "lite/backends/arm/math/bf16/gemm_bf16.h"
+#include "lite/backends/arm/math/conv_impl.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace bf16 {
+
+void conv1x1s1_gemm_bf16(const float* i_data,
+                         float* o_data,
+                         int num,
+                         int oc,
+                         int oh,
+                         int ow,
+                         int ic,
+                         int ih,
+                         int win,
+                         const uint16_t* weights,
+                         const float* bias,
+                         const operators::ConvParam& param,
+                         ARMContext* ctx) {
+  int channel_size_out = ow * oh;
+  int channel_size_in = win * ih;
+
+  const int group = param.groups;
+  const int m = oc / group;
+  const int n = oh * ow;
+  const int k = ic / group;
+  bool flag_bias = param.bias != nullptr;
+  int weights_size_per_group = get_packed_size_bf16(m, k);
+
+  for (int b = 0; b < num; ++b) {
+    for (int g = 0; g < group; ++g) {
+      float* dout_group = o_data + (b * oc + g * m) * channel_size_out;
+      const float* din_group = i_data + (b * ic + g * k) * channel_size_in;
+      const uint16_t* weights_group = weights + g * weights_size_per_group;
+      const float* bias_group = flag_bias ? bias + g * m : nullptr;
+      gemm_prepack_bf16(weights_group,
+                        din_group,
+                        bias_group,
+                        dout_group,
+                        m,
+                        n,
+                        k,
+                        flag_bias,
+                        false,
+                        param.activation_param,
+                        ctx);
+    }
+  }
+}
+
+void conv_im2col_gemm_bf16(const float* i_data,
+                           float* o_data,
+                           int num,
+                           int oc,
+                           int oh,
+                           int ow,
+                           int ic,
+                           int ih,
+                           int win,
+                           const uint16_t* weights,
+                           const float* bias,
+                           const operators::ConvParam& param,
+                           ARMContext* ctx) {
+  const int group = param.groups;
+  auto filter_dims = param.filter->dims();
+  const int kernel_h = filter_dims[2];
+  const int kernel_w = filter_dims[3];  // nchw
+  const int m = oc / group;
+  const int n = oh * ow;
+  const int k = ic * kernel_h * kernel_w / group;
+  const int chin_per_group = ic / group;
+  int channel_size_out = ow * oh;
+  int channel_size_in = win * ih;
+  bool flag_bias = param.bias != nullptr;
+  int weights_size_per_group = get_packed_size_bf16(m, k);
+
+  // The panel of B packed by the gemm is kept in the first llc_size bytes.
+  float* tmp_work_space =
+      ctx->workspace_data<float>() + ctx->llc_size() / sizeof(float);
+
+  auto paddings = *param.paddings;
+  auto dilations = *param.dilations;
+  for (int b = 0; b < num; ++b) {
+    for (int g = 0; g < group; ++g) {
+      float* dout_group = o_data + (b * oc + g * m) * channel_size_out;
+      const float* din_group =
+          i_data + (b * ic + g * chin_per_group) * channel_size_in;
+      const uint16_t* weights_group = weights + g * weights_size_per_group;
+      const float* bias_group = flag_bias ? bias + g * m : nullptr;
+      float* dB = tmp_work_space;
+      im2col<float>(din_group,
+                    chin_per_group,
+                    ih,
+                    win,
+                    kernel_h,
+                    kernel_w,
+                    paddings[0],
+                    paddings[1],
+                    paddings[2],
+                    paddings[3],
+                    param.strides[0],
+                    param.strides[1],
+                    dilations[0],
+                    dilations[1],
+                    dB);
+      gemm_prepack_bf16(weights_group,
+                        dB,
+                        bias_group,
+                        dout_group,
+                        m,
+                        n,
+                        k,
+                        flag_bias,
+                        false,
+                        param.activation_param,
+                        ctx);
+    }
+  }
+}
+
+}  // namespace bf16
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,61 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include "lite/core/context.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace bf16 {
+
+// The gemm-like convs with the bf16 weights packed by trans_gemm_weights_bf16,
+// the input and the output are fp32.
+void conv1x1s1_gemm_bf16(const float* i_data,
+                         float* o_data,
+                         int num,
+                         int oc,
+                         int oh,
+                         int ow,
+                         int ic,
+                         int ih,
+                         int win,
+                         const uint16_t* weights,
+                         const float* bias,
+                         const operators::ConvParam& param,
+                         ARMContext* ctx);
+
+void conv_im2col_gemm_bf16(const float* i_data,
+                           float* o_data,
+                           int num,
+                           int oc,
+                           int oh,
+                           int ow,
+                           int ic,
+                           int ih,
+                           int win,
+                           const uint16_t* weights,
+                           const float* bias,
+                           const operators::ConvParam& param,
+                           ARMContext* ctx);
+
+}  // namespace bf16
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,395 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/bf16/gemm_bf16.h"
+#include <algorithm>
+#include "lite/backends/arm/math/bf16/type_trans_bf16.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace bf16 {
+
+namespace {
+inline int round_up(int x, int block) {
+  return (x + block - 1) / block * block;
+}
+
+inline uint16_t to_bf16(uint16_t x) { return x; }
+inline uint16_t to_bf16(float x) { return fp32_to_bf16(x); }
+
+// Pack the 8 rows of the R x K matrix, the 4 bf16 of a row in K are
+// contiguous, and the rows are stored in pairs for bfmmla:
+// r0k0-3, r1k0-3, r2k0-3, ..., r7k0-3, r0k4-7, ...
+// The rows out of [r0, rmax) and K out of [k0, kmax) are padded with zeros.
+// `k_contiguous` is whether the elements of a row are contiguous in `in`.
+template <typename T>
+void pack_bf16(uint16_t* out,
+               const T* in,
+               int ldin,
+               int r0,
+               int rmax,
+               int k0,
+               int kmax,
+               bool k_contiguous) {
+  int kup = round_up(kmax - k0, KBLOCK_BF16);
+  for (int r = r0; r < rmax; r += MBLOCK_BF16) {
+    for (int k = k0; k < k0 + kup; k += KBLOCK_BF16) {
+      for (int i = r; i < r + MBLOCK_BF16; i++) {
+        for (int j = k; j < k + KBLOCK_BF16; j++) {
+          if (i >= rmax || j >= kmax) {
+            *out++ = 0;
+          } else {
+            *out++ = to_bf16(k_contiguous ? in[i * ldin + j]
+                                          : in[j * ldin + i]);
+          }
+        }
+      }
+    }
+  }
+}
+
+// The 8x8 fp32 tile of the row pairs of A and the col pairs of B, the 2x2
+// block of row pair i and col pair j is stored at tile + 16 * i + 4 * j.
+inline void gemm_bf16_kernel_8x8_c(const uint16_t* a_ptr,
+                                   const uint16_t* b_ptr,
+                                   float* tile,
+                                   int k) {
+  std::fill(tile, tile + MBLOCK_BF16 * NBLOCK_BF16, 0.f);
+  for (int s = 0; s < k; s++) {
+    for (int i = 0; i < MBLOCK_BF16; i++) {
+      for (int j = 0; j < NBLOCK_BF16; j++) {
+        float sum = 0.f;
+        for (int t = 0; t < KBLOCK_BF16; t++) {
+          sum += bf16_to_fp32(a_ptr[i * KBLOCK_BF16 + t]) *
+                 bf16_to_fp32(b_ptr[j * KBLOCK_BF16 + t]);
+        }
+        tile[(i / 2) * 16 + (j / 2) * 4 + (i % 2) * 2 + j % 2] += sum;
+      }
+    }
+    a_ptr += MBLOCK_BF16 * KBLOCK_BF16;
+    b_ptr += NBLOCK_BF16 * KBLOCK_BF16;
+  }
+}
+
+#if defined(WITH_ARM_BF16) && defined(__aarch64__)
+// clang-format off
+// bfmmla vd.4s, vn.8h, vm.8h, which is emitted as the machine code for the
+// toolchains without armv8.6. vd += [n0; n1] * [m0; m1]^T, where n0, n1, m0
+// and m1 are the halves of 8 bf16 of vn and vm, and vd is the 2x2 fp32.
+#define BFMMLA(vd, vn, vm) \
+  ".inst 0x6e40ec00 | (" #vm " << 16) | (" #vn " << 5) | " #vd "\n"
+
+// the same layout as gemm_bf16_kernel_8x8_c, the 2x2 block of C of row pair i
+// and col pair j is accumulated in v(8 + 4 * i + j).
+#define GEMM_BFMMLA_KERNEL_8x8                                     \
+  "eor    v8.16b,  v8.16b,  v8.16b\n"                              \
+  "eor    v9.16b,  v9.16b,  v9.16b\n"                              \
+  "eor    v10.16b, v10.16b, v10.16b\n"                             \
+  "eor    v11.16b, v11.16b, v11.16b\n"                             \
+  "eor    v12.16b, v12.16b, v12.16b\n"                             \
+  "eor    v13.16b, v13.16b, v13.16b\n"                             \
+  "eor    v14.16b, v14.16b, v14.16b\n"                             \
+  "eor    v15.16b, v15.16b, v15.16b\n"                             \
+  "eor    v16.16b, v16.16b, v16.16b\n"                             \
+  "eor    v17.16b, v17.16b, v17.16b\n"                             \
+  "eor    v18.16b, v18.16b, v18.16b\n"                             \
+  "eor    v19.16b, v19.16b, v19.16b\n"                             \
+  "eor    v20.16b, v20.16b, v20.16b\n"                             \
+  "eor    v21.16b, v21.16b, v21.16b\n"                             \
+  "eor    v22.16b, v22.16b, v22.16b\n"                             \
+  "eor    v23.16b, v23.16b, v23.16b\n"                             \
+  "cbz    %w[k], 2f\n"                 /* check loop count > 0 */  \
+  "1:\n"                               /* main loop */             \
+  "ld1    {v0.8h, v1.8h, v2.8h, v3.8h}, [%[a_ptr]], #64\n"         \
+  "ld1    {v4.8h, v5.8h, v6.8h, v7.8h}, [%[b_ptr]], #64\n"         \
+  "prfm   pldl1keep, [%[a_ptr], #128]\n"                           \
+  "prfm   pldl1keep, [%[b_ptr], #128]\n"                           \
+  BFMMLA(8, 0, 4)  BFMMLA(9, 0, 5)  BFMMLA(10, 0, 6) BFMMLA(11, 0, 7)  \
+  BFMMLA(12, 1, 4) BFMMLA(13, 1, 5) BFMMLA(14, 1, 6) BFMMLA(15, 1, 7)  \
+  BFMMLA(16, 2, 4) BFMMLA(17, 2, 5) BFMMLA(18, 2, 6) BFMMLA(19, 2, 7)  \
+  BFMMLA(20, 3, 4) BFMMLA(21, 3, 5) BFMMLA(22, 3, 6) BFMMLA(23, 3, 7)  \
+  "subs   %w[k], %w[k], #1\n"                                      \
+  "bne    1b\n"                                                    \
+  "2:\n"                                                           \
+  "st1    {v8.4s, v9.4s, v10.4s, v11.4s}, [%[c_ptr]], #64\n"       \
+  "st1    {v12.4s, v13.4s, v14.4s, v15.4s}, [%[c_ptr]], #64\n"     \
+  "st1    {v16.4s, v17.4s, v18.4s, v19.4s}, [%[c_ptr]], #64\n"     \
+  "st1    {v20.4s, v21.4s, v22.4s, v23.4s}, [%[c_ptr]], #64\n"
+// clang-format on
+
+inline void gemm_bfmmla_kernel_8x8(const uint16_t* a_ptr,
+                                   const uint16_t* b_ptr,
+                                   float* c_ptr,
+                                   int k) {
+  // clang-format off
+  asm volatile(GEMM_BFMMLA_KERNEL_8x8
+               : [a_ptr] "+r"(a_ptr),
+                 [b_ptr] "+r"(b_ptr),
+                 [k] "+r"(k),
+                 [c_ptr] "+r"(c_ptr)
+               :
+               : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5",
+                 "v6", "v7", "v8", "v9", "v10", "v11", "v12", "v13",
+                 "v14", "v15", "v16", "v17", "v18", "v19", "v20",
+                 "v21", "v22", "v23");
+  // clang-format on
+}
+#undef BFMMLA
+#endif  // WITH_ARM_BF16 && __aarch64__
+
+// `k` is the number of the K blocks.
+inline void gemm_bf16_kernel_8x8(const uint16_t* a_ptr,
+                                 const uint16_t* b_ptr,
+                                 float* tile,
+                                 int k,
+                                 bool has_bf16) {
+#if defined(WITH_ARM_BF16) && defined(__aarch64__)
+  if (has_bf16) {
+    gemm_bfmmla_kernel_8x8(a_ptr, b_ptr, tile, k);
+    return;
+  }
+#endif
+  gemm_bf16_kernel_8x8_c(a_ptr, b_ptr, tile, k);
+}
+
+struct Activation {
+  lite_api::ActivationType type{lite_api::ActivationType::kIndentity};
+  float alpha{0.f};
+  float scale{1.f};
+  float offset{0.f};
+  float threshold{0.f};
+
+  explicit Activation(const operators::ActivationParam& act_param) {
+    if (!act_param.has_active) return;
+    CHECK(gemm_bf16_support_act(act_param))
+        << "bf16 gemm does not support the activation "
+        << static_cast<int>(act_param.active_type);
+    type = act_param.active_type;
+    if (type == lite_api::ActivationType::kRelu6) {
+      alpha = act_param.Relu_clipped_coef;
+    } else if (type == lite_api::ActivationType::kLeakyRelu) {
+      alpha = act_param.Leaky_relu_alpha;
+    } else if (type == lite_api::ActivationType::kHardSwish) {
+      scale = 1.f / act_param.hard_swish_scale;
+      offset = act_param.hard_swish_offset;
+      threshold = act_param.hard_swish_threshold;
+    }
+  }
+
+  float operator()(float x) const {
+    switch (type) {
+      case lite_api::ActivationType::kRelu:
+        return std::max(x, 0.f);
+      case lite_api::ActivationType::kRelu6:
+        return std::min(std::max(x, 0.f), alpha);
+      case lite_api::ActivationType::kLeakyRelu:
+        return x >= 0.f ? x : x * alpha;
+      case lite_api::ActivationType::kHardSwish:
+        return x * std::min(std::max(x + offset, 0.f), threshold) * scale;
+      default:
+        return x;
+    }
+  }
+};
+
+// Unzip the tile of the rows [y, ymax) and the cols [x, xmax) into C, the
+// bias is of the rows if `bias_row` is not null, or of the cols.
+inline void gemm_bf16_write_tile(const float* tile,
+                                 float* C,
+                                 int ldc,
+                                 int y,
+                                 int ymax,
+                                 int x,
+                                 int xmax,
+                                 const float* bias_row,
+                                 const float* bias_col,
+                                 const Activation& act) {
+  for (int i = y; i < ymax; i++) {
+    int r = i - y;
+    float* c = C + i * ldc + x;
+    for (int j = x; j < xmax; j++) {
+      int s = j - x;
+      float v = tile[(r / 2) * 16 + (s / 2) * 4 + (r % 2) * 2 + s % 2];
+      if (bias_row) {
+        v += bias_row[i];
+      } else if (bias_col) {
+        v += bias_col[j];
+      }
+      c[s] = act(v);
+    }
+  }
+}
+}  // namespace
+
+void prepackA_bf16(uint16_t* out,
+                   const uint16_t* in,
+                   int ldin,
+                   int m0,
+                   int mmax,
+                   int k0,
+                   int kmax,
+                   bool is_trans) {
+  pack_bf16(out, in, ldin, m0, mmax, k0, kmax, !is_trans);
+}
+
+void prepackA_bf16(uint16_t* out,
+                   const float* in,
+                   int ldin,
+                   int m0,
+                   int mmax,
+                   int k0,
+                   int kmax,
+                   bool is_trans) {
+  pack_bf16(out, in, ldin, m0, mmax, k0, kmax, !is_trans);
+}
+
+void trans_gemm_weights_bf16(const Tensor& tin,
+                             Tensor& tout,  // NOLINT
+                             int group,
+                             ARMContext* ctx) {
+  CHECK_EQ(tin.dims().size(), 4) << "conv weights dims size must = 4";
+  CHECK(tin.precision() == PRECISION(kBF16));
+  int m = tin.dims()[0] / group;
+  int k = tin.dims().count(1, 4);
+  int group_size = get_packed_size_bf16(m, k);
+  tout.Resize({group_size * group});
+  auto* w_trans_ptr = tout.mutable_data<uint16_t>();
+  tout.set_precision(PRECISION(kBF16));
+  const auto* w_data = tin.data<uint16_t>();
+  for (int g = 0; g < group; ++g) {
+    prepackA_bf16(w_trans_ptr + g * group_size,
+                  w_data + g * m * k,
+                  k,
+                  0,
+                  m,
+                  0,
+                  k,
+                  false);
+  }
+}
+
+void gemm_prepack_bf16(const uint16_t* A_packed,
+                       const float* B,
+                       const float* bias,
+                       float* C,
+                       int M,
+                       int N,
+                       int K,
+                       bool is_bias,
+                       bool is_transB,
+                       const operators::ActivationParam& act_param,
+                       ARMContext* ctx) {
+  Activation act(act_param);
+  bool has_bf16 = ctx->has_bf16();
+  size_t llc_size = ctx->llc_size() / 4;
+  auto workspace = ctx->workspace_data<uint16_t>();
+  int kup = round_up(K, KBLOCK_BF16);
+  //! x * k (B) = l2
+  int x_block = static_cast<int>(llc_size / (kup * sizeof(uint16_t)));
+  x_block /= NBLOCK_BF16;
+  x_block *= NBLOCK_BF16;
+  x_block = x_block < NBLOCK_BF16 ? NBLOCK_BF16 : x_block;
+
+  int x_num = (N + (x_block - 1)) / x_block;
+  x_block = (N + x_num - 1) / x_num;
+  x_block = round_up(x_block, NBLOCK_BF16);
+
+  //! apanel is pre_compute outside gemm
+  for (int x0 = 0; x0 < N; x0 += x_block) {
+    int xmax = x0 + x_block;
+    xmax = (xmax > N) ? N : xmax;
+    int bblocks = (xmax - x0 + NBLOCK_BF16 - 1) / NBLOCK_BF16;
+    //! load bpanel
+    uint16_t* b_pannel = workspace;
+    pack_bf16(b_pannel, B, is_transB ? K : N, x0, xmax, 0, K, is_transB);
+
+    LITE_PARALLEL_COMMON_BEGIN(y, tid, M, 0, MBLOCK_BF16) {
+      int ymax = y + MBLOCK_BF16;
+      ymax = (ymax > M) ? M : ymax;
+      const uint16_t* a_ptr = A_packed + y * kup;
+      float tile[MBLOCK_BF16 * NBLOCK_BF16];
+      for (int xb = 0; xb < bblocks; xb++) {
+        const uint16_t* b_ptr = b_pannel + xb * NBLOCK_BF16 * kup;
+        gemm_bf16_kernel_8x8(
+            a_ptr, b_ptr, tile, kup / KBLOCK_BF16, has_bf16);
+        int x = x0 + xb * NBLOCK_BF16;
+        int xend = std::min(x + NBLOCK_BF16, xmax);
+        gemm_bf16_write_tile(tile,
+                             C,
+                             N,
+                             y,
+                             ymax,
+                             x,
+                             xend,
+                             is_bias ? bias : nullptr,
+                             nullptr,
+                             act);
+      }
+    }
+    LITE_PARALLEL_COMMON_END();
+  }
+}
+
+void gemm_prepack_b_bf16(const float* A,
+                         const uint16_t* B_packed,
+                         const float* bias,
+                         float* C,
+                         int M,
+                         int N,
+                         int K,
+                         bool is_bias,
+                         bool is_transA,
+                         const operators::ActivationParam& act_param,
+                         ARMContext* ctx) {
+  Activation act(act_param);
+  bool has_bf16 = ctx->has_bf16();
+  int kup = round_up(K, KBLOCK_BF16);
+  // The whole A is packed, which is usually small, e.g. the inputs of fc.
+  ctx->ExtendWorkspace(get_packed_size_bf16(M, K) * sizeof(uint16_t));
+  auto a_pannel = ctx->workspace_data<uint16_t>();
+  pack_bf16(a_pannel, A, is_transA ? M : K, 0, M, 0, K, !is_transA);
+
+  LITE_PARALLEL_COMMON_BEGIN(x, tid, N, 0, NBLOCK_BF16) {
+    int xmax = x + NBLOCK_BF16;
+    xmax = (xmax > N) ? N : xmax;
+    const uint16_t* b_ptr = B_packed + x * kup;
+    float tile[MBLOCK_BF16 * NBLOCK_BF16];
+    for (int y = 0; y < M; y += MBLOCK_BF16) {
+      int ymax = y + MBLOCK_BF16;
+      ymax = (ymax > M) ? M : ymax;
+      gemm_bf16_kernel_8x8(
+          a_pannel + y * kup, b_ptr, tile, kup / KBLOCK_BF16, has_bf16);
+      gemm_bf16_write_tile(tile,
+                           C,
+                           N,
+                           y,
+                           ymax,
+                           x,
+                           xmax,
+                           nullptr,
+                           is_bias ? bias : nullptr,
+                           act);
+    }
+  }
+  LITE_PARALLEL_COMMON_END();
+}
+
+}  // namespace bf16
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,113 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include "lite/core/context.h"
+#include "lite/core/tensor.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace bf16 {
+
+// for the bfloat16 matrix multiplication (bfmmla) of armv8.6, the rows of A
+// and the cols of B are packed in pairs of 4 bf16.
+const int MBLOCK_BF16 = 8;
+const int NBLOCK_BF16 = 8;
+const int KBLOCK_BF16 = 4;
+
+// The number of bf16 of the m x k weights packed by prepackA_bf16.
+inline int get_packed_size_bf16(int m, int k) {
+  return ((m + MBLOCK_BF16 - 1) / MBLOCK_BF16) * MBLOCK_BF16 *
+         ((k + KBLOCK_BF16 - 1) / KBLOCK_BF16) * KBLOCK_BF16;
+}
+
+// Pack the rows [m0, mmax) of the M x K bf16 weights, or the K x M ones if
+// `is_trans`, as the operand of gemm_prepack_bf16 or gemm_prepack_b_bf16.
+void prepackA_bf16(uint16_t* out,
+                   const uint16_t* in,
+                   int ldin,
+                   int m0,
+                   int mmax,
+                   int k0,
+                   int kmax,
+                   bool is_trans);
+
+// The same as above, but rounds the fp32 `in` to bf16 when packed, e.g. the
+// Y of matmul which is not a weight.
+void prepackA_bf16(uint16_t* out,
+                   const float* in,
+                   int ldin,
+                   int m0,
+                   int mmax,
+                   int k0,
+                   int kmax,
+                   bool is_trans);
+
+// Pack the M x K bf16 weights of each group into `tout`, the same as
+// trans_gemm_weights of the fp32 gemm-like conv.
+void trans_gemm_weights_bf16(const Tensor& tin,
+                             Tensor& tout,  // NOLINT
+                             int group,
+                             ARMContext* ctx);
+
+// Whether the activation can be fused into the bf16 gemms.
+inline bool gemm_bf16_support_act(const operators::ActivationParam& act_param) {
+  if (!act_param.has_active) return true;
+  auto type = act_param.active_type;
+  return type == lite_api::ActivationType::kRelu ||
+         type == lite_api::ActivationType::kRelu6 ||
+         type == lite_api::ActivationType::kLeakyRelu ||
+         type == lite_api::ActivationType::kHardSwish;
+}
+
+// C (M x N) = A (M x K) * B (K x N, or N x K if `is_transB`) + bias (M), A
+// is the weights packed by prepackA_bf16, B is rounded to bf16 when packed,
+// and the products are accumulated in fp32.
+void gemm_prepack_bf16(const uint16_t* A_packed,
+                       const float* B,
+                       const float* bias,
+                       float* C,
+                       int M,
+                       int N,
+                       int K,
+                       bool is_bias,
+                       bool is_transB,
+                       const operators::ActivationParam& act_param,
+                       ARMContext* ctx);
+
+// C (M x N) = A (M x K, or K x M if `is_transA`) * B + bias (N), B is the
+// K x N weights packed by prepackA_bf16 with `is_trans`, e.g. the weights
+// of fc.
+void gemm_prepack_b_bf16(const float* A,
+                         const uint16_t* B_packed,
+                         const float* bias,
+                         float* C,
+                         int M,
+                         int N,
+                         int K,
+                         bool is_bias,
+                         bool is_transA,
+                         const operators::ActivationParam& act_param,
+                         ARMContext* ctx);
+
+}  // namespace bf16
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,98 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/bf16/type_trans_bf16.h"
+#include <arm_neon.h>
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace bf16 {
+
+void fp32_to_bf16(const float* in, uint16_t* out, int size) {
+  int cnt = size >> 3;
+  int remain = size & 7;
+  const uint32_t* ptr_in = reinterpret_cast<const uint32_t*>(in);
+  uint32x4_t vbias = vdupq_n_u32(0x7fff);
+  uint32x4_t vone = vdupq_n_u32(1);
+  uint32x4_t vabs = vdupq_n_u32(0x7fffffff);
+  uint32x4_t vinf = vdupq_n_u32(0x7f800000);
+  uint32x4_t vquiet = vdupq_n_u32(0x400000);
+  for (int i = 0; i < cnt; i++) {
+    uint32x4_t v0 = vld1q_u32(ptr_in);
+    uint32x4_t v1 = vld1q_u32(ptr_in + 4);
+    uint32x4_t nan0 = vcgtq_u32(vandq_u32(v0, vabs), vinf);
+    uint32x4_t nan1 = vcgtq_u32(vandq_u32(v1, vabs), vinf);
+    uint32x4_t r0 =
+        vaddq_u32(v0, vaddq_u32(vandq_u32(vshrq_n_u32(v0, 16), vone), vbias));
+    uint32x4_t r1 =
+        vaddq_u32(v1, vaddq_u32(vandq_u32(vshrq_n_u32(v1, 16), vone), vbias));
+    r0 = vbslq_u32(nan0, vorrq_u32(v0, vquiet), r0);
+    r1 = vbslq_u32(nan1, vorrq_u32(v1, vquiet), r1);
+    vst1q_u16(out, vcombine_u16(vshrn_n_u32(r0, 16), vshrn_n_u32(r1, 16)));
+    ptr_in += 8;
+    out += 8;
+  }
+  in += cnt * 8;
+  for (int i = 0; i < remain; i++) {
+    out[i] = fp32_to_bf16(in[i]);
+  }
+}
+
+void bf16_to_fp32(const uint16_t* in, float* out, int size) {
+  int cnt = size >> 3;
+  int remain = size & 7;
+  uint32_t* ptr_out = reinterpret_cast<uint32_t*>(out);
+  for (int i = 0; i < cnt; i++) {
+    uint16x8_t v = vld1q_u16(in);
+    vst1q_u32(ptr_out, vshll_n_u16(vget_low_u16(v), 16));
+    vst1q_u32(ptr_out + 4, vshll_n_u16(vget_high_u16(v), 16));
+    in += 8;
+    ptr_out += 8;
+  }
+  out += cnt * 8;
+  for (int i = 0; i < remain; i++) {
+    out[i] = bf16_to_fp32(in[i]);
+  }
+}
+
+void tensor_fp32_to_bf16(Tensor* tensor) {
+  CHECK(tensor);
+  if (tensor->precision() != PRECISION(kFloat)) return;
+  Tensor tmp;
+  tmp.CopyDataFrom(*tensor);
+  tensor->clear();
+  // mutable_data<uint16_t> leaves the precision unknown.
+  auto* out = tensor->mutable_data<uint16_t>();
+  tensor->set_precision(PRECISION(kBF16));
+  fp32_to_bf16(tmp.data<float>(), out, static_cast<int>(tensor->numel()));
+}
+
+void tensor_bf16_to_fp32(Tensor* tensor) {
+  CHECK(tensor);
+  if (tensor->precision() != PRECISION(kBF16)) return;
+  Tensor tmp;
+  tmp.CopyDataFrom(*tensor);
+  tensor->clear();
+  bf16_to_fp32(tmp.data<uint16_t>(),
+               tensor->mutable_data<float>(),
+               static_cast<int>(tensor->numel()));
+}
+
+}  // namespace bf16
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
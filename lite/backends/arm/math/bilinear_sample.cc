@@ -0,0 +1,84 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/bilinear_sample.h"
+#include <arm_neon.h>
+#include <cmath>
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+void bilinear_table_set(int* offsets,
+                        float* weights,
+                        int p,
+                        float x,
+                        float y,
+                        int w,
+                        int h,
+                        int base,
+                        float scale) {
+  int xw = static_cast<int>(floorf(x));
+  int yn = static_cast<int>(floorf(y));
+  float dw = x - xw;
+  float de = xw + 1 - x;
+  float dn = y - yn;
+  float ds = yn + 1 - y;
+  int xs[4] = {xw, xw + 1, xw, xw + 1};
+  int ys[4] = {yn, yn, yn + 1, yn + 1};
+  float ws[4] = {ds * de, ds * dw, dn * de, dn * dw};
+  int* ofs = offsets + p / 4 * kBilinearTile + p % 4;
+  float* wts = weights + p / 4 * kBilinearTile + p % 4;
+  for (int k = 0; k < 4; ++k) {
+    bool inside = xs[k] >= 0 && xs[k] < w && ys[k] >= 0 && ys[k] < h;
+    ofs[k * 4] = inside ? base + ys[k] * w + xs[k] : 0;
+    wts[k * 4] = inside ? ws[k] * scale : 0.f;
+  }
+}
+
+void bilinear_sample(const float* src,
+                     const int* offsets,
+                     const float* weights,
+                     float* dst,
+                     int size) {
+  int cnt = size / 4;
+  for (int i = 0; i < cnt; ++i) {
+    float32x4_t vsum = vdupq_n_f32(0.f);
+    for (int k = 0; k < 4; ++k) {
+      const int* ofs = offsets + k * 4;
+      float32x4_t vval = vdupq_n_f32(src[ofs[0]]);
+      vval = vsetq_lane_f32(src[ofs[1]], vval, 1);
+      vval = vsetq_lane_f32(src[ofs[2]], vval, 2);
+      vval = vsetq_lane_f32(src[ofs[3]], vval, 3);
+      vsum = vmlaq_f32(vsum, vval, vld1q_f32(weights + k * 4));
+    }
+    vst1q_f32(dst, vsum);
+    offsets += kBilinearTile;
+    weights += kBilinearTile;
+    dst += 4;
+  }
+  for (int p = 0; p < size - cnt * 4; ++p) {
+    float sum = 0.f;
+    for (int k = 0; k < 4; ++k) {
+      sum += src[offsets[k * 4 + p]] * weights[k * 4 + p];
+    }
+    dst[p] = sum;
+  }
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
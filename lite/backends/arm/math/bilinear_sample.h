@@ -0,0 +1,54 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// The bilinear sample table keeps the points in tiles of 4, a tile holds the
+// 4 corner offsets of each of its points as offsets[corner][point], and the
+// weights in the same order. The corners out of the image get the offset 0
+// and the weight 0, so the sampling needs no bounds check.
+const int kBilinearTile = 16;
+
+inline int bilinear_table_size(int size) {
+  return (size + 3) / 4 * kBilinearTile;
+}
+
+// sets the point p of the table to sample (x, y) of a h * w image, the
+// weights are scaled by scale and the offsets are moved by base
+void bilinear_table_set(int* offsets,
+                        float* weights,
+                        int p,
+                        float x,
+                        float y,
+                        int w,
+                        int h,
+                        int base = 0,
+                        float scale = 1.f);
+
+// dst[p] = sum of the corner weights by the src corners of the point p
+void bilinear_sample(const float* src,
+                     const int* offsets,
+                     const float* weights,
+                     float* dst,
+                     int size);
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -403,24 +403,18 @@ void conv_compute_4x4_3x3_int8(const int8_t* input,
   int w_pad = win + pad_w0 + pad_w1;
   int h_pad = hin + pad_h0 + pad_h1;
 
-  const int zero_len = (w_pad + 5) / 6 * 6;  // up_div in_w_pad 6x6
-  Dtype zero_ptr[zero_len];                  // NOLINT
-  memset(zero_ptr, 0, zero_len * sizeof(Dtype));
-
   int8_t* input_c8 = tmp_work_space;  // input_c8 for input layout transform
   int new_h_stride = w_pad * 8;       // 8 is c8
   int new_c_stride = new_h_stride * h_pad;  // in stride w_pad*h_pad*8
 
   int ic_8_stride = w_pad * h_pad * 8;
-  int oc_8_stride = wout * hout * 8;
 
   int tile_block = 8;
   int block_count = (size_tile + tile_block - 1) / tile_block;
 
   int threads = ctx->threads();
   int16_t* g_tmp_data = reinterpret_cast<int16_t*>(
-      tmp_work_space + ic_8 * ic_8_stride * sizeof(int8_t) +  // NOLINT
-      oc_8 * oc_8_stride * sizeof(int32_t));
+      tmp_work_space + ic_8 * ic_8_stride * sizeof(int8_t));  // NOLINT
   int tmp_input_thread_stride =
       tile_block * ic_8 * 288;  // 128 = 8*4*4, 8*6*6=288
   // tmp_output_thread_stride is batched gemm result
@@ -441,6 +435,9 @@ void conv_compute_4x4_3x3_int8(const int8_t* input,
       g_trans_remain_tmp_data + threads * 288);  // 4x4x8=128
   int32_t* g_trans_remain_tmp_output_data =
       g_trans_tmp_output_data + threads * 192;
+  // The padded channels of the last c8 block are written into it
+  Dtype* g_trash_data =
+      reinterpret_cast<Dtype*>(g_trans_remain_tmp_output_data + threads * 128);
   auto act_type = act_param.active_type;
   int flag_act = 0;  // relu: 1, relu6: 2, leakey: 3
   float alpha[12] = {
@@ -487,7 +484,6 @@ void conv_compute_4x4_3x3_int8(const int8_t* input,
                                   win,
                                   hin);
     }
-    int32_t* output_c8 = (int32_t*)(input_c8 + ic_8 * ic_8_stride);  // NOLINT
     Dtype* output_ptr = output + ni * out_n_stride;
     const int16_t* weight_ptr = weight;
     LITE_PARALLEL_BEGIN(tbi, tid, block_count) {
@@ -499,6 +495,7 @@ void conv_compute_4x4_3x3_int8(const int8_t* input,
       int32_t* trans_tmp_output_data = g_trans_tmp_output_data + tid * 192;
       int32_t* trans_remain_tmp_output_data =
           g_trans_remain_tmp_output_data + tid * 128;
+      Dtype* trash_data = g_trash_data + tid * 8;
 #elif defined(ARM_WITH_OMP)
       int16_t* tmp_data =
           g_tmp_data +
@@ -510,12 +507,14 @@ void conv_compute_4x4_3x3_int8(const int8_t* input,
           g_trans_tmp_output_data + omp_get_thread_num() * 192;
       int32_t* trans_remain_tmp_output_data =
           g_trans_remain_tmp_output_data + omp_get_thread_num() * 128;
+      Dtype* trash_data = g_trash_data + omp_get_thread_num() * 8;
 #else
       int16_t* tmp_data = g_tmp_data;
       int16_t* trans_tmp_data = g_trans_tmp_data;
       int8_t* trans_remain_tmp_data = g_trans_remain_tmp_data;
       int32_t* trans_tmp_output_data = g_trans_tmp_output_data;
       int32_t* trans_remain_tmp_output_data = g_trans_remain_tmp_output_data;
+      Dtype* trash_data = g_trash_data;
 #endif
       int tile_index = tbi * tile_block;
       int tile_remain = size_tile - tile_index;
@@ -626,7 +625,8 @@ void conv_compute_4x4_3x3_int8(const int8_t* input,
 
       //*/
       //*
-      // output trans
+      // output trans, the tiles are requantized and written into the output
+      // directly, instead of the whole int32 output in c8.
       for (int ti = 0; ti < tile_count; ++ti) {
         int index = tile_index + ti;
 
@@ -636,76 +636,45 @@ void conv_compute_4x4_3x3_int8(const int8_t* input,
         int dst_x = tw_index * 4;
         int dst_y = th_index * 4;
 
-        int ex = dst_x + 4 > wout ? wout - dst_x : 4;
         int ey = dst_y + 4 > hout ? hout - dst_y : 4;
 
         int32_t* src_ptr = dst_temp_data + ti * 8;
-        int32_t* dst_ptr = output_c8 + (dst_y * wout + dst_x) * 8;
-        if (ex == 4) {
-          // trans output
-          for (int ci = 0; ci < oc_8; ++ci) {
-            int32_t* src_ci = src_ptr + ci * tile_count * 8;
-            int32_t* dst_ci = dst_ptr + ci * oc_8_stride;
-            for (int i = 0; i < 6; ++i) {
-              output_trans_c8_post_4x6_int8(src_ci + i * c_gi_stride * 6,
-                                            c_gi_stride,
-                                            trans_tmp_output_data + i * 8,
-                                            48);  // 6*c8=48
-            }
-            for (int i = 0; i < ey; ++i) {
-              output_trans_c8_post_4x6_int8(
-                  trans_tmp_output_data + i * 48, 8, dst_ci + i * wout * 8, 8);
-            }
+        for (int ci = 0; ci < oc_8; ++ci) {
+          int32_t* src_ci = src_ptr + ci * tile_count * 8;
+          for (int i = 0; i < 6; ++i) {
+            output_trans_c8_post_4x6_int8(src_ci + i * c_gi_stride * 6,
+                                          c_gi_stride,
+                                          trans_tmp_output_data + i * 8,
+                                          48);  // 6*c8=48
           }
-        } else {
-          for (int ci = 0; ci < oc_8; ++ci) {
-            // trans output
-            int32_t* src_ci = src_ptr + ci * tile_count * 8;
-            for (int i = 0; i < 6; ++i) {
-              output_trans_c8_post_4x6_int8(src_ci + i * c_gi_stride * 6,
-                                            c_gi_stride,
-                                            trans_tmp_output_data + i * 8,
-                                            48);
-            }
-            for (int i = 0; i < ey; ++i) {
-              output_trans_c8_post_4x6_int8(
-                  trans_tmp_output_data + i * 48,
-                  8,  // 4(4x4)*c8=32
-                  trans_remain_tmp_output_data + i * 32,
-                  8);
-            }
-            // copy to dest
-            int32_t* dst_ci = dst_ptr + ci * oc_8_stride;
-            for (int i = 0; i < ey; ++i) {
-              memcpy(dst_ci + i * wout * 8,                  // 8 is c8
-                     trans_remain_tmp_output_data + i * 32,  // 32=c8*4(4x4)
-                     ex * sizeof(int32_t) * 8);  // 4*sizeof(int32_t) * 8*4=512
-            }
+          for (int i = 0; i < ey; ++i) {
+            output_trans_c8_post_4x6_int8(trans_tmp_output_data + i * 48,
+                                          8,
+                                          trans_remain_tmp_output_data + i * 32,
+                                          8);  // 4(4x4)*c8=32
           }
+          write_int32_nchwc8_to_nchw(trans_remain_tmp_output_data,
+                                     output_ptr,
+                                     ci * 8,
+                                     ci * 8 + 8,
+                                     dst_y,
+                                     dst_y + 4,
+                                     dst_x,
+                                     dst_x + 4,
+                                     chout,
+                                     hout,
+                                     wout,
+                                     flag_act,
+                                     alpha,
+                                     bias + ci * 8,
+                                     flag_bias,
+                                     trash_data,
+                                     scale + ci * 8);
         }
       }
       //*/
     }  // for block_count
     LITE_PARALLEL_END();
-    for (int ci = 0; ci < oc_8; ++ci) {
-      write_int32_nchwc8_to_nchw(output_c8 + ci * oc_8_stride,
-                                 output_ptr,
-                                 ci * 8,
-                                 ci * 8 + 8,
-                                 0,
-                                 hout,
-                                 0,
-                                 wout,
-                                 chout,
-                                 hout,
-                                 wout,
-                                 flag_act,
-                                 alpha,
-                                 bias + ci * 8,
-                                 flag_bias,
-                                 zero_ptr,
-                                 scale + ci * 8);
-    }
   }  // for num
 }  // conv compute
 template void conv_compute_4x4_3x3_int8<int8_t>(
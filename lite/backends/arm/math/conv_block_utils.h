@@ -48,6 +48,13 @@ inline void trans_gemm_weights<PRECISION(kFP16)>(const Tensor& tin,
                                                  ARMContext* ctx) {}
 #endif
 
+// The bf16 weights are packed by bf16::trans_gemm_weights_bf16.
+template <>
+inline void trans_gemm_weights<PRECISION(kBF16)>(const Tensor& tin,
+                                                 Tensor& tout,  // NOLINT
+                                                 int group,
+                                                 ARMContext* ctx) {}
+
 template <>
 inline void trans_gemm_weights<PRECISION(kFloat)>(const Tensor& tin,
                                                   Tensor& tout,  // NOLINT
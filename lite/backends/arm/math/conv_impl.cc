@@ -646,14 +646,15 @@ void conv1x1s1_gemm_int8(const int8_t* i_data,
   const int n = oh * ow;
   const int k = ic / group;
   int hblock = get_hblock_int8(ctx);
-  int k_roundup = ROUNDUP(k, KBLOCK_INT8);
+  int k_roundup = ROUNDUP(k, get_kblock_int8(ctx));
   int m_roundup = ROUNDUP(m, hblock);
   int weights_size_per_group = m * k;
   if (n > 1 && m > 1) {
     weights_size_per_group = ((m_roundup * k_roundup + 15) / 16) * 16;
   }
   bool flag_relu = param.fuse_relu;
-  bool flag_bias = param.bias != nullptr;
+  // the bias may be folded by the kernel without param.bias
+  bool flag_bias = bias != nullptr;
   auto act_param = param.activation_param;
   //! use gemv when the output channel size = 1
   for (int b = 0; b < num; ++b) {
@@ -755,6 +756,23 @@ template void conv1x1s1_gemm_int8<float>(const int8_t* i_data,
                                          ARMContext* ctx,
                                          const float* scale);
 
+int im2col_band_rows(int kernel_h,
+                     int kernel_w,
+                     int k,
+                     int hout,
+                     int wout,
+                     int type_size,
+                     ARMContext* ctx) {
+  int64_t row_size = static_cast<int64_t>(k) * wout * type_size;
+  int64_t budget = ctx->llc_size();
+  // the small kernels keep the fast im2col of the whole input while it fits
+  if (kernel_h * kernel_w < 25 && row_size * hout <= 4 * budget) {
+    return hout;
+  }
+  int rows = static_cast<int>(budget / std::max<int64_t>(row_size, 1));
+  return std::min(std::max(rows, 1), hout);
+}
+
 /**
  * \brief convolution function for kernel size 3x3, stride size 2, gemm
  * implementation
@@ -787,6 +805,8 @@ void conv_im2col_gemm(const float* i_data,
   int hblock = get_hblock(ctx, m);
   int m_roundup = hblock * ((m + hblock - 1) / hblock);
   int weights_size_per_group = m * k;
+  int band_rows =
+      im2col_band_rows(kernel_h, kernel_w, k, oh, ow, sizeof(float), ctx);
 
   auto act_param = param.activation_param;
   if (n > 1 && m > 1) {
@@ -808,74 +828,97 @@ void conv_im2col_gemm(const float* i_data,
       const float* weights_group = weights + g * weights_size_per_group;
       const float* bias_group = bias + g * m;
       float* dB = tmp_work_space;
-      im2col<float>(din_group,
-                    chin_per_group,
-                    ih,
-                    win,
-                    kernel_h,
-                    kernel_w,
-                    paddings[0],
-                    paddings[1],
-                    paddings[2],
-                    paddings[3],
-                    param.strides[0],
-                    param.strides[1],
-                    dilations[0],
-                    dilations[1],
-                    dB);
-      if (n == 1) {
-        sgemv(weights_group,
-              dB,
-              dout_group,
-              false,
-              m,
-              k,
-              0.f,
-              flag_bias,
-              bias_group,
-              act_param,
-              ctx);
-      } else if (m == 1) {
+      for (int h = 0; h < oh; h += band_rows) {
+        int h_end = std::min(h + band_rows, oh);
+        int band_n = (h_end - h) * ow;
+        float* dout_band = dout_group + h * ow;
+        if (band_rows == oh) {
+          im2col<float>(din_group,
+                        chin_per_group,
+                        ih,
+                        win,
+                        kernel_h,
+                        kernel_w,
+                        paddings[0],
+                        paddings[1],
+                        paddings[2],
+                        paddings[3],
+                        param.strides[0],
+                        param.strides[1],
+                        dilations[0],
+                        dilations[1],
+                        dB);
+        } else {
+          im2col_rows<float>(din_group,
+                             chin_per_group,
+                             ih,
+                             win,
+                             kernel_h,
+                             kernel_w,
+                             paddings[0],
+                             paddings[2],
+                             param.strides[0],
+                             param.strides[1],
+                             dilations[0],
+                             dilations[1],
+                             ow,
+                             h,
+                             h_end,
+                             dB);
+        }
+        if (n == 1) {
+          sgemv(weights_group,
+                dB,
+                dout_band,
+                false,
+                m,
+                k,
+                0.f,
+                flag_bias,
+                bias_group,
+                act_param,
+                ctx);
+        } else if (m == 1) {
 #ifdef TARGET_IOS
-        float* bias_ptr = new float[n];
+          float* bias_ptr = new float[band_n];
 #else
-        float bias_ptr[n];   // NOLINT
+          float bias_ptr[band_n];  // NOLINT
 #endif
-        if (flag_bias) {
-          for (int i = 0; i < n; i++) {
-            bias_ptr[i] = bias_group[0];
+          if (flag_bias) {
+            for (int i = 0; i < band_n; i++) {
+              bias_ptr[i] = bias_group[0];
+            }
           }
-        }
-        sgemv(dB,
-              weights_group,
-              dout_group,
-              true,
-              n,
-              k,
-              0.f,
-              flag_bias,
-              bias_ptr,
-              act_param,
-              ctx);
+          sgemv(dB,
+                weights_group,
+                dout_band,
+                true,
+                band_n,
+                k,
+                0.f,
+                flag_bias,
+                bias_ptr,
+                act_param,
+                ctx);
 #ifdef TARGET_IOS
-        delete[] bias_ptr;
+          delete[] bias_ptr;
 #endif
-      } else {
-        int ldb = n;
-        sgemm_prepack(false,
-                      m,
-                      n,
-                      k,
-                      weights_group,
-                      dB,
-                      ldb,
-                      0.f,
-                      dout_group,
-                      n,
-                      bias_group,
-                      flag_bias,
-                      act_param,
-                      ctx);
+        } else {
+          sgemm_prepack(false,
+                        m,
+                        band_n,
+                        k,
+                        weights_group,
+                        dB,
+                        band_n,
+                        0.f,
+                        dout_band,
+                        n,
+                        bias_group,
+                        flag_bias,
+                        act_param,
+                        ctx);
+        }
       }
     }
   }
@@ -915,12 +958,13 @@ void conv_im2col_gemm_int8(const int8_t* i_data,
   int channel_size_out = ow * oh;
   int channel_size_in = win * ih;
   bool flag_relu = param.fuse_relu;
-  bool flag_bias = param.bias != nullptr;
+  // the bias may be folded by the kernel without param.bias
+  bool flag_bias = bias != nullptr;
 
   auto act_param = param.activation_param;
 
   int hblock = get_hblock_int8(ctx);
-  int k_roundup = ROUNDUP(k, KBLOCK_INT8);
+  int k_roundup = ROUNDUP(k, get_kblock_int8(ctx));
   int m_roundup = ROUNDUP(m, hblock);
   int weights_size_per_group = m * k;
   if (n > 1 && m > 1) {
@@ -930,6 +974,13 @@ void conv_im2col_gemm_int8(const int8_t* i_data,
   int8_t* tmp_work_space =
       ctx->workspace_data<int8_t>() + ctx->llc_size() / sizeof(int8_t);
 
+  // The int8 gemm writes the output rows of a band contiguously, they are
+  // computed behind the im2col of the band and copied to the output.
+  int band_rows =
+      im2col_band_rows(kernel_h, kernel_w, k, oh, ow, sizeof(int8_t), ctx);
+  Dtype* band_out = reinterpret_cast<Dtype*>(
+      tmp_work_space + ROUNDUP(k * band_rows * ow, 16));
+
   //! use gemv when the output channel size = 1
   for (int b = 0; b < num; ++b) {
     // dC
@@ -942,77 +993,119 @@ void conv_im2col_gemm_int8(const int8_t* i_data,
       const float* bias_group = bias + g * m;
       int8_t* dB = tmp_work_space;
       const float* scale_group = scale + g * m;
-      im2col<int8_t>(din_group,
-                     chin_per_group,
-                     ih,
-                     win,
-                     kernel_h,
-                     kernel_w,
-                     pad_h,
-                     paddings[1],
-                     pad_w,
-                     paddings[3],
-                     stride_h,
-                     stride_w,
-                     dila_h,
-                     dila_w,
-                     dB);
-      if (n == 1) {
-        gemv_int8(weights_group,
-                  dB,
-                  dout_group,
-                  false,
-                  m,
-                  k,
-                  scale_group,
-                  flag_bias,
-                  bias_group,
-                  act_param,
-                  ctx);
-      } else if (m == 1) {
+      for (int h = 0; h < oh; h += band_rows) {
+        int h_end = std::min(h + band_rows, oh);
+        int band_n = (h_end - h) * ow;
+        Dtype* dout_band = dout_group + h * ow;
+        if (band_rows == oh) {
+          im2col<int8_t>(din_group,
+                         chin_per_group,
+                         ih,
+                         win,
+                         kernel_h,
+                         kernel_w,
+                         pad_h,
+                         paddings[1],
+                         pad_w,
+                         paddings[3],
+                         stride_h,
+                         stride_w,
+                         dila_h,
+                         dila_w,
+                         dB);
+        } else {
+          im2col_rows<int8_t>(din_group,
+                              chin_per_group,
+                              ih,
+                              win,
+                              kernel_h,
+                              kernel_w,
+                              pad_h,
+                              pad_w,
+                              stride_h,
+                              stride_w,
+                              dila_h,
+                              dila_w,
+                              ow,
+                              h,
+                              h_end,
+                              dB);
+        }
+        if (n == 1) {
+          gemv_int8(weights_group,
+                    dB,
+                    dout_band,
+                    false,
+                    m,
+                    k,
+                    scale_group,
+                    flag_bias,
+                    bias_group,
+                    act_param,
+                    ctx);
+        } else if (m == 1) {
 #ifdef TARGET_IOS
-        float* bias_ptr = new float[n];
-        float* scale_ptr = new float[n];
+          float* bias_ptr = new float[band_n];
+          float* scale_ptr = new float[band_n];
 #else
-        float bias_ptr[n];   // NOLINT
-        float scale_ptr[n];  // NOLINT
+          float bias_ptr[band_n];   // NOLINT
+          float scale_ptr[band_n];  // NOLINT
 #endif
-        if (flag_bias) {
-          for (int i = 0; i < n; i++) {
-            bias_ptr[i] = bias_group[0];
+          if (flag_bias) {
+            for (int i = 0; i < band_n; i++) {
+              bias_ptr[i] = bias_group[0];
+            }
           }
-        }
-        for (int i = 0; i < n; i++) {
-          scale_ptr[i] = scale_group[0];
-        }
-        gemv_int8(dB,
-                  weights_group,
-                  dout_group,
-                  true,
-                  n,
-                  k,
-                  scale_ptr,
-                  flag_bias,
-                  bias_ptr,
-                  act_param,
-                  ctx);
+          for (int i = 0; i < band_n; i++) {
+            scale_ptr[i] = scale_group[0];
+          }
+          gemv_int8(dB,
+                    weights_group,
+                    dout_band,
+                    true,
+                    band_n,
+                    k,
+                    scale_ptr,
+                    flag_bias,
+                    bias_ptr,
+                    act_param,
+                    ctx);
 #ifdef TARGET_IOS
-        delete[] bias_ptr;
-        delete[] scale_ptr;
+          delete[] bias_ptr;
+          delete[] scale_ptr;
 #endif
-      } else {
-        gemm_prepack_int8(weights_group,
-                          dB,
-                          bias_group,
-                          dout_group,
-                          m,
-                          n,
-                          k,
-                          flag_bias,
-                          false,
-                          scale_group,
-                          act_param,
-                          ctx);
+        } else if (band_rows == oh) {
+          gemm_prepack_int8(weights_group,
+                            dB,
+                            bias_group,
+                            dout_band,
+                            m,
+                            n,
+                            k,
+                            flag_bias,
+                            false,
+                            scale_group,
+                            act_param,
+                            ctx);
+        } else {
+          gemm_prepack_int8(weights_group,
+                            dB,
+                            bias_group,
+                            band_out,
+                            m,
+                            band_n,
+                            k,
+                            flag_bias,
+                            false,
+                            scale_group,
+                            act_param,
+                            ctx);
+          for (int i = 0; i < m; ++i) {
+            memcpy(dout_band + i * n,
+                   band_out + i * band_n,
+                   band_n * sizeof(Dtype));
+          }
+        }
       }
     }
   }
@@ -14,7 +14,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
 #include "lite/core/context.h"
+#include "lite/core/parallel_defines.h"
 #include "lite/core/target_wrapper.h"
 #include "lite/operators/op_params.h"
 
@@ -394,6 +397,77 @@ void im2col_s2(const Dtype* data_im,
                int dilation_h,
                int dilation_w,
                Dtype* data_col);
+
+// The output rows of each im2col of the gemm-like conv. The conv with the
+// large kernel (5x5, 7x7), or whose im2col is several times the last level
+// cache, is computed by the bands of output rows whose im2col fits the cache,
+// instead of the im2col of the whole input which is kernel_h * kernel_w times
+// its size.
+int im2col_band_rows(int kernel_h,
+                     int kernel_w,
+                     int k,
+                     int hout,
+                     int wout,
+                     int type_size,
+                     ARMContext* ctx);
+
+// im2col of the output rows [row_begin, row_end) of the conv, which are
+// computed by the gemm with N = (row_end - row_begin) * output_w.
+template <typename Dtype>
+void im2col_rows(const Dtype* data_im,
+                 int channels,
+                 int height,
+                 int width,
+                 int kernel_h,
+                 int kernel_w,
+                 int pad_top,
+                 int pad_left,
+                 int stride_h,
+                 int stride_w,
+                 int dilation_h,
+                 int dilation_w,
+                 int output_w,
+                 int row_begin,
+                 int row_end,
+                 Dtype* data_col) {
+  const int col_size = (row_end - row_begin) * output_w;
+  LITE_PARALLEL_BEGIN(c, tid, channels) {
+    const Dtype* im = data_im + c * height * width;
+    Dtype* col = data_col + c * kernel_h * kernel_w * col_size;
+    for (int kr = 0; kr < kernel_h; ++kr) {
+      for (int kc = 0; kc < kernel_w; ++kc) {
+        // the output cols [ow_begin, ow_end) read inside the input row
+        int offset = kc * dilation_w - pad_left;
+        int ow_begin = offset >= 0 ? 0 : (stride_w - 1 - offset) / stride_w;
+        int ow_end = width > offset
+                         ? (width - offset + stride_w - 1) / stride_w
+                         : 0;
+        ow_begin = std::min(ow_begin, output_w);
+        ow_end = std::max(std::min(ow_end, output_w), ow_begin);
+        for (int oy = row_begin; oy < row_end; ++oy, col += output_w) {
+          int iy = oy * stride_h - pad_top + kr * dilation_h;
+          if (iy < 0 || iy >= height) {
+            memset(col, 0, output_w * sizeof(Dtype));
+            continue;
+          }
+          const Dtype* row = im + iy * width;
+          memset(col, 0, ow_begin * sizeof(Dtype));
+          if (stride_w == 1) {
+            memcpy(col + ow_begin,
+                   row + offset + ow_begin,
+                   (ow_end - ow_begin) * sizeof(Dtype));
+          } else {
+            for (int ox = ow_begin; ox < ow_end; ++ox) {
+              col[ox] = row[ox * stride_w + offset];
+            }
+          }
+          memset(col + ow_end, 0, (output_w - ow_end) * sizeof(Dtype));
+        }
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
 }  // namespace math
 }  // namespace arm
 }  // namespace lite
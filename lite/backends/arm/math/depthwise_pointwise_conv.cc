@@ -0,0 +1,128 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/depthwise_pointwise_conv.h"
+#include <arm_neon.h>
+#include <algorithm>
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+static void act_rows(float* dout,
+                     int size,
+                     const operators::ActivationParam& act_param) {
+  int i = 0;
+  float32x4_t vzero = vdupq_n_f32(0.f);
+  switch (act_param.active_type) {
+    case lite_api::ActivationType::kRelu:
+      for (; i + 3 < size; i += 4) {
+        vst1q_f32(dout + i, vmaxq_f32(vld1q_f32(dout + i), vzero));
+      }
+      for (; i < size; ++i) dout[i] = std::max(dout[i], 0.f);
+      break;
+    case lite_api::ActivationType::kRelu6: {
+      const float six = act_param.Relu_clipped_coef;
+      float32x4_t vsix = vdupq_n_f32(six);
+      for (; i + 3 < size; i += 4) {
+        float32x4_t v = vmaxq_f32(vld1q_f32(dout + i), vzero);
+        vst1q_f32(dout + i, vminq_f32(v, vsix));
+      }
+      for (; i < size; ++i) dout[i] = std::min(std::max(dout[i], 0.f), six);
+      break;
+    }
+    case lite_api::ActivationType::kLeakyRelu: {
+      const float alpha = act_param.Leaky_relu_alpha;
+      for (; i < size; ++i) {
+        dout[i] = dout[i] >= 0.f ? dout[i] : dout[i] * alpha;
+      }
+      break;
+    }
+    case lite_api::ActivationType::kHardSwish: {
+      const float scale = 1.f / act_param.hard_swish_scale;
+      const float offset = act_param.hard_swish_offset;
+      const float threshold = act_param.hard_swish_threshold;
+      for (; i < size; ++i) {
+        float v = std::min(std::max(dout[i] + offset, 0.f), threshold);
+        dout[i] = dout[i] * v * scale;
+      }
+      break;
+    }
+    default:
+      LOG(FATAL) << "unsupported activation of the fused depthwise conv: "
+                 << static_cast<int>(act_param.active_type);
+  }
+}
+
+void conv_depthwise_rows(const float* din,
+                         const float* weights,
+                         const float* bias,
+                         float* dout,
+                         int channel,
+                         int hin,
+                         int win,
+                         int wout,
+                         int row_begin,
+                         int row_end,
+                         int kh,
+                         int kw,
+                         const std::vector<int>& strides,
+                         const std::vector<int>& paddings,
+                         const std::vector<int>& dilations,
+                         const operators::ActivationParam& act_param) {
+  const int rows = row_end - row_begin;
+  const int sh = strides[0];
+  const int sw = strides[1];
+  LITE_PARALLEL_BEGIN(c, tid, channel) {
+    const float* in_c = din + static_cast<int64_t>(c) * hin * win;
+    const float* w_c = weights + c * kh * kw;
+    float* out_c = dout + static_cast<int64_t>(c) * rows * wout;
+    std::fill(out_c, out_c + rows * wout, bias ? bias[c] : 0.f);
+    for (int r = 0; r < rows; ++r) {
+      float* out = out_c + r * wout;
+      const int oy = row_begin + r;
+      for (int ky = 0; ky < kh; ++ky) {
+        const int iy = oy * sh - paddings[0] + ky * dilations[0];
+        if (iy < 0 || iy >= hin) continue;
+        const float* in = in_c + iy * win;
+        for (int kx = 0; kx < kw; ++kx) {
+          const float w = w_c[ky * kw + kx];
+          const int off = kx * dilations[1] - paddings[2];
+          // the outputs whose input ox * sw + off is inside the row
+          int ox0 = off >= 0 ? 0 : (-off + sw - 1) / sw;
+          int ox1 = win - off > 0 ? std::min(wout, (win - off + sw - 1) / sw)
+                                  : 0;
+          int ox = ox0;
+          if (sw == 1) {
+            const float* p = in + off;
+            for (; ox + 3 < ox1; ox += 4) {
+              vst1q_f32(out + ox,
+                        vmlaq_n_f32(vld1q_f32(out + ox), vld1q_f32(p + ox), w));
+            }
+          }
+          for (; ox < ox1; ++ox) out[ox] += in[ox * sw + off] * w;
+        }
+      }
+    }
+    if (act_param.has_active) act_rows(out_c, rows * wout, act_param);
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
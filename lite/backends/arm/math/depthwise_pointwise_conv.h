@@ -0,0 +1,50 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// Depthwise conv of the output rows [row_begin, row_end) of one NCHW image,
+// written to dout as a [channel, (row_end - row_begin) * wout] matrix, which
+// is the input of the following 1x1 conv gemm. The paddings are
+// {up, down, left, right}, only relu, relu6, leaky_relu and hard_swish are
+// supported as act_param.
+void conv_depthwise_rows(const float* din,
+                         const float* weights,
+                         const float* bias,
+                         float* dout,
+                         int channel,
+                         int hin,
+                         int win,
+                         int wout,
+                         int row_begin,
+                         int row_end,
+                         int kh,
+                         int kw,
+                         const std::vector<int>& strides,
+                         const std::vector<int>& paddings,
+                         const std::vector<int>& dilations,
+                         const operators::ActivationParam& act_param);
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -19,13 +19,41 @@
 #include "lite/backends/arm/math/elementwise_common_broadcast_config.h"
 #include "lite/backends/arm/math/elementwise_naive_impl.h"
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/core/device_info.h"
 #include "lite/core/parallel_defines.h"
+#if defined(__aarch64__) && defined(WITH_ARM_SVE)
+#include "lite/backends/arm/math/sve/funcs_sve.h"
+#endif
 
 namespace paddle {
 namespace lite {
 namespace arm {
 namespace math {
 
+#if defined(__aarch64__) && defined(WITH_ARM_SVE)
+// Split the same-shape elementwise op into the blocks run by the sve kernel
+// on the thread pool.
+static void elementwise_sve_compute(void (*kernel)(const float*,
+                                                   const float*,
+                                                   float*,
+                                                   int),
+                                    const float* dinx,
+                                    const float* diny,
+                                    float* dout,
+                                    int num) {
+  const int block = 4096;
+  int cnt = (num + block - 1) / block;
+  LITE_PARALLEL_BEGIN(i, tid, cnt) {
+    int offset = i * block;
+    kernel(dinx + offset,
+           diny + offset,
+           dout + offset,
+           std::min(block, num - offset));
+  }
+  LITE_PARALLEL_END();
+}
+#endif
+
 template <>
 void elementwise_add<int32_t>(const int32_t* dinx,
                               const int32_t* diny,
@@ -42,6 +70,12 @@ void elementwise_add<float>(const float* dinx,
                             const float* diny,
                             float* dout,
                             int num) {
+#if defined(__aarch64__) && defined(WITH_ARM_SVE)
+  if (DeviceInfo::Global().has_sve()) {
+    elementwise_sve_compute(sve::elementwise_add_sve, dinx, diny, dout, num);
+    return;
+  }
+#endif
   int cnt = num >> 4;
   int remain = num % 16;
   LITE_PARALLEL_BEGIN(i, tid, cnt) {
@@ -99,6 +133,13 @@ void elementwise_add_relu<float>(const float* dinx,
                                  const float* diny,
                                  float* dout,
                                  int num) {
+#if defined(__aarch64__) && defined(WITH_ARM_SVE)
+  if (DeviceInfo::Global().has_sve()) {
+    elementwise_sve_compute(
+        sve::elementwise_add_relu_sve, dinx, diny, dout, num);
+    return;
+  }
+#endif
   int cnt = num >> 4;
   int remain = num % 16;
   float32x4_t vzero = vdupq_n_f32(0.f);
@@ -526,6 +567,12 @@ void elementwise_sub<float>(const float* dinx,
                             const float* diny,
                             float* dout,
                             int num) {
+#if defined(__aarch64__) && defined(WITH_ARM_SVE)
+  if (DeviceInfo::Global().has_sve()) {
+    elementwise_sve_compute(sve::elementwise_sub_sve, dinx, diny, dout, num);
+    return;
+  }
+#endif
   int cnt = num >> 4;
   int remain = num % 16;
   LITE_PARALLEL_BEGIN(i, tid, cnt) {
@@ -572,6 +619,13 @@ void elementwise_sub_relu<float>(const float* dinx,
                                  const float* diny,
                                  float* dout,
                                  int num) {
+#if defined(__aarch64__) && defined(WITH_ARM_SVE)
+  if (DeviceInfo::Global().has_sve()) {
+    elementwise_sve_compute(
+        sve::elementwise_sub_relu_sve, dinx, diny, dout, num);
+    return;
+  }
+#endif
   int cnt = num >> 4;
   int remain = num % 16;
   float32x4_t vzero = vdupq_n_f32(0.f);
@@ -896,6 +950,12 @@ void elementwise_mul<float>(const float* dinx,
                             const float* diny,
                             float* dout,
                             int num) {
+#if defined(__aarch64__) && defined(WITH_ARM_SVE)
+  if (DeviceInfo::Global().has_sve()) {
+    elementwise_sve_compute(sve::elementwise_mul_sve, dinx, diny, dout, num);
+    return;
+  }
+#endif
   int cnt = num >> 4;
   int remain = num % 16;
   LITE_PARALLEL_BEGIN(i, tid, cnt) {
@@ -998,6 +1058,13 @@ void elementwise_mul_relu<float>(const float* dinx,
                                  const float* diny,
                                  float* dout,
                                  int num) {
+#if defined(__aarch64__) && defined(WITH_ARM_SVE)
+  if (DeviceInfo::Global().has_sve()) {
+    elementwise_sve_compute(
+        sve::elementwise_mul_relu_sve, dinx, diny, dout, num);
+    return;
+  }
+#endif
   int cnt = num >> 4;
   int remain = num % 16;
   float32x4_t vzero = vdupq_n_f32(0.f);
@@ -0,0 +1,254 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/elementwise_chain.h"
+#include <arm_neon.h>
+#include <algorithm>
+#include <cmath>
+#include "lite/backends/arm/math/funcs.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+using host::math::ChainOp;
+
+template <typename VFunc, typename Func>
+static void unary(const float* x, float* out, int n, VFunc vfunc, Func func) {
+  int i = 0;
+  for (; i + 7 < n; i += 8) {
+    float32x4_t v0 = vfunc(vld1q_f32(x + i));
+    float32x4_t v1 = vfunc(vld1q_f32(x + i + 4));
+    vst1q_f32(out + i, v0);
+    vst1q_f32(out + i + 4, v1);
+  }
+  for (; i + 3 < n; i += 4) {
+    vst1q_f32(out + i, vfunc(vld1q_f32(x + i)));
+  }
+  for (; i < n; ++i) out[i] = func(x[i]);
+}
+
+template <typename VFunc, typename Func>
+static void binary(
+    const float* x, const float* y, float* out, int n, VFunc vfunc, Func f) {
+  int i = 0;
+  for (; i + 7 < n; i += 8) {
+    float32x4_t v0 = vfunc(vld1q_f32(x + i), vld1q_f32(y + i));
+    float32x4_t v1 = vfunc(vld1q_f32(x + i + 4), vld1q_f32(y + i + 4));
+    vst1q_f32(out + i, v0);
+    vst1q_f32(out + i + 4, v1);
+  }
+  for (; i + 3 < n; i += 4) {
+    vst1q_f32(out + i, vfunc(vld1q_f32(x + i), vld1q_f32(y + i)));
+  }
+  for (; i < n; ++i) out[i] = f(x[i], y[i]);
+}
+
+static inline float32x4_t vsigmoid(float32x4_t x) {
+  return vactive_f32<lite_api::ActivationType::kSigmoid>(x);
+}
+
+static inline float sigmoid(float x) { return 1.f / (1.f + std::exp(-x)); }
+
+void elementwise_chain_step(const host::math::ElementwiseChainStep& step,
+                            const float* x,
+                            const float* y,
+                            float* out,
+                            int n) {
+  const float alpha = step.alpha;
+  const float beta = step.beta;
+  const float gamma = step.gamma;
+  const float32x4_t vzero = vdupq_n_f32(0.f);
+  const float32x4_t vone = vdupq_n_f32(1.f);
+  const float32x4_t valpha = vdupq_n_f32(alpha);
+  const float32x4_t vbeta = vdupq_n_f32(beta);
+  const float32x4_t vgamma = vdupq_n_f32(gamma);
+  switch (step.op) {
+    case ChainOp::kAdd:
+      binary(x,
+             y,
+             out,
+             n,
+             [](float32x4_t a, float32x4_t b) { return vaddq_f32(a, b); },
+             [](float a, float b) { return a + b; });
+      break;
+    case ChainOp::kSub:
+      binary(x,
+             y,
+             out,
+             n,
+             [](float32x4_t a, float32x4_t b) { return vsubq_f32(a, b); },
+             [](float a, float b) { return a - b; });
+      break;
+    case ChainOp::kMul:
+      binary(x,
+             y,
+             out,
+             n,
+             [](float32x4_t a, float32x4_t b) { return vmulq_f32(a, b); },
+             [](float a, float b) { return a * b; });
+      break;
+    case ChainOp::kDiv:
+      binary(x,
+             y,
+             out,
+             n,
+             [](float32x4_t a, float32x4_t b) {
+#ifdef __aarch64__
+               return vdivq_f32(a, b);
+#else
+               return div_ps(a, b);
+#endif
+             },
+             [](float a, float b) { return a / b; });
+      break;
+    case ChainOp::kMax:
+      binary(x,
+             y,
+             out,
+             n,
+             [](float32x4_t a, float32x4_t b) { return vmaxq_f32(a, b); },
+             [](float a, float b) { return std::max(a, b); });
+      break;
+    case ChainOp::kMin:
+      binary(x,
+             y,
+             out,
+             n,
+             [](float32x4_t a, float32x4_t b) { return vminq_f32(a, b); },
+             [](float a, float b) { return std::min(a, b); });
+      break;
+    case ChainOp::kRelu:
+      unary(x,
+            out,
+            n,
+            [=](float32x4_t a) { return vmaxq_f32(a, vzero); },
+            [](float a) { return std::max(a, 0.f); });
+      break;
+    case ChainOp::kRelu6:
+      unary(x,
+            out,
+            n,
+            [=](float32x4_t a) {
+              return vminq_f32(vmaxq_f32(a, vzero), valpha);
+            },
+            [=](float a) { return std::min(std::max(a, 0.f), alpha); });
+      break;
+    case ChainOp::kLeakyRelu:
+      unary(x,
+            out,
+            n,
+            [=](float32x4_t a) {
+              uint32x4_t mask = vcgeq_f32(a, vzero);
+              return vbslq_f32(mask, a, vmulq_f32(a, valpha));
+            },
+            [=](float a) { return a > 0.f ? a : a * alpha; });
+      break;
+    case ChainOp::kSigmoid:
+      unary(x, out, n, vsigmoid, sigmoid);
+      break;
+    case ChainOp::kTanh:
+      unary(x,
+            out,
+            n,
+            [](float32x4_t a) {
+              return vactive_f32<lite_api::ActivationType::kTanh>(a);
+            },
+            [](float a) { return std::tanh(a); });
+      break;
+    case ChainOp::kSwish:
+      unary(x,
+            out,
+            n,
+            [=](float32x4_t a) {
+              return vmulq_f32(a, vsigmoid(vmulq_f32(a, valpha)));
+            },
+            [=](float a) { return a * sigmoid(alpha * a); });
+      break;
+    case ChainOp::kHardSigmoid:
+      unary(x,
+            out,
+            n,
+            [=](float32x4_t a) {
+              float32x4_t v = vmlaq_f32(vbeta, a, valpha);
+              return vminq_f32(vmaxq_f32(v, vzero), vone);
+            },
+            [=](float a) {
+              return std::min(std::max(a * alpha + beta, 0.f), 1.f);
+            });
+      break;
+    case ChainOp::kHardSwish: {
+      const float32x4_t vscale = vdupq_n_f32(1.f / beta);
+      unary(x,
+            out,
+            n,
+            [=](float32x4_t a) {
+              float32x4_t v =
+                  vminq_f32(vmaxq_f32(vaddq_f32(a, vgamma), vzero), valpha);
+              return vmulq_f32(vmulq_f32(v, a), vscale);
+            },
+            [=](float a) {
+              return std::min(std::max(a + gamma, 0.f), alpha) * a / beta;
+            });
+      break;
+    }
+    case ChainOp::kExp:
+      unary(x,
+            out,
+            n,
+            [](float32x4_t a) { return exp_ps(a); },
+            [](float a) { return std::exp(a); });
+      break;
+    case ChainOp::kAbs:
+      unary(x,
+            out,
+            n,
+            [](float32x4_t a) { return vabsq_f32(a); },
+            [](float a) { return std::fabs(a); });
+      break;
+    case ChainOp::kSquare:
+      unary(x,
+            out,
+            n,
+            [](float32x4_t a) { return vmulq_f32(a, a); },
+            [](float a) { return a * a; });
+      break;
+    case ChainOp::kScale:
+      if (gamma != 0.f) {
+        unary(x,
+              out,
+              n,
+              [=](float32x4_t a) { return vmlaq_f32(vbeta, a, valpha); },
+              [=](float a) { return a * alpha + beta; });
+      } else {
+        unary(x,
+              out,
+              n,
+              [=](float32x4_t a) {
+                return vmulq_f32(vaddq_f32(a, vbeta), valpha);
+              },
+              [=](float a) { return (a + beta) * alpha; });
+      }
+      break;
+    default:
+      host::math::elementwise_chain_step(step, x, y, out, n);
+      break;
+  }
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,35 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "lite/backends/host/math/elementwise_chain.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// The NEON step of host::math::elementwise_chain, the ops without a NEON
+// loop fall back to host::math::elementwise_chain_step.
+void elementwise_chain_step(const host::math::ElementwiseChainStep& step,
+                            const float* x,
+                            const float* y,
+                            float* out,
+                            int n);
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -170,6 +170,89 @@ struct SubConfig<int32_t> : public BasicConfig<int32_t> {
   constexpr static auto neon_op = vsubq_s32;
 };
 
+template <>
+struct SubConfig<int64_t> : public BasicConfig<int64_t> {
+  constexpr static auto naive_op = naive_sub<int64_t>;
+  constexpr static auto neon_op = vsubq_s64;
+};
+
+template <>
+struct SubConfig<float> : public BasicConfig<float> {
+  constexpr static auto naive_op = naive_sub<float>;
+  constexpr static auto neon_op = vsubq_f32;
+};
+
+template <class T>
+struct MulConfig {};
+
+template <>
+struct MulConfig<int32_t> : public BasicConfig<int32_t> {
+  constexpr static auto naive_op = naive_mul<int32_t>;
+  constexpr static auto neon_op = vmulq_s32;
+};
+
+template <>
+struct MulConfig<float> : public BasicConfig<float> {
+  constexpr static auto naive_op = naive_mul<float>;
+  constexpr static auto neon_op = vmulq_f32;
+};
+
+template <class T>
+struct DivConfig {};
+
+#ifdef __aarch64__
+template <>
+struct DivConfig<float> : public BasicConfig<float> {
+  constexpr static auto naive_op = naive_div<float>;
+  constexpr static auto neon_op = vdivq_f32;
+};
+#endif
+
+template <class T>
+struct MaxConfig {};
+
+template <>
+struct MaxConfig<int32_t> : public BasicConfig<int32_t> {
+  constexpr static auto naive_op = naive_max<int32_t>;
+  constexpr static auto neon_op = vmaxq_s32;
+};
+
+template <>
+struct MaxConfig<float> : public BasicConfig<float> {
+  constexpr static auto naive_op = naive_max<float>;
+  constexpr static auto neon_op = vmaxq_f32;
+};
+
+template <class T>
+struct MinConfig {};
+
+template <>
+struct MinConfig<int32_t> : public BasicConfig<int32_t> {
+  constexpr static auto naive_op = naive_min<int32_t>;
+  constexpr static auto neon_op = vminq_s32;
+};
+
+template <>
+struct MinConfig<float> : public BasicConfig<float> {
+  constexpr static auto naive_op = naive_min<float>;
+  constexpr static auto neon_op = vminq_f32;
+};
+
+/**
+ * The op config without activation if it has a neon_op for DataType, else
+ * NullNeonConfig, which runs the naive code.
+ */
+template <class OpConfig, class DataType, class = void>
+struct NeonConfigOf {
+  using type = NullNeonConfig;
+};
+
+template <class OpConfig, class DataType>
+struct NeonConfigOf<OpConfig, DataType, decltype(void(OpConfig::neon_op))> {
+  using type =
+      MergeConfig<OpConfig, ActiveConfig<ActiveType::NO_ACTIVE, DataType>>;
+};
+
 #ifdef ENABLE_ARM_FP16
 static inline float16x8_t __attribute__((__always_inline__))
 neon_relu_fp16(const float16x8_t& a) {
@@ -200,9 +283,6 @@ struct AddConfig<float16_t> : public BasicConfig<float16_t> {
   constexpr static auto neon_op = vaddq_f16;
 };
 
-template <class T>
-struct MulConfig {};
-
 template <>
 struct MulConfig<float16_t> : public BasicConfig<float16_t> {
   constexpr static auto naive_op = naive_mul<float16_t>;
@@ -213,9 +293,6 @@ struct SubConfig<float16_t> : public BasicConfig<float16_t> {
   constexpr static auto naive_op = naive_sub<float16_t>;
   constexpr static auto neon_op = vsubq_f16;
 };
-template <class T>
-struct DivConfig {};
-
 template <>
 struct DivConfig<float16_t> : public BasicConfig<float16_t> {
   constexpr static auto naive_op = naive_div<float16_t>;
@@ -63,6 +63,11 @@ static inline T __attribute__((__always_inline__)) naive_max(T l, T r) {
   return l > r ? l : r;
 }
 
+template <typename T>
+static inline T __attribute__((__always_inline__)) naive_min(T l, T r) {
+  return l < r ? l : r;
+}
+
 template <typename T>
 static inline T __attribute__((__always_inline__)) naive_mod(T l, T r) {
   return l % r;
@@ -0,0 +1,124 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/embedding_dequant.h"
+#include <arm_neon.h>
+#include <cstring>
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// dout[0:16] (+)= vin * scale + bias
+static inline void dequant_u8x16(uint8x16_t vin,
+                                 float32x4_t vscale,
+                                 float32x4_t vbias,
+                                 float* dout,
+                                 bool accumulate) {
+  uint16x8_t vin_l = vmovl_u8(vget_low_u8(vin));
+  uint16x8_t vin_h = vmovl_u8(vget_high_u8(vin));
+  float32x4_t vin0 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(vin_l)));
+  float32x4_t vin1 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(vin_l)));
+  float32x4_t vin2 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(vin_h)));
+  float32x4_t vin3 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(vin_h)));
+  float32x4_t vout0 = vbias;
+  float32x4_t vout1 = vbias;
+  float32x4_t vout2 = vbias;
+  float32x4_t vout3 = vbias;
+  if (accumulate) {
+    vout0 = vaddq_f32(vld1q_f32(dout), vbias);
+    vout1 = vaddq_f32(vld1q_f32(dout + 4), vbias);
+    vout2 = vaddq_f32(vld1q_f32(dout + 8), vbias);
+    vout3 = vaddq_f32(vld1q_f32(dout + 12), vbias);
+  }
+  vst1q_f32(dout, vmlaq_f32(vout0, vin0, vscale));
+  vst1q_f32(dout + 4, vmlaq_f32(vout1, vin1, vscale));
+  vst1q_f32(dout + 8, vmlaq_f32(vout2, vin2, vscale));
+  vst1q_f32(dout + 12, vmlaq_f32(vout3, vin3, vscale));
+}
+
+void embedding_dequant_row(const float* row,
+                           float* dout,
+                           int64_t row_width,
+                           int quant_bits,
+                           bool accumulate) {
+  float scale = row[0];
+  float bias = row[1];
+  if (quant_bits == 0) {
+    // the same scale as lookup_table_dequant
+    scale = (row[1] - row[0]) / 256.f;
+    bias = row[0];
+  }
+  const uint8_t* codes = reinterpret_cast<const uint8_t*>(row + 2);
+  float32x4_t vscale = vdupq_n_f32(scale);
+  float32x4_t vbias = vdupq_n_f32(bias);
+  int64_t i = 0;
+  if (quant_bits == 4) {
+    uint8x8_t vmask = vdup_n_u8(0x0F);
+    for (; i + 15 < row_width; i += 16) {
+      uint8x8_t vin = vld1_u8(codes + (i >> 1));
+      // the low nibbles are the even elements
+      uint8x8x2_t vzip = vzip_u8(vand_u8(vin, vmask), vshr_n_u8(vin, 4));
+      dequant_u8x16(vcombine_u8(vzip.val[0], vzip.val[1]),
+                    vscale,
+                    vbias,
+                    dout + i,
+                    accumulate);
+    }
+    for (; i < row_width; i++) {
+      int code = (codes[i >> 1] >> ((i & 1) * 4)) & 0x0F;
+      float x = scale * code + bias;
+      dout[i] = accumulate ? dout[i] + x : x;
+    }
+  } else {
+    for (; i + 15 < row_width; i += 16) {
+      dequant_u8x16(
+          vld1q_u8(codes + i), vscale, vbias, dout + i, accumulate);
+    }
+    for (; i < row_width; i++) {
+      float x = scale * static_cast<int>(codes[i]) + bias;
+      dout[i] = accumulate ? dout[i] + x : x;
+    }
+  }
+}
+
+void embedding_dequant(const float* table,
+                       const int64_t* ids,
+                       float* dout,
+                       int64_t ids_numel,
+                       int64_t row_number,
+                       int64_t quant_number,
+                       int64_t row_width,
+                       int quant_bits,
+                       int64_t padding_idx) {
+  for (int64_t i = 0; i < ids_numel; i++) {
+    float* dout_ptr = dout + i * row_width;
+    if (padding_idx != -1 && ids[i] == padding_idx) {
+      memset(dout_ptr, 0, row_width * sizeof(float));
+      continue;
+    }
+    CHECK_LT(ids[i], row_number)
+        << "look uptable ids[i] < row_number check failed";
+    CHECK_GE(ids[i], 0) << "lookuptable ids[i] >= 0 check failed";
+    embedding_dequant_row(
+        table + ids[i] * quant_number, dout_ptr, row_width, quant_bits, false);
+  }
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
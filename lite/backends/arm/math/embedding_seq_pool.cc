@@ -0,0 +1,138 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/embedding_seq_pool.h"
+#include <arm_neon.h>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "lite/backends/arm/math/embedding_dequant.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// dout += din
+static void add_row(const float* din, float* dout, int64_t width) {
+  int64_t i = 0;
+  for (; i + 15 < width; i += 16) {
+    float32x4_t vout0 = vld1q_f32(dout + i);
+    float32x4_t vout1 = vld1q_f32(dout + i + 4);
+    float32x4_t vout2 = vld1q_f32(dout + i + 8);
+    float32x4_t vout3 = vld1q_f32(dout + i + 12);
+    vout0 = vaddq_f32(vout0, vld1q_f32(din + i));
+    vout1 = vaddq_f32(vout1, vld1q_f32(din + i + 4));
+    vout2 = vaddq_f32(vout2, vld1q_f32(din + i + 8));
+    vout3 = vaddq_f32(vout3, vld1q_f32(din + i + 12));
+    vst1q_f32(dout + i, vout0);
+    vst1q_f32(dout + i + 4, vout1);
+    vst1q_f32(dout + i + 8, vout2);
+    vst1q_f32(dout + i + 12, vout3);
+  }
+  for (; i + 3 < width; i += 4) {
+    vst1q_f32(dout + i, vaddq_f32(vld1q_f32(dout + i), vld1q_f32(din + i)));
+  }
+  for (; i < width; i++) {
+    dout[i] += din[i];
+  }
+}
+
+// scale the sums of a sequence of height rows for the pool type
+static void pool_row(float* dout,
+                     int64_t height,
+                     int64_t width,
+                     const std::string& pool_type,
+                     float pad_value) {
+  if (height == 0) {
+    for (int64_t i = 0; i < width; i++) {
+      dout[i] = pad_value;
+    }
+    return;
+  }
+  float scale = 1.f;
+  if (pool_type == "AVERAGE") {
+    scale = 1.f / height;
+  } else if (pool_type == "SQRT") {
+    scale = 1.f / std::sqrt(static_cast<float>(height));
+  }
+  if (scale == 1.f) return;
+  float32x4_t vscale = vdupq_n_f32(scale);
+  int64_t i = 0;
+  for (; i + 3 < width; i += 4) {
+    vst1q_f32(dout + i, vmulq_f32(vld1q_f32(dout + i), vscale));
+  }
+  for (; i < width; i++) {
+    dout[i] *= scale;
+  }
+}
+
+void embedding_seq_pool(const float* table,
+                        const int64_t* ids,
+                        float* dout,
+                        const std::vector<uint64_t>& lod,
+                        int64_t row_number,
+                        int64_t row_width,
+                        int64_t padding_idx,
+                        const std::string& pool_type,
+                        float pad_value) {
+  for (size_t i = 0; i + 1 < lod.size(); i++) {
+    float* dout_ptr = dout + i * row_width;
+    memset(dout_ptr, 0, row_width * sizeof(float));
+    for (uint64_t j = lod[i]; j < lod[i + 1]; j++) {
+      if (padding_idx != -1 && ids[j] == padding_idx) continue;
+      CHECK_LT(ids[j], row_number)
+          << "look uptable ids[i] < row_number check failed";
+      CHECK_GE(ids[j], 0) << "lookuptable ids[i] >= 0 check failed";
+      add_row(table + ids[j] * row_width, dout_ptr, row_width);
+    }
+    pool_row(dout_ptr, lod[i + 1] - lod[i], row_width, pool_type, pad_value);
+  }
+}
+
+void embedding_dequant_seq_pool(const float* table,
+                                const int64_t* ids,
+                                float* dout,
+                                const std::vector<uint64_t>& lod,
+                                int64_t row_number,
+                                int64_t quant_number,
+                                int64_t row_width,
+                                int quant_bits,
+                                int64_t padding_idx,
+                                const std::string& pool_type,
+                                float pad_value) {
+  for (size_t i = 0; i + 1 < lod.size(); i++) {
+    float* dout_ptr = dout + i * row_width;
+    memset(dout_ptr, 0, row_width * sizeof(float));
+    for (uint64_t j = lod[i]; j < lod[i + 1]; j++) {
+      if (padding_idx != -1 && ids[j] == padding_idx) continue;
+      CHECK_LT(ids[j], row_number)
+          << "look uptable ids[i] < row_number check failed";
+      CHECK_GE(ids[j], 0) << "lookuptable ids[i] >= 0 check failed";
+      embedding_dequant_row(table + ids[j] * quant_number,
+                            dout_ptr,
+                            row_width,
+                            quant_bits,
+                            true);
+    }
+    pool_row(dout_ptr, lod[i + 1] - lod[i], row_width, pool_type, pad_value);
+  }
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,55 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <string>
+#include <vector>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// Pool the rows of the table looked up by the ids of each sequence with
+// SUM, AVERAGE or SQRT, without writing out the rows. The rows of
+// padding_idx are zeros, and the empty sequences are pad_value.
+void embedding_seq_pool(const float* table,
+                        const int64_t* ids,
+                        float* dout,
+                        const std::vector<uint64_t>& lod,
+                        int64_t row_number,
+                        int64_t row_width,
+                        int64_t padding_idx,
+                        const std::string& pool_type,
+                        float pad_value);
+
+// The same for the tables of lookup_table_dequant of quant_bits, whose rows
+// are quant_number floats, see embedding_dequant_row.
+void embedding_dequant_seq_pool(const float* table,
+                                const int64_t* ids,
+                                float* dout,
+                                const std::vector<uint64_t>& lod,
+                                int64_t row_number,
+                                int64_t quant_number,
+                                int64_t row_width,
+                                int quant_bits,
+                                int64_t padding_idx,
+                                const std::string& pool_type,
+                                float pad_value);
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
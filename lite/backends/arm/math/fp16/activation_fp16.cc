@@ -14,7 +14,9 @@
 
 #include "lite/backends/arm/math/fp16/activation_fp16.h"
 #include <algorithm>
+#include <cstring>
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
+#include "lite/core/fast_math.h"
 #include "lite/core/parallel_defines.h"
 
 namespace paddle {
@@ -326,6 +328,31 @@ void act_tanh<float16_t>(const float16_t* din,
                          float16_t* dout,
                          int size,
                          int threads) {
+  if (FastMath::Enabled()) {
+    // tanh_ps_fast in fp32 is well below the fp16 precision
+    int cnt = size >> 3;
+    int remain = size & 7;
+    auto tanh_f16 = [](float16x8_t x) {
+      float32x4_t lo = tanh_ps_fast(vcvt_f32_f16(vget_low_f16(x)));
+      float32x4_t hi = tanh_ps_fast(vcvt_f32_f16(vget_high_f16(x)));
+      return vcombine_f16(vcvt_f16_f32(lo), vcvt_f16_f32(hi));
+    };
+    int cnt_per_thread = (cnt + threads - 1) / threads;
+    LITE_PARALLEL_BEGIN(i, tid, threads) {
+      int end = std::min(cnt, (i + 1) * cnt_per_thread);
+      for (int k = i * cnt_per_thread; k < end; ++k) {
+        vst1q_f16(dout + 8 * k, tanh_f16(vld1q_f16(din + 8 * k)));
+      }
+    }
+    LITE_PARALLEL_END();
+    if (remain > 0) {
+      float16_t buf[8] = {0.f};
+      memcpy(buf, din + size - remain, remain * sizeof(float16_t));
+      vst1q_f16(buf, tanh_f16(vld1q_f16(buf)));
+      memcpy(dout + size - remain, buf, remain * sizeof(float16_t));
+    }
+    return;
+  }
   int nums_per_thread = size / threads;
   int remain = size - threads * nums_per_thread;
   int neon_loop_cnt_dim8 = nums_per_thread >> 3;
@@ -48,10 +48,22 @@ void output_trans_c8_post_4x6_fp16(const float16_t* src,
                                    int src_stride,
                                    float16_t* dest,
                                    int dest_stride);
+
+void input_trans_c8_8x8_fp16(const float16_t* src,
+                             int src_stride,
+                             float16_t* dest,
+                             int dest_stride);
+
+void output_trans_c8_post_6x8_fp16(const float16_t* src,
+                                   int src_stride,
+                                   float16_t* dest,
+                                   int dest_stride);
 void weight_trans_c8_4x4_fp16(
     float16_t* dest, const float16_t* src, int ic, int oc, void* workspace);
 void weight_trans_c8_6x6_fp16(
     float16_t* dest, const float16_t* src, int ic, int oc, void* workspace);
+void weight_trans_c8_8x8_fp16(
+    float16_t* dest, const float16_t* src, int ic, int oc, void* workspace);
 // F(2,3)
 void conv_compute_2x2_3x3_fp16(const float16_t* input,
                                float16_t* output,
@@ -605,6 +617,230 @@ void conv_compute_4x4_3x3_fp16(const float16_t* input,
   }  // for num
 }  // conv_compute
 
+// F(6,3)
+void conv_compute_6x6_3x3_fp16(const float16_t* input,
+                               float16_t* output,
+                               int num,
+                               int chout,
+                               int hout,
+                               int wout,
+                               int chin,
+                               int hin,
+                               int win,
+                               const float16_t* weight,
+                               const float16_t* bias,
+                               const operators::ConvParam& param,
+                               ARMContext* ctx) {
+  auto act_param = param.activation_param;
+  const int pad_h0 = (*param.paddings)[0];
+  const int pad_h1 = (*param.paddings)[1];
+  const int pad_w0 = (*param.paddings)[2];
+  const int pad_w1 = (*param.paddings)[3];
+  float16_t* tmp_work_space =
+      ctx->workspace_data<float16_t>() + ctx->llc_size() / sizeof(float16_t);
+
+  int in_n_stride = chin * hin * win;
+  int out_n_stride = chout * hout * wout;
+  int ic_8 = (chin + 7) / 8;   // up_div c8
+  int oc_8 = (chout + 7) / 8;  // up_div c8
+
+  int tile_w = (wout + 5) / 6;  // up_div out_w 6x6
+  int tile_h = (hout + 5) / 6;  // up_div out_h 6x6
+  int size_tile = tile_h * tile_w;
+
+  int w_pad = win + pad_w0 + pad_w1;
+  int h_pad = hin + pad_h0 + pad_h1;
+
+  const int zero_len = (w_pad + 7) / 8 * 8;  // up_div in_w_pad 8x8
+  float16_t zero_ptr[zero_len];              // NOLINT
+  memset(zero_ptr, 0, zero_len * sizeof(float16_t));
+
+  float16_t* input_c8 = tmp_work_space;  // input_c8 for input layout transform
+  int new_h_stride = w_pad * 8;          // 8 is c8
+  int new_c_stride = new_h_stride * h_pad;  // in stride w_pad*h_pad*8
+
+  int ic_8_stride = w_pad * h_pad * 8;
+
+  int tile_block = 8;
+  int block_count = (size_tile + tile_block - 1) / tile_block;
+
+  int threads = ctx->threads();
+
+  float16_t* g_tmp_data = tmp_work_space + ic_8 * ic_8_stride;
+  int tmp_input_thread_stride = tile_block * ic_8 * 512;  // 8*8*8=512
+  int tmp_output_thread_stride = tile_block * oc_8 * 512;
+  int tmp_data_thread_stride =
+      tmp_input_thread_stride + tmp_output_thread_stride;
+  memset(g_tmp_data, 0, threads * tmp_data_thread_stride * sizeof(float16_t));
+  float16_t* g_trans_tmp_data = g_tmp_data + threads * tmp_data_thread_stride;
+  float16_t* g_trans_remain_tmp_data = g_trans_tmp_data + threads * 512;
+  auto act_type = act_param.active_type;
+  float16_t local_alpha = 0.f;
+  bool flag_bias = (bias != nullptr);
+  int flag_act = 0x00;  // relu: 1, relu6: 2, leakey: 3
+  float16_t offset = 0.f;
+  float16_t threshold = 6.f;
+
+  if (act_param.has_active) {
+    act_acquire(act_type, flag_act, local_alpha, offset, threshold, act_param);
+  }
+
+  // begin compute
+  for (int ni = 0; ni < num; ++ni) {
+    // trans input to c8
+    for (int i = 0; i < ic_8; ++i) {
+      prepack_input_nxwc8_fp16_dw(input + ni * in_n_stride,
+                                  input_c8 + i * new_c_stride,
+                                  i * 8,
+                                  -pad_h0,
+                                  hin + pad_h1,
+                                  -pad_w0,
+                                  win + pad_w1,
+                                  chin,
+                                  win,
+                                  hin,
+                                  zero_ptr);
+    }
+    float16_t* output_ptr = output + ni * out_n_stride;
+
+    LITE_PARALLEL_BEGIN(tbi, tid, block_count) {
+#ifdef LITE_USE_THREAD_POOL
+      float16_t* tmp_data = g_tmp_data + tid * tmp_data_thread_stride;
+      float16_t* trans_tmp_data = g_trans_tmp_data + tid * 512;
+      float16_t* trans_remain_tmp_data = g_trans_remain_tmp_data + tid * 512;
+#elif ARM_WITH_OMP
+      float16_t* tmp_data =
+          g_tmp_data + omp_get_thread_num() * tmp_data_thread_stride;
+      float16_t* trans_tmp_data = g_trans_tmp_data + omp_get_thread_num() * 512;
+      float16_t* trans_remain_tmp_data =
+          g_trans_remain_tmp_data + omp_get_thread_num() * 512;
+#else
+      float16_t* tmp_data = g_tmp_data;
+      float16_t* trans_tmp_data = g_trans_tmp_data;
+      float16_t* trans_remain_tmp_data = g_trans_remain_tmp_data;
+#endif
+      int tile_index = tbi * tile_block;
+      int tile_remain = size_tile - tile_index;
+      int tile_count = tile_remain > tile_block ? tile_block : tile_remain;
+      // input trans
+      int c_gi_stride = tile_count * oc_8 * 8;
+      int b_gi_stride = tile_count * ic_8 * 8;
+      for (int ti = 0; ti < tile_count; ++ti) {
+        int index = tile_index + ti;
+
+        int tw_index = index % tile_w;
+        int th_index = index / tile_w;
+
+        int src_x = tw_index * 6;
+        int src_y = th_index * 6;
+        int ex = src_x + 8 > w_pad ? w_pad - src_x : 8;
+        int ey = src_y + 8 > h_pad ? h_pad - src_y : 8;
+        float16_t* dst_ptr = tmp_data + ti * 8;
+        const float16_t* src_ptr = input_c8 + (src_y * w_pad + src_x) * 8;
+
+        for (int ci = 0; ci < ic_8; ++ci) {
+          const float16_t* src_ci = src_ptr + ci * ic_8_stride;
+          int src_h_stride = w_pad * 8;
+          if (ex != 8 || ey != 8) {
+            // pad the remain tile with zero
+            memset(trans_remain_tmp_data, 0, 512 * sizeof(float16_t));
+            if (ex > 0) {
+              for (int yi = 0; yi < ey; ++yi) {
+                memcpy(trans_remain_tmp_data + yi * 64,  // 64=8(8x8)*c8
+                       src_ci + w_pad * yi * 8,
+                       ex * sizeof(float16_t) * 8);
+              }
+            }
+            src_ci = trans_remain_tmp_data;
+            src_h_stride = 64;
+          }
+          for (int i = 0; i < 8; ++i) {
+            input_trans_c8_8x8_fp16(
+                src_ci + i * src_h_stride, 8, trans_tmp_data + i * 8, 64);
+          }
+          float16_t* dst_ci = dst_ptr + ci * tile_count * 8;
+          for (int i = 0; i < 8; ++i) {
+            input_trans_c8_8x8_fp16(trans_tmp_data + i * 64,
+                                    8,
+                                    dst_ci + i * b_gi_stride * 8,
+                                    b_gi_stride);
+          }
+        }
+      }
+      // input trans end
+      // begin compute
+      float16_t* dst_temp_data = tmp_data + tmp_input_thread_stride;
+      float16_t* b_ptr = tmp_data;
+      int w_gi_stride = ic_8 * oc_8 * 64;
+      for (int gi = 0; gi < 64; ++gi) {
+        float16_t* origin_C = dst_temp_data + gi * c_gi_stride;
+        float16_t* origin_B = b_ptr + gi * b_gi_stride;
+        const float16_t* origin_A = weight + gi * w_gi_stride;
+        gemm_prepack_c8_fp16_small(
+            oc_8 * 8, tile_count, ic_8 * 8, origin_A, origin_B, origin_C, ctx);
+      }
+      // output trans
+      for (int ti = 0; ti < tile_count; ++ti) {
+        int index = tile_index + ti;
+
+        int tw_index = index % tile_w;
+        int th_index = index / tile_w;
+
+        int dst_x = tw_index * 6;
+        int dst_y = th_index * 6;
+
+        int ex = dst_x + 6 > wout ? wout - dst_x : 6;
+        int ey = dst_y + 6 > hout ? hout - dst_y : 6;
+
+        float16_t* src_ptr = dst_temp_data + ti * 8;
+        for (int ci = 0; ci < oc_8; ++ci) {
+          float16_t* src_ci = src_ptr + ci * tile_count * 8;
+          for (int i = 0; i < 8; ++i) {
+            output_trans_c8_post_6x8_fp16(src_ci + i * c_gi_stride * 8,
+                                          c_gi_stride,
+                                          trans_tmp_data + i * 8,
+                                          64);  // 8*c8=64
+          }
+          for (int i = 0; i < ey; ++i) {
+            output_trans_c8_post_6x8_fp16(trans_tmp_data + i * 64,
+                                          8,
+                                          trans_remain_tmp_data + i * 48,
+                                          8);  // 6(6x6)*c8=48
+          }
+          float16_t* out_tile = trans_remain_tmp_data;
+          if (ex != 6) {
+            // copy to dest
+            for (int i = 0; i < ey; ++i) {
+              memcpy(trans_tmp_data + i * ex * 8,
+                     trans_remain_tmp_data + i * 48,
+                     ex * sizeof(float16_t) * 8);
+            }
+            out_tile = trans_tmp_data;
+          }
+          write_to_oc8_fp16(out_tile,
+                            output_ptr,
+                            ci * 8,
+                            ci * 8 + 8,
+                            dst_y,
+                            dst_y + ey,
+                            dst_x,
+                            dst_x + ex,
+                            chout,
+                            hout,
+                            wout,
+                            flag_act,
+                            local_alpha,
+                            bias + ci * 8,
+                            flag_bias,
+                            offset,
+                            threshold);
+        }
+      }
+    }  // for block_count
+    LITE_PARALLEL_END();
+  }  // for num
+}  // conv_compute
+
 // BT=[1, 0, -1, 0,
 //    0, 1,  1, 0,
 //    0, -1, 1, 0,
@@ -736,6 +972,71 @@ void input_trans_c8_6x6_fp16(const float16_t* src,
   vst1q_f16(dest + dest_stride * 5, dst5);
 }
 
+/*
+BT = [
+   1    0     -21/4   0     -21/4     0     -1  0
+   0    1     1     -17/4   -17/4     1     1   0
+   0    -1    1     17/4    -17/4     -1    1   0
+   0    1/2   1/4   -5/2    -5/4      2     1   0
+   0    -1/2  1/4   5/2     -5/4      -2    1   0
+   0    2     4   -5/2      -5        1/2   1   0
+   0    -2    4     5/2     -5        -1/2  1   0
+   0    -1    0     21/4    0         -21/4 0   1
+]
+*/
+void input_trans_c8_8x8_fp16(const float16_t* src,
+                             int src_stride,
+                             float16_t* dest,
+                             int dest_stride) {
+  float16x8_t src0 = vld1q_f16(src);
+  float16x8_t src1 = vld1q_f16(src + src_stride);
+  float16x8_t src2 = vld1q_f16(src + src_stride * 2);
+  float16x8_t src3 = vld1q_f16(src + src_stride * 3);
+  float16x8_t src4 = vld1q_f16(src + src_stride * 4);
+  float16x8_t src5 = vld1q_f16(src + src_stride * 5);
+  float16x8_t src6 = vld1q_f16(src + src_stride * 6);
+  float16x8_t src7 = vld1q_f16(src + src_stride * 7);
+
+  // take the differences first so the 21/4 and 17/4 terms cancel before
+  // being scaled, which keeps the intermediates small in half precision
+  float16x8_t dst0 = vaddq_f16(vsubq_f16(src0, src6),
+                               vmulq_n_f16(vsubq_f16(src4, src2), 5.25f));
+  float16x8_t dst7 = vaddq_f16(vsubq_f16(src7, src1),
+                               vmulq_n_f16(vsubq_f16(src3, src5), 5.25f));
+
+  float16x8_t tmp12a =
+      vsubq_f16(vaddq_f16(src2, src6), vmulq_n_f16(src4, 4.25f));
+  float16x8_t tmp12b =
+      vsubq_f16(vaddq_f16(src1, src5), vmulq_n_f16(src3, 4.25f));
+  float16x8_t dst1 = vaddq_f16(tmp12a, tmp12b);
+  float16x8_t dst2 = vsubq_f16(tmp12a, tmp12b);
+
+  float16x8_t tmp34a = vsubq_f16(vaddq_f16(src6, vmulq_n_f16(src2, 0.25f)),
+                                 vmulq_n_f16(src4, 1.25f));
+  float16x8_t tmp34b =
+      vaddq_f16(vsubq_f16(vmulq_n_f16(src1, 0.5f), vmulq_n_f16(src3, 2.5f)),
+                vmulq_n_f16(src5, 2.f));
+  float16x8_t dst3 = vaddq_f16(tmp34a, tmp34b);
+  float16x8_t dst4 = vsubq_f16(tmp34a, tmp34b);
+
+  float16x8_t tmp56a = vaddq_f16(
+      src6, vmulq_n_f16(vsubq_f16(src2, vmulq_n_f16(src4, 1.25f)), 4.f));
+  float16x8_t tmp56b =
+      vaddq_f16(vsubq_f16(vmulq_n_f16(src1, 2.f), vmulq_n_f16(src3, 2.5f)),
+                vmulq_n_f16(src5, 0.5f));
+  float16x8_t dst5 = vaddq_f16(tmp56a, tmp56b);
+  float16x8_t dst6 = vsubq_f16(tmp56a, tmp56b);
+
+  vst1q_f16(dest, dst0);
+  vst1q_f16(dest + dest_stride, dst1);
+  vst1q_f16(dest + dest_stride * 2, dst2);
+  vst1q_f16(dest + dest_stride * 3, dst3);
+  vst1q_f16(dest + dest_stride * 4, dst4);
+  vst1q_f16(dest + dest_stride * 5, dst5);
+  vst1q_f16(dest + dest_stride * 6, dst6);
+  vst1q_f16(dest + dest_stride * 7, dst7);
+}
+
 // AT=[1, 1,  1,  0,
 //    0, 1, -1, -1]
 void output_trans_c8_post_2x4_fp16(const float16_t* src,
@@ -821,9 +1122,66 @@ void output_trans_c8_post_4x6_fp16(const float16_t* src,
   vst1q_f16(dest + dest_stride * 3, dest3);
 }
 
+/*
+AT = [
+    1   1   1   1   1   1     1     0
+    0   1   -1  2   -2  1/2   -1/2  0
+    0   1   1   4   4   1/4   1/4   0
+    0   1   -1  8   -8  1/8   -1/8  0
+    0   1   1   16  16  1/16  1/16  0
+    0   1   -1  32  -32 1/32  -1/32 1
+]
+*/
+void output_trans_c8_post_6x8_fp16(const float16_t* src,
+                                   int src_stride,
+                                   float16_t* dest,
+                                   int dest_stride) {
+  const float16x8_t src0 = vld1q_f16(src);
+  const float16x8_t src1 = vld1q_f16(src + src_stride);
+  const float16x8_t src2 = vld1q_f16(src + src_stride * 2);
+  const float16x8_t src3 = vld1q_f16(src + src_stride * 3);
+  const float16x8_t src4 = vld1q_f16(src + src_stride * 4);
+  const float16x8_t src5 = vld1q_f16(src + src_stride * 5);
+  const float16x8_t src6 = vld1q_f16(src + src_stride * 6);
+  const float16x8_t src7 = vld1q_f16(src + src_stride * 7);
+
+  float16x8_t tmp024a = vaddq_f16(src1, src2);
+  float16x8_t tmp135a = vsubq_f16(src1, src2);
+  float16x8_t tmp024b = vaddq_f16(src3, src4);
+  float16x8_t tmp135b = vsubq_f16(src3, src4);
+  float16x8_t tmp024c = vaddq_f16(src5, src6);
+  float16x8_t tmp135c = vsubq_f16(src5, src6);
+
+  float16x8_t dest0 =
+      vaddq_f16(vaddq_f16(vaddq_f16(src0, tmp024a), tmp024b), tmp024c);
+  float16x8_t dest2 = vaddq_f16(vaddq_f16(tmp024a, vmulq_n_f16(tmp024b, 4.f)),
+                                vmulq_n_f16(tmp024c, 0.25f));
+  float16x8_t dest4 =
+      vaddq_f16(vaddq_f16(tmp024a, vmulq_n_f16(tmp024b, 16.f)),
+                vmulq_n_f16(tmp024c, 0.0625f));
+
+  float16x8_t dest1 = vaddq_f16(vaddq_f16(tmp135a, vmulq_n_f16(tmp135b, 2.f)),
+                                vmulq_n_f16(tmp135c, 0.5f));
+  float16x8_t dest3 = vaddq_f16(vaddq_f16(tmp135a, vmulq_n_f16(tmp135b, 8.f)),
+                                vmulq_n_f16(tmp135c, 0.125f));
+  float16x8_t dest5 =
+      vaddq_f16(src7,
+                vaddq_f16(vaddq_f16(tmp135a, vmulq_n_f16(tmp135b, 32.f)),
+                          vmulq_n_f16(tmp135c, 0.03125f)));
+
+  vst1q_f16(dest, dest0);
+  vst1q_f16(dest + dest_stride, dest1);
+  vst1q_f16(dest + dest_stride * 2, dest2);
+  vst1q_f16(dest + dest_stride * 3, dest3);
+  vst1q_f16(dest + dest_stride * 4, dest4);
+  vst1q_f16(dest + dest_stride * 5, dest5);
+}
+
+// the transform is accumulated in fp32 and rounded to fp16 once, the
+// F(6,3) coefficients such as 1/90 lose too much precision otherwise
 void weights_trans_c8_fp16(float16_t* dest,
                            const float16_t* din,
-                           const float16_t (*coeff)[3],
+                           const float (*coeff)[3],
                            int num,
                            int ch_in,
                            int ch_out,
@@ -842,7 +1200,7 @@ void weights_trans_c8_fp16(float16_t* dest,
       const float16_t* k2 = kernel0 + 6;
 
       //! h
-      float16_t tmp[num][3];
+      float tmp[num][3];  // NOLINT
       for (int i = 0; i < num; i++) {
         tmp[i][0] =
             k0[0] * coeff[i][0] + k0[1] * coeff[i][1] + k0[2] * coeff[i][2];
@@ -854,7 +1212,7 @@ void weights_trans_c8_fp16(float16_t* dest,
 
       //! v
       for (int j = 0; j < num; j++) {
-        float16_t* tmpp = &tmp[j][0];
+        float* tmpp = &tmp[j][0];
         for (int i = 0; i < num; i++) {
           ptr_channel[j * num + i] = tmpp[0] * coeff[i][0] +
                                      tmpp[1] * coeff[i][1] +
@@ -880,6 +1238,25 @@ void weights_trans_c8_fp16(float16_t* dest,
     dest[dest_ind] = ptr_out[i];
   }
 }
+// Input weight Layout: K*C*R*R (RR=3x3)
+// Output weight Layout: G*G*[K/8]*[C]*8 (GG=8x8, [x] means round up to integer)
+// Temp data Layout: K*C*G*G
+void weight_trans_c8_8x8_fp16(float16_t* dest,
+                              const float16_t* din,
+                              int ch_in,
+                              int ch_out,
+                              void* workspace) {
+  const float coeff[8][3] = {{1.0f, 0.0f, 0.0f},
+                             {-2.0f / 9, -2.0f / 9, -2.0f / 9},
+                             {-2.0f / 9, 2.0f / 9, -2.0f / 9},
+                             {1.0f / 90, 1.0f / 45, 2.0f / 45},
+                             {1.0f / 90, -1.0f / 45, 2.0f / 45},
+                             {32.0f / 45, 16.0f / 45, 8.0f / 45},
+                             {32.0f / 45, -16.0f / 45, 8.0f / 45},
+                             {0.0f, 0.0f, 1.0f}};
+  weights_trans_c8_fp16(dest, din, coeff, 8, ch_in, ch_out, workspace);
+}
+
 // Input weight Layout: K*C*R*R (RR=3x3)
 // Output weight Layout: G*G*[K/8]*[C]*8 (GG=6x6, [x] means round up to integer)
 // Temp data Layout: K*C*G*G
@@ -888,12 +1265,12 @@ void weight_trans_c8_6x6_fp16(float16_t* dest,
                               int ch_in,
                               int ch_out,
                               void* workspace) {
-  const float16_t coeff[6][3] = {{0.25f, 0.0f, 0.0f},
-                                 {-1.0f / 6, -1.0f / 6, -1.0f / 6},
-                                 {-1.0f / 6, 1.0f / 6, -1.0f / 6},
-                                 {1.0f / 24, 1.0f / 12, 1.0f / 6},
-                                 {1.0f / 24, -1.0f / 12, 1.0f / 6},
-                                 {0.0f, 0.0f, 1.0f}};
+  const float coeff[6][3] = {{0.25f, 0.0f, 0.0f},
+                             {-1.0f / 6, -1.0f / 6, -1.0f / 6},
+                             {-1.0f / 6, 1.0f / 6, -1.0f / 6},
+                             {1.0f / 24, 1.0f / 12, 1.0f / 6},
+                             {1.0f / 24, -1.0f / 12, 1.0f / 6},
+                             {0.0f, 0.0f, 1.0f}};
   weights_trans_c8_fp16(dest, din, coeff, 6, ch_in, ch_out, workspace);
 }
 
@@ -902,10 +1279,10 @@ void weight_trans_c8_4x4_fp16(float16_t* dest,
                               int ch_in,
                               int ch_out,
                               void* workspace) {
-  const float16_t coeff[4][3] = {{1.0f, 0.0f, 0.0f},
-                                 {0.5f, 0.5f, 0.5f},
-                                 {0.5f, -0.5f, 0.5f},
-                                 {0.0f, 0.0f, 1.0f}};
+  const float coeff[4][3] = {{1.0f, 0.0f, 0.0f},
+                             {0.5f, 0.5f, 0.5f},
+                             {0.5f, -0.5f, 0.5f},
+                             {0.0f, 0.0f, 1.0f}};
   weights_trans_c8_fp16(dest, din, coeff, 4, ch_in, ch_out, workspace);
 }
 }  // namespace fp16
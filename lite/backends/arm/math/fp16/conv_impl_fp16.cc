@@ -15,6 +15,7 @@
 #include "lite/backends/arm/math/fp16/conv_impl_fp16.h"
 #include <arm_neon.h>
 #include <algorithm>
+#include "lite/backends/arm/math/conv_impl.h"
 #include "lite/backends/arm/math/fp16/conv3x3_depthwise_fp16.h"
 #include "lite/backends/arm/math/fp16/gemm_fp16.h"
 #include "lite/backends/arm/math/fp16/gemv_fp16.h"
@@ -393,6 +394,8 @@ void conv_im2col_gemm_fp16(CONV_PARAM(float16_t)) {
   int hblock = get_hblock_fp16(ctx);
   int m_roundup = hblock * ((m + hblock - 1) / hblock);
   int weights_size_per_group = m * k;
+  int band_rows =
+      im2col_band_rows(kernel_h, kernel_w, k, oh, ow, sizeof(float16_t), ctx);
 
   auto act_param = param.activation_param;
   if (n > 1 && m > 1) {
@@ -413,76 +416,100 @@ void conv_im2col_gemm_fp16(CONV_PARAM(float16_t)) {
       const float16_t* weights_group = weights + g * weights_size_per_group;
       const float16_t* bias_group = bias + g * m;
       float16_t* dB = tmp_work_space;
-      im2col_fp16(din_group,
-                  chin_per_group,
-                  ih,
-                  win,
-                  kernel_h,
-                  kernel_w,
-                  paddings[0],
-                  paddings[1],
-                  paddings[2],
-                  paddings[3],
-                  dilations[0],
-                  dilations[1],
-                  dB,
-                  param.strides[0],
-                  param.strides[1]);
-      if (n == 1) {
-        gemv_fp16(weights_group,
-                  dB,
-                  dout_group,
-                  false,
-                  m,
-                  k,
-                  0.f,
-                  flag_bias,
-                  bias_group,
-                  act_param.has_active,
-                  act_param,
-                  ctx);
-      } else if (m == 1) {
+      for (int h = 0; h < oh; h += band_rows) {
+        int h_end = std::min(h + band_rows, oh);
+        int band_n = (h_end - h) * ow;
+        float16_t* dout_band = dout_group + h * ow;
+        if (band_rows == oh) {
+          im2col_fp16(din_group,
+                      chin_per_group,
+                      ih,
+                      win,
+                      kernel_h,
+                      kernel_w,
+                      paddings[0],
+                      paddings[1],
+                      paddings[2],
+                      paddings[3],
+                      dilations[0],
+                      dilations[1],
+                      dB,
+                      param.strides[0],
+                      param.strides[1]);
+        } else {
+          im2col_rows<float16_t>(din_group,
+                                 chin_per_group,
+                                 ih,
+                                 win,
+                                 kernel_h,
+                                 kernel_w,
+                                 paddings[0],
+                                 paddings[2],
+                                 param.strides[0],
+                                 param.strides[1],
+                                 dilations[0],
+                                 dilations[1],
+                                 ow,
+                                 h,
+                                 h_end,
+                                 dB);
+        }
+        if (n == 1) {
+          gemv_fp16(weights_group,
+                    dB,
+                    dout_band,
+                    false,
+                    m,
+                    k,
+                    0.f,
+                    flag_bias,
+                    bias_group,
+                    act_param.has_active,
+                    act_param,
+                    ctx);
+        } else if (m == 1) {
 #ifdef TARGET_IOS
-        float16_t* bias_ptr = new float16_t[n];
+          float16_t* bias_ptr = new float16_t[band_n];
 #else
-        float16_t bias_ptr[n];  // NOLINT
+          float16_t bias_ptr[band_n];  // NOLINT
 #endif
-        if (flag_bias) {
-          for (int i = 0; i < n; i++) {
-            bias_ptr[i] = bias_group[0];
+          if (flag_bias) {
+            for (int i = 0; i < band_n; i++) {
+              bias_ptr[i] = bias_group[0];
+            }
           }
-        }
 
-        gemv_fp16(weights_group,
-                  dB,
-                  dout_group,
-                  true,
-                  n,
-                  k,
-                  0.f,
-                  flag_bias,
-                  bias_ptr,
-                  act_param.has_active,
-                  act_param,
-                  ctx);
+          gemv_fp16(weights_group,
+                    dB,
+                    dout_band,
+                    true,
+                    band_n,
+                    k,
+                    0.f,
+                    flag_bias,
+                    bias_ptr,
+                    act_param.has_active,
+                    act_param,
+                    ctx);
 #ifdef TARGET_IOS
-        delete[] bias_ptr;
+          delete[] bias_ptr;
 #endif
-      } else {
-        gemm_prepack_fp16(false,
-                          m,
-                          n,
-                          k,
-                          weights_group,
-                          dB,
-                          n,
-                          0.f,
-                          dout_group,
-                          n,
-                          bias_group,
-                          flag_bias,
-                          act_param,
-                          ctx);
+        } else {
+          gemm_prepack_fp16(false,
+                            m,
+                            band_n,
+                            k,
+                            weights_group,
+                            dB,
+                            band_n,
+                            0.f,
+                            dout_band,
+                            n,
+                            bias_group,
+                            flag_bias,
+                            act_param,
+                            ctx);
+        }
       }
     }
   }
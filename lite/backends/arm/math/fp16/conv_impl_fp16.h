@@ -73,10 +73,15 @@ void weight_trans_c8_4x4_fp16(
 void weight_trans_c8_6x6_fp16(
     float16_t *dest, const float16_t *src, int ic, int oc, void *workspace);
 
+void weight_trans_c8_8x8_fp16(
+    float16_t *dest, const float16_t *src, int ic, int oc, void *workspace);
+
 void conv_compute_2x2_3x3_fp16(CONV_PARAM(float16_t));
 
 void conv_compute_4x4_3x3_fp16(CONV_PARAM(float16_t));
 
+void conv_compute_6x6_3x3_fp16(CONV_PARAM(float16_t));
+
 template <typename Dtype>
 void col2im(const Dtype *data_col,
             const int channels,
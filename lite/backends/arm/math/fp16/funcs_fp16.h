@@ -29,6 +29,7 @@
 #include "lite/backends/arm/math/fp16/gemm_fp16.h"
 #include "lite/backends/arm/math/fp16/gemv_fp16.h"
 #include "lite/backends/arm/math/fp16/interpolate_fp16.h"
+#include "lite/backends/arm/math/fp16/norm_fp16.h"
 #include "lite/backends/arm/math/fp16/pad2d_fp16.h"
 #include "lite/backends/arm/math/fp16/pooling_fp16.h"
 #include "lite/backends/arm/math/fp16/power_fp16.h"
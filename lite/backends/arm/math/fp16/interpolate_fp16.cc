@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/backends/arm/math/fp16/interpolate_fp16.h"
+#include <algorithm>
 #include <string>
 #include <vector>
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
@@ -46,368 +47,90 @@ inline std::vector<T> get_new_data_from_tensor(const Tensor* new_data_tensor) {
   return vec_new_data;
 }
 
-#define ALPHA_COMPUTE_BOUND                 \
-  int idx = dx * 2;                         \
-  int sx = xofs[idx];                       \
-  int sx1 = xofs[idx + 1];                  \
-  int sxn = xofs[idx + 2];                  \
-  int sxn1 = xofs[idx + 3];                 \
-  float16x4_t _s0s0n;                       \
-  _s0s0n[0] = *(s0 + sx);                   \
-  _s0s0n[1] = *(s0 + sx1);                  \
-  _s0s0n[2] = *(s0 + sxn);                  \
-  _s0s0n[3] = *(s0 + sxn1);                 \
-  float16x4_t _s1s1n;                       \
-  _s1s1n[0] = *(s1 + sx);                   \
-  _s1s1n[1] = *(s1 + sx1);                  \
-  _s1s1n[2] = *(s1 + sxn);                  \
-  _s1s1n[3] = *(s1 + sxn1);                 \
-  float16x4_t _a = vld1_f16(alphap);        \
-  float16x4_t _ms0 = vmul_f16(_s0s0n, _a);  \
-  float16x4_t _ms1 = vmul_f16(_s1s1n, _a);  \
-  float16x4_t _mss = vpadd_f16(_ms0, _ms1); \
-  rows0p[dx] = _mss[0];                     \
-  rows0p[dx + 1] = _mss[1];                 \
-  rows1p[dx] = _mss[2];                     \
-  rows1p[dx + 1] = _mss[3];                 \
-  alphap += 4;
-
-#define ALPHA_COMPUTE                     \
-  float16x4_t va = vld1_f16(alphap);      \
-  float16x4_t vs0 = vld1_f16(s0p);        \
-  float16x4_t vs1 = vld1_f16(s1p);        \
-  float16x4_t vs0n = vld1_f16(s0np);      \
-  float16x4_t vs1n = vld1_f16(s1np);      \
-  vs0[2] = vs0n[0];                       \
-  vs0[3] = vs0n[1];                       \
-  vs1[2] = vs1n[0];                       \
-  vs1[3] = vs1n[1];                       \
-  float16x4_t vms0 = vmul_f16(vs0, va);   \
-  float16x4_t vms1 = vmul_f16(vs1, va);   \
-  float16_t vmres0_0 = vms0[0] + vms0[1]; \
-  float16_t vmres0_1 = vms0[2] + vms0[3]; \
-  float16_t vmres1_0 = vms1[0] + vms1[1]; \
-  float16_t vmres1_1 = vms1[2] + vms1[3]; \
-  rows0p[dx] = vmres0_0;                  \
-  rows0p[dx + 1] = vmres0_1;              \
-  rows1p[dx] = vmres1_0;                  \
-  rows1p[dx + 1] = vmres1_1;
-
-#define BRTA_COMPUTE                           \
-  float16x8_t vrows0 = vld1q_f16(rows0p);      \
-  float16x8_t vrows2 = vld1q_f16(rows0p + 8);  \
-  float16x8_t vrows4 = vld1q_f16(rows0p + 16); \
-  float16x8_t vrows6 = vld1q_f16(rows0p + 24); \
-  float16x8_t vrows1 = vld1q_f16(rows1p);      \
-  float16x8_t vsum0 = vmulq_f16(vrows0, vb0);  \
-  float16x8_t vrows3 = vld1q_f16(rows1p + 8);  \
-  float16x8_t vsum1 = vmulq_f16(vrows2, vb0);  \
-  float16x8_t vrows5 = vld1q_f16(rows1p + 16); \
-  float16x8_t vsum2 = vmulq_f16(vrows4, vb0);  \
-  float16x8_t vrows7 = vld1q_f16(rows1p + 24); \
-  float16x8_t vsum3 = vmulq_f16(vrows6, vb0);  \
-  vsum0 = vfmaq_f16(vsum0, vrows1, vb1);       \
-  vsum1 = vfmaq_f16(vsum1, vrows3, vb1);       \
-  vsum2 = vfmaq_f16(vsum2, vrows5, vb1);       \
-  vsum3 = vfmaq_f16(vsum3, vrows7, vb1);       \
-  rows0p += 32;                                \
-  vst1q_f16(dp, vsum0);                        \
-  vst1q_f16(dp + 8, vsum1);                    \
-  rows1p += 32;                                \
-  vst1q_f16(dp + 16, vsum2);                   \
-  vst1q_f16(dp + 24, vsum3);                   \
-  dp += 32;
+// blends the columns of one source row
+static void bilinear_row(const float16_t* src,
+                         float16_t* row,
+                         int w_out,
+                         const InterpTable<float16_t>& table) {
+  const int* xofs0 = table.xofs0.data();
+  const int* xofs1 = table.xofs1.data();
+  const float16_t* alpha0 = table.alpha0.data();
+  const float16_t* alpha1 = table.alpha1.data();
+  int dx = 0;
+  for (; dx + 7 < w_out; dx += 8) {
+    float16_t s0[8];
+    float16_t s1[8];
+    for (int i = 0; i < 8; i++) {
+      s0[i] = src[xofs0[dx + i]];
+      s1[i] = src[xofs1[dx + i]];
+    }
+    float16x8_t vrow = vmulq_f16(vld1q_f16(s0), vld1q_f16(alpha0 + dx));
+    vrow = vfmaq_f16(vrow, vld1q_f16(s1), vld1q_f16(alpha1 + dx));
+    vst1q_f16(row + dx, vrow);
+  }
+  for (; dx < w_out; dx++) {
+    row[dx] = src[xofs0[dx]] * alpha0[dx] + src[xofs1[dx]] * alpha1[dx];
+  }
+}
 
+// Fills the output rows [h_begin, h_end) of one channel, keeping the two
+// blended source rows for the next output row like the fp32 version.
 void bilinear_interp(const float16_t* src,
                      int w_in,
-                     int h_in,
                      float16_t* dst,
                      int w_out,
-                     int h_out,
-                     float scale_x,
-                     float scale_y,
-                     bool with_align,
-                     int align_mode) {
-  int* buf = new int[w_out + h_out + w_out * 2 + h_out * 2];
-
-  int* xofs = buf;
-  int* yofs = buf + w_out * 2;
-
-  float16_t* alpha = reinterpret_cast<float16_t*>(buf + 2 * w_out + 2 * h_out);
-  float16_t* beta =
-      reinterpret_cast<float16_t*>(buf + w_out + 2 * h_out + w_out * 2);
-
-  float fx = 0.0f;
-  float fy = 0.0f;
-  int sx = 0;
-  int sy = 0;
-  if (with_align) {
-    scale_x = static_cast<float>(w_in - 1) / (w_out - 1);
-    scale_y = static_cast<float>(h_in - 1) / (h_out - 1);
-    // calculate x axis coordinate
-    for (int dx = 0; dx < w_out; dx++) {
-      fx = dx * scale_x;
-      sx = static_cast<int>(fx);
-      fx -= sx;
-      xofs[dx * 2] = sx;
-      xofs[dx * 2 + 1] = (sx + 1) < w_in - 1 ? (sx + 1) : (w_in - 1);
-      alpha[dx * 2] = 1.f - static_cast<float16_t>(fx);
-      alpha[dx * 2 + 1] = static_cast<float16_t>(fx);
-    }
-    // calculate y axis coordinate
-    for (int dy = 0; dy < h_out; dy++) {
-      fy = dy * scale_y;
-      sy = static_cast<int>(fy);
-      fy -= sy;
-      yofs[dy * 2] = sy;
-      yofs[dy * 2 + 1] = (sy + 1) < h_in - 1 ? (sy + 1) : (h_in - 1);
-      beta[dy * 2] = 1.f - static_cast<float16_t>(fy);
-      beta[dy * 2 + 1] = static_cast<float16_t>(fy);
-    }
-  } else {
-    scale_x = static_cast<float>(w_in) / w_out;
-    scale_y = static_cast<float>(h_in) / h_out;
-    // calculate x axis coordinate
-    for (int dx = 0; dx < w_out; dx++) {
-      fx = align_mode ? scale_x * dx : scale_x * (dx + 0.5f) - 0.5f;
-      fx = fx < 0 ? 0.f : fx;
-      sx = static_cast<int>(fx);
-      fx -= sx;
-      xofs[dx * 2] = sx;
-      xofs[dx * 2 + 1] = (sx + 1) < w_in - 1 ? (sx + 1) : (w_in - 1);
-      alpha[dx * 2] = 1.f - static_cast<float16_t>(fx);
-      alpha[dx * 2 + 1] = static_cast<float16_t>(fx);
-    }
-    // calculate y axis coordinate
-    for (int dy = 0; dy < h_out; dy++) {
-      fy = align_mode ? scale_y * dy : scale_y * (dy + 0.5f) - 0.5f;
-      fy = fy < 0 ? 0.f : fy;
-      sy = static_cast<int>(fy);
-      fy -= sy;
-      yofs[dy * 2] = sy;
-      yofs[dy * 2 + 1] = (sy + 1) < h_in - 1 ? (sy + 1) : (h_in - 1);
-      beta[dy * 2] = 1.f - static_cast<float16_t>(fy);
-      beta[dy * 2 + 1] = static_cast<float16_t>(fy);
-    }
-  }
-  float16_t* rowsbuf0 = new float16_t[w_out];
-  float16_t* rowsbuf1 = new float16_t[w_out];
-  float16_t* rows0 = rowsbuf0;
-  float16_t* rows1 = rowsbuf1;
-  // output w , h boundary
-  int w_bound = w_out;
-  int h_bound = h_out;
-
-  int cnt = w_out >> 5;
-  int remain = (w_out & 31);
-  int remain_cnt = remain >> 3;
-  int remain_rem = remain & 7;
-  if (with_align) {
-    w_bound = ceil((w_in - 1) / scale_x);
-    h_bound = ceil((h_in - 1) / scale_y);
-  } else {
-    w_bound = ceil((w_in - 0.5f) / scale_x - 0.5f);
-    h_bound = ceil((h_in - 0.5f) / scale_y - 0.5f);
-  }
-  // h_bound loop
-  for (int dy = 0; dy < h_bound; dy++) {
-    int sy0 = yofs[dy * 2];
-    int sy1 = yofs[dy * 2 + 1];
-
-    const float16_t* s0 = src + sy0 * w_in;
-    const float16_t* s1 = src + sy1 * w_in;
-
-    const float16_t* alphap = alpha;
-    float16_t* rows0p = rows0;
-    float16_t* rows1p = rows1;
-
-    int dx = 0;
-    // w_bound loop
-    for (; dx + 1 < w_bound; dx += 2) {
-      ALPHA_COMPUTE_BOUND
-    }
-    // w_bound remain loop
-    for (; dx < w_bound; dx++) {
-      auto idx = dx * 2;
-      int sx = xofs[idx];
-      int sx1 = xofs[idx + 1];
-
-      rows0p[dx] = s0[sx] * alphap[0] + s0[sx1] * alphap[1];
-      rows1p[dx] = s1[sx] * alphap[0] + s1[sx1] * alphap[1];
-
-      alphap += 2;
-    }
-
-    const float16_t buffer1[2] = {*(src + sy0 * w_in + w_in - 1),
-                                  *(src + sy0 * w_in + w_in - 1)};
-    const float16_t buffer2[2] = {*(src + sy1 * w_in + w_in - 1),
-                                  *(src + sy1 * w_in + w_in - 1)};
-    // w_bound - w_out loop
-    for (; dx + 1 < w_out; dx += 2) {
-      const float16_t* s0p = buffer1;
-      const float16_t* s1p = buffer2;
-      const float16_t* s0np = buffer1;
-      const float16_t* s1np = buffer2;
-
-      ALPHA_COMPUTE
-
-      alphap += 4;
+                     int h_begin,
+                     int h_end,
+                     const InterpTable<float16_t>& table) {
+  std::vector<float16_t> rows_buf(w_out * 2);
+  float16_t* rows0 = rows_buf.data();
+  float16_t* rows1 = rows0 + w_out;
+  // the source rows held by rows0 and rows1
+  int row0 = -1;
+  int row1 = -1;
+  for (int dy = h_begin; dy < h_end; dy++) {
+    int sy0 = table.yofs0[dy];
+    int sy1 = table.yofs1[dy];
+    if (row0 != sy0) {
+      if (row1 == sy0) {
+        std::swap(rows0, rows1);
+        std::swap(row0, row1);
+      } else {
+        bilinear_row(src + sy0 * w_in, rows0, w_out, table);
+        row0 = sy0;
+      }
     }
-    // w_bound - w_out remain loop
-    for (; dx < w_out; dx++) {
-      const float16_t* s0p = buffer1;
-      const float16_t* s1p = buffer2;
-
-      float16_t a0 = alphap[0];
-      float16_t a1 = alphap[1];
-      rows0p[dx] = s0p[0] * a0 + s0p[1] * a1;
-      rows1p[dx] = s1p[0] * a0 + s1p[1] * a1;
-
-      alphap += 2;
+    const float16_t* r0 = rows0;
+    const float16_t* r1 = rows0;
+    if (sy1 != sy0) {
+      if (row1 != sy1) {
+        bilinear_row(src + sy1 * w_in, rows1, w_out, table);
+        row1 = sy1;
+      }
+      r1 = rows1;
     }
 
-    float16_t b0 = beta[0];
-    float16_t b1 = beta[1];
-
-    float16_t* dp = dst + dy * w_out;
-
+    float16_t b0 = table.beta0[dy];
+    float16_t b1 = table.beta1[dy];
     float16x8_t vb0 = vdupq_n_f16(b0);
     float16x8_t vb1 = vdupq_n_f16(b1);
-    // calculate and store results
-    for (int i = 0; i < cnt; i++) {
-      BRTA_COMPUTE
-    }
-    for (int i = 0; i < remain_cnt; i++) {
-      float16x8_t vrows0 = vld1q_f16(rows0p);
-      float16x8_t vrows1 = vld1q_f16(rows1p);
-      float16x8_t vsum0 = vmulq_f16(vrows0, vb0);
-      vsum0 = vfmaq_f16(vsum0, vrows1, vb1);
-
-      rows0p += 8;
-      vst1q_f16(dp, vsum0);
-      rows1p += 8;
-      dp += 8;
-    }
-    // calculate and store remain resluts
-    for (int i = 0; i < remain_rem; i++) {
-      *dp++ = *rows0p++ * b0 + *rows1p++ * b1;
-    }
-    beta += 2;
-  }
-
-  // h_bound - h_out loop
-  for (int dy = h_bound; dy < h_out; dy++) {
-    int sy = h_in - 1;
-    const float16_t* s0 = src + sy * w_in;
-    const float16_t* s1 = s0;
-    const float16_t* alphap = alpha;
-    float16_t* rows0p = rows0;
-    float16_t* rows1p = rows1;
-
+    float16_t* dp = dst + dy * w_out;
     int dx = 0;
-    // w_bound loop
-    for (; dx + 1 < w_bound; dx += 2) {
-      ALPHA_COMPUTE_BOUND
+    for (; dx + 15 < w_out; dx += 16) {
+      float16x8_t vd0 = vmulq_f16(vld1q_f16(r0 + dx), vb0);
+      float16x8_t vd1 = vmulq_f16(vld1q_f16(r0 + dx + 8), vb0);
+      vd0 = vfmaq_f16(vd0, vld1q_f16(r1 + dx), vb1);
+      vd1 = vfmaq_f16(vd1, vld1q_f16(r1 + dx + 8), vb1);
+      vst1q_f16(dp + dx, vd0);
+      vst1q_f16(dp + dx + 8, vd1);
     }
-    // w_bound remain loop
-    for (; dx < w_bound; dx++) {
-      int sx = xofs[dx * 2];
-      int sx1 = xofs[dx * 2 + 1];
-
-      const float16_t* s0p = s0 + sx;
-      const float16_t* s1p = s0 + sx1;
-      float16_t a0 = alphap[0];
-      float16_t a1 = alphap[1];
-      rows0p[dx] = s0p[0] * a0 + s1p[0] * a1;
-      rows1p[dx] = rows0p[dx];
-
-      alphap += 2;
+    for (; dx + 7 < w_out; dx += 8) {
+      float16x8_t vd0 = vmulq_f16(vld1q_f16(r0 + dx), vb0);
+      vd0 = vfmaq_f16(vd0, vld1q_f16(r1 + dx), vb1);
+      vst1q_f16(dp + dx, vd0);
     }
-
-    const float16_t buffer1[2] = {*(src + sy * w_in + w_in - 1),
-                                  *(src + sy * w_in + w_in - 1)};
-    // w_bound - w_out loop
-    for (; dx + 1 < w_out; dx += 2) {
-      const float16_t* s0p = buffer1;
-      const float16_t* s1p = buffer1;
-      const float16_t* s0np = buffer1;
-      const float16_t* s1np = buffer1;
-
-      ALPHA_COMPUTE
-
-      alphap += 4;
-    }
-    // w_bound - wout remain loop
     for (; dx < w_out; dx++) {
-      const float16_t* s0p = buffer1;
-      float16_t a0 = alphap[0];
-      float16_t a1 = alphap[1];
-      rows0p[dx] = s0p[0] * a0 + s0p[1] * a1;
-      rows1p[dx] = rows0p[dx];
-      alphap += 2;
-    }
-
-    float16_t b0 = beta[0];
-    float16_t b1 = beta[1];
-
-    float16_t* dp = dst + dy * w_out;
-
-    float16x8_t vb0 = vdupq_n_f16(b0);
-    float16x8_t vb1 = vdupq_n_f16(b1);
-    // calculate and store results
-    for (int i = 0; i < cnt; i++) {
-      BRTA_COMPUTE
-    }
-    for (int i = 0; i < remain_cnt; i++) {
-      float16x8_t vrows0 = vld1q_f16(rows0p);
-      float16x8_t vrows1 = vld1q_f16(rows1p);
-      float16x8_t vsum0 = vmulq_f16(vrows0, vb0);
-      vsum0 = vfmaq_f16(vsum0, vrows1, vb1);
-
-      rows0p += 8;
-      vst1q_f16(dp, vsum0);
-      rows1p += 8;
-      dp += 8;
-    }
-
-    // calculate and store remain results
-    for (int i = 0; i < remain_rem; i++) {
-      *dp++ = *rows0p++ * b0 + *rows1p++ * b1;
-    }
-
-    beta += 2;
-  }
-  delete[] buf;
-  delete[] rowsbuf0;
-  delete[] rowsbuf1;
-}
-
-void nearest_interp(const float16_t* src,
-                    int w_in,
-                    int h_in,
-                    float16_t* dst,
-                    int w_out,
-                    int h_out,
-                    float scale_x,
-                    float scale_y,
-                    bool with_align) {
-  if (with_align) {
-    for (int h = 0; h < h_out; ++h) {
-      float16_t* dst_p = dst + h * w_out;
-      int near_y = static_cast<int>(scale_y * h + 0.5);
-      for (int w = 0; w < w_out; ++w) {
-        int near_x = static_cast<int>(scale_x * w + 0.5);
-        *dst_p++ = src[near_y * w_in + near_x];
-      }
-    }
-  } else {
-    for (int h = 0; h < h_out; ++h) {
-      float16_t* dst_p = dst + h * w_out;
-      int near_y = static_cast<int>(scale_y * h);
-      for (int w = 0; w < w_out; ++w) {
-        int near_x = static_cast<int>(scale_x * w);
-        *dst_p++ = src[near_y * w_in + near_x];
-      }
+      dp[dx] = r0[dx] * b0 + r1[dx] * b1;
     }
   }
 }
@@ -423,7 +146,9 @@ void interpolate(lite::Tensor* X,
                  bool with_align,
                  int align_mode,
                  std::string interpolate_type,
-                 std::vector<float> scale_data) {
+                 std::vector<float> scale_data,
+                 InterpTable<float16_t>* table,
+                 int threads) {
   int in_h = X->dims()[2];
   int in_w = X->dims()[3];
   float height_scale = 0.f;
@@ -502,34 +227,40 @@ void interpolate(lite::Tensor* X,
                           ? (static_cast<float>(in_h - 1) / (out_h - 1))
                           : (static_cast<float>(in_h) / (out_h));
 
-  if (interpolate_type == "Bilinear") {
-    LITE_PARALLEL_BEGIN(i, tid, count) {
-      bilinear_interp(din + spatial_in * i,
+  bool bilinear = interpolate_type == "Bilinear";
+  if (bilinear) {
+    bilinear_table(table, in_w, in_h, out_w, out_h, with_align, align_mode);
+  } else if (interpolate_type == "Nearest") {
+    nearest_table(
+        table, in_w, in_h, out_w, out_h, scale_w_new, scale_h_new, with_align);
+  } else {
+    return;
+  }
+  int blocks = interp_row_blocks(count, out_h, threads);
+  int block_h = (out_h + blocks - 1) / blocks;
+  LITE_PARALLEL_BEGIN(i, tid, count * blocks) {
+    int c = i / blocks;
+    int h_begin = (i % blocks) * block_h;
+    int h_end = std::min(h_begin + block_h, out_h);
+    if (bilinear) {
+      bilinear_interp(din + spatial_in * c,
                       in_w,
-                      in_h,
-                      dout + spatial_out * i,
+                      dout + spatial_out * c,
                       out_w,
-                      out_h,
-                      1.f / width_scale,
-                      1.f / height_scale,
-                      with_align,
-                      align_mode);
-    }
-    LITE_PARALLEL_END()
-  } else if (interpolate_type == "Nearest") {
-    LITE_PARALLEL_BEGIN(i, tid, count) {
-      nearest_interp(din + spatial_in * i,
+                      h_begin,
+                      h_end,
+                      *table);
+    } else {
+      nearest_interp(din + spatial_in * c,
                      in_w,
-                     in_h,
-                     dout + spatial_out * i,
+                     dout + spatial_out * c,
                      out_w,
-                     out_h,
-                     scale_w_new,
-                     scale_h_new,
-                     with_align);
+                     h_begin,
+                     h_end,
+                     *table);
     }
-    LITE_PARALLEL_END()
   }
+  LITE_PARALLEL_END()
 }
 
 }  // namespace fp16
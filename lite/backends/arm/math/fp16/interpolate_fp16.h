@@ -29,6 +29,7 @@
 #pragma once
 #include <string>
 #include <vector>
+#include "lite/backends/arm/math/interpolate.h"
 #include "lite/core/tensor.h"
 
 namespace paddle {
@@ -40,23 +41,11 @@ typedef __fp16 float16_t;
 
 void bilinear_interp(const float16_t* src,
                      int w_in,
-                     int h_in,
                      float16_t* dst,
                      int w_out,
-                     int h_out,
-                     float scale_x,
-                     float scale_y,
-                     bool with_align);
-
-void nearest_interp(const float16_t* src,
-                    int w_in,
-                    int h_in,
-                    float16_t* dst,
-                    int w_out,
-                    int h_out,
-                    float scale_x,
-                    float scale_y,
-                    bool with_align);
+                     int h_begin,
+                     int h_end,
+                     const InterpTable<float16_t>& table);
 
 void interpolate(lite::Tensor* X,
                  lite::Tensor* OutSize,
@@ -69,7 +58,9 @@ void interpolate(lite::Tensor* X,
                  bool with_align,
                  int align_mode,
                  std::string interpolate_type,
-                 std::vector<float> scale_data);
+                 std::vector<float> scale_data,
+                 InterpTable<float16_t>* table,
+                 int threads);
 
 }  // namespace fp16
 }  // namespace math
@@ -0,0 +1,161 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/fp16/norm_fp16.h"
+#include <arm_neon.h>
+#include <cmath>
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace fp16 {
+
+static void norm_row(const float16_t* x,
+                     const float* scale_data,
+                     const float* bias_data,
+                     float16_t* out,
+                     float* mean_out,
+                     float* var_out,
+                     float epsilon,
+                     int feature_size) {
+  int cnt = feature_size >> 3;
+  int remain = feature_size & 7;
+  float32x4_t vsum0 = vdupq_n_f32(0.f);
+  float32x4_t vsum1 = vdupq_n_f32(0.f);
+  float32x4_t vsqr0 = vdupq_n_f32(0.f);
+  float32x4_t vsqr1 = vdupq_n_f32(0.f);
+  for (int i = 0; i < cnt; ++i) {
+    float16x8_t vx = vld1q_f16(x + i * 8);
+    float32x4_t vlow = vcvt_f32_f16(vget_low_f16(vx));
+    float32x4_t vhigh = vcvt_f32_f16(vget_high_f16(vx));
+    vsum0 = vaddq_f32(vsum0, vlow);
+    vsum1 = vaddq_f32(vsum1, vhigh);
+    vsqr0 = vmlaq_f32(vsqr0, vlow, vlow);
+    vsqr1 = vmlaq_f32(vsqr1, vhigh, vhigh);
+  }
+  float32x4_t vsum = vaddq_f32(vsum0, vsum1);
+  float32x4_t vsqr = vaddq_f32(vsqr0, vsqr1);
+  float mean = vgetq_lane_f32(vsum, 0) + vgetq_lane_f32(vsum, 1) +
+               vgetq_lane_f32(vsum, 2) + vgetq_lane_f32(vsum, 3);
+  float variance = vgetq_lane_f32(vsqr, 0) + vgetq_lane_f32(vsqr, 1) +
+                   vgetq_lane_f32(vsqr, 2) + vgetq_lane_f32(vsqr, 3);
+  for (int i = cnt * 8; i < feature_size; ++i) {
+    float v = x[i];
+    mean += v;
+    variance += v * v;
+  }
+  mean /= feature_size;
+  variance = variance / feature_size - mean * mean;
+  *mean_out = mean;
+  *var_out = variance;
+  float rvar = 1.f / sqrtf(variance + epsilon);
+
+  // out = (x - mean) * scale * rvar + bias, computed in fp32
+  float32x4_t vmean = vdupq_n_f32(mean);
+  float32x4_t vrvar = vdupq_n_f32(rvar);
+  float32x4_t vscale0 = vrvar;
+  float32x4_t vscale1 = vrvar;
+  float32x4_t vbias0 = vdupq_n_f32(0.f);
+  float32x4_t vbias1 = vbias0;
+  for (int i = 0; i < cnt; ++i) {
+    float16x8_t vx = vld1q_f16(x + i * 8);
+    float32x4_t vlow = vsubq_f32(vcvt_f32_f16(vget_low_f16(vx)), vmean);
+    float32x4_t vhigh = vsubq_f32(vcvt_f32_f16(vget_high_f16(vx)), vmean);
+    if (scale_data) {
+      vscale0 = vmulq_f32(vld1q_f32(scale_data + i * 8), vrvar);
+      vscale1 = vmulq_f32(vld1q_f32(scale_data + i * 8 + 4), vrvar);
+    }
+    if (bias_data) {
+      vbias0 = vld1q_f32(bias_data + i * 8);
+      vbias1 = vld1q_f32(bias_data + i * 8 + 4);
+    }
+    vlow = vmlaq_f32(vbias0, vlow, vscale0);
+    vhigh = vmlaq_f32(vbias1, vhigh, vscale1);
+    vst1q_f16(out + i * 8,
+              vcombine_f16(vcvt_f16_f32(vlow), vcvt_f16_f32(vhigh)));
+  }
+  for (int i = cnt * 8; i < feature_size; ++i) {
+    float v = (static_cast<float>(x[i]) - mean) * rvar;
+    if (scale_data) v *= scale_data[i];
+    if (bias_data) v += bias_data[i];
+    out[i] = static_cast<float16_t>(v);
+  }
+}
+
+void matrix_norm_row(const float16_t* x_data,
+                     const float* scale_data,
+                     const float* bias_data,
+                     float16_t* out_data,
+                     float* mean_out,
+                     float* var_out,
+                     float epsilon,
+                     int batch_size,
+                     int feature_size) {
+  LITE_PARALLEL_BEGIN(bi, tid, batch_size) {
+    int offset = bi * feature_size;
+    norm_row(x_data + offset,
+             scale_data,
+             bias_data,
+             out_data + offset,
+             mean_out + bi,
+             var_out + bi,
+             epsilon,
+             feature_size);
+  }
+  LITE_PARALLEL_END();
+}
+
+void matrix_add_norm_row(const float16_t* x_data,
+                         const float16_t* residual_data,
+                         int residual_rows,
+                         const float* scale_data,
+                         const float* bias_data,
+                         float16_t* add_out,
+                         float16_t* out_data,
+                         float* mean_out,
+                         float* var_out,
+                         float epsilon,
+                         int batch_size,
+                         int feature_size) {
+  LITE_PARALLEL_BEGIN(bi, tid, batch_size) {
+    int offset = bi * feature_size;
+    const float16_t* x_ptr = x_data + offset;
+    const float16_t* r_ptr =
+        residual_data + (bi % residual_rows) * feature_size;
+    float16_t* sum_ptr = add_out ? add_out + offset : out_data + offset;
+    int i = 0;
+    for (; i + 8 <= feature_size; i += 8) {
+      vst1q_f16(sum_ptr + i,
+                vaddq_f16(vld1q_f16(x_ptr + i), vld1q_f16(r_ptr + i)));
+    }
+    for (; i < feature_size; i++) sum_ptr[i] = x_ptr[i] + r_ptr[i];
+    norm_row(sum_ptr,
+             scale_data,
+             bias_data,
+             out_data + offset,
+             mean_out + bi,
+             var_out + bi,
+             epsilon,
+             feature_size);
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace fp16
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,54 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace fp16 {
+typedef __fp16 float16_t;
+
+// The fp16 layer norm of the rows, the mean and the variance are accumulated
+// in fp32 and the scale, bias, mean and variance stay fp32.
+void matrix_norm_row(const float16_t* x_data,
+                     const float* scale_data,
+                     const float* bias_data,
+                     float16_t* out_data,
+                     float* mean_out,
+                     float* var_out,
+                     float epsilon,
+                     int batch_size,
+                     int feature_size);
+
+// The fp16 layer norm of x + residual, see the fp32 matrix_add_norm_row.
+void matrix_add_norm_row(const float16_t* x_data,
+                         const float16_t* residual_data,
+                         int residual_rows,
+                         const float* scale_data,
+                         const float* bias_data,
+                         float16_t* add_out,
+                         float16_t* out_data,
+                         float* mean_out,
+                         float* var_out,
+                         float epsilon,
+                         int batch_size,
+                         int feature_size);
+
+}  // namespace fp16
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include "lite/backends/arm/math/fp16/sgemm_fp16.h"
+#include <algorithm>
+#include <numeric>
+#include <vector>
 
 namespace paddle {
 namespace lite {
@@ -107,6 +110,93 @@ void sgemm_fp16(bool is_transA,
                     ctx);
 }
 
+void sgemm_fp16_strided_batch(const host::math::StridedMatmulArgs& args,
+                              float16_t alpha,
+                              const float16_t* x,
+                              const float16_t* y,
+                              float16_t* out,
+                              ARMContext* ctx) {
+  const int batch = args.out_offsets.size();
+  operators::ActivationParam act_param;
+  act_param.has_active = false;
+  // the batches of X and Out stacked in rows with a shared Y, e.g. the
+  // [B, M, K] x [K, N] projections, are one gemm of B * M rows
+  bool stacked = !args.trans_x && batch > 1;
+  for (int b = 1; stacked && b < batch; ++b) {
+    stacked = args.y_offsets[b] == args.y_offsets[0] &&
+              args.x_offsets[b] - args.x_offsets[b - 1] ==
+                  static_cast<int64_t>(args.m) * args.ldx &&
+              args.out_offsets[b] - args.out_offsets[b - 1] ==
+                  static_cast<int64_t>(args.m) * args.ldout;
+  }
+  const int m = stacked ? args.m * batch : args.m;
+  const int gemms = stacked ? 1 : batch;
+  // a single row of X is contiguous unless it's read transposed
+  if (m == 1 && args.ldy == (args.trans_y ? args.k : args.n) &&
+      (!args.trans_x || args.ldx == 1)) {
+    bool has_alpha = fabsf(alpha - 1.f) > 1e-8f;
+    for (int b = 0; b < gemms; ++b) {
+      float16_t* c = out + args.out_offsets[b];
+      gemv_fp16(y + args.y_offsets[b],
+                x + args.x_offsets[b],
+                c,
+                !args.trans_y,
+                args.n,
+                args.k,
+                0.f,
+                false,
+                nullptr,
+                false,
+                act_param,
+                ctx);
+      for (int j = 0; has_alpha && j < args.n; ++j) {
+        c[j] *= alpha;
+      }
+    }
+    return;
+  }
+  int hblock = get_hblock_fp16(ctx);
+  int m_roundup = hblock * ((m + hblock - 1) / hblock);
+  ctx->ExtendWorkspace(m_roundup * args.k * sizeof(float16_t));
+  auto packed_x = static_cast<float16_t*>(ctx->workspace_data<float16_t>()) +
+                  ctx->llc_size() / sizeof(float16_t);
+  // run the batches grouped by X, each broadcast X is packed once
+  std::vector<int> order(gemms);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    return args.x_offsets[a] < args.x_offsets[b];
+  });
+  for (int i = 0; i < gemms; ++i) {
+    int b = order[i];
+    if (i == 0 || args.x_offsets[b] != args.x_offsets[order[i - 1]]) {
+      prepackA_fp16(packed_x,
+                    x + args.x_offsets[b],
+                    alpha,
+                    args.ldx,
+                    0,
+                    m,
+                    0,
+                    args.k,
+                    args.trans_x,
+                    ctx);
+    }
+    gemm_prepack_fp16(args.trans_y,
+                      m,
+                      args.n,
+                      args.k,
+                      packed_x,
+                      y + args.y_offsets[b],
+                      args.ldy,
+                      0.f,
+                      out + args.out_offsets[b],
+                      args.ldout,
+                      nullptr,
+                      false,
+                      act_param,
+                      ctx);
+  }
+}
+
 }  // namespace fp16
 }  // namespace math
 }  // namespace arm
@@ -17,6 +17,7 @@
 #include <cmath>
 #include "lite/backends/arm/math/fp16/gemm_fp16.h"
 #include "lite/backends/arm/math/fp16/gemv_fp16.h"
+#include "lite/backends/host/math/strided_matmul.h"
 #include "lite/core/context.h"
 #include "lite/core/device_info.h"
 
@@ -44,6 +45,17 @@ void sgemm_fp16(bool is_transA,
                 const operators::ActivationParam act_param,
                 ARMContext* ctx);
 
+// The gemms of a batched matmul, see StridedMatmulArgs. The batches sharing
+// an X are run together so that it's packed once, the batches of X stacked
+// in rows with a shared Y are run as one gemm, and the single-row ones, e.g.
+// the attention scores of one query, as gemvs.
+void sgemm_fp16_strided_batch(const host::math::StridedMatmulArgs& args,
+                              float16_t alpha,
+                              const float16_t* x,
+                              const float16_t* y,
+                              float16_t* out,
+                              ARMContext* ctx);
+
 }  // namespace fp16
 }  // namespace math
 }  // namespace arm
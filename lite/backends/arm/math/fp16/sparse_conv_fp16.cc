@@ -0,0 +1,291 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/fp16/sparse_conv_fp16.h"
+#include <arm_neon.h>
+#include <algorithm>
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace fp16 {
+
+namespace {
+struct SparseActFp16 {
+  int flag{0};  // relu: 1, relu6: 2, leakey: 3, hard_swish: 4
+  float16x8_t vzero;
+  float16x8_t valpha;
+  float16x8_t voffset;
+  float16x8_t vscale;
+  float16x8_t vthreshold;
+};
+
+SparseActFp16 init_sparse_act(const operators::ActivationParam& act_param) {
+  SparseActFp16 act;
+  act.vzero = vdupq_n_f16(0.f);
+  act.valpha = act.vzero;
+  act.voffset = act.vzero;
+  act.vscale = act.vzero;
+  act.vthreshold = act.vzero;
+  if (!act_param.has_active) return act;
+  auto act_type = act_param.active_type;
+  if (act_type == lite_api::ActivationType::kRelu) {
+    act.flag = 1;
+  } else if (act_type == lite_api::ActivationType::kRelu6) {
+    act.flag = 2;
+    act.valpha = vdupq_n_f16(act_param.Relu_clipped_coef);
+  } else if (act_type == lite_api::ActivationType::kLeakyRelu) {
+    act.flag = 3;
+    act.valpha = vdupq_n_f16(act_param.Leaky_relu_alpha);
+  } else if (act_type == lite_api::ActivationType::kHardSwish) {
+    act.flag = 4;
+    act.voffset = vdupq_n_f16(act_param.hard_swish_offset);
+    act.vscale = vdupq_n_f16(1.f / act_param.hard_swish_scale);
+    act.vthreshold = vdupq_n_f16(act_param.hard_swish_threshold);
+  }
+  return act;
+}
+
+inline float16x8_t sparse_act(float16x8_t v, const SparseActFp16& act) {
+  switch (act.flag) {
+    case 1:
+      return vmaxq_f16(v, act.vzero);
+    case 2:
+      return vminq_f16(vmaxq_f16(v, act.vzero), act.valpha);
+    case 3:
+      return vbslq_f16(
+          vcgeq_f16(v, act.vzero), v, vmulq_f16(v, act.valpha));
+    case 4: {
+      float16x8_t vtmp = vminq_f16(
+          act.vthreshold, vmaxq_f16(act.vzero, vaddq_f16(v, act.voffset)));
+      return vmulq_f16(vmulq_f16(v, act.vscale), vtmp);
+    }
+    default:
+      return v;
+  }
+}
+
+// Move the input pointer by `diff` bytes to the next non-zero channel.
+inline const float16_t* next_input(const float16_t* b, int32_t diff) {
+  return reinterpret_cast<const float16_t*>(
+      reinterpret_cast<uintptr_t>(b) + static_cast<intptr_t>(diff));
+}
+
+// Compute the 8 * W columns of `rows` output channels, whose weights of a
+// non-zero input channel are adjacent.
+template <int W, int rows>
+inline void sparse_block_fp16(const float16_t* w,
+                              const float16_t* b,
+                              const int32_t* dmap,
+                              uint32_t nnz,
+                              const float16_t* bias,
+                              float16_t* const* out,
+                              const SparseActFp16& act) {
+  float16x8_t vacc[rows][W];
+  for (int r = 0; r < rows; r++) {
+    for (int k = 0; k < W; k++) {
+      vacc[r][k] = vdupq_n_f16(bias[r]);
+    }
+  }
+  for (uint32_t j = 0; j < nnz; j++) {
+    float16x8_t vb[W];
+    for (int k = 0; k < W; k++) {
+      vb[k] = vld1q_f16(b + 8 * k);
+    }
+    b = next_input(b, dmap[j]);
+    for (int r = 0; r < rows; r++) {
+      float16x8_t vw = vdupq_n_f16(w[r]);
+      for (int k = 0; k < W; k++) {
+        vacc[r][k] = vfmaq_f16(vacc[r][k], vb[k], vw);
+      }
+    }
+    w += rows;
+  }
+  for (int r = 0; r < rows; r++) {
+    for (int k = 0; k < W; k++) {
+      vst1q_f16(out[r] + 8 * k, sparse_act(vacc[r][k], act));
+    }
+  }
+}
+
+// The last columns fewer than 8.
+template <int rows>
+inline void sparse_block_fp16_tail(const float16_t* w,
+                                   const float16_t* b,
+                                   const int32_t* dmap,
+                                   uint32_t nnz,
+                                   const float16_t* bias,
+                                   float16_t* const* out,
+                                   int cols,
+                                   const SparseActFp16& act) {
+  float16_t acc[rows][8];
+  for (int r = 0; r < rows; r++) {
+    for (int c = 0; c < 8; c++) {
+      acc[r][c] = bias[r];
+    }
+  }
+  for (uint32_t j = 0; j < nnz; j++) {
+    for (int r = 0; r < rows; r++) {
+      for (int c = 0; c < cols; c++) {
+        acc[r][c] += w[r] * b[c];
+      }
+    }
+    b = next_input(b, dmap[j]);
+    w += rows;
+  }
+  for (int r = 0; r < rows; r++) {
+    vst1q_f16(acc[r], sparse_act(vld1q_f16(acc[r]), act));
+    for (int c = 0; c < cols; c++) {
+      out[r][c] = acc[r][c];
+    }
+  }
+}
+
+template <int rows>
+inline void sparse_row_fp16(const float16_t* w,
+                            const float16_t* b,
+                            const int32_t* dmap,
+                            uint32_t nnz,
+                            const float16_t* bias,
+                            float16_t* const* out,
+                            int ncols,
+                            const SparseActFp16& act) {
+  float16_t* cur_out[rows];
+  for (int r = 0; r < rows; r++) cur_out[r] = out[r];
+  int n = 0;
+  for (; n + 32 <= ncols; n += 32) {
+    sparse_block_fp16<4, rows>(w, b + n, dmap, nnz, bias, cur_out, act);
+    for (int r = 0; r < rows; r++) cur_out[r] += 32;
+  }
+  if (n + 16 <= ncols) {
+    sparse_block_fp16<2, rows>(w, b + n, dmap, nnz, bias, cur_out, act);
+    for (int r = 0; r < rows; r++) cur_out[r] += 16;
+    n += 16;
+  }
+  if (n + 8 <= ncols) {
+    sparse_block_fp16<1, rows>(w, b + n, dmap, nnz, bias, cur_out, act);
+    for (int r = 0; r < rows; r++) cur_out[r] += 8;
+    n += 8;
+  }
+  if (n < ncols) {
+    sparse_block_fp16_tail<rows>(
+        w, b + n, dmap, nnz, bias, cur_out, ncols - n, act);
+  }
+}
+
+// The input of the output channels starts from the input channel whose byte
+// offset is at the last diff of the channels before.
+inline const float16_t* row_input(const float16_t* B,
+                                  const int32_t* widx_dmap,
+                                  uint32_t nnz_before) {
+  if (nnz_before == 0) return B;
+  return B + widx_dmap[nnz_before - 1] / static_cast<int>(sizeof(float16_t));
+}
+}  // namespace
+
+// The columns are computed in the blocks of 256, so the input of a block
+// stays in cache for all the output channels.
+static const int kSparseBlockCols = 256;
+
+void sparse_conv_fp16_pipelined(const float16_t* A,
+                                const float16_t* B,
+                                const int32_t* widx_dmap,
+                                const uint32_t* nidx_nnzmap,
+                                const float16_t* bias,
+                                float16_t* output,
+                                int M,
+                                int K,
+                                int N,
+                                const operators::SparseConvParam& param,
+                                ARMContext* ctx) {
+  auto act = init_sparse_act(param.activation_param);
+  for (int n = 0; n < N; n += kSparseBlockCols) {
+    int ncols = std::min(kSparseBlockCols, N - n);
+    LITE_PARALLEL_COMMON_BEGIN(i, tid, M, 0, 1) {
+      // The weights of each output channel are padded to the multiple of 4.
+      const float16_t* cur_w = A;
+      uint32_t nnz = nidx_nnzmap[i];
+      const float16_t* cur_b = B;
+      const int32_t* dmap = widx_dmap;
+      if (i != 0) {
+        int cur_rem = nidx_nnzmap[i - 1] & 3;
+        if (cur_rem != 0) {
+          cur_rem = 4 - cur_rem;
+        }
+        nnz = nidx_nnzmap[i] - nidx_nnzmap[i - 1] - cur_rem;
+        cur_w = A + nidx_nnzmap[i - 1] + cur_rem;
+        cur_b = row_input(B, widx_dmap, nidx_nnzmap[i - 1]);
+        dmap = widx_dmap + nidx_nnzmap[i - 1] + cur_rem;
+      }
+      float16_t vbias = bias ? bias[i] : static_cast<float16_t>(0.f);
+      float16_t* out = output + i * N + n;
+      sparse_row_fp16<1>(cur_w, cur_b + n, dmap, nnz, &vbias, &out, ncols, act);
+    }
+    LITE_PARALLEL_COMMON_END();
+  }
+}
+
+void sparse_semi_conv_fp16_pipelined(const float16_t* A,
+                                     const float16_t* B,
+                                     const int32_t* widx_dmap,
+                                     const uint32_t* nidx_nnzmap,
+                                     const float16_t* bias,
+                                     float16_t* output,
+                                     int M,
+                                     int K,
+                                     int N,
+                                     const operators::SparseConvParam& param,
+                                     ARMContext* ctx) {
+  auto act = init_sparse_act(param.activation_param);
+  int pair_num = M / 2;
+  int lave_num = M % 2;
+  for (int n = 0; n < N; n += kSparseBlockCols) {
+    int ncols = std::min(kSparseBlockCols, N - n);
+    LITE_PARALLEL_COMMON_BEGIN(i, tid, pair_num + lave_num, 0, 1) {
+      // The blocks of 2 output channels, the last single one if M is odd.
+      const float16_t* cur_w = A;
+      uint32_t nnz = nidx_nnzmap[i];
+      const float16_t* cur_b = B;
+      const int32_t* dmap = widx_dmap;
+      if (i != 0) {
+        cur_w = A + nidx_nnzmap[i - 1] * 2;
+        nnz = nidx_nnzmap[i] - nidx_nnzmap[i - 1];
+        cur_b = row_input(B, widx_dmap, nidx_nnzmap[i - 1]);
+        dmap = widx_dmap + nidx_nnzmap[i - 1];
+      }
+      float16_t* out[2] = {output + 2 * i * N + n,
+                           output + (2 * i + 1) * N + n};
+      float16_t vbias[2] = {0.f, 0.f};
+      if (i < pair_num) {
+        if (bias) {
+          vbias[0] = bias[2 * i];
+          vbias[1] = bias[2 * i + 1];
+        }
+        sparse_row_fp16<2>(cur_w, cur_b + n, dmap, nnz, vbias, out, ncols, act);
+      } else {
+        if (bias) vbias[0] = bias[2 * i];
+        sparse_row_fp16<1>(cur_w, cur_b + n, dmap, nnz, vbias, out, ncols, act);
+      }
+    }
+    LITE_PARALLEL_COMMON_END();
+  }
+}
+
+}  // namespace fp16
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
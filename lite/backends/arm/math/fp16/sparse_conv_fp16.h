@@ -0,0 +1,61 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include "lite/core/context.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace fp16 {
+typedef __fp16 float16_t;
+
+// The fp16 version of sparse_conv_fp32_pipelined, the weights are packed in
+// the same layout, while the byte offsets in `widx_dmap` are of the fp16
+// input.
+void sparse_conv_fp16_pipelined(const float16_t* A,
+                                const float16_t* B,
+                                const int32_t* widx_dmap,
+                                const uint32_t* nidx_nnzmap,
+                                const float16_t* bias,
+                                float16_t* output,
+                                int M,
+                                int K,
+                                int N,
+                                const operators::SparseConvParam& param,
+                                ARMContext* ctx);
+
+// The fp16 version of sparse_semi_conv_fp32_pipelined, whose output channels
+// are in the blocks of 2.
+void sparse_semi_conv_fp16_pipelined(const float16_t* A,
+                                     const float16_t* B,
+                                     const int32_t* widx_dmap,
+                                     const uint32_t* nidx_nnzmap,
+                                     const float16_t* bias,
+                                     float16_t* output,
+                                     int M,
+                                     int K,
+                                     int N,
+                                     const operators::SparseConvParam& param,
+                                     ARMContext* ctx);
+
+}  // namespace fp16
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
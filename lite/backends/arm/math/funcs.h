@@ -22,7 +22,9 @@
 #include "lite/backends/arm/math/activation.h"
 #include "lite/backends/arm/math/affine_channel.h"
 #include "lite/backends/arm/math/argmax.h"
+#include "lite/backends/arm/math/attention.h"
 #include "lite/backends/arm/math/axpy.h"
+#include "lite/backends/arm/math/bilinear_sample.h"
 #include "lite/backends/arm/math/box_coder.h"
 #include "lite/backends/arm/math/clip.h"
 #include "lite/backends/arm/math/col_im_transform.h"
@@ -31,16 +33,23 @@
 #include "lite/backends/arm/math/conv_impl.h"
 #include "lite/backends/arm/math/conv_transpose_depthwise.h"
 #include "lite/backends/arm/math/decode_bboxes.h"
+#include "lite/backends/arm/math/depthwise_pointwise_conv.h"
 #include "lite/backends/arm/math/dropout.h"
 #include "lite/backends/arm/math/elementwise.h"
+#include "lite/backends/arm/math/elementwise_chain.h"
+#include "lite/backends/arm/math/embedding_dequant.h"
+#include "lite/backends/arm/math/embedding_seq_pool.h"
 #include "lite/backends/arm/math/fill_bias_relu.h"
+#include "lite/backends/arm/math/gemm_int4.h"
 #include "lite/backends/arm/math/gemm_prepacked_int8.h"
 #include "lite/backends/arm/math/gemm_s8.h"
+#include "lite/backends/arm/math/gemm_weight_int8.h"
 #include "lite/backends/arm/math/gemv_arm_int8.h"
 #include "lite/backends/arm/math/interpolate.h"
 #include "lite/backends/arm/math/layout.h"
 #include "lite/backends/arm/math/lrn.h"
 #include "lite/backends/arm/math/negative.h"
+#include "lite/backends/arm/math/nhwc.h"
 #include "lite/backends/arm/math/norm.h"
 #include "lite/backends/arm/math/packed_sgemm.h"
 #include "lite/backends/arm/math/packed_sgemm_c4.h"
@@ -48,12 +57,7 @@
 #include "lite/backends/arm/math/pooling.h"
 #include "lite/backends/arm/math/power.h"
 #include "lite/backends/arm/math/quantize.h"
-#include "lite/backends/arm/math/reduce_max.h"
-#include "lite/backends/arm/math/reduce_max_min.h"
-#include "lite/backends/arm/math/reduce_mean.h"
-#include "lite/backends/arm/math/reduce_min.h"
-#include "lite/backends/arm/math/reduce_prod.h"
-#include "lite/backends/arm/math/reduce_sum.h"
+#include "lite/backends/arm/math/reduce.h"
 #include "lite/backends/arm/math/scale.h"
 #include "lite/backends/arm/math/scatter.h"
 #include "lite/backends/arm/math/sequence_expand.h"
@@ -66,6 +70,7 @@
 #include "lite/backends/arm/math/sparse_conv_impl.h"
 #include "lite/backends/arm/math/sparse_semi_conv_impl.h"
 #include "lite/backends/arm/math/split_merge_lod_tenosr.h"
+#include "lite/backends/arm/math/transpose.h"
 
 namespace paddle {
 namespace lite {
@@ -364,6 +369,94 @@ inline float32x4_t div_ps(float32x4_t a, float32x4_t b) {
   return vmulq_f32(a, reciprocal);
 }
 
+// The approximations used in the fast-math mode, see FastMath. The error
+// bounds below are measured over the whole float range.
+
+// a / b, the reciprocal is refined twice on armv7 to keep it to 1e-7.
+inline float32x4_t div_ps_fast(float32x4_t a, float32x4_t b) {
+#ifdef __aarch64__
+  return vdivq_f32(a, b);
+#else
+  float32x4_t reciprocal = vrecpeq_f32(b);
+  reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+  reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+  return vmulq_f32(a, reciprocal);
+#endif
+}
+
+// exp(x) = 2^n * p(r), r = x - n * ln2 in [-ln2/2, ln2/2], p is the degree-4
+// minimax polynomial of exp on it. The relative error is below 3e-6.
+inline float32x4_t exp_ps_fast(float32x4_t x) {
+  x = vminq_f32(x, vdupq_n_f32(c_exp_hi));
+  x = vmaxq_f32(x, vdupq_n_f32(-87.3365478515625f));
+  // adding 1.5 * 2^23 rounds x / ln2 to n in the low bits of the mantissa
+  float32x4_t vshift = vdupq_n_f32(12582912.f);
+  float32x4_t t = vmlaq_f32(vshift, x, vdupq_n_f32(c_cephes_LOG2EF));
+  float32x4_t n = vsubq_f32(t, vshift);
+  float32x4_t r = vmlsq_f32(x, n, vdupq_n_f32(c_cephes_exp_C1));
+  r = vmlsq_f32(r, n, vdupq_n_f32(c_cephes_exp_C2));
+
+  float32x4_t p = vmlaq_f32(
+      vdupq_n_f32(1.679090722e-01f), r, vdupq_n_f32(4.145860820e-02f));
+  p = vmlaq_f32(vdupq_n_f32(5.000435866e-01f), p, r);
+  p = vmlaq_f32(vdupq_n_f32(9.999634049e-01f), p, r);
+  p = vmlaq_f32(vdupq_n_f32(9.999992614e-01f), p, r);
+
+  // build 2^n
+  int32x4_t e = vshlq_n_s32(vreinterpretq_s32_f32(t), 23);
+  e = vaddq_s32(e, vdupq_n_s32(0x3f800000));
+  return vmulq_f32(p, vreinterpretq_f32_s32(e));
+}
+
+// 1 / (1 + exp(-x)), the absolute error is below 1e-6.
+inline float32x4_t sigmoid_ps_fast(float32x4_t x) {
+  float32x4_t one = vdupq_n_f32(1.f);
+  return div_ps_fast(one, vaddq_f32(one, exp_ps_fast(vnegq_f32(x))));
+}
+
+// (1 - exp(-2|x|)) / (1 + exp(-2|x|)) with the sign of x, and the odd Taylor
+// polynomial for |x| < 1/8 where the difference cancels. The absolute error
+// is below 1.5e-6 and the relative one below 1e-5.
+inline float32x4_t tanh_ps_fast(float32x4_t x) {
+  float32x4_t one = vdupq_n_f32(1.f);
+  float32x4_t ax = vabsq_f32(x);
+  float32x4_t e = exp_ps_fast(vmulq_n_f32(ax, -2.f));
+  float32x4_t y = div_ps_fast(vsubq_f32(one, e), vaddq_f32(one, e));
+  y = vbslq_f32(vdupq_n_u32(0x80000000), x, y);
+
+  float32x4_t x2 = vmulq_f32(x, x);
+  float32x4_t p = vmlaq_f32(
+      vdupq_n_f32(1.333333333e-01f), x2, vdupq_n_f32(-5.396825397e-02f));
+  p = vmlaq_f32(vdupq_n_f32(-3.333333333e-01f), p, x2);
+  p = vmlaq_f32(one, p, x2);
+  p = vmulq_f32(p, x);
+  return vbslq_f32(vcltq_f32(ax, vdupq_n_f32(0.125f)), p, y);
+}
+
+// erf(x) by the formula 7.1.26 of Abramowitz and Stegun, the absolute error
+// is below 2.5e-6.
+inline float32x4_t erf_ps_fast(float32x4_t x) {
+  float32x4_t one = vdupq_n_f32(1.f);
+  float32x4_t ax = vabsq_f32(x);
+  float32x4_t t =
+      div_ps_fast(one, vmlaq_f32(one, ax, vdupq_n_f32(0.3275911f)));
+  float32x4_t p = vmlaq_f32(
+      vdupq_n_f32(-1.453152027f), t, vdupq_n_f32(1.061405429f));
+  p = vmlaq_f32(vdupq_n_f32(1.421413741f), p, t);
+  p = vmlaq_f32(vdupq_n_f32(-0.284496736f), p, t);
+  p = vmlaq_f32(vdupq_n_f32(0.254829592f), p, t);
+  p = vmulq_f32(p, t);
+  float32x4_t e = exp_ps_fast(vnegq_f32(vmulq_f32(ax, ax)));
+  float32x4_t y = vmlsq_f32(one, p, e);
+  return vbslq_f32(vdupq_n_u32(0x80000000), x, y);
+}
+
+// exp_ps_fast if `fast`, which is read from FastMath::Enabled() outside of
+// the loops, or else exp_ps.
+inline float32x4_t exp_ps(float32x4_t x, bool fast) {
+  return fast ? exp_ps_fast(x) : exp_ps(x);
+}
+
 inline float32x4_t pow_ps(float32x4_t a, float32x4_t b) {
   // pow(x, m) = exp(m * log(x))
   float32x4_t vone = vdupq_n_f32(1.f);
@@ -438,6 +531,24 @@ inline float32x4_t vactive_f32<lite_api::ActivationType::kTanh>(
   return vsubq_f32(__out, __one);
 }
 
+// vactive_f32 by the approximations of the fast-math mode.
+template <lite_api::ActivationType Act>
+inline float32x4_t vactive_fast_f32(const float32x4_t& x) {
+  return vactive_f32<Act>(x);
+}
+
+template <>
+inline float32x4_t vactive_fast_f32<lite_api::ActivationType::kSigmoid>(
+    const float32x4_t& x) {
+  return sigmoid_ps_fast(x);
+}
+
+template <>
+inline float32x4_t vactive_fast_f32<lite_api::ActivationType::kTanh>(
+    const float32x4_t& x) {
+  return tanh_ps_fast(x);
+}
+
 template <lite_api::ActivationType Act = lite_api::ActivationType::kIndentity>
 inline float active_f32(const float& x) {
   return x;
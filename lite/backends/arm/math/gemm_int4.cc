@@ -0,0 +1,179 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/gemm_int4.h"
+#include <arm_neon.h>
+#include <algorithm>
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+const int kMaxGroupSize = 256;
+
+int64_t packed_weight_int4_size(int n, int k, int group_size) {
+  int64_t groups = (k + group_size - 1) / group_size;
+  return n * groups * group_size / 2;
+}
+
+void pack_weight_int4(
+    const int8_t* weight, uint8_t* packed, int n, int k, int group_size) {
+  CHECK(group_size % 16 == 0 && group_size <= kMaxGroupSize)
+      << "The group size should be a multiple of 16 and at most "
+      << kMaxGroupSize;
+  int64_t row_bytes = packed_weight_int4_size(1, k, group_size);
+  for (int j = 0; j < n; j++) {
+    uint8_t* row = packed + j * row_bytes;
+    // the padded codes are zeros
+    std::fill(row, row + row_bytes, 0x88);
+    for (int i = 0; i < k; i++) {
+      int code = std::min(std::max(static_cast<int>(weight[i * n + j]), -7), 7);
+      code += 8;
+      row[i >> 1] = (i & 1) ? ((row[i >> 1] & 0x0F) | (code << 4))
+                            : ((row[i >> 1] & 0xF0) | code);
+    }
+  }
+}
+
+// vout[0:4] = the 16 values of the codes in 8 bytes
+static inline void unpack_int4x16(const uint8_t* codes, float32x4_t* vout) {
+  uint8x8_t vin = vld1_u8(codes);
+  uint8x8x2_t vzip =
+      vzip_u8(vand_u8(vin, vdup_n_u8(0x0F)), vshr_n_u8(vin, 4));
+  uint16x8_t vin_l = vmovl_u8(vzip.val[0]);
+  uint16x8_t vin_h = vmovl_u8(vzip.val[1]);
+  float32x4_t vzero = vdupq_n_f32(8.f);
+  vout[0] = vsubq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(vin_l))), vzero);
+  vout[1] = vsubq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(vin_l))), vzero);
+  vout[2] = vsubq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(vin_h))), vzero);
+  vout[3] = vsubq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(vin_h))), vzero);
+}
+
+static inline float int4_value(const uint8_t* codes, int i) {
+  return static_cast<float>(((codes[i >> 1] >> ((i & 1) * 4)) & 0x0F) - 8);
+}
+
+static inline float reduce_add(float32x4_t v) {
+#ifdef __aarch64__
+  return vaddvq_f32(v);
+#else
+  float32x2_t vsum = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+  return vget_lane_f32(vpadd_f32(vsum, vsum), 0);
+#endif
+}
+
+// dot(x[0:len], the values of the codes) without the scale
+static inline float dot_int4(const float* x, const uint8_t* codes, int len) {
+  float32x4_t vacc0 = vdupq_n_f32(0.f);
+  float32x4_t vacc1 = vdupq_n_f32(0.f);
+  float32x4_t vw[4];
+  int i = 0;
+  for (; i + 15 < len; i += 16) {
+    unpack_int4x16(codes + (i >> 1), vw);
+    vacc0 = vmlaq_f32(vacc0, vld1q_f32(x + i), vw[0]);
+    vacc1 = vmlaq_f32(vacc1, vld1q_f32(x + i + 4), vw[1]);
+    vacc0 = vmlaq_f32(vacc0, vld1q_f32(x + i + 8), vw[2]);
+    vacc1 = vmlaq_f32(vacc1, vld1q_f32(x + i + 12), vw[3]);
+  }
+  float sum = reduce_add(vaddq_f32(vacc0, vacc1));
+  for (; i < len; i++) {
+    sum += x[i] * int4_value(codes, i);
+  }
+  return sum;
+}
+
+// dot(x[0:len], w[0:len])
+static inline float dot_fp32(const float* x, const float* w, int len) {
+  float32x4_t vacc0 = vdupq_n_f32(0.f);
+  float32x4_t vacc1 = vdupq_n_f32(0.f);
+  int i = 0;
+  for (; i + 7 < len; i += 8) {
+    vacc0 = vmlaq_f32(vacc0, vld1q_f32(x + i), vld1q_f32(w + i));
+    vacc1 = vmlaq_f32(vacc1, vld1q_f32(x + i + 4), vld1q_f32(w + i + 4));
+  }
+  float sum = reduce_add(vaddq_f32(vacc0, vacc1));
+  for (; i < len; i++) {
+    sum += x[i] * w[i];
+  }
+  return sum;
+}
+
+void gemm_int4(const float* x,
+               const uint8_t* packed,
+               const float* scales,
+               const float* bias,
+               float* out,
+               int m,
+               int n,
+               int k,
+               int group_size,
+               bool flag_relu) {
+  const int groups = (k + group_size - 1) / group_size;
+  const int64_t row_bytes = groups * group_size / 2;
+  LITE_PARALLEL_BEGIN(j, tid, n) {
+    const uint8_t* w_row = packed + j * row_bytes;
+    if (m == 1) {
+      // gemv, the codes are dequantized in the registers
+      float sum = 0.f;
+      for (int g = 0; g < groups; g++) {
+        int start = g * group_size;
+        int len = std::min(group_size, k - start);
+        sum += scales[g * n + j] * dot_int4(x + start, w_row + start / 2, len);
+      }
+      sum += bias ? bias[j] : 0.f;
+      out[j] = flag_relu ? std::max(sum, 0.f) : sum;
+    } else {
+      // the group is dequantized once for all the rows of x
+      float w_buf[kMaxGroupSize];
+      for (int i = 0; i < m; i++) {
+        out[i * n + j] = bias ? bias[j] : 0.f;
+      }
+      for (int g = 0; g < groups; g++) {
+        int start = g * group_size;
+        int len = std::min(group_size, k - start);
+        const uint8_t* codes = w_row + start / 2;
+        float32x4_t vscale = vdupq_n_f32(scales[g * n + j]);
+        float32x4_t vw[4];
+        int l = 0;
+        for (; l + 15 < len; l += 16) {
+          unpack_int4x16(codes + (l >> 1), vw);
+          vst1q_f32(w_buf + l, vmulq_f32(vw[0], vscale));
+          vst1q_f32(w_buf + l + 4, vmulq_f32(vw[1], vscale));
+          vst1q_f32(w_buf + l + 8, vmulq_f32(vw[2], vscale));
+          vst1q_f32(w_buf + l + 12, vmulq_f32(vw[3], vscale));
+        }
+        for (; l < len; l++) {
+          w_buf[l] = scales[g * n + j] * int4_value(codes, l);
+        }
+        for (int i = 0; i < m; i++) {
+          out[i * n + j] += dot_fp32(x + i * k + start, w_buf, len);
+        }
+      }
+      if (flag_relu) {
+        for (int i = 0; i < m; i++) {
+          out[i * n + j] = std::max(out[i * n + j], 0.f);
+        }
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,49 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstdint>
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// The int4 weights are quantized group-wise along K, of which the values in
+// [-7, 7] are stored as int8 in [K, N] with the scales in [groups, N].
+
+// The bytes of the packed weight [N, groups * group_size / 2], in which the
+// codes of the values + 8 are stored two in a byte, the low nibble first.
+int64_t packed_weight_int4_size(int n, int k, int group_size);
+
+void pack_weight_int4(
+    const int8_t* weight, uint8_t* packed, int n, int k, int group_size);
+
+// out[M, N] = x[M, K] * weight[K, N] (+ bias) (relu), the weight is
+// dequantized in the inner loop of the dot products.
+void gemm_int4(const float* x,
+               const uint8_t* packed,
+               const float* scales,
+               const float* bias,
+               float* out,
+               int m,
+               int n,
+               int k,
+               int group_size,
+               bool flag_relu);
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
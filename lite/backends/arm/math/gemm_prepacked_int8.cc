@@ -14,6 +14,8 @@
 
 #include "lite/backends/arm/math/gemm_prepacked_int8.h"
 #include <arm_neon.h>
+#include <algorithm>
+#include "lite/backends/arm/math/saturate.h"
 #include "lite/core/parallel_defines.h"
 #ifdef __aarch64__
 #include "lite/backends/arm/math/dotprod/gemm_sdot.h"
@@ -123,6 +125,17 @@ void prepackA_m6k4_trans_int8(int8_t* out,
                               int kmax);
 #endif
 
+#if defined(WITH_ARM_I8MM) && defined(__aarch64__)
+void pack_smmla_int8(int8_t* out,
+                     const int8_t* in,
+                     int ldin,
+                     int r0,
+                     int rmax,
+                     int k0,
+                     int kmax,
+                     bool k_contiguous);
+#endif
+
 void prepackA_int8(void* out,
                    const void* in,
                    int ldin,
@@ -133,6 +146,20 @@ void prepackA_int8(void* out,
                    bool is_trans,
                    ARMContext* ctx) {
 #ifdef __aarch64__
+#ifdef WITH_ARM_I8MM
+  if (ctx->has_i8mm()) {
+    // the A of M x K is packed as the B of N x K in smmla
+    pack_smmla_int8(static_cast<int8_t*>(out),
+                    static_cast<const int8_t*>(in),
+                    ldin,
+                    m0,
+                    mmax,
+                    k0,
+                    kmax,
+                    !is_trans);
+    return;
+  }
+#endif
   if (ctx->has_dot()) {
 #ifdef WITH_ARM_DOTPROD
     if (is_trans) {
@@ -227,7 +254,7 @@ void prepackA_int8(TensorLite* tout,
   int hblock = get_hblock_int8(ctx);
   int m_roundup = ROUNDUP(m, hblock);
   // round up to 128 bits
-  int kup = ROUNDUP(k, KBLOCK_INT8);
+  int kup = ROUNDUP(k, get_kblock_int8(ctx));
   int group_size_round_up = ((m_roundup * kup + 15) / 16) * 16;
 
   if (tout->numel() < group_size_round_up * group) {
@@ -4258,12 +4285,16 @@ void gemm_prepack_oth_int8(const int8_t* A_packed,
       packb_int8(b_pannel, B, N, 0, K, x0, xmax, zerobuf);
     }
 
-    LITE_PARALLEL_COMMON_BEGIN(y, tid, M, 0, MBLOCK_INT8_OTH) {
+    // split N into tiles as well when M is too small to feed all threads
+    int x_tile = ParallelTileSize(
+        (M + MBLOCK_INT8_OTH - 1) / MBLOCK_INT8_OTH, bblocks, threads);
+    LITE_PARALLEL_COMMON_2D_BEGIN(
+        y, xt, tid, M, 0, MBLOCK_INT8_OTH, bblocks, 0, x_tile, 1) {
       Dtype out0[NBLOCK_INT8_OTH] = {0};
       Dtype out1[NBLOCK_INT8_OTH] = {0};
       Dtype out2[NBLOCK_INT8_OTH] = {0};
       Dtype out3[NBLOCK_INT8_OTH] = {0};
-      Dtype* c_ptr0 = C + y * N + x0;
+      Dtype* c_ptr0 = C + y * N + x0 + xt * NBLOCK_INT8_OTH;
       Dtype* c_ptr1 = c_ptr0 + N;
       Dtype* c_ptr2 = c_ptr1 + N;
       Dtype* c_ptr3 = c_ptr2 + N;
@@ -4312,20 +4343,22 @@ void gemm_prepack_oth_int8(const int8_t* A_packed,
         }
       }
       if (y + MBLOCK_INT8_OTH > M) {
+        Dtype* trash_tile = trash_ptr + xt * NBLOCK_INT8_OTH;
         switch (y + MBLOCK_INT8_OTH - M) {
           case 3:
-            c_ptr1 = trash_ptr;
+            c_ptr1 = trash_tile;
           case 2:
-            c_ptr2 = trash_ptr;
+            c_ptr2 = trash_tile;
           case 1:
-            c_ptr3 = trash_ptr;
+            c_ptr3 = trash_tile;
           default:
             break;
         }
       }
       const int8_t* a_ptr_l = A_packed + y * KUP;
-      const int8_t* b_ptr = b_pannel;
-      for (int xb = 0; xb < bblocks; xb++) {
+      const int8_t* b_ptr = b_pannel + xt * KUP * NBLOCK_INT8_OTH;
+      int xt_end = std::min(xt + x_tile, bblocks);
+      for (int xb = xt; xb < xt_end; xb++) {
         if (flag_rem && (xb == bblocks - 1)) {
           tmp0 = c_ptr0;
           tmp1 = c_ptr1;
@@ -4358,7 +4391,7 @@ void gemm_prepack_oth_int8(const int8_t* A_packed,
         }
       }
     }
-    LITE_PARALLEL_COMMON_END();
+    LITE_PARALLEL_COMMON_2D_END();
   }
   free(zerobuf);
 }
@@ -7418,6 +7451,296 @@ void gemm_prepack_vsdot_int8(const int8_t* A_packed,
 #endif
 #endif  // dotprod  //NOLINT
 
+#if defined(WITH_ARM_I8MM) && defined(__aarch64__)
+// Pack the 8 rows of the R x K matrix, the 8 int8 of a row in K are
+// contiguous, and the rows are stored in pairs for smmla:
+// r0k0-7, r1k0-7, r2k0-7, ..., r7k0-7, r0k8-15, ...
+// The rows out of [r0, rmax) and K out of [k0, kmax) are padded with zeros.
+// `k_contiguous` is whether the elements of a row are contiguous in `in`.
+void pack_smmla_int8(int8_t* out,
+                     const int8_t* in,
+                     int ldin,
+                     int r0,
+                     int rmax,
+                     int k0,
+                     int kmax,
+                     bool k_contiguous) {
+  int kup = ROUNDUP(kmax - k0, KBLOCK_INT8_MMLA);
+  for (int r = r0; r < rmax; r += MBLOCK_INT8_MMLA) {
+    for (int k = k0; k < k0 + kup; k += KBLOCK_INT8_MMLA) {
+      for (int i = r; i < r + MBLOCK_INT8_MMLA; i++) {
+        for (int j = k; j < k + KBLOCK_INT8_MMLA; j++) {
+          if (i >= rmax || j >= kmax) {
+            *out++ = 0;
+          } else {
+            *out++ = k_contiguous ? in[i * ldin + j] : in[j * ldin + i];
+          }
+        }
+      }
+    }
+  }
+}
+
+// clang-format off
+// smmla vd.4s, vn.16b, vm.16b, which is emitted as the machine code for the
+// toolchains without armv8.6. vd += [n0; n1] * [m0; m1]^T, where n0, n1, m0
+// and m1 are the halves of 8 int8 of vn and vm, and vd is the 2x2 int32.
+#define SMMLA(vd, vn, vm) \
+  ".inst 0x4e80a400 | (" #vm " << 16) | (" #vn " << 5) | " #vd "\n"
+
+// the 8x8 int32 tile of C computed with the 4 row pairs of A in v0-v3 and the
+// 4 col pairs of B in v4-v7, the 2x2 block of C of row pair i and col pair j
+// is accumulated in v(8 + 4 * i + j).
+#define GEMM_SMMLA_INT8_KERNEL_8x8                                 \
+  "eor    v8.16b,  v8.16b,  v8.16b\n"                              \
+  "eor    v9.16b,  v9.16b,  v9.16b\n"                              \
+  "eor    v10.16b, v10.16b, v10.16b\n"                             \
+  "eor    v11.16b, v11.16b, v11.16b\n"                             \
+  "eor    v12.16b, v12.16b, v12.16b\n"                             \
+  "eor    v13.16b, v13.16b, v13.16b\n"                             \
+  "eor    v14.16b, v14.16b, v14.16b\n"                             \
+  "eor    v15.16b, v15.16b, v15.16b\n"                             \
+  "eor    v16.16b, v16.16b, v16.16b\n"                             \
+  "eor    v17.16b, v17.16b, v17.16b\n"                             \
+  "eor    v18.16b, v18.16b, v18.16b\n"                             \
+  "eor    v19.16b, v19.16b, v19.16b\n"                             \
+  "eor    v20.16b, v20.16b, v20.16b\n"                             \
+  "eor    v21.16b, v21.16b, v21.16b\n"                             \
+  "eor    v22.16b, v22.16b, v22.16b\n"                             \
+  "eor    v23.16b, v23.16b, v23.16b\n"                             \
+  "cbz    %w[k], 2f\n"                 /* check loop count > 0 */  \
+  "1:\n"                               /* main loop */             \
+  "ld1    {v0.16b, v1.16b, v2.16b, v3.16b}, [%[a_ptr]], #64\n"     \
+  "ld1    {v4.16b, v5.16b, v6.16b, v7.16b}, [%[b_ptr]], #64\n"     \
+  "prfm   pldl1keep, [%[a_ptr], #128]\n"                           \
+  "prfm   pldl1keep, [%[b_ptr], #128]\n"                           \
+  SMMLA(8, 0, 4)  SMMLA(9, 0, 5)  SMMLA(10, 0, 6) SMMLA(11, 0, 7)  \
+  SMMLA(12, 1, 4) SMMLA(13, 1, 5) SMMLA(14, 1, 6) SMMLA(15, 1, 7)  \
+  SMMLA(16, 2, 4) SMMLA(17, 2, 5) SMMLA(18, 2, 6) SMMLA(19, 2, 7)  \
+  SMMLA(20, 3, 4) SMMLA(21, 3, 5) SMMLA(22, 3, 6) SMMLA(23, 3, 7)  \
+  "subs   %w[k], %w[k], #1\n"                                      \
+  "bne    1b\n"                                                    \
+  "2:\n"                                                           \
+  "st1    {v8.4s, v9.4s, v10.4s, v11.4s}, [%[c_ptr]], #64\n"       \
+  "st1    {v12.4s, v13.4s, v14.4s, v15.4s}, [%[c_ptr]], #64\n"     \
+  "st1    {v16.4s, v17.4s, v18.4s, v19.4s}, [%[c_ptr]], #64\n"     \
+  "st1    {v20.4s, v21.4s, v22.4s, v23.4s}, [%[c_ptr]], #64\n"
+// clang-format on
+
+inline void gemm_smmla_int8_kernel_8x8(const int8_t* a_ptr,
+                                       const int8_t*& b_ptr,  // NOLINT
+                                       int32_t* c_ptr,
+                                       int k) {
+  // clang-format off
+  asm volatile(GEMM_SMMLA_INT8_KERNEL_8x8
+               : [a_ptr] "+r"(a_ptr),
+                 [b_ptr] "+r"(b_ptr),
+                 [k] "+r"(k),
+                 [c_ptr] "+r"(c_ptr)
+               :
+               : "cc", "memory", "v0", "v1", "v2", "v3", "v4", "v5",
+                 "v6", "v7", "v8", "v9", "v10", "v11", "v12", "v13",
+                 "v14", "v15", "v16", "v17", "v18", "v19", "v20",
+                 "v21", "v22", "v23");
+  // clang-format on
+}
+
+inline float32x4_t gemm_smmla_act(float32x4_t x,
+                                  int flag_act,
+                                  const float* alpha) {
+  float32x4_t vzero = vdupq_n_f32(0.f);
+  switch (flag_act) {
+    case 0x01:  // relu
+      return vmaxq_f32(x, vzero);
+    case 0x02:  // relu6
+      return vminq_f32(vmaxq_f32(x, vzero), vdupq_n_f32(alpha[0]));
+    case 0x03:  // leaky relu
+      return vbslq_f32(
+          vcgeq_f32(x, vzero), x, vmulq_f32(x, vdupq_n_f32(alpha[0])));
+    case 0x04: {  // hard swish
+      float32x4_t offset = vaddq_f32(x, vdupq_n_f32(alpha[4]));
+      offset = vminq_f32(vmaxq_f32(offset, vzero), vdupq_n_f32(alpha[8]));
+      return vmulq_f32(vmulq_f32(x, vdupq_n_f32(alpha[0])), offset);
+    }
+    default:
+      return x;
+  }
+}
+
+// Write the n (<= 8) outputs of a row of the tile, the int32 ones are the
+// raw sums, the others are scaled, biased and activated.
+template <typename Dtype>
+inline void gemm_smmla_int8_write_row(int32x4_t v0,
+                                      int32x4_t v1,
+                                      Dtype* c,
+                                      int n,
+                                      float bias,
+                                      float scale,
+                                      int flag_act,
+                                      const float* alpha);
+
+template <>
+inline void gemm_smmla_int8_write_row(int32x4_t v0,
+                                      int32x4_t v1,
+                                      int32_t* c,
+                                      int n,
+                                      float bias,
+                                      float scale,
+                                      int flag_act,
+                                      const float* alpha) {
+  int32_t out[8];
+  int32_t* dst = n == NBLOCK_INT8_MMLA ? c : out;
+  vst1q_s32(dst, v0);
+  vst1q_s32(dst + 4, v1);
+  for (int i = 0; dst == out && i < n; i++) c[i] = out[i];
+}
+
+template <>
+inline void gemm_smmla_int8_write_row(int32x4_t v0,
+                                      int32x4_t v1,
+                                      float* c,
+                                      int n,
+                                      float bias,
+                                      float scale,
+                                      int flag_act,
+                                      const float* alpha) {
+  float32x4_t vbias = vdupq_n_f32(bias);
+  float32x4_t vscale = vdupq_n_f32(scale);
+  float32x4_t f0 = vmlaq_f32(vbias, vcvtq_f32_s32(v0), vscale);
+  float32x4_t f1 = vmlaq_f32(vbias, vcvtq_f32_s32(v1), vscale);
+  f0 = gemm_smmla_act(f0, flag_act, alpha);
+  f1 = gemm_smmla_act(f1, flag_act, alpha);
+  float out[8];
+  float* dst = n == NBLOCK_INT8_MMLA ? c : out;
+  vst1q_f32(dst, f0);
+  vst1q_f32(dst + 4, f1);
+  for (int i = 0; dst == out && i < n; i++) c[i] = out[i];
+}
+
+template <>
+inline void gemm_smmla_int8_write_row(int32x4_t v0,
+                                      int32x4_t v1,
+                                      int8_t* c,
+                                      int n,
+                                      float bias,
+                                      float scale,
+                                      int flag_act,
+                                      const float* alpha) {
+  float32x4_t vbias = vdupq_n_f32(bias);
+  float32x4_t vscale = vdupq_n_f32(scale);
+  float32x4_t vmin = vdupq_n_f32(-127.f);
+  float32x4_t f0 = vmlaq_f32(vbias, vcvtq_f32_s32(v0), vscale);
+  float32x4_t f1 = vmlaq_f32(vbias, vcvtq_f32_s32(v1), vscale);
+  f0 = vmaxq_f32(gemm_smmla_act(f0, flag_act, alpha), vmin);
+  f1 = vmaxq_f32(gemm_smmla_act(f1, flag_act, alpha), vmin);
+  int16x8_t s16 = vcombine_s16(vqmovn_s32(vcvtaq_s32_f32(f0)),
+                               vqmovn_s32(vcvtaq_s32_f32(f1)));
+  int8x8_t s8 = vqmovn_s16(s16);
+  int8_t out[8];
+  int8_t* dst = n == NBLOCK_INT8_MMLA ? c : out;
+  vst1_s8(dst, s8);
+  for (int i = 0; dst == out && i < n; i++) c[i] = out[i];
+}
+
+template <typename Dtype>
+void gemm_prepack_smmla_int8(const int8_t* A_packed,
+                             const int8_t* B,
+                             const float* bias,
+                             Dtype* C,
+                             int M,
+                             int N,
+                             int K,
+                             bool is_bias,
+                             int flag_act,
+                             bool is_transB,
+                             const float* scale,
+                             const float* alpha,
+                             ARMContext* ctx) {
+  size_t llc_size = ctx->llc_size() / 4;
+  auto workspace = ctx->workspace_data<int8_t>();
+  int kup = ROUNDUP(K, KBLOCK_INT8_MMLA);
+  //! MBLOCK_INT8_MMLA * x (result) + MBLOCK_INT8_MMLA * k (A) + x * k (B) = l2
+  int x_block = (static_cast<int>(llc_size) - (MBLOCK_INT8_MMLA * kup)) /
+                (kup + MBLOCK_INT8_MMLA);
+  x_block /= NBLOCK_INT8_MMLA;
+  x_block *= NBLOCK_INT8_MMLA;
+  x_block = x_block < NBLOCK_INT8_MMLA ? NBLOCK_INT8_MMLA : x_block;
+
+  int x_num = (N + (x_block - 1)) / x_block;
+  x_block = (N + x_num - 1) / x_num;
+  x_block = ROUNDUP(x_block, NBLOCK_INT8_MMLA);
+
+  //! apanel is pre_compute outside gemm
+  for (int x0 = 0; x0 < N; x0 += x_block) {
+    int xmax = x0 + x_block;
+    xmax = (xmax > N) ? N : xmax;
+    int bblocks = (xmax - x0 + NBLOCK_INT8_MMLA - 1) / NBLOCK_INT8_MMLA;
+    //! load bpanel
+    auto b_pannel = static_cast<int8_t*>(workspace);
+    if (!is_transB) {
+      // K * N
+      pack_smmla_int8(b_pannel, B, N, x0, xmax, 0, K, false);
+    } else {
+      // N X K
+      pack_smmla_int8(b_pannel, B, K, x0, xmax, 0, K, true);
+    }
+
+    LITE_PARALLEL_COMMON_BEGIN(y, tid, M, 0, MBLOCK_INT8_MMLA) {
+      int ymax = y + MBLOCK_INT8_MMLA;
+      ymax = (ymax > M) ? M : ymax;
+      float bias_local[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+      float scale_local[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+      for (int i = y; i < ymax; i++) {
+        if (is_bias) bias_local[i - y] = bias[i];
+        if (scale) scale_local[i - y] = scale[i];
+      }
+      const int8_t* a_ptr = A_packed + y * kup;
+      const int8_t* b_ptr = b_pannel;
+      int32_t tile[MBLOCK_INT8_MMLA * NBLOCK_INT8_MMLA];
+      for (int xb = 0; xb < bblocks; xb++) {
+        gemm_smmla_int8_kernel_8x8(
+            a_ptr, b_ptr, tile, kup / KBLOCK_INT8_MMLA);
+        int x = x0 + xb * NBLOCK_INT8_MMLA;
+        int n = xmax - x;
+        n = n > NBLOCK_INT8_MMLA ? NBLOCK_INT8_MMLA : n;
+        // the 2x2 blocks of a row pair are unzipped into the two rows
+        for (int i = 0; i < MBLOCK_INT8_MMLA / 2; i++) {
+          int64x2_t c0 = vreinterpretq_s64_s32(vld1q_s32(tile + i * 16));
+          int64x2_t c1 = vreinterpretq_s64_s32(vld1q_s32(tile + i * 16 + 4));
+          int64x2_t c2 = vreinterpretq_s64_s32(vld1q_s32(tile + i * 16 + 8));
+          int64x2_t c3 = vreinterpretq_s64_s32(vld1q_s32(tile + i * 16 + 12));
+          int r = 2 * i;
+          if (y + r < ymax) {
+            gemm_smmla_int8_write_row<Dtype>(
+                vreinterpretq_s32_s64(vzip1q_s64(c0, c1)),
+                vreinterpretq_s32_s64(vzip1q_s64(c2, c3)),
+                C + (y + r) * N + x,
+                n,
+                bias_local[r],
+                scale_local[r],
+                flag_act,
+                alpha);
+          }
+          if (y + r + 1 < ymax) {
+            gemm_smmla_int8_write_row<Dtype>(
+                vreinterpretq_s32_s64(vzip2q_s64(c0, c1)),
+                vreinterpretq_s32_s64(vzip2q_s64(c2, c3)),
+                C + (y + r + 1) * N + x,
+                n,
+                bias_local[r + 1],
+                scale_local[r + 1],
+                flag_act,
+                alpha);
+          }
+        }
+      }
+    }
+    LITE_PARALLEL_COMMON_END();
+  }
+}
+#undef SMMLA
+#endif  // WITH_ARM_I8MM && __aarch64__
+
 template <typename dtype>
 void gemm_prepack_int8(const int8_t* A_packed,
                        const int8_t* B,
@@ -7465,6 +7788,12 @@ void gemm_prepack_int8(const int8_t* A_packed,
 #define IN_PARAMS \
   A_packed, B, bias, C, M, N, K, is_bias, flag_act, is_transB, scale, alpha, ctx
 #ifdef __aarch64__
+#ifdef WITH_ARM_I8MM
+  if (ctx->has_i8mm()) {
+    gemm_prepack_smmla_int8<dtype>(IN_PARAMS);
+    return;
+  }
+#endif
   if (ctx->has_dot()) {
 #ifdef WITH_ARM_DOTPROD
     gemm_prepack_sdot_int8<dtype>(IN_PARAMS);
@@ -7503,6 +7832,153 @@ GEMM_PREPACK_INT8(int32_t);
 #undef IN_PARAMS
 #undef GEMM_PREPACK_INT8
 
+inline float32x4_t residual_act(float32x4_t v,
+                                int flag_act,
+                                const float32x4_t* valpha) {
+  float32x4_t vzero = vdupq_n_f32(0.f);
+  switch (flag_act) {
+    case 1:
+      return vmaxq_f32(v, vzero);
+    case 2:
+      return vminq_f32(vmaxq_f32(v, vzero), valpha[0]);
+    case 3:
+      return vbslq_f32(vcgeq_f32(v, vzero), v, vmulq_f32(v, valpha[0]));
+    case 4: {
+      float32x4_t voffset = vaddq_f32(v, valpha[1]);
+      float32x4_t vclip = vminq_f32(vmaxq_f32(voffset, vzero), valpha[2]);
+      return vmulq_f32(vmulq_f32(v, valpha[0]), vclip);
+    }
+    default:
+      return v;
+  }
+}
+
+inline float residual_act(float v, int flag_act, const float* alpha) {
+  switch (flag_act) {
+    case 1:
+      return std::max(v, 0.f);
+    case 2:
+      return std::min(std::max(v, 0.f), alpha[0]);
+    case 3:
+      return v >= 0.f ? v : v * alpha[0];
+    case 4:
+      return v * alpha[0] * std::min(std::max(v + alpha[1], 0.f), alpha[2]);
+    default:
+      return v;
+  }
+}
+
+template <typename dtype>
+inline void residual_store(dtype* dout, float32x4_t v0, float32x4_t v1);
+
+template <>
+inline void residual_store(float* dout, float32x4_t v0, float32x4_t v1) {
+  vst1q_f32(dout, v0);
+  vst1q_f32(dout + 4, v1);
+}
+
+template <>
+inline void residual_store(int8_t* dout, float32x4_t v0, float32x4_t v1) {
+#ifdef __aarch64__
+  int32x4_t vi0 = vcvtaq_s32_f32(v0);
+  int32x4_t vi1 = vcvtaq_s32_f32(v1);
+#else
+  // round half away from zero
+  float32x4_t vzero = vdupq_n_f32(0.f);
+  float32x4_t vpos = vdupq_n_f32(0.5f);
+  float32x4_t vneg = vdupq_n_f32(-0.5f);
+  int32x4_t vi0 = vcvtq_s32_f32(
+      vaddq_f32(v0, vbslq_f32(vcgeq_f32(v0, vzero), vpos, vneg)));
+  int32x4_t vi1 = vcvtq_s32_f32(
+      vaddq_f32(v1, vbslq_f32(vcgeq_f32(v1, vzero), vpos, vneg)));
+#endif
+  int16x8_t vs = vcombine_s16(vqmovn_s32(vi0), vqmovn_s32(vi1));
+  int8x8_t vout = vmax_s8(vqmovn_s16(vs), vdup_n_s8(-127));
+  vst1_s8(dout, vout);
+}
+
+inline void residual_store(float* dout, float v) { *dout = v; }
+
+inline void residual_store(int8_t* dout, float v) {
+  *dout = std::max(saturate_cast<int8_t>(roundf(v)), static_cast<int8_t>(-127));
+}
+
+template <typename dtype>
+void gemm_int8_add_residual(const float* din,
+                            const int8_t* residual,
+                            dtype* dout,
+                            float residual_scale,
+                            const operators::ActivationParam& act_param,
+                            int size,
+                            ARMContext* ctx) {
+  auto act_type = act_param.active_type;
+  float alpha[3] = {0.f, 0.f, 0.f};
+  int flag_act = 0x00;  // relu: 1, relu6: 2, leakey: 3, hard_swish: 4
+  if (act_param.has_active) {
+    if (act_type == lite_api::ActivationType::kRelu) {
+      flag_act = 0x01;
+    } else if (act_type == lite_api::ActivationType::kRelu6) {
+      flag_act = 0x02;
+      alpha[0] = act_param.Relu_clipped_coef;
+    } else if (act_type == lite_api::ActivationType::kLeakyRelu) {
+      flag_act = 0x03;
+      alpha[0] = act_param.Leaky_relu_alpha;
+    } else if (act_type == lite_api::ActivationType::kHardSwish) {
+      flag_act = 0x04;
+      alpha[0] = 1.f / act_param.hard_swish_scale;
+      alpha[1] = act_param.hard_swish_offset;
+      alpha[2] = act_param.hard_swish_threshold;
+    } else {
+      LOG(FATAL) << "The int8 conv fused with the residual does not support "
+                    "the activation type "
+                 << static_cast<int>(act_type);
+    }
+  }
+  float32x4_t valpha[3] = {
+      vdupq_n_f32(alpha[0]), vdupq_n_f32(alpha[1]), vdupq_n_f32(alpha[2])};
+  float32x4_t vscale = vdupq_n_f32(residual_scale);
+  // Each thread handles the blocks of 1024 elements.
+  const int kBlock = 1024;
+  int cnt = (size + kBlock - 1) / kBlock;
+  LITE_PARALLEL_BEGIN(i, tid, cnt) {
+    int start = i * kBlock;
+    int end = std::min(start + kBlock, size);
+    int j = start;
+    for (; j + 8 <= end; j += 8) {
+      int16x8_t vr = vmovl_s8(vld1_s8(residual + j));
+      float32x4_t vr0 = vcvtq_f32_s32(vmovl_s16(vget_low_s16(vr)));
+      float32x4_t vr1 = vcvtq_f32_s32(vmovl_s16(vget_high_s16(vr)));
+      float32x4_t v0 = vmlaq_f32(vld1q_f32(din + j), vr0, vscale);
+      float32x4_t v1 = vmlaq_f32(vld1q_f32(din + j + 4), vr1, vscale);
+      residual_store(dout + j,
+                     residual_act(v0, flag_act, valpha),
+                     residual_act(v1, flag_act, valpha));
+    }
+    for (; j < end; j++) {
+      float v = din[j] + residual[j] * residual_scale;
+      residual_store(dout + j, residual_act(v, flag_act, alpha));
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+template void gemm_int8_add_residual<int8_t>(
+    const float* din,
+    const int8_t* residual,
+    int8_t* dout,
+    float residual_scale,
+    const operators::ActivationParam& act_param,
+    int size,
+    ARMContext* ctx);
+template void gemm_int8_add_residual<float>(
+    const float* din,
+    const int8_t* residual,
+    float* dout,
+    float residual_scale,
+    const operators::ActivationParam& act_param,
+    int size,
+    ARMContext* ctx);
+
 }  // namespace math
 }  // namespace arm
 }  // namespace lite
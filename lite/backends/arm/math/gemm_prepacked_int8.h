@@ -34,7 +34,18 @@ const int NBLOCK_INT8_OTH = 16;
 const int MBLOCK_INT8_DOT = 8;
 const int NBLOCK_INT8_DOT = 12;
 
+// for the int8 matrix multiplication (smmla) of armv8.6, the rows of A and
+// the cols of B are packed in pairs of 8 int8.
+const int MBLOCK_INT8_MMLA = 8;
+const int NBLOCK_INT8_MMLA = 8;
+const int KBLOCK_INT8_MMLA = 8;
+
 inline int get_hblock_int8(ARMContext* ctx) {
+#ifdef WITH_ARM_I8MM
+  if (ctx->has_i8mm()) {
+    return MBLOCK_INT8_MMLA;
+  }
+#endif
 #ifdef WITH_ARM_DOTPROD
   if (ctx->has_dot()) {
     return MBLOCK_INT8_DOT;
@@ -45,6 +56,16 @@ inline int get_hblock_int8(ARMContext* ctx) {
   return MBLOCK_INT8_OTH;
 #endif
 }
+
+// The K of the packed A is rounded up to it.
+inline int get_kblock_int8(ARMContext* ctx) {
+#ifdef WITH_ARM_I8MM
+  if (ctx->has_i8mm()) {
+    return KBLOCK_INT8_MMLA;
+  }
+#endif
+  return KBLOCK_INT8;
+}
 #else
 // const int HBLOCK = 4;
 // const int WBLOCK = 8;
@@ -65,6 +86,8 @@ inline int get_hblock_int8(ARMContext* ctx) {
   return MBLOCK_INT8_OTH;
 #endif
 }
+
+inline int get_kblock_int8(ARMContext* ctx) { return KBLOCK_INT8; }
 #endif  // __aarch64__
 
 void prepackA_int8(void* out,
@@ -99,6 +122,19 @@ void gemm_prepack_int8(const int8_t* A_packed,
                        const operators::ActivationParam act_param,
                        ARMContext* ctx);
 
+// The epilogue of the int8 conv fused with the residual elementwise_add,
+// dout = act(din + residual * residual_scale), where din is the fp32 result
+// of the gemm computed without the activation, and dout is rounded to int8
+// for the int8 output. din and dout can be the same for the fp32 output.
+template <typename dtype>
+void gemm_int8_add_residual(const float* din,
+                            const int8_t* residual,
+                            dtype* dout,
+                            float residual_scale,
+                            const operators::ActivationParam& act_param,
+                            int size,
+                            ARMContext* ctx);
+
 #define ROUNDUP(a, b) ((((a) + (b)-1) / (b)) * (b))
 }  // namespace math
 }  // namespace arm
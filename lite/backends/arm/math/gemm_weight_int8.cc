@@ -0,0 +1,145 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/gemm_weight_int8.h"
+#include <arm_neon.h>
+#include <algorithm>
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// the columns of K dequantized at a time for the rows of x
+const int kBlockK = 256;
+
+void pack_weight_int8(const int8_t* weight, int8_t* packed, int n, int k) {
+  for (int j = 0; j < n; j++) {
+    for (int i = 0; i < k; i++) {
+      packed[j * k + i] = weight[i * n + j];
+    }
+  }
+}
+
+// vout[0:4] = the 16 values of w
+static inline void unpack_int8x16(const int8_t* w, float32x4_t* vout) {
+  int8x16_t vin = vld1q_s8(w);
+  int16x8_t vin_l = vmovl_s8(vget_low_s8(vin));
+  int16x8_t vin_h = vmovl_s8(vget_high_s8(vin));
+  vout[0] = vcvtq_f32_s32(vmovl_s16(vget_low_s16(vin_l)));
+  vout[1] = vcvtq_f32_s32(vmovl_s16(vget_high_s16(vin_l)));
+  vout[2] = vcvtq_f32_s32(vmovl_s16(vget_low_s16(vin_h)));
+  vout[3] = vcvtq_f32_s32(vmovl_s16(vget_high_s16(vin_h)));
+}
+
+static inline float reduce_add(float32x4_t v) {
+#ifdef __aarch64__
+  return vaddvq_f32(v);
+#else
+  float32x2_t vsum = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+  return vget_lane_f32(vpadd_f32(vsum, vsum), 0);
+#endif
+}
+
+// dot(x[0:len], w[0:len]) without the scale
+static inline float dot_int8(const float* x, const int8_t* w, int len) {
+  float32x4_t vacc0 = vdupq_n_f32(0.f);
+  float32x4_t vacc1 = vdupq_n_f32(0.f);
+  float32x4_t vw[4];
+  int i = 0;
+  for (; i + 15 < len; i += 16) {
+    unpack_int8x16(w + i, vw);
+    vacc0 = vmlaq_f32(vacc0, vld1q_f32(x + i), vw[0]);
+    vacc1 = vmlaq_f32(vacc1, vld1q_f32(x + i + 4), vw[1]);
+    vacc0 = vmlaq_f32(vacc0, vld1q_f32(x + i + 8), vw[2]);
+    vacc1 = vmlaq_f32(vacc1, vld1q_f32(x + i + 12), vw[3]);
+  }
+  float sum = reduce_add(vaddq_f32(vacc0, vacc1));
+  for (; i < len; i++) {
+    sum += x[i] * w[i];
+  }
+  return sum;
+}
+
+// dot(x[0:len], w[0:len])
+static inline float dot_fp32(const float* x, const float* w, int len) {
+  float32x4_t vacc0 = vdupq_n_f32(0.f);
+  float32x4_t vacc1 = vdupq_n_f32(0.f);
+  int i = 0;
+  for (; i + 7 < len; i += 8) {
+    vacc0 = vmlaq_f32(vacc0, vld1q_f32(x + i), vld1q_f32(w + i));
+    vacc1 = vmlaq_f32(vacc1, vld1q_f32(x + i + 4), vld1q_f32(w + i + 4));
+  }
+  float sum = reduce_add(vaddq_f32(vacc0, vacc1));
+  for (; i < len; i++) {
+    sum += x[i] * w[i];
+  }
+  return sum;
+}
+
+void gemm_weight_int8(const float* x,
+                      const int8_t* packed,
+                      const float* scales,
+                      const float* bias,
+                      float* out,
+                      int m,
+                      int n,
+                      int k,
+                      bool flag_relu) {
+  LITE_PARALLEL_BEGIN(j, tid, n) {
+    const int8_t* w_row = packed + j * k;
+    const float b = bias ? bias[j] : 0.f;
+    if (m == 1) {
+      // gemv, the weight is dequantized in the registers
+      float sum = scales[j] * dot_int8(x, w_row, k) + b;
+      out[j] = flag_relu ? std::max(sum, 0.f) : sum;
+    } else {
+      // each block of K is dequantized once for all the rows of x, the scale
+      // of the column is applied to the sums at last
+      float w_buf[kBlockK];
+      for (int i = 0; i < m; i++) {
+        out[i * n + j] = 0.f;
+      }
+      for (int start = 0; start < k; start += kBlockK) {
+        int len = std::min(kBlockK, k - start);
+        float32x4_t vw[4];
+        int l = 0;
+        for (; l + 15 < len; l += 16) {
+          unpack_int8x16(w_row + start + l, vw);
+          vst1q_f32(w_buf + l, vw[0]);
+          vst1q_f32(w_buf + l + 4, vw[1]);
+          vst1q_f32(w_buf + l + 8, vw[2]);
+          vst1q_f32(w_buf + l + 12, vw[3]);
+        }
+        for (; l < len; l++) {
+          w_buf[l] = w_row[start + l];
+        }
+        for (int i = 0; i < m; i++) {
+          out[i * n + j] += dot_fp32(x + i * k + start, w_buf, len);
+        }
+      }
+      for (int i = 0; i < m; i++) {
+        float sum = scales[j] * out[i * n + j] + b;
+        out[i * n + j] = flag_relu ? std::max(sum, 0.f) : sum;
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
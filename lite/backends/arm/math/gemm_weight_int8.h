@@ -0,0 +1,44 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstdint>
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// The int8 weights [K, N] quantized channel-wise along N by post_quant_dynamic,
+// with the scales in [N].
+
+// packed[N, K] = the transposed weight[K, N]
+void pack_weight_int8(const int8_t* weight, int8_t* packed, int n, int k);
+
+// out[M, N] = x[M, K] * weight[K, N] (+ bias) (relu), the weight is
+// dequantized in the inner loop of the dot products.
+void gemm_weight_int8(const float* x,
+                      const int8_t* packed,
+                      const float* scales,
+                      const float* bias,
+                      float* out,
+                      int m,
+                      int n,
+                      int k,
+                      bool flag_relu);
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
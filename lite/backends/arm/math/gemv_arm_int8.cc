@@ -2217,8 +2217,7 @@ bool gemv_int8_trans_oth(const int8_t* A,
     "sadalp v7.4s, v25.8h         \n"   /* pair acc, 8 int16 -> 4 int32 */\
     "bne 1b                       \n"   /* jump to main loop */
 
-#define GEMV_COMPUTE_ACT                                                  \
-    /* pair add to final result */                                        \
+#define GEMV_LOAD_SCALE                                                   \
     "2:                           \n"   /* reduce to scale */             \
     "ldp  q17,    q18, [%[scale]] \n"   /* load scale */                  \
     "movi   v19.4s, #0            \n"                                     \
@@ -2226,13 +2225,18 @@ bool gemv_int8_trans_oth(const int8_t* A,
     "cmp    %w[bias],   #0        \n"                                     \
     "beq    9f                    \n"                                     \
     "ldp  q19,    q20, [%[bias]]  \n"   /* load bias */                   \
-    "9:                           \n"                                     \
+    "9:                           \n"
+
+#define GEMV_COMPUTE_REDUCE                                               \
+    /* pair add to final result */                                        \
     "addp v9.4s,  v2.4s, v3.4s    \n"   /* pair add to 4 int32*/          \
     "addp v8.4s,  v0.4s, v1.4s    \n"   /* pair add to 4 int32*/          \
     "addp v10.4s, v4.4s, v5.4s    \n"   /* pair add to 4 int32*/          \
     "addp v11.4s, v6.4s, v7.4s    \n"   /* pair add to 4 int32*/          \
     "addp v12.4s, v8.4s , v9.4s   \n"   /* pair add to 4 int32*/          \
-    "addp v13.4s, v10.4s, v11.4s  \n"   /* pair add to 4 int32*/          \
+    "addp v13.4s, v10.4s, v11.4s  \n"   /* pair add to 4 int32*/
+
+#define GEMV_ACT                                                          \
     "scvtf  v21.4s, v12.4s        \n"   /* convert to fp32 */             \
     "scvtf  v22.4s, v13.4s        \n"   /* convert to fp32 */             \
     "fmla v19.4s, v21.4s, v17.4s  \n"   /* mul scale to get result */     \
@@ -2280,6 +2284,8 @@ bool gemv_int8_trans_oth(const int8_t* A,
     "fmul   v22.4s, v20.4s, v1.4s \n"                                     \
     "bif    v20.16b,v22.16b,v21.16b\n"
 
+#define GEMV_COMPUTE_ACT GEMV_LOAD_SCALE GEMV_COMPUTE_REDUCE GEMV_ACT
+
 #define GEMV_ST_INT8                                                      \
     "12:                          \n"                                     \
     "dup    v8.4s,  %w[vmax]      \n"                                     \
@@ -2340,6 +2346,56 @@ bool gemv_int8_trans_oth(const int8_t* A,
   ".word 0x4e909507 //sdot v7.4s, v8.16b, v16.16b \n" /* out4~7*/         \
   "bne 1b                                         \n"
 
+// the weights are packed by gemv_prepack_int8_sdot, each 16 int8 of the
+// input are multiplied by the 128 int8 of 8 rows x 16 cols
+#define GEMV_PACKED_DOT_COMPUTE                                           \
+    "prfm  pldl1keep, [%[in]]     \n"   /* preload din */                 \
+    "prfm  pldl1keep, [%[w]]      \n"   /* preload w */                   \
+    "movi   v0.4s,  #0            \n"   /* set out0~3 to 0 */             \
+    "movi   v1.4s,  #0            \n"   /* set out4~7 to 0 */             \
+    "movi   v2.4s,  #0            \n"   /* set out0~3 to 0 */             \
+    "movi   v3.4s,  #0            \n"   /* set out4~7 to 0 */             \
+    "cmp %w[cnt], #1              \n"   /* check whether has main loop */ \
+    "blt  2f                      \n"   /* jump to tail */                \
+    "1:                           \n"   /* main loop */                   \
+    "ldr    q8,     [%[in]], #16  \n"   /* load input, 16 int8 */         \
+    "ld1 {v9.16b, v10.16b, v11.16b, v12.16b}, [%[w]], #64\n"              \
+    "ld1 {v13.16b, v14.16b, v15.16b, v16.16b}, [%[w]], #64\n"             \
+    "prfm  pldl1keep, [%[w], #128]\n"   /* preload w */                   \
+    ".word 0x4f88e120\n" /* sdot v0.4s, v9.16b, v8.4b[0] */               \
+    ".word 0x4f88e141\n" /* sdot v1.4s, v10.16b, v8.4b[0] */              \
+    ".word 0x4fa8e162\n" /* sdot v2.4s, v11.16b, v8.4b[1] */              \
+    ".word 0x4fa8e183\n" /* sdot v3.4s, v12.16b, v8.4b[1] */              \
+    "subs %w[cnt], %w[cnt], #1    \n"   /* sub main loop count */         \
+    ".word 0x4f88e9a0\n" /* sdot v0.4s, v13.16b, v8.4b[2] */              \
+    ".word 0x4f88e9c1\n" /* sdot v1.4s, v14.16b, v8.4b[2] */              \
+    ".word 0x4fa8e9e2\n" /* sdot v2.4s, v15.16b, v8.4b[3] */              \
+    ".word 0x4fa8ea03\n" /* sdot v3.4s, v16.16b, v8.4b[3] */              \
+    "bne 1b                       \n"   /* jump to main loop */
+
+#define GEMV_PACKED_REDUCE                                                \
+    "add v12.4s, v0.4s, v2.4s     \n"   /* out0~3 */                      \
+    "add v13.4s, v1.4s, v3.4s     \n"   /* out4~7 */
+
+#define GEMV_PACKED_ASM_PARAMS                                            \
+    [in] "+r"(ptr_in),                                                    \
+    [w] "+r"(ptr_w),                                                      \
+    [cnt] "+r"(cnt),                                                      \
+    [scale] "+r"(scale_ptr),                                              \
+    [bias] "+r"(bias_ptr),                                                \
+    [relu] "+r"(act)                                                      \
+  : [out] "r"(out_ptr), [alpha] "r"(tmp_ptr)                              \
+  : "cc", "memory",                                                       \
+    "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7", "v8", "v9",           \
+    "v10", "v11", "v12", "v13", "v14", "v15", "v16", "v17",               \
+    "v18", "v19", "v20", "v21", "v22"
+
+#define GEMV_PACKED_ASM_FUN_PARAMS(dtype)                                 \
+  const int8_t *ptr_in, const int8_t *ptr_w, int cnt,                     \
+  const float *scale_ptr, const float *bias_ptr,                          \
+  int act, float alpha,  float offset, float threshold,                   \
+  dtype *out_ptr
+
 // clang-format on
 template <typename dtype>
 inline void gemv_int8_asm(GEMV_ASM_FUN_PARAMS(dtype));
@@ -2419,14 +2475,63 @@ inline void gemv_int8_dot_asm(GEMV_ASM_FUN_PARAMS(float)) {
                : GEMV_ASM_PARAMS);
 }
 
+template <typename dtype>
+inline void gemv_int8_packed_dot_asm(GEMV_PACKED_ASM_FUN_PARAMS(dtype));
+
+template <>
+inline void gemv_int8_packed_dot_asm(GEMV_PACKED_ASM_FUN_PARAMS(int8_t)) {
+  float vmax = -127.f;
+  float tmp_ptr[12] = {alpha,
+                       alpha,
+                       alpha,
+                       alpha,
+                       offset,
+                       offset,
+                       offset,
+                       offset,
+                       threshold,
+                       threshold,
+                       threshold,
+                       threshold};
+  asm volatile(GEMV_PACKED_DOT_COMPUTE GEMV_LOAD_SCALE GEMV_PACKED_REDUCE
+                   GEMV_ACT GEMV_ST_INT8
+               : [vmax] "+r"(vmax), GEMV_PACKED_ASM_PARAMS);
+}
+
+template <>
+inline void gemv_int8_packed_dot_asm(GEMV_PACKED_ASM_FUN_PARAMS(float)) {
+  float tmp_ptr[12] = {alpha,
+                       alpha,
+                       alpha,
+                       alpha,
+                       offset,
+                       offset,
+                       offset,
+                       offset,
+                       threshold,
+                       threshold,
+                       threshold,
+                       threshold};
+  asm volatile(GEMV_PACKED_DOT_COMPUTE GEMV_LOAD_SCALE GEMV_PACKED_REDUCE
+                   GEMV_ACT GEMV_ST_FP32
+               : GEMV_PACKED_ASM_PARAMS);
+}
+
 #undef GEMV_COMPUTE_INIT
 #undef GEMV_DOT_COMPUTE
+#undef GEMV_PACKED_DOT_COMPUTE
+#undef GEMV_PACKED_REDUCE
 #undef GEMV_COMPUTE
+#undef GEMV_LOAD_SCALE
+#undef GEMV_COMPUTE_REDUCE
+#undef GEMV_ACT
 #undef GEMV_COMPUTE_ACT
 #undef GEMV_ST_FP32
 #undef GEMV_ST_INT8
 #undef GEMV_ASM_PARAMS
 #undef GEMV_ASM_FUN_PARAMS
+#undef GEMV_PACKED_ASM_PARAMS
+#undef GEMV_PACKED_ASM_FUN_PARAMS
 #else
 // clang-format off
 #define GEMV_COMPUTE                    \
@@ -2933,6 +3038,91 @@ void gemv_int8_sdot(const int8_t* A,
 }
 #endif  // __aarch64__ && sdot
 
+#if defined(__aarch64__) && defined(WITH_ARM_DOTPROD)
+template <typename dtype>
+void gemv_int8_packed_sdot(const int8_t* A_packed,
+                           const int8_t* x,
+                           dtype* data_out,
+                           int M,
+                           int N,
+                           const float* scale,
+                           bool is_bias,
+                           const float* bias,
+                           bool fact,
+                           lite_api::ActivationType act,
+                           float alpha,
+                           float offset,
+                           float threshold,
+                           ARMContext* ctx) {
+  int Nup = (N + 15) / 16 * 16;
+  int cnt = Nup >> 4;
+  int out_cnt = (M + 7) / 8;
+  ctx->ExtendWorkspace(Nup);
+  int8_t* data_in = ctx->workspace_data<int8_t>();
+  memset(data_in + N, 0, Nup - N);
+  lite::TargetWrapperHost::MemcpySync(data_in, x, N);
+
+  LITE_PARALLEL_BEGIN(j, tid, out_cnt) {
+    int out_idx = j * 8;
+    int rows = std::min(8, M - out_idx);
+    const int8_t* ptr_w = A_packed + out_idx * Nup;
+    float scale_v[8] = {0.f};
+    float bias_v[8] = {0.f};
+    for (int p = 0; p < rows; p++) {
+      scale_v[p] = scale[out_idx + p];
+      bias_v[p] = is_bias ? bias[out_idx + p] : 0.f;
+    }
+    dtype out_temp[8];
+    dtype* out_p = rows == 8 ? data_out + out_idx : out_temp;
+    gemv_int8_packed_dot_asm<dtype>(data_in,
+                                    ptr_w,
+                                    cnt,
+                                    scale_v,
+                                    bias_v,
+                                    static_cast<int>(act),
+                                    alpha,
+                                    offset,
+                                    threshold,
+                                    out_p);
+    if (rows < 8) {
+      for (int p = 0; p < rows; p++) {
+        data_out[out_idx + p] = out_temp[p];
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+#endif  // __aarch64__ && sdot
+
+int gemv_packed_size_int8_sdot(int M, int N) {
+  return (M + 7) / 8 * 8 * ((N + 15) / 16 * 16);
+}
+
+void gemv_prepack_int8_sdot(const int8_t* A, int8_t* A_packed, int M, int N) {
+  int Nup = (N + 15) / 16 * 16;
+  int out_cnt = (M + 7) / 8;
+  // 8 rows x 4 cols each time, the rows and cols out of A are zero
+  LITE_PARALLEL_BEGIN(j, tid, out_cnt) {
+    int8_t* ptr_out = A_packed + j * 8 * Nup;
+    for (int k = 0; k < Nup; k += 4) {
+      for (int r = j * 8; r < j * 8 + 8; r++) {
+        for (int i = k; i < k + 4; i++) {
+          *ptr_out++ = r < M && i < N ? A[r * N + i] : 0;
+        }
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+bool gemv_int8_packed_enabled(ARMContext* ctx) {
+#if defined(__aarch64__) && defined(WITH_ARM_DOTPROD)
+  return ctx->has_dot();
+#else
+  return false;
+#endif
+}
+
 template <typename dtype>
 void gemv_int8(const int8_t* A,
                const int8_t* x,
@@ -2968,18 +3158,60 @@ void gemv_int8(const int8_t* A,
     return;
   }
 
-#ifdef __aarch64__
+#if defined(__aarch64__) && defined(WITH_ARM_DOTPROD)
   if (ctx->has_dot()) {
-#ifdef WITH_ARM_DOTPROD
     gemv_int8_sdot<dtype>(IN_PARAMS);
+    return;
+  }
 #endif
-  } else {
-    gemv_int8_oth<dtype>(IN_PARAMS);
+  gemv_int8_oth<dtype>(IN_PARAMS);
+#undef IN_PARAMS
+}
+
+template <typename dtype>
+void gemv_int8_packed(const int8_t* A_packed,
+                      const int8_t* x,
+                      dtype* y,
+                      int M,
+                      int N,
+                      const float* scale,
+                      bool is_bias,
+                      const float* bias,
+                      const operators::ActivationParam act_param,
+                      ARMContext* ctx) {
+  float alpha = 1.f;
+  float offset = 3.f;
+  float threshold = 6.f;
+  if (act_param.has_active) {
+    if (act_param.active_type == lite_api::ActivationType::kRelu6) {
+      alpha = act_param.Relu_clipped_coef;
+    } else if (act_param.active_type == lite_api::ActivationType::kLeakyRelu) {
+      alpha = act_param.Leaky_relu_alpha;
+    } else if (act_param.active_type == lite_api::ActivationType::kHardSwish) {
+      alpha = 1.0 / act_param.hard_swish_scale;
+      offset = act_param.hard_swish_offset;
+      threshold = act_param.hard_swish_threshold;
+    }
   }
+#if defined(__aarch64__) && defined(WITH_ARM_DOTPROD)
+  CHECK(ctx->has_dot()) << "the packed int8 gemv needs the sdot";
+  gemv_int8_packed_sdot<dtype>(A_packed,
+                               x,
+                               y,
+                               M,
+                               N,
+                               scale,
+                               is_bias,
+                               bias,
+                               act_param.has_active,
+                               act_param.active_type,
+                               alpha,
+                               offset,
+                               threshold,
+                               ctx);
 #else
-  gemv_int8_oth<dtype>(IN_PARAMS);
+  LOG(FATAL) << "the packed int8 gemv needs the sdot";
 #endif
-#undef IN_PARAMS
 }
 
 #define GEMV_INT8_FUN(dtype)                                                 \
@@ -2998,6 +3230,23 @@ void gemv_int8(const int8_t* A,
 GEMV_INT8_FUN(int8_t);
 GEMV_INT8_FUN(float);
 #undef GEMV_INT8_FUN
+
+#define GEMV_INT8_PACKED_FUN(dtype)                                   \
+  template void gemv_int8_packed<dtype>(                              \
+      const int8_t* A_packed,                                         \
+      const int8_t* x,                                                \
+      dtype* y,                                                       \
+      int M,                                                          \
+      int N,                                                          \
+      const float* scale,                                             \
+      bool is_bias,                                                   \
+      const float* bias,                                              \
+      const operators::ActivationParam act_param,                     \
+      ARMContext* ctx);
+
+GEMV_INT8_PACKED_FUN(int8_t);
+GEMV_INT8_PACKED_FUN(float);
+#undef GEMV_INT8_PACKED_FUN
 }  // namespace math
 }  // namespace arm
 }  // namespace lite
@@ -36,6 +36,28 @@ void gemv_int8(const int8_t* A,
                const operators::ActivationParam act_param,
                ARMContext* ctx);
 
+// The int8 gemv with the weights packed once by gemv_prepack_int8_sdot, it
+// runs the sdot on one stream of the weights, only for the cpus with dot.
+bool gemv_int8_packed_enabled(ARMContext* ctx);
+
+int gemv_packed_size_int8_sdot(int M, int N);
+
+// Packs A[M, N] in the blocks of 8 rows x 4 cols, the rows are padded to 8
+// and the cols are padded to 16 with zero.
+void gemv_prepack_int8_sdot(const int8_t* A, int8_t* A_packed, int M, int N);
+
+template <typename dtype>
+void gemv_int8_packed(const int8_t* A_packed,
+                      const int8_t* x,
+                      dtype* y,
+                      int M,
+                      int N,
+                      const float* scale,
+                      bool is_bias,
+                      const float* bias,
+                      const operators::ActivationParam act_param,
+                      ARMContext* ctx);
+
 }  // namespace math
 }  // namespace arm
 }  // namespace lite
@@ -19,6 +19,7 @@
 
 #include "lite/backends/arm/math/quantize.h"
 #include "lite/backends/arm/math/sgemm.h"
+#include "lite/core/fast_math.h"
 #include "lite/core/parallel_defines.h"
 
 namespace paddle {
@@ -74,7 +75,12 @@ inline void gru_add_with_bias(
   LITE_PARALLEL_END()
 }
 
-template <lite_api::ActivationType Act>
+template <lite_api::ActivationType Act, bool Fast>
+inline float32x4_t vactive(const float32x4_t& x) {
+  return Fast ? vactive_fast_f32<Act>(x) : vactive_f32<Act>(x);
+}
+
+template <lite_api::ActivationType Act, bool Fast>
 static void gru_unit_reset_act_impl(float* updata_gate_ptr,
                                     int stride_update,
                                     float* reset_gate_ptr,
@@ -108,16 +114,16 @@ static void gru_unit_reset_act_impl(float* updata_gate_ptr,
       float32x4_t vr0 = vld1q_f32(reset_gate + i);
       float32x4_t vr1 = vld1q_f32(reset_gate + i + 4);
 
-      float32x4_t vau0 = lite::arm::math::vactive_f32<Act>(vu0);
-      float32x4_t vau1 = lite::arm::math::vactive_f32<Act>(vu1);
+      float32x4_t vau0 = vactive<Act, Fast>(vu0);
+      float32x4_t vau1 = vactive<Act, Fast>(vu1);
 
       if (hidden_prev) {
         vpre0 = vld1q_f32(hidden_prev + i);
         vpre1 = vld1q_f32(hidden_prev + i + 4);
       }
 
-      float32x4_t var0 = lite::arm::math::vactive_f32<Act>(vr0);
-      float32x4_t var1 = lite::arm::math::vactive_f32<Act>(vr1);
+      float32x4_t var0 = vactive<Act, Fast>(vr0);
+      float32x4_t var1 = vactive<Act, Fast>(vr1);
 
       vst1q_f32(updata_gate + i, vau0);
       vst1q_f32(updata_gate + i + 4, vau1);
@@ -143,7 +149,7 @@ static void gru_unit_reset_act_impl(float* updata_gate_ptr,
   LITE_PARALLEL_END()
 }
 
-template <lite_api::ActivationType Act>
+template <lite_api::ActivationType Act, bool Fast>
 static void gru_unit_out_act_impl(bool origin_mode,
                                   float* updata_gate_ptr,
                                   int stride_update,
@@ -179,8 +185,8 @@ static void gru_unit_out_act_impl(bool origin_mode,
         float32x4_t vu0 = vld1q_f32(updata_gate + i);
         float32x4_t vu1 = vld1q_f32(updata_gate + i + 4);
 
-        float32x4_t vac0 = lite::arm::math::vactive_f32<Act>(vc0);
-        float32x4_t vac1 = lite::arm::math::vactive_f32<Act>(vc1);
+        float32x4_t vac0 = vactive<Act, Fast>(vc0);
+        float32x4_t vac1 = vactive<Act, Fast>(vc1);
         if (hidden_prev) {
           vpre0 = vld1q_f32(hidden_prev + i);
           vpre1 = vld1q_f32(hidden_prev + i + 4);
@@ -214,8 +220,8 @@ static void gru_unit_out_act_impl(bool origin_mode,
         float32x4_t vu0 = vld1q_f32(updata_gate + i);
         float32x4_t vu1 = vld1q_f32(updata_gate + i + 4);
 
-        float32x4_t vac0 = lite::arm::math::vactive_f32<Act>(vc0);
-        float32x4_t vac1 = lite::arm::math::vactive_f32<Act>(vc1);
+        float32x4_t vac0 = vactive<Act, Fast>(vc0);
+        float32x4_t vac1 = vactive<Act, Fast>(vc1);
 
         if (hidden_prev) {
           vpre0 = vld1q_f32(hidden_prev + i);
@@ -248,10 +254,11 @@ static void gru_unit_out_act_impl(bool origin_mode,
   LITE_PARALLEL_END()
 }
 
-inline void gru_unit_reset_act(lite_api::ActivationType act_type,
-                               GRUMetaValue<float> value,
-                               int frame_size,
-                               int batch_size) {
+template <bool Fast>
+inline void gru_unit_reset_act_select(lite_api::ActivationType act_type,
+                                      GRUMetaValue<float> value,
+                                      int frame_size,
+                                      int batch_size) {
   auto updata_gate = value.gate_value;
   auto reset_gate = value.gate_value + frame_size;
   auto hidden_prev = value.prev_out_value;
@@ -263,7 +270,7 @@ inline void gru_unit_reset_act(lite_api::ActivationType act_type,
 
   switch (act_type) {
     case lite_api::ActivationType::kIndentity:
-      gru_unit_reset_act_impl<lite_api::ActivationType::kIndentity>(
+      gru_unit_reset_act_impl<lite_api::ActivationType::kIndentity, Fast>(
           updata_gate,
           stride_update,
           reset_gate,
@@ -276,7 +283,7 @@ inline void gru_unit_reset_act(lite_api::ActivationType act_type,
           batch_size);
       break;
     case lite_api::ActivationType::kTanh:
-      gru_unit_reset_act_impl<lite_api::ActivationType::kTanh>(
+      gru_unit_reset_act_impl<lite_api::ActivationType::kTanh, Fast>(
           updata_gate,
           stride_update,
           reset_gate,
@@ -289,7 +296,7 @@ inline void gru_unit_reset_act(lite_api::ActivationType act_type,
           batch_size);
       break;
     case lite_api::ActivationType::kSigmoid:
-      gru_unit_reset_act_impl<lite_api::ActivationType::kSigmoid>(
+      gru_unit_reset_act_impl<lite_api::ActivationType::kSigmoid, Fast>(
           updata_gate,
           stride_update,
           reset_gate,
@@ -302,7 +309,7 @@ inline void gru_unit_reset_act(lite_api::ActivationType act_type,
           batch_size);
       break;
     case lite_api::ActivationType::kRelu:
-      gru_unit_reset_act_impl<lite_api::ActivationType::kRelu>(
+      gru_unit_reset_act_impl<lite_api::ActivationType::kRelu, Fast>(
           updata_gate,
           stride_update,
           reset_gate,
@@ -319,11 +326,12 @@ inline void gru_unit_reset_act(lite_api::ActivationType act_type,
   }
 }
 
-inline void gru_unit_out_act(lite_api::ActivationType act_type,
-                             bool origin_mode,
-                             GRUMetaValue<float> value,
-                             int frame_size,
-                             int batch_size) {
+template <bool Fast>
+inline void gru_unit_out_act_select(lite_api::ActivationType act_type,
+                                    bool origin_mode,
+                                    GRUMetaValue<float> value,
+                                    int frame_size,
+                                    int batch_size) {
   auto updata_gate = value.gate_value;
   auto cell_state = value.gate_value + 2 * frame_size;
   auto hidden_prev = value.prev_out_value;
@@ -336,7 +344,7 @@ inline void gru_unit_out_act(lite_api::ActivationType act_type,
 
   switch (act_type) {
     case lite_api::ActivationType::kIndentity:
-      gru_unit_out_act_impl<lite_api::ActivationType::kIndentity>(
+      gru_unit_out_act_impl<lite_api::ActivationType::kIndentity, Fast>(
           origin_mode,
           updata_gate,
           stride_update,
@@ -350,20 +358,21 @@ inline void gru_unit_out_act(lite_api::ActivationType act_type,
           batch_size);
       break;
     case lite_api::ActivationType::kTanh:
-      gru_unit_out_act_impl<lite_api::ActivationType::kTanh>(origin_mode,
-                                                             updata_gate,
-                                                             stride_update,
-                                                             cell_state,
-                                                             stride_cell_state,
-                                                             hidden_prev,
-                                                             stride_hidden_prev,
-                                                             hidden,
-                                                             stride_hidden,
-                                                             frame_size,
-                                                             batch_size);
+      gru_unit_out_act_impl<lite_api::ActivationType::kTanh, Fast>(
+          origin_mode,
+          updata_gate,
+          stride_update,
+          cell_state,
+          stride_cell_state,
+          hidden_prev,
+          stride_hidden_prev,
+          hidden,
+          stride_hidden,
+          frame_size,
+          batch_size);
       break;
     case lite_api::ActivationType::kSigmoid:
-      gru_unit_out_act_impl<lite_api::ActivationType::kSigmoid>(
+      gru_unit_out_act_impl<lite_api::ActivationType::kSigmoid, Fast>(
           origin_mode,
           updata_gate,
           stride_update,
@@ -377,23 +386,49 @@ inline void gru_unit_out_act(lite_api::ActivationType act_type,
           batch_size);
       break;
     case lite_api::ActivationType::kRelu:
-      gru_unit_out_act_impl<lite_api::ActivationType::kRelu>(origin_mode,
-                                                             updata_gate,
-                                                             stride_update,
-                                                             cell_state,
-                                                             stride_cell_state,
-                                                             hidden_prev,
-                                                             stride_hidden_prev,
-                                                             hidden,
-                                                             stride_hidden,
-                                                             frame_size,
-                                                             batch_size);
+      gru_unit_out_act_impl<lite_api::ActivationType::kRelu, Fast>(
+          origin_mode,
+          updata_gate,
+          stride_update,
+          cell_state,
+          stride_cell_state,
+          hidden_prev,
+          stride_hidden_prev,
+          hidden,
+          stride_hidden,
+          frame_size,
+          batch_size);
       break;
     default:
       break;
   }
 }
 
+inline void gru_unit_reset_act(lite_api::ActivationType act_type,
+                               GRUMetaValue<float> value,
+                               int frame_size,
+                               int batch_size) {
+  if (FastMath::Enabled()) {
+    gru_unit_reset_act_select<true>(act_type, value, frame_size, batch_size);
+  } else {
+    gru_unit_reset_act_select<false>(act_type, value, frame_size, batch_size);
+  }
+}
+
+inline void gru_unit_out_act(lite_api::ActivationType act_type,
+                             bool origin_mode,
+                             GRUMetaValue<float> value,
+                             int frame_size,
+                             int batch_size) {
+  if (FastMath::Enabled()) {
+    gru_unit_out_act_select<true>(
+        act_type, origin_mode, value, frame_size, batch_size);
+  } else {
+    gru_unit_out_act_select<false>(
+        act_type, origin_mode, value, frame_size, batch_size);
+  }
+}
+
 template <typename T>
 struct GRUUnitFunctor {
   static void compute(GRUMetaValue<T> value,
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #pragma once
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <vector>
 #include "lite/core/parallel_defines.h"
@@ -45,55 +47,176 @@ inline std::vector<T> get_new_data_from_tensor(const Tensor* new_data_tensor) {
   return vec_new_data;
 }
 
-void bilinear_interp(const float* src,
-                     int w_in,
-                     int h_in,
-                     float* dst,
-                     int w_out,
-                     int h_out,
-                     float scale_x,
-                     float scale_y,
-                     bool with_align);
-void nearest_interp(const float* src,
+// The source offsets and weights of a resize only depend on the sizes and
+// the attributes, so the kernels keep them between runs. Bilinear blends
+// the columns xofs0/xofs1 by alpha0/alpha1 and the rows yofs0/yofs1 by
+// beta0/beta1, nearest only reads xofs0 and yofs0.
+template <typename T>
+struct InterpTable {
+  int w_in{-1};
+  int h_in{-1};
+  int w_out{-1};
+  int h_out{-1};
+  float ratio_w{0.f};
+  float ratio_h{0.f};
+  bool with_align{false};
+  int align_mode{-1};
+  std::vector<int> xofs0, xofs1, yofs0, yofs1;
+  std::vector<T> alpha0, alpha1, beta0, beta1;
+
+  // Returns false if the table is already built for these arguments.
+  bool Reset(int w_in,
+             int h_in,
+             int w_out,
+             int h_out,
+             float ratio_w,
+             float ratio_h,
+             bool with_align,
+             int align_mode) {
+    if (this->w_in == w_in && this->h_in == h_in && this->w_out == w_out &&
+        this->h_out == h_out && this->ratio_w == ratio_w &&
+        this->ratio_h == ratio_h && this->with_align == with_align &&
+        this->align_mode == align_mode) {
+      return false;
+    }
+    this->w_in = w_in;
+    this->h_in = h_in;
+    this->w_out = w_out;
+    this->h_out = h_out;
+    this->ratio_w = ratio_w;
+    this->ratio_h = ratio_h;
+    this->with_align = with_align;
+    this->align_mode = align_mode;
+    return true;
+  }
+};
+
+template <typename T>
+void bilinear_axis(int in,
+                   int out,
+                   bool with_align,
+                   int align_mode,
+                   std::vector<int>* ofs0,
+                   std::vector<int>* ofs1,
+                   std::vector<T>* w0,
+                   std::vector<T>* w1) {
+  float ratio = 0.f;
+  if (out > 1) {
+    ratio = with_align ? static_cast<float>(in - 1) / (out - 1)
+                       : static_cast<float>(in) / out;
+  }
+  bool half_pixel = !with_align && align_mode == 0;
+  ofs0->resize(out);
+  ofs1->resize(out);
+  w0->resize(out);
+  w1->resize(out);
+  for (int i = 0; i < out; i++) {
+    float f = half_pixel ? ratio * (i + 0.5f) - 0.5f : ratio * i;
+    f = f < 0 ? 0.f : f;
+    int s = std::min(static_cast<int>(f), in - 1);
+    f -= s;
+    (*ofs0)[i] = s;
+    (*ofs1)[i] = std::min(s + 1, in - 1);
+    (*w0)[i] = static_cast<T>(1.f - f);
+    (*w1)[i] = static_cast<T>(f);
+  }
+}
+
+template <typename T>
+void bilinear_table(InterpTable<T>* table,
                     int w_in,
                     int h_in,
-                    float* dst,
                     int w_out,
                     int h_out,
-                    float scale_x,
-                    float scale_y,
-                    bool with_align);
+                    bool with_align,
+                    int align_mode) {
+  if (!table->Reset(
+          w_in, h_in, w_out, h_out, 0.f, 0.f, with_align, align_mode)) {
+    return;
+  }
+  bilinear_axis(w_in,
+                w_out,
+                with_align,
+                align_mode,
+                &table->xofs0,
+                &table->xofs1,
+                &table->alpha0,
+                &table->alpha1);
+  bilinear_axis(h_in,
+                h_out,
+                with_align,
+                align_mode,
+                &table->yofs0,
+                &table->yofs1,
+                &table->beta0,
+                &table->beta1);
+}
+
 template <typename T>
-void nearest_interp_v2_compute(const T* src,
-                               int w_in,
-                               int h_in,
-                               T* dst,
-                               int w_out,
-                               int h_out,
-                               float scale_x,
-                               float scale_y,
-                               bool with_align) {
-  if (with_align) {
-    for (int h = 0; h < h_out; ++h) {
-      T* dst_p = dst + h * w_out;
-      int near_y = static_cast<int>(scale_y * h + 0.5);
-      for (int w = 0; w < w_out; ++w) {
-        int near_x = static_cast<int>(scale_x * w + 0.5);
-        *dst_p++ = src[near_y * w_in + near_x];
-      }
+void nearest_table(InterpTable<T>* table,
+                   int w_in,
+                   int h_in,
+                   int w_out,
+                   int h_out,
+                   float ratio_w,
+                   float ratio_h,
+                   bool with_align) {
+  if (!table->Reset(
+          w_in, h_in, w_out, h_out, ratio_w, ratio_h, with_align, 0)) {
+    return;
+  }
+  float offset = with_align ? 0.5f : 0.f;
+  table->xofs0.resize(w_out);
+  table->yofs0.resize(h_out);
+  for (int w = 0; w < w_out; ++w) {
+    int near_x = static_cast<int>(ratio_w * w + offset);
+    table->xofs0[w] = std::min(std::max(near_x, 0), w_in - 1);
+  }
+  for (int h = 0; h < h_out; ++h) {
+    int near_y = static_cast<int>(ratio_h * h + offset);
+    table->yofs0[h] = std::min(std::max(near_y, 0), h_in - 1);
+  }
+}
+
+// Fills the output rows [h_begin, h_end) of one channel, a row reading the
+// same source row as the one before is copied.
+template <typename T, typename W>
+void nearest_interp(const T* src,
+                    int w_in,
+                    T* dst,
+                    int w_out,
+                    int h_begin,
+                    int h_end,
+                    const InterpTable<W>& table) {
+  const int* xofs = table.xofs0.data();
+  for (int h = h_begin; h < h_end; ++h) {
+    T* dst_p = dst + h * w_out;
+    if (h > h_begin && table.yofs0[h] == table.yofs0[h - 1]) {
+      memcpy(dst_p, dst_p - w_out, sizeof(T) * w_out);
+      continue;
     }
-  } else {
-    for (int h = 0; h < h_out; ++h) {
-      T* dst_p = dst + h * w_out;
-      int near_y = static_cast<int>(scale_y * h);
-      for (int w = 0; w < w_out; ++w) {
-        int near_x = static_cast<int>(scale_x * w);
-        *dst_p++ = src[near_y * w_in + near_x];
-      }
+    const T* src_p = src + table.yofs0[h] * w_in;
+    for (int w = 0; w < w_out; ++w) {
+      dst_p[w] = src_p[xofs[w]];
     }
   }
 }
 
+void bilinear_interp(const float* src,
+                     int w_in,
+                     float* dst,
+                     int w_out,
+                     int h_begin,
+                     int h_end,
+                     const InterpTable<float>& table);
+
+// The number of blocks the output rows of each channel are split into, so
+// that a few large maps still keep all the threads busy.
+inline int interp_row_blocks(int count, int h_out, int threads) {
+  if (count >= threads || h_out < 2) return 1;
+  return std::min((threads + count - 1) / count, h_out);
+}
+
 void interpolate(lite::Tensor* X,
                  lite::Tensor* OutSize,
                  std::vector<const lite::Tensor*> SizeTensor,
@@ -105,7 +228,9 @@ void interpolate(lite::Tensor* X,
                  bool with_align,
                  int align_mode,
                  std::string interpolate_type,
-                 std::vector<float> scale_data);
+                 std::vector<float> scale_data,
+                 InterpTable<float>* table,
+                 int threads);
 
 template <typename T>
 void nearest_interp_v2(lite::Tensor* X,
@@ -119,7 +244,9 @@ void nearest_interp_v2(lite::Tensor* X,
                        bool with_align,
                        int align_mode,
                        std::string interpolate_type,
-                       std::vector<float> scale_data) {
+                       std::vector<float> scale_data,
+                       InterpTable<float>* table,
+                       int threads) {
   int in_h = X->dims()[2];
   int in_w = X->dims()[3];
   float height_scale = -1;
@@ -188,16 +315,21 @@ void nearest_interp_v2(lite::Tensor* X,
   int spatial_in = in_h * in_w;
   int spatial_out = out_h * out_w;
 
-  LITE_PARALLEL_BEGIN(i, tid, count) {
-    nearest_interp_v2_compute<T>(din + spatial_in * i,
-                                 in_w,
-                                 in_h,
-                                 dout + spatial_out * i,
-                                 out_w,
-                                 out_h,
-                                 ratio_w,
-                                 ratio_h,
-                                 with_align);
+  nearest_table(
+      table, in_w, in_h, out_w, out_h, ratio_w, ratio_h, with_align);
+  int blocks = interp_row_blocks(count, out_h, threads);
+  int block_h = (out_h + blocks - 1) / blocks;
+  LITE_PARALLEL_BEGIN(i, tid, count * blocks) {
+    int c = i / blocks;
+    int h_begin = (i % blocks) * block_h;
+    int h_end = std::min(h_begin + block_h, out_h);
+    nearest_interp<T>(din + spatial_in * c,
+                      in_w,
+                      dout + spatial_out * c,
+                      out_w,
+                      h_begin,
+                      h_end,
+                      *table);
   }
   LITE_PARALLEL_END()
 }
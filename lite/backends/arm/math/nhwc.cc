@@ -0,0 +1,274 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/nhwc.h"
+#include <arm_neon.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+void im2col_nhwc(const float* din,
+                 float* dout,
+                 int hin,
+                 int win,
+                 int channel,
+                 int c_begin,
+                 int cin,
+                 int wout,
+                 int row_begin,
+                 int row_end,
+                 int kh,
+                 int kw,
+                 const std::vector<int>& strides,
+                 const std::vector<int>& paddings,
+                 const std::vector<int>& dilations) {
+  const int k_size = kh * kw * cin;
+  LITE_PARALLEL_BEGIN(row, tid, row_end - row_begin) {
+    const int oy = (row_begin + row) / wout;
+    const int ox = (row_begin + row) % wout;
+    float* out = dout + static_cast<int64_t>(row) * k_size;
+    for (int ky = 0; ky < kh; ++ky) {
+      const int iy = oy * strides[0] - paddings[0] + ky * dilations[0];
+      for (int kx = 0; kx < kw; ++kx, out += cin) {
+        const int ix = ox * strides[1] - paddings[2] + kx * dilations[1];
+        if (iy < 0 || iy >= hin || ix < 0 || ix >= win) {
+          memset(out, 0, sizeof(float) * cin);
+        } else {
+          memcpy(out,
+                 din + (static_cast<int64_t>(iy) * win + ix) * channel +
+                     c_begin,
+                 sizeof(float) * cin);
+        }
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+static void act_row(float* dout,
+                    int channel,
+                    const operators::ActivationParam& act_param) {
+  int i = 0;
+  switch (act_param.active_type) {
+    case lite_api::ActivationType::kRelu: {
+      float32x4_t vzero = vdupq_n_f32(0.f);
+      for (; i + 3 < channel; i += 4) {
+        vst1q_f32(dout + i, vmaxq_f32(vld1q_f32(dout + i), vzero));
+      }
+      for (; i < channel; ++i) dout[i] = std::max(dout[i], 0.f);
+      break;
+    }
+    case lite_api::ActivationType::kRelu6: {
+      const float six = act_param.Relu_clipped_coef;
+      float32x4_t vzero = vdupq_n_f32(0.f);
+      float32x4_t vsix = vdupq_n_f32(six);
+      for (; i + 3 < channel; i += 4) {
+        float32x4_t v = vmaxq_f32(vld1q_f32(dout + i), vzero);
+        vst1q_f32(dout + i, vminq_f32(v, vsix));
+      }
+      for (; i < channel; ++i) {
+        dout[i] = std::min(std::max(dout[i], 0.f), six);
+      }
+      break;
+    }
+    case lite_api::ActivationType::kLeakyRelu: {
+      const float alpha = act_param.Leaky_relu_alpha;
+      float32x4_t vzero = vdupq_n_f32(0.f);
+      float32x4_t valpha = vdupq_n_f32(alpha);
+      for (; i + 3 < channel; i += 4) {
+        float32x4_t v = vld1q_f32(dout + i);
+        uint32x4_t vmask = vcgeq_f32(v, vzero);
+        vst1q_f32(dout + i, vbslq_f32(vmask, v, vmulq_f32(v, valpha)));
+      }
+      for (; i < channel; ++i) {
+        dout[i] = dout[i] >= 0.f ? dout[i] : dout[i] * alpha;
+      }
+      break;
+    }
+    case lite_api::ActivationType::kHardSwish: {
+      const float scale = 1.f / act_param.hard_swish_scale;
+      const float offset = act_param.hard_swish_offset;
+      const float threshold = act_param.hard_swish_threshold;
+      for (; i < channel; ++i) {
+        float v = std::min(std::max(dout[i] + offset, 0.f), threshold);
+        dout[i] = dout[i] * v * scale;
+      }
+      break;
+    }
+    case lite_api::ActivationType::kSigmoid:
+      for (; i < channel; ++i) dout[i] = 1.f / (1.f + expf(-dout[i]));
+      break;
+    case lite_api::ActivationType::kTanh:
+      for (; i < channel; ++i) dout[i] = tanhf(dout[i]);
+      break;
+    default:
+      LOG(FATAL) << "the nhwc kernels do not support the activation type "
+                 << static_cast<int>(act_param.active_type);
+  }
+}
+
+void bias_act_nhwc(float* dout,
+                   int64_t rows,
+                   int channel,
+                   const float* bias,
+                   const operators::ActivationParam& act_param) {
+  if (!bias && !act_param.has_active) return;
+  LITE_PARALLEL_BEGIN(row, tid, rows) {
+    float* out = dout + row * channel;
+    if (bias) {
+      int i = 0;
+      for (; i + 3 < channel; i += 4) {
+        vst1q_f32(out + i, vaddq_f32(vld1q_f32(out + i), vld1q_f32(bias + i)));
+      }
+      for (; i < channel; ++i) out[i] += bias[i];
+    }
+    if (act_param.has_active) act_row(out, channel, act_param);
+  }
+  LITE_PARALLEL_END();
+}
+
+void conv_depthwise_nhwc(const float* din,
+                         const float* weights,
+                         const float* bias,
+                         float* dout,
+                         int hin,
+                         int win,
+                         int channel,
+                         int hout,
+                         int wout,
+                         int kh,
+                         int kw,
+                         const std::vector<int>& strides,
+                         const std::vector<int>& paddings,
+                         const std::vector<int>& dilations,
+                         const operators::ActivationParam& act_param) {
+  LITE_PARALLEL_BEGIN(oy, tid, hout) {
+    for (int ox = 0; ox < wout; ++ox) {
+      float* out = dout + (static_cast<int64_t>(oy) * wout + ox) * channel;
+      if (bias) {
+        memcpy(out, bias, sizeof(float) * channel);
+      } else {
+        memset(out, 0, sizeof(float) * channel);
+      }
+      for (int ky = 0; ky < kh; ++ky) {
+        const int iy = oy * strides[0] - paddings[0] + ky * dilations[0];
+        if (iy < 0 || iy >= hin) continue;
+        for (int kx = 0; kx < kw; ++kx) {
+          const int ix = ox * strides[1] - paddings[2] + kx * dilations[1];
+          if (ix < 0 || ix >= win) continue;
+          const float* in =
+              din + (static_cast<int64_t>(iy) * win + ix) * channel;
+          const float* w = weights + (ky * kw + kx) * channel;
+          int c = 0;
+          for (; c + 3 < channel; c += 4) {
+            float32x4_t vout = vld1q_f32(out + c);
+            vout = vmlaq_f32(vout, vld1q_f32(in + c), vld1q_f32(w + c));
+            vst1q_f32(out + c, vout);
+          }
+          for (; c < channel; ++c) out[c] += in[c] * w[c];
+        }
+      }
+      if (act_param.has_active) act_row(out, channel, act_param);
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void pooling_nhwc(const float* din,
+                  float* dout,
+                  int num,
+                  int channel,
+                  int hin,
+                  int win,
+                  int hout,
+                  int wout,
+                  const std::vector<int>& ksize,
+                  const std::vector<int>& strides,
+                  const std::vector<int>& paddings,
+                  bool is_max,
+                  bool exclusive,
+                  bool adaptive) {
+  const float init = is_max ? -FLT_MAX : 0.f;
+  LITE_PARALLEL_BEGIN(row, tid, num * hout) {
+    const int n = row / hout;
+    const int oy = row % hout;
+    const float* in = din + static_cast<int64_t>(n) * hin * win * channel;
+    int hstart, hend;
+    if (adaptive) {
+      hstart = oy * hin / hout;
+      hend = ((oy + 1) * hin + hout - 1) / hout;
+    } else {
+      hstart = oy * strides[0] - paddings[0];
+      hend = std::min(hstart + ksize[0], hin + paddings[1]);
+    }
+    for (int ox = 0; ox < wout; ++ox) {
+      int wstart, wend;
+      if (adaptive) {
+        wstart = ox * win / wout;
+        wend = ((ox + 1) * win + wout - 1) / wout;
+      } else {
+        wstart = ox * strides[1] - paddings[2];
+        wend = std::min(wstart + ksize[1], win + paddings[3]);
+      }
+      const int y0 = std::max(hstart, 0);
+      const int y1 = std::min(hend, hin);
+      const int x0 = std::max(wstart, 0);
+      const int x1 = std::min(wend, win);
+      float* out = dout + (static_cast<int64_t>(row) * wout + ox) * channel;
+      for (int c = 0; c < channel; ++c) out[c] = init;
+      for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+          const float* p = in + (static_cast<int64_t>(y) * win + x) * channel;
+          int c = 0;
+          if (is_max) {
+            for (; c + 3 < channel; c += 4) {
+              vst1q_f32(out + c,
+                        vmaxq_f32(vld1q_f32(out + c), vld1q_f32(p + c)));
+            }
+            for (; c < channel; ++c) out[c] = std::max(out[c], p[c]);
+          } else {
+            for (; c + 3 < channel; c += 4) {
+              vst1q_f32(out + c,
+                        vaddq_f32(vld1q_f32(out + c), vld1q_f32(p + c)));
+            }
+            for (; c < channel; ++c) out[c] += p[c];
+          }
+        }
+      }
+      if (is_max) continue;
+      int pool_size = (exclusive || adaptive) ? (y1 - y0) * (x1 - x0)
+                                              : ksize[0] * ksize[1];
+      const float scale = pool_size > 0 ? 1.f / pool_size : 0.f;
+      float32x4_t vscale = vdupq_n_f32(scale);
+      int c = 0;
+      for (; c + 3 < channel; c += 4) {
+        vst1q_f32(out + c, vmulq_f32(vld1q_f32(out + c), vscale));
+      }
+      for (; c < channel; ++c) out[c] *= scale;
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,92 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// The NHWC kernels keep the logical NCHW dims of the tensors and store the
+// images channel last, the paddings are {up, down, left, right}.
+
+// Write the patches of the output rows [row_begin, row_end) of an NHWC image
+// with channel channels into dout, a [rows, kh * kw * cin] matrix, taking the
+// cin channels from c_begin on. The padded pixels are zeros.
+void im2col_nhwc(const float* din,
+                 float* dout,
+                 int hin,
+                 int win,
+                 int channel,
+                 int c_begin,
+                 int cin,
+                 int wout,
+                 int row_begin,
+                 int row_end,
+                 int kh,
+                 int kw,
+                 const std::vector<int>& strides,
+                 const std::vector<int>& paddings,
+                 const std::vector<int>& dilations);
+
+// Depthwise convolution of one NHWC image, the weights are [kh, kw, channel].
+void conv_depthwise_nhwc(const float* din,
+                         const float* weights,
+                         const float* bias,
+                         float* dout,
+                         int hin,
+                         int win,
+                         int channel,
+                         int hout,
+                         int wout,
+                         int kh,
+                         int kw,
+                         const std::vector<int>& strides,
+                         const std::vector<int>& paddings,
+                         const std::vector<int>& dilations,
+                         const operators::ActivationParam& act_param);
+
+// dout[i][j] = act(dout[i][j] + bias[j]) for the rows x channel matrix, the
+// bias may be nullptr. Relu6 clips at Relu_clipped_coef.
+void bias_act_nhwc(float* dout,
+                   int64_t rows,
+                   int channel,
+                   const float* bias,
+                   const operators::ActivationParam& act_param);
+
+// Max or average pooling of num NHWC images.
+void pooling_nhwc(const float* din,
+                  float* dout,
+                  int num,
+                  int channel,
+                  int hin,
+                  int win,
+                  int hout,
+                  int wout,
+                  const std::vector<int>& ksize,
+                  const std::vector<int>& strides,
+                  const std::vector<int>& paddings,
+                  bool is_max,
+                  bool exclusive,
+                  bool adaptive);
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -32,6 +32,22 @@ void matrix_norm_row(const float* x_data,
                      int batch_size,
                      int feature_size);
 
+// The layer norm of x + residual, whose rows are repeated for the rows of x
+// if residual_rows is less than batch_size. The sum is written into add_out
+// if not nullptr.
+void matrix_add_norm_row(const float* x_data,
+                         const float* residual_data,
+                         int residual_rows,
+                         const float* scale_data,
+                         const float* bias_data,
+                         float* add_out,
+                         float* out_data,
+                         float* mean_out,
+                         float* var_out,
+                         float epsilon,
+                         int batch_size,
+                         int feature_size);
+
 }  // namespace math
 }  // namespace arm
 }  // namespace lite
@@ -3274,7 +3274,7 @@ void sgemm_prepacked_8x12(bool is_transB,
                           bool has_bias,
                           const operators::ActivationParam act_param,
                           ARMContext *ctx) {
-  size_t l2_cache = ctx->llc_size() > 0 ? ctx->llc_size() : 512 * 1024;
+  size_t l2_cache = sgemm_block_cache_size(ctx);
   auto workspace = ctx->workspace_data<float>();
   int threads = ctx->threads();
 
@@ -3340,7 +3340,10 @@ void sgemm_prepacked_8x12(bool is_transB,
     } else {
       loadb(b_pannel, B, ldb, 0, K, x0, xmax);
     }
-    LITE_PARALLEL_COMMON_BEGIN(y, tid, M, 0, MBLOCK) {
+    // split N into tiles as well when M is too small to feed all threads
+    int x_tile = ParallelTileSize((M + MBLOCK - 1) / MBLOCK, bblocks, threads);
+    LITE_PARALLEL_COMMON_2D_BEGIN(
+        y, xt, tid, M, 0, MBLOCK, bblocks, 0, x_tile, 1) {
       unsigned int ymax = y + MBLOCK;
       if (ymax > M) {
         ymax = M;
@@ -3363,7 +3366,7 @@ void sgemm_prepacked_8x12(bool is_transB,
       float cout6[NBLOCK];
       float cout7[NBLOCK];
 
-      float *c_ptr0 = C + y * ldc + x0;
+      float *c_ptr0 = C + y * ldc + x0 + xt * NBLOCK;
       float *c_ptr1 = c_ptr0 + ldc;
       float *c_ptr2 = c_ptr1 + ldc;
       float *c_ptr3 = c_ptr2 + ldc;
@@ -3382,8 +3385,9 @@ void sgemm_prepacked_8x12(bool is_transB,
       float *pout7 = c_ptr7;
 
       const float *a_ptr_l = A_packed + y * K;
-      const float *b_ptr = b_pannel;
-      for (int xb = 0; xb < bblocks; xb++) {
+      const float *b_ptr = b_pannel + xt * K * NBLOCK;
+      int xt_end = std::min(xt + x_tile, bblocks);
+      for (int xb = xt; xb < xt_end; xb++) {
         if ((y + 7) >= ymax) {
           switch ((y + 7) - ymax) {
             case 6:
@@ -4481,7 +4485,7 @@ void sgemm_prepacked_8x12(bool is_transB,
         }
       }
     }
-    LITE_PARALLEL_COMMON_END();
+    LITE_PARALLEL_COMMON_2D_END();
   }
 }
 
@@ -4499,7 +4503,7 @@ void sgemm_prepacked_8x12_a53(bool is_transB,
                               bool has_bias,
                               const operators::ActivationParam act_param,
                               ARMContext *ctx) {
-  size_t l2_cache = ctx->llc_size() > 0 ? ctx->llc_size() : 512 * 1024;
+  size_t l2_cache = sgemm_block_cache_size(ctx);
   auto workspace = ctx->workspace_data<float>();
   int threads = ctx->threads();
 
@@ -5767,7 +5771,7 @@ void sgemm_prepacked_4x8(bool is_transB,
                          bool has_bias,
                          const operators::ActivationParam act_param,
                          ARMContext *ctx) {
-  size_t l2_cache = ctx->llc_size() > 0 ? ctx->llc_size() : 512 * 1024;
+  size_t l2_cache = sgemm_block_cache_size(ctx);
   auto *workspace = ctx->workspace_data<float>();
   int threads = ctx->threads();
   auto act_type = act_param.active_type;
@@ -6227,7 +6231,7 @@ void sgemm_prepacked_4x4(bool is_transB,
                          bool has_bias,
                          const operators::ActivationParam act_param,
                          ARMContext *ctx) {
-  size_t l2_cache = ctx->llc_size() > 0 ? ctx->llc_size() : 512 * 1024;
+  size_t l2_cache = sgemm_block_cache_size(ctx);
   auto workspace = ctx->workspace_data<float>();
   int threads = ctx->threads();
 
@@ -6624,7 +6628,7 @@ void sgemm_prepacked_6x8(bool is_transB,
                          bool has_bias,
                          const operators::ActivationParam act_param,
                          ARMContext* ctx) {
-  size_t l2_cache = ctx->llc_size() > 0 ? ctx->llc_size() : 512 * 1024;
+  size_t l2_cache = sgemm_block_cache_size(ctx);
   auto* workspace = ctx->workspace_data<float>();
   int threads = ctx->threads();
   auto act_type = act_param.active_type;
@@ -7283,7 +7287,7 @@ void sgemm_prepacked_6x8_a53(bool is_transB,
                              bool has_bias,
                              int is_relu,
                              ARMContext* ctx) {
-  size_t l2_cache = ctx->llc_size() > 0 ? ctx->llc_size() : 512 * 1024;
+  size_t l2_cache = sgemm_block_cache_size(ctx);
   auto* workspace = ctx->workspace_data<float>();
   int threads = ctx->threads();
   X_BLOCK_COMPUTE((l2_cache * 9 / 10), MBLOCK_OTH, NBLOCK, M, N, K)
@@ -7730,7 +7734,7 @@ void sgemm_prepacked_4x8(bool is_transB,
                          bool has_bias,
                          const operators::ActivationParam act_param,
                          ARMContext* ctx) {
-  size_t l2_cache = ctx->llc_size() > 0 ? ctx->llc_size() : 512 * 1024;
+  size_t l2_cache = sgemm_block_cache_size(ctx);
   auto* workspace = ctx->workspace_data<float>();
   int threads = ctx->threads();
   auto act_type = act_param.active_type;
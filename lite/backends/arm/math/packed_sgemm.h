@@ -60,6 +60,14 @@ inline int get_hblock(ARMContext* ctx, int m) {
   x_block *= NBLOCK;                                                        \
   x_block = x_block < NBLOCK ? NBLOCK : x_block;
 
+// The cache size the fp32 packed gemms block the packed B panels by, see
+// X_BLOCK_COMPUTE, which is the last level cache of the active cores. When
+// the KernelTuner is enabled, the first gemm times the candidates between
+// the L2 and the last level cache sizes on a gemm larger than the caches,
+// and the fastest one is kept for the device, the power mode and the
+// threads, and saved into the tuning file.
+size_t sgemm_block_cache_size(ARMContext* ctx);
+
 void prepackA(float* out,
               const float* in,
               float alpha,
@@ -0,0 +1,408 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/reduce.h"
+#include <arm_neon.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// The elements reduced by one thread below which a reduction is not split.
+static const int64_t kReduceGrain = 16384;
+
+template <typename T, ReduceType R>
+struct ReduceOp {
+  static inline T init() { return static_cast<T>(0); }
+  static inline T apply(T a, T b) { return a + b; }
+};
+
+template <typename T>
+struct ReduceOp<T, ReduceType::kMax> {
+  static inline T init() { return std::numeric_limits<T>::lowest(); }
+  static inline T apply(T a, T b) { return a > b ? a : b; }
+};
+
+template <typename T>
+struct ReduceOp<T, ReduceType::kMin> {
+  static inline T init() { return std::numeric_limits<T>::max(); }
+  static inline T apply(T a, T b) { return a < b ? a : b; }
+};
+
+template <typename T>
+struct ReduceOp<T, ReduceType::kProd> {
+  static inline T init() { return static_cast<T>(1); }
+  static inline T apply(T a, T b) { return a * b; }
+};
+
+template <typename T, ReduceType R>
+struct Reducer {
+  typedef ReduceOp<T, R> Op;
+
+  // Reduces din[0, len).
+  static T row(const T* din, int64_t len) {
+    T r0 = Op::init();
+    T r1 = r0;
+    T r2 = r0;
+    T r3 = r0;
+    int64_t i = 0;
+    for (; i + 3 < len; i += 4) {
+      r0 = Op::apply(r0, din[i]);
+      r1 = Op::apply(r1, din[i + 1]);
+      r2 = Op::apply(r2, din[i + 2]);
+      r3 = Op::apply(r3, din[i + 3]);
+    }
+    for (; i < len; i++) {
+      r0 = Op::apply(r0, din[i]);
+    }
+    return Op::apply(Op::apply(r0, r1), Op::apply(r2, r3));
+  }
+
+  // Reduces the `len` rows of `cols` elements strided by `stride` into dout.
+  static void cols(
+      const T* din, T* dout, int64_t len, int64_t cols, int64_t stride) {
+    std::memcpy(dout, din, sizeof(T) * cols);
+    for (int64_t i = 1; i < len; i++) {
+      const T* row = din + i * stride;
+      for (int64_t j = 0; j < cols; j++) {
+        dout[j] = Op::apply(dout[j], row[j]);
+      }
+    }
+  }
+};
+
+template <ReduceType R>
+inline float32x4_t vapply(float32x4_t a, float32x4_t b);
+
+template <>
+inline float32x4_t vapply<ReduceType::kSum>(float32x4_t a, float32x4_t b) {
+  return vaddq_f32(a, b);
+}
+
+template <>
+inline float32x4_t vapply<ReduceType::kMax>(float32x4_t a, float32x4_t b) {
+  return vmaxq_f32(a, b);
+}
+
+template <>
+inline float32x4_t vapply<ReduceType::kMin>(float32x4_t a, float32x4_t b) {
+  return vminq_f32(a, b);
+}
+
+template <>
+inline float32x4_t vapply<ReduceType::kProd>(float32x4_t a, float32x4_t b) {
+  return vmulq_f32(a, b);
+}
+
+template <ReduceType R>
+struct Reducer<float, R> {
+  typedef ReduceOp<float, R> Op;
+
+  static float row(const float* din, int64_t len) {
+    float32x4_t v0 = vdupq_n_f32(Op::init());
+    float32x4_t v1 = v0;
+    float32x4_t v2 = v0;
+    float32x4_t v3 = v0;
+    int64_t i = 0;
+    for (; i + 15 < len; i += 16) {
+      v0 = vapply<R>(v0, vld1q_f32(din + i));
+      v1 = vapply<R>(v1, vld1q_f32(din + i + 4));
+      v2 = vapply<R>(v2, vld1q_f32(din + i + 8));
+      v3 = vapply<R>(v3, vld1q_f32(din + i + 12));
+    }
+    for (; i + 3 < len; i += 4) {
+      v0 = vapply<R>(v0, vld1q_f32(din + i));
+    }
+    v0 = vapply<R>(vapply<R>(v0, v1), vapply<R>(v2, v3));
+    float r = Op::apply(
+        Op::apply(vgetq_lane_f32(v0, 0), vgetq_lane_f32(v0, 1)),
+        Op::apply(vgetq_lane_f32(v0, 2), vgetq_lane_f32(v0, 3)));
+    for (; i < len; i++) {
+      r = Op::apply(r, din[i]);
+    }
+    return r;
+  }
+
+  // The columns are reduced in the blocks of 16 held in the registers.
+  static void cols(const float* din,
+                   float* dout,
+                   int64_t len,
+                   int64_t cols,
+                   int64_t stride) {
+    int64_t j = 0;
+    for (; j + 15 < cols; j += 16) {
+      const float* ptr = din + j;
+      float32x4_t v0 = vld1q_f32(ptr);
+      float32x4_t v1 = vld1q_f32(ptr + 4);
+      float32x4_t v2 = vld1q_f32(ptr + 8);
+      float32x4_t v3 = vld1q_f32(ptr + 12);
+      for (int64_t i = 1; i < len; i++) {
+        ptr += stride;
+        v0 = vapply<R>(v0, vld1q_f32(ptr));
+        v1 = vapply<R>(v1, vld1q_f32(ptr + 4));
+        v2 = vapply<R>(v2, vld1q_f32(ptr + 8));
+        v3 = vapply<R>(v3, vld1q_f32(ptr + 12));
+      }
+      vst1q_f32(dout + j, v0);
+      vst1q_f32(dout + j + 4, v1);
+      vst1q_f32(dout + j + 8, v2);
+      vst1q_f32(dout + j + 12, v3);
+    }
+    for (; j + 3 < cols; j += 4) {
+      const float* ptr = din + j;
+      float32x4_t v0 = vld1q_f32(ptr);
+      for (int64_t i = 1; i < len; i++) {
+        ptr += stride;
+        v0 = vapply<R>(v0, vld1q_f32(ptr));
+      }
+      vst1q_f32(dout + j, v0);
+    }
+    for (; j < cols; j++) {
+      const float* ptr = din + j;
+      float r = ptr[0];
+      for (int64_t i = 1; i < len; i++) {
+        ptr += stride;
+        r = Op::apply(r, ptr[0]);
+      }
+      dout[j] = r;
+    }
+  }
+};
+
+// Reduces [outer, len, inner] over len into [outer, inner].
+template <typename T, ReduceType R>
+static void reduce_pass(const T* din,
+                        T* dout,
+                        int64_t outer,
+                        int64_t len,
+                        int64_t inner,
+                        int threads) {
+  typedef Reducer<T, R> Red;
+  threads = std::max(threads, 1);
+  // split the columns if the outer rows can not feed the threads
+  int64_t col_block = inner;
+  if (inner > 1 && outer < threads) {
+    int64_t blocks = (threads + outer - 1) / outer;
+    col_block = ((inner + blocks - 1) / blocks + 15) / 16 * 16;
+    col_block = std::min(inner, col_block);
+  }
+  int64_t col_blocks = (inner + col_block - 1) / col_block;
+  int64_t tasks = outer * col_blocks;
+  // split the reduced dim if the outputs still can not feed the threads
+  int64_t parts = 1;
+  if (tasks < threads) {
+    parts = std::min<int64_t>(threads / tasks, len * col_block / kReduceGrain);
+    parts = std::max<int64_t>(parts, 1);
+  }
+
+  if (parts == 1 && inner == 1) {
+    int64_t step = (outer + threads - 1) / threads;
+    int num = static_cast<int>((outer + step - 1) / step);
+    LITE_PARALLEL_BEGIN(t, tid, num) {
+      int64_t end = std::min<int64_t>(outer, (t + 1) * step);
+      for (int64_t i = t * step; i < end; i++) {
+        dout[i] = Red::row(din + i * len, len);
+      }
+    }
+    LITE_PARALLEL_END()
+  } else if (parts == 1) {
+    LITE_PARALLEL_BEGIN(t, tid, static_cast<int>(tasks)) {
+      int64_t o = t / col_blocks;
+      int64_t j = t % col_blocks * col_block;
+      int64_t cols = std::min(col_block, inner - j);
+      Red::cols(
+          din + o * len * inner + j, dout + o * inner + j, len, cols, inner);
+    }
+    LITE_PARALLEL_END()
+  } else {
+    // the partial results of the parts are combined in order
+    int64_t part_len = (len + parts - 1) / parts;
+    parts = (len + part_len - 1) / part_len;
+    std::vector<T> partial(outer * parts * inner);
+    T* partial_data = partial.data();
+    LITE_PARALLEL_BEGIN(t, tid, static_cast<int>(tasks * parts)) {
+      int64_t p = t % parts;
+      int64_t o = t / parts / col_blocks;
+      int64_t j = t / parts % col_blocks * col_block;
+      int64_t cols = std::min(col_block, inner - j);
+      int64_t begin = p * part_len;
+      int64_t num = std::min(part_len, len - begin);
+      const T* in = din + (o * len + begin) * inner + j;
+      T* out = partial_data + (o * parts + p) * inner + j;
+      if (inner == 1) {
+        out[0] = Red::row(in, num);
+      } else {
+        Red::cols(in, out, num, cols, inner);
+      }
+    }
+    LITE_PARALLEL_END()
+    for (int64_t o = 0; o < outer; o++) {
+      Red::cols(partial_data + o * parts * inner,
+                dout + o * inner,
+                parts,
+                inner,
+                inner);
+    }
+  }
+}
+
+// Folds the reduced groups of the collapsed `dims` from the innermost one,
+// the intermediate results go through two buffers.
+template <typename T, ReduceType R>
+static void reduce_impl(const T* din,
+                        T* dout,
+                        std::vector<int64_t> dims,
+                        std::vector<bool> reduced,
+                        int threads) {
+  std::vector<T> buffers[2];
+  int cur = 0;
+  const T* src = din;
+  for (;;) {
+    int k = static_cast<int>(dims.size()) - 1;
+    while (k >= 0 && !reduced[k]) k--;
+    int64_t outer = 1;
+    int64_t inner = 1;
+    bool last = true;
+    for (int i = 0; i < k; i++) {
+      outer *= dims[i];
+      last = last && !reduced[i];
+    }
+    for (size_t i = k + 1; i < dims.size(); i++) {
+      inner *= dims[i];
+    }
+    T* dst = dout;
+    if (!last) {
+      buffers[cur].resize(outer * inner);
+      dst = buffers[cur].data();
+      cur ^= 1;
+    }
+    reduce_pass<T, R>(src, dst, outer, dims[k], inner, threads);
+    if (last) break;
+    src = dst;
+    dims.erase(dims.begin() + k);
+    reduced.erase(reduced.begin() + k);
+    // the kept dims around the folded group become adjacent
+    if (k > 0 && k < static_cast<int>(dims.size())) {
+      dims[k - 1] *= dims[k];
+      dims.erase(dims.begin() + k);
+      reduced.erase(reduced.begin() + k);
+    }
+  }
+}
+
+template <typename T>
+void reduce(const T* din,
+            T* dout,
+            const std::vector<int64_t>& x_dims,
+            const std::vector<int>& axes,
+            ReduceType type,
+            int threads) {
+  int rank = static_cast<int>(x_dims.size());
+  std::vector<bool> reduced(rank, axes.empty());
+  for (int axis : axes) {
+    int i = axis < 0 ? axis + rank : axis;
+    CHECK(i >= 0 && i < rank) << "The reduce axis " << axis
+                              << " is out of the rank " << rank;
+    reduced[i] = true;
+  }
+  // drop the size 1 dims and merge the adjacent dims of the same kind
+  std::vector<int64_t> dims;
+  std::vector<bool> groups;
+  int64_t size = 1;
+  int64_t count = 1;
+  for (int i = 0; i < rank; i++) {
+    size *= x_dims[i];
+    if (reduced[i]) count *= x_dims[i];
+    if (x_dims[i] == 1) continue;
+    if (!groups.empty() && groups.back() == reduced[i]) {
+      dims.back() *= x_dims[i];
+    } else {
+      dims.push_back(x_dims[i]);
+      groups.push_back(reduced[i]);
+    }
+  }
+  if (size == 0) return;
+  if (std::find(groups.begin(), groups.end(), true) == groups.end()) {
+    std::memcpy(dout, din, sizeof(T) * size);
+    return;
+  }
+  switch (type) {
+    case ReduceType::kSum:
+    case ReduceType::kMean:
+      reduce_impl<T, ReduceType::kSum>(din, dout, dims, groups, threads);
+      break;
+    case ReduceType::kMax:
+      reduce_impl<T, ReduceType::kMax>(din, dout, dims, groups, threads);
+      break;
+    case ReduceType::kMin:
+      reduce_impl<T, ReduceType::kMin>(din, dout, dims, groups, threads);
+      break;
+    case ReduceType::kProd:
+      reduce_impl<T, ReduceType::kProd>(din, dout, dims, groups, threads);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported reduce type " << static_cast<int>(type);
+  }
+  if (type == ReduceType::kMean) {
+    int64_t out_size = size / count;
+    for (int64_t i = 0; i < out_size; i++) {
+      dout[i] = dout[i] / static_cast<T>(count);
+    }
+  }
+}
+
+template void reduce<float>(const float* din,
+                            float* dout,
+                            const std::vector<int64_t>& x_dims,
+                            const std::vector<int>& axes,
+                            ReduceType type,
+                            int threads);
+template void reduce<int32_t>(const int32_t* din,
+                              int32_t* dout,
+                              const std::vector<int64_t>& x_dims,
+                              const std::vector<int>& axes,
+                              ReduceType type,
+                              int threads);
+template void reduce<int64_t>(const int64_t* din,
+                              int64_t* dout,
+                              const std::vector<int64_t>& x_dims,
+                              const std::vector<int>& axes,
+                              ReduceType type,
+                              int threads);
+
+template <>
+void mean_grad<float>(const float* out_grad, float* in_grad, int size) {
+  float grad = out_grad[0] / size;
+  float32x4_t grad_v = vdupq_n_f32(grad);
+  int loop = size >> 2;
+
+  LITE_PARALLEL_BEGIN(i, tid, loop) {
+    vst1q_f32(in_grad + i * 4, grad_v);
+  }
+  LITE_PARALLEL_END()
+  for (int i = loop * 4; i < size; ++i) {
+    in_grad[i] = grad;
+  }
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
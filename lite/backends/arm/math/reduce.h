@@ -0,0 +1,50 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+enum class ReduceType { kSum = 0, kMean, kMax, kMin, kProd };
+
+/**
+ * Reduces `din` of `x_dims` over `axes` into `dout`, all the dims are reduced
+ * if `axes` is empty. The size 1 dims are dropped and the adjacent dims both
+ * kept or both reduced are merged, then the reduced groups are folded from
+ * the innermost one as [outer, len] row or [outer, len, inner] column
+ * reductions with neon accumulators. The rows or column blocks are spread on
+ * the threads, and a long reduction with few outputs is split into the
+ * partial results combined at the end.
+ */
+template <typename T>
+void reduce(const T* din,
+            T* dout,
+            const std::vector<int64_t>& x_dims,
+            const std::vector<int>& axes,
+            ReduceType type,
+            int threads);
+
+template <typename T>
+void mean_grad(const T* out_grad, T* in_grad, int size);
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
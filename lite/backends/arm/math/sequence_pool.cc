@@ -19,6 +19,7 @@
 #include <vector>
 #include "lite/backends/arm/math/funcs.h"
 #include "lite/core/op_registry.h"
+#include "lite/core/parallel_defines.h"
 #include "lite/core/tensor.h"
 #include "lite/core/type_system.h"
 
@@ -30,10 +31,11 @@ namespace math {
 template <typename T>
 void seq_pool_sum(const T* din,
                   T* dout,
-                  const std::vector<uint64_t> lod,
+                  const std::vector<uint64_t>& lod,
                   int64_t width,
                   T pad_value) {
-  for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
+  int num_seq = static_cast<int>(lod.size()) - 1;
+  LITE_PARALLEL_BEGIN(i, tid, num_seq) {
     const T* din_ptr = din + lod[i] * width;
     T* dout_ptr = dout + i * width;
     int64_t height = static_cast<int64_t>(lod[i + 1] - lod[i]);
@@ -61,15 +63,17 @@ void seq_pool_sum(const T* din,
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 template <typename T>
 void seq_pool_average(const T* din,
                       T* dout,
-                      const std::vector<uint64_t> lod,
+                      const std::vector<uint64_t>& lod,
                       int64_t width,
                       T pad_value) {
-  for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
+  int num_seq = static_cast<int>(lod.size()) - 1;
+  LITE_PARALLEL_BEGIN(i, tid, num_seq) {
     const T* din_ptr = din + lod[i] * width;
     T* dout_ptr = dout + i * width;
     int64_t height = static_cast<int64_t>(lod[i + 1] - lod[i]);
@@ -100,15 +104,17 @@ void seq_pool_average(const T* din,
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 template <typename T>
 void seq_pool_sqrt(const T* din,
                    T* dout,
-                   const std::vector<uint64_t> lod,
+                   const std::vector<uint64_t>& lod,
                    int64_t width,
                    T pad_value) {
-  for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
+  int num_seq = static_cast<int>(lod.size()) - 1;
+  LITE_PARALLEL_BEGIN(i, tid, num_seq) {
     const T* din_ptr = din + lod[i] * width;
     T* dout_ptr = dout + i * width;
     int64_t height = static_cast<int64_t>(lod[i + 1] - lod[i]);
@@ -140,16 +146,18 @@ void seq_pool_sqrt(const T* din,
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 template <typename T>
 void seq_pool_max(const T* din,
                   T* dout,
                   int64_t* index,
-                  const std::vector<uint64_t> lod,
+                  const std::vector<uint64_t>& lod,
                   int64_t width,
                   T pad_value) {
-  for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
+  int num_seq = static_cast<int>(lod.size()) - 1;
+  LITE_PARALLEL_BEGIN(i, tid, num_seq) {
     const T* din_ptr = din + lod[i] * width;
     T* dout_ptr = dout + i * width;
     int64_t* index_ptr = index + i * width;
@@ -187,16 +195,18 @@ void seq_pool_max(const T* din,
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 template <typename T>
 void seq_pool_min(const T* din,
                   T* dout,
                   int64_t* index,
-                  const std::vector<uint64_t> lod,
+                  const std::vector<uint64_t>& lod,
                   int64_t width,
                   T pad_value) {
-  for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
+  int num_seq = static_cast<int>(lod.size()) - 1;
+  LITE_PARALLEL_BEGIN(i, tid, num_seq) {
     const T* din_ptr = din + lod[i] * width;
     T* dout_ptr = dout + i * width;
     int64_t* index_ptr = index + i * width;
@@ -234,15 +244,17 @@ void seq_pool_min(const T* din,
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 template <typename T>
 void seq_pool_first(const T* din,
                     T* dout,
-                    const std::vector<uint64_t> lod,
+                    const std::vector<uint64_t>& lod,
                     int64_t width,
                     T pad_value) {
-  for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
+  int num_seq = static_cast<int>(lod.size()) - 1;
+  LITE_PARALLEL_BEGIN(i, tid, num_seq) {
     int64_t height = lod[i + 1] - lod[i];
     const T* din_ptr = din + width * lod[i];
     T* dout_ptr = dout + i * width;
@@ -254,15 +266,17 @@ void seq_pool_first(const T* din,
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 template <typename T>
 void seq_pool_last(const T* din,
                    T* dout,
-                   const std::vector<uint64_t> lod,
+                   const std::vector<uint64_t>& lod,
                    int64_t width,
                    T pad_value) {
-  for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
+  int num_seq = static_cast<int>(lod.size()) - 1;
+  LITE_PARALLEL_BEGIN(i, tid, num_seq) {
     int64_t height = lod[i + 1] - lod[i];
     int64_t seq_len = static_cast<int64_t>(lod[i + 1] - lod[0]);
     const T* din_ptr = din + width * seq_len;
@@ -275,81 +289,82 @@ void seq_pool_last(const T* din,
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 template void seq_pool_sum<float>(const float* din,
                                   float* dout,
-                                  const std::vector<uint64_t> lod,
+                                  const std::vector<uint64_t>& lod,
                                   int64_t width,
                                   float pad_value);
 template void seq_pool_average<float>(const float* din,
                                       float* dout,
-                                      const std::vector<uint64_t> lod,
+                                      const std::vector<uint64_t>& lod,
                                       int64_t width,
                                       float pad_value);
 template void seq_pool_sqrt<float>(const float* din,
                                    float* dout,
-                                   const std::vector<uint64_t> lod,
+                                   const std::vector<uint64_t>& lod,
                                    int64_t width,
                                    float pad_value);
 template void seq_pool_max<float>(const float* din,
                                   float* dout,
                                   int64_t* index,
-                                  const std::vector<uint64_t> lod,
+                                  const std::vector<uint64_t>& lod,
                                   int64_t width,
                                   float pad_value);
 template void seq_pool_min<float>(const float* din,
                                   float* dout,
                                   int64_t* index,
-                                  const std::vector<uint64_t> lod,
+                                  const std::vector<uint64_t>& lod,
                                   int64_t width,
                                   float pad_value);
 template void seq_pool_first<float>(const float* din,
                                     float* dout,
-                                    const std::vector<uint64_t> lod,
+                                    const std::vector<uint64_t>& lod,
                                     int64_t width,
                                     float pad_value);
 template void seq_pool_last<float>(const float* din,
                                    float* dout,
-                                   const std::vector<uint64_t> lod,
+                                   const std::vector<uint64_t>& lod,
                                    int64_t width,
                                    float pad_value);
 #ifdef ENABLE_ARM_FP16
 template void seq_pool_sum<float16_t>(const float16_t* din,
                                       float16_t* dout,
-                                      const std::vector<uint64_t> lod,
+                                      const std::vector<uint64_t>& lod,
                                       int64_t width,
                                       float16_t pad_value);
 template void seq_pool_average<float16_t>(const float16_t* din,
                                           float16_t* dout,
-                                          const std::vector<uint64_t> lod,
+                                          const std::vector<uint64_t>& lod,
                                           int64_t width,
                                           float16_t pad_value);
 template void seq_pool_sqrt<float16_t>(const float16_t* din,
                                        float16_t* dout,
-                                       const std::vector<uint64_t> lod,
+                                       const std::vector<uint64_t>& lod,
                                        int64_t width,
                                        float16_t pad_value);
 template void seq_pool_max<float16_t>(const float16_t* din,
                                       float16_t* dout,
                                       int64_t* index,
-                                      const std::vector<uint64_t> lod,
+                                      const std::vector<uint64_t>& lod,
                                       int64_t width,
                                       float16_t pad_value);
 template void seq_pool_min<float16_t>(const float16_t* din,
                                       float16_t* dout,
                                       int64_t* index,
-                                      const std::vector<uint64_t> lod,
+                                      const std::vector<uint64_t>& lod,
                                       int64_t width,
                                       float16_t pad_value);
 template void seq_pool_first<float16_t>(const float16_t* din,
                                         float16_t* dout,
-                                        const std::vector<uint64_t> lod,
+                                        const std::vector<uint64_t>& lod,
                                         int64_t width,
                                         float16_t pad_value);
 template void seq_pool_last<float16_t>(const float16_t* din,
                                        float16_t* dout,
-                                       const std::vector<uint64_t> lod,
+                                       const std::vector<uint64_t>& lod,
                                        int64_t width,
                                        float16_t pad_value);
 #endif
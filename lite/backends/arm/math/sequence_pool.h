@@ -24,21 +24,21 @@ namespace math {
 template <typename T>
 void seq_pool_sum(const T* din,
                   T* dout,
-                  const std::vector<uint64_t> lod,
+                  const std::vector<uint64_t>& lod,
                   int64_t width,
                   T pad_value);
 
 template <typename T>
 void seq_pool_average(const T* din,
                       T* dout,
-                      const std::vector<uint64_t> lod,
+                      const std::vector<uint64_t>& lod,
                       int64_t width,
                       T pad_value);
 
 template <typename T>
 void seq_pool_sqrt(const T* din,
                    T* dout,
-                   const std::vector<uint64_t> lod,
+                   const std::vector<uint64_t>& lod,
                    int64_t width,
                    T pad_value);
 
@@ -46,7 +46,7 @@ template <typename T>
 void seq_pool_max(const T* din,
                   T* dout,
                   int64_t* index,
-                  const std::vector<uint64_t> lod,
+                  const std::vector<uint64_t>& lod,
                   int64_t width,
                   T pad_value);
 
@@ -54,21 +54,21 @@ template <typename T>
 void seq_pool_min(const T* din,
                   T* dout,
                   int64_t* index,
-                  const std::vector<uint64_t> lod,
+                  const std::vector<uint64_t>& lod,
                   int64_t width,
                   T pad_value);
 
 template <typename T>
 void seq_pool_first(const T* din,
                     T* dout,
-                    const std::vector<uint64_t> lod,
+                    const std::vector<uint64_t>& lod,
                     int64_t width,
                     T pad_value);
 
 template <typename T>
 void seq_pool_last(const T* din,
                    T* dout,
-                   const std::vector<uint64_t> lod,
+                   const std::vector<uint64_t>& lod,
                    int64_t width,
                    T pad_value);
 
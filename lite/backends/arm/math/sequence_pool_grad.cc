@@ -31,7 +31,7 @@ template <>
 void seq_pool_sum_grad<float>(const float* din,
                               const float* dout_grad,
                               float* din_grad,
-                              const std::vector<uint64_t> lod,
+                              const std::vector<uint64_t>& lod,
                               int64_t width) {
   for (int i = 0; i < static_cast<int>(lod.size()) - 1; i++) {
     int64_t height = static_cast<int64_t>(lod[i + 1] - lod[i]);
@@ -58,7 +58,7 @@ template <>
 void seq_pool_average_grad<float>(const float* din,
                                   const float* dout_grad,
                                   float* din_grad,
-                                  const std::vector<uint64_t> lod,
+                                  const std::vector<uint64_t>& lod,
                                   int64_t width) {
   for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
     int64_t height = static_cast<int64_t>(lod[i + 1] - lod[i]);
@@ -87,7 +87,7 @@ template <>
 void seq_pool_sqrt_grad<float>(const float* din,
                                const float* dout_grad,
                                float* din_grad,
-                               const std::vector<uint64_t> lod,
+                               const std::vector<uint64_t>& lod,
                                int64_t width) {
   for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
     int64_t height = static_cast<int64_t>(lod[i + 1] - lod[i]);
@@ -117,7 +117,7 @@ void seq_pool_max_grad<float>(const float* din,
                               const float* dout_grad,
                               const int64_t* index_grad,
                               float* din_grad,
-                              const std::vector<uint64_t> lod,
+                              const std::vector<uint64_t>& lod,
                               int64_t width) {
   for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
     int64_t height = lod[i + 1] - lod[i];
@@ -143,7 +143,7 @@ template <>
 void seq_pool_first_grad<float>(const float* din,
                                 const float* dout_grad,
                                 float* din_grad,
-                                const std::vector<uint64_t> lod,
+                                const std::vector<uint64_t>& lod,
                                 int64_t width) {
   for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
     int64_t height = lod[i + 1] - lod[i];
@@ -168,7 +168,7 @@ template <>
 void seq_pool_last_grad<float>(const float* din,
                                const float* dout_grad,
                                float* din_grad,
-                               const std::vector<uint64_t> lod,
+                               const std::vector<uint64_t>& lod,
                                int64_t width) {
   for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
     int64_t height = lod[i + 1] - lod[i];
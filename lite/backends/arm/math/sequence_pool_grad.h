@@ -25,21 +25,21 @@ template <typename T>
 void seq_pool_sum_grad(const T* din,
                        const T* dout_grad,
                        T* din_grad,
-                       const std::vector<uint64_t> lod,
+                       const std::vector<uint64_t>& lod,
                        int64_t width);
 
 template <typename T>
 void seq_pool_average_grad(const T* din,
                            const T* dout_grad,
                            T* din_grad,
-                           const std::vector<uint64_t> lod,
+                           const std::vector<uint64_t>& lod,
                            int64_t width);
 
 template <typename T>
 void seq_pool_sqrt_grad(const T* din,
                         const T* dout_grad,
                         T* din_grad,
-                        const std::vector<uint64_t> lod,
+                        const std::vector<uint64_t>& lod,
                         int64_t width);
 
 template <typename T>
@@ -47,21 +47,21 @@ void seq_pool_max_grad(const T* din,
                        const T* dout_grad,
                        const int64_t* index_grad,
                        T* din_grad,
-                       const std::vector<uint64_t> lod,
+                       const std::vector<uint64_t>& lod,
                        int64_t width);
 
 template <typename T>
 void seq_pool_first_grad(const T* din,
                          const T* dout_grad,
                          T* din_grad,
-                         const std::vector<uint64_t> lod,
+                         const std::vector<uint64_t>& lod,
                          int64_t width);
 
 template <typename T>
 void seq_pool_last_grad(const T* din,
                         const T* dout_grad,
                         T* din_grad,
-                        const std::vector<uint64_t> lod,
+                        const std::vector<uint64_t>& lod,
                         int64_t width);
 
 }  // namespace math
@@ -77,6 +77,116 @@ void sgemm(bool is_transA,
                 ctx);
 }
 
+void sgemm_strided_batch(const host::math::StridedMatmulArgs& args,
+                         float alpha,
+                         const float* x,
+                         const float* y,
+                         float* out,
+                         ARMContext* ctx) {
+  int hblock = get_hblock(ctx, args.m);
+  int m_roundup = hblock * ((args.m + hblock - 1) / hblock);
+  ctx->ExtendWorkspace(m_roundup * args.k * sizeof(float));
+  auto packed_x = static_cast<float*>(ctx->workspace_data<float>()) +
+                  ctx->llc_size() / sizeof(float);
+  operators::ActivationParam act_param;
+  act_param.has_active = false;
+  for (size_t b = 0; b < args.out_offsets.size(); ++b) {
+    // a broadcast X is packed once
+    if (b == 0 || args.x_offsets[b] != args.x_offsets[b - 1]) {
+      prepackA(packed_x,
+               x + args.x_offsets[b],
+               alpha,
+               args.ldx,
+               0,
+               args.m,
+               0,
+               args.k,
+               args.trans_x,
+               ctx);
+    }
+    sgemm_prepack(args.trans_y,
+                  args.m,
+                  args.n,
+                  args.k,
+                  packed_x,
+                  y + args.y_offsets[b],
+                  args.ldy,
+                  0.f,
+                  out + args.out_offsets[b],
+                  args.ldout,
+                  nullptr,
+                  false,
+                  act_param,
+                  ctx);
+  }
+}
+
+void prepack_recurrent_weight(const float* W,
+                              bool is_trans,
+                              int N,
+                              int K,
+                              Tensor* packed,
+                              ARMContext* ctx) {
+  int hblock = get_hblock(ctx, N);
+  int n_roundup = hblock * ((N + hblock - 1) / hblock);
+  packed->Resize({n_roundup * K});
+  // W^T is the transpose of a [K,N] W and a plain read of a [N,K] one
+  prepackA(packed->mutable_data<float>(),
+           W,
+           1.f,
+           is_trans ? K : N,
+           0,
+           N,
+           0,
+           K,
+           !is_trans,
+           ctx);
+}
+
+void sgemm_recurrent(const Tensor& packed,
+                     const float* X,
+                     int M,
+                     int N,
+                     int K,
+                     float beta,
+                     float* Y,
+                     ARMContext* ctx) {
+  // Y^T[N,M] = W^T * X^T, put behind the cache part of the workspace that
+  // sgemm_prepack packs X into
+  ctx->ExtendWorkspace(M * N * sizeof(float));
+  auto yt = static_cast<float*>(ctx->workspace_data<float>()) +
+            ctx->llc_size() / sizeof(float);
+  operators::ActivationParam act_param;
+  act_param.has_active = false;
+  sgemm_prepack(true,
+                N,
+                M,
+                K,
+                packed.data<float>(),
+                X,
+                K,
+                0.f,
+                yt,
+                M,
+                nullptr,
+                false,
+                act_param,
+                ctx);
+  for (int i = 0; i < M; ++i) {
+    float* y = Y + i * N;
+    const float* src = yt + i;
+    if (beta == 0.f) {
+      for (int j = 0; j < N; ++j) {
+        y[j] = src[j * M];
+      }
+    } else {
+      for (int j = 0; j < N; ++j) {
+        y[j] = src[j * M] + beta * y[j];
+      }
+    }
+  }
+}
+
 }  // namespace math
 }  // namespace arm
 }  // namespace lite
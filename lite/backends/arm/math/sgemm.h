@@ -17,6 +17,7 @@
 #include <cmath>
 #include "lite/backends/arm/math/packed_sgemm.h"
 #include "lite/backends/arm/math/sgemv.h"
+#include "lite/backends/host/math/strided_matmul.h"
 #include "lite/core/context.h"
 #include "lite/core/device_info.h"
 
@@ -43,6 +44,34 @@ void sgemm(bool is_transA,
            const operators::ActivationParam act_param,
            ARMContext* ctx);
 
+// The gemms of a matmul with fused transposes, see StridedMatmulArgs. They
+// always take the packed path, as the gemv ones assume dense leading dims.
+void sgemm_strided_batch(const host::math::StridedMatmulArgs& args,
+                         float alpha,
+                         const float* x,
+                         const float* y,
+                         float* out,
+                         ARMContext* ctx);
+
+// Recurrent gemm Y[M,N] = X[M,K] * W + beta * Y with a constant weight W,
+// which is [K,N] or, if is_trans, [N,K]. W^T is packed once as the A
+// matrix of the packed gemm, so the steps only pack their small X.
+void prepack_recurrent_weight(const float* W,
+                              bool is_trans,
+                              int N,
+                              int K,
+                              Tensor* packed,
+                              ARMContext* ctx);
+
+void sgemm_recurrent(const Tensor& packed,
+                     const float* X,
+                     int M,
+                     int N,
+                     int K,
+                     float beta,
+                     float* Y,
+                     ARMContext* ctx);
+
 }  // namespace math
 }  // namespace arm
 }  // namespace lite
@@ -0,0 +1,145 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "lite/backends/arm/math/packed_sgemm.h"
+#include "lite/core/kernel_tuner.h"
+#include "lite/utils/timer.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+namespace {
+// The cache size timed by the tuning on this thread, 0 if not tuning.
+LITE_THREAD_LOCAL size_t tuning_cache_size = 0;
+
+// The size tuned for the llc, the power mode and the threads of this
+// thread, which are looked up again once any of them changes.
+struct TunedCacheSize {
+  int llc{0};
+  int mode{-1};
+  int threads{0};
+  size_t size{0};
+};
+LITE_THREAD_LOCAL TunedCacheSize tuned;
+
+std::string GemmBlockTuneKey(ARMContext* ctx) {
+  std::stringstream ss;
+  ss << KernelTuner::DeviceKey() << "|sgemm_block|l2:" << ctx->l2_cache_size()
+     << ",l3:" << ctx->l3_cache_size() << ",llc:" << ctx->llc_size();
+  return ss.str();
+}
+
+// The time of a gemm whose packed B is several times of the llc, so each
+// candidate is used by the blocking.
+uint64_t TimeGemm(ARMContext* ctx, size_t cache_size, int repeats) {
+  const int K = 256;
+  const int M = 64;
+  int N = static_cast<int>(
+      std::min<size_t>(2 * ctx->llc_size() / (sizeof(float) * K), 16384));
+  N = std::max(N, 1024);
+  std::vector<float> a(M * K, 0.5f);
+  std::vector<float> b(K * N, 0.25f);
+  std::vector<float> c(M * N);
+  int hblock = get_hblock(ctx, M);
+  std::vector<float> packed_a(hblock * ((M + hblock - 1) / hblock) * K);
+  prepackA(packed_a.data(), a.data(), 1.f, K, 0, M, 0, K, false, ctx);
+  operators::ActivationParam act_param;
+  act_param.has_active = false;
+  tuning_cache_size = cache_size;
+  auto run = [&] {
+    sgemm_prepack(false,
+                  M,
+                  N,
+                  K,
+                  packed_a.data(),
+                  b.data(),
+                  N,
+                  0.f,
+                  c.data(),
+                  N,
+                  nullptr,
+                  false,
+                  act_param,
+                  ctx);
+  };
+  // Warm up the caches and the workspace first.
+  run();
+  uint64_t start = Timer::GetCurrentUS();
+  for (int i = 0; i < repeats; i++) run();
+  uint64_t elapsed = Timer::GetCurrentUS() - start;
+  tuning_cache_size = 0;
+  return elapsed;
+}
+
+size_t TuneGemmBlockCacheSize(ARMContext* ctx, size_t llc) {
+  auto& tuner = KernelTuner::Global();
+  auto key = GemmBlockTuneKey(ctx);
+  std::string choice;
+  if (tuner.Lookup(key, &choice)) {
+    size_t size = std::stoul(choice);
+    return size > 0 && size <= llc ? size : llc;
+  }
+  // The panels must fit in the cache part of the workspace.
+  std::vector<size_t> candidates{llc};
+  for (size_t size : {llc / 2,
+                      llc / 4,
+                      static_cast<size_t>(std::max(ctx->l2_cache_size(), 0))}) {
+    if (size >= 64 * 1024 && size < llc &&
+        std::find(candidates.begin(), candidates.end(), size) ==
+            candidates.end()) {
+      candidates.push_back(size);
+    }
+  }
+  size_t best = llc;
+  uint64_t best_time = 0;
+  for (size_t i = 0; i < candidates.size(); i++) {
+    uint64_t elapsed = TimeGemm(ctx, candidates[i], tuner.repeats());
+    VLOG(4) << "sgemm blocked by " << candidates[i] << " bytes: " << elapsed
+            << " us";
+    if (i == 0 || elapsed < best_time) {
+      best = candidates[i];
+      best_time = elapsed;
+    }
+  }
+  tuner.Record(key, std::to_string(best));
+  VLOG(4) << "Tuned " << key << ": " << best;
+  return best;
+}
+}  // namespace
+
+size_t sgemm_block_cache_size(ARMContext* ctx) {
+  if (tuning_cache_size > 0) return tuning_cache_size;
+  size_t llc = ctx->llc_size() > 0 ? ctx->llc_size() : 512 * 1024;
+  if (!KernelTuner::Global().enabled()) return llc;
+  int mode = static_cast<int>(DeviceInfo::Global().mode());
+  if (tuned.size == 0 || tuned.llc != ctx->llc_size() || tuned.mode != mode ||
+      tuned.threads != ctx->threads()) {
+    tuned.llc = ctx->llc_size();
+    tuned.mode = mode;
+    tuned.threads = ctx->threads();
+    tuned.size = TuneGemmBlockCacheSize(ctx, llc);
+  }
+  return tuned.size;
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -15,7 +15,12 @@
 #include "lite/backends/arm/math/softmax.h"
 #include <algorithm>
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/core/device_info.h"
+#include "lite/core/fast_math.h"
 #include "lite/core/parallel_defines.h"
+#if defined(__aarch64__) && defined(WITH_ARM_SVE)
+#include "lite/backends/arm/math/sve/funcs_sve.h"
+#endif
 
 namespace paddle {
 namespace lite {
@@ -68,6 +73,7 @@ void softmax_inner8_axis4<float>(const float* din,
                                  const int axis_size,
                                  const int inner_num,
                                  const int outer_num) {
+  const bool fast_math = FastMath::Enabled();
   int compute_size = inner_num * outer_num;
   int cmp_cnt = compute_size >> 3;
   int remain = compute_size % 8;
@@ -106,15 +112,15 @@ void softmax_inner8_axis4<float>(const float* din,
     float32x4_t vmax_1 = vmaxq_f32(vmax11, vmax21);
 
     // sub, exp and sum
-    float32x4_t vsum0 = exp_ps(vsubq_f32(vdata0, vmax));
-    float32x4_t vsum1 = exp_ps(vsubq_f32(vdata1, vmax));
-    float32x4_t vsum2 = exp_ps(vsubq_f32(vdata2, vmax));
-    float32x4_t vsum3 = exp_ps(vsubq_f32(vdata3, vmax));
+    float32x4_t vsum0 = exp_ps(vsubq_f32(vdata0, vmax), fast_math);
+    float32x4_t vsum1 = exp_ps(vsubq_f32(vdata1, vmax), fast_math);
+    float32x4_t vsum2 = exp_ps(vsubq_f32(vdata2, vmax), fast_math);
+    float32x4_t vsum3 = exp_ps(vsubq_f32(vdata3, vmax), fast_math);
 
-    float32x4_t vsum01 = exp_ps(vsubq_f32(vdata01, vmax_1));
-    float32x4_t vsum11 = exp_ps(vsubq_f32(vdata11, vmax_1));
-    float32x4_t vsum21 = exp_ps(vsubq_f32(vdata21, vmax_1));
-    float32x4_t vsum31 = exp_ps(vsubq_f32(vdata31, vmax_1));
+    float32x4_t vsum01 = exp_ps(vsubq_f32(vdata01, vmax_1), fast_math);
+    float32x4_t vsum11 = exp_ps(vsubq_f32(vdata11, vmax_1), fast_math);
+    float32x4_t vsum21 = exp_ps(vsubq_f32(vdata21, vmax_1), fast_math);
+    float32x4_t vsum31 = exp_ps(vsubq_f32(vdata31, vmax_1), fast_math);
 
     float32x4_t vsum_1 = vaddq_f32(vsum0, vsum1);
     float32x4_t vsum_2 = vaddq_f32(vsum2, vsum3);
@@ -174,10 +180,10 @@ void softmax_inner8_axis4<float>(const float* din,
     float32x4_t vmax = vmaxq_f32(vmax1, vmax2);
 
     // sub, exp and sum
-    float32x4_t vsum0 = exp_ps(vsubq_f32(vdata0, vmax));
-    float32x4_t vsum1 = exp_ps(vsubq_f32(vdata1, vmax));
-    float32x4_t vsum2 = exp_ps(vsubq_f32(vdata2, vmax));
-    float32x4_t vsum3 = exp_ps(vsubq_f32(vdata3, vmax));
+    float32x4_t vsum0 = exp_ps(vsubq_f32(vdata0, vmax), fast_math);
+    float32x4_t vsum1 = exp_ps(vsubq_f32(vdata1, vmax), fast_math);
+    float32x4_t vsum2 = exp_ps(vsubq_f32(vdata2, vmax), fast_math);
+    float32x4_t vsum3 = exp_ps(vsubq_f32(vdata3, vmax), fast_math);
 
     float32x4_t vsum_1 = vaddq_f32(vsum0, vsum1);
     float32x4_t vsum_2 = vaddq_f32(vsum2, vsum3);
@@ -237,6 +243,7 @@ void softmax_inner4_axis4<float>(const float* din,
                                  const int axis_size,
                                  const int inner_num,
                                  const int outer_num) {
+  const bool fast_math = FastMath::Enabled();
   int compute_size = inner_num * outer_num;
   int cmp_cnt = compute_size >> 2;
   int remain = compute_size % 4;
@@ -267,10 +274,10 @@ void softmax_inner4_axis4<float>(const float* din,
     float32x4_t vmax = vmaxq_f32(vmax1, vmax2);
 
     // sub, exp and sum
-    float32x4_t vsum0 = exp_ps(vsubq_f32(vdata0, vmax));
-    float32x4_t vsum1 = exp_ps(vsubq_f32(vdata1, vmax));
-    float32x4_t vsum2 = exp_ps(vsubq_f32(vdata2, vmax));
-    float32x4_t vsum3 = exp_ps(vsubq_f32(vdata3, vmax));
+    float32x4_t vsum0 = exp_ps(vsubq_f32(vdata0, vmax), fast_math);
+    float32x4_t vsum1 = exp_ps(vsubq_f32(vdata1, vmax), fast_math);
+    float32x4_t vsum2 = exp_ps(vsubq_f32(vdata2, vmax), fast_math);
+    float32x4_t vsum3 = exp_ps(vsubq_f32(vdata3, vmax), fast_math);
 
     float32x4_t vsum_1 = vaddq_f32(vsum0, vsum1);
     float32x4_t vsum_2 = vaddq_f32(vsum2, vsum3);
@@ -330,6 +337,7 @@ void softmax_inner8<float>(const float* din,
                            const int axis_size,
                            const int inner_num,
                            const int outer_num) {
+  const bool fast_math = FastMath::Enabled();
   int compute_size = inner_num * outer_num;
   int cmp_cnt = compute_size >> 3;
   LITE_PARALLEL_BEGIN(c, tid, cmp_cnt) {
@@ -355,8 +363,8 @@ void softmax_inner8<float>(const float* din,
     float* dout_ptr = dout + real_index;
     float32x4_t vdata = vld1q_f32(din_ptr);
     float32x4_t vdata2 = vld1q_f32(din_ptr + 4);
-    float32x4_t vsum = exp_ps(vsubq_f32(vdata, vmax));
-    float32x4_t vsum2 = exp_ps(vsubq_f32(vdata2, vmax2));
+    float32x4_t vsum = exp_ps(vsubq_f32(vdata, vmax), fast_math);
+    float32x4_t vsum2 = exp_ps(vsubq_f32(vdata2, vmax2), fast_math);
     din_ptr += inner_num;
     vst1q_f32(dout_ptr, vsum);
     vst1q_f32(dout_ptr + 4, vsum2);
@@ -364,8 +372,8 @@ void softmax_inner8<float>(const float* din,
     for (int j = 1; j < axis_size; ++j) {
       float32x4_t vdata0 = vld1q_f32(din_ptr);
       float32x4_t vdata1 = vld1q_f32(din_ptr + 4);
-      vdata0 = exp_ps(vsubq_f32(vdata0, vmax));
-      vdata1 = exp_ps(vsubq_f32(vdata1, vmax2));
+      vdata0 = exp_ps(vsubq_f32(vdata0, vmax), fast_math);
+      vdata1 = exp_ps(vsubq_f32(vdata1, vmax2), fast_math);
       din_ptr += inner_num;
       vsum = vaddq_f32(vsum, vdata0);
       vsum2 = vaddq_f32(vsum2, vdata1);
@@ -429,6 +437,7 @@ void softmax_inner4<float>(const float* din,
                            const int axis_size,
                            const int inner_num,
                            const int outer_num) {
+  const bool fast_math = FastMath::Enabled();
   int compute_size = inner_num * outer_num;
   int cmp_cnt = compute_size >> 2;
   LITE_PARALLEL_BEGIN(c, tid, cmp_cnt) {
@@ -450,14 +459,14 @@ void softmax_inner4<float>(const float* din,
     din_ptr = din + real_index;
     float* dout_ptr = dout + real_index;
     float32x4_t vdata = vld1q_f32(din_ptr);
-    float32x4_t vsum = exp_ps(vsubq_f32(vdata, vmax));
+    float32x4_t vsum = exp_ps(vsubq_f32(vdata, vmax), fast_math);
     din_ptr += inner_num;
     vst1q_f32(dout_ptr, vsum);
     dout_ptr += inner_num;
     for (int j = 1; j < axis_size; ++j) {
       // real_index += inner_num;
       float32x4_t vdata0 = vld1q_f32(din_ptr);
-      vdata0 = exp_ps(vsubq_f32(vdata0, vmax));
+      vdata0 = exp_ps(vsubq_f32(vdata0, vmax), fast_math);
       din_ptr += inner_num;
       vsum = vaddq_f32(vsum, vdata0);
       vst1q_f32(dout_ptr, vdata0);
@@ -514,6 +523,17 @@ void softmax_inner1_large_axis<float>(const float* din,
                                       float* dout,
                                       const int outer_size,
                                       const int axis_size) {
+  const bool fast_math = FastMath::Enabled();
+#if defined(__aarch64__) && defined(WITH_ARM_SVE)
+  if (DeviceInfo::Global().has_sve()) {
+    LITE_PARALLEL_BEGIN(i, tid, outer_size) {
+      sve::softmax_inner1_sve(
+          din + i * axis_size, dout + i * axis_size, axis_size);
+    }
+    LITE_PARALLEL_END();
+    return;
+  }
+#endif
   LITE_PARALLEL_BEGIN(i, tid, outer_size) {
     const float* din_ptr = din + i * axis_size;
     float* dout_ptr = dout + i * axis_size;
@@ -540,7 +560,8 @@ void softmax_inner1_large_axis<float>(const float* din,
     const float* din_sum_ptr = din_ptr;
     float* dout_sum_ptr = dout_ptr;
     vmax = vdupq_n_f32(max_data);
-    float32x4_t vsub_exp = exp_ps(vsubq_f32(vld1q_f32(din_sum_ptr), vmax));
+    float32x4_t vsub_exp =
+        exp_ps(vsubq_f32(vld1q_f32(din_sum_ptr), vmax), fast_math);
     float32x4_t vsum = vsub_exp;
     vst1q_f32(dout_sum_ptr, vsub_exp);
     din_sum_ptr += 4;
@@ -548,7 +569,7 @@ void softmax_inner1_large_axis<float>(const float* din,
 
     j = 1;
     for (; j < nn; ++j) {
-      vsub_exp = exp_ps(vsubq_f32(vld1q_f32(din_sum_ptr), vmax));
+      vsub_exp = exp_ps(vsubq_f32(vld1q_f32(din_sum_ptr), vmax), fast_math);
       vst1q_f32(dout_sum_ptr, vsub_exp);
       vsum = vaddq_f32(vsum, vsub_exp);
       din_sum_ptr += 4;
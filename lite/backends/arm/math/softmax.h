@@ -65,6 +65,16 @@ void softmax_inner1_small_axis(const T* din,
                                const int outer_size,
                                const int axis_size);
 
+// in place softmax of each row of a [rows, cols] matrix, for the kernels which
+// apply it to their output while it is still in the cache
+inline void softmax_rows(float* data, int rows, int cols) {
+  if (cols > 4) {
+    softmax_inner1_large_axis(data, data, rows, cols);
+  } else {
+    softmax_inner1_small_axis(data, data, rows, cols);
+  }
+}
+
 }  // namespace math
 }  // namespace arm
 }  // namespace lite
@@ -0,0 +1,122 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/sve/elementwise_sve.h"
+#include "lite/backends/arm/math/sve/math_sve.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace sve {
+
+namespace {
+struct AddOp {
+  svfloat32_t operator()(svbool_t pg, svfloat32_t x, svfloat32_t y) const {
+    return svadd_f32_x(pg, x, y);
+  }
+};
+
+struct SubOp {
+  svfloat32_t operator()(svbool_t pg, svfloat32_t x, svfloat32_t y) const {
+    return svsub_f32_x(pg, x, y);
+  }
+};
+
+struct MulOp {
+  svfloat32_t operator()(svbool_t pg, svfloat32_t x, svfloat32_t y) const {
+    return svmul_f32_x(pg, x, y);
+  }
+};
+
+template <typename Op, bool kRelu>
+inline svfloat32_t compute(svbool_t pg, svfloat32_t x, svfloat32_t y) {
+  svfloat32_t out = Op()(pg, x, y);
+  return kRelu ? svmax_n_f32_x(pg, out, 0.f) : out;
+}
+
+// Two vectors each iteration, and the tail is predicated instead of the
+// scalar loop of the neon kernels.
+template <typename Op, bool kRelu>
+void elementwise_compute(const float* dinx,
+                         const float* diny,
+                         float* dout,
+                         int num) {
+  const int step = svcntw();
+  const svbool_t all = svptrue_b32();
+  int i = 0;
+  for (; i + 2 * step <= num; i += 2 * step) {
+    svfloat32_t x0 = svld1_f32(all, dinx + i);
+    svfloat32_t x1 = svld1_f32(all, dinx + i + step);
+    svfloat32_t y0 = svld1_f32(all, diny + i);
+    svfloat32_t y1 = svld1_f32(all, diny + i + step);
+    svst1_f32(all, dout + i, compute<Op, kRelu>(all, x0, y0));
+    svst1_f32(all, dout + i + step, compute<Op, kRelu>(all, x1, y1));
+  }
+  for (; i < num; i += step) {
+    svbool_t pg = svwhilelt_b32(i, num);
+    svfloat32_t x = svld1_f32(pg, dinx + i);
+    svfloat32_t y = svld1_f32(pg, diny + i);
+    svst1_f32(pg, dout + i, compute<Op, kRelu>(pg, x, y));
+  }
+}
+}  // namespace
+
+void elementwise_add_sve(const float* dinx,
+                         const float* diny,
+                         float* dout,
+                         int num) {
+  elementwise_compute<AddOp, false>(dinx, diny, dout, num);
+}
+
+void elementwise_add_relu_sve(const float* dinx,
+                              const float* diny,
+                              float* dout,
+                              int num) {
+  elementwise_compute<AddOp, true>(dinx, diny, dout, num);
+}
+
+void elementwise_sub_sve(const float* dinx,
+                         const float* diny,
+                         float* dout,
+                         int num) {
+  elementwise_compute<SubOp, false>(dinx, diny, dout, num);
+}
+
+void elementwise_sub_relu_sve(const float* dinx,
+                              const float* diny,
+                              float* dout,
+                              int num) {
+  elementwise_compute<SubOp, true>(dinx, diny, dout, num);
+}
+
+void elementwise_mul_sve(const float* dinx,
+                         const float* diny,
+                         float* dout,
+                         int num) {
+  elementwise_compute<MulOp, false>(dinx, diny, dout, num);
+}
+
+void elementwise_mul_relu_sve(const float* dinx,
+                              const float* diny,
+                              float* dout,
+                              int num) {
+  elementwise_compute<MulOp, true>(dinx, diny, dout, num);
+}
+
+}  // namespace sve
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
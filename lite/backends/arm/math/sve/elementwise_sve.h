@@ -0,0 +1,53 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace sve {
+// The kernels of the contiguous float inputs of the same shape, in the length
+// of the sve vectors of the cpu. They run in the calling thread, and are only
+// called if DeviceInfo::has_sve() is true.
+void elementwise_add_sve(const float* dinx,
+                         const float* diny,
+                         float* dout,
+                         int num);
+void elementwise_add_relu_sve(const float* dinx,
+                              const float* diny,
+                              float* dout,
+                              int num);
+void elementwise_sub_sve(const float* dinx,
+                         const float* diny,
+                         float* dout,
+                         int num);
+void elementwise_sub_relu_sve(const float* dinx,
+                              const float* diny,
+                              float* dout,
+                              int num);
+void elementwise_mul_sve(const float* dinx,
+                         const float* diny,
+                         float* dout,
+                         int num);
+void elementwise_mul_relu_sve(const float* dinx,
+                              const float* diny,
+                              float* dout,
+                              int num);
+}  // namespace sve
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
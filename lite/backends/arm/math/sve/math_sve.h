@@ -0,0 +1,60 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <arm_sve.h>
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace sve {
+// The helpers of the sve vectors, which must only be included by the sources
+// in sve/ built with the sve instructions.
+
+// The same approximation as exp_ps in funcs.h, of the active lanes in `pg`.
+inline svfloat32_t exp_ps_sve(svbool_t pg, svfloat32_t x) {
+  const float exp_hi = 88.3762626647949f;
+  const float exp_lo = -88.3762626647949f;
+  const float cephes_log2ef = 1.44269504088896341f;
+  const float cephes_exp_c1 = 0.693359375f;
+  const float cephes_exp_c2 = -2.12194440e-4f;
+  x = svmin_n_f32_x(pg, x, exp_hi);
+  x = svmax_n_f32_x(pg, x, exp_lo);
+
+  // express exp(x) as exp(g + n*log(2))
+  svfloat32_t fx = svmla_n_f32_x(pg, svdup_n_f32(0.5f), x, cephes_log2ef);
+  fx = svrintm_f32_x(pg, fx);
+  x = svmls_n_f32_x(pg, x, fx, cephes_exp_c1);
+  x = svmls_n_f32_x(pg, x, fx, cephes_exp_c2);
+
+  svfloat32_t z = svmul_f32_x(pg, x, x);
+  svfloat32_t y = svdup_n_f32(1.9875691500E-4f);
+  y = svmad_n_f32_x(pg, y, x, 1.3981999507E-3f);
+  y = svmad_n_f32_x(pg, y, x, 8.3334519073E-3f);
+  y = svmad_n_f32_x(pg, y, x, 4.1665795894E-2f);
+  y = svmad_n_f32_x(pg, y, x, 1.6666665459E-1f);
+  y = svmad_n_f32_x(pg, y, x, 5.0000001201E-1f);
+  y = svmla_f32_x(pg, x, y, z);
+  y = svadd_n_f32_x(pg, y, 1.f);
+
+  // multiply by 2^n
+  return svscale_f32_x(pg, y, svcvt_s32_f32_x(pg, fx));
+}
+}  // namespace sve
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,69 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/sve/norm_sve.h"
+#include <math.h>
+#include "lite/backends/arm/math/sve/math_sve.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace sve {
+
+void matrix_norm_row_sve(const float* x,
+                         const float* scale,
+                         const float* bias,
+                         float* out,
+                         float* mean_out,
+                         float* var_out,
+                         float epsilon,
+                         int feature_size) {
+  const int step = svcntw();
+  const svbool_t all = svptrue_b32();
+  // get mean and variance
+  svfloat32_t vsum = svdup_n_f32(0.f);
+  svfloat32_t vsquare = svdup_n_f32(0.f);
+  for (int i = 0; i < feature_size; i += step) {
+    svbool_t pg = svwhilelt_b32(i, feature_size);
+    svfloat32_t vx = svld1_f32(pg, x + i);
+    vsum = svadd_f32_m(pg, vsum, vx);
+    vsquare = svmla_f32_m(pg, vsquare, vx, vx);
+  }
+  float mean = svaddv_f32(all, vsum) / feature_size;
+  float variance = svaddv_f32(all, vsquare) / feature_size - mean * mean;
+  *mean_out = mean;
+  *var_out = variance;
+
+  // compute norm_out
+  float rvar = 1.f / sqrtf(variance + epsilon);
+  for (int i = 0; i < feature_size; i += step) {
+    svbool_t pg = svwhilelt_b32(i, feature_size);
+    svfloat32_t vx = svsub_n_f32_x(pg, svld1_f32(pg, x + i), mean);
+    vx = svmul_n_f32_x(pg, vx, rvar);
+    if (scale) {
+      vx = svmul_f32_x(pg, vx, svld1_f32(pg, scale + i));
+    }
+    if (bias) {
+      vx = svadd_f32_x(pg, vx, svld1_f32(pg, bias + i));
+    }
+    svst1_f32(pg, out + i, vx);
+  }
+}
+
+}  // namespace sve
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,36 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace sve {
+// Normalize a row of `feature_size` of the layer_norm, the same as a row of
+// matrix_norm_row. `scale` and `bias` may be nullptr.
+void matrix_norm_row_sve(const float* x,
+                         const float* scale,
+                         const float* bias,
+                         float* out,
+                         float* mean_out,
+                         float* var_out,
+                         float epsilon,
+                         int feature_size);
+}  // namespace sve
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,59 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/sve/softmax_sve.h"
+#include <float.h>
+#include "lite/backends/arm/math/sve/math_sve.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace sve {
+
+void softmax_inner1_sve(const float* din, float* dout, int axis_size) {
+  const int step = svcntw();
+  const svbool_t all = svptrue_b32();
+  // get max
+  svfloat32_t vmax = svdup_n_f32(-FLT_MAX);
+  for (int i = 0; i < axis_size; i += step) {
+    svbool_t pg = svwhilelt_b32(i, axis_size);
+    vmax = svmax_f32_m(pg, vmax, svld1_f32(pg, din + i));
+  }
+  float max_data = svmaxv_f32(all, vmax);
+
+  // sub, exp and sum
+  svfloat32_t vsum = svdup_n_f32(0.f);
+  for (int i = 0; i < axis_size; i += step) {
+    svbool_t pg = svwhilelt_b32(i, axis_size);
+    svfloat32_t vexp =
+        exp_ps_sve(pg, svsub_n_f32_x(pg, svld1_f32(pg, din + i), max_data));
+    svst1_f32(pg, dout + i, vexp);
+    vsum = svadd_f32_m(pg, vsum, vexp);
+  }
+  float sum_inv = 1.f / svaddv_f32(all, vsum);
+
+  // get softmax result
+  for (int i = 0; i < axis_size; i += step) {
+    svbool_t pg = svwhilelt_b32(i, axis_size);
+    svfloat32_t vout = svld1_f32(pg, dout + i);
+    svst1_f32(pg, dout + i, svmul_n_f32_x(pg, vout, sum_inv));
+  }
+}
+
+}  // namespace sve
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
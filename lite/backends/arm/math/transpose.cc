@@ -0,0 +1,351 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/transpose.h"
+#include <arm_neon.h>
+#include <algorithm>
+#include <cstring>
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/log/logging.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// The tile of the innermost pair handled by a task, in elements.
+static constexpr int kTransTile = 32;
+// The rows copied by a task if the innermost dim is kept, in bytes.
+static constexpr int64_t kTransCopyBytes = 16384;
+
+// Transposes a kSize x kSize register block, in[i * ld_in + j] goes to
+// out[j * ld_out + i].
+template <typename T>
+struct TransBlock {
+  static constexpr int kSize = 1;
+  static void Run(const T* in, int64_t ld_in, T* out, int64_t ld_out) {
+    *out = *in;
+  }
+};
+
+template <>
+struct TransBlock<uint32_t> {
+  static constexpr int kSize = 4;
+  static void Run(const uint32_t* in,
+                  int64_t ld_in,
+                  uint32_t* out,
+                  int64_t ld_out) {
+    uint32x4_t r0 = vld1q_u32(in);
+    uint32x4_t r1 = vld1q_u32(in + ld_in);
+    uint32x4_t r2 = vld1q_u32(in + 2 * ld_in);
+    uint32x4_t r3 = vld1q_u32(in + 3 * ld_in);
+    // 00 10 02 12, 01 11 03 13
+    uint32x4x2_t t01 = vtrnq_u32(r0, r1);
+    // 20 30 22 32, 21 31 23 33
+    uint32x4x2_t t23 = vtrnq_u32(r2, r3);
+    vst1q_u32(out,
+              vcombine_u32(vget_low_u32(t01.val[0]),
+                           vget_low_u32(t23.val[0])));
+    vst1q_u32(out + ld_out,
+              vcombine_u32(vget_low_u32(t01.val[1]),
+                           vget_low_u32(t23.val[1])));
+    vst1q_u32(out + 2 * ld_out,
+              vcombine_u32(vget_high_u32(t01.val[0]),
+                           vget_high_u32(t23.val[0])));
+    vst1q_u32(out + 3 * ld_out,
+              vcombine_u32(vget_high_u32(t01.val[1]),
+                           vget_high_u32(t23.val[1])));
+  }
+};
+
+template <>
+struct TransBlock<uint16_t> {
+  static constexpr int kSize = 8;
+  static void Run(const uint16_t* in,
+                  int64_t ld_in,
+                  uint16_t* out,
+                  int64_t ld_out) {
+    uint16x8x2_t t01 = vtrnq_u16(vld1q_u16(in), vld1q_u16(in + ld_in));
+    uint16x8x2_t t23 =
+        vtrnq_u16(vld1q_u16(in + 2 * ld_in), vld1q_u16(in + 3 * ld_in));
+    uint16x8x2_t t45 =
+        vtrnq_u16(vld1q_u16(in + 4 * ld_in), vld1q_u16(in + 5 * ld_in));
+    uint16x8x2_t t67 =
+        vtrnq_u16(vld1q_u16(in + 6 * ld_in), vld1q_u16(in + 7 * ld_in));
+    // the pairs of rows 0-3 and 4-7, e.g. u0.val[0] = 00 10 20 30 04 14 24 34
+    uint32x4x2_t u0 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[0]),
+                                vreinterpretq_u32_u16(t23.val[0]));
+    uint32x4x2_t u1 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[1]),
+                                vreinterpretq_u32_u16(t23.val[1]));
+    uint32x4x2_t u2 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[0]),
+                                vreinterpretq_u32_u16(t67.val[0]));
+    uint32x4x2_t u3 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[1]),
+                                vreinterpretq_u32_u16(t67.val[1]));
+#define TRANS_U16_STORE(k, a, b, half)                              \
+  vst1q_u16(out + k * ld_out,                                       \
+            vreinterpretq_u16_u32(vcombine_u32(vget_##half##_u32(a), \
+                                               vget_##half##_u32(b))));
+    TRANS_U16_STORE(0, u0.val[0], u2.val[0], low)
+    TRANS_U16_STORE(1, u1.val[0], u3.val[0], low)
+    TRANS_U16_STORE(2, u0.val[1], u2.val[1], low)
+    TRANS_U16_STORE(3, u1.val[1], u3.val[1], low)
+    TRANS_U16_STORE(4, u0.val[0], u2.val[0], high)
+    TRANS_U16_STORE(5, u1.val[0], u3.val[0], high)
+    TRANS_U16_STORE(6, u0.val[1], u2.val[1], high)
+    TRANS_U16_STORE(7, u1.val[1], u3.val[1], high)
+#undef TRANS_U16_STORE
+  }
+};
+
+template <>
+struct TransBlock<uint8_t> {
+  static constexpr int kSize = 8;
+  static void Run(const uint8_t* in,
+                  int64_t ld_in,
+                  uint8_t* out,
+                  int64_t ld_out) {
+    uint8x8x2_t t01 = vtrn_u8(vld1_u8(in), vld1_u8(in + ld_in));
+    uint8x8x2_t t23 = vtrn_u8(vld1_u8(in + 2 * ld_in), vld1_u8(in + 3 * ld_in));
+    uint8x8x2_t t45 = vtrn_u8(vld1_u8(in + 4 * ld_in), vld1_u8(in + 5 * ld_in));
+    uint8x8x2_t t67 = vtrn_u8(vld1_u8(in + 6 * ld_in), vld1_u8(in + 7 * ld_in));
+    // e.g. u02.val[0] = 00 10 20 30 04 14 24 34
+    uint16x4x2_t u02 = vtrn_u16(vreinterpret_u16_u8(t01.val[0]),
+                                vreinterpret_u16_u8(t23.val[0]));
+    uint16x4x2_t u13 = vtrn_u16(vreinterpret_u16_u8(t01.val[1]),
+                                vreinterpret_u16_u8(t23.val[1]));
+    uint16x4x2_t u46 = vtrn_u16(vreinterpret_u16_u8(t45.val[0]),
+                                vreinterpret_u16_u8(t67.val[0]));
+    uint16x4x2_t u57 = vtrn_u16(vreinterpret_u16_u8(t45.val[1]),
+                                vreinterpret_u16_u8(t67.val[1]));
+#define TRANS_U8_STORE(k0, k1, a, b)                             \
+  {                                                              \
+    uint32x2x2_t v = vtrn_u32(vreinterpret_u32_u16(a),           \
+                              vreinterpret_u32_u16(b));          \
+    vst1_u8(out + k0 * ld_out, vreinterpret_u8_u32(v.val[0]));   \
+    vst1_u8(out + k1 * ld_out, vreinterpret_u8_u32(v.val[1]));   \
+  }
+    TRANS_U8_STORE(0, 4, u02.val[0], u46.val[0])
+    TRANS_U8_STORE(1, 5, u13.val[0], u57.val[0])
+    TRANS_U8_STORE(2, 6, u02.val[1], u46.val[1])
+    TRANS_U8_STORE(3, 7, u13.val[1], u57.val[1])
+#undef TRANS_U8_STORE
+  }
+};
+
+// in[i * ld_in + j] goes to out[j * ld_out + i] for the rows x cols tile.
+template <typename T>
+static void transpose_tile(const T* in,
+                           int64_t ld_in,
+                           T* out,
+                           int64_t ld_out,
+                           int rows,
+                           int cols) {
+  constexpr int kSize = TransBlock<T>::kSize;
+  int i = 0;
+  for (; i + kSize <= rows; i += kSize) {
+    int j = 0;
+    for (; j + kSize <= cols; j += kSize) {
+      TransBlock<T>::Run(
+          in + i * ld_in + j, ld_in, out + j * ld_out + i, ld_out);
+    }
+    for (; j < cols; ++j) {
+      for (int k = i; k < i + kSize; ++k) {
+        out[j * ld_out + k] = in[k * ld_in + j];
+      }
+    }
+  }
+  for (; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      out[j * ld_out + i] = in[i * ld_in + j];
+    }
+  }
+}
+
+// The dims left after dropping the size 1 dims and merging the input dims
+// which stay adjacent in the output.
+static void simplify_transpose(const std::vector<int64_t>& dims,
+                               const std::vector<int>& axis,
+                               std::vector<int64_t>* new_dims,
+                               std::vector<int>* new_axis) {
+  int rank = dims.size();
+  std::vector<int> squeezed(rank, -1);
+  std::vector<int64_t> sq_dims;
+  for (int i = 0; i < rank; ++i) {
+    if (dims[i] != 1) {
+      squeezed[i] = sq_dims.size();
+      sq_dims.push_back(dims[i]);
+    }
+  }
+  std::vector<int> sq_axis;
+  for (int i = 0; i < rank; ++i) {
+    if (squeezed[axis[i]] >= 0) sq_axis.push_back(squeezed[axis[i]]);
+  }
+  // the group of every input dim, a group starts where the output order
+  // does not continue the input order
+  int sq_rank = sq_dims.size();
+  std::vector<bool> starts(sq_rank, true);
+  for (int i = 1; i < sq_rank; ++i) {
+    if (sq_axis[i] == sq_axis[i - 1] + 1) starts[sq_axis[i]] = false;
+  }
+  std::vector<int> group(sq_rank, 0);
+  new_dims->clear();
+  for (int i = 0; i < sq_rank; ++i) {
+    if (starts[i]) new_dims->push_back(1);
+    group[i] = new_dims->size() - 1;
+    new_dims->back() *= sq_dims[i];
+  }
+  new_axis->clear();
+  for (int i = 0; i < sq_rank; ++i) {
+    if (starts[sq_axis[i]]) new_axis->push_back(group[sq_axis[i]]);
+  }
+}
+
+template <typename T>
+static void transpose_nd_impl(const T* din,
+                              T* dout,
+                              const std::vector<int64_t>& dims,
+                              const std::vector<int>& axis) {
+  int rank = dims.size();
+  std::vector<int64_t> in_stride(rank, 1);
+  for (int i = rank - 2; i >= 0; --i) {
+    in_stride[i] = in_stride[i + 1] * dims[i + 1];
+  }
+  // the output stride of every input dim
+  std::vector<int64_t> out_stride(rank, 1);
+  int64_t stride = 1;
+  for (int i = rank - 1; i >= 0; --i) {
+    out_stride[axis[i]] = stride;
+    stride *= dims[axis[i]];
+  }
+
+  if (axis[rank - 1] == rank - 1) {
+    // the innermost dim is kept, copy the rows in the output order
+    int64_t row = dims[rank - 1];
+    int64_t row_num = stride / row;
+    int64_t step =
+        std::max<int64_t>(1, kTransCopyBytes / (row * sizeof(T)));
+    int task_num = static_cast<int>((row_num + step - 1) / step);
+    LITE_PARALLEL_BEGIN(t, tid, task_num) {
+      int64_t begin = t * step;
+      int64_t end = std::min(begin + step, row_num);
+      std::vector<int64_t> index(rank - 1, 0);
+      int64_t in_offset = 0;
+      int64_t rest = begin;
+      for (int i = rank - 2; i >= 0; --i) {
+        index[i] = rest % dims[axis[i]];
+        rest /= dims[axis[i]];
+        in_offset += index[i] * in_stride[axis[i]];
+      }
+      for (int64_t r = begin; r < end; ++r) {
+        memcpy(dout + r * row, din + in_offset, row * sizeof(T));
+        for (int i = rank - 2; i >= 0; --i) {
+          in_offset += in_stride[axis[i]];
+          if (++index[i] < dims[axis[i]]) break;
+          in_offset -= in_stride[axis[i]] * dims[axis[i]];
+          index[i] = 0;
+        }
+      }
+    }
+    LITE_PARALLEL_END();
+    return;
+  }
+
+  // the innermost pair is the last input dim and the last output dim
+  int row_dim = axis[rank - 1];
+  int col_dim = rank - 1;
+  int64_t rows = dims[row_dim];
+  int64_t cols = dims[col_dim];
+  int64_t row_tiles = (rows + kTransTile - 1) / kTransTile;
+  int64_t col_tiles = (cols + kTransTile - 1) / kTransTile;
+  std::vector<int> outer;
+  for (int i = 0; i < rank; ++i) {
+    if (i != row_dim && i != col_dim) outer.push_back(i);
+  }
+  int64_t outer_num = 1;
+  for (int i : outer) outer_num *= dims[i];
+  int task_num = static_cast<int>(outer_num * row_tiles * col_tiles);
+  int64_t ld_in = in_stride[row_dim];
+  int64_t ld_out = out_stride[col_dim];
+  LITE_PARALLEL_BEGIN(t, tid, task_num) {
+    int64_t rest = t / (row_tiles * col_tiles);
+    int64_t tile = t % (row_tiles * col_tiles);
+    int64_t i = tile / col_tiles * kTransTile;
+    int64_t j = tile % col_tiles * kTransTile;
+    int64_t in_offset = i * ld_in + j;
+    int64_t out_offset = j * ld_out + i;
+    for (int k = static_cast<int>(outer.size()) - 1; k >= 0; --k) {
+      int64_t index = rest % dims[outer[k]];
+      rest /= dims[outer[k]];
+      in_offset += index * in_stride[outer[k]];
+      out_offset += index * out_stride[outer[k]];
+    }
+    transpose_tile(din + in_offset,
+                   ld_in,
+                   dout + out_offset,
+                   ld_out,
+                   static_cast<int>(std::min<int64_t>(kTransTile, rows - i)),
+                   static_cast<int>(std::min<int64_t>(kTransTile, cols - j)));
+  }
+  LITE_PARALLEL_END();
+}
+
+void transpose_nd(const void* din,
+                  void* dout,
+                  size_t elem_size,
+                  const std::vector<int64_t>& dims,
+                  const std::vector<int>& axis) {
+  CHECK_EQ(dims.size(), axis.size()) << "axis size is not match to dims";
+  std::vector<int64_t> new_dims;
+  std::vector<int> new_axis;
+  simplify_transpose(dims, axis, &new_dims, &new_axis);
+  if (new_dims.size() <= 1) {
+    int64_t num = 1;
+    for (auto d : dims) num *= d;
+    memcpy(dout, din, num * elem_size);
+    return;
+  }
+  switch (elem_size) {
+    case 1:
+      transpose_nd_impl(static_cast<const uint8_t*>(din),
+                        static_cast<uint8_t*>(dout),
+                        new_dims,
+                        new_axis);
+      break;
+    case 2:
+      transpose_nd_impl(static_cast<const uint16_t*>(din),
+                        static_cast<uint16_t*>(dout),
+                        new_dims,
+                        new_axis);
+      break;
+    case 4:
+      transpose_nd_impl(static_cast<const uint32_t*>(din),
+                        static_cast<uint32_t*>(dout),
+                        new_dims,
+                        new_axis);
+      break;
+    case 8:
+      transpose_nd_impl(static_cast<const uint64_t*>(din),
+                        static_cast<uint64_t*>(dout),
+                        new_dims,
+                        new_axis);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported element size of transpose: " << elem_size;
+  }
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
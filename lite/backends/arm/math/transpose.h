@@ -0,0 +1,55 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+/**
+ * Transposes `din` of `dims` into `dout` by the permutation `axis`, i.e. the
+ * dim i of dout is the dim axis[i] of din. The size 1 dims are dropped and
+ * the input dims staying adjacent are merged first, then the innermost pair
+ * is transposed by cache tiles with the neon register blocks, or the rows
+ * are copied if the innermost dim is kept. Runs on the thread pool.
+ * @param elem_size the element size in bytes, 1, 2, 4 or 8
+ */
+void transpose_nd(const void* din,
+                  void* dout,
+                  size_t elem_size,
+                  const std::vector<int64_t>& dims,
+                  const std::vector<int>& axis);
+
+template <typename T>
+inline void transpose_nd(const T* din,
+                         T* dout,
+                         const std::vector<int64_t>& dims,
+                         const std::vector<int>& axis) {
+  transpose_nd(static_cast<const void*>(din),
+               static_cast<void*>(dout),
+               sizeof(T),
+               dims,
+               axis);
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -15,6 +15,8 @@
 #include "lite/backends/arm/math/type_trans.h"
 #include <arm_neon.h>
 #include <string.h>
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include "lite/backends/arm/math/saturate.h"
 #include "lite/core/parallel_defines.h"
@@ -267,6 +269,66 @@ void fp32_to_int16(const float* din,
   LITE_PARALLEL_END()
 }
 
+void fp32_to_int8_asym(const float* din,
+                       int8_t* dout,
+                       float scale,
+                       int zero_point,
+                       int64_t size) {
+  const float inv_scale = 1.f / scale;
+  const int64_t cnt = size / 8;
+  LITE_PARALLEL_BEGIN(j, tid, cnt) {
+    float32x4_t vscale = vdupq_n_f32(inv_scale);
+    float32x4_t vzp = vdupq_n_f32(static_cast<float>(zero_point));
+    float32x4_t vmin = vdupq_n_f32(-127.f);
+    float32x4_t vmax = vdupq_n_f32(127.f);
+    const float* in = din + j * 8;
+    float32x4_t v0 = vmlaq_f32(vzp, vld1q_f32(in), vscale);
+    float32x4_t v1 = vmlaq_f32(vzp, vld1q_f32(in + 4), vscale);
+    v0 = vminq_f32(vmaxq_f32(v0, vmin), vmax);
+    v1 = vminq_f32(vmaxq_f32(v1, vmin), vmax);
+#ifdef __aarch64__
+    int32x4_t vi0 = vcvtaq_s32_f32(v0);
+    int32x4_t vi1 = vcvtaq_s32_f32(v1);
+#else
+    // round half away from zero by the offset of the sign
+    float32x4_t vpoff = vdupq_n_f32(0.5f);
+    float32x4_t vnoff = vdupq_n_f32(-0.5f);
+    int32x4_t vi0 = vcvtq_s32_f32(vaddq_f32(
+        v0, vbslq_f32(vcgeq_f32(v0, vdupq_n_f32(0.f)), vpoff, vnoff)));
+    int32x4_t vi1 = vcvtq_s32_f32(vaddq_f32(
+        v1, vbslq_f32(vcgeq_f32(v1, vdupq_n_f32(0.f)), vpoff, vnoff)));
+#endif
+    int16x8_t vi16 = vcombine_s16(vqmovn_s32(vi0), vqmovn_s32(vi1));
+    vst1_s8(dout + j * 8, vqmovn_s16(vi16));
+  }
+  LITE_PARALLEL_END()
+  for (int64_t i = cnt * 8; i < size; i++) {
+    float v = din[i] * inv_scale + zero_point;
+    v = std::min(std::max(v, -127.f), 127.f);
+    dout[i] = static_cast<int8_t>(std::round(v));
+  }
+}
+
+void fold_zero_point_bias(const int8_t* weight,
+                          const float* scale,
+                          const float* bias,
+                          float* bias_out,
+                          int zero_point,
+                          int channels,
+                          int inner,
+                          bool trans) {
+  std::vector<int> sums(channels, 0);
+  for (int c = 0; c < channels; c++) {
+    for (int i = 0; i < inner; i++) {
+      sums[c] += trans ? weight[i * channels + c] : weight[c * inner + i];
+    }
+  }
+  for (int c = 0; c < channels; c++) {
+    float b = bias ? bias[c] : 0.f;
+    bias_out[c] = b - zero_point * scale[c] * sums[c];
+  }
+}
+
 void int8_to_fp32(const int8_t* in,
                   float* out,
                   const float* scale,
@@ -104,6 +104,28 @@ void fp32_to_int8(const float* din,
                   int64_t outer_size,
                   int64_t inner_size);
 
+// dout = clamp(round(din / scale) + zero_point, -127, 127), for the
+// asymmetric int8 activations
+void fp32_to_int8_asym(const float* din,
+                       int8_t* dout,
+                       float scale,
+                       int zero_point,
+                       int64_t size);
+
+// Fold the zero point of the asymmetric int8 input of a gemm into the bias
+// of each output channel c:
+// bias_out[c] = bias[c] - zero_point * scale[c] * sum(the weights of c),
+// where the weights of c are weight[c * inner + i] if !trans, or
+// weight[i * channels + c] if trans, for i in [0, inner). bias may be null.
+void fold_zero_point_bias(const int8_t* weight,
+                          const float* scale,
+                          const float* bias,
+                          float* bias_out,
+                          int zero_point,
+                          int channels,
+                          int inner,
+                          bool trans);
+
 void int8_to_fp32(const int8_t* in,
                   float* out,
                   const float* scale,
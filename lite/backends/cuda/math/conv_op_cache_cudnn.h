@@ -15,8 +15,16 @@ limitations under the License. */
 #pragma once
 
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
 #include <map>
+#include <mutex>  // NOLINT
+#include <sstream>
+#include <string>
+#include <thread>  // NOLINT
 #include <vector>
+#include "lite/utils/log/cp_logging.h"
 
 namespace paddle {
 namespace lite {
@@ -127,6 +135,101 @@ TAlgorithm AlgorithmsCache<TAlgorithm>::GetAlgorithm(
   return algo;
 }
 
+// The conv algorithms found by the exhaustive search, and their workspace
+// sizes, shared by all the kernels of the process. They are keyed by the
+// shapes, the data type, the GPU arch and the cudnn version, and persisted in
+// the file set by CxxConfig::set_cudnn_algo_cache_file, so the later
+// processes skip the search for the same convs. Thread-safe.
+class ConvAlgorithmFileCache {
+ public:
+  struct Entry {
+    int algo{0};
+    size_t workspace_size{0};
+  };
+
+  static ConvAlgorithmFileCache& Global() {
+    static ConvAlgorithmFileCache x;
+    return x;
+  }
+
+  // Merge the entries saved in `path`, the ones already found are kept.
+  // Loading the same file again does nothing.
+  void Load(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (path.empty() || path == path_) return;
+    path_ = path;
+    size_t count = Merge(path);
+    VLOG(3) << "Loaded " << count << " cudnn conv algorithms from " << path;
+  }
+
+  bool Find(const std::string& key, Entry* entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return false;
+    *entry = it->second;
+    return true;
+  }
+
+  // Insert the entry and save all of them into the loaded file, merged with
+  // the ones saved by the other processes since loaded.
+  void Insert(const std::string& key, const Entry& entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[key] = entry;
+    if (path_.empty()) return;
+    Merge(path_);
+    // Written into a temporary file first, so the processes loading the file
+    // at the same time never see a partial one.
+    std::stringstream tmp_path;
+    tmp_path << path_ << ".tmp"
+             << std::hash<std::thread::id>()(std::this_thread::get_id());
+    {
+      std::ofstream file(tmp_path.str());
+      for (auto& item : entries_) {
+        file << item.first << " : " << item.second.algo << " "
+             << item.second.workspace_size << "\n";
+      }
+      if (!file.good()) {
+        LOG(WARNING) << "Failed to save the cudnn conv algorithms into "
+                     << path_;
+        file.close();
+        std::remove(tmp_path.str().c_str());
+        return;
+      }
+    }
+    if (std::rename(tmp_path.str().c_str(), path_.c_str()) != 0) {
+      LOG(WARNING) << "Failed to save the cudnn conv algorithms into " << path_;
+      std::remove(tmp_path.str().c_str());
+    }
+  }
+
+ private:
+  ConvAlgorithmFileCache() = default;
+
+  // Insert the entries in `path` missing in entries_, one entry per line in
+  // the format "key : algo workspace_size". Returns the number of the
+  // entries read.
+  size_t Merge(const std::string& path) {
+    std::ifstream file(path);
+    size_t count = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+      auto pos = line.rfind(" : ");
+      if (pos == std::string::npos) continue;
+      Entry entry;
+      std::stringstream entry_ss(line.substr(pos + 3));
+      if (!(entry_ss >> entry.algo >> entry.workspace_size)) continue;
+      entries_.insert({line.substr(0, pos), entry});
+      count++;
+    }
+    return count;
+  }
+
+  std::mutex mutex_;
+  std::map<std::string, Entry> entries_;
+  // The file the entries are loaded from and saved into.
+  std::string path_;
+};
+
 }  // namespace math
 }  // namespace cuda
 }  // namespace lite
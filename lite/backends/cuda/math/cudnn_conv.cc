@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/backends/cuda/math/cudnn_conv.h"
+#include <sstream>
 #include "lite/backends/cuda/math/activation.h"
 #include "lite/backends/cuda/math/conv_op_cache_cudnn.h"
 #include "lite/backends/cuda/math/cudnn_helper.h"
@@ -97,9 +98,12 @@ bool CudnnConv2D<T, Ptype_out>::create(const operators::ConvParam& param,
   CUDNN_CHECK(cudnnSetConvolutionMathType(this->conv_desc_, math_type));
 #endif
 
+  // The workspace size of the searched algorithm is known.
+  bool searched = false;
   if (ic == param.groups && ic == oc && ic != 1) {
     this->fwd_algo_ = CUDNN_CONVOLUTION_FWD_ALGO_IMPLICIT_GEMM;
   } else if (!param.var_length) {
+    searched = true;
     const auto* i_data = param.x->data<T>();
     const auto* w_data = param.filter->data<T>();
     auto* o_data = param.output->mutable_data<T>(TARGET(kCUDA));
@@ -138,17 +142,32 @@ bool CudnnConv2D<T, Ptype_out>::create(const operators::ConvParam& param,
         VLOG(2) << stat.algo << ": " << stat.status << " " << stat.time << " "
                 << stat.memory;
       }
-      return fwd_perf_stat[0].algo;
+      return fwd_perf_stat[0];
     };
-    AlgorithmsCache<cudnnConvolutionFwdAlgo_t> algo_cache;
-    this->fwd_algo_ = algo_cache.GetAlgorithm(x_dims.Vectorize(),
-                                              w_dims.Vectorize(),
-                                              param.strides,
-                                              *param.paddings,
-                                              *param.dilations,
-                                              0,
-                                              search_func);
-
+    // The algorithms found on the other archs or by the other cudnn versions
+    // may be invalid or slow here.
+    std::stringstream key;
+    key << "sm" << TargetWrapperCuda::GetComputeCapability() << " cudnn"
+        << CUDNN_VERSION << " type" << cudnn::cudnnTypeWrapper<T>::type
+        << " tc" << this->use_tensor_core_ << " x";
+    for (auto dim : x_dims.Vectorize()) key << " " << dim;
+    key << " w";
+    for (auto dim : w_dims.Vectorize()) key << " " << dim;
+    key << " s " << sh << " " << sw << " p";
+    for (auto pad : paddings) key << " " << pad;
+    key << " d " << dh << " " << dw << " g " << param.groups;
+    ConvAlgorithmFileCache::Entry entry;
+    if (ConvAlgorithmFileCache::Global().Find(key.str(), &entry)) {
+      this->fwd_algo_ = static_cast<cudnnConvolutionFwdAlgo_t>(entry.algo);
+      this->workspace_fwd_sizes_ = entry.workspace_size;
+    } else {
+      auto perf = search_func();
+      this->fwd_algo_ = perf.algo;
+      this->workspace_fwd_sizes_ = perf.memory;
+      entry.algo = static_cast<int>(perf.algo);
+      entry.workspace_size = perf.memory;
+      ConvAlgorithmFileCache::Global().Insert(key.str(), entry);
+    }
   } else {
     int requestedAlgoCount = 1;
     int returnedAlgoCount;
@@ -162,14 +181,16 @@ bool CudnnConv2D<T, Ptype_out>::create(const operators::ConvParam& param,
                                                        &this->algo_perf_));
     this->fwd_algo_ = this->algo_perf_.algo;
   }
-  CUDNN_CHECK(
-      cudnnGetConvolutionForwardWorkspaceSize(this->handle_,
-                                              this->input_desc_,
-                                              this->filter_desc_,
-                                              this->conv_desc_,
-                                              this->output_desc_,
-                                              this->fwd_algo_,
-                                              &this->workspace_fwd_sizes_));
+  if (!searched) {
+    CUDNN_CHECK(
+        cudnnGetConvolutionForwardWorkspaceSize(this->handle_,
+                                                this->input_desc_,
+                                                this->filter_desc_,
+                                                this->conv_desc_,
+                                                this->output_desc_,
+                                                this->fwd_algo_,
+                                                &this->workspace_fwd_sizes_));
+  }
   if (this->workspace_fwd_sizes_ > this->workspace_size_inbytes_) {
     this->workspace_size_inbytes_ = this->workspace_fwd_sizes_;
     this->ResetWorkSpace();
@@ -131,15 +131,96 @@ template <>
 class cublasTypeWrapper<float> {
  public:
   static const cudaDataType_t type = CUDA_R_32F;
+#if CUBLAS_VER_MAJOR >= 11
+  static const cublasComputeType_t compute_type = CUBLAS_COMPUTE_32F;
+#endif
 };
 
 template <>
 class cublasTypeWrapper<half> {
  public:
   static const cudaDataType_t type = CUDA_R_16F;
+#if CUBLAS_VER_MAJOR >= 11
+  static const cublasComputeType_t compute_type = CUBLAS_COMPUTE_16F;
+#endif
 };
 
-#if (CUBLAS_VER_MAJOR * 10 + CUBLAS_VER_MINOR) == 101
+#if (CUBLAS_VER_MAJOR * 10 + CUBLAS_VER_MINOR) >= 101
+
+#if CUBLAS_VER_MAJOR >= 11
+static bool GetEpilogue(bool has_bias,
+                        const std::string& act_type,
+                        cublasLtEpilogue_t* epilogue) {
+  if (act_type.empty()) {
+    *epilogue = has_bias ? CUBLASLT_EPILOGUE_BIAS : CUBLASLT_EPILOGUE_DEFAULT;
+  } else if (act_type == "relu") {
+    *epilogue = has_bias ? CUBLASLT_EPILOGUE_RELU_BIAS : CUBLASLT_EPILOGUE_RELU;
+#if CUDA_VERSION >= 11030
+  } else if (act_type == "gelu") {
+    *epilogue = has_bias ? CUBLASLT_EPILOGUE_GELU_BIAS : CUBLASLT_EPILOGUE_GELU;
+#endif
+  } else {
+    return false;
+  }
+  return true;
+}
+#endif
+
+template <typename PTypeIn, typename PTypeOut>
+LtGemm<PTypeIn, PTypeOut>::~LtGemm() {
+  ClearAlgos();
+  if (matmul_desc_) {
+    CUBLAS_CALL(cublasLtMatmulDescDestroy(matmul_desc_));
+  }
+  if (preference_) {
+    CUBLAS_CALL(cublasLtMatmulPreferenceDestroy(preference_));
+  }
+  if (handle_) {
+    CUBLAS_CALL(cublasLtDestroy(handle_));
+  }
+  if (workspace_) {
+    CUDA_CALL(cudaFree(workspace_));
+  }
+}
+
+template <typename PTypeIn, typename PTypeOut>
+void LtGemm<PTypeIn, PTypeOut>::ClearAlgos() {
+  for (auto& it : algos_) {
+    CUBLAS_CALL(cublasLtMatrixLayoutDestroy(it.second.a_desc));
+    CUBLAS_CALL(cublasLtMatrixLayoutDestroy(it.second.b_desc));
+    CUBLAS_CALL(cublasLtMatrixLayoutDestroy(it.second.c_desc));
+  }
+  algos_.clear();
+  algo_ = nullptr;
+}
+
+template <typename PTypeIn, typename PTypeOut>
+bool LtGemm<PTypeIn, PTypeOut>::support_epilogue(bool has_bias,
+                                                 const std::string& act_type) {
+#if CUBLAS_VER_MAJOR >= 11
+  cublasLtEpilogue_t epilogue;
+  return GetEpilogue(has_bias, act_type, &epilogue);
+#else
+  return !has_bias && act_type.empty();
+#endif
+}
+
+template <typename PTypeIn, typename PTypeOut>
+void LtGemm<PTypeIn, PTypeOut>::set_epilogue(bool has_bias,
+                                             const std::string& act_type) {
+  CHECK(support_epilogue(has_bias, act_type))
+      << "cuBLASLt doesn't fuse the activation: " << act_type;
+  if (has_bias != has_bias_ || act_type != act_type_) {
+    has_bias_ = has_bias;
+    act_type_ = act_type;
+    // the matmul desc and the algorithms are created again
+    if (matmul_desc_) {
+      CUBLAS_CALL(cublasLtMatmulDescDestroy(matmul_desc_));
+      matmul_desc_ = nullptr;
+    }
+    ClearAlgos();
+  }
+}
 
 template <typename PTypeIn, typename PTypeOut>
 bool LtGemm<PTypeIn, PTypeOut>::init(const bool trans_a,
@@ -168,77 +249,89 @@ bool LtGemm<PTypeIn, PTypeOut>::init(const bool trans_a,
   if (handle_ == nullptr) {
     this->exe_stream_ = ctx->exec_stream();
     CUBLAS_CALL(cublasLtCreate(&handle_));
+    CUDA_CALL(cudaMalloc(&this->workspace_, workspace_size_));
+    // here we just assume A,B,C are always well aligned (e.g. directly come
+    // from cudaMalloc)
+    CUBLAS_CALL(cublasLtMatmulPreferenceCreate(&preference_));
+    CUBLAS_CALL(cublasLtMatmulPreferenceSetAttribute(
+        preference_,
+        CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
+        &workspace_size_,
+        sizeof(workspace_size_)));
+  }
+  if (matmul_desc_ && (trans_a != trans_a_ || trans_b != trans_b_)) {
+    CUBLAS_CALL(cublasLtMatmulDescDestroy(matmul_desc_));
+    matmul_desc_ = nullptr;
+    ClearAlgos();
+  }
+  if (matmul_desc_ == nullptr) {
+    trans_a_ = trans_a;
+    trans_b_ = trans_b;
+    // the row major C = A * B is computed as the col major C' = B' * A'
+    cublasOperation_t cu_trans_a = trans_a ? CUBLAS_OP_T : CUBLAS_OP_N;
+    cublasOperation_t cu_trans_b = trans_b ? CUBLAS_OP_T : CUBLAS_OP_N;
+#if CUBLAS_VER_MAJOR >= 11
+    CUBLAS_CALL(
+        cublasLtMatmulDescCreate(&matmul_desc_,
+                                 cublasTypeWrapper<PTypeOut>::compute_type,
+                                 cublasTypeWrapper<PTypeOut>::type));
+    cublasLtEpilogue_t epilogue;
+    CHECK(GetEpilogue(has_bias_, act_type_, &epilogue));
+    CUBLAS_CALL(cublasLtMatmulDescSetAttribute(matmul_desc_,
+                                               CUBLASLT_MATMUL_DESC_EPILOGUE,
+                                               &epilogue,
+                                               sizeof(epilogue)));
+#else
+    CUBLAS_CALL(cublasLtMatmulDescCreate(&matmul_desc_,
+                                         cublasTypeWrapper<PTypeOut>::type));
+#endif
+    CUBLAS_CALL(cublasLtMatmulDescSetAttribute(matmul_desc_,
+                                               CUBLASLT_MATMUL_DESC_TRANSA,
+                                               &cu_trans_b,
+                                               sizeof(cu_trans_b)));
+    CUBLAS_CALL(cublasLtMatmulDescSetAttribute(matmul_desc_,
+                                               CUBLASLT_MATMUL_DESC_TRANSB,
+                                               &cu_trans_a,
+                                               sizeof(cu_trans_a)));
   }
-  m_ = m;
-  n_ = n;
-  k_ = k;
-  lda_ = lda;
-  ldb_ = ldb;
-  ldc_ = ldc;
-  cu_trans_a_ = trans_a ? CUBLAS_OP_T : CUBLAS_OP_N;
-  cu_trans_b_ = trans_b ? CUBLAS_OP_T : CUBLAS_OP_N;
-
-  // create operation desciriptor; see cublasLtMatmulDescAttributes_t for
-  // details about defaults; here we just need to set the transforms for A and B
-  CUBLAS_CALL(cublasLtMatmulDescCreate(&matmul_desc_,
-                                       cublasTypeWrapper<PTypeOut>::type));
-  CUBLAS_CALL(cublasLtMatmulDescSetAttribute(matmul_desc_,
-                                             CUBLASLT_MATMUL_DESC_TRANSA,
-                                             &cu_trans_b_,
-                                             sizeof(cu_trans_b_)));
-  CUBLAS_CALL(cublasLtMatmulDescSetAttribute(matmul_desc_,
-                                             CUBLASLT_MATMUL_DESC_TRANSA,
-                                             &cu_trans_a_,
-                                             sizeof(cu_trans_a_)));
 
-  // create matrix descriptors, we are good with the details here so no need to
-  // set any extra attributes
-  CUBLAS_CALL(cublasLtMatrixLayoutCreate(&a_desc_,
-                                         cublasTypeWrapper<PTypeOut>::type,
+  std::vector<int> shape{m, n, k, lda, ldb, ldc};
+  auto it = algos_.find(shape);
+  if (it != algos_.end()) {
+    algo_ = &it->second;
+    return true;
+  }
+  Algo algo;
+  CUBLAS_CALL(cublasLtMatrixLayoutCreate(&algo.a_desc,
+                                         cublasTypeWrapper<PTypeIn>::type,
                                          trans_a == false ? k : m,
                                          trans_a == false ? m : k,
                                          lda));
-  CUBLAS_CALL(cublasLtMatrixLayoutCreate(&b_desc_,
-                                         cublasTypeWrapper<PTypeOut>::type,
+  CUBLAS_CALL(cublasLtMatrixLayoutCreate(&algo.b_desc,
+                                         cublasTypeWrapper<PTypeIn>::type,
                                          trans_b == false ? n : k,
                                          trans_b == false ? k : n,
                                          ldb));
   CUBLAS_CALL(cublasLtMatrixLayoutCreate(
-      &c_desc_, cublasTypeWrapper<PTypeOut>::type, n, m, ldc));
-
-  // create preference handle; here we could use extra attributes to disable
-  // tensor ops or to make sure algo selected will work with badly aligned A, B,
-  // C; here for simplicity we just assume A,B,C are always well aligned (e.g.
-  // directly come from cudaMalloc)
-  CUBLAS_CALL(cublasLtMatmulPreferenceCreate(&preference_));
+      &algo.c_desc, cublasTypeWrapper<PTypeOut>::type, n, m, ldc));
 
-  if (!workspace_) {
-    CUDA_CALL(cudaMalloc(&this->workspace_, workspace_size_));
-  }
-  CUBLAS_CALL(cublasLtMatmulPreferenceSetAttribute(
-      preference_,
-      CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
-      &workspace_size_,
-      sizeof(workspace_size_)));
-
-  // we just need the best available heuristic to try and run matmul. There is
-  // no guarantee this will work, e.g. if A is badly aligned, you can request
-  // more (e.g. 32) algos and try to run them one by one until something works
+  // we just need the best available heuristic to try and run matmul
+  int returned_results = 0;
   CUBLAS_CALL(cublasLtMatmulAlgoGetHeuristic(handle_,
                                              matmul_desc_,
-                                             b_desc_,
-                                             a_desc_,
-                                             c_desc_,
-                                             c_desc_,
+                                             algo.b_desc,
+                                             algo.a_desc,
+                                             algo.c_desc,
+                                             algo.c_desc,
                                              preference_,
                                              1,
-                                             &heuristic_result_,
-                                             &returned_results_));
-  if (returned_results_ == 0) {
+                                             &algo.heuristic_result,
+                                             &returned_results));
+  if (returned_results == 0) {
     LOG(FATAL) << "cuBLAS API failed with status "
                << CUBLAS_STATUS_NOT_SUPPORTED;
   }
-
+  algo_ = &(algos_[shape] = algo);
   return true;
 }
 
@@ -248,20 +341,32 @@ bool LtGemm<PTypeIn, PTypeOut>::run(const PTypeOut alpha,
                                     const PTypeIn *a,
                                     const PTypeIn *b,
                                     PTypeOut *c,
-                                    Context<TARGET(kCUDA)> *ctx) {
+                                    Context<TARGET(kCUDA)> *ctx,
+                                    const PTypeOut *bias) {
+  CHECK(algo_) << "LtGemm should be inited first";
+#if CUBLAS_VER_MAJOR >= 11
+  if (has_bias_) {
+    CHECK(bias) << "the bias of the epilogue is missing";
+    CUBLAS_CALL(
+        cublasLtMatmulDescSetAttribute(matmul_desc_,
+                                       CUBLASLT_MATMUL_DESC_BIAS_POINTER,
+                                       &bias,
+                                       sizeof(bias)));
+  }
+#endif
   CUBLAS_CALL(cublasLtMatmul(handle_,
                              matmul_desc_,
                              &alpha,
                              b,
-                             b_desc_,
+                             algo_->b_desc,
                              a,
-                             a_desc_,
+                             algo_->a_desc,
                              &beta,
                              c,
-                             c_desc_,
+                             algo_->c_desc,
                              c,
-                             c_desc_,
-                             &heuristic_result_.algo,
+                             algo_->c_desc,
+                             &algo_->heuristic_result.algo,
                              workspace_,
                              workspace_size_,
                              this->exe_stream_));
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <map>
 #include <string>
 #include <vector>
 #include "lite/api/paddle_place.h"
@@ -69,28 +70,22 @@ class Gemm {
   int ldc_{-1};
 };
 
-#if (CUBLAS_VER_MAJOR * 10 + CUBLAS_VER_MINOR) == 101
+#if (CUBLAS_VER_MAJOR * 10 + CUBLAS_VER_MINOR) >= 101
 
+// The gemm with cuBLASLt. On cuBLAS 11 the bias and the activation run in
+// the epilogue of the matmul, and the algorithm is picked once per shape.
 template <typename PtypeIn, typename PtypeOut>
 class LtGemm {
  public:
-  LtGemm()
-      : handle_(nullptr),
-        matmul_desc_(nullptr),
-        a_desc_(nullptr),
-        b_desc_(nullptr),
-        c_desc_(nullptr),
-        preference_(nullptr),
-        returned_results_(0),
-        workspace_size_(4 * 1024 * 1024),
-        workspace_{nullptr} {}
-
-  ~LtGemm() {
-    if (this->workspace_) {
-      CUDA_CALL(cudaFree(this->workspace_));
-    }
-    this->workspace_ = nullptr;
-  }
+  LtGemm() = default;
+  ~LtGemm();
+
+  // Whether the bias and the activation can be fused, the activation is
+  // "", "relu" or "gelu" as the act_type of fc.
+  static bool support_epilogue(bool has_bias, const std::string& act_type);
+  // Sets the epilogue of the following runs, before init.
+  void set_epilogue(bool has_bias, const std::string& act_type);
+
   bool init(const bool trans_a,
             const bool trans_b,
             const int m,
@@ -107,38 +102,42 @@ class LtGemm {
             const int ldc,
             Context<TARGET(kCUDA)>* ctx);
 
+  // The bias of n is needed if the epilogue has the bias.
   bool run(const PtypeOut alpha,
            const PtypeOut beta,
            const PtypeIn* a,
            const PtypeIn* b,
            PtypeOut* c,
-           Context<TARGET(kCUDA)>* ctx);
+           Context<TARGET(kCUDA)>* ctx,
+           const PtypeOut* bias = nullptr);
 
   cublasLtHandle_t get_handle() const { return handle_; }
 
  private:
+  struct Algo {
+    cublasLtMatrixLayout_t a_desc{nullptr};
+    cublasLtMatrixLayout_t b_desc{nullptr};
+    cublasLtMatrixLayout_t c_desc{nullptr};
+    cublasLtMatmulHeuristicResult_t heuristic_result{};
+  };
+  void ClearAlgos();
+
   cudaStream_t exe_stream_;
 
-  cublasLtHandle_t handle_;
-  cublasLtMatmulDesc_t matmul_desc_;
-  cublasLtMatrixLayout_t a_desc_;
-  cublasLtMatrixLayout_t b_desc_;
-  cublasLtMatrixLayout_t c_desc_;
-  cublasLtMatmulPreference_t preference_;
-  int returned_results_;
-  cublasLtMatmulHeuristicResult_t heuristic_result_{};
+  cublasLtHandle_t handle_{nullptr};
+  cublasLtMatmulDesc_t matmul_desc_{nullptr};
+  cublasLtMatmulPreference_t preference_{nullptr};
+  // the algorithm of each {m, n, k, lda, ldb, ldc}
+  std::map<std::vector<int>, Algo> algos_;
+  Algo* algo_{nullptr};
 
-  cublasOperation_t cu_trans_a_;
-  cublasOperation_t cu_trans_b_;
-  int m_{-1};
-  int n_{-1};
-  int k_{-1};
-  int lda_{-1};
-  int ldb_{-1};
-  int ldc_{-1};
+  bool has_bias_{false};
+  std::string act_type_;
+  bool trans_a_{false};
+  bool trans_b_{false};
 
-  size_t workspace_size_;
-  void* workspace_;
+  size_t workspace_size_{4 * 1024 * 1024};
+  void* workspace_{nullptr};
 };
 #endif
 
@@ -32,6 +32,14 @@ void* TargetWrapperCuda::Malloc(size_t size) {
 
 void TargetWrapperCuda::Free(void* ptr) { CUDA_CALL(cudaFree(ptr)); }
 
+void* TargetWrapperCuda::MallocHost(size_t size) {
+  void* ptr{};
+  CUDA_CALL(cudaMallocHost(&ptr, size));
+  return ptr;
+}
+
+void TargetWrapperCuda::FreeHost(void* ptr) { CUDA_CALL(cudaFreeHost(ptr)); }
+
 void TargetWrapperCuda::MemcpySync(void* dst,
                                    const void* src,
                                    size_t size,
@@ -61,7 +61,9 @@ class TargetWrapper<TARGET(kCUDA)> {
   static void RecordEvent(const event_t& event, const stream_t& stream) {
     cudaEventRecord(event, stream);
   }
-  static void SyncEvent(const event_t& event) {}
+  static void SyncEvent(const event_t& event) {
+    cudaEventSynchronize(event);
+  }
 
   static void StreamSync(const stream_t& stream) {
     cudaStreamSynchronize(stream);
@@ -74,6 +76,10 @@ class TargetWrapper<TARGET(kCUDA)> {
   static void* Malloc(size_t size);
   static void Free(void* ptr);
 
+  // The page-locked host memory, copied by the dma without staging.
+  static void* MallocHost(size_t size);
+  static void FreeHost(void* ptr);
+
   static void MemcpySync(void* dst,
                          const void* src,
                          size_t size,
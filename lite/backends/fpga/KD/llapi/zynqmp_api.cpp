@@ -23,6 +23,7 @@ limitations under the License. */
 
 #include <algorithm>
 #include <bitset>
+#include <chrono>  // NOLINT
 #include <cstring>
 #include <map>
 #include <mutex>  // NOLINT
@@ -40,7 +41,10 @@ static std::map<void *, size_t> memory_map;
 static size_t memory_size_max = 0;
 static size_t memory_size = 0;
 
-static inline int do_ioctl(uint64_t req, const void *arg) {
+static bool time_stats_enabled = false;
+static thread_local FpgaTimeStats time_stats;
+
+static inline int do_ioctl_raw(uint64_t req, const void *arg) {
 #ifdef PADDLE_OS_LINUX
   return ioctl(fd, req, arg);
 #else
@@ -48,6 +52,35 @@ static inline int do_ioctl(uint64_t req, const void *arg) {
 #endif
 }
 
+static inline int do_ioctl(uint64_t req, const void *arg) {
+  if (!time_stats_enabled) {
+    return do_ioctl_raw(req, arg);
+  }
+  auto start = std::chrono::steady_clock::now();
+  int ret = do_ioctl_raw(req, arg);
+  uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+  if (req == IOCTL_MEMCACHE_FLUSH || req == IOCTL_MEMCACHE_INVAL) {
+    time_stats.transfer_us += us;
+    time_stats.transfer_bytes +=
+        static_cast<const MemoryCacheArgs *>(arg)->size;
+  } else {
+    time_stats.compute_us += us;
+  }
+  return ret;
+}
+
+void fpga_enable_time_stats(bool enable) { time_stats_enabled = enable; }
+
+bool fpga_time_stats_enabled() { return time_stats_enabled; }
+
+FpgaTimeStats fpga_take_time_stats() {
+  FpgaTimeStats stats = time_stats;
+  time_stats = FpgaTimeStats();
+  return stats;
+}
+
 static std::mutex mem_mutex;
 
 int open_device() {
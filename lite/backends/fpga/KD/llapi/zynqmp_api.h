@@ -341,6 +341,18 @@ inline int align_to_x_floor(int num, int x) { return (num / x) * x; }
 void set_pool_cap(uint32_t pool_cap);
 uint32_t get_pool_cap();
 
+// The time spent in the cache maintenance (the transfers between the CPU and
+// the FPGA) and in the FPGA compute ioctls since the last take.
+struct FpgaTimeStats {
+  uint64_t transfer_us = 0;
+  uint64_t compute_us = 0;
+  size_t transfer_bytes = 0;
+};
+
+void fpga_enable_time_stats(bool enable);
+bool fpga_time_stats_enabled();
+FpgaTimeStats fpga_take_time_stats();
+
 int open_device();
 void close_device();
 void reset_device();
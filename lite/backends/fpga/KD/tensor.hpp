@@ -292,12 +292,23 @@ class Tensor {
     }
   }
 
-  void flush() { fpga_flush(placeHolder_->data(), placeHolder_->memorySize()); }
-
-  void invalidate() {
-    fpga_invalidate(placeHolder_->data(), placeHolder_->memorySize());
+  // The placeholder is only grown, so the cache maintenance is limited to
+  // the bytes the current shape spans instead of the whole placeholder.
+  size_t syncSize() {
+    size_t capacity = placeHolder_->memorySize();
+    if (shape_ == nullptr) {
+      return capacity;
+    }
+    size_t size = (offset_ + shape_->alignedElementCount()) *
+                      CellSize(dataType_) * mem_factor_ +
+                  16;
+    return std::min(size, capacity);
   }
 
+  void flush() { fpga_flush(placeHolder_->data(), syncSize()); }
+
+  void invalidate() { fpga_invalidate(placeHolder_->data(), syncSize()); }
+
   void sync() {
     switch (synchedStatus_) {
       case CPU:
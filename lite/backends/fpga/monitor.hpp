@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <chrono>  // NOLINT
 #include <cstddef>
 #include <fstream>
 #include <iostream>
@@ -21,8 +22,10 @@
 #include <unordered_map>
 #include <vector>
 
+#include "lite/backends/fpga/KD/llapi/zynqmp_api.h"
 #include "lite/core/program.h"
 #include "lite/core/tensor.h"
+#include "lite/utils/env.h"
 
 namespace paddle {
 namespace lite {
@@ -34,9 +37,17 @@ class Monitor {
     return s_instance;
   }
 
-  void inferStart() {}
+  void inferStart() {
+    if (!profile_) return;
+    total_ = zynqmp::FpgaTimeStats();
+    total_us_ = 0;
+  }
 
   void preRun(Instruction& inst) {  // NOLINT
+    if (profile_) {
+      zynqmp::fpga_take_time_stats();
+      op_start_ = std::chrono::steady_clock::now();
+    }
     auto op = const_cast<OpLite*>(inst.op());
     auto op_info = op->op_info();
     auto op_type = op->Type();
@@ -63,6 +74,9 @@ class Monitor {
   }
 
   void postRun(Instruction& inst) {  // NOLINT
+    if (profile_) {
+      ProfileOp(inst);
+    }
     auto op = const_cast<OpLite*>(inst.op());
     auto op_info = op->op_info();
     auto in_names = op_info->input_names();
@@ -100,9 +114,41 @@ class Monitor {
     }
   }
 
-  void inferEnd() {}
+  void inferEnd() {
+    if (!profile_) return;
+    LOG(INFO) << "[FPGA profile] total transfer: " << total_.transfer_us
+              << " us (" << total_.transfer_bytes
+              << " bytes), compute: " << total_.compute_us
+              << " us, ops: " << total_us_ << " us";
+  }
 
  private:
+  // Set PADDLE_LITE_FPGA_PROFILE=1 to log the cache maintenance (transfer)
+  // and the FPGA compute time of each op.
+  Monitor() : profile_(GetBoolFromEnv("PADDLE_LITE_FPGA_PROFILE")) {
+    zynqmp::fpga_enable_time_stats(profile_);
+  }
+
+  void ProfileOp(Instruction& inst) {  // NOLINT
+    auto stats = zynqmp::fpga_take_time_stats();
+    uint64_t op_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::steady_clock::now() - op_start_)
+                         .count();
+    total_.transfer_us += stats.transfer_us;
+    total_.transfer_bytes += stats.transfer_bytes;
+    total_.compute_us += stats.compute_us;
+    total_us_ += op_us;
+    LOG(INFO) << "[FPGA profile] " << inst.op()->Type() << " on "
+              << inst.kernel()->name() << " transfer: " << stats.transfer_us
+              << " us (" << stats.transfer_bytes
+              << " bytes), compute: " << stats.compute_us
+              << " us, total: " << op_us << " us";
+  }
+
+  bool profile_{false};
+  std::chrono::steady_clock::time_point op_start_;
+  zynqmp::FpgaTimeStats total_;
+  uint64_t total_us_{0};
 };
 
 }  // namespace lite
@@ -0,0 +1,63 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <vector>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// The mask of the attention scores [..., seq_q, seq_k] broadcast as the
+// elementwise_add of axis -1. Returns the offsets of the mask of each head
+// flattened from the leading dims, and the strides of the rows and columns,
+// which are 0 if the mask is broadcast along them.
+inline void AttentionMaskStrides(const DDim& mask_dims,
+                                 const DDim& q_dims,
+                                 std::vector<int64_t>* offsets,
+                                 int* row_stride,
+                                 int* col_stride) {
+  int rank = static_cast<int>(q_dims.size());
+  int mask_rank = static_cast<int>(mask_dims.size());
+  std::vector<int64_t> dims(rank, 1);
+  for (int i = 0; i < mask_rank; i++) {
+    dims[rank - mask_rank + i] = mask_dims[i];
+  }
+  std::vector<int64_t> strides(rank, 0);
+  int64_t stride = 1;
+  for (int i = rank - 1; i >= 0; i--) {
+    strides[i] = dims[i] == 1 ? 0 : stride;
+    stride *= dims[i];
+  }
+  *row_stride = static_cast<int>(strides[rank - 2]);
+  *col_stride = static_cast<int>(strides[rank - 1]);
+  int64_t batch = q_dims.count(0, rank - 2);
+  offsets->resize(batch);
+  for (int64_t b = 0; b < batch; b++) {
+    int64_t offset = 0;
+    int64_t idx = b;
+    for (int i = rank - 3; i >= 0; i--) {
+      offset += (idx % q_dims[i]) * strides[i];
+      idx /= q_dims[i];
+    }
+    (*offsets)[b] = offset;
+  }
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
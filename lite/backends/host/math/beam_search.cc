@@ -13,128 +13,92 @@
 // limitations under the License.
 
 #include "lite/backends/host/math/beam_search.h"
+#ifdef LITE_WITH_ARM
+#include <arm_neon.h>
+#endif
+#include <algorithm>
 #include <cmath>
-#include <string>
 #include <vector>
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
 namespace host {
 namespace math {
-/*
-* The basic items help to sort.
-*/
-struct Item {
-  Item() {}
-  Item(size_t offset, size_t id, float score)
-      : offset(offset), id(id), score(score) {}
-  // offset in the higher lod level.
-  size_t offset;
-  // prefix id in the lower lod level.
-  // size_t prefix;
-  // the candidate id
-  size_t id;
-  // the corresponding score
-  float score;
 
-  inline bool operator<(const Item &in) const {
-    return (score < in.score) || ((score == in.score) && (offset < in.offset));
-  }
+using Item = BeamSearchItem;
 
-  inline void operator=(const Item &in) {
-    offset = in.offset;
-    id = in.id;
-    score = in.score;
-  }
+// the candidates compared with the worst of a full beam at once
+static constexpr int kBlockSize = 16;
 
-  std::string ToString() {
-    std::ostringstream os;
-    os << "{";
-    os << "offset: " << offset << ", ";
-    os << "id: " << id << ", ";
-    os << "score: " << score << "";
-    os << "}";
-    return os.str();
+static void ToAbsOffset(const LoD& in, LoD* result) {
+  result->resize(in.size());
+  for (size_t level = 0; level < in.size(); level++) {
+    (*result)[level].assign(in[level].begin(), in[level].end());
   }
-};
-LoD ToAbsOffset(const LoD &in) {
-  if (in.empty() || in.size() == 1) return in;
-  LoD result = in;
+  if (in.size() <= 1) return;
   for (auto level = static_cast<int>(in.size() - 2); level >= 0; level--) {
     for (size_t i = 0; i < in[level].size(); ++i) {
       size_t index = in[level][i];
-      result[level][i] = result[level + 1][index];
+      (*result)[level][i] = (*result)[level + 1][index];
     }
   }
-  return result;
 }
 
-/*
- * Prune the source sentences all branchs finished, and it is optional.
- * Pruning must one step later than finishing (thus pre_ids is needed here),
- * since the end tokens must be writed out.
- */
-void PruneEndBeams(const Tensor *pre_ids,
-                   const LoD &abs_lod,
-                   std::vector<std::vector<Item>> *items,
-                   size_t lod_level,
-                   int end_id) {
-  auto *pre_ids_data = pre_ids->data<int64_t>();
-  auto &high_level = abs_lod[lod_level];
-  for (size_t src_idx = 0; src_idx < high_level.size() - 1; ++src_idx) {
-    size_t src_prefix_start = high_level[src_idx];
-    size_t src_prefix_end = high_level[src_idx + 1];
-    bool finish_flag = true;
-    for (size_t offset = src_prefix_start; offset < src_prefix_end; offset++) {
-      for (auto &item : items->at(offset)) {
-        if (item.id != static_cast<size_t>(end_id) ||
-            pre_ids_data[offset] != end_id) {
-          finish_flag = false;
-          break;
-        }
-      }
-      if (!finish_flag) break;
-    }
-    if (finish_flag) {  // all branchs of the beam (source sentence) end and
-                        // prune this beam
-      for (size_t offset = src_prefix_start; offset < src_prefix_end; offset++)
-        items->at(offset).clear();
-    }
+// The min and the max of the block, NaN if any of it is NaN.
+static inline void MinMax(const float* x, float* min, float* max) {
+#ifdef LITE_WITH_ARM
+  float32x4_t vmin = vminq_f32(vld1q_f32(x), vld1q_f32(x + 4));
+  float32x4_t vmax = vmaxq_f32(vld1q_f32(x), vld1q_f32(x + 4));
+  vmin = vminq_f32(vmin, vminq_f32(vld1q_f32(x + 8), vld1q_f32(x + 12)));
+  vmax = vmaxq_f32(vmax, vmaxq_f32(vld1q_f32(x + 8), vld1q_f32(x + 12)));
+#ifdef __aarch64__
+  *min = vminvq_f32(vmin);
+  *max = vmaxvq_f32(vmax);
+#else
+  float32x2_t vmin2 = vpmin_f32(vget_low_f32(vmin), vget_high_f32(vmin));
+  float32x2_t vmax2 = vpmax_f32(vget_low_f32(vmax), vget_high_f32(vmax));
+  *min = vget_lane_f32(vpmin_f32(vmin2, vmin2), 0);
+  *max = vget_lane_f32(vpmax_f32(vmax2, vmax2), 0);
+#endif
+#else
+  float vmin = x[0];
+  float vmax = x[0];
+  bool has_nan = false;
+  for (int i = 0; i < kBlockSize; i++) {
+    vmin = std::min(vmin, x[i]);
+    vmax = std::max(vmax, x[i]);
+    has_nan = has_nan || std::isnan(x[i]);
   }
+  *min = has_nan ? NAN : vmin;
+  *max = has_nan ? NAN : vmax;
+#endif
 }
 
-/*
- * Transform the items into a map whose key is offset, value is the items.
- * NOTE low performance.
- */
-std::vector<std::vector<Item>> ToMap(
-    const std::vector<std::vector<Item>> &items, size_t element_num) {
-  std::vector<std::vector<Item>> result;
-  result.resize(element_num);
-  for (auto &entries : items) {
-    for (const auto &item : entries) {
-      result[item.offset].push_back(item);
-    }
-  }
-  return result;
+// Whether all the scores of the block of candidates are below the threshold,
+// then none of them enters the full beam. pre_score is finite.
+static inline bool BlockBelow(const float* x,
+                              float pre_score,
+                              float threshold,
+                              bool is_accumulated) {
+  float min, max;
+  MinMax(x, &min, &max);
+  if (is_accumulated) return max < threshold;
+  // pre_score + log(x) is not NaN and grows with x for x >= 0 only
+  return min >= 0.f && pre_score + std::log(max) < threshold;
 }
 
-void Insert(std::vector<Item> *top_beam_ptr,
-            const Item &item,
-            size_t beam_size) {
-  std::vector<Item> &top_beam = *top_beam_ptr;
-
-  size_t num_beams = top_beam.size();
+// Insert the item into the beam of num items in the descending order.
+static void Insert(Item* top_beam, int* num, const Item& item, int beam_size) {
+  int num_beams = *num;
   if (num_beams < beam_size) {
-    top_beam.resize(num_beams + 1);
     num_beams++;
-  } else {
-    if (item < top_beam[beam_size - 1]) {
-      return;
-    }
+    *num = num_beams;
+  } else if (item < top_beam[beam_size - 1]) {
+    return;
   }
 
-  for (int k = static_cast<int>(num_beams) - 2; k >= 0; --k) {
+  for (int k = num_beams - 2; k >= 0; --k) {
     if (top_beam[k] < item) {
       top_beam[k + 1] = top_beam[k];
     } else {
@@ -146,130 +110,168 @@ void Insert(std::vector<Item> *top_beam_ptr,
 }
 
 /*
- * For each source, select top beam_size records.
+ * Select the top beam_size items of the source, from all the candidates of
+ * its prefixes [seq_offset_start, seq_offset_end).
  */
-std::vector<std::vector<Item>> SelectTopBeamSizeItems(const Tensor *pre_ids,
-                                                      const Tensor *pre_scores,
-                                                      const Tensor *ids,
-                                                      const Tensor *scores,
-                                                      size_t lod_level,
-                                                      size_t beam_size,
-                                                      int end_id,
-                                                      bool is_accumulated) {
-  std::vector<std::vector<Item>> result;
-
-  // find the current candidates
-  // auto abs_lod = framework::ToAbsOffset(scores->lod());
-  auto abs_lod = ToAbsOffset(scores->lod());
-  auto *pre_ids_data = pre_ids->data<int64_t>();
-  auto *pre_scores_data = pre_scores->data<float>();
-
-  auto *ids_data = ids ? ids->data<int64_t>() : nullptr;
-  auto *scores_data = scores->data<float>();
-
-  size_t num_seqs = abs_lod[lod_level].size() - 1;
-  size_t seq_width = 1;
-  for (int i = 1; i < scores->dims().size(); i++) {
-    seq_width *= scores->dims()[i];
-  }
-
-  for (size_t seq_id = 0; seq_id < num_seqs; ++seq_id) {
-    size_t seq_offset_start = abs_lod[lod_level][seq_id];
-    size_t seq_offset_end = abs_lod[lod_level][seq_id + 1];
-
-    std::vector<Item> top_beam;
-    top_beam.reserve(beam_size);
-
-    for (size_t offset = seq_offset_start; offset < seq_offset_end; ++offset) {
-      auto pre_id = pre_ids_data[offset];
-      auto pre_score = pre_scores_data[offset];
-      if (pre_id == end_id) {
-        // Allocate all probability mass to end_id for finished branchs and
-        // the other candidate ids can be ignored.
-        Item item(offset, end_id, pre_score);
-        Insert(&top_beam, item, beam_size);
-      } else {
-        size_t index = offset * seq_width;
-        for (size_t d = 0; d < seq_width; d++, index++) {
-          int64_t id = ids_data ? ids_data[index] : static_cast<int64_t>(d);
-          float score = is_accumulated
-                            ? scores_data[index]
-                            : pre_score + std::log(scores_data[index]);
-          Item item(offset, id, score);
-          Insert(&top_beam, item, beam_size);
-        }
+static int SelectTopBeamSizeItems(const int64_t* pre_ids_data,
+                                  const float* pre_scores_data,
+                                  const int64_t* ids_data,
+                                  const float* scores_data,
+                                  size_t seq_offset_start,
+                                  size_t seq_offset_end,
+                                  size_t seq_width,
+                                  int beam_size,
+                                  int end_id,
+                                  bool is_accumulated,
+                                  Item* top_beam) {
+  int num = 0;
+  for (size_t offset = seq_offset_start; offset < seq_offset_end; ++offset) {
+    auto pre_id = pre_ids_data[offset];
+    auto pre_score = pre_scores_data[offset];
+    if (pre_id == end_id) {
+      // Allocate all probability mass to end_id for finished branchs and
+      // the other candidate ids can be ignored.
+      Insert(top_beam, &num, Item{offset, end_id, pre_score}, beam_size);
+      continue;
+    }
+    const float* row = scores_data + offset * seq_width;
+    const int64_t* row_ids = ids_data ? ids_data + offset * seq_width : nullptr;
+    // The items of the beam are of the offsets before this one, so a
+    // candidate of the offset enters a full beam only if its score is not
+    // below the worst.
+    const bool skippable = is_accumulated || std::isfinite(pre_score);
+    size_t d = 0;
+    while (d < seq_width) {
+      size_t end = std::min(d + kBlockSize, seq_width);
+      if (skippable && end - d == kBlockSize && num == beam_size &&
+          BlockBelow(
+              row + d, pre_score, top_beam[num - 1].score, is_accumulated)) {
+        d = end;
+        continue;
+      }
+      for (; d < end; d++) {
+        int64_t id = row_ids ? row_ids[d] : static_cast<int64_t>(d);
+        float score =
+            is_accumulated ? row[d] : pre_score + std::log(row[d]);
+        Insert(top_beam, &num, Item{offset, id, score}, beam_size);
       }
     }
+  }
+  return num;
+}
 
-    result.emplace_back(top_beam);
+/*
+ * Prune the source sentences all branchs finished, and it is optional.
+ * Pruning must one step later than finishing (thus pre_ids is needed here),
+ * since the end tokens must be writed out.
+ */
+static bool EndBeam(const int64_t* pre_ids_data,
+                    const Item* top_beam,
+                    int num,
+                    int end_id) {
+  for (int i = 0; i < num; i++) {
+    if (top_beam[i].id != end_id ||
+        pre_ids_data[top_beam[i].offset] != end_id) {
+      return false;
+    }
   }
-  return result;
+  return true;
 }
 
-void beam_search(const Tensor *pre_ids,
-                 const Tensor *pre_scores,
-                 const Tensor *ids,
-                 const Tensor *scores,
-                 Tensor *selected_ids,
-                 Tensor *selected_scores,
-                 Tensor *parent_idx,
+void beam_search(const Tensor* pre_ids,
+                 const Tensor* pre_scores,
+                 const Tensor* ids,
+                 const Tensor* scores,
+                 Tensor* selected_ids,
+                 Tensor* selected_scores,
+                 Tensor* parent_idx,
                  int level,
                  int beam_size,
                  int end_id,
-                 bool is_accumulated) {
-  auto abs_lod = ToAbsOffset(scores->lod());
-  auto &high_level = abs_lod[level];
-  auto items = SelectTopBeamSizeItems(pre_ids,
-                                      pre_scores,
-                                      ids,
-                                      scores,
-                                      level,
-                                      beam_size,
-                                      end_id,
-                                      is_accumulated);
-  auto selected_items = ToMap(items, high_level.back());
+                 bool is_accumulated,
+                 BeamSearchBuffer* buffer) {
+  auto& abs_lod = buffer->abs_lod;
+  ToAbsOffset(scores->lod(), &abs_lod);
+  const auto& high_level = abs_lod[level];
+  auto* pre_ids_data = pre_ids->data<int64_t>();
+  auto* pre_scores_data = pre_scores->data<float>();
+  auto* ids_data = ids ? ids->data<int64_t>() : nullptr;
+  auto* scores_data = scores->data<float>();
+  size_t seq_width = 1;
+  for (size_t i = 1; i < scores->dims().size(); i++) {
+    seq_width *= scores->dims()[i];
+  }
+
+  // The sources select their beams in parallel.
+  const int num_seqs = high_level.size() - 1;
+  auto& items = buffer->items;
+  auto& item_nums = buffer->item_nums;
+  items.resize(num_seqs * beam_size);
+  item_nums.resize(num_seqs);
+  LITE_PARALLEL_BEGIN(seq_id, tid, num_seqs) {
+    Item* top_beam = items.data() + seq_id * beam_size;
+    int num = SelectTopBeamSizeItems(pre_ids_data,
+                                     pre_scores_data,
+                                     ids_data,
+                                     scores_data,
+                                     high_level[seq_id],
+                                     high_level[seq_id + 1],
+                                     seq_width,
+                                     beam_size,
+                                     end_id,
+                                     is_accumulated,
+                                     top_beam);
+    item_nums[seq_id] = EndBeam(pre_ids_data, top_beam, num, end_id) ? 0 : num;
+  }
+  LITE_PARALLEL_END();
+
+  // The selected items are grouped by their prefixes, in the order of the
+  // beams within a prefix.
+  auto& offset_nums = buffer->offset_nums;
+  offset_nums.assign(high_level.back() + 1, 0);
+  size_t num_instances = 0;
+  for (int seq_id = 0; seq_id < num_seqs; seq_id++) {
+    const Item* top_beam = items.data() + seq_id * beam_size;
+    for (int i = 0; i < item_nums[seq_id]; i++) {
+      offset_nums[top_beam[i].offset + 1]++;
+    }
+    num_instances += item_nums[seq_id];
+  }
+  for (size_t i = 1; i < offset_nums.size(); i++) {
+    offset_nums[i] += offset_nums[i - 1];
+  }
 
-  PruneEndBeams(pre_ids, abs_lod, &selected_items, level, end_id);
-  // calculate the output tensor's height
-  size_t num_instances = std::accumulate(
-      std::begin(selected_items),
-      std::end(selected_items),
-      0,
-      [](size_t a, std::vector<Item> &b) { return a + b.size(); });
   // the output tensor shape should be [num_instances, 1]
-  auto dims = std::vector<int64_t>({static_cast<int>(num_instances), 1});
-  selected_ids->Resize(dims);
-  selected_scores->Resize(dims);
+  selected_ids->Resize({static_cast<int64_t>(num_instances), 1});
+  selected_scores->Resize({static_cast<int64_t>(num_instances), 1});
   if (parent_idx) {
     parent_idx->Resize({static_cast<int64_t>(num_instances)});
   }
-  auto *selected_ids_data = selected_ids->mutable_data<int64_t>();
-  auto *selected_scores_data = selected_scores->mutable_data<float>();
-  auto *parent_idx_data =
+  auto* selected_ids_data = selected_ids->mutable_data<int64_t>();
+  auto* selected_scores_data = selected_scores->mutable_data<float>();
+  auto* parent_idx_data =
       parent_idx ? parent_idx->mutable_data<int>() : nullptr;
 
-  // fill in data
-  std::vector<size_t> low_level;
-  size_t low_offset = 0;
-  for (auto &items : selected_items) {
-    low_level.push_back(low_offset);
-    for (auto &item : items) {
-      if (parent_idx) {
-        parent_idx_data[low_offset] = static_cast<int>(low_level.size() - 1);
+  // fill lod, the low level is the start of the items of each prefix
+  auto* lod = selected_ids->mutable_lod();
+  lod->resize(2);
+  (*lod)[0].assign(high_level.begin(), high_level.end());
+  (*lod)[1].assign(offset_nums.begin(), offset_nums.end());
+  *(selected_scores->mutable_lod()) = *lod;
+
+  // fill in data, offset_nums becomes the end of each prefix
+  for (int seq_id = 0; seq_id < num_seqs; seq_id++) {
+    const Item* top_beam = items.data() + seq_id * beam_size;
+    for (int i = 0; i < item_nums[seq_id]; i++) {
+      const auto& item = top_beam[i];
+      size_t low_offset = offset_nums[item.offset]++;
+      if (parent_idx_data) {
+        parent_idx_data[low_offset] = static_cast<int>(item.offset);
       }
       selected_ids_data[low_offset] = item.id;
       selected_scores_data[low_offset] = item.score;
-      low_offset++;
     }
   }
-  low_level.push_back(low_offset);
-
-  // fill lod
-  LoD lod(2);
-  lod[0].assign(high_level.begin(), high_level.end());
-  lod[1].assign(low_level.begin(), low_level.end());
-  *(selected_ids->mutable_lod()) = lod;
-  *(selected_scores->mutable_lod()) = lod;
 }
 
 }  // namespace math
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <vector>
 #include "lite/core/context.h"
 
 namespace paddle {
@@ -20,6 +21,32 @@ namespace lite {
 namespace host {
 namespace math {
 
+// A candidate of a beam.
+struct BeamSearchItem {
+  // the prefix of the candidate, the offset in the higher lod level
+  size_t offset;
+  // the candidate id
+  int64_t id;
+  // the corresponding score
+  float score;
+
+  inline bool operator<(const BeamSearchItem& in) const {
+    return (score < in.score) || ((score == in.score) && (offset < in.offset));
+  }
+};
+
+// The buffers of beam_search, kept by the kernel so that the steps allocate
+// nothing once they are grown.
+struct BeamSearchBuffer {
+  // the beams of the sources, beam_size items each
+  std::vector<BeamSearchItem> items;
+  // the number of the items of each beam
+  std::vector<int> item_nums;
+  // the number of the selected items of each prefix
+  std::vector<uint64_t> offset_nums;
+  LoD abs_lod;
+};
+
 void beam_search(const Tensor* pre_ids,
                  const Tensor* pre_scores,
                  const Tensor* ids,
@@ -30,7 +57,8 @@ void beam_search(const Tensor* pre_ids,
                  int level,
                  int beam_size,
                  int end_id,
-                 bool is_accumulated);
+                 bool is_accumulated,
+                 BeamSearchBuffer* buffer);
 
 }  // namespace math
 }  // namespace host
@@ -0,0 +1,119 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/host/math/conv_resample.h"
+#include <algorithm>
+#include <cstring>
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+void im2col_rows(const float* din,
+                 float* dout,
+                 int channel,
+                 int hin,
+                 int win,
+                 int wout,
+                 int row_begin,
+                 int row_end,
+                 int kh,
+                 int kw,
+                 const std::vector<int>& strides,
+                 const std::vector<int>& paddings,
+                 const std::vector<int>& dilations) {
+  const int cols = (row_end - row_begin) * wout;
+  for (int c = 0; c < channel; ++c) {
+    const float* in = din + static_cast<int64_t>(c) * hin * win;
+    for (int ky = 0; ky < kh; ++ky) {
+      for (int kx = 0; kx < kw; ++kx) {
+        const int k = (c * kh + ky) * kw + kx;
+        float* out = dout + static_cast<int64_t>(k) * cols;
+        const int off = kx * dilations[1] - paddings[2];
+        for (int oy = row_begin; oy < row_end; ++oy, out += wout) {
+          const int iy = oy * strides[0] - paddings[0] + ky * dilations[0];
+          if (iy < 0 || iy >= hin) {
+            memset(out, 0, sizeof(float) * wout);
+            continue;
+          }
+          const float* row = in + iy * win;
+          for (int ox = 0; ox < wout; ++ox) {
+            const int ix = ox * strides[1] + off;
+            out[ox] = (ix >= 0 && ix < win) ? row[ix] : 0.f;
+          }
+        }
+      }
+    }
+  }
+}
+
+void max_pool2x2_rows(const float* din,
+                      float* dout,
+                      int channel,
+                      int rows,
+                      int win,
+                      int row_begin,
+                      int hout,
+                      int wout) {
+  const int y0 = row_begin / 2;
+  const int y1 = std::min(hout, y0 + rows / 2);
+  for (int c = 0; c < channel; ++c) {
+    const float* in = din + static_cast<int64_t>(c) * rows * win;
+    float* out = dout + static_cast<int64_t>(c) * hout * wout;
+    for (int y = y0; y < y1; ++y) {
+      const float* r0 = in + (y - y0) * 2 * win;
+      const float* r1 = r0 + win;
+      float* o = out + y * wout;
+      for (int x = 0; x < wout; ++x) {
+        o[x] = std::max(std::max(r0[2 * x], r0[2 * x + 1]),
+                        std::max(r1[2 * x], r1[2 * x + 1]));
+      }
+    }
+  }
+}
+
+void global_sum_rows(const float* din, float* dout, int channel, int size) {
+  for (int c = 0; c < channel; ++c) {
+    const float* in = din + static_cast<int64_t>(c) * size;
+    float sum = 0.f;
+    for (int i = 0; i < size; ++i) sum += in[i];
+    dout[c] += sum;
+  }
+}
+
+void upsample_nearest2x_rows(const float* din,
+                             float* dout,
+                             int channel,
+                             int rows,
+                             int win,
+                             int row_begin,
+                             int hout,
+                             int wout) {
+  for (int c = 0; c < channel; ++c) {
+    const float* in = din + static_cast<int64_t>(c) * rows * win;
+    float* out = dout + static_cast<int64_t>(c) * hout * wout;
+    for (int r = 0; r < rows; ++r) {
+      const float* src = in + r * win;
+      float* o = out + static_cast<int64_t>(row_begin + r) * 2 * wout;
+      for (int x = 0; x < wout; ++x) o[x] = src[x / 2];
+      memcpy(o + wout, o, sizeof(float) * wout);
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
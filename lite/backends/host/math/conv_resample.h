@@ -0,0 +1,74 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// The helpers of the convs fused with a 2x2 max pooling, a global average
+// pooling or a 2x nearest upsampling, which run the conv in bands of output
+// rows.
+
+// Write the patches of the conv output rows [row_begin, row_end) of one
+// NCHW image as the [channel * kh * kw, (row_end - row_begin) * wout] gemm
+// input. The paddings are {up, down, left, right}.
+void im2col_rows(const float* din,
+                 float* dout,
+                 int channel,
+                 int hin,
+                 int win,
+                 int wout,
+                 int row_begin,
+                 int row_end,
+                 int kh,
+                 int kw,
+                 const std::vector<int>& strides,
+                 const std::vector<int>& paddings,
+                 const std::vector<int>& dilations);
+
+// 2x2 stride 2 max pooling of a [channel, rows, win] band of conv output rows
+// from row_begin, which is even, into the [channel, hout, wout] output.
+void max_pool2x2_rows(const float* din,
+                      float* dout,
+                      int channel,
+                      int rows,
+                      int win,
+                      int row_begin,
+                      int hout,
+                      int wout);
+
+// Add the sums of each channel of a [channel, size] band of conv output rows
+// to dout[channel], for the global average pooling.
+void global_sum_rows(const float* din, float* dout, int channel, int size);
+
+// 2x nearest upsampling of a [channel, rows, win] band of conv output rows
+// from row_begin into the [channel, hout, wout] output.
+void upsample_nearest2x_rows(const float* din,
+                             float* dout,
+                             int channel,
+                             int rows,
+                             int win,
+                             int row_begin,
+                             int hout,
+                             int wout);
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
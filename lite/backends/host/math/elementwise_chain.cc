@@ -0,0 +1,319 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/host/math/elementwise_chain.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// the elements of a tile, and the tiles of a task of the thread pool
+static constexpr int kTile = 256;
+static constexpr int kTilesPerTask = 64;
+
+bool ParseChainOp(const std::string& type, ChainOp* op) {
+  static const std::map<std::string, ChainOp> ops{
+      {"elementwise_add", ChainOp::kAdd},
+      {"elementwise_sub", ChainOp::kSub},
+      {"elementwise_mul", ChainOp::kMul},
+      {"elementwise_div", ChainOp::kDiv},
+      {"elementwise_max", ChainOp::kMax},
+      {"elementwise_min", ChainOp::kMin},
+      {"relu", ChainOp::kRelu},
+      {"relu6", ChainOp::kRelu6},
+      {"leaky_relu", ChainOp::kLeakyRelu},
+      {"sigmoid", ChainOp::kSigmoid},
+      {"tanh", ChainOp::kTanh},
+      {"swish", ChainOp::kSwish},
+      {"hard_sigmoid", ChainOp::kHardSigmoid},
+      {"hard_swish", ChainOp::kHardSwish},
+      {"exp", ChainOp::kExp},
+      {"abs", ChainOp::kAbs},
+      {"square", ChainOp::kSquare},
+      {"sqrt", ChainOp::kSqrt},
+      {"scale", ChainOp::kScale}};
+  auto it = ops.find(type);
+  if (it == ops.end()) return false;
+  *op = it->second;
+  return true;
+}
+
+std::vector<ElementwiseChainStep> elementwise_chain_steps(
+    const operators::ElementwiseChainParam& param) {
+  std::vector<ElementwiseChainStep> steps(param.step_types.size());
+  for (size_t i = 0; i < steps.size(); ++i) {
+    auto& step = steps[i];
+    CHECK(ParseChainOp(param.step_types[i], &step.op))
+        << "Unsupported op of the elementwise chain: " << param.step_types[i];
+    step.operand = param.operands[i];
+    step.operand_first = param.operand_first[i] != 0;
+    step.axis = param.axes[i];
+    step.alpha = param.alphas[i];
+    step.beta = param.betas[i];
+    step.gamma = param.gammas[i];
+    CHECK_EQ(IsBinaryChainOp(step.op), (step.operand >= 0));
+  }
+  return steps;
+}
+
+template <typename Func>
+static void unary(const float* x, float* out, int n, Func func) {
+  for (int i = 0; i < n; ++i) out[i] = func(x[i]);
+}
+
+template <typename Func>
+static void binary(const float* x, const float* y, float* out, int n, Func f) {
+  for (int i = 0; i < n; ++i) out[i] = f(x[i], y[i]);
+}
+
+void elementwise_chain_step(const ElementwiseChainStep& step,
+                            const float* x,
+                            const float* y,
+                            float* out,
+                            int n) {
+  const float alpha = step.alpha;
+  const float beta = step.beta;
+  const float gamma = step.gamma;
+  switch (step.op) {
+    case ChainOp::kAdd:
+      binary(x, y, out, n, [](float a, float b) { return a + b; });
+      break;
+    case ChainOp::kSub:
+      binary(x, y, out, n, [](float a, float b) { return a - b; });
+      break;
+    case ChainOp::kMul:
+      binary(x, y, out, n, [](float a, float b) { return a * b; });
+      break;
+    case ChainOp::kDiv:
+      binary(x, y, out, n, [](float a, float b) { return a / b; });
+      break;
+    case ChainOp::kMax:
+      binary(x, y, out, n, [](float a, float b) { return std::max(a, b); });
+      break;
+    case ChainOp::kMin:
+      binary(x, y, out, n, [](float a, float b) { return std::min(a, b); });
+      break;
+    case ChainOp::kRelu:
+      unary(x, out, n, [](float a) { return std::max(a, 0.f); });
+      break;
+    case ChainOp::kRelu6:
+      unary(x, out, n, [=](float a) {
+        return std::min(std::max(a, 0.f), alpha);
+      });
+      break;
+    case ChainOp::kLeakyRelu:
+      unary(x, out, n, [=](float a) { return a > 0.f ? a : a * alpha; });
+      break;
+    case ChainOp::kSigmoid:
+      unary(x, out, n, [](float a) { return 1.f / (1.f + std::exp(-a)); });
+      break;
+    case ChainOp::kTanh:
+      unary(x, out, n, [](float a) { return std::tanh(a); });
+      break;
+    case ChainOp::kSwish:
+      unary(x, out, n, [=](float a) {
+        return a / (1.f + std::exp(-alpha * a));
+      });
+      break;
+    case ChainOp::kHardSigmoid:
+      unary(x, out, n, [=](float a) {
+        return std::min(std::max(a * alpha + beta, 0.f), 1.f);
+      });
+      break;
+    case ChainOp::kHardSwish:
+      unary(x, out, n, [=](float a) {
+        return std::min(std::max(a + gamma, 0.f), alpha) * a / beta;
+      });
+      break;
+    case ChainOp::kExp:
+      unary(x, out, n, [](float a) { return std::exp(a); });
+      break;
+    case ChainOp::kAbs:
+      unary(x, out, n, [](float a) { return std::fabs(a); });
+      break;
+    case ChainOp::kSquare:
+      unary(x, out, n, [](float a) { return a * a; });
+      break;
+    case ChainOp::kSqrt:
+      unary(x, out, n, [](float a) { return std::sqrt(a); });
+      break;
+    case ChainOp::kScale:
+      if (gamma != 0.f) {
+        unary(x, out, n, [=](float a) { return a * alpha + beta; });
+      } else {
+        unary(x, out, n, [=](float a) { return (a + beta) * alpha; });
+      }
+      break;
+  }
+}
+
+namespace {
+
+// How an input is read at the output index i.
+struct ChainInput {
+  enum Kind { kFull, kScalar, kRepeat, kGeneral };
+  Kind kind{kFull};
+  const float* data{nullptr};
+  // kRepeat reads data[(i / post) % n]
+  int64_t n{1};
+  int64_t post{1};
+  // kGeneral reads with the strides of the input, 0 for the broadcast dims
+  std::vector<int64_t> strides;
+
+  ChainInput(const float* x,
+             const std::vector<int64_t>& dims,
+             const std::vector<int64_t>& out_dims)
+      : data(x) {
+    const int rank = static_cast<int>(out_dims.size());
+    if (dims == out_dims) return;
+    int first = rank;
+    int last = -1;
+    for (int i = 0; i < rank; ++i) {
+      if (dims[i] != 1) {
+        first = std::min(first, i);
+        last = i;
+      }
+    }
+    if (last < 0) {
+      kind = kScalar;
+      return;
+    }
+    kind = kRepeat;
+    n = 1;
+    post = 1;
+    for (int i = first; i <= last; ++i) {
+      if (dims[i] != out_dims[i]) kind = kGeneral;
+      n *= dims[i];
+    }
+    for (int i = last + 1; i < rank; ++i) post *= out_dims[i];
+    if (kind == kRepeat) return;
+    strides.assign(rank, 0);
+    int64_t stride = 1;
+    for (int i = rank - 1; i >= 0; --i) {
+      if (dims[i] != 1) strides[i] = stride;
+      stride *= dims[i];
+    }
+  }
+
+  // the elements [begin, begin + len) of the input in the output space
+  const float* Read(int64_t begin,
+                    int len,
+                    const std::vector<int64_t>& out_dims,
+                    float* buf) const {
+    switch (kind) {
+      case kFull:
+        return data + begin;
+      case kScalar:
+        std::fill(buf, buf + len, data[0]);
+        return buf;
+      case kRepeat: {
+        int j = 0;
+        while (j < len) {
+          const int64_t i = begin + j;
+          const int64_t q = i / post;
+          if (post == 1) {
+            const int64_t k = q % n;
+            const int cnt = static_cast<int>(std::min<int64_t>(n - k, len - j));
+            memcpy(buf + j, data + k, sizeof(float) * cnt);
+            j += cnt;
+          } else {
+            const int cnt =
+                static_cast<int>(std::min<int64_t>(post - i % post, len - j));
+            std::fill(buf + j, buf + j + cnt, data[q % n]);
+            j += cnt;
+          }
+        }
+        return buf;
+      }
+      case kGeneral:
+        for (int j = 0; j < len; ++j) {
+          int64_t i = begin + j;
+          int64_t offset = 0;
+          for (int d = static_cast<int>(out_dims.size()) - 1; d >= 0; --d) {
+            offset += (i % out_dims[d]) * strides[d];
+            i /= out_dims[d];
+          }
+          buf[j] = data[offset];
+        }
+        return buf;
+    }
+    return buf;
+  }
+};
+
+}  // namespace
+
+void elementwise_chain(const std::vector<const float*>& x,
+                       const std::vector<std::vector<int64_t>>& aligned_dims,
+                       const std::vector<int64_t>& out_dims,
+                       const std::vector<ElementwiseChainStep>& steps,
+                       float* out,
+                       ChainStepFunc step_func) {
+  CHECK(!steps.empty());
+  CHECK_EQ(x.size(), aligned_dims.size());
+  const int num_x = static_cast<int>(x.size());
+  const int num_steps = static_cast<int>(steps.size());
+  std::vector<ChainInput> inputs;
+  for (int i = 0; i < num_x; ++i) {
+    inputs.emplace_back(x[i], aligned_dims[i], out_dims);
+  }
+  int64_t numel = 1;
+  for (auto d : out_dims) numel *= d;
+  const int64_t num_tiles = (numel + kTile - 1) / kTile;
+  const int64_t num_tasks = (num_tiles + kTilesPerTask - 1) / kTilesPerTask;
+
+  LITE_PARALLEL_BEGIN(task, tid, num_tasks) {
+    // the tiles of the inputs read with broadcasting, and of the results
+    std::vector<float> scratch(static_cast<size_t>(num_x + num_steps) * kTile);
+    std::vector<const float*> values(num_x + num_steps);
+    const int64_t tile_end =
+        std::min(num_tiles, (task + 1) * static_cast<int64_t>(kTilesPerTask));
+    for (int64_t t = task * kTilesPerTask; t < tile_end; ++t) {
+      const int64_t begin = t * kTile;
+      const int len = static_cast<int>(std::min<int64_t>(kTile, numel - begin));
+      for (int i = 0; i < num_x; ++i) {
+        values[i] =
+            inputs[i].Read(begin, len, out_dims, scratch.data() + i * kTile);
+      }
+      for (int s = 0; s < num_steps; ++s) {
+        const auto& step = steps[s];
+        const float* chain = s == 0 ? values[0] : values[num_x + s - 1];
+        float* res = s + 1 == num_steps
+                         ? out + begin
+                         : scratch.data() + (num_x + s) * kTile;
+        if (step.operand < 0) {
+          step_func(step, chain, nullptr, res, len);
+        } else if (step.operand_first) {
+          step_func(step, values[step.operand], chain, res, len);
+        } else {
+          step_func(step, chain, values[step.operand], res, len);
+        }
+        values[num_x + s] = res;
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,106 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// The ops of fusion_elementwise_chain.
+enum class ChainOp {
+  kAdd,
+  kSub,
+  kMul,
+  kDiv,
+  kMax,
+  kMin,
+  kRelu,
+  kRelu6,
+  kLeakyRelu,
+  kSigmoid,
+  kTanh,
+  kSwish,
+  kHardSigmoid,
+  kHardSwish,
+  kExp,
+  kAbs,
+  kSquare,
+  kSqrt,
+  kScale,
+};
+
+// One op of the chain. The params of the unary ops are
+//   relu6: alpha = threshold
+//   leaky_relu: alpha
+//   swish: alpha = beta
+//   hard_sigmoid: alpha = slope, beta = offset
+//   hard_swish: alpha = threshold, beta = scale, gamma = offset
+//   scale: alpha = scale, beta = bias, gamma = 1 if bias_after_scale
+struct ElementwiseChainStep {
+  ChainOp op{ChainOp::kAdd};
+  // the value read with the chain value by the binary ops, -1 otherwise
+  int operand{-1};
+  // whether the operand is the left hand side, as in x - chain
+  bool operand_first{false};
+  int axis{-1};
+  float alpha{0.f};
+  float beta{0.f};
+  float gamma{0.f};
+};
+
+// The chain op of the op type, returns false if the type is not supported.
+bool ParseChainOp(const std::string& type, ChainOp* op);
+
+// The steps of the attributes of fusion_elementwise_chain.
+std::vector<ElementwiseChainStep> elementwise_chain_steps(
+    const operators::ElementwiseChainParam& param);
+
+inline bool IsBinaryChainOp(ChainOp op) { return op <= ChainOp::kMin; }
+
+// Evaluates one step on n elements, y is nullptr for the unary ops. out may
+// be x or y.
+using ChainStepFunc = void (*)(const ElementwiseChainStep& step,
+                               const float* x,
+                               const float* y,
+                               float* out,
+                               int n);
+
+void elementwise_chain_step(const ElementwiseChainStep& step,
+                            const float* x,
+                            const float* y,
+                            float* out,
+                            int n);
+
+// Evaluates the chain over tiles of the output which stay in the L1 cache.
+// The values are the inputs followed by the step results, step i reads the
+// input 0 for i == 0 and the result of step i - 1 otherwise. aligned_dims
+// are the dims of the inputs padded with 1 to the output rank.
+void elementwise_chain(const std::vector<const float*>& x,
+                       const std::vector<std::vector<int64_t>>& aligned_dims,
+                       const std::vector<int64_t>& out_dims,
+                       const std::vector<ElementwiseChainStep>& steps,
+                       float* out,
+                       ChainStepFunc step_func);
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #pragma once
+#include <algorithm>
+#include <cstring>
+#include "lite/core/parallel_defines.h"
 #include "lite/core/tensor.h"
 
 namespace paddle {
@@ -20,6 +23,55 @@ namespace lite {
 namespace host {
 namespace math {
 
+/**
+ * Gathers the slices of src viewed as [outer, src_rows, slice] by index into
+ * dst viewed as [outer, index_num, slice]. The rows are split into the tasks
+ * of about kGatherTaskBytes on the thread pool, the single element slices
+ * are moved directly instead of by memcpy.
+ */
+template <typename T, typename IndexT>
+void GatherSlices(const T *src,
+                  const IndexT *index,
+                  T *dst,
+                  int64_t outer,
+                  int64_t src_rows,
+                  int64_t index_num,
+                  int64_t slice) {
+  constexpr int64_t kGatherTaskBytes = 16384;
+  int64_t rows = outer * index_num;
+  if (rows == 0 || slice == 0) return;
+  int64_t step =
+      std::max<int64_t>(1, kGatherTaskBytes / (slice * sizeof(T)));
+  int task_num = static_cast<int>((rows + step - 1) / step);
+  LITE_PARALLEL_BEGIN(t, tid, task_num) {
+    int64_t begin = t * step;
+    int64_t end = std::min(begin + step, rows);
+    int64_t k = begin % index_num;
+    const T *src_outer = src + begin / index_num * src_rows * slice;
+    T *out = dst + begin * slice;
+    if (slice == 1) {
+      for (int64_t r = begin; r < end; ++r) {
+        *out++ = src_outer[index[k]];
+        if (++k == index_num) {
+          k = 0;
+          src_outer += src_rows;
+        }
+      }
+    } else {
+      size_t slice_bytes = slice * sizeof(T);
+      for (int64_t r = begin; r < end; ++r) {
+        memcpy(out, src_outer + index[k] * slice, slice_bytes);
+        out += slice;
+        if (++k == index_num) {
+          k = 0;
+          src_outer += src_rows * slice;
+        }
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
 template <typename T, typename IndexT = int>
 void Gather(const Tensor &src, const Tensor &index, Tensor *output) {
   auto *p_src = src.data<T>();
@@ -29,13 +81,8 @@ void Gather(const Tensor &src, const Tensor &index, Tensor *output) {
   auto src_dims = src.dims();
   int64_t slice_size = 1;
   for (size_t i = 1; i < src_dims.size(); i++) slice_size *= src_dims[i];
-  size_t slice_bytes = slice_size * sizeof(T);
-
-  int64_t index_size = index.numel();
-  for (int64_t i = 0; i < index_size; i++) {
-    IndexT index_ = p_index[i];
-    memcpy(p_output + i * slice_size, p_src + index_ * slice_size, slice_bytes);
-  }
+  GatherSlices(
+      p_src, p_index, p_output, 1, src_dims[0], index.numel(), slice_size);
 }
 
 }  // namespace math
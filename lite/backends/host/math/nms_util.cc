@@ -0,0 +1,68 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/host/math/nms_util.h"
+#if defined(LITE_WITH_ARM) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+void JaccardOverlaps(const float* box,
+                     const BoxColumns<float>& boxes,
+                     int begin,
+                     int end,
+                     const bool normalized,
+                     float* overlaps) {
+  int i = begin;
+#if defined(LITE_WITH_ARM) && defined(__aarch64__)
+  // The same operations in the same order as JaccardOverlap, the division
+  // included, so that the same boxes are suppressed.
+  const float32x4_t vnorm = vdupq_n_f32(normalized ? 0.f : 1.f);
+  const float32x4_t varea = vdupq_n_f32(BBoxArea<float>(box, normalized));
+  const float32x4_t vxmin = vdupq_n_f32(box[0]);
+  const float32x4_t vymin = vdupq_n_f32(box[1]);
+  const float32x4_t vxmax = vdupq_n_f32(box[2]);
+  const float32x4_t vymax = vdupq_n_f32(box[3]);
+  const float32x4_t vzero = vdupq_n_f32(0.f);
+  for (; i + 3 < end; i += 4) {
+    float32x4_t bxmin = vld1q_f32(boxes.xmin.data() + i);
+    float32x4_t bymin = vld1q_f32(boxes.ymin.data() + i);
+    float32x4_t bxmax = vld1q_f32(boxes.xmax.data() + i);
+    float32x4_t bymax = vld1q_f32(boxes.ymax.data() + i);
+    float32x4_t barea = vld1q_f32(boxes.area.data() + i);
+    uint32x4_t disjoint =
+        vorrq_u32(vorrq_u32(vcgtq_f32(bxmin, vxmax), vcltq_f32(bxmax, vxmin)),
+                  vorrq_u32(vcgtq_f32(bymin, vymax), vcltq_f32(bymax, vymin)));
+    float32x4_t inter_w = vaddq_f32(
+        vsubq_f32(vminq_f32(vxmax, bxmax), vmaxq_f32(vxmin, bxmin)), vnorm);
+    float32x4_t inter_h = vaddq_f32(
+        vsubq_f32(vminq_f32(vymax, bymax), vmaxq_f32(vymin, bymin)), vnorm);
+    float32x4_t inter_area = vmulq_f32(inter_w, inter_h);
+    float32x4_t iou = vdivq_f32(
+        inter_area, vsubq_f32(vaddq_f32(varea, barea), inter_area));
+    vst1q_f32(overlaps + i - begin, vbslq_f32(disjoint, vzero, iou));
+  }
+#endif
+  JaccardOverlaps<float>(
+      box, boxes, i, end, normalized, overlaps + (i - begin));
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
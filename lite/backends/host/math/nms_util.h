@@ -39,13 +39,20 @@ static void GetMaxScoreIndex(const std::vector<T>& scores,
       sorted_indices->push_back(std::make_pair(scores[i], i));
     }
   }
-  // Sort the score pair according to the scores in descending order
-  std::stable_sort(sorted_indices->begin(),
-                   sorted_indices->end(),
-                   SortScorePairDescend<int>);
-  // Keep top_k scores if needed.
+  // Sort the score pair according to the scores in descending order, the
+  // ties are in the order of the indices as the stable sort leaves them.
+  auto descend = [](const std::pair<T, int>& a, const std::pair<T, int>& b) {
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+  };
+  // Only the top_k scores are sorted if needed.
   if (top_k > -1 && top_k < static_cast<int>(sorted_indices->size())) {
+    std::partial_sort(sorted_indices->begin(),
+                      sorted_indices->begin() + top_k,
+                      sorted_indices->end(),
+                      descend);
     sorted_indices->resize(top_k);
+  } else {
+    std::sort(sorted_indices->begin(), sorted_indices->end(), descend);
   }
 }
 
@@ -87,6 +94,93 @@ static T JaccardOverlap(const T* box1, const T* box2, const bool normalized) {
   }
 }
 
+// The boxes [xmin ymin xmax ymax] stored as the columns of the coordinates
+// and the areas, so that the overlaps with them are computed in vectors.
+template <typename T>
+struct BoxColumns {
+  std::vector<T> xmin, ymin, xmax, ymax, area;
+
+  int size() const { return static_cast<int>(xmin.size()); }
+  void push_back(const T* box, const bool normalized) {
+    xmin.push_back(box[0]);
+    ymin.push_back(box[1]);
+    xmax.push_back(box[2]);
+    ymax.push_back(box[3]);
+    area.push_back(BBoxArea<T>(box, normalized));
+  }
+};
+
+// overlaps[i - begin] is the JaccardOverlap of box with the i-th of boxes
+// for i in [begin, end).
+template <typename T>
+void JaccardOverlaps(const T* box,
+                     const BoxColumns<T>& boxes,
+                     int begin,
+                     int end,
+                     const bool normalized,
+                     T* overlaps) {
+  const T norm = normalized ? static_cast<T>(0.) : static_cast<T>(1.);
+  const T area = BBoxArea<T>(box, normalized);
+  for (int i = begin; i < end; ++i) {
+    if (boxes.xmin[i] > box[2] || boxes.xmax[i] < box[0] ||
+        boxes.ymin[i] > box[3] || boxes.ymax[i] < box[1]) {
+      overlaps[i - begin] = static_cast<T>(0.);
+    } else {
+      const T inter_w = (std::min)(box[2], boxes.xmax[i]) -
+                        (std::max)(box[0], boxes.xmin[i]) + norm;
+      const T inter_h = (std::min)(box[3], boxes.ymax[i]) -
+                        (std::max)(box[1], boxes.ymin[i]) + norm;
+      const T inter_area = inter_w * inter_h;
+      overlaps[i - begin] = inter_area / (area + boxes.area[i] - inter_area);
+    }
+  }
+}
+
+// The same as above, 4 boxes at a time with NEON on armv8.
+void JaccardOverlaps(const float* box,
+                     const BoxColumns<float>& boxes,
+                     int begin,
+                     int end,
+                     const bool normalized,
+                     float* overlaps);
+
+// The greedy NMS of the boxes [xmin ymin xmax ymax] visited in the order of
+// sorted_indices, with the threshold adapted by eta after each kept box.
+// The kept boxes are overlapped with a box in chunks, which stops early once
+// it is suppressed.
+template <typename T>
+void NMSBoxes(const T* bbox_data,
+              const std::vector<std::pair<T, int>>& sorted_indices,
+              const T nms_threshold,
+              const T eta,
+              const bool normalized,
+              std::vector<int>* selected_indices) {
+  const int kChunk = 16;
+  T overlaps[kChunk];
+  T adaptive_threshold = nms_threshold;
+  BoxColumns<T> kept_boxes;
+  for (auto& score_index : sorted_indices) {
+    const int idx = score_index.second;
+    const T* box = bbox_data + idx * 4;
+    bool keep = true;
+    const int num_kept = kept_boxes.size();
+    for (int k = 0; keep && k < num_kept; k += kChunk) {
+      const int end = (std::min)(num_kept, k + kChunk);
+      JaccardOverlaps(box, kept_boxes, k, end, normalized, overlaps);
+      for (int j = 0; j < end - k; ++j) {
+        keep = keep && overlaps[j] <= adaptive_threshold;
+      }
+    }
+    if (keep) {
+      selected_indices->push_back(idx);
+      kept_boxes.push_back(box, normalized);
+      if (eta < 1 && adaptive_threshold > 0.5) {
+        adaptive_threshold *= eta;
+      }
+    }
+  }
+}
+
 template <typename T>
 T PolyIoU(const T* box1,
           const T* box2,
@@ -149,9 +243,20 @@ static Tensor NMS(Tensor* bbox,
       GetSortedScoreIndex<T>(scores_data);
 
   std::vector<int> selected_indices;
+  const T* bbox_data = bbox->data<T>();
+  if (box_size == 4) {
+    // the scores in descending order, the ties of the larger indices first
+    std::reverse(sorted_indices.begin(), sorted_indices.end());
+    NMSBoxes(bbox_data,
+             sorted_indices,
+             nms_threshold,
+             static_cast<T>(eta),
+             !pixel_offset,
+             &selected_indices);
+    return VectorToTensor(selected_indices, selected_indices.size());
+  }
   int selected_num = 0;
   T adaptive_threshold = nms_threshold;
-  const T* bbox_data = bbox->data<T>();
   while (sorted_indices.size() != 0) {
     int idx = sorted_indices.back().second;
     bool flag = true;
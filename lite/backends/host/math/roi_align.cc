@@ -0,0 +1,221 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/host/math/roi_align.h"
+#include <algorithm>
+#include <cmath>
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// the corners of a bilinear sample
+static constexpr int kROISize = 4;
+
+// The corners and the weights of the samples of the bins of the roi.
+static void PreCalcForBilinearInterpolate(const int height,
+                                          const int width,
+                                          const int pooled_height,
+                                          const int pooled_width,
+                                          float roi_ymin,
+                                          float roi_xmin,
+                                          float bin_size_h,
+                                          float bin_size_w,
+                                          int roi_bin_grid_h,
+                                          int roi_bin_grid_w,
+                                          int* pre_pos_data,
+                                          float* pre_w_data) {
+  int pre_calc_index = 0;
+  for (int ph = 0; ph < pooled_height; ph++) {
+    for (int pw = 0; pw < pooled_width; pw++) {
+      for (int iy = 0; iy < roi_bin_grid_h; iy++) {
+        // calculate y of sample points
+        float y = roi_ymin + ph * bin_size_h +
+                  static_cast<float>(iy + .5f) * bin_size_h /
+                      static_cast<float>(roi_bin_grid_h);
+        // calculate x of samle points
+        for (int ix = 0; ix < roi_bin_grid_w; ix++) {
+          float x = roi_xmin + pw * bin_size_w +
+                    static_cast<float>(ix + .5f) * bin_size_w /
+                        static_cast<float>(roi_bin_grid_w);
+          int* pos = pre_pos_data + pre_calc_index * kROISize;
+          float* w = pre_w_data + pre_calc_index * kROISize;
+          pre_calc_index += 1;
+          // deal with elements out of map
+          if (y < -1.0 || y > height || x < -1.0 || x > width) {
+            for (int i = 0; i < kROISize; ++i) {
+              pos[i] = 0;
+              w[i] = 0;
+            }
+            continue;
+          }
+          y = y <= 0 ? 0 : y;
+          x = x <= 0 ? 0 : x;
+
+          int y_low = static_cast<int>(y);
+          int x_low = static_cast<int>(x);
+          int y_high;
+          int x_high;
+          if (y_low >= height - 1) {
+            y_high = y_low = height - 1;
+            y = static_cast<float>(y_low);
+          } else {
+            y_high = y_low + 1;
+          }
+          if (x_low >= width - 1) {
+            x_high = x_low = width - 1;
+            x = static_cast<float>(x_low);
+          } else {
+            x_high = x_low + 1;
+          }
+          float ly = y - y_low, lx = x - x_low;
+          float hy = 1. - ly, hx = 1. - lx;
+          pos[0] = y_low * width + x_low;
+          pos[1] = y_low * width + x_high;
+          pos[2] = y_high * width + x_low;
+          pos[3] = y_high * width + x_high;
+          w[0] = hy * hx;
+          w[1] = hy * lx;
+          w[2] = ly * hx;
+          w[3] = ly * lx;
+        }
+      }
+    }
+  }
+}
+
+void roi_align_one(const float* in,
+                   const float* roi,
+                   float* out,
+                   int channels,
+                   int height,
+                   int width,
+                   int pooled_height,
+                   int pooled_width,
+                   float spatial_scale,
+                   int sampling_ratio,
+                   bool aligned) {
+  float roi_offset = aligned ? 0.5f : 0.f;
+  float roi_xmin = roi[0] * spatial_scale - roi_offset;
+  float roi_ymin = roi[1] * spatial_scale - roi_offset;
+  float roi_xmax = roi[2] * spatial_scale - roi_offset;
+  float roi_ymax = roi[3] * spatial_scale - roi_offset;
+  float roi_width = roi_xmax - roi_xmin;
+  float roi_height = roi_ymax - roi_ymin;
+  if (!aligned) {
+    roi_width = std::max(roi_width, 1.f);
+    roi_height = std::max(roi_height, 1.f);
+  }
+
+  float bin_size_h = roi_height / pooled_height;
+  float bin_size_w = roi_width / pooled_width;
+  int roi_bin_grid_h = (sampling_ratio > 0)
+                           ? sampling_ratio
+                           : ceil(roi_height / pooled_height);
+  int roi_bin_grid_w =
+      (sampling_ratio > 0) ? sampling_ratio : ceil(roi_width / pooled_width);
+  const int count = std::max(roi_bin_grid_h * roi_bin_grid_w, 1);
+  const int pool_size = pooled_height * pooled_width;
+  // The samples are the same for all the channels.
+  std::vector<int> pre_pos(count * pool_size * kROISize, 0);
+  std::vector<float> pre_w(count * pool_size * kROISize, 0.f);
+  PreCalcForBilinearInterpolate(height,
+                                width,
+                                pooled_height,
+                                pooled_width,
+                                roi_ymin,
+                                roi_xmin,
+                                bin_size_h,
+                                bin_size_w,
+                                roi_bin_grid_h,
+                                roi_bin_grid_w,
+                                pre_pos.data(),
+                                pre_w.data());
+
+  const int samples = roi_bin_grid_h * roi_bin_grid_w;
+  for (int c = 0; c < channels; c++) {
+    const int* pos = pre_pos.data();
+    const float* w = pre_w.data();
+    for (int p = 0; p < pool_size; p++) {
+      float output_val = 0;
+      for (int s = 0; s < samples; s++) {
+        for (int i = 0; i < kROISize; i++) {
+          output_val += w[i] * in[pos[i]];
+        }
+        pos += kROISize;
+        w += kROISize;
+      }
+      out[p] = output_val / count;
+    }
+    in += height * width;
+    out += pool_size;
+  }
+}
+
+void roi_align(const float* in,
+               const float* rois,
+               const int* batch_ids,
+               float* out,
+               int rois_num,
+               int channels,
+               int height,
+               int width,
+               int pooled_height,
+               int pooled_width,
+               float spatial_scale,
+               int sampling_ratio,
+               bool aligned) {
+  const int in_stride = channels * height * width;
+  const int out_stride = channels * pooled_height * pooled_width;
+  LITE_PARALLEL_BEGIN(n, tid, rois_num) {
+    roi_align_one(in + batch_ids[n] * in_stride,
+                  rois + n * 4,
+                  out + n * out_stride,
+                  channels,
+                  height,
+                  width,
+                  pooled_height,
+                  pooled_width,
+                  spatial_scale,
+                  sampling_ratio,
+                  aligned);
+  }
+  LITE_PARALLEL_END();
+}
+
+int fpn_level(const float* roi,
+              int min_level,
+              int max_level,
+              int refer_level,
+              int refer_scale,
+              bool pixel_offset) {
+  float area = 0.f;
+  // the invalid rois of xmax < xmin or ymax < ymin are of area 0
+  if (roi[2] >= roi[0] && roi[3] >= roi[1]) {
+    const float w = roi[2] - roi[0];
+    const float h = roi[3] - roi[1];
+    area = pixel_offset ? (w + 1) * (h + 1) : w * h;
+  }
+  float roi_scale = std::sqrt(area);
+  int tgt_lvl = std::floor(
+      log2(roi_scale / refer_scale + static_cast<float>(1e-6)) + refer_level);
+  return std::min(max_level, std::max(tgt_lvl, min_level));
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
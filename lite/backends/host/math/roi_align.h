@@ -0,0 +1,65 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// The roi_align of the rois of [xmin, ymin, xmax, ymax] on the images of
+// in of [batch, channels, height, width] into out of [rois_num, channels,
+// pooled_height, pooled_width]. batch_ids are the images of the rois. The
+// rois run in parallel.
+void roi_align(const float* in,
+               const float* rois,
+               const int* batch_ids,
+               float* out,
+               int rois_num,
+               int channels,
+               int height,
+               int width,
+               int pooled_height,
+               int pooled_width,
+               float spatial_scale,
+               int sampling_ratio,
+               bool aligned);
+
+// The roi_align of one roi on the image of [channels, height, width].
+void roi_align_one(const float* in,
+                   const float* roi,
+                   float* out,
+                   int channels,
+                   int height,
+                   int width,
+                   int pooled_height,
+                   int pooled_width,
+                   float spatial_scale,
+                   int sampling_ratio,
+                   bool aligned);
+
+// The fpn level of the roi of distribute_fpn_proposals.
+int fpn_level(const float* roi,
+              int min_level,
+              int max_level,
+              int refer_level,
+              int refer_scale,
+              bool pixel_offset);
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
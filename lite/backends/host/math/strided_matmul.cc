@@ -0,0 +1,153 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/host/math/strided_matmul.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// the dims and the element strides of a tensor read through a transpose
+struct StridedView {
+  std::vector<int64_t> dims;
+  std::vector<int64_t> strides;
+};
+
+static StridedView TransposedView(const DDim& dims,
+                                  const std::vector<int>& perm) {
+  const int rank = dims.size();
+  std::vector<int64_t> strides(rank, 1);
+  for (int i = rank - 2; i >= 0; --i) {
+    strides[i] = strides[i + 1] * dims[i + 1];
+  }
+  StridedView view;
+  for (int i = 0; i < rank; ++i) {
+    const int axis = perm.empty() ? i : perm[i];
+    view.dims.push_back(dims[axis]);
+    view.strides.push_back(strides[axis]);
+  }
+  return view;
+}
+
+// The leading dim of the matrix in the last two dims of the view, and whether
+// it is stored transposed, i.e. its columns are contiguous.
+static void MatrixLayout(const StridedView& view, int* ld, bool* trans) {
+  const int rank = view.dims.size();
+  CHECK_GE(rank, 2) << "the strided operands of matmul should be matrices";
+  const int64_t rows = view.dims[rank - 2];
+  const int64_t cols = view.dims[rank - 1];
+  if (view.strides[rank - 1] == 1 || cols == 1) {
+    *trans = false;
+    *ld = rows > 1 ? view.strides[rank - 2] : cols;
+  } else {
+    CHECK(view.strides[rank - 2] == 1 || rows == 1)
+        << "the fused transpose of matmul should keep one of the last two "
+           "dims contiguous";
+    *trans = true;
+    *ld = cols > 1 ? view.strides[rank - 1] : rows;
+  }
+}
+
+bool has_fused_transpose(const operators::MatMulParam& param) {
+  return !param.fused_transpose_X.empty() ||
+         !param.fused_transpose_Y.empty() ||
+         !param.fused_transpose_Out.empty();
+}
+
+bool has_broadcast_batch(const operators::MatMulParam& param) {
+  const auto& x_dims = param.X->dims();
+  const auto& y_dims = param.Y->dims();
+  if (x_dims.size() <= 2 || y_dims.size() <= 2) {
+    return false;
+  }
+  return x_dims.size() != y_dims.size() ||
+         x_dims.count(0, x_dims.size() - 2) !=
+             y_dims.count(0, y_dims.size() - 2);
+}
+
+void strided_matmul_args(const operators::MatMulParam& param,
+                         StridedMatmulArgs* args) {
+  auto x = TransposedView(param.X->dims(), param.fused_transpose_X);
+  auto y = TransposedView(param.Y->dims(), param.fused_transpose_Y);
+  bool x_trans = false;
+  bool y_trans = false;
+  MatrixLayout(x, &args->ldx, &x_trans);
+  MatrixLayout(y, &args->ldy, &y_trans);
+  const int x_rank = x.dims.size();
+  const int y_rank = y.dims.size();
+  args->m = param.transpose_X ? x.dims[x_rank - 1] : x.dims[x_rank - 2];
+  args->k = param.transpose_X ? x.dims[x_rank - 2] : x.dims[x_rank - 1];
+  args->n = param.transpose_Y ? y.dims[y_rank - 2] : y.dims[y_rank - 1];
+  CHECK_EQ(args->k,
+           param.transpose_Y ? y.dims[y_rank - 1] : y.dims[y_rank - 2])
+      << "the inner dims of the strided operands of matmul should be equal";
+  args->trans_x = x_trans != param.transpose_X;
+  args->trans_y = y_trans != param.transpose_Y;
+
+  // the output before its fused transpose, with the strides of Out
+  const auto& out_perm = param.fused_transpose_Out;
+  auto out_dims = param.Out->dims();
+  const int out_rank = out_dims.size();
+  auto final_out = TransposedView(out_dims, {});
+  auto out = final_out;
+  for (int i = 0; i < static_cast<int>(out_perm.size()); ++i) {
+    out.dims[out_perm[i]] = final_out.dims[i];
+    out.strides[out_perm[i]] = final_out.strides[i];
+  }
+  CHECK(out.strides[out_rank - 1] == 1 || args->n == 1)
+      << "the fused transpose of the output of matmul should keep its last dim";
+  args->ldout = args->m > 1 ? out.strides[out_rank - 2] : args->n;
+
+  // the batches are those of the output, the batch dims of X and Y are
+  // aligned to its last ones, and the missing or size-1 ones are broadcast
+  const int batch_rank = out_rank - 2;
+  CHECK(x_rank <= out_rank && y_rank <= out_rank)
+      << "the strided operands of matmul should have the batches of Out";
+  const int x_shift = out_rank - x_rank;
+  const int y_shift = out_rank - y_rank;
+  int64_t batch = 1;
+  for (int i = 0; i < batch_rank; ++i) {
+    CHECK(i < x_shift || x.dims[i - x_shift] == out.dims[i] ||
+          x.dims[i - x_shift] == 1);
+    CHECK(i < y_shift || y.dims[i - y_shift] == out.dims[i] ||
+          y.dims[i - y_shift] == 1);
+    batch *= out.dims[i];
+  }
+  args->x_offsets.assign(batch, 0);
+  args->y_offsets.assign(batch, 0);
+  args->out_offsets.assign(batch, 0);
+  std::vector<int64_t> index(batch_rank, 0);
+  for (int64_t b = 0; b < batch; ++b) {
+    for (int i = 0; i < batch_rank; ++i) {
+      if (i >= x_shift && x.dims[i - x_shift] > 1) {
+        args->x_offsets[b] += index[i] * x.strides[i - x_shift];
+      }
+      if (i >= y_shift && y.dims[i - y_shift] > 1) {
+        args->y_offsets[b] += index[i] * y.strides[i - y_shift];
+      }
+      args->out_offsets[b] += index[i] * out.strides[i];
+    }
+    for (int i = batch_rank - 1; i >= 0; --i) {
+      if (++index[i] < out.dims[i]) break;
+      index[i] = 0;
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
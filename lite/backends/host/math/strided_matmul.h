@@ -0,0 +1,59 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// The gemms of a batched matmul whose operands are read and whose output is
+// written through the perms of the transpose2 ops folded into it by
+// lite_transpose_matmul_fuse_pass, so those transposes are never done.
+struct StridedMatmulArgs {
+  int m{0};
+  int n{0};
+  int k{0};
+  bool trans_x{false};
+  bool trans_y{false};
+  int ldx{0};
+  int ldy{0};
+  int ldout{0};
+  // the offsets of the matrices of each batch
+  std::vector<int64_t> x_offsets;
+  std::vector<int64_t> y_offsets;
+  std::vector<int64_t> out_offsets;
+};
+
+// Whether a transpose2 is folded into X, Y or Out of the matmul.
+bool has_fused_transpose(const operators::MatMulParam& param);
+
+// Whether X and Y both have batches but a different number of them, i.e.
+// the size-1 or missing batch dims of one of them are broadcast.
+bool has_broadcast_batch(const operators::MatMulParam& param);
+
+// The gemms of the matmul of param, with the dims of its tensors: those of X
+// and Y before and that of Out after their fused transposes.
+void strided_matmul_args(const operators::MatMulParam& param,
+                         StridedMatmulArgs* args);
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
@@ -13,14 +13,156 @@
 // limitations under the License.
 
 #include "lite/backends/host/math/topk.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+#ifdef LITE_WITH_ARM
+#include <arm_neon.h>
+#endif
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
 namespace host {
 namespace math {
 
-bool comp_func(std::pair<float, int> a, std::pair<float, int> b) {
-  return (a.first > b.first);
+// the rows longer than this are split into chunks selected in parallel
+static constexpr int kChunkSize = 16384;
+
+// a is ranked before b, the larger value or the smaller index of the ties
+static bool Better(const std::pair<float, int>& a,
+                   const std::pair<float, int>& b) {
+  return a.first > b.first || (a.first == b.first && a.second < b.second);
+}
+
+// The max of the 16 values at din.
+static inline float Max16(const float* din) {
+#ifdef LITE_WITH_ARM
+  float32x4_t vmax0 = vmaxq_f32(vld1q_f32(din), vld1q_f32(din + 4));
+  float32x4_t vmax1 = vmaxq_f32(vld1q_f32(din + 8), vld1q_f32(din + 12));
+  vmax0 = vmaxq_f32(vmax0, vmax1);
+#ifdef __aarch64__
+  return vmaxvq_f32(vmax0);
+#else
+  float32x2_t vmax =
+      vpmax_f32(vget_low_f32(vmax0), vget_high_f32(vmax0));
+  vmax = vpmax_f32(vmax, vmax);
+  return vget_lane_f32(vmax, 0);
+#endif
+#else
+  float max0 = std::max(din[0], din[1]);
+  float max1 = std::max(din[2], din[3]);
+  for (int i = 4; i < 16; i += 4) {
+    max0 = std::max(max0, std::max(din[i], din[i + 1]));
+    max1 = std::max(max1, std::max(din[i + 2], din[i + 3]));
+  }
+  return std::max(max0, max1);
+#endif
+}
+
+// The k largest of the row of n into heap, best first. A min heap of the k
+// best so far is kept, and the blocks of 16 values are compared with its
+// worst value first, so the most of a long row is skipped with no pushes.
+static void TopkRow(const float* din,
+                    int n,
+                    int k,
+                    std::vector<std::pair<float, int>>* heap) {
+  heap->clear();
+  k = std::min(k, n);
+  if (k <= 0) return;
+  for (int i = 0; i < k; i++) {
+    heap->emplace_back(din[i], i);
+  }
+  std::make_heap(heap->begin(), heap->end(), Better);
+  float threshold = heap->front().first;
+  // the later values replace the worst one only if they are larger
+  auto push = [&](int i) {
+    if (din[i] > threshold) {
+      std::pop_heap(heap->begin(), heap->end(), Better);
+      heap->back() = std::make_pair(din[i], i);
+      std::push_heap(heap->begin(), heap->end(), Better);
+      threshold = heap->front().first;
+    }
+  };
+  int i = k;
+  for (; i + 15 < n; i += 16) {
+    if (Max16(din + i) > threshold) {
+      for (int j = i; j < i + 16; j++) {
+        push(j);
+      }
+    }
+  }
+  for (; i < n; i++) {
+    push(i);
+  }
+  std::sort_heap(heap->begin(), heap->end(), Better);
+}
+
+// The k largest of a long row, the chunks are selected in parallel and the
+// candidates of the chunks are selected again.
+static void TopkLongRow(const float* din,
+                        int n,
+                        int k,
+                        std::vector<std::pair<float, int>>* heap) {
+  int chunk_num = (n + kChunkSize - 1) / kChunkSize;
+  std::vector<std::vector<std::pair<float, int>>> chunk_heaps(chunk_num);
+  LITE_PARALLEL_BEGIN(c, tid, chunk_num) {
+    int begin = c * kChunkSize;
+    TopkRow(din + begin,
+            std::min(kChunkSize, n - begin),
+            k,
+            &chunk_heaps[c]);
+    for (auto& item : chunk_heaps[c]) {
+      item.second += begin;
+    }
+  }
+  LITE_PARALLEL_END();
+  // The candidates of a chunk are in the order of their ranks, and the ties
+  // among them in the order of the indices, so are the ties of all of them.
+  std::vector<float> values;
+  std::vector<int> indices;
+  for (const auto& chunk_heap : chunk_heaps) {
+    for (const auto& item : chunk_heap) {
+      values.push_back(item.first);
+      indices.push_back(item.second);
+    }
+  }
+  TopkRow(values.data(), values.size(), k, heap);
+  for (auto& item : *heap) {
+    item.second = indices[item.second];
+  }
+}
+
+// The topk of the r-th row of [outer, n, inner].
+static void TopkAxisRow(const float* din,
+                        float* out_val,
+                        int64_t* out_ind,
+                        int n,
+                        int inner,
+                        int k,
+                        int r,
+                        bool long_row) {
+  const int o = r / inner;
+  const int i = r % inner;
+  const float* row = din + o * n * inner + i;
+  std::vector<float> column;
+  if (inner > 1) {
+    column.resize(n);
+    for (int j = 0; j < n; j++) {
+      column[j] = row[j * inner];
+    }
+    row = column.data();
+  }
+  std::vector<std::pair<float, int>> heap;
+  if (long_row) {
+    TopkLongRow(row, n, k, &heap);
+  } else {
+    TopkRow(row, n, k, &heap);
+  }
+  for (int j = 0; j < k; j++) {
+    out_val[(o * k + j) * inner + i] = heap[j].first;
+    out_ind[(o * k + j) * inner + i] = heap[j].second;
+  }
 }
 
 void topk(const float* in_data,
@@ -29,20 +171,28 @@ void topk(const float* in_data,
           int m,
           int n,
           int k) {
-  for (int i = 0; i < m; i++) {
-    const float* in_tmp = in_data + i * n;
-    float* out_val_tmp = out_val + i * k;
-    int64_t* out_ind_tmp = out_ind + i * k;
-    std::vector<std::pair<float, int>> vec;
-    for (int j = 0; j < n; j++) {
-      vec.push_back(std::make_pair(in_tmp[j], j));
-    }
-    std::partial_sort(vec.begin(), vec.begin() + k, vec.end(), comp_func);
-    for (int q = 0; q < k; q++) {
-      out_val_tmp[q] = vec[q].first;
-      out_ind_tmp[q] = vec[q].second;
+  topk(in_data, out_val, out_ind, m, n, 1, k);
+}
+
+void topk(const float* din,
+          float* out_val,
+          int64_t* out_ind,
+          int outer,
+          int n,
+          int inner,
+          int k) {
+  const int rows = outer * inner;
+  // a few long rows run the chunks of each row in parallel instead
+  if (rows < 4 && n >= 2 * kChunkSize && k * 4 <= kChunkSize) {
+    for (int r = 0; r < rows; r++) {
+      TopkAxisRow(din, out_val, out_ind, n, inner, k, r, true);
     }
+    return;
+  }
+  LITE_PARALLEL_BEGIN(r, tid, rows) {
+    TopkAxisRow(din, out_val, out_ind, n, inner, k, r, false);
   }
+  LITE_PARALLEL_END();
 }
 
 }  // namespace math
@@ -13,18 +13,28 @@
 // limitations under the License.
 
 #pragma once
-#include <algorithm>
-#include <utility>
-#include <vector>
+#include <cstdint>
 
 namespace paddle {
 namespace lite {
 namespace host {
 namespace math {
 
+// The k largest values of each of the m rows of n and their indices, in
+// descending order. The ties are taken in the order of the indices.
 void topk(
     const float* din, float* out_val, int64_t* out_ind, int m, int n, int k);
 
+// topk over the middle axis of din of [outer, n, inner], the outputs are of
+// [outer, k, inner].
+void topk(const float* din,
+          float* out_val,
+          int64_t* out_ind,
+          int outer,
+          int n,
+          int inner,
+          int k);
+
 }  // namespace math
 }  // namespace host
 }  // namespace lite
@@ -0,0 +1,178 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/host/memory_pool.h"
+#include <cstdlib>
+#if defined(__linux__) || defined(__ANDROID__)
+#include <sys/mman.h>
+#endif
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace host {
+
+namespace {
+const size_t kAlignment = 64;
+// The kernels may read a little beyond the end of the data.
+const size_t kExtraSize = 64;
+const size_t kMinPooledSize = 256;
+// The larger blocks are always returned to the allocator.
+const size_t kMaxPooledSize = 256 * 1024 * 1024;
+const size_t kHugePageSize = 2 * 1024 * 1024;
+}  // namespace
+
+MemoryPool& MemoryPool::Global() {
+  // Never destroyed, since the static tensors may be freed after it.
+  static MemoryPool* x = new MemoryPool;
+  return *x;
+}
+
+MemoryPool::MemoryPool() {}
+
+size_t MemoryPool::SizeClass(size_t size) {
+  if (size <= kMinPooledSize) return kMinPooledSize;
+  size_t power = kMinPooledSize;
+  while (power * 2 < size) power <<= 1;
+  size_t step = power / 4;
+  return (size + step - 1) / step * step;
+}
+
+void* MemoryPool::Malloc(size_t size) {
+  CHECK(size);
+  if (!enabled_ || size > kMaxPooledSize) {
+    return Use(static_cast<BlockHeader*>(Allocate(size, false)) - 1);
+  }
+  size_t capacity = SizeClass(size);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = free_blocks_.find(capacity);
+    if (it != free_blocks_.end() && !it->second.empty()) {
+      auto* header = it->second.back();
+      it->second.pop_back();
+      cached_size_ -= capacity;
+      return Use(header);
+    }
+  }
+  return Use(static_cast<BlockHeader*>(Allocate(capacity, true)) - 1);
+}
+
+void* MemoryPool::Use(BlockHeader* header) {
+  auto capacity = header->capacity;
+  allocated_size_.fetch_add(capacity, std::memory_order_relaxed);
+  auto used = used_size_.fetch_add(capacity, std::memory_order_relaxed);
+  used += capacity;
+  auto peak = peak_used_size_.load(std::memory_order_relaxed);
+  while (used > peak && !peak_used_size_.compare_exchange_weak(
+                            peak, used, std::memory_order_relaxed)) {
+  }
+  return header + 1;
+}
+
+void MemoryPool::Free(void* ptr) {
+  if (!ptr) return;
+  auto* header = static_cast<BlockHeader*>(ptr) - 1;
+  used_size_.fetch_sub(header->capacity, std::memory_order_relaxed);
+  if (header->pooled && enabled_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_blocks_[header->capacity].push_back(header);
+    cached_size_ += header->capacity;
+    return;
+  }
+  Release(header);
+}
+
+void* MemoryPool::Allocate(size_t capacity, bool pooled) {
+  size_t offset = sizeof(BlockHeader) + kAlignment - 1;
+  CHECK_GT(offset + capacity, capacity);
+  size_t total_size = offset + capacity + kExtraSize;
+  CHECK_GT(total_size, offset + capacity);
+  auto* allocator = allocator_.load();
+  void* raw = nullptr;
+  if (allocator) {
+    raw = allocator->malloc_func(total_size);
+  } else {
+#if defined(MADV_HUGEPAGE)
+    if (use_huge_page_ && capacity >= kHugePageSize) {
+      if (posix_memalign(&raw, kHugePageSize, total_size) == 0) {
+        size_t huge_size = total_size / kHugePageSize * kHugePageSize;
+        madvise(raw, huge_size, MADV_HUGEPAGE);
+      } else {
+        raw = nullptr;
+      }
+    }
+#endif
+    if (!raw) raw = std::malloc(total_size);
+  }
+  CHECK(raw) << "Error occurred in MemoryPool::Malloc period: no enough for "
+                "mallocing "
+             << capacity << " bytes.";
+  auto* data = reinterpret_cast<char*>(
+      (reinterpret_cast<size_t>(raw) + offset) & (~(kAlignment - 1)));
+  auto* header = reinterpret_cast<BlockHeader*>(data) - 1;
+  header->raw = raw;
+  header->allocator = allocator;
+  header->capacity = capacity;
+  header->pooled = pooled;
+  return data;
+}
+
+void MemoryPool::Release(BlockHeader* header) {
+  if (header->allocator) {
+    header->allocator->free_func(header->raw);
+  } else {
+    std::free(header->raw);
+  }
+}
+
+void MemoryPool::set_enabled(bool enabled) {
+  enabled_ = enabled;
+  if (!enabled) Trim();
+}
+
+void MemoryPool::set_allocator(const MallocFunc& malloc_func,
+                               const FreeFunc& free_func) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (malloc_func && free_func) {
+      allocators_.push_back(Allocator{malloc_func, free_func});
+      allocator_ = &allocators_.back();
+    } else {
+      allocator_ = nullptr;
+    }
+  }
+  // The new blocks come from the new allocator.
+  Trim();
+}
+
+void MemoryPool::Trim() {
+  std::map<size_t, std::vector<BlockHeader*>> free_blocks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_blocks.swap(free_blocks_);
+    cached_size_ = 0;
+  }
+  for (auto& item : free_blocks) {
+    for (auto* header : item.second) Release(header);
+  }
+}
+
+size_t MemoryPool::cached_size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cached_size_;
+}
+
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
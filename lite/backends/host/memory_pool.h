@@ -0,0 +1,96 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>  // NOLINT
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace host {
+
+// The process-wide allocator of the host memory(kHost/kARM/kX86), which backs
+// TargetWrapper<TARGET(kHost)>::Malloc and Free. By default the memory is
+// allocated from and freed to the system directly. With the pool enabled, the
+// freed blocks are cached in the size classes(4 per power of two) and reused,
+// which avoids the malloc/free churn and the page faults when the tensors are
+// reallocated. The system memory can be replaced by the user-supplied
+// allocator, and the large blocks can be backed by the huge pages.
+class MemoryPool {
+ public:
+  using MallocFunc = std::function<void*(size_t)>;
+  using FreeFunc = std::function<void(void*)>;
+
+  static MemoryPool& Global();
+
+  // The returned memory is aligned to 64 bytes.
+  void* Malloc(size_t size);
+  void Free(void* ptr);
+
+  void set_enabled(bool enabled);
+  bool enabled() const { return enabled_; }
+  // Advise the kernel to back the blocks of 2MB or more with the huge pages,
+  // only works on Linux and Android.
+  void set_use_huge_page(bool use_huge_page) { use_huge_page_ = use_huge_page; }
+  bool use_huge_page() const { return use_huge_page_; }
+  // Set the allocator of the new blocks, or the system one if either of them
+  // is empty. The blocks always return to the allocator they come from.
+  void set_allocator(const MallocFunc& malloc_func, const FreeFunc& free_func);
+
+  // Release the cached blocks to their allocators.
+  void Trim();
+  size_t cached_size();
+  // The bytes returned by Malloc in total, and the peak of the bytes in use.
+  uint64_t allocated_size() const { return allocated_size_.load(); }
+  size_t peak_used_size() const { return peak_used_size_.load(); }
+
+ private:
+  struct Allocator {
+    MallocFunc malloc_func;
+    FreeFunc free_func;
+  };
+  // Stored right before the aligned memory.
+  struct BlockHeader {
+    void* raw;
+    Allocator* allocator;
+    size_t capacity;
+    bool pooled;
+  };
+
+  MemoryPool();
+  static size_t SizeClass(size_t size);
+  void* Allocate(size_t capacity, bool pooled);
+  void Release(BlockHeader* header);
+  void* Use(BlockHeader* header);
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<bool> use_huge_page_{false};
+  std::atomic<Allocator*> allocator_{nullptr};
+  // The allocators are never destroyed, since the blocks refer to them.
+  std::list<Allocator> allocators_;
+  std::map<size_t, std::vector<BlockHeader*>> free_blocks_;
+  size_t cached_size_{0};
+  std::mutex mutex_;
+  std::atomic<uint64_t> allocated_size_{0};
+  std::atomic<size_t> used_size_{0};
+  std::atomic<size_t> peak_used_size_{0};
+};
+
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,86 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/host/memory_pool.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdlib>
+
+namespace paddle {
+namespace lite {
+namespace host {
+
+TEST(MemoryPool, reuse) {
+  auto& pool = MemoryPool::Global();
+  pool.set_enabled(true);
+  void* a = pool.Malloc(1000);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % 64, 0u);
+  pool.Free(a);
+  EXPECT_EQ(pool.cached_size(), 1024u);
+  // The sizes of the same class share the blocks.
+  void* b = pool.Malloc(1010);
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(pool.cached_size(), 0u);
+  void* c = pool.Malloc(1100);
+  EXPECT_NE(b, c);
+  pool.Free(b);
+  pool.Free(c);
+  pool.Trim();
+  EXPECT_EQ(pool.cached_size(), 0u);
+  pool.set_enabled(false);
+}
+
+TEST(MemoryPool, allocator) {
+  static int mallocs = 0;
+  static int frees = 0;
+  auto& pool = MemoryPool::Global();
+  pool.set_enabled(true);
+  pool.set_allocator(
+      [](size_t size) {
+        mallocs++;
+        return std::malloc(size);
+      },
+      [](void* ptr) {
+        frees++;
+        std::free(ptr);
+      });
+  void* a = pool.Malloc(4096);
+  pool.Free(a);
+  EXPECT_EQ(mallocs, 1);
+  EXPECT_EQ(frees, 0);
+  // Restore the system allocator, the cached blocks are released to the
+  // allocator they come from.
+  pool.set_allocator(nullptr, nullptr);
+  EXPECT_EQ(frees, 1);
+  // The blocks are freed directly without the pool.
+  pool.set_enabled(false);
+  void* b = pool.Malloc(4096);
+  pool.Free(b);
+  EXPECT_EQ(pool.cached_size(), 0u);
+  EXPECT_EQ(mallocs, 1);
+}
+
+TEST(MemoryPool, huge_page) {
+  auto& pool = MemoryPool::Global();
+  pool.set_use_huge_page(true);
+  auto* data = static_cast<char*>(pool.Malloc(4 * 1024 * 1024));
+  data[0] = 1;
+  data[4 * 1024 * 1024 - 1] = 1;
+  pool.Free(data);
+  pool.set_use_huge_page(false);
+}
+
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
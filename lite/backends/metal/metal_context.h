@@ -15,6 +15,7 @@
 #ifndef LITE_BACKENDS_METAL_METAL_CONTEXT_H_
 #define LITE_BACKENDS_METAL_METAL_CONTEXT_H_
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -53,6 +54,15 @@ class MetalContext {
     bool use_memory_reuse() const {
         return use_memory_reuse_;
     }
+    // The textures of the tensors whose vars are never alive at the same time
+    // share a heap planned by the program, the others use their own heaps.
+    void set_reuse_heap(const std::string& tensor, const std::string& heap) {
+        reuse_heaps_[tensor] = heap;
+    }
+    std::string reuse_heap(const std::string& tensor) const {
+        auto it = reuse_heaps_.find(tensor);
+        return it == reuse_heaps_.end() ? tensor : it->second;
+    }
 
     // ptr
     void* backend() const {
@@ -63,6 +73,7 @@ class MetalContext {
     bool use_mps_{false};
     bool use_aggressive_{false};
     bool use_memory_reuse_{false};
+    std::map<std::string, std::string> reuse_heaps_;
     void* mContext = nullptr;
 };
 }  // namespace lite
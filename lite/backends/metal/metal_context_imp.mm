@@ -362,6 +362,10 @@ extern NSString* cString2NSString(std::string cStr) {
         MTLHeapDescriptor* heapDesc = [[MTLHeapDescriptor alloc] init];
         heapDesc.size = size;
         heapDesc.storageMode = MTLStorageModeShared;
+        if (@available(iOS 13.0, *)) {
+            // the aliased textures of a shared heap are written in order
+            heapDesc.hazardTrackingMode = MTLHazardTrackingModeTracked;
+        }
         return [_device newHeapWithDescriptor:heapDesc];
     }
     return nil;
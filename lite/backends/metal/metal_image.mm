@@ -187,7 +187,7 @@ void MetalImage::initImage(MetalContext* context) {
 
 void MetalImage::initImageReuse(MetalContext* context, std::string ptr) {
     if (@available(iOS 10.0, *)) {
-        initImageFromHeap(context, ptr);
+        initImageFromHeap(context, context->reuse_heap(ptr));
     } else {
         initImage(context);
     }
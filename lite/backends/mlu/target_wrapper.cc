@@ -88,6 +88,50 @@ void TargetWrapperMlu::MemcpySync(void* dst,
       LOG(FATAL) << "Unsupported IoDirection" << static_cast<int>(dir);
   }
 }
+void TargetWrapperMlu::MemcpyAsync(void* dst,
+                                   const void* src,
+                                   size_t size,
+                                   IoDirection dir,
+                                   const queue_t& queue) {
+  switch (dir) {
+    case IoDirection::HtoD:
+      CNRT_CALL(cnrtMemcpyAsync(dst,
+                                const_cast<void*>(src),
+                                size,
+                                queue,
+                                CNRT_MEM_TRANS_DIR_HOST2DEV))
+          << " cnrt memcpy async htod failed";
+      break;
+    case IoDirection::DtoH:
+      CNRT_CALL(cnrtMemcpyAsync(dst,
+                                const_cast<void*>(src),
+                                size,
+                                queue,
+                                CNRT_MEM_TRANS_DIR_DEV2HOST))
+          << " cnrt memcpy async dtoh failed";
+      break;
+    default:
+      LOG(FATAL) << "Unsupported IoDirection" << static_cast<int>(dir);
+  }
+}
+
+void TargetWrapperMlu::CreateNotifier(notifier_t* notifier) {
+  CNRT_CALL(cnrtCreateNotifier(notifier)) << " cnrt create notifier failed";
+}
+
+void TargetWrapperMlu::DestroyNotifier(notifier_t* notifier) {
+  CNRT_CALL(cnrtDestroyNotifier(notifier)) << " cnrt destroy notifier failed";
+}
+
+void TargetWrapperMlu::QueueWaitNotifier(const queue_t& queue,
+                                         const notifier_t& notifier,
+                                         const queue_t& notifier_queue) {
+  CNRT_CALL(cnrtPlaceNotifier(notifier, notifier_queue))
+      << " cnrt place notifier failed";
+  CNRT_CALL(cnrtQueueWaitNotifier(notifier, queue, 0))
+      << " cnrt queue wait notifier failed";
+}
+
 void TargetWrapperMlu::SetMLURunMode(
     lite_api::MLUCoreVersion core_version,
     int core_number,
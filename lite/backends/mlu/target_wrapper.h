@@ -28,6 +28,7 @@ template <>
 class TargetWrapper<TARGET(kMLU)> {
  public:
   using queue_t = cnrtQueue_t;
+  using notifier_t = cnrtNotifier_t;
 
   static size_t num_devices();
   static size_t maxinum_queue() { return 0; }  // TODO(zhangshijin): fix out it.
@@ -46,6 +47,18 @@ class TargetWrapper<TARGET(kMLU)> {
                          const void* src,
                          size_t size,
                          IoDirection dir);
+  static void MemcpyAsync(void* dst,
+                          const void* src,
+                          size_t size,
+                          IoDirection dir,
+                          const queue_t& queue);
+
+  static void CreateNotifier(notifier_t* notifier);
+  static void DestroyNotifier(notifier_t* notifier);
+  // The queue waits for the work placed before the notifier on another queue.
+  static void QueueWaitNotifier(const queue_t& queue,
+                                const notifier_t& notifier,
+                                const queue_t& notifier_queue);
   static void SetMLURunMode(
       lite_api::MLUCoreVersion core_version,
       int core_number,
@@ -39,6 +39,7 @@ typedef struct Argument {
   int index;
   void* memory;
   void* (*access)(void* memory, NNAdapterOperandType* type);
+  NNAdapterMemoryType memory_type;
 } Argument;
 
 typedef struct Operation {
@@ -43,6 +43,9 @@ typedef struct Device {
                          core::Argument* input_arguments,
                          uint32_t output_count,
                          core::Argument* output_arguments);
+  // Whether the arguments of NNADAPTER_DEVICE_MEMORY are accepted by
+  // execute_program
+  bool device_memory;
 } Device;
 
 }  // namespace driver
@@ -2122,7 +2122,25 @@ typedef enum {
   NNADAPTER_INTERPOLATE_MODE_NEAREST = 2,
 } NNAdapterInterpolateModeCode;
 
+/**
+ * Memory types of the execution inputs and outputs.
+ *
+ * Available since version 1.
+ */
+typedef enum {
+  /** The buffer returned by `access` is a host buffer. */
+  NNADAPTER_HOST_MEMORY = 0,
+  /**
+   * The buffer returned by `access` is allocated on the device by the user,
+   * e.g. a CUDA buffer for NVIDIA TensorRT or an ACL buffer for Huawei Ascend
+   * NPU, so the data is consumed and produced on the device without being
+   * copied through the host.
+   */
+  NNADAPTER_DEVICE_MEMORY = 1,
+} NNAdapterMemoryTypeCode;
+
 typedef int32_t NNAdapterDeviceType;
+typedef int32_t NNAdapterMemoryType;
 
 /**
  * The quantization parameters for NNADAPTER_QUANT_INT8_SYMM_PER_LAYER
@@ -2519,6 +2537,26 @@ int NNAdapterExecution_setOutput(NNAdapterExecution* execution,
                                  void* memory,
                                  void* (*access)(void* memory,
                                                  NNAdapterOperandType* type));
+/**
+ * Set the memory type of the buffer returned by the access function of the
+ * input, NNADAPTER_HOST_MEMORY by default. NNADAPTER_DEVICE_MEMORY is only
+ * accepted by the devices which support it, otherwise
+ * `NNAdapterExecution_compute` returns NNADAPTER_INVALID_PARAMETER.
+ *
+ * Available since version 1.
+ */
+int NNAdapterExecution_setInputMemoryType(NNAdapterExecution* execution,
+                                          int32_t index,
+                                          NNAdapterMemoryType type);
+/**
+ * Set the memory type of the buffer returned by the access function of the
+ * output, NNADAPTER_HOST_MEMORY by default.
+ *
+ * Available since version 1.
+ */
+int NNAdapterExecution_setOutputMemoryType(NNAdapterExecution* execution,
+                                           int32_t index,
+                                           NNAdapterMemoryType type);
 /**
  * Start to run the execution synchronously.
  *
@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include "driver/android_nnapi/engine.h"
+#include <sys/mman.h>
+#include <unistd.h>
 #include <algorithm>
+#include <cstring>
 #include <utility>
 #include "driver/android_nnapi/converter/converter.h"
 #include "driver/android_nnapi/converter/validator.h"
@@ -241,6 +244,46 @@ Context::Context(void* device, const char* properties) : device_(device) {
 
 Context::~Context() {}
 
+static bool CreateSharedMemory(size_t length, SharedMemory* shared_memory) {
+  if (!nnapi()->ASharedMemory_create) return false;
+  int fd = nnapi()->ASharedMemory_create("nnadapter", length);
+  if (fd < 0) return false;
+  void* data =
+      mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED) {
+    close(fd);
+    return false;
+  }
+  ANeuralNetworksMemory* memory = nullptr;
+  if (nnapi()->ANeuralNetworksMemory_createFromFd(
+          length, PROT_READ | PROT_WRITE, fd, 0, &memory) !=
+      ANEURALNETWORKS_NO_ERROR) {
+    munmap(data, length);
+    close(fd);
+    return false;
+  }
+  shared_memory->fd = fd;
+  shared_memory->data = data;
+  shared_memory->length = length;
+  shared_memory->memory = memory;
+  return true;
+}
+
+static void FreeSharedMemories(std::vector<SharedMemory>* shared_memories) {
+  for (auto& shared_memory : *shared_memories) {
+    if (shared_memory.memory) {
+      nnapi()->ANeuralNetworksMemory_free(shared_memory.memory);
+    }
+    if (shared_memory.data) {
+      munmap(shared_memory.data, shared_memory.length);
+    }
+    if (shared_memory.fd >= 0) {
+      close(shared_memory.fd);
+    }
+  }
+  shared_memories->clear();
+}
+
 Program::~Program() { Clear(); }
 
 void Program::Clear() {
@@ -248,6 +291,12 @@ void Program::Clear() {
     nnapi()->ANeuralNetworksExecution_free(execution_);
     execution_ = nullptr;
   }
+  if (burst_) {
+    nnapi()->ANeuralNetworksBurst_free(burst_);
+    burst_ = nullptr;
+  }
+  FreeSharedMemories(&input_memories_);
+  FreeSharedMemories(&output_memories_);
   if (compilation_) {
     nnapi()->ANeuralNetworksCompilation_free(compilation_);
     compilation_ = nullptr;
@@ -428,6 +477,22 @@ int Program::Build(core::Model* model, core::Cache* cache) {
                          << ")!";
     return NNADAPTER_DEVICE_INTERNAL_ERROR;
   }
+  // Reuse the resources of the HAL across the executions by a burst, which
+  // also caches the shared memories of the inputs and outputs, so only the
+  // data is exchanged per execution instead of the host buffers.
+  if (nnapi()->android_sdk_version >= ANEURALNETWORKS_FEATURE_LEVEL_3 &&
+      nnapi()->ANeuralNetworksBurst_create) {
+    result = nnapi()->ANeuralNetworksBurst_create(compilation_, &burst_);
+    if (result != ANEURALNETWORKS_NO_ERROR) {
+      NNADAPTER_LOG(WARNING) << "Failed to create a NNAPI Burst(" << result
+                             << "), execute without it.";
+      burst_ = nullptr;
+    }
+  }
+  if (!CreateSharedMemories()) {
+    NNADAPTER_LOG(WARNING) << "Failed to create the shared memories of the "
+                              "inputs and outputs, pass the host buffers.";
+  }
   // Release the restored core::Model
   if (model_from_cache) {
     nnadapter::ClearModel(model);
@@ -437,6 +502,28 @@ int Program::Build(core::Model* model, core::Cache* cache) {
   return NNADAPTER_NO_ERROR;
 }
 
+bool Program::CreateSharedMemories() {
+  auto create = [](const std::vector<NNAdapterOperandType>& types,
+                   std::vector<SharedMemory>* shared_memories) {
+    shared_memories->resize(types.size());
+    for (size_t i = 0; i < types.size(); i++) {
+      if (IsDynamicShapeOperandType(types[i]) ||
+          !CreateSharedMemory(GetOperandTypeBufferLength(types[i]),
+                              &shared_memories->at(i))) {
+        return false;
+      }
+    }
+    return true;
+  };
+  if (!create(input_types_, &input_memories_) ||
+      !create(output_types_, &output_memories_)) {
+    FreeSharedMemories(&input_memories_);
+    FreeSharedMemories(&output_memories_);
+    return false;
+  }
+  return true;
+}
+
 int Program::CheckInputsAndOutputs(uint32_t input_count,
                                    core::Argument* input_arguments,
                                    uint32_t output_count,
@@ -500,16 +587,35 @@ int Program::Execute(uint32_t input_count,
     auto buffer = arg.access(arg.memory, &type);
     NNADAPTER_CHECK(buffer);
     auto length = GetOperandTypeBufferLength(type);
+    auto data = buffer;
+    if (!input_memories_.empty()) {
+      NNADAPTER_CHECK_EQ(length, input_memories_[arg.index].length);
+      data = input_memories_[arg.index].data;
+    }
     if (IsUInt8AsymmPerLayerQuantType(type.precision)) {
       Symm2AsymmData(reinterpret_cast<const int8_t*>(buffer),
                      length,
                      type.asymm_per_layer_params.zero_point,
-                     reinterpret_cast<uint8_t*>(buffer));
+                     reinterpret_cast<uint8_t*>(data));
+    } else if (data != buffer) {
+      memcpy(data, buffer, length);
     }
     if (should_reset_execution) {
-      NNADAPTER_CHECK_EQ(nnapi()->ANeuralNetworksExecution_setInput(
-                             execution_, arg.index, NULL, buffer, length),
-                         ANEURALNETWORKS_NO_ERROR);
+      if (input_memories_.empty()) {
+        NNADAPTER_CHECK_EQ(nnapi()->ANeuralNetworksExecution_setInput(
+                               execution_, arg.index, NULL, buffer, length),
+                           ANEURALNETWORKS_NO_ERROR);
+      } else {
+        NNADAPTER_CHECK_EQ(
+            nnapi()->ANeuralNetworksExecution_setInputFromMemory(
+                execution_,
+                arg.index,
+                NULL,
+                input_memories_[arg.index].memory,
+                0,
+                length),
+            ANEURALNETWORKS_NO_ERROR);
+      }
     }
   }
   std::vector<std::pair<void*, size_t>> output_buffers(output_count);
@@ -527,9 +633,22 @@ int Program::Execute(uint32_t input_count,
     NNADAPTER_CHECK(buffer);
     auto length = GetOperandTypeBufferLength(*type);
     if (should_reset_execution) {
-      NNADAPTER_CHECK_EQ(nnapi()->ANeuralNetworksExecution_setOutput(
-                             execution_, arg.index, NULL, buffer, length),
-                         ANEURALNETWORKS_NO_ERROR);
+      if (output_memories_.empty()) {
+        NNADAPTER_CHECK_EQ(nnapi()->ANeuralNetworksExecution_setOutput(
+                               execution_, arg.index, NULL, buffer, length),
+                           ANEURALNETWORKS_NO_ERROR);
+      } else {
+        NNADAPTER_CHECK_EQ(length, output_memories_[arg.index].length);
+        NNADAPTER_CHECK_EQ(
+            nnapi()->ANeuralNetworksExecution_setOutputFromMemory(
+                execution_,
+                arg.index,
+                NULL,
+                output_memories_[arg.index].memory,
+                0,
+                length),
+            ANEURALNETWORKS_NO_ERROR);
+      }
     }
     output_buffers[arg.index].first = buffer;
     output_buffers[arg.index].second = length;
@@ -543,6 +662,10 @@ int Program::Execute(uint32_t input_count,
     NNADAPTER_CHECK_EQ(nnapi()->ANeuralNetworksEvent_wait(event),
                        ANEURALNETWORKS_NO_ERROR);
     nnapi()->ANeuralNetworksEvent_free(event);
+  } else if (burst_) {
+    NNADAPTER_CHECK_EQ(
+        nnapi()->ANeuralNetworksExecution_burstCompute(execution_, burst_),
+        ANEURALNETWORKS_NO_ERROR);
   } else {
     NNADAPTER_CHECK_EQ(nnapi()->ANeuralNetworksExecution_compute(execution_),
                        ANEURALNETWORKS_NO_ERROR);
@@ -552,11 +675,14 @@ int Program::Execute(uint32_t input_count,
     auto type = &output_types_[i];
     auto buffer = output_buffers[i].first;
     auto length = output_buffers[i].second;
+    auto data = output_memories_.empty() ? buffer : output_memories_[i].data;
     if (IsUInt8AsymmPerLayerQuantType(type->precision)) {
-      Asymm2SymmData(reinterpret_cast<const uint8_t*>(buffer),
+      Asymm2SymmData(reinterpret_cast<const uint8_t*>(data),
                      length,
                      type->asymm_per_layer_params.zero_point,
                      reinterpret_cast<int8_t*>(buffer));
+    } else if (data != buffer) {
+      memcpy(buffer, data, length);
     }
   }
   return NNADAPTER_NO_ERROR;
@@ -48,6 +48,16 @@ class Context {
   std::vector<ANeuralNetworksDevice*> selected_devices_;
 };
 
+// The shared memory bound to an input or output of the executions, which
+// the HAL maps once instead of receiving a copy of the host buffer in each
+// execution.
+struct SharedMemory {
+  int fd{-1};
+  void* data{nullptr};
+  size_t length{0};
+  ANeuralNetworksMemory* memory{nullptr};
+};
+
 class Program {
  public:
   explicit Program(Context* context) : context_(context) {}
@@ -66,6 +76,9 @@ class Program {
                             core::Argument* input_arguments,
                             uint32_t output_count,
                             core::Argument* output_arguments);
+  // Create the shared memories of all the inputs and outputs, or none of them
+  // if any fails or has the dynamic dimensions.
+  bool CreateSharedMemories();
 
  private:
   Context* context_{nullptr};
@@ -75,6 +88,9 @@ class Program {
   ANeuralNetworksModel* model_{nullptr};
   ANeuralNetworksCompilation* compilation_{nullptr};
   ANeuralNetworksExecution* execution_{nullptr};
+  ANeuralNetworksBurst* burst_{nullptr};
+  std::vector<SharedMemory> input_memories_;
+  std::vector<SharedMemory> output_memories_;
   std::vector<NNAdapterOperandType> input_types_;
   std::vector<NNAdapterOperandType> output_types_;
 };
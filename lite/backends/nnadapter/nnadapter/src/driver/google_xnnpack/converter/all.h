@@ -16,10 +16,23 @@
 #define __NNADAPTER_DRIVER_GOOGLE_XNNPACK_CONVERTER_ALL_H__
 
 REGISTER_CONVERTER(ADD, ValidateElementwise, ConvertElementwise)
+REGISTER_CONVERTER(AVERAGE_POOL_2D, ValidatePool2D, ConvertPool2D)
+REGISTER_CONVERTER(CONV_2D, ValidateConv2D, ConvertConv2D)
 REGISTER_CONVERTER(DIV, ValidateElementwise, ConvertElementwise)
+REGISTER_CONVERTER(FULLY_CONNECTED,
+                   ValidateFullyConnected,
+                   ConvertFullyConnected)
+REGISTER_CONVERTER(HARD_SWISH,
+                   ValidateHardSigmoidSwish,
+                   ConvertHardSigmoidSwish)
+REGISTER_CONVERTER(MAX_POOL_2D, ValidatePool2D, ConvertPool2D)
 REGISTER_CONVERTER(MUL, ValidateElementwise, ConvertElementwise)
+REGISTER_CONVERTER(RELU, ValidateUnaryActivations, ConvertUnaryActivations)
+REGISTER_CONVERTER(RELU6, ValidateUnaryActivations, ConvertUnaryActivations)
 REGISTER_CONVERTER(RESHAPE, ValidateReshape, ConvertReshape)
+REGISTER_CONVERTER(RESIZE_LINEAR, ValidateResizeLinear, ConvertResizeLinear)
 REGISTER_CONVERTER(SOFTMAX, ValidateSoftmax, ConvertSoftmax)
 REGISTER_CONVERTER(SUB, ValidateElementwise, ConvertElementwise)
+REGISTER_CONVERTER(TRANSPOSE, ValidateTranspose, ConvertTranspose)
 
 #endif  // NOLINT
@@ -0,0 +1,110 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "operation/conv2d.h"
+#include "driver/google_xnnpack/converter/converter.h"
+#include "driver/google_xnnpack/converter/validator.h"
+#include "utility/debug.h"
+#include "utility/logging.h"
+
+namespace nnadapter {
+namespace google_xnnpack {
+
+bool ValidateConv2D(Validator* validator, const core::Operation* operation) {
+  return true;
+}
+
+int ConvertConv2D(Converter* converter, core::Operation* operation) {
+  CONV_2D_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  if (auto_pad != NNADAPTER_AUTO_PAD_NONE) {
+    // NHWC
+    operation::UpdateConv2DPadAndDilation(
+        input_operand->type.dimensions.data[1],
+        filter_height,
+        auto_pad,
+        &pad_height_top,
+        &pad_height_bottom,
+        stride_height,
+        &dilation_height);
+    operation::UpdateConv2DPadAndDilation(
+        input_operand->type.dimensions.data[2],
+        filter_width,
+        auto_pad,
+        &pad_width_left,
+        &pad_width_right,
+        stride_width,
+        &dilation_width);
+  }
+
+  // Convert to XNNPACK tensor value ids and nodes
+  auto input_tensor_value_id = converter->GetMappedTensorValueId(input_operand);
+  if (input_tensor_value_id == XNN_INVALID_VALUE_ID) {
+    input_tensor_value_id = converter->ConvertOperand(input_operand);
+  }
+  auto filter_tensor_value_id = converter->ConvertOperand(filter_operand);
+  auto bias_tensor_value_id = converter->ConvertOperand(bias_operand);
+  auto output_tensor_value_id = converter->ConvertOperand(output_operand);
+  float output_min, output_max;
+  ConvertFuseCodeToXNNClippingRange(fuse_code, &output_min, &output_max);
+  if (is_depthwise_mode) {
+    // The filter is [1, filter_height, filter_width, C_out]
+    ADD_OPERATOR(xnn_define_depthwise_convolution_2d,
+                 pad_height_top,
+                 pad_width_right,
+                 pad_height_bottom,
+                 pad_width_left,
+                 filter_height,
+                 filter_width,
+                 stride_height,
+                 stride_width,
+                 dilation_height,
+                 dilation_width,
+                 output_channel_size / group,
+                 input_channel_size,
+                 output_min,
+                 output_max,
+                 input_tensor_value_id,
+                 filter_tensor_value_id,
+                 bias_tensor_value_id,
+                 output_tensor_value_id,
+                 0);
+  } else {
+    // The filter is [C_out, filter_height, filter_width, C_in / group]
+    ADD_OPERATOR(xnn_define_convolution_2d,
+                 pad_height_top,
+                 pad_width_right,
+                 pad_height_bottom,
+                 pad_width_left,
+                 filter_height,
+                 filter_width,
+                 stride_height,
+                 stride_width,
+                 dilation_height,
+                 dilation_width,
+                 group,
+                 input_channel_size / group,
+                 output_channel_size / group,
+                 output_min,
+                 output_max,
+                 input_tensor_value_id,
+                 filter_tensor_value_id,
+                 bias_tensor_value_id,
+                 output_tensor_value_id,
+                 0);
+  }
+  return NNADAPTER_NO_ERROR;
+}
+
+}  // namespace google_xnnpack
+}  // namespace nnadapter
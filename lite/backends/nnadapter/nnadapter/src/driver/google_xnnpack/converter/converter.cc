@@ -101,7 +101,8 @@ uint32_t Converter::AddTensorValue(int32_t* dimensions_data,
       // Symmetric per-channel quantization
       xnn_define_channelwise_quantized_tensor_value(
           subgraph_,
-          datatype,
+          datatype == xnn_datatype_qint8 ? xnn_datatype_qcint8
+                                         : xnn_datatype_qcint32,
           quant_scales,
           converted_dimensions.size(),
           quant_channel_dim,
@@ -291,6 +292,18 @@ uint32_t Converter::ConvertOperand(core::Operand* operand,
                                         dimensions.size(),
                                         type.symm_per_layer_params.scale);
     } break;
+    case NNADAPTER_QUANT_INT32_SYMM_PER_CHANNEL: {
+      // Only for bias
+      NNADAPTER_CHECK(is_constant);
+      tensor_value_id =
+          AddTensorValue(dimensions.data(),
+                         dimensions.size(),
+                         xnn_datatype_qint32,
+                         type.symm_per_channel_params.scales,
+                         type.symm_per_channel_params.scale_count,
+                         type.symm_per_channel_params.channel_dim,
+                         buffer);
+    } break;
     default:
       NNADAPTER_LOG(FATAL) << "Missing the processing "
                            << OperandPrecisionCodeToString(type.precision)
@@ -0,0 +1,103 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "operation/pool2d.h"
+#include "driver/google_xnnpack/converter/converter.h"
+#include "driver/google_xnnpack/converter/validator.h"
+#include "utility/debug.h"
+#include "utility/logging.h"
+
+namespace nnadapter {
+namespace google_xnnpack {
+
+bool ValidatePool2D(Validator* validator, const core::Operation* operation) {
+  POOL_2D_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  // XNNPACK always floors the output size and excludes the padding elements
+  if (ceil_mode) return false;
+  if (operation_type == NNADAPTER_AVERAGE_POOL_2D && flag &&
+      (pad_height_top || pad_height_bottom || pad_width_left ||
+       pad_width_right)) {
+    return false;
+  }
+  return true;
+}
+
+int ConvertPool2D(Converter* converter, core::Operation* operation) {
+  POOL_2D_OPERATION_EXTRACT_INPUTS_OUTPUTS
+  // NHWC
+  auto input_height = input_operand->type.dimensions.data[1];
+  auto input_width = input_operand->type.dimensions.data[2];
+  global_pooling = kernel_height == input_height && kernel_width == input_width;
+  bool has_pads = pad_height_top || pad_height_bottom || pad_width_left ||
+                  pad_width_right;
+
+  // Convert to XNNPACK tensor value ids and nodes
+  auto input_tensor_value_id = converter->GetMappedTensorValueId(input_operand);
+  if (input_tensor_value_id == XNN_INVALID_VALUE_ID) {
+    input_tensor_value_id = converter->ConvertOperand(input_operand);
+  }
+  auto output_tensor_value_id = converter->ConvertOperand(output_operand);
+  float output_min, output_max;
+  ConvertFuseCodeToXNNClippingRange(fuse_code, &output_min, &output_max);
+  if (operation_type == NNADAPTER_AVERAGE_POOL_2D) {
+    if (global_pooling && !has_pads) {
+      ADD_OPERATOR(xnn_define_global_average_pooling_2d,
+                   output_min,
+                   output_max,
+                   input_tensor_value_id,
+                   output_tensor_value_id,
+                   0);
+    } else {
+      ADD_OPERATOR(xnn_define_average_pooling_2d,
+                   pad_height_top,
+                   pad_width_right,
+                   pad_height_bottom,
+                   pad_width_left,
+                   kernel_height,
+                   kernel_width,
+                   stride_height,
+                   stride_width,
+                   output_min,
+                   output_max,
+                   input_tensor_value_id,
+                   output_tensor_value_id,
+                   0);
+    }
+  } else if (operation_type == NNADAPTER_MAX_POOL_2D) {
+    ADD_OPERATOR(xnn_define_max_pooling_2d,
+                 pad_height_top,
+                 pad_width_right,
+                 pad_height_bottom,
+                 pad_width_left,
+                 kernel_height,
+                 kernel_width,
+                 stride_height,
+                 stride_width,
+                 1,
+                 1,
+                 output_min,
+                 output_max,
+                 input_tensor_value_id,
+                 output_tensor_value_id,
+                 0);
+  } else {
+    NNADAPTER_LOG(FATAL) << "Unsupported pooling operation type "
+                         << OperationTypeToString(operation->type)
+                         << " is found.";
+  }
+  return NNADAPTER_NO_ERROR;
+}
+
+}  // namespace google_xnnpack
+}  // namespace nnadapter
@@ -14,6 +14,8 @@
 
 #include "driver/google_xnnpack/engine.h"
 #include <algorithm>
+#include <map>
+#include <mutex>  // NOLINT
 #include <utility>
 #include "driver/google_xnnpack/converter/converter.h"
 #include "driver/google_xnnpack/converter/validator.h"
@@ -40,6 +42,37 @@ Device::~Device() {
       << "Failed to deinitialize XNNPACK library!";
 }
 
+// The thread pools are shared by all of the contexts with the same number of
+// threads, avoid creating the extra worker threads for each subgraph.
+static std::mutex threadpool_mutex;
+static std::map<int, std::pair<pthreadpool_t, int>> threadpool_refs;
+
+static pthreadpool_t AcquireThreadPool(int num_threads) {
+  std::lock_guard<std::mutex> lock(threadpool_mutex);
+  auto it = threadpool_refs.find(num_threads);
+  if (it == threadpool_refs.end()) {
+    auto threadpool = pthreadpool_create(num_threads);
+    if (!threadpool) return nullptr;
+    it = threadpool_refs
+             .insert(std::make_pair(num_threads, std::make_pair(threadpool, 0)))
+             .first;
+  }
+  it->second.second++;
+  return it->second.first;
+}
+
+static void ReleaseThreadPool(pthreadpool_t threadpool) {
+  std::lock_guard<std::mutex> lock(threadpool_mutex);
+  for (auto it = threadpool_refs.begin(); it != threadpool_refs.end(); ++it) {
+    if (it->second.first != threadpool) continue;
+    if (--it->second.second == 0) {
+      pthreadpool_destroy(threadpool);
+      threadpool_refs.erase(it);
+    }
+    return;
+  }
+}
+
 Context::Context(void* device, const char* properties) : device_(device) {
   // Extract the runtime parameters from the context properties
   NNADAPTER_LOG(INFO) << "properties: " << std::string(properties);
@@ -53,7 +86,7 @@ Context::Context(void* device, const char* properties) : device_(device) {
   }
   NNADAPTER_LOG(INFO) << "num_threads: " << num_threads_;
   if (num_threads_ > 1) {
-    threadpool_ = pthreadpool_create(num_threads_);
+    threadpool_ = AcquireThreadPool(num_threads_);
     NNADAPTER_CHECK(threadpool_ != nullptr)
         << "Failed to create a thread pool for XNNPACK library!";
   }
@@ -61,7 +94,7 @@ Context::Context(void* device, const char* properties) : device_(device) {
 
 Context::~Context() {
   if (threadpool_) {
-    pthreadpool_destroy(threadpool_);
+    ReleaseThreadPool(threadpool_);
     threadpool_ = nullptr;
   }
 }
@@ -116,6 +149,7 @@ int Program::Build(core::Model* model, core::Cache* cache) {
     // Convert the data layout and the quantization parameters of the NNAdapter
     // Model
     FuseMatMulAddIntoFullyConnected(model);
+    ConvertDataLayoutNCHWToNHWC(model);
     ResolveOperationLiminations(model);
     NNADAPTER_VLOG(5) << "Optimized model:" << std::endl << Visualize(model);
   }
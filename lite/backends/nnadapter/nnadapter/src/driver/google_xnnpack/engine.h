@@ -32,7 +32,7 @@ class Device {
 class Context {
  public:
   explicit Context(void* device, const char* properties);
-  bool num_threads() { return num_threads_; }
+  int num_threads() { return num_threads_; }
   pthreadpool_t threadpool() { return threadpool_; }
   ~Context();
 
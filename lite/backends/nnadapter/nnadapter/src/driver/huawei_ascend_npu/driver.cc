@@ -118,4 +118,5 @@ NNADAPTER_EXPORT nnadapter::driver::Device NNADAPTER_AS_SYM2(DEVICE_NAME) = {
     .create_program = nnadapter::huawei_ascend_npu::CreateProgram,
     .destroy_program = nnadapter::huawei_ascend_npu::DestroyProgram,
     .execute_program = nnadapter::huawei_ascend_npu::ExecuteProgram,
+    .device_memory = true,
 };
@@ -171,6 +171,22 @@ Context::Context(void* device, const char* properties) : device_(device) {
   NNADAPTER_LOG(INFO)
       << "initial buffer length of dynamic shape range: "
       << ascend_config_params_.initial_buffer_length_of_dynamic_shape_range;
+  // HUAWEI_ASCEND_NPU_EXECUTION_STREAM_COUNT
+  std::string execution_stream_count;
+  if (key_values.count(HUAWEI_ASCEND_NPU_EXECUTION_STREAM_COUNT)) {
+    execution_stream_count =
+        key_values[HUAWEI_ASCEND_NPU_EXECUTION_STREAM_COUNT];
+  } else {
+    execution_stream_count =
+        GetStringFromEnv(HUAWEI_ASCEND_NPU_EXECUTION_STREAM_COUNT);
+  }
+  if (!execution_stream_count.empty()) {
+    ascend_config_params_.execution_stream_count =
+        std::stoi(execution_stream_count);
+  }
+  NNADAPTER_CHECK_GE(ascend_config_params_.execution_stream_count, 1);
+  NNADAPTER_LOG(INFO) << "execution stream count: "
+                      << ascend_config_params_.execution_stream_count;
 }
 
 Context::~Context() {}
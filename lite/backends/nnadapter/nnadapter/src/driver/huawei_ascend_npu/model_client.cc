@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "driver/huawei_ascend_npu/model_client.h"
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -91,6 +93,7 @@ bool AclModelClient::LoadModel(const void* data,
     NNADAPTER_LOG(WARNING) << "ACL model had been already loaded.";
     return true;
   }
+  ACL_CALL(aclrtSetCurrentContext(context_));
   ACL_CALL(aclmdlLoadFromMem(data, size, &model_id_));
   auto model_desc = aclmdlCreateDesc();
   if (!model_desc) {
@@ -106,8 +109,8 @@ bool AclModelClient::LoadModel(const void* data,
     SetDynamicShapeRangeInitialBufferLength(
         config_params->initial_buffer_length_of_dynamic_shape_range);
   }
-  NNADAPTER_CHECK(CreateModelInputDataset(is_dynamic_shape_range, -1));
-  NNADAPTER_CHECK(CreateModelOutputDataset(is_dynamic_shape_range, -1));
+  CreateExecutionSlots(config_params->execution_stream_count,
+                       is_dynamic_shape_range);
   NNADAPTER_VLOG(3) << "Load a ACL model success.";
   return true;
 }
@@ -117,12 +120,8 @@ void AclModelClient::UnloadModel() {
     NNADAPTER_LOG(WARNING) << "No ACL model is loaded.";
     return;
   }
-  if (input_dataset_) {
-    DestroyDataset(&input_dataset_);
-  }
-  if (output_dataset_) {
-    DestroyDataset(&output_dataset_);
-  }
+  ACL_CALL(aclrtSetCurrentContext(context_));
+  DestroyExecutionSlots();
   ACL_CALL(aclmdlUnload(model_id_));
   ACL_CALL(aclmdlDestroyDesc(model_desc_));
   model_desc_ = nullptr;
@@ -173,17 +172,19 @@ bool AclModelClient::GetModelIOTensorDim(
   return true;
 }
 
-bool AclModelClient::CreateModelInputDataset(bool is_dynamic_shape_range,
+bool AclModelClient::CreateModelInputDataset(AclExecutionSlot* slot,
+                                             bool is_dynamic_shape_range,
                                              int64_t buffer_length) {
   if (!model_desc_) {
     NNADAPTER_LOG(FATAL) << "No ACL model is loaded.";
     return false;
   }
-  if (input_dataset_) {
-    DestroyDataset(&input_dataset_);
+  NNADAPTER_CHECK(slot);
+  if (slot->input_dataset) {
+    DestroyDataset(&slot->input_dataset, &slot->input_host_buffers);
   }
-  input_dataset_ = aclmdlCreateDataset();
-  NNADAPTER_CHECK(input_dataset_) << "Failed to create input dataset!";
+  slot->input_dataset = aclmdlCreateDataset();
+  NNADAPTER_CHECK(slot->input_dataset) << "Failed to create input dataset!";
   auto input_count = aclmdlGetNumInputs(model_desc_);
   NNADAPTER_VLOG(3) << "input_count: " << input_count;
   for (uint32_t i = 0; i < input_count; i++) {
@@ -202,23 +203,29 @@ bool AclModelClient::CreateModelInputDataset(bool is_dynamic_shape_range,
     auto data_buffer = aclCreateDataBuffer(device_ptr, length);
     NNADAPTER_CHECK(data_buffer)
         << "Failed to call aclCreateDataBuffer to create a data buffer!";
-    ACL_CALL(aclmdlAddDatasetBuffer(input_dataset_, data_buffer));
+    ACL_CALL(aclmdlAddDatasetBuffer(slot->input_dataset, data_buffer));
+    // aclrtMemcpyAsync only accepts the host memory from aclrtMallocHost
+    void* host_ptr = nullptr;
+    ACL_CALL(aclrtMallocHost(&host_ptr, length));
+    slot->input_host_buffers.push_back(host_ptr);
   }
   NNADAPTER_VLOG(5) << "Create input dataset success.";
   return true;
 }
 
-bool AclModelClient::CreateModelOutputDataset(bool is_dynamic_shape_range,
+bool AclModelClient::CreateModelOutputDataset(AclExecutionSlot* slot,
+                                              bool is_dynamic_shape_range,
                                               int64_t buffer_length) {
   if (!model_desc_) {
     NNADAPTER_LOG(FATAL) << "No ACL model is loaded.";
     return false;
   }
-  if (output_dataset_) {
-    DestroyDataset(&output_dataset_);
+  NNADAPTER_CHECK(slot);
+  if (slot->output_dataset) {
+    DestroyDataset(&slot->output_dataset, &slot->output_host_buffers);
   }
-  output_dataset_ = aclmdlCreateDataset();
-  NNADAPTER_CHECK(output_dataset_) << "Failed to create output dataset!";
+  slot->output_dataset = aclmdlCreateDataset();
+  NNADAPTER_CHECK(slot->output_dataset) << "Failed to create output dataset!";
   auto output_count = aclmdlGetNumOutputs(model_desc_);
   NNADAPTER_VLOG(3) << "output_count: " << output_count;
   for (uint32_t i = 0; i < output_count; i++) {
@@ -237,14 +244,18 @@ bool AclModelClient::CreateModelOutputDataset(bool is_dynamic_shape_range,
     auto data_buffer = aclCreateDataBuffer(device_ptr, length);
     NNADAPTER_CHECK(data_buffer)
         << "Failed to call aclCreateDataBuffer to create a data buffer!";
-    ACL_CALL(aclmdlAddDatasetBuffer(output_dataset_, data_buffer));
+    ACL_CALL(aclmdlAddDatasetBuffer(slot->output_dataset, data_buffer));
+    void* host_ptr = nullptr;
+    ACL_CALL(aclrtMallocHost(&host_ptr, length));
+    slot->output_host_buffers.push_back(host_ptr);
   }
   NNADAPTER_VLOG(5) << "Create output dataset success.";
   return true;
 }
 
-void AclModelClient::DestroyDataset(aclmdlDataset** dataset) {
-  if (!dataset) {
+void AclModelClient::DestroyDataset(aclmdlDataset** dataset,
+                                    std::vector<void*>* host_buffers) {
+  if (!dataset || !*dataset) {
     NNADAPTER_LOG(WARNING) << "ACL dataset is not initialized!";
     return;
   }
@@ -262,9 +273,68 @@ void AclModelClient::DestroyDataset(aclmdlDataset** dataset) {
   }
   ACL_CALL(aclmdlDestroyDataset(*dataset));
   *dataset = nullptr;
+  if (host_buffers) {
+    for (auto host_ptr : *host_buffers) {
+      ACL_CALL(aclrtFreeHost(host_ptr));
+    }
+    host_buffers->clear();
+  }
   NNADAPTER_VLOG(5) << "Destroy a ACL dataset success.";
 }
 
+void AclModelClient::CreateExecutionSlots(int count,
+                                          bool is_dynamic_shape_range) {
+  NNADAPTER_CHECK_GE(count, 1);
+  std::lock_guard<std::mutex> lock(slots_mutex_);
+  for (int i = 0; i < count; i++) {
+    std::unique_ptr<AclExecutionSlot> slot(new AclExecutionSlot);
+    ACL_CALL(aclrtCreateStream(&slot->stream));
+    NNADAPTER_CHECK(
+        CreateModelInputDataset(slot.get(), is_dynamic_shape_range, -1));
+    NNADAPTER_CHECK(
+        CreateModelOutputDataset(slot.get(), is_dynamic_shape_range, -1));
+    idle_slots_.push_back(slot.get());
+    slots_.push_back(std::move(slot));
+  }
+  NNADAPTER_VLOG(5) << "Create " << count << " execution slots success.";
+}
+
+void AclModelClient::DestroyExecutionSlots() {
+  std::lock_guard<std::mutex> lock(slots_mutex_);
+  NNADAPTER_CHECK_EQ(idle_slots_.size(), slots_.size())
+      << "Some executions are still in flight!";
+  for (auto& slot : slots_) {
+    if (slot->input_dataset) {
+      DestroyDataset(&slot->input_dataset, &slot->input_host_buffers);
+    }
+    if (slot->output_dataset) {
+      DestroyDataset(&slot->output_dataset, &slot->output_host_buffers);
+    }
+    if (slot->stream) {
+      ACL_CALL(aclrtDestroyStream(slot->stream));
+      slot->stream = nullptr;
+    }
+  }
+  idle_slots_.clear();
+  slots_.clear();
+}
+
+AclExecutionSlot* AclModelClient::AcquireExecutionSlot() {
+  std::unique_lock<std::mutex> lock(slots_mutex_);
+  slots_cv_.wait(lock, [&] { return !idle_slots_.empty(); });
+  auto slot = idle_slots_.back();
+  idle_slots_.pop_back();
+  return slot;
+}
+
+void AclModelClient::ReleaseExecutionSlot(AclExecutionSlot* slot) {
+  {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    idle_slots_.push_back(slot);
+  }
+  slots_cv_.notify_one();
+}
+
 void AclModelClient::ProfilingStart() {
   if (config_) {
     aclprofStart(config_);
@@ -304,39 +374,61 @@ bool AclModelClient::Process(uint32_t input_count,
   NNADAPTER_CHECK(output_arguments);
   NNADAPTER_CHECK_EQ(input_types->size(), input_count);
   NNADAPTER_CHECK_EQ(output_types->size(), output_count);
-  NNADAPTER_CHECK(input_dataset_);
-  NNADAPTER_CHECK(output_dataset_);
+  std::unique_lock<std::mutex> dynamic_shape_lock(dynamic_shape_mutex_,
+                                                  std::defer_lock);
+  if (dynamic_shape_mode != DYNAMIC_SHAPE_MODE_NONE) {
+    dynamic_shape_lock.lock();
+  }
+  auto slot = AcquireExecutionSlot();
+  auto stream = slot->stream;
+  NNADAPTER_CHECK(slot->input_dataset);
+  NNADAPTER_CHECK(slot->output_dataset);
   if (dynamic_shape_mode == DYNAMIC_SHAPE_MODE_NONE ||
       dynamic_shape_mode == DYNAMIC_SHAPE_MODE_SHAPE_RANGE) {
-    NNADAPTER_CHECK_EQ(input_count, aclmdlGetDatasetNumBuffers(input_dataset_));
+    NNADAPTER_CHECK_EQ(input_count,
+                       aclmdlGetDatasetNumBuffers(slot->input_dataset));
   } else {
-    NNADAPTER_CHECK_LT(input_count, aclmdlGetDatasetNumBuffers(input_dataset_));
+    NNADAPTER_CHECK_LT(input_count,
+                       aclmdlGetDatasetNumBuffers(slot->input_dataset));
   }
-  NNADAPTER_CHECK_EQ(output_count, aclmdlGetDatasetNumBuffers(output_dataset_));
-  // Copy the input data from host to device
-  bool is_dynamic_dims = false;
-  std::vector<int64_t> dynamic_dims;
+  NNADAPTER_CHECK_EQ(output_count,
+                     aclmdlGetDatasetNumBuffers(slot->output_dataset));
+  std::vector<core::Argument*> args(input_count);
+  std::vector<NNAdapterOperandType> types(*input_types);
+  std::vector<void*> host_ptrs(input_count);
+  std::vector<int64_t> lengths(input_count);
+  int64_t max_length = 0;
   for (uint32_t i = 0; i < input_count; i++) {
     auto arg = FindArgumentByIndex(input_arguments, i, input_count);
     NNADAPTER_CHECK(arg) << "Input argument " << i << " does not exist!";
     NNADAPTER_CHECK(arg->memory);
     NNADAPTER_CHECK(arg->access);
-    auto type = input_types->at(i);
-    auto host_ptr = arg->access(arg->memory, &type);
-    NNADAPTER_CHECK(host_ptr);
-    auto length = GetOperandTypeBufferLength(type);
-    // Reallocate dataset memory space in dynamic_shape_range mode if the
-    // current buffer length exceeds max_length
-    if (dynamic_shape_mode == DYNAMIC_SHAPE_MODE_SHAPE_RANGE) {
-      if (length > dynamic_shape_range_initial_buffer_length_) {
-        NNADAPTER_LOG(WARNING) << "Not enough device memory for the " << i
-                               << "th input tensor, expect >= " << length
-                               << " but recevied "
-                               << dynamic_shape_range_initial_buffer_length_;
-        NNADAPTER_LOG(WARNING) << "Reallocate dataset memory space...";
-        CreateModelInputDataset(true, length);
-      }
+    host_ptrs[i] = arg->access(arg->memory, &types[i]);
+    NNADAPTER_CHECK(host_ptrs[i]);
+    args[i] = arg;
+    lengths[i] = GetOperandTypeBufferLength(types[i]);
+    max_length = std::max(max_length, lengths[i]);
+  }
+  // Reallocate dataset memory space in dynamic_shape_range mode before any
+  // copy is issued if the current buffer length exceeds max_length
+  if (dynamic_shape_mode == DYNAMIC_SHAPE_MODE_SHAPE_RANGE && input_count > 0) {
+    auto data_buffer = aclmdlGetDatasetBuffer(slot->input_dataset, 0);
+    auto data_size = static_cast<int64_t>(aclGetDataBufferSizeV2(data_buffer));
+    if (max_length > data_size) {
+      NNADAPTER_LOG(WARNING) << "Not enough device memory for the inputs, "
+                                "expect >= "
+                             << max_length << " but recevied " << data_size;
+      NNADAPTER_LOG(WARNING) << "Reallocate dataset memory space...";
+      CreateModelInputDataset(slot, true, max_length);
     }
+  }
+  // Copy the input data from host to device on the stream of the slot
+  bool is_dynamic_dims = false;
+  std::vector<int64_t> dynamic_dims;
+  for (uint32_t i = 0; i < input_count; i++) {
+    auto arg = args[i];
+    auto& type = types[i];
+    auto length = lengths[i];
     // Query and verify the input dimensions from ACL runtime
     aclmdlIODims dimensions;
     ACL_CALL(aclmdlGetInputDims(model_desc_, i, &dimensions));
@@ -361,10 +453,10 @@ bool AclModelClient::Process(uint32_t input_count,
     if (is_dynamic_shape) {
       if (dynamic_shape_mode == DYNAMIC_SHAPE_MODE_BATCH_SIZE) {
         aclmdlSetDynamicBatchSize(
-            model_id_, input_dataset_, i, type.dimensions.data[0]);
+            model_id_, slot->input_dataset, i, type.dimensions.data[0]);
       } else if (dynamic_shape_mode == DYNAMIC_SHAPE_MODE_HEIGHT_WIDTH) {
         aclmdlSetDynamicHWSize(model_id_,
-                               input_dataset_,
+                               slot->input_dataset,
                                i,
                                type.dimensions.data[2],
                                type.dimensions.data[3]);
@@ -377,7 +469,7 @@ bool AclModelClient::Process(uint32_t input_count,
         std::vector<int64_t> input_dims = ConvertACLDimsToGEDims(dimensions);
         auto input_tensor_desc = aclCreateTensorDesc(
             data_type, input_dims.size(), input_dims.data(), format);
-        aclmdlSetDatasetTensorDesc(input_dataset_, input_tensor_desc, i);
+        aclmdlSetDatasetTensorDesc(slot->input_dataset, input_tensor_desc, i);
 #else
         NNADAPTER_LOG(FATAL)
             << "The dynamic shape range feature is only supported in CANN "
@@ -390,7 +482,7 @@ bool AclModelClient::Process(uint32_t input_count,
                              << dynamic_shape_mode;
       }
     }
-    auto data_buffer = aclmdlGetDatasetBuffer(input_dataset_, i);
+    auto data_buffer = aclmdlGetDatasetBuffer(slot->input_dataset, i);
     auto data_size = aclGetDataBufferSizeV2(data_buffer);
     NNADAPTER_CHECK_LE(length, data_size)
         << "Not enough device memory for the " << i
@@ -398,8 +490,25 @@ bool AclModelClient::Process(uint32_t input_count,
         << data_size;
     auto device_ptr = aclGetDataBufferAddr(data_buffer);
     NNADAPTER_CHECK(device_ptr);
-    ACL_CALL(aclrtMemcpy(
-        device_ptr, length, host_ptr, length, ACL_MEMCPY_HOST_TO_DEVICE));
+    if (arg->memory_type == NNADAPTER_DEVICE_MEMORY) {
+      ACL_CALL(aclrtMemcpyAsync(device_ptr,
+                                data_size,
+                                host_ptrs[i],
+                                length,
+                                ACL_MEMCPY_DEVICE_TO_DEVICE,
+                                stream));
+    } else {
+      // Stage through the pinned buffer, aclrtMemcpyAsync DMAs from it
+      // directly without another copy by the runtime
+      auto host_buffer = slot->input_host_buffers[i];
+      memcpy(host_buffer, host_ptrs[i], length);
+      ACL_CALL(aclrtMemcpyAsync(device_ptr,
+                                data_size,
+                                host_buffer,
+                                length,
+                                ACL_MEMCPY_HOST_TO_DEVICE,
+                                stream));
+    }
   }
   // Set dynamic dims
   if (is_dynamic_dims) {
@@ -410,15 +519,23 @@ bool AclModelClient::Process(uint32_t input_count,
     for (size_t i = 0; i < dimensions.dimCount; i++) {
       dimensions.dims[i] = dynamic_dims[i];
     }
-    aclmdlSetInputDynamicDims(model_id_, input_dataset_, index, &dimensions);
+    aclmdlSetInputDynamicDims(
+        model_id_, slot->input_dataset, index, &dimensions);
   }
-  // Model execution
+  // Model execution, the input copies and the execution are queued on the
+  // same stream, so only one synchronization is needed
   auto start_time = GetCurrentUS();
   ProfilingStart();
-  ACL_CALL(aclmdlExecute(model_id_, input_dataset_, output_dataset_));
+  ACL_CALL(aclmdlExecuteAsync(
+      model_id_, slot->input_dataset, slot->output_dataset, stream));
+  ACL_CALL(aclrtSynchronizeStream(stream));
   ProfilingEnd();
   NNADAPTER_VLOG(3) << "Process cost " << GetCurrentUS() - start_time << " us";
   // Copy the output data from device to host
+  args.resize(output_count);
+  host_ptrs.resize(output_count);
+  lengths.resize(output_count);
+  max_length = 0;
   for (uint32_t i = 0; i < output_count; i++) {
     auto arg = FindArgumentByIndex(output_arguments, i, output_count);
     NNADAPTER_CHECK(arg) << "Output argument " << i << " does not exist!";
@@ -430,22 +547,29 @@ bool AclModelClient::Process(uint32_t input_count,
     NNADAPTER_CHECK_EQ(dimensions.dimCount, type->dimensions.count);
     ConvertACLDimsToGEDims(
         dimensions, type->dimensions.data, &type->dimensions.count);
-    auto host_ptr = arg->access(arg->memory, type);
-    NNADAPTER_CHECK(host_ptr);
-    auto length = GetOperandTypeBufferLength(*type);
-    // Reallocate dataset memory space in dynamic_shape_range mode if the
-    // current buffer length exceeds max_length
-    if (dynamic_shape_mode == DYNAMIC_SHAPE_MODE_SHAPE_RANGE) {
-      if (length > dynamic_shape_range_initial_buffer_length_) {
-        NNADAPTER_LOG(WARNING) << "Not enough device memory for the " << i
-                               << "th output tensor, expect >= " << length
-                               << " but recevied "
-                               << dynamic_shape_range_initial_buffer_length_;
-        NNADAPTER_LOG(WARNING) << "Reallocate dataset memory space...";
-        CreateModelOutputDataset(true, length);
-      }
+    host_ptrs[i] = arg->access(arg->memory, type);
+    NNADAPTER_CHECK(host_ptrs[i]);
+    args[i] = arg;
+    lengths[i] = GetOperandTypeBufferLength(*type);
+    max_length = std::max(max_length, lengths[i]);
+  }
+  // Reallocate dataset memory space in dynamic_shape_range mode if the
+  // current buffer length exceeds max_length
+  if (dynamic_shape_mode == DYNAMIC_SHAPE_MODE_SHAPE_RANGE &&
+      output_count > 0) {
+    auto data_buffer = aclmdlGetDatasetBuffer(slot->output_dataset, 0);
+    auto data_size = static_cast<int64_t>(aclGetDataBufferSizeV2(data_buffer));
+    if (max_length > data_size) {
+      NNADAPTER_LOG(WARNING) << "Not enough device memory for the outputs, "
+                                "expect >= "
+                             << max_length << " but recevied " << data_size;
+      NNADAPTER_LOG(WARNING) << "Reallocate dataset memory space...";
+      CreateModelOutputDataset(slot, true, max_length);
     }
-    auto data_buffer = aclmdlGetDatasetBuffer(output_dataset_, i);
+  }
+  for (uint32_t i = 0; i < output_count; i++) {
+    auto length = lengths[i];
+    auto data_buffer = aclmdlGetDatasetBuffer(slot->output_dataset, i);
     auto data_size = aclGetDataBufferSizeV2(data_buffer);
     NNADAPTER_CHECK_LE(length, data_size)
         << "Not enough device memory for the " << i
@@ -453,9 +577,29 @@ bool AclModelClient::Process(uint32_t input_count,
         << data_size;
     auto device_ptr = aclGetDataBufferAddr(data_buffer);
     NNADAPTER_CHECK(device_ptr);
-    ACL_CALL(aclrtMemcpy(
-        host_ptr, length, device_ptr, length, ACL_MEMCPY_DEVICE_TO_HOST));
+    if (args[i]->memory_type == NNADAPTER_DEVICE_MEMORY) {
+      ACL_CALL(aclrtMemcpyAsync(host_ptrs[i],
+                                length,
+                                device_ptr,
+                                length,
+                                ACL_MEMCPY_DEVICE_TO_DEVICE,
+                                stream));
+    } else {
+      ACL_CALL(aclrtMemcpyAsync(slot->output_host_buffers[i],
+                                data_size,
+                                device_ptr,
+                                length,
+                                ACL_MEMCPY_DEVICE_TO_HOST,
+                                stream));
+    }
+  }
+  ACL_CALL(aclrtSynchronizeStream(stream));
+  for (uint32_t i = 0; i < output_count; i++) {
+    if (args[i]->memory_type != NNADAPTER_DEVICE_MEMORY) {
+      memcpy(host_ptrs[i], slot->output_host_buffers[i], lengths[i]);
+    }
   }
+  ReleaseExecutionSlot(slot);
   NNADAPTER_VLOG(5) << "Process a ACL model success.";
   return true;
 }
@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <condition_variable>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <thread>  // NOLINT
 #include <vector>
@@ -45,8 +48,19 @@ typedef struct AscendConfigParams {
   std::string auto_tune_mode = "";
   std::string enable_dynamic_shape_range = "";
   int64_t initial_buffer_length_of_dynamic_shape_range = -1;
+  int execution_stream_count = 1;
 } AscendConfigParams;
 
+// The resources of one in-flight execution: a stream, the device datasets and
+// the pinned host buffers which the async copies are staged through.
+typedef struct AclExecutionSlot {
+  aclrtStream stream{nullptr};
+  aclmdlDataset* input_dataset{nullptr};
+  aclmdlDataset* output_dataset{nullptr};
+  std::vector<void*> input_host_buffers;
+  std::vector<void*> output_host_buffers;
+} AclExecutionSlot;
+
 class AclModelClient {
  public:
   explicit AclModelClient(int device_id, AscendConfigParams* config_params);
@@ -71,11 +85,18 @@ class AclModelClient {
   void FinalizeAclClientEnv();
   void InitAclProfilingEnv(const std::string& profiling_file_path);
   void FinalizeAclProfilingEnv();
-  bool CreateModelInputDataset(bool is_dynamic_shape_range,
+  bool CreateModelInputDataset(AclExecutionSlot* slot,
+                               bool is_dynamic_shape_range,
                                int64_t buffer_length = -1);
-  bool CreateModelOutputDataset(bool is_dynamic_shape_range,
+  bool CreateModelOutputDataset(AclExecutionSlot* slot,
+                                bool is_dynamic_shape_range,
                                 int64_t buffer_length = -1);
-  void DestroyDataset(aclmdlDataset** dataset);
+  void DestroyDataset(aclmdlDataset** dataset,
+                      std::vector<void*>* host_buffers);
+  void CreateExecutionSlots(int count, bool is_dynamic_shape_range);
+  void DestroyExecutionSlots();
+  AclExecutionSlot* AcquireExecutionSlot();
+  void ReleaseExecutionSlot(AclExecutionSlot* slot);
   void ProfilingStart();
   void ProfilingEnd();
   void SetDynamicShapeRangeInitialBufferLength(int64_t initial_buffer_length) {
@@ -87,8 +108,13 @@ class AclModelClient {
   aclrtContext context_{nullptr};
   uint32_t model_id_{0};
   aclmdlDesc* model_desc_{nullptr};
-  aclmdlDataset* input_dataset_{nullptr};
-  aclmdlDataset* output_dataset_{nullptr};
+  std::vector<std::unique_ptr<AclExecutionSlot>> slots_;
+  std::vector<AclExecutionSlot*> idle_slots_;
+  std::mutex slots_mutex_;
+  std::condition_variable slots_cv_;
+  // The current output dimensions are queried from the model description, so
+  // the executions of a dynamic shape model are serialized.
+  std::mutex dynamic_shape_mutex_;
   aclprofConfig* config_{nullptr};
   int64_t dynamic_shape_range_initial_buffer_length_{4 * 3 * 1024 * 1024};
 };
@@ -76,6 +76,12 @@ namespace huawei_ascend_npu {
 #define HUAWEI_ASCEND_NPU_INITIAL_BUFFER_LENGTH_OF_DYNAMIC_SHAPE_RANGE \
   "HUAWEI_ASCEND_NPU_INITIAL_BUFFER_LENGTH_OF_DYNAMIC_SHAPE_RANGE"
 
+// Specify the number of ACL streams used to run the model concurrently, each
+// stream owns its device datasets and pinned host buffers, such as
+// HUAWEI_ASCEND_NPU_EXECUTION_STREAM_COUNT=4
+#define HUAWEI_ASCEND_NPU_EXECUTION_STREAM_COUNT \
+  "HUAWEI_ASCEND_NPU_EXECUTION_STREAM_COUNT"
+
 #define NNADAPTER_HUAWEI_ASCEND_NPU_CANN_VERSION_GREATER_THAN(   \
     major, minor, patch)                                         \
   NNADAPTER_HUAWEI_ASCEND_NPU_CANN_MAJOR_VERSION * 1000 +        \
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "driver/intel_openvino/engine.h"
+#include <algorithm>
 #include "driver/intel_openvino/converter/converter.h"
 #include "utility/modeling.h"
 #include "utility/utility.h"
@@ -51,10 +52,47 @@ Context::Context(void* device, const char* properties) : device_(device) {
   for (auto& selected_device_name : selected_device_names_) {
     NNADAPTER_LOG(INFO) << selected_device_name;
   }
+  // INTEL_OPENVINO_PERFORMANCE_HINT
+  if (key_values.count(INTEL_OPENVINO_PERFORMANCE_HINT)) {
+    performance_hint_ = key_values[INTEL_OPENVINO_PERFORMANCE_HINT];
+  } else {
+    performance_hint_ = GetStringFromEnv(INTEL_OPENVINO_PERFORMANCE_HINT);
+  }
+  NNADAPTER_LOG(INFO) << "performance hint: " << performance_hint_;
+  // INTEL_OPENVINO_NUM_STREAMS
+  if (key_values.count(INTEL_OPENVINO_NUM_STREAMS)) {
+    num_streams_ = key_values[INTEL_OPENVINO_NUM_STREAMS];
+  } else {
+    num_streams_ = GetStringFromEnv(INTEL_OPENVINO_NUM_STREAMS);
+  }
+  NNADAPTER_LOG(INFO) << "num streams: " << num_streams_;
 }
 
 Context::~Context() {}
 
+ov::AnyMap Context::GetCompileConfig() const {
+  ov::AnyMap config;
+  if (performance_hint_ == "THROUGHPUT") {
+    config.insert(
+        ov::hint::performance_mode(ov::hint::PerformanceMode::THROUGHPUT));
+  } else if (performance_hint_ == "LATENCY") {
+    config.insert(
+        ov::hint::performance_mode(ov::hint::PerformanceMode::LATENCY));
+  } else if (!performance_hint_.empty()) {
+    NNADAPTER_LOG(WARNING) << "Unsupported performance hint "
+                           << performance_hint_ << ", ignored.";
+  }
+  if (num_streams_ == "AUTO") {
+    config.insert(ov::num_streams(ov::streams::AUTO));
+  } else if (!num_streams_.empty()) {
+    auto num_streams = string_parse<int>(num_streams_);
+    if (num_streams > 0) {
+      config.insert(ov::num_streams(num_streams));
+    }
+  }
+  return config;
+}
+
 int Program::Build(core::Model* model, core::Cache* cache) {
   NNADAPTER_LOG(INFO) << "OpenVINO runtime version - "
                       << ov::get_openvino_version();
@@ -105,7 +143,28 @@ int Program::BuildFromModel(core::Model* model) {
       result_nodes_, parameter_nodes_, "openvino_graph");
   compiled_model_ =
       std::make_shared<ov::CompiledModel>(runtime_core_->compile_model(
-          ov_model, context_->GetFirtSelectedDeviceName()));
+          ov_model,
+          context_->GetFirtSelectedDeviceName(),
+          context_->GetCompileConfig()));
+  // Create an infer request for each of the streams, so that the concurrent
+  // executions run in parallel on one compiled model
+  uint32_t infer_request_count = 1;
+  try {
+    infer_request_count =
+        compiled_model_->get_property(ov::optimal_number_of_infer_requests);
+  } catch (const std::exception& e) {
+    NNADAPTER_LOG(WARNING) << "Failed to query the optimal number of infer "
+                              "requests, use one infer request: "
+                           << e.what();
+  }
+  infer_request_count = std::max(infer_request_count, 1U);
+  NNADAPTER_VLOG(3) << "Infer request count: " << infer_request_count;
+  infer_requests_.clear();
+  idle_infer_requests_.clear();
+  for (uint32_t i = 0; i < infer_request_count; i++) {
+    infer_requests_.push_back(compiled_model_->create_infer_request());
+    idle_infer_requests_.push_back(i);
+  }
   NNADAPTER_VLOG(3) << "Build success.";
   return NNADAPTER_NO_ERROR;
 }
@@ -138,6 +197,22 @@ int Program::CheckInputsAndOutputs(uint32_t input_count,
   return NNADAPTER_NO_ERROR;
 }
 
+size_t Program::AcquireInferRequest() {
+  std::unique_lock<std::mutex> lock(infer_request_mutex_);
+  infer_request_cv_.wait(lock, [&] { return !idle_infer_requests_.empty(); });
+  auto index = idle_infer_requests_.back();
+  idle_infer_requests_.pop_back();
+  return index;
+}
+
+void Program::ReleaseInferRequest(size_t index) {
+  {
+    std::lock_guard<std::mutex> lock(infer_request_mutex_);
+    idle_infer_requests_.push_back(index);
+  }
+  infer_request_cv_.notify_one();
+}
+
 int Program::Execute(uint32_t input_count,
                      core::Argument* input_arguments,
                      uint32_t output_count,
@@ -146,8 +221,11 @@ int Program::Execute(uint32_t input_count,
       input_count, input_arguments, output_count, output_arguments);
   if (ret != NNADAPTER_NO_ERROR) return ret;
   NNADAPTER_CHECK(compiled_model_);
-  // Create infer request
-  ov::InferRequest infer_request = compiled_model_->create_infer_request();
+  NNADAPTER_CHECK(!infer_requests_.empty());
+  // Take an idle infer request, the concurrent executions are run as the
+  // parallel infer requests
+  auto infer_request_index = AcquireInferRequest();
+  auto& infer_request = infer_requests_[infer_request_index];
   // Set inputs
   for (uint32_t i = 0; i < input_count; i++) {
     auto& arg = input_arguments[i];
@@ -159,11 +237,12 @@ int Program::Execute(uint32_t input_count,
     auto buffer = arg.access(arg.memory, &type);
     NNADAPTER_CHECK(buffer);
     auto length = GetOperandTypeBufferLength(type);
-    ov::Tensor input_tensor = infer_request.get_input_tensor(i);
+    ov::Tensor input_tensor = infer_request.get_input_tensor(arg.index);
     memcpy(input_tensor.data(), buffer, length);
   }
   // Inference
-  infer_request.infer();
+  infer_request.start_async();
+  infer_request.wait();
   // Get results
   for (uint32_t i = 0; i < output_count; i++) {
     auto& arg = output_arguments[i];
@@ -174,11 +253,12 @@ int Program::Execute(uint32_t input_count,
     auto type = output_types_[arg.index];
     auto buffer = arg.access(arg.memory, &type);
     auto length = GetOperandTypeBufferLength(type);
-    ov::Tensor output_tensor = infer_request.get_output_tensor(i);
+    ov::Tensor output_tensor = infer_request.get_output_tensor(arg.index);
     auto output_size = output_tensor.get_byte_size();
     NNADAPTER_CHECK_EQ(output_size, length);
     memcpy(buffer, output_tensor.data(), output_size);
   }
+  ReleaseInferRequest(infer_request_index);
   return NNADAPTER_NO_ERROR;
 }
 
@@ -14,8 +14,10 @@
 
 #pragma once
 
+#include <condition_variable>  // NOLINT
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <vector>
 #include "driver/intel_openvino/utility.h"
@@ -36,11 +38,15 @@ class Context {
   std::string GetFirtSelectedDeviceName() const {
     return selected_device_names_[0];
   }
+  // The properties for compiling the model
+  ov::AnyMap GetCompileConfig() const;
 
  private:
   void* device_{nullptr};
   void* context_{nullptr};
   std::vector<std::string> selected_device_names_{};
+  std::string performance_hint_{""};
+  std::string num_streams_{""};
 };
 
 class Program {
@@ -63,6 +69,9 @@ class Program {
                             core::Argument* input_arguments,
                             uint32_t output_count,
                             core::Argument* output_arguments);
+  // Take an idle infer request, wait if all of them are busy
+  size_t AcquireInferRequest();
+  void ReleaseInferRequest(size_t index);
 
  private:
   Context* context_{nullptr};
@@ -73,6 +82,11 @@ class Program {
   std::vector<std::shared_ptr<default_opset::Parameter>> parameter_nodes_;
   std::vector<std::shared_ptr<Operator>> result_nodes_;
   std::shared_ptr<ov::CompiledModel> compiled_model_{nullptr};
+  // The infer requests for running the concurrent executions
+  std::vector<ov::InferRequest> infer_requests_;
+  std::vector<size_t> idle_infer_requests_;
+  std::mutex infer_request_mutex_;
+  std::condition_variable infer_request_cv_;
 };
 
 }  // namespace intel_openvino
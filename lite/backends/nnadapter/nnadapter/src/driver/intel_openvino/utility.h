@@ -31,6 +31,14 @@ namespace intel_openvino {
 // INTEL_OPENVINO_SELECT_DEVICE_NAMES=CPU,GPU or
 // INTEL_OPENVINO_SELECT_DEVICE_NAMES=CPU
 #define INTEL_OPENVINO_SELECT_DEVICE_NAMES "INTEL_OPENVINO_SELECT_DEVICE_NAMES"
+// Specify the performance hint of the compiled model, such as
+// INTEL_OPENVINO_PERFORMANCE_HINT=THROUGHPUT or
+// INTEL_OPENVINO_PERFORMANCE_HINT=LATENCY
+#define INTEL_OPENVINO_PERFORMANCE_HINT "INTEL_OPENVINO_PERFORMANCE_HINT"
+// Specify the number of the execution streams, such as
+// INTEL_OPENVINO_NUM_STREAMS=4 or INTEL_OPENVINO_NUM_STREAMS=AUTO, the
+// concurrent executions are run as the parallel infer requests on the streams
+#define INTEL_OPENVINO_NUM_STREAMS "INTEL_OPENVINO_NUM_STREAMS"
 
 // Convert NNAdapterAutoPadCode to OpenVINO ov::op::PadType
 PadType ConvertToOVPadType(const NNAdapterAutoPadCode& auto_pad_code);
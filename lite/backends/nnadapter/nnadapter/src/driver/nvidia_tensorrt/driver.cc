@@ -119,4 +119,5 @@ NNADAPTER_EXPORT nnadapter::driver::Device NNADAPTER_AS_SYM2(DEVICE_NAME) = {
     .create_program = nnadapter::nvidia_tensorrt::CreateProgram,
     .destroy_program = nnadapter::nvidia_tensorrt::DestroyProgram,
     .execute_program = nnadapter::nvidia_tensorrt::ExecuteProgram,
+    .device_memory = true,
 };
@@ -168,17 +168,19 @@ int Program::CheckInputsAndOutputs(uint32_t input_count,
 }
 
 static void SetTensor(Tensor* tensor,
-                      void* host_ptr,
-                      const NNAdapterOperandType& type) {
+                      void* ptr,
+                      const NNAdapterOperandType& type,
+                      NNAdapterMemoryType memory_type) {
   auto dims = type.dimensions;
   std::vector<int32_t> shape(dims.data, dims.data + dims.count);
   tensor->Resize(shape);
   tensor->SetDateType(ConvertToNVDataType(type.precision));
   uint32_t length =
       tensor->Length() * GetOperandPrecisionDataLength(type.precision);
-  NNADAPTER_CHECK_EQ(
-      cudaMemcpy(tensor->Data(), host_ptr, length, cudaMemcpyHostToDevice),
-      cudaSuccess);
+  auto kind = memory_type == NNADAPTER_DEVICE_MEMORY ? cudaMemcpyDeviceToDevice
+                                                     : cudaMemcpyHostToDevice;
+  NNADAPTER_CHECK_EQ(cudaMemcpy(tensor->Data(), ptr, length, kind),
+                     cudaSuccess);
 }
 
 int Program::Execute(uint32_t input_count,
@@ -194,14 +196,14 @@ int Program::Execute(uint32_t input_count,
     auto arg = FindArgumentByIndex(input_arguments, i, input_count);
     NNADAPTER_CHECK(arg) << "Input argument " << i << " does not exist!";
     auto type = input_types_.at(i);
-    auto host_ptr = arg->access(arg->memory, &type);
-    NNADAPTER_CHECK(host_ptr);
+    auto ptr = arg->access(arg->memory, &type);
+    NNADAPTER_CHECK(ptr);
     // Fill input tensor
     int index = -static_cast<int>(i) - 1;
     if (!input_tensors_.count(index)) {
       input_tensors_[index] = std::shared_ptr<Tensor>(new Tensor());
     }
-    SetTensor(input_tensors_[index].get(), host_ptr, type);
+    SetTensor(input_tensors_[index].get(), ptr, type, arg->memory_type);
   }
   // 2. Execute sub_programs_ in order
   for (size_t i = 0; i < sub_programs_.size(); i++) {
@@ -245,16 +247,23 @@ int Program::Execute(uint32_t input_count,
     NNAdapterOperandType type = output_types_.at(i);
     type.dimensions.count = dims.size();
     memcpy(type.dimensions.data, dims.data(), dims.size() * sizeof(int32_t));
-    auto host_ptr = arg->access(arg->memory, &type);
+    auto ptr = arg->access(arg->memory, &type);
     auto length = GetOperandTypeBufferLength(type);
     auto output_tensor = output_tensors_.at(index);
+    bool is_device_memory = arg->memory_type == NNADAPTER_DEVICE_MEMORY;
     if (output_tensor->Data() != nullptr) {
+      auto kind = is_device_memory ? cudaMemcpyDeviceToDevice
+                                   : cudaMemcpyDeviceToHost;
       NNADAPTER_CHECK_EQ(
-          cudaMemcpy(
-              host_ptr, output_tensor->Data(), length, cudaMemcpyDeviceToHost),
-          cudaSuccess);
+          cudaMemcpy(ptr, output_tensor->Data(), length, kind), cudaSuccess);
+    } else if (is_device_memory) {
+      NNADAPTER_CHECK_EQ(cudaMemcpy(ptr,
+                                    output_tensor->Data(false),
+                                    length,
+                                    cudaMemcpyHostToDevice),
+                         cudaSuccess);
     } else {
-      memcpy(host_ptr, output_tensor->Data(false), length);
+      memcpy(ptr, output_tensor->Data(false), length);
     }
   }
   return NNADAPTER_NO_ERROR;
@@ -104,6 +104,11 @@ Context::Context(void* device, const char* properties) : device_(device) {
       key_values.count(NVIDIA_TENSORRT_CALIBRATION_TABLE_PATH)
           ? key_values[NVIDIA_TENSORRT_CALIBRATION_TABLE_PATH]
           : GetStringFromEnv(NVIDIA_TENSORRT_CALIBRATION_TABLE_PATH);
+  // Multiple profiles
+  multiple_profiles_ =
+      key_values.count(NVIDIA_TENSORRT_MULTIPLE_PROFILES)
+          ? key_values[NVIDIA_TENSORRT_MULTIPLE_PROFILES] == "1"
+          : GetBoolFromEnv(NVIDIA_TENSORRT_MULTIPLE_PROFILES, true);
   if (precision_ == kInt8) {
     NNADAPTER_CHECK(!calibration_dataset_path_.empty() ||
                     !calibration_table_path_.empty())
@@ -149,6 +154,9 @@ void TensorrtProgram::Clear() {
   output_indices_.clear();
   input_types_.clear();
   output_types_.clear();
+  profiles_.clear();
+  profile_count_ = 1;
+  profile_index_ = 0;
 }
 
 int TensorrtProgram::Build() {
@@ -181,9 +189,12 @@ int TensorrtProgram::Build() {
   // 3. Create execution_context_
   execution_context_.reset(engine_->createExecutionContext());
   NNADAPTER_CHECK(execution_context_);
-  // 4. Prepare input/output indexes
+  // 4. Prepare input/output indexes, the bindings of the k-th profile follow
+  // the ones of the (k-1)-th profile
+  profile_count_ = engine_->getNbOptimizationProfiles();
   NNADAPTER_CHECK_EQ(static_cast<size_t>(engine_->getNbBindings()),
-                     input_count + output_count);
+                     (input_count + output_count) * profile_count_);
+  NNADAPTER_VLOG(3) << "Optimization profile count: " << profile_count_;
   for (size_t i = 0; i < input_count; i++) {
     std::string name = "input" + std::to_string(i);
     input_indices_.push_back(engine_->getBindingIndex(name.c_str()));
@@ -200,25 +211,7 @@ void TensorrtProgram::CompleteConfig() {
   NNADAPTER_CHECK(config_);
   // Set dynamic shapes
   if (with_dynamic_shape_) {
-    for (auto operand : model_->input_operands) {
-      auto type = operand->type;
-      auto& dimensions = type.dimensions;
-      if (dimensions.dynamic_count == 0) continue;
-      ConvertDynamicDimensions(&type);
-      NNADAPTER_CHECK_EQ(dimensions.dynamic_count, 3);
-      // need not to delete by user
-      auto profile = builder_->createOptimizationProfile();
-      auto name = tensors_.at(operand).back()->getName();
-      nvinfer1::Dims dims;
-      dims.nbDims = dimensions.count;
-      memcpy(dims.d, dimensions.dynamic_data[0], sizeof(int32_t) * dims.nbDims);
-      profile->setDimensions(name, nvinfer1::OptProfileSelector::kOPT, dims);
-      memcpy(dims.d, dimensions.dynamic_data[1], sizeof(int32_t) * dims.nbDims);
-      profile->setDimensions(name, nvinfer1::OptProfileSelector::kMIN, dims);
-      memcpy(dims.d, dimensions.dynamic_data[2], sizeof(int32_t) * dims.nbDims);
-      profile->setDimensions(name, nvinfer1::OptProfileSelector::kMAX, dims);
-      config_->addOptimizationProfile(profile);
-    }
+    AddOptimizationProfiles();
   }
   // Set device_type
   auto device_type = context_->DeviceType();
@@ -262,16 +255,103 @@ void TensorrtProgram::CompleteConfig() {
   }
   // Calibration
   if (precision == kInt8) {
-    NNADAPTER_CHECK(!with_dynamic_shape_)
-        << "Int8 and dynamic shape is incompatible.";
+    // The calibration only runs at the fixed shapes, so the dynamic shapes
+    // are only supported by reusing an existing calibration table
+    std::vector<uint8_t> table;
+    NNADAPTER_CHECK(!with_dynamic_shape_ ||
+                    ReadFile(context_->CalibrationTablePath(), &table))
+        << "Int8 and dynamic shape require the calibration table.";
     calibrator_.reset(new Int8EntropyCalibrator(
-        model_->input_operands.at(0)->type.dimensions.data[0],
-        context_->CalibrationDatasetPath(),
+        with_dynamic_shape_
+            ? 1
+            : model_->input_operands.at(0)->type.dimensions.data[0],
+        with_dynamic_shape_ ? "" : context_->CalibrationDatasetPath(),
         context_->CalibrationTablePath()));
     config_->setInt8Calibrator(calibrator_.get());
+    if (!profiles_.empty()) {
+      config_->setCalibrationProfile(profiles_.front());
+    }
+  }
+}
+
+void TensorrtProgram::AddOptimizationProfiles() {
+  // The k-th shapes of all of the dynamic inputs make up the k-th profile if
+  // the dynamic inputs have the same number of shapes
+  uint32_t shape_count = 0;
+  bool multiple_profiles = context_->MultipleProfiles();
+  for (auto operand : model_->input_operands) {
+    auto dynamic_count = operand->type.dimensions.dynamic_count;
+    if (dynamic_count == 0) continue;
+    if (shape_count != 0 && dynamic_count != shape_count) {
+      multiple_profiles = false;
+    }
+    shape_count = dynamic_count;
+  }
+  if (shape_count == 0) return;
+  int profile_count = multiple_profiles ? shape_count : 1;
+  for (int i = 0; i < profile_count; i++) {
+    // need not to delete by user
+    auto profile = builder_->createOptimizationProfile();
+    for (auto operand : model_->input_operands) {
+      auto type = operand->type;
+      if (type.dimensions.dynamic_count == 0) continue;
+      auto name = tensors_.at(operand).back()->getName();
+      nvinfer1::Dims dims;
+      dims.nbDims = type.dimensions.count;
+      auto size = sizeof(int32_t) * dims.nbDims;
+      // Each profile accepts the shapes from the min shape to its own shape
+      // and is tuned for its own shape
+      std::vector<int32_t> shape(type.dimensions.dynamic_data[i],
+                                 type.dimensions.dynamic_data[i] + dims.nbDims);
+      ConvertDynamicDimensions(&type);
+      auto& dynamic_data = type.dimensions.dynamic_data;
+      memcpy(dims.d, multiple_profiles ? shape.data() : dynamic_data[0], size);
+      profile->setDimensions(name, nvinfer1::OptProfileSelector::kOPT, dims);
+      memcpy(dims.d, dynamic_data[1], size);
+      profile->setDimensions(name, nvinfer1::OptProfileSelector::kMIN, dims);
+      memcpy(dims.d, multiple_profiles ? shape.data() : dynamic_data[2], size);
+      profile->setDimensions(name, nvinfer1::OptProfileSelector::kMAX, dims);
+    }
+    config_->addOptimizationProfile(profile);
+    profiles_.push_back(profile);
   }
 }
 
+int TensorrtProgram::SelectOptimizationProfile(
+    const std::vector<std::shared_ptr<Tensor>>& input_tensors) {
+  if (profile_count_ <= 1) return 0;
+  int selected_index = -1;
+  int64_t selected_volume = 0;
+  for (int i = 0; i < profile_count_; i++) {
+    bool covered = true;
+    int64_t volume = 0;
+    for (size_t j = 0; j < input_tensors.size() && covered; j++) {
+      auto shape = input_tensors.at(j)->Dims();
+      auto min_dims = engine_->getProfileDimensions(
+          input_indices_.at(j), i, nvinfer1::OptProfileSelector::kMIN);
+      auto max_dims = engine_->getProfileDimensions(
+          input_indices_.at(j), i, nvinfer1::OptProfileSelector::kMAX);
+      int64_t max_volume = 1;
+      for (size_t k = 0; k < shape.size(); k++) {
+        if (shape[k] < min_dims.d[k] || shape[k] > max_dims.d[k]) {
+          covered = false;
+          break;
+        }
+        max_volume *= max_dims.d[k];
+      }
+      volume += max_volume;
+    }
+    if (covered && (selected_index < 0 || volume < selected_volume)) {
+      selected_index = i;
+      selected_volume = volume;
+    }
+  }
+  NNADAPTER_CHECK_GE(selected_index, 0)
+      << "No optimization profile covers the input shapes!";
+  return selected_index;
+}
+}
+
 int TensorrtProgram::BuildFromModel() {
   for (auto operand : model_->input_operands) {
     if (IsOperandWithDynamicShape(operand)) {
@@ -288,7 +368,7 @@ int TensorrtProgram::BuildFromModel() {
   // 2. Build model_, serialize to plan_, create engnie_
   builder_.reset(nvinfer1::createInferBuilder(*TrtLogger::Global()));
   NNADAPTER_CHECK(builder_);
-  if (context_->Precision() == kInt8) {
+  if (context_->Precision() == kInt8 && !with_dynamic_shape_) {
     network_.reset(builder_->createNetworkV2(0U));
   } else {
     network_.reset(builder_->createNetworkV2(
@@ -336,16 +416,30 @@ int TensorrtProgram::Execute(
   for (int i = 0; i < output_size; i++) {
     SetMaxDims(output_types_.at(i), output_tensors->at(i).get());
   }
-  // Prepare input/output buffers
-  std::vector<void*> device_ptrs(input_size + output_size, nullptr);
+  // Switch to the profile covering the input shapes
+  int profile_index = SelectOptimizationProfile(*input_tensors);
+  if (profile_index != profile_index_) {
+#if TENSORRT_MAJOR_VERSION >= 8
+    NNADAPTER_CHECK(
+        execution_context_->setOptimizationProfileAsync(profile_index, 0));
+#else
+    NNADAPTER_CHECK(execution_context_->setOptimizationProfile(profile_index));
+#endif
+    profile_index_ = profile_index;
+  }
+  int binding_offset = profile_index_ * (input_size + output_size);
+  // Prepare input/output buffers, only the bindings of the selected profile
+  // are used
+  std::vector<void*> device_ptrs(engine_->getNbBindings(), nullptr);
   for (int i = 0; i < input_size; i++) {
-    device_ptrs[input_indices_[i]] = input_tensors->at(i)->Data();
+    auto ptr = input_tensors->at(i)->Data();
+    NNADAPTER_CHECK(ptr);
+    device_ptrs[input_indices_[i] + binding_offset] = ptr;
   }
   for (int i = 0; i < output_size; i++) {
-    device_ptrs[output_indices_[i]] = output_tensors->at(i)->Data();
-  }
-  for (auto ptr : device_ptrs) {
+    auto ptr = output_tensors->at(i)->Data();
     NNADAPTER_CHECK(ptr);
+    device_ptrs[output_indices_[i] + binding_offset] = ptr;
   }
   // Set input dims
   for (int i = 0; i < input_size; i++) {
@@ -353,14 +447,16 @@ int TensorrtProgram::Execute(
     nvinfer1::Dims dims;
     dims.nbDims = shape.size();
     memcpy(dims.d, shape.data(), dims.nbDims * sizeof(int32_t));
-    execution_context_->setBindingDimensions(input_indices_.at(i), dims);
+    execution_context_->setBindingDimensions(
+        input_indices_.at(i) + binding_offset, dims);
   }
   NNADAPTER_CHECK(execution_context_->allInputDimensionsSpecified());
   // Execute model
   execution_context_->execute(1, device_ptrs.data());
   // Get output dims
   for (int i = 0; i < output_size; i++) {
-    auto dims = execution_context_->getBindingDimensions(output_indices_.at(i));
+    auto dims = execution_context_->getBindingDimensions(
+        output_indices_.at(i) + binding_offset);
     std::vector<int> shape(dims.d, dims.d + dims.nbDims);
     output_tensors->at(i)->Resize(shape);
   }
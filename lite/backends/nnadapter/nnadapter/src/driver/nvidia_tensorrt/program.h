@@ -46,6 +46,7 @@ class Context {
   bool GpuFallback() { return gpu_fallback_; }
   std::string CalibrationDatasetPath() { return calibration_dataset_path_; }
   std::string CalibrationTablePath() { return calibration_table_path_; }
+  bool MultipleProfiles() { return multiple_profiles_; }
   std::vector<NNAdapterOperationCode> CudaOperations() {
     return cuda_operations_;
   }
@@ -62,6 +63,7 @@ class Context {
   bool gpu_fallback_{true};
   std::string calibration_dataset_path_;
   std::string calibration_table_path_;
+  bool multiple_profiles_{true};
   std::vector<NNAdapterOperationCode> cuda_operations_;
   std::vector<NNAdapterOperationCode> host_operations_;
 };
@@ -91,6 +93,13 @@ class TensorrtProgram : public ProgramBase {
  private:
   void Clear();
   void CompleteConfig();
+  // Add an optimization profile for each shape of the dynamic shape info, or
+  // a profile covering all of the shapes
+  void AddOptimizationProfiles();
+  // Select the profile with the smallest max shapes which covers the input
+  // shapes
+  int SelectOptimizationProfile(
+      const std::vector<std::shared_ptr<Tensor>>& input_tensors);
   // Build model and save to plan_
   int BuildFromModel();
   // Read model from cache to plan_
@@ -115,6 +124,9 @@ class TensorrtProgram : public ProgramBase {
   std::vector<NNAdapterOperandType> input_types_;
   std::vector<NNAdapterOperandType> output_types_;
   bool with_dynamic_shape_{false};
+  std::vector<nvinfer1::IOptimizationProfile*> profiles_;
+  int profile_count_{1};
+  int profile_index_{0};
 };
 
 class CudaProgram : public ProgramBase {
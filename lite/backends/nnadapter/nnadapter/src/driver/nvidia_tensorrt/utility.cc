@@ -237,8 +237,7 @@ void ConvertDynamicDimensions(NNAdapterOperandType* type) {
       }
     }
   }
-  memcpy(dynamic_data[0], min_shape.data(), sizeof(int32_t) * count);
-  memcpy(dynamic_data[1], opt_shape.data(), sizeof(int32_t) * count);
+  memcpy(dynamic_data[1], min_shape.data(), sizeof(int32_t) * count);
   memcpy(dynamic_data[2], max_shape.data(), sizeof(int32_t) * count);
   type->dimensions.dynamic_count = 3;
 }
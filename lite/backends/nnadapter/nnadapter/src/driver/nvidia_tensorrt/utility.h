@@ -58,6 +58,10 @@ namespace nvidia_tensorrt {
 #define NVIDIA_TENSORRT_HOST_OPERATIONS_LIST \
   "NVIDIA_TENSORRT_HOST_OPERATIONS_LIST"
 
+// Whether to build an optimization profile for each shape of the dynamic
+// shape info, for example: "0", "1"
+#define NVIDIA_TENSORRT_MULTIPLE_PROFILES "NVIDIA_TENSORRT_MULTIPLE_PROFILES"
+
 // Tensorrt precision mode options
 typedef enum {
   kFloat32 = 0,
@@ -170,7 +174,7 @@ void Deserialize(const void** buffer,
                  size_t* buffer_size,
                  std::vector<T>* value);
 
-// Only remain min/opt/max shapes
+// Only remain opt/min/max shapes
 void ConvertDynamicDimensions(NNAdapterOperandType* type);
 
 core::Argument* FindArgumentByIndex(core::Argument* arguments,
@@ -205,9 +205,14 @@ int Program::Execute(uint32_t input_count,
     NNADAPTER_CHECK(arg.memory);
     NNADAPTER_CHECK(arg.access);
     auto type = input_types_[arg.index];
-    auto buffer = arg.access(arg.memory, &type);
+    // The caller always provides the symmetric int8 data with the same scale
+    auto caller_type = type;
+    if (IsUInt8AsymmPerLayerQuantType(type.precision)) {
+      caller_type.precision = NNADAPTER_QUANT_INT8_SYMM_PER_LAYER;
+    }
+    auto buffer = arg.access(arg.memory, &caller_type);
     NNADAPTER_CHECK(buffer);
-    auto length = GetOperandTypeBufferLength(type);
+    auto length = GetOperandTypeBufferLength(caller_type);
     if (IsUInt8AsymmPerLayerQuantType(type.precision)) {
       Symm2AsymmData(reinterpret_cast<const int8_t*>(buffer),
                      length,
@@ -233,7 +238,12 @@ int Program::Execute(uint32_t input_count,
     // TODO(hong19860320) Get the dimensions of the outputs from tim-vx
     // according to the dynamic dimensions of the inputs, fill them to 'type'
     // and call the 'access' function to re-allocate the host output memory
-    auto buffer = arg.access(arg.memory, type);
+    // The caller always receives the symmetric int8 data with the same scale
+    auto caller_type = *type;
+    if (IsUInt8AsymmPerLayerQuantType(type->precision)) {
+      caller_type.precision = NNADAPTER_QUANT_INT8_SYMM_PER_LAYER;
+    }
+    auto buffer = arg.access(arg.memory, &caller_type);
     NNADAPTER_CHECK(buffer);
     auto length = GetOperandTypeBufferLength(*type);
     if (!output_tensors_[arg.index]->CopyDataFromTensor(buffer)) {
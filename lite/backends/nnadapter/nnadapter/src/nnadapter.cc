@@ -405,6 +405,24 @@ NNADAPTER_EXPORT int NNAdapterExecution_setOutput(
   return e->SetOutput(index, memory, access);
 }
 
+NNADAPTER_EXPORT int NNAdapterExecution_setInputMemoryType(
+    NNAdapterExecution* execution, int32_t index, NNAdapterMemoryType type) {
+  if (!execution) {
+    return NNADAPTER_INVALID_PARAMETER;
+  }
+  auto e = reinterpret_cast<nnadapter::runtime::Execution*>(execution);
+  return e->SetInputMemoryType(index, type);
+}
+
+NNADAPTER_EXPORT int NNAdapterExecution_setOutputMemoryType(
+    NNAdapterExecution* execution, int32_t index, NNAdapterMemoryType type) {
+  if (!execution) {
+    return NNADAPTER_INVALID_PARAMETER;
+  }
+  auto e = reinterpret_cast<nnadapter::runtime::Execution*>(execution);
+  return e->SetOutputMemoryType(index, type);
+}
+
 NNADAPTER_EXPORT int NNAdapterExecution_compute(NNAdapterExecution* execution) {
   if (!execution) {
     return NNADAPTER_INVALID_PARAMETER;
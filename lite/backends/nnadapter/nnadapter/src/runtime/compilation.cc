@@ -13,7 +13,13 @@
 // limitations under the License.
 
 #include "runtime/compilation.h"
+#include <dirent.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <utime.h>
+#include <algorithm>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include "optimizer/partition_model_into_submodels.h"
@@ -44,6 +50,61 @@ static const char* NNADAPTER_RUNTIME_CACHE_CACHE_OUTPUT_INDEXES_KEY =
 static const char* NNADAPTER_RUNTIME_CACHE_CACHE_MODEL_BUFFER_KEY =
     "cache_%d_model_buffer";
 
+// The max size in MB of the cache files in the cache dir, the least recently
+// used ones are removed if it's exceeded, 0 means unlimited.
+#define NNADAPTER_MODEL_CACHE_MAX_SIZE "NNADAPTER_MODEL_CACHE_MAX_SIZE"
+
+static int64_t GetCacheMaxSize(Context* context) {
+  auto key_values = GetKeyValues(context->GetProperties());
+  int64_t max_size = 0;
+  if (key_values.count(NNADAPTER_MODEL_CACHE_MAX_SIZE)) {
+    max_size =
+        string_parse<int64_t>(key_values[NNADAPTER_MODEL_CACHE_MAX_SIZE]);
+  } else {
+    max_size = GetIntFromEnv(NNADAPTER_MODEL_CACHE_MAX_SIZE, 0);
+  }
+  return max_size * 1024 * 1024;
+}
+
+// Remove the least recently used cache files in the dir other than `keep`,
+// until their total size is not larger than `max_size` bytes. The mtime of a
+// cache file is updated when it's read.
+static void LimitCacheDir(const std::string& dir,
+                          const std::string& keep,
+                          int64_t max_size) {
+  DIR* handle = opendir(dir.c_str());
+  if (!handle) return;
+  std::string extension(NNADAPTER_RUNTIME_CACHE_FILE_EXTENSION);
+  std::vector<std::tuple<time_t, int64_t, std::string>> files;
+  int64_t total_size = 0;
+  while (auto entry = readdir(handle)) {
+    std::string name(entry->d_name);
+    if (name.size() <= extension.size() ||
+        name.compare(name.size() - extension.size(),
+                     extension.size(),
+                     extension) != 0) {
+      continue;
+    }
+    std::string path = dir + "/" + name;
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) continue;
+    total_size += info.st_size;
+    if (path != keep) {
+      files.emplace_back(info.st_mtime, info.st_size, path);
+    }
+  }
+  closedir(handle);
+  std::sort(files.begin(), files.end());
+  for (auto& file : files) {
+    if (total_size <= max_size) break;
+    if (remove(std::get<2>(file).c_str()) == 0) {
+      total_size -= std::get<1>(file);
+      NNADAPTER_LOG(INFO) << "Remove the least recently used cache file "
+                          << std::get<2>(file) << ".";
+    }
+  }
+}
+
 void* AccessSubmodelInput(void* memory, NNAdapterOperandType* type) {
   NNADAPTER_CHECK(memory);
   NNADAPTER_CHECK(type);
@@ -122,6 +183,8 @@ Compilation::Compilation(Model* model,
                          std::string(NNADAPTER_RUNTIME_CACHE_FILE_EXTENSION);
       if (ReadFile(path, &buffer)) {
         NNADAPTER_LOG(INFO) << "Read the cache file " << path << " success.";
+        // Mark the cache file as recently used
+        utime(path.c_str(), nullptr);
         cache_buffer = buffer.data();
         cache_length = buffer.size();
       }
@@ -146,6 +209,7 @@ int Compilation::Execute(std::vector<core::Argument>* input_arguments,
     for (size_t i = 0; i < indexes.size(); i++) {
       core::Argument arg;
       arg.index = i;
+      arg.memory_type = NNADAPTER_HOST_MEMORY;
       auto pos = indexes[i];
       if (pos < 0) {
         pos = -pos - 1;
@@ -154,6 +218,7 @@ int Compilation::Execute(std::vector<core::Argument>* input_arguments,
           if (pos == arguments->at(j).index) {
             arg.memory = arguments->at(j).memory;
             arg.access = arguments->at(j).access;
+            arg.memory_type = arguments->at(j).memory_type;
             found = true;
             break;
           }
@@ -172,6 +237,12 @@ int Compilation::Execute(std::vector<core::Argument>* input_arguments,
       args->push_back(arg);
     }
   };
+  auto has_device_memory = [](const std::vector<core::Argument>& args) {
+    for (auto& arg : args) {
+      if (arg.memory_type != NNADAPTER_HOST_MEMORY) return true;
+    }
+    return false;
+  };
   // Executes the compiled programs on the multi-devices asynchronously or
   // synchronously
   // TODO(hong19860320) Supports asynchronously execution in future.
@@ -188,6 +259,13 @@ int Compilation::Execute(std::vector<core::Argument>* input_arguments,
                              output_arguments,
                              &buffers_,
                              AccessSubmodelOutput);
+    if (!device_context->device->SupportDeviceMemory() &&
+        (has_device_memory(input_args) || has_device_memory(output_args))) {
+      NNADAPTER_LOG(ERROR) << "The device '"
+                           << device_context->device->GetName()
+                           << "' doesn't support the device memory!";
+      return NNADAPTER_INVALID_PARAMETER;
+    }
     auto result = device_context->device->ExecuteProgram(programs_[i].program,
                                                          input_args.size(),
                                                          input_args.data(),
@@ -223,6 +301,10 @@ int Compilation::Execute(std::vector<core::Argument>* input_arguments,
           if (WriteFile(path, buffer)) {
             NNADAPTER_LOG(INFO) << "Write the cache file " << path
                                 << " success.";
+            auto max_size = GetCacheMaxSize(context_);
+            if (max_size > 0) {
+              LimitCacheDir(cache_dir_, path, max_size);
+            }
           }
         }
       }
@@ -43,6 +43,9 @@ class Device {
   int32_t GetVersion() const {
     return IsValid() ? device_->second->version : -1;
   }
+  bool SupportDeviceMemory() const {
+    return IsValid() && device_->second->device_memory;
+  }
   int CreateContext(const char* properties, void** context);
   void DestroyContext(void* context);
   int ValidateProgram(void* context,
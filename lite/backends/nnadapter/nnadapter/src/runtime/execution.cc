@@ -18,22 +18,29 @@
 namespace nnadapter {
 namespace runtime {
 
+static core::Argument* FindOrAddArgument(
+    std::vector<core::Argument>* arguments, int32_t index) {
+  for (auto& argument : *arguments) {
+    if (argument.index == index) {
+      return &argument;
+    }
+  }
+  arguments->emplace_back();
+  auto argument = &arguments->back();
+  argument->index = index;
+  argument->memory_type = NNADAPTER_HOST_MEMORY;
+  return argument;
+}
+
+static bool IsValidMemoryType(NNAdapterMemoryType type) {
+  return type == NNADAPTER_HOST_MEMORY || type == NNADAPTER_DEVICE_MEMORY;
+}
+
 int Execution::SetInput(int32_t index,
                         void* memory,
                         void* (*access)(void* memory,
                                         NNAdapterOperandType* type)) {
-  core::Argument* argument = nullptr;
-  for (auto& input_argument : input_arguments_) {
-    if (input_argument.index == index) {
-      argument = &input_argument;
-      break;
-    }
-  }
-  if (!argument) {
-    input_arguments_.emplace_back();
-    argument = &input_arguments_.back();
-    argument->index = index;
-  }
+  auto argument = FindOrAddArgument(&input_arguments_, index);
   argument->memory = memory;
   argument->access = access;
   return NNADAPTER_NO_ERROR;
@@ -43,23 +50,24 @@ int Execution::SetOutput(int32_t index,
                          void* memory,
                          void* (*access)(void* memory,
                                          NNAdapterOperandType* type)) {
-  core::Argument* argument = nullptr;
-  for (auto& output_argument : output_arguments_) {
-    if (output_argument.index == index) {
-      argument = &output_argument;
-      break;
-    }
-  }
-  if (!argument) {
-    output_arguments_.emplace_back();
-    argument = &output_arguments_.back();
-    argument->index = index;
-  }
+  auto argument = FindOrAddArgument(&output_arguments_, index);
   argument->memory = memory;
   argument->access = access;
   return NNADAPTER_NO_ERROR;
 }
 
+int Execution::SetInputMemoryType(int32_t index, NNAdapterMemoryType type) {
+  if (!IsValidMemoryType(type)) return NNADAPTER_INVALID_PARAMETER;
+  FindOrAddArgument(&input_arguments_, index)->memory_type = type;
+  return NNADAPTER_NO_ERROR;
+}
+
+int Execution::SetOutputMemoryType(int32_t index, NNAdapterMemoryType type) {
+  if (!IsValidMemoryType(type)) return NNADAPTER_INVALID_PARAMETER;
+  FindOrAddArgument(&output_arguments_, index)->memory_type = type;
+  return NNADAPTER_NO_ERROR;
+}
+
 int Execution::Compute() {
   // TODO(hong19860320) support asynchronously execution
   return compilation_->Execute(&input_arguments_, &output_arguments_);
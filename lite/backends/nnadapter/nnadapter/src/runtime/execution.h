@@ -29,6 +29,8 @@ class Execution {
   int SetOutput(int32_t index,
                 void* memory,
                 void* (*access)(void* memory, NNAdapterOperandType* type));
+  int SetInputMemoryType(int32_t index, NNAdapterMemoryType type);
+  int SetOutputMemoryType(int32_t index, NNAdapterMemoryType type);
   int Compute();
 
  private:
@@ -417,10 +417,34 @@ NNADAPTER_EXPORT bool MatchDimensions(const int32_t* target_dimensions_data,
   return true;
 }
 
+// The int8 data and the uint8 data with zero_point=128 only differ in the sign
+// bit, so the conversion between them is lossless and needs no saturation
+static void FlipSignBits(const uint8_t* input_data,
+                         size_t input_data_count,
+                         uint8_t* output_data) {
+  size_t i = 0;
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+  uint8x16_t vsign_u8x16 = vdupq_n_u8(0x80);
+  for (; i + 15 < input_data_count; i += 16) {
+    vst1q_u8(output_data + i,
+             veorq_u8(vld1q_u8(input_data + i), vsign_u8x16));
+  }
+#endif
+  for (; i < input_data_count; i++) {
+    output_data[i] = input_data[i] ^ 0x80;
+  }
+}
+
 NNADAPTER_EXPORT void Symm2AsymmData(const int8_t* input_data,
                                      size_t input_data_count,
                                      int32_t zero_point,
                                      uint8_t* output_data) {
+  if (zero_point == 128) {
+    FlipSignBits(reinterpret_cast<const uint8_t*>(input_data),
+                 input_data_count,
+                 output_data);
+    return;
+  }
   int i = 0;
   int size = input_data_count;
 #if defined(__ARM_NEON) || defined(__ARM_NEON__)
@@ -445,6 +469,11 @@ NNADAPTER_EXPORT void Asymm2SymmData(const uint8_t* input_data,
                                      size_t input_data_count,
                                      int32_t zero_point,
                                      int8_t* output_data) {
+  if (zero_point == 128) {
+    FlipSignBits(
+        input_data, input_data_count, reinterpret_cast<uint8_t*>(output_data));
+    return;
+  }
   int i = 0;
   int size = input_data_count;
 #if defined(__ARM_NEON) || defined(__ARM_NEON__)
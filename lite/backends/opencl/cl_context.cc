@@ -14,6 +14,7 @@ limitations under the License. */
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 #include "lite/api/paddle_place.h"
 #include "lite/backends/opencl/cl_runtime.h"
 #include "lite/backends/opencl/cl_utility.h"
@@ -33,11 +34,19 @@ void CLContext::AddKernel(const std::string &kernel_name,
                           const std::string &file_name,
                           const std::string &options,
                           const std::string &time_stamp) {
+  AddKernel(kernel_name, file_name, "", options, time_stamp);
+}
+
+void CLContext::AddKernel(const std::string &kernel_name,
+                          const std::string &file_name,
+                          const std::string &source,
+                          const std::string &options,
+                          const std::string &time_stamp) {
   cl_int status{CL_SUCCESS};
 #ifdef LITE_WITH_LOG
   VLOG(3) << " --- to get program " << file_name << " --- ";
 #endif
-  auto program = CLRuntime::Global()->GetProgram(file_name, options);
+  auto program = CLRuntime::Global()->GetProgram(file_name, source, options);
 #ifdef LITE_WITH_LOG
   VLOG(3) << " --- end get program --- ";
   VLOG(3) << " --- to create kernel: " << kernel_name << " --- ";
@@ -274,6 +283,24 @@ CLContext::DefaultLocalWorkSize(const cl::NDRange &gws,
   return lws_set;
 }
 
+cl::NDRange CLContext::FitLocalWorkSize(const cl::NDRange &global_work_size,
+                                        const cl::NDRange &local_work_size) {
+  if (local_work_size.dimensions() == 0 ||
+      local_work_size.dimensions() != global_work_size.dimensions()) {
+    return local_work_size;
+  }
+  std::vector<size_t> lws(3, 1);
+  for (size_t i = 0; i < local_work_size.dimensions(); i++) {
+    lws[i] = local_work_size[i];
+    while (lws[i] > 1 && global_work_size[i] % lws[i] != 0) {
+      lws[i]--;
+    }
+  }
+  if (local_work_size.dimensions() == 1) return cl::NDRange{lws[0]};
+  if (local_work_size.dimensions() == 2) return cl::NDRange{lws[0], lws[1]};
+  return cl::NDRange{lws[0], lws[1], lws[2]};
+}
+
 bool CLContext::IsArmMali() {
   return CLRuntime::Global()->GetGpuType() == GpuType::ARM_MALI;
 }
@@ -52,6 +52,14 @@ class CLContext {
                  const std::string &options = "",
                  const std::string &time_stamp = "");
 
+  // Adds the kernel of the source generated at runtime, see
+  // CLRuntime::GetProgram.
+  void AddKernel(const std::string &kernel_name,
+                 const std::string &file_name,
+                 const std::string &source,
+                 const std::string &options,
+                 const std::string &time_stamp);
+
   cl::Kernel &GetKernel(const int index);
 
   cl::Kernel &GetKernel(const std::string &name);
@@ -83,6 +91,10 @@ class CLContext {
 
   std::set<cl::NDRange, CompareByRange> GenerateLocalWorkSizes(
       cl::NDRange global_work_size, size_t max_work_size);
+  // Shrink each dim of the local work size tuned on another shape to the
+  // largest divisor of the global work size.
+  cl::NDRange FitLocalWorkSize(const cl::NDRange &global_work_size,
+                               const cl::NDRange &local_work_size);
   bool IsArmMali();
   bool IsAppleM1();
 
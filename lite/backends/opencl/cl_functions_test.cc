@@ -20,6 +20,7 @@ limitations under the License. */
 #include "lite/backends/opencl/cl_caller.h"
 #include "lite/backends/opencl/cl_context.h"
 #include "lite/backends/opencl/cl_image.h"
+#include "lite/backends/opencl/cl_image_converter.h"
 #include "lite/backends/opencl/cl_runtime.h"
 #include "lite/backends/opencl/target_wrapper.h"
 #include "lite/core/tensor.h"
@@ -280,5 +281,162 @@ TEST(cl_test, target_wrapper_image_test) {
   TargetWrapperCL::FreeImage(d_image);
 }
 
+// The images converted on the device are the same as the ones on the host.
+void TestDeviceImageConverter(CLImageConverterBase *converter,
+                              const DDim &dims) {
+  std::vector<float> nchw(dims.production());
+  for (size_t i = 0; i < nchw.size(); i++) {
+    nchw[i] = static_cast<float>(i % 1023) / 1023.f - 0.5f;
+  }
+  DDim image_dims = converter->InitImageDimInfoWith(dims);
+  size_t image_size = image_dims[0] * image_dims[1] * 4;
+  size_t elem_size = converter->fp16_support_ ? sizeof(half_t) : sizeof(float);
+  std::vector<char> host_image(image_size * elem_size);
+  converter->NCHWToImage(nchw.data(), host_image.data(), dims);
+
+  Tensor hold_image;
+  Tensor image;
+  converter->NCHWToDeviceImage(nchw.data(), dims, &hold_image, &image);
+  std::vector<char> device_image(image_size * elem_size);
+  TargetWrapperCL::ImgcpySync(device_image.data(),
+                              image.data<float, cl::Image2D>(),
+                              image_dims[0],
+                              image_dims[1],
+                              0,
+                              0,
+                              IoDirection::DtoH);
+  for (size_t i = 0; i < image_size; i++) {
+    if (converter->fp16_support_) {
+      auto *expected = reinterpret_cast<half_t *>(host_image.data());
+      auto *actual = reinterpret_cast<half_t *>(device_image.data());
+      EXPECT_NEAR(Half2Float(actual[i]), Half2Float(expected[i]), 1e-3);
+    } else {
+      auto *expected = reinterpret_cast<float *>(host_image.data());
+      auto *actual = reinterpret_cast<float *>(device_image.data());
+      EXPECT_NEAR(actual[i], expected[i], 1e-6);
+    }
+  }
+}
+
+TEST(cl_test, device_image_converter_test) {
+  CHECK(CLRuntime::Global()->IsInitSuccess());
+  // Large enough to be converted on the device.
+  const DDim dims = DDim(std::vector<DDim::value_type>{67, 129, 3, 3});
+  CLImageConverterDefault default_converter;
+  TestDeviceImageConverter(&default_converter, dims);
+  CLImageConverterFolder folder_converter;
+  TestDeviceImageConverter(&folder_converter, dims);
+  CLImageConverterNWBlock nw_converter;
+  TestDeviceImageConverter(&nw_converter, dims);
+  CLImageConverterNBlock n_converter;
+  TestDeviceImageConverter(&n_converter, dims);
+}
+
+TEST(cl_test, winograd_4x4_weight_converter_test) {
+  CHECK(CLRuntime::Global()->IsInitSuccess());
+  CLRuntime::Global()->set_precision(lite_api::CL_PRECISION_FP32);
+  const DDim dims = DDim(std::vector<DDim::value_type>{1, 1, 3, 3});
+  std::vector<float> filter(9);
+  std::default_random_engine engine;
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  for (auto& x : filter) x = dist(engine);
+
+  CLImageConverterWinoTransWeight converter(4);
+  const DDim image_dims = converter.InitImageDimInfoWith(dims);
+  EXPECT_EQ(image_dims[0], 4);
+  EXPECT_EQ(image_dims[1], 36);
+  std::vector<float> image(image_dims[0] * image_dims[1] * 4);
+  converter.NCHWToImage(filter.data(), image.data(), dims);
+
+  // U = G * g * G^T
+  const double G[6][3] = {{1. / 4, 0., 0.},
+                          {-1. / 6, -1. / 6, -1. / 6},
+                          {-1. / 6, 1. / 6, -1. / 6},
+                          {1. / 24, 1. / 12, 1. / 6},
+                          {1. / 24, -1. / 12, 1. / 6},
+                          {0., 0., 1.}};
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      double u = 0.;
+      for (int h = 0; h < 3; h++) {
+        for (int w = 0; w < 3; w++) {
+          u += G[i][h] * filter[h * 3 + w] * G[j][w];
+        }
+      }
+      // The (i * 6 + j)-th matrix of the one channel.
+      EXPECT_NEAR(image[(i * 6 + j) * 16], u, 1e-5);
+    }
+  }
+}
+
+TEST(cl_test, memory_pool_test) {
+  CLMemoryPool::set_capacity(1 << 20);
+  CLMemoryPool::set_enabled(true);
+  auto *pool = CLMemoryPool::Current();
+  ASSERT_TRUE(pool != nullptr);
+  pool->Trim();
+
+  // the freed buffer and image are reused by the same sizes only
+  void *buffer = TargetWrapperCL::Malloc(4096);
+  TargetWrapperCL::Free(buffer);
+  EXPECT_EQ(pool->cached_size(), 4096u);
+  EXPECT_EQ(TargetWrapperCL::Malloc(4096), buffer);
+  void *other = TargetWrapperCL::Malloc(8192);
+  EXPECT_NE(other, buffer);
+  TargetWrapperCL::Free(other);
+  TargetWrapperCL::Free(buffer);
+
+  void *image = TargetWrapperCL::MallocImage<float>(16, 8);
+  TargetWrapperCL::FreeImage(image);
+  EXPECT_EQ(TargetWrapperCL::MallocImage<float>(16, 8), image);
+  TargetWrapperCL::FreeImage(image);
+  void *half_image = TargetWrapperCL::MallocImage<uint16_t>(16, 8);
+  EXPECT_NE(half_image, image);
+  TargetWrapperCL::FreeImage(half_image);
+
+  // the images created from the host data are never cached
+  std::vector<float> host(16 * 8 * 4, 1.f);
+  pool->Trim();
+  void *const_image = TargetWrapperCL::MallocImage<float>(16, 8, host.data());
+  TargetWrapperCL::FreeImage(const_image);
+  EXPECT_EQ(pool->cached_size(), 0u);
+
+  // the oldest objects are released beyond the capacity
+  void *large = TargetWrapperCL::Malloc(1 << 20);
+  void *small = TargetWrapperCL::Malloc(1024);
+  TargetWrapperCL::Free(large);
+  TargetWrapperCL::Free(small);
+  EXPECT_EQ(pool->cached_size(), 1024u);
+
+  CLMemoryPool::set_enabled(false);
+  EXPECT_TRUE(CLMemoryPool::Current() == nullptr);
+}
+
+TEST(cl_test, shape_bucket_test) {
+  auto *runtime = CLRuntime::Global();
+  CHECK(runtime->IsInitSuccess());
+  EXPECT_EQ(runtime->TuneBucket(100), 100);
+  runtime->set_tune_shape_buckets(true);
+  EXPECT_EQ(runtime->TuneBucket(100), 128);
+  EXPECT_EQ(runtime->TuneBucket(128), 128);
+  EXPECT_EQ(runtime->TuneBucket(1), 1);
+  runtime->set_tune_shape_buckets(false);
+
+  // the local work size tuned on another shape of the bucket
+  CLContext context;
+  auto lws = context.FitLocalWorkSize(cl::NDRange{24, 100, 1},
+                                      cl::NDRange{16, 8, 1});
+  EXPECT_EQ(lws[0], 12u);
+  EXPECT_EQ(lws[1], 5u);
+  EXPECT_EQ(lws[2], 1u);
+  lws = context.FitLocalWorkSize(cl::NDRange{32, 128, 1},
+                                 cl::NDRange{16, 8, 1});
+  EXPECT_EQ(lws[0], 16u);
+  EXPECT_EQ(lws[1], 8u);
+  EXPECT_EQ(context.FitLocalWorkSize(cl::NDRange{32, 128, 1}, cl::NullRange)
+                .dimensions(),
+            0u);
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -13,11 +13,75 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include "lite/backends/opencl/cl_image_converter.h"
+#include <string>
 #include <vector>
+#include "lite/backends/opencl/cl_utility.h"
 #include "lite/utils/log/cp_logging.h"
 
 namespace paddle {
 namespace lite {
+
+// The tensors smaller than it are converted on the host, where the upload
+// and the kernel launch cost more than the loops.
+static const int64_t kDeviceConverterMinSize = 64 * 1024;
+
+void CLImageConverterBase::NCHWToDeviceImage(float *nchw,
+                                             const DDim &tensor_dim,
+                                             Tensor *host_image,
+                                             Tensor *image) {
+  CHECK(host_image);
+  CHECK(image);
+  DDim image_dim = InitImageDimInfoWith(tensor_dim);
+  size_t image_w = image_dim[0];
+  size_t image_h = image_dim[1];
+  std::string kernel_name = DeviceKernelName(tensor_dim);
+  if (kernel_name.empty() ||
+      tensor_dim.production() < kDeviceConverterMinSize) {
+    host_image->Resize({1, static_cast<int64_t>(image_w),
+                        static_cast<int64_t>(image_h), 4});
+    auto *image_data = MUTABLE_DATA_CPU(host_image);
+    NCHWToImage(nchw, image_data, tensor_dim);
+    MUTABLE_DATA_GPU(image, image_w, image_h, image_data);
+    return;
+  }
+
+  int new_dims[] = {1, 1, 1, 1};
+  for (size_t j = 0; j < tensor_dim.size(); ++j) {
+    new_dims[4 - tensor_dim.size() + j] = tensor_dim[j];
+  }
+  auto *runtime = CLRuntime::Global();
+  cl_int status;
+  cl::Buffer nchw_buffer(runtime->context(),
+                         CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                         tensor_dim.production() * sizeof(float),
+                         nchw,
+                         &status);
+  CL_CHECK_FATAL(status);
+  auto *image_data = MUTABLE_DATA_GPU(image, image_w, image_h, nullptr);
+  cl::Kernel kernel(runtime->GetProgram("image/weight_layout_kernel.cl", ""),
+                    kernel_name.c_str(),
+                    &status);
+  CL_CHECK_FATAL(status);
+  int arg_idx = 0;
+  status = kernel.setArg(arg_idx++, nchw_buffer);
+  CL_CHECK_FATAL(status);
+  status = kernel.setArg(arg_idx++, *image_data);
+  CL_CHECK_FATAL(status);
+  for (auto dim : new_dims) {
+    status = kernel.setArg(arg_idx++, dim);
+    CL_CHECK_FATAL(status);
+  }
+  // The buffer is released after the kernel completes.
+  status = runtime->command_queue().enqueueNDRangeKernel(
+      kernel,
+      cl::NullRange,
+      cl::NDRange{image_w, image_h},
+      cl::NullRange,
+      nullptr,
+      nullptr);
+  CL_CHECK_FATAL(status);
+  VLOG(3) << "Converted the tensor " << tensor_dim << " by " << kernel_name;
+}
 DDim CLImageConverterDefault::InitImageDimInfoWith(const DDim &tensor_dim) {
   size_t new_dims[] = {1, 1, 1, 1};
   for (size_t j = 0; j < tensor_dim.size(); ++j) {
@@ -494,9 +558,10 @@ DDim CLImageConverterWinoTransWeight::InitImageDimInfoWith(
   size_t N, C;
   N = tensor_dim[0];
   C = tensor_dim[1];
+  size_t alpha = wino_unit_ + 2;
   size_t width = ((C + 3) / 4) * 4;
   size_t height =
-      ((N + 3) / 4) * 16;  // N * (wino_blk_size + 2) * (wino_blk_size + 2)
+      ((N + 3) / 4) * alpha * alpha;  // N * (wino_unit + 2) * (wino_unit + 2)
   return DDim(
       std::vector<DDim::value_type>({static_cast<DDim::value_type>(width),
                                      static_cast<DDim::value_type>(height)}));
@@ -525,19 +590,35 @@ static void matmul(float *C, float *A, float *B, int h, int k, int w) {
 void CLImageConverterWinoTransWeight::NCHWToImage(float *tensor,
                                                   void *image,
                                                   const DDim &tensor_dim) {
-  std::vector<float> G = {
-      1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f};
-
-  std::vector<float> GT = {
-      1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, -1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f};
+  std::vector<float> G, GT;
+  if (wino_unit_ == 4) {
+    // clang-format off
+    G = {1.0f / 4,  0.0f,       0.0f,
+         -1.0f / 6, -1.0f / 6,  -1.0f / 6,
+         -1.0f / 6, 1.0f / 6,   -1.0f / 6,
+         1.0f / 24, 1.0f / 12,  1.0f / 6,
+         1.0f / 24, -1.0f / 12, 1.0f / 6,
+         0.0f,      0.0f,       1.0f};
+    // clang-format on
+  } else {
+    CHECK_EQ(wino_unit_, 2) << "Unsupported winograd unit: " << wino_unit_;
+    G = {1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f,
+         1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f};
+  }
   CHECK(tensor_dim.size() == 4) << " Tensor dim is not 4.";
   int co = tensor_dim[0];
   int ci = tensor_dim[1];
   int kernelCount = tensor_dim[2];
   int unitCi = 4;
   int unitCo = 4;
-  int alpha = 4;
-  int num_count = 16 * ((co + 3) / 4) * ((ci + 3) / 4) * 4 * 4;
+  int alpha = wino_unit_ + 2;
+  GT.resize(G.size());
+  for (int i = 0; i < alpha; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      GT[j * alpha + i] = G[i * 3 + j];
+    }
+  }
+  int num_count = alpha * alpha * ((co + 3) / 4) * ((ci + 3) / 4) * 4 * 4;
   float *image_fp32 = static_cast<float *>(image);
   half_t *image_fp16 = static_cast<half_t *>(image);
   // auto weight_dest_data = static_cast<half_t *>(image);
@@ -547,8 +628,8 @@ void CLImageConverterWinoTransWeight::NCHWToImage(float *tensor,
     memset(image_fp32, 0, num_count * sizeof(float));
   }
 
-  std::vector<float> M(12);
-  std::vector<float> K_Transform(16);
+  std::vector<float> M(alpha * 3);
+  std::vector<float> K_Transform(alpha * alpha);
   auto weightPtr = tensor;
 
   int oz_index, alpha_index;
@@ -567,13 +648,13 @@ void CLImageConverterWinoTransWeight::NCHWToImage(float *tensor,
       int my = sz % unitCi;
       auto srcSz = srcOz + kernelCount * kernelCount * sz;
 
-      matmul(M.data(), G.data(), srcSz, 4, 3, 3);
+      matmul(M.data(), G.data(), srcSz, alpha, 3, 3);
 
-      matmul(K_Transform.data(), M.data(), GT.data(), 4, 3, 4);
+      matmul(K_Transform.data(), M.data(), GT.data(), alpha, 3, alpha);
 
       auto dstSz_fp16 = dstOz_fp16 + szC4 * 16 + unitCo * my;
       auto dstSz_fp32 = dstOz_fp32 + szC4 * 16 + unitCo * my;
-      for (int i = 0; i < 16; ++i) {
+      for (int i = 0; i < alpha * alpha; ++i) {
         if (fp16_support_) {
           *(dstSz_fp16 + i * ((co + 3) / 4) * ((ci + 3) / 4) * 4 * 4) =
               Float2Half(K_Transform.data()[i]);
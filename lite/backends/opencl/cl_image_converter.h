@@ -14,6 +14,7 @@ limitations under the License. */
 
 #pragma once
 
+#include <string>
 #include "lite/api/paddle_place.h"
 #include "lite/backends/opencl/cl_half.h"
 #include "lite/backends/opencl/cl_runtime.h"
@@ -36,8 +37,24 @@ class CLImageConverterBase {
                            const DDim &tensor_dim) = 0;
   virtual DDim InitImageDimInfoWith(const DDim &tensor_dim) = 0;
 
+  // Convert `nchw` into the image `image` on the device. The large tensors
+  // are converted by the OpenCL kernel of the layout if there is one, which
+  // is much faster than the host loops, the others by NCHWToImage through
+  // the host image `host_image`.
+  void NCHWToDeviceImage(float *nchw,
+                         const DDim &tensor_dim,
+                         Tensor *host_image,
+                         Tensor *image);
+
   bool fp16_support_{paddle::lite::CLRuntime::Global()->get_precision() ==
                      lite_api::CL_PRECISION_FP16};
+
+ protected:
+  // The kernel in image/weight_layout_kernel.cl converting the tensors of
+  // `tensor_dim` to this layout, empty if there is none.
+  virtual std::string DeviceKernelName(const DDim &tensor_dim) {
+    return "";
+  }
 };
 
 class CLImageConverterDefault : public CLImageConverterBase {
@@ -48,6 +65,11 @@ class CLImageConverterDefault : public CLImageConverterBase {
                    float *tensor,
                    const DDim &image_dim,
                    const DDim &tensor_dim) override;
+
+ protected:
+  std::string DeviceKernelName(const DDim &tensor_dim) override {
+    return "nchw_to_image2d_default";
+  }
 };
 
 class CLImageConverterFolder : public CLImageConverterBase {
@@ -71,6 +93,11 @@ class CLImageConverterFolder : public CLImageConverterBase {
 
   int GetCBlock() const { return c_block_; }
 
+ protected:
+  std::string DeviceKernelName(const DDim &tensor_dim) override {
+    return tensor_dim.size() > 2 ? "nchw_to_image2d_default" : "";
+  }
+
  private:
   int c_block_;
   int width_of_one_block_;
@@ -112,6 +139,11 @@ class CLImageConverterNWBlock : public CLImageConverterBase {
                    float *tensor,
                    const DDim &image_dim,
                    const DDim &tensor_dim) override;
+
+ protected:
+  std::string DeviceKernelName(const DDim &tensor_dim) override {
+    return "nchw_to_image2d_nw";
+  }
 };
 class CLImageConverterDWBlock : public CLImageConverterBase {
  public:
@@ -123,14 +155,21 @@ class CLImageConverterDWBlock : public CLImageConverterBase {
                    const DDim &tensor_dim) override;
 };
 
+// The filter transformed for the winograd conv computing the output tiles of
+// wino_unit x wino_unit, F(2x2, 3x3) or F(4x4, 3x3).
 class CLImageConverterWinoTransWeight : public CLImageConverterBase {
  public:
+  explicit CLImageConverterWinoTransWeight(int wino_unit = 2)
+      : wino_unit_(wino_unit) {}
   DDim InitImageDimInfoWith(const DDim &tensor_dim) override;
   void NCHWToImage(float *tensor, void *image, const DDim &tensor_dim) override;
   void ImageToNCHW(void *image,
                    float *tensor,
                    const DDim &image_dim,
                    const DDim &tensor_dim) override;
+
+ private:
+  int wino_unit_{2};
 };
 
 class CLImageConverterNBlock : public CLImageConverterBase {
@@ -141,6 +180,11 @@ class CLImageConverterNBlock : public CLImageConverterBase {
                    float *tensor,
                    const DDim &image_dim,
                    const DDim &tensor_dim) override;
+
+ protected:
+  std::string DeviceKernelName(const DDim &tensor_dim) override {
+    return "nchw_to_image2d_nblock";
+  }
 };
 
 class CLImageConverterNBlockGroup : public CLImageConverterBase {
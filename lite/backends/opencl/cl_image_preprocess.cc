@@ -0,0 +1,175 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/opencl/cl_image_preprocess.h"
+#include "lite/backends/opencl/cl_half.h"
+#include "lite/backends/opencl/cl_runtime.h"
+#include "lite/backends/opencl/cl_utility.h"
+#include "lite/utils/log/cp_logging.h"
+#include "lite/utils/replace_stl/stream.h"
+
+namespace paddle {
+namespace lite {
+
+using utils::cv::ImageFormat;
+
+static size_t ImageSize(ImageFormat format, int w, int h) {
+  switch (format) {
+    case utils::cv::GRAY:
+      return w * h;
+    case utils::cv::RGB:
+    case utils::cv::BGR:
+      return w * h * 3;
+    case utils::cv::RGBA:
+    case utils::cv::BGRA:
+      return w * h * 4;
+    case utils::cv::NV12:
+    case utils::cv::NV21:
+      return w * h * 3 / 2;
+    default:
+      LOG(FATAL) << "Unsupported source image format: "
+                 << static_cast<int>(format);
+  }
+  return 0;
+}
+
+CLImagePreprocess::CLImagePreprocess(const CLImagePreprocessParam& param)
+    : param_(param), context_(new CLContext) {
+  CHECK(CLRuntime::Global()->IsInitSuccess())
+      << "Fail to initialize OpenCL runtime.";
+  CHECK(param.src_w > 0 && param.src_h > 0 && param.dst_w > 0 &&
+        param.dst_h > 0)
+      << "Invalid image size: " << param.src_w << "x" << param.src_h << " -> "
+      << param.dst_w << "x" << param.dst_h;
+  src_size_ = ImageSize(param.src_format, param.src_w, param.src_h);
+
+  STL::stringstream options;
+  options << "-DSRC_FORMAT=" << static_cast<int>(param.src_format);
+  switch (param.dst_format) {
+    case utils::cv::GRAY:
+      options << " -DDST_GRAY";
+      break;
+    case utils::cv::BGR:
+      options << " -DDST_BGR";
+      break;
+    case utils::cv::RGB:
+      break;
+    default:
+      LOG(FATAL) << "Unsupported destination image format: "
+                 << static_cast<int>(param.dst_format);
+  }
+  const std::string file = "image/image_preprocess_kernel.cl";
+  context_->AddKernel("image_preprocess_buffer", file, options.str());
+  buffer_kernel_key_ = "image_preprocess_buffer" + options.str();
+  if (param.src_format == utils::cv::RGBA ||
+      param.src_format == utils::cv::BGRA) {
+    context_->AddKernel("image_preprocess_image", file, options.str());
+    image_kernel_key_ = "image_preprocess_image" + options.str();
+  }
+}
+
+cl::Image2D* CLImagePreprocess::PrepareOutput(Tensor* dst) {
+  const int channel = param_.dst_format == utils::cv::GRAY ? 1 : 3;
+  dst->Resize({1, channel, param_.dst_h, param_.dst_w});
+  return MUTABLE_DATA_GPU(dst, param_.dst_w, param_.dst_h, nullptr);
+}
+
+void CLImagePreprocess::Enqueue(const cl::Kernel& kernel) {
+  auto global_work_size =
+      cl::NDRange{static_cast<cl::size_type>(param_.dst_w),
+                  static_cast<cl::size_type>(param_.dst_h)};
+  cl_int status = context_->RunKernel(kernel, global_work_size, cl::NullRange);
+  CL_CHECK_FATAL(status);
+}
+
+static void SetNormalizeArgs(const CLImagePreprocessParam& param,
+                             cl::Kernel* kernel,
+                             int arg_idx) {
+  const float scale_x = static_cast<float>(param.src_w) / param.dst_w;
+  const float scale_y = static_cast<float>(param.src_h) / param.dst_h;
+  cl_float4 means;
+  cl_float4 scales;
+  for (int i = 0; i < 3; i++) {
+    means.s[i] = param.means[i];
+    scales.s[i] = param.scales[i];
+  }
+  means.s[3] = 0.f;
+  scales.s[3] = 1.f;
+  cl_int status = kernel->setArg(arg_idx++, scale_x);
+  CL_CHECK_FATAL(status);
+  status = kernel->setArg(arg_idx++, scale_y);
+  CL_CHECK_FATAL(status);
+  status = kernel->setArg(arg_idx++, means);
+  CL_CHECK_FATAL(status);
+  status = kernel->setArg(arg_idx++, scales);
+  CL_CHECK_FATAL(status);
+}
+
+void CLImagePreprocess::Run(const cl::Buffer& src, Tensor* dst) {
+  auto* out_image = PrepareOutput(dst);
+  auto& kernel = context_->GetKernel(buffer_kernel_key_);
+  int arg_idx = 0;
+  cl_int status = kernel.setArg(arg_idx++, src);
+  CL_CHECK_FATAL(status);
+  status = kernel.setArg(arg_idx++, *out_image);
+  CL_CHECK_FATAL(status);
+  status = kernel.setArg(arg_idx++, param_.src_w);
+  CL_CHECK_FATAL(status);
+  status = kernel.setArg(arg_idx++, param_.src_h);
+  CL_CHECK_FATAL(status);
+  status = kernel.setArg(arg_idx++, param_.dst_w);
+  CL_CHECK_FATAL(status);
+  status = kernel.setArg(arg_idx++, param_.dst_h);
+  CL_CHECK_FATAL(status);
+  SetNormalizeArgs(param_, &kernel, arg_idx);
+  Enqueue(kernel);
+}
+
+void CLImagePreprocess::Run(const uint8_t* src, Tensor* dst) {
+  if (upload_buffer_ == nullptr) {
+    cl_int status;
+    upload_buffer_.reset(new cl::Buffer(context_->GetContext(),
+                                        CL_MEM_READ_ONLY,
+                                        src_size_,
+                                        nullptr,
+                                        &status));
+    CL_CHECK_FATAL(status);
+  }
+  cl_int status = context_->GetCommandQueue().enqueueWriteBuffer(
+      *upload_buffer_, CL_FALSE, 0, src_size_, src, nullptr, nullptr);
+  CL_CHECK_FATAL(status);
+  Run(*upload_buffer_, dst);
+}
+
+void CLImagePreprocess::Run(const cl::Image2D& src, Tensor* dst) {
+  CHECK(!image_kernel_key_.empty())
+      << "Only RGBA or BGRA source images are supported, but got "
+      << static_cast<int>(param_.src_format);
+  auto* out_image = PrepareOutput(dst);
+  auto& kernel = context_->GetKernel(image_kernel_key_);
+  int arg_idx = 0;
+  cl_int status = kernel.setArg(arg_idx++, src);
+  CL_CHECK_FATAL(status);
+  status = kernel.setArg(arg_idx++, *out_image);
+  CL_CHECK_FATAL(status);
+  status = kernel.setArg(arg_idx++, param_.dst_w);
+  CL_CHECK_FATAL(status);
+  status = kernel.setArg(arg_idx++, param_.dst_h);
+  CL_CHECK_FATAL(status);
+  SetNormalizeArgs(param_, &kernel, arg_idx);
+  Enqueue(kernel);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,73 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include "lite/backends/opencl/cl_context.h"
+#include "lite/backends/opencl/cl_include.h"
+#include "lite/core/tensor.h"
+#include "lite/utils/cv/paddle_image_preprocess.h"
+
+namespace paddle {
+namespace lite {
+
+struct CLImagePreprocessParam {
+  // GRAY, RGB, BGR, RGBA, BGRA, NV12 or NV21
+  utils::cv::ImageFormat src_format{utils::cv::RGBA};
+  // GRAY, RGB or BGR
+  utils::cv::ImageFormat dst_format{utils::cv::RGB};
+  int src_w{0};
+  int src_h{0};
+  int dst_w{0};
+  int dst_h{0};
+  // in the channel order of dst_format: out = (pixel - mean) * scale
+  float means[3]{0.f, 0.f, 0.f};
+  float scales[3]{1.f, 1.f, 1.f};
+};
+
+// Resize (bilinear), color conversion and normalization of an 8-bit image
+// on the GPU, in one kernel. The result is written into the
+// cl::Image2D(ImageDefault) of the tensor {1, C, dst_h, dst_w}, the layout
+// of the input of the OpenCL image kernels, so the image does not go
+// through the host between the camera and the model.
+class CLImagePreprocess {
+ public:
+  explicit CLImagePreprocess(const CLImagePreprocessParam& param);
+
+  // src: the image in src_format in a device buffer, e.g. a mapped camera
+  // frame.
+  void Run(const cl::Buffer& src, Tensor* dst);
+  // src: the image in src_format in host memory, which is uploaded first.
+  void Run(const uint8_t* src, Tensor* dst);
+  // src: an RGBA or BGRA image of CL_UNORM_INT8, e.g. a camera texture
+  // shared by cl_khr_gl_sharing, which is resized by the sampler.
+  void Run(const cl::Image2D& src, Tensor* dst);
+
+ private:
+  cl::Image2D* PrepareOutput(Tensor* dst);
+  void Enqueue(const cl::Kernel& kernel);
+
+  CLImagePreprocessParam param_;
+  std::unique_ptr<CLContext> context_;
+  std::string buffer_kernel_key_;
+  std::string image_kernel_key_;
+  std::unique_ptr<cl::Buffer> upload_buffer_;
+  size_t src_size_{0};
+};
+
+}  // namespace lite
+}  // namespace paddle
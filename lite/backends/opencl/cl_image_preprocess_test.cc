@@ -0,0 +1,152 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "lite/backends/opencl/cl_image_converter.h"
+#include "lite/backends/opencl/cl_image_preprocess.h"
+#include "lite/backends/opencl/cl_runtime.h"
+#include "lite/backends/opencl/target_wrapper.h"
+
+namespace paddle {
+namespace lite {
+
+// rgb of the pixel (x, y) of an RGBA or NV12 image
+static void LoadRgb(const std::vector<uint8_t>& src,
+                    utils::cv::ImageFormat format,
+                    int w,
+                    int h,
+                    int x,
+                    int y,
+                    float* rgb) {
+  if (format == utils::cv::RGBA) {
+    for (int c = 0; c < 3; c++) {
+      rgb[c] = src[(y * w + x) * 4 + c];
+    }
+    return;
+  }
+  const uint8_t* uv = src.data() + w * h + (y / 2) * w + (x / 2) * 2;
+  float luma = src[y * w + x];
+  float u = uv[0] - 128.f;
+  float v = uv[1] - 128.f;
+  rgb[0] = luma + 1.402f * v;
+  rgb[1] = luma - 0.34414f * u - 0.71414f * v;
+  rgb[2] = luma + 1.772f * u;
+  for (int c = 0; c < 3; c++) {
+    rgb[c] = std::min(std::max(rgb[c], 0.f), 255.f);
+  }
+}
+
+static void PreprocessRef(const std::vector<uint8_t>& src,
+                          const CLImagePreprocessParam& param,
+                          std::vector<float>* out) {
+  const int src_w = param.src_w;
+  const int src_h = param.src_h;
+  const int dst_w = param.dst_w;
+  const int dst_h = param.dst_h;
+  const bool bgr = param.dst_format == utils::cv::BGR;
+  out->resize(3 * dst_h * dst_w);
+  for (int y = 0; y < dst_h; y++) {
+    for (int x = 0; x < dst_w; x++) {
+      float fx = std::max((x + 0.5f) * src_w / dst_w - 0.5f, 0.f);
+      float fy = std::max((y + 0.5f) * src_h / dst_h - 0.5f, 0.f);
+      int x0 = std::min(static_cast<int>(fx), src_w - 1);
+      int y0 = std::min(static_cast<int>(fy), src_h - 1);
+      int x1 = std::min(x0 + 1, src_w - 1);
+      int y1 = std::min(y0 + 1, src_h - 1);
+      float ax = fx - x0;
+      float ay = fy - y0;
+      float p00[3], p01[3], p10[3], p11[3];
+      LoadRgb(src, param.src_format, src_w, src_h, x0, y0, p00);
+      LoadRgb(src, param.src_format, src_w, src_h, x1, y0, p01);
+      LoadRgb(src, param.src_format, src_w, src_h, x0, y1, p10);
+      LoadRgb(src, param.src_format, src_w, src_h, x1, y1, p11);
+      for (int c = 0; c < 3; c++) {
+        float top = p00[c] + (p01[c] - p00[c]) * ax;
+        float bottom = p10[c] + (p11[c] - p10[c]) * ax;
+        float value = top + (bottom - top) * ay;
+        int oc = bgr ? 2 - c : c;
+        (*out)[(oc * dst_h + y) * dst_w + x] =
+            (value - param.means[oc]) * param.scales[oc];
+      }
+    }
+  }
+}
+
+static void TestPreprocess(utils::cv::ImageFormat src_format,
+                           utils::cv::ImageFormat dst_format) {
+  CLImagePreprocessParam param;
+  param.src_format = src_format;
+  param.dst_format = dst_format;
+  param.src_w = 64;
+  param.src_h = 48;
+  param.dst_w = 40;
+  param.dst_h = 30;
+  for (int i = 0; i < 3; i++) {
+    param.means[i] = 127.5f;
+    param.scales[i] = 1.f / 127.5f;
+  }
+  size_t src_size = src_format == utils::cv::RGBA
+                        ? param.src_w * param.src_h * 4
+                        : param.src_w * param.src_h * 3 / 2;
+  std::vector<uint8_t> src(src_size);
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> dist(0, 255);
+  for (auto& v : src) {
+    v = static_cast<uint8_t>(dist(rng));
+  }
+
+  CLImagePreprocess preprocess(param);
+  Tensor out;
+  preprocess.Run(src.data(), &out);
+  CLRuntime::Global()->command_queue().finish();
+
+  DDim out_dims = out.dims();
+  ASSERT_EQ(out_dims, DDim({1, 3, param.dst_h, param.dst_w}));
+  CLImageConverterDefault converter;
+  DDim image_shape = converter.InitImageDimInfoWith(out_dims);
+  std::vector<half_t> image_data(image_shape.production() * 4);
+  std::vector<float> out_data(out_dims.production());
+  TargetWrapperCL::ImgcpySync(image_data.data(),
+                              out.data<half_t, cl::Image2D>(),
+                              image_shape[0],
+                              image_shape[1],
+                              0,
+                              0,
+                              IoDirection::DtoH);
+  converter.ImageToNCHW(
+      image_data.data(), out_data.data(), image_shape, out_dims);
+
+  std::vector<float> ref;
+  PreprocessRef(src, param, &ref);
+  for (size_t i = 0; i < ref.size(); i++) {
+    EXPECT_NEAR(out_data[i], ref[i], 1e-2) << "index " << i;
+  }
+}
+
+TEST(cl_image_preprocess, rgba_to_rgb) {
+  CHECK(CLRuntime::Global()->IsInitSuccess());
+  TestPreprocess(utils::cv::RGBA, utils::cv::RGB);
+}
+
+TEST(cl_image_preprocess, nv12_to_bgr) {
+  CHECK(CLRuntime::Global()->IsInitSuccess());
+  TestPreprocess(utils::cv::NV12, utils::cv::BGR);
+}
+
+}  // namespace lite
+}  // namespace paddle
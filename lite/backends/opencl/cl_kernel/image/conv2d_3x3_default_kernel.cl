@@ -29,7 +29,12 @@ __kernel void conv2d_3x3_opt(__private const int item_ch,
                              __private const int in_h,
                              __private const int out_w,
                              __private const int out_h,
-                             __read_only image2d_t prelu_alpha) {
+                             __read_only image2d_t prelu_alpha
+#ifdef ELT_FUSE
+                             ,
+                             __read_only image2d_t second_input_image
+#endif
+                             ) {
   // item_id
   const int item_ch_id = get_global_id(0);
   const int item_w_id = get_global_id(1);
@@ -222,29 +227,54 @@ __kernel void conv2d_3x3_opt(__private const int item_ch,
   output[4] = fuse_scale(output[4], 1.f, 0.f, 0.f);
 #endif
 
+#ifdef ELT_FUSE
+  elt_fuse_func_wrapper(second_input_image,
+                        (int2)(out_w_base_id + out_w_id0, item_nh_id),
+                        &output[0]);
+#endif
   WRITE_IMG_TYPE(CL_DTYPE_CHAR,
                  output_image,
                  (int2)(out_w_base_id + out_w_id0, item_nh_id),
                  output[0]);
   if (out_w_id1 < out_w) {
+#ifdef ELT_FUSE
+    elt_fuse_func_wrapper(second_input_image,
+                          (int2)(out_w_base_id + out_w_id1, item_nh_id),
+                          &output[1]);
+#endif
     WRITE_IMG_TYPE(CL_DTYPE_CHAR,
                    output_image,
                    (int2)(out_w_base_id + out_w_id1, item_nh_id),
                    output[1]);
   }
   if (out_w_id2 < out_w) {
+#ifdef ELT_FUSE
+    elt_fuse_func_wrapper(second_input_image,
+                          (int2)(out_w_base_id + out_w_id2, item_nh_id),
+                          &output[2]);
+#endif
     WRITE_IMG_TYPE(CL_DTYPE_CHAR,
                    output_image,
                    (int2)(out_w_base_id + out_w_id2, item_nh_id),
                    output[2]);
   }
   if (out_w_id3 < out_w) {
+#ifdef ELT_FUSE
+    elt_fuse_func_wrapper(second_input_image,
+                          (int2)(out_w_base_id + out_w_id3, item_nh_id),
+                          &output[3]);
+#endif
     WRITE_IMG_TYPE(CL_DTYPE_CHAR,
                    output_image,
                    (int2)(out_w_base_id + out_w_id3, item_nh_id),
                    output[3]);
   }
   if (out_w_id4 < out_w) {
+#ifdef ELT_FUSE
+    elt_fuse_func_wrapper(second_input_image,
+                          (int2)(out_w_base_id + out_w_id4, item_nh_id),
+                          &output[4]);
+#endif
     WRITE_IMG_TYPE(CL_DTYPE_CHAR,
                    output_image,
                    (int2)(out_w_base_id + out_w_id4, item_nh_id),
@@ -268,7 +298,12 @@ __kernel void conv2d_3x3_opt_mali(__private const int item_ch,
                                   __private const int in_h,
                                   __private const int out_w,
                                   __private const int out_h,
-                                  __read_only image2d_t prelu_alpha) {
+                                  __read_only image2d_t prelu_alpha
+#ifdef ELT_FUSE
+                                  ,
+                                  __read_only image2d_t second_input_image
+#endif
+                                  ) {
   // item_id
   const int item_ch_id = get_global_id(0);
   const int item_w_id = 2 * get_global_id(1);
@@ -375,11 +410,21 @@ __kernel void conv2d_3x3_opt_mali(__private const int item_ch,
   output[1] = fuse_scale(output[1], 1.f, 0.f, 0.f);
 #endif
 
+#ifdef ELT_FUSE
+  elt_fuse_func_wrapper(second_input_image,
+                        (int2)(out_w_base_id + out_w_id0, item_nh_id),
+                        &output[0]);
+#endif
   WRITE_IMG_TYPE(CL_DTYPE_CHAR,
                  output_image,
                  (int2)(out_w_base_id + out_w_id0, item_nh_id),
                  output[0]);
   if (out_w_id1 < out_w) {
+#ifdef ELT_FUSE
+    elt_fuse_func_wrapper(second_input_image,
+                          (int2)(out_w_base_id + out_w_id1, item_nh_id),
+                          &output[1]);
+#endif
     WRITE_IMG_TYPE(CL_DTYPE_CHAR,
                    output_image,
                    (int2)(out_w_base_id + out_w_id1, item_nh_id),
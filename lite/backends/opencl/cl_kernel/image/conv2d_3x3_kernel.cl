@@ -287,7 +287,12 @@ __kernel void conv2d_3x3_multi_batch(__private const int item_ch,
                                      __private const int in_h,
                                      __private const int out_w,
                                      __private const int out_h,
-                                     __read_only image2d_t prelu_alpha) {
+                                     __read_only image2d_t prelu_alpha
+#ifdef ELT_FUSE
+                                     ,
+                                     __read_only image2d_t second_input_image
+#endif
+                                     ) {
   // item_id
   const int item_ch_id = get_global_id(0);
   const int item_w_id = get_global_id(1);
@@ -522,29 +527,54 @@ __kernel void conv2d_3x3_multi_batch(__private const int item_ch,
   output[4] = fuse_scale(output[4], 1.f, 0.f, 0.f);
 #endif
 
+#ifdef ELT_FUSE
+  elt_fuse_func_wrapper(second_input_image,
+                        (int2)(out_w_base_id + out_w_id0, item_h_id),
+                        &output[0]);
+#endif
   WRITE_IMG_TYPE(CL_DTYPE_CHAR,
                  output_image,
                  (int2)(out_w_base_id + out_w_id0, item_h_id),
                  output[0]);
   if (out_w_id1 < out_w) {
+#ifdef ELT_FUSE
+    elt_fuse_func_wrapper(second_input_image,
+                          (int2)(out_w_base_id + out_w_id1, item_h_id),
+                          &output[1]);
+#endif
     WRITE_IMG_TYPE(CL_DTYPE_CHAR,
                    output_image,
                    (int2)(out_w_base_id + out_w_id1, item_h_id),
                    output[1]);
   }
   if (out_w_id2 < out_w) {
+#ifdef ELT_FUSE
+    elt_fuse_func_wrapper(second_input_image,
+                          (int2)(out_w_base_id + out_w_id2, item_h_id),
+                          &output[2]);
+#endif
     WRITE_IMG_TYPE(CL_DTYPE_CHAR,
                    output_image,
                    (int2)(out_w_base_id + out_w_id2, item_h_id),
                    output[2]);
   }
   if (out_w_id3 < out_w) {
+#ifdef ELT_FUSE
+    elt_fuse_func_wrapper(second_input_image,
+                          (int2)(out_w_base_id + out_w_id3, item_h_id),
+                          &output[3]);
+#endif
     WRITE_IMG_TYPE(CL_DTYPE_CHAR,
                    output_image,
                    (int2)(out_w_base_id + out_w_id3, item_h_id),
                    output[3]);
   }
   if (out_w_id4 < out_w) {
+#ifdef ELT_FUSE
+    elt_fuse_func_wrapper(second_input_image,
+                          (int2)(out_w_base_id + out_w_id4, item_h_id),
+                          &output[4]);
+#endif
     WRITE_IMG_TYPE(CL_DTYPE_CHAR,
                    output_image,
                    (int2)(out_w_base_id + out_w_id4, item_h_id),
@@ -305,7 +305,12 @@ __kernel void transform_to_output(__read_only image2d_t matrix_m,
                                   __private const int out_height,
                                   __private const int global_size_dim0,
                                   __private const int global_size_dim1,
-                                  __read_only image2d_t prelu_alpha) {
+                                  __read_only image2d_t prelu_alpha
+#ifdef ELT_FUSE
+                                  ,
+                                  __read_only image2d_t second_input_image
+#endif
+                                  ) {
   const int output_cw_idx = get_global_id(0);  // c/4 w/2
   const int output_bh_idx = get_global_id(1);  // b h/2
   if (output_cw_idx >= global_size_dim0 || output_bh_idx >= global_size_dim1) {
@@ -470,14 +475,26 @@ __kernel void transform_to_output(__read_only image2d_t matrix_m,
   output3 = fuse_scale(output3, 1.f, 0.f, 0.f);
 #endif
 
+#ifdef ELT_FUSE
+  elt_fuse_func_wrapper(second_input_image, (int2)(ox.s0, oy.s0), &output0);
+#endif
   WRITE_IMG_TYPE(CL_DTYPE_CHAR, output, (int2)(ox.s0, oy.s0), output0);
   if (ow.s1 < out_width && oh.s0 < out_height) {
+#ifdef ELT_FUSE
+    elt_fuse_func_wrapper(second_input_image, (int2)(ox.s1, oy.s0), &output1);
+#endif
     WRITE_IMG_TYPE(CL_DTYPE_CHAR, output, (int2)(ox.s1, oy.s0), output1);
   }
   if (ow.s0 < out_width && oh.s1 < out_height) {
+#ifdef ELT_FUSE
+    elt_fuse_func_wrapper(second_input_image, (int2)(ox.s0, oy.s1), &output2);
+#endif
     WRITE_IMG_TYPE(CL_DTYPE_CHAR, output, (int2)(ox.s0, oy.s1), output2);
   }
   if (ow.s1 < out_width && oh.s1 < out_height) {
+#ifdef ELT_FUSE
+    elt_fuse_func_wrapper(second_input_image, (int2)(ox.s1, oy.s1), &output3);
+#endif
     WRITE_IMG_TYPE(CL_DTYPE_CHAR, output, (int2)(ox.s1, oy.s1), output3);
   }
 }
@@ -594,7 +611,12 @@ __kernel void transform_to_output_mali(__read_only image2d_t matrix_m,
                                        __private const int out_height,
                                        __private const int global_size_dim0,
                                        __private const int global_size_dim1,
-                                       __read_only image2d_t prelu_alpha) {
+                                       __read_only image2d_t prelu_alpha
+#ifdef ELT_FUSE
+                                       ,
+                                       __read_only image2d_t second_input_image
+#endif
+                                       ) {
   const int output_cw_idx = get_global_id(0);  // c/4 w/2
   const int output_bh_idx = get_global_id(1);  // b h/2
   if (output_cw_idx >= global_size_dim0 || output_bh_idx >= global_size_dim1) {
@@ -758,14 +780,207 @@ __kernel void transform_to_output_mali(__read_only image2d_t matrix_m,
   output3 = fuse_scale(output3, 1.f, 0.f, 0.f);
 #endif
 
+#ifdef ELT_FUSE
+  elt_fuse_func_wrapper(second_input_image, (int2)(ox.s0, oy.s0), &output0);
+#endif
   WRITE_IMG_TYPE(CL_DTYPE_CHAR, output, (int2)(ox.s0, oy.s0), output0);
   if (ow.s1 < out_width && oh.s0 < out_height) {
+#ifdef ELT_FUSE
+    elt_fuse_func_wrapper(second_input_image, (int2)(ox.s1, oy.s0), &output1);
+#endif
     WRITE_IMG_TYPE(CL_DTYPE_CHAR, output, (int2)(ox.s1, oy.s0), output1);
   }
   if (ow.s0 < out_width && oh.s1 < out_height) {
+#ifdef ELT_FUSE
+    elt_fuse_func_wrapper(second_input_image, (int2)(ox.s0, oy.s1), &output2);
+#endif
     WRITE_IMG_TYPE(CL_DTYPE_CHAR, output, (int2)(ox.s0, oy.s1), output2);
   }
   if (ow.s1 < out_width && oh.s1 < out_height) {
+#ifdef ELT_FUSE
+    elt_fuse_func_wrapper(second_input_image, (int2)(ox.s1, oy.s1), &output3);
+#endif
     WRITE_IMG_TYPE(CL_DTYPE_CHAR, output, (int2)(ox.s1, oy.s1), output3);
   }
-}
\ No newline at end of file
+}
+
+// The F(4x4, 3x3) winograd, which computes a 4x4 output tile from a 6x6
+// input tile. The 36 matrices between the transforms are multiplied by
+// matrix_inner_product, the same as the F(2x2, 3x3) ones.
+
+// B^T * d of F(4x4, 3x3).
+inline void winograd_4x4_bt(const CL_DTYPE4 *d, CL_DTYPE4 *o) {
+  o[0] = (CL_DTYPE)4.f * d[0] - (CL_DTYPE)5.f * d[2] + d[4];
+  o[1] = -(CL_DTYPE)4.f * (d[1] + d[2]) + d[3] + d[4];
+  o[2] = (CL_DTYPE)4.f * (d[1] - d[2]) - d[3] + d[4];
+  o[3] = (CL_DTYPE)2.f * (d[3] - d[1]) - d[2] + d[4];
+  o[4] = (CL_DTYPE)2.f * (d[1] - d[3]) - d[2] + d[4];
+  o[5] = (CL_DTYPE)4.f * d[1] - (CL_DTYPE)5.f * d[3] + d[5];
+}
+
+// A^T * m of F(4x4, 3x3).
+inline void winograd_4x4_at(const CL_DTYPE4 *m, CL_DTYPE4 *o) {
+  o[0] = m[0] + m[1] + m[2] + m[3] + m[4];
+  o[1] = m[1] - m[2] + (CL_DTYPE)2.f * (m[3] - m[4]);
+  o[2] = m[1] + m[2] + (CL_DTYPE)4.f * (m[3] + m[4]);
+  o[3] = m[1] - m[2] + (CL_DTYPE)8.f * (m[3] - m[4]) + m[5];
+}
+
+__kernel void transform_from_input_4x4(__read_only image2d_t input,
+                                       __write_only image2d_t matrix_v,
+                                       __private const int in_height,
+                                       __private const int in_width,
+                                       __private const int in_channel,
+                                       __private const int round_h,
+                                       __private const int round_w,
+                                       __private const int pad,
+                                       __private const int global_size_dim0,
+                                       __private const int global_size_dim1) {
+  const int output_cw_idx = get_global_id(0);  // c/4 w/4
+  const int output_bh_idx = get_global_id(1);  // b h/4
+  if (output_cw_idx >= global_size_dim0 || output_bh_idx >= global_size_dim1) {
+    return;
+  }
+  const int c_block_idx = output_cw_idx / round_w;
+  const int w_block_idx = output_cw_idx - mul24(c_block_idx, round_w);
+  const int batch = output_bh_idx / round_h;
+  const int h_block_idx = output_bh_idx - mul24(batch, round_h);
+
+  const int width_start_idx = (w_block_idx << 2) - pad;
+  const int height_start_idx = (h_block_idx << 2) - pad;
+
+  // transform the rows of the tile
+  CL_DTYPE4 t[6][6];
+  for (int i = 0; i < 6; i++) {
+    const int height_idx = height_start_idx + i;
+    const int in_bh_idx = (height_idx < 0 || height_idx >= in_height)
+                              ? -1
+                              : mad24(batch, in_height, height_idx);
+    CL_DTYPE4 d[6];
+    for (int j = 0; j < 6; j++) {
+      const int width_idx = width_start_idx + j;
+      const int in_wc_idx = (width_idx < 0 || width_idx >= in_width)
+                                ? -1
+                                : mad24(c_block_idx, in_width, width_idx);
+      d[j] = READ_IMG_TYPE(
+          CL_DTYPE_CHAR, input, SAMPLER, (int2)(in_wc_idx, in_bh_idx));
+    }
+    winograd_4x4_bt(d, t[i]);
+  }
+
+  // transform the columns of the tile, the j-th column of the i-th row is
+  // written into the (i * 6 + j)-th matrix
+  for (int j = 0; j < 6; j++) {
+    CL_DTYPE4 d[6];
+    CL_DTYPE4 v[6];
+    for (int i = 0; i < 6; i++) {
+      d[i] = t[i][j];
+    }
+    winograd_4x4_bt(d, v);
+    for (int i = 0; i < 6; i++) {
+      WRITE_IMG_TYPE(CL_DTYPE_CHAR,
+                     matrix_v,
+                     (int2)(output_cw_idx,
+                            mad24(i * 6 + j, global_size_dim1, output_bh_idx)),
+                     v[i]);
+    }
+  }
+}
+
+__kernel void transform_to_output_4x4(__read_only image2d_t matrix_m,
+                                      __read_only image2d_t bias,
+                                      __write_only image2d_t output,
+                                      __private const int round_w,
+                                      __private const int round_h,
+                                      __private const int out_width,
+                                      __private const int out_height,
+                                      __private const int global_size_dim0,
+                                      __private const int global_size_dim1,
+                                      __read_only image2d_t prelu_alpha
+#ifdef ELT_FUSE
+                                      ,
+                                      __read_only image2d_t second_input_image
+#endif
+                                      ) {
+  const int output_cw_idx = get_global_id(0);  // c/4 w/4
+  const int output_bh_idx = get_global_id(1);  // b h/4
+  if (output_cw_idx >= global_size_dim0 || output_bh_idx >= global_size_dim1) {
+    return;
+  }
+  const int c_block_idx = output_cw_idx / round_w;
+  const int w_block_idx = output_cw_idx - mul24(c_block_idx, round_w);
+  const int batch = output_bh_idx / round_h;
+  const int h_block_idx = output_bh_idx - mul24(batch, round_h);
+
+#ifdef BIASE_CH
+  CL_DTYPE4 bias_value =
+      READ_IMG_TYPE(CL_DTYPE_CHAR, bias, SAMPLER, (int2)(c_block_idx, 0));
+#else
+  CL_DTYPE4 bias_value = 0.0f;
+#endif
+
+  // transform the columns of the tile
+  CL_DTYPE4 t[4][6];
+  for (int j = 0; j < 6; j++) {
+    CL_DTYPE4 m[6];
+    CL_DTYPE4 o[4];
+    for (int i = 0; i < 6; i++) {
+      m[i] = READ_IMG_TYPE(
+          CL_DTYPE_CHAR,
+          matrix_m,
+          SAMPLER,
+          (int2)(output_cw_idx,
+                 mad24(i * 6 + j, global_size_dim1, output_bh_idx)));
+    }
+    winograd_4x4_at(m, o);
+    for (int i = 0; i < 4; i++) {
+      t[i][j] = o[i];
+    }
+  }
+
+  // transform the rows of the tile and write the 4x4 outputs
+  for (int i = 0; i < 4; i++) {
+    const int oh = (h_block_idx << 2) + i;
+    if (oh >= out_height) {
+      break;
+    }
+    const int oy = mad24(batch, out_height, oh);
+    CL_DTYPE4 o[4];
+    winograd_4x4_at(t[i], o);
+    for (int j = 0; j < 4; j++) {
+      const int ow = (w_block_idx << 2) + j;
+      if (ow >= out_width) {
+        break;
+      }
+      const int ox = mad24(c_block_idx, out_width, ow);
+      CL_DTYPE4 res = bias_value + o[j];
+
+      CL_DTYPE4 alpha;
+#ifdef PRELU_CH  //{
+      alpha = READ_IMG_TYPE(
+          CL_DTYPE_CHAR, prelu_alpha, SAMPLER, (int2)(c_block_idx, 0));
+//}
+#elif defined(PRELU_ELE)  //{
+      alpha =
+          READ_IMG_TYPE(CL_DTYPE_CHAR, prelu_alpha, SAMPLER, (int2)(ox, oh));
+//}
+#elif defined(PRELU_ALL)  //{
+      alpha = READ_IMG_TYPE(CL_DTYPE_CHAR, prelu_alpha, SAMPLER, (int2)(0, 0));
+      alpha.y = alpha.x;
+      alpha.z = alpha.x;
+      alpha.w = alpha.x;
+//}
+#endif
+      res = activation_type4(res, alpha);
+
+#ifdef SCALE_ACTIVATION
+      res = fuse_scale(res, 1.f, 0.f, 0.f);
+#endif
+
+#ifdef ELT_FUSE
+      elt_fuse_func_wrapper(second_input_image, (int2)(ox, oy), &res);
+#endif
+      WRITE_IMG_TYPE(CL_DTYPE_CHAR, output, (int2)(ox, oy), res);
+    }
+  }
+}
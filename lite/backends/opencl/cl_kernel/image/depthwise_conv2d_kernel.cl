@@ -31,7 +31,12 @@ __kernel void depth_conv2d_3x3(
     __private const int input_height, /* of one block */
     __private const int output_width,
     __private const int output_height,
-    __read_only image2d_t prelu_alpha) {
+    __read_only image2d_t prelu_alpha
+#ifdef ELT_FUSE
+    ,
+    __read_only image2d_t second_input_image
+#endif
+    ) {
   const int out_c = get_global_id(0);
   const int out_w = get_global_id(1);
   const int out_nh = get_global_id(2);
@@ -260,6 +265,9 @@ __kernel void depth_conv2d_3x3(
 
   */
 
+#ifdef ELT_FUSE
+  elt_fuse_func_wrapper(second_input_image, output_pos, &output);
+#endif
   WRITE_IMG_TYPE(CL_DTYPE_CHAR, output_image, output_pos, output);
 }
 
@@ -278,7 +286,12 @@ __kernel void depth_conv2d_3x3s1(__private const int ou_ch_blk,
                                  __private const int in_h, /* of one block */
                                  __private const int ou_w,
                                  __private const int ou_h,
-                                 __read_only image2d_t prelu_alpha) {
+                                 __read_only image2d_t prelu_alpha
+#ifdef ELT_FUSE
+                                 ,
+                                 __read_only image2d_t second_input_image
+#endif
+                                 ) {
   const int ou_ch_blk_id = get_global_id(0);
   const int ou_w_blk_id = get_global_id(1);
   const int ou_nh_id = get_global_id(2);
@@ -422,9 +435,17 @@ __kernel void depth_conv2d_3x3s1(__private const int ou_ch_blk,
   output[1] = fuse_scale(output[1], 1.f, 0.f, 0.f);
 #endif
 
+#ifdef ELT_FUSE
+  elt_fuse_func_wrapper(second_input_image, (int2)(ou_x, ou_nh_id), &output[0]);
+#endif
   WRITE_IMG_TYPE(
       CL_DTYPE_CHAR, output_image, (int2)(ou_x, ou_nh_id), output[0]);
   if (ou_col_id + 1 < ou_w) {
+#ifdef ELT_FUSE
+    elt_fuse_func_wrapper(second_input_image,
+                          (int2)(ou_x + 1, ou_nh_id),
+                          &output[1]);
+#endif
     WRITE_IMG_TYPE(
         CL_DTYPE_CHAR, output_image, (int2)(ou_x + 1, ou_nh_id), output[1]);
   }
@@ -0,0 +1,58 @@
+/* Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <cl_common.h>
+
+// The helpers of the elementwise_chain kernel, whose source is generated by
+// the fusion_elementwise_chain kernel and appended to this file.
+
+// The element at the NCHW offset of the image of the dims (n, c, h, w).
+inline float elementwise_chain_gather(__read_only image2d_t img,
+                                      int4 dims,
+                                      int offset) {
+  int w = offset % dims.w;
+  offset /= dims.w;
+  int h = offset % dims.z;
+  offset /= dims.z;
+  int c = offset % dims.y;
+  int n = offset / dims.y;
+  int2 pos = (int2)((c >> 2) * dims.w + w, n * dims.z + h);
+  float4 v = convert_float4(READ_IMG_TYPE(CL_DTYPE_CHAR, img, SAMPLER, pos));
+  int lane = c & 3;
+  return lane == 0 ? v.x : (lane == 1 ? v.y : (lane == 2 ? v.z : v.w));
+}
+
+// The 4 channels from c4 * 4 of the output pixel (n, h, w), read from the
+// image of the dims whose dims aligned to the output are aligned, e.g. a 1-D
+// input put at the channels, which the image holds at the width.
+inline float4 elementwise_chain_read_general(__read_only image2d_t img,
+                                             int4 dims,
+                                             int4 aligned,
+                                             int n,
+                                             int c4,
+                                             int h,
+                                             int w) {
+  int in_n = aligned.x == 1 ? 0 : n;
+  int in_h = aligned.z == 1 ? 0 : h;
+  int in_w = aligned.w == 1 ? 0 : w;
+  float r[4];
+  for (int i = 0; i < 4; i++) {
+    // the padded channels of the last pixel read the last channel
+    int in_c = aligned.y == 1 ? 0 : min(c4 * 4 + i, aligned.y - 1);
+    int offset =
+        ((in_n * aligned.y + in_c) * aligned.z + in_h) * aligned.w + in_w;
+    r[i] = elementwise_chain_gather(img, dims, offset);
+  }
+  return (float4)(r[0], r[1], r[2], r[3]);
+}
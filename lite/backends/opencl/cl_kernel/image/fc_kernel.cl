@@ -100,6 +100,103 @@ __kernel void fc(__read_only image2d_t input,
   }
 }
 
+#if defined(INT8_DOT_ARM)
+#pragma OPENCL EXTENSION cl_arm_integer_dot_product_int8 : enable
+#define DOT8_ACC(a, b, acc) ((acc) + arm_dot((a), (b)))
+#elif defined(INT8_DOT_QCOM)
+#pragma OPENCL EXTENSION cl_qcom_dot_product8 : enable
+#define DOT8_ACC(a, b, acc) qcom_dot8_acc(as_uint(a), as_uint(b), (acc))
+#else
+#define DOT8_ACC(a, b, acc) \
+  ((acc) + (a).x * (b).x + (a).y * (b).y + (a).z * (b).z + (a).w * (b).w)
+#endif
+
+// The input is quantized by `input_scale_inv` on the fly, and the int8
+// weights are stored in the 4x4 blocks of the fc kernel, but the 4 input
+// channels of each output channel are contiguous, i.e. the block is
+// transposed. `dequant_scales` is the input scale multiplied by the scales of
+// the output channels.
+__kernel void fc_int8(__read_only image2d_t input,
+                      __write_only image2d_t output,
+                      __global char16 *weights,
+                      __global float4 *dequant_scales,
+#ifdef BIASE_CH
+                      __read_only image2d_t biases,
+#endif  // BIASE_CH
+#ifdef PRELU
+                      __read_only image2d_t prelu_alpha,
+#endif  // PRELU
+                      int batch,
+                      int in_c_blks,
+                      int out_c_blks,
+                      float input_scale_inv) {
+  int out_n = get_global_id(2);
+  int out_c = get_global_id(0);
+  int2 tid = (int2)(get_local_id(0), get_local_id(1));
+  int4 s = (int4)(0);
+  if (out_n >= batch) return;
+
+  if (out_c < out_c_blks) {
+    for (int c = tid.y; c < in_c_blks; c += 4) {
+      float4 v = convert_float4(READ_IMG_TYPE(
+          CL_COMPUTE_DTYPE_CHAR, input, SAMPLER, (int2)(c, out_n)));
+      char4 q = convert_char4_sat_rte(
+          clamp(v * input_scale_inv, (float4)(-127.f), (float4)(127.f)));
+      char16 w = weights[c * out_c_blks + out_c];
+      s.x = DOT8_ACC(q, w.s0123, s.x);
+      s.y = DOT8_ACC(q, w.s4567, s.y);
+      s.z = DOT8_ACC(q, w.s89ab, s.z);
+      s.w = DOT8_ACC(q, w.scdef, s.w);
+    }
+  }
+  __local int4 temp[32][4];
+  temp[tid.x][tid.y] = s;
+  barrier(CLK_LOCAL_MEM_FENCE);
+
+  if (out_c >= out_c_blks) {
+    return;
+  }
+  if (tid.y == 0) {
+    s += temp[tid.x][1];
+    s += temp[tid.x][2];
+    s += temp[tid.x][3];
+    int2 output_pos0 = (int2)(out_c, out_n);
+    CL_COMPUTE_DTYPE4 output0 = CONVERT_TYPE_TO(
+        convert_float4(s) * dequant_scales[out_c], CL_COMPUTE_DTYPE4);
+
+#ifdef BIASE_CH
+    output0 +=
+        READ_IMG_TYPE(CL_COMPUTE_DTYPE_CHAR, biases, SAMPLER, (int2)(out_c, 0));
+#endif  // BIASE_CH
+
+    CL_COMPUTE_DTYPE4 alpha0;
+#ifdef PRELU_CH
+    alpha0 = READ_IMG_TYPE(
+        CL_COMPUTE_DTYPE_CHAR, prelu_alpha, SAMPLER, (int2)(out_c, 0));
+#elif defined(PRELU_ELE)
+    alpha0 = READ_IMG_TYPE(
+        CL_COMPUTE_DTYPE_CHAR, prelu_alpha, SAMPLER, (int2)(out_c, 0));
+#elif defined(PRELU_ALL)
+    alpha0 = READ_IMG_TYPE(
+        CL_COMPUTE_DTYPE_CHAR, prelu_alpha, SAMPLER, (int2)(0, 0));
+    alpha0.y = alpha0.x;
+    alpha0.z = alpha0.x;
+    alpha0.w = alpha0.x;
+#endif  // PRELU
+    output0 = activation_type4(output0, alpha0);
+#ifdef SCALE_ACTIVATION
+    output0 = fuse_scale(output0, 1.f, 0.f, 0.f);
+#endif
+
+    CL_DTYPE4 out0;
+    out0.x = CONVERT_TYPE_TO(output0.x, CL_DTYPE);
+    out0.y = CONVERT_TYPE_TO(output0.y, CL_DTYPE);
+    out0.z = CONVERT_TYPE_TO(output0.z, CL_DTYPE);
+    out0.w = CONVERT_TYPE_TO(output0.w, CL_DTYPE);
+    WRITE_IMG_TYPE(CL_DTYPE_CHAR, output, output_pos0, out0);
+  }
+}
+
 __kernel void input_layout(__read_only image2d_t input_image,
                            __write_only image2d_t output_image,
                            __private const int in_W,
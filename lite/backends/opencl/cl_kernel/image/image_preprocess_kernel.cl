@@ -0,0 +1,144 @@
+/* Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <cl_common.h>
+
+// SRC_FORMAT takes the values of paddle::lite::utils::cv::ImageFormat.
+#define FORMAT_RGBA 0
+#define FORMAT_BGRA 1
+#define FORMAT_RGB 2
+#define FORMAT_BGR 3
+#define FORMAT_GRAY 4
+#define FORMAT_NV21 11
+#define FORMAT_NV12 12
+
+__constant sampler_t LINEAR_SAMPLER = CLK_NORMALIZED_COORDS_FALSE |
+                                      CLK_ADDRESS_CLAMP_TO_EDGE |
+                                      CLK_FILTER_LINEAR;
+
+// load the pixel (x, y) of an 8-bit image as rgb in [0, 255]
+inline float3 load_rgb(__global const uchar* src,
+                       const int x,
+                       const int y,
+                       const int src_w,
+                       const int src_h) {
+  float3 rgb;
+#if SRC_FORMAT == FORMAT_GRAY
+  rgb = (float3)((float)src[y * src_w + x]);
+#elif SRC_FORMAT == FORMAT_RGB || SRC_FORMAT == FORMAT_BGR
+  rgb = convert_float3(vload3(y * src_w + x, src));
+#elif SRC_FORMAT == FORMAT_RGBA || SRC_FORMAT == FORMAT_BGRA
+  rgb = convert_float4(vload4(y * src_w + x, src)).xyz;
+#else
+  // a y plane followed by an interleaved uv(NV12) or vu(NV21) plane of
+  // half the height
+  __global const uchar* uv =
+      src + src_w * src_h + (y >> 1) * src_w + (x & ~1);
+  const float luma = (float)src[y * src_w + x];
+#if SRC_FORMAT == FORMAT_NV12
+  const float u = (float)uv[0] - 128.f;
+  const float v = (float)uv[1] - 128.f;
+#else
+  const float v = (float)uv[0] - 128.f;
+  const float u = (float)uv[1] - 128.f;
+#endif
+  rgb = (float3)(luma + 1.402f * v,
+                 luma - 0.34414f * u - 0.71414f * v,
+                 luma + 1.772f * u);
+  rgb = clamp(rgb, 0.f, 255.f);
+#endif
+#if SRC_FORMAT == FORMAT_BGR || SRC_FORMAT == FORMAT_BGRA
+  rgb = rgb.zyx;
+#endif
+  return rgb;
+}
+
+// normalize rgb to the channel order of the output (DST_BGR, DST_GRAY or
+// rgb by default) and store it in the ImageDefault image
+inline void store_normalized(__write_only image2d_t output,
+                             const int x,
+                             const int y,
+                             float3 rgb,
+                             const float4 means,
+                             const float4 scales) {
+  float4 out = (float4)(0.f);
+#if defined(DST_GRAY)
+  out.x = (dot(rgb, (float3)(0.299f, 0.587f, 0.114f)) - means.x) * scales.x;
+#elif defined(DST_BGR)
+  out.xyz = (rgb.zyx - means.xyz) * scales.xyz;
+#else
+  out.xyz = (rgb - means.xyz) * scales.xyz;
+#endif
+  WRITE_IMG_TYPE(
+      CL_DTYPE_CHAR, output, (int2)(x, y), CONVERT_TYPE_TO(out, CL_DTYPE4));
+}
+
+// resize (bilinear, half pixel centers), convert and normalize an 8-bit
+// image in a buffer
+__kernel void image_preprocess_buffer(__global const uchar* src,
+                                      __write_only image2d_t output,
+                                      __private const int src_w,
+                                      __private const int src_h,
+                                      __private const int dst_w,
+                                      __private const int dst_h,
+                                      __private const float scale_x,
+                                      __private const float scale_y,
+                                      __private const float4 means,
+                                      __private const float4 scales) {
+  const int x = get_global_id(0);
+  const int y = get_global_id(1);
+  if (x >= dst_w || y >= dst_h) {
+    return;
+  }
+  const float fx = max(((float)x + 0.5f) * scale_x - 0.5f, 0.f);
+  const float fy = max(((float)y + 0.5f) * scale_y - 0.5f, 0.f);
+  const int x0 = min((int)fx, src_w - 1);
+  const int y0 = min((int)fy, src_h - 1);
+  const int x1 = min(x0 + 1, src_w - 1);
+  const int y1 = min(y0 + 1, src_h - 1);
+  const float ax = fx - (float)x0;
+  const float ay = fy - (float)y0;
+
+  float3 top = mix(load_rgb(src, x0, y0, src_w, src_h),
+                   load_rgb(src, x1, y0, src_w, src_h),
+                   ax);
+  float3 bottom = mix(load_rgb(src, x0, y1, src_w, src_h),
+                      load_rgb(src, x1, y1, src_w, src_h),
+                      ax);
+  store_normalized(output, x, y, mix(top, bottom, ay), means, scales);
+}
+
+// resize, convert and normalize an RGBA/BGRA image of CL_UNORM_INT8, e.g.
+// a camera texture, by the bilinear filter of the sampler
+__kernel void image_preprocess_image(__read_only image2d_t src,
+                                     __write_only image2d_t output,
+                                     __private const int dst_w,
+                                     __private const int dst_h,
+                                     __private const float scale_x,
+                                     __private const float scale_y,
+                                     __private const float4 means,
+                                     __private const float4 scales) {
+  const int x = get_global_id(0);
+  const int y = get_global_id(1);
+  if (x >= dst_w || y >= dst_h) {
+    return;
+  }
+  const float2 pos =
+      (float2)(((float)x + 0.5f) * scale_x, ((float)y + 0.5f) * scale_y);
+  float3 rgb = read_imagef(src, LINEAR_SAMPLER, pos).xyz * 255.f;
+#if SRC_FORMAT == FORMAT_BGRA
+  rgb = rgb.zyx;
+#endif
+  store_normalized(output, x, y, rgb, means, scales);
+}
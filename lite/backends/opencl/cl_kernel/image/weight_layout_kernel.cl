@@ -0,0 +1,114 @@
+/* Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include <cl_common.h>
+
+// The fp32 NCHW tensors uploaded to the images of the CLImageConverter
+// layouts, one pixel per work item. The padded channels are zeros.
+
+////////////////////////////////////////////////////////
+// nchw -> CLImageConverterDefault
+// image: (W * ((C + 3) / 4), N * H)
+////////////////////////////////////////////////////////
+__kernel void nchw_to_image2d_default(__global const float* in,
+                                      __write_only image2d_t output_image,
+                                      __private const int N,
+                                      __private const int C,
+                                      __private const int H,
+                                      __private const int W) {
+  const int x = get_global_id(0);
+  const int y = get_global_id(1);
+
+  const int c0 = (x / W) * 4;
+  const int w = x % W;
+  const int n = y / H;
+  const int h = y % H;
+
+  float4 out = (float4)(0.f, 0.f, 0.f, 0.f);
+  int pos = ((n * C + c0) * H + h) * W + w;
+  const int stride = H * W;
+  out.x = in[pos];
+  if (c0 + 1 < C) out.y = in[pos + stride];
+  if (c0 + 2 < C) out.z = in[pos + 2 * stride];
+  if (c0 + 3 < C) out.w = in[pos + 3 * stride];
+
+  WRITE_IMG_TYPE(CL_DTYPE_CHAR,
+                 output_image,
+                 (int2)(x, y),
+                 CONVERT_TYPE_TO(out, CL_DTYPE4));
+}
+
+////////////////////////////////////////////////////////
+// nchw -> CLImageConverterNWBlock
+// image: (W * ((N + 3) / 4), C * H)
+////////////////////////////////////////////////////////
+__kernel void nchw_to_image2d_nw(__global const float* in,
+                                 __write_only image2d_t output_image,
+                                 __private const int N,
+                                 __private const int C,
+                                 __private const int H,
+                                 __private const int W) {
+  const int x = get_global_id(0);
+  const int y = get_global_id(1);
+
+  const int n0 = (x / W) * 4;
+  const int w = x % W;
+  const int c = y / H;
+  const int h = y % H;
+
+  float4 out = (float4)(0.f, 0.f, 0.f, 0.f);
+  int pos = ((n0 * C + c) * H + h) * W + w;
+  const int stride = C * H * W;
+  out.x = in[pos];
+  if (n0 + 1 < N) out.y = in[pos + stride];
+  if (n0 + 2 < N) out.z = in[pos + 2 * stride];
+  if (n0 + 3 < N) out.w = in[pos + 3 * stride];
+
+  WRITE_IMG_TYPE(CL_DTYPE_CHAR,
+                 output_image,
+                 (int2)(x, y),
+                 CONVERT_TYPE_TO(out, CL_DTYPE4));
+}
+
+////////////////////////////////////////////////////////
+// nchw -> CLImageConverterNBlock
+// image: (((C + 3) / 4) * 4, ((N + 3) / 4) * H * W)
+////////////////////////////////////////////////////////
+__kernel void nchw_to_image2d_nblock(__global const float* in,
+                                     __write_only image2d_t output_image,
+                                     __private const int N,
+                                     __private const int C,
+                                     __private const int H,
+                                     __private const int W) {
+  const int c = get_global_id(0);
+  const int y = get_global_id(1);
+
+  const int n0 = (y / (H * W)) * 4;
+  const int hw = y % (H * W);
+
+  float4 out = (float4)(0.f, 0.f, 0.f, 0.f);
+  if (c < C) {
+    int pos = (n0 * C + c) * H * W + hw;
+    const int stride = C * H * W;
+    out.x = in[pos];
+    if (n0 + 1 < N) out.y = in[pos + stride];
+    if (n0 + 2 < N) out.z = in[pos + 2 * stride];
+    if (n0 + 3 < N) out.w = in[pos + 3 * stride];
+  }
+
+  WRITE_IMG_TYPE(CL_DTYPE_CHAR,
+                 output_image,
+                 (int2)(c, y),
+                 CONVERT_TYPE_TO(out, CL_DTYPE4));
+}
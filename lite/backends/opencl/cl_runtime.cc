@@ -10,10 +10,15 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include "lite/backends/opencl/cl_runtime.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <functional>
 #include <string>
 #include <utility>
 #include <vector>
 #include "lite/backends/opencl/utils/cache.h"
+#include "lite/core/runtime_stats.h"
 #include "lite/core/target_wrapper.h"
 #include "lite/core/version.h"
 #include "lite/utils/io.h"
@@ -43,6 +48,7 @@ CLRuntime::~CLRuntime() {
     return;
   }
 
+  JoinAsyncBuilds();
   if (command_queue_ != nullptr) {
     command_queue_->flush();
     command_queue_->finish();
@@ -142,6 +148,12 @@ cl::CommandQueue& CLRuntime::command_queue() {
 
 cl::Program& CLRuntime::GetProgram(const std::string& file_name,
                                    const std::string& options) {
+  return GetProgram(file_name, "", options);
+}
+
+cl::Program& CLRuntime::GetProgram(const std::string& file_name,
+                                   const std::string& source,
+                                   const std::string& options) {
   /* -I +CLRuntime::Global()->cl_path() + "/cl_kernel"*/
   std::string build_option = options + " -cl-fast-relaxed-math -cl-mad-enable";
   if (build_option.find("CL_DTYPE_") == std::string::npos) {
@@ -157,15 +169,22 @@ cl::Program& CLRuntime::GetProgram(const std::string& file_name,
 #endif
 
   STL::stringstream program_key_ss;
-  program_key_ss << file_name << build_option;
+  program_key_ss << file_name;
+  if (!source.empty()) {
+    // Lower case hex, the options are found by the first '-' or 'D' of the
+    // keys loaded from the precompiled binary.
+    program_key_ss << "#" << std::hex << std::hash<std::string>()(source);
+  }
+  program_key_ss << build_option;
   std::string program_key = program_key_ss.str();
 
   // Build flow: cache -> precompiled binary -> source
+  WaitForAsyncProgram(program_key);
   bool ret = CheckFromCache(program_key);
   if (!ret) {
     ret = CheckFromPrecompiledBinary(program_key, build_option);
     if (!ret) {
-      ret = CheckFromSource(file_name, program_key, build_option);
+      ret = CheckFromSource(file_name, program_key, build_option, source);
     }
   }
 
@@ -245,7 +264,6 @@ bool CLRuntime::CheckFromPrecompiledBinary(const std::string& program_key,
         LOG(WARNING) << "The precompiled OpenCL binary[" << bin_file
                      << "] is illegal!";
         delete_bin_flag = true;
-        del_tune_bin_flag_ = true;
         // Jump to build from source
       } else if (host::memcmp(((sn_iter->second)[0]).data(),
                               GetSN(precision_option).data(),
@@ -259,7 +277,6 @@ bool CLRuntime::CheckFromPrecompiledBinary(const std::string& program_key,
         LOG(WARNING) << "The precompiled OpenCL binary[" << bin_file
                      << "] is invalid!";
         delete_bin_flag = true;
-        del_tune_bin_flag_ = true;
         // Jump to build from source
       } else {
 #ifdef LITE_WITH_LOG
@@ -290,8 +307,7 @@ bool CLRuntime::CheckFromPrecompiledBinary(const std::string& program_key,
           ret = true;
         } else {
           delete_bin_flag = true;
-          del_tune_bin_flag_ = true;
-          // Jump to build from source
+            // Jump to build from source
         }
       }
     }
@@ -305,7 +321,6 @@ bool CLRuntime::CheckFromPrecompiledBinary(const std::string& program_key,
     // This case happened when model has updated. Bin file should be updated
     // accordingly.
     delete_bin_flag = true;
-    del_tune_bin_flag_ = true;
     gotten_bin_flag_ = false;
     remove_file(bin_file);
   }
@@ -315,8 +330,9 @@ bool CLRuntime::CheckFromPrecompiledBinary(const std::string& program_key,
 
 bool CLRuntime::CheckFromSource(const std::string& file_name,
                                 const std::string& program_key,
-                                const std::string& build_option) {
-  auto ptr = CreateProgramFromSource(context(), file_name);
+                                const std::string& build_option,
+                                const std::string& source) {
+  auto ptr = CreateProgramFromSource(context(), file_name, source);
   auto program = ptr.get();
 #ifdef LITE_WITH_LOG
   VLOG(3) << " --- begin build program from source -> " << program_key
@@ -328,10 +344,98 @@ bool CLRuntime::CheckFromSource(const std::string& file_name,
   return true;
 }
 
+void CLRuntime::PrecompileProgramsAsync() {
+  if (program_list_loaded_) return;
+  std::string list_file = GetProgramListFile();
+  if (list_file.empty()) return;
+  program_list_loaded_ = true;
+  std::string bin_file =
+      binary_path_name_.at(0) + "/" + binary_path_name_.at(1);
+  if (IsFileExists(bin_file) || !IsFileExists(list_file)) return;
+
+  typedef std::promise<std::shared_ptr<cl::Program>> promise_t;
+  typedef std::vector<std::pair<std::string, promise_t>> tasks_t;
+  auto tasks = std::make_shared<tasks_t>();
+  for (auto& program_key : ReadLines(list_file)) {
+    if (program_key.empty() || programs_.count(program_key) ||
+        async_programs_.count(program_key)) {
+      continue;
+    }
+    promise_t promise;
+    async_programs_[program_key] = promise.get_future().share();
+    tasks->emplace_back(program_key, std::move(promise));
+  }
+  if (tasks->empty()) return;
+  // Leave a core for the main thread going on with the initialization.
+  size_t threads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+  threads = std::min(threads, tasks->size());
+  LOG(INFO) << "Build " << tasks->size() << " OpenCL programs listed in "
+            << list_file << " on " << threads << " threads";
+  auto next = std::make_shared<std::atomic<size_t>>(0);
+  for (size_t i = 0; i < threads; i++) {
+    async_builders_.emplace_back([this, tasks, next] {
+      for (size_t j = (*next)++; j < tasks->size(); j = (*next)++) {
+        auto& task = tasks->at(j);
+        // The program key is the file name followed by the build options.
+        auto pos = task.first.find(".cl");
+        if (pos == std::string::npos) {
+          task.second.set_value(nullptr);
+          continue;
+        }
+        task.second.set_value(BuildProgramAsync(task.first.substr(0, pos + 3),
+                                                task.first.substr(pos + 3)));
+      }
+    });
+  }
+}
+
+void CLRuntime::WaitForAsyncProgram(const std::string& program_key) {
+  auto it = async_programs_.find(program_key);
+  if (it == async_programs_.end()) return;
+  auto program = it->second.get();
+  async_programs_.erase(it);
+  if (program) {
+#ifdef LITE_WITH_LOG
+    VLOG(3) << " --- program -> " << program_key
+            << " has been built in background --- ";
+#endif
+    programs_[program_key].reset(new cl::Program(*program));
+  }
+}
+
+std::shared_ptr<cl::Program> CLRuntime::BuildProgramAsync(
+    const std::string& file_name, const std::string& options) {
+  auto cl_file = opencl_kernels_files.find(file_name);
+  if (cl_file == opencl_kernels_files.end()) return nullptr;
+  cl::Program::Sources sources;
+  sources.push_back(
+      std::string(cl_file->second.begin(), cl_file->second.end()));
+  cl_int status{CL_SUCCESS};
+  auto program = std::make_shared<cl::Program>(*context_, sources, &status);
+  if (status != CL_SUCCESS) return nullptr;
+  status = program->build({*device_}, options.c_str());
+  // Built again by GetProgram, which reports the build log.
+  if (status != CL_SUCCESS) return nullptr;
+  return program;
+}
+
+void CLRuntime::JoinAsyncBuilds() {
+  for (auto& builder : async_builders_) {
+    if (builder.joinable()) builder.join();
+  }
+  async_builders_.clear();
+  async_programs_.clear();
+}
+
 std::unique_ptr<cl::Program> CLRuntime::CreateProgramFromSource(
-    const cl::Context& context, std::string file_name) {
+    const cl::Context& context,
+    std::string file_name,
+    const std::string& source) {
   auto cl_file = opencl_kernels_files.find(file_name);
+  CHECK(cl_file != opencl_kernels_files.end())
+      << "Unknown OpenCL kernel file: " << file_name;
   std::string content(cl_file->second.begin(), cl_file->second.end());
+  content += "\n" + source;
   cl::Program::Sources sources;
   sources.push_back(content);
   auto prog =
@@ -403,6 +507,14 @@ void CLRuntime::SaveProgram() {
     if (!ret) {
       LOG(WARNING) << "Serialize failed for opencl binary_file:" << binary_file;
     }
+    // The device-independent list of the programs, used to build them in
+    // the background when the binary is missing or invalid.
+    std::ofstream list_file(GetProgramListFile());
+    for (auto& program_id : programs_) {
+      // The generated sources aren't in the kernel files.
+      if (program_id.first.find(".cl#") != std::string::npos) continue;
+      list_file << program_id.first << "\n";
+    }
 #ifdef LITE_WITH_LOG
     if (programs_precompiled_binary_.find(sn_key_) !=
         programs_precompiled_binary_.end()) {
@@ -419,21 +531,30 @@ void CLRuntime::SaveProgram() {
 
 void CLRuntime::SaveTuned() {
   if (tuned_path_name_.empty() || auto_tune() == lite_api::CL_TUNE_NONE) return;
+  if (!tuned_dirty_) return;
   std::string tuned_file =
       tuned_path_name_.at(0) + "/" + tuned_path_name_.at(1);
-  if (IsFileExists(tuned_file) && del_tune_bin_flag_) {
-    remove_file(tuned_file);
-  }
+  // Keep the entries saved by the other runs meanwhile, e.g. the ones of the
+  // other devices or models sharing the file.
   if (IsFileExists(tuned_file)) {
-    LOG(INFO) << "OpenCL Tuned file existed:" << tuned_file;
-  } else {
-    bool ret = Serialize(tuned_file, tuned_lwss_map_);
-    if (!ret) {
-      LOG(WARNING) << "Serialize failed for opencl tuned_file:" << tuned_file;
+    std::map<std::string, std::vector<int>> saved_map;
+    if (Deserialize(tuned_file, &saved_map)) {
+      tuned_lwss_map_.insert(saved_map.begin(), saved_map.end());
     }
-    LOG(INFO) << "Tuned file have been serialized to disk successfully: "
-              << tuned_file;
   }
+  // Written into a temporary file first, so the runs loading the file at the
+  // same time never see a partial one.
+  std::string tmp_file = tuned_file + ".tmp";
+  bool ret = Serialize(tmp_file, tuned_lwss_map_) &&
+             std::rename(tmp_file.c_str(), tuned_file.c_str()) == 0;
+  if (!ret) {
+    LOG(WARNING) << "Serialize failed for opencl tuned_file:" << tuned_file;
+    remove_file(tmp_file);
+    return;
+  }
+  tuned_dirty_ = false;
+  LOG(INFO) << "Tuned file have been serialized to disk successfully: "
+            << tuned_file;
 }
 
 // binary
@@ -464,23 +585,40 @@ bool CLRuntime::Serialize(
     const std::string file_name,
     const std::map<std::string, std::vector<int>>& map_data) {
   fbs::opencl::TuneCache cache{map_data};
-  std::vector<int> buffer;
+  std::vector<uint8_t> buffer;
   cache.CopyDataToBuffer(&buffer);
 
-  WriteFile<int>(file_name, buffer);
+  WriteFile<uint8_t>(file_name, buffer);
   return true;
 }
 
 bool CLRuntime::Deserialize(const std::string file_name,
                             std::map<std::string, std::vector<int>>* map_ptr) {
-  std::vector<int> buffer;
-  ReadFile<int>(file_name, &buffer);
+  std::vector<uint8_t> buffer;
+  ReadFile<uint8_t>(file_name, &buffer);
+  if (!fbs::opencl::TuneCache::Verify(buffer)) return false;
 
   fbs::opencl::TuneCache cache{buffer};
-  *map_ptr = cache.GetBinaryMap();
+  if (cache.version() > fbs::opencl::TuneCache::kVersion) return false;
+  map_ptr->clear();
+  for (auto& pair : cache.GetBinaryMap()) {
+    // The files of version 0 only hold the kernels tuned on this device.
+    std::string key =
+        cache.version() == 0 ? GetTunedKey(pair.first) : pair.first;
+    map_ptr->emplace(key, pair.second);
+  }
   return true;
 }
 
+std::string CLRuntime::GetTunedDeviceKey() {
+  if (tuned_device_key_.empty()) {
+    tuned_device_key_ = device_->getInfo<CL_DEVICE_NAME>() + "; " +
+                        device_->getInfo<CL_DEVICE_VERSION>() + "; " +
+                        device_->getInfo<CL_DRIVER_VERSION>();
+  }
+  return tuned_device_key_;
+}
+
 std::string CLRuntime::GetSN(const std::string options) {
   // Identifier info(Serial Number) for each binary file: lite version,
   // build options, platform info, device version, driver version
@@ -759,11 +897,32 @@ bool CLRuntime::InitializeDevice() {
     LOG(INFO) << "The chosen device doesn't support the half data type!";
     device_info_["CL_DEVICE_EXTENSIONS_FP16"] = 0;
   }
+  // The dot product of the int8 vectors used by the quantized kernels.
+  if (ext_data.find("cl_arm_integer_dot_product_int8") != std::string::npos) {
+    device_info_["CL_DEVICE_EXTENSIONS_INT8_DOT"] = kInt8DotArm;
+  } else if (ext_data.find("cl_qcom_dot_product8") != std::string::npos) {
+    device_info_["CL_DEVICE_EXTENSIONS_INT8_DOT"] = kInt8DotQcom;
+  } else {
+    device_info_["CL_DEVICE_EXTENSIONS_INT8_DOT"] = kInt8DotNone;
+  }
+  LOG(INFO) << "CL_DEVICE_EXTENSIONS_INT8_DOT:"
+            << device_info_["CL_DEVICE_EXTENSIONS_INT8_DOT"];
 
   auto address_bits = device_->getInfo<CL_DEVICE_ADDRESS_BITS>();
   LOG(INFO) << "CL_DEVICE_ADDRESS_BITS:" << address_bits;
   device_info_["CL_DEVICE_ADDRESS_BITS"] = address_bits;
 
+  // The memory shared with the host, where the buffers created with
+  // CL_MEM_USE_HOST_PTR may avoid the copies.
+  cl_bool host_unified_memory = CL_FALSE;
+  device_->getInfo(CL_DEVICE_HOST_UNIFIED_MEMORY, &host_unified_memory);
+  LOG(INFO) << "CL_DEVICE_HOST_UNIFIED_MEMORY:" << host_unified_memory;
+  device_info_["CL_DEVICE_HOST_UNIFIED_MEMORY"] = host_unified_memory;
+
+  auto mem_base_addr_align = device_->getInfo<CL_DEVICE_MEM_BASE_ADDR_ALIGN>();
+  LOG(INFO) << "CL_DEVICE_MEM_BASE_ADDR_ALIGN:" << mem_base_addr_align;
+  device_info_["CL_DEVICE_MEM_BASE_ADDR_ALIGN"] = mem_base_addr_align;
+
   auto driver_version = device_->getInfo<CL_DRIVER_VERSION>();
   LOG(INFO) << "CL_DRIVER_VERSION:" << driver_version;
 
@@ -860,11 +1019,13 @@ void CLRuntime::set_auto_tune(lite_api::CLTuneMode tune_mode,
   const std::string tuned_file =
       tuned_path_name_.at(0) + "/" + tuned_path_name_.at(1);
   LOG(INFO) << "tuned_file:" << tuned_file;
-  if (IsFileExists(tuned_file) && auto_tune() != lite_api::CL_TUNE_NONE) {
+  // The tuned file shipped with the app is used even if the tuning is off.
+  if (IsFileExists(tuned_file)) {
     LOG(INFO) << "Load tuned file: " << tuned_file;
     bool status = Deserialize(tuned_file, &tuned_lwss_map_);
     if (!status) {
       LOG(WARNING) << "Failed to deserialize tuned file:" << tuned_file;
+      tuned_lwss_map_.clear();
     }
     have_tune_file_flag_ = true;
   } else {
@@ -876,17 +1037,18 @@ void CLRuntime::set_auto_tune(lite_api::CLTuneMode tune_mode,
 bool CLRuntime::HasTunedLocalWorkSizeMap(const std::string& key,
                                          std::vector<int>* tuned_value) {
   bool has = false;
-  auto it = tuned_lwss_map_.find(key);
+  auto it = tuned_lwss_map_.find(GetTunedKey(key));
   if (it != tuned_lwss_map_.end()) {
     *tuned_value = it->second;
     has = true;
   }
+  RuntimeStats::Global().opencl_tune_cache.Record(has);
   return has;
 }
 
 void CLRuntime::SetTunedLocalWorkSizeMap(const std::string& key,
                                          const std::vector<int>& tune_vct) {
-  auto it = tuned_lwss_map_.find(key);
+  auto it = tuned_lwss_map_.find(GetTunedKey(key));
   if (it != tuned_lwss_map_.end()) {
     auto lws_old = it->second;
     LOG(FATAL) << "===> found lws_old with same key, please add more detailed "
@@ -896,7 +1058,15 @@ void CLRuntime::SetTunedLocalWorkSizeMap(const std::string& key,
                << tune_vct[1] << "," << tune_vct[2];
   }
   tuned_lwss_map_.insert(
-      std::pair<std::string, std::vector<int>>(key, tune_vct));
+      std::pair<std::string, std::vector<int>>(GetTunedKey(key), tune_vct));
+  tuned_dirty_ = true;
+}
+
+int64_t CLRuntime::TuneBucket(int64_t extent) const {
+  if (!tune_shape_buckets_ || extent <= 1) return extent;
+  int64_t bucket = 1;
+  while (bucket < extent) bucket <<= 1;
+  return bucket;
 }
 
 double CLRuntime::GetCommandTime(const cl::Event& event) {
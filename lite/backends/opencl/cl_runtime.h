@@ -12,9 +12,11 @@ limitations under the License. */
 #pragma once
 
 #include <fstream>
+#include <future>  // NOLINT
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT
 #include <vector>
 #include "lite/api/paddle_place.h"
 #include "lite/backends/opencl/cl_include.h"
@@ -85,6 +87,28 @@ class CLRuntime {
     return static_cast<bool>(device_info_["CL_DEVICE_EXTENSIONS_FP16"]);
   }
 
+  // The extensions computing the dot product of the int8 vectors.
+  enum Int8DotType { kInt8DotNone = 0, kInt8DotArm = 1, kInt8DotQcom = 2 };
+
+  bool support_int8_dot() { return int8_dot_type() != kInt8DotNone; }
+
+  Int8DotType int8_dot_type() {
+    return static_cast<Int8DotType>(
+        device_info_["CL_DEVICE_EXTENSIONS_INT8_DOT"]);
+  }
+
+  // The build options of the kernels using the int8 dot product.
+  std::string int8_dot_build_options() {
+    switch (int8_dot_type()) {
+      case kInt8DotArm:
+        return " -DINT8_DOT_ARM";
+      case kInt8DotQcom:
+        return " -DINT8_DOT_QCOM";
+      default:
+        return "";
+    }
+  }
+
   bool OpenCLAvaliableForDevice(bool check_fp16_valid = false) {
 // note(ysh329): entered this func means:
 //  1. opencl_lib_found must be true
@@ -120,7 +144,15 @@ class CLRuntime {
 
   size_t lws_repeats() { return lws_repeats_; }
   bool tune_file_flag() { return have_tune_file_flag_; }
-  void set_del_flag() { del_tune_bin_flag_ = true; }
+  // Rewrite the tuned file, which is called once a kernel is tuned.
+  void set_del_flag() { tuned_dirty_ = true; }
+
+  // Tune the local work sizes once per bucket of the spatial extents instead
+  // of once per shape, for the inputs of many shapes.
+  void set_tune_shape_buckets(bool enable) { tune_shape_buckets_ = enable; }
+  bool tune_shape_buckets() const { return tune_shape_buckets_; }
+  // The extent in the tuned keys, rounded up to a power of 2 if bucketed.
+  int64_t TuneBucket(int64_t extent) const;
 
   void set_precision(
       lite_api::CLPrecisionType p = lite_api::CL_PRECISION_AUTO) {
@@ -169,8 +201,18 @@ class CLRuntime {
   cl::Program& GetProgram(const std::string& file_name,
                           const std::string& options);
 
+  // The program of the source generated at runtime, appended to the kernel
+  // file holding its helpers. It's keyed by the file name, a hash of the
+  // source and the options, and saved in the precompiled binary along with
+  // the programs of the kernel files.
+  cl::Program& GetProgram(const std::string& file_name,
+                          const std::string& source,
+                          const std::string& options);
+
   std::unique_ptr<cl::Program> CreateProgramFromSource(
-      const cl::Context& context, std::string file_name);
+      const cl::Context& context,
+      std::string file_name,
+      const std::string& source = "");
 
   bool CheckFromCache(const std::string& program_key);
 
@@ -179,10 +221,20 @@ class CLRuntime {
 
   bool CheckFromSource(const std::string& file_name,
                        const std::string& program_key,
-                       const std::string& build_option);
+                       const std::string& build_option,
+                       const std::string& source = "");
 
   void SaveProgram();
 
+  // Build the programs listed in the program list file saved with the binary
+  // on the background threads, if the binary doesn't exist, e.g. on the first
+  // run of a new device or after a driver update invalidated the binary. The
+  // list file may also be shipped with the app. GetProgram waits for the
+  // program being built instead of building it again.
+  void PrecompileProgramsAsync();
+
+  // Save the tuned local work sizes, merged with the ones of the other
+  // devices and runs saved in the tuned file.
   void SaveTuned();
 
   std::unique_ptr<cl::UserEvent> CreateEvent(const cl::Context& context);
@@ -238,6 +290,21 @@ class CLRuntime {
 
   std::string GetSN(const std::string options);
 
+  std::string GetProgramListFile() const {
+    if (binary_path_name_.size() != 2) return "";
+    return binary_path_name_.at(0) + "/" + binary_path_name_.at(1) +
+           ".programs";
+  }
+
+  // Move the program built on the background threads into programs_.
+  void WaitForAsyncProgram(const std::string& program_key);
+
+  // Thread-safe, returns nullptr on failure.
+  std::shared_ptr<cl::Program> BuildProgramAsync(const std::string& file_name,
+                                                 const std::string& options);
+
+  void JoinAsyncBuilds();
+
   std::shared_ptr<cl::Context> CreateContext() {
     // note(ysh329): gpu perf mode and priority level of adreno gpu referred
     // from xiaomi/mace.
@@ -297,6 +364,13 @@ class CLRuntime {
   bool Deserialize(const std::string file_name,
                    std::map<std::string, std::vector<int>>* map_ptr);
 
+  // The gpu model, the opencl version and the driver version, which prefix
+  // the keys of the tuned local work sizes.
+  std::string GetTunedDeviceKey();
+  std::string GetTunedKey(const std::string& key) {
+    return GetTunedDeviceKey() + "\t" + key;
+  }
+
   std::map<std::string, size_t> device_info_;
 
   GpuType gpu_type_{GpuType::UNKNOWN};
@@ -327,12 +401,18 @@ class CLRuntime {
   lite_api::CLTuneMode auto_tune_{lite_api::CL_TUNE_NONE};
 
   size_t lws_repeats_{0};
+  bool tune_shape_buckets_{false};
 
   // CLPrecisionType
   // 0 - AUTO, 1 - fp32, 2 - fp16
   lite_api::CLPrecisionType precision_{lite_api::CL_PRECISION_AUTO};
 
   std::map<std::string, std::unique_ptr<cl::Program>> programs_;
+  // The programs being built on the background threads.
+  std::map<std::string, std::shared_future<std::shared_ptr<cl::Program>>>
+      async_programs_;
+  std::vector<std::thread> async_builders_;
+  bool program_list_loaded_{false};
   std::map<std::string, cl::Program::Binaries> programs_precompiled_binary_;
   std::map<std::string, std::vector<int>> tuned_lwss_map_;
   std::vector<std::string> binary_path_name_;
@@ -340,8 +420,9 @@ class CLRuntime {
   // magic number for precompiled binary
   const std::string sn_key_{"lite_opencl_precompiled_binary_identifier"};
   bool gotten_bin_flag_{false};
-  bool del_tune_bin_flag_{false};
+  bool tuned_dirty_{false};
   bool have_tune_file_flag_{false};
+  std::string tuned_device_key_;
   // magic number for cl flush judgement
   const int opencl_flush_period_ = 10;
 };
@@ -19,6 +19,7 @@
 #include "lite/backends/opencl/cl_include.h"
 #include "lite/backends/opencl/cl_runtime.h"
 #include "lite/backends/opencl/cl_utility.h"
+#include "lite/core/runtime_stats.h"
 namespace paddle {
 namespace lite {
 
@@ -38,6 +39,130 @@ static cl_channel_type GetCLChannelType(const PrecisionType type) {
   }
 }
 
+static size_t GetCLChannelSize(cl_channel_type type) {
+  switch (type) {
+    case CL_HALF_FLOAT:
+      return 2;
+    case CL_SIGNED_INT8:
+      return 1;
+    default:
+      return 4;
+  }
+}
+
+static bool IsOutOfMemory(cl_int status) {
+  return status == CL_MEM_OBJECT_ALLOCATION_FAILURE ||
+         status == CL_OUT_OF_RESOURCES || status == CL_OUT_OF_HOST_MEMORY;
+}
+
+// Only the memory objects allocated for the outputs, which are neither
+// initialized from nor mapped to the host data, are cached.
+static const cl_mem_flags kPooledMemFlags =
+    CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR;
+enum { kPooledImage = 0, kPooledBuffer = 1 };
+
+std::atomic<bool> CLMemoryPool::enabled_{false};
+std::atomic<size_t> CLMemoryPool::capacity_{256 << 20};
+
+// Set once the pool of the exiting thread is destroyed, so that the memory
+// objects freed after it are released directly.
+static thread_local bool cl_memory_pool_destroyed = false;
+
+CLMemoryPool *CLMemoryPool::Current() {
+  if (!enabled_ || cl_memory_pool_destroyed) return nullptr;
+  thread_local CLMemoryPool pool(CLRuntime::Global()->context()());
+  return &pool;
+}
+
+void CLMemoryPool::set_enabled(bool enabled) {
+  if (!enabled) {
+    // Release the objects cached by the calling thread, the pools of the
+    // other threads are released when they exit.
+    auto pool = Current();
+    if (pool) pool->Trim();
+  }
+  enabled_ = enabled;
+}
+
+static void DestroyPooledMemory(int kind, cl::Memory *memory) {
+  if (kind == kPooledImage) {
+    delete static_cast<cl::Image2D *>(memory);
+  } else {
+    delete static_cast<cl::Buffer *>(memory);
+  }
+}
+
+CLMemoryPool::~CLMemoryPool() {
+  Trim();
+  cl_memory_pool_destroyed = true;
+}
+
+cl::Memory *CLMemoryPool::Acquire(const Key &key) {
+  auto it = entries_.find(key);
+  bool hit = it != entries_.end();
+  RuntimeStats::Global().opencl_memory_pool.Record(hit);
+  if (!hit) return nullptr;
+  auto memory = it->second.memory;
+  cached_size_ -= it->second.bytes;
+  entries_.erase(it);
+  return memory;
+}
+
+bool CLMemoryPool::Release(const Key &key, cl::Memory *memory, size_t bytes) {
+  if (bytes > capacity_) return false;
+  if (memory->getInfo<CL_MEM_FLAGS>() != kPooledMemFlags) return false;
+  if (memory->getInfo<CL_MEM_CONTEXT>()() != context_) return false;
+  Evict(bytes);
+  entries_.emplace(key, Entry{memory, bytes, stamp_++});
+  cached_size_ += bytes;
+  return true;
+}
+
+void CLMemoryPool::Evict(size_t bytes) {
+  while (!entries_.empty() && cached_size_ + bytes > capacity_) {
+    auto oldest = entries_.begin();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (it->second.stamp < oldest->second.stamp) oldest = it;
+    }
+    cached_size_ -= oldest->second.bytes;
+    DestroyPooledMemory(std::get<0>(oldest->first), oldest->second.memory);
+    entries_.erase(oldest);
+  }
+}
+
+void CLMemoryPool::Trim() {
+  for (auto &entry : entries_) {
+    DestroyPooledMemory(std::get<0>(entry.first), entry.second.memory);
+  }
+  entries_.clear();
+  cached_size_ = 0;
+}
+
+cl::Image2D *CLMemoryPool::AcquireImage(cl_channel_type type,
+                                        size_t width,
+                                        size_t height) {
+  return static_cast<cl::Image2D *>(
+      Acquire(Key(kPooledImage, type, width, height)));
+}
+
+cl::Buffer *CLMemoryPool::AcquireBuffer(size_t size) {
+  return static_cast<cl::Buffer *>(Acquire(Key(kPooledBuffer, 0, size, 0)));
+}
+
+bool CLMemoryPool::ReleaseImage(cl::Image2D *image) {
+  auto type = image->getImageInfo<CL_IMAGE_FORMAT>().image_channel_data_type;
+  auto width = image->getImageInfo<CL_IMAGE_WIDTH>();
+  auto height = image->getImageInfo<CL_IMAGE_HEIGHT>();
+  return Release(Key(kPooledImage, type, width, height),
+                 image,
+                 width * height * 4 * GetCLChannelSize(type));
+}
+
+bool CLMemoryPool::ReleaseBuffer(cl::Buffer *buffer) {
+  auto size = buffer->getInfo<CL_MEM_SIZE>();
+  return Release(Key(kPooledBuffer, 0, size, 0), buffer, size);
+}
+
 bool BufferValid(const size_t req_size) {
   bool valid = true;
   std::map<std::string, size_t> &dev_map = CLRuntime::Global()->GetDeviceInfo();
@@ -57,12 +182,23 @@ bool BufferValid(const size_t req_size) {
 
 void *TargetWrapperCL::Malloc(size_t size) {
   BufferValid(size);
+  auto pool = CLMemoryPool::Current();
+  if (pool) {
+    auto buffer = pool->AcquireBuffer(size);
+    if (buffer) return buffer;
+  }
   cl_int status;
-  cl::Buffer *buffer = new cl::Buffer(CLRuntime::Global()->context(),
-                                      CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR,
-                                      size,
-                                      nullptr,
-                                      &status);
+  cl::Buffer *buffer = new cl::Buffer(
+      CLRuntime::Global()->context(), kPooledMemFlags, size, nullptr, &status);
+  if (IsOutOfMemory(status) && pool && pool->cached_size() > 0) {
+    delete buffer;
+    pool->Trim();
+    buffer = new cl::Buffer(CLRuntime::Global()->context(),
+                            kPooledMemFlags,
+                            size,
+                            nullptr,
+                            &status);
+  }
   if (status != CL_SUCCESS) {
     delete buffer;
     buffer = nullptr;
@@ -74,6 +210,8 @@ void *TargetWrapperCL::Malloc(size_t size) {
 void TargetWrapperCL::Free(void *ptr) {
   if (ptr != nullptr) {
     cl::Buffer *cl_buffer = static_cast<cl::Buffer *>(ptr);
+    auto pool = CLMemoryPool::Current();
+    if (pool && pool->ReleaseBuffer(cl_buffer)) return;
     delete cl_buffer;
   }
 }
@@ -101,23 +239,42 @@ bool ImageValid(const size_t req_img_w, const size_t req_img_h) {
   return valid;
 }
 
-template <>
-void *TargetWrapperCL::MallocImage<float>(const size_t cl_image2d_width,
-                                          const size_t cl_image2d_height,
-                                          void *host_ptr) {
+static void *MallocImage2D(PrecisionType precision,
+                           const size_t cl_image2d_width,
+                           const size_t cl_image2d_height,
+                           void *host_ptr) {
   ImageValid(cl_image2d_width, cl_image2d_height);
-  cl::ImageFormat img_format(CL_RGBA, GetCLChannelType(PRECISION(kFloat)));
+  auto channel_type = GetCLChannelType(precision);
+  auto pool = host_ptr ? nullptr : CLMemoryPool::Current();
+  if (pool) {
+    auto cl_image =
+        pool->AcquireImage(channel_type, cl_image2d_width, cl_image2d_height);
+    if (cl_image) return cl_image;
+  }
+  cl::ImageFormat img_format(CL_RGBA, channel_type);
+  cl_mem_flags flags = host_ptr ? CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR
+                                : kPooledMemFlags;
   cl_int status;
-  cl::Image2D *cl_image = new cl::Image2D(
-      CLRuntime::Global()->context(),
-      (host_ptr ? CL_MEM_READ_ONLY : CL_MEM_READ_WRITE) |
-          (host_ptr ? CL_MEM_COPY_HOST_PTR : CL_MEM_ALLOC_HOST_PTR),
-      img_format,
-      cl_image2d_width,
-      cl_image2d_height,
-      0,
-      host_ptr,
-      &status);
+  cl::Image2D *cl_image = new cl::Image2D(CLRuntime::Global()->context(),
+                                          flags,
+                                          img_format,
+                                          cl_image2d_width,
+                                          cl_image2d_height,
+                                          0,
+                                          host_ptr,
+                                          &status);
+  if (IsOutOfMemory(status) && pool && pool->cached_size() > 0) {
+    delete cl_image;
+    pool->Trim();
+    cl_image = new cl::Image2D(CLRuntime::Global()->context(),
+                               flags,
+                               img_format,
+                               cl_image2d_width,
+                               cl_image2d_height,
+                               0,
+                               host_ptr,
+                               &status);
+  }
   if (status != CL_SUCCESS) {
     delete cl_image;
     cl_image = nullptr;
@@ -126,59 +283,35 @@ void *TargetWrapperCL::MallocImage<float>(const size_t cl_image2d_width,
   return cl_image;
 }
 
+template <>
+void *TargetWrapperCL::MallocImage<float>(const size_t cl_image2d_width,
+                                          const size_t cl_image2d_height,
+                                          void *host_ptr) {
+  return MallocImage2D(
+      PRECISION(kFloat), cl_image2d_width, cl_image2d_height, host_ptr);
+}
+
 template <>  // use uint16_t represents half float
 void *TargetWrapperCL::MallocImage<uint16_t>(const size_t cl_image2d_width,
                                              const size_t cl_image2d_height,
                                              void *host_ptr) {
-  ImageValid(cl_image2d_width, cl_image2d_height);
-  cl::ImageFormat img_format(CL_RGBA, GetCLChannelType(PRECISION(kFP16)));
-  cl_int status;
-  cl::Image2D *cl_image = new cl::Image2D(
-      CLRuntime::Global()->context(),
-      (host_ptr ? CL_MEM_READ_ONLY : CL_MEM_READ_WRITE) |
-          (host_ptr ? CL_MEM_COPY_HOST_PTR : CL_MEM_ALLOC_HOST_PTR),
-      img_format,
-      cl_image2d_width,
-      cl_image2d_height,
-      0,
-      host_ptr,
-      &status);
-  if (status != CL_SUCCESS) {
-    delete cl_image;
-    cl_image = nullptr;
-  }
-  CL_CHECK_FATAL(status);
-  return cl_image;
+  return MallocImage2D(
+      PRECISION(kFP16), cl_image2d_width, cl_image2d_height, host_ptr);
 }
 
 template <>
 void *TargetWrapperCL::MallocImage<int32_t>(const size_t cl_image2d_width,
                                             const size_t cl_image2d_height,
                                             void *host_ptr) {
-  ImageValid(cl_image2d_width, cl_image2d_height);
-  cl::ImageFormat img_format(CL_RGBA, GetCLChannelType(PRECISION(kInt32)));
-  cl_int status;
-  cl::Image2D *cl_image = new cl::Image2D(
-      CLRuntime::Global()->context(),
-      (host_ptr ? CL_MEM_READ_ONLY : CL_MEM_READ_WRITE) |
-          (host_ptr ? CL_MEM_COPY_HOST_PTR : CL_MEM_ALLOC_HOST_PTR),
-      img_format,
-      cl_image2d_width,
-      cl_image2d_height,
-      0,
-      host_ptr,
-      &status);
-  if (status != CL_SUCCESS) {
-    delete cl_image;
-    cl_image = nullptr;
-  }
-  CL_CHECK_FATAL(status);
-  return cl_image;
+  return MallocImage2D(
+      PRECISION(kInt32), cl_image2d_width, cl_image2d_height, host_ptr);
 }
 
 void TargetWrapperCL::FreeImage(void *image) {
   if (image != nullptr) {
     cl::Image2D *cl_image = static_cast<cl::Image2D *>(image);
+    auto pool = CLMemoryPool::Current();
+    if (pool && pool->ReleaseImage(cl_image)) return;
     delete cl_image;
   }
 }
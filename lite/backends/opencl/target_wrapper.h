@@ -14,12 +14,72 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <tuple>
 #include "lite/backends/opencl/cl_include.h"
 #include "lite/core/target_wrapper.h"
 
 namespace paddle {
 namespace lite {
 
+// The cache of the freed images and buffers of the OpenCL context of the
+// calling thread, which backs TargetWrapperCL::Malloc(Image) and Free(Image).
+// The memory objects are kept by their exact format and size, since the
+// kernels query the size of the objects they get, and reused by the tensors
+// of all the predictors sharing the context, e.g. when the memory optimize
+// pass reuses a var for another shape or a predictor is rebuilt. The oldest
+// cached objects are released once the cached bytes exceed the capacity, and
+// all of them before an allocation is retried for the out of memory error.
+class CLMemoryPool {
+ public:
+  // Returns nullptr if the pool is disabled.
+  static CLMemoryPool* Current();
+
+  static void set_enabled(bool enabled);
+  static bool enabled() { return enabled_; }
+  static void set_capacity(size_t capacity) { capacity_ = capacity; }
+  static size_t capacity() { return capacity_; }
+
+  // Returns nullptr if no memory object of the same size is cached.
+  cl::Image2D* AcquireImage(cl_channel_type type, size_t width, size_t height);
+  cl::Buffer* AcquireBuffer(size_t size);
+  // Returns false if the memory object can't be cached, e.g. it's created
+  // with the host data, and the caller should release it.
+  bool ReleaseImage(cl::Image2D* image);
+  bool ReleaseBuffer(cl::Buffer* buffer);
+
+  // Release the cached memory objects.
+  void Trim();
+  size_t cached_size() const { return cached_size_; }
+
+  ~CLMemoryPool();
+
+ private:
+  // The kind(image or buffer), the channel type, and the width and height of
+  // the image or the bytes of the buffer.
+  using Key = std::tuple<int, cl_channel_type, size_t, size_t>;
+  struct Entry {
+    cl::Memory* memory;
+    size_t bytes;
+    uint64_t stamp;
+  };
+
+  explicit CLMemoryPool(cl_context context) : context_(context) {}
+  cl::Memory* Acquire(const Key& key);
+  bool Release(const Key& key, cl::Memory* memory, size_t bytes);
+  // Release the oldest cached memory objects until the bytes fit.
+  void Evict(size_t bytes);
+
+  static std::atomic<bool> enabled_;
+  static std::atomic<size_t> capacity_;
+  cl_context context_{nullptr};
+  std::multimap<Key, Entry> entries_;
+  size_t cached_size_{0};
+  uint64_t stamp_{0};
+};
+
 using TargetWrapperCL =
     TargetWrapper<TARGET(kOpenCL), cl::CommandQueue, cl::Event>;
 // This interface should be specified by each kind of target.
@@ -71,11 +71,20 @@ flatbuffers::DetachedBuffer Cache::SyncToFbs() const {
 }
 
 // Tuned Cache: for Tuned file
-TuneCache::TuneCache(const std::vector<int>& buffer) {
+const uint32_t TuneCache::kVersion;
+
+TuneCache::TuneCache(const std::vector<uint8_t>& buffer) {
+  CHECK(Verify(buffer)) << "OpenCL TuneCache verification failed.";
   SyncFromFbs(proto::GetTuneCache(buffer.data()));
 }
 
-void TuneCache::CopyDataToBuffer(std::vector<int>* buffer) const {
+bool TuneCache::Verify(const std::vector<uint8_t>& buffer) {
+  flatbuffers::Verifier verifier(buffer.data(), buffer.size());
+  return verifier.VerifyBuffer<paddle::lite::fbs::opencl::proto::TuneCache>(
+      nullptr);
+}
+
+void TuneCache::CopyDataToBuffer(std::vector<uint8_t>* buffer) const {
   CHECK(buffer);
   flatbuffers::DetachedBuffer buf{SyncToFbs()};
   buffer->resize(buf.size());
@@ -87,6 +96,7 @@ void TuneCache::CopyDataToBuffer(std::vector<int>* buffer) const {
 void TuneCache::SyncFromFbs(
     const paddle::lite::fbs::opencl::proto::TuneCache* desc) {
   CHECK(desc);
+  version_ = desc->version();
   const auto* tune_map_desc = desc->tune_map();
   CHECK(tune_map_desc);
   for (const auto& pair : *tune_map_desc) {
@@ -108,7 +118,7 @@ flatbuffers::DetachedBuffer TuneCache::SyncToFbs() const {
     tune_map.emplace_back(proto::TuneCache_::CreateTunePairDirect(
         fbb, pair.first.c_str(), &pair.second));
   }
-  fbb.Finish(proto::CreateTuneCacheDirect(fbb, &tune_map));
+  fbb.Finish(proto::CreateTuneCacheDirect(fbb, &tune_map, version_));
   return fbb.Release();
 }
 
@@ -45,18 +45,26 @@ class Cache {
 
 class TuneCache {
  public:
-  explicit TuneCache(const std::map<std::string, std::vector<int>>& map)
-      : tune_map_{map} {}
-  explicit TuneCache(const std::vector<int>& buffer);
-  void CopyDataToBuffer(std::vector<int>* buffer) const;
+  // The version of the tuned files whose keys are prefixed by the device.
+  static const uint32_t kVersion = 1;
+
+  explicit TuneCache(const std::map<std::string, std::vector<int>>& map,
+                     uint32_t version = kVersion)
+      : tune_map_{map}, version_{version} {}
+  explicit TuneCache(const std::vector<uint8_t>& buffer);
+  // Whether `buffer` holds a valid tuned file.
+  static bool Verify(const std::vector<uint8_t>& buffer);
+  void CopyDataToBuffer(std::vector<uint8_t>* buffer) const;
   const std::map<std::string, std::vector<int>>& GetBinaryMap() const {
     return tune_map_;
   }
+  uint32_t version() const { return version_; }
 
  private:
   void SyncFromFbs(const paddle::lite::fbs::opencl::proto::TuneCache* desc);
   flatbuffers::DetachedBuffer SyncToFbs() const;
   std::map<std::string, std::vector<int>> tune_map_;
+  uint32_t version_{kVersion};
 };
 
 }  // namespace opencl
@@ -40,12 +40,29 @@ TEST(OpenCLTunedCache, tuned_cache) {
       {"a", {1, 1, 1}}, {"b", {1, 1, 2}},
   };
   TuneCache cache_0{map};
-  std::vector<int> buffer;
+  std::vector<uint8_t> buffer;
   cache_0.CopyDataToBuffer(&buffer);
 
+  CHECK(TuneCache::Verify(buffer));
   TuneCache cache_1{buffer};
   CHECK(map == cache_1.GetBinaryMap())
       << "Cache read and write are not equivalent, the test failed.";
+  CHECK_EQ(cache_1.version(), TuneCache::kVersion);
+}
+
+TEST(OpenCLTunedCache, legacy_version) {
+  const std::map<std::string, std::vector<int>> map{{"a", {1, 1, 1}}};
+  TuneCache cache_0{map, 0};
+  std::vector<uint8_t> buffer;
+  cache_0.CopyDataToBuffer(&buffer);
+
+  TuneCache cache_1{buffer};
+  CHECK(map == cache_1.GetBinaryMap());
+  CHECK_EQ(cache_1.version(), 0u);
+
+  // A truncated file is rejected.
+  buffer.resize(buffer.size() / 2);
+  CHECK(!TuneCache::Verify(buffer));
 }
 
 }  // namespace opencl
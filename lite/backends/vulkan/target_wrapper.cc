@@ -0,0 +1,62 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/vulkan/target_wrapper.h"
+#include <cstring>
+
+namespace paddle {
+namespace lite {
+
+void* TargetWrapperVK::Malloc(size_t size) {
+  return VKRuntime::Global()->CreateBuffer(size);
+}
+
+void TargetWrapperVK::Free(void* ptr) {
+  VKRuntime::Global()->DestroyBuffer(static_cast<VKBuffer*>(ptr));
+}
+
+void TargetWrapperVK::MemcpySync(void* dst,
+                                 const void* src,
+                                 size_t size,
+                                 IoDirection dir) {
+  if (size == 0) return;
+  VKRuntime::Global()->Flush();
+  switch (dir) {
+    case IoDirection::DtoD: {
+      auto* dst_buffer = static_cast<VKBuffer*>(dst);
+      auto* src_buffer = static_cast<const VKBuffer*>(src);
+      CHECK_LE(size, dst_buffer->size);
+      CHECK_LE(size, src_buffer->size);
+      memcpy(dst_buffer->mapped, src_buffer->mapped, size);
+      break;
+    }
+    case IoDirection::HtoD: {
+      auto* dst_buffer = static_cast<VKBuffer*>(dst);
+      CHECK_LE(size, dst_buffer->size);
+      memcpy(dst_buffer->mapped, src, size);
+      break;
+    }
+    case IoDirection::DtoH: {
+      auto* src_buffer = static_cast<const VKBuffer*>(src);
+      CHECK_LE(size, src_buffer->size);
+      memcpy(dst, src_buffer->mapped, size);
+      break;
+    }
+    default:
+      LOG(FATAL) << "Unsupported IoDirection " << static_cast<int>(dir);
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,509 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/vulkan/vk_runtime.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+
+namespace paddle {
+namespace lite {
+
+// Generated from lite/backends/vulkan/glsl by gen_vulkan_code.py, the SPIR-V
+// words keyed by the shader names.
+extern const std::map<std::string, std::vector<uint32_t>> vulkan_shaders_spirv;
+
+std::string VKRuntime::pipeline_cache_path_;  // NOLINT
+
+VKRuntime* VKRuntime::Global() {
+  static VKRuntime* runtime = new VKRuntime;
+  return runtime;
+}
+
+void VKRuntime::set_pipeline_cache_path(const std::string& path) {
+  pipeline_cache_path_ = path;
+}
+
+const std::string& VKRuntime::pipeline_cache_path() {
+  return pipeline_cache_path_;
+}
+
+VKRuntime::VKRuntime() {
+  is_init_success_ = Init();
+  if (!is_init_success_) {
+    LOG(ERROR) << "Vulkan runtime init failed";
+  }
+}
+
+bool VKRuntime::Init() {
+  auto* vk = VKWrapper::Global();
+  if (!vk->VulkanLibFound() || !vk->DlsymSuccess()) return false;
+  if (!CreateInstance() || !CreateDevice() || !CreateCommandObjects()) {
+    return false;
+  }
+  CreatePipelineCache();
+  LOG(INFO) << "Vulkan device: " << device_properties_.deviceName
+            << ", api version: "
+            << VK_VERSION_MAJOR(device_properties_.apiVersion) << "."
+            << VK_VERSION_MINOR(device_properties_.apiVersion)
+            << ", driver version: " << device_properties_.driverVersion;
+  return true;
+}
+
+bool VKRuntime::CreateInstance() {
+  auto* vk = VKWrapper::Global();
+  VkApplicationInfo app_info = {};
+  app_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+  app_info.pApplicationName = "PaddleLite";
+  app_info.pEngineName = "PaddleLite";
+  app_info.apiVersion = VK_API_VERSION_1_0;
+  VkInstanceCreateInfo instance_info = {};
+  instance_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+  instance_info.pApplicationInfo = &app_info;
+  if (vk->vkCreateInstance(&instance_info, nullptr, &instance_) !=
+      VK_SUCCESS) {
+    LOG(ERROR) << "vkCreateInstance failed";
+    return false;
+  }
+  return vk->LoadInstanceFunctions(instance_);
+}
+
+bool VKRuntime::CreateDevice() {
+  auto* vk = VKWrapper::Global();
+  uint32_t num_devices = 0;
+  vk->vkEnumeratePhysicalDevices(instance_, &num_devices, nullptr);
+  std::vector<VkPhysicalDevice> devices(num_devices);
+  vk->vkEnumeratePhysicalDevices(instance_, &num_devices, devices.data());
+  // Prefer the gpus to the software implementations, e.g. SwiftShader.
+  int best_score = -1;
+  for (auto device : devices) {
+    VkPhysicalDeviceProperties properties;
+    vk->vkGetPhysicalDeviceProperties(device, &properties);
+    uint32_t num_families = 0;
+    vk->vkGetPhysicalDeviceQueueFamilyProperties(
+        device, &num_families, nullptr);
+    std::vector<VkQueueFamilyProperties> families(num_families);
+    vk->vkGetPhysicalDeviceQueueFamilyProperties(
+        device, &num_families, families.data());
+    for (uint32_t i = 0; i < num_families; i++) {
+      if (!(families[i].queueFlags & VK_QUEUE_COMPUTE_BIT)) continue;
+      int score = 0;
+      if (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU ||
+          properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) {
+        score = 2;
+      } else if (properties.deviceType != VK_PHYSICAL_DEVICE_TYPE_CPU) {
+        score = 1;
+      }
+      if (score > best_score) {
+        best_score = score;
+        physical_device_ = device;
+        device_properties_ = properties;
+        queue_family_ = i;
+      }
+      break;
+    }
+  }
+  if (physical_device_ == VK_NULL_HANDLE) {
+    LOG(ERROR) << "No Vulkan device supports the compute queue";
+    return false;
+  }
+  vk->vkGetPhysicalDeviceMemoryProperties(physical_device_,
+                                          &memory_properties_);
+
+  float priority = 1.f;
+  VkDeviceQueueCreateInfo queue_info = {};
+  queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+  queue_info.queueFamilyIndex = queue_family_;
+  queue_info.queueCount = 1;
+  queue_info.pQueuePriorities = &priority;
+  VkDeviceCreateInfo device_info = {};
+  device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+  device_info.queueCreateInfoCount = 1;
+  device_info.pQueueCreateInfos = &queue_info;
+  if (vk->vkCreateDevice(physical_device_, &device_info, nullptr, &device_) !=
+      VK_SUCCESS) {
+    LOG(ERROR) << "vkCreateDevice failed";
+    return false;
+  }
+  vk->vkGetDeviceQueue(device_, queue_family_, 0, &queue_);
+  return true;
+}
+
+bool VKRuntime::CreateCommandObjects() {
+  auto* vk = VKWrapper::Global();
+  VkCommandPoolCreateInfo pool_info = {};
+  pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+  pool_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+  pool_info.queueFamilyIndex = queue_family_;
+  if (vk->vkCreateCommandPool(device_, &pool_info, nullptr, &command_pool_) !=
+      VK_SUCCESS) {
+    return false;
+  }
+  VkCommandBufferAllocateInfo command_info = {};
+  command_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+  command_info.commandPool = command_pool_;
+  command_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+  command_info.commandBufferCount = 1;
+  if (vk->vkAllocateCommandBuffers(device_, &command_info, &command_buffer_) !=
+      VK_SUCCESS) {
+    return false;
+  }
+  VkFenceCreateInfo fence_info = {};
+  fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+  if (vk->vkCreateFence(device_, &fence_info, nullptr, &fence_) !=
+      VK_SUCCESS) {
+    return false;
+  }
+  VkDescriptorPoolSize pool_size = {};
+  pool_size.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  pool_size.descriptorCount = kMaxDescriptorSets * kMaxBuffersPerSet;
+  VkDescriptorPoolCreateInfo descriptor_info = {};
+  descriptor_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  descriptor_info.maxSets = kMaxDescriptorSets;
+  descriptor_info.poolSizeCount = 1;
+  descriptor_info.pPoolSizes = &pool_size;
+  return vk->vkCreateDescriptorPool(
+             device_, &descriptor_info, nullptr, &descriptor_pool_) ==
+         VK_SUCCESS;
+}
+
+void VKRuntime::CreatePipelineCache() {
+  // The driver validates the header of the data, and ignores the data of
+  // another device or driver version.
+  std::vector<char> data;
+  if (!pipeline_cache_path_.empty()) {
+    std::ifstream file(pipeline_cache_path_, std::ios::binary);
+    if (file.is_open()) {
+      data.assign(std::istreambuf_iterator<char>(file),
+                  std::istreambuf_iterator<char>());
+      VLOG(3) << "Load " << data.size() << " bytes of the pipeline cache from "
+              << pipeline_cache_path_;
+    }
+  }
+  VkPipelineCacheCreateInfo cache_info = {};
+  cache_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  cache_info.initialDataSize = data.size();
+  cache_info.pInitialData = data.empty() ? nullptr : data.data();
+  if (VKWrapper::Global()->vkCreatePipelineCache(
+          device_, &cache_info, nullptr, &pipeline_cache_) != VK_SUCCESS) {
+    LOG(WARNING) << "Failed to create the pipeline cache";
+    pipeline_cache_ = VK_NULL_HANDLE;
+  }
+}
+
+int VKRuntime::FindMemoryType(uint32_t type_bits) const {
+  const VkMemoryPropertyFlags host_flags =
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+      VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+  const VkMemoryPropertyFlags preferred_flags[] = {
+      host_flags | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, host_flags};
+  for (auto flags : preferred_flags) {
+    for (uint32_t i = 0; i < memory_properties_.memoryTypeCount; i++) {
+      if ((type_bits & (1u << i)) &&
+          (memory_properties_.memoryTypes[i].propertyFlags & flags) == flags) {
+        return static_cast<int>(i);
+      }
+    }
+  }
+  return -1;
+}
+
+VKBuffer* VKRuntime::CreateBuffer(size_t size) {
+  CHECK(is_init_success_) << "Vulkan runtime init failed";
+  auto* vk = VKWrapper::Global();
+  std::unique_ptr<VKBuffer> buffer(new VKBuffer);
+  buffer->size = size;
+  VkBufferCreateInfo buffer_info = {};
+  buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  // The empty buffers can't be created.
+  buffer_info.size = std::max<size_t>(size, 4);
+  buffer_info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                      VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                      VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+  buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  VK_CHECK_FATAL(
+      vk->vkCreateBuffer(device_, &buffer_info, nullptr, &buffer->buffer));
+  VkMemoryRequirements requirements;
+  vk->vkGetBufferMemoryRequirements(device_, buffer->buffer, &requirements);
+  int memory_type = FindMemoryType(requirements.memoryTypeBits);
+  CHECK_GE(memory_type, 0) << "No host visible memory for the buffers";
+  VkMemoryAllocateInfo memory_info = {};
+  memory_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+  memory_info.allocationSize = requirements.size;
+  memory_info.memoryTypeIndex = static_cast<uint32_t>(memory_type);
+  VK_CHECK_FATAL(
+      vk->vkAllocateMemory(device_, &memory_info, nullptr, &buffer->memory));
+  VK_CHECK_FATAL(
+      vk->vkBindBufferMemory(device_, buffer->buffer, buffer->memory, 0));
+  VK_CHECK_FATAL(vk->vkMapMemory(
+      device_, buffer->memory, 0, VK_WHOLE_SIZE, 0, &buffer->mapped));
+  return buffer.release();
+}
+
+void VKRuntime::DestroyBuffer(VKBuffer* buffer) {
+  if (buffer == nullptr) return;
+  auto* vk = VKWrapper::Global();
+  {
+    // The recorded dispatches may still use the buffer.
+    std::lock_guard<std::mutex> lock(mutex_);
+    FlushLocked();
+  }
+  vk->vkUnmapMemory(device_, buffer->memory);
+  vk->vkDestroyBuffer(device_, buffer->buffer, nullptr);
+  vk->vkFreeMemory(device_, buffer->memory, nullptr);
+  delete buffer;
+}
+
+const VKPipeline* VKRuntime::GetPipeline(const std::string& shader,
+                                         uint32_t num_buffers,
+                                         uint32_t push_constant_size) {
+  CHECK(is_init_success_) << "Vulkan runtime init failed";
+  CHECK_LE(num_buffers, kMaxBuffersPerSet);
+  CHECK_EQ(push_constant_size % 4, 0u);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = pipelines_.find(shader);
+  if (it != pipelines_.end()) {
+    CHECK_EQ(it->second->num_buffers, num_buffers) << shader;
+    CHECK_EQ(it->second->push_constant_size, push_constant_size) << shader;
+    return it->second.get();
+  }
+  auto spirv = vulkan_shaders_spirv.find(shader);
+  CHECK(spirv != vulkan_shaders_spirv.end())
+      << "Can't find the SPIR-V of the shader " << shader;
+
+  auto* vk = VKWrapper::Global();
+  std::unique_ptr<VKPipeline> pipeline(new VKPipeline);
+  pipeline->num_buffers = num_buffers;
+  pipeline->push_constant_size = push_constant_size;
+  std::vector<VkDescriptorSetLayoutBinding> bindings(num_buffers);
+  for (uint32_t i = 0; i < num_buffers; i++) {
+    bindings[i] = {};
+    bindings[i].binding = i;
+    bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[i].descriptorCount = 1;
+    bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+  }
+  VkDescriptorSetLayoutCreateInfo set_layout_info = {};
+  set_layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  set_layout_info.bindingCount = num_buffers;
+  set_layout_info.pBindings = bindings.data();
+  VK_CHECK_FATAL(vk->vkCreateDescriptorSetLayout(
+      device_, &set_layout_info, nullptr, &pipeline->set_layout));
+
+  VkPushConstantRange push_constant_range = {};
+  push_constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+  push_constant_range.size = push_constant_size;
+  VkPipelineLayoutCreateInfo layout_info = {};
+  layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+  layout_info.setLayoutCount = 1;
+  layout_info.pSetLayouts = &pipeline->set_layout;
+  layout_info.pushConstantRangeCount = push_constant_size > 0 ? 1 : 0;
+  layout_info.pPushConstantRanges = &push_constant_range;
+  VK_CHECK_FATAL(vk->vkCreatePipelineLayout(
+      device_, &layout_info, nullptr, &pipeline->layout));
+
+  VkShaderModuleCreateInfo module_info = {};
+  module_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+  module_info.codeSize = spirv->second.size() * sizeof(uint32_t);
+  module_info.pCode = spirv->second.data();
+  VkShaderModule module;
+  VK_CHECK_FATAL(
+      vk->vkCreateShaderModule(device_, &module_info, nullptr, &module));
+  VkComputePipelineCreateInfo pipeline_info = {};
+  pipeline_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+  pipeline_info.stage.sType =
+      VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+  pipeline_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+  pipeline_info.stage.module = module;
+  pipeline_info.stage.pName = "main";
+  pipeline_info.layout = pipeline->layout;
+  VkResult result = vk->vkCreateComputePipelines(device_,
+                                                 pipeline_cache_,
+                                                 1,
+                                                 &pipeline_info,
+                                                 nullptr,
+                                                 &pipeline->pipeline);
+  vk->vkDestroyShaderModule(device_, module, nullptr);
+  CHECK_EQ(result, VK_SUCCESS) << "Failed to create the pipeline of "
+                               << shader;
+  pipeline_cache_dirty_ = true;
+  auto* ptr = pipeline.get();
+  pipelines_[shader] = std::move(pipeline);
+  return ptr;
+}
+
+void VKRuntime::Dispatch(const VKPipeline* pipeline,
+                         const std::vector<const VKBuffer*>& buffers,
+                         const void* push_constants,
+                         size_t total) {
+  CHECK(pipeline);
+  CHECK_EQ(buffers.size(), pipeline->num_buffers);
+  if (total == 0) return;
+  auto* vk = VKWrapper::Global();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (num_recorded_ == kMaxDescriptorSets) {
+    FlushLocked();
+  }
+  if (num_recorded_ == 0) {
+    VkCommandBufferBeginInfo begin_info = {};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    VK_CHECK_FATAL(vk->vkBeginCommandBuffer(command_buffer_, &begin_info));
+  } else {
+    // The kernels run in the order of the program, each one reads what the
+    // previous ones write.
+    VkMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask =
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vk->vkCmdPipelineBarrier(command_buffer_,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0,
+                             1,
+                             &barrier,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+  }
+
+  VkDescriptorSetAllocateInfo set_info = {};
+  set_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  set_info.descriptorPool = descriptor_pool_;
+  set_info.descriptorSetCount = 1;
+  set_info.pSetLayouts = &pipeline->set_layout;
+  VkDescriptorSet descriptor_set;
+  VK_CHECK_FATAL(
+      vk->vkAllocateDescriptorSets(device_, &set_info, &descriptor_set));
+  std::vector<VkDescriptorBufferInfo> buffer_infos(buffers.size());
+  std::vector<VkWriteDescriptorSet> writes(buffers.size());
+  for (size_t i = 0; i < buffers.size(); i++) {
+    CHECK(buffers[i]);
+    buffer_infos[i].buffer = buffers[i]->buffer;
+    buffer_infos[i].offset = 0;
+    buffer_infos[i].range = VK_WHOLE_SIZE;
+    writes[i] = {};
+    writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writes[i].dstSet = descriptor_set;
+    writes[i].dstBinding = static_cast<uint32_t>(i);
+    writes[i].descriptorCount = 1;
+    writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    writes[i].pBufferInfo = &buffer_infos[i];
+  }
+  vk->vkUpdateDescriptorSets(device_,
+                             static_cast<uint32_t>(writes.size()),
+                             writes.data(),
+                             0,
+                             nullptr);
+
+  vk->vkCmdBindPipeline(
+      command_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline->pipeline);
+  vk->vkCmdBindDescriptorSets(command_buffer_,
+                              VK_PIPELINE_BIND_POINT_COMPUTE,
+                              pipeline->layout,
+                              0,
+                              1,
+                              &descriptor_set,
+                              0,
+                              nullptr);
+  if (pipeline->push_constant_size > 0) {
+    vk->vkCmdPushConstants(command_buffer_,
+                           pipeline->layout,
+                           VK_SHADER_STAGE_COMPUTE_BIT,
+                           0,
+                           pipeline->push_constant_size,
+                           push_constants);
+  }
+  // The group count of a dimension may be limited to 65535, so the groups
+  // are laid out in two dimensions for the large tensors.
+  size_t groups = (total + kWorkGroupSize - 1) / kWorkGroupSize;
+  size_t max_groups = device_properties_.limits.maxComputeWorkGroupCount[0];
+  uint32_t group_x = static_cast<uint32_t>(std::min(groups, max_groups));
+  uint32_t group_y = static_cast<uint32_t>((groups + group_x - 1) / group_x);
+  vk->vkCmdDispatch(command_buffer_, group_x, group_y, 1);
+  num_recorded_++;
+}
+
+void VKRuntime::Flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  FlushLocked();
+}
+
+void VKRuntime::FlushLocked() {
+  if (num_recorded_ == 0) return;
+  auto* vk = VKWrapper::Global();
+  VkMemoryBarrier barrier = {};
+  barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+  barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+  vk->vkCmdPipelineBarrier(command_buffer_,
+                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                           VK_PIPELINE_STAGE_HOST_BIT,
+                           0,
+                           1,
+                           &barrier,
+                           0,
+                           nullptr,
+                           0,
+                           nullptr);
+  VK_CHECK_FATAL(vk->vkEndCommandBuffer(command_buffer_));
+  VkSubmitInfo submit_info = {};
+  submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+  submit_info.commandBufferCount = 1;
+  submit_info.pCommandBuffers = &command_buffer_;
+  VK_CHECK_FATAL(vk->vkQueueSubmit(queue_, 1, &submit_info, fence_));
+  VK_CHECK_FATAL(vk->vkWaitForFences(device_, 1, &fence_, VK_TRUE, UINT64_MAX));
+  VK_CHECK_FATAL(vk->vkResetFences(device_, 1, &fence_));
+  VK_CHECK_FATAL(vk->vkResetCommandBuffer(command_buffer_, 0));
+  VK_CHECK_FATAL(vk->vkResetDescriptorPool(device_, descriptor_pool_, 0));
+  num_recorded_ = 0;
+  if (pipeline_cache_dirty_) {
+    SavePipelineCacheLocked();
+  }
+}
+
+bool VKRuntime::SavePipelineCache() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return SavePipelineCacheLocked();
+}
+
+bool VKRuntime::SavePipelineCacheLocked() {
+  pipeline_cache_dirty_ = false;
+  if (pipeline_cache_path_.empty() || pipeline_cache_ == VK_NULL_HANDLE) {
+    return false;
+  }
+  auto* vk = VKWrapper::Global();
+  size_t size = 0;
+  VK_CHECK_FATAL(
+      vk->vkGetPipelineCacheData(device_, pipeline_cache_, &size, nullptr));
+  std::vector<char> data(size);
+  VK_CHECK_FATAL(vk->vkGetPipelineCacheData(
+      device_, pipeline_cache_, &size, data.data()));
+  std::ofstream file(pipeline_cache_path_, std::ios::binary);
+  if (!file.is_open()) {
+    LOG(WARNING) << "Failed to save the pipeline cache into "
+                 << pipeline_cache_path_;
+    return false;
+  }
+  file.write(data.data(), static_cast<std::streamsize>(size));
+  VLOG(3) << "Save " << size << " bytes of the pipeline cache into "
+          << pipeline_cache_path_;
+  return true;
+}
+
+}  // namespace lite
+}  // namespace paddle
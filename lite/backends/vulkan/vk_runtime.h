@@ -0,0 +1,131 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+#include "lite/backends/vulkan/vk_wrapper.h"
+
+namespace paddle {
+namespace lite {
+
+// A storage buffer in the host visible memory, which is mapped persistently.
+// The memory of the mobile gpus is shared with the cpu, so the host reads and
+// writes it directly instead of going through the staging buffers.
+struct VKBuffer {
+  VkBuffer buffer{VK_NULL_HANDLE};
+  VkDeviceMemory memory{VK_NULL_HANDLE};
+  size_t size{0};
+  void* mapped{nullptr};
+};
+
+// A compute pipeline whose shader binds `num_buffers` storage buffers to the
+// bindings 0, 1, ... of the set 0, and takes `push_constant_size` bytes of
+// the push constants.
+struct VKPipeline {
+  VkDescriptorSetLayout set_layout{VK_NULL_HANDLE};
+  VkPipelineLayout layout{VK_NULL_HANDLE};
+  VkPipeline pipeline{VK_NULL_HANDLE};
+  uint32_t num_buffers{0};
+  uint32_t push_constant_size{0};
+};
+
+// The Vulkan device and the compute queue shared by all the predictors. The
+// dispatches of the kernels are recorded into one command buffer, and
+// submitted together when the host accesses the buffers, e.g. by io_copy.
+class VKRuntime {
+ public:
+  // The work group size of all the shaders, see lite/backends/vulkan/glsl.
+  static constexpr uint32_t kWorkGroupSize = 64;
+
+  // Never destroyed, since the tensors may free their buffers after the
+  // static objects are destroyed.
+  static VKRuntime* Global();
+
+  // The file the pipeline cache is loaded from and saved into, it saves
+  // compiling the shaders to the gpu binaries in the later processes. It
+  // should be set before the runtime is created.
+  static void set_pipeline_cache_path(const std::string& path);
+  static const std::string& pipeline_cache_path();
+
+  bool IsInitSuccess() const { return is_init_success_; }
+  const VkPhysicalDeviceProperties& device_properties() const {
+    return device_properties_;
+  }
+
+  VKBuffer* CreateBuffer(size_t size);
+  void DestroyBuffer(VKBuffer* buffer);
+
+  // The pipeline of the shader, which is created once and cached by the name
+  // of the shader, e.g. "conv2d" for glsl/conv2d.comp.
+  const VKPipeline* GetPipeline(const std::string& shader,
+                                uint32_t num_buffers,
+                                uint32_t push_constant_size);
+
+  // Record a dispatch of `total` invocations, see glsl/ for how the shaders
+  // get the flattened index.
+  void Dispatch(const VKPipeline* pipeline,
+                const std::vector<const VKBuffer*>& buffers,
+                const void* push_constants,
+                size_t total);
+
+  // Submit the recorded dispatches and wait for them, the pipeline cache is
+  // saved if any pipeline has been created since the last save.
+  void Flush();
+
+  bool SavePipelineCache();
+
+ private:
+  // The dispatches recorded before the descriptors are recycled by Flush.
+  static constexpr uint32_t kMaxDescriptorSets = 512;
+  static constexpr uint32_t kMaxBuffersPerSet = 8;
+
+  VKRuntime();
+  bool Init();
+  bool CreateInstance();
+  bool CreateDevice();
+  bool CreateCommandObjects();
+  void CreatePipelineCache();
+  // Returns -1 if no host visible and coherent memory type fits.
+  int FindMemoryType(uint32_t type_bits) const;
+  void FlushLocked();
+  bool SavePipelineCacheLocked();
+
+  static std::string pipeline_cache_path_;
+
+  bool is_init_success_{false};
+  VkInstance instance_{VK_NULL_HANDLE};
+  VkPhysicalDevice physical_device_{VK_NULL_HANDLE};
+  VkPhysicalDeviceProperties device_properties_;
+  VkPhysicalDeviceMemoryProperties memory_properties_;
+  uint32_t queue_family_{0};
+  VkDevice device_{VK_NULL_HANDLE};
+  VkQueue queue_{VK_NULL_HANDLE};
+  VkCommandPool command_pool_{VK_NULL_HANDLE};
+  VkCommandBuffer command_buffer_{VK_NULL_HANDLE};
+  VkFence fence_{VK_NULL_HANDLE};
+  VkDescriptorPool descriptor_pool_{VK_NULL_HANDLE};
+  VkPipelineCache pipeline_cache_{VK_NULL_HANDLE};
+  std::map<std::string, std::unique_ptr<VKPipeline>> pipelines_;
+  uint32_t num_recorded_{0};
+  bool pipeline_cache_dirty_{false};
+  std::mutex mutex_;
+};
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,91 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/vulkan/vk_wrapper.h"
+#include <dlfcn.h>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+VKWrapper* VKWrapper::Global() {
+  static VKWrapper wrapper;
+  return &wrapper;
+}
+
+VKWrapper::VKWrapper() {
+  if (!InitHandle()) {
+    LOG(INFO) << "Failed to find and initialize Vulkan library";
+    return;
+  }
+  dlsym_success_ = InitFunctions();
+}
+
+bool VKWrapper::InitHandle() {
+  const std::vector<std::string> paths = {
+    "libvulkan.so",
+    "libvulkan.so.1",
+#if defined(__aarch64__)
+    "/system/lib64/libvulkan.so",
+#else
+    "/system/lib/libvulkan.so",
+#endif
+  };
+  for (auto& path : paths) {
+    handle_ = dlopen(path.c_str(), RTLD_LAZY | RTLD_LOCAL);
+    if (handle_ != nullptr) {
+      VLOG(4) << "Load the Vulkan library from " << path;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool VKWrapper::InitFunctions() {
+  vkGetInstanceProcAddr = reinterpret_cast<PFN_vkGetInstanceProcAddr>(
+      dlsym(handle_, "vkGetInstanceProcAddr"));
+  if (vkGetInstanceProcAddr == nullptr) {
+    LOG(ERROR) << "Cannot find the vkGetInstanceProcAddr symbol in "
+                  "libvulkan.so!";
+    return false;
+  }
+  bool success = true;
+#define LITE_VK_LOAD_GLOBAL_FUNCTION(func)                                    \
+  func = reinterpret_cast<PFN_##func>(vkGetInstanceProcAddr(nullptr, #func)); \
+  if (func == nullptr) {                                                      \
+    LOG(ERROR) << "Cannot load the " << #func << " function!";                \
+    success = false;                                                          \
+  }
+  LITE_VK_GLOBAL_FUNCTIONS(LITE_VK_LOAD_GLOBAL_FUNCTION)
+#undef LITE_VK_LOAD_GLOBAL_FUNCTION
+  return success;
+}
+
+bool VKWrapper::LoadInstanceFunctions(VkInstance instance) {
+  CHECK(dlsym_success_);
+  bool success = true;
+#define LITE_VK_LOAD_INSTANCE_FUNCTION(func)                                   \
+  func = reinterpret_cast<PFN_##func>(vkGetInstanceProcAddr(instance, #func)); \
+  if (func == nullptr) {                                                       \
+    LOG(ERROR) << "Cannot load the " << #func << " function!";                 \
+    success = false;                                                           \
+  }
+  LITE_VK_INSTANCE_FUNCTIONS(LITE_VK_LOAD_INSTANCE_FUNCTION)
+#undef LITE_VK_LOAD_INSTANCE_FUNCTION
+  return success;
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,120 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+#include <vulkan/vulkan.h>
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+
+// The global level functions, which are loaded by vkGetInstanceProcAddr with
+// the null instance.
+#define LITE_VK_GLOBAL_FUNCTIONS(__) __(vkCreateInstance)
+
+// The instance and device level functions, which are loaded after the
+// instance is created, the device level ones go through the loader
+// trampolines, whose overhead is negligible for the dispatch sizes here.
+#define LITE_VK_INSTANCE_FUNCTIONS(__)         \
+  __(vkDestroyInstance)                        \
+  __(vkEnumeratePhysicalDevices)               \
+  __(vkGetPhysicalDeviceProperties)            \
+  __(vkGetPhysicalDeviceQueueFamilyProperties) \
+  __(vkGetPhysicalDeviceMemoryProperties)      \
+  __(vkCreateDevice)                           \
+  __(vkDestroyDevice)                          \
+  __(vkGetDeviceQueue)                         \
+  __(vkQueueSubmit)                            \
+  __(vkCreateBuffer)                           \
+  __(vkDestroyBuffer)                          \
+  __(vkGetBufferMemoryRequirements)            \
+  __(vkAllocateMemory)                         \
+  __(vkFreeMemory)                             \
+  __(vkBindBufferMemory)                       \
+  __(vkMapMemory)                              \
+  __(vkUnmapMemory)                            \
+  __(vkCreateShaderModule)                     \
+  __(vkDestroyShaderModule)                    \
+  __(vkCreateDescriptorSetLayout)              \
+  __(vkDestroyDescriptorSetLayout)             \
+  __(vkCreatePipelineLayout)                   \
+  __(vkDestroyPipelineLayout)                  \
+  __(vkCreatePipelineCache)                    \
+  __(vkDestroyPipelineCache)                   \
+  __(vkGetPipelineCacheData)                   \
+  __(vkCreateComputePipelines)                 \
+  __(vkDestroyPipeline)                        \
+  __(vkCreateDescriptorPool)                   \
+  __(vkDestroyDescriptorPool)                  \
+  __(vkResetDescriptorPool)                    \
+  __(vkAllocateDescriptorSets)                 \
+  __(vkUpdateDescriptorSets)                   \
+  __(vkCreateCommandPool)                      \
+  __(vkDestroyCommandPool)                     \
+  __(vkAllocateCommandBuffers)                 \
+  __(vkBeginCommandBuffer)                     \
+  __(vkEndCommandBuffer)                       \
+  __(vkResetCommandBuffer)                     \
+  __(vkCmdBindPipeline)                        \
+  __(vkCmdBindDescriptorSets)                  \
+  __(vkCmdPushConstants)                       \
+  __(vkCmdDispatch)                            \
+  __(vkCmdPipelineBarrier)                     \
+  __(vkCmdCopyBuffer)                          \
+  __(vkCreateFence)                            \
+  __(vkDestroyFence)                           \
+  __(vkWaitForFences)                          \
+  __(vkResetFences)
+
+// Loads libvulkan.so at runtime like CLWrapper does for OpenCL, so that the
+// library runs on the devices without the Vulkan driver, and the functions
+// are called by the pointers, e.g. VKWrapper::Global()->vkCreateBuffer(...).
+class VKWrapper final {
+ public:
+  static VKWrapper* Global();
+
+  bool VulkanLibFound() const { return handle_ != nullptr; }
+  bool DlsymSuccess() const { return dlsym_success_; }
+  // Returns false if any of the instance functions is missing.
+  bool LoadInstanceFunctions(VkInstance instance);
+
+#define LITE_VK_DECLARE_FUNCTION(func) PFN_##func func{nullptr};
+  PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr{nullptr};
+  LITE_VK_GLOBAL_FUNCTIONS(LITE_VK_DECLARE_FUNCTION)
+  LITE_VK_INSTANCE_FUNCTIONS(LITE_VK_DECLARE_FUNCTION)
+#undef LITE_VK_DECLARE_FUNCTION
+
+ private:
+  VKWrapper();
+  VKWrapper(const VKWrapper&) = delete;
+  VKWrapper& operator=(const VKWrapper&) = delete;
+  bool InitHandle();
+  bool InitFunctions();
+
+  void* handle_{nullptr};
+  bool dlsym_success_{false};
+};
+
+#define VK_CHECK_FATAL(expr)                                              \
+  do {                                                                    \
+    VkResult vk_result = (expr);                                          \
+    CHECK_EQ(vk_result, VK_SUCCESS) << #expr << " failed: " << vk_result; \
+  } while (false)
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,172 @@
+/* Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "lite/backends/x86/jit/gen/gemm.h"
+#include <memory>
+#include "lite/backends/x86/jit/registry.h"
+
+namespace paddle {
+namespace lite {
+namespace jit {
+namespace gen {
+
+// the mask of the ymm tail of rest floats starts at YMM_FLOAT_BLOCK - rest
+static const int32_t gemm_tail_mask[2 * YMM_FLOAT_BLOCK] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+
+void GemmJitCode::genTile(int rows, int panels, bool tail) {
+  const int b_reg_idx = max_rows_ * max_panels_;
+  const int x_reg_idx = b_reg_idx + max_panels_;
+  const size_t panel_len = sizeof(float) * k_ * block_;
+  // clean
+  for (int r = 0; r < rows; ++r) {
+    for (int j = 0; j < panels; ++j) {
+      int idx = r * max_panels_ + j;
+      if (block_ == ZMM_FLOAT_BLOCK) {
+        vpxord(vmm(idx), vmm(idx), vmm(idx));
+      } else {
+        vxorps(vmm(idx), vmm(idx), vmm(idx));
+      }
+    }
+  }
+
+  Label l_next_k;
+  mov(reg_ptr_a_k, param_a);
+  mov(reg_ptr_b_k, reg_ptr_b_col);
+  mov(reg_k, k_);
+  L(l_next_k);
+  {
+    for (int j = 0; j < panels; ++j) {
+      vmovups(vmm(b_reg_idx + j), ptr[reg_ptr_b_k + j * panel_len]);
+    }
+    for (int r = 0; r < rows; ++r) {
+      vbroadcastss(vmm(x_reg_idx), ptr[reg_ptr_a_k + r * k_ * sizeof(float)]);
+      for (int j = 0; j < panels; ++j) {
+        vfmadd231ps(
+            vmm(r * max_panels_ + j), vmm(b_reg_idx + j), vmm(x_reg_idx));
+      }
+    }
+    add(reg_ptr_a_k, sizeof(float));
+    add(reg_ptr_b_k, block_ * sizeof(float));
+    dec(reg_k);
+    jnz(l_next_k, T_NEAR);
+  }
+
+  // save
+  for (int r = 0; r < rows; ++r) {
+    for (int j = 0; j < panels; ++j) {
+      int idx = r * max_panels_ + j;
+      size_t offset = (r * n_ + j * block_) * sizeof(float);
+      if (!tail || j < panels - 1) {
+        vmovups(ptr[reg_ptr_c_col + offset], vmm(idx));
+      } else if (block_ == ZMM_FLOAT_BLOCK) {
+        vmovups(ptr[reg_ptr_c_col + offset] | k1, zmm_t(idx));
+      } else {
+        vmaskmovps(ptr[reg_ptr_c_col + offset], ymm_t(15), ymm_t(idx));
+      }
+    }
+  }
+}
+
+void GemmJitCode::genRows(int rows) {
+  const int rest = n_ % block_;
+  const int num_panels = (n_ + block_ - 1) / block_;
+  // the panels of the loop are stored without masks
+  const int num_loops = (rest != 0 ? num_panels - 1 : num_panels) / max_panels_;
+  const int tail_panels = num_panels - num_loops * max_panels_;
+
+  mov(reg_ptr_b_col, param_b);
+  mov(reg_ptr_c_col, param_c);
+  if (num_loops > 0) {
+    Label l_next_col;
+    mov(reg_col, num_loops);
+    L(l_next_col);
+    genTile(rows, max_panels_, false);
+    add(reg_ptr_b_col, max_panels_ * k_ * block_ * sizeof(float));
+    add(reg_ptr_c_col, max_panels_ * block_ * sizeof(float));
+    dec(reg_col);
+    jnz(l_next_col, T_NEAR);
+  }
+  if (tail_panels > 0) {
+    genTile(rows, tail_panels, rest != 0);
+  }
+}
+
+void GemmJitCode::genCode() {
+  preCode();
+  // m is an int
+  movsxd(param_m, param_m.cvt32());
+  const int rest = n_ % block_;
+  if (rest != 0) {
+    if (block_ == ZMM_FLOAT_BLOCK) {
+      mov(reg_tmp.cvt32(), (1 << rest) - 1);
+      kmovw(k1, reg_tmp.cvt32());
+    } else {
+      mov(reg_tmp,
+          reinterpret_cast<size_t>(&gemm_tail_mask[YMM_FLOAT_BLOCK - rest]));
+      vmovups(ymm_t(15), ptr[reg_tmp]);
+    }
+  }
+
+  Label l_next_rows, l_rest_rows, l_done;
+  L(l_next_rows);
+  cmp(param_m, max_rows_);
+  jl(l_rest_rows, T_NEAR);
+  genRows(max_rows_);
+  add(param_a, max_rows_ * k_ * sizeof(float));
+  add(param_c, max_rows_ * n_ * sizeof(float));
+  sub(param_m, max_rows_);
+  jmp(l_next_rows, T_NEAR);
+
+  L(l_rest_rows);
+  for (int rows = max_rows_ - 1; rows > 0; --rows) {
+    Label l_next;
+    cmp(param_m, rows);
+    jne(l_next, T_NEAR);
+    genRows(rows);
+    jmp(l_done, T_NEAR);
+    L(l_next);
+  }
+  L(l_done);
+  postCode();
+}
+
+class GemmCreator : public JitCodeCreator<gemm_attr_t> {
+ public:
+  bool CanBeUsed(const gemm_attr_t& attr) const override {
+    if (attr.block == ZMM_FLOAT_BLOCK) {
+      return x86::MayIUse(x86::avx512f);
+    }
+    return attr.block == YMM_FLOAT_BLOCK && x86::MayIUse(x86::avx2);
+  }
+  size_t CodeSize(const gemm_attr_t& attr) const override {
+    // two tiles of at most 6 x 4 vectors for each count of the rows
+    return 96 + 6 * 2 * (256 + 6 * 4 * 48);
+  }
+  std::unique_ptr<GenBase> CreateJitCode(
+      const gemm_attr_t& attr) const override {
+    CHECK_GT(attr.n, 0);
+    CHECK_GT(attr.k, 0);
+    return make_unique<GemmJitCode>(attr, CodeSize(attr));
+  }
+};
+
+}  // namespace gen
+}  // namespace jit
+}  // namespace lite
+}  // namespace paddle
+
+namespace gen = paddle::lite::jit::gen;
+
+REGISTER_JITKERNEL_GEN_LITE(kGemm, gen::GemmCreator);
@@ -0,0 +1,89 @@
+/* Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <string>
+#include "lite/backends/x86/jit/gen/jitcode.h"
+#include "lite/utils/log/cp_logging.h"
+#include "lite/utils/string.h"
+
+namespace paddle {
+namespace lite {
+namespace jit {
+namespace gen {
+
+// The gemm of the packed weights specialized by N and K. C is computed in
+// tiles of max_rows_ x max_panels_ vectors, which are kept in the registers
+// while looping over K.
+class GemmJitCode : public JitCode {
+ public:
+  explicit GemmJitCode(const gemm_attr_t& attr,
+                       size_t code_size = 256 * 1024,
+                       void* code_ptr = nullptr)
+      : JitCode(code_size, code_ptr),
+        n_(attr.n),
+        k_(attr.k),
+        block_(attr.block) {
+    CHECK(block_ == YMM_FLOAT_BLOCK || block_ == ZMM_FLOAT_BLOCK)
+        << "Only support the panels of ymm or zmm";
+    // ymm: 12 for C, 2 for B, 1 for A and 1 for the mask of the tail
+    // zmm: 24 for C, 4 for B, 1 for A, the tail is masked by k1
+    max_rows_ = 6;
+    max_panels_ = block_ == ZMM_FLOAT_BLOCK ? 4 : 2;
+    this->genCode();
+  }
+
+  std::string name() const override {
+    std::string base = "GemmJitCode";
+    base = base + "_N" + paddle::lite::to_string(n_) + "_K" +
+           paddle::lite::to_string(k_) + "_B" +
+           paddle::lite::to_string(block_);
+    return base;
+  }
+  void genCode() override;
+
+ private:
+  // C of rows x panels at reg_ptr_c_col, the last panel is masked if tail
+  void genTile(int rows, int panels, bool tail);
+  // all the columns of C of the rows
+  void genRows(int rows);
+  Xbyak::Xmm vmm(int idx) const {
+    if (block_ == ZMM_FLOAT_BLOCK) {
+      return Xbyak::Zmm(idx);
+    }
+    return Xbyak::Ymm(idx);
+  }
+
+  int n_, k_, block_;
+  int max_rows_, max_panels_;
+
+  reg64_t param_a{abi_param1};
+  reg64_t param_b{abi_param2};
+  reg64_t param_c{abi_param3};
+  reg64_t param_m{abi_param4};
+  reg64_t reg_tmp{rax};
+
+  reg64_t reg_ptr_b_col{r8};
+  reg64_t reg_ptr_c_col{r9};
+  reg64_t reg_ptr_a_k{r10};
+  reg64_t reg_ptr_b_k{r11};
+  reg64_t reg_k{r12};
+  reg64_t reg_col{r13};
+};
+
+}  // namespace gen
+}  // namespace jit
+}  // namespace lite
+}  // namespace paddle
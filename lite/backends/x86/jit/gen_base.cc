@@ -13,6 +13,7 @@
  * limitations under the License. */
 
 #include "lite/backends/x86/jit/gen_base.h"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -100,6 +101,25 @@ std::vector<int> packed_groups(int n, int k, int* block_out, int* rest_out) {
   return groups;
 }
 
+int gemm_block() {
+  return x86::MayIUse(x86::avx512f) ? ZMM_FLOAT_BLOCK : YMM_FLOAT_BLOCK;
+}
+
+void pack_gemm_weights(
+    const float* b, int k, int n, int block, float* packed) {
+  const int panels = (n + block - 1) / block;
+  for (int p = 0; p < panels; ++p) {
+    float* dst = packed + p * k * block;
+    const int cols = std::min(block, n - p * block);
+    for (int i = 0; i < k; ++i) {
+      const float* src = b + i * n + p * block;
+      for (int j = 0; j < block; ++j) {
+        dst[i * block + j] = j < cols ? src[j] : 0.f;
+      }
+    }
+  }
+}
+
 }  // namespace jit
 }  // namespace lite
 }  // namespace paddle
@@ -83,6 +83,13 @@ std::vector<int> packed_groups(int n,
                                int* block = nullptr,
                                int* rest = nullptr);
 
+// the column width of the panels of the gemm weights, one vector of the cpu
+int gemm_block();
+
+// pack B(k,n) into the panels of block columns, each one k x block, and pad
+// the last one with zeros, the packed size is ceil(n / block) * block * k
+void pack_gemm_weights(const float* b, int k, int n, int block, float* packed);
+
 }  // namespace jit
 }  // namespace lite
 }  // namespace paddle
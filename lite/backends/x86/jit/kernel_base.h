@@ -25,6 +25,7 @@ typedef enum {
   // sort by alphabet
   kCRFDecoding = 1,
   kEmbSeqPool = 2,
+  kGemm,
   kGRUH1,
   kGRUHtPart1,
   kGRUHtPart2,
@@ -294,6 +295,24 @@ struct MatMulTuple {
   typedef void (*func_type)(const T*, const T*, T*, const matmul_attr_t*);
 };
 
+// the columns of B are packed in panels of block by pack_gemm_weights
+typedef struct gemm_attr_s {
+  int n, k;
+  int block;
+  gemm_attr_s() = default;
+  explicit gemm_attr_s(int n_, int k_, int block_)
+      : n(n_), k(k_), block(block_) {}
+} gemm_attr_t;
+
+// A(M,K) * packed B(K,N) = C(M,N), M is given at runtime
+template <typename T>
+struct GemmTuple {
+  static constexpr KernelType kernel_type = kGemm;
+  typedef T data_type;
+  typedef gemm_attr_t attr_type;
+  typedef void (*func_type)(const T*, const T*, T*, int, const gemm_attr_t*);
+};
+
 template <typename T>
 struct CRFDecodingTuple {
   static constexpr KernelType kernel_type = kCRFDecoding;
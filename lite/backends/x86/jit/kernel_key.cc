@@ -56,6 +56,11 @@ int64_t JitCodeKey<matmul_attr_t>(const matmul_attr_t& attr) {
   return XXH64(&attr, sizeof(int) * 3, 0);  // m, n, k
 }
 
+template <>
+int64_t JitCodeKey<gemm_attr_t>(const gemm_attr_t& attr) {
+  return XXH64(&attr, sizeof(int) * 3, 0);  // n, k, block
+}
+
 template <>
 int64_t JitCodeKey<emb_seq_pool_attr_t>(const emb_seq_pool_attr_t& attr) {
   return attr.table_width;
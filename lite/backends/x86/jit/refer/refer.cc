@@ -50,6 +50,7 @@ REGISTER_REFER_KERNEL(LayerNorm);
 REGISTER_REFER_KERNEL(NCHW16CMulNC);
 REGISTER_REFER_KERNEL(SeqPool);
 REGISTER_REFER_KERNEL(MatMul);
+REGISTER_REFER_KERNEL(Gemm);
 REGISTER_REFER_KERNEL(HMax);
 REGISTER_REFER_KERNEL(HSum);
 REGISTER_REFER_KERNEL(StrideASum);
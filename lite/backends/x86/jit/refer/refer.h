@@ -408,6 +408,25 @@ void MatMul(const T* A, const T* B, T* C, const matmul_attr_t* attr) {
   }
 }
 
+// A(M,K) * B(K,N) = C(M,N), B is packed in panels of attr->block columns
+template <typename T>
+void Gemm(const T* A, const T* B, T* C, int M, const gemm_attr_t* attr) {
+  int N = attr->n;
+  int K = attr->k;
+  int block = attr->block;
+  for (int m = 0; m < M; ++m) {
+    const T* pa = A + m * K;
+    T* pc = C + m * N;
+    for (int n = 0; n < N; ++n) {
+      const T* pb = B + (n / block) * K * block + n % block;
+      pc[n] = pa[0] * pb[0];
+      for (int k = 1; k < K; ++k) {
+        pc[n] += pa[k] * pb[k * block];
+      }
+    }
+  }
+}
+
 template <typename T>
 void HMax(const T* x, T* res, int n) {
   res[0] = x[0];
@@ -589,6 +608,7 @@ DECLARE_REFER_KERNEL(LayerNorm);
 DECLARE_REFER_KERNEL(NCHW16CMulNC);
 DECLARE_REFER_KERNEL(SeqPool);
 DECLARE_REFER_KERNEL(MatMul);
+DECLARE_REFER_KERNEL(Gemm);
 DECLARE_REFER_KERNEL(Softmax);
 DECLARE_REFER_KERNEL(EmbSeqPool);
 DECLARE_REFER_KERNEL(Sgd);
@@ -24,6 +24,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 namespace paddle {
 namespace lite {
@@ -229,6 +230,80 @@ void hard_swish(const float* din,
   }
 }
 
+#ifdef __AVX__
+// Apply `vact` to every 8 floats, the tail is padded so that every element
+// goes through the same approximation.
+template <typename VAct>
+static void act_fast(const float* din, float* dout, int size, VAct vact) {
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    _mm256_storeu_ps(dout + i, vact(_mm256_loadu_ps(din + i)));
+  }
+  if (i < size) {
+    float buf[8] = {0.f};
+    memcpy(buf, din + i, (size - i) * sizeof(float));
+    _mm256_storeu_ps(buf, vact(_mm256_loadu_ps(buf)));
+    memcpy(dout + i, buf, (size - i) * sizeof(float));
+  }
+}
+#endif
+
+template <>
+void sigmoid_fast(const float* din, float* dout, int size) {
+#ifdef __AVX__
+  act_fast(din, dout, size, [](__m256 x) { return sigmoid256_ps_fast(x); });
+#else
+  for (int i = 0; i < size; i++) {
+    dout[i] = 1.f / (1.f + std::exp(-din[i]));
+  }
+#endif
+}
+
+template <>
+void tanh_fast(const float* din, float* dout, int size) {
+#ifdef __AVX__
+  act_fast(din, dout, size, [](__m256 x) { return tanh256_ps_fast(x); });
+#else
+  for (int i = 0; i < size; i++) {
+    dout[i] = std::tanh(din[i]);
+  }
+#endif
+}
+
+template <>
+void gelu_fast(const float* din, float* dout, int size, bool approximate) {
+  const float sqrt_2_div_pi = 0.79788456f;
+#ifdef __AVX__
+  __m256 vhalf = _mm256_set1_ps(0.5f);
+  if (approximate) {
+    __m256 vcoef = _mm256_set1_ps(sqrt_2_div_pi);
+    __m256 vcubic = _mm256_set1_ps(0.044715f);
+    act_fast(din, dout, size, [=](__m256 x) {
+      __m256 x3 = _mm256_mul_ps(_mm256_mul_ps(x, x), x);
+      __m256 t = _mm256_mul_ps(_mm256_fmadd_ps(x3, vcubic, x), vcoef);
+      __m256 hx = _mm256_mul_ps(x, vhalf);
+      return _mm256_fmadd_ps(hx, tanh256_ps_fast(t), hx);
+    });
+  } else {
+    __m256 vsqrt1_2 = _mm256_set1_ps(0.70710678f);
+    act_fast(din, dout, size, [=](__m256 x) {
+      __m256 hx = _mm256_mul_ps(x, vhalf);
+      return _mm256_fmadd_ps(
+          hx, erf256_ps_fast(_mm256_mul_ps(x, vsqrt1_2)), hx);
+    });
+  }
+#else
+  for (int i = 0; i < size; i++) {
+    float x = din[i];
+    dout[i] = approximate
+                  ? 0.5f * x *
+                        (1.f + std::tanh(sqrt_2_div_pi *
+                                         (x + 0.044715f * x * x * x)))
+                  : 0.5f * x * (1.f + std::erf(x * 0.70710678f));
+  }
+#endif
+}
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
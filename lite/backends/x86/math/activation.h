@@ -30,6 +30,17 @@ void hard_swish(const T* din,
                 float offset,
                 float threshold);
 
+// The activations by the approximations of the fast-math mode on AVX, see
+// FastMath.
+template <typename T>
+void sigmoid_fast(const T* din, T* dout, int size);
+
+template <typename T>
+void tanh_fast(const T* din, T* dout, int size);
+
+template <typename T>
+void gelu_fast(const T* din, T* dout, int size, bool approximate);
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
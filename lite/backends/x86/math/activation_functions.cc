@@ -54,6 +54,12 @@ __m256 Tanh(const __m256 a) {
 
 __m256 Identity(const __m256 a) { return a; }
 
+__m256 SigmoidFast(const __m256 a) {
+  return lite::x86::math::sigmoid256_ps_fast(a);
+}
+
+__m256 TanhFast(const __m256 a) { return lite::x86::math::tanh256_ps_fast(a); }
+
 }  // namespace avx
 }  // namespace forward
 
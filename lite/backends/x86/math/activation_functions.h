@@ -16,6 +16,7 @@ limitations under the License. */
 #include <math.h>
 #include <string>
 #include "lite/backends/x86/cpu_info.h"
+#include "lite/core/fast_math.h"
 #include "lite/utils/log/cp_logging.h"
 
 namespace paddle {
@@ -33,15 +34,20 @@ enum ActivationType {
   kReLU,
   kTanh,
   kIdentity,
+  // The approximations of the fast-math mode on AVX, see FastMath.
+  kSigmoidFast,
+  kTanhFast,
 };
 
 inline ActivationType GetActivationType(const std::string &type) {
   if (type == "sigmoid") {
-    return ActivationType::kSigmoid;
+    return FastMath::Enabled() ? ActivationType::kSigmoidFast
+                               : ActivationType::kSigmoid;
   } else if (type == "relu") {
     return ActivationType::kReLU;
   } else if (type == "tanh") {
-    return ActivationType::kTanh;
+    return FastMath::Enabled() ? ActivationType::kTanhFast
+                               : ActivationType::kTanh;
   } else if (type == "identity" || type == "") {
     return ActivationType::kIdentity;
   }
@@ -111,22 +117,30 @@ struct Active {
 static Active<float>::Act kActFloat[] = {&forward::Sigmoid<float>,
                                          &forward::Relu<float>,
                                          &forward::Tanh<float>,
-                                         &forward::Identity<float>};
+                                         &forward::Identity<float>,
+                                         &forward::Sigmoid<float>,
+                                         &forward::Tanh<float>};
 
 static Active<float>::ActGrad kActGradFloat[] = {&backward::Sigmoid<float>,
                                                  &backward::Relu<float>,
                                                  &backward::Tanh<float>,
-                                                 &backward::Identity<float>};
+                                                 &backward::Identity<float>,
+                                                 &backward::Sigmoid<float>,
+                                                 &backward::Tanh<float>};
 
 static Active<double>::Act kActDouble[] = {&forward::Sigmoid<double>,
                                            &forward::Relu<double>,
                                            &forward::Tanh<double>,
-                                           &forward::Identity<double>};
+                                           &forward::Identity<double>,
+                                           &forward::Sigmoid<double>,
+                                           &forward::Tanh<double>};
 
 static Active<double>::ActGrad kActGradDouble[] = {&backward::Sigmoid<double>,
                                                    &backward::Relu<double>,
                                                    &backward::Tanh<double>,
-                                                   &backward::Identity<double>};
+                                                   &backward::Identity<double>,
+                                                   &backward::Sigmoid<double>,
+                                                   &backward::Tanh<double>};
 
 namespace forward {
 inline float activation(float a, int index) { return kActFloat[index](a); }
@@ -152,6 +166,8 @@ __m256 Relu(const __m256 a);
 __m256 Sigmoid(const __m256 a);
 __m256 Tanh(const __m256 a);
 __m256 Identity(const __m256 a);
+__m256 SigmoidFast(const __m256 a);
+__m256 TanhFast(const __m256 a);
 }  // namespace avx
 }  // namespace forward
 
@@ -167,12 +183,16 @@ __m256 Identity(const __m256 a, const __m256 b);
 static Active<__m256>::Act kActAvx[] = {&forward::avx::Sigmoid,
                                         &forward::avx::Relu,
                                         &forward::avx::Tanh,
-                                        &forward::avx::Identity};
+                                        &forward::avx::Identity,
+                                        &forward::avx::SigmoidFast,
+                                        &forward::avx::TanhFast};
 
 static Active<__m256>::ActGrad kActGradAvx[] = {&backward::avx::Sigmoid,
                                                 &backward::avx::Relu,
                                                 &backward::avx::Tanh,
-                                                &backward::avx::Identity};
+                                                &backward::avx::Identity,
+                                                &backward::avx::Sigmoid,
+                                                &backward::avx::Tanh};
 
 namespace forward {
 inline __m256 activation(__m256 a, int index) { return kActAvx[index](a); }
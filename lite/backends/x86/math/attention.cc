@@ -0,0 +1,416 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/attention.h"
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "lite/backends/x86/math/avx/avx_mathfuns.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// The rows of a block of queries and the columns of a tile of keys.
+const int kAttentionRows = 4;
+const int kAttentionCols = 64;
+
+#ifdef __AVX__
+static inline float reduce_add(__m256 v) {
+  __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+  s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+  return _mm_cvtss_f32(s);
+}
+#endif
+
+// The dot products of the kAttentionRows rows of q with a key, the last row
+// is repeated for the missing ones.
+static inline void attention_dot(const float* const* q,
+                                 const float* kj,
+                                 int dim,
+                                 float* sums) {
+  int c = 0;
+#if defined(__AVX512F__)
+  __m512 acc0 = _mm512_setzero_ps();
+  __m512 acc1 = _mm512_setzero_ps();
+  __m512 acc2 = _mm512_setzero_ps();
+  __m512 acc3 = _mm512_setzero_ps();
+  for (; c + 16 <= dim; c += 16) {
+    __m512 vk = _mm512_loadu_ps(kj + c);
+    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(q[0] + c), vk, acc0);
+    acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(q[1] + c), vk, acc1);
+    acc2 = _mm512_fmadd_ps(_mm512_loadu_ps(q[2] + c), vk, acc2);
+    acc3 = _mm512_fmadd_ps(_mm512_loadu_ps(q[3] + c), vk, acc3);
+  }
+  sums[0] = _mm512_reduce_add_ps(acc0);
+  sums[1] = _mm512_reduce_add_ps(acc1);
+  sums[2] = _mm512_reduce_add_ps(acc2);
+  sums[3] = _mm512_reduce_add_ps(acc3);
+#elif defined(__AVX__)
+  __m256 acc0 = _mm256_setzero_ps();
+  __m256 acc1 = _mm256_setzero_ps();
+  __m256 acc2 = _mm256_setzero_ps();
+  __m256 acc3 = _mm256_setzero_ps();
+  for (; c + 8 <= dim; c += 8) {
+    __m256 vk = _mm256_loadu_ps(kj + c);
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(q[0] + c), vk, acc0);
+    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(q[1] + c), vk, acc1);
+    acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(q[2] + c), vk, acc2);
+    acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(q[3] + c), vk, acc3);
+  }
+  sums[0] = reduce_add(acc0);
+  sums[1] = reduce_add(acc1);
+  sums[2] = reduce_add(acc2);
+  sums[3] = reduce_add(acc3);
+#else
+  sums[0] = sums[1] = sums[2] = sums[3] = 0.f;
+#endif
+  for (; c < dim; c++) {
+    sums[0] += q[0][c] * kj[c];
+    sums[1] += q[1][c] * kj[c];
+    sums[2] += q[2][c] * kj[c];
+    sums[3] += q[3][c] * kj[c];
+  }
+}
+
+// Scale and mask the scores s of a row, and replace them by the
+// probabilities exp(s - m) with the new running max m. The running sum l and
+// the output o of the row are rescaled to the new max.
+static void attention_online_softmax(float* s,
+                                     int cols,
+                                     const float* mask,
+                                     int mask_col_stride,
+                                     float scale,
+                                     float* m,
+                                     float* l,
+                                     float* o,
+                                     int dim_v) {
+  float max_val = -std::numeric_limits<float>::infinity();
+  for (int j = 0; j < cols; j++) {
+    s[j] = s[j] * scale + (mask ? mask[j * mask_col_stride] : 0.f);
+    max_val = std::max(max_val, s[j]);
+  }
+  float m_new = std::max(*m, max_val);
+  if (m_new == -std::numeric_limits<float>::infinity()) {
+    // All the keys so far are masked out.
+    memset(s, 0, sizeof(float) * cols);
+    return;
+  }
+
+  float sum = 0.f;
+  int j = 0;
+#ifdef __AVX__
+  __m256 vm = _mm256_set1_ps(m_new);
+  __m256 vsum = _mm256_setzero_ps();
+  for (; j + 8 <= cols; j += 8) {
+    __m256 vp = exp256_ps(_mm256_sub_ps(_mm256_loadu_ps(s + j), vm));
+    _mm256_storeu_ps(s + j, vp);
+    vsum = _mm256_add_ps(vsum, vp);
+  }
+  sum = reduce_add(vsum);
+#endif
+  for (; j < cols; j++) {
+    s[j] = std::exp(s[j] - m_new);
+    sum += s[j];
+  }
+  float alpha = std::exp(*m - m_new);
+  *l = *l * alpha + sum;
+  *m = m_new;
+  if (alpha < 1.f) {
+    for (int c = 0; c < dim_v; c++) o[c] *= alpha;
+  }
+}
+
+// o[r] += p[r] * v for the kAttentionRows rows, the accumulators of the four
+// rows are kept in the registers through the keys of the tile. The rows of v
+// are ldv apart.
+static void attention_accumulate(const float* p,
+                                 const float* v,
+                                 int cols,
+                                 int dim_v,
+                                 int ldv,
+                                 float* o) {
+  float* o0 = o;
+  float* o1 = o0 + dim_v;
+  float* o2 = o1 + dim_v;
+  float* o3 = o2 + dim_v;
+  const float* p0 = p;
+  const float* p1 = p0 + kAttentionCols;
+  const float* p2 = p1 + kAttentionCols;
+  const float* p3 = p2 + kAttentionCols;
+  int c = 0;
+#if defined(__AVX512F__)
+  for (; c + 16 <= dim_v; c += 16) {
+    __m512 acc0 = _mm512_loadu_ps(o0 + c);
+    __m512 acc1 = _mm512_loadu_ps(o1 + c);
+    __m512 acc2 = _mm512_loadu_ps(o2 + c);
+    __m512 acc3 = _mm512_loadu_ps(o3 + c);
+    const float* vj = v + c;
+    for (int j = 0; j < cols; j++, vj += ldv) {
+      __m512 vv = _mm512_loadu_ps(vj);
+      acc0 = _mm512_fmadd_ps(vv, _mm512_set1_ps(p0[j]), acc0);
+      acc1 = _mm512_fmadd_ps(vv, _mm512_set1_ps(p1[j]), acc1);
+      acc2 = _mm512_fmadd_ps(vv, _mm512_set1_ps(p2[j]), acc2);
+      acc3 = _mm512_fmadd_ps(vv, _mm512_set1_ps(p3[j]), acc3);
+    }
+    _mm512_storeu_ps(o0 + c, acc0);
+    _mm512_storeu_ps(o1 + c, acc1);
+    _mm512_storeu_ps(o2 + c, acc2);
+    _mm512_storeu_ps(o3 + c, acc3);
+  }
+#endif
+#ifdef __AVX__
+  for (; c + 8 <= dim_v; c += 8) {
+    __m256 acc0 = _mm256_loadu_ps(o0 + c);
+    __m256 acc1 = _mm256_loadu_ps(o1 + c);
+    __m256 acc2 = _mm256_loadu_ps(o2 + c);
+    __m256 acc3 = _mm256_loadu_ps(o3 + c);
+    const float* vj = v + c;
+    for (int j = 0; j < cols; j++, vj += ldv) {
+      __m256 vv = _mm256_loadu_ps(vj);
+      acc0 = _mm256_fmadd_ps(vv, _mm256_set1_ps(p0[j]), acc0);
+      acc1 = _mm256_fmadd_ps(vv, _mm256_set1_ps(p1[j]), acc1);
+      acc2 = _mm256_fmadd_ps(vv, _mm256_set1_ps(p2[j]), acc2);
+      acc3 = _mm256_fmadd_ps(vv, _mm256_set1_ps(p3[j]), acc3);
+    }
+    _mm256_storeu_ps(o0 + c, acc0);
+    _mm256_storeu_ps(o1 + c, acc1);
+    _mm256_storeu_ps(o2 + c, acc2);
+    _mm256_storeu_ps(o3 + c, acc3);
+  }
+#endif
+  for (; c < dim_v; c++) {
+    const float* vj = v + c;
+    for (int j = 0; j < cols; j++, vj += ldv) {
+      o0[c] += p0[j] * vj[0];
+      o1[c] += p1[j] * vj[0];
+      o2[c] += p2[j] * vj[0];
+      o3[c] += p3[j] * vj[0];
+    }
+  }
+}
+
+// The attention of a block of kAttentionRows queries against seq_k keys, the
+// rows of k and v are ldk and ldv apart. The unnormalized outputs are left in
+// o, with the running max and sum of the rows in m and l. s, o, m and l are
+// the workspace of the block.
+static void attention_block(const float* const* q_rows,
+                            const float* const* mask_rows,
+                            int mask_col_stride,
+                            const float* k,
+                            int ldk,
+                            const float* v,
+                            int ldv,
+                            int seq_k,
+                            int dim,
+                            int dim_v,
+                            float scale,
+                            float* s,
+                            float* o,
+                            float* m,
+                            float* l) {
+  for (int r = 0; r < kAttentionRows; r++) {
+    m[r] = -std::numeric_limits<float>::infinity();
+    l[r] = 0.f;
+  }
+  memset(o, 0, sizeof(float) * kAttentionRows * dim_v);
+  for (int col0 = 0; col0 < seq_k; col0 += kAttentionCols) {
+    int cols = std::min(kAttentionCols, seq_k - col0);
+    for (int j = 0; j < cols; j++) {
+      float sums[kAttentionRows];
+      attention_dot(
+          q_rows, k + static_cast<int64_t>(col0 + j) * ldk, dim, sums);
+      for (int r = 0; r < kAttentionRows; r++) {
+        s[r * kAttentionCols + j] = sums[r];
+      }
+    }
+    for (int r = 0; r < kAttentionRows; r++) {
+      attention_online_softmax(
+          s + r * kAttentionCols,
+          cols,
+          mask_rows[r] ? mask_rows[r] + col0 * mask_col_stride : nullptr,
+          mask_col_stride,
+          scale,
+          m + r,
+          l + r,
+          o + r * dim_v,
+          dim_v);
+    }
+    attention_accumulate(
+        s, v + static_cast<int64_t>(col0) * ldv, cols, dim_v, ldv, o);
+  }
+}
+
+// Normalize the first `rows` outputs of a block into out, whose rows are
+// out_row_stride apart.
+static void attention_store(const float* o,
+                            const float* l,
+                            int rows,
+                            int dim_v,
+                            float* out,
+                            int64_t out_row_stride) {
+  for (int r = 0; r < rows; r++) {
+    float* out_r = out + r * out_row_stride;
+    const float* o_r = o + r * dim_v;
+    // The rows whose keys are all masked out are zeros.
+    float inv = l[r] > 0.f ? 1.f / l[r] : 0.f;
+    for (int c = 0; c < dim_v; c++) out_r[c] = o_r[c] * inv;
+  }
+}
+
+void fusion_attention(const float* q,
+                      const float* k,
+                      const float* v,
+                      const float* mask,
+                      const int64_t* mask_offsets,
+                      int mask_row_stride,
+                      int mask_col_stride,
+                      float* out,
+                      int batch,
+                      int heads,
+                      int seq_q,
+                      int seq_k,
+                      int kv_stride,
+                      int dim,
+                      int dim_v,
+                      float scale,
+                      bool transpose_out) {
+  int blocks = (seq_q + kAttentionRows - 1) / kAttentionRows;
+  int out_row_stride = transpose_out ? heads * dim_v : dim_v;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif  // PADDLE_WITH_MKLML
+  for (int task = 0; task < batch * blocks; task++) {
+    // The scores of a tile, the outputs, the running max and sum of a block.
+    std::vector<float> buffer(kAttentionRows * (kAttentionCols + dim_v + 2));
+    float* s = buffer.data();
+    float* o = s + kAttentionRows * kAttentionCols;
+    float* m = o + kAttentionRows * dim_v;
+    float* l = m + kAttentionRows;
+    int b = task / blocks;
+    int row0 = (task % blocks) * kAttentionRows;
+    int rows = std::min(kAttentionRows, seq_q - row0);
+    const float* q_rows[kAttentionRows];
+    const float* mask_rows[kAttentionRows];
+    for (int r = 0; r < kAttentionRows; r++) {
+      int row = row0 + std::min(r, rows - 1);
+      q_rows[r] = q + (static_cast<int64_t>(b) * seq_q + row) * dim;
+      mask_rows[r] = mask ? mask + mask_offsets[b] + row * mask_row_stride
+                          : nullptr;
+    }
+    attention_block(q_rows,
+                    mask_rows,
+                    mask_col_stride,
+                    k + static_cast<int64_t>(b) * kv_stride * dim,
+                    dim,
+                    v + static_cast<int64_t>(b) * kv_stride * dim_v,
+                    dim_v,
+                    seq_k,
+                    dim,
+                    dim_v,
+                    scale,
+                    s,
+                    o,
+                    m,
+                    l);
+
+    // The rows of a head are interleaved with the other heads if transposed.
+    int64_t out_offset =
+        transpose_out
+            ? (static_cast<int64_t>(b / heads) * seq_q * heads + b % heads) *
+                  dim_v
+            : static_cast<int64_t>(b) * seq_q * dim_v;
+    out_offset += static_cast<int64_t>(row0) * out_row_stride;
+    attention_store(o, l, rows, dim_v, out + out_offset, out_row_stride);
+  }
+}
+
+void fusion_attention_varlen(const float* q,
+                             const float* k,
+                             const float* v,
+                             const int* cu_seqlens,
+                             float* out,
+                             int batch,
+                             int heads,
+                             int dim,
+                             int dim_v,
+                             float scale) {
+  // The first row of each block of the sequences, the blocks of the padding
+  // don't exist at all.
+  std::vector<int> block_rows;
+  std::vector<int> block_seqs;
+  for (int i = 0; i < batch; i++) {
+    for (int row = cu_seqlens[i]; row < cu_seqlens[i + 1];
+         row += kAttentionRows) {
+      block_rows.push_back(row);
+      block_seqs.push_back(i);
+    }
+  }
+  int blocks = static_cast<int>(block_rows.size());
+  int ldq = heads * dim;
+  int ldv = heads * dim_v;
+  const float* no_mask[kAttentionRows] = {nullptr};
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif  // PADDLE_WITH_MKLML
+  for (int task = 0; task < blocks * heads; task++) {
+    std::vector<float> buffer(kAttentionRows * (kAttentionCols + dim_v + 2));
+    float* s = buffer.data();
+    float* o = s + kAttentionRows * kAttentionCols;
+    float* m = o + kAttentionRows * dim_v;
+    float* l = m + kAttentionRows;
+    int block = task / heads;
+    int h = task % heads;
+    int seq = block_seqs[block];
+    int begin = cu_seqlens[seq];
+    int row0 = block_rows[block];
+    int rows = std::min(kAttentionRows, cu_seqlens[seq + 1] - row0);
+    const float* q_rows[kAttentionRows];
+    for (int r = 0; r < kAttentionRows; r++) {
+      int row = row0 + std::min(r, rows - 1);
+      q_rows[r] = q + static_cast<int64_t>(row) * ldq + h * dim;
+    }
+    attention_block(q_rows,
+                    no_mask,
+                    0,
+                    k + static_cast<int64_t>(begin) * ldq + h * dim,
+                    ldq,
+                    v + static_cast<int64_t>(begin) * ldv + h * dim_v,
+                    ldv,
+                    cu_seqlens[seq + 1] - begin,
+                    dim,
+                    dim_v,
+                    scale,
+                    s,
+                    o,
+                    m,
+                    l);
+    attention_store(o,
+                    l,
+                    rows,
+                    dim_v,
+                    out + static_cast<int64_t>(row0) * ldv + h * dim_v,
+                    ldv);
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,61 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstdint>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// The attention softmax(q * k^T * scale + mask) * v of `batch` heads, the
+// same as arm::math::fusion_attention. The keys are visited in tiles with
+// the online softmax, so only the scores of a block of queries against a
+// tile of keys are kept.
+void fusion_attention(const float* q,
+                      const float* k,
+                      const float* v,
+                      const float* mask,
+                      const int64_t* mask_offsets,
+                      int mask_row_stride,
+                      int mask_col_stride,
+                      float* out,
+                      int batch,
+                      int heads,
+                      int seq_q,
+                      int seq_k,
+                      int kv_stride,
+                      int dim,
+                      int dim_v,
+                      float scale,
+                      bool transpose_out);
+
+// The attention of `batch` sequences packed without padding, the same as
+// arm::math::fusion_attention_varlen.
+void fusion_attention_varlen(const float* q,
+                             const float* k,
+                             const float* v,
+                             const int* cu_seqlens,
+                             float* out,
+                             int batch,
+                             int heads,
+                             int dim,
+                             int dim_v,
+                             float scale);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -85,6 +85,7 @@ _PI32_CONST256(inv1, ~1);
 _PI32_CONST256(2, 2);
 _PI32_CONST256(4, 4);
 _PI32_CONST256(0x7f, 0x7f);
+_PI32_CONST256(0x3f800000, 0x3f800000);
 
 _PS256_CONST(cephes_SQRTHF, 0.707106781186547524);
 _PS256_CONST(cephes_log_p0, 7.0376836292E-2);
@@ -322,6 +323,75 @@ v8sf pow256_ps(v8sf a, v8sf b) {
   return vsum;
 }
 
+// exp(x) = 2^n * p(r), r = x - n * ln2 in [-ln2/2, ln2/2], p is the degree-4
+// minimax polynomial of exp on it.
+v8sf exp256_ps_fast(v8sf x) {
+  x = _mm256_min_ps(x, _mm256_set1_ps(88.3762626647949f));
+  x = _mm256_max_ps(x, _mm256_set1_ps(-87.3365478515625f));
+  // adding 1.5 * 2^23 rounds x / ln2 to n in the low bits of the mantissa
+  v8sf shift = _mm256_set1_ps(12582912.f);
+  v8sf t = _mm256_fmadd_ps(x, _mm256_set1_ps(1.44269504088896341f), shift);
+  v8sf n = _mm256_sub_ps(t, shift);
+  v8sf r = _mm256_fmadd_ps(n, _mm256_set1_ps(-0.693359375f), x);
+  r = _mm256_fmadd_ps(n, _mm256_set1_ps(2.12194440e-4f), r);
+
+  v8sf p = _mm256_fmadd_ps(
+      r, _mm256_set1_ps(4.145860820e-02f), _mm256_set1_ps(1.679090722e-01f));
+  p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(5.000435866e-01f));
+  p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(9.999634049e-01f));
+  p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(9.999992614e-01f));
+
+  /* build 2^n */
+  v8si e = avx2_mm256_slli_epi32(_mm256_castps_si256(t), 23);
+  e = avx2_mm256_add_epi32(e, *(v8si *)_pi32_256_0x3f800000);  // NOLINT
+  return _mm256_mul_ps(p, _mm256_castsi256_ps(e));
+}
+
+v8sf sigmoid256_ps_fast(v8sf x) {
+  v8sf one = _mm256_set1_ps(1.f);
+  v8sf e = exp256_ps_fast(_mm256_sub_ps(_mm256_setzero_ps(), x));
+  return _mm256_div_ps(one, _mm256_add_ps(one, e));
+}
+
+v8sf tanh256_ps_fast(v8sf x) {
+  v8sf one = _mm256_set1_ps(1.f);
+  v8sf sign = _mm256_and_ps(x, *(v8sf *)_ps256_sign_mask);     // NOLINT
+  v8sf ax = _mm256_and_ps(x, *(v8sf *)_ps256_inv_sign_mask);  // NOLINT
+  v8sf e = exp256_ps_fast(_mm256_mul_ps(ax, _mm256_set1_ps(-2.f)));
+  v8sf y = _mm256_div_ps(_mm256_sub_ps(one, e), _mm256_add_ps(one, e));
+  y = _mm256_or_ps(y, sign);
+
+  // the odd Taylor polynomial for |x| < 1/8 where 1 - e cancels
+  v8sf x2 = _mm256_mul_ps(x, x);
+  v8sf p = _mm256_fmadd_ps(x2,
+                           _mm256_set1_ps(-5.396825397e-02f),
+                           _mm256_set1_ps(1.333333333e-01f));
+  p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(-3.333333333e-01f));
+  p = _mm256_fmadd_ps(p, x2, one);
+  p = _mm256_mul_ps(p, x);
+  v8sf small = _mm256_cmp_ps(ax, _mm256_set1_ps(0.125f), _CMP_LT_OS);
+  return _mm256_blendv_ps(y, p, small);
+}
+
+// erf(x) by the formula 7.1.26 of Abramowitz and Stegun.
+v8sf erf256_ps_fast(v8sf x) {
+  v8sf one = _mm256_set1_ps(1.f);
+  v8sf sign = _mm256_and_ps(x, *(v8sf *)_ps256_sign_mask);     // NOLINT
+  v8sf ax = _mm256_and_ps(x, *(v8sf *)_ps256_inv_sign_mask);  // NOLINT
+  v8sf t = _mm256_div_ps(
+      one, _mm256_fmadd_ps(ax, _mm256_set1_ps(0.3275911f), one));
+  v8sf p = _mm256_fmadd_ps(
+      t, _mm256_set1_ps(1.061405429f), _mm256_set1_ps(-1.453152027f));
+  p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(1.421413741f));
+  p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(-0.284496736f));
+  p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(0.254829592f));
+  p = _mm256_mul_ps(p, t);
+  v8sf e = exp256_ps_fast(
+      _mm256_sub_ps(_mm256_setzero_ps(), _mm256_mul_ps(ax, ax)));
+  v8sf y = _mm256_sub_ps(one, _mm256_mul_ps(p, e));
+  return _mm256_or_ps(y, sign);
+}
+
 _PS256_CONST(minus_cephes_DP1, -0.78515625);
 _PS256_CONST(minus_cephes_DP2, -2.4187564849853515625e-4);
 _PS256_CONST(minus_cephes_DP3, -3.77489497744594108e-8);
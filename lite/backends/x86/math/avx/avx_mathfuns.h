@@ -29,6 +29,14 @@ v8sf sin256_ps(v8sf x);
 v8sf cos256_ps(v8sf x);
 void sincos256_ps(v8sf x, v8sf *s, v8sf *c);
 
+// The approximations used in the fast-math mode, see FastMath. The error of
+// exp is below 3e-6 relatively, the absolute ones of sigmoid, tanh and erf
+// are below 1e-6, 1.5e-6 and 2.5e-6.
+v8sf exp256_ps_fast(v8sf x);
+v8sf sigmoid256_ps_fast(v8sf x);
+v8sf tanh256_ps_fast(v8sf x);
+v8sf erf256_ps_fast(v8sf x);
+
 // FMA support
 #ifndef __AVX2__
 #define _mm256_fmadd_ps(a, b, c) _mm256_add_ps(c, _mm256_mul_ps(a, b))
@@ -0,0 +1,98 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/embedding_dequant.h"
+#include <cstring>
+#include "lite/utils/log/cp_logging.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+static void dequant_row(const float* row,
+                        float* dout,
+                        int64_t row_width,
+                        int quant_bits) {
+  float scale = row[0];
+  float bias = row[1];
+  if (quant_bits == 0) {
+    // the same scale as lookup_table_dequant
+    scale = (row[1] - row[0]) / 256.f;
+    bias = row[0];
+  }
+  const uint8_t* codes = reinterpret_cast<const uint8_t*>(row + 2);
+  int64_t i = 0;
+#ifdef __AVX2__
+  __m256 vscale = _mm256_set1_ps(scale);
+  __m256 vbias = _mm256_set1_ps(bias);
+  if (quant_bits == 4) {
+    // the low nibbles are the even elements
+    const __m256i vshift = _mm256_setr_epi32(0, 4, 0, 4, 0, 4, 0, 4);
+    const __m256i vmask = _mm256_set1_epi32(0x0F);
+    for (; i + 7 < row_width; i += 8) {
+      int32_t packed;
+      memcpy(&packed, codes + (i >> 1), sizeof(packed));
+      __m128i vin = _mm_cvtsi32_si128(packed);
+      __m256i vcode = _mm256_cvtepu8_epi32(_mm_unpacklo_epi8(vin, vin));
+      vcode = _mm256_and_si256(_mm256_srlv_epi32(vcode, vshift), vmask);
+      __m256 vout = _mm256_mul_ps(_mm256_cvtepi32_ps(vcode), vscale);
+      _mm256_storeu_ps(dout + i, _mm256_add_ps(vout, vbias));
+    }
+  } else {
+    for (; i + 7 < row_width; i += 8) {
+      __m128i vin =
+          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(codes + i));
+      __m256 vcode = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(vin));
+      __m256 vout = _mm256_mul_ps(vcode, vscale);
+      _mm256_storeu_ps(dout + i, _mm256_add_ps(vout, vbias));
+    }
+  }
+#endif
+  for (; i < row_width; i++) {
+    int code = quant_bits == 4 ? (codes[i >> 1] >> ((i & 1) * 4)) & 0x0F
+                               : static_cast<int>(codes[i]);
+    dout[i] = scale * code + bias;
+  }
+}
+
+void embedding_dequant(const float* table,
+                       const int64_t* ids,
+                       float* dout,
+                       int64_t ids_numel,
+                       int64_t row_number,
+                       int64_t quant_number,
+                       int64_t row_width,
+                       int quant_bits,
+                       int64_t padding_idx) {
+  for (int64_t i = 0; i < ids_numel; i++) {
+    float* dout_ptr = dout + i * row_width;
+    if (padding_idx != -1 && ids[i] == padding_idx) {
+      memset(dout_ptr, 0, row_width * sizeof(float));
+      continue;
+    }
+    CHECK_LT(ids[i], row_number);
+    CHECK_GE(ids[i], 0);
+    dequant_row(table + ids[i] * quant_number, dout_ptr, row_width, quant_bits);
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
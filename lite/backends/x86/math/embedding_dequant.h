@@ -0,0 +1,41 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstdint>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// Look up the rows of the ids in the table of lookup_table_dequant and
+// dequantize them, the rows of padding_idx are zeros. A row is
+// [min, max, uint8 codes] with scale = (max - min) / 256 if quant_bits is 0,
+// otherwise it is [scale, bias, codes] of quant_bits 8 or 4, two codes in a
+// byte for 4.
+void embedding_dequant(const float* table,
+                       const int64_t* ids,
+                       float* dout,
+                       int64_t ids_numel,
+                       int64_t row_number,
+                       int64_t quant_number,
+                       int64_t row_width,
+                       int quant_bits,
+                       int64_t padding_idx);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
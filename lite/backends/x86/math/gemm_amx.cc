@@ -0,0 +1,339 @@
+/* Copyright (c) 2021 paddlepaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#include "lite/backends/x86/math/gemm_amx.h"
+#include <string.h>
+#include <algorithm>
+#include "lite/utils/env.h"
+#include "lite/utils/log/cp_logging.h"
+
+// Compiled with the AMX flags if the compiler supports them, otherwise AMX is
+// never available.
+#if defined(__AMX_TILE__) && defined(__AMX_INT8__) && defined(__AMX_BF16__) && \
+    defined(__linux__) && defined(__x86_64__)
+#define GEMM_WITH_AMX
+#include <cpuid.h>
+#include <immintrin.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+// Each tile is 16 rows by 64 bytes, i.e. 64 int8 or 32 bf16 of K per row of
+// A, and the output block is 2x2 tiles.
+const int kTileRows = 16;
+const int kTileColsBytes = 64;
+const int kInt8TileK = 64;
+const int kBF16TileK = 32;
+const int kBlockM = 2 * kTileRows;
+const int kBlockN = 2 * kTileRows;
+
+// Round to the nearest even, and keep NaN quiet.
+uint16_t FloatToBF16(float x) {
+  uint32_t u;
+  memcpy(&u, &x, sizeof(u));
+  if ((u & 0x7fffffff) > 0x7f800000) {
+    return static_cast<uint16_t>((u >> 16) | 0x40);
+  }
+  u += 0x7fff + ((u >> 16) & 1);
+  return static_cast<uint16_t>(u >> 16);
+}
+
+}  // namespace
+
+void AmxPackedB::PackInt8(const int8_t* b, int K, int N, bool trans) {
+  K_ = K;
+  N_ = N;
+  k_blocks_ = (K + kInt8TileK - 1) / kInt8TileK;
+  // Even, since each output block reads 2 tiles of B.
+  n_blocks_ = (N + kBlockN - 1) / kBlockN * 2;
+  data_.assign(static_cast<size_t>(n_blocks_) * k_blocks_ * kTileBytes, 0);
+  for (int k = 0; k < K; k++) {
+    int kb = k / kInt8TileK;
+    int kk = k % kInt8TileK;
+    for (int n = 0; n < N; n++) {
+      int8_t v = trans ? b[n * K + k] : b[k * N + n];
+      int nb = n / kTileRows;
+      int nn = n % kTileRows;
+      size_t offset = (static_cast<size_t>(nb) * k_blocks_ + kb) * kTileBytes +
+                      (kk / 4) * kTileColsBytes + nn * 4 + kk % 4;
+      data_[offset] = static_cast<uint8_t>(v);
+    }
+  }
+}
+
+void AmxPackedB::PackBF16(const float* b, int K, int N, bool trans) {
+  K_ = K;
+  N_ = N;
+  k_blocks_ = (K + kBF16TileK - 1) / kBF16TileK;
+  n_blocks_ = (N + kBlockN - 1) / kBlockN * 2;
+  data_.assign(static_cast<size_t>(n_blocks_) * k_blocks_ * kTileBytes, 0);
+  for (int k = 0; k < K; k++) {
+    int kb = k / kBF16TileK;
+    int kk = k % kBF16TileK;
+    for (int n = 0; n < N; n++) {
+      uint16_t v = FloatToBF16(trans ? b[n * K + k] : b[k * N + n]);
+      int nb = n / kTileRows;
+      int nn = n % kTileRows;
+      size_t offset = (static_cast<size_t>(nb) * k_blocks_ + kb) * kTileBytes +
+                      (kk / 2) * kTileColsBytes + (nn * 2 + kk % 2) * 2;
+      memcpy(&data_[offset], &v, sizeof(v));
+    }
+  }
+}
+
+bool AmxBF16Enabled() {
+  static bool enabled = GetBoolFromEnv("LITE_X86_AMX_BF16") && AmxAvailable();
+  return enabled;
+}
+
+#ifdef GEMM_WITH_AMX
+
+namespace {
+
+struct TileConfig {
+  uint8_t palette_id;
+  uint8_t start_row;
+  uint8_t reserved[14];
+  uint16_t colsb[16];
+  uint8_t rows[16];
+};
+
+// All the 8 tiles are full: 0-3 for the output block, 4-5 for A and 6-7 for
+// B. The config is per thread.
+void LoadTileConfig() {
+  alignas(64) TileConfig config;
+  memset(&config, 0, sizeof(config));
+  config.palette_id = 1;
+  for (int i = 0; i < 8; i++) {
+    config.rows[i] = kTileRows;
+    config.colsb[i] = kTileColsBytes;
+  }
+  _tile_loadconfig(&config);
+}
+
+template <typename T>
+void StoreBlock(const T* acc,
+                int rows,
+                int cols,
+                float* C,
+                int ldc,
+                const float* scale,
+                float alpha,
+                const float* bias,
+                bool relu) {
+  for (int i = 0; i < rows; i++) {
+    const T* acc_row = acc + i * kBlockN;
+    float* c_row = C + i * ldc;
+    for (int j = 0; j < cols; j++) {
+      float v = static_cast<float>(acc_row[j]) * (scale ? scale[j] : alpha);
+      if (bias) v += bias[j];
+      c_row[j] = relu ? std::max(v, 0.f) : v;
+    }
+  }
+}
+
+}  // namespace
+
+bool AmxAvailable() {
+  static bool available = [] {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+    // AMX-BF16, AMX-TILE and AMX-INT8
+    if (!((edx >> 22) & 1) || !((edx >> 24) & 1) || !((edx >> 25) & 1)) {
+      return false;
+    }
+    // The tile data is not enabled for a process until it is requested.
+    const int kArchGetXCompPerm = 0x1022;
+    const int kArchReqXCompPerm = 0x1023;
+    const int kXFeatureXTileData = 18;
+    unsigned long bitmask = 0;  // NOLINT
+    if (syscall(SYS_arch_prctl, kArchReqXCompPerm, kXFeatureXTileData) != 0 ||
+        syscall(SYS_arch_prctl, kArchGetXCompPerm, &bitmask) != 0 ||
+        !((bitmask >> kXFeatureXTileData) & 1)) {
+      LOG(WARNING) << "The AMX tiles are not allowed by the OS";
+      return false;
+    }
+    VLOG(3) << "The AMX gemm is enabled";
+    return true;
+  }();
+  return available;
+}
+
+void AmxGemmInt8(int M,
+                 const int8_t* A,
+                 int lda,
+                 const AmxPackedB& B,
+                 float* C,
+                 int ldc,
+                 const float* scale,
+                 const float* bias,
+                 bool relu) {
+  int K = B.K();
+  int N = B.N();
+  int k_blocks = B.k_blocks();
+  // A is copied into the rows of full tiles, padded with zeros.
+  int a_stride = k_blocks * kInt8TileK;
+  int m_padded = (M + kBlockM - 1) / kBlockM * kBlockM;
+  thread_local std::vector<int8_t> a_buf;
+  a_buf.assign(static_cast<size_t>(m_padded) * a_stride, 0);
+  for (int i = 0; i < M; i++) {
+    memcpy(a_buf.data() + static_cast<size_t>(i) * a_stride, A + i * lda, K);
+  }
+  alignas(64) int32_t acc[kBlockM * kBlockN];
+  LoadTileConfig();
+  for (int m0 = 0; m0 < M; m0 += kBlockM) {
+    const int8_t* a_block = a_buf.data() + static_cast<size_t>(m0) * a_stride;
+    for (int nb = 0; nb < B.n_blocks(); nb += 2) {
+      int n0 = nb * kTileRows;
+      if (n0 >= N) break;
+      _tile_zero(0);
+      _tile_zero(1);
+      _tile_zero(2);
+      _tile_zero(3);
+      for (int kb = 0; kb < k_blocks; kb++) {
+        const int8_t* a_tile = a_block + kb * kInt8TileK;
+        _tile_loadd(4, a_tile, a_stride);
+        _tile_loadd(5, a_tile + kTileRows * a_stride, a_stride);
+        _tile_loadd(6, B.tile(nb, kb), kTileColsBytes);
+        _tile_loadd(7, B.tile(nb + 1, kb), kTileColsBytes);
+        _tile_dpbssd(0, 4, 6);
+        _tile_dpbssd(1, 4, 7);
+        _tile_dpbssd(2, 5, 6);
+        _tile_dpbssd(3, 5, 7);
+      }
+      const int stride = kBlockN * sizeof(int32_t);
+      _tile_stored(0, acc, stride);
+      _tile_stored(1, acc + kTileRows, stride);
+      _tile_stored(2, acc + kTileRows * kBlockN, stride);
+      _tile_stored(3, acc + kTileRows * kBlockN + kTileRows, stride);
+      StoreBlock(acc,
+                 std::min(kBlockM, M - m0),
+                 std::min(kBlockN, N - n0),
+                 C + m0 * ldc + n0,
+                 ldc,
+                 scale + n0,
+                 1.f,
+                 bias ? bias + n0 : nullptr,
+                 relu);
+    }
+  }
+  _tile_release();
+}
+
+void AmxGemmBF16(int M,
+                 const float* A,
+                 int lda,
+                 const AmxPackedB& B,
+                 float* C,
+                 int ldc,
+                 float alpha,
+                 const float* bias,
+                 bool relu) {
+  int K = B.K();
+  int N = B.N();
+  int k_blocks = B.k_blocks();
+  int a_stride = k_blocks * kBF16TileK;
+  int m_padded = (M + kBlockM - 1) / kBlockM * kBlockM;
+  thread_local std::vector<uint16_t> a_buf;
+  a_buf.assign(static_cast<size_t>(m_padded) * a_stride, 0);
+  for (int i = 0; i < M; i++) {
+    uint16_t* a_row = a_buf.data() + static_cast<size_t>(i) * a_stride;
+    for (int k = 0; k < K; k++) a_row[k] = FloatToBF16(A[i * lda + k]);
+  }
+  alignas(64) float acc[kBlockM * kBlockN];
+  const int a_stride_bytes = a_stride * sizeof(uint16_t);
+  LoadTileConfig();
+  for (int m0 = 0; m0 < M; m0 += kBlockM) {
+    const uint16_t* a_block =
+        a_buf.data() + static_cast<size_t>(m0) * a_stride;
+    for (int nb = 0; nb < B.n_blocks(); nb += 2) {
+      int n0 = nb * kTileRows;
+      if (n0 >= N) break;
+      _tile_zero(0);
+      _tile_zero(1);
+      _tile_zero(2);
+      _tile_zero(3);
+      for (int kb = 0; kb < k_blocks; kb++) {
+        const uint16_t* a_tile = a_block + kb * kBF16TileK;
+        _tile_loadd(4, a_tile, a_stride_bytes);
+        _tile_loadd(5, a_tile + kTileRows * a_stride, a_stride_bytes);
+        _tile_loadd(6, B.tile(nb, kb), kTileColsBytes);
+        _tile_loadd(7, B.tile(nb + 1, kb), kTileColsBytes);
+        _tile_dpbf16ps(0, 4, 6);
+        _tile_dpbf16ps(1, 4, 7);
+        _tile_dpbf16ps(2, 5, 6);
+        _tile_dpbf16ps(3, 5, 7);
+      }
+      const int stride = kBlockN * sizeof(float);
+      _tile_stored(0, acc, stride);
+      _tile_stored(1, acc + kTileRows, stride);
+      _tile_stored(2, acc + kTileRows * kBlockN, stride);
+      _tile_stored(3, acc + kTileRows * kBlockN + kTileRows, stride);
+      StoreBlock(acc,
+                 std::min(kBlockM, M - m0),
+                 std::min(kBlockN, N - n0),
+                 C + m0 * ldc + n0,
+                 ldc,
+                 nullptr,
+                 alpha,
+                 bias ? bias + n0 : nullptr,
+                 relu);
+    }
+  }
+  _tile_release();
+}
+
+#else
+
+bool AmxAvailable() { return false; }
+
+void AmxGemmInt8(int M,
+                 const int8_t* A,
+                 int lda,
+                 const AmxPackedB& B,
+                 float* C,
+                 int ldc,
+                 const float* scale,
+                 const float* bias,
+                 bool relu) {
+  LOG(FATAL) << "The AMX gemm is not built";
+}
+
+void AmxGemmBF16(int M,
+                 const float* A,
+                 int lda,
+                 const AmxPackedB& B,
+                 float* C,
+                 int ldc,
+                 float alpha,
+                 const float* bias,
+                 bool relu) {
+  LOG(FATAL) << "The AMX gemm is not built";
+}
+
+#endif  // GEMM_WITH_AMX
+
+#undef GEMM_WITH_AMX
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,90 @@
+/* Copyright (c) 2021 paddlepaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// Whether the cpu has the AMX tiles of int8 and bf16, and the OS allows this
+// process to use them, which is requested once by arch_prctl on Linux.
+bool AmxAvailable();
+
+// Whether the fp32 gemm of the weights may round to bf16 on AMX, which loses
+// precision, so it is enabled by LITE_X86_AMX_BF16.
+bool AmxBF16Enabled();
+
+// The matrix B[K, N], or B[N, K] if transposed, packed once into the layout
+// of the AMX tiles, in the blocks of 16 columns by the K of one tile. For
+// int8, each tile row holds 4 consecutive k of 16 columns, and for bf16, 2.
+// K and N are padded with zeros to the tiles.
+class AmxPackedB {
+ public:
+  void PackInt8(const int8_t* b, int K, int N, bool trans);
+  void PackBF16(const float* b, int K, int N, bool trans);
+
+  int K() const { return K_; }
+  int N() const { return N_; }
+  bool empty() const { return data_.empty(); }
+  // The tile of the n-th block of 16 columns and the k-th block of K.
+  const uint8_t* tile(int n_block, int k_block) const {
+    return data_.data() + (n_block * k_blocks_ + k_block) * kTileBytes;
+  }
+  int k_blocks() const { return k_blocks_; }
+  int n_blocks() const { return n_blocks_; }
+
+  static const int kTileBytes = 1024;
+
+ private:
+  int K_{0};
+  int N_{0};
+  int k_blocks_{0};
+  int n_blocks_{0};
+  std::vector<uint8_t> data_;
+};
+
+// C[M, N] = act(A[M, K] * B * scale + bias), where the products of the int8
+// A and B are summed into int32. `scale` and `bias` have N values, `bias` may
+// be null, and `relu` applies max(x, 0). Only called if AmxAvailable().
+void AmxGemmInt8(int M,
+                 const int8_t* A,
+                 int lda,
+                 const AmxPackedB& B,
+                 float* C,
+                 int ldc,
+                 const float* scale,
+                 const float* bias,
+                 bool relu);
+
+// C[M, N] = act(alpha * A[M, K] * B + bias), where A is rounded to bf16 and
+// the products are summed into fp32, B is packed by PackBF16.
+void AmxGemmBF16(int M,
+                 const float* A,
+                 int lda,
+                 const AmxPackedB& B,
+                 float* C,
+                 int ldc,
+                 float alpha,
+                 const float* bias,
+                 bool relu);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
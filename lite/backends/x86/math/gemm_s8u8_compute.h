@@ -57,6 +57,7 @@ class generate_gemm_s8u8_x86_kern {
                                        int relu_type,
                                        float relu_alpha) {
     PARAM_INIT
+    _use_vnni = gemm_s8u8_use_vnni();
     gemm_int8_init(M, N, K, bias);
   }
 
@@ -90,17 +91,31 @@ class generate_gemm_s8u8_x86_kern {
         cur_c = _C + loop_m * _ldc + loop_n;
 
         // kernel
-        gemm_kernel_loop_int8(min_m,
-                              min_n,
-                              _K,
-                              cur_a,
-                              _pack_B,
-                              cur_c,
-                              _ldc,
-                              _scale + loop_m,
-                              _re_bias + loop_m,
-                              _relu_type,
-                              _relu_alpha);
+        if (_use_vnni) {
+          gemm_kernel_loop_int8_vnni(min_m,
+                                     min_n,
+                                     _K,
+                                     cur_a,
+                                     _pack_B,
+                                     cur_c,
+                                     _ldc,
+                                     _scale + loop_m,
+                                     _re_bias + loop_m,
+                                     _relu_type,
+                                     _relu_alpha);
+        } else {
+          gemm_kernel_loop_int8(min_m,
+                                min_n,
+                                _K,
+                                cur_a,
+                                _pack_B,
+                                cur_c,
+                                _ldc,
+                                _scale + loop_m,
+                                _re_bias + loop_m,
+                                _relu_type,
+                                _relu_alpha);
+        }
       }
     }
   }
@@ -115,6 +130,7 @@ class generate_gemm_s8u8_x86_kern {
   bool _C_is_int8;
   bool _is_trans_A;
   bool _is_trans_B;
+  bool _use_vnni{false};
   // divide block param
   const int _unroll_n = 32;
   const int _unroll_m = 2;
@@ -45,6 +45,36 @@ void gemm_kernel_loop_int8(int M,
                            int relu_type,
                            float relu_alpha);
 
+// The same kernels accumulating by the AVX512-VNNI instructions, only called
+// if gemm_s8u8_use_vnni() returns true.
+void gemm_kernel_loop_int8_vnni(int M,
+                                int N,
+                                int K,
+                                int8_t* A,
+                                uint8_t* B,
+                                int8_t* C,
+                                int ldc,
+                                const float* scale,
+                                const float* bias,
+                                int relu_type,
+                                float relu_alpha);
+
+void gemm_kernel_loop_int8_vnni(int M,
+                                int N,
+                                int K,
+                                int8_t* A,
+                                uint8_t* B,
+                                float* C,
+                                int ldc,
+                                const float* scale,
+                                const float* bias,
+                                int relu_type,
+                                float relu_alpha);
+
+// Whether the VNNI kernels are built and the cpu supports them, detected once
+// by MayIUse(avx512_core_vnni).
+bool gemm_s8u8_use_vnni();
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
@@ -0,0 +1,51 @@
+/* Copyright (c) 2021 paddlepaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#ifdef __AVX2__
+
+#include "lite/backends/x86/math/gemm_s8u8_kernel.h"
+#include "lite/backends/x86/cpu_info.h"
+
+// Compiled with the AVX512-VNNI flags if the compiler supports them,
+// otherwise the kernels are the same as the AVX2 ones.
+#if defined(__AVX512VNNI__) && defined(__AVX512VL__)
+#define GEMM_S8U8_WITH_VNNI
+#endif
+
+#define GEMM_S8U8_KERNEL_LOOP gemm_kernel_loop_int8_vnni
+#include "lite/backends/x86/math/gemm_s8u8_kernel_impl.h"
+#undef GEMM_S8U8_KERNEL_LOOP
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+bool gemm_s8u8_use_vnni() {
+#ifdef GEMM_S8U8_WITH_VNNI
+  static bool use_vnni = MayIUse(avx512_core_vnni);
+  return use_vnni;
+#else
+  return false;
+#endif
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
+
+#undef GEMM_S8U8_WITH_VNNI
+
+#endif  // __AVX2__
@@ -16,7 +16,9 @@
 
 #include <string>
 #include "lite/backends/x86/math/activation_functions.h"
+#include "lite/backends/x86/math/avx/avx_mathfuns.h"
 #include "lite/backends/x86/math/blas.h"
+#include "lite/core/fast_math.h"
 #include "lite/core/tensor.h"
 #include "lite/utils/log/logging.h"
 
@@ -208,9 +210,11 @@ template <>
 void act_sigmoid<float>(const float* din, float* dout, int size, int threads) {
   int i = 0;
 #ifdef __AVX__
+  const bool fast_math = FastMath::Enabled();
   for (; i + 7 < size; i += 8) {
     __m256 a = _mm256_loadu_ps(din + i);
-    _mm256_storeu_ps(dout + i, x86_forward::avx::Sigmoid(a));
+    __m256 b = fast_math ? sigmoid256_ps_fast(a) : x86_forward::avx::Sigmoid(a);
+    _mm256_storeu_ps(dout + i, b);
   }
 #endif
   for (; i < size; i++) {
@@ -222,9 +226,11 @@ template <>
 void act_tanh<float>(const float* din, float* dout, int size, int threads) {
   int i = 0;
 #ifdef __AVX__
+  const bool fast_math = FastMath::Enabled();
   for (; i + 7 < size; i += 8) {
     __m256 a = _mm256_loadu_ps(din + i);
-    _mm256_storeu_ps(dout + i, x86_forward::avx::Tanh(a));
+    __m256 b = fast_math ? tanh256_ps_fast(a) : x86_forward::avx::Tanh(a);
+    _mm256_storeu_ps(dout + i, b);
   }
 #endif
   for (; i < size; i++) {
@@ -0,0 +1,118 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/numa.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+
+namespace {
+
+const char kNodePath[] = "/sys/devices/system/node/node";
+
+// Parse the cpu list of sysfs, e.g. "0-15,32-47".
+std::vector<int> ParseCpuList(const std::string& list) {
+  std::vector<int> cpus;
+  std::stringstream ss(list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    if (range.empty()) continue;
+    auto dash = range.find('-');
+    int first = std::stoi(range.substr(0, dash));
+    int last = dash == std::string::npos ? first
+                                         : std::stoi(range.substr(dash + 1));
+    for (int cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+}  // namespace
+
+int NumaNodeCount() {
+  int count = 0;
+  while (std::ifstream(kNodePath + std::to_string(count) + "/cpulist")) {
+    count++;
+  }
+  return count > 0 ? count : 1;
+}
+
+std::vector<int> NumaNodeCpus(int node) {
+  std::ifstream file(kNodePath + std::to_string(node) + "/cpulist");
+  std::string list;
+  if (!file || !std::getline(file, list)) return {};
+  return ParseCpuList(list);
+}
+
+bool BindThreadsToNumaNode(int node, int omp_threads) {
+  auto cpus = NumaNodeCpus(node);
+  if (cpus.empty()) {
+    LOG(WARNING) << "Unknown NUMA node " << node;
+    return false;
+  }
+  if (!BindThreadsToCpus(cpus, omp_threads)) {
+    LOG(WARNING) << "Failed to bind the threads to the NUMA node " << node;
+    return false;
+  }
+  return true;
+}
+
+std::vector<int> ThreadCpus() {
+  std::vector<int> cpus;
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) != 0) return cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET(cpu, &mask)) cpus.push_back(cpu);
+  }
+#endif
+  return cpus;
+}
+
+bool BindThreadsToCpus(const std::vector<int>& cpus, int omp_threads) {
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (auto cpu : cpus) {
+    CPU_SET(cpu, &mask);
+  }
+  bool success = sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#if defined(PADDLE_WITH_MKLML)
+  // The omp threads are pooled per thread which starts the parallel regions,
+  // so they keep the binding for the following runs of the caller.
+#pragma omp parallel num_threads(omp_threads) reduction(&& : success)
+  success = sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#endif
+  return success;
+#else
+  return false;
+#endif
+}
+
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,43 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+
+//! Get the number of the NUMA nodes, 1 if unknown.
+int NumaNodeCount();
+
+//! Get the cpus of the NUMA node `node`, empty if unknown.
+std::vector<int> NumaNodeCpus(int node);
+
+//! Bind the calling thread and the `omp_threads` omp threads it starts to
+//! the cpus of the NUMA node `node`. The memory first touched by them is
+//! then placed on the node by the kernel. Returns false if it fails.
+bool BindThreadsToNumaNode(int node, int omp_threads);
+
+//! Get the cpus the calling thread is bound to, empty if unknown.
+std::vector<int> ThreadCpus();
+
+//! Bind the calling thread and the `omp_threads` omp threads it starts to
+//! `cpus`. Returns false if it fails.
+bool BindThreadsToCpus(const std::vector<int>& cpus, int omp_threads);
+
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -36,6 +36,19 @@ static void SetNumThreads(int num_threads) {
 #endif
 }
 
+// Set the threads of MKL and the omp regions issued by the calling thread only.
+static void SetLocalNumThreads(int num_threads) {
+#ifdef PADDLE_WITH_MKLML
+  int real_num_threads = (std::max)(num_threads, 1);
+#ifdef LITE_WITH_STATIC_MKL
+  MKL_Set_Num_Threads_Local(real_num_threads);
+#else
+  x86::MKL_Set_Num_Threads_Local(real_num_threads);
+#endif
+  omp_set_num_threads(real_num_threads);
+#endif
+}
+
 static inline int64_t GetMaxThreads() {
   int64_t num_threads = 1;
 #ifdef PADDLE_WITH_MKLML
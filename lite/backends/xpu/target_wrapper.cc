@@ -60,12 +60,17 @@ void TargetWrapperXPU::ScatterL3Cache(
   size_t total_block_l3_size = 0, xdnn_ctx_l3_size = 0;
   l3_planner_->set_current_query_shape(query_shape, l3_size);
   std::vector<size_t>* plan = l3_planner_->get_current_plan();
+  // The plans loaded from the file may be tuned for another model.
+  if (plan != nullptr && plan->size() != l3_block_dict.size() + 1) {
+    VLOG(3) << "Ignore the XPU L3 plan of " << plan->size() - 1
+            << " blocks, while the model has " << l3_block_dict.size();
+    plan = nullptr;
+  }
   if (plan == nullptr) {
     XPU_CALL(tls_raw_ctx_->_l3_mgr.set(l3_ptr, l3_size));
     VLOG(3) << "XDNN CTX L3 Size is " << tls_raw_ctx_->_l3_mgr.get_size()
             << ", Remain L3 Size for Lite is " << 0;
   } else {
-    CHECK_EQ(plan->size(), l3_block_dict.size() + 1);
     xdnn_ctx_l3_size = plan->back();
     for (size_t i = 0; i < l3_block_dict.size(); i++) {
       size_t cur_block_size = plan->data()[i];
@@ -89,6 +94,7 @@ void TargetWrapperXPU::ScatterL3Cache(
 void TargetWrapperXPU::MallocL3Cache(
     const std::vector<std::vector<int64_t>>& query_shape) {
   TargetWrapperXPU::GetRawContext();
+  l3_planner_->load_plans(l3_autotune_file);
   // malloc shared l3
   if (!TargetWrapperXPU::IsSharedL3Created() && shared_l3_size > 0) {
     mutex_l3_.lock();
@@ -121,19 +127,21 @@ void TargetWrapperXPU::MallocL3Cache(
 }
 
 void TargetWrapperXPU::FreeL3Cache() {
+  bool tuned = false;
   if (local_l3_size != 0) {
     if (local_l3_ptr_ != nullptr) {
       TargetWrapperXPU::Free(local_l3_ptr_);
       local_l3_ptr_ = nullptr;
       XPU_CALL(tls_raw_ctx_->_l3_mgr.set(nullptr, 0));
     }
-    l3_planner_->run_autotune(l3_block_dict, local_l3_size);
+    tuned = l3_planner_->run_autotune(l3_block_dict, local_l3_size);
   } else if (need_l3_mutex && TargetWrapperXPU::IsSharedL3Created()) {
     XPU_CALL(xpu_wait(TargetWrapperXPU::get_xpu_stream()));
     XPU_CALL(tls_raw_ctx_->_l3_mgr.set(nullptr, 0));
     mutex_l3_.unlock();
-    l3_planner_->run_autotune(l3_block_dict, shared_l3_size);
+    tuned = l3_planner_->run_autotune(l3_block_dict, shared_l3_size);
   }
+  if (tuned) l3_planner_->save_plans();
   for (size_t i = 0; i < l3_block_dict.size(); i++) {
     l3_block_dict[i]->clear();
   }
@@ -170,6 +178,7 @@ LITE_THREAD_LOCAL size_t TargetWrapperXPU::local_l3_size{
     std::numeric_limits<size_t>::max()};
 LITE_THREAD_LOCAL size_t TargetWrapperXPU::local_gm_size{
     0x4000000};  // 64 * 1024 * 1024
+LITE_THREAD_LOCAL std::string TargetWrapperXPU::l3_autotune_file;  // NOLINT
 LITE_THREAD_LOCAL void* TargetWrapperXPU::local_l3_ptr_{nullptr};
 void* TargetWrapperXPU::shared_l3_ptr_{nullptr};
 size_t TargetWrapperXPU::shared_l3_size{0};
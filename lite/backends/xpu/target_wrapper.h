@@ -170,6 +170,8 @@ class TargetWrapper<TARGET(kXPU)> {
   static LITE_THREAD_LOCAL bool need_l3_mutex;    // model level l3 size
   static LITE_THREAD_LOCAL size_t local_l3_size;  // model level l3 size
   static LITE_THREAD_LOCAL size_t local_gm_size;
+  // the file to save the l3 plans tuned into, and load them from
+  static LITE_THREAD_LOCAL std::string l3_autotune_file;  // NOLINT
   static size_t shared_l3_size;  // model level l3 size
   static LITE_THREAD_LOCAL std::vector<XPUL3CacheBlock*>
       l3_block_dict;  // l3 cache block used between op layers
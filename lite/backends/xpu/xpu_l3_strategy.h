@@ -13,8 +13,14 @@
 // limitations under the License.
 #pragma once
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
 #include <map>
 #include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>  // NOLINT
 #include <vector>
 #include "lite/backends/xpu/xpu_l3_cache_block.h"
 #include "lite/utils/macros.h"
@@ -49,11 +55,52 @@ class XPUL3Planner {
     }
   }
 
-  void run_autotune(const std::vector<XPUL3CacheBlock*>& l3_block_dict,
+  // Merge the plans saved in `path` into plans_, the ones already tuned are
+  // kept. Loading the same file again does nothing.
+  void load_plans(const std::string& path) {
+    if (path.empty() || path == plans_path_) return;
+    plans_path_ = path;
+    size_t count = merge_plans(path);
+    VLOG(3) << "Loaded " << count << " XPU L3 plans from " << path;
+  }
+
+  // Save plans_ into the file loaded by load_plans(), merged with the plans
+  // saved into it by the other threads and processes since loaded.
+  void save_plans() {
+    if (plans_path_.empty()) return;
+    merge_plans(plans_path_);
+    // Written into a temporary file first, so the processes loading the plans
+    // at the same time never see a partial file.
+    std::stringstream tmp_path;
+    tmp_path << plans_path_ << ".tmp"
+             << std::hash<std::thread::id>()(std::this_thread::get_id());
+    {
+      std::ofstream file(tmp_path.str());
+      for (auto& plan : plans_) {
+        for (auto x : plan.first) file << x << " ";
+        file << ":";
+        for (auto x : plan.second) file << " " << x;
+        file << "\n";
+      }
+      if (!file.good()) {
+        LOG(WARNING) << "Failed to save the XPU L3 plans into " << plans_path_;
+        file.close();
+        std::remove(tmp_path.str().c_str());
+        return;
+      }
+    }
+    if (std::rename(tmp_path.str().c_str(), plans_path_.c_str()) != 0) {
+      LOG(WARNING) << "Failed to save the XPU L3 plans into " << plans_path_;
+      std::remove(tmp_path.str().c_str());
+    }
+  }
+
+  // Returns whether a new plan is tuned.
+  bool run_autotune(const std::vector<XPUL3CacheBlock*>& l3_block_dict,
                     size_t l3_size) {
     if (l3_block_dict.size() == 0 || l3_size <= 0 || query_shape_.size() == 0 ||
         plans_.find(query_shape_) != plans_.end()) {
-      return;
+      return false;
     }
     VLOG(3) << "AutoTune XPU L3 Cache Block Start.";
     struct node {
@@ -95,7 +142,7 @@ class XPUL3Planner {
       }
     }
     if (records.size() <= 0) {
-      return;
+      return false;
     }
     std::vector<node> res(records[0]);
     for (size_t block_idx = 1; block_idx < records.size(); block_idx++) {
@@ -174,13 +221,41 @@ class XPUL3Planner {
     final_res[l3_block_dict.size()] = xdnn_ctx_l3_size;
     plans_.insert({query_shape_, final_res});
     VLOG(3) << "AutoTune XPU L3 Cache Block End.";
+    return true;
   }
 
  private:
+  // Insert the plans in `path` missing in plans_, one plan per line in the
+  // format "shape0 shape1 ... shapen l3_size : block0 ... xdnn_ctx_l3_size".
+  // Returns the number of the plans read.
+  size_t merge_plans(const std::string& path) {
+    std::ifstream file(path);
+    size_t count = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+      auto pos = line.find(':');
+      if (pos == std::string::npos) continue;
+      std::vector<int64_t> shape;
+      std::vector<size_t> plan;
+      std::stringstream shape_ss(line.substr(0, pos));
+      std::stringstream plan_ss(line.substr(pos + 1));
+      int64_t dim;
+      size_t size;
+      while (shape_ss >> dim) shape.push_back(dim);
+      while (plan_ss >> size) plan.push_back(size);
+      if (shape.empty() || plan.empty()) continue;
+      plans_.insert({shape, plan});
+      count++;
+    }
+    return count;
+  }
+
   // plans_ format: [query_shape_] : [block0 block1 ... blockn xdnn_ctx_l3_size]
   std::map<std::vector<int64_t>, std::vector<size_t>> plans_;
   // query_shape format: [shape0 shape1 ... shapen l3_size]
   std::vector<int64_t> query_shape_;
+  // The file the plans are loaded from and saved into.
+  std::string plans_path_;
 };
 
 }  // namespace lite
@@ -0,0 +1,79 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/adaptive_threads.h"
+#include <algorithm>
+#include "lite/utils/log/logging.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+// The tail latency grows by more than 1/kSlowdownRatio of the last window.
+constexpr uint64_t kSlowdownRatio = 5;
+}  // namespace
+
+constexpr int AdaptiveThreads::kWindow;
+constexpr int AdaptiveThreads::kRecoverWindows;
+
+AdaptiveThreads::AdaptiveThreads(int max_threads)
+    : max_threads_(std::max(max_threads, 1)),
+      threads_(max_threads_),
+      tail_us_(max_threads_ + 1, 0) {
+  window_.reserve(kWindow);
+}
+
+void AdaptiveThreads::Update(uint64_t latency_us,
+                             const std::function<bool()>& throttled) {
+  window_.push_back(latency_us);
+  if (static_cast<int>(window_.size()) >= kWindow) {
+    EndWindow(throttled());
+    window_.clear();
+  }
+}
+
+void AdaptiveThreads::EndWindow(bool throttled) {
+  windows_++;
+  std::sort(window_.begin(), window_.end());
+  uint64_t tail = window_[window_.size() * 99 / 100];
+  uint64_t last = tail_us_[threads_];
+  tail_us_[threads_] = tail;
+  if (probe_from_ > 0) {
+    // Keep the probed threads only if they beat the ones before the probe.
+    if (tail >= tail_us_[probe_from_]) {
+      threads_ = probe_from_;
+      // Back off, the probes cost the tail latency too.
+      next_probe_ = windows_ + kRecoverWindows / 2;
+    }
+    VLOG(3) << "Adaptive threads: " << threads_ << ", tail latency of "
+            << probe_from_ << " threads: " << tail_us_[probe_from_]
+            << " us, probed: " << tail << " us";
+    probe_from_ = 0;
+    return;
+  }
+  bool slower = last > 0 && tail > last + last / kSlowdownRatio;
+  if (windows_ < next_probe_) {
+    return;
+  }
+  if ((throttled || slower) && threads_ > 1) {
+    probe_from_ = threads_;
+    threads_--;
+  } else if (windows_ % kRecoverWindows == 0 && threads_ < max_threads_) {
+    probe_from_ = threads_;
+    threads_++;
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
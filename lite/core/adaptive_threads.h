@@ -0,0 +1,65 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+// Adjusts the threads of a predictor between its runs, so that the tail
+// latency stays low when the big cores are throttled by the heat in the
+// sustained inference, instead of sticking to the threads that are the best
+// only while the device is cool.
+//
+// The latencies are collected in windows of kWindow runs. At the end of a
+// window, one thread less is probed if the active cores are throttled or the
+// tail latency grows noticeably, and one thread more is probed from time to
+// time to recover once the device cools down. A probe is kept only if its
+// tail latency is lower, otherwise the probes pause for a while. Not
+// thread-safe.
+class AdaptiveThreads {
+ public:
+  static constexpr int kWindow = 20;
+  // Probe one thread more every kRecoverWindows windows.
+  static constexpr int kRecoverWindows = 8;
+
+  explicit AdaptiveThreads(int max_threads);
+
+  // The threads of the next run.
+  int threads() const { return threads_; }
+  // Record a run of `latency_us` with threads(). `throttled` tells that the
+  // active cores are capped below their max frequencies, which is sampled
+  // only once at the end of a window, since it reads the sysfs.
+  void Update(uint64_t latency_us, const std::function<bool()>& throttled);
+
+ private:
+  void EndWindow(bool throttled);
+
+  int max_threads_;
+  int threads_;
+  std::vector<uint64_t> window_;
+  // The tail latency of the last window of each threads, 0 if not measured.
+  std::vector<uint64_t> tail_us_;
+  // The threads before the probe, 0 if not probing.
+  int probe_from_{0};
+  int windows_{0};
+  // No probe before this window after a failed one.
+  int next_probe_{0};
+};
+
+}  // namespace lite
+}  // namespace paddle
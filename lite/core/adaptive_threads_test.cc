@@ -0,0 +1,79 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/adaptive_threads.h"
+#include <gtest/gtest.h>
+
+namespace paddle {
+namespace lite {
+
+namespace {
+// Run a window with the latency of each threads given by `latency`.
+template <typename F>
+void RunWindow(AdaptiveThreads* adaptive, F latency, bool throttled) {
+  for (int i = 0; i < AdaptiveThreads::kWindow; ++i) {
+    adaptive->Update(latency(adaptive->threads()),
+                     [throttled]() { return throttled; });
+  }
+}
+}  // namespace
+
+TEST(AdaptiveThreads, throttled) {
+  AdaptiveThreads adaptive(4);
+  EXPECT_EQ(adaptive.threads(), 4);
+  // Cool: 4 threads are the fastest, and stay.
+  auto cool = [](int threads) { return 1000 / threads; };
+  RunWindow(&adaptive, cool, false);
+  EXPECT_EQ(adaptive.threads(), 4);
+  // Throttled: the 4th thread lands on a slow core, 3 threads win the probe.
+  auto hot = [](int threads) { return threads == 4 ? 500 : 1000 / threads; };
+  RunWindow(&adaptive, hot, true);
+  EXPECT_EQ(adaptive.threads(), 3);
+  RunWindow(&adaptive, hot, true);
+  EXPECT_EQ(adaptive.threads(), 3);
+  // Throttled but 2 threads are slower, back to 3 after the probe.
+  RunWindow(&adaptive, hot, true);
+  EXPECT_EQ(adaptive.threads(), 2);
+  RunWindow(&adaptive, hot, true);
+  EXPECT_EQ(adaptive.threads(), 3);
+}
+
+TEST(AdaptiveThreads, sample_throttled_per_window) {
+  AdaptiveThreads adaptive(4);
+  int samples = 0;
+  for (int i = 0; i < AdaptiveThreads::kWindow * 3; ++i) {
+    adaptive.Update(100, [&samples]() {
+      samples++;
+      return false;
+    });
+  }
+  EXPECT_EQ(samples, 3);
+}
+
+TEST(AdaptiveThreads, recover) {
+  AdaptiveThreads adaptive(2);
+  auto hot = [](int threads) { return threads == 2 ? 900 : 600; };
+  RunWindow(&adaptive, hot, true);
+  RunWindow(&adaptive, hot, true);
+  EXPECT_EQ(adaptive.threads(), 1);
+  // Cooled down, one thread more is probed and kept in a while.
+  auto cool = [](int threads) { return 600 / threads; };
+  for (int i = 0; i < AdaptiveThreads::kRecoverWindows + 1; ++i) {
+    RunWindow(&adaptive, cool, false);
+  }
+  EXPECT_EQ(adaptive.threads(), 2);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,108 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/async_executor.h"
+#include <utility>
+#include "lite/utils/env.h"
+#include "lite/utils/log/logging.h"
+
+namespace paddle {
+namespace lite {
+
+AsyncExecutor& AsyncExecutor::Global() {
+  // Never destroyed, so that the pending tasks at exit are not joined with
+  // any static objects which might have been destructed.
+  static auto* x =
+      new AsyncExecutor(GetIntFromEnv(LITE_ASYNC_EXECUTOR_THREADS, 2));
+  return *x;
+}
+
+AsyncExecutor::AsyncExecutor(int thread_num) {
+  if (thread_num < 1) {
+    thread_num = 1;
+  }
+  for (int i = 0; i < thread_num; ++i) {
+    workers_.emplace_back([this]() {
+      while (true) {
+        TASK task;
+        {
+          std::unique_lock<std::mutex> _l(mutex_);
+          cv_.wait(_l, [this]() { return stop_ || !queue_.empty(); });
+          if (queue_.empty()) {
+            return;
+          }
+          task = std::move(queue_.front());
+          queue_.pop_front();
+        }
+        task();
+      }
+    });
+  }
+}
+
+AsyncExecutor::~AsyncExecutor() {
+  {
+    std::lock_guard<std::mutex> _l(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void AsyncExecutor::Submit(TASK task) {
+  {
+    std::lock_guard<std::mutex> _l(mutex_);
+    CHECK(!stop_) << "Submit a task to a stopped AsyncExecutor.";
+    queue_.push_back(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+void AsyncExecutor::Submit(const std::shared_ptr<Strand>& strand, TASK task) {
+  CHECK(strand);
+  {
+    std::lock_guard<std::mutex> _l(strand->mutex_);
+    strand->tasks_.push_back(std::move(task));
+    if (strand->scheduled_) {
+      return;
+    }
+    strand->scheduled_ = true;
+  }
+  Submit([this, strand]() { Drain(strand); });
+}
+
+void AsyncExecutor::Drain(const std::shared_ptr<Strand>& strand) {
+  TASK task;
+  {
+    std::lock_guard<std::mutex> _l(strand->mutex_);
+    task = std::move(strand->tasks_.front());
+    strand->tasks_.pop_front();
+  }
+  task();
+  {
+    std::lock_guard<std::mutex> _l(strand->mutex_);
+    if (strand->tasks_.empty()) {
+      strand->scheduled_ = false;
+      return;
+    }
+  }
+  // Requeue the strand rather than draining it here, which gives the other
+  // strands a fair chance to run.
+  Submit([this, strand]() { Drain(strand); });
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,68 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <condition_variable>  //NOLINT
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>   //NOLINT
+#include <thread>  //NOLINT
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+// The environment variable to set the thread number of the global executor.
+#define LITE_ASYNC_EXECUTOR_THREADS "LITE_ASYNC_EXECUTOR_THREADS"
+
+// A small thread pool executing the asynchronous tasks of the predictors, such
+// as RunAsync(). It does not run any kernels itself, the parallel kernels are
+// still executed by the thread pool of the predictor.
+class AsyncExecutor {
+ public:
+  typedef std::function<void()> TASK;
+
+  // The tasks submitted to the same strand are executed one by one in the
+  // order of submission, while the tasks of different strands run in parallel.
+  class Strand {
+   private:
+    friend class AsyncExecutor;
+    std::mutex mutex_;
+    std::deque<TASK> tasks_;
+    bool scheduled_{false};
+  };
+
+  // The global executor, its thread number is taken from the environment
+  // variable LITE_ASYNC_EXECUTOR_THREADS and defaults to 2.
+  static AsyncExecutor& Global();
+
+  explicit AsyncExecutor(int thread_num);
+  ~AsyncExecutor();
+
+  void Submit(TASK task);
+  void Submit(const std::shared_ptr<Strand>& strand, TASK task);
+
+ private:
+  void Drain(const std::shared_ptr<Strand>& strand);
+
+  std::vector<std::thread> workers_;
+  std::deque<TASK> queue_;
+  std::condition_variable cv_;
+  std::mutex mutex_;
+  bool stop_{false};
+};
+
+}  // namespace lite
+}  // namespace paddle
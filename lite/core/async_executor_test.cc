@@ -0,0 +1,71 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/async_executor.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <future>  // NOLINT
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+TEST(AsyncExecutor, strand_order) {
+  AsyncExecutor executor(4);
+  auto strand_a = std::make_shared<AsyncExecutor::Strand>();
+  auto strand_b = std::make_shared<AsyncExecutor::Strand>();
+  std::vector<int> order_a;
+  std::vector<int> order_b;
+  std::promise<void> done_a;
+  std::promise<void> done_b;
+  const int kTasks = 100;
+  for (int i = 0; i < kTasks; ++i) {
+    executor.Submit(strand_a, [&, i]() {
+      order_a.push_back(i);
+      if (i == kTasks - 1) done_a.set_value();
+    });
+    executor.Submit(strand_b, [&, i]() {
+      order_b.push_back(i);
+      if (i == kTasks - 1) done_b.set_value();
+    });
+  }
+  done_a.get_future().wait();
+  done_b.get_future().wait();
+  ASSERT_EQ(order_a.size(), kTasks);
+  ASSERT_EQ(order_b.size(), kTasks);
+  for (int i = 0; i < kTasks; ++i) {
+    ASSERT_EQ(order_a[i], i);
+    ASSERT_EQ(order_b[i], i);
+  }
+}
+
+TEST(AsyncExecutor, global) {
+  std::atomic<int> count{0};
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < 10; ++i) {
+    auto promise = std::make_shared<std::promise<void>>();
+    futures.push_back(promise->get_future());
+    AsyncExecutor::Global().Submit([&count, promise]() {
+      count++;
+      promise->set_value();
+    });
+  }
+  for (auto& future : futures) {
+    future.wait();
+  }
+  ASSERT_EQ(count.load(), 10);
+}
+
+}  // namespace lite
+}  // namespace paddle
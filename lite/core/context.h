@@ -26,6 +26,9 @@
 #include "lite/backends/opencl/cl_context.h"
 #include "lite/backends/opencl/cl_runtime.h"
 #endif
+#ifdef LITE_WITH_VULKAN
+#include "lite/backends/vulkan/vk_runtime.h"
+#endif
 #ifdef LITE_WITH_MLU
 #include <cnml.h>
 #include <cnrt.h>
@@ -39,8 +42,10 @@
 #include "lite/backends/nnadapter/nnadapter_wrapper.h"
 #endif
 
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <set>
 #include <string>
 #include <utility>
@@ -71,6 +76,7 @@ using MLUContext = Context<TargetType::kMLU>;
 using IntelFPGAContext = Context<TargetType::kIntelFPGA>;
 using NNAdapterContext = Context<TargetType::kNNAdapter>;
 using MTLContext = Context<TargetType::kMetal>;
+using VulkanContext = Context<TargetType::kVulkan>;
 
 template <>
 class Context<TargetType::kHost> {
@@ -168,6 +174,50 @@ class Context<TargetType::kNNAdapter> {
     return var->Get<std::map<std::string, std::vector<std::vector<int64_t>>>>();
   }
 
+  static void SetNNAdapterPrecompileDynamicShapes(Scope* scope,
+                                                 bool precompile) {
+    auto var = scope->Var("NNADAPTER_PRECOMPILE_DYNAMIC_SHAPES");
+    CHECK(var);
+    *var->GetMutable<bool>() = precompile;
+  }
+
+  static bool NNAdapterPrecompileDynamicShapes(Scope* scope) {
+    auto var = scope->FindVar("NNADAPTER_PRECOMPILE_DYNAMIC_SHAPES");
+    if (!var) return false;
+    return var->Get<bool>();
+  }
+
+  // Whether a subgraph is compiled for the input shapes.
+  typedef std::function<bool(
+      const std::map<std::string, std::vector<int64_t>>&)>
+      NNAdapterShapeReadyFunc;
+
+  // Register the readiness of the subgraph `key` in the root scope of
+  // `scope`, or unregister it if `func` is empty.
+  static void SetNNAdapterShapeReadyFunc(Scope* scope,
+                                         const void* key,
+                                         NNAdapterShapeReadyFunc func) {
+    std::lock_guard<std::mutex> lock(NNAdapterShapeReadyMutex());
+    auto* funcs = NNAdapterShapeReadyFuncs(scope);
+    if (func) {
+      (*funcs)[key] = std::move(func);
+    } else {
+      funcs->erase(key);
+    }
+  }
+
+  // Whether all the subgraphs under the root scope of `scope` are compiled
+  // for the input shapes.
+  static bool NNAdapterShapeReady(
+      Scope* scope,
+      const std::map<std::string, std::vector<int64_t>>& input_shapes) {
+    std::lock_guard<std::mutex> lock(NNAdapterShapeReadyMutex());
+    for (auto& item : *NNAdapterShapeReadyFuncs(scope)) {
+      if (!item.second(input_shapes)) return false;
+    }
+    return true;
+  }
+
   static void SetNNAdapterModelCacheBuffers(
       Scope* scope,
       const std::map<std::string, std::vector<char>>& model_cache_buffers) {
@@ -254,6 +304,21 @@ class Context<TargetType::kNNAdapter> {
     return var->Get<std::string>();
   }
 
+  static void SetNNAdapterSubgraphCostTablePath(
+      Scope* scope, const std::string& subgraph_cost_table_path) {
+    auto var = scope->Var("NNADAPTER_SUBGRAPH_COST_TABLE_PATH");
+    CHECK(var);
+    auto data = var->GetMutable<std::string>();
+    CHECK(data);
+    *data = subgraph_cost_table_path;
+  }
+
+  static std::string NNAdapterSubgraphCostTablePath(Scope* scope) {
+    auto var = scope->FindVar("NNADAPTER_SUBGRAPH_COST_TABLE_PATH");
+    if (!var) return "";
+    return var->Get<std::string>();
+  }
+
   static void SetNNAdapterSubgraphPartitionConfigBuffer(
       Scope* scope, const std::string& subgraph_partition_config_buffer) {
     auto var = scope->Var("NNADAPTER_SUBGRAPH_PARTITION_CONFIG_BUFFER");
@@ -305,6 +370,19 @@ class Context<TargetType::kNNAdapter> {
     if (!var) return "";
     return var->Get<std::string>();
   }
+
+ private:
+  static std::mutex& NNAdapterShapeReadyMutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  static std::map<const void*, NNAdapterShapeReadyFunc>*
+  NNAdapterShapeReadyFuncs(Scope* scope) {
+    while (scope->MutableParent()) scope = scope->MutableParent();
+    return scope->Var("NNADAPTER_SHAPE_READY_FUNCS")
+        ->GetMutable<std::map<const void*, NNAdapterShapeReadyFunc>>();
+  }
 };
 #endif
 
@@ -351,6 +429,9 @@ class Context<TargetType::kARM> {
   int l3_cache_size() const { return DeviceInfo::Global().l3_cache_size(); }
   int llc_size() const { return DeviceInfo::Global().llc_size(); }
   bool has_dot() const { return DeviceInfo::Global().has_dot(); }
+  bool has_i8mm() const { return DeviceInfo::Global().has_i8mm(); }
+  bool has_bf16() const { return DeviceInfo::Global().has_bf16(); }
+  bool has_sve() const { return DeviceInfo::Global().has_sve(); }
   bool has_fp16() const { return DeviceInfo::Global().has_fp16(); }
   bool has_a53_valid() const { return DeviceInfo::Global().set_a53_valid(); }
 
@@ -524,6 +605,24 @@ class Context<TargetType::kOpenCL> {
 };
 #endif
 
+#ifdef LITE_WITH_VULKAN
+template <>
+class Context<TargetType::kVulkan> {
+ public:
+  void InitOnce() {
+    if (!VKRuntime::Global()->IsInitSuccess()) {
+      LOG(ERROR) << "Vulkan runtime init failed";
+    }
+  }
+
+  void CopySharedTo(VulkanContext* ctx) {}
+
+  VKRuntime* runtime() { return VKRuntime::Global(); }
+
+  std::string name() const { return "VulkanContext"; }
+};
+#endif
+
 #ifdef LITE_WITH_METAL
 template <>
 class Context<TargetType::kMetal> {
@@ -615,6 +714,12 @@ class ContextScheduler {
             &ctx->As<OpenCLContext>());
         break;
 #endif
+#ifdef LITE_WITH_VULKAN
+      case TARGET(kVulkan):
+        kernel_contexts_[TargetType::kVulkan].As<VulkanContext>().CopySharedTo(
+            &ctx->As<VulkanContext>());
+        break;
+#endif
 #ifdef LITE_WITH_METAL
       case TARGET(kMetal):
         kernel_contexts_[TargetType::kMetal].As<MTLContext>().CopySharedTo(
@@ -690,6 +795,9 @@ class ContextScheduler {
 #ifdef LITE_WITH_METAL
     InitContext<TargetType::kMetal, MTLContext>();
 #endif
+#ifdef LITE_WITH_VULKAN
+    InitContext<TargetType::kVulkan, VulkanContext>();
+#endif
 #ifdef LITE_WITH_FPGA
     InitContext<TargetType::kFPGA, FPGAContext>();
 #endif
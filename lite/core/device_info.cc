@@ -48,6 +48,9 @@
 #ifdef LITE_WITH_LINUX
 #include <sys/syscall.h>
 #include <unistd.h>
+#if defined(__aarch64__)
+#include <sys/auxv.h>
+#endif
 #endif
 #ifdef LITE_WITH_ANDROID
 #include <sys/system_properties.h>
@@ -221,6 +224,15 @@ void get_cpu_arch(std::vector<ARMArch>* archs, const int cpu_num) {
           // 888
           arch_type = kX1;
           break;
+        case 0xd46:
+          arch_type = kA510;
+          break;
+        case 0xd47:
+          arch_type = kA710;
+          break;
+        case 0xd48:
+          arch_type = kX2;
+          break;
         default:
           LOG(ERROR) << "Unknow cpu arch: " << arch_id;
       }
@@ -348,6 +360,44 @@ int get_max_freq_khz(int cpuid) {
   return max_freq_khz;
 }
 
+// The capacity of the core normalized by the kernel to 1024 for the fastest
+// one, which accounts for both the frequency and the micro architecture.
+int get_cpu_capacity(int cpuid) {
+  char path[256];
+  snprintf(
+      path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpu_capacity", cpuid);
+  FILE* fp = fopen(path, "rb");
+  if (!fp) {
+    return -1;
+  }
+  int capacity = -1;
+  if (fscanf(fp, "%d", &capacity) != 1) {
+    capacity = -1;
+  }
+  fclose(fp);
+  return capacity;
+}
+
+// The frequency the core is currently capped at by the cpufreq policy, which
+// is lowered by the thermal throttling.
+int get_capped_freq_khz(int cpuid) {
+  char path[256];
+  snprintf(path,
+           sizeof(path),
+           "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_max_freq",
+           cpuid);
+  FILE* fp = fopen(path, "rb");
+  if (!fp) {
+    return -1;
+  }
+  int freq_khz = -1;
+  if (fscanf(fp, "%d", &freq_khz) != 1) {
+    freq_khz = -1;
+  }
+  fclose(fp);
+  return freq_khz;
+}
+
 void sort_cpuid_by_max_freq(const std::vector<int>& max_freqs,
                             std::vector<int>* cpu_ids,
                             std::vector<int>* cluster_ids) {
@@ -540,6 +590,78 @@ void DeviceInfo::SetDotInfo(int argc, ...) {
   va_end(arg_ptr);
 }
 
+void DeviceInfo::SetI8mmInfo(int argc, ...) {
+  va_list arg_ptr;
+  va_start(arg_ptr, argc);
+  i8mm_.resize(core_num_);
+  if (argc == 1) {
+    bool flag = va_arg(arg_ptr, int) > 0;
+    for (int i = 0; i < core_num_; ++i) {
+      i8mm_[i] = flag;
+    }
+  } else {
+    bool flag_big_core = va_arg(arg_ptr, int) > 0;
+    bool flag_little_core = va_arg(arg_ptr, int) > 0;
+    int big_core_num = big_core_ids_.size();
+    int little_core_num = little_core_ids_.size();
+    for (int i = 0; i < big_core_num; ++i) {
+      i8mm_[big_core_ids_[i]] = flag_big_core;
+    }
+    for (int i = 0; i < little_core_num; ++i) {
+      i8mm_[little_core_ids_[i]] = flag_little_core;
+    }
+  }
+  va_end(arg_ptr);
+}
+
+void DeviceInfo::SetBF16Info(int argc, ...) {
+  va_list arg_ptr;
+  va_start(arg_ptr, argc);
+  bf16_.resize(core_num_);
+  if (argc == 1) {
+    bool flag = va_arg(arg_ptr, int) > 0;
+    for (int i = 0; i < core_num_; ++i) {
+      bf16_[i] = flag;
+    }
+  } else {
+    bool flag_big_core = va_arg(arg_ptr, int) > 0;
+    bool flag_little_core = va_arg(arg_ptr, int) > 0;
+    int big_core_num = big_core_ids_.size();
+    int little_core_num = little_core_ids_.size();
+    for (int i = 0; i < big_core_num; ++i) {
+      bf16_[big_core_ids_[i]] = flag_big_core;
+    }
+    for (int i = 0; i < little_core_num; ++i) {
+      bf16_[little_core_ids_[i]] = flag_little_core;
+    }
+  }
+  va_end(arg_ptr);
+}
+
+void DeviceInfo::SetSVEInfo(int argc, ...) {
+  va_list arg_ptr;
+  va_start(arg_ptr, argc);
+  sve_.resize(core_num_);
+  if (argc == 1) {
+    bool flag = va_arg(arg_ptr, int) > 0;
+    for (int i = 0; i < core_num_; ++i) {
+      sve_[i] = flag;
+    }
+  } else {
+    bool flag_big_core = va_arg(arg_ptr, int) > 0;
+    bool flag_little_core = va_arg(arg_ptr, int) > 0;
+    int big_core_num = big_core_ids_.size();
+    int little_core_num = little_core_ids_.size();
+    for (int i = 0; i < big_core_num; ++i) {
+      sve_[big_core_ids_[i]] = flag_big_core;
+    }
+    for (int i = 0; i < little_core_num; ++i) {
+      sve_[little_core_ids_[i]] = flag_little_core;
+    }
+  }
+  va_end(arg_ptr);
+}
+
 void DeviceInfo::SetFP16Info(int argc, ...) {
   va_list arg_ptr;
   va_start(arg_ptr, argc);
@@ -680,6 +802,22 @@ void DeviceInfo::SetArchInfo(int argc, ...) {
 
 bool DeviceInfo::SetCPUInfoByName() {
   /* Snapdragon */
+  if (dev_name_.find("SM8450") != std::string::npos) {  // 8 Gen 1
+    core_num_ = 8;
+    core_ids_ = {0, 1, 2, 3, 4, 5, 6, 7};
+    big_core_ids_ = {4, 5, 6, 7};
+    little_core_ids_ = {0, 1, 2, 3};
+    cluster_ids_ = {1, 1, 1, 1, 0, 0, 0, 0};
+    SetArchInfo(3, kX2, kA710, kA510);
+    SetCacheInfo(0, 3, 64 * 1024, 64 * 1024, 32 * 1024);
+    SetCacheInfo(1, 3, 1024 * 1024, 512 * 1024, 128 * 1024);
+    SetCacheInfo(2, 1, 6 * 1024 * 1024);
+    SetFP16Info(1, 1);
+    SetDotInfo(1, 1);
+    SetI8mmInfo(1, 1);
+    SetBF16Info(1, 1);
+    return true;
+  }
   if (dev_name_.find("SM8350") != std::string::npos) {  // 888
     core_num_ = 8;
     core_ids_ = {0, 1, 2, 3, 4, 5, 6, 7};
@@ -1105,6 +1243,9 @@ int DeviceInfo::Setup() {
   SetFP32Info(1, 1);
   SetFP16Info(1, 0);
   SetDotInfo(1, 0);
+  SetI8mmInfo(1, 0);
+  SetBF16Info(1, 0);
+  SetSVEInfo(1, 0);
   max_freqs_.resize(core_num_);
   min_freqs_.resize(core_num_);
 #ifdef LITE_WITH_LINUX
@@ -1115,11 +1256,38 @@ int DeviceInfo::Setup() {
     max_freqs_[i] = max_freq / 1000;
     min_freqs_[i] = min_freq / 1000;
   }
+  // Fall back to the max frequencies if any core reports no capacity.
+  capacities_.resize(core_num_);
+  for (int i = 0; i < core_num_; ++i) {
+    capacities_[i] = get_cpu_capacity(i);
+    if (capacities_[i] <= 0) {
+      capacities_ = max_freqs_;
+      break;
+    }
+  }
   // get cache size and big.LITTLE core ids
   dev_name_ = get_cpu_name();
   if (!SetCPUInfoByName()) {
     SetCPUInfoByProb();
   }
+#if defined(__aarch64__) && defined(AT_HWCAP2)
+  // The kernel reports the features common to all the cores.
+  const uint64_t kHwcap2I8mm = 1ULL << 13;
+  const uint64_t kHwcap2BF16 = 1ULL << 14;
+  uint64_t hwcap2 = getauxval(AT_HWCAP2);
+  if (hwcap2 & kHwcap2I8mm) {
+    SetI8mmInfo(1, 1);
+  }
+  if (hwcap2 & kHwcap2BF16) {
+    SetBF16Info(1, 1);
+  }
+#endif
+#if defined(__aarch64__)
+  const uint64_t kHwcapSVE = 1ULL << 22;
+  if (getauxval(AT_HWCAP) & kHwcapSVE) {
+    SetSVEInfo(1, 1);
+  }
+#endif
 #else
 #ifdef TARGET_IOS
   dev_name_ = "Apple";
@@ -1132,6 +1300,7 @@ int DeviceInfo::Setup() {
   for (int i = 0; i < core_num_; ++i) {
     max_freqs_[i] = 1000000;
     min_freqs_[i] = 1000000;
+    capacities_.push_back(1);
     cluster_ids_[i] = 0;
     core_ids_[i] = i;
     big_core_ids_[i] = i;
@@ -1152,7 +1321,9 @@ int DeviceInfo::Setup() {
               << ", max freq: " << max_freqs_[i]
               << ", min freq: " << min_freqs_[i]
               << ", cluster ID: " << cluster_ids_[core_ids_[i]]
-              << ", CPU ARCH: A" << static_cast<int>(archs_[i]);
+              << ", CPU ARCH: A" << static_cast<int>(archs_[i])
+              << ", i8mm: " << i8mm_[i] << ", bf16: " << bf16_[i]
+              << ", sve: " << sve_[i];
   }
   LOG(INFO) << "L1 DataCache size is: ";
   for (int i = 0; i < core_num_; ++i) {
@@ -1214,6 +1385,12 @@ void DeviceInfo::SetRunMode(lite_api::PowerMode mode, int thread_num) {
   }
 #ifdef ARM_WITH_OMP
   omp_set_num_threads(active_ids_.size());
+  // Hand out the iterations dynamically when the cores differ in speed, so
+  // the little cores don't hold back the big ones.
+  auto capacities = active_capacities();
+  bool balanced = std::equal(
+      capacities.begin() + 1, capacities.end(), capacities.begin());
+  omp_set_schedule(balanced ? omp_sched_static : omp_sched_guided, 0);
 #endif
   if (mode_ != lite_api::LITE_POWER_NO_BIND) {
     if (check_cpu_online(active_ids_)) {
@@ -1231,8 +1408,7 @@ void DeviceInfo::SetRunMode(lite_api::PowerMode mode, int thread_num) {
 #endif
 #endif  // LITE_WITH_LINUX
   //! alloc memory for sgemm in this context
-  workspace_.Resize({llc_size()});
-  workspace_.mutable_data<int8_t>();
+  ResetWorkspace();
   arch_ = archs_[active_ids_[0]];
 }
 
@@ -1240,8 +1416,29 @@ void DeviceInfo::SetCache(int l1size, int l2size, int l3size) {
   SetCacheInfo(0, 1, l1size);
   SetCacheInfo(1, 1, l2size);
   SetCacheInfo(2, 1, l3size);
-  workspace_.Resize({llc_size()});
-  workspace_.mutable_data<int8_t>();
+  ResetWorkspace();
+}
+
+std::vector<int> DeviceInfo::active_capacities() const {
+  std::vector<int> capacities;
+  for (int id : active_ids_) {
+    capacities.push_back(
+        id < static_cast<int>(capacities_.size()) ? capacities_[id] : 1);
+  }
+  return capacities;
+}
+
+bool DeviceInfo::active_cores_throttled() const {
+#ifdef LITE_WITH_LINUX
+  for (int id : active_ids_) {
+    int capped_freq = get_capped_freq_khz(id) / 1000;
+    if (capped_freq > 0 && id < static_cast<int>(max_freqs_.size()) &&
+        capped_freq * 10 < max_freqs_[id] * 9) {
+      return true;
+    }
+  }
+#endif
+  return false;
 }
 
 bool DeviceInfo::ExtendWorkspace(size_t size) {
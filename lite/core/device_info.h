@@ -39,6 +39,7 @@ using L3CacheSetMethod = lite_api::L3CacheSetMethod;
 typedef enum {
   kAPPLE = 0,
   kX1 = 1,
+  kX2 = 2,
   kA35 = 35,
   kA53 = 53,
   kA55 = 55,
@@ -49,6 +50,8 @@ typedef enum {
   kA76 = 76,
   kA77 = 77,
   kA78 = 78,
+  kA510 = 510,
+  kA710 = 710,
   kARMArch_UNKOWN = -1
 } ARMArch;
 
@@ -73,6 +76,13 @@ class DeviceInfo {
 
   lite_api::PowerMode mode() const { return mode_; }
   int threads() const { return active_ids_.size(); }
+  const std::vector<int>& active_ids() const { return active_ids_; }
+  // The relative compute capacity of each active core, read from the
+  // cpu_capacity of sysfs, or the max frequency if it's not available.
+  std::vector<int> active_capacities() const;
+  // Whether any active core is capped below 90% of its max frequency, e.g. by
+  // the thermal throttling. Always false on the other OSes than Linux.
+  bool active_cores_throttled() const;
   ARMArch arch() const { return arch_; }
   int l1_cache_size() const { return L1_cache_[active_ids_[0]]; }
   int l2_cache_size() const { return L2_cache_[active_ids_[0]]; }
@@ -87,8 +97,7 @@ class DeviceInfo {
     absolute_l3cache_size_ = absolute_val;
     // Realloc memory for sgemm in this context.
     workspace_.clear();
-    workspace_.Resize({llc_size()});
-    workspace_.mutable_data<int8_t>();
+    ResetWorkspace();
   }
 
   void ClearArmL3Cache() { workspace_.clear(); }
@@ -109,6 +118,11 @@ class DeviceInfo {
       // kAbsolute = 2, use the external setting.
       case L3CacheSetMethod::kAbsolute:
         break;
+      // kAutoGrow = 3, use the system L2 Cache size, the workspace is
+      // allocated at the first use and grows with ExtendWorkspace only.
+      case L3CacheSetMethod::kAutoGrow:
+        size = L2_cache_[active_ids_[0]];
+        break;
       default:
         LOG(FATAL) << "Error: unknown l3_cache_method_ !";
     }
@@ -123,17 +137,53 @@ class DeviceInfo {
 #endif
   }
   bool has_fp16() const { return fp16_[active_ids_[0]]; }
+  // Whether the active cores support the int8 matrix multiplication of
+  // ARMv8.6, i.e. the SMMLA instruction.
+  inline bool has_i8mm() const {
+#ifdef WITH_ARM_I8MM
+    return i8mm_[active_ids_[0]];
+#else
+    return false;
+#endif
+  }
+  // Whether the active cores support the bfloat16 extension of ARMv8.6,
+  // i.e. the BFMMLA instruction.
+  inline bool has_bf16() const {
+#ifdef WITH_ARM_BF16
+    return bf16_[active_ids_[0]];
+#else
+    return false;
+#endif
+  }
+  // Whether the active cores support the scalable vector extension, whose
+  // kernels are only built for armv8.
+  inline bool has_sve() const {
+#if defined(__aarch64__) && defined(WITH_ARM_SVE)
+    return sve_[active_ids_[0]];
+#else
+    return false;
+#endif
+  }
 
   template <typename T>
   T* workspace_data() {
     return reinterpret_cast<T*>(workspace_.mutable_data<int8_t>());
   }
   bool ExtendWorkspace(size_t size);
+  // Size the workspace to the cache part, allocated here or, with kAutoGrow,
+  // by the first workspace_data.
+  void ResetWorkspace() {
+    workspace_.Resize({llc_size()});
+    if (l3_cache_method_ != L3CacheSetMethod::kAutoGrow) {
+      workspace_.mutable_data<int8_t>();
+    }
+  }
 
  private:
   int core_num_;
   std::vector<int> max_freqs_;
   std::vector<int> min_freqs_;
+  std::vector<int> capacities_;
   std::string dev_name_;
 
   std::vector<int> L1_cache_;
@@ -147,6 +197,9 @@ class DeviceInfo {
   std::vector<bool> fp32_;
   std::vector<bool> fp16_;
   std::vector<bool> dot_;
+  std::vector<bool> i8mm_;
+  std::vector<bool> bf16_;
+  std::vector<bool> sve_;
   bool has_a53_valid_;
 
   // LITE_POWER_HIGH stands for using big cores,
@@ -160,6 +213,9 @@ class DeviceInfo {
   static LITE_THREAD_LOCAL int64_t count_;
 
   void SetDotInfo(int argc, ...);
+  void SetI8mmInfo(int argc, ...);
+  void SetBF16Info(int argc, ...);
+  void SetSVEInfo(int argc, ...);
   void SetFP16Info(int argc, ...);
   void SetFP32Info(int argc, ...);
   void SetCacheInfo(int cache_id, int argc, ...);
@@ -179,6 +235,11 @@ class DeviceInfo {
   int absolute_l3cache_size_{-1};
   DeviceInfo() = default;
 };
+
+#ifdef LITE_WITH_LINUX
+// Bind the calling thread to `cpu_ids`, return 0 on success.
+int set_sched_affinity(const std::vector<int>& cpu_ids);
+#endif  // LITE_WITH_LINUX
 #endif  // LITE_WITH_ARM
 
 template <TargetType Type>
@@ -43,11 +43,9 @@ value_type DDimLite::count(int start, int end) const {
 DDimLite DDimLite::Slice(int start, int end) const {
   start = std::max(start, 0);
   end = std::min(end, static_cast<int>(data_.size()));
-  std::vector<value_type> new_dim(end - start);
-  for (int i = start; i < end; i++) {
-    new_dim[i - start] = data_[i];
-  }
-  return DDim(new_dim);
+  DimVector new_dim;
+  if (end > start) new_dim.assign(data_.begin() + start, data_.begin() + end);
+  return DDimLite(new_dim);
 }
 
 std::string DDimLite::repr() const {
@@ -25,7 +25,74 @@
 
 namespace paddle {
 namespace lite {
-// class DDimLite;
+
+// The dims of a tensor, kept inline up to kInlineRank so that the shapes
+// copied and sliced on the hot path never allocate. The larger ranks are
+// rare and kept on the heap.
+class DimVector {
+ public:
+  using value_type = int64_t;
+  using iterator = value_type *;
+  using const_iterator = const value_type *;
+  static constexpr size_t kInlineRank = 8;
+
+  DimVector() = default;
+
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last) {
+    clear();
+    for (; first != last; ++first) push_back(*first);
+  }
+
+  void resize(size_t n, value_type value = 0) {
+    if (n > kInlineRank && heap_.empty()) {
+      heap_.assign(inline_, inline_ + size_);
+    }
+    if (!heap_.empty() || n > kInlineRank) {
+      heap_.resize(n, value);
+    } else {
+      std::fill(inline_ + std::min(size_, n), inline_ + n, value);
+    }
+    size_ = n;
+  }
+  void push_back(value_type value) { resize(size_ + 1, value); }
+  void clear() {
+    heap_.clear();
+    size_ = 0;
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  value_type *data() { return heap_.empty() ? inline_ : heap_.data(); }
+  const value_type *data() const {
+    return heap_.empty() ? inline_ : heap_.data();
+  }
+  value_type operator[](size_t i) const { return data()[i]; }
+  value_type &operator[](size_t i) { return data()[i]; }
+  value_type front() const { return data()[0]; }
+  value_type back() const { return data()[size_ - 1]; }
+  iterator begin() { return data(); }
+  iterator end() { return data() + size_; }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + size_; }
+
+  operator std::vector<value_type>() const {
+    return std::vector<value_type>(begin(), end());
+  }
+
+  friend bool operator==(const DimVector &a, const DimVector &b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+  }
+  friend bool operator!=(const DimVector &a, const DimVector &b) {
+    return !(a == b);
+  }
+
+ private:
+  value_type inline_[kInlineRank] = {};
+  size_t size_{0};
+  // only used for the ranks larger than kInlineRank
+  std::vector<value_type> heap_;
+};
 
 class DDimLite {
  public:
@@ -34,10 +101,13 @@ class DDimLite {
   DDimLite() = default;
 
   explicit DDimLite(const std::vector<value_type> &x) { ConstructFrom(x); }
+  explicit DDimLite(const DimVector &x) : data_(x) {}
   // DDimLite(std::initializer_list<value_type> init_list) :
   // DDimLite(std::vector<value_type>(init_list)) {}
 
-  void ConstructFrom(const std::vector<value_type> &x) { data_ = x; }
+  void ConstructFrom(const std::vector<value_type> &x) {
+    data_.assign(x.begin(), x.end());
+  }
 
   value_type operator[](int offset) const { return data_[offset]; }
   value_type &operator[](int offset) { return data_[offset]; }
@@ -48,14 +118,16 @@ class DDimLite {
 
   value_type production() const;
 
-  const std::vector<value_type> &data() const { return data_; }
+  const DimVector &data() const { return data_; }
   value_type count(int start, int end) const;
 
   DDimLite Slice(int start, int end) const;
 
   DDimLite Flatten2D(int col) const {
-    return DDimLite(std::vector<value_type>(
-        {Slice(0, col).production(), Slice(col, size()).production()}));
+    DimVector dims;
+    dims.push_back(count(0, col));
+    dims.push_back(count(col, size()));
+    return DDimLite(dims);
   }
 
   std::string repr() const;
@@ -66,23 +138,15 @@ class DDimLite {
   }
 
   friend bool operator==(const DDimLite &a, const DDimLite &b) {
-    if (a.size() != b.size()) return false;
-    for (size_t i = 0; i < a.size(); i++) {
-      if (a[i] != b[i]) return false;
-    }
-    return true;
+    return a.data_ == b.data_;
   }
 
   friend bool operator!=(const DDimLite &a, const DDimLite &b) {
-    if (a.size() != b.size()) return true;
-    for (size_t i = 0; i < a.size(); i++) {
-      if (a[i] != b[i]) return true;
-    }
-    return false;
+    return a.data_ != b.data_;
   }
 
  private:
-  std::vector<value_type> data_;
+  DimVector data_;
 };
 
 using DDim = paddle::lite::DDimLite;
@@ -0,0 +1,76 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/dim.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "lite/core/tensor.h"
+
+namespace {
+std::atomic<int64_t> g_allocs{0};
+}  // namespace
+
+// Count the allocations of the test.
+void* operator new(size_t size) {
+  g_allocs++;
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (!ptr) throw std::bad_alloc();
+  return ptr;
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+namespace paddle {
+namespace lite {
+
+TEST(DDim, no_alloc_on_hot_path) {
+  const std::vector<int64_t> shape({2, 3, 4, 5});
+  Tensor x;
+  DDim dims(shape);
+  x.Resize(dims);
+  int64_t allocs = g_allocs;
+  // copy, resize, slice, flatten and compare
+  DDim copied = dims;
+  x.Resize(copied);
+  x.Resize(shape);
+  DDim sliced = x.dims().Slice(1, 3);
+  DDim flattened = x.dims().Flatten2D(2);
+  bool same = x.dims() == copied && sliced != flattened;
+  EXPECT_EQ(g_allocs - allocs, 0);
+  EXPECT_TRUE(same);
+  EXPECT_EQ(sliced.production(), 12);
+  EXPECT_EQ(flattened[0], 6);
+  EXPECT_EQ(flattened[1], 20);
+}
+
+TEST(DDim, large_rank) {
+  std::vector<int64_t> shape;
+  for (int i = 1; i <= 10; i++) shape.push_back(i);
+  DDim dims(shape);
+  EXPECT_EQ(dims.size(), 10u);
+  EXPECT_EQ(dims.Vectorize(), shape);
+  EXPECT_EQ(dims.Slice(7, 10).production(), 8 * 9 * 10);
+  DDim copied = dims;
+  copied[9] = 11;
+  EXPECT_NE(copied, dims);
+  EXPECT_EQ(copied.count(8, 10), 9 * 11);
+  std::vector<int64_t> data = dims.data();
+  EXPECT_EQ(data, shape);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,46 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include "lite/utils/macros.h"
+
+namespace paddle {
+namespace lite {
+
+// Whether the kernels may use the fast approximations of exp, tanh and erf,
+// see lite_api::ConfigBase::set_fast_math. The mode is set on the thread of
+// a run, so the kernels read it before dispatching to the thread pool.
+class FastMath {
+ public:
+  static bool Enabled() { return enabled(); }
+
+  // Enable or disable the mode on the calling thread in the scope.
+  class Scope {
+   public:
+    explicit Scope(bool enable) : previous_(enabled()) { enabled() = enable; }
+    ~Scope() { enabled() = previous_; }
+
+   private:
+    bool previous_;
+  };
+
+ private:
+  static bool& enabled() {
+    static LITE_THREAD_LOCAL bool enabled = false;
+    return enabled;
+  }
+};
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,280 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/inter_op_scheduler.h"
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include "lite/core/program.h"
+#ifdef LITE_WITH_ARM
+#include "lite/core/device_info.h"
+#endif
+
+namespace paddle {
+namespace lite {
+
+InterOpScheduler::~InterOpScheduler() { Stop(); }
+
+void InterOpScheduler::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& worker : workers_) worker.join();
+  workers_.clear();
+}
+
+bool InterOpScheduler::Plan(std::vector<Instruction>* insts,
+                            Scope* exec_scope,
+                            int lanes) {
+  CHECK(insts);
+  CHECK(exec_scope);
+  Stop();
+  insts_ = insts;
+  lanes_ = lanes;
+  // The tensors sharing the same buffer, e.g. the outputs of the inplace
+  // reshape, are accessed as one resource.
+  std::map<const void*, int> buffer_ids;
+  std::map<std::string, int> resource_ids;
+  auto resource_id = [&](const std::string& name) {
+    auto it = resource_ids.find(name);
+    if (it != resource_ids.end()) return it->second;
+    int id = static_cast<int>(resource_ids.size());
+    auto* var = exec_scope->FindVar(name);
+    if (var && var->IsType<Tensor>()) {
+      auto& tensor = var->Get<Tensor>();
+      if (tensor.IsInitialized()) {
+        const void* key =
+            static_cast<const char*>(tensor.raw_data()) - tensor.offset();
+        id = buffer_ids.emplace(key, id).first->second;
+      }
+    }
+    resource_ids.emplace(name, id);
+    return id;
+  };
+
+  std::map<int, size_t> last_writers;
+  std::map<int, std::vector<size_t>> readers;
+  std::vector<std::vector<size_t>> deps(insts->size());
+  std::vector<std::vector<size_t>> producers(insts->size());
+  std::vector<int64_t> works(insts->size(), 1);
+  for (size_t idx = 0; idx < insts->size(); idx++) {
+    auto& inst = (*insts)[idx];
+    if (inst.is_feed_fetch_op()) continue;
+    auto op_type = inst.op()->Type();
+    auto target = inst.kernel() ? inst.kernel()->target() : TARGET(kHost);
+    // The sub blocks access the variables by the names, and the contexts of
+    // the devices are bound to the calling thread.
+    if (op_type == "while" || op_type == "conditional_block" ||
+        op_type == "subgraph" ||
+        (target != TARGET(kHost) && target != TARGET(kARM) &&
+         target != TARGET(kX86) && target != TARGET(kAny))) {
+      LOG(WARNING) << "The inter-op parallelism is disabled for the program "
+                      "with "
+                   << op_type << " op on " << TargetToStr(target);
+      return false;
+    }
+    auto* op_info = inst.op()->op_info();
+    std::set<size_t> inst_deps;
+    std::set<size_t> inst_producers;
+    for (auto& name : op_info->input_names()) {
+      int id = resource_id(name);
+      auto it = last_writers.find(id);
+      if (it != last_writers.end()) {
+        inst_deps.insert(it->second);
+        inst_producers.insert(it->second);
+      }
+    }
+    for (auto& name : op_info->output_names()) {
+      int id = resource_id(name);
+      auto it = last_writers.find(id);
+      if (it != last_writers.end()) inst_deps.insert(it->second);
+      for (auto reader : readers[id]) inst_deps.insert(reader);
+      auto* var = exec_scope->FindVar(name);
+      if (var && var->IsType<Tensor>()) {
+        works[idx] += var->Get<Tensor>().numel();
+      }
+    }
+    for (auto& name : op_info->input_names()) {
+      readers[resource_id(name)].push_back(idx);
+    }
+    for (auto& name : op_info->output_names()) {
+      int id = resource_id(name);
+      last_writers[id] = idx;
+      readers[id].clear();
+    }
+    inst_deps.erase(idx);
+    inst_producers.erase(idx);
+    deps[idx].assign(inst_deps.begin(), inst_deps.end());
+    producers[idx].assign(inst_producers.begin(), inst_producers.end());
+  }
+
+  // Continue the lane of an input whose last instruction produces it, or fork
+  // on the least loaded lane.
+  std::vector<int> inst_lanes(insts->size(), -1);
+  std::vector<int64_t> loads(lanes, 0);
+  std::vector<int> tails(lanes, -1);
+  lane_insts_.assign(lanes, {});
+  for (size_t idx = 0; idx < insts->size(); idx++) {
+    if ((*insts)[idx].is_feed_fetch_op()) continue;
+    int lane = -1;
+    for (auto producer : producers[idx]) {
+      int producer_lane = inst_lanes[producer];
+      if (tails[producer_lane] != static_cast<int>(producer)) continue;
+      if (lane < 0 || loads[producer_lane] < loads[lane]) {
+        lane = producer_lane;
+      }
+    }
+    if (lane < 0) {
+      lane = static_cast<int>(std::min_element(loads.begin(), loads.end()) -
+                              loads.begin());
+    }
+    inst_lanes[idx] = lane;
+    loads[lane] += works[idx];
+    tails[lane] = static_cast<int>(idx);
+    lane_insts_[lane].push_back(idx);
+  }
+  int used_lanes = 0;
+  for (auto& lane_insts : lane_insts_) {
+    if (!lane_insts.empty()) used_lanes++;
+  }
+  if (used_lanes < 2) {
+    VLOG(1) << "The program without the independent branches is not "
+               "scheduled by lanes";
+    return false;
+  }
+
+  // Only wait for the last instruction each of the other lanes.
+  waits_.assign(insts->size(), {});
+  for (size_t idx = 0; idx < insts->size(); idx++) {
+    if (inst_lanes[idx] < 0) continue;
+    std::map<int, size_t> lane_waits;
+    for (auto dep : deps[idx]) {
+      int dep_lane = inst_lanes[dep];
+      if (dep_lane < 0 || dep_lane == inst_lanes[idx]) continue;
+      lane_waits[dep_lane] = (std::max)(lane_waits[dep_lane], dep);
+    }
+    for (auto& item : lane_waits) waits_[idx].push_back(item.second);
+  }
+
+  // Split the intra-op threads among the lanes.
+  int threads = 1;
+#ifdef LITE_WITH_ARM
+  mode_ = DeviceInfo::Global().mode();
+  threads = DeviceInfo::Global().threads();
+#endif
+#ifdef LITE_USE_THREAD_POOL
+  auto* thread_pool = ThreadPool::Current();
+  if (thread_pool) threads = (std::max)(threads, thread_pool->thread_num());
+#endif
+  lane_threads_ = (std::max)(1, threads / lanes);
+#ifdef LITE_USE_THREAD_POOL
+  thread_pools_.clear();
+  for (int lane = 0; lane < lanes; lane++) {
+    thread_pools_.push_back(ThreadPool::Create(lane_threads_));
+  }
+#endif
+  finished_.assign(insts->size(), 0);
+  stop_ = false;
+  for (int lane = 1; lane < lanes; lane++) {
+    workers_.emplace_back(&InterOpScheduler::WorkerLoop, this, lane);
+  }
+  VLOG(1) << "Scheduled " << insts->size() << " instructions on " << used_lanes
+          << " lanes with " << lane_threads_ << " threads each";
+  return true;
+}
+
+void InterOpScheduler::RunLane(int lane) {
+  for (auto idx : lane_insts_[lane]) {
+    if (!waits_[idx].empty()) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&] {
+        for (auto wait : waits_[idx]) {
+          if (finished_[wait] != epoch_) return false;
+        }
+        return true;
+      });
+    }
+    auto& inst = (*insts_)[idx];
+    if (!control_ || !control_->Check()) {
+      inst.set_reuse_shapes(reuse_shapes_);
+      inst.Run();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      finished_[idx] = epoch_;
+    }
+    cv_.notify_all();
+  }
+}
+
+void InterOpScheduler::WorkerLoop(int lane) {
+#ifdef LITE_WITH_ARM
+  DeviceInfo::Init();
+  DeviceInfo::Global().SetRunMode(mode_, lane_threads_);
+#endif
+#ifdef LITE_USE_THREAD_POOL
+  ThreadPoolGuard thread_pool_guard(thread_pools_[lane].get());
+#endif
+  int64_t epoch = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&] { return stop_ || epoch_ != epoch; });
+      if (stop_) return;
+      epoch = epoch_;
+    }
+    RunLane(lane);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_lanes_--;
+    }
+    cv_.notify_all();
+  }
+}
+
+void InterOpScheduler::Run(bool reuse_shapes) {
+#ifdef LITE_WITH_ARM
+  auto& device_info = DeviceInfo::Global();
+  auto mode = device_info.mode();
+  int threads = device_info.threads();
+  device_info.SetRunMode(mode_, lane_threads_);
+#endif
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    reuse_shapes_ = reuse_shapes;
+    control_ = RunControl::Current();
+    pending_lanes_ = lanes_ - 1;
+    epoch_++;
+  }
+  cv_.notify_all();
+  {
+#ifdef LITE_USE_THREAD_POOL
+    ThreadPoolGuard thread_pool_guard(thread_pools_[0].get());
+#endif
+    RunLane(0);
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return pending_lanes_ == 0; });
+  }
+#ifdef LITE_WITH_ARM
+  device_info.SetRunMode(mode, threads);
+#endif
+}
+
+}  // namespace lite
+}  // namespace paddle
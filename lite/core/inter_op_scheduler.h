@@ -0,0 +1,86 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <condition_variable>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+#include "lite/api/paddle_place.h"
+#include "lite/core/run_control.h"
+#include "lite/core/scope.h"
+#include "lite/core/thread_pool.h"
+
+namespace paddle {
+namespace lite {
+
+struct Instruction;
+
+// Run the independent branches of a program on the host at the same time,
+// e.g. the ones of the inception blocks and the multi-head detectors, whose
+// ops are too small to use all the cores by themselves. The instructions are
+// assigned to the lanes the same way as multi_stream_analysis_pass assigns
+// the ops to the CUDA streams: an op continues the lane of one of its inputs,
+// the least loaded one, and the ops forking from a branch start on the least
+// loaded lane. Each lane runs its instructions in order on its own thread,
+// with the share of the intra-op threads, and waits for the instructions of
+// the other lanes it depends on.
+class InterOpScheduler {
+ public:
+  ~InterOpScheduler();
+
+  // Plan the lanes from the instructions run once, so the tensors sharing the
+  // buffers are known. Returns false if the program is not worth or can not
+  // be scheduled, e.g. without the independent branches or with the ops
+  // running the sub blocks.
+  bool Plan(std::vector<Instruction>* insts, Scope* exec_scope, int lanes);
+  void Run(bool reuse_shapes);
+
+ private:
+  void WorkerLoop(int lane);
+  void RunLane(int lane);
+  void Stop();
+
+  std::vector<Instruction>* insts_{nullptr};
+  // The instructions of each lane in order, and the instructions of the other
+  // lanes each instruction waits for.
+  std::vector<std::vector<size_t>> lane_insts_;
+  std::vector<std::vector<size_t>> waits_;
+  int lanes_{1};
+  int lane_threads_{1};
+#ifdef LITE_WITH_ARM
+  lite_api::PowerMode mode_{lite_api::LITE_POWER_NO_BIND};
+#endif
+#ifdef LITE_USE_THREAD_POOL
+  std::vector<std::shared_ptr<ThreadPool>> thread_pools_;
+#endif
+  bool reuse_shapes_{false};
+  // The control of the current run, whose instructions are skipped but still
+  // marked finished once it stops, so the lanes do not wait for each other.
+  const RunControl* control_{nullptr};
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_{false};
+  // Increased by each run, the instructions finished in the current run are
+  // marked by it.
+  int64_t epoch_{0};
+  std::vector<int64_t> finished_;
+  int pending_lanes_{0};
+};
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,118 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/io_binding.h"
+#include <algorithm>
+#include <cstring>
+
+namespace paddle {
+namespace lite {
+
+void IoBinding::Bind(std::vector<Binding>* bindings, const Binding& binding) {
+  auto it = std::find_if(
+      bindings->begin(), bindings->end(), [&](const Binding& item) {
+        return item.tensor == binding.tensor;
+      });
+  if (it != bindings->end()) bindings->erase(it);
+  if (binding.data) bindings->push_back(binding);
+}
+
+void IoBinding::BindInput(Tensor* tensor,
+                          void* data,
+                          size_t memory_size,
+                          const DDim& dims,
+                          PrecisionType precision) {
+#ifdef LITE_WITH_FPGA
+  LOG(FATAL) << "The IO binding is not supported on FPGA";
+#else
+  CHECK(tensor);
+  if (data) {
+    size_t element_size = PrecisionTypeLength(precision);
+    CHECK_GT(element_size, 0u) << "Unsupported precision "
+                               << PrecisionToStr(precision) << " to bind";
+    CHECK_GE(memory_size, dims.production() * element_size)
+        << "The buffer of " << memory_size << " bytes is too small for the "
+        << "input of dims " << dims << " and precision "
+        << PrecisionToStr(precision);
+    auto declared = tensor->precision();
+    CHECK(declared == PRECISION(kUnk) || declared == PRECISION(kAny) ||
+          declared == precision)
+        << "The input requires precision " << PrecisionToStr(declared)
+        << " but " << PrecisionToStr(precision) << " is bound";
+  }
+  Binding binding;
+  binding.tensor = tensor;
+  binding.data = data;
+  binding.memory_size = memory_size;
+  binding.dims = dims;
+  binding.precision = precision;
+  Bind(&inputs_, binding);
+#endif
+}
+
+void IoBinding::BindOutput(Tensor* tensor, void* data, size_t memory_size) {
+#ifdef LITE_WITH_FPGA
+  LOG(FATAL) << "The IO binding is not supported on FPGA";
+#else
+  CHECK(tensor);
+  Binding binding;
+  binding.tensor = tensor;
+  binding.data = data;
+  binding.memory_size = memory_size;
+  Bind(&outputs_, binding);
+#endif
+}
+
+void IoBinding::Apply() {
+#ifndef LITE_WITH_FPGA
+  for (auto& binding : inputs_) {
+    auto* tensor = binding.tensor;
+    tensor->Resize(binding.dims);
+    tensor->set_precision(binding.precision);
+    if (tensor->raw_data() != binding.data || tensor->offset() != 0) {
+      tensor->ShareExternalMemory(
+          binding.data, binding.memory_size, TARGET(kHost));
+    }
+  }
+  for (auto& binding : outputs_) {
+    auto* tensor = binding.tensor;
+    if (tensor->raw_data() != binding.data || tensor->offset() != 0) {
+      tensor->ShareExternalMemory(
+          binding.data, binding.memory_size, TARGET(kHost));
+    }
+  }
+#endif
+}
+
+void IoBinding::Sync() {
+#ifndef LITE_WITH_FPGA
+  for (auto& binding : outputs_) {
+    auto* tensor = binding.tensor;
+    if (tensor->raw_data() == binding.data) continue;
+    CHECK(tensor->target() == TARGET(kHost))
+        << "Only the host outputs can be bound";
+    size_t memory_size =
+        tensor->numel() * PrecisionTypeLength(tensor->precision());
+    CHECK_LE(memory_size, binding.memory_size)
+        << "The buffer of " << binding.memory_size << " bytes is too small "
+        << "for the output of dims " << tensor->dims();
+    std::memcpy(binding.data, tensor->raw_data(), memory_size);
+    tensor->ShareExternalMemory(
+        binding.data, binding.memory_size, TARGET(kHost));
+  }
+#endif
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,64 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <vector>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+
+// Binds the caller-owned host buffers to the input and output tensors of a
+// predictor, so that the kernels read the inputs and write the outputs in
+// place instead of copying them through the tensors' own memory.
+class IoBinding {
+ public:
+  // Bind `data` to the input `tensor`, `dims` and `precision` are checked
+  // against the declared precision of the tensor and `memory_size`. Binding
+  // nullptr removes the binding of the tensor.
+  void BindInput(Tensor* tensor,
+                 void* data,
+                 size_t memory_size,
+                 const DDim& dims,
+                 PrecisionType precision);
+  // Bind `data` to the output `tensor`, which must be large enough for the
+  // output. Binding nullptr removes the binding of the tensor.
+  void BindOutput(Tensor* tensor, void* data, size_t memory_size);
+
+  // Point the bound tensors to the buffers, called before each run. The
+  // bindings are applied again in case the tensors are resized or reset.
+  void Apply();
+  // Copy the outputs which are not written in place, e.g. the ones sharing
+  // the data of other tensors, into the buffers, called after each run.
+  void Sync();
+
+  bool empty() const { return inputs_.empty() && outputs_.empty(); }
+
+ private:
+  struct Binding {
+    Tensor* tensor{nullptr};
+    void* data{nullptr};
+    size_t memory_size{0};
+    DDim dims;
+    PrecisionType precision{PrecisionType::kUnk};
+  };
+
+  static void Bind(std::vector<Binding>* bindings, const Binding& binding);
+
+  std::vector<Binding> inputs_;
+  std::vector<Binding> outputs_;
+};
+
+}  // namespace lite
+}  // namespace paddle
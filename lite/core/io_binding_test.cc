@@ -0,0 +1,82 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/io_binding.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+TEST(IoBinding, input_in_place) {
+  Tensor input;
+  input.set_precision(PRECISION(kFloat));
+  std::vector<float> data(6, 1.f);
+  IoBinding binding;
+  binding.BindInput(&input,
+                    data.data(),
+                    data.size() * sizeof(float),
+                    DDim(std::vector<int64_t>({2, 3})),
+                    PRECISION(kFloat));
+  binding.Apply();
+  EXPECT_EQ(input.dims(), DDim(std::vector<int64_t>({2, 3})));
+  EXPECT_EQ(input.data<float>(), data.data());
+  // The tensor resized or reset by others is bound again in the next run.
+  input.Resize({4, 4});
+  input.ShareExternalMemory(nullptr, 0, TARGET(kHost));
+  binding.Apply();
+  EXPECT_EQ(input.dims(), DDim(std::vector<int64_t>({2, 3})));
+  EXPECT_EQ(input.data<float>(), data.data());
+}
+
+TEST(IoBinding, output_in_place) {
+  Tensor output;
+  std::vector<float> data(8, 0.f);
+  IoBinding binding;
+  binding.BindOutput(&output, data.data(), data.size() * sizeof(float));
+  binding.Apply();
+  output.Resize({2, 2});
+  auto* out = output.mutable_data<float>();
+  EXPECT_EQ(out, data.data());
+  out[3] = 3.f;
+  binding.Sync();
+  EXPECT_EQ(data[3], 3.f);
+}
+
+TEST(IoBinding, output_shared) {
+  Tensor output;
+  Tensor other;
+  other.Resize({3});
+  auto* x = other.mutable_data<float>();
+  x[0] = 1.f;
+  x[1] = 2.f;
+  x[2] = 3.f;
+  std::vector<float> data(4, 0.f);
+  IoBinding binding;
+  binding.BindOutput(&output, data.data(), data.size() * sizeof(float));
+  binding.Apply();
+  // The kernels like reshape share the data of the input.
+  output.ShareDataWith(other);
+  binding.Sync();
+  EXPECT_EQ(output.data<float>(), data.data());
+  EXPECT_EQ(data, std::vector<float>({1.f, 2.f, 3.f, 0.f}));
+  // Unbind the output.
+  binding.BindOutput(&output, nullptr, 0);
+  output.ShareDataWith(other);
+  binding.Sync();
+  EXPECT_EQ(output.data<float>(), x);
+}
+
+}  // namespace lite
+}  // namespace paddle
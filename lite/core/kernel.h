@@ -30,6 +30,7 @@
 #include "lite/operators/op_params.h"
 #include "lite/utils/all.h"
 #include "lite/utils/replace_stl/stream.h"
+#include "lite/utils/timer.h"
 
 #ifdef LITE_WITH_PROFILE
 #include "lite/core/profile/profiler.h"
@@ -58,6 +59,13 @@ class KernelBase {
   /// Run the kernel. Before Run, both the param_ and context_ should be valid.
   virtual void Run() = 0;
 
+  /// Let Run return before the work finishes, e.g. the device subgraphs run by
+  /// another thread, then Wait finishes it. Returns false if the kernel can't
+  /// run asynchronously, which is the default.
+  virtual bool SetAsync(bool async) { return false; }
+  /// Wait for the work of the last asynchronous Run.
+  virtual void Wait() {}
+
 #ifdef LITE_WITH_METAL
   virtual void SaveOutput() {}
 #endif
@@ -81,12 +89,21 @@ class KernelBase {
   }
 #endif
 
+  /// Init the kernel and transform the weights once, by the first Launch or
+  /// ahead of it by RuntimeProgram::PrepareKernels.
+  void Prepare() {
+    if (!is_first_epoch_) return;
+    uint64_t start = Timer::GetCurrentUS();
+    PrepareForRun();
+    prepare_time_us_ = Timer::GetCurrentUS() - start;
+    is_first_epoch_ = false;
+  }
+  /// The time spent in PrepareForRun, 0 before the kernel is prepared.
+  uint64_t prepare_time_us() const { return prepare_time_us_; }
+
   void Launch() {
     /// First run, init kernel, do weights transform once
-    if (is_first_epoch_) {
-      PrepareForRun();
-      is_first_epoch_ = false;
-    }
+    Prepare();
     /// re-init the kernel if needed (input shape should be checked in conv
     /// kernel)
     ReInitWhenNeeded();
@@ -208,6 +225,7 @@ class KernelBase {
   // is the unique ID for the kernel.
   std::string alias_{};
   bool is_first_epoch_{true};
+  uint64_t prepare_time_us_{0};
 
 #ifdef LITE_WITH_PROFILE
   profile::Profiler* profiler_{nullptr};
@@ -15,6 +15,7 @@
 #include "lite/core/kernel.h"
 #include <gtest/gtest.h>
 #include "lite/core/op_lite.h"
+#include "lite/core/op_registry.h"
 
 namespace paddle {
 namespace lite {
@@ -58,6 +59,36 @@ TEST(Kernel, kernel_type) {
   ASSERT_EQ(place, place1);
 }
 
+std::unique_ptr<KernelBase> CreateSomeKernel() {
+  std::unique_ptr<KernelBase> x(new SomeKernel);
+  x->set_op_type("fc");
+  x->set_alias("def");
+  return x;
+}
+
+TEST(Kernel, static_kernel_table) {
+  // sorted by key
+  static const StaticKernelTable::Entry entries[] = {
+      {"conv2d,kHost,kFloat,kNCHW,def", CreateSomeKernel},
+      {"fc,kHost,kFloat,kNCHW,def", CreateSomeKernel},
+      {"fc,kHost,kFloat,kNCHW,int8", CreateSomeKernel},
+  };
+  auto& table = StaticKernelTable::Global();
+  table.Set(entries, 3);
+  ASSERT_EQ(table.size(), 3UL);
+
+  Place place(TARGET(kHost), PRECISION(kFloat), DATALAYOUT(kNCHW));
+  auto kernel = table.Create("fc", "def", place);
+  ASSERT_TRUE(kernel != nullptr);
+  ASSERT_EQ(kernel->op_type(), "fc");
+  ASSERT_EQ(kernel->alias(), "def");
+  ASSERT_TRUE(table.Create("fc", "fp16", place) == nullptr);
+  ASSERT_TRUE(table.Create("relu", "def", place) == nullptr);
+  Place arm_place(TARGET(kARM), PRECISION(kFloat), DATALAYOUT(kNCHW));
+  ASSERT_TRUE(table.Create("fc", "def", arm_place) == nullptr);
+  table.Set(nullptr, 0);
+}
+
 }  // namespace core
 }  // namespace lite
 }  // namespace paddle
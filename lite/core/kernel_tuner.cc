@@ -0,0 +1,145 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/kernel_tuner.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "lite/core/device_info.h"
+#include "lite/core/runtime_stats.h"
+#include "lite/utils/log/logging.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+const char* const kHeader = "paddle-lite-kernel-tune v1";
+}  // namespace
+
+KernelTuner& KernelTuner::Global() {
+  static KernelTuner* x = new KernelTuner;
+  return *x;
+}
+
+void KernelTuner::SetTuneMode(lite_api::ARMTuneMode mode,
+                              const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  mode_ = mode;
+  if (path == path_) return;
+  path_ = path;
+  if (!path.empty()) LoadFile(path, &decisions_);
+}
+
+int KernelTuner::repeats() const {
+  switch (mode_) {
+    case lite_api::ARM_TUNE_RAPID:
+      return 1;
+    case lite_api::ARM_TUNE_EXHAUSTIVE:
+      return 10;
+    default:
+      return 3;
+  }
+}
+
+bool KernelTuner::Lookup(const std::string& key, std::string* choice) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = decisions_.find(key);
+  RuntimeStats::Global().kernel_tune_cache.Record(it != decisions_.end());
+  if (it == decisions_.end()) return false;
+  *choice = it->second;
+  return true;
+}
+
+void KernelTuner::Record(const std::string& key, const std::string& choice) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  decisions_[key] = choice;
+  dirty_ = true;
+}
+
+void KernelTuner::LoadFile(const std::string& path,
+                           std::map<std::string, std::string>* decisions) {
+  std::ifstream file(path);
+  if (!file.is_open()) return;
+  std::string line;
+  if (!std::getline(file, line) || line != kHeader) {
+    LOG(WARNING) << "Ignore the tuning file " << path
+                 << " of an unknown version";
+    return;
+  }
+  // Each line is a key and the choice separated by a tab.
+  while (std::getline(file, line)) {
+    auto pos = line.rfind('\t');
+    if (pos == std::string::npos) continue;
+    decisions->emplace(line.substr(0, pos), line.substr(pos + 1));
+  }
+}
+
+void KernelTuner::Save() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!dirty_ || path_.empty()) return;
+  LoadFile(path_, &decisions_);
+  std::string tmp_path = path_ + ".tmp";
+  {
+    std::ofstream file(tmp_path);
+    file << kHeader << "\n";
+    for (auto& item : decisions_) {
+      file << item.first << "\t" << item.second << "\n";
+    }
+    if (!file.good()) {
+      LOG(WARNING) << "Failed to write the tuning file " << tmp_path;
+      return;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+    LOG(WARNING) << "Failed to save the tuning file " << path_;
+    std::remove(tmp_path.c_str());
+    return;
+  }
+  dirty_ = false;
+  VLOG(1) << "Saved " << decisions_.size() << " tuned kernels into " << path_;
+}
+
+size_t KernelTuner::size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return decisions_.size();
+}
+
+void KernelTuner::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  mode_ = lite_api::ARM_TUNE_NONE;
+  dirty_ = false;
+  path_.clear();
+  decisions_.clear();
+}
+
+std::string KernelTuner::DeviceKey() {
+  std::stringstream ss;
+#if defined(__aarch64__)
+  ss << "armv8";
+#elif defined(__arm__)
+  ss << "armv7";
+#else
+  ss << "host";
+#endif
+#ifdef LITE_WITH_ARM
+  auto& info = DeviceInfo::Global();
+  ss << "|arch:" << static_cast<int>(info.arch()) << "|dot:" << info.has_dot()
+     << "|fp16:" << info.has_fp16() << "|mode:" << static_cast<int>(info.mode())
+     << "|threads:" << info.threads();
+#endif
+  return ss.str();
+}
+
+}  // namespace lite
+}  // namespace paddle
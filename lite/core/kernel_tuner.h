@@ -0,0 +1,66 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <map>
+#include <mutex>  // NOLINT
+#include <string>
+#include "lite/api/paddle_place.h"
+
+namespace paddle {
+namespace lite {
+
+// The implementations chosen by timing the candidates on the real shapes,
+// e.g. the algorithms of the ARM convs. The decisions are keyed by the
+// device and the shape, and can be saved into a tuning file so the later
+// processes skip the timing.
+class KernelTuner {
+ public:
+  static KernelTuner& Global();
+
+  // Enable the tuning in `mode` and load the decisions saved in `path`, the
+  // decisions are kept in memory only if `path` is empty.
+  void SetTuneMode(lite_api::ARMTuneMode mode, const std::string& path = "");
+  lite_api::ARMTuneMode tune_mode() const { return mode_; }
+  bool enabled() const { return mode_ != lite_api::ARM_TUNE_NONE; }
+  // The times each candidate is run in the current mode.
+  int repeats() const;
+
+  bool Lookup(const std::string& key, std::string* choice);
+  void Record(const std::string& key, const std::string& choice);
+  // Save the decisions into the tuning file if any is recorded since loaded,
+  // merged with the ones saved by the other processes meanwhile.
+  void Save();
+  size_t size();
+  void Clear();
+
+  // The cpu arch, the ISA features, the power mode and the threads, which
+  // the decisions are only valid for.
+  static std::string DeviceKey();
+
+ private:
+  KernelTuner() = default;
+  static void LoadFile(const std::string& path,
+                       std::map<std::string, std::string>* decisions);
+
+  std::atomic<lite_api::ARMTuneMode> mode_{lite_api::ARM_TUNE_NONE};
+  bool dirty_{false};
+  std::string path_;
+  std::map<std::string, std::string> decisions_;
+  std::mutex mutex_;
+};
+
+}  // namespace lite
+}  // namespace paddle
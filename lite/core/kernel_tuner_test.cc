@@ -0,0 +1,96 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/kernel_tuner.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace paddle {
+namespace lite {
+
+TEST(KernelTuner, record_and_save) {
+  const std::string path = "kernel_tuner_test.txt";
+  std::remove(path.c_str());
+  auto& tuner = KernelTuner::Global();
+  tuner.Clear();
+  EXPECT_FALSE(tuner.enabled());
+
+  tuner.SetTuneMode(lite_api::ARM_TUNE_RAPID, path);
+  EXPECT_TRUE(tuner.enabled());
+  EXPECT_EQ(tuner.repeats(), 1);
+  std::string choice;
+  EXPECT_FALSE(tuner.Lookup("conv_a", &choice));
+  tuner.Record("conv_a", "winograd");
+  tuner.Record("conv_b", "gemm_like");
+  tuner.Save();
+
+  // Load the saved decisions in a new process.
+  tuner.Clear();
+  tuner.SetTuneMode(lite_api::ARM_TUNE_NORMAL, path);
+  EXPECT_EQ(tuner.size(), 2u);
+  EXPECT_TRUE(tuner.Lookup("conv_a", &choice));
+  EXPECT_EQ(choice, "winograd");
+  EXPECT_TRUE(tuner.Lookup("conv_b", &choice));
+  EXPECT_EQ(choice, "gemm_like");
+  tuner.Clear();
+  std::remove(path.c_str());
+}
+
+TEST(KernelTuner, merge_on_save) {
+  const std::string path = "kernel_tuner_merge_test.txt";
+  std::remove(path.c_str());
+  auto& tuner = KernelTuner::Global();
+  tuner.Clear();
+  tuner.SetTuneMode(lite_api::ARM_TUNE_NORMAL, path);
+  tuner.Record("conv_a", "direct");
+  // Saved by another process meanwhile.
+  {
+    std::ofstream file(path);
+    file << "paddle-lite-kernel-tune v1\n"
+         << "conv_a\twinograd\n"
+         << "conv_c\tdepthwise\n";
+  }
+  tuner.Save();
+
+  tuner.Clear();
+  tuner.SetTuneMode(lite_api::ARM_TUNE_NORMAL, path);
+  std::string choice;
+  EXPECT_EQ(tuner.size(), 2u);
+  EXPECT_TRUE(tuner.Lookup("conv_a", &choice));
+  EXPECT_EQ(choice, "direct");
+  EXPECT_TRUE(tuner.Lookup("conv_c", &choice));
+  EXPECT_EQ(choice, "depthwise");
+  tuner.Clear();
+  std::remove(path.c_str());
+}
+
+TEST(KernelTuner, ignore_unknown_version) {
+  const std::string path = "kernel_tuner_version_test.txt";
+  {
+    std::ofstream file(path);
+    file << "paddle-lite-kernel-tune v0\n"
+         << "conv_a\twinograd\n";
+  }
+  auto& tuner = KernelTuner::Global();
+  tuner.Clear();
+  tuner.SetTuneMode(lite_api::ARM_TUNE_NORMAL, path);
+  EXPECT_EQ(tuner.size(), 0u);
+  tuner.Clear();
+  std::remove(path.c_str());
+}
+
+}  // namespace lite
+}  // namespace paddle
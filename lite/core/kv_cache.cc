@@ -0,0 +1,156 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/kv_cache.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+namespace {
+const int64_t kMinCapacity = 16;
+
+// Copy `rows` of the `src_heads` heads of [heads, src_capacity, dim] into
+// [heads, dst_capacity, dim], the heads are selected by `src_heads`.
+void CopyRows(const float* src,
+              int64_t src_capacity,
+              float* dst,
+              int64_t dst_capacity,
+              const int64_t* src_heads,
+              int64_t heads,
+              int64_t rows,
+              int64_t dim) {
+  for (int64_t h = 0; h < heads; h++) {
+    std::memcpy(dst + h * dst_capacity * dim,
+                src + src_heads[h] * src_capacity * dim,
+                sizeof(float) * rows * dim);
+  }
+}
+}  // namespace
+
+void KVCache::Grow(int64_t capacity) {
+  Tensor k;
+  Tensor v;
+  k.Resize({batch_, heads_, capacity, dim_});
+  v.Resize({batch_, heads_, capacity, dim_v_});
+  auto* k_data = k.mutable_data<float>();
+  auto* v_data = v.mutable_data<float>();
+  if (length_ > 0) {
+    std::vector<int64_t> src_heads(batch_ * heads_);
+    for (size_t i = 0; i < src_heads.size(); i++) src_heads[i] = i;
+    CopyRows(k_.data<float>(),
+             capacity_,
+             k_data,
+             capacity,
+             src_heads.data(),
+             batch_ * heads_,
+             length_,
+             dim_);
+    CopyRows(v_.data<float>(),
+             capacity_,
+             v_data,
+             capacity,
+             src_heads.data(),
+             batch_ * heads_,
+             length_,
+             dim_v_);
+  }
+  k_ = std::move(k);
+  v_ = std::move(v);
+  capacity_ = capacity;
+}
+
+void KVCache::Reorder(const int* parents, int64_t rows) {
+  CHECK(parents);
+  bool identity = rows == batch_;
+  for (int64_t i = 0; i < rows && identity; i++) {
+    identity = parents[i] == i;
+  }
+  if (identity || length_ == 0) return;
+  std::vector<int64_t> src_heads(rows * heads_);
+  for (int64_t i = 0; i < rows; i++) {
+    CHECK(parents[i] >= 0 && parents[i] < batch_)
+        << "The parent " << parents[i] << " is out of the " << batch_
+        << " cached beams";
+    for (int64_t h = 0; h < heads_; h++) {
+      src_heads[i * heads_ + h] = parents[i] * heads_ + h;
+    }
+  }
+  Tensor k;
+  Tensor v;
+  k.Resize({rows, heads_, capacity_, dim_});
+  v.Resize({rows, heads_, capacity_, dim_v_});
+  CopyRows(k_.data<float>(),
+           capacity_,
+           k.mutable_data<float>(),
+           capacity_,
+           src_heads.data(),
+           rows * heads_,
+           length_,
+           dim_);
+  CopyRows(v_.data<float>(),
+           capacity_,
+           v.mutable_data<float>(),
+           capacity_,
+           src_heads.data(),
+           rows * heads_,
+           length_,
+           dim_v_);
+  k_ = std::move(k);
+  v_ = std::move(v);
+  batch_ = rows;
+}
+
+void KVCache::Append(const Tensor& k, const Tensor& v) {
+  const auto& k_dims = k.dims();
+  const auto& v_dims = v.dims();
+  CHECK_EQ(k_dims.size(), 4UL) << "The keys should be [batch, heads, seq, dim]";
+  CHECK_EQ(v_dims.size(), 4UL)
+      << "The values should be [batch, heads, seq, dim]";
+  CHECK(k_dims[0] == v_dims[0] && k_dims[1] == v_dims[1] &&
+        k_dims[2] == v_dims[2])
+      << "The keys " << k_dims << " mismatch the values " << v_dims;
+  if (k_dims[0] != batch_ || k_dims[1] != heads_ || k_dims[3] != dim_ ||
+      v_dims[3] != dim_v_) {
+    batch_ = k_dims[0];
+    heads_ = k_dims[1];
+    dim_ = k_dims[3];
+    dim_v_ = v_dims[3];
+    length_ = 0;
+    capacity_ = 0;
+  }
+  int64_t seq = k_dims[2];
+  if (length_ + seq > capacity_) {
+    Grow(std::max(std::max(2 * capacity_, length_ + seq), kMinCapacity));
+  }
+  auto* k_data = k_.mutable_data<float>();
+  auto* v_data = v_.mutable_data<float>();
+  const auto* k_src = k.data<float>();
+  const auto* v_src = v.data<float>();
+  for (int64_t h = 0; h < batch_ * heads_; h++) {
+    std::memcpy(k_data + (h * capacity_ + length_) * dim_,
+                k_src + h * seq * dim_,
+                sizeof(float) * seq * dim_);
+    std::memcpy(v_data + (h * capacity_ + length_) * dim_v_,
+                v_src + h * seq * dim_v_,
+                sizeof(float) * seq * dim_v_);
+  }
+  length_ += seq;
+}
+
+}  // namespace lite
+}  // namespace paddle
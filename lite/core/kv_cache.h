@@ -0,0 +1,68 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstdint>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+
+// The keys and values of the attention layers cached across the steps of an
+// autoregressive decoding, so every step only computes the projections of the
+// new tokens. They are stored in [batch, heads, capacity, dim] with the rows
+// of the first `length` tokens valid, and the capacity grows geometrically,
+// so appending a step copies just the new rows in the amortized sense. It
+// lives in a RAW variable of the outer block of the `while` op, which is not
+// created by the program and keeps its content across the runs.
+class KVCache {
+ public:
+  // Drop the cached tokens but keep the memory, e.g. for a new request.
+  void Reset() { length_ = 0; }
+
+  // Select the rows of the cache by the beams survived, the i-th row of the
+  // new cache is the parents[i]-th row of the old one, as the parent_idx of
+  // beam_search. Nothing is copied if the beams are not reordered.
+  void Reorder(const int* parents, int64_t rows);
+
+  // Append the keys [batch, heads, seq, dim] and values [batch, heads, seq,
+  // dim_v] of the new tokens, the cache is reset if its batch, heads or dims
+  // differ from them.
+  void Append(const Tensor& k, const Tensor& v);
+
+  const float* k_data() const { return k_.data<float>(); }
+  const float* v_data() const { return v_.data<float>(); }
+  int64_t batch() const { return batch_; }
+  int64_t heads() const { return heads_; }
+  int64_t dim() const { return dim_; }
+  int64_t dim_v() const { return dim_v_; }
+  int64_t length() const { return length_; }
+  int64_t capacity() const { return capacity_; }
+
+ private:
+  // Move the valid rows into the new buffers of the capacity.
+  void Grow(int64_t capacity);
+
+  Tensor k_;
+  Tensor v_;
+  int64_t batch_{0};
+  int64_t heads_{0};
+  int64_t dim_{0};
+  int64_t dim_v_{0};
+  int64_t length_{0};
+  int64_t capacity_{0};
+};
+
+}  // namespace lite
+}  // namespace paddle
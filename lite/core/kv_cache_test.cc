@@ -0,0 +1,91 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/kv_cache.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+namespace {
+// Fill [batch, heads, seq, dim] with batch * 1000 + head * 100 + pos * 10 + c
+// for the tokens from `pos0`.
+void FillTokens(Tensor* x, int64_t pos0) {
+  const auto& dims = x->dims();
+  auto* data = x->mutable_data<float>();
+  for (int64_t b = 0; b < dims[0]; b++) {
+    for (int64_t h = 0; h < dims[1]; h++) {
+      for (int64_t s = 0; s < dims[2]; s++) {
+        for (int64_t c = 0; c < dims[3]; c++) {
+          *data++ = b * 1000 + h * 100 + (pos0 + s) * 10 + c;
+        }
+      }
+    }
+  }
+}
+
+float CachedAt(const KVCache& cache, int64_t b, int64_t h, int64_t s) {
+  return cache.k_data()[((b * cache.heads() + h) * cache.capacity() + s) *
+                        cache.dim()];
+}
+}  // namespace
+
+TEST(KVCache, append) {
+  KVCache cache;
+  Tensor k;
+  Tensor v;
+  for (int64_t pos = 0; pos < 40; pos += 5) {
+    k.Resize({2, 3, 5, 4});
+    v.Resize({2, 3, 5, 2});
+    FillTokens(&k, pos);
+    FillTokens(&v, pos);
+    cache.Append(k, v);
+  }
+  EXPECT_EQ(cache.length(), 40);
+  EXPECT_GE(cache.capacity(), 40);
+  EXPECT_EQ(cache.dim_v(), 2);
+  for (int64_t s = 0; s < 40; s++) {
+    EXPECT_EQ(CachedAt(cache, 1, 2, s), 1000 + 200 + s * 10);
+  }
+  cache.Reset();
+  EXPECT_EQ(cache.length(), 0);
+}
+
+TEST(KVCache, reorder) {
+  KVCache cache;
+  Tensor k;
+  Tensor v;
+  k.Resize({3, 2, 4, 4});
+  v.Resize({3, 2, 4, 4});
+  FillTokens(&k, 0);
+  FillTokens(&v, 0);
+  cache.Append(k, v);
+  std::vector<int> parents{2, 2, 0};
+  cache.Reorder(parents.data(), parents.size());
+  EXPECT_EQ(cache.batch(), 3);
+  for (int64_t b = 0; b < 3; b++) {
+    for (int64_t s = 0; s < 4; s++) {
+      EXPECT_EQ(CachedAt(cache, b, 1, s), parents[b] * 1000 + 100 + s * 10);
+    }
+  }
+  // The beams pruned shrink the cache.
+  parents = {1};
+  cache.Reorder(parents.data(), parents.size());
+  EXPECT_EQ(cache.batch(), 1);
+  EXPECT_EQ(CachedAt(cache, 0, 0, 3), 2 * 1000 + 30);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,319 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/latency_estimator.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include "lite/utils/log/logging.h"
+#include "lite/utils/string.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+
+// The op of the op benchmark of an op type, and the arguments of its main
+// input and output.
+struct BenchmarkOp {
+  const char* name;
+  const char* input;
+  const char* output;
+};
+
+bool FindBenchmarkOp(const std::string& op_type, BenchmarkOp* op) {
+  static const std::map<std::string, BenchmarkOp> ops = {
+      {"conv2d", {"conv", "Input", "Output"}},
+      {"depthwise_conv2d", {"conv", "Input", "Output"}},
+      {"fc", {"fc", "Input", "Out"}},
+      {"batch_norm", {"batchnorm", "X", "Y"}},
+      {"pool2d", {"pooling", "X", "Out"}},
+      {"relu", {"activation", "X", "Out"}},
+      {"relu6", {"activation", "X", "Out"}},
+      {"leaky_relu", {"activation", "X", "Out"}},
+      {"tanh", {"activation", "X", "Out"}},
+      {"swish", {"activation", "X", "Out"}},
+      {"exp", {"activation", "X", "Out"}},
+      {"abs", {"activation", "X", "Out"}},
+      {"hard_swish", {"activation", "X", "Out"}},
+      {"reciprocal", {"activation", "X", "Out"}},
+      {"thresholded_relu", {"activation", "X", "Out"}},
+  };
+  auto it = ops.find(op_type);
+  if (it == ops.end()) return false;
+  *op = it->second;
+  return true;
+}
+
+std::string Trim(const std::string& text) {
+  auto begin = text.find_first_not_of(" \t\r");
+  if (begin == std::string::npos) return "";
+  auto end = text.find_last_not_of(" \t\r");
+  return text.substr(begin, end - begin + 1);
+}
+
+// The value of `name` in the param info of the op benchmark, e.g. 1 of group
+// in "(ch_out=48,group=1,dtype=float)".
+std::string ParamValue(const std::string& param_info, const std::string& name) {
+  auto pos = param_info.find(name + "=");
+  if (pos == std::string::npos) return "";
+  pos += name.size() + 1;
+  auto end = param_info.find_first_of(",)", pos);
+  return Trim(param_info.substr(pos, end - pos));
+}
+
+// The dims of the op benchmark, e.g. "[1 96 112 112]".
+DDim ParseDims(const std::string& text) {
+  std::istringstream is(text.substr(text.find('[') + 1));
+  std::vector<int64_t> dims;
+  int64_t dim = 0;
+  while (is >> dim) dims.push_back(dim);
+  return DDim(dims);
+}
+
+const Tensor* FindTensor(Scope* scope, const std::string& name) {
+  auto* var = scope->FindVar(name);
+  if (!var || !var->IsType<Tensor>()) return nullptr;
+  return &var->Get<Tensor>();
+}
+
+const Tensor* ArgTensor(const OpLite& op,
+                        Scope* scope,
+                        const std::string& arg,
+                        bool input) {
+  auto* op_info = op.op_info();
+  if (input ? !op_info->HasInput(arg) : !op_info->HasOutput(arg)) {
+    return nullptr;
+  }
+  auto names = input ? op_info->Input(arg) : op_info->Output(arg);
+  return names.empty() ? nullptr : FindTensor(scope, names.front());
+}
+
+uint64_t TensorBytes(const Tensor& tensor) {
+  // The precision is unknown until the kernel runs, float is assumed then.
+  size_t size = PrecisionTypeLength(tensor.precision());
+  return tensor.dims().production() * (size ? size : sizeof(float));
+}
+
+// The multiply-adds are counted as 2 flops, and the other ops are assumed to
+// take 1 flop per output.
+uint64_t Flops(const OpLite& op, Scope* scope, uint64_t output_numel) {
+  auto type = op.Type();
+  auto* op_info = op.op_info();
+  if (type == "conv2d" || type == "depthwise_conv2d") {
+    auto* filter = ArgTensor(op, scope, "Filter", true);
+    if (filter && filter->dims().size() == 4) {
+      return 2 * output_numel * filter->dims().production() /
+             filter->dims()[0];
+    }
+  } else if (type == "conv2d_transpose") {
+    auto* input = ArgTensor(op, scope, "Input", true);
+    auto* filter = ArgTensor(op, scope, "Filter", true);
+    if (input && filter && filter->dims().size() == 4) {
+      return 2 * input->dims().production() * filter->dims().production() /
+             filter->dims()[0];
+    }
+  } else if (type == "fc") {
+    auto* w = ArgTensor(op, scope, "W", true);
+    if (w && w->dims().size() == 2) return 2 * output_numel * w->dims()[0];
+  } else if (type == "mul" || type == "matmul" || type == "matmul_v2") {
+    auto* x = ArgTensor(op, scope, "X", true);
+    if (x && x->dims().size() >= 2) {
+      bool transpose = false;
+      for (auto* attr : {"transpose_X", "trans_x"}) {
+        if (op_info->HasAttr(attr)) transpose = op_info->GetAttr<bool>(attr);
+      }
+      auto& dims = x->dims();
+      int64_t k = type == "mul" ? dims.production() / dims[0]
+                                : dims[dims.size() - (transpose ? 2 : 1)];
+      return 2 * output_numel * k;
+    }
+  }
+  return output_numel;
+}
+
+std::string BenchmarkKey(const OpLite& op, Scope* scope) {
+  BenchmarkOp benchmark_op;
+  if (!FindBenchmarkOp(op.Type(), &benchmark_op)) return "";
+  auto* input = ArgTensor(op, scope, benchmark_op.input, true);
+  auto* output = ArgTensor(op, scope, benchmark_op.output, false);
+  if (!input || !output) return "";
+  auto* op_info = op.op_info();
+  std::string param;
+  if (benchmark_op.name == std::string("conv")) {
+    int groups = op_info->HasAttr("groups") ? op_info->GetAttr<int>("groups")
+                                            : 1;
+    param = std::to_string(groups);
+  } else if (benchmark_op.name == std::string("pooling")) {
+    param = op_info->GetAttr<std::string>("pooling_type");
+  } else if (benchmark_op.name == std::string("activation")) {
+    param = op.Type() == "thresholded_relu" ? "threshold_relu" : op.Type();
+  }
+  return OpBenchmarkTable::Key(
+      benchmark_op.name, param, input->dims(), output->dims());
+}
+
+}  // namespace
+
+double DeviceProfile::LatencyMs(uint64_t flops, uint64_t bytes) const {
+  return std::max(flops / (gflops * 1e6), bytes / (bandwidth_gbps * 1e6));
+}
+
+std::string OpBenchmarkTable::Key(const std::string& op,
+                                  const std::string& param,
+                                  const DDim& input_dims,
+                                  const DDim& output_dims) {
+  return op + "|" + param + "|" + input_dims.repr() + "|" + output_dims.repr();
+}
+
+bool OpBenchmarkTable::Load(const std::string& path) {
+  std::ifstream file(path);
+  if (!file.is_open()) return false;
+  // The lines of the device info come first, then the ops with the fields of
+  // op_name, input_dims, output_dims, param_info, min, max and avg latency
+  // separated by the tabs.
+  std::string line;
+  bool ops_begin = false;
+  while (std::getline(file, line)) {
+    auto fields = lite::Split(line, "\t");
+    if (fields.empty()) continue;
+    auto op = Trim(fields[0]);
+    if (op == "op_name") {
+      ops_begin = true;
+      continue;
+    }
+    if (!ops_begin || fields.size() < 7) continue;
+    auto param_info = fields[3];
+    std::string param;
+    if (op == "conv") {
+      param = ParamValue(param_info, "group");
+    } else if (op == "pooling") {
+      param = ParamValue(param_info, "pooling_type");
+    } else if (op == "activation") {
+      param = ParamValue(param_info, "act_type");
+    }
+    std::istringstream is(fields[6]);
+    double ms = 0;
+    if (!(is >> ms)) continue;
+    entries_[Key(op, param, ParseDims(fields[1]), ParseDims(fields[2]))] = ms;
+  }
+  return true;
+}
+
+bool OpBenchmarkTable::Lookup(const std::string& key, double* ms) const {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) return false;
+  *ms = it->second;
+  return true;
+}
+
+bool LatencyEstimator::LoadTable(const std::string& path) {
+  std::ifstream file(path);
+  std::string header;
+  if (!std::getline(file, header)) return false;
+  if (header.compare(0, 25, "paddle-lite-latency-table") == 0) {
+    return latency_table_.Load(path);
+  }
+  return benchmark_table_.Load(path);
+}
+
+OpCostEstimate LatencyEstimator::EstimateOp(Instruction* inst,
+                                            Scope* scope) const {
+  auto* op = inst->op();
+  auto* op_info = op->op_info();
+  OpCostEstimate cost;
+  cost.op_type = op->Type();
+  if (inst->kernel()) cost.kernel = inst->kernel()->name();
+  uint64_t output_numel = 0;
+  for (auto& name : op_info->input_names()) {
+    auto* tensor = FindTensor(scope, name);
+    if (tensor) cost.bytes += TensorBytes(*tensor);
+  }
+  for (auto& name : op_info->output_names()) {
+    auto* tensor = FindTensor(scope, name);
+    if (!tensor) continue;
+    cost.bytes += TensorBytes(*tensor);
+    output_numel = std::max<uint64_t>(output_numel,
+                                      tensor->dims().production());
+  }
+  cost.flops = Flops(*op, scope, output_numel);
+
+  auto benchmark_key = BenchmarkKey(*op, scope);
+  if ((inst->kernel() &&
+       latency_table_.Lookup(inst->LatencyKey(profile_.threads), &cost.ms)) ||
+      (!benchmark_key.empty() &&
+       benchmark_table_.Lookup(benchmark_key, &cost.ms))) {
+    cost.measured = true;
+  } else {
+    cost.ms = profile_.LatencyMs(cost.flops, cost.bytes);
+  }
+  return cost;
+}
+
+CostEstimate LatencyEstimator::Estimate(RuntimeProgram* program) const {
+  CHECK(program);
+  auto* scope = program->exec_scope();
+  CHECK(scope);
+  CostEstimate estimate;
+  // The activations are the local vars of the exec scope, alive from the op
+  // of the first use to the last one, and the weights are of the root scope.
+  struct Lifetime {
+    uint64_t bytes;
+    size_t first;
+    size_t last;
+  };
+  std::map<std::string, Lifetime> activations;
+  std::map<std::string, uint64_t> weights;
+  program->InferShapes([&](Instruction* inst) {
+    size_t index = estimate.ops.size();
+    estimate.ops.push_back(EstimateOp(inst, scope));
+    estimate.total_ms += estimate.ops.back().ms;
+    auto* op_info = inst->op()->op_info();
+    auto names = op_info->input_names();
+    auto output_names = op_info->output_names();
+    names.insert(names.end(), output_names.begin(), output_names.end());
+    for (auto& name : names) {
+      auto* tensor = FindTensor(scope, name);
+      if (!tensor) continue;
+      uint64_t bytes = TensorBytes(*tensor);
+      if (!scope->FindLocalVar(name)) {
+        weights[name] = bytes;
+        continue;
+      }
+      auto it = activations.find(name);
+      if (it == activations.end()) {
+        activations.emplace(name, Lifetime{bytes, index, index});
+      } else {
+        it->second.bytes = std::max(it->second.bytes, bytes);
+        it->second.last = index;
+      }
+    }
+  });
+  for (auto& item : weights) estimate.weight_bytes += item.second;
+  std::vector<int64_t> deltas(estimate.ops.size() + 1, 0);
+  for (auto& item : activations) {
+    deltas[item.second.first] += item.second.bytes;
+    deltas[item.second.last + 1] -= item.second.bytes;
+  }
+  int64_t alive = 0;
+  for (auto delta : deltas) {
+    alive += delta;
+    estimate.peak_activation_bytes =
+        std::max<uint64_t>(estimate.peak_activation_bytes, alive);
+  }
+  return estimate;
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,104 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "lite/core/latency_table.h"
+#include "lite/core/program.h"
+
+namespace paddle {
+namespace lite {
+
+// The device of the analytic cost model, an op takes the longer of computing
+// its flops and moving its inputs and outputs through the memory, i.e. the
+// roofline of the device.
+struct DeviceProfile {
+  double gflops{10.0};
+  double bandwidth_gbps{10.0};
+  // The threads of the kernels in the latency table.
+  int threads{1};
+
+  double LatencyMs(uint64_t flops, uint64_t bytes) const;
+};
+
+// The latencies measured by the op benchmark of lite/tests/benchmark, keyed by
+// the op, its main parameter and the input and output dims, e.g. the
+// latency_lookup_table.txt there.
+class OpBenchmarkTable {
+ public:
+  // Load the table in `path`, return false if it can't be read.
+  bool Load(const std::string& path);
+  // The average latency in milliseconds.
+  bool Lookup(const std::string& key, double* ms) const;
+  size_t size() const { return entries_.size(); }
+
+  // `param` tells apart the ops of the same shapes, i.e. the group of conv,
+  // the pooling_type of pooling and the act_type of activation.
+  static std::string Key(const std::string& op,
+                         const std::string& param,
+                         const DDim& input_dims,
+                         const DDim& output_dims);
+
+ private:
+  std::map<std::string, double> entries_;
+};
+
+struct OpCostEstimate {
+  std::string op_type;
+  std::string kernel;
+  double ms{0};
+  // Looked up in a table, or estimated by the analytic model otherwise.
+  bool measured{false};
+  uint64_t flops{0};
+  uint64_t bytes{0};
+};
+
+struct CostEstimate {
+  std::vector<OpCostEstimate> ops;
+  double total_ms{0};
+  // The persistable tensors used by the ops.
+  uint64_t weight_bytes{0};
+  // The largest sum of the activations alive at the same time, without the
+  // reuse of the memory optimization passes.
+  uint64_t peak_activation_bytes{0};
+};
+
+// Estimate the latency and the peak memory of a runtime program on a device
+// without running it, e.g. by opt for a new device tier. The shapes are
+// inferred from the current input shapes, and each op is looked up in the
+// latency tables measured on the device, or estimated by the profile.
+class LatencyEstimator {
+ public:
+  explicit LatencyEstimator(const DeviceProfile& profile)
+      : profile_(profile) {}
+
+  // Load a table saved by LatencyTable or the op benchmark, told apart by the
+  // header, return false if it can't be read.
+  bool LoadTable(const std::string& path);
+
+  CostEstimate Estimate(RuntimeProgram* program) const;
+
+ private:
+  OpCostEstimate EstimateOp(Instruction* inst, Scope* scope) const;
+
+  DeviceProfile profile_;
+  LatencyTable latency_table_;
+  OpBenchmarkTable benchmark_table_;
+};
+
+}  // namespace lite
+}  // namespace paddle
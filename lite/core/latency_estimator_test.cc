@@ -0,0 +1,68 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/latency_estimator.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace paddle {
+namespace lite {
+
+TEST(OpBenchmarkTable, load_and_lookup) {
+  const std::string path = "op_benchmark_table_test.txt";
+  {
+    std::ofstream file(path);
+    file << "dev_info  \tarmv7/v8  \tcore_num  \tthread_num\n"
+         << "Kirin980  \tarmv8     \t8         \t1         \n"
+         << "op_name   \tinput_dims\toutput_dims\tparam_info\t"
+         << "min_latency(ms)\tmax_latency(ms)\tavg_latency(ms)\n"
+         << "conv      \t[1 96 112 112]\t[1 48 114 114]\t"
+         << "(ch_out=48,kernel=1x1,group=1,dtype=float)\t"
+         << "3.472     \t5.384     \t3.97393   \n"
+         << "pooling   \t[1 64 56 56]\t[1 64 28 28]\t"
+         << "(stride=2,pooling_type=max,dtype=float)\t"
+         << "0.1       \t0.3       \t0.2       \n";
+  }
+  OpBenchmarkTable table;
+  EXPECT_TRUE(table.Load(path));
+  EXPECT_EQ(table.size(), 2u);
+  double ms = 0;
+  auto conv = OpBenchmarkTable::Key(
+      "conv", "1", DDim({1, 96, 112, 112}), DDim({1, 48, 114, 114}));
+  EXPECT_TRUE(table.Lookup(conv, &ms));
+  EXPECT_DOUBLE_EQ(ms, 3.97393);
+  auto max_pool = OpBenchmarkTable::Key(
+      "pooling", "max", DDim({1, 64, 56, 56}), DDim({1, 64, 28, 28}));
+  EXPECT_TRUE(table.Lookup(max_pool, &ms));
+  EXPECT_DOUBLE_EQ(ms, 0.2);
+  auto avg_pool = OpBenchmarkTable::Key(
+      "pooling", "avg", DDim({1, 64, 56, 56}), DDim({1, 64, 28, 28}));
+  EXPECT_FALSE(table.Lookup(avg_pool, &ms));
+  std::remove(path.c_str());
+}
+
+TEST(DeviceProfile, roofline) {
+  DeviceProfile profile;
+  profile.gflops = 20;
+  profile.bandwidth_gbps = 5;
+  // Bound by the computation.
+  EXPECT_DOUBLE_EQ(profile.LatencyMs(40000000, 1000), 2.0);
+  // Bound by the memory.
+  EXPECT_DOUBLE_EQ(profile.LatencyMs(1000, 10000000), 2.0);
+}
+
+}  // namespace lite
+}  // namespace paddle
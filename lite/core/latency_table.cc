@@ -0,0 +1,151 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/latency_table.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include "lite/utils/log/logging.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+const char* const kHeader = "paddle-lite-latency-table v1";
+}  // namespace
+
+std::string LatencyTable::Key(const std::string& kernel_name,
+                              const std::string& input_shapes,
+                              int threads) {
+  return kernel_name + "|" + input_shapes + "|threads:" +
+         std::to_string(threads);
+}
+
+bool LatencyTable::LoadFile(const std::string& path,
+                            std::map<std::string, Entry>* entries) {
+  std::ifstream file(path);
+  if (!file.is_open()) return false;
+  std::string line;
+  if (!std::getline(file, line) || line != kHeader) {
+    LOG(WARNING) << "Ignore the latency table " << path
+                 << " of an unknown version";
+    return false;
+  }
+  // Each line is a key, the average latency in ms and the runs separated by
+  // the tabs.
+  while (std::getline(file, line)) {
+    auto runs_pos = line.rfind('\t');
+    if (runs_pos == std::string::npos || runs_pos == 0) continue;
+    auto ms_pos = line.rfind('\t', runs_pos - 1);
+    if (ms_pos == std::string::npos) continue;
+    Entry entry;
+    std::istringstream is(line.substr(ms_pos + 1));
+    double ms = 0;
+    if (!(is >> ms >> entry.runs) || entry.runs == 0) continue;
+    entry.total_ms = ms * entry.runs;
+    entries->emplace(line.substr(0, ms_pos), entry);
+  }
+  return true;
+}
+
+bool LatencyTable::Load(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return LoadFile(path, &entries_);
+}
+
+bool LatencyTable::Save(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  LoadFile(path, &entries_);
+  std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream file(tmp_path);
+    file << kHeader << "\n";
+    for (auto& item : entries_) {
+      file << item.first << "\t" << item.second.total_ms / item.second.runs
+           << "\t" << item.second.runs << "\n";
+    }
+    if (!file.good()) {
+      LOG(WARNING) << "Failed to write the latency table " << tmp_path;
+      return false;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    LOG(WARNING) << "Failed to save the latency table " << path;
+    std::remove(tmp_path.c_str());
+    return false;
+  }
+  VLOG(1) << "Saved the latencies of " << entries_.size() << " kernels into "
+          << path;
+  return true;
+}
+
+void LatencyTable::Record(const std::string& key, double ms) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& entry = entries_[key];
+  entry.total_ms += ms;
+  entry.runs++;
+}
+
+bool LatencyTable::Lookup(const std::string& key, double* ms) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) return false;
+  *ms = it->second.total_ms / it->second.runs;
+  return true;
+}
+
+size_t LatencyTable::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+std::map<std::string, double> LatencyTable::RelativeLatencies(
+    const std::string& op_type) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The kernel names begin with the op type followed by ':', and the shapes
+  // and the threads follow the kernel name, see Key().
+  const std::string prefix = op_type + ":";
+  std::map<std::string, std::map<std::string, double>> runs;
+  for (auto& item : entries_) {
+    const std::string& key = item.first;
+    if (key.compare(0, prefix.size(), prefix) != 0) continue;
+    auto pos = key.find('|');
+    if (pos == std::string::npos) continue;
+    runs[key.substr(pos)][key.substr(0, pos)] =
+        item.second.total_ms / item.second.runs;
+  }
+  std::map<std::string, double> total;
+  std::map<std::string, int> count;
+  for (auto& run : runs) {
+    if (run.second.size() < 2) continue;
+    double fastest = run.second.begin()->second;
+    for (auto& kernel : run.second) {
+      fastest = std::min(fastest, kernel.second);
+    }
+    if (fastest <= 0) continue;
+    for (auto& kernel : run.second) {
+      total[kernel.first] += kernel.second / fastest;
+      count[kernel.first]++;
+    }
+  }
+  for (auto& kernel : total) {
+    kernel.second /= count[kernel.first];
+  }
+  return total;
+}
+
+}  // namespace lite
+}  // namespace paddle
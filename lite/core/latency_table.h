@@ -0,0 +1,65 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstdint>
+#include <map>
+#include <mutex>  // NOLINT
+#include <string>
+
+namespace paddle {
+namespace lite {
+
+// The latencies of the kernels measured on a device, keyed by the kernel, the
+// input shapes and the threads, see Key(). It's filled by running the
+// representative inputs, and read to estimate the latency of a model on the
+// device without running it, e.g. to select among the candidate models.
+class LatencyTable {
+ public:
+  static std::string Key(const std::string& kernel_name,
+                         const std::string& input_shapes,
+                         int threads);
+
+  // Load the latencies saved in `path`, return false if it can't be read.
+  bool Load(const std::string& path);
+  // Save the latencies into `path`, merged with the ones saved meanwhile, the
+  // recorded ones are preferred.
+  bool Save(const std::string& path);
+
+  // Accumulate a run of `ms` milliseconds, thread-safe.
+  void Record(const std::string& key, double ms);
+  // The average latency in milliseconds.
+  bool Lookup(const std::string& key, double* ms) const;
+  size_t size() const;
+
+  // The latencies of the kernels of `op_type` relative to the fastest one
+  // of the same input shapes and threads, averaged over the shapes measured
+  // by more than one kernel of the op, keyed by the kernel name.
+  std::map<std::string, double> RelativeLatencies(
+      const std::string& op_type) const;
+
+ private:
+  struct Entry {
+    double total_ms{0};
+    uint64_t runs{0};
+  };
+  static bool LoadFile(const std::string& path,
+                       std::map<std::string, Entry>* entries);
+
+  std::map<std::string, Entry> entries_;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,94 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/latency_table.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+
+namespace paddle {
+namespace lite {
+
+TEST(LatencyTable, record_and_save) {
+  const std::string path = "latency_table_test.txt";
+  std::remove(path.c_str());
+  LatencyTable table;
+  EXPECT_FALSE(table.Load(path));
+  auto key = LatencyTable::Key("conv2d,kARM,kFloat", "{1,3,224,224}", 4);
+  double ms = 0;
+  EXPECT_FALSE(table.Lookup(key, &ms));
+  table.Record(key, 1.0);
+  table.Record(key, 3.0);
+  EXPECT_TRUE(table.Lookup(key, &ms));
+  EXPECT_DOUBLE_EQ(ms, 2.0);
+  EXPECT_TRUE(table.Save(path));
+
+  LatencyTable loaded;
+  EXPECT_TRUE(loaded.Load(path));
+  EXPECT_EQ(loaded.size(), 1u);
+  EXPECT_TRUE(loaded.Lookup(key, &ms));
+  EXPECT_DOUBLE_EQ(ms, 2.0);
+  std::remove(path.c_str());
+}
+
+TEST(LatencyTable, merge_on_save) {
+  const std::string path = "latency_table_merge_test.txt";
+  std::remove(path.c_str());
+  auto key_a = LatencyTable::Key("fc,kARM,kFloat", "{1,512}", 1);
+  auto key_b = LatencyTable::Key("pool2d,kARM,kFloat", "{1,32,56,56}", 1);
+  LatencyTable table;
+  table.Record(key_a, 1.0);
+  // Saved by another process meanwhile.
+  {
+    LatencyTable other;
+    other.Record(key_a, 5.0);
+    other.Record(key_b, 2.0);
+    EXPECT_TRUE(other.Save(path));
+  }
+  EXPECT_TRUE(table.Save(path));
+
+  LatencyTable loaded;
+  EXPECT_TRUE(loaded.Load(path));
+  EXPECT_EQ(loaded.size(), 2u);
+  double ms = 0;
+  EXPECT_TRUE(loaded.Lookup(key_a, &ms));
+  EXPECT_DOUBLE_EQ(ms, 1.0);
+  EXPECT_TRUE(loaded.Lookup(key_b, &ms));
+  EXPECT_DOUBLE_EQ(ms, 2.0);
+  std::remove(path.c_str());
+}
+
+TEST(LatencyTable, relative_latencies) {
+  const std::string image = "fc:opencl/float16/ImageFolder";
+  const std::string buffer = "fc:opencl/float/NCHW";
+  LatencyTable table;
+  table.Record(LatencyTable::Key(image, "{1,512}", 1), 2.0);
+  table.Record(LatencyTable::Key(buffer, "{1,512}", 1), 1.0);
+  table.Record(LatencyTable::Key(image, "{4,512}", 1), 3.0);
+  table.Record(LatencyTable::Key(buffer, "{4,512}", 1), 2.0);
+  // Measured by one kernel only, or of other ops.
+  table.Record(LatencyTable::Key(image, "{8,512}", 1), 1.0);
+  table.Record(LatencyTable::Key("conv2d:opencl/float16/ImageDefault",
+                                 "{1,512}",
+                                 1),
+               1.0);
+  auto latencies = table.RelativeLatencies("fc");
+  ASSERT_EQ(latencies.size(), 2u);
+  EXPECT_DOUBLE_EQ(latencies[image], 1.75);
+  EXPECT_DOUBLE_EQ(latencies[buffer], 1.0);
+  EXPECT_TRUE(table.RelativeLatencies("conv2d").empty());
+}
+
+}  // namespace lite
+}  // namespace paddle
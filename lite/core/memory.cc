@@ -66,6 +66,11 @@ void* TargetMalloc(TargetType target, size_t size) {
       break;
     }
 #endif  // LITE_WITH_METAL
+#ifdef LITE_WITH_VULKAN
+    case TargetType::kVulkan:
+      data = TargetWrapperVK::Malloc(size);
+      break;
+#endif  // LITE_WITH_VULKAN
     default:
       LOG(FATAL) << "Unknown supported target " << TargetToStr(target);
   }
@@ -123,6 +128,11 @@ void TargetFree(TargetType target, void* data, std::string free_flag) {
       }
       break;
 #endif
+#ifdef LITE_WITH_VULKAN
+    case TargetType::kVulkan:
+      TargetWrapperVK::Free(data);
+      break;
+#endif  // LITE_WITH_VULKAN
     default:
       LOG(FATAL) << "Unknown type";
   }
@@ -175,6 +185,11 @@ void TargetCopy(TargetType target, void* dst, const void* src, size_t size) {
       TargetWrapperMetal::MemcpySync(dst, src, size, IoDirection::DtoD);
       break;
 #endif
+#ifdef LITE_WITH_VULKAN
+    case TargetType::kVulkan:
+      TargetWrapperVK::MemcpySync(dst, src, size, IoDirection::DtoD);
+      break;
+#endif  // LITE_WITH_VULKAN
     default:
       LOG(FATAL) << "unsupported type";
   }
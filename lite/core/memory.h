@@ -23,6 +23,10 @@
 #include "lite/utils/log/logging.h"
 #include "lite/utils/macros.h"
 
+#ifdef LITE_WITH_PROFILE
+#include "lite/core/profile/memory_profiler.h"
+#endif  // LITE_WITH_PROFILE
+
 #ifdef LITE_WITH_OPENCL
 #include "lite/backends/opencl/target_wrapper.h"
 #endif  // LITE_WITH_OPENCL
@@ -43,6 +47,10 @@
 #include "lite/backends/xpu/target_wrapper.h"
 #endif  // LITE_WITH_XPU
 
+#ifdef LITE_WITH_VULKAN
+#include "lite/backends/vulkan/target_wrapper.h"
+#endif  // LITE_WITH_VULKAN
+
 #ifdef LITE_WITH_METAL
 #include "lite/backends/metal/metal_buffer.h"
 #include "lite/backends/metal/metal_image.h"
@@ -98,6 +106,11 @@ void CopySync(void* dst, const void* src, size_t size, IoDirection dir) {
       TargetWrapperMetal::MemcpySync(dst, src, size, dir);
       break;
 #endif  // LITE_WITH_METAL
+#ifdef LITE_WITH_VULKAN
+    case TargetType::kVulkan:
+      TargetWrapperVK::MemcpySync(dst, src, size, dir);
+      break;
+#endif  // LITE_WITH_VULKAN
 #ifdef LITE_WITH_MLU
     case TARGET(kMLU):
       TargetWrapperMlu::MemcpySync(dst, src, size, dir);
@@ -142,6 +155,11 @@ class Buffer {
       data_ = TargetMalloc(target, size);
       target_ = target;
       space_ = size;
+#ifdef LITE_WITH_PROFILE
+      if (profile::MemoryProfiler::Enabled()) {
+        profile::MemoryProfiler::Global().RecordMalloc(this, target, size);
+      }
+#endif
 #ifdef LITE_WITH_OPENCL
       cl_use_image2d_ = false;
 #endif
@@ -221,6 +239,11 @@ class Buffer {
 #endif
 
   virtual void Free() {
+#ifdef LITE_WITH_PROFILE
+    if (profile::MemoryProfiler::Enabled() && data_) {
+      profile::MemoryProfiler::Global().RecordFree(this);
+    }
+#endif
     if (space_ > 0 && own_data_) {
       if (!cl_use_image2d_ && !metal_use_image2d_) {
         TargetFree(target_, data_);
@@ -0,0 +1,80 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/memory_planner.h"
+#include <algorithm>
+#include <numeric>
+
+namespace paddle {
+namespace lite {
+
+size_t PlanMemoryBlocks(std::vector<MemoryBlock>* blocks, size_t alignment) {
+  CHECK(blocks);
+  CHECK_GT(alignment, 0u);
+  auto align = [=](size_t x) {
+    return (x + alignment - 1) / alignment * alignment;
+  };
+  std::vector<int> order(blocks->size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    return (*blocks)[a].size > (*blocks)[b].size;
+  });
+
+  size_t arena_size = 0;
+  std::vector<int> placed;
+  std::vector<const MemoryBlock*> conflicts;
+  for (int i : order) {
+    auto& block = (*blocks)[i];
+    conflicts.clear();
+    for (int j : placed) {
+      auto& other = (*blocks)[j];
+      if (block.begin <= other.end && other.begin <= block.end) {
+        conflicts.push_back(&other);
+      }
+    }
+    std::sort(conflicts.begin(),
+              conflicts.end(),
+              [](const MemoryBlock* a, const MemoryBlock* b) {
+                return a->offset < b->offset;
+              });
+    // Take the first gap between the conflicting blocks that fits.
+    size_t offset = 0;
+    for (auto* other : conflicts) {
+      if (offset + block.size <= other->offset) break;
+      offset = (std::max)(offset, align(other->offset + other->size));
+    }
+    block.offset = offset;
+    arena_size = (std::max)(arena_size, offset + block.size);
+    placed.push_back(i);
+  }
+  return align(arena_size);
+}
+
+std::string ShapeBucket(const std::vector<DDim>& shapes) {
+  std::string bucket;
+  for (size_t i = 0; i < shapes.size(); i++) {
+    if (i > 0) bucket += ";";
+    for (size_t j = 0; j < shapes[i].size(); j++) {
+      int64_t dim = shapes[i][j];
+      int64_t rounded = 1;
+      while (rounded < dim) rounded <<= 1;
+      if (j > 0) bucket += "x";
+      bucket += std::to_string(dim > 0 ? rounded : dim);
+    }
+  }
+  return bucket;
+}
+
+}  // namespace lite
+}  // namespace paddle
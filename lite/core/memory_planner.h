@@ -0,0 +1,112 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/memory.h"
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+
+// A block of memory to be placed in an arena, which is alive from the
+// begin-th to the end-th instruction.
+struct MemoryBlock {
+  int begin{0};
+  int end{0};
+  size_t size{0};
+  // The byte offset in the arena, assigned by PlanMemoryBlocks.
+  size_t offset{0};
+};
+
+// Assign the offsets of `blocks` in a single arena, the blocks whose lifetimes
+// overlap never overlap in the arena. The blocks are placed in the decreasing
+// order of their sizes at the lowest aligned offset that does not conflict
+// with the placed ones(greedy by size). Return the size of the arena.
+size_t PlanMemoryBlocks(std::vector<MemoryBlock>* blocks,
+                        size_t alignment = 64);
+
+// The layout of the activations in an arena, planned for one bucket of the
+// input shapes.
+struct MemoryPlan {
+  struct Slot {
+    size_t offset{0};
+    size_t size{0};
+    TargetType target{TARGET(kHost)};
+    // The tensors sharing the slot, e.g. the inplace reshape.
+    std::vector<Tensor*> tensors;
+  };
+  std::vector<Slot> slots;
+  size_t arena_size{0};
+  // The total size of the activations without reuse.
+  size_t activation_size{0};
+  // The number of runs using the plan.
+  int64_t runs{0};
+};
+
+struct MemoryPlanStats {
+  std::string bucket;
+  // The peak memory of the bucket, i.e. the size of its arena.
+  size_t arena_size{0};
+  size_t activation_size{0};
+  int64_t runs{0};
+};
+
+// Return the key of the bucket of `shapes`, which rounds every dimension up to
+// a power of two, e.g. {1, 3, 100} and {1, 3, 120} are both "1x4x128".
+std::string ShapeBucket(const std::vector<DDim>& shapes);
+
+// A slice of a memory arena which keeps the arena alive. Once it is reset to a
+// larger size, e.g. the shapes grow after the planning, it leaves the arena and
+// allocates the memory of its own.
+class ArenaBuffer : public Buffer {
+ public:
+  ArenaBuffer(const std::shared_ptr<Buffer>& arena,
+              size_t offset,
+              size_t size,
+              TargetType target)
+      : Buffer(static_cast<char*>(arena->data()) + offset, target, size),
+        arena_(arena) {}
+
+  void ResetLazy(TargetType target, size_t size) override {
+    if (!own_data_ && (target != target_ || space_ < size)) {
+      data_ = nullptr;
+      space_ = 0;
+      own_data_ = true;
+      arena_.reset();
+    }
+    Buffer::ResetLazy(target, size);
+  }
+
+  void Free() override {
+    if (own_data_) {
+      Buffer::Free();
+      return;
+    }
+    data_ = nullptr;
+    space_ = 0;
+    own_data_ = true;
+    arena_.reset();
+  }
+
+  bool in_arena() const { return arena_ != nullptr; }
+
+ private:
+  std::shared_ptr<Buffer> arena_;
+};
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,101 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/memory_planner.h"
+#include <gtest/gtest.h>
+#include <vector>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+
+MemoryBlock MakeBlock(int begin, int end, size_t size) {
+  MemoryBlock block;
+  block.begin = begin;
+  block.end = end;
+  block.size = size;
+  return block;
+}
+
+TEST(MemoryPlanner, chain) {
+  // The activations of a chain: a -> b -> c -> d.
+  std::vector<MemoryBlock> blocks = {MakeBlock(0, 1, 256),
+                                     MakeBlock(1, 2, 128),
+                                     MakeBlock(2, 3, 256),
+                                     MakeBlock(3, 4, 64)};
+  size_t arena_size = PlanMemoryBlocks(&blocks, 64);
+  EXPECT_EQ(arena_size, 384u);
+  for (size_t i = 0; i < blocks.size(); i++) {
+    for (size_t j = i + 1; j < blocks.size(); j++) {
+      auto& a = blocks[i];
+      auto& b = blocks[j];
+      bool live_together = a.begin <= b.end && b.begin <= a.end;
+      bool overlap =
+          a.offset < b.offset + b.size && b.offset < a.offset + a.size;
+      EXPECT_FALSE(live_together && overlap) << i << " and " << j;
+    }
+  }
+  EXPECT_EQ(blocks[0].offset, 0u);
+  EXPECT_EQ(blocks[2].offset, 0u);
+}
+
+TEST(MemoryPlanner, alignment) {
+  std::vector<MemoryBlock> blocks = {MakeBlock(0, 1, 100), MakeBlock(0, 1, 10)};
+  size_t arena_size = PlanMemoryBlocks(&blocks, 64);
+  EXPECT_EQ(blocks[0].offset, 0u);
+  EXPECT_EQ(blocks[1].offset, 128u);
+  EXPECT_EQ(arena_size, 192u);
+}
+
+TEST(MemoryPlanner, arena_buffer) {
+  auto arena = std::make_shared<Buffer>();
+  arena->ResetLazy(TARGET(kHost), 1024);
+  Tensor tensor;
+  tensor.Resize({16});
+  auto buffer = std::make_shared<ArenaBuffer>(arena, 256, 64, TARGET(kHost));
+  tensor.ResetBuffer(buffer, 64);
+  EXPECT_EQ(tensor.mutable_data<float>(),
+            reinterpret_cast<float*>(static_cast<char*>(arena->data()) + 256));
+  EXPECT_TRUE(buffer->in_arena());
+  // Growing leaves the arena instead of failing.
+  tensor.Resize({32});
+  auto* data = tensor.mutable_data<float>();
+  EXPECT_FALSE(buffer->in_arena());
+  EXPECT_NE(data, reinterpret_cast<float*>(arena->data()) + 64);
+  data[31] = 1.f;
+}
+
+TEST(MemoryPlanner, arena_buffer_free) {
+  auto arena = std::make_shared<Buffer>();
+  arena->ResetLazy(TARGET(kHost), 256);
+  auto buffer = std::make_shared<ArenaBuffer>(arena, 0, 256, TARGET(kHost));
+  EXPECT_EQ(arena.use_count(), 2);
+  buffer->Free();
+  EXPECT_FALSE(buffer->in_arena());
+  EXPECT_EQ(arena.use_count(), 1);
+  buffer->ResetLazy(TARGET(kHost), 64);
+  EXPECT_NE(buffer->data(), nullptr);
+}
+
+TEST(MemoryPlanner, shape_bucket) {
+  EXPECT_EQ(ShapeBucket({DDim(std::vector<int64_t>({1, 3, 100}))}), "1x4x128");
+  EXPECT_EQ(ShapeBucket({DDim(std::vector<int64_t>({1, 3, 120}))}), "1x4x128");
+  EXPECT_EQ(ShapeBucket({DDim(std::vector<int64_t>({2, 64})),
+                         DDim(std::vector<int64_t>({2, 65}))}),
+            "2x64;2x128");
+  EXPECT_EQ(ShapeBucket({}), "");
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,72 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <memory>
+#include <mutex>  // NOLINT
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+
+/*
+ * Holds the attributes of an op desc decoded into a typed struct, so that the
+ * ops attached to the desc read them once instead of looking up the string
+ * keyed attribute map on every attach. The struct T provides
+ * `static T Decode(const cpp::OpDesc&)`.
+ *
+ * Copies of a desc share the decoded attributes until one of them changes its
+ * attributes, then it drops its share by Reset().
+ */
+class DecodedAttrsCache {
+ public:
+  DecodedAttrsCache() : slot_(std::make_shared<Slot>()) {}
+
+  template <typename T, typename DescT>
+  const T& Get(const DescT& desc) const {
+    std::lock_guard<std::mutex> lock(slot_->mutex);
+    if (!slot_->attrs) {
+      slot_->attrs = std::make_shared<const T>(T::Decode(desc));
+      slot_->type = TypeId<T>();
+    }
+    CHECK(slot_->type == TypeId<T>())
+        << "The attributes of an op desc are decoded into one type only.";
+    return *static_cast<const T*>(slot_->attrs.get());
+  }
+
+  // Called whenever the attributes of the owning desc are modified.
+  void Reset() {
+    if (slot_.use_count() > 1 || slot_->attrs) {
+      slot_ = std::make_shared<Slot>();
+    }
+  }
+
+ private:
+  struct Slot {
+    std::mutex mutex;
+    const void* type{nullptr};
+    std::shared_ptr<const void> attrs;
+  };
+
+  template <typename T>
+  static const void* TypeId() {
+    static const char id = 0;
+    return &id;
+  }
+
+  std::shared_ptr<Slot> slot_;
+};
+
+}  // namespace lite
+}  // namespace paddle
@@ -13,6 +13,13 @@
 // limitations under the License.
 
 #include "lite/core/model/base/io.h"
+#include "lite/core/runtime_stats.h"
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace paddle {
 namespace lite {
@@ -51,11 +58,84 @@ BinaryFileReader::BinaryFileReader(const std::string& path, size_t offset) {
 
 void BinaryFileReader::Read(void* dst, size_t size) const {
   CHECK(dst);
+  uint64_t start = MonotonicNanos();
   CHECK_EQ(fread(dst, 1, size, file_), size) << "Failed to read " << size
                                              << " bytes.";
+  ThreadBuildStats::Current().read_file_ns += MonotonicNanos() - start;
   cur_ += size;
 }
 
+#if !defined(_WIN32)
+namespace {
+class MappedFile : public lite::Buffer {
+ public:
+  MappedFile(void* data, size_t size)
+      : lite::Buffer(data, TargetType::kHost, size) {}
+  ~MappedFile() { munmap(data_, space_); }
+};
+}  // namespace
+#endif
+
+SharedBufferReader::SharedBufferReader(
+    const std::shared_ptr<lite::Buffer>& buffer, size_t offset) {
+  Init(buffer, offset);
+}
+
+void SharedBufferReader::Init(const std::shared_ptr<lite::Buffer>& buffer,
+                              size_t offset) {
+  CHECK(buffer);
+  CHECK_LE(offset, buffer->space());
+  buffer_ = buffer;
+  offset_ = offset;
+  length_ = buffer->space() - offset;
+  cur_ = 0;
+}
+
+void SharedBufferReader::Read(void* dst, size_t size) const {
+  CHECK(dst);
+  lite::TargetCopy(TargetType::kHost, dst, ReadInPlace(size), size);
+}
+
+const void* SharedBufferReader::ReadInPlace(size_t size) const {
+  CHECK_LE(cur_ + size, length_) << "Failed to read " << size << " bytes.";
+  const char* data = static_cast<const char*>(buffer_->data()) + offset_ + cur_;
+  cur_ += size;
+  return data;
+}
+
+MappedFileReader::MappedFileReader(const std::string& path, size_t offset) {
+#if defined(_WIN32)
+  LOG(FATAL) << "Mapping the model file is not supported on Windows";
+#else
+  uint64_t start = MonotonicNanos();
+  int fd = open(path.c_str(), O_RDONLY);
+  CHECK_GE(fd, 0) << "Unable to open file: " << path;
+  struct stat file_stat;
+  CHECK_EQ(fstat(fd, &file_stat), 0) << "Unable to stat file: " << path;
+  size_t size = file_stat.st_size;
+  CHECK_GT(size, offset) << "The file " << path << " is too small";
+  // The private writable mapping allows the weights to be modified in place,
+  // e.g. converted after loading, without affecting the file.
+  void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  CHECK(data != MAP_FAILED) << "Unable to map file: " << path;
+  // Only the mapping, the pages are read by the first touches later.
+  ThreadBuildStats::Current().read_file_ns += MonotonicNanos() - start;
+  Init(std::make_shared<MappedFile>(data, size), offset);
+#endif
+}
+
+void ReadAhead(const void* data, size_t size) {
+#if !defined(_WIN32)
+  if (!data || size == 0) return;
+  static const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  uintptr_t begin = reinterpret_cast<uintptr_t>(data) & ~(page_size - 1);
+  uintptr_t end = reinterpret_cast<uintptr_t>(data) + size;
+  // Only a hint, the failures are ignored.
+  madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+#endif
+}
+
 void BinaryFileWriter::Write(const void* src, size_t size) const {
   CHECK(src);
   CHECK_EQ(fwrite(src, 1, size, file_), size) << "Failed to read " << size
@@ -83,6 +83,11 @@ class ByteReader {
   virtual size_t length() const = 0;
   virtual size_t current() const = 0;
   virtual bool ReachEnd() const = 0;
+  // Return the next `size` bytes in place and skip them, or nullptr if the
+  // reader does not hold the bytes in memory.
+  virtual const void* ReadInPlace(size_t size) const { return nullptr; }
+  // The memory which keeps the bytes returned by ReadInPlace alive.
+  virtual std::shared_ptr<lite::Buffer> mapping() const { return nullptr; }
 
   template <typename T,
             typename = typename std::enable_if<
@@ -118,6 +123,8 @@ class ByteWriter {
   }
 
   virtual size_t Align(size_t bytes_size) const = 0;
+  // The number of the written bytes.
+  virtual size_t current() const = 0;
 
   virtual ~ByteWriter() = default;
 
@@ -145,6 +152,42 @@ class BinaryFileReader : public ByteReader {
   mutable size_t cur_{0};
 };
 
+// Read from the memory which is shared with the tensors, so that they can
+// refer to the data in place.
+class SharedBufferReader : public ByteReader {
+ public:
+  explicit SharedBufferReader(const std::shared_ptr<lite::Buffer>& buffer,
+                              size_t offset = 0);
+  void Read(void* dst, size_t size) const override;
+  const void* ReadInPlace(size_t size) const override;
+  std::shared_ptr<lite::Buffer> mapping() const override { return buffer_; }
+  bool ReachEnd() const override { return cur_ >= length_; }
+  size_t length() const override { return length_; }
+  size_t current() const override { return cur_; }
+
+ protected:
+  SharedBufferReader() = default;
+  void Init(const std::shared_ptr<lite::Buffer>& buffer, size_t offset);
+
+ private:
+  std::shared_ptr<lite::Buffer> buffer_;
+  size_t offset_{0};
+  size_t length_{0};
+  mutable size_t cur_{0};
+};
+
+// Map the file into memory, the pages are loaded lazily and copied on write,
+// so the tensors can share the data in place. Not supported on Windows.
+class MappedFileReader : public SharedBufferReader {
+ public:
+  explicit MappedFileReader(const std::string& path, size_t offset = 0);
+};
+
+// Start reading the pages of [data, data + size) in the background, e.g. the
+// mapped weights of the ops to run next, so the first touch does not wait for
+// the storage. Only a hint, which does nothing on Windows.
+void ReadAhead(const void* data, size_t size);
+
 class BinaryFileWriter : public ByteWriter {
  public:
   explicit BinaryFileWriter(const std::string& path) {
@@ -167,6 +210,7 @@ class BinaryFileWriter : public ByteWriter {
     }
     return padding_bytes;
   }
+  size_t current() const override { return cur_; }
 
  private:
   FILE* file_{};
@@ -18,6 +18,7 @@
 #include <utility>
 #include <vector>
 #include "lite/core/model/base/apis.h"
+#include "lite/core/model/base/decoded_attrs.h"
 #include "lite/utils/any.h"
 #include "lite/utils/varient.h"
 
@@ -40,12 +41,16 @@ class OpDesc : public OpDescAPI {
   std::map<std::string, std::vector<std::string>> outputs_;
   std::map<std::string, Any> attrs_;
   std::map<std::string, AttrType> attr_types_;
+  DecodedAttrsCache decoded_attrs_;
 
  public:
   OpDesc() = default;
 
   std::string Type() const override { return type_; }
-  void SetType(const std::string& x) override { type_ = x; }
+  void SetType(const std::string& x) override {
+    type_ = x;
+    decoded_attrs_.Reset();
+  }
 
   const std::map<std::string, std::vector<std::string>>& inputs() const {
     return inputs_;
@@ -110,6 +115,7 @@ class OpDesc : public OpDescAPI {
   void SetAttr(const std::string& name, const T& v) {
     attr_types_[name] = OpDataTypeTrait<T>::AT;
     attrs_[name].set(v);
+    decoded_attrs_.Reset();
   }
 
   template <typename T>
@@ -129,9 +135,16 @@ class OpDesc : public OpDescAPI {
   void DeleteAttr(const std::string& name) {
     if (attrs_.count(name) > 0) {
       attrs_.erase(name);
+      decoded_attrs_.Reset();
     }
   }
 
+  // The attributes decoded into the struct T once, see DecodedAttrsCache.
+  template <typename T>
+  const T& DecodedAttrs() const {
+    return decoded_attrs_.Get<T>(*this);
+  }
+
   const std::map<std::string, Any>& attrs() const { return attrs_; }
   const std::map<std::string, AttrType>& attr_types() const {
     return attr_types_;
@@ -18,48 +18,101 @@
 #include <utility>
 #include <vector>
 #include "lite/core/op_registry.h"
+#include "lite/core/runtime_stats.h"
 #include "lite/utils/string.h"
 
 namespace paddle {
 namespace lite {
 
+namespace {
+// The frozen program compares the data of the inputs not larger than it.
+const size_t kInferShapeCacheMaxDataSize = 128;
+}  // namespace
+
+std::vector<char> OpLite::InferShapeCacheData(const Tensor *x) {
+  bool is_host = x->target() == TARGET(kHost) ||
+                 x->target() == TARGET(kARM) || x->target() == TARGET(kX86);
+  if (!is_host || !x->IsInitialized() ||
+      x->memory_size() > kInferShapeCacheMaxDataSize) {
+    return {};
+  }
+  const char *data = static_cast<const char *>(x->raw_data());
+  return std::vector<char>(data, data + x->memory_size());
+}
+
+void OpLite::PrepareInferShapeCache() {
+  infer_shape_cache_prepared_ = true;
+  if (!InferShapeWithCache() || ShapeDependsOnInputData() || !scope_ ||
+      !op_info_) {
+    return;
+  }
+  std::vector<const Tensor *> inputs;
+  std::vector<Tensor *> outputs;
+  for (auto &name : op_info_->input_names()) {
+    auto *var = scope_->FindVar(name);
+    if (!var) continue;
+    if (!var->IsType<Tensor>()) return;
+    inputs.push_back(var->GetMutable<Tensor>());
+  }
+  for (auto &name : op_info_->output_names()) {
+    auto *var = scope_->FindVar(name);
+    if (!var) continue;
+    if (!var->IsType<Tensor>()) return;
+    outputs.push_back(var->GetMutable<Tensor>());
+  }
+  input_tensor_ptrs_cache_ = std::move(inputs);
+  output_tensor_ptrs_cache_ = std::move(outputs);
+  infer_shape_cache_ = true;
+}
+
+bool OpLite::ReuseInferredShapes() {
+  if (!shapes_cached_) return false;
+  for (size_t i = 0; i < output_tensor_ptrs_cache_.size(); i++) {
+    output_tensor_ptrs_cache_[i]->Resize(last_output_shapes_[i]);
+    output_tensor_ptrs_cache_[i]->set_lod(last_output_lods_[i]);
+  }
+  return true;
+}
+
 bool OpLite::InferShape() {
+  if (!infer_shape_cache_prepared_) PrepareInferShapeCache();
   auto UseCache = [&, this]() -> bool {
-    if (last_input_shapes_.empty()) {
-      return false;
-    }
-    if (last_input_shapes_.size() == input_tensor_ptrs_cache_.size()) {
-      for (size_t i = 0; i < input_tensor_ptrs_cache_.size(); i++) {
-        if (last_input_shapes_[i] != input_tensor_ptrs_cache_[i]->dims() ||
-            last_input_lods_[i] != input_tensor_ptrs_cache_[i]->lod()) {
-          return false;
-        }
+    if (!shapes_cached_) return false;
+    for (size_t i = 0; i < input_tensor_ptrs_cache_.size(); i++) {
+      const auto *input = input_tensor_ptrs_cache_[i];
+      if (last_input_shapes_[i] != input->dims() ||
+          last_input_lods_[i] != input->lod()) {
+        return false;
       }
-      return true;
     }
-    return false;
+    return true;
   };
-  if (InferShapeWithCache() && UseCache()) {
-    for (size_t i = 0; i < output_tensor_ptrs_cache_.size(); i++) {
-      output_tensor_ptrs_cache_[i]->Resize(last_output_shapes_[i]);
-      output_tensor_ptrs_cache_[i]->set_lod(last_output_lods_[i]);
-    }
+  if (!infer_shape_cache_) {
+    this->InferShapeImpl();
+  } else if (UseCache()) {
+    RuntimeStats::Global().infer_shape_cache.Record(true);
+    ReuseInferredShapes();
   } else {
+    RuntimeStats::Global().infer_shape_cache.Record(false);
+    // The inputs are recorded before inferring, which may resize the inputs
+    // shared with the outputs.
+    size_t num_inputs = input_tensor_ptrs_cache_.size();
+    last_input_shapes_.resize(num_inputs);
+    last_input_lods_.resize(num_inputs);
+    for (size_t i = 0; i < num_inputs; i++) {
+      const auto *input = input_tensor_ptrs_cache_[i];
+      last_input_shapes_[i] = input->dims();
+      last_input_lods_[i] = input->lod();
+    }
     this->InferShapeImpl();
-    if (InferShapeWithCache()) {
-      last_output_shapes_.clear();
-      last_output_lods_.clear();
-      for (size_t i = 0; i < output_tensor_ptrs_cache_.size(); i++) {
-        last_output_shapes_.push_back(output_tensor_ptrs_cache_[i]->dims());
-        last_output_lods_.push_back(output_tensor_ptrs_cache_[i]->lod());
-      }
-      last_input_shapes_.clear();
-      last_input_lods_.clear();
-      for (size_t i = 0; i < input_tensor_ptrs_cache_.size(); i++) {
-        last_input_shapes_.push_back(input_tensor_ptrs_cache_[i]->dims());
-        last_input_lods_.push_back(input_tensor_ptrs_cache_[i]->lod());
-      }
+    size_t num_outputs = output_tensor_ptrs_cache_.size();
+    last_output_shapes_.resize(num_outputs);
+    last_output_lods_.resize(num_outputs);
+    for (size_t i = 0; i < num_outputs; i++) {
+      last_output_shapes_[i] = output_tensor_ptrs_cache_[i]->dims();
+      last_output_lods_[i] = output_tensor_ptrs_cache_[i]->lod();
     }
+    shapes_cached_ = true;
   }
   return true;
 }
@@ -70,6 +123,7 @@ std::vector<std::unique_ptr<KernelBase>> OpLite::CreateKernels(
   CHECK(!op_type_.empty()) << "op_type_ should be set first";
 
   auto pick_kernel = [&](const Place &place) {
+    uint64_t start = MonotonicNanos();
     auto ks = KernelRegistry::Global().Create(
         op_type_, place.target, place.precision, place.layout);
     VLOG(5) << "pick kernel for " << op_info()->Type() << " "
@@ -78,6 +132,7 @@ std::vector<std::unique_ptr<KernelBase>> OpLite::CreateKernels(
       AttachKernel(it.get());
       kernels.emplace_back(std::move(it));
     }
+    ThreadBuildStats::Current().create_kernels_ns += MonotonicNanos() - start;
   };
 
   if (!kernel_type.empty()) {
@@ -127,6 +182,10 @@ bool OpLite::Attach(const cpp::OpDesc &opdesc, lite::Scope *scope) {
   scope_ = scope;
   op_info_.reset(
       new OpInfo(opdesc));  // Force clean the out-of-date infomation.
+  // The tensors may be changed, which are collected again by InferShape.
+  infer_shape_cache_prepared_ = false;
+  infer_shape_cache_ = false;
+  shapes_cached_ = false;
   return AttachImpl(*op_info(), scope);
 }
 
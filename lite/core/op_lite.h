@@ -68,6 +68,12 @@ class OpLite : public Registry {
   // Inference the outputs' shape.
   virtual bool InferShapeImpl() const { return true; }
   virtual bool InferShape();
+  // Resize the outputs to the shapes cached by the last InferShape, returns
+  // false if nothing is cached.
+  bool ReuseInferredShapes();
+  // The data of the small host tensor compared by the frozen program, or
+  // empty if it is too large to compare.
+  static std::vector<char> InferShapeCacheData(const Tensor *x);
   // Infer the outputs's data type during opt period
   virtual bool InferType() {
     LOG(FATAL) << "Error! " << op_type_
@@ -135,7 +141,15 @@ class OpLite : public Registry {
   // Attach it with the runtime environment.
   virtual bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) = 0;
 
-  virtual bool InferShapeWithCache() const { return false; }
+  // Whether InferShape reuses the output shapes of the last run if the dims
+  // and LoDs of all the inputs are not changed. The ops whose shapes depend on
+  // anything else should disable it. It is also disabled for the ops with the
+  // non-tensor arguments.
+  virtual bool InferShapeWithCache() const { return true; }
+  // Whether InferShapeImpl reads the data of any input, e.g. the ShapeTensor
+  // of reshape, which disables the shape cache. Every op reading the data
+  // must declare it, the data is never compared by the cache.
+  virtual bool ShapeDependsOnInputData() const { return false; }
   // Specify the kernel to run by default. This will specify the value of
   // `kernel_place_`.
   virtual void StaticPickKernel(const std::vector<Place> &valid_targets) {
@@ -178,19 +192,21 @@ class OpLite : public Registry {
   std::vector<Place> valid_places_;
   Place kernel_place_{TARGET(kHost), PRECISION(kFloat)};
   std::unique_ptr<OpInfo> op_info_;
-  // Infer Shape according to memory, if current input shapes are consistent
-  // with that of previous inputs, output shapes of last time will be reused.
-  std::vector<const Tensor *> input_tensor_ptrs_cache_{};
-  std::vector<Tensor *> output_tensor_ptrs_cache_{};
 
  private:
-  // todo: it's prefered to combine last_input_shapes and
-  // last_input_lods into a single hash value to decrease
-  // memory usage.
+  // Collect the input and output tensors compared and resized by the shape
+  // cache on the first InferShape after attached.
+  void PrepareInferShapeCache();
+
+  std::vector<const Tensor *> input_tensor_ptrs_cache_{};
+  std::vector<Tensor *> output_tensor_ptrs_cache_{};
   std::vector<DDimLite> last_input_shapes_{};
   std::vector<LoD> last_input_lods_{};
   std::vector<DDimLite> last_output_shapes_{};
   std::vector<LoD> last_output_lods_{};
+  bool infer_shape_cache_prepared_{false};
+  bool infer_shape_cache_{false};
+  bool shapes_cached_{false};
 };
 
 /*
@@ -14,11 +14,240 @@
 
 #include "lite/core/op_lite.h"
 #include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/op_registry.h"
 
 namespace paddle {
 namespace lite {
 
 TEST(OpLite, test) {}
 
+// Out has the dims of X, and Y[0] rows if Y is given.
+class InferShapeCountOp : public OpLite {
+ public:
+  InferShapeCountOp() : OpLite("infer_shape_count") {}
+
+  bool InferShapeImpl() const override {
+    count++;
+    auto dims = x_->dims().Vectorize();
+    if (y_) dims[0] = y_->data<int>()[0];
+    out_->Resize(dims);
+    return true;
+  }
+
+  bool AttachImpl(const cpp::OpDesc& op_desc, Scope* scope) override {
+    x_ = scope->FindTensor(op_desc.Input("X").front());
+    if (!op_desc.Input("Y").empty()) {
+      y_ = scope->FindTensor(op_desc.Input("Y").front());
+    }
+    out_ = scope->FindMutableTensor(op_desc.Output("Out").front());
+    return true;
+  }
+
+  void AttachKernel(KernelBase* kernel) override {}
+
+  std::string DebugString() const override { return "infer_shape_count"; }
+
+  bool InferShapeWithCache() const override { return with_cache; }
+
+  bool ShapeDependsOnInputData() const override { return y_ != nullptr; }
+
+  mutable int count{0};
+  bool with_cache{true};
+
+ private:
+  const Tensor* x_{};
+  const Tensor* y_{};
+  Tensor* out_{};
+};
+
+TEST(OpLite, infer_shape_cache) {
+  Scope scope;
+  auto* x = scope.Var("x")->GetMutable<Tensor>();
+  auto* out = scope.Var("out")->GetMutable<Tensor>();
+  x->Resize({2, 3});
+  cpp::OpDesc op_desc;
+  op_desc.SetType("infer_shape_count");
+  op_desc.SetInput("X", {"x"});
+  op_desc.SetInput("Y", {});
+  op_desc.SetOutput("Out", {"out"});
+  InferShapeCountOp op;
+  op.Attach(op_desc, &scope);
+  op.InferShape();
+  op.InferShape();
+  EXPECT_EQ(op.count, 1);
+  EXPECT_EQ(out->dims(), DDim(std::vector<int64_t>({2, 3})));
+  // The output reused by the others is resized back.
+  out->Resize({7});
+  op.InferShape();
+  EXPECT_EQ(op.count, 1);
+  EXPECT_EQ(out->dims(), DDim(std::vector<int64_t>({2, 3})));
+  // The data is not compared.
+  x->mutable_data<float>()[0] = 1.f;
+  op.InferShape();
+  EXPECT_EQ(op.count, 1);
+  x->Resize({2, 6});
+  op.InferShape();
+  EXPECT_EQ(op.count, 2);
+  EXPECT_EQ(out->dims(), DDim(std::vector<int64_t>({2, 6})));
+  LoD lod{{0, 1, 2}};
+  x->set_lod(lod);
+  op.InferShape();
+  EXPECT_EQ(op.count, 3);
+}
+
+TEST(OpLite, infer_shape_from_input_data) {
+  Scope scope;
+  auto* x = scope.Var("x")->GetMutable<Tensor>();
+  auto* y = scope.Var("y")->GetMutable<Tensor>();
+  auto* out = scope.Var("out")->GetMutable<Tensor>();
+  x->Resize({2, 3});
+  // Any size of the data, the small tensors are not special.
+  for (int64_t y_size : {1, 64}) {
+    y->Resize({y_size});
+    auto* y_data = y->mutable_data<int>();
+    cpp::OpDesc op_desc;
+    op_desc.SetType("infer_shape_count");
+    op_desc.SetInput("X", {"x"});
+    op_desc.SetInput("Y", {"y"});
+    op_desc.SetOutput("Out", {"out"});
+    InferShapeCountOp op;
+    op.Attach(op_desc, &scope);
+    for (int rows : {4, 4, 5}) {
+      y_data[0] = rows;
+      op.InferShape();
+      EXPECT_EQ(out->dims(), DDim(std::vector<int64_t>({rows, 3})));
+    }
+    EXPECT_EQ(op.count, 3);
+    EXPECT_FALSE(op.ReuseInferredShapes());
+  }
+}
+
+// The registered ops reading the data of the inputs in InferShapeImpl.
+TEST(OpLite, infer_shape_of_data_reading_ops) {
+  Scope scope;
+  scope.Var("x")->GetMutable<Tensor>()->Resize({2, 3, 4});
+  auto* shape = scope.Var("shape")->GetMutable<Tensor>();
+  shape->Resize({2});
+  auto* reshape_out = scope.Var("reshape_out")->GetMutable<Tensor>();
+  scope.Var("xshape")->GetMutable<Tensor>();
+  cpp::OpDesc reshape_desc;
+  reshape_desc.SetType("reshape2");
+  reshape_desc.SetInput("X", {"x"});
+  reshape_desc.SetInput("Shape", {"shape"});
+  reshape_desc.SetOutput("Out", {"reshape_out"});
+  reshape_desc.SetOutput("XShape", {"xshape"});
+  auto reshape = LiteOpRegistry::Global().Create("reshape2");
+  ASSERT_TRUE(reshape);
+  reshape->Attach(reshape_desc, &scope);
+
+  auto* start = scope.Var("start")->GetMutable<Tensor>();
+  auto* end = scope.Var("end")->GetMutable<Tensor>();
+  auto* step = scope.Var("step")->GetMutable<Tensor>();
+  for (auto* t : {start, end, step}) t->Resize({1});
+  start->mutable_data<float>()[0] = 0.f;
+  step->mutable_data<float>()[0] = 1.f;
+  auto* range_out = scope.Var("range_out")->GetMutable<Tensor>();
+  cpp::OpDesc range_desc;
+  range_desc.SetType("range");
+  range_desc.SetInput("Start", {"start"});
+  range_desc.SetInput("End", {"end"});
+  range_desc.SetInput("Step", {"step"});
+  range_desc.SetOutput("Out", {"range_out"});
+  auto range = LiteOpRegistry::Global().Create("range");
+  ASSERT_TRUE(range);
+  range->Attach(range_desc, &scope);
+
+  for (int rows : {4, 6, 3}) {
+    auto* shape_data = shape->mutable_data<int>();
+    shape_data[0] = rows;
+    shape_data[1] = 24 / rows;
+    ASSERT_TRUE(reshape->InferShape());
+    EXPECT_EQ(reshape_out->dims(),
+              DDim(std::vector<int64_t>({rows, 24 / rows})));
+    end->mutable_data<float>()[0] = static_cast<float>(rows);
+    ASSERT_TRUE(range->InferShape());
+    EXPECT_EQ(range_out->dims(), DDim(std::vector<int64_t>({rows})));
+  }
+}
+
+TEST(OpLite, infer_shape_without_cache) {
+  Scope scope;
+  auto* x = scope.Var("x")->GetMutable<Tensor>();
+  scope.Var("out")->GetMutable<Tensor>();
+  x->Resize({2, 3});
+  cpp::OpDesc op_desc;
+  op_desc.SetType("infer_shape_count");
+  op_desc.SetInput("X", {"x"});
+  op_desc.SetInput("Y", {});
+  op_desc.SetOutput("Out", {"out"});
+  InferShapeCountOp op;
+  op.with_cache = false;
+  op.Attach(op_desc, &scope);
+  op.InferShape();
+  op.InferShape();
+  EXPECT_EQ(op.count, 2);
+  EXPECT_FALSE(op.ReuseInferredShapes());
+}
+
+TEST(OpLite, reuse_inferred_shapes) {
+  Scope scope;
+  auto* x = scope.Var("x")->GetMutable<Tensor>();
+  scope.Var("y")->GetMutable<Tensor>();
+  auto* out = scope.Var("out")->GetMutable<Tensor>();
+  x->Resize({2, 3});
+  cpp::OpDesc op_desc;
+  op_desc.SetType("infer_shape_count");
+  op_desc.SetInput("X", {"x"});
+  op_desc.SetInput("Y", {});
+  op_desc.SetOutput("Out", {"out"});
+  InferShapeCountOp op;
+  op.Attach(op_desc, &scope);
+  EXPECT_FALSE(op.ReuseInferredShapes());
+  op.InferShape();
+  // Reused without checking the inputs.
+  x->Resize({4, 4});
+  out->Resize({7});
+  EXPECT_TRUE(op.ReuseInferredShapes());
+  EXPECT_EQ(op.count, 1);
+  EXPECT_EQ(out->dims(), DDim(std::vector<int64_t>({2, 3})));
+}
+
+struct CountedAttrs {
+  int k{0};
+
+  static CountedAttrs Decode(const cpp::OpDesc& op_desc) {
+    decode_count++;
+    CountedAttrs attrs;
+    attrs.k = op_desc.GetAttr<int>("k");
+    return attrs;
+  }
+
+  static int decode_count;
+};
+
+int CountedAttrs::decode_count = 0;
+
+TEST(OpLite, decoded_attrs) {
+  cpp::OpDesc op_desc;
+  op_desc.SetType("decoded");
+  op_desc.SetAttr<int>("k", 3);
+  EXPECT_EQ(op_desc.DecodedAttrs<CountedAttrs>().k, 3);
+  // The copies share the decoded attributes.
+  OpInfo op_info(op_desc);
+  cpp::OpDesc op_desc_copy(op_info);
+  EXPECT_EQ(op_info.DecodedAttrs<CountedAttrs>().k, 3);
+  EXPECT_EQ(op_desc_copy.DecodedAttrs<CountedAttrs>().k, 3);
+  EXPECT_EQ(CountedAttrs::decode_count, 1);
+  // A modified copy decodes again, the others keep theirs.
+  op_desc_copy.SetAttr<int>("k", 5);
+  EXPECT_EQ(op_desc_copy.DecodedAttrs<CountedAttrs>().k, 5);
+  EXPECT_EQ(op_desc.DecodedAttrs<CountedAttrs>().k, 3);
+  EXPECT_EQ(op_info.DecodedAttrs<CountedAttrs>().k, 3);
+  EXPECT_EQ(CountedAttrs::decode_count, 2);
+}
+
 }  // namespace lite
 }  // namespace paddle
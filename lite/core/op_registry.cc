@@ -13,9 +13,81 @@
 // limitations under the License.
 
 #include "lite/core/op_registry.h"
+#include <algorithm>
+#include <cstring>
 #include <list>
 #include <set>
 
 namespace paddle {
-namespace lite {}  // namespace lite
+namespace lite {
+
+const KernelRegistrar* KernelRegistrar::pending_ = nullptr;
+
+void KernelFactory::AddRegistrar(const KernelRegistrar* registrar) {
+  auto key = std::make_tuple(
+      registrar->target_, registrar->precision_, registrar->layout_);
+  op_registry_[registrar->op_type_][key].push_back(registrar->creator_);
+}
+
+void KernelFactory::TakeRegistrars(const std::string& op_type) {
+  if (KernelRegistrar::pending_) {
+    // The registrars are linked in the reverse order of registration.
+    size_t begin = registrars_.size();
+    for (auto* it = KernelRegistrar::pending_; it; it = it->next_) {
+      registrars_.push_back(it);
+    }
+    KernelRegistrar::pending_ = nullptr;
+    std::reverse(registrars_.begin() + begin, registrars_.end());
+    std::stable_sort(registrars_.begin(),
+                     registrars_.end(),
+                     [](const KernelRegistrar* a, const KernelRegistrar* b) {
+                       return std::strcmp(a->op_type_, b->op_type_) < 0;
+                     });
+  }
+  auto begin = std::lower_bound(
+      registrars_.begin(),
+      registrars_.end(),
+      op_type.c_str(),
+      [](const KernelRegistrar* registrar, const char* type) {
+        return std::strcmp(registrar->op_type_, type) < 0;
+      });
+  auto end = begin;
+  while (end != registrars_.end() &&
+         std::strcmp((*end)->op_type_, op_type.c_str()) == 0) {
+    AddRegistrar(*end++);
+  }
+  registrars_.erase(begin, end);
+}
+
+void KernelFactory::TakeRegistrars() {
+  TakeRegistrars("");
+  for (auto* registrar : registrars_) {
+    AddRegistrar(registrar);
+  }
+  registrars_.clear();
+}
+
+StaticKernelTable& StaticKernelTable::Global() {
+  static StaticKernelTable* x = new StaticKernelTable;
+  return *x;
+}
+
+std::unique_ptr<KernelBase> StaticKernelTable::Create(
+    const std::string& op_type,
+    const std::string& alias,
+    const Place& place) const {
+  if (size_ == 0) return nullptr;
+  std::string key = op_type + "," + TargetRepr(place.target) + "," +
+                    PrecisionRepr(place.precision) + "," +
+                    DataLayoutRepr(place.layout) + "," + alias;
+  auto end = entries_ + size_;
+  auto it = std::lower_bound(
+      entries_, end, key.c_str(), [](const Entry& entry, const char* k) {
+        return std::strcmp(entry.key, k) < 0;
+      });
+  if (it == end || std::strcmp(it->key, key.c_str()) != 0) return nullptr;
+  return it->creator();
+}
+
+}  // namespace lite
 }  // namespace paddle
@@ -17,6 +17,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <tuple>
 #include <utility>
@@ -122,6 +123,44 @@ class OpLiteRegistrar {
   void touch() {}
 };
 
+// Register Kernel by initializing a static KernelRegistrar instance. The
+// registrars of the library are only linked into a list at load, while
+// KernelFactory builds the creators of an op on its first lookup, so that the
+// thousands of kernels of a full build cost nothing before a predictor asks
+// for them.
+class KernelRegistrar {
+ public:
+  typedef std::unique_ptr<KernelBase> (*creator_t)();
+
+  KernelRegistrar(const char* op_type,
+                  TargetType target,
+                  PrecisionType precision,
+                  DataLayoutType layout,
+                  creator_t creator)
+      : op_type_(op_type),
+        target_(target),
+        precision_(precision),
+        layout_(layout),
+        creator_(creator),
+        next_(pending_) {
+    pending_ = this;
+  }
+  // Touch function is used to guarantee registrar was initialized.
+  void touch() {}
+
+ private:
+  friend class KernelFactory;
+
+  const char* op_type_;
+  TargetType target_;
+  PrecisionType precision_;
+  DataLayoutType layout_;
+  creator_t creator_;
+  const KernelRegistrar* next_;
+  // The registrars not taken by KernelFactory yet, constant initialized.
+  static const KernelRegistrar* pending_;
+};
+
 class KernelFactory {
  public:
   // Register a function to create kernels
@@ -130,6 +169,7 @@ class KernelFactory {
                        PrecisionType precision,
                        DataLayoutType layout,
                        std::function<std::unique_ptr<KernelBase>()> fun) {
+    std::lock_guard<std::mutex> lock(mutex_);
     op_registry_[op_type][std::make_tuple(target, precision, layout)].push_back(
         fun);
   }
@@ -143,14 +183,23 @@ class KernelFactory {
    * Create all kernels belongs to an op.
    */
   std::list<std::unique_ptr<KernelBase>> Create(const std::string& op_type) {
-    std::list<std::unique_ptr<KernelBase>> res;
-    if (op_registry_.find(op_type) == op_registry_.end()) return res;
-    auto& kernel_registry = op_registry_[op_type];
-    for (auto it = kernel_registry.begin(); it != kernel_registry.end(); ++it) {
-      for (auto& fun : it->second) {
-        res.emplace_back(fun());
+    std::vector<const creator_fun_t*> creators;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      TakeRegistrars(op_type);
+      auto op_it = op_registry_.find(op_type);
+      if (op_it != op_registry_.end()) {
+        for (auto& item : op_it->second) {
+          for (auto& fun : item.second) {
+            creators.push_back(&fun);
+          }
+        }
       }
     }
+    std::list<std::unique_ptr<KernelBase>> res;
+    for (auto* fun : creators) {
+      res.emplace_back((*fun)());
+    }
     return res;
   }
 
@@ -161,18 +210,31 @@ class KernelFactory {
                                                 TargetType target,
                                                 PrecisionType precision,
                                                 DataLayoutType layout) {
+    std::vector<const creator_fun_t*> creators;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      TakeRegistrars(op_type);
+      auto op_it = op_registry_.find(op_type);
+      if (op_it != op_registry_.end()) {
+        auto key = std::make_tuple(target, precision, layout);
+        auto it = op_it->second.find(key);
+        if (it != op_it->second.end()) {
+          for (auto& fun : it->second) {
+            creators.push_back(&fun);
+          }
+        }
+      }
+    }
     std::list<std::unique_ptr<KernelBase>> res;
-    if (op_registry_.find(op_type) == op_registry_.end()) return res;
-    auto& kernel_registry = op_registry_[op_type];
-    auto it = kernel_registry.find(std::make_tuple(target, precision, layout));
-    if (it == kernel_registry.end()) return res;
-    for (auto& fun : it->second) {
-      res.emplace_back(fun());
+    for (auto* fun : creators) {
+      res.emplace_back((*fun)());
     }
     return res;
   }
 
-  std::string DebugString() const {
+  std::string DebugString() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TakeRegistrars();
     STL::stringstream ss;
     for (const auto& item : op_registry_) {
       ss << " - " << item.first << "\n";
@@ -181,31 +243,71 @@ class KernelFactory {
   }
 
  protected:
+  using creator_fun_t = std::function<std::unique_ptr<KernelBase>()>;
+
+  // Builds the creators of the registrars of `op_type`, the first lookup also
+  // indexes all the pending registrars by op type.
+  void TakeRegistrars(const std::string& op_type);
+  // Builds the creators of all the pending registrars.
+  void TakeRegistrars();
+  void AddRegistrar(const KernelRegistrar* registrar);
+
+  std::mutex mutex_;
+  // The pending registrars sorted by op type, in the order of registration
+  // within an op type.
+  std::vector<const KernelRegistrar*> registrars_;
   // Outer map: op -> a map of kernel.
   // Inner map: kernel -> creator function.
   // Each kernel was represented by a combination of <TargetType, PrecisionType,
   // DataLayoutType>
   std::map<std::string,
            std::map<std::tuple<TargetType, PrecisionType, DataLayoutType>,
-                    std::list<std::function<std::unique_ptr<KernelBase>()>>>>
+                    std::list<creator_fun_t>>>
       op_registry_;
 };
 
 using KernelRegistry = KernelFactory;
 
-// Register Kernel by initializing a static KernelRegistrar instance
-class KernelRegistrar {
+// The kernels of a tailored build are also listed in a table generated from
+// the .tailored_kernels_list of the model by gen_static_kernel_table.py, so a
+// program creates each of its kernels by a binary search of the key instead
+// of creating all the kernels of the place from KernelFactory and picking
+// the alias.
+class StaticKernelTable {
  public:
-  KernelRegistrar(const std::string& op_type,
-                  TargetType target,
-                  PrecisionType precision,
-                  DataLayoutType layout,
-                  std::function<std::unique_ptr<KernelBase>()> fun) {
-    KernelFactory::Global().RegisterCreator(
-        op_type, target, precision, layout, fun);
+  typedef std::unique_ptr<KernelBase> (*creator_t)();
+  struct Entry {
+    // "op_type,target,precision,layout,alias" as in .tailored_kernels_list,
+    // e.g. "conv2d,kARM,kFloat,kNCHW,def"
+    const char* key;
+    creator_t creator;
+  };
+
+  static StaticKernelTable& Global();
+
+  // `entries` must be sorted by key and outlive the table.
+  void Set(const Entry* entries, size_t size) {
+    entries_ = entries;
+    size_ = size;
+  }
+  size_t size() const { return size_; }
+
+  // Returns nullptr if the kernel is not in the table.
+  std::unique_ptr<KernelBase> Create(const std::string& op_type,
+                                     const std::string& alias,
+                                     const Place& place) const;
+
+ private:
+  const Entry* entries_{nullptr};
+  size_t size_{0};
+};
+
+class StaticKernelTableRegistrar {
+ public:
+  StaticKernelTableRegistrar(const StaticKernelTable::Entry* entries,
+                             size_t size) {
+    StaticKernelTable::Global().Set(entries, size);
   }
-  // Touch function is used to guarantee registrar was initialized.
-  void touch() {}
 };
 
 class ParamTypeDummyRegistry {
@@ -265,20 +367,24 @@ class ParamTypeDummyRegistry {
   }
 
 // Register a kernel.
+// The creator function is also referenced by the static kernel table of
+// the tailored build.
 #define REGISTER_LITE_KERNEL(                                                 \
     op_type__, target__, precision__, layout__, KernelClass, alias__)         \
+  std::unique_ptr<paddle::lite::KernelBase>                                   \
+      create_##op_type__##target__##precision__##layout__##alias__() {        \
+    std::unique_ptr<paddle::lite::KernelBase> x(new KernelClass);             \
+    x->set_op_type(#op_type__);                                               \
+    x->set_alias(#alias__);                                                   \
+    return x;                                                                 \
+  }                                                                           \
   static paddle::lite::KernelRegistrar                                        \
       op_type__##target__##precision__##layout__##alias__##_kernel_registry(  \
           #op_type__,                                                         \
           TARGET(target__),                                                   \
           PRECISION(precision__),                                             \
           DATALAYOUT(layout__),                                               \
-          []() {                                                              \
-            std::unique_ptr<KernelClass> x(new KernelClass);                  \
-            x->set_op_type(#op_type__);                                       \
-            x->set_alias(#alias__);                                           \
-            return x;                                                         \
-          });                                                                 \
+          create_##op_type__##target__##precision__##layout__##alias__);      \
   int touch_##op_type__##target__##precision__##layout__##alias__() {         \
     op_type__##target__##precision__##layout__##alias__##_kernel_registry     \
         .touch();                                                             \
@@ -0,0 +1,44 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+/*
+ * Mark the fp32 weights of the ops running the ARM bf16 kernels by the
+ * attribute weight_name_bf16, then the weights are converted to bf16 when
+ * the model is loaded, see LightPredictor::WeightFP32ToBF16.
+ */
+class BF16AttributePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  // The ops and the arguments of their weights used in bf16.
+  std::map<std::string, std::string> bf16_weights_{
+      {"conv2d", "Filter"},
+      {"depthwise_conv2d", "Filter"},
+      {"fc", "W"},
+      {"matmul", "Y"}};
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
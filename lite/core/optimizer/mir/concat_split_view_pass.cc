@@ -0,0 +1,82 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/concat_split_view_pass.h"
+#include <set>
+#include <string>
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// Whether an input of the concat can be turned into a view of the output:
+// it is written by a single kernel on the same target and read by nothing
+// else, so no other op sees it moved into the output.
+static bool IsViewableInput(Node* var_node, TargetType target) {
+  auto& arg = var_node->AsArg();
+  if (arg.is_weight || arg.is_persist) return false;
+  if (var_node->inlinks.size() != 1 || var_node->outlinks.size() != 1) {
+    return false;
+  }
+  auto* producer = var_node->inlinks.front();
+  if (!producer->IsStmt()) return false;
+  auto& inst = producer->AsStmt();
+  // The outputs of the split are views of its input, and the ones of the
+  // inplace ops share the buffer of their inputs.
+  auto op_type = inst.op_type();
+  if (op_type == "feed" || op_type == "split" || op_type == "concat") {
+    return false;
+  }
+  auto* op_info = inst.op_info();
+  if (op_info->HasAttr("inplace") && op_info->GetAttr<bool>("inplace")) {
+    return false;
+  }
+  return !inst.kernels().empty() && inst.picked_kernel().target() == target;
+}
+
+void ConcatSplitViewPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    auto& inst = node->AsStmt();
+    if (inst.kernels().empty()) continue;
+    auto target = inst.picked_kernel().target();
+    auto* op_info = inst.mutable_op_info();
+    if (inst.op_type() == "concat" && target == TARGET(kARM)) {
+      auto x_names = op_info->Input("X");
+      std::set<std::string> names(x_names.begin(), x_names.end());
+      if (names.size() != x_names.size()) continue;
+      bool viewable = true;
+      for (auto* in_node : node->inlinks) {
+        if (!names.count(in_node->AsArg().name)) continue;
+        viewable = viewable && IsViewableInput(in_node, target);
+      }
+      if (!viewable) continue;
+    } else if (inst.op_type() != "split" || target != TARGET(kHost)) {
+      continue;
+    }
+    op_info->SetAttr<bool>("zero_copy", true);
+    VLOG(4) << "Zero copy " << inst.op_type() << " for "
+            << op_info->Output("Out").front();
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(concat_split_view_pass,
+                  paddle::lite::mir::ConcatSplitViewPass)
+    .BindTargets({TARGET(kARM)})
+    .BindKernel("concat");
@@ -0,0 +1,92 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/conv_algorithm_select_pass.h"
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/operators/conv_algorithm.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void ConvAlgorithmSelectPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    auto& inst = node->AsStmt();
+    if (inst.op_type() != "conv2d" && inst.op_type() != "depthwise_conv2d") {
+      continue;
+    }
+    if (inst.kernels().empty()) continue;
+    auto& kernel = inst.picked_kernel();
+    if (kernel.target() != TARGET(kARM)) continue;
+    auto* op_info = inst.mutable_op_info();
+    auto* scope = inst.op()->scope();
+    // The paddings are computed from the input shape at runtime.
+    if (op_info->HasAttr("padding_algorithm") &&
+        op_info->GetAttr<std::string>("padding_algorithm") == "SAME") {
+      continue;
+    }
+    auto* filter_var = scope->FindVar(op_info->Input("Filter").front());
+    if (!filter_var) continue;
+    auto w_dims = filter_var->Get<Tensor>().dims();
+    if (w_dims.size() != 4) continue;
+
+    operators::ConvShape shape;
+    shape.groups = op_info->GetAttr<int>("groups");
+    shape.ic = w_dims[1] * shape.groups;
+    shape.oc = w_dims[0];
+    shape.kh = w_dims[2];
+    shape.kw = w_dims[3];
+    auto* input_var = scope->FindVar(op_info->Input("Input").front());
+    if (input_var) {
+      auto x_dims = input_var->Get<Tensor>().dims();
+      if (x_dims.size() == 4) {
+        shape.hin = x_dims[2];
+        shape.win = x_dims[3];
+      }
+    }
+    shape.strides = op_info->GetAttr<std::vector<int>>("strides");
+    shape.dilations = op_info->GetAttr<std::vector<int>>("dilations");
+    auto paddings = op_info->GetAttr<std::vector<int>>("paddings");
+    if (op_info->HasAttr("padding_algorithm") &&
+        op_info->GetAttr<std::string>("padding_algorithm") == "VALID") {
+      paddings.assign(4, 0);
+    } else if (paddings.size() == 2L) {
+      paddings = {paddings[0], paddings[0], paddings[1], paddings[1]};
+    }
+    if (shape.strides.size() != 2L || shape.dilations.size() != 2L ||
+        paddings.size() != 4L) {
+      continue;
+    }
+    shape.paddings = paddings;
+
+    auto algorithm = operators::SelectArmConvAlgorithm(
+        kernel.precision(), shape, has_dot_);
+    if (algorithm == operators::ConvAlgorithm::kAuto) continue;
+    op_info->SetAttr<std::string>(operators::kConvAlgorithmAttr,
+                                  operators::ConvAlgorithmToStr(algorithm));
+    VLOG(4) << "Select " << operators::ConvAlgorithmToStr(algorithm)
+            << " for " << op_info->Output("Output").front();
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(conv_algorithm_select_pass,
+                  paddle::lite::mir::ConvAlgorithmSelectPass)
+    .BindTargets({TARGET(kARM)});
@@ -0,0 +1,43 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <memory>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * Select the implementations of the ARM conv2d kernels ahead of time, and
+ * record them into the attribute "conv_algorithm" of the ops, so the kernels
+ * skip the selection on the device. The convs whose choice depends on the
+ * unknown input shape are left to be selected at runtime.
+ */
+class ConvAlgorithmSelectPass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+  // Whether the target cpu supports the dot product instructions, which
+  // affects the choice of the int8 convs.
+  void SetTargetHasDot(bool has_dot) { has_dot_ = has_dot; }
+
+ private:
+  bool has_dot_{false};
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
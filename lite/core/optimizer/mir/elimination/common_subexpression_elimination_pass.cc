@@ -0,0 +1,179 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/elimination/common_subexpression_elimination_pass.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+const std::set<std::string> CommonSubexpressionEliminationPass::skipped_ops_ =
+    {"feed",
+     "fetch",
+     "while",
+     "conditional_block",
+     "increment",
+     "print",
+     "subgraph",
+     "uniform_random",
+     "gaussian_random",
+     "randint",
+     "randperm",
+     "sampling_id",
+     "write_to_array",
+     "read_from_array"};
+
+// The type and the inputs of the op, the ops with the same key are compared
+// by the attributes.
+static std::string GenOpKey(const OpInfo& op_info) {
+  std::string key = op_info.Type();
+  auto arg_names = op_info.input_argnames();
+  std::sort(arg_names.begin(), arg_names.end());
+  for (const auto& arg_name : arg_names) {
+    key += ";" + arg_name + ":";
+    for (const auto& var_name : op_info.Input(arg_name)) {
+      key += var_name + ",";
+    }
+  }
+  auto out_arg_names = op_info.output_argnames();
+  std::sort(out_arg_names.begin(), out_arg_names.end());
+  key += "->";
+  for (const auto& arg_name : out_arg_names) {
+    key += arg_name + ":" + std::to_string(op_info.Output(arg_name).size()) +
+           ";";
+  }
+  return key;
+}
+
+static bool AttrsIdentical(const OpInfo& op_info0, const OpInfo& op_info1) {
+  auto attr_types = op_info0.attr_types();
+  if (attr_types != op_info1.attr_types()) return false;
+  for (const auto& pair : attr_types) {
+    const std::string& attr_name = pair.first;
+    switch (pair.second) {
+#define ATTR_COMPARE(attr_type, cpp_type)        \
+  case cpp::OpDesc::AttrType::attr_type:         \
+    if (op_info0.GetAttr<cpp_type>(attr_name) != \
+        op_info1.GetAttr<cpp_type>(attr_name))   \
+      return false;                              \
+    break
+      ATTR_COMPARE(INT, int32_t);
+      ATTR_COMPARE(FLOAT, float);
+      ATTR_COMPARE(STRING, std::string);
+      ATTR_COMPARE(INTS, std::vector<int32_t>);
+      ATTR_COMPARE(FLOATS, std::vector<float>);
+      ATTR_COMPARE(STRINGS, std::vector<std::string>);
+      ATTR_COMPARE(BOOLEAN, bool);
+      ATTR_COMPARE(LONG, int64_t);
+      ATTR_COMPARE(LONGS, std::vector<int64_t>);
+#undef ATTR_COMPARE
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+void CommonSubexpressionEliminationPass::Apply(
+    const std::unique_ptr<SSAGraph>& graph) {
+  // The vars of the block may be read by the ops in the sub-blocks by name,
+  // which are not in the graph.
+  std::map<std::string, int> producer_num;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    if (node->AsStmt().op_info()->HasAttr("sub_block")) {
+      VLOG(4) << "Skip the common subexpression elimination for the block "
+                 "with sub-blocks.";
+      return;
+    }
+    for (auto* out_node : node->outlinks) {
+      producer_num[out_node->AsArg().name]++;
+    }
+  }
+  // Only the outputs written once, which are not weights, are merged.
+  auto mergeable = [&](Node* node) {
+    std::set<std::string> in_names;
+    for (auto* in_node : node->inlinks) {
+      in_names.insert(in_node->AsArg().name);
+    }
+    for (auto* out_node : node->outlinks) {
+      const auto& name = out_node->AsArg().name;
+      if (out_node->AsArg().is_weight || producer_num[name] != 1 ||
+          in_names.count(name)) {
+        return false;
+      }
+    }
+    return !node->outlinks.empty();
+  };
+
+  std::map<std::string, std::vector<Node*>> candidates;
+  int merged_num = 0;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    const auto* op_info = node->AsStmt().op_info();
+    if (skipped_ops_.count(op_info->Type()) || !mergeable(node)) continue;
+    auto& nodes = candidates[GenOpKey(*op_info)];
+    Node* to_keep = nullptr;
+    for (auto* candidate : nodes) {
+      if (AttrsIdentical(*candidate->AsStmt().op_info(), *op_info)) {
+        to_keep = candidate;
+        break;
+      }
+    }
+    if (!to_keep) {
+      nodes.push_back(node);
+      continue;
+    }
+
+    // Redirect the consumers of the outputs to the outputs of `to_keep`.
+    const auto* keep_info = to_keep->AsStmt().op_info();
+    std::set<const Node*> nodes2rm{node};
+    for (const auto& arg_name : op_info->output_argnames()) {
+      auto keep_names = keep_info->Output(arg_name);
+      auto remove_names = op_info->Output(arg_name);
+      for (size_t i = 0; i < remove_names.size(); i++) {
+        auto* keep_node = graph->RetrieveArgument(keep_names[i]);
+        auto* remove_node = graph->RetrieveArgument(remove_names[i]);
+        CHECK(keep_node && remove_node);
+        for (auto* stmt_node : remove_node->outlinks) {
+          auto new_op_info = *stmt_node->AsStmt().op_info();
+          new_op_info.UpdateAllInputs(remove_names[i], keep_names[i]);
+          stmt_node->AsStmt().ResetOp(new_op_info, graph->valid_places());
+          DirectedLink(keep_node, stmt_node);
+        }
+        nodes2rm.insert(remove_node);
+      }
+    }
+    VLOG(4) << "Merge the identical op " << op_info->Type();
+    GraphSafeRemoveNodes(graph.get(), nodes2rm);
+    merged_num++;
+  }
+  VLOG(3) << "Common subexpression elimination merges " << merged_num
+          << " ops.";
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(common_subexpression_elimination_pass,
+                  paddle::lite::mir::CommonSubexpressionEliminationPass)
+    .BindTargets({TARGET(kAny)});
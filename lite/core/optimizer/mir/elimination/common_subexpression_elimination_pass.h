@@ -0,0 +1,44 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * Merge the identical ops, which have the same type, inputs and attributes,
+ * e.g. the shape, slice and cast ops repeated in the exported graphs. The
+ * consumers of the outputs of the merged ops read the outputs of the kept
+ * ones instead.
+ */
+class CommonSubexpressionEliminationPass : public mir::StmtPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  // The ops which are not deterministic or have side effects.
+  static const std::set<std::string> skipped_ops_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
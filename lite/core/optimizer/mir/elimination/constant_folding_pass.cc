@@ -0,0 +1,187 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/elimination/constant_folding_pass.h"
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/context.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+const std::set<std::string> ConstantFoldingPass::skipped_ops_ = {
+    "feed",
+    "fetch",
+    "io_copy",
+    "io_copy_once",
+    "layout",
+    "layout_once",
+    "calib",
+    "calib_once",
+    "while",
+    "conditional_block",
+    "increment",
+    "print",
+    "subgraph",
+    "uniform_random",
+    "gaussian_random",
+    "randint",
+    "randperm",
+    "sampling_id",
+    "write_to_array",
+    "read_from_array"};
+
+// Whether the var is written by the ops other than `node`, the vars written
+// more than once are renamed with "__Mangled_" in SSAGraph.
+static bool HasOtherProducers(SSAGraph* graph,
+                              const Node* node,
+                              const std::string& var_name) {
+  for (auto* op_node : graph->StmtTopologicalOrder()) {
+    if (!op_node->IsStmt() || op_node == node) continue;
+    for (auto* var_node : op_node->outlinks) {
+      const auto& name = var_node->AsArg().name;
+      if (name == var_name ||
+          name.find(var_name + "__Mangled_") != std::string::npos) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static bool IsTensor(Scope* scope, const std::string& var_name) {
+  auto* var = scope->FindVar(var_name);
+  return var && var->IsType<lite::Tensor>();
+}
+
+void ConstantFoldingPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // The vars of the main block may be written by the ops in the sub-blocks,
+  // e.g. the loop counters, which can not be folded.
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (node->IsStmt() && node->AsStmt().op_info()->HasAttr("sub_block")) {
+      VLOG(4) << "Skip constant folding for the block with sub-blocks.";
+      return;
+    }
+  }
+
+  int folded_num = 0;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    auto& stmt = node->AsStmt();
+    const std::string op_type = stmt.op_type();
+    if (skipped_ops_.count(op_type) || node->outlinks.empty()) continue;
+    auto* scope = stmt.op()->scope();
+
+    bool foldable = true;
+    std::set<std::string> in_names;
+    for (auto* in_node : node->inlinks) {
+      const auto& name = in_node->AsArg().name;
+      if (!in_node->AsArg().is_weight || !IsTensor(scope, name) ||
+          !scope->FindVar(name)->Get<lite::Tensor>().persistable()) {
+        foldable = false;
+        break;
+      }
+      in_names.insert(name);
+    }
+    for (auto* out_node : node->outlinks) {
+      if (!foldable) break;
+      const auto& name = out_node->AsArg().name;
+      // the in-place outputs, or the outputs written by the other ops
+      if (out_node->AsArg().is_weight || in_names.count(name) ||
+          !IsTensor(scope, name) ||
+          HasOtherProducers(graph.get(), node, name)) {
+        foldable = false;
+      }
+    }
+    if (!foldable || !RunOnHost(node)) continue;
+
+    std::set<const Node*> nodes2rm;
+    nodes2rm.insert(node);
+    for (auto* in_node : node->inlinks) {
+      if (in_node->outlinks.size() == 1) {
+        nodes2rm.insert(in_node);
+      }
+    }
+    for (auto* out_node : node->outlinks) {
+      scope->FindVar(out_node->AsArg().name)
+          ->GetMutable<lite::Tensor>()
+          ->set_persistable(true);
+      out_node->AsArg().is_weight = true;
+    }
+    VLOG(4) << "Fold the constant op " << op_type;
+    GraphSafeRemoveNodes(graph.get(), nodes2rm);
+    folded_num++;
+  }
+  VLOG(3) << "Constant folding folds " << folded_num << " ops.";
+}
+
+bool ConstantFoldingPass::RunOnHost(Node* node) {
+  auto& stmt = node->AsStmt();
+  auto op = stmt.op();
+  const auto* op_info = stmt.op_info();
+  auto* scope = op->scope();
+
+  std::vector<Place> places{Place{TARGET(kHost), PRECISION(kFloat)},
+                            Place{TARGET(kHost), PRECISION(kInt32)},
+                            Place{TARGET(kHost), PRECISION(kInt64)},
+                            Place{TARGET(kHost), PRECISION(kBool)}};
+#ifdef LITE_WITH_X86
+  places.emplace_back(TARGET(kX86), PRECISION(kFloat));
+  places.emplace_back(TARGET(kX86), PRECISION(kInt32));
+  places.emplace_back(TARGET(kX86), PRECISION(kInt64));
+#endif
+  auto kernels = op->CreateKernels(places);
+
+  // Pick the kernel which accepts the precisions of the inputs.
+  KernelBase* kernel = nullptr;
+  for (auto& candidate : kernels) {
+    bool matched = true;
+    for (const auto& arg_name : op_info->input_argnames()) {
+      const auto* type = ParamTypeRegistry::Global().RetrieveInArgument(
+          candidate->place(), candidate->GenParamTypeKey(), arg_name);
+      if (!type) continue;
+      auto precision = type->type->precision();
+      for (const auto& var_name : op_info->Input(arg_name)) {
+        auto& tensor = scope->FindVar(var_name)->Get<lite::Tensor>();
+        if (precision != PRECISION(kAny) && precision != tensor.precision()) {
+          matched = false;
+        }
+      }
+    }
+    if (matched) {
+      kernel = candidate.get();
+      break;
+    }
+  }
+  if (!kernel) {
+    VLOG(4) << "No host kernel to fold the constant op " << op_info->Type();
+    return false;
+  }
+
+  if (!op->CheckShape() || !op->InferShape()) return false;
+  kernel->SetContext(ContextScheduler::Global().NewContext(kernel->target()));
+  kernel->Launch();
+  return true;
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(constant_folding_pass, paddle::lite::mir::ConstantFoldingPass)
+    .BindTargets({TARGET(kAny)});
@@ -0,0 +1,48 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * Fold the ops whose inputs are all persistable, e.g. the shape computation
+ * and the prior box chains, by running their host kernels in optimization
+ * stage. The outputs of the folded ops become weights, and the inputs which
+ * are not used by the other ops are removed.
+ */
+class ConstantFoldingPass : public mir::StmtPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  // Run the op by one of its host kernels, return false if the op can not be
+  // run on host.
+  bool RunOnHost(Node* node);
+
+  // The ops which are not deterministic or have side effects.
+  static const std::set<std::string> skipped_ops_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
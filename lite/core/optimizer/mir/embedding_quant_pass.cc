@@ -0,0 +1,149 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/embedding_quant_pass.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+const std::vector<std::string> EmbeddingQuantPass::quant_ops = {
+    "lookup_table", "lookup_table_v2"};
+
+// The number of floats of a quantized row of width elements
+static int64_t QuantNumber(int64_t width, int quant_bits) {
+  return 2 + (width * quant_bits + 31) / 32;
+}
+
+static void QuantizeEmbeddingRowWise(Tensor* weight, int quant_bits) {
+  const DDim dims = weight->dims();
+  CHECK_EQ(dims.size(), 2);
+  int64_t row_number = dims[0];
+  int64_t row_width = dims[1];
+  int64_t quant_number = QuantNumber(row_width, quant_bits);
+  const float levels = static_cast<float>((1 << quant_bits) - 1);
+
+  Tensor tmp_tensor;
+  tmp_tensor.CopyDataFrom(*weight);
+  const float* src = tmp_tensor.data<float>();
+  weight->clear();
+  weight->Resize({row_number, quant_number});
+  float* dst = weight->mutable_data<float>();
+  memset(dst, 0, row_number * quant_number * sizeof(float));
+
+  for (int64_t i = 0; i < row_number; i++) {
+    const float* src_row = src + i * row_width;
+    float* dst_row = dst + i * quant_number;
+    auto min_max = std::minmax_element(src_row, src_row + row_width);
+    float min = *min_max.first;
+    float scale = (*min_max.second - min) / levels;
+    dst_row[0] = scale;
+    dst_row[1] = min;
+    uint8_t* codes = reinterpret_cast<uint8_t*>(dst_row + 2);
+    for (int64_t j = 0; j < row_width; j++) {
+      float q = scale > 0.f ? std::round((src_row[j] - min) / scale) : 0.f;
+      uint8_t code = static_cast<uint8_t>(std::min(std::max(q, 0.f), levels));
+      if (quant_bits == 8) {
+        codes[j] = code;
+      } else {
+        codes[j >> 1] |= code << ((j & 1) * 4);
+      }
+    }
+  }
+}
+
+void EmbeddingQuantPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  CHECK(quant_bits_ == 8 || quant_bits_ == 4)
+      << "Not support embedding quant bits: " << quant_bits_;
+
+  std::vector<mir::Node*> nodes;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    const std::string op_type = node->stmt()->op_type();
+    if (std::find(quant_ops.begin(), quant_ops.end(), op_type) !=
+        quant_ops.end()) {
+      nodes.push_back(node);
+    }
+  }
+
+  // the tables shared by several lookups are quantized once
+  std::map<std::string, int64_t> quantized_widths;
+  for (auto* node : nodes) {
+    auto* op_info = node->stmt()->mutable_op_info();
+    auto* scope = node->stmt()->op()->scope();
+    const std::string weight_name = op_info->Input("W").front();
+    if (!quantized_widths.count(weight_name)) {
+      mir::Node* weight_node = nullptr;
+      for (auto* in_node : node->inlinks) {
+        if (in_node->IsArg() && in_node->arg()->name == weight_name) {
+          weight_node = in_node;
+        }
+      }
+      if (!weight_node || !weight_node->arg()->is_weight) continue;
+      // the table must be only read by the lookups, e.g. not tied to a matmul
+      bool only_lookups = true;
+      for (auto* out_node : weight_node->outlinks) {
+        only_lookups &= std::find(quant_ops.begin(),
+                                  quant_ops.end(),
+                                  out_node->stmt()->op_type()) !=
+                        quant_ops.end();
+      }
+      Tensor* weight = scope->FindVar(weight_name)->GetMutable<Tensor>();
+      CHECK(weight) << "Can not find the weight in scope.";
+      if (!only_lookups || weight->precision() != PrecisionType::kFloat ||
+          weight->dims().size() != 2) {
+        LOG(INFO) << "The table is used by other ops or not a 2-D fp32 "
+                  << "tensor, so skip quantizing the weight of "
+                  << weight_name;
+        continue;
+      }
+      quantized_widths[weight_name] = weight->dims()[1];
+      QuantizeEmbeddingRowWise(weight, quant_bits_);
+    }
+
+    cpp::OpDesc op_desc = *op_info;
+    op_desc.SetType("lookup_table_dequant");
+    op_desc.SetAttr<int>("quant_bits", quant_bits_);
+    op_desc.SetAttr<int64_t>("row_width", quantized_widths[weight_name]);
+    // lookup_table_v2 appends the width to the shape of Ids
+    op_desc.SetAttr<bool>("append_width",
+                          op_info->Type() == "lookup_table_v2");
+    if (!op_desc.HasAttr("padding_idx")) {
+      op_desc.SetAttr<int64_t>("padding_idx", -1);
+    }
+    auto new_op = LiteOpRegistry::Global().Create("lookup_table_dequant");
+    CHECK(new_op) << "No op found for lookup_table_dequant";
+    new_op->Attach(op_desc, scope);
+    new_op->SetValidPlaces(node->stmt()->op()->valid_places());
+    auto kernels = new_op->CreateKernels(new_op->valid_places());
+    node->stmt()->SetOp(new_op);
+    node->stmt()->SetKernels(std::move(kernels));
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(embedding_quant_pass, paddle::lite::mir::EmbeddingQuantPass)
+    .BindTargets({TARGET(kARM), TARGET(kX86)});
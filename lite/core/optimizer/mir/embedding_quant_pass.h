@@ -0,0 +1,47 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+/*
+ * Store the fp32 weights of lookup_table and lookup_table_v2 row-wise in
+ * 8 or 4 bits, and convert the ops into lookup_table_dequant, which
+ * dequantizes the gathered rows on the fly. Each row of the quantized table
+ * is [scale, bias, codes], value = scale * code + bias, and the unsigned
+ * codes are packed into the floats following the scale and bias. So the
+ * size of the table is reduced about 4x/8x in both the model and the memory.
+ */
+class EmbeddingQuantPass : public ProgramPass {
+ public:
+  static const std::vector<std::string> quant_ops;
+
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+  void SetQuantBits(int quant_bits) { quant_bits_ = quant_bits; }
+
+ private:
+  int quant_bits_{8};
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -30,6 +30,12 @@ void FP16AttributePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
     if (node->IsStmt()) {
       const std::string op_type = node->stmt()->op_type();
       auto iter = std::find(fp16_ops_.begin(), fp16_ops_.end(), op_type);
+      const OpInfo* op_info = node->stmt()->op_info();
+      // mixed_precision_pass keeps the op in fp32
+      if (op_info->HasAttr("mixed_precision") &&
+          op_info->GetAttr<std::string>("mixed_precision") == "fp32") {
+        continue;
+      }
       if (iter != fp16_ops_.end()) {
         nodes.push_back(node);
       }
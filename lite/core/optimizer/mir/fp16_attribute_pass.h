@@ -48,7 +48,9 @@ class FP16AttributePass : public ProgramPass {
                                      "matmul",
                                      "mul",
                                      "matmul_v2",
-                                     "prelu"};
+                                     "prelu",
+                                     "sparse_conv2d",
+                                     "sparse_fc"};
 };
 
 }  // namespace mir
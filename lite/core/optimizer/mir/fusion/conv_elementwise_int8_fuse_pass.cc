@@ -0,0 +1,62 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/conv_elementwise_int8_fuse_pass.h"
+#include <memory>
+#include <vector>
+#include "lite/core/optimizer/mir/fusion/conv_elementwise_int8_fuser.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void ConvElementwiseInt8FusePass::Apply(
+    const std::unique_ptr<SSAGraph>& graph) {
+  bool has_int8 = false;
+  for (auto& place : graph->valid_places()) {
+    if (place.target == TARGET(kARM) && place.precision == PRECISION(kInt8)) {
+      has_int8 = true;
+    }
+  }
+  if (!has_int8) return;
+
+  // The relu of the add is fused into fusion_elementwise_add_activation.
+  std::vector<std::string> elementwise_type_cases{
+      "elementwise_add", "fusion_elementwise_add_activation"};
+  std::vector<std::string> act_type_cases{"relu6", "hard_swish", ""};
+  for (auto conv_has_bias : {true, false}) {
+    for (auto conv_output_is_x : {false, true}) {
+      for (auto& elementwise_type : elementwise_type_cases) {
+        for (auto& act_type : act_type_cases) {
+          if (elementwise_type != "elementwise_add" && !act_type.empty()) {
+            continue;
+          }
+          fusion::ConvElementwiseInt8Fuser fuser(
+              conv_has_bias, elementwise_type, act_type, conv_output_is_x);
+          fuser.apply_impl(graph.get());
+        }
+      }
+    }
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_conv_elementwise_int8_fuse_pass,
+                  paddle::lite::mir::ConvElementwiseInt8FusePass)
+    .BindTargets({TARGET(kARM)})
+    .BindKernel("conv2d");
@@ -0,0 +1,62 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// This pass fuses the quantized conv2d, the following elementwise_add of the
+// residual and the optional activation into the int8 conv2d, which adds the
+// int8 residual and applies the activation before requantizing the output.
+// It removes the int8 to fp32 calib ops of the add and the fp32 tensors
+// between them.
+//
+// For example:
+//
+//       |                          |
+//       A                     conv2d(int8)
+//       |                          |
+//       ----- elementwise_add -----
+//                  |
+//          relu6 / hard_swish
+//                  |
+//                  V
+//
+// After the pass is applied:
+//
+//       |                          |
+//       A                          |
+//       |                          |
+//       ------- conv2d(int8) ------
+//                    |
+//                    V
+//
+// Limitations:
+// * The conv2d has no fused activation, and is not a depthwise conv.
+// * The residual A has the same dims as the conv output and its own scale.
+// * The activation is relu, relu6 or hard_swish.
+class ConvElementwiseInt8FusePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
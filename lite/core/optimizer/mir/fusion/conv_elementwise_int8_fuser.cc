@@ -0,0 +1,234 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/conv_elementwise_int8_fuser.h"
+#include <memory>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+void ConvElementwiseInt8Fuser::BuildPattern() {
+  // create input nodes.
+  auto* conv_input =
+      VarNode("conv_input")->assert_is_op_input("conv2d", "Input")->AsInput();
+  auto* conv_filter = VarNode("conv_filter")
+                          ->assert_is_persistable_var()
+                          ->assert_is_op_input("conv2d", "Filter")
+                          ->AsInput();
+  const std::string conv_output_arg = conv_output_is_x_ ? "X" : "Y";
+  const std::string elementwise_input_arg = conv_output_is_x_ ? "Y" : "X";
+  auto* elementwise_input =
+      VarNode("elementwise_input")
+          ->assert_is_op_input(elementwise_type_, elementwise_input_arg)
+          ->AsInput();
+
+  // create intermediate nodes
+  auto* conv_output =
+      VarNode("conv_output")
+          ->assert_is_op_output("conv2d", "Output")
+          ->assert_is_op_input(elementwise_type_, conv_output_arg)
+          ->assert_only_one_output()
+          ->AsIntermediate();
+
+  // create op nodes
+  // The quantized conv without the fused activation and elementwise, whose
+  // activation would be applied before the add.
+  auto conv_teller = [](const Node* node) -> bool {
+    auto* op_info = const_cast<Node*>(node)->AsStmt().op_info();
+    bool enable_int8 = op_info->HasAttr("enable_int8") &&
+                       op_info->GetAttr<bool>("enable_int8");
+    bool with_act =
+        op_info->HasAttr("with_act") && op_info->GetAttr<bool>("with_act");
+    return enable_int8 && !with_act &&
+           !op_info->HasAttr("fuse_elementwise_op_type");
+  };
+  // The activation of the elementwise can not be followed by another one.
+  bool has_act_op = !act_type_.empty();
+  auto elementwise_teller = [has_act_op](const Node* node) -> bool {
+    auto* op_info = const_cast<Node*>(node)->AsStmt().op_info();
+    bool enable_int8 = op_info->HasAttr("enable_int8") &&
+                       op_info->GetAttr<bool>("enable_int8");
+    int axis = op_info->GetAttr<int>("axis");
+    std::string act_type{""};
+    if (op_info->HasAttr("act_type")) {
+      act_type = op_info->GetAttr<std::string>("act_type");
+    }
+    return enable_int8 && axis == -1 && !op_info->HasAttr("fuse_scale") &&
+           (act_type.empty() || (!has_act_op && act_type == "relu"));
+  };
+
+  auto* conv = OpNode("conv", "conv2d")
+                   ->assert_is_op("conv2d")
+                   ->assert_node_satisfied(conv_teller)
+                   ->AsIntermediate();
+  auto* elementwise = OpNode("elementwise", elementwise_type_)
+                          ->assert_is_op(elementwise_type_)
+                          ->assert_node_satisfied(elementwise_teller)
+                          ->AsIntermediate();
+
+  // create output node
+  auto* elementwise_output =
+      VarNode("elementwise_output")
+          ->assert_is_op_output(elementwise_type_, "Out");
+
+  // create topology.
+  std::vector<PMNode*> conv_inputs{conv_input, conv_filter};
+  if (conv_has_bias_) {
+    auto* conv_bias = VarNode("conv_bias")
+                          ->assert_is_op_input("conv2d", "Bias")
+                          ->assert_is_persistable_var()
+                          ->AsInput();
+    conv_inputs.push_back(conv_bias);
+  }
+  conv->LinksFrom(conv_inputs).LinksTo({conv_output});
+  elementwise->LinksFrom({elementwise_input, conv_output})
+      .LinksTo({elementwise_output});
+  if (act_type_.empty()) {
+    elementwise_output->AsOutput();
+    return;
+  }
+  elementwise_output->assert_is_op_input(act_type_, "X")
+      ->assert_only_one_output()
+      ->AsIntermediate();
+  auto* act =
+      OpNode("act", act_type_)->assert_is_op(act_type_)->AsIntermediate();
+  auto* act_output =
+      VarNode("act_output")->assert_is_op_output(act_type_, "Out")->AsOutput();
+  elementwise_output->LinksTo({act});
+  act->LinksTo({act_output});
+}
+
+void ConvElementwiseInt8Fuser::InsertNewNode(SSAGraph* graph,
+                                             const key2nodes_t& matched) {
+  auto conv_op_old = matched.at("conv")->stmt()->op();
+  auto* scope = conv_op_old->scope();
+  auto* conv_op_info = matched.at("conv")->stmt()->op_info();
+  auto* elementwise_op_info = matched.at("elementwise")->stmt()->op_info();
+  auto& residual_name = matched.at("elementwise_input")->arg()->name;
+  auto& conv_input_name = matched.at("conv_input")->arg()->name;
+  // The residual is added in int8, and must not be the input of the conv
+  // sharing the scale attribute.
+  if (residual_name == conv_input_name ||
+      !elementwise_op_info->HasInputScale(residual_name)) {
+    VLOG(4) << "The residual " << residual_name
+            << " is not quantized separately. Skip this pass!";
+    return;
+  }
+
+  // The residual is read at the output position of the conv, so it must not
+  // be broadcasted.
+  auto* conv_output_var =
+      scope->FindVar(matched.at("conv_output")->arg()->name);
+  auto* residual_var = scope->FindVar(residual_name);
+  if (conv_output_var == nullptr || residual_var == nullptr ||
+      conv_output_var->Get<Tensor>().dims() !=
+          residual_var->Get<Tensor>().dims()) {
+    VLOG(4) << "The residual " << residual_name
+            << " is broadcasted to the conv output. Skip this pass!";
+    return;
+  }
+
+  // The depthwise conv runs by the gemm-like conv if fused, which is slower
+  // than the unfused one.
+  auto* filter_var = scope->FindVar(conv_op_info->Input("Filter").front());
+  auto w_dims = filter_var->Get<Tensor>().dims();
+  int groups = conv_op_info->HasAttr("groups")
+                   ? conv_op_info->GetAttr<int>("groups")
+                   : 1;
+  if (groups > 1 && w_dims[1] == 1) {
+    VLOG(4) << "The depthwise conv is not fused. Skip this pass!";
+    return;
+  }
+
+  nodes2rm_.insert(matched.at("conv"));
+  nodes2rm_.insert(matched.at("conv_output"));
+  nodes2rm_.insert(matched.at("elementwise"));
+  if (!act_type_.empty()) {
+    nodes2rm_.insert(matched.at("elementwise_output"));
+    nodes2rm_.insert(matched.at("act"));
+  }
+
+  auto op_desc = GenOpDesc(matched);
+  auto conv_op_new = LiteOpRegistry::Global().Create("conv2d");
+  auto& valid_places = conv_op_old->valid_places();
+  conv_op_new->Attach(op_desc, scope);
+  auto* new_op_node = graph->GraphCreateInstructNode(conv_op_new, valid_places);
+
+  IR_NODE_LINK_TO(matched.at("conv_input"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("conv_filter"), new_op_node);
+  if (conv_has_bias_) {
+    IR_NODE_LINK_TO(matched.at("conv_bias"), new_op_node);
+  }
+  IR_NODE_LINK_TO(matched.at("elementwise_input"), new_op_node);
+  if (act_type_.empty()) {
+    IR_NODE_LINK_TO(new_op_node, matched.at("elementwise_output"));
+  } else {
+    IR_NODE_LINK_TO(new_op_node, matched.at("act_output"));
+  }
+}
+
+cpp::OpDesc ConvElementwiseInt8Fuser::GenOpDesc(const key2nodes_t& matched) {
+  auto op_desc = *matched.at("conv")->stmt()->op_info();
+  auto* elementwise_op_info = matched.at("elementwise")->stmt()->op_info();
+  auto& residual_name = matched.at("elementwise_input")->arg()->name;
+  op_desc.SetAttr("fuse_elementwise_op_type", elementwise_type_);
+  op_desc.SetInput("SecondInput", {residual_name});
+  op_desc.SetInputScale(residual_name,
+                        elementwise_op_info->GetInputScale(residual_name));
+
+  // The activation of the fused elementwise or the following op is applied
+  // after the add.
+  const OpInfo* out_op_info = elementwise_op_info;
+  std::string act_type{""};
+  if (elementwise_op_info->HasAttr("act_type")) {
+    act_type = elementwise_op_info->GetAttr<std::string>("act_type");
+  }
+  if (!act_type_.empty()) {
+    auto* act_op_info = matched.at("act")->stmt()->op_info();
+    act_type = act_type_;
+    out_op_info = act_op_info;
+    if (act_type_ == "relu6") {
+      op_desc.SetAttr("fuse_brelu_threshold",
+                      act_op_info->GetAttr<float>("threshold"));
+    } else if (act_type_ == "hard_swish") {
+      op_desc.SetAttr("hard_swish_threshold",
+                      act_op_info->GetAttr<float>("threshold"));
+      op_desc.SetAttr("hard_swish_scale", act_op_info->GetAttr<float>("scale"));
+      op_desc.SetAttr("hard_swish_offset",
+                      act_op_info->GetAttr<float>("offset"));
+    }
+  }
+  if (!act_type.empty()) {
+    op_desc.SetAttr("with_act", true);
+    op_desc.SetAttr("act_type", act_type);
+    if (act_type == "relu") op_desc.SetAttr("fuse_relu", true);
+  }
+
+  auto& out_name = act_type_.empty()
+                       ? matched.at("elementwise_output")->arg()->name
+                       : matched.at("act_output")->arg()->name;
+  op_desc.SetOutput("Output", {out_name});
+  if (out_op_info->HasOutputScale(out_name)) {
+    op_desc.SetOutputScale(out_name, out_op_info->GetOutputScale(out_name));
+  }
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,67 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include "lite/core/optimizer/mir/pattern_matcher_high_api.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+class ConvElementwiseInt8Fuser : public FuseBase {
+ public:
+  explicit ConvElementwiseInt8Fuser(const bool conv_has_bias,
+                                    const std::string& elementwise_type,
+                                    const std::string& act_type,
+                                    const bool conv_output_is_x = false) {
+    conv_has_bias_ = conv_has_bias;
+    elementwise_type_ = elementwise_type;
+    act_type_ = act_type;
+    conv_output_is_x_ = conv_output_is_x;
+  }
+  size_t apply_impl(SSAGraph* graph) {
+    BuildPattern();
+    PerformPatternMatcher(graph);
+
+    for (const auto& matched : key2nodes_) {
+      InsertNewNode(graph, matched);
+    }
+
+    GraphSafeRemoveNodes(graph, nodes2rm_);
+    return key2nodes_.size();
+  }
+
+  void BuildPattern() override;
+  void InsertNewNode(SSAGraph* graph, const key2nodes_t& matched) override;
+
+ private:
+  cpp::OpDesc GenOpDesc(const key2nodes_t& matched) override;
+
+  bool conv_has_bias_{false};
+  std::string elementwise_type_{""};
+  // The activation op following the elementwise, empty if there is none.
+  std::string act_type_{""};
+  bool conv_output_is_x_{false};
+  std::set<const Node*> nodes2rm_;
+};
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -27,25 +27,32 @@ void ConvElementwiseTreeFusePass::Apply(
   // initialze fuser params
   std::vector<bool> conv_has_prelu_alpha_cases{true, false};
   std::vector<bool> conv_has_bias_cases{true, false};
-  // TODO(zhaoyang34): Support "depthwise_conv2d", "conv2d_transpose"
-  std::vector<std::string> conv_type_cases{"conv2d"};
+  // TODO(zhaoyang34): Support "conv2d_transpose"
+  std::vector<std::string> conv_type_cases{"conv2d", "depthwise_conv2d"};
   // TODO(zhaoyang34): Support "elementwise_sub", "elementwise_mul",
   // "elementwise_div"
   std::vector<std::string> elementwise_type_cases{
       "elementwise_add", "fusion_elementwise_add_activation"};
+  std::vector<bool> conv_output_is_x_cases{false, true};
 
   // start fuse using params
   for (auto conv_has_prelu_alpha : conv_has_prelu_alpha_cases) {
     for (auto conv_has_bias : conv_has_bias_cases) {
       for (auto conv_type : conv_type_cases) {
         for (auto elementwise_type : elementwise_type_cases) {
-          VLOG(4) << " conv_type: " << conv_type
-                  << "  conv_has_bias: " << conv_has_bias
-                  << "  conv_has_prelu_alpha: " << conv_has_prelu_alpha
-                  << "  elementwise_type: " << elementwise_type;
-          fusion::ConvElementwiseTreeFuser fuser(
-              conv_type, conv_has_bias, conv_has_prelu_alpha, elementwise_type);
-          fuser.apply_impl(graph.get());
+          for (auto conv_output_is_x : conv_output_is_x_cases) {
+            VLOG(4) << " conv_type: " << conv_type
+                    << "  conv_has_bias: " << conv_has_bias
+                    << "  conv_has_prelu_alpha: " << conv_has_prelu_alpha
+                    << "  elementwise_type: " << elementwise_type
+                    << "  conv_output_is_x: " << conv_output_is_x;
+            fusion::ConvElementwiseTreeFuser fuser(conv_type,
+                                                   conv_has_bias,
+                                                   conv_has_prelu_alpha,
+                                                   elementwise_type,
+                                                   conv_output_is_x);
+            fuser.apply_impl(graph.get());
+          }
         }
       }
     }
@@ -29,15 +29,19 @@ void ConvElementwiseTreeFuser::BuildPattern() {
                           ->assert_is_persistable_var()
                           ->assert_is_op_input(conv_type_, "Filter")
                           ->AsInput();
-  auto* elementwise_input = VarNode("elementwise_input")
-                                ->assert_is_op_input(elementwise_type_, "X")
-                                ->AsInput();
+  const std::string conv_output_arg = conv_output_is_x_ ? "X" : "Y";
+  const std::string elementwise_input_arg = conv_output_is_x_ ? "Y" : "X";
+  auto* elementwise_input =
+      VarNode("elementwise_input")
+          ->assert_is_op_input(elementwise_type_, elementwise_input_arg)
+          ->AsInput();
 
   // create intermediate nodes
-  auto* conv_output = VarNode("conv_output")
-                          ->assert_is_op_output(conv_type_, "Output")
-                          ->assert_is_op_input(elementwise_type_, "Y")
-                          ->assert_only_one_output();
+  auto* conv_output =
+      VarNode("conv_output")
+          ->assert_is_op_output(conv_type_, "Output")
+          ->assert_is_op_input(elementwise_type_, conv_output_arg)
+          ->assert_only_one_output();
 
   // create op nodes
   // The pass will not been applied if conv1x1 has already applied this pass.
@@ -140,12 +144,36 @@ void ConvElementwiseTreeFuser::InsertNewNode(SSAGraph* graph,
     return;
   }
 
-  // Check filter dims as this pass only support conv1x1 by now.
+  // The second input is read at the output position of the conv, so it must
+  // not be broadcasted.
+  auto* elementwise_input_var =
+      matched.at("conv")->stmt()->op()->scope()->FindVar(
+          matched.at("elementwise_input")->arg()->name);
+  if (elementwise_input_var == nullptr ||
+      elementwise_input_var->Get<Tensor>().dims() != conv_out_dims) {
+    VLOG(4) << "The input of " << elementwise_type_
+            << " is broadcasted to the conv output. Skip this pass!";
+    return;
+  }
+
+  // Check filter dims as only the conv1x1, the conv3x3 without groups and the
+  // depthwise conv kernels support the fused elementwise by now.
   DDimLite conv_filter_dims;
   GetTensorDims(matched, "conv", "filter", conv_filter_dims);
-  if (!(conv_filter_dims[2] == 1 && conv_filter_dims[3] == 1)) {
-    VLOG(4) << "This pass only support conv1x1, while the conv filter dims is "
-            << conv_filter_dims << ". Skip this pass!";
+  auto* conv_op_info = matched.at("conv")->stmt()->op_info();
+  int groups = conv_op_info->HasAttr("groups")
+                   ? conv_op_info->GetAttr<int>("groups")
+                   : 1;
+  bool is_conv1x1 = conv_filter_dims[2] == 1 && conv_filter_dims[3] == 1;
+  bool is_conv3x3 =
+      conv_filter_dims[2] == 3 && conv_filter_dims[3] == 3 && groups == 1;
+  bool is_depthwise = conv_filter_dims[1] == 1 &&
+                      conv_filter_dims[0] == groups &&
+                      conv_out_dims[1] == groups;
+  if (!(is_conv1x1 || is_conv3x3 || is_depthwise)) {
+    VLOG(4) << "This pass only support conv1x1, conv3x3 and depthwise conv, "
+            << "while the conv filter dims is " << conv_filter_dims
+            << " and groups is " << groups << ". Skip this pass!";
     return;
   }
 
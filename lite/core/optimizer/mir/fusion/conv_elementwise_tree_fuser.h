@@ -29,11 +29,13 @@ class ConvElementwiseTreeFuser : public FuseBase {
   explicit ConvElementwiseTreeFuser(const std::string& conv_type,
                                     const bool conv_has_bias,
                                     const bool conv_has_prelu_alpha,
-                                    const std::string& elementwise_type) {
+                                    const std::string& elementwise_type,
+                                    const bool conv_output_is_x = false) {
     conv_type_ = conv_type;
     conv_has_bias_ = conv_has_bias;
     conv_has_prelu_alpha_ = conv_has_prelu_alpha;
     elementwise_type_ = elementwise_type;
+    conv_output_is_x_ = conv_output_is_x;
   }
   size_t apply_impl(SSAGraph* graph) {
     BuildPattern();
@@ -57,6 +59,9 @@ class ConvElementwiseTreeFuser : public FuseBase {
   bool conv_has_bias_{false};
   bool conv_has_prelu_alpha_{false};
   std::string elementwise_type_{""};
+  // Whether the conv output is the input X of the elementwise rather than Y,
+  // the add is commutative so both are fused.
+  bool conv_output_is_x_{false};
   std::set<const Node*> nodes2rm_;
 };
 
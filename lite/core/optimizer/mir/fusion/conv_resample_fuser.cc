@@ -0,0 +1,202 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/conv_resample_fuser.h"
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+// the fp32 convs whose activation the fused kernels support
+static bool IsFusibleConv(const Node* node) {
+  auto* op_info = node->stmt()->op_info();
+  if ((op_info->HasAttr("enable_int8") &&
+       op_info->GetAttr<bool>("enable_int8")) ||
+      op_info->HasAttr("quantize_weight_bits") ||
+      op_info->HasAttr("quantization_type") ||
+      op_info->HasAttr("fuse_elementwise_op_type")) {
+    return false;
+  }
+  if (op_info->HasAttr("with_act") && op_info->GetAttr<bool>("with_act")) {
+    static const std::set<std::string> acts{
+        "relu", "relu6", "leaky_relu", "hard_swish"};
+    return acts.count(op_info->GetAttr<std::string>("act_type")) > 0;
+  }
+  return true;
+}
+
+static bool IsMaxPool2x2(const Node* node) {
+  auto* op_info = node->stmt()->op_info();
+  if (op_info->GetAttr<std::string>("pooling_type") != "max" ||
+      op_info->GetAttr<bool>("global_pooling") ||
+      (op_info->HasAttr("adaptive") && op_info->GetAttr<bool>("adaptive")) ||
+      (op_info->HasAttr("ceil_mode") && op_info->GetAttr<bool>("ceil_mode"))) {
+    return false;
+  }
+  if (op_info->HasAttr("padding_algorithm") &&
+      op_info->GetAttr<std::string>("padding_algorithm") == "SAME") {
+    return false;
+  }
+  for (auto v : op_info->GetAttr<std::vector<int>>("paddings")) {
+    if (v != 0) return false;
+  }
+  return op_info->GetAttr<std::vector<int>>("ksize") ==
+             std::vector<int>({2, 2}) &&
+         op_info->GetAttr<std::vector<int>>("strides") ==
+             std::vector<int>({2, 2});
+}
+
+// only the static scale of 2 is known before the shapes are
+static bool IsNearestUp2x(const Node* node) {
+  auto* op_info = node->stmt()->op_info();
+  for (auto input : {"OutSize", "SizeTensor", "Scale"}) {
+    if (op_info->HasInput(input) && !op_info->Input(input).empty()) {
+      return false;
+    }
+  }
+  if (op_info->GetAttr<std::string>("interp_method") != "nearest" ||
+      op_info->GetAttr<bool>("align_corners") ||
+      !op_info->HasAttr("scale")) {
+    return false;
+  }
+  if (op_info->HasAttr("data_layout") &&
+      op_info->GetAttr<std::string>("data_layout") != "NCHW") {
+    return false;
+  }
+  if (op_info->Type() == "nearest_interp_v2") {
+    auto scale = op_info->GetAttr<std::vector<float>>("scale");
+    return scale.size() == 2 && scale[0] == 2.f && scale[1] == 2.f;
+  }
+  return op_info->GetAttr<float>("scale") == 2.f;
+}
+
+// the average of all of the pixels of each channel, with the dims kept
+static bool IsGlobalAvgPool(const Node* node) {
+  auto* op_info = node->stmt()->op_info();
+  if (op_info->Type() == "reduce_mean") {
+    if ((op_info->HasAttr("reduce_all") &&
+         op_info->GetAttr<bool>("reduce_all")) ||
+        !op_info->GetAttr<bool>("keep_dim")) {
+      return false;
+    }
+    auto dims = op_info->GetAttr<std::vector<int>>("dim");
+    return dims == std::vector<int>({2, 3}) ||
+           dims == std::vector<int>({-2, -1});
+  }
+  if (op_info->GetAttr<std::string>("pooling_type") != "avg") return false;
+  if (op_info->GetAttr<bool>("global_pooling")) return true;
+  return op_info->HasAttr("adaptive") && op_info->GetAttr<bool>("adaptive") &&
+         op_info->GetAttr<std::vector<int>>("ksize") ==
+             std::vector<int>({1, 1});
+}
+
+// the resample_type of fusion_conv2d_resample, empty if not supported
+static std::string ResampleType(const Node* node) {
+  const auto& type = node->stmt()->op_info()->Type();
+  if (type == "pool2d" && IsMaxPool2x2(node)) return "max_pool2x2";
+  if ((type == "pool2d" || type == "reduce_mean") && IsGlobalAvgPool(node)) {
+    return "global_avg_pool";
+  }
+  if (type != "pool2d" && type != "reduce_mean" && IsNearestUp2x(node)) {
+    return "nearest_up2x";
+  }
+  return "";
+}
+
+void ConvResampleFuser::BuildPattern() {
+  auto conv_teller = [](const Node* node) -> bool {
+    return IsFusibleConv(node);
+  };
+  auto resample_teller = [](const Node* node) -> bool {
+    return !ResampleType(node).empty();
+  };
+
+  auto* input =
+      VarNode("input")->assert_is_op_input(conv_type_, "Input")->AsInput();
+  auto* filter = VarNode("filter")
+                     ->assert_is_op_input(conv_type_, "Filter")
+                     ->assert_is_persistable_var()
+                     ->AsInput();
+  auto* conv = OpNode("conv", conv_type_)
+                   ->assert_is_op(conv_type_)
+                   ->assert_node_satisfied(conv_teller)
+                   ->AsIntermediate();
+  auto* conv_out = VarNode("conv_out")
+                       ->assert_is_op_output(conv_type_, "Output")
+                       ->assert_is_op_input(resample_op_type_, "X")
+                       ->assert_only_one_output()
+                       ->AsIntermediate();
+  auto* resample = OpNode("resample", resample_op_type_)
+                       ->assert_is_op(resample_op_type_)
+                       ->assert_node_satisfied(resample_teller)
+                       ->AsIntermediate();
+  auto* output = VarNode("output")
+                     ->assert_is_op_output(resample_op_type_, "Out")
+                     ->AsOutput();
+
+  std::vector<PMNode*> conv_inputs{input, filter};
+  if (conv_has_bias_) {
+    conv_inputs.push_back(VarNode("bias")
+                              ->assert_is_op_input(conv_type_, "Bias")
+                              ->assert_is_persistable_var()
+                              ->AsInput());
+  }
+  conv->LinksFrom(conv_inputs).LinksTo({conv_out});
+  resample->LinksFrom({conv_out}).LinksTo({output});
+}
+
+void ConvResampleFuser::InsertNewNode(SSAGraph* graph,
+                                      const key2nodes_t& matched) {
+  auto op_desc = GenOpDesc(matched);
+  auto fuse_op = LiteOpRegistry::Global().Create("fusion_conv2d_resample");
+  auto conv = matched.at("conv")->stmt()->op();
+  auto* scope = conv->scope();
+  auto& valid_places = conv->valid_places();
+  fuse_op->Attach(op_desc, scope);
+
+  auto* new_op_node = graph->GraphCreateInstructNode(fuse_op, valid_places);
+
+  IR_NODE_LINK_TO(matched.at("input"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("filter"), new_op_node);
+  if (conv_has_bias_) {
+    IR_NODE_LINK_TO(matched.at("bias"), new_op_node);
+  }
+  IR_NODE_LINK_TO(new_op_node, matched.at("output"));
+}
+
+cpp::OpDesc ConvResampleFuser::GenOpDesc(const key2nodes_t& matched) {
+  auto op_desc = *matched.at("conv")->stmt()->op_info();
+  op_desc.SetType("fusion_conv2d_resample");
+  op_desc.SetInput("Input", {matched.at("input")->arg()->name});
+  op_desc.SetInput("Filter", {matched.at("filter")->arg()->name});
+  if (conv_has_bias_) {
+    op_desc.SetInput("Bias", {matched.at("bias")->arg()->name});
+  } else {
+    op_desc.SetInput("Bias", {});
+  }
+  op_desc.SetOutput("Output", {matched.at("output")->arg()->name});
+  op_desc.SetAttr<std::string>("resample_type",
+                               ResampleType(matched.at("resample")));
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
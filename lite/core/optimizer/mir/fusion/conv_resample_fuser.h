@@ -0,0 +1,50 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pattern_matcher_high_api.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+// Fuses a conv and the 2x2 stride 2 max pool2d, the global average pool2d
+// or reduce_mean over H and W, or the 2x nearest_interp which is the only
+// consumer of its output into fusion_conv2d_resample.
+class ConvResampleFuser : public FuseBase {
+ public:
+  ConvResampleFuser(const std::string& conv_type,
+                    bool conv_has_bias,
+                    const std::string& resample_op_type)
+      : conv_type_(conv_type),
+        conv_has_bias_(conv_has_bias),
+        resample_op_type_(resample_op_type) {}
+  void BuildPattern() override;
+  void InsertNewNode(SSAGraph* graph, const key2nodes_t& matched) override;
+
+ private:
+  cpp::OpDesc GenOpDesc(const key2nodes_t& matched) override;
+  std::string conv_type_;
+  bool conv_has_bias_;
+  std::string resample_op_type_;
+};
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
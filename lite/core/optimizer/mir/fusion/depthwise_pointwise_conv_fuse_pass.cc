@@ -0,0 +1,53 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/depthwise_pointwise_conv_fuse_pass.h"
+#include <memory>
+#include <vector>
+#include "lite/core/optimizer/mir/fusion/depthwise_pointwise_conv_fuser.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void DepthwisePointwiseConvFusePass::Apply(
+    const std::unique_ptr<SSAGraph>& graph) {
+  // the fused kernel is fp32 only, keep the fp16 and int8 convs as they are
+  for (auto& place : graph->valid_places()) {
+    if (place.target == TARGET(kARM) &&
+        (place.precision == PRECISION(kFP16) ||
+         place.precision == PRECISION(kInt8))) {
+      return;
+    }
+  }
+  for (auto dw_type : {"depthwise_conv2d", "conv2d"}) {
+    for (auto dw_has_bias : {true, false}) {
+      for (auto pw_has_bias : {true, false}) {
+        fusion::DepthwisePointwiseConvFuser fuser(
+            dw_type, dw_has_bias, pw_has_bias);
+        fuser(graph.get());
+      }
+    }
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_depthwise_pointwise_conv_fuse_pass,
+                  paddle::lite::mir::DepthwisePointwiseConvFusePass)
+    .BindTargets({TARGET(kARM)})
+    .BindKernel("fusion_depthwise_pointwise_conv2d");
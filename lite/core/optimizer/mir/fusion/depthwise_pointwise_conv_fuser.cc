@@ -0,0 +1,179 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/depthwise_pointwise_conv_fuser.h"
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+// the fp32 convs whose activation the fused kernel supports
+static bool IsFusibleConv(const Node* node) {
+  auto* op_info = node->stmt()->op_info();
+  if ((op_info->HasAttr("enable_int8") &&
+       op_info->GetAttr<bool>("enable_int8")) ||
+      op_info->HasAttr("quantize_weight_bits") ||
+      op_info->HasAttr("quantization_type") ||
+      op_info->HasAttr("fuse_elementwise_op_type")) {
+    return false;
+  }
+  if (op_info->HasAttr("with_act") && op_info->GetAttr<bool>("with_act")) {
+    static const std::set<std::string> acts{
+        "relu", "relu6", "leaky_relu", "hard_swish"};
+    return acts.count(op_info->GetAttr<std::string>("act_type")) > 0;
+  }
+  return true;
+}
+
+static DDim FilterDims(const Node* node) {
+  auto* scope = node->stmt()->op()->scope();
+  auto filter = node->stmt()->op_info()->Input("Filter").front();
+  return scope->FindVar(filter)->Get<lite::Tensor>().dims();
+}
+
+void DepthwisePointwiseConvFuser::BuildPattern() {
+  // one filter of each of the channels
+  auto dw_teller = [](const Node* node) -> bool {
+    if (!IsFusibleConv(node)) return false;
+    auto dims = FilterDims(node);
+    int groups = node->stmt()->op_info()->GetAttr<int>("groups");
+    return dims.size() == 4 && dims[1] == 1 && dims[0] == groups;
+  };
+  auto pw_teller = [](const Node* node) -> bool {
+    if (!IsFusibleConv(node)) return false;
+    auto* op_info = node->stmt()->op_info();
+    auto dims = FilterDims(node);
+    auto strides = op_info->GetAttr<std::vector<int>>("strides");
+    auto paddings = op_info->GetAttr<std::vector<int>>("paddings");
+    for (auto v : strides) {
+      if (v != 1) return false;
+    }
+    for (auto v : paddings) {
+      if (v != 0) return false;
+    }
+    return dims.size() == 4 && dims[2] == 1 && dims[3] == 1 &&
+           op_info->GetAttr<int>("groups") == 1;
+  };
+
+  auto* input =
+      VarNode("input")->assert_is_op_input(dw_type_, "Input")->AsInput();
+  auto* dw_filter = VarNode("dw_filter")
+                        ->assert_is_op_input(dw_type_, "Filter")
+                        ->assert_is_persistable_var()
+                        ->AsInput();
+  auto* dw = OpNode("dw", dw_type_)
+                 ->assert_is_op(dw_type_)
+                 ->assert_node_satisfied(dw_teller)
+                 ->AsIntermediate();
+  auto* dw_out = VarNode("dw_out")
+                     ->assert_is_op_output(dw_type_, "Output")
+                     ->assert_is_op_input("conv2d", "Input")
+                     ->assert_only_one_output()
+                     ->AsIntermediate();
+  auto* pw_filter = VarNode("pw_filter")
+                        ->assert_is_op_input("conv2d", "Filter")
+                        ->assert_is_persistable_var()
+                        ->AsInput();
+  auto* pw = OpNode("pw", "conv2d")
+                 ->assert_is_op("conv2d")
+                 ->assert_node_satisfied(pw_teller)
+                 ->AsIntermediate();
+  auto* output =
+      VarNode("output")->assert_is_op_output("conv2d", "Output")->AsOutput();
+
+  std::vector<PMNode*> dw_inputs{input, dw_filter};
+  if (dw_has_bias_) {
+    dw_inputs.push_back(VarNode("dw_bias")
+                            ->assert_is_op_input(dw_type_, "Bias")
+                            ->assert_is_persistable_var()
+                            ->AsInput());
+  }
+  std::vector<PMNode*> pw_inputs{dw_out, pw_filter};
+  if (pw_has_bias_) {
+    pw_inputs.push_back(VarNode("pw_bias")
+                            ->assert_is_op_input("conv2d", "Bias")
+                            ->assert_is_persistable_var()
+                            ->AsInput());
+  }
+  dw->LinksFrom(dw_inputs).LinksTo({dw_out});
+  pw->LinksFrom(pw_inputs).LinksTo({output});
+}
+
+void DepthwisePointwiseConvFuser::InsertNewNode(SSAGraph* graph,
+                                                const key2nodes_t& matched) {
+  auto op_desc = GenOpDesc(matched);
+  auto fuse_op =
+      LiteOpRegistry::Global().Create("fusion_depthwise_pointwise_conv2d");
+  auto dw = matched.at("dw")->stmt()->op();
+  auto* scope = dw->scope();
+  auto& valid_places = dw->valid_places();
+  fuse_op->Attach(op_desc, scope);
+
+  auto* new_op_node = graph->GraphCreateInstructNode(fuse_op, valid_places);
+
+  IR_NODE_LINK_TO(matched.at("input"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("dw_filter"), new_op_node);
+  if (dw_has_bias_) {
+    IR_NODE_LINK_TO(matched.at("dw_bias"), new_op_node);
+  }
+  IR_NODE_LINK_TO(matched.at("pw_filter"), new_op_node);
+  if (pw_has_bias_) {
+    IR_NODE_LINK_TO(matched.at("pw_bias"), new_op_node);
+  }
+  IR_NODE_LINK_TO(new_op_node, matched.at("output"));
+}
+
+cpp::OpDesc DepthwisePointwiseConvFuser::GenOpDesc(
+    const key2nodes_t& matched) {
+  auto op_desc = *matched.at("dw")->stmt()->op_info();
+  auto* pw_info = matched.at("pw")->stmt()->op_info();
+  op_desc.SetType("fusion_depthwise_pointwise_conv2d");
+  op_desc.SetInput("Input", {matched.at("input")->arg()->name});
+  op_desc.SetInput("Filter", {matched.at("dw_filter")->arg()->name});
+  if (dw_has_bias_) {
+    op_desc.SetInput("Bias", {matched.at("dw_bias")->arg()->name});
+  } else {
+    op_desc.SetInput("Bias", {});
+  }
+  op_desc.SetInput("PwFilter", {matched.at("pw_filter")->arg()->name});
+  if (pw_has_bias_) {
+    op_desc.SetInput("PwBias", {matched.at("pw_bias")->arg()->name});
+  }
+  op_desc.SetOutput("Output", {matched.at("output")->arg()->name});
+  if (pw_info->HasAttr("with_act") && pw_info->GetAttr<bool>("with_act")) {
+    op_desc.SetAttr<bool>("pw_with_act", true);
+    auto act_type = pw_info->GetAttr<std::string>("act_type");
+    op_desc.SetAttr<std::string>("pw_act_type", act_type);
+    for (auto attr : {"fuse_brelu_threshold",
+                      "leaky_relu_alpha",
+                      "hard_swish_threshold",
+                      "hard_swish_scale",
+                      "hard_swish_offset"}) {
+      if (pw_info->HasAttr(attr)) {
+        op_desc.SetAttr<float>(std::string("pw_") + attr,
+                               pw_info->GetAttr<float>(attr));
+      }
+    }
+  }
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,49 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pattern_matcher_high_api.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+// Fuses a depthwise conv and the 1x1 stride 1 conv2d which is the only
+// consumer of its output into fusion_depthwise_pointwise_conv2d.
+class DepthwisePointwiseConvFuser : public FuseBase {
+ public:
+  DepthwisePointwiseConvFuser(const std::string& dw_type,
+                              bool dw_has_bias,
+                              bool pw_has_bias)
+      : dw_type_(dw_type),
+        dw_has_bias_(dw_has_bias),
+        pw_has_bias_(pw_has_bias) {}
+  void BuildPattern() override;
+  void InsertNewNode(SSAGraph* graph, const key2nodes_t& matched) override;
+
+ private:
+  cpp::OpDesc GenOpDesc(const key2nodes_t& matched) override;
+  std::string dw_type_;
+  bool dw_has_bias_;
+  bool pw_has_bias_;
+};
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,226 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/distribute_fpn_roi_align_fuse_pass.h"
+#include <list>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+static bool IsOp(const Node* node, const std::string& type) {
+  return node->IsStmt() && node->stmt()->op_info()->Type() == type;
+}
+
+static Node* FindArg(const std::list<Node*>& nodes, const std::string& name) {
+  for (auto* node : nodes) {
+    if (node->arg()->name == name) return node;
+  }
+  return nullptr;
+}
+
+// The only op that reads the var.
+static Node* SoleConsumer(const Node* var) {
+  if (!var || var->arg()->is_weight || var->outlinks.size() != 1) {
+    return nullptr;
+  }
+  return var->outlinks.front();
+}
+
+static bool HasArgs(const OpInfo* op_info,
+                    const std::string& param,
+                    bool is_input) {
+  if (is_input) {
+    return op_info->HasInput(param) && !op_info->Input(param).empty();
+  }
+  return op_info->HasOutput(param) && !op_info->Output(param).empty();
+}
+
+bool DistributeFpnRoiAlignFusePass::Fuse(SSAGraph* graph, Node* distribute) {
+  const auto* dist_info = distribute->stmt()->op_info();
+  const auto rois_names = dist_info->Output("MultiFpnRois");
+  std::vector<std::string> rois_num_names;
+  if (HasArgs(dist_info, "MultiLevelRoIsNum", false)) {
+    rois_num_names = dist_info->Output("MultiLevelRoIsNum");
+    if (rois_num_names.size() != rois_names.size()) return false;
+  }
+  const int min_level = dist_info->GetAttr<int>("min_level");
+  const int max_level = dist_info->GetAttr<int>("max_level");
+  if (static_cast<int>(rois_names.size()) != max_level - min_level + 1) {
+    return false;
+  }
+  auto* restore_index = FindArg(distribute->outlinks,
+                                dist_info->Output("RestoreIndex").front());
+  auto* gather = SoleConsumer(restore_index);
+  if (!gather || !IsOp(gather, "gather")) return false;
+  const auto* gather_info = gather->stmt()->op_info();
+  if (HasArgs(gather_info, "Axis", true) ||
+      (gather_info->HasAttr("axis") && gather_info->GetAttr<int>("axis")) ||
+      gather_info->Input("Index").front() != restore_index->arg()->name) {
+    return false;
+  }
+  auto* concat_out =
+      FindArg(gather->inlinks, gather_info->Input("X").front());
+  if (!concat_out || concat_out->inlinks.size() != 1 ||
+      SoleConsumer(concat_out) != gather) {
+    return false;
+  }
+  auto* concat = concat_out->inlinks.front();
+  if (!IsOp(concat, "concat")) return false;
+  const auto* concat_info = concat->stmt()->op_info();
+  if (HasArgs(concat_info, "AxisTensor", true) ||
+      concat_info->GetAttr<int>("axis") != 0 ||
+      concat_info->Input("X").size() != rois_names.size()) {
+    return false;
+  }
+
+  std::set<const Node*> nodes2rm{
+      distribute, restore_index, gather, concat_out, concat};
+  std::vector<std::string> x_names;
+  std::vector<float> spatial_scales;
+  const OpInfo* first_info = nullptr;
+  for (size_t i = 0; i < rois_names.size(); i++) {
+    // the roi_align of the level i is the i-th input of the concat
+    auto* rois = FindArg(distribute->outlinks, rois_names[i]);
+    auto* roi_align = SoleConsumer(rois);
+    if (!roi_align || !IsOp(roi_align, "roi_align")) return false;
+    const auto* op_info = roi_align->stmt()->op_info();
+    if (op_info->Input("ROIs").front() != rois_names[i] ||
+        HasArgs(op_info, "RoisLod", true)) {
+      return false;
+    }
+    nodes2rm.insert(rois);
+    if (!rois_num_names.empty()) {
+      // the rois num of the level is read by its roi_align only, if at all
+      auto* rois_num = FindArg(distribute->outlinks, rois_num_names[i]);
+      bool read = HasArgs(op_info, "RoisNum", true);
+      if (!rois_num || rois_num->outlinks.size() != (read ? 1 : 0) ||
+          (read && op_info->Input("RoisNum").front() != rois_num_names[i])) {
+        return false;
+      }
+      nodes2rm.insert(rois_num);
+    } else if (HasArgs(op_info, "RoisNum", true)) {
+      return false;
+    }
+    auto* out = FindArg(roi_align->outlinks, op_info->Output("Out").front());
+    if (SoleConsumer(out) != concat ||
+        concat_info->Input("X")[i] != out->arg()->name) {
+      return false;
+    }
+    nodes2rm.insert(out);
+    nodes2rm.insert(roi_align);
+
+    auto aligned = [](const OpInfo* info) {
+      return info->HasAttr("aligned") && info->GetAttr<bool>("aligned");
+    };
+    if (!first_info) {
+      first_info = op_info;
+    } else if (op_info->GetAttr<int>("pooled_height") !=
+                   first_info->GetAttr<int>("pooled_height") ||
+               op_info->GetAttr<int>("pooled_width") !=
+                   first_info->GetAttr<int>("pooled_width") ||
+               op_info->GetAttr<int>("sampling_ratio") !=
+                   first_info->GetAttr<int>("sampling_ratio") ||
+               aligned(op_info) != aligned(first_info)) {
+      return false;
+    }
+    x_names.push_back(op_info->Input("X").front());
+    spatial_scales.push_back(op_info->GetAttr<float>("spatial_scale"));
+  }
+
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fusion_distribute_fpn_roi_align");
+  op_desc.SetInput("X", x_names);
+  op_desc.SetInput("FpnRois", dist_info->Input("FpnRois"));
+  if (HasArgs(dist_info, "RoisNum", true)) {
+    op_desc.SetInput("RoisNum", dist_info->Input("RoisNum"));
+  }
+  op_desc.SetOutput("Out", gather_info->Output("Out"));
+  op_desc.SetAttr("min_level", min_level);
+  op_desc.SetAttr("max_level", max_level);
+  op_desc.SetAttr("refer_level", dist_info->GetAttr<int>("refer_level"));
+  op_desc.SetAttr("refer_scale", dist_info->GetAttr<int>("refer_scale"));
+  op_desc.SetAttr("pixel_offset",
+                  dist_info->HasAttr("pixel_offset")
+                      ? dist_info->GetAttr<bool>("pixel_offset")
+                      : true);
+  op_desc.SetAttr("spatial_scales", spatial_scales);
+  op_desc.SetAttr("pooled_height", first_info->GetAttr<int>("pooled_height"));
+  op_desc.SetAttr("pooled_width", first_info->GetAttr<int>("pooled_width"));
+  op_desc.SetAttr("sampling_ratio",
+                  first_info->GetAttr<int>("sampling_ratio"));
+  op_desc.SetAttr("aligned",
+                  first_info->HasAttr("aligned") &&
+                      first_info->GetAttr<bool>("aligned"));
+
+  auto dist_op = distribute->stmt()->op();
+  auto* scope = dist_op->scope();
+  auto fuse_op =
+      LiteOpRegistry::Global().Create("fusion_distribute_fpn_roi_align");
+  fuse_op->Attach(op_desc, scope);
+  auto* new_op_node =
+      graph->GraphCreateInstructNode(fuse_op, dist_op->valid_places());
+  for (const auto& name : x_names) {
+    DirectedLink(graph->RetrieveArgument(name), new_op_node);
+  }
+  DirectedLink(graph->RetrieveArgument(dist_info->Input("FpnRois").front()),
+               new_op_node);
+  if (HasArgs(dist_info, "RoisNum", true)) {
+    DirectedLink(
+        graph->RetrieveArgument(dist_info->Input("RoisNum").front()),
+        new_op_node);
+  }
+  DirectedLink(new_op_node,
+               graph->RetrieveArgument(gather_info->Output("Out").front()));
+  GraphSafeRemoveNodes(graph, nodes2rm);
+  return true;
+}
+
+void DistributeFpnRoiAlignFusePass::Apply(
+    const std::unique_ptr<SSAGraph>& graph) {
+  // the fused kernel is fp32 only, keep the fp16 and int8 ops as they are
+  for (auto& place : graph->valid_places()) {
+    if (place.target == TARGET(kARM) &&
+        (place.precision == PRECISION(kFP16) ||
+         place.precision == PRECISION(kInt8))) {
+      return;
+    }
+  }
+  std::vector<Node*> distributes;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (IsOp(node, "distribute_fpn_proposals")) {
+      distributes.push_back(node);
+    }
+  }
+  int fused_num = 0;
+  for (auto* distribute : distributes) {
+    if (Fuse(graph.get(), distribute)) fused_num++;
+  }
+  VLOG(3) << "Fuse " << fused_num << " distribute_fpn_proposals + roi_align.";
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_distribute_fpn_roi_align_fuse_pass,
+                  paddle::lite::mir::DistributeFpnRoiAlignFusePass)
+    .BindTargets({TARGET(kARM), TARGET(kX86)})
+    .BindKernel("fusion_distribute_fpn_roi_align");
@@ -0,0 +1,45 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * Fuse the RoI feature extraction of the FPN detectors,
+ *
+ *   distribute_fpn_proposals -> roi_align (per level) -> concat -> gather
+ *                            -> RestoreIndex ---------------------->
+ *
+ * into fusion_distribute_fpn_roi_align, which pools every roi from its level
+ * right into its row of the output, so the rois of the levels, the outputs
+ * of the levels and their concat are never written.
+ */
+class DistributeFpnRoiAlignFusePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  bool Fuse(SSAGraph* graph, Node* distribute);
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,106 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/elementwise_add_layer_norm_fuser.h"
+#include <memory>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+void ElementwiseAddLayerNormFuser::BuildPattern() {
+  // create nodes.
+  // The bias adds of the persistable Y are left to the other fusions.
+  auto* x = VarNode("x")
+                ->assert_is_op_input("elementwise_add", "X")
+                ->assert_var_not_persistable();
+  auto* y = VarNode("y")
+                ->assert_is_op_input("elementwise_add", "Y")
+                ->assert_var_not_persistable();
+  auto* add = OpNode("add", "elementwise_add")
+                  ->assert_op_attr<int>("axis", -1)
+                  ->AsIntermediate();
+  auto* add_out = VarNode("add_out")
+                      ->assert_is_op_output("elementwise_add", "Out")
+                      ->assert_is_op_input("layer_norm", "X");
+  auto* scale = VarNode("scale")->assert_is_op_input("layer_norm", "Scale");
+  auto* bias = VarNode("bias")->assert_is_op_input("layer_norm", "Bias");
+  auto* layer_norm = OpNode("layer_norm", "layer_norm")->AsIntermediate();
+  auto* out = VarNode("out")->assert_is_op_output("layer_norm", "Y");
+  auto* mean = VarNode("mean")->assert_is_op_output("layer_norm", "Mean");
+  auto* var = VarNode("var")->assert_is_op_output("layer_norm", "Variance");
+
+  // create topology.
+  std::vector<PMNode*> add_inputs{x, y};
+  std::vector<PMNode*> layer_norm_inputs{add_out, scale, bias};
+  std::vector<PMNode*> layer_norm_outputs{out, mean, var};
+  add_inputs >> *add >> *add_out;
+  layer_norm_inputs >> *layer_norm >> layer_norm_outputs;
+
+  if (!keep_sum_) {
+    add_out->assert_only_one_output()->AsIntermediate();
+  }
+}
+
+void ElementwiseAddLayerNormFuser::InsertNewNode(SSAGraph* graph,
+                                                 const key2nodes_t& matched) {
+  auto op_desc = GenOpDesc(matched);
+  auto fused_op =
+      LiteOpRegistry::Global().Create("fusion_elementwise_add_layer_norm");
+  auto layer_norm = matched.at("layer_norm")->stmt()->op();
+  auto* scope = layer_norm->scope();
+  auto& valid_places = layer_norm->valid_places();
+  fused_op->Attach(op_desc, scope);
+
+  auto* new_op_node = graph->GraphCreateInstructNode(fused_op, valid_places);
+
+  IR_NODE_LINK_TO(matched.at("x"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("y"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("scale"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("bias"), new_op_node);
+  IR_NODE_LINK_TO(new_op_node, matched.at("out"));
+  IR_NODE_LINK_TO(new_op_node, matched.at("mean"));
+  IR_NODE_LINK_TO(new_op_node, matched.at("var"));
+  if (keep_sum_) {
+    IR_NODE_LINK_TO(new_op_node, matched.at("add_out"));
+  }
+}
+
+cpp::OpDesc ElementwiseAddLayerNormFuser::GenOpDesc(
+    const key2nodes_t& matched) {
+  auto* layer_norm = matched.at("layer_norm")->stmt()->op_info();
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fusion_elementwise_add_layer_norm");
+  op_desc.SetInput("X", {matched.at("x")->arg()->name});
+  op_desc.SetInput("Residual", {matched.at("y")->arg()->name});
+  op_desc.SetInput("Scale", {matched.at("scale")->arg()->name});
+  op_desc.SetInput("Bias", {matched.at("bias")->arg()->name});
+  op_desc.SetOutput("Y", {matched.at("out")->arg()->name});
+  op_desc.SetOutput("Mean", {matched.at("mean")->arg()->name});
+  op_desc.SetOutput("Variance", {matched.at("var")->arg()->name});
+  if (keep_sum_) {
+    op_desc.SetOutput("AddOut", {matched.at("add_out")->arg()->name});
+  }
+  op_desc.SetAttr<int>("begin_norm_axis",
+                       layer_norm->GetAttr<int>("begin_norm_axis"));
+  op_desc.SetAttr<float>("epsilon", layer_norm->GetAttr<float>("epsilon"));
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
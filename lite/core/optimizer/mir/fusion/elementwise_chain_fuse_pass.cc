@@ -0,0 +1,274 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/elementwise_chain_fuse_pass.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// the steps of a fused chain
+static constexpr size_t kMinSteps = 3;
+static constexpr size_t kMaxSteps = 16;
+
+static const std::set<std::string> kBinaryOps{"elementwise_add",
+                                              "elementwise_sub",
+                                              "elementwise_mul",
+                                              "elementwise_div",
+                                              "elementwise_max",
+                                              "elementwise_min"};
+static const std::set<std::string> kUnaryOps{"relu",
+                                             "relu6",
+                                             "leaky_relu",
+                                             "sigmoid",
+                                             "tanh",
+                                             "swish",
+                                             "hard_sigmoid",
+                                             "hard_swish",
+                                             "exp",
+                                             "abs",
+                                             "square",
+                                             "sqrt",
+                                             "scale"};
+
+static bool IsChainOp(const Node* node) {
+  if (!node->IsStmt()) return false;
+  auto* op_info = node->stmt()->op_info();
+  const auto& type = op_info->Type();
+  if (!kBinaryOps.count(type) && !kUnaryOps.count(type)) return false;
+  if ((op_info->HasAttr("enable_int8") &&
+       op_info->GetAttr<bool>("enable_int8")) ||
+      (op_info->HasAttr("fuse_scale") &&
+       op_info->GetAttr<bool>("fuse_scale"))) {
+    return false;
+  }
+  if (type == "scale") {
+    if ((op_info->HasInput("ScaleTensor") &&
+         !op_info->Input("ScaleTensor").empty()) ||
+        (op_info->HasAttr("activation_type") &&
+         !op_info->GetAttr<std::string>("activation_type").empty()) ||
+        (op_info->HasAttr("fuse_scaleact") &&
+         op_info->GetAttr<bool>("fuse_scaleact"))) {
+      return false;
+    }
+  }
+  return node->outlinks.size() == 1 && op_info->Output("Out").size() == 1;
+}
+
+static float FloatAttr(const OpInfo& op_info,
+                       const std::string& name,
+                       float default_value) {
+  return op_info.HasAttr(name) ? op_info.GetAttr<float>(name) : default_value;
+}
+
+std::vector<Node*> ElementwiseChainFusePass::FindChain(Node* seed) {
+  std::vector<Node*> chain{seed};
+  std::set<const Node*> ops{seed};
+  Node* head = seed->outlinks.front();
+  while (chain.size() < kMaxSteps) {
+    if (head->arg()->is_weight || head->outlinks.empty()) break;
+    Node* next = nullptr;
+    for (auto* consumer : head->outlinks) {
+      if (!ops.count(consumer) && IsChainOp(consumer)) {
+        next = consumer;
+        break;
+      }
+    }
+    if (!next) break;
+    chain.push_back(next);
+    ops.insert(next);
+    head = next->outlinks.front();
+  }
+  // The longest prefix whose values in the middle are read by the prefix
+  // only. An input of the chain computed from such a value by another op is
+  // excluded by this as well.
+  while (chain.size() > 1) {
+    std::set<const Node*> prefix(chain.begin(), chain.end());
+    bool valid = true;
+    for (size_t i = 0; valid && i + 1 < chain.size(); i++) {
+      auto* value = chain[i]->outlinks.front();
+      valid = !value->arg()->is_weight;
+      for (auto* consumer : value->outlinks) {
+        valid = valid && prefix.count(consumer);
+      }
+    }
+    if (valid) break;
+    chain.pop_back();
+  }
+  return chain;
+}
+
+bool ElementwiseChainFusePass::FuseChain(SSAGraph* graph,
+                                         const std::vector<Node*>& chain) {
+  auto first_op = chain.front()->stmt()->op();
+  auto* scope = first_op->scope();
+  std::vector<std::string> x_names{
+      chain.front()->stmt()->op_info()->Input("X").front()};
+  // the step of each value computed by the chain
+  std::map<std::string, int> results;
+  std::vector<std::pair<std::string, bool>> operands;
+  std::vector<std::string> step_types;
+  std::vector<int> operand_first;
+  std::vector<int> axes;
+  std::vector<float> alphas;
+  std::vector<float> betas;
+  std::vector<float> gammas;
+  // The kernels are fp32 only, and the precision of the vars is not known
+  // before the kernels are picked. The activations are float ops, and so are
+  // the elementwise ops with a float weight.
+  bool is_float = false;
+  for (size_t i = 0; i < chain.size(); i++) {
+    const auto& op_info = *chain[i]->stmt()->op_info();
+    const auto& type = op_info.Type();
+    const std::string value =
+        i == 0 ? x_names.front() : chain[i - 1]->outlinks.front()->arg()->name;
+    float alpha = 0.f;
+    float beta = 0.f;
+    float gamma = 0.f;
+    int axis = -1;
+    bool first = false;
+    std::string operand;
+    if (kBinaryOps.count(type)) {
+      auto x = op_info.Input("X").front();
+      auto y = op_info.Input("Y").front();
+      first = x != value;
+      operand = first ? x : y;
+      axis = op_info.GetAttr<int>("axis");
+      if (!results.count(operand)) {
+        auto* var = scope->FindVar(operand);
+        auto* node = graph->RetrieveArgument(operand);
+        if (node && node->arg()->is_weight && var &&
+            var->Get<lite::Tensor>().precision() == PRECISION(kFloat)) {
+          is_float = true;
+        }
+      }
+    } else if (type == "scale") {
+      alpha = op_info.GetAttr<float>("scale");
+      beta = op_info.GetAttr<float>("bias");
+      gamma = op_info.GetAttr<bool>("bias_after_scale") ? 1.f : 0.f;
+    } else {
+      is_float = true;
+      if (type == "relu6") {
+        alpha = FloatAttr(op_info, "threshold", 6.f);
+      } else if (type == "leaky_relu") {
+        alpha = FloatAttr(op_info, "alpha", 0.02f);
+      } else if (type == "swish") {
+        alpha = FloatAttr(op_info, "beta", 1.f);
+      } else if (type == "hard_sigmoid") {
+        alpha = FloatAttr(op_info, "slope", 0.2f);
+        beta = FloatAttr(op_info, "offset", 0.5f);
+      } else if (type == "hard_swish") {
+        alpha = FloatAttr(op_info, "threshold", 6.f);
+        beta = FloatAttr(op_info, "scale", 6.f);
+        gamma = FloatAttr(op_info, "offset", 3.f);
+      }
+    }
+    if (!operand.empty() && !results.count(operand) &&
+        std::find(x_names.begin(), x_names.end(), operand) == x_names.end()) {
+      x_names.push_back(operand);
+    }
+    operands.emplace_back(operand, results.count(operand) > 0);
+    step_types.push_back(type);
+    operand_first.push_back(first);
+    axes.push_back(axis);
+    alphas.push_back(alpha);
+    betas.push_back(beta);
+    gammas.push_back(gamma);
+    results[chain[i]->outlinks.front()->arg()->name] = i;
+  }
+  if (!is_float) return false;
+
+  // the values are the inputs followed by the results of the steps
+  std::vector<int> operand_ids;
+  for (const auto& operand : operands) {
+    if (operand.first.empty()) {
+      operand_ids.push_back(-1);
+    } else if (operand.second) {
+      operand_ids.push_back(x_names.size() + results.at(operand.first));
+    } else {
+      operand_ids.push_back(
+          std::find(x_names.begin(), x_names.end(), operand.first) -
+          x_names.begin());
+    }
+  }
+  auto* out_node = chain.back()->outlinks.front();
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fusion_elementwise_chain");
+  op_desc.SetInput("X", x_names);
+  op_desc.SetOutput("Out", {out_node->arg()->name});
+  op_desc.SetAttr("step_types", step_types);
+  op_desc.SetAttr("operands", operand_ids);
+  op_desc.SetAttr("operand_first", operand_first);
+  op_desc.SetAttr("axes", axes);
+  op_desc.SetAttr("alphas", alphas);
+  op_desc.SetAttr("betas", betas);
+  op_desc.SetAttr("gammas", gammas);
+
+  auto fuse_op = LiteOpRegistry::Global().Create("fusion_elementwise_chain");
+  fuse_op->Attach(op_desc, scope);
+  auto* new_op_node =
+      graph->GraphCreateInstructNode(fuse_op, first_op->valid_places());
+  for (const auto& name : x_names) {
+    DirectedLink(graph->RetrieveArgument(name), new_op_node);
+  }
+  DirectedLink(new_op_node, out_node);
+
+  std::set<const Node*> nodes2rm(chain.begin(), chain.end());
+  for (size_t i = 0; i + 1 < chain.size(); i++) {
+    nodes2rm.insert(chain[i]->outlinks.front());
+  }
+  GraphSafeRemoveNodes(graph, nodes2rm);
+  return true;
+}
+
+void ElementwiseChainFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // the fused kernels are fp32 only, keep the fp16 and int8 ops as they are
+  for (auto& place : graph->valid_places()) {
+    if (place.target == TARGET(kARM) &&
+        (place.precision == PRECISION(kFP16) ||
+         place.precision == PRECISION(kInt8))) {
+      return;
+    }
+  }
+  std::set<const Node*> visited;
+  int fused_num = 0;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (visited.count(node) || !IsChainOp(node)) continue;
+    auto chain = FindChain(node);
+    visited.insert(chain.begin(), chain.end());
+    if (chain.size() >= kMinSteps && FuseChain(graph.get(), chain)) {
+      VLOG(4) << "Fuse a chain of " << chain.size() << " elementwise ops";
+      fused_num++;
+    }
+  }
+  VLOG(3) << "Fuse " << fused_num << " elementwise chains.";
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_elementwise_chain_fuse_pass,
+                  paddle::lite::mir::ElementwiseChainFusePass)
+    .BindTargets({TARGET(kARM), TARGET(kX86), TARGET(kOpenCL)})
+    .BindKernel("fusion_elementwise_chain");
@@ -0,0 +1,47 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * Fuse the chains of elementwise, scale and activation ops, such as the
+ * sub -> mul -> add -> sigmoid -> mul of the swish and the normalization
+ * math, into fusion_elementwise_chain, which reads the inputs and writes the
+ * output once instead of once per op. A chain grows from an op through the
+ * consumers of its output, and every other input of an op of the chain is
+ * either an earlier value of the chain or an input of the fused op. The
+ * values in the middle of the chain must not be read by the other ops. The
+ * chains of two ops are left to the pair fusions.
+ */
+class ElementwiseChainFusePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  std::vector<Node*> FindChain(Node* seed);
+  bool FuseChain(SSAGraph* graph, const std::vector<Node*>& chain);
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
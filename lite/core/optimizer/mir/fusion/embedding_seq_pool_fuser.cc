@@ -0,0 +1,105 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/embedding_seq_pool_fuser.h"
+
+#include <memory>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+void EmbeddingSeqPoolFuser::BuildPattern() {
+  // the pools which are linear in the rows, MAX and MIN need MaxIndex
+  auto pool_teller = [](const std::string& pool_type) {
+    return pool_type == "SUM" || pool_type == "AVERAGE" || pool_type == "SQRT";
+  };
+
+  // create input nodes.
+  auto* ids =
+      VarNode("ids")->assert_is_op_input(lookup_type_, "Ids")->AsInput();
+  auto* w = VarNode("w")->assert_is_op_input(lookup_type_, "W")->AsInput();
+
+  // create op nodes
+  auto* lookup_table = OpNode("lookup_table", lookup_type_)
+                           ->assert_is_op(lookup_type_)
+                           ->AsIntermediate();
+  auto* sequence_pool =
+      OpNode("sequence_pool", "sequence_pool")
+          ->assert_is_op("sequence_pool")
+          ->assert_op_attr_satisfied<std::string>("pooltype", pool_teller)
+          ->AsIntermediate();
+
+  // create intermediate nodes
+  auto* lookup_table_out = VarNode("lookup_table_out")
+                               ->assert_is_op_output(lookup_type_, "Out")
+                               ->assert_is_op_input("sequence_pool", "X")
+                               ->assert_only_one_output()
+                               ->AsIntermediate();
+  auto* sequence_pool_idx =
+      VarNode("sequence_pool_idx")
+          ->assert_is_op_output("sequence_pool", "MaxIndex")
+          ->AsIntermediate();
+
+  // create output node
+  auto* out =
+      VarNode("out")->assert_is_op_output("sequence_pool", "Out")->AsOutput();
+
+  // create topology.
+  *ids >> *lookup_table >> *lookup_table_out >> *sequence_pool >> *out;
+  *w >> *lookup_table;
+  *sequence_pool >> *sequence_pool_idx;
+}
+
+void EmbeddingSeqPoolFuser::InsertNewNode(SSAGraph* graph,
+                                          const key2nodes_t& matched) {
+  auto op_desc = GenOpDesc(matched);
+  auto fuse_op = LiteOpRegistry::Global().Create("fused_embedding_seq_pool");
+  auto sequence_pool = matched.at("sequence_pool")->stmt()->op();
+  auto* scope = sequence_pool->scope();
+  auto& valid_places = sequence_pool->valid_places();
+  fuse_op->Attach(op_desc, scope);
+
+  auto* new_op_node = graph->GraphCreateInstructNode(fuse_op, valid_places);
+
+  IR_NODE_LINK_TO(matched.at("ids"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("w"), new_op_node);
+  IR_NODE_LINK_TO(new_op_node, matched.at("out"));
+}
+
+cpp::OpDesc EmbeddingSeqPoolFuser::GenOpDesc(const key2nodes_t& matched) {
+  auto op_desc = *matched.at("lookup_table")->stmt()->op_info();
+  auto* pool_info = matched.at("sequence_pool")->stmt()->op_info();
+  op_desc.SetType("fused_embedding_seq_pool");
+  op_desc.SetInput("Ids", {matched.at("ids")->arg()->name});
+  op_desc.SetInput("W", {matched.at("w")->arg()->name});
+  op_desc.SetOutput("Out", {matched.at("out")->arg()->name});
+  if (!op_desc.HasAttr("padding_idx")) {
+    op_desc.SetAttr<int64_t>("padding_idx", -1);
+  }
+  op_desc.SetAttr<bool>("dequant", lookup_type_ == "lookup_table_dequant");
+  op_desc.SetAttr<std::string>("pooltype",
+                               pool_info->GetAttr<std::string>("pooltype"));
+  if (pool_info->HasAttr("pad_value")) {
+    op_desc.SetAttr<float>("pad_value", pool_info->GetAttr<float>("pad_value"));
+  }
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
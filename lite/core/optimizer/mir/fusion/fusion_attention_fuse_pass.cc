@@ -0,0 +1,57 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/fusion_attention_fuse_pass.h"
+#include <memory>
+#include <vector>
+#include "lite/core/optimizer/mir/fusion/fusion_attention_fuser.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void FusionAttentionFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  for (auto& place : graph->valid_places()) {
+    if (place.precision == PRECISION(kInt8)) {
+      return;
+    }
+  }
+  // The longer patterns first, so the optional ops are fused if any.
+  for (auto matmul_qk_type : {"matmul_v2", "matmul"}) {
+    for (auto matmul_v_type : {"matmul_v2", "matmul"}) {
+      for (auto with_transpose : {true, false}) {
+        for (auto with_mask : {true, false}) {
+          for (auto with_scale : {true, false}) {
+            fusion::FusionAttentionFuser fuser(matmul_qk_type,
+                                               matmul_v_type,
+                                               with_scale,
+                                               with_mask,
+                                               with_transpose);
+            fuser(graph.get());
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_fusion_attention_fuse_pass,
+                  paddle::lite::mir::FusionAttentionFusePass)
+    .BindTargets({TARGET(kARM), TARGET(kX86)})
+    .BindKernel("fusion_attention");
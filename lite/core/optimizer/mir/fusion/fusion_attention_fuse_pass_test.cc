@@ -0,0 +1,108 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/fusion_attention_fuse_pass.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+static void AddVar(cpp::BlockDesc* block_desc,
+                   Scope* scope,
+                   const std::string& name,
+                   const std::vector<int64_t>& shape) {
+  block_desc->AddVar<cpp::VarDesc>()->SetName(name);
+  scope->Var(name)->GetMutable<Tensor>()->Resize(shape);
+}
+
+static void AddMatmulV2(cpp::BlockDesc* block_desc,
+                        const std::string& x,
+                        const std::string& y,
+                        const std::string& out,
+                        bool trans_y) {
+  auto* op_desc = block_desc->AddOp<cpp::OpDesc>();
+  op_desc->SetType("matmul_v2");
+  op_desc->SetInput("X", {x});
+  op_desc->SetInput("Y", {y});
+  op_desc->SetOutput("Out", {out});
+  op_desc->SetAttr("trans_x", false);
+  op_desc->SetAttr("trans_y", trans_y);
+}
+
+// matmul_v2(q, k^T) -> softmax -> matmul_v2(, v), without the mask, the scale
+// and the transpose.
+TEST(fusion_attention_fuse_pass, no_mask_no_scale_no_transpose) {
+  auto program_desc = std::make_shared<cpp::ProgramDesc>();
+  auto scope = std::make_shared<Scope>();
+  std::vector<Place> valid_places{
+#ifdef LITE_WITH_ARM
+      Place{TARGET(kARM), PRECISION(kFloat)},
+#else
+      Place{TARGET(kX86), PRECISION(kFloat)},
+#endif
+  };
+  auto* block_desc = program_desc->AddBlock<cpp::BlockDesc>();
+  block_desc->ClearOps();
+  block_desc->ClearVars();
+  AddVar(block_desc, scope.get(), "q", {2, 4, 8, 16});
+  AddVar(block_desc, scope.get(), "k", {2, 4, 8, 16});
+  AddVar(block_desc, scope.get(), "v", {2, 4, 8, 16});
+  AddVar(block_desc, scope.get(), "scores", {});
+  AddVar(block_desc, scope.get(), "probs", {});
+  AddVar(block_desc, scope.get(), "out", {});
+  AddMatmulV2(block_desc, "q", "k", "scores", true);
+  auto* softmax = block_desc->AddOp<cpp::OpDesc>();
+  softmax->SetType("softmax");
+  softmax->SetInput("X", {"scores"});
+  softmax->SetOutput("Out", {"probs"});
+  softmax->SetAttr("axis", -1);
+  AddMatmulV2(block_desc, "probs", "v", "out", false);
+
+  Program program(program_desc, scope, valid_places);
+  std::unique_ptr<SSAGraph> graph(new SSAGraph());
+  graph->Build(program, valid_places);
+  FusionAttentionFusePass pass;
+  pass.Apply(graph);
+
+  std::map<std::string, int> op_types;
+  const OpInfo* attention = nullptr;
+  for (auto& node : graph->StmtTopologicalOrder()) {
+    auto* op_info = node->AsStmt().op_info();
+    op_types[op_info->Type()]++;
+    if (op_info->Type() == "fusion_attention") attention = op_info;
+  }
+  EXPECT_EQ(op_types.size(), 1u);
+  ASSERT_TRUE(attention);
+  EXPECT_EQ(attention->Input("Q"), std::vector<std::string>{"q"});
+  EXPECT_EQ(attention->Input("K"), std::vector<std::string>{"k"});
+  EXPECT_EQ(attention->Input("V"), std::vector<std::string>{"v"});
+  EXPECT_EQ(attention->Output("Out"), std::vector<std::string>{"out"});
+  EXPECT_FALSE(attention->HasInput("Mask") &&
+               !attention->Input("Mask").empty());
+  EXPECT_FLOAT_EQ(attention->GetAttr<float>("scale"), 1.f);
+  EXPECT_FALSE(attention->GetAttr<bool>("transpose_out"));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
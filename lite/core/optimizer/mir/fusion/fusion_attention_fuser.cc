@@ -0,0 +1,177 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/fusion_attention_fuser.h"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+void FusionAttentionFuser::BuildPattern() {
+  auto not_quantized = [](const Node* node) -> bool {
+    return !const_cast<Node*>(node)->stmt()->op_info()->HasAttr("enable_int8");
+  };
+  // The matmuls of q * k^T and scores * v, the alpha of the matmul v1 of
+  // q * k^T is merged into the scale.
+  auto* matmul_qk = OpNode("matmul_qk", matmul_qk_type_)
+                        ->assert_node_satisfied(not_quantized)
+                        ->AsIntermediate();
+  auto* matmul_v = OpNode("matmul_v", matmul_v_type_)
+                       ->assert_node_satisfied(not_quantized)
+                       ->AsIntermediate();
+  if (matmul_qk_type_ == "matmul_v2") {
+    matmul_qk->assert_op_attr<bool>("trans_x", false)
+        ->assert_op_attr<bool>("trans_y", true);
+  } else {
+    matmul_qk->assert_op_attr<bool>("transpose_X", false)
+        ->assert_op_attr<bool>("transpose_Y", true);
+  }
+  if (matmul_v_type_ == "matmul_v2") {
+    matmul_v->assert_op_attr<bool>("trans_x", false)
+        ->assert_op_attr<bool>("trans_y", false);
+  } else {
+    matmul_v->assert_op_attr<bool>("transpose_X", false)
+        ->assert_op_attr<bool>("transpose_Y", false)
+        ->assert_op_attr_satisfied<float>(
+            "alpha", [](float attr) { return std::fabs(attr - 1.f) < 1e-5; });
+  }
+
+  auto* q = VarNode("q")->assert_is_op_input(matmul_qk_type_, "X");
+  auto* k = VarNode("k")->assert_is_op_input(matmul_qk_type_, "Y");
+  auto* v = VarNode("v")->assert_is_op_input(matmul_v_type_, "Y");
+  auto* scores = VarNode("scores")
+                     ->assert_is_op_output(matmul_qk_type_, "Out")
+                     ->assert_only_one_output()
+                     ->AsIntermediate();
+  *q >> *matmul_qk;
+  *k >> *matmul_qk >> *scores;
+
+  if (with_scale_) {
+    auto* scale = OpNode("scale", "scale")
+                      ->assert_op_attr_satisfied<float>(
+                          "bias", [](float attr) { return attr == 0.f; })
+                      ->AsIntermediate();
+    auto* scaled = VarNode("scaled")
+                       ->assert_is_op_output("scale", "Out")
+                       ->assert_only_one_output()
+                       ->AsIntermediate();
+    scores->assert_is_op_input("scale", "X");
+    *scores >> *scale >> *scaled;
+    scores = scaled;
+  }
+  if (with_mask_) {
+    auto* mask = VarNode("mask")->assert_is_op_input("elementwise_add", "Y");
+    auto* add = OpNode("add", "elementwise_add")
+                    ->assert_op_attr<int>("axis", -1)
+                    ->AsIntermediate();
+    auto* masked = VarNode("masked")
+                       ->assert_is_op_output("elementwise_add", "Out")
+                       ->assert_only_one_output()
+                       ->AsIntermediate();
+    scores->assert_is_op_input("elementwise_add", "X");
+    *scores >> *add >> *masked;
+    *mask >> *add;
+    scores = masked;
+  }
+  auto* softmax =
+      OpNode("softmax", "softmax")
+          ->assert_op_attr_satisfied<int>("axis",
+                                          [](int attr) { return attr == -1; })
+          ->AsIntermediate();
+  auto* probs = VarNode("probs")
+                    ->assert_is_op_output("softmax", "Out")
+                    ->assert_is_op_input(matmul_v_type_, "X")
+                    ->assert_only_one_output()
+                    ->AsIntermediate();
+  scores->assert_is_op_input("softmax", "X");
+  *scores >> *softmax >> *probs;
+  *probs >> *matmul_v;
+  *v >> *matmul_v;
+
+  auto* out = VarNode("out");
+  if (with_transpose_) {
+    auto* attn = VarNode("attn")
+                     ->assert_is_op_output(matmul_v_type_, "Out")
+                     ->assert_is_op_input("transpose2", "X")
+                     ->assert_only_one_output()
+                     ->AsIntermediate();
+    auto* transpose = OpNode("transpose", "transpose2")
+                          ->assert_op_attr<std::vector<int>>(
+                              "axis", std::vector<int>({0, 2, 1, 3}))
+                          ->AsIntermediate();
+    auto* xshape = VarNode("xshape")
+                       ->assert_is_op_output("transpose2", "XShape")
+                       ->AsIntermediate();
+    out->assert_is_op_output("transpose2", "Out");
+    *matmul_v >> *attn >> *transpose >> *out;
+    *transpose >> *xshape;
+  } else {
+    out->assert_is_op_output(matmul_v_type_, "Out");
+    *matmul_v >> *out;
+  }
+}
+
+void FusionAttentionFuser::InsertNewNode(SSAGraph* graph,
+                                         const key2nodes_t& matched) {
+  auto op_desc = GenOpDesc(matched);
+  auto attention_op = LiteOpRegistry::Global().Create("fusion_attention");
+  auto matmul = matched.at("matmul_qk")->stmt()->op();
+  auto* scope = matmul->scope();
+  auto& valid_places = matmul->valid_places();
+  attention_op->Attach(op_desc, scope);
+
+  auto* new_op_node =
+      graph->GraphCreateInstructNode(attention_op, valid_places);
+
+  IR_NODE_LINK_TO(matched.at("q"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("k"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("v"), new_op_node);
+  if (with_mask_) {
+    IR_NODE_LINK_TO(matched.at("mask"), new_op_node);
+  }
+  IR_NODE_LINK_TO(new_op_node, matched.at("out"));
+}
+
+cpp::OpDesc FusionAttentionFuser::GenOpDesc(const key2nodes_t& matched) {
+  auto* matmul_qk = matched.at("matmul_qk")->stmt()->op_info();
+  float scale = 1.f;
+  if (matmul_qk_type_ == "matmul" && matmul_qk->HasAttr("alpha")) {
+    scale = matmul_qk->GetAttr<float>("alpha");
+  }
+  if (with_scale_) {
+    scale *= matched.at("scale")->stmt()->op_info()->GetAttr<float>("scale");
+  }
+
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fusion_attention");
+  op_desc.SetInput("Q", {matched.at("q")->arg()->name});
+  op_desc.SetInput("K", {matched.at("k")->arg()->name});
+  op_desc.SetInput("V", {matched.at("v")->arg()->name});
+  if (with_mask_) {
+    op_desc.SetInput("Mask", {matched.at("mask")->arg()->name});
+  }
+  op_desc.SetOutput("Out", {matched.at("out")->arg()->name});
+  op_desc.SetAttr<float>("scale", scale);
+  op_desc.SetAttr<bool>("transpose_out", with_transpose_);
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,58 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pattern_matcher_high_api.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+// Fuse the attention of the transformers
+//   matmul(q, k^T) -> [scale] -> [elementwise_add(mask)] -> softmax ->
+//   matmul(, v) -> [transpose2(0, 2, 1, 3)]
+// into a fusion_attention op, which never keeps the full attention scores.
+class FusionAttentionFuser : public FuseBase {
+ public:
+  FusionAttentionFuser(const std::string& matmul_qk_type,
+                       const std::string& matmul_v_type,
+                       bool with_scale,
+                       bool with_mask,
+                       bool with_transpose)
+      : matmul_qk_type_(matmul_qk_type),
+        matmul_v_type_(matmul_v_type),
+        with_scale_(with_scale),
+        with_mask_(with_mask),
+        with_transpose_(with_transpose) {}
+
+  void BuildPattern() override;
+  void InsertNewNode(SSAGraph* graph, const key2nodes_t& matched) override;
+
+ private:
+  cpp::OpDesc GenOpDesc(const key2nodes_t& matched) override;
+  std::string matmul_qk_type_;
+  std::string matmul_v_type_;
+  bool with_scale_;
+  bool with_mask_;
+  bool with_transpose_;
+};
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,51 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/matmul_softmax_fuse_pass.h"
+#include <memory>
+#include <vector>
+#include "lite/core/optimizer/mir/fusion/matmul_softmax_fuser.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void MatmulSoftmaxFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // only the fp32 arm and x86 kernels know fuse_softmax, keep the softmax
+  // where another matmul kernel may be picked
+  for (auto& place : graph->valid_places()) {
+    if (place.target != TARGET(kARM) && place.target != TARGET(kX86) &&
+        place.target != TARGET(kHost) && place.target != TARGET(kAny)) {
+      return;
+    }
+    if (place.target == TARGET(kARM) && place.precision != PRECISION(kFloat) &&
+        place.precision != PRECISION(kAny)) {
+      return;
+    }
+  }
+  for (auto matmul_type : {"matmul", "matmul_v2"}) {
+    fusion::MatmulSoftmaxFuser fuser(matmul_type);
+    fuser(graph.get());
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_matmul_softmax_fuse_pass,
+                  paddle::lite::mir::MatmulSoftmaxFusePass)
+    .BindTargets({TARGET(kARM), TARGET(kX86)})
+    .BindKernel("matmul");
@@ -0,0 +1,85 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/matmul_softmax_fuser.h"
+#include <memory>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+void MatmulSoftmaxFuser::BuildPattern() {
+  auto matmul_teller = [](const Node* node) -> bool {
+    auto* op_info = node->stmt()->op_info();
+    if (op_info->HasAttr("enable_int8") &&
+        op_info->GetAttr<bool>("enable_int8")) {
+      return false;
+    }
+    return !op_info->HasAttr("quantize_weight_bits");
+  };
+  auto softmax_teller = [](const Node* node) -> bool {
+    auto* op_info = node->stmt()->op_info();
+    return !op_info->HasAttr("axis") || op_info->GetAttr<int>("axis") == -1;
+  };
+
+  auto* x = VarNode("x")->assert_is_op_input(matmul_type_, "X")->AsInput();
+  auto* y = VarNode("y")->assert_is_op_input(matmul_type_, "Y")->AsInput();
+  auto* matmul = OpNode("matmul", matmul_type_)
+                     ->assert_is_op(matmul_type_)
+                     ->assert_node_satisfied(matmul_teller)
+                     ->AsIntermediate();
+  auto* matmul_out = VarNode("matmul_out")
+                         ->assert_is_op_output(matmul_type_, "Out")
+                         ->assert_is_op_input("softmax", "X")
+                         ->assert_only_one_output()
+                         ->AsIntermediate();
+  auto* softmax = OpNode("softmax", "softmax")
+                      ->assert_is_op("softmax")
+                      ->assert_node_satisfied(softmax_teller)
+                      ->AsIntermediate();
+  auto* out =
+      VarNode("output")->assert_is_op_output("softmax", "Out")->AsOutput();
+
+  std::vector<PMNode*> matmul_inputs{x, y};
+  matmul_inputs >> *matmul >> *matmul_out >> *softmax >> *out;
+}
+
+void MatmulSoftmaxFuser::InsertNewNode(SSAGraph* graph,
+                                       const key2nodes_t& matched) {
+  auto op_desc = GenOpDesc(matched);
+  auto op = LiteOpRegistry::Global().Create(matmul_type_);
+  auto old_op = matched.at("matmul")->stmt()->op();
+  auto* scope = old_op->scope();
+  auto& valid_places = old_op->valid_places();
+  op->Attach(op_desc, scope);
+  auto* new_op_node = graph->GraphCreateInstructNode(op, valid_places);
+
+  IR_NODE_LINK_TO(matched.at("x"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("y"), new_op_node);
+  IR_NODE_LINK_TO(new_op_node, matched.at("output"));
+}
+
+cpp::OpDesc MatmulSoftmaxFuser::GenOpDesc(const key2nodes_t& matched) {
+  auto op_desc = *matched.at("matmul")->stmt()->op_info();
+  op_desc.SetOutput("Out", {matched.at("output")->arg()->name});
+  op_desc.SetAttr("fuse_softmax", true);
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
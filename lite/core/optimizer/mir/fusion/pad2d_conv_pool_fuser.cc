@@ -0,0 +1,112 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/pad2d_conv_pool_fuser.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+void Pad2dConvPoolFuser::BuildPattern() {
+  // only a zero pad of constant size in NCHW is the same as the paddings of
+  // the conv or the pool
+  auto pad_teller = [](const Node* node) -> bool {
+    auto* op_info = const_cast<Node*>(node)->stmt()->op_info();
+    if (op_info->GetAttr<std::string>("mode") != "constant" ||
+        op_info->GetAttr<float>("pad_value") != 0.f ||
+        op_info->GetAttr<std::string>("data_format") != "NCHW") {
+      return false;
+    }
+    for (auto name : {"variable_padding", "variable_paddings"}) {
+      if (op_info->HasAttr(name) && op_info->GetAttr<bool>(name)) {
+        return false;
+      }
+    }
+    auto paddings = op_info->GetAttr<std::vector<int>>("paddings");
+    if (paddings.size() != 4) return false;
+    for (auto pad : paddings) {
+      if (pad < 0) return false;
+    }
+    return true;
+  };
+  // SAME computes the paddings from the input size, which the pad changes.
+  // A pool only sees the zeros when it is a non-exclusive avg pool with fixed
+  // windows that never go past the padded input.
+  auto op_teller = [](const Node* node) -> bool {
+    auto* op_info = const_cast<Node*>(node)->stmt()->op_info();
+    if (op_info->HasAttr("padding_algorithm") &&
+        op_info->GetAttr<std::string>("padding_algorithm") == "SAME") {
+      return false;
+    }
+    if (op_info->Type() != "pool2d") return true;
+    auto bool_attr = [&](const char* name) {
+      return op_info->HasAttr(name) && op_info->GetAttr<bool>(name);
+    };
+    return op_info->GetAttr<std::string>("pooling_type") == "avg" &&
+           op_info->HasAttr("exclusive") && !bool_attr("exclusive") &&
+           !bool_attr("global_pooling") && !bool_attr("adaptive") &&
+           !bool_attr("ceil_mode");
+  };
+
+  auto* pad_in = VarNode("pad_in")->assert_is_op_input("pad2d", "X")->AsInput();
+  auto* pad = OpNode("pad2d", "pad2d")
+                  ->assert_node_satisfied(pad_teller)
+                  ->AsIntermediate();
+  auto* pad_out = VarNode("pad_out")
+                      ->assert_is_op_output("pad2d", "Out")
+                      ->assert_is_op_input(op_type_, input_name_)
+                      ->assert_only_one_output()
+                      ->AsIntermediate();
+  auto* op = OpNode("op", op_type_)->assert_node_satisfied(op_teller);
+
+  *pad_in >> *pad >> *pad_out >> *op;
+}
+
+void Pad2dConvPoolFuser::InsertNewNode(SSAGraph* graph,
+                                       const key2nodes_t& matched) {
+  auto* pad_info = matched.at("pad2d")->stmt()->op_info();
+  auto pad_paddings = pad_info->GetAttr<std::vector<int>>("paddings");
+
+  auto* op_instruct = matched.at("op")->stmt();
+  auto op_desc = *op_instruct->mutable_op_info();
+  // 2-pad to 4-pad, in the order of top, bottom, left and right
+  auto paddings = op_desc.GetAttr<std::vector<int>>("paddings");
+  if (paddings.size() == 2) {
+    paddings = {paddings[0], paddings[0], paddings[1], paddings[1]};
+  }
+  CHECK_EQ(paddings.size(), 4u);
+  if (op_desc.HasAttr("padding_algorithm")) {
+    if (op_desc.GetAttr<std::string>("padding_algorithm") == "VALID") {
+      paddings.assign(4, 0);
+    }
+    op_desc.SetAttr<std::string>("padding_algorithm", "EXPLICIT");
+  }
+  for (size_t i = 0; i < 4; i++) {
+    paddings[i] += pad_paddings[i];
+  }
+  op_desc.SetAttr<std::vector<int>>("paddings", paddings);
+  op_desc.SetInput(input_name_, {matched.at("pad_in")->arg()->name});
+  op_instruct->ResetOp(op_desc, graph->valid_places());
+
+  IR_NODE_LINK_TO(matched.at("pad_in"), matched.at("op"));
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
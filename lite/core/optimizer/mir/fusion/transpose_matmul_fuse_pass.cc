@@ -0,0 +1,56 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/transpose_matmul_fuse_pass.h"
+#include <memory>
+#include <vector>
+#include "lite/core/optimizer/mir/fusion/transpose_matmul_fuser.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void TransposeMatmulFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // only the fp32 arm and x86 kernels read the strided views, keep the
+  // transposes where another matmul kernel may be picked
+  for (auto& place : graph->valid_places()) {
+    if (place.target != TARGET(kARM) && place.target != TARGET(kX86) &&
+        place.target != TARGET(kHost) && place.target != TARGET(kAny)) {
+      return;
+    }
+    if (place.target == TARGET(kARM) && place.precision != PRECISION(kFloat) &&
+        place.precision != PRECISION(kAny)) {
+      return;
+    }
+  }
+  for (auto transpose_type : {"transpose2", "transpose"}) {
+    for (auto matmul_type : {"matmul", "matmul_v2"}) {
+      for (auto matmul_arg : {"X", "Y", "Out"}) {
+        fusion::TransposeMatmulFuser fuser(
+            transpose_type, matmul_type, matmul_arg);
+        fuser(graph.get());
+      }
+    }
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_transpose_matmul_fuse_pass,
+                  paddle::lite::mir::TransposeMatmulFusePass)
+    .BindTargets({TARGET(kARM), TARGET(kX86)})
+    .BindKernel("matmul");
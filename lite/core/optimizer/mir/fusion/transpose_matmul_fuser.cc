@@ -0,0 +1,159 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/transpose_matmul_fuser.h"
+#include <memory>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+// the operands keep the last or the second last dim contiguous, so each
+// matrix is read with a leading dim, transposed or not
+static bool IsStridedOperandAxis(const std::vector<int>& axis) {
+  const int rank = axis.size();
+  return rank >= 2 &&
+         (axis[rank - 1] == rank - 1 || axis[rank - 2] == rank - 1);
+}
+
+// the output keeps its rows contiguous
+static bool IsStridedOutputAxis(const std::vector<int>& axis) {
+  const int rank = axis.size();
+  return rank >= 3 && axis[rank - 1] == rank - 1;
+}
+
+// only swaps the last two dims, which is the transpose attr of matmul
+static bool IsMatrixTransposeAxis(const std::vector<int>& axis) {
+  const int rank = axis.size();
+  for (int i = 0; i < rank - 2; ++i) {
+    if (axis[i] != i) return false;
+  }
+  return rank >= 2 && axis[rank - 2] == rank - 1 && axis[rank - 1] == rank - 2;
+}
+
+void TransposeMatmulFuser::BuildPattern() {
+  const bool output = matmul_arg_ == "Out";
+  auto transpose_teller = [output](const Node* node) -> bool {
+    auto axis = node->stmt()->op_info()->GetAttr<std::vector<int>>("axis");
+    return output ? IsStridedOutputAxis(axis) : IsStridedOperandAxis(axis);
+  };
+  const std::string fused_attr = "fused_transpose_" + matmul_arg_;
+  auto matmul_teller = [fused_attr](const Node* node) -> bool {
+    auto* op_info = node->stmt()->op_info();
+    if ((op_info->HasAttr("enable_int8") &&
+         op_info->GetAttr<bool>("enable_int8")) ||
+        op_info->HasAttr("quantize_weight_bits")) {
+      return false;
+    }
+    return !op_info->HasAttr(fused_attr) ||
+           op_info->GetAttr<std::vector<int>>(fused_attr).empty();
+  };
+
+  auto* transpose = OpNode("transpose", transpose_type_)
+                        ->assert_is_op(transpose_type_)
+                        ->assert_node_satisfied(transpose_teller)
+                        ->AsIntermediate();
+  auto* matmul = OpNode("matmul", matmul_type_)
+                     ->assert_is_op(matmul_type_)
+                     ->assert_node_satisfied(matmul_teller)
+                     ->AsIntermediate();
+  PMNode* xshape = nullptr;
+  if (transpose_type_ == "transpose2") {
+    xshape = VarNode("xshape")
+                 ->assert_is_op_output(transpose_type_, "XShape")
+                 ->AsIntermediate();
+    *transpose >> *xshape;
+  }
+
+  if (output) {
+    auto* x = VarNode("x")->assert_is_op_input(matmul_type_, "X")->AsInput();
+    auto* y = VarNode("y")->assert_is_op_input(matmul_type_, "Y")->AsInput();
+    auto* matmul_out = VarNode("matmul_out")
+                           ->assert_is_op_output(matmul_type_, "Out")
+                           ->assert_is_op_input(transpose_type_, "X")
+                           ->assert_only_one_output()
+                           ->AsIntermediate();
+    auto* out = VarNode("output")
+                    ->assert_is_op_output(transpose_type_, "Out")
+                    ->AsOutput();
+    std::vector<PMNode*> matmul_inputs{x, y};
+    matmul_inputs >> *matmul >> *matmul_out >> *transpose >> *out;
+  } else {
+    const std::string other_arg = matmul_arg_ == "X" ? "Y" : "X";
+    auto* input = VarNode("input")
+                      ->assert_is_op_input(transpose_type_, "X")
+                      ->AsInput();
+    auto* transpose_out = VarNode("transpose_out")
+                              ->assert_is_op_output(transpose_type_, "Out")
+                              ->assert_is_op_input(matmul_type_, matmul_arg_)
+                              ->assert_only_one_output()
+                              ->AsIntermediate();
+    auto* other = VarNode("other")
+                      ->assert_is_op_input(matmul_type_, other_arg)
+                      ->AsInput();
+    auto* out =
+        VarNode("output")->assert_is_op_output(matmul_type_, "Out")->AsOutput();
+    *input >> *transpose >> *transpose_out;
+    std::vector<PMNode*> matmul_inputs{transpose_out, other};
+    matmul_inputs >> *matmul >> *out;
+  }
+}
+
+void TransposeMatmulFuser::InsertNewNode(SSAGraph* graph,
+                                         const key2nodes_t& matched) {
+  auto op_desc = GenOpDesc(matched);
+  auto op = LiteOpRegistry::Global().Create(matmul_type_);
+  auto old_op = matched.at("matmul")->stmt()->op();
+  auto* scope = old_op->scope();
+  auto& valid_places = old_op->valid_places();
+  op->Attach(op_desc, scope);
+  auto* new_op_node = graph->GraphCreateInstructNode(op, valid_places);
+
+  if (matmul_arg_ == "Out") {
+    IR_NODE_LINK_TO(matched.at("x"), new_op_node);
+    IR_NODE_LINK_TO(matched.at("y"), new_op_node);
+  } else {
+    IR_NODE_LINK_TO(matched.at("input"), new_op_node);
+    IR_NODE_LINK_TO(matched.at("other"), new_op_node);
+  }
+  IR_NODE_LINK_TO(new_op_node, matched.at("output"));
+}
+
+cpp::OpDesc TransposeMatmulFuser::GenOpDesc(const key2nodes_t& matched) {
+  auto op_desc = *matched.at("matmul")->stmt()->op_info();
+  auto* transpose_op_info = matched.at("transpose")->stmt()->op_info();
+  auto axis = transpose_op_info->GetAttr<std::vector<int>>("axis");
+  if (matmul_arg_ == "Out") {
+    op_desc.SetOutput("Out", {matched.at("output")->arg()->name});
+    op_desc.SetAttr("fused_transpose_Out", axis);
+    return op_desc;
+  }
+  op_desc.SetInput(matmul_arg_, {matched.at("input")->arg()->name});
+  if (IsMatrixTransposeAxis(axis)) {
+    std::string attr = matmul_type_ == "matmul"
+                           ? "transpose_" + matmul_arg_
+                           : (matmul_arg_ == "X" ? "trans_x" : "trans_y");
+    op_desc.SetAttr(attr, !op_desc.GetAttr<bool>(attr));
+  } else {
+    op_desc.SetAttr("fused_transpose_" + matmul_arg_, axis);
+  }
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
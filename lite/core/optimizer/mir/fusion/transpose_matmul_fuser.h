@@ -0,0 +1,51 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pattern_matcher_high_api.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+// Folds the transpose or transpose2 which makes the matmul_arg, "X", "Y" or
+// "Out", of a fp32 matmul or matmul_v2 into it. A transpose of the last two
+// dims flips transpose_X or transpose_Y, the others are recorded in the
+// fused_transpose_<arg> attr and read or written as strided views.
+class TransposeMatmulFuser : public FuseBase {
+ public:
+  TransposeMatmulFuser(const std::string& transpose_type,
+                       const std::string& matmul_type,
+                       const std::string& matmul_arg)
+      : transpose_type_(transpose_type),
+        matmul_type_(matmul_type),
+        matmul_arg_(matmul_arg) {}
+  void BuildPattern() override;
+  void InsertNewNode(SSAGraph* graph, const key2nodes_t& matched) override;
+
+ private:
+  cpp::OpDesc GenOpDesc(const key2nodes_t& matched) override;
+  std::string transpose_type_;
+  std::string matmul_type_;
+  std::string matmul_arg_;
+};
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
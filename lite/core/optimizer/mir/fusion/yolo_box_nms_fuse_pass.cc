@@ -0,0 +1,229 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/yolo_box_nms_fuse_pass.h"
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+static bool IsOp(const Node* node, const std::string& type) {
+  return node->IsStmt() && node->stmt()->op_info()->Type() == type;
+}
+
+// The op that writes the var, if the var is read by one op only.
+static Node* SoleProducer(const Node* var) {
+  if (!var->IsArg() || var->arg()->is_weight || var->inlinks.size() != 1 ||
+      var->outlinks.size() != 1) {
+    return nullptr;
+  }
+  return var->inlinks.front();
+}
+
+static Node* FindArg(const Node* op, const std::string& name) {
+  for (auto* node : op->inlinks) {
+    if (node->arg()->name == name) return node;
+  }
+  for (auto* node : op->outlinks) {
+    if (node->arg()->name == name) return node;
+  }
+  return nullptr;
+}
+
+// The producers of the inputs of a concat on the axis.
+static std::vector<Node*> ConcatInputs(Node* concat, int axis) {
+  std::vector<Node*> producers;
+  const auto* op_info = concat->stmt()->op_info();
+  if (op_info->HasInput("AxisTensor") &&
+      !op_info->Input("AxisTensor").empty()) {
+    return producers;
+  }
+  int concat_axis = op_info->GetAttr<int>("axis");
+  if (concat_axis < 0) concat_axis += 3;
+  if (concat_axis != axis) return producers;
+  for (const auto& name : op_info->Input("X")) {
+    auto* var = FindArg(concat, name);
+    auto* producer = var ? SoleProducer(var) : nullptr;
+    if (!producer) return {};
+    producers.push_back(producer);
+  }
+  return producers;
+}
+
+bool YoloBoxNmsFusePass::Fuse(SSAGraph* graph, Node* nms) {
+  const auto* nms_info = nms->stmt()->op_info();
+  if ((nms_info->HasInput("RoisNum") && !nms_info->Input("RoisNum").empty()) ||
+      nms_info->GetAttr<float>("score_threshold") < 0.f) {
+    return false;
+  }
+  auto* bboxes = FindArg(nms, nms_info->Input("BBoxes").front());
+  auto* scores = FindArg(nms, nms_info->Input("Scores").front());
+  auto* boxes_concat = bboxes ? SoleProducer(bboxes) : nullptr;
+  auto* scores_concat = scores ? SoleProducer(scores) : nullptr;
+  if (!boxes_concat || !scores_concat || !IsOp(boxes_concat, "concat") ||
+      !IsOp(scores_concat, "concat")) {
+    return false;
+  }
+  auto yolo_boxes = ConcatInputs(boxes_concat, 1);
+  auto transposes = ConcatInputs(scores_concat, 2);
+  if (yolo_boxes.empty() || yolo_boxes.size() != transposes.size()) {
+    return false;
+  }
+
+  std::set<const Node*> nodes2rm{
+      nms, bboxes, scores, boxes_concat, scores_concat};
+  std::vector<std::string> x_names;
+  std::vector<int> anchors;
+  std::vector<int> anchor_nums;
+  std::vector<int> downsample_ratios;
+  std::vector<float> scales_x_y;
+  const auto* head_info = yolo_boxes.front()->stmt()->op_info();
+  const auto img_size = head_info->Input("ImgSize").front();
+  const int class_num = head_info->GetAttr<int>("class_num");
+  const float conf_thresh = head_info->GetAttr<float>("conf_thresh");
+  auto clip_bbox = [](const OpInfo* op_info) {
+    return op_info->HasAttr("clip_bbox") ? op_info->GetAttr<bool>("clip_bbox")
+                                         : true;
+  };
+  for (size_t i = 0; i < yolo_boxes.size(); i++) {
+    auto* yolo_box = yolo_boxes[i];
+    auto* transpose = transposes[i];
+    if (!IsOp(yolo_box, "yolo_box") ||
+        (!IsOp(transpose, "transpose") && !IsOp(transpose, "transpose2"))) {
+      return false;
+    }
+    const auto* op_info = yolo_box->stmt()->op_info();
+    const auto* trans_info = transpose->stmt()->op_info();
+    if (trans_info->GetAttr<std::vector<int>>("axis") !=
+        std::vector<int>({0, 2, 1})) {
+      return false;
+    }
+    // the scores of the head are transposed and concatenated in order
+    auto* head_scores = FindArg(transpose, trans_info->Input("X").front());
+    if (!head_scores || SoleProducer(head_scores) != yolo_box ||
+        head_scores->arg()->name != op_info->Output("Scores").front()) {
+      return false;
+    }
+    if (trans_info->HasOutput("XShape") &&
+        !trans_info->Output("XShape").empty()) {
+      auto* xshape = FindArg(transpose, trans_info->Output("XShape").front());
+      if (!xshape || !xshape->outlinks.empty()) return false;
+      nodes2rm.insert(xshape);
+    }
+    if (op_info->Input("ImgSize").front() != img_size ||
+        op_info->GetAttr<int>("class_num") != class_num ||
+        op_info->GetAttr<float>("conf_thresh") != conf_thresh ||
+        clip_bbox(op_info) != clip_bbox(head_info)) {
+      return false;
+    }
+    auto head_anchors = op_info->GetAttr<std::vector<int>>("anchors");
+    anchors.insert(anchors.end(), head_anchors.begin(), head_anchors.end());
+    anchor_nums.push_back(head_anchors.size() / 2);
+    downsample_ratios.push_back(op_info->GetAttr<int>("downsample_ratio"));
+    scales_x_y.push_back(op_info->HasAttr("scale_x_y")
+                             ? op_info->GetAttr<float>("scale_x_y")
+                             : 1.f);
+    x_names.push_back(op_info->Input("X").front());
+    nodes2rm.insert(yolo_box);
+    nodes2rm.insert(transpose);
+    nodes2rm.insert(head_scores);
+    nodes2rm.insert(transpose->outlinks.begin(), transpose->outlinks.end());
+    nodes2rm.insert(FindArg(yolo_box, op_info->Output("Boxes").front()));
+  }
+
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fusion_yolo_box_nms");
+  op_desc.SetInput("X", x_names);
+  op_desc.SetInput("ImgSize", {img_size});
+  std::vector<std::string> out_names;
+  for (const auto& param : {"Out", "Index", "NmsRoisNum"}) {
+    if (nms_info->HasOutput(param) && !nms_info->Output(param).empty()) {
+      op_desc.SetOutput(param, nms_info->Output(param));
+      out_names.push_back(nms_info->Output(param).front());
+    }
+  }
+  op_desc.SetAttr("anchors", anchors);
+  op_desc.SetAttr("anchor_nums", anchor_nums);
+  op_desc.SetAttr("downsample_ratios", downsample_ratios);
+  op_desc.SetAttr("scales_x_y", scales_x_y);
+  op_desc.SetAttr("class_num", class_num);
+  op_desc.SetAttr("conf_thresh", conf_thresh);
+  op_desc.SetAttr("clip_bbox", clip_bbox(head_info));
+  op_desc.SetAttr("background_label",
+                  nms_info->GetAttr<int>("background_label"));
+  op_desc.SetAttr("score_threshold",
+                  nms_info->GetAttr<float>("score_threshold"));
+  op_desc.SetAttr("nms_top_k", nms_info->GetAttr<int>("nms_top_k"));
+  op_desc.SetAttr("nms_threshold", nms_info->GetAttr<float>("nms_threshold"));
+  op_desc.SetAttr("nms_eta", nms_info->GetAttr<float>("nms_eta"));
+  op_desc.SetAttr("keep_top_k", nms_info->GetAttr<int>("keep_top_k"));
+  op_desc.SetAttr("normalized",
+                  nms_info->HasAttr("normalized")
+                      ? nms_info->GetAttr<bool>("normalized")
+                      : true);
+
+  auto nms_op = nms->stmt()->op();
+  auto* scope = nms_op->scope();
+  auto fuse_op = LiteOpRegistry::Global().Create("fusion_yolo_box_nms");
+  fuse_op->Attach(op_desc, scope);
+  auto* new_op_node =
+      graph->GraphCreateInstructNode(fuse_op, nms_op->valid_places());
+  for (const auto& name : x_names) {
+    DirectedLink(graph->RetrieveArgument(name), new_op_node);
+  }
+  DirectedLink(graph->RetrieveArgument(img_size), new_op_node);
+  for (const auto& name : out_names) {
+    DirectedLink(new_op_node, graph->RetrieveArgument(name));
+  }
+  GraphSafeRemoveNodes(graph, nodes2rm);
+  return true;
+}
+
+void YoloBoxNmsFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // the fused kernel is fp32 only, keep the fp16 and int8 ops as they are
+  for (auto& place : graph->valid_places()) {
+    if (place.target == TARGET(kARM) &&
+        (place.precision == PRECISION(kFP16) ||
+         place.precision == PRECISION(kInt8))) {
+      return;
+    }
+  }
+  std::vector<Node*> nms_nodes;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (IsOp(node, "multiclass_nms") || IsOp(node, "multiclass_nms2") ||
+        IsOp(node, "multiclass_nms3")) {
+      nms_nodes.push_back(node);
+    }
+  }
+  int fused_num = 0;
+  for (auto* nms : nms_nodes) {
+    if (Fuse(graph.get(), nms)) fused_num++;
+  }
+  VLOG(3) << "Fuse " << fused_num << " yolo_box + multiclass_nms.";
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_yolo_box_nms_fuse_pass,
+                  paddle::lite::mir::YoloBoxNmsFusePass)
+    .BindTargets({TARGET(kARM), TARGET(kX86)})
+    .BindKernel("fusion_yolo_box_nms");
@@ -0,0 +1,46 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * Fuse the post-processing of the YOLO models exported by PaddleDetection,
+ *
+ *   yolo_box (per head) -> concat (Boxes)  -----------------> multiclass_nms
+ *                       -> transpose (Scores) -> concat ---->
+ *
+ * into fusion_yolo_box_nms, which decodes the boxes whose confidence passes
+ * conf_thresh only and runs the nms on them, so the boxes and the scores of
+ * all the anchors are never written.
+ */
+class YoloBoxNmsFusePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  bool Fuse(SSAGraph* graph, Node* nms);
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -152,6 +152,17 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
         }
       }
     }
+    // The inputs and outputs of the zero copy concat and split ops are the
+    // views of each other, see concat_split_view_pass.
+    if ((op_type == "concat" || op_type == "split") &&
+        op_info->HasAttr("zero_copy") && op_info->GetAttr<bool>("zero_copy")) {
+      for (auto in_var_node : op_node->inlinks) {
+        invalid_var_names.insert(in_var_node->AsArg().name);
+      }
+      for (auto out_var_node : op_node->outlinks) {
+        invalid_var_names.insert(out_var_node->AsArg().name);
+      }
+    }
   }
 
   // non-tensor(like tensor_array) variables will not be reused
@@ -193,6 +204,103 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
   LOG(INFO) << "There are " << (*lifecycles).size() << " types device var.";
 }
 
+void MemoryOptimizePass::MergeInplaceLifeCycles(
+    SSAGraph* graph,
+    lifecycle_map_t* lifecycles,
+    std::map<std::string, std::string>* inplace_outs) {
+  // The ops whose kernels compute each element of the output from the same
+  // element of the input, so the output may be written into the input buffer,
+  // with the names of the input and the output.
+  const std::map<std::string, std::pair<std::string, std::string>>
+      inplace_ops = {{"relu", {"X", "Out"}},
+                     {"relu6", {"X", "Out"}},
+                     {"leaky_relu", {"X", "Out"}},
+                     {"sigmoid", {"X", "Out"}},
+                     {"tanh", {"X", "Out"}},
+                     {"swish", {"X", "Out"}},
+                     {"hard_swish", {"X", "Out"}},
+                     {"hard_sigmoid", {"X", "Out"}},
+                     {"exp", {"X", "Out"}},
+                     {"abs", {"X", "Out"}},
+                     {"square", {"X", "Out"}},
+                     {"sqrt", {"X", "Out"}},
+                     {"gelu", {"X", "Out"}},
+                     {"scale", {"X", "Out"}},
+                     {"clip", {"X", "Out"}},
+                     {"batch_norm", {"X", "Y"}},
+                     {"elementwise_add", {"X", "Out"}},
+                     {"elementwise_sub", {"X", "Out"}},
+                     {"elementwise_mul", {"X", "Out"}},
+                     {"elementwise_div", {"X", "Out"}},
+                     {"elementwise_max", {"X", "Out"}},
+                     {"elementwise_min", {"X", "Out"}},
+                     {"fusion_elementwise_add_activation", {"X", "Out"}},
+                     {"fusion_elementwise_sub_activation", {"X", "Out"}},
+                     {"fusion_elementwise_mul_activation", {"X", "Out"}},
+                     {"fusion_elementwise_div_activation", {"X", "Out"}},
+                     {"fusion_elementwise_max_activation", {"X", "Out"}},
+                     {"fusion_elementwise_min_activation", {"X", "Out"}}};
+  int op_index = 0;
+  for (auto& op_node : graph->StmtTopologicalOrder()) {
+    if (!op_node->IsStmt()) continue;
+    const int index = op_index++;
+    auto& stmt = op_node->AsStmt();
+    auto* op_info = stmt.op_info();
+    auto inplace_op = inplace_ops.find(op_info->Type());
+    if (inplace_op == inplace_ops.end()) continue;
+    const auto& x_args = op_info->Input(inplace_op->second.first);
+    const auto& out_args = op_info->Output(inplace_op->second.second);
+    if (x_args.size() != 1 || out_args.size() != 1) continue;
+    const auto& x = x_args.front();
+    const auto& out = out_args.front();
+    std::string root = inplace_outs->count(x) ? inplace_outs->at(x) : x;
+    if (x == out || !lifecycles->count(root) || !lifecycles->count(out)) {
+      continue;
+    }
+    // the input dies at the op which writes the output
+    auto& x_life = lifecycles->at(root);
+    const auto& out_life = lifecycles->at(out);
+    if (x_life.second != index || out_life.first != index) continue;
+    if (op_info->Type() == "batch_norm" &&
+        !(op_info->HasAttr("is_test") && op_info->GetAttr<bool>("is_test"))) {
+      continue;
+    }
+    // the buffer keeps its element type
+    const Type* x_type = nullptr;
+    const Type* out_type = nullptr;
+    for (auto* in_node : op_node->inlinks) {
+      if (in_node->AsArg().name == x) x_type = in_node->AsArg().type;
+    }
+    for (auto* out_node : op_node->outlinks) {
+      if (out_node->AsArg().name == out) out_type = out_node->AsArg().type;
+    }
+    if (!x_type || !out_type || x_type->precision() != out_type->precision()) {
+      continue;
+    }
+    // a broadcast X is smaller than the output, and the dims of the var
+    // descs may be unknown (-1) until runtime
+    if (op_info->Type().find("elementwise") != std::string::npos) {
+      auto* scope = stmt.op()->scope();
+      auto* x_var = scope->FindVar(x);
+      auto* out_var = scope->FindVar(out);
+      if (!x_var || !out_var) continue;
+      auto x_dims = x_var->Get<lite::Tensor>().dims();
+      if (x_dims.empty() || x_dims != out_var->Get<lite::Tensor>().dims()) {
+        continue;
+      }
+      bool known_dims = true;
+      for (size_t i = 0; i < x_dims.size(); i++) {
+        if (x_dims[i] <= 0) known_dims = false;
+      }
+      if (!known_dims) continue;
+    }
+    VLOG(4) << op_info->Type() << " runs in place: " << out << " -> " << x;
+    x_life.second = out_life.second;
+    lifecycles->erase(out);
+    (*inplace_outs)[out] = root;
+  }
+}
+
 void MemoryOptimizePass::MakeReusePlan(
     const lifecycle_map_t& lifecycles,
     std::map<std::string, std::string>* node2cluster) {
@@ -324,17 +432,27 @@ void MemoryOptimizePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   // We will perform the following operation:
   // 1. Collect all var's lifetime, then classify them according to the device.
   // Only the vars on the same device can be reused.
-  // 2. Make reuse plan: the vars can be reused if there is no overlap between
+  // 2. Merge the lifecycle of the output of an elementwise op, whose input
+  // dies at it, into that of the input, so that it is written in place.
+  // 3. Make reuse plan: the vars can be reused if there is no overlap between
   // them.
   // The final plan is a mapping table in which the key represents the original
   // name of var and the value in the table represents the current name of var.
-  // 3. Perform reuse plan: Replace all var's name in the model according to the
+  // 4. Perform reuse plan: Replace all var's name in the model according to the
   // mapping table.
   std::map<std::string, lifecycle_map_t> lifecycles;
   CollectLifeCycleByDevice(&lifecycles, graph.get());
   for (auto& ele : lifecycles) {
+    // only the host kernels may write into their input buffer
+    std::map<std::string, std::string> inplace_outs;
+    if (ele.first == TargetToStr(TARGET(kHost))) {
+      MergeInplaceLifeCycles(graph.get(), &ele.second, &inplace_outs);
+    }
     std::map<std::string, std::string> node2cluster;
     MakeReusePlan(ele.second, &node2cluster);
+    for (auto& out : inplace_outs) {
+      node2cluster[out.first] = node2cluster.at(out.second);
+    }
     PerformReusePlan(graph.get(), node2cluster);
   }
 }
@@ -43,6 +43,12 @@ class MemoryOptimizePass : public ProgramPass {
  private:
   void CollectLifeCycleByDevice(
       std::map<std::string, lifecycle_map_t>* lifecycles, SSAGraph*);
+  // Merges the lifecycle of the output of an op which may run in place into
+  // that of its input, if the input dies at the op. inplace_outs maps the
+  // merged outputs to the vars left in lifecycles.
+  void MergeInplaceLifeCycles(SSAGraph* graph,
+                              lifecycle_map_t* lifecycles,
+                              std::map<std::string, std::string>* inplace_outs);
   void MakeReusePlan(const lifecycle_map_t& lifecycles,
                      std::map<std::string, std::string>* node2cluster);
   void PerformReusePlan(SSAGraph* graph,
@@ -0,0 +1,61 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/mixed_precision_pass.h"
+#include <fstream>
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void MixedPrecisionPass::SetConfig(const std::string& config_path) {
+  std::ifstream fin(config_path);
+  CHECK(fin.is_open()) << "Can not open the mixed precision config "
+                       << config_path;
+  precisions_.clear();
+  std::string name;
+  std::string precision;
+  while (fin >> name >> precision) {
+    CHECK(precision == "fp32" || precision == "fp16" || precision == "int8")
+        << "Unsupported precision " << precision << " of " << name;
+    precisions_[name] = precision;
+  }
+  LOG(INFO) << "Load the precisions of " << precisions_.size()
+            << " weights from " << config_path;
+}
+
+void MixedPrecisionPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  CHECK(!precisions_.empty()) << "The mixed precision config is not set";
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    for (auto* in_node : node->inlinks) {
+      if (!in_node->arg()->is_weight) continue;
+      auto iter = precisions_.find(in_node->arg()->name);
+      if (iter == precisions_.end()) continue;
+      node->stmt()->mutable_op_info()->SetAttr<std::string>("mixed_precision",
+                                                            iter->second);
+      break;
+    }
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(mixed_precision_pass, paddle::lite::mir::MixedPrecisionPass)
+    .BindTargets({TARGET(kARM), TARGET(kX86)});
@@ -0,0 +1,45 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+/*
+ * Use mixed_precision_pass method to set the precisions of the ops with
+ * weights from a mixed precision config, which is searched by calib_bin.
+ * The op gets the attr `mixed_precision` (fp32, fp16 or int8) of its
+ * weight, then post_quant_static_pass and post_quant_dynamic_pass only
+ * quantize the int8 ops, static_kernel_pick_pass keeps the fp32 ops off the
+ * fp16 kernels and fp16_attribute_pass skips their weights.
+ */
+class MixedPrecisionPass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+  // Load the config, of which each line is `<weight name> <precision>`.
+  void SetConfig(const std::string& config_path);
+
+ private:
+  std::map<std::string, std::string> precisions_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -14,9 +14,12 @@
 
 #include "lite/core/optimizer/mir/post_quant_dynamic_pass.h"
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <memory>
+#include <set>
 #include <string>
+#include <thread>  //NOLINT
 #include <vector>
 #include "lite/api/paddle_place.h"
 #include "lite/core/optimizer/mir/pass_registry.h"
@@ -115,11 +118,16 @@ void QuantizeWeightPerChannel(const Tensor& src,
   }
 }
 
-void PostQuantDynamicPerChannel(OpInfo* op_info,
-                                Tensor* weight,
-                                const std::string weight_name,
+template void QuantizeWeightPerChannel<int8_t>(const Tensor& src,
+                                               const std::vector<float>& scales,
+                                               int quant_axis,
+                                               int8_t* dest_data);
+
+// Quantize the weight in place and return the scales of the channels
+void PostQuantDynamicPerChannel(Tensor* weight,
                                 int quant_axis,
-                                int quant_bits) {
+                                int quant_bits,
+                                std::vector<float>* scales) {
   const DDim weight_dims = weight->dims();
   CHECK(weight_dims.size() == 2 || weight_dims.size() == 4);
   CHECK(quant_axis == 0 || quant_axis == 1);
@@ -127,10 +135,9 @@ void PostQuantDynamicPerChannel(OpInfo* op_info,
 
   // get scales
   float range = (1 << (quant_bits - 1)) - 1;
-  std::vector<float> scales;
-  FindAbsMaxPerChannel(*weight, quant_axis, &scales);
+  FindAbsMaxPerChannel(*weight, quant_axis, scales);
   std::transform(
-      scales.begin(), scales.end(), scales.begin(), [&range](float x) {
+      scales->begin(), scales->end(), scales->begin(), [&range](float x) {
         return x / range;
       });
 
@@ -142,16 +149,74 @@ void PostQuantDynamicPerChannel(OpInfo* op_info,
   if (quant_bits == 8) {
     weight->set_precision(PRECISION(kInt8));
     int8_t* weight_data = weight->mutable_data<int8_t>();
-    QuantizeWeightPerChannel(tmp_tensor, scales, quant_axis, weight_data);
+    QuantizeWeightPerChannel(tmp_tensor, *scales, quant_axis, weight_data);
   } else if (quant_bits == 16) {
     weight->set_precision(PRECISION(kInt16));
     int16_t* weight_data = weight->mutable_data<int16_t>();
-    QuantizeWeightPerChannel(tmp_tensor, scales, quant_axis, weight_data);
+    QuantizeWeightPerChannel(tmp_tensor, *scales, quant_axis, weight_data);
+  }
+}
+
+const std::vector<std::string> PostQuantDynamicPass::int4_ops = {
+    "mul", "matmul_v2", "fc"};
+
+// Quantize the 2-D weight [K, N] to int4 group-wise along K in place, of
+// which the values in [-7, 7] are stored as int8, and the scales are
+// [groups, N].
+void PostQuantDynamicGroupWise(Tensor* weight,
+                               int group_size,
+                               std::vector<float>* scales) {
+  const DDim weight_dims = weight->dims();
+  CHECK_EQ(weight_dims.size(), 2UL);
+  const int64_t k = weight_dims[0];
+  const int64_t n = weight_dims[1];
+  const int64_t groups = (k + group_size - 1) / group_size;
+  const float range = 7.f;
+  const float* weight_data = weight->data<float>();
+
+  scales->assign(groups * n, 0.f);
+  for (int64_t i = 0; i < k; i++) {
+    float* group_scales = scales->data() + i / group_size * n;
+    for (int64_t j = 0; j < n; j++) {
+      group_scales[j] =
+          std::max(group_scales[j], std::fabs(weight_data[i * n + j]));
+    }
+  }
+  for (auto& scale : *scales) {
+    scale = std::max(scale, 1e-8f) / range;
+  }
+
+  Tensor tmp_tensor;
+  tmp_tensor.CopyDataFrom(*weight);
+  weight->clear();
+  weight->set_precision(PRECISION(kInt8));
+  const float* src_data = tmp_tensor.data<float>();
+  int8_t* dest_data = weight->mutable_data<int8_t>();
+  for (int64_t i = 0; i < k; i++) {
+    const float* group_scales = scales->data() + i / group_size * n;
+    for (int64_t j = 0; j < n; j++) {
+      float value = std::round(src_data[i * n + j] / group_scales[j]);
+      dest_data[i * n + j] =
+          static_cast<int8_t>(std::min(std::max(value, -range), range));
+    }
   }
-  op_info->SetAttr<std::string>("quantization_type",
-                                "post_weight_channel_wise_abs_max");
-  op_info->SetAttr("quantize_weight_bits", quant_bits);
-  op_info->SetAttr(weight_name + "_quant_scale", scales);
+}
+
+// Whether the weight of the op is the 2-D [K, N] weight of a gemm
+static bool IsInt4Weight(const OpInfo* op_info,
+                         const std::string& weight_name,
+                         const Tensor& weight) {
+  const std::string op_type = op_info->Type();
+  if (weight.dims().size() != 2) return false;
+  if (op_type == "fc") {
+    return op_info->Input("W").front() == weight_name;
+  }
+  if (op_info->Input("Y").front() != weight_name) return false;
+  if (op_type == "matmul_v2") {
+    return !op_info->GetAttr<bool>("trans_x") &&
+           !op_info->GetAttr<bool>("trans_y");
+  }
+  return op_type == "mul";
 }
 
 void PostQuantDynamicPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
@@ -160,6 +225,9 @@ void PostQuantDynamicPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
     quant_bits = 8;
   } else if (quant_type_ == lite_api::QuantType::QUANT_INT16) {
     quant_bits = 16;
+  } else if (quant_type_ == lite_api::QuantType::QUANT_INT4) {
+    // the weights not in int4_ops are quantized to int8
+    quant_bits = 8;
   } else {
     LOG(FATAL) << "Not support quant type:" << static_cast<int>(quant_type_);
   }
@@ -168,13 +236,37 @@ void PostQuantDynamicPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   for (auto* node : graph->StmtTopologicalOrder()) {
     if (node->IsStmt()) {
       const std::string op_type = node->stmt()->op_type();
-      auto iter = std::find(quant_ops.begin(), quant_ops.end(), op_type);
-      if (iter != quant_ops.end()) {
+      bool is_quant_op =
+          std::find(quant_ops.begin(), quant_ops.end(), op_type) !=
+              quant_ops.end() ||
+          (quant_type_ == lite_api::QuantType::QUANT_INT4 &&
+           std::find(int4_ops.begin(), int4_ops.end(), op_type) !=
+               int4_ops.end());
+      const OpInfo* op_info = node->stmt()->op_info();
+      // mixed_precision_pass keeps the op in float
+      if (op_info->HasAttr("mixed_precision") &&
+          op_info->GetAttr<std::string>("mixed_precision") != "int8") {
+        continue;
+      }
+      if (is_quant_op) {
         nodes.push_back(node);
       }
     }
   }
 
+  // The weights are quantized by multiple threads, and the attributes of the
+  // ops are set after that in the order of the ops.
+  struct QuantJob {
+    OpInfo* op_info;
+    Tensor* weight;
+    std::string weight_name;
+    int quant_axis;
+    // 0 for the int4 group-wise quantization
+    int quant_bits;
+    std::vector<float> scales;
+  };
+  std::vector<QuantJob> jobs;
+  std::set<std::string> quantized_weights;
   for (auto* node : nodes) {
     const std::string op_type = node->stmt()->op_type();
     OpInfo* op_info = node->stmt()->mutable_op_info();
@@ -185,19 +277,73 @@ void PostQuantDynamicPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
         std::string weight_name = in_node->arg()->name;
         Tensor* weight = scope->FindVar(weight_name)->GetMutable<Tensor>();
         CHECK(weight) << "Can not find the weight in scope.";
-        if (weight->precision() != PrecisionType::kFloat) {
+        if (weight->precision() != PrecisionType::kFloat ||
+            quantized_weights.count(weight_name)) {
           LOG(INFO) << "The dtype of weight is not fp32, "
                     << "so skip quantizing the weight of " << weight_name;
           continue;
         }
+        if (quant_type_ == lite_api::QuantType::QUANT_INT4 &&
+            std::find(int4_ops.begin(), int4_ops.end(), op_type) !=
+                int4_ops.end()) {
+          if (IsInt4Weight(op_info, weight_name, *weight)) {
+            jobs.push_back({op_info, weight, weight_name, 0, 0, {}});
+            quantized_weights.insert(weight_name);
+          }
+          continue;
+        }
         auto iter =
             std::find(quant_axis1_ops.begin(), quant_axis1_ops.end(), op_type);
         int quant_axis = iter != quant_axis1_ops.end() ? 1 : 0;
-        PostQuantDynamicPerChannel(
-            op_info, weight, weight_name, quant_axis, quant_bits);
+        jobs.push_back(
+            {op_info, weight, weight_name, quant_axis, quant_bits, {}});
+        quantized_weights.insert(weight_name);
       }
     }
   }
+
+  auto quantize = [&](QuantJob* job) {
+    if (job->quant_bits == 0) {
+      PostQuantDynamicGroupWise(job->weight, kInt4GroupSize, &job->scales);
+    } else {
+      PostQuantDynamicPerChannel(
+          job->weight, job->quant_axis, job->quant_bits, &job->scales);
+    }
+  };
+  size_t thread_num = std::min<size_t>(
+      std::max(std::thread::hardware_concurrency(), 1U), jobs.size());
+  if (thread_num > 1) {
+    std::atomic<size_t> next_job{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_num; i++) {
+      threads.emplace_back([&]() {
+        for (size_t j = next_job++; j < jobs.size(); j = next_job++) {
+          quantize(&jobs[j]);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  } else {
+    for (auto& job : jobs) {
+      quantize(&job);
+    }
+  }
+
+  for (auto& job : jobs) {
+    if (job.quant_bits == 0) {
+      job.op_info->SetAttr<std::string>("quantization_type",
+                                        "post_weight_group_wise_abs_max");
+      job.op_info->SetAttr("quantize_weight_bits", 4);
+      job.op_info->SetAttr("quantize_weight_group_size", kInt4GroupSize);
+    } else {
+      job.op_info->SetAttr<std::string>("quantization_type",
+                                        "post_weight_channel_wise_abs_max");
+      job.op_info->SetAttr("quantize_weight_bits", job.quant_bits);
+    }
+    job.op_info->SetAttr(job.weight_name + "_quant_scale", job.scales);
+  }
 }
 
 }  // namespace mir
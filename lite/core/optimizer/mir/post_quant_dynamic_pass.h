@@ -24,12 +24,29 @@
 namespace paddle {
 namespace lite {
 namespace mir {
+
+// The abs max of each channel of the weight along quant_axis 0 or 1
+void FindAbsMaxPerChannel(const Tensor& tensor,
+                          int quant_axis,
+                          std::vector<float>* res);
+
+// Quantize the weight by the scale of each channel along quant_axis
+template <typename T>
+void QuantizeWeightPerChannel(const Tensor& src,
+                              const std::vector<float>& scales,
+                              int quant_axis,
+                              T* dest_data);
+
 /*
  * Use post_quant_dynamic method to quantize the model.
  * In optimization stage, if the data type of weights is fp32, quantize the
  * weights to int8/16. So the size of the quantized weights is reduced 4x/2x.
  * In inference stage, the quantized weights are dequantized to fp32 and run
- * all ops to get output.
+ * all ops to get output, except that the int8 weights of fc and conv2d are
+ * run by the fp32 kernels on arm without dequantizing them at load.
+ * With QUANT_INT4, the 2-D weights of int4_ops are quantized to int4
+ * group-wise along K, which are run by the fp32 kernels of fc and matmul_v2
+ * on arm without dequantizing them at load.
  */
 class PostQuantDynamicPass : public ProgramPass {
  public:
@@ -39,6 +56,11 @@ class PostQuantDynamicPass : public ProgramPass {
   // For the ops in quant_axis1_ops, the quantized axis is 1.
   // Default, quant_axis1_ops = {"mul", "lookup_table"}
   static const std::vector<std::string> quant_axis1_ops;
+  // For QUANT_INT4, the weights of int4_ops are quantized group-wise.
+  // Default, int4_ops = {"mul", "matmul_v2", "fc"}
+  static const std::vector<std::string> int4_ops;
+  // The number of the rows of K sharing a scale of int4.
+  static const int kInt4GroupSize = 64;
 
  public:
   void Apply(const std::unique_ptr<SSAGraph>& graph) override;
@@ -0,0 +1,237 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/post_quant_static_pass.h"
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/post_quant_dynamic_pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+const std::vector<std::string> PostQuantStaticPass::quant_ops = {
+    "conv2d", "depthwise_conv2d", "mul", "matmul", "matmul_v2"};
+
+void PostQuantStaticPass::SetCalibTable(const std::string& calib_table) {
+  std::ifstream fin(calib_table);
+  CHECK(fin.is_open()) << "Can not open the calibration table "
+                       << calib_table;
+  thresholds_.clear();
+  mins_.clear();
+  std::string line;
+  while (std::getline(fin, line)) {
+    std::istringstream sin(line);
+    std::string name;
+    float threshold, min;
+    if (!(sin >> name >> threshold)) continue;
+    thresholds_[name] = threshold;
+    if (sin >> min) mins_[name] = min;
+  }
+  LOG(INFO) << "Load " << thresholds_.size() << " thresholds from "
+            << calib_table;
+}
+
+// The names of the activation and the weight of a quant op, and the axis of
+// the output channels of the weight. Return false if the op can not be
+// quantized.
+static bool GetQuantArgs(const OpInfo* op_info,
+                         std::string* act_name,
+                         std::string* weight_name,
+                         int* quant_axis) {
+  const std::string op_type = op_info->Type();
+  if (std::find(PostQuantStaticPass::quant_ops.begin(),
+                PostQuantStaticPass::quant_ops.end(),
+                op_type) == PostQuantStaticPass::quant_ops.end()) {
+    return false;
+  }
+  if (op_type == "conv2d" || op_type == "depthwise_conv2d") {
+    *act_name = op_info->Input("Input").front();
+    *weight_name = op_info->Input("Filter").front();
+    *quant_axis = 0;
+    return true;
+  }
+  *act_name = op_info->Input("X").front();
+  *weight_name = op_info->Input("Y").front();
+  *quant_axis = 1;
+  if (op_type == "matmul") {
+    return !op_info->GetAttr<bool>("transpose_X") &&
+           !op_info->GetAttr<bool>("transpose_Y");
+  }
+  if (op_type == "matmul_v2") {
+    return !op_info->GetAttr<bool>("trans_x") &&
+           !op_info->GetAttr<bool>("trans_y");
+  }
+  return true;
+}
+
+// Whether the ARM int8 kernel of the op folds the zero point of the
+// asymmetric int8 activation into the bias. The padded conv can not, as the
+// padding would be the zero point rather than zero.
+static bool FoldsZeroPoint(const OpInfo* op_info) {
+  const std::string op_type = op_info->Type();
+  if (op_type == "mul") return true;
+  if (op_type != "conv2d" && op_type != "depthwise_conv2d") return false;
+  if (op_info->HasAttr("padding_algorithm") &&
+      op_info->GetAttr<std::string>("padding_algorithm") == "SAME") {
+    return false;
+  }
+  auto paddings = op_info->GetAttr<std::vector<int>>("paddings");
+  return std::all_of(
+      paddings.begin(), paddings.end(), [](int pad) { return pad == 0; });
+}
+
+void PostQuantStaticPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  CHECK(!thresholds_.empty()) << "The calibration table is not set";
+  const int bit_length = 8;
+  const float range = (1 << (bit_length - 1)) - 1;
+
+  // the thresholds of the outputs of all the ops
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    auto* op_info = node->stmt()->mutable_op_info();
+    bool single_output = op_info->output_vars().size() == 1;
+    for (auto* out_node : node->outlinks) {
+      const std::string& out_name = out_node->arg()->name;
+      auto iter = thresholds_.find(out_name);
+      if (iter == thresholds_.end()) continue;
+      std::string argname;
+      int index;
+      if (single_output) {
+        op_info->SetAttr<float>("out_threshold", iter->second);
+      } else if (op_info->GetOutputArgname(out_name, &argname) &&
+                 op_info->GetOutputIndex(out_name, &index)) {
+        op_info->SetAttr<float>(argname + to_string(index) + "_threshold",
+                                iter->second);
+      }
+    }
+  }
+
+  // the op is quantized if its activation is calibrated and its weight is
+  // a fp32 weight, which is only used by such ops
+  auto quantizable = [&](mir::Node* node,
+                         std::string* act_name,
+                         std::string* weight_name,
+                         int* quant_axis) {
+    auto* op_info = node->stmt()->op_info();
+    if (op_info->HasAttr("enable_int8") &&
+        op_info->GetAttr<bool>("enable_int8")) {
+      return false;
+    }
+    // mixed_precision_pass keeps the op in float
+    if (op_info->HasAttr("mixed_precision") &&
+        op_info->GetAttr<std::string>("mixed_precision") != "int8") {
+      return false;
+    }
+    if (!GetQuantArgs(op_info, act_name, weight_name, quant_axis)) {
+      return false;
+    }
+    auto iter = thresholds_.find(*act_name);
+    return iter != thresholds_.end() && iter->second > 0.f;
+  };
+
+  // the non-negative activations quantized asymmetrically
+  std::set<std::string> asym_acts;
+  bool arm_int8 = false;
+  for (auto& place : graph->valid_places()) {
+    arm_int8 |= place.target == TARGET(kARM) &&
+                place.precision == PRECISION(kInt8);
+  }
+  for (auto& node : graph->mutable_nodes()) {
+    if (!arm_int8 || !node.IsArg()) continue;
+    const std::string& name = node.arg()->name;
+    auto iter = mins_.find(name);
+    if (iter == mins_.end() || iter->second < 0.f) continue;
+    bool folds = true;
+    for (auto* out_node : node.outlinks) {
+      std::string act_name, weight_name;
+      int quant_axis;
+      if (quantizable(out_node, &act_name, &weight_name, &quant_axis) &&
+          act_name == name) {
+        folds &= FoldsZeroPoint(out_node->stmt()->op_info());
+      }
+    }
+    if (folds) asym_acts.insert(name);
+  }
+
+  std::map<std::string, std::vector<float>> weight_scales;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    auto* op_info = node->stmt()->mutable_op_info();
+    std::string act_name, weight_name;
+    int quant_axis;
+    if (!quantizable(node, &act_name, &weight_name, &quant_axis)) continue;
+
+    if (!weight_scales.count(weight_name)) {
+      mir::Node* weight_node = nullptr;
+      for (auto* in_node : node->inlinks) {
+        if (in_node->arg()->name == weight_name) weight_node = in_node;
+      }
+      if (!weight_node || !weight_node->arg()->is_weight) continue;
+      bool shared_by_quant_ops = true;
+      for (auto* out_node : weight_node->outlinks) {
+        std::string other_act, other_weight;
+        int other_axis;
+        shared_by_quant_ops &=
+            quantizable(out_node, &other_act, &other_weight, &other_axis) &&
+            other_weight == weight_name && other_axis == quant_axis;
+      }
+      auto* scope = node->stmt()->op()->scope();
+      auto* weight = scope->FindVar(weight_name)->GetMutable<Tensor>();
+      const size_t rank = weight->dims().size();
+      if (!shared_by_quant_ops ||
+          weight->precision() != PrecisionType::kFloat ||
+          (quant_axis == 0 && rank != 4) || (quant_axis == 1 && rank != 2)) {
+        continue;
+      }
+      std::vector<float> scales;
+      FindAbsMaxPerChannel(*weight, quant_axis, &scales);
+      for (auto& scale : scales) {
+        scale = std::max(scale, 1e-8f) / range;
+      }
+      Tensor tmp_tensor;
+      tmp_tensor.CopyDataFrom(*weight);
+      weight->clear();
+      weight->set_precision(PRECISION(kInt8));
+      QuantizeWeightPerChannel(
+          tmp_tensor, scales, quant_axis, weight->mutable_data<int8_t>());
+      weight_scales[weight_name] = scales;
+    }
+
+    op_info->SetAttr("enable_int8", true);
+    op_info->SetAttr<int>("bit_length", bit_length);
+    if (asym_acts.count(act_name)) {
+      op_info->SetInputScale(act_name, {thresholds_[act_name] / (2 * range)});
+      op_info->SetAttr<int>(act_name + "_zero_point",
+                            -static_cast<int>(range));
+    } else {
+      op_info->SetInputScale(act_name, {thresholds_[act_name] / range});
+    }
+    op_info->SetInputScale(weight_name, weight_scales[weight_name]);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(post_quant_static_pass,
+                  paddle::lite::mir::PostQuantStaticPass)
+    .BindTargets({TARGET(kAny)});
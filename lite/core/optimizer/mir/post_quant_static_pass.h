@@ -0,0 +1,58 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+/*
+ * Use post_quant_static method to quantize the model with the thresholds of
+ * the activations collected by running a calibration dataset (calib_bin).
+ * The ops in quant_ops whose inputs are calibrated are marked as int8 ops in
+ * the same way as the ops fused from the fake quant ops, and their weights
+ * are quantized to int8 per channel. The outputs of all the ops get their
+ * thresholds, so quantization_parameters_propagation_pass can compute the
+ * output scales and the model runs in int8 end-to-end.
+ * On ARM, the non-negative activations, e.g. the outputs of relu, are
+ * quantized asymmetrically with the zero point -127 to use all the 255
+ * levels, if all their int8 consumers fold the zero point into the bias.
+ */
+class PostQuantStaticPass : public ProgramPass {
+ public:
+  // Default, quant_ops = {"conv2d", "depthwise_conv2d", "mul", "matmul",
+  // "matmul_v2"}
+  static const std::vector<std::string> quant_ops;
+
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+  // Load the calibration table, of which each line is
+  // `<variable name> <threshold> [<min>]`, the threshold is the abs max to
+  // keep, and the optional min is the min value of the variable.
+  void SetCalibTable(const std::string& calib_table);
+
+ private:
+  std::map<std::string, float> thresholds_;
+  std::map<std::string, float> mins_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,76 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// Lists the calib ops left in the optimized graph, the casts around the ops
+// without a kernel of the inference precision, with the size of the casted
+// tensors, so the missing kernels costing the most are easy to find. The
+// sizes come from the var descs and the dynamic dims are shown as -1.
+class PrecisionCastReportPass : public DebugPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override {
+    int count = 0;
+    int64_t elements = 0;
+    for (auto* node : graph->StmtTopologicalOrder()) {
+      auto& stmt = node->AsStmt();
+      const std::string op_type = stmt.op_type();
+      if (op_type != "calib" && op_type != "calib_once") continue;
+      if (node->inlinks.empty() || node->outlinks.empty()) continue;
+      auto* in = node->inlinks.front();
+      auto* out = node->outlinks.front();
+      std::string consumers;
+      for (auto* op : out->outlinks) {
+        if (!op->IsStmt()) continue;
+        consumers += (consumers.empty() ? "" : ", ") + op->AsStmt().op_type();
+      }
+      DDim dims;
+      auto* var = stmt.op()->scope()->FindVar(in->AsArg().name);
+      if (var && var->IsType<lite::Tensor>()) {
+        dims = var->Get<lite::Tensor>().dims();
+      }
+      int64_t numel = dims.empty() ? 0 : dims.production();
+      if (numel > 0) elements += numel;
+      LOG(INFO) << "precision cast " << op_type << ": " << in->AsArg().name
+                << " " << PrecisionName(in) << " -> " << PrecisionName(out)
+                << ", dims " << dims.repr() << ", for " << consumers;
+      count++;
+    }
+    if (count > 0) {
+      LOG(INFO) << "precision casts: " << count
+                << ", elements of the static shapes: " << elements;
+    }
+  }
+
+ private:
+  static std::string PrecisionName(Node* arg) {
+    auto* type = arg->AsArg().type;
+    return type ? lite_api::PrecisionToStr(type->precision()) : "unk";
+  }
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(precision_cast_report_pass,
+                  paddle::lite::mir::PrecisionCastReportPass)
+    .BindTargets({TARGET(kAny)});
@@ -15,10 +15,12 @@
 // This pass intends to improve the latency performance of the convolutional
 // operations with the kernel size of 1x1. In practice, the pass requires the
 // convolutional weights to be sparse. And, the sparser the weights
-// are, the more latency improvement we would potentially obtain.
+// are, the more latency improvement we would potentially obtain. The fc and
+// matmul_v2 with the sparse weights are computed by the same kernels.
 
 #include "lite/core/optimizer/mir/sparse_conv_detect_pass.h"
 #include <math.h>
+#include <algorithm>
 #include <list>
 #include <memory>
 #include <string>
@@ -31,6 +33,25 @@ namespace paddle {
 namespace lite {
 namespace mir {
 
+namespace {
+// The min sparse degree of the sparse fc.
+const float kSparseFcMinThreshold = 0.7f;
+
+// w_trans[n x k] = w[k x n]^T
+template <typename T>
+void TransposeWeight(const lite::Tensor& w, lite::Tensor* w_trans) {
+  int k = w.dims()[0];
+  int n = w.dims()[1];
+  const T* din = w.data<T>();
+  T* dout = w_trans->mutable_data<T>();
+  for (int i = 0; i < k; i++) {
+    for (int j = 0; j < n; j++) {
+      dout[j * k + i] = din[i * n + j];
+    }
+  }
+}
+}  // namespace
+
 template <typename T>
 int SparseConvDetectPass::ComputeSparseWeight(
     const lite::Tensor* w_tensor,
@@ -602,254 +623,410 @@ void SparseConvDetectPass::CopyOutputScaleFromOpInfo(cpp::OpDesc* op_desc,
   }
 }
 
-void SparseConvDetectPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
-  for (auto& node : graph->StmtTopologicalOrder()) {
-    if (node->IsStmt() && node->AsStmt().op_type() == "conv2d") {
-      auto* scope = node->stmt()->op()->scope();
-      auto conv_op_desc = node->stmt()->mutable_op_info();
-      auto x = conv_op_desc->Input("Input").front();
-      auto w = conv_op_desc->Input("Filter").front();
-      auto y = conv_op_desc->Output("Output").front();
-      auto x_tensor = scope->FindVar(x)->Get<lite::Tensor>();
-      auto w_tensor = scope->FindVar(w)->Get<lite::Tensor>();
-      auto x_dims = x_tensor.dims();
-      auto weight_dims = w_tensor.dims();
-      auto groups = conv_op_desc->GetAttr<int>("groups");
-      auto strides = conv_op_desc->GetAttr<std::vector<int>>("strides");
-      auto paddings = conv_op_desc->GetAttr<std::vector<int>>("paddings");
-      auto ch_out = weight_dims[0];
-      auto ch_in = weight_dims[1] * groups;
-      auto kh = weight_dims[2];
-      auto kw = weight_dims[3];
-      auto im_size = x_dims[2] * x_dims[3];
-      int weight_num = ch_out * ch_in * kh * kw;
-      bool use_int8 = (w_tensor.precision() == PrecisionType::kInt8);
-      bool use_fp32 = (w_tensor.precision() == PrecisionType::kFloat);
-      if (!(use_int8 || use_fp32)) {
-        VLOG(4) << "The sparse conv detect pass now only support fp32 and int8";
-        continue;
-      }
-      if (!(kw == 1 && kh == 1)) {
-        VLOG(4) << "The kernel size of the supported sparse conv must be 1x1";
-        continue;
-      }
-      if (groups != 1) {
-        VLOG(4) << "The groups of the supported sparse conv must be 1";
-        continue;
-      }
-      if (!(strides[0] == 1 && strides[1] == 1)) {
-        VLOG(4) << "The strides of the supported sparse conv must be 1";
-        continue;
-      }
-      if (!(paddings[0] == 0 && paddings[1] == 0)) {
-        VLOG(4) << "The paddings of the supported sparse conv must be 0";
-        continue;
-      }
-      if (!(ch_out > 0 && ch_in > 0)) {
-        VLOG(4) << "The input and output channels must be larger than 0";
-        continue;
-      }
-      int zero_num;
-      int num_build_nonzeroes = 0;
-      int count_nonzeroes = 0;
-      int count_channels = 0;
-      int count_blocks = 0;
-      int flag_semi = 0;
-      if (use_fp32) {
-        zero_num = ComputeSemiSparseZeros<float>(&w_tensor,
-                                                 &count_nonzeroes,
-                                                 &count_channels,
-                                                 &count_blocks,
-                                                 &flag_semi,
-                                                 ch_out,
-                                                 ch_in);
-        if (flag_semi == 0) {
-          zero_num = ComputeSparseZeros<float>(
-              &w_tensor, &num_build_nonzeroes, ch_out, ch_in);
-        }
-      } else if (use_int8) {
-        zero_num = ComputeSemiSparseZeros<int8_t>(&w_tensor,
-                                                  &count_nonzeroes,
-                                                  &count_channels,
-                                                  &count_blocks,
-                                                  &flag_semi,
-                                                  ch_out,
-                                                  ch_in);
-      }
-      int nonzero_num = weight_num - zero_num;
-      VLOG(4) << "zero_num: " << zero_num << "weight_num: " << weight_num;
-      float sparse_zero_percent =
-          static_cast<float>(zero_num) / static_cast<float>(weight_num);
-      VLOG(4) << "sparse zero num percent: " << sparse_zero_percent;
-      if (sparse_zero_percent < sparse_threshold_) {
-        VLOG(4) << "The sparse degree of the sparse conv must be greater than "
-                   "sparse_threshold: "
-                << sparse_threshold_;
-        continue;
-      }
-      auto nonzeros_output_name =
-          string_format("%s_nonzeros_output", w.c_str());
-      auto oc_nonzeros_name = string_format("%s_oc_nonzeros", w.c_str());
-      auto ic_diffs_name = string_format("%s_ic_diffs", w.c_str());
-      auto* nonzeros_output_arg = graph->NewArgumentNode(nonzeros_output_name);
-      auto* oc_nonzeros_arg = graph->NewArgumentNode(oc_nonzeros_name);
-      auto* ic_diffs_arg = graph->NewArgumentNode(ic_diffs_name);
-      nonzeros_output_arg->AsArg().is_persist = true;
-      nonzeros_output_arg->AsArg().is_weight = true;
-      oc_nonzeros_arg->AsArg().is_persist = true;
-      oc_nonzeros_arg->AsArg().is_weight = true;
-      ic_diffs_arg->AsArg().is_persist = true;
-      ic_diffs_arg->AsArg().is_weight = true;
-
-      auto* nonzeros_output_t =
-          scope->Var(nonzeros_output_name)->GetMutable<Tensor>();
-      auto* oc_nonzeros_t = scope->Var(oc_nonzeros_name)->GetMutable<Tensor>();
-      auto* ic_diffs_t = scope->Var(ic_diffs_name)->GetMutable<Tensor>();
-      if (use_fp32) {
-        if (flag_semi == 1) {
-          nonzeros_output_t->Resize({count_nonzeroes});
-          oc_nonzeros_t->Resize({ch_out});
-          ic_diffs_t->Resize({count_blocks});
-        } else {
-          nonzeros_output_t->Resize({num_build_nonzeroes});
-          oc_nonzeros_t->Resize({ch_out});
-          ic_diffs_t->Resize({num_build_nonzeroes});
-        }
-      } else if (use_int8) {
-        if (flag_semi == 1) {
-          nonzeros_output_t->Resize({count_nonzeroes});
-          oc_nonzeros_t->Resize({ch_out});
-          ic_diffs_t->Resize({count_blocks});
-        } else {
-          nonzeros_output_t->Resize({count_nonzeroes});
-          oc_nonzeros_t->Resize({ch_out});
-          ic_diffs_t->Resize({count_nonzeroes});
-        }
-      }
-      int first_ic;
-      if (use_fp32) {
-        if (flag_semi == 1) {
-          first_ic = ComputeSemiSparseWeight<float>(&w_tensor,
-                                                    ch_out,
-                                                    ch_in,
-                                                    im_size,
-                                                    count_nonzeroes,
-                                                    count_channels,
-                                                    count_blocks,
-                                                    nonzeros_output_t,
-                                                    oc_nonzeros_t,
-                                                    ic_diffs_t);
-        } else {
-          first_ic = ComputeSparseWeight<float>(&w_tensor,
-                                                ch_out,
-                                                ch_in,
-                                                im_size,
-                                                nonzero_num,
-                                                num_build_nonzeroes,
+bool SparseConvDetectPass::CreateSparseWeights(
+    SSAGraph* graph,
+    Scope* scope,
+    const lite::Tensor& w_tensor,
+    const std::string& w,
+    const int M,
+    const int K,
+    const int N,
+    const float threshold,
+    cpp::OpDesc* op_desc,
+    std::vector<Node*>* weight_args) {
+  bool use_int8 = (w_tensor.precision() == PrecisionType::kInt8);
+  bool use_fp32 = (w_tensor.precision() == PrecisionType::kFloat);
+  if (!(use_int8 || use_fp32)) {
+    VLOG(4) << "The sparse conv detect pass now only support fp32 and int8";
+    return false;
+  }
+  if (!(M > 0 && K > 0)) {
+    VLOG(4) << "The input and output channels must be larger than 0";
+    return false;
+  }
+  int weight_num = M * K;
+  int zero_num;
+  int num_build_nonzeroes = 0;
+  int count_nonzeroes = 0;
+  int count_channels = 0;
+  int count_blocks = 0;
+  int flag_semi = 0;
+  if (use_fp32) {
+    zero_num = ComputeSemiSparseZeros<float>(&w_tensor,
+                                             &count_nonzeroes,
+                                             &count_channels,
+                                             &count_blocks,
+                                             &flag_semi,
+                                             M,
+                                             K);
+    if (flag_semi == 0) {
+      zero_num =
+          ComputeSparseZeros<float>(&w_tensor, &num_build_nonzeroes, M, K);
+    }
+  } else if (use_int8) {
+    zero_num = ComputeSemiSparseZeros<int8_t>(&w_tensor,
+                                              &count_nonzeroes,
+                                              &count_channels,
+                                              &count_blocks,
+                                              &flag_semi,
+                                              M,
+                                              K);
+  }
+  int nonzero_num = weight_num - zero_num;
+  VLOG(4) << "zero_num: " << zero_num << "weight_num: " << weight_num;
+  float sparse_zero_percent =
+      static_cast<float>(zero_num) / static_cast<float>(weight_num);
+  VLOG(4) << "sparse zero num percent: " << sparse_zero_percent;
+  if (sparse_zero_percent < threshold) {
+    VLOG(4) << "The sparse degree of the sparse conv must be greater than "
+               "sparse_threshold: "
+            << threshold;
+    return false;
+  }
+  auto nonzeros_output_name = string_format("%s_nonzeros_output", w.c_str());
+  auto oc_nonzeros_name = string_format("%s_oc_nonzeros", w.c_str());
+  auto ic_diffs_name = string_format("%s_ic_diffs", w.c_str());
+  auto* nonzeros_output_arg = graph->NewArgumentNode(nonzeros_output_name);
+  auto* oc_nonzeros_arg = graph->NewArgumentNode(oc_nonzeros_name);
+  auto* ic_diffs_arg = graph->NewArgumentNode(ic_diffs_name);
+  nonzeros_output_arg->AsArg().is_persist = true;
+  nonzeros_output_arg->AsArg().is_weight = true;
+  oc_nonzeros_arg->AsArg().is_persist = true;
+  oc_nonzeros_arg->AsArg().is_weight = true;
+  ic_diffs_arg->AsArg().is_persist = true;
+  ic_diffs_arg->AsArg().is_weight = true;
+
+  auto* nonzeros_output_t =
+      scope->Var(nonzeros_output_name)->GetMutable<Tensor>();
+  auto* oc_nonzeros_t = scope->Var(oc_nonzeros_name)->GetMutable<Tensor>();
+  auto* ic_diffs_t = scope->Var(ic_diffs_name)->GetMutable<Tensor>();
+  if (use_fp32) {
+    if (flag_semi == 1) {
+      nonzeros_output_t->Resize({count_nonzeroes});
+      oc_nonzeros_t->Resize({M});
+      ic_diffs_t->Resize({count_blocks});
+    } else {
+      nonzeros_output_t->Resize({num_build_nonzeroes});
+      oc_nonzeros_t->Resize({M});
+      ic_diffs_t->Resize({num_build_nonzeroes});
+    }
+  } else if (use_int8) {
+    if (flag_semi == 1) {
+      nonzeros_output_t->Resize({count_nonzeroes});
+      oc_nonzeros_t->Resize({M});
+      ic_diffs_t->Resize({count_blocks});
+    } else {
+      nonzeros_output_t->Resize({count_nonzeroes});
+      oc_nonzeros_t->Resize({M});
+      ic_diffs_t->Resize({count_nonzeroes});
+    }
+  }
+  int first_ic;
+  if (use_fp32) {
+    if (flag_semi == 1) {
+      first_ic = ComputeSemiSparseWeight<float>(&w_tensor,
+                                                M,
+                                                K,
+                                                N,
+                                                count_nonzeroes,
+                                                count_channels,
+                                                count_blocks,
                                                 nonzeros_output_t,
                                                 oc_nonzeros_t,
                                                 ic_diffs_t);
-        }
-      } else if (use_int8) {
-        if (flag_semi == 1) {
-          first_ic = ComputeSemiSparseWeight<int8_t>(&w_tensor,
-                                                     ch_out,
-                                                     ch_in,
-                                                     im_size,
-                                                     count_nonzeroes,
-                                                     count_channels,
-                                                     count_blocks,
-                                                     nonzeros_output_t,
-                                                     oc_nonzeros_t,
-                                                     ic_diffs_t);
-        } else {
-          first_ic = ComputeSparseWeight<int8_t>(&w_tensor,
-                                                 ch_out,
-                                                 ch_in,
-                                                 im_size,
-                                                 nonzero_num,
+    } else {
+      first_ic = ComputeSparseWeight<float>(&w_tensor,
+                                            M,
+                                            K,
+                                            N,
+                                            nonzero_num,
+                                            num_build_nonzeroes,
+                                            nonzeros_output_t,
+                                            oc_nonzeros_t,
+                                            ic_diffs_t);
+    }
+  } else if (use_int8) {
+    if (flag_semi == 1) {
+      first_ic = ComputeSemiSparseWeight<int8_t>(&w_tensor,
+                                                 M,
+                                                 K,
+                                                 N,
+                                                 count_nonzeroes,
+                                                 count_channels,
+                                                 count_blocks,
                                                  nonzeros_output_t,
                                                  oc_nonzeros_t,
                                                  ic_diffs_t);
-        }
-      }
-      VLOG(4) << "zero_num: " << zero_num << " weight_num: " << weight_num
-              << " first_ic: " << first_ic;
-      nonzeros_output_t->set_persistable(true);
-      oc_nonzeros_t->set_persistable(true);
-      ic_diffs_t->set_persistable(true);
-      if (use_fp32)
-        nonzeros_output_t->set_precision(PRECISION(kFloat));
-      else if (use_int8)
-        nonzeros_output_t->set_precision(PRECISION(kInt8));
-      oc_nonzeros_t->set_precision(PRECISION(kInt32));
-      ic_diffs_t->set_precision(PRECISION(kInt32));
-      auto sparse_conv2d_op = LiteOpRegistry::Global().Create("sparse_conv2d");
-      cpp::OpDesc op_desc;
-      op_desc.SetType("sparse_conv2d");
-      op_desc.SetInput("Input", {x});
-      op_desc.SetInput("NonZeroWeights", {nonzeros_output_name});
-      op_desc.SetInput("OcNonZeros", {oc_nonzeros_name});
-      op_desc.SetInput("Diffs", {ic_diffs_name});
-      bool has_bias = conv_op_desc->HasInput("Bias") &&
-                      conv_op_desc->Input("Bias").size() > 0;
-      if (has_bias) {
-        auto b = conv_op_desc->Input("Bias").front();
-        op_desc.SetInput("Bias", {b});
-      }
-      op_desc.SetOutput("Output", {y});
-      if (use_int8) {
-        if (!(conv_op_desc->HasAttr("enable_int8")))
-          conv_op_desc->SetAttr<bool>("enable_int8", true);
-        else if (conv_op_desc->GetAttr<bool>("enable_int8") == false)
-          conv_op_desc->SetAttr<bool>("enable_int8", true);
+    } else {
+      first_ic = ComputeSparseWeight<int8_t>(&w_tensor,
+                                             M,
+                                             K,
+                                             N,
+                                             nonzero_num,
+                                             nonzeros_output_t,
+                                             oc_nonzeros_t,
+                                             ic_diffs_t);
+    }
+  }
+  VLOG(4) << "zero_num: " << zero_num << " weight_num: " << weight_num
+          << " first_ic: " << first_ic;
+  nonzeros_output_t->set_persistable(true);
+  oc_nonzeros_t->set_persistable(true);
+  ic_diffs_t->set_persistable(true);
+  if (use_fp32)
+    nonzeros_output_t->set_precision(PRECISION(kFloat));
+  else if (use_int8)
+    nonzeros_output_t->set_precision(PRECISION(kInt8));
+  oc_nonzeros_t->set_precision(PRECISION(kInt32));
+  ic_diffs_t->set_precision(PRECISION(kInt32));
+  op_desc->SetInput("NonZeroWeights", {nonzeros_output_name});
+  op_desc->SetInput("OcNonZeros", {oc_nonzeros_name});
+  op_desc->SetInput("Diffs", {ic_diffs_name});
+  op_desc->SetAttr<int>("first_ic", first_ic);
+  op_desc->SetAttr<int>("flag_semi", flag_semi);
+  *weight_args = {nonzeros_output_arg, oc_nonzeros_arg, ic_diffs_arg};
+  return true;
+}
+
+void SparseConvDetectPass::ReplaceWithSparseOp(
+    SSAGraph* graph,
+    Node* node,
+    const cpp::OpDesc& op_desc,
+    const std::vector<Node*>& weight_args) {
+  auto sparse_op = LiteOpRegistry::Global().Create(op_desc.Type());
+  sparse_op->Attach(op_desc, node->stmt()->op()->scope());
+  auto* sparse_op_node =
+      graph->GraphCreateInstructNode(sparse_op, graph->valid_places());
+  for (auto iter = node->inlinks.begin(); iter != node->inlinks.end();) {
+    auto it =
+        std::find((*iter)->outlinks.begin(), (*iter)->outlinks.end(), node);
+    if (it != (*iter)->outlinks.end()) {
+      (*iter)->outlinks.erase(it);
+    }
+    bool is_weight = (*iter)->IsArg() && (*iter)->AsArg().is_weight;
+    if (!is_weight) {
+      DirectedLink(*iter, sparse_op_node);
+    } else {
+      graph->RemoveNode((*iter));
+    }
+    iter = node->inlinks.erase(iter);
+  }
+  for (auto* weight_arg : weight_args) {
+    DirectedLink(weight_arg, sparse_op_node);
+  }
+  for (auto iter = node->outlinks.begin(); iter != node->outlinks.end();) {
+    DirectedLink(sparse_op_node, *iter);
+    auto it =
+        std::find((*iter)->inlinks.begin(), (*iter)->inlinks.end(), node);
+    if (it != (*iter)->inlinks.end()) {
+      (*iter)->inlinks.erase(it);
+    }
+    iter = node->outlinks.erase(iter);
+  }
+  graph->RemoveNode(node);
+}
+
+void SparseConvDetectPass::DetectSparseConv(SSAGraph* graph, Node* node) {
+  auto* scope = node->stmt()->op()->scope();
+  auto conv_op_desc = node->stmt()->mutable_op_info();
+  auto x = conv_op_desc->Input("Input").front();
+  auto w = conv_op_desc->Input("Filter").front();
+  auto y = conv_op_desc->Output("Output").front();
+  auto x_tensor = scope->FindVar(x)->Get<lite::Tensor>();
+  auto w_tensor = scope->FindVar(w)->Get<lite::Tensor>();
+  auto x_dims = x_tensor.dims();
+  auto weight_dims = w_tensor.dims();
+  auto groups = conv_op_desc->GetAttr<int>("groups");
+  auto strides = conv_op_desc->GetAttr<std::vector<int>>("strides");
+  auto paddings = conv_op_desc->GetAttr<std::vector<int>>("paddings");
+  auto ch_out = weight_dims[0];
+  auto ch_in = weight_dims[1] * groups;
+  auto kh = weight_dims[2];
+  auto kw = weight_dims[3];
+  auto im_size = x_dims[2] * x_dims[3];
+  if (!(kw == 1 && kh == 1)) {
+    VLOG(4) << "The kernel size of the supported sparse conv must be 1x1";
+    return;
+  }
+  if (groups != 1) {
+    VLOG(4) << "The groups of the supported sparse conv must be 1";
+    return;
+  }
+  if (!(strides[0] == 1 && strides[1] == 1)) {
+    VLOG(4) << "The strides of the supported sparse conv must be 1";
+    return;
+  }
+  if (!(paddings[0] == 0 && paddings[1] == 0)) {
+    VLOG(4) << "The paddings of the supported sparse conv must be 0";
+    return;
+  }
+  cpp::OpDesc op_desc;
+  std::vector<Node*> weight_args;
+  if (!CreateSparseWeights(graph,
+                           scope,
+                           w_tensor,
+                           w,
+                           ch_out,
+                           ch_in,
+                           im_size,
+                           sparse_threshold_,
+                           &op_desc,
+                           &weight_args)) {
+    return;
+  }
+  op_desc.SetType("sparse_conv2d");
+  op_desc.SetInput("Input", {x});
+  bool has_bias =
+      conv_op_desc->HasInput("Bias") && conv_op_desc->Input("Bias").size() > 0;
+  if (has_bias) {
+    auto b = conv_op_desc->Input("Bias").front();
+    op_desc.SetInput("Bias", {b});
+  }
+  op_desc.SetOutput("Output", {y});
+  if (w_tensor.precision() == PrecisionType::kInt8) {
+    conv_op_desc->SetAttr<bool>("enable_int8", true);
+  }
+  // copy attributes
+  std::vector<std::string> attr_names = conv_op_desc->AttrNames();
+  for (size_t i = 0; i < attr_names.size(); i++) {
+    if (conv_op_desc->HasAttr(attr_names[i])) {
+      CopyAttrFromOpInfo(&op_desc, conv_op_desc, attr_names[i]);
+    }
+  }
+  // Copy inputs/outputs scales
+  if (conv_op_desc->HasAttr("enable_int8")) {
+    CopyInputScaleFromOpInfo(&op_desc, conv_op_desc, "Input0_scale");
+    CopyInputScaleFromOpInfo(&op_desc, conv_op_desc, "Filter0_scale");
+    CopyOutputScaleFromOpInfo(&op_desc, conv_op_desc, "Output0_scale");
+  }
+  ReplaceWithSparseOp(graph, node, op_desc, weight_args);
+}
+
+void SparseConvDetectPass::DetectSparseFc(SSAGraph* graph, Node* node) {
+  auto* scope = node->stmt()->op()->scope();
+  auto op_info = node->stmt()->mutable_op_info();
+  bool is_fc = op_info->Type() == "fc";
+  auto x = op_info->Input(is_fc ? "Input" : "X").front();
+  auto w = op_info->Input(is_fc ? "W" : "Y").front();
+  auto y = op_info->Output("Out").front();
+  auto x_dims = scope->FindVar(x)->Get<lite::Tensor>().dims();
+  const auto& w_tensor = scope->FindVar(w)->Get<lite::Tensor>();
+  auto weight_dims = w_tensor.dims();
+  if (weight_dims.size() != 2) {
+    VLOG(4) << "The weight of the supported sparse fc must be 2-D";
+    return;
+  }
+  // The weight of the fc and the matmul_v2 without trans_y is K x N, which
+  // is transposed into N x K as the weight of the 1x1 conv.
+  bool trans_w = true;
+  int in_num_col_dims = 1;
+  if (is_fc) {
+    if (op_info->HasAttr("padding_weights") &&
+        op_info->GetAttr<bool>("padding_weights")) {
+      VLOG(4) << "The weight of the supported sparse fc must not be padded";
+      return;
+    }
+    if (op_info->HasAttr("activation_type")) {
+      auto act_type = op_info->GetAttr<std::string>("activation_type");
+      if (!act_type.empty() && act_type != "relu") {
+        VLOG(4) << "The sparse fc only supports fuse with relu";
+        return;
       }
-      // copy attributes
-      std::vector<std::string> attr_names = conv_op_desc->AttrNames();
-      for (size_t i = 0; i < attr_names.size(); i++) {
-        if (conv_op_desc->HasAttr(attr_names[i])) {
-          CopyAttrFromOpInfo(&op_desc, conv_op_desc, attr_names[i]);
-        }
+    }
+    in_num_col_dims = op_info->GetAttr<int>("in_num_col_dims");
+  } else {
+    if (!w_tensor.persistable()) {
+      VLOG(4) << "The Y of the supported sparse matmul_v2 must be a weight";
+      return;
+    }
+    if (op_info->GetAttr<bool>("trans_x")) {
+      VLOG(4) << "The X of the supported sparse matmul_v2 must not be "
+                 "transposed";
+      return;
+    }
+    if (x_dims.size() < 2) {
+      VLOG(4) << "The X of the supported sparse matmul_v2 must be at least "
+                 "2-D";
+      return;
+    }
+    trans_w = !op_info->GetAttr<bool>("trans_y");
+    in_num_col_dims = x_dims.size() - 1;
+  }
+  int ch_out = trans_w ? weight_dims[1] : weight_dims[0];
+  int ch_in = trans_w ? weight_dims[0] : weight_dims[1];
+  lite::Tensor w_trans;
+  const lite::Tensor* sparse_w = &w_tensor;
+  if (trans_w) {
+    w_trans.Resize({ch_out, ch_in});
+    w_trans.set_precision(w_tensor.precision());
+    if (w_tensor.precision() == PrecisionType::kInt8) {
+      TransposeWeight<int8_t>(w_tensor, &w_trans);
+    } else if (w_tensor.precision() == PrecisionType::kFloat) {
+      TransposeWeight<float>(w_tensor, &w_trans);
+    }
+    sparse_w = &w_trans;
+  }
+  // The sparse fc transposes the input and the output of more than one row,
+  // which needs the sparser weights to pay off.
+  float threshold = std::max(sparse_threshold_, kSparseFcMinThreshold);
+  cpp::OpDesc op_desc;
+  std::vector<Node*> weight_args;
+  // The diffs are scaled by the rows of the input in the kernel.
+  if (!CreateSparseWeights(graph,
+                           scope,
+                           *sparse_w,
+                           w,
+                           ch_out,
+                           ch_in,
+                           1,
+                           threshold,
+                           &op_desc,
+                           &weight_args)) {
+    return;
+  }
+  op_desc.SetType("sparse_fc");
+  op_desc.SetInput("Input", {x});
+  if (is_fc && op_info->HasInput("Bias") && op_info->Input("Bias").size() > 0) {
+    op_desc.SetInput("Bias", {op_info->Input("Bias").front()});
+  }
+  op_desc.SetOutput("Out", {y});
+  if (w_tensor.precision() == PrecisionType::kInt8) {
+    op_info->SetAttr<bool>("enable_int8", true);
+  }
+  std::vector<std::string> attr_names = op_info->AttrNames();
+  for (size_t i = 0; i < attr_names.size(); i++) {
+    if (op_info->HasAttr(attr_names[i])) {
+      CopyAttrFromOpInfo(&op_desc, op_info, attr_names[i]);
+    }
+  }
+  op_desc.SetAttr<int>("in_num_col_dims", in_num_col_dims);
+  if (op_info->HasAttr("enable_int8")) {
+    if (is_fc) {
+      CopyInputScaleFromOpInfo(&op_desc, op_info, "Input0_scale");
+      CopyInputScaleFromOpInfo(&op_desc, op_info, "W0_scale");
+    } else {
+      if (op_info->HasInputScale("X0_scale", true)) {
+        op_desc.SetAttr<std::vector<float>>(
+            "Input0_scale", op_info->GetInputScale("X0_scale", true));
       }
-      // Copy inputs/outputs scales
-      if (conv_op_desc->HasAttr("enable_int8")) {
-        CopyInputScaleFromOpInfo(&op_desc, conv_op_desc, "Input0_scale");
-        CopyInputScaleFromOpInfo(&op_desc, conv_op_desc, "Filter0_scale");
-        CopyOutputScaleFromOpInfo(&op_desc, conv_op_desc, "Output0_scale");
+      if (op_info->HasInputScale("Y0_scale", true)) {
+        op_desc.SetAttr<std::vector<float>>(
+            "W0_scale", op_info->GetInputScale("Y0_scale", true));
       }
+    }
+    CopyOutputScaleFromOpInfo(&op_desc, op_info, "Out0_scale");
+  }
+  ReplaceWithSparseOp(graph, node, op_desc, weight_args);
+}
 
-      op_desc.SetAttr<int>("first_ic", first_ic);
-      op_desc.SetAttr<int>("flag_semi", flag_semi);
-      sparse_conv2d_op->Attach(op_desc, node->stmt()->op()->scope());
-      auto* sparse_op_node = graph->GraphCreateInstructNode(
-          sparse_conv2d_op, graph->valid_places());
-      for (auto iter = node->inlinks.begin(); iter != node->inlinks.end();) {
-        auto it =
-            std::find((*iter)->outlinks.begin(), (*iter)->outlinks.end(), node);
-        if (it != (*iter)->outlinks.end()) {
-          (*iter)->outlinks.erase(it);
-        }
-        bool is_weight = (*iter)->IsArg() && (*iter)->AsArg().is_weight;
-        if (!is_weight) {
-          DirectedLink(*iter, sparse_op_node);
-        } else {
-          graph->RemoveNode((*iter));
-        }
-        iter = node->inlinks.erase(iter);
-      }
-      DirectedLink(nonzeros_output_arg, sparse_op_node);
-      DirectedLink(oc_nonzeros_arg, sparse_op_node);
-      DirectedLink(ic_diffs_arg, sparse_op_node);
-      for (auto iter = node->outlinks.begin(); iter != node->outlinks.end();) {
-        DirectedLink(sparse_op_node, *iter);
-        auto it =
-            std::find((*iter)->inlinks.begin(), (*iter)->inlinks.end(), node);
-        if (it != (*iter)->inlinks.end()) {
-          (*iter)->inlinks.erase(it);
-        }
-        iter = node->outlinks.erase(iter);
-      }
-      graph->RemoveNode(node);
+void SparseConvDetectPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  for (auto& node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    auto op_type = node->AsStmt().op_type();
+    if (op_type == "conv2d") {
+      DetectSparseConv(graph.get(), node);
+    } else if (op_type == "fc" || op_type == "matmul_v2") {
+      DetectSparseFc(graph.get(), node);
     }
   }
 }
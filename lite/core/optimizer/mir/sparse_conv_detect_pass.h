@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include "lite/core/op_registry.h"
 #include "lite/core/optimizer/mir/pass.h"
 
@@ -95,6 +96,31 @@ class SparseConvDetectPass : public ProgramPass {
   }
 
  private:
+  // Compress the M x K weight `w_tensor` named `w` for the input of N pixels
+  // into the sparse weights, which are added into `op_desc` together with
+  // the attributes first_ic and flag_semi. Returns false and does nothing if
+  // the sparse degree of the weight is lower than `threshold`.
+  bool CreateSparseWeights(SSAGraph* graph,
+                           Scope* scope,
+                           const lite::Tensor& w_tensor,
+                           const std::string& w,
+                           const int M,
+                           const int K,
+                           const int N,
+                           const float threshold,
+                           cpp::OpDesc* op_desc,
+                           std::vector<Node*>* weight_args);
+  // Replace the op of `node` with the sparse op of `op_desc`, whose sparse
+  // weights are `weight_args`.
+  void ReplaceWithSparseOp(SSAGraph* graph,
+                           Node* node,
+                           const cpp::OpDesc& op_desc,
+                           const std::vector<Node*>& weight_args);
+  void DetectSparseConv(SSAGraph* graph, Node* node);
+  // The fc and the matmul_v2 with a 2-D weight, which are computed by
+  // sparse_fc.
+  void DetectSparseFc(SSAGraph* graph, Node* node);
+
   float sparse_threshold_{0.5f};
 };
 
@@ -22,6 +22,9 @@
 #include <vector>
 #include "lite/core/optimizer/mir/graph_visualize_pass.h"
 #include "lite/core/optimizer/mir/pass_registry.h"
+#ifdef LITE_WITH_OPENCL
+#include "lite/backends/opencl/cl_runtime.h"
+#endif
 
 namespace paddle {
 namespace lite {
@@ -32,6 +35,110 @@ bool KernelScoreCmp(const std::pair<float, std::unique_ptr<KernelBase>>& a,
   return a.first > b.first;
 }
 
+// Whether the kernel may replace the picked one, only the kernels of the
+// same precision, or fp32 and fp16 for the ops not kept in fp32 by
+// mixed_precision_pass, are considered.
+static bool FloatPrecisionAlternative(const Node::Stmt& instruct,
+                                      const KernelBase& picked,
+                                      const KernelBase& kernel) {
+  if (kernel.precision() == picked.precision()) return true;
+  if (instruct.op_info()->HasAttr("mixed_precision")) return false;
+  auto is_float = [](PrecisionType precision) {
+    return precision == PRECISION(kFloat) || precision == PRECISION(kFP16);
+  };
+  return is_float(kernel.precision()) && is_float(picked.precision());
+}
+
+// The declared types of the arguments, nullptr if not declared.
+static const Type* InputDeclType(const KernelBase& kernel,
+                                 const std::string& argname) {
+  const auto* type = ParamTypeRegistry::Global().RetrieveInArgument(
+      kernel.place(), kernel.GenParamTypeKey(), argname);
+  return type ? type->type : nullptr;
+}
+
+static const Type* OutputDeclType(const KernelBase& kernel,
+                                  const std::string& argname) {
+  const auto* type = ParamTypeRegistry::Global().RetrieveOutArgument(
+      kernel.place(), kernel.GenParamTypeKey(), argname);
+  return type ? type->type : nullptr;
+}
+
+// Whether no layout or precision cast is needed between the types.
+static bool TypeCompatible(const Type* a, const Type* b) {
+  if (!a || !b) return true;
+  bool layout_compatible = a->layout() == b->layout() ||
+                           a->layout() == DATALAYOUT(kAny) ||
+                           b->layout() == DATALAYOUT(kAny);
+  bool precision_compatible = a->precision() == b->precision() ||
+                              a->precision() == PRECISION(kAny) ||
+                              b->precision() == PRECISION(kAny);
+  return layout_compatible && precision_compatible;
+}
+
+static bool IsImageLayout(DataLayoutType layout) {
+  return layout == DATALAYOUT(kImageDefault) ||
+         layout == DATALAYOUT(kImageFolder) || layout == DATALAYOUT(kImageNW);
+}
+
+// The rank of the variable in the model, -1 if unknown.
+static int StaticRank(const Node::Stmt& instruct, const std::string& name) {
+  auto* var = instruct.op()->scope()->FindVar(name);
+  if (!var || !var->IsType<Tensor>()) return -1;
+  return static_cast<int>(var->Get<Tensor>().dims().size());
+}
+
+// Whether the OpenCL buffer kernel of the op supports its shapes, the fc one
+// takes the 2-D outputs only, and the matmul ones the 2-D inputs with the
+// persistable Y.
+static bool OpenCLBufferFits(const Node::Stmt& instruct) {
+  const auto* op_info = instruct.op_info();
+  if (instruct.op_type() == "fc") {
+    return StaticRank(instruct, op_info->Output("Out").front()) == 2;
+  }
+  if (instruct.op_type() == "matmul" || instruct.op_type() == "matmul_v2") {
+    const auto& y = op_info->Input("Y").front();
+    auto* y_var = instruct.op()->scope()->FindVar(y);
+    return y_var && y_var->IsType<Tensor>() &&
+           y_var->Get<Tensor>().persistable() &&
+           StaticRank(instruct, op_info->Input("X").front()) == 2 &&
+           StaticRank(instruct, y) == 2;
+  }
+  return true;
+}
+
+// Whether the GPU is known to run the op faster by the buffer kernel.
+static bool OpenCLBufferPreferred(const Node::Stmt& instruct) {
+#ifdef LITE_WITH_OPENCL
+  if (instruct.op_type() != "fc" && instruct.op_type() != "matmul" &&
+      instruct.op_type() != "matmul_v2") {
+    return false;
+  }
+  if (!CLWrapper::Global()->OpenclLibFound() ||
+      !CLWrapper::Global()->DlsymSuccess() ||
+      !CLRuntime::Global()->IsInitSuccess()) {
+    return false;
+  }
+  // The Mali GPUs read the images through the texture pipe, which is slower
+  // than the buffer loads for the matrix multiplications.
+  return CLRuntime::Global()->GetGpuType() == GpuType::ARM_MALI;
+#else
+  return false;
+#endif
+}
+
+void StaticKernelPickPass::SetKernelLatencies(const std::string& path) {
+  kernel_latencies_.reset();
+  if (path.empty()) return;
+  std::unique_ptr<LatencyTable> table(new LatencyTable);
+  if (!table->Load(path)) {
+    LOG(WARNING) << "Failed to load the op latency table " << path
+                 << ", pick the OpenCL kernels by the GPU vendor.";
+    return;
+  }
+  kernel_latencies_ = std::move(table);
+}
+
 void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   kernel_pick_factors_.ConsiderTarget();
   kernel_pick_factors_.ConsiderPrecision();
@@ -44,6 +151,9 @@ void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   VLOG(2) << "graph block_idx: " << graph->blockIdx();
   VLOG(2) << "graph->mutable_nodes().size(): " << graph->mutable_nodes().size();
   size_t idx = 0;
+  // The candidates of the same target and precision as the picked kernels
+  // but different data layouts, which are reconsidered by AssignDataLayouts.
+  std::map<Node*, LayoutCandidates> layout_candidates;
   for (auto& node : graph->mutable_nodes()) {
     if (!node.IsStmt()) continue;
     auto& instruct = node.AsStmt();
@@ -95,6 +205,22 @@ void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
       instruct.kernels().emplace_back(std::move(scored.front().second));
       VLOG(2) << "the final pick kernel is "
               << instruct.kernels().front()->summary() << "\n\n";
+      const auto& picked = instruct.kernels().front();
+      auto& candidates = layout_candidates[&node];
+      candidates.best_score = scored.front().first;
+      candidates.picked_score = scored.front().first;
+      for (size_t i = 1; i < scored.size(); i++) {
+        auto& kernel = scored[i].second;
+        if (scored[i].first > 0 && kernel->target() == picked->target() &&
+            (kernel->layout() != picked->layout() ||
+             kernel->precision() != picked->precision()) &&
+            FloatPrecisionAlternative(instruct, *picked, *kernel)) {
+          candidates.kernels.emplace_back(scored[i].first, std::move(kernel));
+        }
+      }
+      if (candidates.kernels.empty()) {
+        layout_candidates.erase(&node);
+      }
 
     } else {
       bool out_type_int8 = true;
@@ -113,7 +239,9 @@ void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
         for (auto* tmp_op : out_n->outlinks) {
           CHECK(tmp_op->IsStmt());
           auto* tmp_op_info = tmp_op->AsStmt().op_info();
+          // the asymmetric int8 input is quantized from fp32 by calib
           if (!tmp_op_info->HasAttr("enable_int8") ||
+              tmp_op_info->HasAttr(out_n->AsArg().name + "_zero_point") ||
               tmp_op_info->Type() == "lstm" || tmp_op_info->Type() == "gru" ||
               instruct.op_type() == "__xpu__multi_encoder" ||
               instruct.op_type() == "__xpu__fc") {
@@ -181,10 +309,196 @@ void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
           break;
         }
       }
+      // The targets without the int8 kernels, e.g. OpenCL, run the quantized
+      // op by the best kernel, which handles the int8 weights itself.
+      if (instruct.kernels().empty() && !scored.empty()) {
+        bool has_int8_kernel = false;
+        auto input_arguments = instruct.op_info()->InputArgumentNames();
+        for (auto& candidate : scored) {
+          if (!candidate.second) continue;
+          for (auto& arg_name : input_arguments) {
+            const Type* in_arg_ty =
+                candidate.second->GetInputDeclType(arg_name);
+            if (in_arg_ty->precision() == PRECISION(kInt8)) {
+              has_int8_kernel = true;
+            }
+          }
+        }
+        if (!has_int8_kernel) {
+          instruct.kernels().emplace_back(std::move(scored.front().second));
+          VLOG(2) << "no int8 kernel, the final pick kernel is "
+                  << instruct.kernels().front()->summary();
+        }
+      }
       CHECK(!instruct.kernels().empty()) << "No kernels found for "
                                          << instruct.op_type();
     }
   }
+  kernel_costs_.clear();
+  for (auto& item : layout_candidates) {
+    AssignOpenCLKernelCosts(item.first, item.second);
+  }
+  AssignDataLayouts(graph.get(), &layout_candidates);
+  kernel_costs_.clear();
+  ReportOpenCLKernels(graph.get());
+}
+
+void StaticKernelPickPass::AssignOpenCLKernelCosts(
+    Node* node, const LayoutCandidates& candidates) {
+  auto& instruct = node->AsStmt();
+  const auto& picked = instruct.kernels().front();
+  if (picked->target() != TARGET(kOpenCL)) return;
+  std::vector<const KernelBase*> kernels{picked.get()};
+  bool has_buffer = !IsImageLayout(picked->layout());
+  bool has_image = IsImageLayout(picked->layout());
+  for (auto& candidate : candidates.kernels) {
+    kernels.push_back(candidate.second.get());
+    has_buffer |= !IsImageLayout(candidate.second->layout());
+    has_image |= IsImageLayout(candidate.second->layout());
+  }
+  if (!has_buffer || !has_image || !OpenCLBufferFits(instruct)) return;
+
+  std::map<std::string, double> latencies;
+  if (kernel_latencies_) {
+    latencies = kernel_latencies_->RelativeLatencies(instruct.op_type());
+  }
+  bool measured = !latencies.empty();
+  for (auto* kernel : kernels) {
+    measured = measured && latencies.count(kernel->name());
+  }
+  if (measured) {
+    for (auto* kernel : kernels) {
+      kernel_costs_[kernel] =
+          static_cast<float>(latencies.at(kernel->name()) - 1.0);
+    }
+  } else if (OpenCLBufferPreferred(instruct)) {
+    for (auto* kernel : kernels) {
+      kernel_costs_[kernel] =
+          IsImageLayout(kernel->layout()) ? kSlowImageCost : 0.f;
+    }
+  }
+}
+
+void StaticKernelPickPass::ReportOpenCLKernels(SSAGraph* graph) {
+  int images = 0;
+  int switches = 0;
+  std::map<std::string, int> buffers;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    const auto& kernels = node->AsStmt().kernels();
+    if (kernels.empty() || kernels.front()->target() != TARGET(kOpenCL)) {
+      continue;
+    }
+    bool image = IsImageLayout(kernels.front()->layout());
+    if (image) {
+      images++;
+    } else {
+      buffers[node->AsStmt().op_type()]++;
+    }
+    for (auto* out : node->outlinks) {
+      for (auto* consumer : out->outlinks) {
+        const auto& consumer_kernels = consumer->AsStmt().kernels();
+        if (!consumer_kernels.empty() &&
+            consumer_kernels.front()->target() == TARGET(kOpenCL) &&
+            IsImageLayout(consumer_kernels.front()->layout()) != image) {
+          switches++;
+        }
+      }
+    }
+  }
+  if (images == 0 || buffers.empty()) return;
+  std::string buffer_ops;
+  int buffer_count = 0;
+  for (auto& item : buffers) {
+    buffer_ops += " " + item.first + ":" + std::to_string(item.second);
+    buffer_count += item.second;
+  }
+  LOG(INFO) << "OpenCL kernels of block " << graph->blockIdx() << ": "
+            << images << " image, " << buffer_count << " buffer ("
+            << buffer_ops.substr(1) << "), " << switches
+            << " switches between them";
+}
+
+float StaticKernelPickPass::LayoutCost(Node* node,
+                                       const KernelBase& kernel,
+                                       float score,
+                                       float best_score) {
+  const auto* op_info = node->AsStmt().op_info();
+  float cost = best_score > 0 ? (best_score - score) / best_score : 0.f;
+  auto kernel_cost = kernel_costs_.find(&kernel);
+  if (kernel_cost != kernel_costs_.end()) {
+    cost = kernel_cost->second;
+  }
+  std::string argname;
+  for (auto* in : node->inlinks) {
+    if (in->AsArg().is_weight || in->AsArg().is_persist) continue;
+    if (!op_info->GetInputArgname(in->AsArg().name, &argname)) continue;
+    const Type* type = InputDeclType(kernel, argname);
+    for (auto* producer : in->inlinks) {
+      const auto& producer_kernels = producer->AsStmt().kernels();
+      std::string producer_argname;
+      if (producer_kernels.empty() ||
+          !producer->AsStmt().op_info()->GetOutputArgname(
+              in->AsArg().name, &producer_argname)) {
+        continue;
+      }
+      if (!TypeCompatible(
+              OutputDeclType(*producer_kernels.front(), producer_argname),
+              type)) {
+        cost += kLayoutCastCost;
+      }
+    }
+  }
+  for (auto* out : node->outlinks) {
+    if (!op_info->GetOutputArgname(out->AsArg().name, &argname)) continue;
+    const Type* type = OutputDeclType(kernel, argname);
+    for (auto* consumer : out->outlinks) {
+      const auto& consumer_kernels = consumer->AsStmt().kernels();
+      std::string consumer_argname;
+      if (consumer_kernels.empty() ||
+          !consumer->AsStmt().op_info()->GetInputArgname(out->AsArg().name,
+                                                         &consumer_argname)) {
+        continue;
+      }
+      if (!TypeCompatible(
+              type,
+              InputDeclType(*consumer_kernels.front(), consumer_argname))) {
+        cost += kLayoutCastCost;
+      }
+    }
+  }
+  return cost;
+}
+
+void StaticKernelPickPass::AssignDataLayouts(
+    SSAGraph* graph, std::map<Node*, LayoutCandidates>* layout_candidates) {
+  if (layout_candidates->empty()) return;
+  // Iterated conditional modes: each op in turn takes the kernel of the
+  // lowest cost given the kernels of its neighbors, until nothing changes.
+  const int kMaxSweeps = 4;
+  for (int sweep = 0; sweep < kMaxSweeps; sweep++) {
+    bool changed = false;
+    for (auto* node : graph->StmtTopologicalOrder()) {
+      auto it = layout_candidates->find(node);
+      if (it == layout_candidates->end()) continue;
+      auto& candidates = it->second;
+      auto& picked = node->AsStmt().kernels().front();
+      float picked_cost = LayoutCost(
+          node, *picked, candidates.picked_score, candidates.best_score);
+      for (auto& candidate : candidates.kernels) {
+        float cost = LayoutCost(
+            node, *candidate.second, candidate.first, candidates.best_score);
+        if (cost + 1e-6f < picked_cost) {
+          VLOG(4) << "pick " << candidate.second->summary() << " instead of "
+                  << picked->summary() << " to save the layout casts";
+          std::swap(picked, candidate.second);
+          std::swap(candidates.picked_score, candidate.first);
+          picked_cost = cost;
+          changed = true;
+        }
+      }
+    }
+    if (!changed) break;
+  }
 }
 
 }  // namespace mir
@@ -18,7 +18,9 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
+#include "lite/core/latency_table.h"
 #include "lite/core/optimizer/mir/pass.h"
 #include "lite/core/types.h"
 
@@ -48,7 +50,46 @@ class StaticKernelPickPass : public mir::StmtPass {
     return &kernel_pick_factors_;
   }
 
+  // Pick the OpenCL buffer or image kernels by the op latency table saved in
+  // `path`, or by the GPU vendor if it's empty or can't be read.
+  void SetKernelLatencies(const std::string& path);
+
  private:
+  struct LayoutCandidates {
+    float best_score{0.f};
+    float picked_score{0.f};
+    std::vector<std::pair<float, std::unique_ptr<KernelBase>>> kernels;
+  };
+
+  // The cost of a layout or precision cast inserted by type_layout_cast_pass
+  // or type_precision_cast_pass, relative to the score of the best kernel.
+  static constexpr float kLayoutCastCost = 0.5f;
+
+  // The cost of an OpenCL image kernel of fc or matmul relative to the buffer
+  // one on the GPUs known to run them faster by buffers, which is more than
+  // the casts into and out of the buffer kernel.
+  static constexpr float kSlowImageCost = 1.5f;
+
+  // The relative score loss of the kernel, or its cost in kernel_costs_,
+  // plus the casts between it and the picked kernels of the neighbors.
+  float LayoutCost(Node* node,
+                   const KernelBase& kernel,
+                   float score,
+                   float best_score);
+
+  // Reconsider the kernels of different data layouts(and fp32/fp16) for the
+  // whole graph to reduce the casts, instead of keeping the best kernel of
+  // each op.
+  void AssignDataLayouts(SSAGraph* graph,
+                         std::map<Node*, LayoutCandidates>* layout_candidates);
+
+  // Cost the OpenCL buffer and image kernels of the node by the measured
+  // latencies, or else by the GPU vendor, into kernel_costs_.
+  void AssignOpenCLKernelCosts(Node* node, const LayoutCandidates& candidates);
+
+  // Log the mix of the OpenCL buffer and image kernels picked.
+  void ReportOpenCLKernels(SSAGraph* graph);
+
   // Score the kernel.
   size_t KernelGrade(lite::mir::Node* node,
                      const lite::KernelBase& kernel,
@@ -96,9 +137,15 @@ class StaticKernelPickPass : public mir::StmtPass {
           (place.precision == kernel.precision() ||
            kernel.precision() == PRECISION(kAny) ||
            place.precision == PRECISION(kAny))) {
-        // score skipped, if kernel is int8, but op is not int8
+        // score skipped, if kernel is int8, but op is not int8, or kernel is
+        // fp16, but op is kept in fp32 by mixed_precision_pass
+        bool fp32_op =
+            instruct.op_info()->HasAttr("mixed_precision") &&
+            instruct.op_info()->GetAttr<std::string>("mixed_precision") ==
+                "fp32";
         if (!(kernel.precision() == PRECISION(kInt8) &&
-              !instruct.op_info()->HasAttr("enable_int8"))) {
+              !instruct.op_info()->HasAttr("enable_int8")) &&
+            !(kernel.precision() == PRECISION(kFP16) && fp32_op)) {
           size_t precision_score =
               kMax /
               static_cast<int>(core::KernelPickFactor::Factor::PrecisionFirst);
@@ -310,6 +357,8 @@ class StaticKernelPickPass : public mir::StmtPass {
 
  private:
   core::KernelPickFactor kernel_pick_factors_;
+  std::unique_ptr<LatencyTable> kernel_latencies_;
+  std::map<const KernelBase*, float> kernel_costs_;
 };
 
 }  // namespace mir
@@ -13,8 +13,10 @@
 // limitations under the License.
 
 #include "lite/core/optimizer/mir/subgraph/subgraph_detector.h"
+#include <map>
 #include <memory>
 #include <set>
+#include <sstream>
 #include <utility>
 #include <vector>
 #include "lite/core/optimizer/mir/dot.h"
@@ -641,9 +643,69 @@ void SubgraphFuser::ReplaceNodesWithSubgraphs(
   }
 }
 
+void SubgraphFuser::DropUnprofitableSubgraphs(
+    std::vector<std::vector<Node *>> *subgraphs) {
+  std::map<std::string, std::pair<float, float>> op_costs;
+  float transfer_cost = 0.f;
+  for (const auto &line : Split(subgraph_cost_table_, "\n")) {
+    std::istringstream ss(line);
+    std::string op_type;
+    float host_latency = 0.f, device_latency = 0.f;
+    if (!(ss >> op_type) || op_type[0] == '#') continue;
+    if (!(ss >> host_latency)) {
+      LOG(WARNING) << "Invalid line of the subgraph cost table: " << line;
+    } else if (op_type == "transfer") {
+      transfer_cost = host_latency;
+    } else if (ss >> device_latency) {
+      op_costs[op_type] = std::make_pair(host_latency, device_latency);
+    } else {
+      LOG(WARNING) << "Invalid line of the subgraph cost table: " << line;
+    }
+  }
+  std::vector<std::vector<Node *>> profitable_subgraphs;
+  for (auto &subgraph : *subgraphs) {
+    float host_cost = 0.f;
+    float device_cost = 0.f;
+    bool is_known = true;
+    for (auto node : subgraph) {
+      auto op_type = node->AsStmt().op_type();
+      if (!op_costs.count(op_type)) {
+        is_known = false;
+        break;
+      }
+      host_cost += op_costs[op_type].first;
+      device_cost += op_costs[op_type].second;
+    }
+    if (is_known) {
+      std::set<Node *> input_var_nodes, weight_var_nodes, output_var_nodes,
+          local_var_nodes, unused_var_nodes;
+      ExtractInputsOutputs(subgraph,
+                           &input_var_nodes,
+                           &weight_var_nodes,
+                           &output_var_nodes,
+                           &local_var_nodes,
+                           &unused_var_nodes);
+      device_cost +=
+          transfer_cost * (input_var_nodes.size() + output_var_nodes.size());
+      if (device_cost >= host_cost) {
+        VLOG(3) << "Drop the subgraph of " << subgraph.size()
+                << " ops, host cost " << host_cost << "ms, device cost "
+                << device_cost << "ms";
+        continue;
+      }
+    }
+    profitable_subgraphs.push_back(subgraph);
+  }
+  *subgraphs = profitable_subgraphs;
+}
+
 void SubgraphFuser::operator()() {
   std::vector<std::vector<Node *>> subgraphs =
       SubgraphDetector(graph_, teller_, subgraph_partition_configs_)();
+  // The custom partition configurations take precedence over the cost table
+  if (subgraph_partition_configs_.empty() && !subgraph_cost_table_.empty()) {
+    DropUnprofitableSubgraphs(&subgraphs);
+  }
   if (support_mixed_precision_) {
     MixedPrecisionAutoInsertCalibFuser mixed_precision_auto_insert_calib_fuser(
         graph_, &subgraphs);
@@ -100,14 +100,27 @@ class SubgraphFuser {
                 const SubgraphTeller& teller,
                 int min_subgraph_size,
                 const std::string& subgraph_partition_configs = "",
-                bool support_mixed_precision = false)
+                bool support_mixed_precision = false,
+                const std::string& subgraph_cost_table = "")
       : graph_(graph),
         teller_(teller),
         min_subgraph_size_{min_subgraph_size},
         subgraph_partition_configs_(subgraph_partition_configs),
-        support_mixed_precision_(support_mixed_precision) {}
+        support_mixed_precision_(support_mixed_precision),
+        subgraph_cost_table_(subgraph_cost_table) {}
   void operator()();
 
+  // Drop the subgraphs which run slower on the device than on the host
+  // according to the op costs and the transfer costs of the cost table, here
+  // is an example:
+  // # op_type host_latency(ms) device_latency(ms)
+  // conv2d 3.97 0.52
+  // softmax 0.08 0.31
+  // # The latency(ms) of transferring a tensor between the host and device
+  // transfer 0.25
+  // The subgraphs containing the ops missing in the table are kept.
+  void DropUnprofitableSubgraphs(std::vector<std::vector<Node*>>* subgraphs);
+
   // Remove the op nodes of the subgraphs and replace with the subgraph ops.
   void ReplaceNodesWithSubgraphs(
       SSAGraph* graph,
@@ -125,6 +138,7 @@ class SubgraphFuser {
   int min_subgraph_size_;
   const std::string& subgraph_partition_configs_;
   bool support_mixed_precision_{false};
+  std::string subgraph_cost_table_;
 };
 
 class MixedPrecisionAutoInsertCalibFuser {
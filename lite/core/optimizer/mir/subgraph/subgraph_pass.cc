@@ -127,6 +127,7 @@ void NNAdapterSubgraphPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   // Filter the supported operators for the selected devices according to the
   // registered op converters
   std::string subgraph_partition_configs;
+  std::string subgraph_cost_table;
   std::vector<std::string> selected_device_names;
   Scope* scope = nullptr;
   for (auto& any_op_node : graph->StmtTopologicalOrder()) {
@@ -160,6 +161,18 @@ void NNAdapterSubgraphPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
       }
     }
   }
+  // Load the op costs and transfer costs to drop the unprofitable subgraphs
+  auto cost_table_path =
+      Context<TargetType::kNNAdapter>::NNAdapterSubgraphCostTablePath(scope);
+  if (!cost_table_path.empty()) {
+    std::vector<char> buffer;
+    if (ReadFile(cost_table_path, &buffer, false)) {
+      subgraph_cost_table.assign(buffer.begin(), buffer.end());
+    } else {
+      LOG(WARNING) << "Missing the subgraph cost table file "
+                   << cost_table_path;
+    }
+  }
 #endif
   // Read the config path from environment and load the partition configurations
   if (subgraph_partition_configs.empty()) {
@@ -209,7 +222,8 @@ void NNAdapterSubgraphPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
                       teller,
                       1 /* min_subgraph_size */,
                       subgraph_partition_configs,
-                      true);
+                      true,
+                      subgraph_cost_table);
   fuser();
 }
 
@@ -304,6 +304,14 @@ void PrecisionCastPass::AddCastInst(const Type& from,
     if (InferScale(in, inst_node, &scale)) {
       op_desc.SetAttr("scale", scale);
     }
+    // the asymmetric int8 input of the current op
+    const auto* inst_op_info = inst_node->AsStmt().op_info();
+    std::string zero_point_name = in->AsArg().name + "_zero_point";
+    if (to.precision() == PRECISION(kInt8) &&
+        inst_op_info->HasAttr(zero_point_name)) {
+      op_desc.SetAttr<int>("zero_point",
+                           inst_op_info->GetAttr<int>(zero_point_name));
+    }
 
     cast_op->Attach(op_desc, inst_node->AsStmt().op()->scope());
     auto kernels = cast_op->CreateKernels(valid_places);
@@ -146,8 +146,10 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "scale_calc_offline_pass",
        "unsqueeze_calc_offline_pass",
        "ssd_boxes_calc_offline_pass",
+       "constant_folding_pass",
        "adaptive_1x1_pool2d_convert_global_pass",  //
        "lite_unsqueeze2_pad3d_squeeze2_fuse_pass",
+       "lite_pad2d_conv_pool_fuse_pass",
        "lite_conv_elementwise_fuse_pass",  // conv-elemwise-bn
        "lite_conv_bn_fuse_pass",           //
        "lite_conv_elementwise_fuse_pass",  // conv-bn-elemwise
@@ -157,6 +159,8 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "lite_conv_activation_fuse_pass",              //
        "lite_var_conv_2d_activation_fuse_pass",       //
        "lite_match_matrix_activation_fuse_pass",      //
+       "lite_fusion_attention_fuse_pass",             //
+       "lite_elementwise_add_layer_norm_fuse_pass",   //
        "lite_squeeze2_matmul_fuse_pass",              //
        "lite_reshape2_matmul_fuse_pass",              //
        "lite_matmul_element_add_fuse_pass",           //
@@ -164,10 +168,14 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "lite_fc_fuse_pass",                           //
        "lite_shuffle_channel_fuse_pass",              //
        "lite_transpose_softmax_transpose_fuse_pass",  //
+       "lite_transpose_matmul_fuse_pass",             //
+       "lite_matmul_softmax_fuse_pass",               //
        "lite_interpolate_fuse_pass",                  //
        "identity_scale_eliminate_pass",               //
+       "lite_elementwise_chain_fuse_pass",            //
        "lite_scales_fuse_pass",                       //
        "lite_sequence_reverse_embedding_fuse_pass",   //
+       "lite_embedding_seq_pool_fuse_pass",           //
        "elementwise_mul_constant_eliminate_pass",     //
        "lite_sequence_pool_concat_fuse_pass",         //
        "lite_scale_activation_fuse_pass",             //
@@ -179,11 +187,17 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "lite_elementwise_activation_fuse_pass",
        "lite_conv_scale_fuse_pass",
        "lite_conv_elementwise_tree_fuse_pass",
+       "lite_conv_elementwise_int8_fuse_pass",
        "lite_greater_than_cast_fuse_pass",
        "fill_range_fuse_pass",
        "identity_dropout_eliminate_pass",
        "sparse_conv_detect_pass",
+       "lite_depthwise_pointwise_conv_fuse_pass",
+       "lite_conv_resample_fuse_pass",
+       "lite_yolo_box_nms_fuse_pass",
+       "lite_distribute_fpn_roi_align_fuse_pass",
        "keepdims_convert_pass",
+       "common_subexpression_elimination_pass",
        "__xpu__max_pooling_pad_zero_detect_fuse_pass",
        "__xpu__graph_dedup_pass",
        "__xpu__resnet_fuse_pass",
@@ -263,7 +277,9 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
 
        "runtime_context_assign_pass",
        "argument_type_display_pass",
+       "precision_cast_report_pass",  // list the remaining calib ops
        "lite_inplace_fuse_pass",
+       "concat_split_view_pass",
 #if !(defined(LITE_WITH_FPGA) || defined(LITE_WITH_PRECISION_PROFILE))
        "memory_optimize_pass",
        "xpu_memory_optimize_pass"
@@ -302,13 +318,18 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
 
   // multi_stream_analysis_pass must be in the front of
   // runtime_context_assign_pass
-  // post_quant_dynamic_pass must be in the behind of
-  // lite_quant_dequant_fuse_pass
+  // post_quant_dynamic_pass, post_quant_static_pass and embedding_quant_pass
+  // must be in the behind of lite_quant_dequant_fuse_pass, and
+  // mixed_precision_pass must be in the front of them
   const std::string msa_pass{"multi_stream_analysis_pass"};
   const std::string msa_depend_pass{"runtime_context_assign_pass"};
   const std::string pqd_pass{"post_quant_dynamic_pass"};
   const std::string pqd_depend_pass{"lite_quant_dequant_fuse_pass"};
+  const std::string pqs_pass{"post_quant_static_pass"};
+  const std::string eq_pass{"embedding_quant_pass"};
+  const std::string mp_pass{"mixed_precision_pass"};
   const std::string fp16_pass{"fp16_attribute_pass"};
+  const std::string bf16_pass{"bf16_attribute_pass"};
 
   for (const std::string& pass : passes) {
     if (pass == msa_pass) {
@@ -316,11 +337,16 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
           std::find(passes_local.begin(), passes_local.end(), msa_depend_pass);
       CHECK(iter != passes_local.end()) << "No find " << msa_depend_pass;
       passes_local.insert(iter, msa_pass);
-    } else if (pass == pqd_pass) {
+    } else if (pass == pqd_pass || pass == pqs_pass || pass == eq_pass ||
+               pass == mp_pass) {
       auto iter =
           std::find(passes_local.begin(), passes_local.end(), pqd_depend_pass);
       CHECK(iter != passes_local.end()) << "No find " << pqd_depend_pass;
-      passes_local.insert(iter + 1, pqd_pass);
+      ++iter;
+      if (pass != mp_pass && iter != passes_local.end() && *iter == mp_pass) {
+        ++iter;
+      }
+      passes_local.insert(iter, pass);
     } else {
       passes_local.push_back(pass);
     }
@@ -334,11 +360,23 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
       }
     }
   }
+  for (auto place : valid_places) {
+    if (place.target == TARGET(kARM) && place.precision == PRECISION(kBF16)) {
+      passes_local.push_back(bf16_pass);
+      break;
+    }
+  }
 
   for (auto& pass_name : passes_local) {
     optim.AddPass(pass_name);
   }
 
+  auto* kernel_pick_pass =
+      mir::PassManager::Global().LookUp<mir::StaticKernelPickPass>(
+          "static_kernel_pick_pass");
+  CHECK(kernel_pick_pass);
+  kernel_pick_pass->SetKernelLatencies(config.opencl_kernel_latencies());
+
   return optim.Run(std::move(program));
 }
 
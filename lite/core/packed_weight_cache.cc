@@ -0,0 +1,245 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/packed_weight_cache.h"
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <utility>
+#include <vector>
+#include "lite/core/device_info.h"
+#include "lite/core/memory_planner.h"
+#include "lite/core/model/base/io.h"
+#include "lite/utils/hash.h"
+#include "lite/utils/io.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+const uint32_t kMagic = 0x4357504c;  // "LPWC"
+const uint32_t kVersion = 1;
+const size_t kAlignment = 64;
+
+size_t Padding(size_t offset) {
+  return (kAlignment - offset % kAlignment) % kAlignment;
+}
+}  // namespace
+
+PackedWeightCache& PackedWeightCache::Global() {
+  static PackedWeightCache* x = new PackedWeightCache;
+  return *x;
+}
+
+std::string PackedWeightCache::Key(const std::string& kernel,
+                                   const Tensor& weight) {
+  std::stringstream ss;
+  ss << kernel;
+#if defined(__aarch64__)
+  ss << "|armv8";
+#elif defined(__arm__)
+  ss << "|armv7";
+#endif
+#ifdef LITE_WITH_ARM
+  auto& info = DeviceInfo::Global();
+  ss << "|arch:" << static_cast<int>(info.arch()) << "|dot:" << info.has_dot()
+     << "|i8mm:" << info.has_i8mm() << "|bf16:" << info.has_bf16()
+     << "|fp16:" << info.has_fp16();
+#endif
+  ss << "|" << PrecisionToStr(weight.precision()) << "|"
+     << weight.dims().repr() << "|" << std::hex
+     << HashBytes(weight.raw_data(), weight.memory_size());
+  return ss.str();
+}
+
+void PackedWeightCache::Load(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  enabled_ = true;
+  if (path == path_) return;
+  path_ = path;
+  if (!IsFileExists(path)) return;
+  {
+    model_parser::BinaryFileReader file(path);
+    if (file.length() < 2 * sizeof(uint32_t) + sizeof(uint64_t)) {
+      LOG(WARNING) << "Ignore the broken packed weight cache " << path;
+      return;
+    }
+  }
+#if defined(_WIN32)
+  model_parser::BinaryFileReader file(path);
+#else
+  model_parser::MappedFileReader file(path);
+#endif
+  const model_parser::ByteReader& reader = file;
+  auto mapping = reader.mapping();
+  auto remains = [&reader](size_t size) {
+    return reader.length() - reader.current() >= size;
+  };
+  auto skip = [&reader](size_t size) {
+    char padding[kAlignment];
+    reader.Read(padding, size);
+  };
+  if (reader.Read<uint32_t>() != kMagic ||
+      reader.Read<uint32_t>() != kVersion) {
+    LOG(WARNING) << "Ignore the packed weight cache " << path
+                 << " of an unknown version";
+    return;
+  }
+  uint64_t count = reader.Read<uint64_t>();
+  std::map<std::string, Entry> entries;
+  for (uint64_t i = 0; i < count; i++) {
+    if (!remains(sizeof(uint32_t))) break;
+    uint32_t key_size = reader.Read<uint32_t>();
+    if (!remains(key_size + 2 * sizeof(uint32_t))) break;
+    std::string key = reader.ReadToString(key_size);
+    Entry entry;
+    entry.precision = static_cast<PrecisionType>(reader.Read<int32_t>());
+    uint32_t rank = reader.Read<uint32_t>();
+    if (!remains(rank * sizeof(int64_t) + sizeof(uint64_t))) break;
+    std::vector<int64_t> dims(rank);
+    for (auto& dim : dims) dim = reader.Read<int64_t>();
+    entry.dims = DDim(dims);
+    entry.size = reader.Read<uint64_t>();
+    size_t padding = Padding(reader.current());
+    if (!remains(padding + entry.size)) break;
+    skip(padding);
+    if (mapping) {
+      auto* data = static_cast<const char*>(reader.ReadInPlace(entry.size));
+      entry.buffer = mapping;
+      entry.offset = data - static_cast<const char*>(mapping->data());
+    } else {
+      entry.buffer = std::make_shared<Buffer>();
+      entry.buffer->ResetLazy(TARGET(kHost), entry.size);
+      reader.Read(entry.buffer->data(), entry.size);
+    }
+    entries.emplace(std::move(key), std::move(entry));
+  }
+  if (entries.size() != count) {
+    LOG(WARNING) << "Ignore the broken packed weight cache " << path;
+    return;
+  }
+  for (auto& item : entries) entries_.insert(std::move(item));
+  VLOG(1) << "Loaded " << count << " packed weights from " << path;
+}
+
+void PackedWeightCache::Save(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!dirty_) return;
+  // Written into a temporary file first, so the processes loading the cache
+  // at the same time never see a partial one.
+  std::string tmp_path = path + ".tmp";
+  {
+    model_parser::BinaryFileWriter file(tmp_path);
+    const model_parser::ByteWriter& writer = file;
+    writer.Write<uint32_t>(kMagic);
+    writer.Write<uint32_t>(kVersion);
+    writer.Write<uint64_t>(entries_.size());
+    for (auto& item : entries_) {
+      auto& entry = item.second;
+      writer.Write<uint32_t>(item.first.size());
+      writer.Write(item.first.data(), item.first.size());
+      writer.Write<int32_t>(static_cast<int32_t>(entry.precision));
+      writer.Write<uint32_t>(entry.dims.size());
+      for (size_t i = 0; i < entry.dims.size(); i++) {
+        writer.Write<int64_t>(entry.dims[i]);
+      }
+      writer.Write<uint64_t>(entry.size);
+      writer.Align(kAlignment);
+      writer.Write(
+          static_cast<const char*>(entry.buffer->data()) + entry.offset,
+          entry.size);
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    LOG(WARNING) << "Failed to save the packed weight cache " << path;
+    std::remove(tmp_path.c_str());
+    return;
+  }
+  dirty_ = false;
+  VLOG(1) << "Saved " << entries_.size() << " packed weights into " << path;
+}
+
+bool PackedWeightCache::dirty() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return dirty_;
+}
+
+size_t PackedWeightCache::size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+void PackedWeightCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  path_.clear();
+  enabled_ = false;
+  dirty_ = false;
+}
+
+void PackedWeightCache::Pack(const std::string& kernel,
+                             const Tensor& weight,
+                             Tensor* packed,
+                             const std::function<void()>& pack) {
+  CHECK(packed);
+  if (!enabled_) {
+    pack();
+    return;
+  }
+  auto key = Key(kernel, weight);
+  if (Lookup(key, packed)) return;
+  // Leave the cached memory shared before, which must not be overwritten.
+  packed->clear();
+  pack();
+  Insert(key, packed);
+}
+
+bool PackedWeightCache::Lookup(const std::string& key, Tensor* packed) {
+  Entry entry;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return false;
+    entry = it->second;
+  }
+  Tensor cached;
+  cached.Resize(entry.dims);
+  cached.set_precision(entry.precision);
+  cached.ResetBuffer(std::make_shared<ArenaBuffer>(
+                         entry.buffer, entry.offset, entry.size, TARGET(kHost)),
+                     entry.size);
+  packed->ShareDataWith(cached);
+  return true;
+}
+
+void PackedWeightCache::Insert(const std::string& key, Tensor* packed) {
+  Entry entry;
+  entry.size = packed->memory_size();
+  entry.precision = packed->precision();
+  entry.dims = packed->dims();
+  entry.buffer = std::make_shared<Buffer>();
+  entry.buffer->ResetLazy(TARGET(kHost), entry.size);
+  TargetCopy(
+      TARGET(kHost), entry.buffer->data(), packed->raw_data(), entry.size);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!entries_.emplace(key, entry).second) return;
+    dirty_ = true;
+  }
+  // Share the cached copy instead of keeping both.
+  Lookup(key, packed);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,80 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+
+// The weights packed by the kernels in PrepareForRun, e.g. the blocked
+// layouts of the gemm-like and winograd convs, which can be saved into a
+// sidecar file and mapped by the later processes to skip the packing. The
+// entries are keyed by the kernel, the arch and the ISA features of the cpu,
+// and the fingerprint of the original weight, so a stale or foreign cache
+// file is never misused, only missed.
+class PackedWeightCache {
+ public:
+  static PackedWeightCache& Global();
+
+  // Enable the cache and map the entries saved in `path`, the missing or
+  // broken file is ignored. Loading the same file again does nothing.
+  void Load(const std::string& path);
+  // Save all the entries into `path` if any is added since loaded.
+  void Save(const std::string& path);
+  bool enabled() const { return enabled_; }
+  bool dirty();
+  size_t size();
+  void Clear();
+
+  // Share the cached weight packed from `weight` by `kernel` with `packed`,
+  // or call `pack` to pack it into `packed` and cache the result. `kernel`
+  // names the kernel and the parameters which affect the packing other than
+  // the weight itself, e.g. "conv_gemmlike/groups:1". Just calls `pack` if
+  // the cache is disabled.
+  void Pack(const std::string& kernel,
+            const Tensor& weight,
+            Tensor* packed,
+            const std::function<void()>& pack);
+
+  static std::string Key(const std::string& kernel, const Tensor& weight);
+
+ private:
+  struct Entry {
+    std::shared_ptr<Buffer> buffer;
+    size_t offset{0};
+    size_t size{0};
+    PrecisionType precision{PRECISION(kUnk)};
+    DDim dims;
+  };
+
+  PackedWeightCache() = default;
+  bool Lookup(const std::string& key, Tensor* packed);
+  void Insert(const std::string& key, Tensor* packed);
+
+  std::atomic<bool> enabled_{false};
+  bool dirty_{false};
+  std::string path_;
+  std::map<std::string, Entry> entries_;
+  std::mutex mutex_;
+};
+
+}  // namespace lite
+}  // namespace paddle
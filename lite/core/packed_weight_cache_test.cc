@@ -0,0 +1,112 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/packed_weight_cache.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+
+namespace paddle {
+namespace lite {
+
+void FillWeight(Tensor* weight, float value) {
+  weight->Resize({4, 8});
+  auto* data = weight->mutable_data<float>();
+  for (int i = 0; i < weight->numel(); i++) data[i] = value + i;
+}
+
+// Pack by reversing the weight.
+void PackWeight(const Tensor& weight, Tensor* packed, int* packed_times) {
+  auto& cache = PackedWeightCache::Global();
+  cache.Pack("reverse", weight, packed, [&] {
+    packed->Resize({weight.numel()});
+    auto* out = packed->mutable_data<float>();
+    auto* in = weight.data<float>();
+    for (int i = 0; i < weight.numel(); i++) {
+      out[i] = in[weight.numel() - 1 - i];
+    }
+    (*packed_times)++;
+  });
+}
+
+TEST(PackedWeightCache, disabled) {
+  PackedWeightCache::Global().Clear();
+  Tensor weight, packed;
+  FillWeight(&weight, 0.f);
+  int packed_times = 0;
+  PackWeight(weight, &packed, &packed_times);
+  PackWeight(weight, &packed, &packed_times);
+  EXPECT_EQ(packed_times, 2);
+  EXPECT_EQ(PackedWeightCache::Global().size(), 0u);
+}
+
+TEST(PackedWeightCache, save_and_load) {
+  std::string path = "packed_weight_cache_test.bin";
+  std::remove(path.c_str());
+  auto& cache = PackedWeightCache::Global();
+  cache.Clear();
+  cache.Load(path);
+  Tensor weight0, weight1, packed0, packed1;
+  FillWeight(&weight0, 0.f);
+  FillWeight(&weight1, 100.f);
+  int packed_times = 0;
+  PackWeight(weight0, &packed0, &packed_times);
+  PackWeight(weight1, &packed1, &packed_times);
+  // The same weight in another kernel instance hits the cache.
+  Tensor packed2;
+  PackWeight(weight0, &packed2, &packed_times);
+  EXPECT_EQ(packed_times, 2);
+  EXPECT_EQ(packed2.data<float>()[0], 31.f);
+  EXPECT_TRUE(cache.dirty());
+  cache.Save(path);
+  EXPECT_FALSE(cache.dirty());
+
+  // A new process maps the saved entries.
+  cache.Clear();
+  cache.Load(path);
+  EXPECT_EQ(cache.size(), 2u);
+  Tensor packed3;
+  PackWeight(weight1, &packed3, &packed_times);
+  EXPECT_EQ(packed_times, 2);
+  EXPECT_EQ(packed3.dims(), DDim(std::vector<int64_t>({32})));
+  EXPECT_EQ(reinterpret_cast<size_t>(packed3.data<float>()) % 64, 0u);
+  EXPECT_EQ(packed3.data<float>()[0], 131.f);
+  EXPECT_EQ(packed3.data<float>()[31], 100.f);
+  // A changed weight misses.
+  weight1.mutable_data<float>()[0] = -1.f;
+  PackWeight(weight1, &packed3, &packed_times);
+  EXPECT_EQ(packed_times, 3);
+  EXPECT_EQ(packed3.data<float>()[31], -1.f);
+  cache.Clear();
+  std::remove(path.c_str());
+}
+
+TEST(PackedWeightCache, broken_file) {
+  std::string path = "packed_weight_cache_broken.bin";
+  FILE* file = fopen(path.c_str(), "wb");
+  ASSERT_TRUE(file);
+  const char garbage[] = "not a packed weight cache";
+  fwrite(garbage, 1, sizeof(garbage), file);
+  fclose(file);
+  auto& cache = PackedWeightCache::Global();
+  cache.Clear();
+  cache.Load(path);
+  EXPECT_TRUE(cache.enabled());
+  EXPECT_EQ(cache.size(), 0u);
+  cache.Clear();
+  std::remove(path.c_str());
+}
+
+}  // namespace lite
+}  // namespace paddle
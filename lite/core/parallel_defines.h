@@ -49,19 +49,117 @@
   paddle::lite::ThreadPool::Enqueue(std::move(task)); \
   }
 
+/* support 2D tiled for loop, the (i, j) tiles are distributed to threads as a
+ * whole, `grain` is the minimum number of adjacent tiles run by one thread
+ * for (int i = start0; i < end0; i += step0)
+ *   for (int j = start1; j < end1; j += step1)
+ */
+#define LITE_PARALLEL_COMMON_2D_BEGIN(                          \
+    i, j, tid, end0, start0, step0, end1, start1, step1, grain) \
+  {                                                             \
+    paddle::lite::ThreadPool::TASK_2D task;                     \
+    std::get<1>(task) = end0;                                   \
+    std::get<2>(task) = start0;                                 \
+    std::get<3>(task) = step0;                                  \
+    std::get<4>(task) = end1;                                   \
+    std::get<5>(task) = start1;                                 \
+    std::get<6>(task) = step1;                                  \
+    std::get<7>(task) = grain;                                  \
+  std::get<0>(task) = [&](int i, int j, int tid) {
+#define LITE_PARALLEL_COMMON_2D_END()                 \
+  }                                                   \
+  ;                                                   \
+  paddle::lite::ThreadPool::Enqueue(std::move(task)); \
+  }
+
+/* support 3D tiled for loop
+ * for (int i = start0; i < end0; i += step0)
+ *   for (int j = start1; j < end1; j += step1)
+ *     for (int k = start2; k < end2; k += step2)
+ */
+#define LITE_PARALLEL_COMMON_3D_BEGIN(i,      \
+                                      j,      \
+                                      k,      \
+                                      tid,    \
+                                      end0,   \
+                                      start0, \
+                                      step0,  \
+                                      end1,   \
+                                      start1, \
+                                      step1,  \
+                                      end2,   \
+                                      start2, \
+                                      step2,  \
+                                      grain)  \
+  {                                           \
+    paddle::lite::ThreadPool::TASK_3D task;   \
+    std::get<1>(task) = end0;                 \
+    std::get<2>(task) = start0;               \
+    std::get<3>(task) = step0;                \
+    std::get<4>(task) = end1;                 \
+    std::get<5>(task) = start1;               \
+    std::get<6>(task) = step1;                \
+    std::get<7>(task) = end2;                 \
+    std::get<8>(task) = start2;               \
+    std::get<9>(task) = step2;                \
+    std::get<10>(task) = grain;               \
+  std::get<0>(task) = [&](int i, int j, int k, int tid) {
+#define LITE_PARALLEL_COMMON_3D_END()                 \
+  }                                                   \
+  ;                                                   \
+  paddle::lite::ThreadPool::Enqueue(std::move(task)); \
+  }
+
 #elif defined(ARM_WITH_OMP)
 #include <omp.h>
 
-#define LITE_PARALLEL_BEGIN(index, tid, work_size)                     \
-  _Pragma("omp parallel for") for (int index = 0; index < (work_size); \
-                                   ++index) {
+// The loops follow the schedule set by DeviceInfo::SetRunMode, which is
+// dynamic when the active cores differ in speed.
+#define LITE_PARALLEL_BEGIN(index, tid, work_size)                        \
+  _Pragma("omp parallel for schedule(runtime)") for (int index = 0;       \
+                                                     index < (work_size); \
+                                                     ++index) {
 #define LITE_PARALLEL_END() }
 
-#define LITE_PARALLEL_COMMON_BEGIN(index, tid, end, start, step)       \
-  _Pragma("omp parallel for") for (int index = (start); index < (end); \
-                                   index += (step)) {
+#define LITE_PARALLEL_COMMON_BEGIN(index, tid, end, start, step)          \
+  _Pragma("omp parallel for schedule(runtime)") for (int index = (start); \
+                                                     index < (end);       \
+                                                     index += (step)) {
 #define LITE_PARALLEL_COMMON_END() }
 
+#define LITE_PARALLEL_COMMON_2D_BEGIN(                            \
+    i, j, tid, end0, start0, step0, end1, start1, step1, grain)   \
+  _Pragma("omp parallel for collapse(2) schedule(runtime)") for ( \
+      int i = (start0); i < (end0); i += (step0)) {               \
+    for (int j = (start1); j < (end1); j += (step1)) {
+#define LITE_PARALLEL_COMMON_2D_END() \
+  }                                   \
+  }
+
+#define LITE_PARALLEL_COMMON_3D_BEGIN(                            \
+    i,                                                            \
+    j,                                                            \
+    k,                                                            \
+    tid,                                                          \
+    end0,                                                         \
+    start0,                                                       \
+    step0,                                                        \
+    end1,                                                         \
+    start1,                                                       \
+    step1,                                                        \
+    end2,                                                         \
+    start2,                                                       \
+    step2,                                                        \
+    grain)                                                        \
+  _Pragma("omp parallel for collapse(3) schedule(runtime)") for ( \
+      int i = (start0); i < (end0); i += (step0)) {               \
+    for (int j = (start1); j < (end1); j += (step1)) {            \
+      for (int k = (start2); k < (end2); k += (step2)) {
+#define LITE_PARALLEL_COMMON_3D_END() \
+  }                                   \
+  }                                   \
+  }
+
 #else
 #define LITE_PARALLEL_BEGIN(index, tid, work_size) \
   for (int index = 0; index < (work_size); ++index) {
@@ -70,4 +168,55 @@
 #define LITE_PARALLEL_COMMON_BEGIN(index, tid, end, start, step) \
   for (int index = (start); index < (end); index += (step)) {
 #define LITE_PARALLEL_COMMON_END() }
+
+#define LITE_PARALLEL_COMMON_2D_BEGIN(                          \
+    i, j, tid, end0, start0, step0, end1, start1, step1, grain) \
+  for (int i = (start0); i < (end0); i += (step0)) {            \
+    for (int j = (start1); j < (end1); j += (step1)) {
+#define LITE_PARALLEL_COMMON_2D_END() \
+  }                                   \
+  }
+
+#define LITE_PARALLEL_COMMON_3D_BEGIN(i,               \
+                                      j,               \
+                                      k,               \
+                                      tid,             \
+                                      end0,            \
+                                      start0,          \
+                                      step0,           \
+                                      end1,            \
+                                      start1,          \
+                                      step1,           \
+                                      end2,            \
+                                      start2,          \
+                                      step2,           \
+                                      grain)           \
+  for (int i = (start0); i < (end0); i += (step0)) {   \
+    for (int j = (start1); j < (end1); j += (step1)) { \
+      for (int k = (start2); k < (end2); k += (step2)) {
+#define LITE_PARALLEL_COMMON_3D_END() \
+  }                                   \
+  }                                   \
+  }
 #endif
+
+namespace paddle {
+namespace lite {
+
+// Return the number of blocks along the second axis that forms one tile of a
+// 2D parallel loop, so that the `m_blocks` x `n_blocks` blocks are split into
+// enough tiles to keep `threads` threads busy while the tiles stay as wide as
+// possible along the second axis.
+inline int ParallelTileSize(int m_blocks, int n_blocks, int threads) {
+  const int kTilesPerThread = 4;
+  int tiles = threads * kTilesPerThread;
+  if (m_blocks >= tiles || n_blocks <= 1) {
+    return n_blocks > 0 ? n_blocks : 1;
+  }
+  int n_tiles = (tiles + m_blocks - 1) / m_blocks;
+  n_tiles = n_tiles < n_blocks ? n_tiles : n_blocks;
+  return (n_blocks + n_tiles - 1) / n_tiles;
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,140 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/profile/memory_profiler.h"
+#include <algorithm>
+#include <iomanip>
+#include "lite/utils/env.h"
+#include "lite/utils/replace_stl/stream.h"
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+bool MemoryProfiler::enabled_ = GetBoolFromEnv("LITE_PROFILE_MEMORY");
+
+MemoryProfiler& MemoryProfiler::Global() {
+  // Never destroyed, since the static buffers may be freed after it.
+  static MemoryProfiler* x = new MemoryProfiler;
+  return *x;
+}
+
+void MemoryProfiler::RecordMalloc(const void* buffer,
+                                  lite_api::TargetType target,
+                                  size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Allocation allocation;
+  allocation.target = target;
+  allocation.size = size;
+  allocation.malloc_op = op_index_;
+  allocation.last_use_op = op_index_;
+  allocation.malloc_seq = seq_++;
+  live_[buffer] = allocations_.size();
+  allocations_.push_back(allocation);
+  used_ += size;
+  if (used_ > peak_) {
+    peak_ = used_;
+    peak_seq_ = allocation.malloc_seq;
+    peak_op_ = op_index_;
+  }
+}
+
+void MemoryProfiler::RecordFree(const void* buffer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = live_.find(buffer);
+  if (it == live_.end()) return;
+  auto& allocation = allocations_[it->second];
+  allocation.free_op = op_index_;
+  allocation.free_seq = seq_++;
+  used_ -= allocation.size;
+  live_.erase(it);
+}
+
+void MemoryProfiler::BeginOp(int op_index, const std::string& op_type) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  op_index_ = op_index;
+  op_types_[op_index] = op_type;
+}
+
+void MemoryProfiler::RecordUse(const void* buffer,
+                               const std::string& var_name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = live_.find(buffer);
+  if (it == live_.end()) return;
+  auto& allocation = allocations_[it->second];
+  if (allocation.var_name.empty()) {
+    allocation.var_name = var_name;
+  } else if (allocation.var_name.find(var_name) == std::string::npos) {
+    // The buffer is shared by the variables, e.g. reused by the memory
+    // optimization.
+    allocation.var_name += "," + var_name;
+  }
+  allocation.last_use_op = std::max(allocation.last_use_op, op_index_);
+}
+
+void MemoryProfiler::EndOp() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  op_index_ = -1;
+}
+
+std::string MemoryProfiler::OpName(int op_index) {
+  if (op_index < 0) return "N/A";
+  return std::to_string(op_index) + ":" + op_types_[op_index];
+}
+
+std::string MemoryProfiler::Summary() {
+  using std::setw;
+  using std::left;
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<const Allocation*> peak_allocations;
+  size_t dead_size = 0;
+  for (auto& allocation : allocations_) {
+    if (allocation.malloc_seq <= peak_seq_ &&
+        allocation.free_seq > peak_seq_) {
+      peak_allocations.push_back(&allocation);
+      if (allocation.last_use_op < peak_op_) dead_size += allocation.size;
+    }
+  }
+  std::sort(peak_allocations.begin(),
+            peak_allocations.end(),
+            [](const Allocation* x, const Allocation* y) {
+              return x->size > y->size;
+            });
+  STL::stringstream ss;
+  ss << "===== Memory Profiler Summary: " << allocations_.size()
+     << " allocations, peak " << peak_ << " bytes at op " << OpName(peak_op_)
+     << ", " << dead_size << " bytes of which are not used after op "
+     << OpName(peak_op_) << " =====" << std::endl;
+  ss << setw(40) << left << "Variable"
+     << " " << setw(10) << left << "Target"
+     << " " << setw(12) << left << "Bytes"
+     << " " << setw(24) << left << "MallocOp"
+     << " " << setw(24) << left << "LastUseOp"
+     << " " << setw(24) << left << "FreeOp" << std::endl;
+  for (auto* allocation : peak_allocations) {
+    ss << setw(40) << left
+       << (allocation->var_name.empty() ? "N/A" : allocation->var_name)
+       << " " << setw(10) << left
+       << lite_api::TargetToStr(allocation->target)
+       << " " << setw(12) << left << allocation->size
+       << " " << setw(24) << left << OpName(allocation->malloc_op)
+       << " " << setw(24) << left << OpName(allocation->last_use_op)
+       << " " << setw(24) << left << OpName(allocation->free_op) << std::endl;
+  }
+  return ss.str();
+}
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
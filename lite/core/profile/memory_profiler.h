@@ -0,0 +1,81 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstdint>
+#include <map>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+#include "lite/api/paddle_place.h"
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+// Record every allocation of the buffers with the variable owning it, the op
+// allocating it, the last op using it and when it's freed, which is enabled
+// by setting the environment variable LITE_PROFILE_MEMORY=1 in the profile
+// builds. Summary() reports the op at the peak of the allocated memory and the
+// buffers live at that point, e.g. the ones whose last use is earlier than the
+// peak may be reused by MemoryOptimizePass.
+class MemoryProfiler {
+ public:
+  static MemoryProfiler& Global();
+  static bool Enabled() { return enabled_; }
+
+  // Called by the buffers.
+  void RecordMalloc(const void* buffer,
+                    lite_api::TargetType target,
+                    size_t size);
+  void RecordFree(const void* buffer);
+  // Called by the instructions around the kernel runs.
+  void BeginOp(int op_index, const std::string& op_type);
+  void RecordUse(const void* buffer, const std::string& var_name);
+  void EndOp();
+
+  std::string Summary();
+
+ private:
+  struct Allocation {
+    std::string var_name;
+    lite_api::TargetType target;
+    size_t size;
+    int malloc_op;
+    int last_use_op;
+    int free_op{-1};
+    uint64_t malloc_seq;
+    uint64_t free_seq{UINT64_MAX};
+  };
+
+  MemoryProfiler() = default;
+  std::string OpName(int op_index);
+
+  static bool enabled_;
+  std::mutex mutex_;
+  std::vector<Allocation> allocations_;
+  // The live allocation of each buffer.
+  std::map<const void*, size_t> live_;
+  std::map<int, std::string> op_types_;
+  int op_index_{-1};
+  uint64_t seq_{0};
+  size_t used_{0};
+  size_t peak_{0};
+  uint64_t peak_seq_{0};
+  int peak_op_{-1};
+};
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,101 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/profile/perf_counter.h"
+#if defined(__linux__) || defined(__ANDROID__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include <cerrno>
+#include <cstring>
+#include "lite/utils/env.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+#if defined(__linux__) || defined(__ANDROID__)
+static int OpenPerfEvent(uint32_t type, uint64_t config) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return static_cast<int>(
+      syscall(__NR_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+#endif
+
+PerfCounters& PerfCounters::ThisThread() {
+  static thread_local PerfCounters counters;
+  return counters;
+}
+
+bool PerfCounters::Enabled() {
+  static bool enabled = GetBoolFromEnv("LITE_PROFILE_PMU");
+  return enabled;
+}
+
+PerfCounters::PerfCounters() {
+  for (int i = 0; i < kPerfEventCount; i++) fds_[i] = -1;
+#if defined(__linux__) || defined(__ANDROID__)
+  fds_[kPerfCycles] =
+      OpenPerfEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+  if (fds_[kPerfCycles] < 0) {
+    LOG(WARNING) << "Failed to open the PMU counters(" << strerror(errno)
+                 << "), please check /proc/sys/kernel/perf_event_paranoid.";
+    return;
+  }
+  fds_[kPerfInstructions] =
+      OpenPerfEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  fds_[kPerfL1DMisses] =
+      OpenPerfEvent(PERF_TYPE_HW_CACHE,
+                    PERF_COUNT_HW_CACHE_L1D |
+                        (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+  fds_[kPerfL2Misses] =
+      OpenPerfEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+  fds_[kPerfStalledCycles] =
+      OpenPerfEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND);
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#if defined(__linux__) || defined(__ANDROID__)
+  for (int i = 0; i < kPerfEventCount; i++) {
+    if (fds_[i] >= 0) close(fds_[i]);
+  }
+#endif
+}
+
+void PerfCounters::Read(PerfCounts* counts) const {
+  CHECK(counts);
+  for (int i = 0; i < kPerfEventCount; i++) {
+    counts->values[i] = 0;
+#if defined(__linux__) || defined(__ANDROID__)
+    uint64_t value = 0;
+    if (fds_[i] >= 0 && read(fds_[i], &value, sizeof(value)) == sizeof(value)) {
+      counts->values[i] = value;
+    }
+#endif
+  }
+}
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,68 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstdint>
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+// The hardware events counted by the PMU.
+enum PerfEvent {
+  kPerfCycles = 0,
+  kPerfInstructions,
+  kPerfL1DMisses,
+  kPerfL2Misses,
+  kPerfStalledCycles,
+  kPerfEventCount,
+};
+
+struct PerfCounts {
+  uint64_t values[kPerfEventCount]{0};
+
+  void Accumulate(const PerfCounts& begin, const PerfCounts& end) {
+    for (int i = 0; i < kPerfEventCount; i++) {
+      values[i] += end.values[i] - begin.values[i];
+    }
+  }
+};
+
+// The PMU counters of the calling thread opened by perf_event_open, which are
+// enabled by setting the environment variable LITE_PROFILE_PMU=1 and only
+// supported on Linux and Android. The L2 misses are counted by the last level
+// cache event, which is the L2 cache of most of the ARM cores. An event not
+// supported by the cpu or the kernel stays zero, and all of the counters are
+// disabled if the cycles can't be counted, e.g. perf_event_paranoid is too
+// high. The threads of the thread pool are not counted.
+class PerfCounters {
+ public:
+  // The counters of the calling thread, which are opened at the first call.
+  static PerfCounters& ThisThread();
+  static bool Enabled();
+
+  ~PerfCounters();
+  bool valid() const { return fds_[kPerfCycles] >= 0; }
+  // Read the counts since the counters are opened.
+  void Read(PerfCounts* counts) const;
+
+ private:
+  PerfCounters();
+
+  int fds_[kPerfEventCount];
+};
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
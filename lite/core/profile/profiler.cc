@@ -13,10 +13,14 @@
 // limitations under the License.
 
 #include "lite/core/profile/profiler.h"
+#include <algorithm>
+#include <cstdlib>
 #include <iomanip>
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
+#include "lite/utils/env.h"
 
 namespace paddle {
 namespace lite {
@@ -76,11 +80,21 @@ void Profiler::StartTiming(Type type, const int index, KernelContext* ctx) {
   CHECK_LT(index, units_.size())
       << "The timer index in the profiler is out of range.";
   units_[index].Timer(type)->Start(ctx);
+  // Read the PMU after the timer starts and before it stops to exclude the
+  // timers themselves.
+  if (type == Type::kDispatch && PerfCounters::Enabled()) {
+    PerfCounters::ThisThread().Read(&units_[index].perf_start);
+  }
 }
 
 void Profiler::StopTiming(Type type, const int index, KernelContext* ctx) {
   CHECK_LT(index, units_.size())
       << "The timer index in the profiler is out of range.";
+  if (type == Type::kDispatch && PerfCounters::Enabled()) {
+    PerfCounts perf_end;
+    PerfCounters::ThisThread().Read(&perf_end);
+    units_[index].perf_counts.Accumulate(units_[index].perf_start, perf_end);
+  }
 #ifdef LITE_WITH_OPENCL
   units_[index].Timer(type)->CLStop(units_[index].character.op_type,
                                     units_[index].character.io_duration,
@@ -313,6 +327,147 @@ std::string Profiler::Summary(Type type, bool concise, size_t w) {
       ss << std::endl;
     }
   }
+  if (type == Type::kDispatch) {
+    ss << RooflineSummary(type, w);
+    if (PerfCounters::Enabled()) ss << PerfSummary();
+  }
+  return ss.str();
+}
+
+std::string Profiler::RooflineSummary(Type type, size_t w) {
+  using std::setw;
+  using std::left;
+  using std::fixed;
+  using std::setprecision;
+  struct Roofline {
+    std::string op_type;
+    double ms{0};
+    double flops{0};
+    double bytes{0};
+  };
+  std::vector<Roofline> summary;
+  std::map<std::string, size_t> indexes;
+  double total_ms = 0;
+  for (auto& unit : units_) {
+    auto& ch = unit.Character();
+    auto it = indexes.find(ch.op_type);
+    if (it == indexes.end()) {
+      it = indexes.emplace(ch.op_type, summary.size()).first;
+      summary.emplace_back();
+      summary.back().op_type = ch.op_type;
+    }
+    auto& item = summary[it->second];
+    auto ms = unit.Timer(type)->LapTimes().Avg(w);
+    item.ms += ms;
+    item.flops += ch.macs;
+    item.bytes += ch.bytes;
+    total_ms += ms;
+  }
+  // GFLOP/s and GB/s are FLOPs and bytes per nanosecond.
+  auto GFlops = [](const Roofline& x) {
+    return x.ms > 0 ? x.flops / (x.ms * 1e6) : 0.0;
+  };
+  auto GBps = [](const Roofline& x) {
+    return x.ms > 0 ? x.bytes / (x.ms * 1e6) : 0.0;
+  };
+  auto peak_gflops = atof(GetStringFromEnv("LITE_PROFILE_PEAK_GFLOPS").c_str());
+  auto peak_gbps = atof(GetStringFromEnv("LITE_PROFILE_PEAK_GBPS").c_str());
+  bool measured_gflops = peak_gflops <= 0;
+  bool measured_gbps = peak_gbps <= 0;
+  for (auto& item : summary) {
+    if (measured_gflops) peak_gflops = std::max(peak_gflops, GFlops(item));
+    if (measured_gbps) peak_gbps = std::max(peak_gbps, GBps(item));
+  }
+  std::sort(summary.begin(),
+            summary.end(),
+            [](const Roofline& x, const Roofline& y) { return x.ms > y.ms; });
+
+  STL::stringstream ss;
+  ss << "===== Roofline Summary: " << name_ << ", Peak " << fixed
+     << setprecision(2) << peak_gflops << " GFLOP/s"
+     << (measured_gflops ? "(best achieved)" : "") << ", " << peak_gbps
+     << " GB/s" << (measured_gbps ? "(best achieved)" : "") << " ====="
+     << std::endl;
+  ss << setw(20) << left << "OperatorType"
+     << " " << setw(7) << left << "Avg(ms)"
+     << " " << setw(7) << left << "Avg(%)"
+     << " " << setw(9) << left << "GFLOP/s"
+     << " " << setw(7) << left << "GB/s"
+     << " " << setw(9) << left << "FLOP/Byte"
+     << " " << setw(7) << left << "Bound"
+     << " " << setw(9) << left << "Roofline(%)" << std::endl;
+  for (auto& item : summary) {
+    double intensity = item.bytes > 0 ? item.flops / item.bytes : 0.0;
+    // The attainable performance is limited by either the compute or the
+    // memory bandwidth, depending on the arithmetic intensity.
+    double attainable = std::min(peak_gflops, intensity * peak_gbps);
+    bool memory_bound = attainable < peak_gflops;
+    double efficiency = 0;
+    if (item.flops > 0 && attainable > 0) {
+      efficiency = 100 * GFlops(item) / attainable;
+    } else if (item.bytes > 0 && peak_gbps > 0) {
+      memory_bound = true;
+      efficiency = 100 * GBps(item) / peak_gbps;
+    }
+    double percent = total_ms > 0 ? 100 * item.ms / total_ms : 0.0;
+    ss << setw(20) << left << item.op_type
+       << " " << setw(7) << left << fixed << setprecision(3) << item.ms
+       << " " << setw(7) << left << fixed << setprecision(2) << percent
+       << " " << setw(9) << left << fixed << setprecision(2) << GFlops(item)
+       << " " << setw(7) << left << fixed << setprecision(2) << GBps(item)
+       << " " << setw(9) << left << fixed << setprecision(2) << intensity
+       << " " << setw(7) << left << (memory_bound ? "memory" : "compute")
+       << " " << setw(9) << left << fixed << setprecision(1) << efficiency;
+    // Point out the op types worth optimizing: taking a noticeable share of
+    // the time while far from the roofline.
+    if (percent >= 5 && efficiency < 30) ss << " <- far from roofline";
+    ss << std::endl;
+  }
+  return ss.str();
+}
+
+std::string Profiler::PerfSummary() {
+  using std::setw;
+  using std::left;
+  using std::fixed;
+  using std::setprecision;
+  STL::stringstream ss;
+  if (!PerfCounters::ThisThread().valid()) {
+    ss << "===== PMU Summary: " << name_ << ", unavailable =====" << std::endl;
+    return ss.str();
+  }
+  std::map<std::string, PerfCounts> summary;
+  for (auto& unit : units_) {
+    auto& counts = summary[unit.Character().op_type];
+    for (int i = 0; i < kPerfEventCount; i++) {
+      counts.values[i] += unit.perf_counts.values[i];
+    }
+  }
+  auto Ratio = [](uint64_t x, uint64_t y) {
+    return y > 0 ? static_cast<double>(x) / y : 0.0;
+  };
+  ss << "===== PMU Summary: " << name_ << " =====" << std::endl;
+  ss << setw(20) << left << "OperatorType"
+     << " " << setw(12) << left << "MCycles"
+     << " " << setw(7) << left << "IPC"
+     << " " << setw(11) << left << "L1DMPKI"
+     << " " << setw(11) << left << "L2MPKI"
+     << " " << setw(9) << left << "Stall(%)" << std::endl;
+  for (auto& item : summary) {
+    auto* values = item.second.values;
+    ss << setw(20) << left << item.first
+       << " " << setw(12) << left << fixed << setprecision(3)
+       << values[kPerfCycles] * 1e-6
+       << " " << setw(7) << left << fixed << setprecision(2)
+       << Ratio(values[kPerfInstructions], values[kPerfCycles])
+       << " " << setw(11) << left << fixed << setprecision(2)
+       << 1000 * Ratio(values[kPerfL1DMisses], values[kPerfInstructions])
+       << " " << setw(11) << left << fixed << setprecision(2)
+       << 1000 * Ratio(values[kPerfL2Misses], values[kPerfInstructions])
+       << " " << setw(9) << left << fixed << setprecision(2)
+       << 100 * Ratio(values[kPerfStalledCycles], values[kPerfCycles])
+       << std::endl;
+  }
   return ss.str();
 }
 
@@ -17,6 +17,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "lite/core/profile/perf_counter.h"
 #include "lite/core/profile/timer.h"
 #include "lite/core/tensor.h"
 #include "lite/utils/replace_stl/stream.h"
@@ -61,8 +62,12 @@ struct OpCharacter {
   std::string output_shape{"N/A"};
   std::string filter_shape{"N/A"};
 
+  // The operations of the op, i.e. FLOPs for the float ops.
   float macs{0};
   float macs_ps{0};
+  // The memory traffic, estimated by the sizes of the inputs and outputs if
+  // the op doesn't set it.
+  float bytes{0};
 
   float io_duration{0};
 
@@ -114,6 +119,9 @@ class StatisUnit final {
   OpCharacter& Character() { return character; }
 
   OpCharacter character;
+  // The PMU counts of the dispatches, see PerfCounters.
+  PerfCounts perf_start;
+  PerfCounts perf_counts;
 
  protected:
   std::unique_ptr<lite::profile::Timer> create_t;
@@ -135,6 +143,13 @@ class Profiler final {
                                  const std::string& kernel_attr,
                                  const std::string& kernel_func_name);
   OpCharacter* GetOpCharacter(const size_t index);
+  // The IPC and the miss rates of the op types, see PerfCounters.
+  std::string PerfSummary();
+  // The achieved GFLOP/s and GB/s of the op types against the roofline of
+  // the device, whose peaks are set by the environment variables
+  // LITE_PROFILE_PEAK_GFLOPS and LITE_PROFILE_PEAK_GBPS, or the best achieved
+  // ones of this run if not set.
+  std::string RooflineSummary(Type type, size_t warm_up);
 
  private:
   std::string name_{std::string("N/A")};
@@ -0,0 +1,95 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/profile/timeline.h"
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstring>
+#include <sstream>
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+Timeline& Timeline::Global() {
+  static Timeline timeline;
+  return timeline;
+}
+
+void Timeline::Start(size_t capacity) {
+  capacity = std::max<size_t>(capacity, 1);
+  if (capacity != capacity_) {
+    events_.reset(new TimelineEvent[capacity]);
+    capacity_ = capacity;
+  }
+  memset(events_.get(), 0, capacity_ * sizeof(TimelineEvent));
+  next_.store(0, std::memory_order_relaxed);
+  enabled_.store(true, std::memory_order_release);
+}
+
+TimelineEvent* Timeline::NewEvent() {
+  if (!enabled()) return nullptr;
+  auto index = next_.fetch_add(1, std::memory_order_relaxed);
+  return &events_[index % capacity_];
+}
+
+uint64_t Timeline::NowMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+int Timeline::ThreadId() {
+  static std::atomic<int> thread_count{0};
+  thread_local int thread_id = thread_count.fetch_add(1);
+  return thread_id;
+}
+
+static void WriteJsonString(std::ostringstream* os, const char* str) {
+  *os << '"';
+  for (; *str; str++) {
+    if (*str == '"' || *str == '\\') *os << '\\';
+    *os << *str;
+  }
+  *os << '"';
+}
+
+std::string Timeline::ExportChromeTrace() const {
+  std::ostringstream os;
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  auto count = std::min<uint64_t>(next_.load(), capacity_);
+  auto first = next_.load() - count;
+  bool has_event = false;
+  for (uint64_t i = first; i < first + count; i++) {
+    const auto& event = events_[i % capacity_];
+    // Skip the event which is claimed but not finished
+    if (event.end_us < event.start_us || event.start_us == 0) continue;
+    if (has_event) os << ",";
+    has_event = true;
+    os << "{\"name\":";
+    WriteJsonString(&os, event.name);
+    os << ",\"cat\":\"kernel\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+       << event.thread_id << ",\"ts\":" << event.start_us
+       << ",\"dur\":" << event.end_us - event.start_us
+       << ",\"args\":{\"input_shapes\":";
+    WriteJsonString(&os, event.input_shapes);
+    os << ",\"flops\":" << event.flops << "}}";
+  }
+  os << "]}";
+  return os.str();
+}
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
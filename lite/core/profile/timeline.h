@@ -0,0 +1,69 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace paddle {
+namespace lite {
+namespace profile {
+
+// A kernel run recorded by the timeline.
+struct TimelineEvent {
+  char name[64];
+  char input_shapes[96];
+  uint64_t start_us;
+  uint64_t end_us;
+  int thread_id;
+  float flops;
+};
+
+// The timeline records the start/stop time, thread, kernel name, input shapes
+// and FLOPs of each kernel run into a ring buffer, the oldest events are
+// overwritten. It's built without LITE_WITH_PROFILE and costs one relaxed
+// atomic load per kernel while stopped, so it can be switched on for the
+// sampled requests of the release binaries. The slots are claimed by an
+// atomic counter without any lock, Start and Export should be called while
+// no kernel is running.
+class Timeline {
+ public:
+  static Timeline& Global();
+
+  void Start(size_t capacity);
+  void Stop() { enabled_.store(false, std::memory_order_relaxed); }
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  // Claim the slot of a new event, return nullptr if the timeline is stopped.
+  TimelineEvent* NewEvent();
+
+  // Export the recorded events as a Chrome trace(JSON) which can be loaded by
+  // chrome://tracing or Perfetto.
+  std::string ExportChromeTrace() const;
+
+  static uint64_t NowMicros();
+  static int ThreadId();
+
+ private:
+  std::atomic<bool> enabled_{false};
+  std::atomic<uint64_t> next_{0};
+  std::unique_ptr<TimelineEvent[]> events_;
+  size_t capacity_{0};
+};
+
+}  // namespace profile
+}  // namespace lite
+}  // namespace paddle
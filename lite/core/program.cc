@@ -15,9 +15,18 @@
 #include "lite/core/program.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <set>
+#include <thread>  // NOLINT
 
+#include "lite/core/kv_cache.h"
+#include "lite/core/run_control.h"
+#include "lite/core/run_priority.h"
+#include "lite/core/thread_pool.h"
 #include "lite/model_parser/cpp_desc.h"
 #include "lite/operators/conditional_block_op.h"
 #include "lite/operators/subgraph_op.h"
@@ -28,6 +37,12 @@
 #ifdef LITE_WITH_FPGA
 #include "lite/backends/fpga/monitor.hpp"
 #endif
+#ifdef LITE_WITH_ARM
+#include "lite/core/device_info.h"
+#endif
+#ifdef LITE_WITH_XPU
+#include "lite/backends/xpu/target_wrapper.h"
+#endif
 
 namespace paddle {
 namespace lite {
@@ -130,6 +145,14 @@ void UpdateVarDescFromStepScopeInfo(cpp::VarDesc* var,
   var->SetPersistable(false);
 }
 
+void UpdateVarDescFromKVCacheInfo(cpp::VarDesc* var,
+                                  const std::string& var_name,
+                                  const std::string& op_type,
+                                  Scope* scope) {
+  var->SetType(cpp::VarDesc::Type::RAW);
+  var->SetPersistable(false);
+}
+
 const Type* GetVariableDeclTypeFromOpInfo(const std::string& var_name,
                                           const OpInfo* op_info,
                                           KernelBase* kernel) {
@@ -223,6 +246,8 @@ void AddVariableDescFromOpInfo(
       } else if (decl_type->IsStepScope() &&
                  var->IsType<std::vector<lite::Scope*>>()) {
         UpdateVarDescFromStepScopeInfo(v, var_name, op_type, scope);
+      } else if (decl_type->IsKVCache() && var->IsType<KVCache>()) {
+        UpdateVarDescFromKVCacheInfo(v, var_name, op_type, scope);
       } else {
         LOG(FATAL) << "Unsupported decl type " << *decl_type << " for var "
                    << var_name << " in op " << op_type;
@@ -263,7 +288,7 @@ RuntimeProgram::RuntimeProgram(
   CHECK(program_desc);
   auto block_size = program_desc->BlocksSize();
   CHECK(block_size) << "No block found!";
-  CHECK(block_idx >= 0 && block_idx < block_size)
+  CHECK(block_idx >= 0 && block_idx < static_cast<int>(block_size))
       << "Invalid block index, expected [0," << (block_size - 1) << "] but got "
       << block_idx;
   auto block_desc = program_desc->GetBlock<cpp::BlockDesc>(block_idx);
@@ -338,18 +363,25 @@ RuntimeProgram::RuntimeProgram(
           op_type + "' is not supported by Paddle-Lite.";
 #endif
 
-      auto kernels = op->CreateKernels({place});
-      if (kernels.size() == 0 && place.target == TargetType::kARM) {
-        place.target = TargetType::kHost;
-        kernels = op->CreateKernels({place});
+      // The tailored build creates the kernel from its static kernel table.
+      kernel = StaticKernelTable::Global().Create(op_type, alias, place);
+      if (kernel) {
+        op->AttachKernel(kernel.get());
+      } else {
+        auto kernels = op->CreateKernels({place});
+        if (kernels.size() == 0 && place.target == TargetType::kARM) {
+          place.target = TargetType::kHost;
+          kernels = op->CreateKernels({place});
+        }
+        CHECK_GT(kernels.size(), 0) << kernels_error_message;
+        auto it = std::find_if(kernels.begin(),
+                               kernels.end(),
+                               [&](std::unique_ptr<KernelBase>& it) {
+                                 return it->alias() == alias;
+                               });
+        CHECK(it != kernels.end());
+        kernel = std::move(*it);
       }
-      CHECK_GT(kernels.size(), 0) << kernels_error_message;
-      auto it = std::find_if(
-          kernels.begin(), kernels.end(), [&](std::unique_ptr<KernelBase>& it) {
-            return it->alias() == alias;
-          });
-      CHECK(it != kernels.end());
-      kernel = std::move(*it);
     } else {
       // TODO(hong19860320) add kernel picking according to the type of input
       // and output tensors
@@ -369,7 +401,24 @@ RuntimeProgram::RuntimeProgram(
     }
     instructions_[kRootBlockIdx].emplace_back(std::move(op), std::move(kernel));
   }
+#ifdef LITE_WITH_OPENCL
+  // Build the OpenCL programs in the background until the first run needs
+  // them.
+  for (auto& inst : instructions_[kRootBlockIdx]) {
+    if (inst.kernel() && inst.kernel()->target() == TARGET(kOpenCL)) {
+      CLRuntime::Global()->PrecompileProgramsAsync();
+      break;
+    }
+  }
+#endif
   Init();
+  // The variables of the sub blocks are planned by the root program, and
+  // their shapes are cached by the ops.
+  if (block_idx != kRootBlockIdx) {
+    use_memory_arena_ = false;
+    frozen_ = false;
+    parallel_prepare_ = false;
+  }
 }
 
 #ifdef LITE_WITH_METAL
@@ -385,6 +434,55 @@ void RuntimeProgram::ConfigMetalContext(std::string lib_path,
   context->set_use_aggressive(use_aggressive);
   context->set_metal_device(device);
   context->set_use_memory_reuse(use_memory_reuse_);
+  if (context->use_memory_reuse()) PlanMetalMemoryReuse(context);
+}
+
+void RuntimeProgram::PlanMetalMemoryReuse(MetalContext* context) {
+  // The vars of the sub blocks are not tracked.
+  if (!exec_scope_ || instructions_.size() != 1) return;
+  const int kAlive = std::numeric_limits<int>::max();
+  auto& insts = instructions_[kRootBlockIdx];
+  std::map<std::string, std::pair<int, int>> lifetimes;
+  std::vector<std::string> order;
+  for (int i = 0; i < static_cast<int>(insts.size()); i++) {
+    const auto* op_info = insts[i].op()->op_info();
+    for (auto& name : op_info->input_names()) {
+      auto it = lifetimes.find(name);
+      if (it == lifetimes.end()) continue;
+      // the fetched vars are alive after the run
+      it->second.second = op_info->Type() == "fetch" ? kAlive : i;
+    }
+    const auto* kernel = insts[i].kernel();
+    if (!kernel || kernel->target() != TARGET(kMetal)) continue;
+    for (auto& name : op_info->output_names()) {
+      if (lifetimes.count(name)) continue;
+      lifetimes[name] = std::make_pair(i, i);
+      order.push_back(name);
+    }
+  }
+  // The vars are assigned greedily to the heaps whose last vars are dead
+  // before their first writes, in the order of the first writes.
+  std::vector<int> heap_ends;
+  for (auto& name : order) {
+    auto* var = exec_scope_->FindVar(name);
+    if (!var || !var->IsType<Tensor>()) continue;
+    auto life = lifetimes[name];
+    // the vars never read may be read by the user
+    if (life.second == life.first) life.second = kAlive;
+    size_t heap = 0;
+    while (heap < heap_ends.size() && heap_ends[heap] >= life.first) heap++;
+    if (heap == heap_ends.size()) {
+      heap_ends.push_back(life.second);
+    } else {
+      heap_ends[heap] = life.second;
+    }
+    auto* tensor = var->GetMutable<Tensor>();
+    context->set_reuse_heap(
+        paddle::lite::to_string(reinterpret_cast<long>(tensor)),  // NOLINT
+        "heap" + paddle::lite::to_string(heap));
+  }
+  VLOG(4) << "The textures of " << order.size() << " metal vars share "
+          << heap_ends.size() << " heaps";
 }
 
 void RuntimeProgram::SaveOutput() {
@@ -396,6 +494,11 @@ void RuntimeProgram::SaveOutput() {
 #endif
 
 void RuntimeProgram::Run() {
+  // The copies of the variables crossing the stages are passed by the steps.
+  if (pipelined_) {
+    RunPipelined(1, nullptr, nullptr);
+    return;
+  }
 #ifdef LITE_WITH_PRECISION_PROFILE
   auto inst_precision_profiler = paddle::lite::profile::PrecisionProfiler();
   std::string precision_profiler_summary =
@@ -416,50 +519,112 @@ void RuntimeProgram::Run() {
   monitor.inferStart();
 #endif
 
-  int idx = -1;
+  if (use_memory_arena_) PrepareMemoryArena();
+  bool track_inputs = frozen_;
+#ifdef LITE_WITH_CUDA
+  if (use_cuda_graph_ && !cuda_graph_prepared_) PrepareCudaGraph();
+  track_inputs = track_inputs || use_cuda_graph_;
+#endif
+  bool inputs_unchanged = track_inputs && FrozenInputsUnchanged();
+  bool reuse_shapes = frozen_ && inputs_unchanged;
+#ifdef LITE_WITH_CUDA
+  // The first run of the new inputs allocates the outputs for the capture.
+  bool use_cuda_graph = use_cuda_graph_ && inputs_unchanged;
+  if (!use_cuda_graph) ResetCudaGraphs();
+  size_t next_segment = 0;
+  size_t graph_end = 0;
+#endif
+
+  if (parallel_prepare_ && !kernels_prepared_) PrepareKernels();
 
-  auto& insts = instructions_[kRootBlockIdx];
-  for (auto& inst : insts) {
-    ++idx;
+  const RunControl* control = RunControl::Current();
+  auto& priority_arbiter = RunPriorityArbiter::Global();
+  if (inter_op_scheduler_) {
+    inter_op_scheduler_->Run(reuse_shapes);
+  } else {
+    int idx = -1;
+    bool async_kernels = async_kernels_ && !use_memory_arena_;
+
+    auto& insts = instructions_[kRootBlockIdx];
+    for (auto& inst : insts) {
+      ++idx;
+      // Give way to the runs of the higher priorities between the ops.
+      priority_arbiter.Yield();
+      if (control && control->Check()) break;
 #if !defined(LITE_WITH_FPGA) && !defined(LITE_WITH_METAL)
-    if (inst.is_feed_fetch_op()) continue;
+      if (inst.is_feed_fetch_op()) continue;
+#endif
+#ifdef LITE_WITH_CUDA
+      if (use_cuda_graph && next_segment < cuda_graph_segments_.size() &&
+          cuda_graph_segments_[next_segment].begin ==
+              static_cast<size_t>(idx)) {
+        auto& segment = cuda_graph_segments_[next_segment++];
+        if (segment.exec) {
+          CUDA_CALL(cudaGraphLaunch(segment.exec, segment.stream));
+          graph_end = segment.end;
+        } else if (CaptureCudaGraph(&segment, reuse_shapes)) {
+          graph_end = segment.end;
+        } else {
+          use_cuda_graph = false;
+        }
+      }
+      if (static_cast<size_t>(idx) < graph_end) continue;
 #endif
 #ifdef LITE_WITH_NVTX
-    NVTXRangeAnnotation annotation = annotator.AnnotateBlock();
-    nvtxStringHandle_t registered_name = register_layer_names_[idx];
-    if (annotator.IsEnabled()) {
-      annotation.generate(registered_name, lite::Color::Runner);
-    }
+      NVTXRangeAnnotation annotation = annotator.AnnotateBlock();
+      nvtxStringHandle_t registered_name = register_layer_names_[idx];
+      if (annotator.IsEnabled()) {
+        annotation.generate(registered_name, lite::Color::Runner);
+      }
 #endif
 #ifdef LITE_WITH_CUDA
-    if (inst.need_sync()) {
-      inst.Sync();
-    }
+      if (inst.need_sync()) {
+        inst.Sync();
+      }
 #endif
 
 #ifdef LITE_WITH_FPGA
-    monitor.preRun(inst);
+      monitor.preRun(inst);
 #endif
 
 #ifdef LITE_WITH_OPENCL
-    // delegate flush judgement to specify target , it is too heavy for Inst
-    inst.Flush(idx);
+      if (opencl_flush_plan_.empty()) {
+        // delegate flush judgement to specify target , it is too heavy for
+        // Inst
+        inst.Flush(idx);
+      } else if (opencl_flush_plan_[idx]) {
+        CLRuntime::Global()->command_queue().flush();
+      }
 #endif
 
-    inst.Run();
+      inst.set_reuse_shapes(reuse_shapes);
+      if (!pending_kernels_.empty()) WaitAsyncKernels(&inst);
+      bool launched = async_kernels && inst.mutable_kernel()->SetAsync(true);
+      inst.Run();
+      if (launched) {
+        inst.mutable_kernel()->SetAsync(false);
+        auto* op_info = inst.op()->op_info();
+        auto inputs = op_info->input_names();
+        auto outputs = op_info->output_names();
+        auto& vars = pending_kernels_[idx];
+        vars.insert(inputs.begin(), inputs.end());
+        vars.insert(outputs.begin(), outputs.end());
+      }
 
 #ifdef LITE_WITH_FPGA
-    monitor.postRun(inst);
+      monitor.postRun(inst);
 #endif
 
 #ifdef LITE_WITH_PRECISION_PROFILE
 #ifndef LITE_WITH_FPGA
-    if (inst.op()->Type() != "while") {
-      precision_profiler_summary +=
-          inst_precision_profiler.GetInstPrecision(&inst);
-    }
+      if (inst.op()->Type() != "while") {
+        precision_profiler_summary +=
+            inst_precision_profiler.GetInstPrecision(&inst);
+      }
 #endif
 #endif  // LITE_WITH_PRECISION_PROFILE
+    }
+    if (!pending_kernels_.empty()) WaitAsyncKernels(nullptr);
   }
 
 #ifdef LITE_WITH_METAL
@@ -469,6 +634,27 @@ void RuntimeProgram::Run() {
   }
 #endif
 
+#ifdef LITE_WITH_FPGA
+  monitor.inferEnd();
+#endif
+
+  // The shapes and the plans of the instructions skipped by the stopped run
+  // are not updated.
+  if (control && control->stopped()) {
+    frozen_input_dims_.clear();
+    return;
+  }
+  if (use_memory_arena_ && MemoryArenaStale()) {
+    PlanMemoryArena();
+  }
+  if (inter_op_lanes_ > 1 && !inter_op_planned_) PlanInterOp();
+  if (report_init_time_ && !init_time_reported_) ReportInitTime();
+#ifdef LITE_WITH_OPENCL
+  if (use_adaptive_flush_ && opencl_flush_plan_.empty()) {
+    PlanOpenCLFlush();
+  }
+#endif
+
 #ifdef LITE_WITH_PROFILE
   LOG(INFO) << "\n" << profiler_.Summary(profile::Type::kDispatch, false, 1);
 #endif
@@ -479,6 +665,28 @@ void RuntimeProgram::Run() {
 #endif
 }
 
+void RuntimeProgram::WaitAsyncKernels(const Instruction* inst) {
+  auto& insts = instructions_[kRootBlockIdx];
+  for (auto it = pending_kernels_.begin(); it != pending_kernels_.end();) {
+    bool depends = inst == nullptr;
+    if (!depends) {
+      auto* op_info = inst->op()->op_info();
+      for (auto& name : op_info->input_names()) {
+        depends = depends || it->second.count(name);
+      }
+      for (auto& name : op_info->output_names()) {
+        depends = depends || it->second.count(name);
+      }
+    }
+    if (depends) {
+      insts[it->first].mutable_kernel()->Wait();
+      it = pending_kernels_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 void Program::Build(const std::shared_ptr<cpp::ProgramDesc>& program_desc) {
   CHECK(ops_.empty()) << "Executor duplicate Build found";
 
@@ -633,6 +841,890 @@ void Instruction::SaveOutput() {
 }
 #endif
 
+std::vector<MemoryPlanStats> RuntimeProgram::memory_plan_stats() const {
+  std::vector<MemoryPlanStats> stats;
+  for (auto& item : memory_plans_) {
+    MemoryPlanStats stat;
+    stat.bucket = item.first;
+    stat.arena_size = item.second.arena_size;
+    stat.activation_size = item.second.activation_size;
+    stat.runs = item.second.runs;
+    stats.push_back(stat);
+  }
+  return stats;
+}
+
+void RuntimeProgram::CollectRuntimeStats(lite_api::RuntimeStats* stats) const {
+  CHECK(stats);
+  std::map<std::string, size_t> op_indexes;
+  for (auto& block : instructions_) {
+    for (auto& inst : block) {
+      auto op_type = inst.op()->Type();
+      auto it = op_indexes.find(op_type);
+      if (it == op_indexes.end()) {
+        it = op_indexes.emplace(op_type, stats->ops.size()).first;
+        stats->ops.emplace_back();
+        stats->ops.back().op_type = op_type;
+      }
+      auto& op_stats = stats->ops[it->second];
+      op_stats.calls += inst.run_count();
+      op_stats.time_ns += inst.run_time_ns();
+      if (inst.kernel()) {
+        op_stats.prepare_time_ns += inst.kernel()->prepare_time_us() * 1000;
+      }
+    }
+  }
+  for (auto& item : memory_plans_) {
+    stats->peak_arena_bytes =
+        std::max<uint64_t>(stats->peak_arena_bytes, item.second.arena_size);
+  }
+}
+
+void RuntimeProgram::SetLatencyTable(LatencyTable* table, int threads) {
+  for (auto& block : instructions_) {
+    for (auto& inst : block) {
+      if (!inst.is_feed_fetch_op()) inst.set_latency_table(table, threads);
+    }
+  }
+}
+
+double RuntimeProgram::EstimateLatency(const LatencyTable& table,
+                                       int threads,
+                                       int* missing) {
+  double latency = 0;
+  int missing_kernels = 0;
+  InferShapes([&](Instruction* inst) {
+    double ms = 0;
+    if (table.Lookup(inst->LatencyKey(threads), &ms)) {
+      latency += ms;
+    } else {
+      missing_kernels++;
+    }
+  });
+  if (missing) *missing = missing_kernels;
+  return latency;
+}
+
+void RuntimeProgram::InferShapes(
+    const std::function<void(Instruction*)>& fn) {
+  for (auto& inst : instructions_[kRootBlockIdx]) {
+    auto* op = inst.mutable_op();
+    if (op->Type() == "feed") {
+      // The feed op infers its output only once, so resize it to the input.
+      auto* op_info = op->op_info();
+      auto* feed_var = exec_scope_->FindVar(op_info->Input("X").front());
+      auto* out_var = exec_scope_->FindVar(op_info->Output("Out").front());
+      CHECK(feed_var && out_var);
+      auto& feed_list = feed_var->Get<std::vector<Tensor>>();
+      auto col = op_info->GetAttr<int>("col");
+      CHECK_LT(col, static_cast<int>(feed_list.size()));
+      out_var->GetMutable<Tensor>()->Resize(feed_list[col].dims());
+      continue;
+    }
+    if (inst.is_feed_fetch_op()) continue;
+    op->InferShape();
+    fn(&inst);
+  }
+}
+
+void RuntimeProgram::PrepareMemoryArena() {
+  CHECK(exec_scope_);
+  std::vector<DDim> shapes;
+  for (auto& inst : instructions_[kRootBlockIdx]) {
+    if (inst.op()->Type() != "feed") continue;
+    for (auto& name : inst.op()->op_info()->output_names()) {
+      auto* var = exec_scope_->FindVar(name);
+      if (var && var->IsType<Tensor>()) {
+        shapes.push_back(var->Get<Tensor>().dims());
+      }
+    }
+  }
+  memory_bucket_ = ShapeBucket(shapes);
+  auto it = memory_plans_.find(memory_bucket_);
+  if (it == memory_plans_.end()) return;
+  it->second.runs++;
+  if (active_memory_plan_ != &it->second) ApplyMemoryPlan(it->second);
+}
+
+void RuntimeProgram::PrepareFrozen() {
+  CHECK(exec_scope_);
+  frozen_prepared_ = true;
+  for (auto& inst : instructions_[kRootBlockIdx]) {
+    const auto* op = inst.op();
+    if (op->Type() != "feed") continue;
+    for (auto& name : op->op_info()->output_names()) {
+      auto* var = exec_scope_->FindVar(name);
+      if (var && var->IsType<Tensor>()) {
+        frozen_inputs_.push_back(&var->Get<Tensor>());
+      }
+    }
+  }
+  if (frozen_inputs_.empty()) {
+    // The CUDA graphs are never replayed either, since the inputs are never
+    // found unchanged.
+    if (frozen_) {
+      LOG(WARNING) << "The frozen program is disabled without the feed ops";
+    }
+    frozen_ = false;
+  }
+}
+
+bool RuntimeProgram::FrozenInputsUnchanged() {
+  if (!frozen_prepared_) {
+    PrepareFrozen();
+    if (frozen_inputs_.empty()) return false;
+  }
+  bool unchanged = !frozen_input_dims_.empty();
+  frozen_input_dims_.resize(frozen_inputs_.size());
+  frozen_input_lods_.resize(frozen_inputs_.size());
+  frozen_input_data_.resize(frozen_inputs_.size());
+  for (size_t i = 0; i < frozen_inputs_.size(); i++) {
+    const auto* input = frozen_inputs_[i];
+    auto data = OpLite::InferShapeCacheData(input);
+    if (frozen_input_dims_[i] == input->dims() &&
+        frozen_input_lods_[i] == input->lod() &&
+        frozen_input_data_[i] == data) {
+      continue;
+    }
+    unchanged = false;
+    frozen_input_dims_[i] = input->dims();
+    frozen_input_lods_[i] = input->lod();
+    frozen_input_data_[i] = std::move(data);
+  }
+  return unchanged;
+}
+
+#ifdef LITE_WITH_CUDA
+void RuntimeProgram::PrepareCudaGraph() {
+  cuda_graph_prepared_ = true;
+  // The buffers planned in the arena and the lanes of the inter-op
+  // parallelism change between the runs.
+  if (use_memory_arena_ || inter_op_lanes_ > 1) {
+    LOG(WARNING) << "The CUDA graphs are disabled with the memory arena or "
+                    "the inter-op parallelism";
+    use_cuda_graph_ = false;
+    return;
+  }
+  auto& insts = instructions_[kRootBlockIdx];
+  for (size_t idx = 0; idx < insts.size(); idx++) {
+    auto& inst = insts[idx];
+    const auto& op_type = inst.op()->Type();
+    // The io_copy kernels copy by the blocking calls, which can not be
+    // captured, and the kernels on the host run outside of the graphs.
+    bool capturable = !inst.is_feed_fetch_op() &&
+                      inst.kernel()->target() == TARGET(kCUDA) &&
+                      op_type != "io_copy" && op_type != "io_copy_once";
+    if (!capturable) continue;
+    if (!cuda_graph_segments_.empty() &&
+        cuda_graph_segments_.back().end == idx) {
+      cuda_graph_segments_.back().end = idx + 1;
+      continue;
+    }
+    CudaGraphSegment segment;
+    segment.begin = idx;
+    segment.end = idx + 1;
+    auto* context = inst.mutable_kernel()->mutable_context();
+    segment.stream = context->As<CUDAContext>().exec_stream();
+    cuda_graph_segments_.push_back(segment);
+  }
+  // A single kernel saves nothing but its launch.
+  cuda_graph_segments_.erase(
+      std::remove_if(cuda_graph_segments_.begin(),
+                     cuda_graph_segments_.end(),
+                     [](const CudaGraphSegment& segment) {
+                       return segment.end - segment.begin < 2;
+                     }),
+      cuda_graph_segments_.end());
+  VLOG(1) << "Found " << cuda_graph_segments_.size()
+          << " segments for the CUDA graphs";
+}
+
+bool RuntimeProgram::CaptureCudaGraph(CudaGraphSegment* segment,
+                                      bool reuse_shapes) {
+  auto& insts = instructions_[kRootBlockIdx];
+  auto* kernel = insts[segment->begin].mutable_kernel();
+  auto& context = kernel->mutable_context()->As<CUDAContext>();
+  // Fork the other streams from the stream of the segment, so the kernels on
+  // them are captured too, and join them back at the end.
+  std::vector<cudaStream_t> streams;
+  for (auto stream : context.all_exec_streams()) {
+    if (stream != segment->stream) streams.push_back(stream);
+  }
+  std::vector<cudaEvent_t> events(streams.size() + 1);
+  for (auto& event : events) TargetWrapperCuda::CreateEventWithFlags(&event);
+  CUDA_CALL(cudaStreamBeginCapture(segment->stream,
+                                   cudaStreamCaptureModeThreadLocal));
+  TargetWrapperCuda::RecordEvent(events.back(), segment->stream);
+  for (auto stream : streams) {
+    TargetWrapperCuda::StreamSync(stream, events.back());
+  }
+  for (size_t idx = segment->begin; idx < segment->end; idx++) {
+    auto& inst = insts[idx];
+    if (inst.need_sync()) inst.Sync();
+    inst.set_reuse_shapes(reuse_shapes);
+    inst.Run();
+  }
+  for (size_t i = 0; i < streams.size(); i++) {
+    TargetWrapperCuda::RecordEvent(events[i], streams[i]);
+    TargetWrapperCuda::StreamSync(segment->stream, events[i]);
+  }
+  cudaGraph_t graph = nullptr;
+  auto status = cudaStreamEndCapture(segment->stream, &graph);
+  if (status == cudaSuccess) {
+    status = cudaGraphInstantiate(&segment->exec, graph, nullptr, nullptr, 0);
+  }
+  if (graph) CUDA_CALL(cudaGraphDestroy(graph));
+  for (auto& event : events) TargetWrapperCuda::DestroyEvent(event);
+  if (status != cudaSuccess) {
+    // Clear the error, the kernels run one by one from now on.
+    cudaGetLastError();
+    segment->exec = nullptr;
+    LOG(WARNING) << "The CUDA graphs are disabled since the kernels from "
+                 << insts[segment->begin].op()->Type()
+                 << " can not be captured: " << cudaGetErrorString(status);
+    use_cuda_graph_ = false;
+    return false;
+  }
+  CUDA_CALL(cudaGraphLaunch(segment->exec, segment->stream));
+  return true;
+}
+
+void RuntimeProgram::ResetCudaGraphs() {
+  for (auto& segment : cuda_graph_segments_) {
+    if (segment.exec) {
+      CUDA_CALL(cudaGraphExecDestroy(segment.exec));
+      segment.exec = nullptr;
+    }
+  }
+}
+#endif
+
+void RuntimeProgram::PlanInterOp() {
+  CHECK(exec_scope_);
+  inter_op_planned_ = true;
+  // The lifetimes planned in the memory arena assume the sequential runs.
+  if (use_memory_arena_ || pipelined_) {
+    LOG(WARNING) << "The inter-op parallelism is disabled with the memory "
+                    "arena or the pipelined runs";
+    return;
+  }
+  std::unique_ptr<InterOpScheduler> scheduler(new InterOpScheduler);
+  if (scheduler->Plan(
+          &instructions_[kRootBlockIdx], exec_scope_, inter_op_lanes_)) {
+    inter_op_scheduler_ = std::move(scheduler);
+  }
+}
+
+void RuntimeProgram::PrepareKernels() {
+  kernels_prepared_ = true;
+  std::vector<KernelBase*> kernels;
+  for (auto& inst : instructions_[kRootBlockIdx]) {
+#if !defined(LITE_WITH_FPGA) && !defined(LITE_WITH_METAL)
+    if (inst.is_feed_fetch_op()) continue;
+#endif
+    inst.InferShapeAhead();
+    // The device kernels may share the runtimes which are not thread-safe.
+    auto* kernel = inst.mutable_kernel();
+    if (kernel && (kernel->target() == TARGET(kARM) ||
+                   kernel->target() == TARGET(kX86))) {
+      kernels.push_back(kernel);
+    }
+  }
+  size_t workers = std::min<size_t>(
+      kernels.size(), std::max(1u, std::thread::hardware_concurrency()));
+  if (workers <= 1) {
+    for (auto* kernel : kernels) kernel->Prepare();
+    return;
+  }
+  std::atomic<size_t> next{0};
+  auto prepare = [&] {
+    for (size_t i = next++; i < kernels.size(); i = next++) {
+      kernels[i]->Prepare();
+    }
+  };
+#ifdef LITE_WITH_ARM
+  auto mode = DeviceInfo::Global().mode();
+  int threads = DeviceInfo::Global().threads();
+#endif
+#ifdef LITE_USE_THREAD_POOL
+  auto* thread_pool = ThreadPool::Current();
+#endif
+  // The workers use the same cpus as the calling thread, see
+  // StartPipelineWorkers.
+  std::vector<std::thread> helpers;
+  for (size_t i = 1; i < workers; i++) {
+    helpers.emplace_back([&] {
+#ifdef LITE_WITH_ARM
+      DeviceInfo::Init();
+      DeviceInfo::Global().SetRunMode(mode, threads);
+#endif
+#ifdef LITE_USE_THREAD_POOL
+      ThreadPoolGuard thread_pool_guard(thread_pool);
+#endif
+      prepare();
+    });
+  }
+  prepare();
+  for (auto& helper : helpers) helper.join();
+  VLOG(1) << "Prepared " << kernels.size() << " kernels on " << workers
+          << " threads";
+}
+
+void RuntimeProgram::ReportInitTime() {
+  init_time_reported_ = true;
+  std::vector<const Instruction*> insts;
+  uint64_t total_us = 0;
+  for (auto& inst : instructions_[kRootBlockIdx]) {
+    if (!inst.kernel()) continue;
+    insts.push_back(&inst);
+    total_us += inst.kernel()->prepare_time_us();
+  }
+  std::stable_sort(insts.begin(),
+                   insts.end(),
+                   [](const Instruction* a, const Instruction* b) {
+                     return a->kernel()->prepare_time_us() >
+                            b->kernel()->prepare_time_us();
+                   });
+  STL::stringstream ss;
+  ss << "PrepareForRun of " << insts.size() << " kernels takes "
+     << total_us / 1000.f << " ms:\n";
+  for (auto* inst : insts) {
+    uint64_t us = inst->kernel()->prepare_time_us();
+    if (us == 0) break;
+    ss << "  " << inst->op()->Type() << " " << inst->kernel()->name() << " "
+       << us / 1000.f << " ms\n";
+  }
+  LOG(INFO) << ss.str();
+}
+
+bool RuntimeProgram::PreparePipeline() {
+  CHECK(exec_scope_);
+  pipeline_prepared_ = true;
+  if (use_memory_arena_) {
+    LOG(WARNING) << "The pipelined runs are disabled with the memory arena";
+    return false;
+  }
+  auto& insts = instructions_[kRootBlockIdx];
+  std::vector<int> inst_stages(insts.size(), -1);
+  std::vector<bool> stage_copies;
+  for (size_t idx = 0; idx < insts.size(); idx++) {
+    auto& inst = insts[idx];
+    if (inst.is_feed_fetch_op()) continue;
+    auto op_type = inst.op()->Type();
+    auto target = inst.kernel() ? inst.kernel()->target() : TARGET(kHost);
+    // The sub blocks find the variables by the names, and the runtime of
+    // OpenCL and Metal is bound to the calling thread.
+    if (op_type == "while" || op_type == "conditional_block" ||
+        target == TARGET(kOpenCL) || target == TARGET(kMetal)) {
+      LOG(WARNING) << "The pipelined runs are disabled for the program with "
+                   << op_type << " op on " << TargetToStr(target);
+      return false;
+    }
+    bool on_device = target != TARGET(kHost) && target != TARGET(kARM) &&
+                     target != TARGET(kX86) && target != TARGET(kAny);
+    bool is_copy = target == TARGET(kXPU) && op_type == "io_copy";
+    if (pipeline_stages_.empty() || pipeline_on_device_.back() != on_device ||
+        stage_copies.back() != is_copy) {
+      pipeline_stages_.emplace_back(idx, idx + 1);
+      pipeline_on_device_.push_back(on_device);
+      stage_copies.push_back(is_copy);
+    } else {
+      pipeline_stages_.back().second = idx + 1;
+    }
+    inst_stages[idx] = static_cast<int>(pipeline_stages_.size()) - 1;
+  }
+  int last_stage = static_cast<int>(pipeline_stages_.size()) - 1;
+  if (last_stage < 1) {
+    VLOG(1) << "The program of one stage is not pipelined";
+    return false;
+  }
+  pipeline_caller_stage_ = pipeline_stages_.size();
+  for (size_t stage = 0; stage < pipeline_stages_.size(); stage++) {
+    if (pipeline_on_device_[stage] && !stage_copies[stage]) {
+      pipeline_caller_stage_ = stage;
+      break;
+    }
+  }
+  if (pipeline_caller_stage_ == pipeline_stages_.size()) {
+    auto host_stage = std::find(
+        pipeline_on_device_.begin(), pipeline_on_device_.end(), false);
+    pipeline_caller_stage_ =
+        std::distance(pipeline_on_device_.begin(), host_stage);
+  }
+
+  // The stages producing and consuming each variable, and the stage whose ops
+  // must access it by its own name, e.g. the subgraph ops and the users.
+  struct VarStages {
+    int producer{-1};
+    int first_consumer{-1};
+    int last_consumer{-1};
+    int pinned{-1};
+  };
+  std::map<std::string, VarStages> vars;
+  bool valid = true;
+  auto pin = [&](VarStages* var, int stage) {
+    if (var->pinned >= 0 && var->pinned != stage) valid = false;
+    var->pinned = stage;
+  };
+  for (size_t idx = 0; idx < insts.size(); idx++) {
+    auto* op = insts[idx].op();
+    auto op_type = op->Type();
+    int stage = inst_stages[idx];
+    bool named = op_type == "subgraph";
+    if (op_type == "feed") {
+      stage = 0;
+      named = true;
+    } else if (op_type == "fetch") {
+      stage = last_stage;
+      named = true;
+    }
+    for (auto& name : op->op_info()->input_names()) {
+      auto& var = vars[name];
+      if (var.first_consumer < 0) var.first_consumer = stage;
+      var.last_consumer = (std::max)(var.last_consumer, stage);
+      if (named) pin(&var, stage);
+    }
+    for (auto& name : op->op_info()->output_names()) {
+      auto& var = vars[name];
+      if (var.producer >= 0 && var.producer != stage) valid = false;
+      var.producer = stage;
+      if (named) pin(&var, stage);
+    }
+  }
+
+  std::vector<std::map<std::string, std::string>> renames(last_stage + 1);
+  for (auto& item : vars) {
+    auto& name = item.first;
+    auto& var = item.second;
+    if (var.producer < 0 || var.last_consumer <= var.producer) continue;
+    auto* scope_var = exec_scope_->FindVar(name);
+    if (var.first_consumer < var.producer || !scope_var ||
+        !scope_var->IsType<Tensor>()) {
+      valid = false;
+    }
+    if (!valid) break;
+    if (var.pinned < 0) var.pinned = var.producer;
+    std::vector<Tensor*> buffers;
+    for (int stage = var.producer; stage <= var.last_consumer; stage++) {
+      auto copy_name = name;
+      if (stage != var.pinned) {
+        copy_name += "@pipeline" + std::to_string(stage);
+        renames[stage][name] = copy_name;
+      }
+      buffers.push_back(exec_scope_->Var(copy_name)->GetMutable<Tensor>());
+    }
+    pipeline_buffers_.push_back(buffers);
+  }
+  if (!valid) {
+    LOG(WARNING) << "The pipelined runs are disabled since some variables "
+                    "are written by multiple stages, read by the previous "
+                    "stages, or found by the names in multiple stages";
+    pipeline_buffers_.clear();
+    return false;
+  }
+
+  for (size_t idx = 0; idx < insts.size(); idx++) {
+    if (inst_stages[idx] < 0) continue;
+    auto& stage_renames = renames[inst_stages[idx]];
+    if (stage_renames.empty()) continue;
+    auto* op = insts[idx].mutable_op();
+    cpp::OpDesc op_desc = *op->op_info();
+    bool renamed = false;
+    auto rename = [&](std::vector<std::string>* args) {
+      for (auto& arg : *args) {
+        auto it = stage_renames.find(arg);
+        if (it == stage_renames.end()) continue;
+        arg = it->second;
+        renamed = true;
+      }
+    };
+    for (auto& param : op_desc.InputArgumentNames()) {
+      auto args = op_desc.Input(param);
+      rename(&args);
+      op_desc.SetInput(param, args);
+    }
+    for (auto& param : op_desc.OutputArgumentNames()) {
+      auto args = op_desc.Output(param);
+      rename(&args);
+      op_desc.SetOutput(param, args);
+    }
+    if (!renamed) continue;
+    op->Attach(op_desc, exec_scope_);
+    op->AttachKernel(insts[idx].mutable_kernel());
+  }
+  VLOG(1) << "Pipelined the program into " << pipeline_stages_.size()
+          << " stages with " << pipeline_buffers_.size()
+          << " variables crossing them";
+  return true;
+}
+
+void RuntimeProgram::RunPipelineStage(size_t stage) {
+  auto& insts = instructions_[kRootBlockIdx];
+  for (size_t idx = pipeline_stages_[stage].first;
+       idx < pipeline_stages_[stage].second;
+       idx++) {
+    auto& inst = insts[idx];
+    if (inst.is_feed_fetch_op()) continue;
+    inst.set_reuse_shapes(false);
+    inst.Run();
+  }
+#ifdef LITE_WITH_XPU
+  // The next stages read the outputs on the other threads, whose streams are
+  // not synchronized with the one of this thread.
+  if (pipeline_on_device_[stage]) {
+    XPU_CALL(xpu_wait(TargetWrapperXPU::get_xpu_stream()));
+  }
+#endif
+}
+
+void RuntimeProgram::StartPipelineWorkers() {
+#ifdef LITE_WITH_ARM
+  auto mode = DeviceInfo::Global().mode();
+  int threads = DeviceInfo::Global().threads();
+#endif
+#ifdef LITE_USE_THREAD_POOL
+  auto* thread_pool = ThreadPool::Current();
+#endif
+#ifdef LITE_WITH_XPU
+  int device = 0;
+  XPU_CALL(xpu_current_device(&device));
+#endif
+  for (size_t stage = 0; stage < pipeline_stages_.size(); stage++) {
+    if (stage == pipeline_caller_stage_) continue;
+    // The workers use the same cpus and devices as the calling thread.
+    pipeline_workers_.emplace_back([=] {
+#ifdef LITE_WITH_ARM
+      DeviceInfo::Init();
+      DeviceInfo::Global().SetRunMode(mode, threads);
+#endif
+#ifdef LITE_USE_THREAD_POOL
+      ThreadPoolGuard thread_pool_guard(thread_pool);
+#endif
+#ifdef LITE_WITH_XPU
+      XPU_CALL(xpu_set_device(device));
+#endif
+      PipelineWorkerLoop(stage);
+    });
+  }
+}
+
+void RuntimeProgram::PipelineWorkerLoop(size_t stage) {
+  uint64_t epoch = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(pipeline_mutex_);
+      pipeline_cv_.wait(
+          lock, [&] { return pipeline_stop_ || pipeline_epoch_ != epoch; });
+      if (pipeline_stop_) return;
+      epoch = pipeline_epoch_;
+    }
+    if (PipelineStageActive(stage)) RunPipelineStage(stage);
+    {
+      std::lock_guard<std::mutex> lock(pipeline_mutex_);
+      pipeline_pending_--;
+    }
+    pipeline_cv_.notify_all();
+  }
+}
+
+void RuntimeProgram::StopPipelineWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(pipeline_mutex_);
+    pipeline_stop_ = true;
+  }
+  pipeline_cv_.notify_all();
+  for (auto& worker : pipeline_workers_) worker.join();
+  pipeline_workers_.clear();
+}
+
+void RuntimeProgram::PipelineHandoff() {
+  for (auto& buffers : pipeline_buffers_) {
+    // From the last consumer, so each copy moves by one stage.
+    for (size_t i = buffers.size() - 1; i > 0; i--) {
+      auto* from = buffers[i - 1];
+      auto* to = buffers[i];
+      if (from->IsBufferShared() || to->IsBufferShared()) {
+        // The buffers shared with the other tensors, e.g. by the inplace ops,
+        // would be written by the previous stage in the next step.
+        to->Resize(from->dims());
+        to->set_lod(from->lod());
+        to->set_precision(from->precision());
+        if (from->memory_size() > 0) {
+          TargetCopy(from->target(),
+                     to->mutable_data(from->target(), from->memory_size()),
+                     from->raw_data(),
+                     from->memory_size());
+        }
+        continue;
+      }
+      Tensor tmp;
+      tmp.ShareDataWith(*to);
+      to->ShareDataWith(*from);
+      from->ShareDataWith(tmp);
+    }
+  }
+}
+
+void RuntimeProgram::RunPipelined(size_t requests,
+                                  const std::function<void(size_t)>& feed,
+                                  const std::function<void(size_t)>& fetch) {
+  if (!pipeline_prepared_) pipelined_ = PreparePipeline();
+  if (!pipelined_) {
+    for (size_t i = 0; i < requests; i++) {
+      if (feed) feed(i);
+      Run();
+      if (fetch) fetch(i);
+    }
+    return;
+  }
+  if (pipeline_workers_.empty()) StartPipelineWorkers();
+  size_t stages = pipeline_stages_.size();
+  // The stage s runs the request step-s in each step.
+  for (size_t step = 0; step + 1 < requests + stages; step++) {
+    if (step < requests && feed) feed(step);
+    {
+      std::lock_guard<std::mutex> lock(pipeline_mutex_);
+      pipeline_step_ = step;
+      pipeline_requests_ = requests;
+      pipeline_pending_ = pipeline_workers_.size();
+      pipeline_epoch_++;
+    }
+    pipeline_cv_.notify_all();
+    if (PipelineStageActive(pipeline_caller_stage_)) {
+      RunPipelineStage(pipeline_caller_stage_);
+    }
+    {
+      std::unique_lock<std::mutex> lock(pipeline_mutex_);
+      pipeline_cv_.wait(lock, [this] { return pipeline_pending_ == 0; });
+    }
+    if (step + 1 >= stages && fetch) fetch(step + 1 - stages);
+    PipelineHandoff();
+  }
+}
+
+bool RuntimeProgram::MemoryArenaStale() const {
+  auto it = memory_plans_.find(memory_bucket_);
+  if (it == memory_plans_.end()) return true;
+  // Only the growth makes the plan stale, the tensors moved out by sharing
+  // the data of others, e.g. the weights, are ignored.
+  for (auto& slot : it->second.slots) {
+    for (auto* tensor : slot.tensors) {
+      if (tensor->memory_size() > slot.size) return true;
+    }
+  }
+  return false;
+}
+
+void RuntimeProgram::ApplyMemoryPlan(const MemoryPlan& plan) {
+  if (!memory_arena_ || memory_arena_->space() < plan.arena_size) {
+    // The previous arena is released once none of the tensors refers to it.
+    memory_arena_ = std::make_shared<Buffer>();
+    memory_arena_->ResetLazy(TARGET(kHost), plan.arena_size);
+  }
+  // The tensors only planned by the previous plan would otherwise alias the
+  // slots of this one.
+  std::set<const Tensor*> planned;
+  for (auto& slot : plan.slots) {
+    planned.insert(slot.tensors.begin(), slot.tensors.end());
+  }
+  if (active_memory_plan_) {
+    for (auto& slot : active_memory_plan_->slots) {
+      for (auto* tensor : slot.tensors) {
+        if (!planned.count(tensor)) {
+          tensor->ResetBuffer(std::make_shared<Buffer>(), 0);
+        }
+      }
+    }
+  }
+  for (auto& slot : plan.slots) {
+    auto buffer = std::make_shared<ArenaBuffer>(
+        memory_arena_, slot.offset, slot.size, slot.target);
+    for (auto* tensor : slot.tensors) {
+      tensor->ResetBuffer(buffer, tensor->memory_size());
+    }
+  }
+  active_memory_plan_ = &plan;
+}
+
+#ifdef LITE_WITH_OPENCL
+void RuntimeProgram::PlanOpenCLFlush() {
+  // Never let too few or too many instructions queued between the flushes.
+  const size_t kMinPending = 4;
+  const size_t kMaxPending = 64;
+  auto& insts = instructions_[kRootBlockIdx];
+  std::vector<int64_t> works(insts.size(), 0);
+  std::vector<bool> is_opencl(insts.size(), false);
+  int64_t total_work = 0;
+  for (size_t idx = 0; idx < insts.size(); idx++) {
+    auto& inst = insts[idx];
+    if (inst.is_feed_fetch_op() || !inst.kernel() ||
+        inst.kernel()->target() != TARGET(kOpenCL)) {
+      continue;
+    }
+    is_opencl[idx] = true;
+    for (auto& name : inst.op()->op_info()->output_names()) {
+      auto* var = exec_scope_->FindVar(name);
+      if (!var || !var->IsType<Tensor>()) continue;
+      works[idx] += var->Get<Tensor>().numel();
+    }
+    total_work += works[idx];
+  }
+
+  opencl_flush_plan_.assign(insts.size(), false);
+  int64_t max_budget = std::max<int64_t>(total_work / 4, 1);
+  int64_t budget = std::max<int64_t>(total_work / 16, 1);
+  int64_t queued_work = 0;
+  size_t pending = 0;
+  size_t flushes = 0;
+  for (size_t idx = 0; idx < insts.size(); idx++) {
+    if (!is_opencl[idx]) continue;
+    if ((queued_work >= budget && pending >= kMinPending) ||
+        pending >= kMaxPending) {
+      opencl_flush_plan_[idx] = true;
+      queued_work = 0;
+      pending = 0;
+      budget = std::min(budget * 2, max_budget);
+      flushes++;
+    }
+    queued_work += works[idx];
+    pending++;
+  }
+  VLOG(1) << "Planned " << flushes << " OpenCL flushes for " << insts.size()
+          << " instructions";
+}
+#endif
+
+void RuntimeProgram::PlanMemoryArena() {
+#ifndef LITE_WITH_FPGA
+  CHECK(exec_scope_);
+  auto& insts = instructions_[kRootBlockIdx];
+  // The feed/fetch variables are accessed by the users, and the outputs of
+  // the run-once ops must be kept across the runs.
+  std::set<std::string> invalid_var_names;
+  for (auto& inst : insts) {
+    auto op_type = inst.op()->Type();
+    if (op_type == "while" || op_type == "conditional_block" ||
+        op_type == "subgraph") {
+      LOG(WARNING) << "The memory arena is disabled for the program with "
+                   << op_type << " op";
+      use_memory_arena_ = false;
+      return;
+    }
+    if (inst.is_feed_fetch_op() || inst.op()->run_once()) {
+      auto* op_info = inst.op()->op_info();
+      for (auto& name : op_info->input_names()) invalid_var_names.insert(name);
+      for (auto& name : op_info->output_names()) invalid_var_names.insert(name);
+    }
+  }
+
+  // The peak sizes of the tensors in the runs of the bucket.
+  std::map<const Tensor*, size_t> peaks;
+  auto cached = memory_plans_.find(memory_bucket_);
+  if (cached != memory_plans_.end()) {
+    for (auto& slot : cached->second.slots) {
+      for (auto* tensor : slot.tensors) peaks[tensor] = slot.size;
+    }
+  }
+
+  // The tensors sharing the same buffer, e.g. the inplace reshape, are planned
+  // as one block whose lifetime is the union of theirs.
+  std::map<const void*, size_t> block_ids;
+  std::vector<MemoryBlock> blocks;
+  std::vector<std::vector<Tensor*>> block_tensors;
+  std::vector<bool> block_valid;
+  for (size_t idx = 0; idx < insts.size(); idx++) {
+    auto* op_info = insts[idx].op()->op_info();
+    auto var_names = op_info->input_names();
+    auto out_names = op_info->output_names();
+    var_names.insert(var_names.end(), out_names.begin(), out_names.end());
+    for (auto& var_name : var_names) {
+      if (invalid_var_names.count(var_name)) continue;
+      // The weights are in the parent scope.
+      auto* var = exec_scope_->FindLocalVar(var_name);
+      if (!var || !var->IsType<Tensor>()) continue;
+      auto* tensor = var->GetMutable<Tensor>();
+      auto target = tensor->target();
+      if (target != TARGET(kHost) && target != TARGET(kARM) &&
+          target != TARGET(kX86)) {
+        continue;
+      }
+      if (!tensor->IsInitialized() || tensor->memory_size() == 0) continue;
+      const void* key =
+          static_cast<const char*>(tensor->raw_data()) - tensor->offset();
+      auto it = block_ids.find(key);
+      size_t id = 0;
+      if (it == block_ids.end()) {
+        id = blocks.size();
+        block_ids.emplace(key, id);
+        MemoryBlock block;
+        block.begin = idx;
+        blocks.push_back(block);
+        block_tensors.emplace_back();
+        block_valid.push_back(true);
+      } else {
+        id = it->second;
+      }
+      size_t size = tensor->offset() + tensor->memory_size();
+      auto peak = peaks.find(tensor);
+      if (peak != peaks.end()) size = (std::max)(size, peak->second);
+      blocks[id].end = idx;
+      blocks[id].size = (std::max)(blocks[id].size, size);
+      // Only the buffers shared from the beginning and on the same target can
+      // be moved as a whole.
+      auto& tensors = block_tensors[id];
+      if (tensor->offset() != 0 ||
+          (!tensors.empty() && tensors.front()->target() != target)) {
+        block_valid[id] = false;
+      }
+      if (std::find(tensors.begin(), tensors.end(), tensor) == tensors.end()) {
+        tensors.push_back(tensor);
+      }
+    }
+  }
+
+  MemoryPlan memory_plan;
+  std::vector<MemoryBlock> planned_blocks;
+  std::vector<size_t> planned_ids;
+  for (size_t id = 0; id < blocks.size(); id++) {
+    if (!block_valid[id]) continue;
+    planned_blocks.push_back(blocks[id]);
+    planned_ids.push_back(id);
+    memory_plan.activation_size += blocks[id].size;
+  }
+  memory_plan.arena_size = PlanMemoryBlocks(&planned_blocks);
+  for (size_t i = 0; i < planned_blocks.size(); i++) {
+    MemoryPlan::Slot slot;
+    slot.offset = planned_blocks[i].offset;
+    slot.size = planned_blocks[i].size;
+    slot.tensors = block_tensors[planned_ids[i]];
+    slot.target = slot.tensors.front()->target();
+    memory_plan.slots.push_back(slot);
+  }
+  memory_plan.runs = cached != memory_plans_.end() ? cached->second.runs : 1;
+  VLOG(3) << "Plan " << planned_blocks.size() << " activations of "
+          << memory_plan.activation_size << " bytes into a memory arena of "
+          << memory_plan.arena_size << " bytes for the inputs of bucket ["
+          << memory_bucket_ << "]";
+  // Rebind the tensors while the previous plan is still alive.
+  ApplyMemoryPlan(memory_plan);
+  auto& stored = memory_plans_[memory_bucket_];
+  stored = std::move(memory_plan);
+  active_memory_plan_ = &stored;
+#endif
+}
+
+void Instruction::InferShapeAhead() {
+  CHECK(op_) << "op null";
+  if (!first_epoch_) return;
+  first_epoch_ = false;
+  if (first_run_hook_) {
+    first_run_hook_();
+    first_run_hook_ = nullptr;
+  }
+  CHECK(op_->CheckShape());
+  op_->InferShape();
+}
+
 void Instruction::Run() {
 #ifdef LITE_WITH_PROFILE
   CHECK(profiler_) << "Profiler pointer of kernel can not be nullptr. "
@@ -646,6 +1738,10 @@ void Instruction::Run() {
 
   if (first_epoch_) {
     first_epoch_ = false;
+    if (first_run_hook_) {
+      first_run_hook_();
+      first_run_hook_ = nullptr;
+    }
     CHECK(op_->CheckShape());
   }
 
@@ -653,8 +1749,44 @@ void Instruction::Run() {
     return;
   }
 
-  op_->InferShape();
+  if (reuse_shapes_ && op_->ReuseInferredShapes()) {
+    RuntimeStats::Global().infer_shape_cache.Record(true);
+  } else {
+    op_->InferShape();
+  }
+#ifdef LITE_WITH_PROFILE
+  bool profile_memory = profile::MemoryProfiler::Enabled();
+  if (profile_memory) {
+    profile::MemoryProfiler::Global().BeginOp(profile_id_, op_->Type());
+  }
+#endif
+  auto start_ns = MonotonicNanos();
   kernel_->Launch();
+#ifdef LITE_WITH_OPENCL
+  // Record the time the GPU takes rather than the enqueue.
+  if (latency_table_ && kernel_->target() == TARGET(kOpenCL)) {
+    CLRuntime::Global()->command_queue().finish();
+  }
+#endif
+  auto end_ns = MonotonicNanos();
+#ifdef LITE_WITH_PROFILE
+  if (profile_memory) {
+    auto& memory_profiler = profile::MemoryProfiler::Global();
+    ForEachIOTensor([&](const std::string& name, const Tensor& tensor) {
+      memory_profiler.RecordUse(tensor.buffer(), name);
+    });
+    memory_profiler.EndOp();
+  }
+#endif
+  run_count_.Add(1);
+  run_time_ns_.Add(end_ns - start_ns);
+  if (profile::Timeline::Global().enabled()) {
+    RecordTimelineEvent(start_ns / 1000, end_ns / 1000);
+  }
+  if (latency_table_) {
+    latency_table_->Record(LatencyKey(latency_threads_),
+                           (end_ns - start_ns) / 1e6);
+  }
   has_run_ = true;
 
 #ifdef LITE_WITH_PROFILE
@@ -667,6 +1799,81 @@ void Instruction::Run() {
 #endif
 }
 
+#ifdef LITE_WITH_PROFILE
+void Instruction::ForEachIOTensor(
+    const std::function<void(const std::string&, const Tensor&)>& func)
+    const {
+  auto* scope = op_->scope();
+  if (!scope) return;
+  auto Visit = [&](const std::vector<std::string>& names) {
+    for (auto& name : names) {
+      auto* var = scope->FindVar(name);
+      if (var && var->IsType<Tensor>()) func(name, var->Get<Tensor>());
+    }
+  };
+  Visit(op_->op_info()->input_names());
+  Visit(op_->op_info()->output_names());
+}
+
+float Instruction::EstimateMemoryTraffic() const {
+  float bytes = 0;
+  ForEachIOTensor([&](const std::string& name, const Tensor& tensor) {
+    bytes += tensor.memory_size();
+  });
+  return bytes;
+}
+#endif
+
+const std::vector<const Tensor*>& Instruction::input_tensors() {
+  if (!input_tensors_resolved_) {
+    input_tensors_resolved_ = true;
+    auto* scope = op_->scope();
+    for (auto& name : op_->op_info()->input_names()) {
+      auto* var = scope ? scope->FindVar(name) : nullptr;
+      if (var && var->IsType<Tensor>()) {
+        input_tensors_.push_back(&var->Get<Tensor>());
+      }
+    }
+  }
+  return input_tensors_;
+}
+
+std::string Instruction::LatencyKey(int threads) {
+  std::string shapes;
+  for (auto* tensor : input_tensors()) {
+    if (!shapes.empty()) shapes += ";";
+    shapes += tensor->dims().repr();
+  }
+  return LatencyTable::Key(kernel_->name(), shapes, threads);
+}
+
+void Instruction::RecordTimelineEvent(uint64_t start_us, uint64_t end_us) {
+  auto* event = profile::Timeline::Global().NewEvent();
+  if (!event) return;
+  snprintf(event->name, sizeof(event->name), "%s", kernel_->name().c_str());
+  size_t offset = 0;
+  event->input_shapes[0] = '\0';
+  for (auto* tensor : input_tensors()) {
+    auto size = sizeof(event->input_shapes) - offset;
+    auto count = snprintf(event->input_shapes + offset,
+                          size,
+                          "%s%s",
+                          offset ? ";" : "",
+                          tensor->dims().repr().c_str());
+    if (count < 0 || static_cast<size_t>(count) >= size) break;
+    offset += count;
+  }
+  event->flops = 0;
+#ifdef LITE_WITH_PROFILE
+  if (!first_epoch_for_profiler_ && profile_id_ >= 0) {
+    event->flops = profiler_->GetOpCharacter(profile_id_)->macs;
+  }
+#endif
+  event->thread_id = profile::Timeline::ThreadId();
+  event->start_us = start_us;
+  event->end_us = end_us;
+}
+
 STL::ostream& operator<<(STL::ostream& os, const Instruction& other) {
   os << other.kernel_->summary() << "\t(" << other.kernel_->doc() << ")";
   return os;
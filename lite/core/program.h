@@ -13,16 +13,28 @@
 // limitations under the License.
 
 #pragma once
+#include <condition_variable>  // NOLINT
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
+#include <set>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
+#include "lite/api/paddle_api.h"
+#include "lite/core/inter_op_scheduler.h"
 #include "lite/core/kernel.h"
+#include "lite/core/latency_table.h"
+#include "lite/core/memory_planner.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
+#include "lite/core/profile/timeline.h"
+#include "lite/core/runtime_stats.h"
 #include "lite/model_parser/cpp_desc.h"
+#include "lite/utils/env.h"
 #ifdef LITE_WITH_PROFILE
 #include "lite/core/profile/profiler.h"
 #endif
@@ -128,8 +140,38 @@ struct Instruction {
   const KernelBase* kernel() const { return kernel_.get(); }
   KernelBase* mutable_kernel() { return kernel_.get(); }
 
+  OpLite* mutable_op() { return op_.get(); }
+
   bool is_feed_fetch_op() const { return is_feed_fetch_op_; }
 
+  // The number of the kernel runs and the time spent by them.
+  uint64_t run_count() const { return run_count_.value(); }
+  uint64_t run_time_ns() const { return run_time_ns_.value(); }
+
+  // Record the latency of each run into `table` keyed by the input shapes and
+  // `threads`, stopped by nullptr.
+  void set_latency_table(LatencyTable* table, int threads) {
+    latency_table_ = table;
+    latency_threads_ = threads;
+  }
+  // The key of the kernel in the LatencyTable for the current input shapes.
+  std::string LatencyKey(int threads);
+
+  // Resize the outputs to the shapes of the last run instead of inferring
+  // them, set by the frozen RuntimeProgram if its inputs are not changed.
+  void set_reuse_shapes(bool reuse_shapes) { reuse_shapes_ = reuse_shapes; }
+
+  // Called once at the beginning of the first run, before the kernel is
+  // prepared, e.g. to materialize the weights loaded lazily.
+  void set_first_run_hook(const std::function<void()>& hook) {
+    first_run_hook_ = hook;
+  }
+
+  // Do the first-run work of the op ahead of the first run: the hook, the
+  // shape check and the shape inference, so the kernel can be prepared
+  // before it runs, see RuntimeProgram::set_parallel_prepare.
+  void InferShapeAhead();
+
 #ifdef LITE_WITH_CUDA
   bool need_sync() const {
     if (kernel_->target() == TargetType::kCUDA) {
@@ -176,7 +218,13 @@ struct Instruction {
     auto* op_lite = static_cast<paddle::lite::OpLite*>(ch->op_lite);
     CHECK(op_lite != nullptr) << "op_lite should not be nullptr.";
     op_lite->GetOpRuntimeInfo(ch);
+    if (ch->bytes == 0) ch->bytes = EstimateMemoryTraffic();
   }
+  // The total bytes of the input and output tensors.
+  float EstimateMemoryTraffic() const;
+  void ForEachIOTensor(
+      const std::function<void(const std::string&, const Tensor&)>& func)
+      const;
 #endif
 
  private:
@@ -185,6 +233,20 @@ struct Instruction {
   bool is_feed_fetch_op_{false};
   bool first_epoch_{true};
   bool has_run_{false};
+  bool reuse_shapes_{false};
+  std::function<void()> first_run_hook_;
+  StatsCounter run_count_;
+  StatsCounter run_time_ns_;
+  LatencyTable* latency_table_{nullptr};
+  int latency_threads_{1};
+  // The input tensors whose shapes are recorded by the timeline and the
+  // latency table, resolved at the first use.
+  std::vector<const Tensor*> input_tensors_;
+  bool input_tensors_resolved_{false};
+
+  const std::vector<const Tensor*>& input_tensors();
+
+  void RecordTimelineEvent(uint64_t start_us, uint64_t end_us);
 
 #ifdef LITE_WITH_PROFILE
   profile::Profiler* profiler_;
@@ -207,6 +269,10 @@ class LITE_API RuntimeProgram {
       Scope* exec_scope,
       int block_idx = kRootBlockIdx);
   ~RuntimeProgram() {
+    StopPipelineWorkers();
+#ifdef LITE_WITH_CUDA
+    ResetCudaGraphs();
+#endif
 #ifdef LITE_WITH_OPENCL
     // save program kernel cache & tuned params
     CLRuntime::Global()->SaveProgram();
@@ -215,6 +281,9 @@ class LITE_API RuntimeProgram {
 #ifdef LITE_WITH_PROFILE
     LOG(INFO) << "\n" << profiler_.Summary(profile::Type::kCreate);
     LOG(INFO) << "\n" << profiler_.Summary(profile::Type::kDispatch);
+    if (profile::MemoryProfiler::Enabled()) {
+      LOG(INFO) << "\n" << profile::MemoryProfiler::Global().Summary();
+    }
 #endif  // LITE_WITH_PROFILE
   }
 
@@ -222,6 +291,18 @@ class LITE_API RuntimeProgram {
     if (instructions_.empty()) {
       LOG(FATAL) << "no instructions";
     }
+    use_memory_arena_ = GetBoolFromEnv("LITE_MEMORY_ARENA");
+    frozen_ = GetBoolFromEnv("LITE_FROZEN_PROGRAM");
+    inter_op_lanes_ = GetIntFromEnv("LITE_INTER_OP_LANES", 1);
+    parallel_prepare_ = GetBoolFromEnv("LITE_PARALLEL_PREPARE");
+    report_init_time_ = GetBoolFromEnv("LITE_REPORT_INIT_TIME");
+    async_kernels_ = GetBoolFromEnv("LITE_ASYNC_SUBGRAPH");
+#ifdef LITE_WITH_CUDA
+    use_cuda_graph_ = GetBoolFromEnv("LITE_CUDA_GRAPH");
+#endif
+#ifdef LITE_WITH_OPENCL
+    use_adaptive_flush_ = GetBoolFromEnv("LITE_OPENCL_ADAPTIVE_FLUSH");
+#endif
 #ifdef LITE_WITH_PROFILE
     set_profiler();
 #endif
@@ -285,6 +366,22 @@ class LITE_API RuntimeProgram {
   void SaveOutput();
 #endif
 
+  // Run `requests` requests in a pipeline of the stages of the program, which
+  // are the segments of the instructions on the host and on the other devices,
+  // e.g. the NNAdapter subgraphs, so the host segment of the request i+1 runs
+  // while the device segment of the request i is executing. On XPU, the
+  // io_copy ops make their own stages, so the copies of the adjacent requests
+  // overlap with the compute, which needs enable_xpu_multi_stream() to run
+  // the copies on their own streams. `feed(i)` sets
+  // the inputs of the request i and `fetch(i)` reads its outputs, both are
+  // called on the calling thread between the steps of the pipeline. The
+  // variables crossing the stages are double-buffered and passed to the next
+  // stages after each step. Falls back to the sequential runs if the program
+  // can not be pipelined, e.g. with the control flow ops or the memory arena.
+  void RunPipelined(size_t requests,
+                    const std::function<void(size_t)>& feed,
+                    const std::function<void(size_t)>& fetch);
+
   void set_exec_scope(Scope* x) { exec_scope_ = x; }
   Scope* exec_scope() { return exec_scope_; }
 
@@ -304,6 +401,81 @@ class LITE_API RuntimeProgram {
 
   const int64_t get_version() const { return version_; }
 
+  // Skip inferring the shapes of all the ops in the runs whose inputs have
+  // the same dims, LoDs and small data as the last one, the outputs are just
+  // resized to the shapes of the last run. It assumes the shapes are decided
+  // by the inputs of the program only, i.e. none of the ops infers its shapes
+  // from the data computed by the others. Enabled by LITE_FROZEN_PROGRAM.
+  void set_frozen(bool frozen) { frozen_ = frozen; }
+  bool frozen() const { return frozen_; }
+
+  // Run the independent branches of the program on the host at the same time
+  // by `lanes` threads, which share the intra-op threads, see
+  // InterOpScheduler. The lanes are planned after the first run. Enabled by
+  // LITE_INTER_OP_LANES, 1 means running the instructions one by one.
+  void set_inter_op_lanes(int lanes) { inter_op_lanes_ = lanes; }
+  int inter_op_lanes() const { return inter_op_lanes_; }
+
+  // Prepare the ARM and X86 kernels, i.e. their PrepareForRun which packs
+  // and transforms the weights, on all the cores at the start of the first
+  // run instead of one by one as they run. The shapes of all the ops are
+  // inferred ahead for it, which assumes, as the frozen program does, that
+  // they are decided by the inputs of the program only. The kernels of the
+  // other targets are still prepared by their first runs. Enabled by
+  // LITE_PARALLEL_PREPARE.
+  void set_parallel_prepare(bool parallel) { parallel_prepare_ = parallel; }
+  bool parallel_prepare() const { return parallel_prepare_; }
+
+  // Log the time spent in PrepareForRun by each kernel after the first run,
+  // the slowest first. Enabled by LITE_REPORT_INIT_TIME.
+  void set_report_init_time(bool report) { report_init_time_ = report; }
+
+  // Launch the kernels which can run asynchronously, i.e. the subgraphs of
+  // the devices, and run the following ops not using their inputs or outputs
+  // until one does, so the host ops overlap the device. Only the instructions
+  // run one by one do so, and not with the memory arena, whose buffers are
+  // planned for the ops running in order. Enabled by LITE_ASYNC_SUBGRAPH.
+  void set_async_kernels(bool async) { async_kernels_ = async; }
+  bool async_kernels() const { return async_kernels_; }
+
+#ifdef LITE_WITH_CUDA
+  // Capture the segments of the consecutive CUDA kernels into CUDA graphs,
+  // and replay them instead of launching the kernels one by one in the runs
+  // whose inputs are the same as the last run. The graphs keep the addresses
+  // of the buffers, so they are captured again after a warmup run once the
+  // inputs change. The streams assigned by multi_stream_analysis_pass are
+  // forked from and joined to the stream of the first kernel of each segment.
+  // Enabled by LITE_CUDA_GRAPH, and disabled if a kernel can not be captured.
+  void set_cuda_graph(bool cuda_graph) { use_cuda_graph_ = cuda_graph; }
+  bool cuda_graph() const { return use_cuda_graph_; }
+#endif
+
+  // The memory plans cached for the buckets of the input shapes, only
+  // available with LITE_MEMORY_ARENA.
+  std::vector<MemoryPlanStats> memory_plan_stats() const;
+  // Fill the kernel runs aggregated by the op type and the peak arena.
+  void CollectRuntimeStats(lite_api::RuntimeStats* stats) const;
+  // Record the latency of the kernels of the following runs into `table`,
+  // stopped by nullptr.
+  void SetLatencyTable(LatencyTable* table, int threads);
+  // Estimate the latency in ms of a run of the current input shapes by the
+  // kernel latencies in `table`, the shapes are inferred without running the
+  // kernels. The kernels not in `table` are counted in `missing`.
+  double EstimateLatency(const LatencyTable& table,
+                         int threads,
+                         int* missing = nullptr);
+  // Infer the shapes of the instructions of the root block in order from the
+  // current input shapes without running the kernels, and call `fn` on each
+  // of them except feed and fetch.
+  void InferShapes(const std::function<void(Instruction*)>& fn);
+
+  // Release the memory arena, the cached plans are kept and applied again in
+  // the next run.
+  void ReleaseMemoryArena() {
+    memory_arena_.reset();
+    active_memory_plan_ = nullptr;
+  }
+
 #ifndef LITE_ON_TINY_PUBLISH
   // Update the ops and vars of all of blocks to the given program_desc
   // according to the instructions
@@ -321,11 +493,134 @@ class LITE_API RuntimeProgram {
 
  private:
   RuntimeProgram(const RuntimeProgram&) = delete;
+  // Back the host activations with a single arena whose offsets are planned
+  // from the peak sizes and the lifetimes observed in the runs, the tensors
+  // which grow later leave the arena and trigger the planning again. The
+  // plans are cached by the bucket of the input shapes, and the arena only
+  // grows to the largest plan.
+  void PrepareMemoryArena();
+  void PlanMemoryArena();
+  void ApplyMemoryPlan(const MemoryPlan& plan);
+  bool MemoryArenaStale() const;
+  // Resolve the inputs of the frozen program and enable the shape cache of
+  // its ops, called by the first run.
+  void PrepareFrozen();
+  // Whether the inputs are the same as the last run, which are updated.
+  bool FrozenInputsUnchanged();
+  // Plan the lanes of the inter-op parallelism after the first run.
+  void PlanInterOp();
+  void PrepareKernels();
+  // Wait for the kernels launched asynchronously which `inst` depends on, or
+  // all of them for nullptr.
+  void WaitAsyncKernels(const Instruction* inst);
+  void ReportInitTime();
+#ifdef LITE_WITH_CUDA
+  // The instructions [begin, end) of the root block captured into one graph.
+  struct CudaGraphSegment {
+    size_t begin{0};
+    size_t end{0};
+    cudaStream_t stream{nullptr};
+    cudaGraphExec_t exec{nullptr};
+  };
+  // Find the segments of the CUDA kernels but the synchronous io_copy ones.
+  void PrepareCudaGraph();
+  // Run the instructions of the segment by capturing and launching its graph,
+  // returns false if they can not be captured, and then nothing is run.
+  bool CaptureCudaGraph(CudaGraphSegment* segment, bool reuse_shapes);
+  void ResetCudaGraphs();
+#endif
+  // Split the instructions into the pipeline stages, and rename the variables
+  // crossing the stages for the ops of all stages but one, so each stage has
+  // its own copy. Returns false if the program can not be pipelined.
+  bool PreparePipeline();
+  void RunPipelineStage(size_t stage);
+  // The stages but the one of the calling thread run on the persistent
+  // workers, which are stopped when the program is destroyed.
+  void StartPipelineWorkers();
+  void PipelineWorkerLoop(size_t stage);
+  void StopPipelineWorkers();
+  bool PipelineStageActive(size_t stage) const {
+    return pipeline_step_ >= stage &&
+           pipeline_step_ - stage < pipeline_requests_;
+  }
+  // Pass the copies of the variables crossing the stages to the next stages,
+  // by swapping the buffers if they are not shared with the other tensors.
+  void PipelineHandoff();
+#ifdef LITE_WITH_OPENCL
+  // Plan where to flush the OpenCL queue after the first run, by the work of
+  // the instructions estimated from their output sizes. The first chunk is
+  // flushed early to keep the gpu busy, and the later chunks grow to save the
+  // driver overhead of the small ops.
+  void PlanOpenCLFlush();
+#endif
+
   std::vector<std::vector<Instruction>> instructions_;
   Scope* exec_scope_{};
   int64_t version_{0};
+  bool use_memory_arena_{false};
+  std::shared_ptr<Buffer> memory_arena_;
+  std::map<std::string, MemoryPlan> memory_plans_;
+  // The bucket of the current run and the plan applied to the tensors.
+  std::string memory_bucket_;
+  const MemoryPlan* active_memory_plan_{nullptr};
+  bool frozen_{false};
+  bool frozen_prepared_{false};
+  // The inputs of the frozen program, and their states of the last run.
+  std::vector<const Tensor*> frozen_inputs_;
+  std::vector<DDim> frozen_input_dims_;
+  std::vector<LoD> frozen_input_lods_;
+  std::vector<std::vector<char>> frozen_input_data_;
+  int inter_op_lanes_{1};
+  bool inter_op_planned_{false};
+  std::unique_ptr<InterOpScheduler> inter_op_scheduler_;
+  bool parallel_prepare_{false};
+  bool kernels_prepared_{false};
+  bool report_init_time_{false};
+  bool init_time_reported_{false};
+  bool async_kernels_{false};
+  // The vars of the kernels launched asynchronously and not waited yet, by
+  // the index of their instructions.
+  std::map<size_t, std::set<std::string>> pending_kernels_;
+#ifdef LITE_WITH_CUDA
+  bool use_cuda_graph_{false};
+  bool cuda_graph_prepared_{false};
+  std::vector<CudaGraphSegment> cuda_graph_segments_;
+#endif
+  bool pipeline_prepared_{false};
+  bool pipelined_{false};
+  // The [begin, end) of the instructions of each stage, and whether they are
+  // on the devices other than the host.
+  std::vector<std::pair<size_t, size_t>> pipeline_stages_;
+  std::vector<bool> pipeline_on_device_;
+  // The copies of each variable crossing the stages, from the one of the
+  // producer stage to the one of the last consumer stage.
+  std::vector<std::vector<Tensor*>> pipeline_buffers_;
+  // The stage run by the calling thread, which is the first device stage but
+  // the copies, since the runtime of some devices keeps the states of the
+  // calling thread, e.g. the context of XPU, or the first host stage.
+  size_t pipeline_caller_stage_{0};
+  std::vector<std::thread> pipeline_workers_;
+  std::mutex pipeline_mutex_;
+  std::condition_variable pipeline_cv_;
+  // The step run by the workers, which start it once pipeline_epoch_ changes.
+  size_t pipeline_step_{0};
+  size_t pipeline_requests_{0};
+  uint64_t pipeline_epoch_{0};
+  size_t pipeline_pending_{0};
+  bool pipeline_stop_{false};
+#ifdef LITE_WITH_OPENCL
+  // Enabled by LITE_OPENCL_ADAPTIVE_FLUSH, otherwise the queue is flushed
+  // every fixed number of instructions.
+  bool use_adaptive_flush_{false};
+  // Whether to flush the queue before each instruction.
+  std::vector<bool> opencl_flush_plan_;
+#endif
 
 #ifdef LITE_WITH_METAL
+  // Plan the heaps shared by the textures of the vars of the Metal kernels
+  // by their lifetimes in the root block.
+  void PlanMetalMemoryReuse(MetalContext* context);
+
   std::unique_ptr<KernelContext> metal_ctx_{nullptr};
 #endif
 
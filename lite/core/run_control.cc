@@ -0,0 +1,35 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/run_control.h"
+#include "lite/utils/macros.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+LITE_THREAD_LOCAL const RunControl* current_run_control = nullptr;
+}  // namespace
+
+const RunControl* RunControl::Current() { return current_run_control; }
+
+RunControl::Scope::Scope(const RunControl* control)
+    : previous_(current_run_control) {
+  current_run_control = control;
+}
+
+RunControl::Scope::~Scope() { current_run_control = previous_; }
+
+}  // namespace lite
+}  // namespace paddle
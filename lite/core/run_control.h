@@ -0,0 +1,73 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <memory>
+#include <utility>
+
+namespace paddle {
+namespace lite {
+
+// The deadline and the cancellation of a run, which are checked by the
+// runtime programs at the boundaries of the instructions and the iterations
+// of the while loops, so a stopped run skips the rest of the instructions.
+class RunControl {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  RunControl(Clock::time_point deadline,
+             std::shared_ptr<std::atomic<bool>> cancelled)
+      : deadline_(deadline), cancelled_(std::move(cancelled)) {}
+
+  // Whether the run should stop, which stays true once it is.
+  bool Check() const {
+    if (stopped_.load(std::memory_order_relaxed)) return true;
+    if ((cancelled_ && cancelled_->load(std::memory_order_relaxed)) ||
+        (deadline_ != Clock::time_point::max() && Clock::now() >= deadline_)) {
+      stopped_.store(true, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+  bool stopped() const { return stopped_.load(std::memory_order_relaxed); }
+
+  // The control of the run on the calling thread, nullptr if there is none.
+  static const RunControl* Current();
+
+  // Set the control of the calling thread in the scope.
+  class Scope {
+   public:
+    explicit Scope(const RunControl* control);
+    ~Scope();
+
+   private:
+    const RunControl* previous_;
+  };
+
+ private:
+  Clock::time_point deadline_;
+  std::shared_ptr<std::atomic<bool>> cancelled_;
+  mutable std::atomic<bool> stopped_{false};
+};
+
+// Whether the run on the calling thread should stop.
+inline bool RunStopped() {
+  const RunControl* control = RunControl::Current();
+  return control && control->Check();
+}
+
+}  // namespace lite
+}  // namespace paddle
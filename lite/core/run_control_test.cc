@@ -0,0 +1,61 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/run_control.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+namespace paddle {
+namespace lite {
+
+TEST(RunControl, cancelled) {
+  auto cancelled = std::make_shared<std::atomic<bool>>(false);
+  RunControl control(RunControl::Clock::time_point::max(), cancelled);
+  EXPECT_FALSE(control.Check());
+  cancelled->store(true);
+  EXPECT_TRUE(control.Check());
+  // It stays stopped once it is.
+  cancelled->store(false);
+  EXPECT_TRUE(control.Check());
+  EXPECT_TRUE(control.stopped());
+}
+
+TEST(RunControl, deadline) {
+  RunControl passed(RunControl::Clock::now(), nullptr);
+  EXPECT_TRUE(passed.Check());
+  RunControl future(RunControl::Clock::now() + std::chrono::hours(1), nullptr);
+  EXPECT_FALSE(future.Check());
+  EXPECT_FALSE(future.stopped());
+}
+
+TEST(RunControl, scope) {
+  EXPECT_EQ(RunControl::Current(), nullptr);
+  EXPECT_FALSE(RunStopped());
+  RunControl outer(RunControl::Clock::time_point::max(), nullptr);
+  RunControl inner(RunControl::Clock::now(), nullptr);
+  {
+    RunControl::Scope outer_scope(&outer);
+    EXPECT_EQ(RunControl::Current(), &outer);
+    EXPECT_FALSE(RunStopped());
+    {
+      RunControl::Scope inner_scope(&inner);
+      EXPECT_TRUE(RunStopped());
+    }
+    EXPECT_EQ(RunControl::Current(), &outer);
+  }
+  EXPECT_EQ(RunControl::Current(), nullptr);
+}
+
+}  // namespace lite
+}  // namespace paddle
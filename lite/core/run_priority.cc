@@ -0,0 +1,94 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/run_priority.h"
+#include "lite/utils/log/logging.h"
+#include "lite/utils/macros.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+// The priority of the run on the calling thread, -1 if there is none.
+LITE_THREAD_LOCAL int current_priority = -1;
+}  // namespace
+
+RunPriorityArbiter& RunPriorityArbiter::Global() {
+  static auto* x = new RunPriorityArbiter;
+  return *x;
+}
+
+std::shared_ptr<void> RunPriorityArbiter::Register(
+    lite_api::RunPriority priority) {
+  int level = static_cast<int>(priority);
+  CHECK(level >= 0 && level < kLevels) << "Unknown run priority: " << level;
+  registered_[level]++;
+  return std::shared_ptr<void>(nullptr,
+                               [this, level](void*) { registered_[level]--; });
+}
+
+lite_api::PowerMode RunPriorityArbiter::ReserveCores(
+    lite_api::RunPriority priority, lite_api::PowerMode mode) const {
+  switch (priority) {
+    case lite_api::LITE_PRIORITY_FOREGROUND:
+      if (mode == lite_api::LITE_POWER_FULL ||
+          mode == lite_api::LITE_POWER_RAND_HIGH) {
+        return mode;
+      }
+      return lite_api::LITE_POWER_HIGH;
+    case lite_api::LITE_PRIORITY_BACKGROUND:
+      if (registered_[lite_api::LITE_PRIORITY_FOREGROUND] == 0 ||
+          mode == lite_api::LITE_POWER_RAND_LOW) {
+        return mode;
+      }
+      return lite_api::LITE_POWER_LOW;
+    default:
+      return mode;
+  }
+}
+
+bool RunPriorityArbiter::HigherRunning(int level) const {
+  for (int i = level + 1; i < kLevels; i++) {
+    if (running_[i].load(std::memory_order_acquire) > 0) return true;
+  }
+  return false;
+}
+
+void RunPriorityArbiter::Yield() {
+  int level = current_priority;
+  if (level < 0 || !HigherRunning(level)) return;
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [&] { return !HigherRunning(level); });
+}
+
+RunPriorityArbiter::Scope::Scope(lite_api::RunPriority priority)
+    : previous_(current_priority) {
+  int level = static_cast<int>(priority);
+  CHECK(level >= 0 && level < kLevels) << "Unknown run priority: " << level;
+  current_priority = level;
+  Global().running_[level]++;
+}
+
+RunPriorityArbiter::Scope::~Scope() {
+  auto& arbiter = Global();
+  {
+    std::lock_guard<std::mutex> lock(arbiter.mutex_);
+    arbiter.running_[current_priority]--;
+  }
+  arbiter.cv_.notify_all();
+  current_priority = previous_;
+}
+
+}  // namespace lite
+}  // namespace paddle
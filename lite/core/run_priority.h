@@ -0,0 +1,68 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include "lite/api/paddle_place.h"
+
+namespace paddle {
+namespace lite {
+
+// Arbitrates the runs of the predictors of different priorities in one
+// process. A run yields at the boundaries of the instructions while any run
+// of a higher priority is in flight, and the cores are reserved by priority:
+// the foreground predictors run on the big cores, and the background ones are
+// moved to the little cores while any foreground predictor exists.
+class RunPriorityArbiter {
+ public:
+  static RunPriorityArbiter& Global();
+
+  // Register a predictor of the priority, which is unregistered when the
+  // returned handle is released.
+  std::shared_ptr<void> Register(lite_api::RunPriority priority);
+
+  // The power mode of a run of the priority configured with `mode`.
+  lite_api::PowerMode ReserveCores(lite_api::RunPriority priority,
+                                   lite_api::PowerMode mode) const;
+
+  // Block the calling thread while any run of a higher priority than the one
+  // on it is in flight, return at once outside of the runs.
+  void Yield();
+
+  // Mark a run of the priority in flight on the calling thread in the scope.
+  class Scope {
+   public:
+    explicit Scope(lite_api::RunPriority priority);
+    ~Scope();
+
+   private:
+    int previous_;
+  };
+
+ private:
+  static constexpr int kLevels = 3;
+
+  bool HigherRunning(int level) const;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::atomic<int> running_[kLevels]{};
+  std::atomic<int> registered_[kLevels]{};
+};
+
+}  // namespace lite
+}  // namespace paddle
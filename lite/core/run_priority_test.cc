@@ -0,0 +1,81 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/run_priority.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <thread>  // NOLINT
+
+namespace paddle {
+namespace lite {
+
+TEST(RunPriority, reserve_cores) {
+  auto& arbiter = RunPriorityArbiter::Global();
+  EXPECT_EQ(arbiter.ReserveCores(lite_api::LITE_PRIORITY_FOREGROUND,
+                                 lite_api::LITE_POWER_NO_BIND),
+            lite_api::LITE_POWER_HIGH);
+  EXPECT_EQ(arbiter.ReserveCores(lite_api::LITE_PRIORITY_FOREGROUND,
+                                 lite_api::LITE_POWER_FULL),
+            lite_api::LITE_POWER_FULL);
+  // The background runs keep their mode without a foreground predictor.
+  EXPECT_EQ(arbiter.ReserveCores(lite_api::LITE_PRIORITY_BACKGROUND,
+                                 lite_api::LITE_POWER_NO_BIND),
+            lite_api::LITE_POWER_NO_BIND);
+  {
+    auto handle = arbiter.Register(lite_api::LITE_PRIORITY_FOREGROUND);
+    EXPECT_EQ(arbiter.ReserveCores(lite_api::LITE_PRIORITY_BACKGROUND,
+                                   lite_api::LITE_POWER_NO_BIND),
+              lite_api::LITE_POWER_LOW);
+    EXPECT_EQ(arbiter.ReserveCores(lite_api::LITE_PRIORITY_NORMAL,
+                                   lite_api::LITE_POWER_NO_BIND),
+              lite_api::LITE_POWER_NO_BIND);
+  }
+  EXPECT_EQ(arbiter.ReserveCores(lite_api::LITE_PRIORITY_BACKGROUND,
+                                 lite_api::LITE_POWER_NO_BIND),
+            lite_api::LITE_POWER_NO_BIND);
+}
+
+TEST(RunPriority, yield) {
+  auto& arbiter = RunPriorityArbiter::Global();
+  // Outside of the runs and without a higher run it returns at once.
+  arbiter.Yield();
+  {
+    RunPriorityArbiter::Scope scope(lite_api::LITE_PRIORITY_BACKGROUND);
+    arbiter.Yield();
+  }
+
+  std::atomic<bool> foreground_started{false};
+  std::atomic<bool> foreground_done{false};
+  std::atomic<bool> yielded_after_done{false};
+  std::thread foreground([&]() {
+    RunPriorityArbiter::Scope scope(lite_api::LITE_PRIORITY_FOREGROUND);
+    foreground_started = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    // A foreground run never waits.
+    arbiter.Yield();
+    foreground_done = true;
+  });
+  while (!foreground_started) std::this_thread::yield();
+  {
+    RunPriorityArbiter::Scope scope(lite_api::LITE_PRIORITY_BACKGROUND);
+    arbiter.Yield();
+    yielded_after_done = foreground_done.load();
+  }
+  foreground.join();
+  EXPECT_TRUE(yielded_after_done);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,33 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/runtime_stats.h"
+
+namespace paddle {
+namespace lite {
+
+RuntimeStats& RuntimeStats::Global() {
+  // Never destroyed, since the counters may be updated by the static objects
+  // after it.
+  static RuntimeStats* x = new RuntimeStats;
+  return *x;
+}
+
+ThreadBuildStats& ThreadBuildStats::Current() {
+  static thread_local ThreadBuildStats x;
+  return x;
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,81 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdint>
+
+namespace paddle {
+namespace lite {
+
+// A relaxed atomic counter, which is copyable so that it can be a member of
+// the objects kept in the containers, e.g. the instructions.
+class StatsCounter {
+ public:
+  StatsCounter() = default;
+  StatsCounter(const StatsCounter& other) : value_(other.value()) {}
+  StatsCounter& operator=(const StatsCounter& other) {
+    value_.store(other.value(), std::memory_order_relaxed);
+    return *this;
+  }
+
+  void Add(uint64_t delta) {
+    value_.fetch_add(delta, std::memory_order_relaxed);
+  }
+  uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<uint64_t> value_{0};
+};
+
+struct CacheCounter {
+  StatsCounter hits;
+  StatsCounter misses;
+
+  void Record(bool hit) { hit ? hits.Add(1) : misses.Add(1); }
+};
+
+// The process-wide counters which are always collected, e.g. the hits of the
+// caches and the busy time of the thread pools. They are only updated with the
+// relaxed atomic operations, so no profiling build is needed.
+struct RuntimeStats {
+  static RuntimeStats& Global();
+
+  StatsCounter thread_pool_busy_ns;
+  StatsCounter thread_pool_idle_ns;
+  CacheCounter opencl_tune_cache;
+  CacheCounter opencl_memory_pool;
+  CacheCounter kernel_tune_cache;
+  CacheCounter nnadapter_model_cache;
+  CacheCounter infer_shape_cache;
+};
+
+// The time the calling thread spent in reading the model files and creating
+// the kernels, which splits the build of a predictor into its phases.
+struct ThreadBuildStats {
+  static ThreadBuildStats& Current();
+
+  uint64_t read_file_ns{0};
+  uint64_t create_kernels_ns{0};
+};
+
+inline uint64_t MonotonicNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace lite
+}  // namespace paddle
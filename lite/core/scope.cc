@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/core/scope.h"
+#include <algorithm>
 #define SCOPE_KIDS_READER_LOCK \
   lite::fluid::AutoRDLock auto_lock(kids_lock_.get());
 #define SCOPE_KIDS_WRITER_LOCK \
@@ -46,8 +47,8 @@ Variable *Scope::Var(const std::string &name) {
   auto *var = FindVar(name);
   if (var) return var;
   // create a new variable.
-  vars_.emplace(name, std::unique_ptr<Variable>(new Variable));
-  return vars_[name].get();
+  auto it = vars_.emplace(name, std::unique_ptr<Variable>(new Variable));
+  return it.first->second.get();
 }
 
 Variable *Scope::LocalVar(const std::string &name) {
@@ -55,8 +56,8 @@ Variable *Scope::LocalVar(const std::string &name) {
   auto *var = FindLocalVar(name);
   if (var) return var;
   // create a new variable.
-  vars_.emplace(name, std::unique_ptr<Variable>(new Variable));
-  return vars_[name].get();
+  auto it = vars_.emplace(name, std::unique_ptr<Variable>(new Variable));
+  return it.first->second.get();
 }
 
 Variable *Scope::FindVar(const std::string &name) const {
@@ -94,7 +95,7 @@ std::vector<std::string> Scope::AttributeVarNames() const {
   }
   // remove feed and fetch
   std::vector<std::string> skiped_vars = {"feed", "fetch"};
-  for (int i = 0; i < skiped_vars.size(); i++) {
+  for (size_t i = 0; i < skiped_vars.size(); i++) {
     auto iter =
         std::find(resulted_keys.begin(), resulted_keys.end(), skiped_vars[i]);
     while (iter != resulted_keys.end()) {
@@ -115,6 +116,8 @@ std::vector<std::string> Scope::LocalVarNames() const {
     }
     rwlock_->UNLock();
   }
+  // sorted, so that the listing does not depend on the hashing
+  std::sort(keys.begin(), keys.end());
   return keys;
 }
 
@@ -17,6 +17,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include "lite/backends/x86/fluid/rw_lock.h"
@@ -98,7 +99,7 @@ class Scope final {
   // Scope in `kids_` are owned by this class.
   mutable std::list<Scope*> kids_;
   const Scope* parent_{nullptr};
-  std::map<std::string, std::unique_ptr<Variable>> vars_;
+  std::unordered_map<std::string, std::unique_ptr<Variable>> vars_;
   std::unique_ptr<lite::fluid::RWLock> kids_lock_{nullptr};
   std::unique_ptr<lite::fluid::RWLock> vars_lock_{nullptr};
   std::unique_ptr<lite::fluid::RWLock> rwlock_{nullptr};
@@ -14,6 +14,8 @@
 
 #include "lite/core/scope.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
 
 namespace paddle {
 namespace lite {
@@ -33,5 +35,20 @@ TEST(Scope, FindVar) {
   ASSERT_TRUE(scope.FindVar("x"));
 }
 
+TEST(Scope, LocalVarNames) {
+  Scope scope;
+  auto* x = scope.Var("x");
+  for (int i = 0; i < 100; i++) {
+    scope.Var("var_" + std::to_string(i));
+  }
+  // the handles stay valid as the scope grows
+  ASSERT_EQ(scope.FindVar("x"), x);
+  ASSERT_EQ(scope.Var("x"), x);
+
+  auto names = scope.LocalVarNames();
+  ASSERT_EQ(names.size(), 101u);
+  ASSERT_TRUE(std::is_sorted(names.begin(), names.end()));
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -0,0 +1,183 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/shared_memory_weights.h"
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <vector>
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+#include "lite/core/memory_planner.h"
+#include "lite/core/model/base/io.h"
+#include "lite/utils/io.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+const uint32_t kMagic = 0x574d534c;  // "LSMW"
+const uint32_t kVersion = 1;
+const size_t kAlignment = 64;
+
+size_t Padding(size_t offset) {
+  return (kAlignment - offset % kAlignment) % kAlignment;
+}
+
+std::map<std::string, Tensor*> SharableTensors(
+    Scope* scope, const std::set<std::string>& excluded) {
+  std::map<std::string, Tensor*> tensors;
+  for (auto& name : scope->LocalVarNames()) {
+    if (excluded.count(name)) continue;
+    auto* var = scope->FindLocalVar(name);
+    if (!var || !var->IsType<Tensor>()) continue;
+    auto* tensor = var->GetMutable<Tensor>();
+    auto target = tensor->target();
+    if (!tensor->persistable() || !tensor->IsInitialized() ||
+        tensor->memory_size() == 0 ||
+        (target != TARGET(kHost) && target != TARGET(kARM) &&
+         target != TARGET(kX86)) ||
+        (tensor->offset() != 0 && !tensor->IsView())) {
+      continue;
+    }
+    tensors.emplace(name, tensor);
+  }
+  return tensors;
+}
+
+#if !defined(_WIN32)
+// Written into a temporary file first, so the processes mapping the region
+// at the same time never see a partial one.
+bool WriteRegion(const std::string& path,
+                 const std::map<std::string, Tensor*>& tensors) {
+  std::string tmp_path = path + ".tmp." + std::to_string(getpid());
+  {
+    model_parser::BinaryFileWriter file(tmp_path);
+    const model_parser::ByteWriter& writer = file;
+    writer.Write<uint32_t>(kMagic);
+    writer.Write<uint32_t>(kVersion);
+    writer.Write<uint64_t>(tensors.size());
+    for (auto& item : tensors) {
+      auto* tensor = item.second;
+      writer.Write<uint32_t>(item.first.size());
+      writer.Write(item.first.data(), item.first.size());
+      writer.Write<int32_t>(static_cast<int32_t>(tensor->precision()));
+      writer.Write<uint32_t>(tensor->dims().size());
+      for (size_t i = 0; i < tensor->dims().size(); i++) {
+        writer.Write<int64_t>(tensor->dims()[i]);
+      }
+      writer.Write<uint64_t>(tensor->memory_size());
+      writer.Align(kAlignment);
+      writer.Write(tensor->raw_data(), tensor->memory_size());
+    }
+  }
+  // A region written by another process meanwhile is replaced as a whole,
+  // the processes which mapped it keep their mappings.
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    LOG(WARNING) << "Failed to write the shared weights into " << path;
+    std::remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+#endif
+}  // namespace
+
+std::string SharedMemoryRegionPath(const std::string& name) {
+  CHECK(!name.empty());
+  if (name.find('/') != std::string::npos) return name;
+#if defined(__ANDROID__)
+  LOG(FATAL) << "The shared memory region must be a path on Android, e.g. "
+                "in the cache dir of the app, while the given one is "
+             << name;
+  return name;
+#else
+  return "/dev/shm/" + name;
+#endif
+}
+
+size_t ShareScopeThroughSharedMemory(const std::string& name,
+                                     Scope* scope,
+                                     const std::set<std::string>& excluded) {
+  CHECK(scope);
+#if defined(_WIN32)
+  LOG(WARNING) << "Sharing the weights through shared memory is not "
+                  "supported on Windows";
+  return 0;
+#else
+  auto path = SharedMemoryRegionPath(name);
+  auto tensors = SharableTensors(scope, excluded);
+  if (tensors.empty()) return 0;
+  if (!IsFileExists(path) && !WriteRegion(path, tensors)) return 0;
+
+  {
+    model_parser::BinaryFileReader file(path);
+    if (file.length() < 2 * sizeof(uint32_t) + sizeof(uint64_t)) {
+      LOG(WARNING) << "Ignore the broken shared weights " << path;
+      return 0;
+    }
+  }
+  model_parser::MappedFileReader file(path);
+  const model_parser::ByteReader& reader = file;
+  auto mapping = reader.mapping();
+  auto remains = [&reader](size_t size) {
+    return reader.length() - reader.current() >= size;
+  };
+  if (reader.Read<uint32_t>() != kMagic ||
+      reader.Read<uint32_t>() != kVersion) {
+    LOG(WARNING) << "Ignore the shared weights " << path
+                 << " of an unknown version";
+    return 0;
+  }
+  uint64_t count = reader.Read<uint64_t>();
+  size_t shared = 0;
+  for (uint64_t i = 0; i < count; i++) {
+    if (!remains(sizeof(uint32_t))) break;
+    uint32_t name_size = reader.Read<uint32_t>();
+    if (!remains(name_size + 2 * sizeof(uint32_t))) break;
+    std::string tensor_name = reader.ReadToString(name_size);
+    auto precision = static_cast<PrecisionType>(reader.Read<int32_t>());
+    uint32_t rank = reader.Read<uint32_t>();
+    if (!remains(rank * sizeof(int64_t) + sizeof(uint64_t))) break;
+    std::vector<int64_t> dims(rank);
+    for (auto& dim : dims) dim = reader.Read<int64_t>();
+    uint64_t size = reader.Read<uint64_t>();
+    size_t padding = Padding(reader.current());
+    if (!remains(padding + size)) break;
+    reader.ReadInPlace(padding);
+    auto* data = static_cast<const char*>(reader.ReadInPlace(size));
+
+    auto it = tensors.find(tensor_name);
+    if (it == tensors.end()) continue;
+    auto* tensor = it->second;
+    if (tensor->precision() != precision || tensor->dims() != DDim(dims) ||
+        tensor->memory_size() != size ||
+        std::memcmp(tensor->raw_data(), data, size) != 0) {
+      continue;
+    }
+    size_t offset = data - static_cast<const char*>(mapping->data());
+    tensor->ResetBuffer(
+        std::make_shared<ArenaBuffer>(mapping, offset, size, tensor->target()),
+        size);
+    shared += size;
+  }
+  VLOG(1) << "Mapped " << shared << " bytes of the weights from " << path;
+  return shared;
+#endif
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,47 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <set>
+#include <string>
+#include "lite/core/scope.h"
+
+namespace paddle {
+namespace lite {
+
+// The persistable tensors of a model placed in a named region of shared
+// memory, so the processes running the same model map one copy of the
+// weights instead of each holding a private one. The first process writes
+// the region after loading the weights, and the later ones map it copy on
+// write, so the weights modified in place by a kernel never leak into the
+// other processes.
+//
+// The region of a bare name lives in /dev/shm on Linux. On Android, where
+// there is no named shared memory without passing the fd over binder, the
+// name must be a path, e.g. in the cache dir of the app, whose pages are
+// shared through the page cache the same way.
+std::string SharedMemoryRegionPath(const std::string& name);
+
+// Replace the buffers of the persistable host tensors of `scope` except the
+// ones of `excluded` by the identical tensors of the region `name`, the
+// region is written first if it does not exist. The tensors are matched by
+// the name, the precision, the dims and the data, so a region written by
+// another model is never misused. Returns the bytes mapped from the region.
+size_t ShareScopeThroughSharedMemory(
+    const std::string& name,
+    Scope* scope,
+    const std::set<std::string>& excluded = {});
+
+}  // namespace lite
+}  // namespace paddle
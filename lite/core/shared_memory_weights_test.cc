@@ -0,0 +1,67 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/shared_memory_weights.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+
+namespace paddle {
+namespace lite {
+
+Tensor* AddWeight(Scope* scope, const std::string& name, float value) {
+  auto* weight = scope->Var(name)->GetMutable<Tensor>();
+  weight->Resize({4, 8});
+  weight->set_persistable(true);
+  weight->set_precision(PRECISION(kFloat));
+  auto* data = weight->mutable_data<float>();
+  for (int i = 0; i < weight->numel(); i++) data[i] = value + i;
+  return weight;
+}
+
+TEST(SharedMemoryWeights, share_scopes) {
+  std::string region = "/tmp/lite_shared_memory_weights_test";
+  std::remove(region.c_str());
+  // The first scope writes the region and maps it as well.
+  Scope scope0;
+  auto* w0 = AddWeight(&scope0, "w", 0.f);
+  AddWeight(&scope0, "head", 1.f);
+  EXPECT_EQ(ShareScopeThroughSharedMemory(region, &scope0),
+            2 * w0->memory_size());
+
+  Scope scope1;
+  auto* w1 = AddWeight(&scope1, "w", 0.f);
+  // The weights of another model are never shared.
+  auto* head1 = AddWeight(&scope1, "head", 2.f);
+  auto* lazy = AddWeight(&scope1, "lazy", 0.f);
+  auto* act = AddWeight(&scope1, "act", 1.f);
+  act->set_persistable(false);
+  EXPECT_EQ(ShareScopeThroughSharedMemory(region, &scope1, {"lazy"}),
+            w1->memory_size());
+  EXPECT_EQ(head1->data<float>()[0], 2.f);
+
+  // The mapping is copied on write.
+  w1->mutable_data<float>()[0] = 10.f;
+  Scope scope2;
+  auto* w2 = AddWeight(&scope2, "w", 0.f);
+  EXPECT_EQ(ShareScopeThroughSharedMemory(region, &scope2),
+            w2->memory_size());
+  EXPECT_EQ(w2->data<float>()[0], 0.f);
+  EXPECT_EQ(w0->data<float>()[0], 0.f);
+  EXPECT_EQ(lazy->data<float>()[1], 1.f);
+  std::remove(region.c_str());
+}
+
+}  // namespace lite
+}  // namespace paddle
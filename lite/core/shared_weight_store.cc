@@ -0,0 +1,108 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/shared_weight_store.h"
+#include <cstring>
+#include <sstream>
+#include "lite/utils/hash.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+std::string WeightKey(const Tensor& weight) {
+  std::stringstream ss;
+  ss << PrecisionToStr(weight.precision()) << "|" << weight.dims().repr()
+     << "|" << weight.memory_size() << "|" << std::hex
+     << HashBytes(weight.raw_data(), weight.memory_size());
+  return ss.str();
+}
+}  // namespace
+
+SharedWeightStore& SharedWeightStore::Global() {
+  static SharedWeightStore* x = new SharedWeightStore;
+  return *x;
+}
+
+bool SharedWeightStore::Share(Tensor* weight) {
+  CHECK(weight);
+  auto target = weight->target();
+  if ((target != TARGET(kHost) && target != TARGET(kARM) &&
+       target != TARGET(kX86)) ||
+      !weight->IsInitialized() || weight->memory_size() == 0) {
+    return false;
+  }
+  auto key = WeightKey(*weight);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto range = weights_.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    auto& stored = it->second;
+    if (stored.raw_data() == weight->raw_data()) return false;
+    if (std::memcmp(stored.raw_data(),
+                    weight->raw_data(),
+                    weight->memory_size()) == 0) {
+      weight->ShareDataWith(stored);
+      return true;
+    }
+  }
+  Tensor stored;
+  stored.ShareDataWith(*weight);
+  weights_.emplace(key, stored);
+  return false;
+}
+
+size_t SharedWeightStore::ShareScope(Scope* scope,
+                                     const std::set<std::string>& excluded) {
+  CHECK(scope);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Prune();
+  }
+  size_t saved = 0;
+  for (auto& name : scope->LocalVarNames()) {
+    if (excluded.count(name)) continue;
+    auto* var = scope->FindLocalVar(name);
+    if (!var || !var->IsType<Tensor>()) continue;
+    auto* tensor = var->GetMutable<Tensor>();
+    if (!tensor->persistable()) continue;
+    if (Share(tensor)) saved += tensor->memory_size();
+  }
+  VLOG(1) << "Shared " << saved << " bytes of the weights, " << size()
+          << " unique weights are stored";
+  return saved;
+}
+
+size_t SharedWeightStore::size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Prune();
+  return weights_.size();
+}
+
+void SharedWeightStore::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  weights_.clear();
+}
+
+void SharedWeightStore::Prune() {
+  for (auto it = weights_.begin(); it != weights_.end();) {
+    if (it->second.IsBufferShared()) {
+      ++it;
+    } else {
+      it = weights_.erase(it);
+    }
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
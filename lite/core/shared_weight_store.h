@@ -0,0 +1,57 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <map>
+#include <mutex>  // NOLINT
+#include <set>
+#include <string>
+#include "lite/core/scope.h"
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+
+// The process-wide store of the weights loaded by the predictors, which are
+// addressed by the content, so the identical weights of different models,
+// e.g. the backbone shared by the fine-tuned heads, share one buffer. The
+// entries are keyed by the precision, the dims and the fingerprint of the
+// data, and compared by the data on hits, so different weights never share.
+// The weights no longer used by any predictor are released later.
+class SharedWeightStore {
+ public:
+  static SharedWeightStore& Global();
+
+  // Share the buffer of an identical weight stored before with `weight`, or
+  // store it. Only the initialized host tensors are shared. Returns whether
+  // the buffer of `weight` is replaced.
+  bool Share(Tensor* weight);
+  // Share all the persistable tensors in `scope` except the ones of
+  // `excluded`, returns the saved bytes.
+  size_t ShareScope(Scope* scope,
+                    const std::set<std::string>& excluded = {});
+  size_t size();
+  void Clear();
+
+ private:
+  SharedWeightStore() = default;
+  // Drop the weights which are not shared by any predictor.
+  void Prune();
+
+  std::multimap<std::string, Tensor> weights_;
+  std::mutex mutex_;
+};
+
+}  // namespace lite
+}  // namespace paddle
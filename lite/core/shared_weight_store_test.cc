@@ -0,0 +1,74 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/shared_weight_store.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+namespace paddle {
+namespace lite {
+
+Tensor* AddWeight(Scope* scope, const std::string& name, float value) {
+  auto* weight = scope->Var(name)->GetMutable<Tensor>();
+  weight->Resize({4, 8});
+  weight->set_persistable(true);
+  weight->set_precision(PRECISION(kFloat));
+  auto* data = weight->mutable_data<float>();
+  for (int i = 0; i < weight->numel(); i++) data[i] = value + i;
+  return weight;
+}
+
+TEST(SharedWeightStore, share_scopes) {
+  auto& store = SharedWeightStore::Global();
+  store.Clear();
+  std::unique_ptr<Scope> scope0(new Scope);
+  auto* w0 = AddWeight(scope0.get(), "backbone", 0.f);
+  auto* head0 = AddWeight(scope0.get(), "head", 1.f);
+  EXPECT_EQ(store.ShareScope(scope0.get()), 0u);
+  EXPECT_EQ(store.size(), 2u);
+
+  std::unique_ptr<Scope> scope1(new Scope);
+  auto* w1 = AddWeight(scope1.get(), "fc_w", 0.f);
+  auto* head1 = AddWeight(scope1.get(), "head", 2.f);
+  // The activations are never shared.
+  auto* act = AddWeight(scope1.get(), "act", 1.f);
+  act->set_persistable(false);
+  EXPECT_EQ(store.ShareScope(scope1.get()), w1->memory_size());
+  EXPECT_EQ(w1->raw_data(), w0->raw_data());
+  EXPECT_NE(head1->raw_data(), head0->raw_data());
+  EXPECT_NE(act->raw_data(), head0->raw_data());
+  EXPECT_EQ(store.size(), 3u);
+
+  // The weights are released with the scopes using them.
+  scope0.reset();
+  EXPECT_EQ(store.size(), 2u);
+  scope1.reset();
+  EXPECT_EQ(store.size(), 0u);
+}
+
+TEST(SharedWeightStore, excluded) {
+  auto& store = SharedWeightStore::Global();
+  store.Clear();
+  Scope scope0, scope1;
+  auto* w0 = AddWeight(&scope0, "w", 0.f);
+  auto* w1 = AddWeight(&scope1, "w", 0.f);
+  store.ShareScope(&scope0);
+  EXPECT_EQ(store.ShareScope(&scope1, {"w"}), 0u);
+  EXPECT_NE(w1->raw_data(), w0->raw_data());
+  store.Clear();
+}
+
+}  // namespace lite
+}  // namespace paddle
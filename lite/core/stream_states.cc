@@ -0,0 +1,79 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/stream_states.h"
+#include <utility>
+#include "lite/core/run_control.h"
+
+namespace paddle {
+namespace lite {
+
+void StreamStates::AddState(Tensor* input, Tensor* output) {
+  CHECK(input);
+  CHECK(output);
+  CHECK(input != output) << "The state input and output must be different";
+  State state;
+  state.input = input;
+  state.output = output;
+  state.initial.CopyDataFrom(*input);
+  states_.push_back(std::move(state));
+  streams_.clear();
+}
+
+void StreamStates::Reset(int64_t id) {
+  auto it = streams_.find(id);
+  if (it != streams_.end()) it->second.fresh = true;
+}
+
+void StreamStates::Apply() {
+  if (states_.empty()) return;
+  auto& stream = streams_[selected_];
+  auto& current = stream.buffers[stream.current];
+  auto& next = stream.buffers[1 - stream.current];
+  if (stream.fresh) {
+    current.resize(states_.size());
+    next.resize(states_.size());
+    for (size_t i = 0; i < states_.size(); i++) {
+      current[i].CopyDataFrom(states_[i].initial);
+    }
+    stream.fresh = false;
+  }
+  for (size_t i = 0; i < states_.size(); i++) {
+    states_[i].input->ShareDataWith(current[i]);
+    states_[i].output->ShareDataWith(next[i]);
+  }
+}
+
+void StreamStates::Sync() {
+  if (states_.empty()) return;
+  const RunControl* control = RunControl::Current();
+  if (control && control->stopped()) return;
+  auto& stream = streams_[selected_];
+  auto& next = stream.buffers[1 - stream.current];
+  for (size_t i = 0; i < states_.size(); i++) {
+    auto* output = states_[i].output;
+    if (output->raw_data() == next[i].raw_data()) {
+      next[i].ShareDataWith(*output);
+    } else {
+      // The output lives in the memory of another variable, which may be
+      // overwritten by the next run.
+      next[i].CopyDataFrom(*output);
+      output->ShareDataWith(next[i]);
+    }
+  }
+  stream.current = 1 - stream.current;
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,81 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+
+// The states of the streams fed in chunks, e.g. the left contexts of the
+// convs and the hidden states of the rnns of a streaming ASR model, which are
+// the state outputs of a run fed to the state inputs of the next run of the
+// same stream. Every stream keeps two buffers for each state, bound to the
+// state input and output of a run alternately, so the states are carried
+// across the runs without copies.
+class StreamStates {
+ public:
+  // Declare the state `input` fed by `output` of the previous run of the
+  // stream. The initial state of the streams is copied from the current
+  // content of `input`. The states of all the streams are dropped.
+  void AddState(Tensor* input, Tensor* output);
+  // Drop all the states and streams.
+  void Clear() {
+    states_.clear();
+    streams_.clear();
+    selected_ = 0;
+  }
+
+  // Select the stream `id` for the following runs, which is created with the
+  // initial states on the first run.
+  void Select(int64_t id) { selected_ = id; }
+  // Restore the initial states of the stream `id`, its buffers are kept.
+  void Reset(int64_t id);
+  // Drop the stream `id` and its buffers.
+  void Release(int64_t id) { streams_.erase(id); }
+
+  // Point the states of the selected stream to the inputs and outputs,
+  // called before each run.
+  void Apply();
+  // Keep the outputs as the states of the next run, which are copied only if
+  // the outputs are not written in place, called after each run. The states
+  // are unchanged by a stopped run, see RunControl.
+  void Sync();
+
+  bool empty() const { return states_.empty(); }
+
+ private:
+  struct State {
+    Tensor* input{nullptr};
+    Tensor* output{nullptr};
+    Tensor initial;
+  };
+  struct Stream {
+    // The two buffers of each state.
+    std::vector<Tensor> buffers[2];
+    // The index of the buffers holding the states of the next run.
+    int current{0};
+    bool fresh{true};
+  };
+
+  std::vector<State> states_;
+  std::map<int64_t, Stream> streams_;
+  int64_t selected_{0};
+};
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,103 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/stream_states.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+// A run of the model which adds one to the state.
+static void RunStep(StreamStates* states, Tensor* input, Tensor* output) {
+  states->Apply();
+  output->Resize(input->dims());
+  auto* out = output->mutable_data<float>();
+  const auto* in = input->data<float>();
+  for (int64_t i = 0; i < input->numel(); i++) out[i] = in[i] + 1.f;
+  states->Sync();
+}
+
+TEST(StreamStates, carried_in_place) {
+  Tensor input;
+  Tensor output;
+  input.Resize({2});
+  auto* init = input.mutable_data<float>();
+  init[0] = 0.f;
+  init[1] = 10.f;
+  StreamStates states;
+  states.AddState(&input, &output);
+
+  RunStep(&states, &input, &output);
+  const void* first = output.raw_data();
+  RunStep(&states, &input, &output);
+  // The two buffers of the stream are swapped without copies.
+  EXPECT_EQ(input.raw_data(), first);
+  EXPECT_NE(output.raw_data(), first);
+  RunStep(&states, &input, &output);
+  EXPECT_EQ(output.raw_data(), first);
+  EXPECT_EQ(output.data<float>()[0], 3.f);
+  EXPECT_EQ(output.data<float>()[1], 13.f);
+}
+
+TEST(StreamStates, many_streams) {
+  Tensor input;
+  Tensor output;
+  input.Resize({1});
+  input.mutable_data<float>()[0] = 0.f;
+  StreamStates states;
+  states.AddState(&input, &output);
+
+  states.Select(1);
+  RunStep(&states, &input, &output);
+  RunStep(&states, &input, &output);
+  states.Select(2);
+  RunStep(&states, &input, &output);
+  EXPECT_EQ(output.data<float>()[0], 1.f);
+  states.Select(1);
+  RunStep(&states, &input, &output);
+  EXPECT_EQ(output.data<float>()[0], 3.f);
+
+  // A reset or released stream restarts from the initial states.
+  states.Reset(1);
+  RunStep(&states, &input, &output);
+  EXPECT_EQ(output.data<float>()[0], 1.f);
+  states.Release(2);
+  states.Select(2);
+  RunStep(&states, &input, &output);
+  EXPECT_EQ(output.data<float>()[0], 1.f);
+}
+
+TEST(StreamStates, output_shared) {
+  Tensor input;
+  Tensor output;
+  Tensor other;
+  input.Resize({1});
+  input.mutable_data<float>()[0] = 5.f;
+  StreamStates states;
+  states.AddState(&input, &output);
+
+  states.Apply();
+  // The output lives in the memory of another variable.
+  other.Resize({1});
+  other.mutable_data<float>()[0] = 6.f;
+  output.ShareDataWith(other);
+  states.Sync();
+  other.mutable_data<float>()[0] = 0.f;
+  states.Apply();
+  EXPECT_EQ(input.data<float>()[0], 6.f);
+}
+
+}  // namespace lite
+}  // namespace paddle
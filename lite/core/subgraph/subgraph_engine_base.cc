@@ -17,6 +17,7 @@
 #include <time.h>
 #include <algorithm>
 #include <utility>
+#include "lite/utils/env.h"
 
 namespace paddle {
 namespace lite {
@@ -41,28 +42,94 @@ SubgraphEngineBase::SubgraphEngineBase(
   // at each call of the subgraph pass.
   std::stable_sort(input_names_.begin(), input_names_.end());
   std::stable_sort(output_names_.begin(), output_names_.end());
+  max_device_programs_ = std::max(
+      GetIntFromEnv(SUBGRAPH_DEVICE_PROGRAM_CACHE_SIZE, 8), 1);
 }
 
-bool SubgraphEngineBase::Run() {
+SubgraphEngineBase::~SubgraphEngineBase() {
+  if (!launch_thread_.joinable()) return;
+  {
+    std::unique_lock<std::mutex> lock(launch_mutex_);
+    launch_cv_.wait(lock, [this] { return !launch_pending_; });
+    stop_ = true;
+  }
+  launch_cv_.notify_all();
+  launch_thread_.join();
+}
+
+bool SubgraphEngineBase::Run() { return Launch(false) && Wait(); }
+
+bool SubgraphEngineBase::Launch(bool async) {
   if (is_first_epoch_) {
     PrepareWorkspaceForDeviceProgram();
     is_first_epoch_ = false;
   }
   if (InputShapeChanged()) {
-    BuildDeviceProgram();
+    UpdateDeviceProgram();
+  }
+  if (!async) {
+    launch_status_ = LaunchDeviceProgram();
+    return true;
+  }
+  if (!launch_thread_.joinable()) {
+    launch_thread_ = std::thread(&SubgraphEngineBase::LaunchLoop, this);
+  }
+  {
+    std::lock_guard<std::mutex> lock(launch_mutex_);
+    CHECK(!launch_pending_) << "The last launch is not waited.";
+    launch_pending_ = true;
   }
-  return LaunchDeviceProgram();
+  launch_cv_.notify_all();
+  return true;
+}
+
+bool SubgraphEngineBase::Wait() {
+  std::unique_lock<std::mutex> lock(launch_mutex_);
+  launch_cv_.wait(lock, [this] { return !launch_pending_; });
+  return launch_status_;
+}
+
+void SubgraphEngineBase::LaunchLoop() {
+  std::unique_lock<std::mutex> lock(launch_mutex_);
+  while (true) {
+    launch_cv_.wait(lock, [this] { return launch_pending_ || stop_; });
+    if (stop_) break;
+    lock.unlock();
+    bool status = LaunchDeviceProgram();
+    lock.lock();
+    launch_status_ = status;
+    launch_pending_ = false;
+    launch_cv_.notify_all();
+  }
+}
+
+bool SubgraphEngineBase::UpdateDeviceProgram() {
+  auto it = std::find(device_program_idims_.begin(),
+                      device_program_idims_.end(),
+                      origin_idims_);
+  if (it != device_program_idims_.end()) {
+    device_program_idims_.splice(
+        device_program_idims_.begin(), device_program_idims_, it);
+    return SwitchDeviceProgram();
+  }
+  if (!BuildDeviceProgram()) return false;
+  device_program_idims_.push_front(origin_idims_);
+  while (device_program_idims_.size() > max_device_programs_) {
+    ReleaseDeviceProgram(device_program_idims_.back());
+    device_program_idims_.pop_back();
+  }
+  return true;
 }
 
 bool SubgraphEngineBase::PrepareWorkspaceForOriginProgram() {
   origin_idims_.resize(input_names_.size());
   origin_itensors_.resize(input_names_.size());
-  for (int i = 0; i < input_names_.size(); i++) {
+  for (size_t i = 0; i < input_names_.size(); i++) {
     origin_itensors_[i] = exec_scope_->FindMutableTensor(input_names_[i]);
     CHECK(origin_itensors_[i]);
   }
   origin_otensors_.resize(output_names_.size());
-  for (int i = 0; i < output_names_.size(); i++) {
+  for (size_t i = 0; i < output_names_.size(); i++) {
     origin_otensors_[i] = exec_scope_->FindMutableTensor(output_names_[i]);
     CHECK(origin_otensors_[i]);
   }
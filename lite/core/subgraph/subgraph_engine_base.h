@@ -14,9 +14,13 @@
 
 #pragma once
 
+#include <condition_variable>  // NOLINT
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
+#include <thread>  // NOLINT
 #include <vector>
 #include "lite/core/op_lite.h"
 #include "lite/core/program.h"
@@ -35,9 +39,15 @@ class SubgraphEngineBase {
       Scope *exec_scope,
       const std::vector<std::string> &input_names,
       const std::vector<std::string> &output_names);
-  virtual ~SubgraphEngineBase() = default;
+  virtual ~SubgraphEngineBase();
 
   virtual bool Run();
+  // Run split into two halves, so the runtime can run the host ops between
+  // them. Launch prepares the device program for the current input shapes,
+  // then runs it on the launch thread of the engine if `async`, or right away
+  // otherwise. Wait returns after it finishes with the result of the run.
+  bool Launch(bool async);
+  bool Wait();
 
  private:
   SubgraphEngineBase(const SubgraphEngineBase &) = delete;
@@ -53,6 +63,14 @@ class SubgraphEngineBase {
 
   virtual bool InputShapeChanged();
 
+  // Reuse the device program built before for the current input shapes, only
+  // rebuild it by default. Override it with ReleaseDeviceProgram to keep the
+  // device programs of the different shapes.
+  virtual bool SwitchDeviceProgram() { return BuildDeviceProgram(); }
+  // Release the device program of the input shapes evicted from the cache.
+  virtual void ReleaseDeviceProgram(
+      const std::vector<std::vector<int64_t>> &idims) {}
+
   KernelContext *ctx_{nullptr};
   int block_idx_{-1};
   const std::shared_ptr<const cpp::ProgramDesc> program_desc_{nullptr};
@@ -64,6 +82,22 @@ class SubgraphEngineBase {
   std::vector<Tensor *> origin_itensors_;
   std::vector<Tensor *> origin_otensors_;
   std::unique_ptr<RuntimeProgram> origin_program_{nullptr};
+
+ private:
+  bool UpdateDeviceProgram();
+  void LaunchLoop();
+
+  // The input shapes of the device programs built, the most recently used
+  // first.
+  std::list<std::vector<std::vector<int64_t>>> device_program_idims_;
+  size_t max_device_programs_{8};
+  // The launch thread is started by the first async launch.
+  std::thread launch_thread_;
+  std::mutex launch_mutex_;
+  std::condition_variable launch_cv_;
+  bool launch_pending_{false};
+  bool launch_status_{true};
+  bool stop_{false};
 };
 
 }  // namespace subgraph
@@ -0,0 +1,105 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/subgraph/subgraph_engine_base.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <set>
+#include <thread>  // NOLINT
+
+namespace paddle {
+namespace lite {
+namespace subgraph {
+
+// Counts the device programs built, switched and released for each of the
+// input shapes instead of building them.
+class FakeEngine : public SubgraphEngineBase {
+ public:
+  explicit FakeEngine(Scope* scope)
+      : SubgraphEngineBase(nullptr, 0, nullptr, scope, {"x"}, {"y"}) {}
+
+  int builds{0};
+  int switches{0};
+  std::set<std::vector<std::vector<int64_t>>> programs;
+  std::atomic<int> launches{0};
+  std::atomic<bool> block{false};
+
+ protected:
+  bool BuildDeviceProgram() override {
+    builds++;
+    programs.insert(origin_idims_);
+    return true;
+  }
+  bool SwitchDeviceProgram() override {
+    switches++;
+    return programs.count(origin_idims_) > 0;
+  }
+  void ReleaseDeviceProgram(
+      const std::vector<std::vector<int64_t>>& idims) override {
+    programs.erase(idims);
+  }
+  bool LaunchDeviceProgram() override {
+    while (block) std::this_thread::yield();
+    launches++;
+    return true;
+  }
+};
+
+TEST(SubgraphEngineBase, device_program_cache) {
+  setenv(SUBGRAPH_DEVICE_PROGRAM_CACHE_SIZE, "2", 1);
+  Scope scope;
+  auto* x = scope.NewTensor("x");
+  scope.NewTensor("y");
+  FakeEngine engine(&scope);
+  for (int64_t batch : {1, 2, 1, 2, 1}) {
+    x->Resize({batch, 8});
+    EXPECT_TRUE(engine.Run());
+  }
+  // The shapes alternating between two are built once each.
+  EXPECT_EQ(engine.builds, 2);
+  EXPECT_EQ(engine.switches, 3);
+  // The least recently used {2, 8} is released by {4, 8}.
+  x->Resize({4, 8});
+  EXPECT_TRUE(engine.Run());
+  EXPECT_EQ(engine.programs.size(), 2u);
+  EXPECT_EQ(engine.programs.count({{2, 8}}), 0u);
+  x->Resize({2, 8});
+  EXPECT_TRUE(engine.Run());
+  EXPECT_EQ(engine.builds, 4);
+  EXPECT_EQ(engine.launches, 7);
+  unsetenv(SUBGRAPH_DEVICE_PROGRAM_CACHE_SIZE);
+}
+
+TEST(SubgraphEngineBase, async_launch) {
+  Scope scope;
+  scope.NewTensor("x")->Resize({1, 8});
+  scope.NewTensor("y");
+  FakeEngine engine(&scope);
+  for (int i = 0; i < 3; i++) {
+    engine.block = true;
+    EXPECT_TRUE(engine.Launch(true));
+    // The launch runs on the other thread, the caller goes on meanwhile.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(engine.launches, i);
+    engine.block = false;
+    EXPECT_TRUE(engine.Wait());
+    EXPECT_EQ(engine.launches, i + 1);
+  }
+  EXPECT_EQ(engine.builds, 1);
+}
+
+}  // namespace subgraph
+}  // namespace lite
+}  // namespace paddle
@@ -29,6 +29,31 @@ void TensorLite::ShareDataWith(const TensorLite &other) {
   memory_size_ = other.memory_size_;
   precision_ = other.precision_;
   offset_ = other.offset_;
+  view_size_ = other.view_size_;
+}
+
+void TensorLite::ShareBufferWith(const TensorLite &other,
+                                 size_t offset,
+                                 size_t memory_size) {
+  // There is nothing to share for an empty view.
+  if (memory_size == 0) {
+    DetachBuffer();
+    return;
+  }
+  CHECK_LE(offset + memory_size, other.buffer_->space())
+      << "The view is out of the buffer.";
+  buffer_ = other.buffer_;
+  target_ = other.target_;
+  precision_ = other.precision_;
+  memory_size_ = memory_size;
+  offset_ = offset;
+  view_size_ = memory_size;
+}
+
+void TensorLite::DetachBuffer() {
+  buffer_ = std::make_shared<Buffer>();
+  offset_ = 0;
+  view_size_ = 0;
 }
 
 void TensorLite::CopyDataFrom(const TensorLite &other) {
@@ -38,13 +63,15 @@ void TensorLite::CopyDataFrom(const TensorLite &other) {
   memory_size_ = other.memory_size_;
   precision_ = other.precision_;
   persistable_ = other.persistable_;
+  if (view_size_ > 0) DetachBuffer();
   buffer_->CopyDataFrom(*other.buffer_, memory_size_);
 }
 
 void *TensorLite::mutable_data(size_t memory_size) {
   memory_size_ = memory_size;
+  DetachOutgrownView(target_);
   buffer_->ResetLazy(target_, memory_size_);
-  return buffer_->data();
+  return static_cast<char *>(buffer_->data()) + offset_;
 }
 
 void *TensorLite::mutable_data(TargetType target, size_t memory_size) {
@@ -59,7 +86,8 @@ void *TensorLite::mutable_data(TargetType target, size_t memory_size) {
 
 void TensorLite::ResetBuffer(std::shared_ptr<Buffer> buffer,
                              size_t memory_size) {
-  CHECK_EQ(offset_, 0u)
+  // A view is moved out of the shared buffer as a whole.
+  CHECK(offset_ == 0u || view_size_ > 0)
       << "Only the offset is supported to zero when the Buffer is reset.";
   if (buffer_) {
     CHECK_LE(memory_size_, buffer->space())
@@ -70,6 +98,18 @@ void TensorLite::ResetBuffer(std::shared_ptr<Buffer> buffer,
   buffer_ = buffer;
   memory_size_ = memory_size;
   target_ = buffer->target();
+  offset_ = 0;
+  view_size_ = 0;
+}
+
+void TensorLite::ShareExternalMemory(void *data,
+                                     size_t memory_size,
+                                     TargetType target) {
+  buffer_ = std::make_shared<Buffer>(data, target, memory_size);
+  target_ = target;
+  memory_size_ = memory_size;
+  offset_ = 0;
+  view_size_ = 0;
 }
 
 #ifdef LITE_WITH_OPENCL
@@ -96,6 +96,7 @@ class TensorLite {
   R *mutable_data() {
     precision_ = lite_api::PrecisionTypeTrait<T>::Type();
     memory_size_ = dims_.production() * sizeof(T);
+    DetachOutgrownView(target_);
     buffer_->ResetLazy(target_, memory_size_);
     return reinterpret_cast<R *>(static_cast<char *>(buffer_->data()) +
                                  offset_);
@@ -190,6 +191,7 @@ class TensorLite {
 #endif
     precision_ = lite_api::PrecisionTypeTrait<T>::Type();
     memory_size_ = memory_size;
+    DetachOutgrownView(target);
     buffer_->ResetLazy(target, memory_size_);
     target_ = target;
     return reinterpret_cast<R *>(static_cast<char *>(buffer_->data()) +
@@ -210,6 +212,10 @@ class TensorLite {
   }
 
   void clear() {
+    if (view_size_ > 0) {
+      DetachBuffer();
+      return;
+    }
     buffer_->Free();
     offset_ = 0;
   }
@@ -221,13 +227,36 @@ class TensorLite {
 
   bool IsInitialized() const { return buffer_->data(); }
 
+  // Whether the buffer is shared with the other tensors.
+  bool IsBufferShared() const { return buffer_.use_count() > 1; }
+  const Buffer *buffer() const { return buffer_.get(); }
+
   // Other share data to this.
   void ShareDataWith(const TensorLite &other);
 
+  // Make this tensor a view of `memory_size` bytes at `offset` bytes into the
+  // buffer of other, e.g. an input of concat living in a slice of its output.
+  // A view asked for more memory than it covers is moved to a buffer of its
+  // own instead of growing the shared one.
+  void ShareBufferWith(const TensorLite &other,
+                       size_t offset,
+                       size_t memory_size);
+  bool IsView() const { return view_size_ > 0; }
+  bool IsViewOf(const TensorLite &other, size_t offset) const {
+    return view_size_ > 0 && buffer_ == other.buffer_ && offset_ == offset;
+  }
+  size_t view_size() const { return view_size_; }
+  // Move to an empty buffer of its own, the shared one is left untouched.
+  void DetachBuffer();
+
   void CopyDataFrom(const TensorLite &other);
 
   void ResetBuffer(std::shared_ptr<Buffer> buffer, size_t memory_size);
 
+  // Point to the external memory which is not owned by the tensor, the
+  // previous buffer is released if it is not shared with others.
+  void ShareExternalMemory(void *data, size_t memory_size, TargetType target);
+
   TargetType target() const { return target_; }
   void set_target(TargetType target) { target_ = target; }
 
@@ -245,6 +274,14 @@ class TensorLite {
   }
 
  private:
+  // A view is moved out before the shared buffer would be reallocated.
+  void DetachOutgrownView(TargetType target) {
+    if (view_size_ > 0 &&
+        (memory_size_ > view_size_ || target != buffer_->target())) {
+      DetachBuffer();
+    }
+  }
+
   TargetType target_{TargetType::kHost};
   // precision_ and persistable_ are only used for persistable vars.
   // If your tensor wants to be saved and loaded correctly, you must
@@ -261,6 +298,8 @@ class TensorLite {
 
   /// @brief Buffer may be shared with other tensors
   size_t offset_{0};
+  // The bytes covered by a view made by ShareBufferWith, 0 for the others.
+  size_t view_size_{0};
 };
 
 template <typename T>
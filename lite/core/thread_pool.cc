@@ -14,21 +14,74 @@
 
 #include "lite/core/thread_pool.h"
 #include <string.h>
+#include <algorithm>
+#include <map>
+#include "lite/core/runtime_stats.h"
 #include "lite/utils/log/logging.h"
+#include "lite/utils/macros.h"
+#if (defined LITE_WITH_ARM) && (defined LITE_WITH_LINUX)
+#include "lite/core/device_info.h"
+#elif (defined LITE_WITH_X86) && (defined __linux__)
+#include <sched.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace paddle {
 namespace lite {
 
+namespace {
+// The number of polling rounds before an idle worker parks itself.
+constexpr int kSpinCount = 2000;
+// Each thread owns about kChunksPerThread chunks at the begining, which leaves
+// enough granularity for the idle threads to steal from the busy ones.
+constexpr int kChunksPerThread = 8;
+// A work range is packed as | tag: 16 | begin: 24 | end: 24 |, `tag` is bumped
+// every time a thief refills its own range to avoid the ABA problem.
+constexpr int kRangeBits = 24;
+constexpr uint64_t kRangeMask = (1ULL << kRangeBits) - 1;
+// The most threads whose work is split by their capacities, the others are
+// split evenly.
+constexpr int kMaxSplitThreads = 64;
+
+inline uint64_t PackRange(uint64_t tag, int begin, int end) {
+  return ((tag & 0xFFFF) << (2 * kRangeBits)) |
+         ((static_cast<uint64_t>(begin) & kRangeMask) << kRangeBits) |
+         (static_cast<uint64_t>(end) & kRangeMask);
+}
+inline uint64_t RangeTag(uint64_t range) { return range >> (2 * kRangeBits); }
+inline int RangeBegin(uint64_t range) {
+  return static_cast<int>((range >> kRangeBits) & kRangeMask);
+}
+inline int RangeEnd(uint64_t range) {
+  return static_cast<int>(range & kRangeMask);
+}
+inline uint64_t JobEpoch(uint64_t job) { return job >> 32; }
+inline int JobThreads(uint64_t job) {
+  return static_cast<int>(job & 0xFFFFFFFF);
+}
+
+// The index of the pool thread running on, -1 means outside of the pool.
+// Nested parallel regions are executed serially in the calling thread.
+LITE_THREAD_LOCAL int gThreadIndex = -1;
+// The thread pool bound to the current thread by ThreadPoolGuard.
+LITE_THREAD_LOCAL ThreadPool* gCurrent = nullptr;
+// The most threads of the parallel regions issued by the current thread, 0
+// means all of them.
+LITE_THREAD_LOCAL int gActiveThreads = 0;
+}  // namespace
+
 ThreadPool* ThreadPool::gInstance = nullptr;
 static std::mutex gInitMutex;  // confirm thread-safe when use singleton mode
-int ThreadPool::Init(int number) {
+int ThreadPool::Init(int number, ThreadPoolMode mode) {
   // Don't instantiate ThreadPool when compile ThreadPool and only use 1 thread
   if (number <= 1) {
     return 1;
   }
   std::lock_guard<std::mutex> _l(gInitMutex);
   if (nullptr == gInstance) {
-    gInstance = new ThreadPool(number);
+    gInstance = new ThreadPool(number, mode);
   }
   return gInstance->thread_num_;
 }
@@ -40,32 +93,276 @@ void ThreadPool::Destroy() {
   }
 }
 
-ThreadPool::ThreadPool(int number) {
-  thread_num_ = number;
-  for (int i = 0; i < thread_num_; ++i) {
-    tasks_.second.emplace_back(new std::atomic<bool>{false});
+std::shared_ptr<ThreadPool> ThreadPool::Create(int number,
+                                               ThreadPoolMode mode,
+                                               const std::string& shared_key) {
+  if (number <= 1) {
+    return nullptr;
+  }
+  if (shared_key.empty()) {
+    return std::make_shared<ThreadPool>(number, mode);
+  }
+  static std::map<std::string, std::weak_ptr<ThreadPool>> shared_pools;
+  std::lock_guard<std::mutex> _l(gInitMutex);
+  auto pool = shared_pools[shared_key].lock();
+  if (!pool) {
+    pool = std::make_shared<ThreadPool>(number, mode);
+    shared_pools[shared_key] = pool;
+  }
+  return pool;
+}
+
+ThreadPool* ThreadPool::Current() {
+  return gCurrent != nullptr ? gCurrent : gInstance;
+}
+
+ThreadPool* ThreadPool::SetCurrent(ThreadPool* pool) {
+  ThreadPool* prev = gCurrent;
+  gCurrent = pool;
+  return prev;
+}
+
+int ThreadPool::ActiveThreads() const {
+  return gActiveThreads > 0 ? std::min(gActiveThreads, thread_num_)
+                            : thread_num_;
+}
+
+void ThreadPool::SetAffinity(const std::vector<int>& cpu_ids) {
+  std::lock_guard<std::mutex> _l(affinity_mutex_);
+  if (cpu_ids != cpu_ids_) {
+    cpu_ids_ = cpu_ids;
+    affinity_version_++;
+  }
+}
+
+void ThreadPool::SetCapacity(const std::vector<int>& capacities) {
+  std::lock_guard<std::mutex> _l(run_mutex_);
+  capacities_.clear();
+  if (std::all_of(capacities.begin(), capacities.end(), [](int c) {
+        return c > 0;
+      })) {
+    capacities_ = capacities;
+  }
+}
+
+void ThreadPool::SetActiveThreads(int number) {
+  gActiveThreads = std::max(number, 0);
+}
+
+void ThreadPool::ApplyAffinity(int thread_index, int* version) {
+  int latest = affinity_version_.load(std::memory_order_acquire);
+  if (latest == *version) {
+    return;
+  }
+  *version = latest;
+  std::vector<int> cpu_ids;
+  {
+    std::lock_guard<std::mutex> _l(affinity_mutex_);
+    cpu_ids = cpu_ids_;
+  }
+  if (cpu_ids.empty()) {
+    return;
   }
+#if (defined LITE_WITH_ARM) && (defined LITE_WITH_LINUX)
+  int cpu_id = cpu_ids[thread_index % cpu_ids.size()];
+  if (set_sched_affinity({cpu_id}) != 0) {
+    LOG(WARNING) << "Set cpu affinity failed, core id: " << cpu_id;
+  }
+#elif (defined LITE_WITH_X86) && (defined __linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (auto cpu_id : cpu_ids) {
+    CPU_SET(cpu_id, &mask);
+  }
+  if (sched_setaffinity(0, sizeof(mask), &mask) != 0) {
+    LOG(WARNING) << "Set cpu affinity failed, worker: " << thread_index;
+  }
+#endif
+}
+
+ThreadPool::ThreadPool(int number, ThreadPoolMode mode) {
+  thread_num_ = number;
+  mode_ = mode;
+  ranges_.reset(new WorkRange[thread_num_]);
+  if (mode_ == ThreadPoolMode::kOpenMP) return;
   for (int thread_index = 1; thread_index < thread_num_; ++thread_index) {
-    workers_.emplace_back([this, thread_index]() {
-      while (!stop_) {
-        // if (*tasks_.second[thread_index]) {
-        while (!(*tasks_.second[thread_index])) {
-          std::this_thread::yield();
-        }
-        tasks_.first(thread_index, thread_index);
-        *tasks_.second[thread_index] = false;
-      }
-    });
+    workers_.emplace_back([this, thread_index]() { WorkerLoop(thread_index); });
   }
 }
 
 ThreadPool::~ThreadPool() {
   stop_ = true;
+  {
+    std::lock_guard<std::mutex> _l(park_mutex_);
+    park_cv_.notify_all();
+  }
   for (auto& worker : workers_) {
     worker.join();
   }
-  for (auto c : tasks_.second) {
-    delete c;
+}
+
+void ThreadPool::WorkerLoop(int thread_index) {
+  gThreadIndex = thread_index;
+  uint64_t seen = 0;
+  int affinity_version = 0;
+  auto& stats = RuntimeStats::Global();
+  auto idle_start_ns = MonotonicNanos();
+  while (true) {
+    uint64_t job = job_.load();
+    for (int i = 0; job == seen && !stop_; ++i) {
+      if (mode_ == ThreadPoolMode::kPark && i >= kSpinCount) {
+        std::unique_lock<std::mutex> _l(park_mutex_);
+        sleeping_.fetch_add(1);
+        park_cv_.wait(_l, [&]() { return stop_ || job_.load() != seen; });
+        sleeping_.fetch_sub(1);
+      } else {
+        std::this_thread::yield();
+      }
+      job = job_.load();
+    }
+    if (stop_) {
+      return;
+    }
+    seen = job;
+    if (thread_index < JobThreads(job)) {
+      auto busy_start_ns = MonotonicNanos();
+      stats.thread_pool_idle_ns.Add(busy_start_ns - idle_start_ns);
+      ApplyAffinity(thread_index, &affinity_version);
+      Execute(thread_index);
+      pending_.fetch_sub(1, std::memory_order_acq_rel);
+      idle_start_ns = MonotonicNanos();
+      stats.thread_pool_busy_ns.Add(idle_start_ns - busy_start_ns);
+    }
+  }
+}
+
+bool ThreadPool::PopFront(int thread_index, int* begin, int* end) {
+  auto& range = ranges_[thread_index].range;
+  uint64_t old = range.load(std::memory_order_acquire);
+  while (RangeBegin(old) < RangeEnd(old)) {
+    int chunk = RangeBegin(old);
+    if (range.compare_exchange_weak(
+            old, PackRange(RangeTag(old), chunk + 1, RangeEnd(old)))) {
+      *begin = chunk;
+      *end = chunk + 1;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ThreadPool::Steal(int thread_index) {
+  int active = JobThreads(job_.load(std::memory_order_relaxed));
+  for (int k = 1; k < active; ++k) {
+    auto& victim = ranges_[(thread_index + k) % active].range;
+    uint64_t old = victim.load(std::memory_order_acquire);
+    while (RangeBegin(old) < RangeEnd(old)) {
+      int begin = RangeBegin(old);
+      int end = RangeEnd(old);
+      // Steal the back half, the victim keeps the front half.
+      int mid = begin + (end - begin) / 2;
+      if (victim.compare_exchange_weak(
+              old, PackRange(RangeTag(old), begin, mid))) {
+        auto& own = ranges_[thread_index].range;
+        uint64_t tag = RangeTag(own.load(std::memory_order_relaxed)) + 1;
+        own.store(PackRange(tag, mid, end), std::memory_order_release);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void ThreadPool::Execute(int thread_index) {
+  const TASK& func = *func_;
+  const int grain = grain_;
+  const int work_size = work_size_;
+  int begin = 0;
+  int end = 0;
+  do {
+    while (PopFront(thread_index, &begin, &end)) {
+      int last = std::min(end * grain, work_size);
+      for (int i = begin * grain; i < last; ++i) {
+        func(i, thread_index);
+      }
+    }
+  } while (Steal(thread_index));
+}
+
+void ThreadPool::RunOpenMP(const TASK& func, int work_size, int grain) {
+#ifdef _OPENMP
+  int chunks = (work_size + grain - 1) / grain;
+  int active = std::min(ActiveThreads(), chunks);
+#pragma omp parallel num_threads(active)
+  {
+    int tid = omp_get_thread_num();
+    int threads = omp_get_num_threads();
+    int64_t first = static_cast<int64_t>(chunks) * tid / threads;
+    int64_t last = static_cast<int64_t>(chunks) * (tid + 1) / threads;
+    int begin = static_cast<int>(first * grain);
+    int end = static_cast<int>(std::min<int64_t>(last * grain, work_size));
+    int prev_index = gThreadIndex;
+    gThreadIndex = tid;
+    for (int i = begin; i < end; ++i) {
+      func(i, tid);
+    }
+    gThreadIndex = prev_index;
+  }
+#else
+  int prev_index = gThreadIndex;
+  gThreadIndex = 0;
+  for (int i = 0; i < work_size; ++i) {
+    func(i, 0);
+  }
+  gThreadIndex = prev_index;
+#endif
+}
+
+void ThreadPool::Run(const TASK& func, int work_size, int grain) {
+  std::lock_guard<std::mutex> _l(run_mutex_);
+  grain = std::max(grain, 1);
+  if (mode_ == ThreadPoolMode::kOpenMP) {
+    RunOpenMP(func, work_size, grain);
+    return;
+  }
+  int active = std::min(ActiveThreads(), (work_size + grain - 1) / grain);
+  grain = std::max(grain, work_size / (active * kChunksPerThread));
+  int chunks = (work_size + grain - 1) / grain;
+  // Split the chunks in proportion to the capacities of the threads.
+  bool weighted = !capacities_.empty() && active <= kMaxSplitThreads;
+  int64_t prefix[kMaxSplitThreads + 1] = {0};
+  for (int t = 0; weighted && t < active; ++t) {
+    prefix[t + 1] = prefix[t] + capacities_[t % capacities_.size()];
+  }
+  for (int t = 0; t < active; ++t) {
+    int begin = static_cast<int64_t>(chunks) * t / active;
+    int end = static_cast<int64_t>(chunks) * (t + 1) / active;
+    if (weighted) {
+      begin = chunks * prefix[t] / prefix[active];
+      end = chunks * prefix[t + 1] / prefix[active];
+    }
+    uint64_t tag = RangeTag(ranges_[t].range.load(std::memory_order_relaxed));
+    ranges_[t].range.store(PackRange(tag + 1, begin, end),
+                           std::memory_order_relaxed);
+  }
+  func_ = &func;
+  grain_ = grain;
+  work_size_ = work_size;
+  pending_.store(active - 1, std::memory_order_relaxed);
+  uint64_t epoch = JobEpoch(job_.load()) + 1;
+  job_.store((epoch << 32) | static_cast<uint64_t>(active));
+  if (sleeping_.load() > 0) {
+    std::lock_guard<std::mutex> _l(park_mutex_);
+    park_cv_.notify_all();
+  }
+  // invoke tid 0 callback in main thread
+  // other tid task is invoked in child thread
+  gThreadIndex = 0;
+  Execute(0);
+  gThreadIndex = -1;
+  // check tid 1 to thread_num - 1 all work completed in child thread
+  while (pending_.load(std::memory_order_acquire) > 0) {
+    std::this_thread::yield();
   }
 }
 
@@ -91,41 +388,15 @@ void ThreadPool::ReleaseThreadPool() {
 }
 
 void ThreadPool::Enqueue(TASK_BASIC&& task) {
-  if (task.second <= 1 || (nullptr == gInstance)) {
+  ThreadPool* pool = Current();
+  if (task.second <= 1 || (nullptr == pool) || gThreadIndex >= 0) {
+    int tid = std::max(gThreadIndex, 0);
     for (int i = 0; i < task.second; ++i) {
-      task.first(i, 0);
+      task.first(i, tid);
     }
     return;
   }
-  int work_size = task.second;
-  if (work_size > gInstance->thread_num_) {
-    gInstance->tasks_.first = [work_size, &task](int index, int tId) {
-      for (int v = tId; v < work_size; v += gInstance->thread_num_) {
-        task.first(v, tId);  // nested lambda func
-      }
-    };
-    work_size = gInstance->thread_num_;
-  } else {
-    gInstance->tasks_.first = std::move(task.first);
-  }
-  for (int i = 1; i < work_size; ++i) {
-    *(gInstance->tasks_.second[i]) = true;
-  }
-  // invoke tid 0 callback in main thread
-  // other tid task is invoked in child thread
-  gInstance->tasks_.first(0, 0);
-  bool complete = true;
-  // check tid 1 to thread_num - 1 all work completed in child thread
-  do {
-    std::this_thread::yield();
-    complete = true;
-    for (int i = 1; i < work_size; ++i) {
-      if (*gInstance->tasks_.second[i]) {
-        complete = false;
-        break;
-      }
-    }
-  } while (!complete);
+  pool->Run(task.first, task.second);
 }
 
 void ThreadPool::Enqueue(TASK_COMMON&& task) {
@@ -133,45 +404,91 @@ void ThreadPool::Enqueue(TASK_COMMON&& task) {
   int start = std::get<2>(task);
   int step = std::get<3>(task);
   int work_size = (end - start + step - 1) / step;
-  if (work_size <= 1 || (nullptr == gInstance)) {
+  ThreadPool* pool = Current();
+  if (work_size <= 1 || (nullptr == pool) || gThreadIndex >= 0) {
+    int tid = std::max(gThreadIndex, 0);
     for (int v = start; v < end; v += step) {
-      std::get<0>(task)(v, 0);
+      std::get<0>(task)(v, tid);
     }
     return;
   }
-  if (work_size > gInstance->thread_num_) {
-    gInstance->tasks_.first = ([=, &task](int index, int tId) {
-      auto start_index = start + tId * step;
-      auto stride = gInstance->thread_num_ * step;
-      for (int v = start_index; v < end; v += stride) {
-        std::get<0>(task)(v, tId);  // nested lambda func
+  auto& func = std::get<0>(task);
+  pool->Run(
+      [&func, start, step](int index, int tid) {
+        func(start + index * step, tid);  // nested lambda func
+      },
+      work_size);
+}
+
+void ThreadPool::Enqueue(TASK_2D&& task) {
+  auto& func = std::get<0>(task);
+  int end0 = std::get<1>(task);
+  int start0 = std::get<2>(task);
+  int step0 = std::get<3>(task);
+  int end1 = std::get<4>(task);
+  int start1 = std::get<5>(task);
+  int step1 = std::get<6>(task);
+  int grain = std::get<7>(task);
+  int size0 = std::max((end0 - start0 + step0 - 1) / step0, 0);
+  int size1 = std::max((end1 - start1 + step1 - 1) / step1, 0);
+  int work_size = size0 * size1;
+  ThreadPool* pool = Current();
+  if (work_size <= 1 || (nullptr == pool) || gThreadIndex >= 0) {
+    int tid = std::max(gThreadIndex, 0);
+    for (int i = start0; i < end0; i += step0) {
+      for (int j = start1; j < end1; j += step1) {
+        func(i, j, tid);
       }
-    });
-    work_size = gInstance->thread_num_;
-  } else {
-    gInstance->tasks_.first = ([=, &task](int index, int tId) {
-      auto v = start + tId * step;
-      std::get<0>(task)(v, tId);  // nested lambda func
-    });
-  }
-  for (int i = 1; i < work_size; ++i) {
-    *(gInstance->tasks_.second[i]) = true;
+    }
+    return;
   }
-  // invoke tid 0 callback in main thread
-  // other tid task is invoked in new thread
-  gInstance->tasks_.first(0, 0);
-  bool complete = true;
-  // check tid 1 to thread_num - 1 all work completed in new thread
-  do {
-    std::this_thread::yield();
-    complete = true;
-    for (int i = 1; i < work_size; ++i) {
-      if (*gInstance->tasks_.second[i]) {
-        complete = false;
-        break;
+  pool->Run(
+      [&](int index, int tid) {
+        func(start0 + (index / size1) * step0,
+             start1 + (index % size1) * step1,
+             tid);
+      },
+      work_size,
+      grain);
+}
+
+void ThreadPool::Enqueue(TASK_3D&& task) {
+  auto& func = std::get<0>(task);
+  int end0 = std::get<1>(task);
+  int start0 = std::get<2>(task);
+  int step0 = std::get<3>(task);
+  int end1 = std::get<4>(task);
+  int start1 = std::get<5>(task);
+  int step1 = std::get<6>(task);
+  int end2 = std::get<7>(task);
+  int start2 = std::get<8>(task);
+  int step2 = std::get<9>(task);
+  int grain = std::get<10>(task);
+  int size0 = std::max((end0 - start0 + step0 - 1) / step0, 0);
+  int size1 = std::max((end1 - start1 + step1 - 1) / step1, 0);
+  int size2 = std::max((end2 - start2 + step2 - 1) / step2, 0);
+  int work_size = size0 * size1 * size2;
+  ThreadPool* pool = Current();
+  if (work_size <= 1 || (nullptr == pool) || gThreadIndex >= 0) {
+    int tid = std::max(gThreadIndex, 0);
+    for (int i = start0; i < end0; i += step0) {
+      for (int j = start1; j < end1; j += step1) {
+        for (int k = start2; k < end2; k += step2) {
+          func(i, j, k, tid);
+        }
       }
     }
-  } while (!complete);
+    return;
+  }
+  pool->Run(
+      [&](int index, int tid) {
+        int i = index / (size1 * size2);
+        int j = (index / size2) % size1;
+        int k = index % size2;
+        func(start0 + i * step0, start1 + j * step1, start2 + k * step2, tid);
+      },
+      work_size,
+      grain);
 }
 
 }  // namespace lite
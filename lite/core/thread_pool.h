@@ -15,8 +15,11 @@
 #pragma once
 #include <atomic>
 #include <condition_variable>  //NOLINT
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>   //NOLINT
+#include <string>
 #include <thread>  //NOLINT
 #include <tuple>
 #include <utility>
@@ -25,32 +28,157 @@
 namespace paddle {
 namespace lite {
 
+// kSpin:  idle workers keep polling for new tasks, which gives the lowest
+//         wake-up latency but occupies all cores between two runs.
+// kPark:  idle workers spin for a bounded number of iterations, then sleep on
+//         a condition variable(futex on linux) until the next task arrives.
+// kOpenMP: no workers of its own, the tasks run on the OpenMP team of the
+//         issuing thread, which is shared with MKL and the omp regions of
+//         the x86 kernels, so they don't oversubscribe the cores. Same as a
+//         single thread without OpenMP.
+enum class ThreadPoolMode { kSpin = 0, kPark = 1, kOpenMP = 2 };
+
 class ThreadPool {
  public:
   typedef std::function<void(int, int)> TASK;
   typedef std::pair<std::function<void(int, int)>, int> TASK_BASIC;
   typedef std::tuple<std::function<void(int, int)>, int, int, int> TASK_COMMON;
+  // func(i, j, tid), end0, start0, step0, end1, start1, step1, grain
+  typedef std::tuple<std::function<void(int, int, int)>,
+                     int,
+                     int,
+                     int,
+                     int,
+                     int,
+                     int,
+                     int>
+      TASK_2D;
+  // func(i, j, k, tid), end0, start0, step0, end1, start1, step1,
+  // end2, start2, step2, grain
+  typedef std::tuple<std::function<void(int, int, int, int)>,
+                     int,
+                     int,
+                     int,
+                     int,
+                     int,
+                     int,
+                     int,
+                     int,
+                     int,
+                     int>
+      TASK_3D;
 
   static void Enqueue(TASK_BASIC&& task);
   static void Enqueue(TASK_COMMON&& task);
+  // The tiles of the 2D/3D loops are flattened in row-major order, and `grain`
+  // is the minimum number of adjacent tiles executed by a thread at a time.
+  static void Enqueue(TASK_2D&& task);
+  static void Enqueue(TASK_3D&& task);
   static void AcquireThreadPool();
   static void ReleaseThreadPool();
-  static int Init(int number);
+  static int Init(int number, ThreadPoolMode mode = ThreadPoolMode::kPark);
   static void Destroy();
 
+  // Create a thread pool owned by the caller, e.g. a predictor. The pools
+  // created with the same non-empty `shared_key` are shared while any of the
+  // owners is alive, and the Run()s of the owners are serialized.
+  static std::shared_ptr<ThreadPool> Create(
+      int number,
+      ThreadPoolMode mode = ThreadPoolMode::kPark,
+      const std::string& shared_key = "");
+  // The thread pool used by the parallel regions issued by the current
+  // thread, which is the bound one or the global one if nothing is bound.
+  static ThreadPool* Current();
+  // Bind `pool` to the current thread and return the previous bound one.
+  static ThreadPool* SetCurrent(ThreadPool* pool);
+
+  explicit ThreadPool(int number,
+                      ThreadPoolMode mode = ThreadPoolMode::kPark);
+  ~ThreadPool();
+
+  // Bind the i-th thread to cpu_ids[i % cpu_ids.size()], the workers apply
+  // it lazily before executing the next task. Empty means no binding. On x86
+  // each worker is bound to all of cpu_ids, e.g. the cpus of a NUMA node,
+  // where the OS schedules the workers of all the pools on the node.
+  void SetAffinity(const std::vector<int>& cpu_ids);
+  // The relative speed of the i-th thread is capacities[i % size], e.g. of
+  // the big and little cores it's bound to. The iterations are split in
+  // proportion at the begining of each Run(), and the idle threads steal the
+  // rest. Empty or non-positive values mean an even split.
+  void SetCapacity(const std::vector<int>& capacities);
+  // Run the next parallel regions issued by the calling thread with at most
+  // `number` of the threads, the others stay idle, e.g. while the big cores
+  // are throttled. 0 means all of them. It's kept per issuing thread, not on
+  // the pool, so the predictors sharing a pool never run with the count of
+  // each other, which their per-thread workspaces are sized by.
+  static void SetActiveThreads(int number);
+  int thread_num() const { return thread_num_; }
+
  private:
+  // The iterations [begin, end) that are owned by one thread, packed into a
+  // single 64-bit word so that the owner and the thieves can update it with
+  // one CAS. Padded to the cache line, so the ranges of two threads are never
+  // in the same line. Not alignas(64), which new[] doesn't honour before
+  // C++17.
+  struct WorkRange {
+    std::atomic<uint64_t> range{0};
+    char padding[64 - sizeof(std::atomic<uint64_t>)];
+  };
+
   static ThreadPool* gInstance;
-  explicit ThreadPool(int number = 0);
-  ~ThreadPool();
+
+  // Run `func` on iterations [0, work_size) with all of the workers, at least
+  // `grain` adjacent iterations are executed by a thread at a time.
+  void Run(const TASK& func, int work_size, int grain = 1);
+  void RunOpenMP(const TASK& func, int work_size, int grain);
+  // The active threads of the parallel regions issued by the calling thread.
+  int ActiveThreads() const;
+  void WorkerLoop(int thread_index);
+  void ApplyAffinity(int thread_index, int* version);
+  void Execute(int thread_index);
+  bool PopFront(int thread_index, int* begin, int* end);
+  bool Steal(int thread_index);
 
   std::vector<std::thread> workers_;
   std::atomic<bool> stop_{false};
   bool ready_{true};
-  std::pair<TASK, std::vector<std::atomic<bool>*>> tasks_;
   std::condition_variable cv_;
   std::mutex mutex_;
+  // Serialize the parallel regions from different threads sharing the pool.
+  std::mutex run_mutex_;
+  std::mutex affinity_mutex_;
+  std::vector<int> cpu_ids_;
+  std::atomic<int> affinity_version_{0};
+  // Guarded by run_mutex_.
+  std::vector<int> capacities_;
+
+  ThreadPoolMode mode_{ThreadPoolMode::kPark};
+  // (epoch << 32 | active thread number) of the task being executed, the
+  // workers whose index is not less than the active number sit out.
+  std::atomic<uint64_t> job_{0};
+  std::atomic<int> pending_{0};
+  std::atomic<int> sleeping_{0};
+  std::condition_variable park_cv_;
+  std::mutex park_mutex_;
+  const TASK* func_{nullptr};
+  int grain_{1};
+  int work_size_{0};
+  std::unique_ptr<WorkRange[]> ranges_;
 
   int thread_num_ = 0;
 };
+
+// Route the parallel regions issued by the current thread to `pool` within
+// the lifetime of the guard.
+class ThreadPoolGuard {
+ public:
+  explicit ThreadPoolGuard(ThreadPool* pool)
+      : prev_(ThreadPool::SetCurrent(pool)) {}
+  ~ThreadPoolGuard() { ThreadPool::SetCurrent(prev_); }
+
+ private:
+  ThreadPool* prev_{nullptr};
+};
+
 }  // namespace lite
 }  // namespace paddle
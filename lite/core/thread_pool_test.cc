@@ -0,0 +1,216 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/thread_pool.h"
+#include <gtest/gtest.h>
+#include "lite/core/parallel_defines.h"
+#include <atomic>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+TEST(ThreadPool, basic) {
+  ThreadPool::Init(4);
+  for (int work_size : {1, 3, 4, 17, 1000}) {
+    std::vector<std::atomic<int>> hits(work_size);
+    for (auto& hit : hits) hit = 0;
+    ThreadPool::Enqueue({[&](int index, int tid) {
+                           ASSERT_GE(tid, 0);
+                           ASSERT_LT(tid, 4);
+                           hits[index]++;
+                         },
+                         work_size});
+    for (auto& hit : hits) {
+      ASSERT_EQ(hit.load(), 1);
+    }
+  }
+  ThreadPool::Destroy();
+}
+
+TEST(ThreadPool, common) {
+  ThreadPool::Init(3, ThreadPoolMode::kSpin);
+  std::atomic<int> sum{0};
+  ThreadPool::Enqueue(std::make_tuple(
+      [&](int index, int tid) { sum += index; }, 100, 4, 3));
+  int expect = 0;
+  for (int i = 4; i < 100; i += 3) expect += i;
+  ASSERT_EQ(sum.load(), expect);
+  ThreadPool::Destroy();
+}
+
+TEST(ThreadPool, imbalance) {
+  ThreadPool::Init(4);
+  std::atomic<int> count{0};
+  for (int round = 0; round < 100; ++round) {
+    ThreadPool::Enqueue({[&](int index, int tid) {
+                           // Only the first iterations are heavy.
+                           volatile int x = 0;
+                           for (int i = 0; i < (index < 4 ? 20000 : 10); ++i) {
+                             x += i;
+                           }
+                           count++;
+                         },
+                         64});
+  }
+  ASSERT_EQ(count.load(), 6400);
+  ThreadPool::Destroy();
+}
+
+TEST(ThreadPool, nested) {
+  ThreadPool::Init(2);
+  std::atomic<int> count{0};
+  ThreadPool::Enqueue({[&](int index, int tid) {
+                         ThreadPool::Enqueue(
+                             {[&](int i, int inner_tid) {
+                                ASSERT_EQ(inner_tid, tid);
+                                count++;
+                              },
+                              8});
+                       },
+                       8});
+  ASSERT_EQ(count.load(), 64);
+  ThreadPool::Destroy();
+}
+
+TEST(ThreadPool, instance) {
+  auto pool_a = ThreadPool::Create(2);
+  auto pool_b = ThreadPool::Create(3, ThreadPoolMode::kPark, "shared");
+  auto pool_c = ThreadPool::Create(3, ThreadPoolMode::kPark, "shared");
+  ASSERT_NE(pool_a.get(), pool_b.get());
+  ASSERT_EQ(pool_b.get(), pool_c.get());
+  ASSERT_EQ(ThreadPool::Create(1), nullptr);
+  ASSERT_EQ(ThreadPool::Current(), nullptr);
+
+  auto run = [](ThreadPool* pool, int max_threads) {
+    ThreadPoolGuard guard(pool);
+    ASSERT_EQ(ThreadPool::Current(), pool);
+    std::atomic<int> count{0};
+    for (int round = 0; round < 50; ++round) {
+      ThreadPool::Enqueue({[&](int index, int tid) {
+                             ASSERT_LT(tid, max_threads);
+                             count++;
+                           },
+                           32});
+    }
+    ASSERT_EQ(count.load(), 50 * 32);
+  };
+  std::thread t0(run, pool_a.get(), 2);
+  std::thread t1(run, pool_b.get(), 3);
+  std::thread t2(run, pool_c.get(), 3);
+  t0.join();
+  t1.join();
+  t2.join();
+  ASSERT_EQ(ThreadPool::Current(), nullptr);
+}
+
+TEST(ThreadPool, active_threads_per_caller) {
+  auto pool = ThreadPool::Create(4, ThreadPoolMode::kPark, "active_threads");
+  // Each caller sizes its per-thread scratch by its own active threads.
+  auto run = [&pool](int active) {
+    ThreadPoolGuard guard(pool.get());
+    ThreadPool::SetActiveThreads(active);
+    for (int round = 0; round < 200; ++round) {
+      ThreadPool::Enqueue({[&](int index, int tid) { ASSERT_LT(tid, active); },
+                           64});
+    }
+    ThreadPool::SetActiveThreads(0);
+  };
+  std::thread t0(run, 1);
+  std::thread t1(run, 4);
+  std::thread t2(run, 2);
+  t0.join();
+  t1.join();
+  t2.join();
+}
+
+TEST(ThreadPool, openmp) {
+  auto pool = ThreadPool::Create(3, ThreadPoolMode::kOpenMP);
+  ThreadPoolGuard guard(pool.get());
+  for (int work_size : {2, 7, 100}) {
+    std::vector<std::atomic<int>> hits(work_size);
+    for (auto& hit : hits) hit = 0;
+    std::atomic<int> nested{0};
+    ThreadPool::Enqueue({[&](int index, int tid) {
+                           ASSERT_GE(tid, 0);
+                           ASSERT_LT(tid, 3);
+                           hits[index]++;
+                           ThreadPool::Enqueue({[&](int i, int inner_tid) {
+                                                  ASSERT_EQ(inner_tid, tid);
+                                                  nested++;
+                                                },
+                                                4});
+                         },
+                         work_size});
+    for (auto& hit : hits) {
+      ASSERT_EQ(hit.load(), 1);
+    }
+    ASSERT_EQ(nested.load(), work_size * 4);
+  }
+}
+
+TEST(ThreadPool, capacity) {
+  auto pool = ThreadPool::Create(4);
+  ThreadPoolGuard guard(pool.get());
+  // two fast and two slow threads, then invalid capacities for an even split
+  for (auto capacities : std::vector<std::vector<int>>{
+           {1024, 1024, 400, 400}, {3, 1}, {1024, 0, 1, 1}}) {
+    pool->SetCapacity(capacities);
+    for (int work_size : {2, 7, 100, 1000}) {
+      std::vector<std::atomic<int>> hits(work_size);
+      for (auto& hit : hits) hit = 0;
+      ThreadPool::Enqueue({[&](int index, int tid) {
+                             ASSERT_LT(tid, 4);
+                             hits[index]++;
+                           },
+                           work_size});
+      for (auto& hit : hits) {
+        ASSERT_EQ(hit.load(), 1);
+      }
+    }
+  }
+}
+
+TEST(ThreadPool, parallel_2d_3d) {
+  ThreadPool::Init(4);
+  std::vector<std::atomic<int>> hits(7 * 5 * 3);
+  for (auto& hit : hits) hit = 0;
+  LITE_PARALLEL_COMMON_2D_BEGIN(i, j, tid, 14, 0, 2, 5, 0, 1, 2) {
+    hits[(i / 2) * 5 + j]++;
+  }
+  LITE_PARALLEL_COMMON_2D_END();
+  for (int n = 0; n < 7 * 5; ++n) {
+    ASSERT_EQ(hits[n].load(), 1);
+  }
+  LITE_PARALLEL_COMMON_3D_BEGIN(i, j, k, tid, 7, 0, 1, 10, 0, 2, 6, 3, 1, 1) {
+    hits[(i * 5 + j / 2) * 3 + k - 3]++;
+  }
+  LITE_PARALLEL_COMMON_3D_END();
+  for (int n = 0; n < 7 * 5 * 3; ++n) {
+    ASSERT_EQ(hits[n].load(), n < 7 * 5 ? 2 : 1);
+  }
+  ThreadPool::Destroy();
+}
+
+TEST(ThreadPool, tile_size) {
+  // enough blocks along M, keep the whole N in one tile
+  ASSERT_EQ(ParallelTileSize(64, 10, 4), 10);
+  // a single M block, split N to feed 4 threads
+  ASSERT_EQ(ParallelTileSize(1, 32, 4), 2);
+  ASSERT_EQ(ParallelTileSize(2, 3, 4), 1);
+  ASSERT_EQ(ParallelTileSize(2, 0, 4), 1);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -117,6 +117,20 @@ const Type *Type::GetStepScopeTy() {
   return type_repo[v];
 }
 
+const Type *Type::GetKVCacheTy() {
+  static std::map<size_t, const Type *> type_repo;
+  std::hash<int> hasher;
+  size_t v = hasher(static_cast<int>(DataType::ID::KVCache));
+  if (!type_repo[v])
+    type_repo[v] = new Type(DataType::ID::KVCache,
+                            "KVCache",
+                            TARGET(kUnk),
+                            PRECISION(kUnk),
+                            DATALAYOUT(kUnk),
+                            -1);
+  return type_repo[v];
+}
+
 const Type *Type::GetUnsupportedTy() {
   static std::map<size_t, const Type *> type_repo;
   std::hash<int> hasher;
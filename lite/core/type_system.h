@@ -89,6 +89,9 @@ class DataType {
     // A vector of local scope, which size equals the step number of While Op.
     // The i'th scope storages temporary variables generated in the i'th step.
     StepScope,
+    // The keys and values cached by the attention layers across the decoding
+    // steps, see KVCache.
+    KVCache,
     // ---------
     NumTypes,  // Must remains as last defined ID.
   };
@@ -101,6 +104,7 @@ class DataType {
   bool IsTensor() const { return id_ == ID::Tensor; }
   bool IsTensorList() const { return id_ == ID::TensorList; }
   bool IsStepScope() const { return id_ == ID::StepScope; }
+  bool IsKVCache() const { return id_ == ID::KVCache; }
   // Get number of types.
   int num_types() const { return static_cast<int>(ID::NumTypes); }
 
@@ -134,6 +138,8 @@ class Type : public DataType {
       int device = 0);
   /// Get a StepScope type.
   static const Type* GetStepScopeTy();
+  /// Get a KVCache type.
+  static const Type* GetKVCacheTy();
   /// Get an Unsupported type.
   static const Type* GetUnsupportedTy();
   /// Get an Void type.
@@ -204,7 +210,7 @@ static bool DataLayoutCompatible(const Type& a, const Type& b) {
 }
 
 static bool PrecisionCompatibleTo(const Type& a, const Type& b) {
-  return a.IsVoid() ||  //
+  return a.IsVoid() || (a.IsKVCache() && b.IsKVCache()) ||  //
          (((a.IsTensor() && b.IsTensor()) ||
            (a.IsTensorList() && b.IsTensor()) ||
            (a.IsTensor() && b.IsTensorList()) ||
@@ -214,7 +220,7 @@ static bool PrecisionCompatibleTo(const Type& a, const Type& b) {
            a.precision() == PRECISION(kAny)));
 }
 static bool PrecisionCompatible(const Type& a, const Type& b) {
-  return a.IsVoid() || b.IsVoid() ||  //
+  return a.IsVoid() || b.IsVoid() || (a.IsKVCache() && b.IsKVCache()) ||  //
          (((a.IsTensor() && b.IsTensor()) ||
            (a.IsTensorList() && b.IsTensorList())) &&
           (a.precision() == b.precision() ||  //
@@ -223,7 +229,7 @@ static bool PrecisionCompatible(const Type& a, const Type& b) {
 }
 
 static bool DeviceCompatibleTo(const Type& a, const Type& b) {
-  return a.IsVoid() ||  //
+  return a.IsVoid() || (a.IsKVCache() && b.IsKVCache()) ||  //
          (((a.IsTensor() && b.IsTensor()) ||
            (a.IsTensorList() && b.IsTensorList())) &&  //
           (a.device() == b.device()));
@@ -33,6 +33,11 @@ void CalibComputeFp32ToInt8<DLType>::Run() {
   std::vector<float> scale = {param.scale};
   const auto* din = param.input->template data<float>();
   auto* dout = param.output->template mutable_data<signed char>();
+  if (param.zero_point != 0) {
+    lite::arm::math::fp32_to_int8_asym(
+        din, dout, param.scale, param.zero_point, param.input->numel());
+    return;
+  }
   lite::arm::math::fp32_to_int8(
       din, dout, scale.data(), 1, 1, param.input->numel());
 }
@@ -59,6 +59,56 @@ void ConcatFunc(const std::vector<lite::Tensor*> inputs,
   }
 }
 
+#ifndef LITE_WITH_FPGA
+// With nothing outside axis the inputs are contiguous slices of the output.
+// They are copied once and then turned into views of their slices, so that
+// their producers write straight into the output from the next run on.
+template <typename T>
+void ConcatViews(const std::vector<lite::Tensor*>& inputs,
+                 int axis,
+                 lite::Tensor* out) {
+  bool contiguous = out->dims().count(0, axis) == 1;
+  size_t out_size = out->numel() * sizeof(T);
+  bool in_place = contiguous && out->IsViewOf(*out, 0) &&
+                  out_size <= out->view_size();
+  size_t offset = 0;
+  for (auto* in : inputs) {
+    size_t size = in->numel() * sizeof(T);
+    if (size > 0 && !in->IsViewOf(*out, offset)) in_place = false;
+    offset += size;
+  }
+  if (in_place) {
+    out->mutable_data<T>();
+    return;
+  }
+  // The output may still share its buffer with the inputs of the last run.
+  out->DetachBuffer();
+  ConcatFunc<T>(inputs, axis, out);
+  if (!contiguous) return;
+  out->ShareBufferWith(*out, 0, out_size);
+  offset = 0;
+  for (auto* in : inputs) {
+    size_t size = in->numel() * sizeof(T);
+    if (size > 0) in->ShareBufferWith(*out, offset, size);
+    offset += size;
+  }
+}
+#endif
+
+template <typename T>
+void Concat(const std::vector<lite::Tensor*>& inputs,
+            int axis,
+            lite::Tensor* out,
+            bool zero_copy) {
+#ifndef LITE_WITH_FPGA
+  if (zero_copy) {
+    ConcatViews<T>(inputs, axis, out);
+    return;
+  }
+#endif
+  ConcatFunc<T>(inputs, axis, out);
+}
+
 void ConcatCompute::Run() {
   auto& param = Param<operators::ConcatParam>();
   std::vector<lite::Tensor*> inputs = param.x;
@@ -123,21 +173,21 @@ void ConcatCompute::Run() {
 
   switch (type) {
     case PRECISION(kFloat):
-      ConcatFunc<float>(inputs, axis, out);
+      Concat<float>(inputs, axis, out, param.zero_copy);
       break;
 #ifdef ENABLE_ARM_FP16
     case PRECISION(kFP16):
-      ConcatFunc<__fp16>(inputs, axis, out);
+      Concat<__fp16>(inputs, axis, out, param.zero_copy);
       break;
 #endif
     case PRECISION(kInt32):
-      ConcatFunc<int32_t>(inputs, axis, out);
+      Concat<int32_t>(inputs, axis, out, param.zero_copy);
       break;
     case PRECISION(kInt64):
-      ConcatFunc<int64_t>(inputs, axis, out);
+      Concat<int64_t>(inputs, axis, out, param.zero_copy);
       break;
     case PRECISION(kBool):
-      ConcatFunc<bool>(inputs, axis, out);
+      Concat<bool>(inputs, axis, out, param.zero_copy);
       break;
     default:
       LOG(FATAL) << "Concat does not implement for the "
@@ -222,6 +222,51 @@ TEST(concat_arm, compute_input_multi) {
   }
 }
 
+TEST(concat_arm, zero_copy) {
+  ConcatCompute concat;
+  operators::ConcatParam param;
+  lite::Tensor x0, x1, output, output_ref;
+  x0.Resize({1, 3, 2, 2});
+  x1.Resize({1, 5, 2, 2});
+  param.x = {&x0, &x1};
+  param.output = &output;
+  param.axis = 1;
+  param.zero_copy = true;
+  CHECK(infer_shape(param));
+  concat.SetParam(param);
+  for (int run = 0; run < 3; run++) {
+    // The producers write through the views made by the first run.
+    for (auto* x : param.x) {
+      auto* x_data = x->mutable_data<float>();
+      for (int i = 0; i < x->numel(); i++) {
+        x_data[i] = run * 100 + i;
+      }
+    }
+    concat.Run();
+    EXPECT_TRUE(x0.IsViewOf(output, 0));
+    EXPECT_TRUE(x1.IsViewOf(output, x0.memory_size()));
+    param.output = &output_ref;
+    concat_compute_ref(param);
+    param.output = &output;
+    for (int i = 0; i < output.numel(); i++) {
+      EXPECT_NEAR(output.data<float>()[i], output_ref.data<float>()[i], 1e-5);
+    }
+  }
+  // A larger input moves out of the output, which is copied again.
+  x1.Resize({1, 7, 2, 2});
+  for (int i = 0; i < x1.numel(); i++) {
+    x1.mutable_data<float>()[i] = -i;
+  }
+  EXPECT_FALSE(x1.IsView());
+  CHECK(infer_shape(param));
+  concat.Run();
+  param.output = &output_ref;
+  concat_compute_ref(param);
+  for (int i = 0; i < output.numel(); i++) {
+    EXPECT_NEAR(output.data<float>()[i], output_ref.data<float>()[i], 1e-5);
+  }
+}
+
 TEST(concat, retrive_op) {
   auto concat = KernelRegistry::Global().Create("concat");
   ASSERT_FALSE(concat.empty());
@@ -13,13 +13,18 @@
 // limitations under the License.
 
 #include "lite/kernels/arm/conv_compute.h"
+#include <sstream>
 #include <utility>
+#include "lite/backends/arm/math/bf16/funcs_bf16.h"
+#include "lite/core/kernel_tuner.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/type_system.h"
 #include "lite/kernels/arm/conv_depthwise.h"
 #include "lite/kernels/arm/conv_direct.h"
 #include "lite/kernels/arm/conv_gemmlike.h"
 #include "lite/kernels/arm/conv_winograd.h"
+#include "lite/operators/conv_algorithm.h"
+#include "lite/utils/timer.h"
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
 #endif
@@ -28,106 +33,199 @@ namespace paddle {
 namespace lite {
 namespace kernels {
 namespace arm {
-#define PARAM_INIT                                                           \
-  auto& param = this->Param<param_t>();                                      \
-  auto w_dims = param.filter->dims();                                        \
-  auto& ctx = this->ctx_->template As<ARMContext>();                         \
-  auto paddings = *param.paddings;                                           \
-  auto dilations = *param.dilations;                                         \
-  int ic = w_dims[1] * param.groups;                                         \
-  int oc = w_dims[0];                                                        \
-  int kh = w_dims[2];                                                        \
-  int kw = w_dims[3];                                                        \
-  int pad_h = paddings[0];                                                   \
-  int pad_w = paddings[2];                                                   \
-  int stride = param.strides[0];                                             \
-  int sh = param.strides[1];                                                 \
-  int sw = param.strides[0];                                                 \
-  int threads = ctx.threads();                                               \
-  int chin = param.x->dims()[1];                                             \
-  int hin = param.x->dims()[2];                                              \
-  int win = param.x->dims()[3];                                              \
-  int chout = param.output->dims()[1];                                       \
-  int hout = param.output->dims()[2];                                        \
-  int wout = param.output->dims()[3];                                        \
-  bool pads_equal =                                                          \
-      ((paddings[0] == paddings[1]) && (paddings[2] == paddings[3]));        \
-  bool pads_all_equal = (pads_equal && pad_h == pad_w);                      \
-  bool ks_equal = (sw == sh) && (kw == kh);                                  \
-  bool no_dilation = (dilations[0] == 1) && (dilations[1] == 1);             \
-  bool kps_equal = (pad_h == pad_w) && ks_equal;                             \
-  bool flag_dw_3x3 = (kw == 3) && (kh == 3) && (stride == 1 || stride == 2); \
-  bool flag_dw_5x5 = (kw == 5) && (kh == 5) && (stride == 1 || stride == 2); \
-  bool flag_dw = flag_dw_3x3 || flag_dw_5x5;
+namespace {
+using operators::ConvAlgorithm;
 
-template <>
-void ConvCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
-  PARAM_INIT
-  /// select conv impl
-  if (param.groups == ic && ic == oc && ks_equal && no_dilation && flag_dw) {
-    impl_ = new DepthwiseConv<PRECISION(kFloat), PRECISION(kFloat)>;
-    // VLOG(3) << "invoking dw conv";
-  } else if (param.groups == 1 && kw == 3 && stride == 1 && ks_equal &&
-             no_dilation) {
-    impl_ = new WinogradConv<PRECISION(kFloat), PRECISION(kFloat)>;
-    // VLOG(3) << "invoking winograd conv";
-  } else if (param.groups == 1 && kw == 3 && stride == 2 &&
-             chin * chout < 4 * hin * win && ks_equal && no_dilation) {
-    impl_ = new DirectConv<PRECISION(kFloat), PRECISION(kFloat)>;
-    // VLOG(3) << "invoking direct conv";
-  } else {
-    impl_ = new GemmLikeConv<PRECISION(kFloat), PRECISION(kFloat)>;
-    // VLOG(3) << "invoking gemm like conv";
+operators::ConvShape GetConvShape(const operators::ConvParam& param) {
+  auto w_dims = param.filter->dims();
+  operators::ConvShape shape;
+  shape.ic = w_dims[1] * param.groups;
+  shape.oc = w_dims[0];
+  shape.kh = w_dims[2];
+  shape.kw = w_dims[3];
+  shape.hin = param.x->dims()[2];
+  shape.win = param.x->dims()[3];
+  shape.groups = param.groups;
+  shape.strides = param.strides;
+  shape.paddings = *param.paddings;
+  shape.dilations = *param.dilations;
+  return shape;
+}
+
+// Use the implementation selected by opt if it supports the conv, or select
+// one by the shape rules.
+ConvAlgorithm GetConvAlgorithm(const operators::ConvParam& param,
+                               PrecisionType precision,
+                               const operators::ConvShape& shape,
+                               bool has_dot) {
+  if (!param.conv_algorithm.empty()) {
+    auto algorithm = operators::ConvAlgorithmFromStr(param.conv_algorithm);
+    if (operators::IsArmConvAlgorithmSupported(algorithm, precision, shape)) {
+      return algorithm;
+    }
+    LOG(WARNING) << "The conv algorithm " << param.conv_algorithm
+                 << " selected by opt is not supported, ignore it.";
+  }
+  auto algorithm = operators::SelectArmConvAlgorithm(precision, shape, has_dot);
+  CHECK(algorithm != ConvAlgorithm::kAuto);
+  return algorithm;
+}
+
+std::string GetConvTuneKey(PrecisionType precision,
+                           PrecisionType out_precision,
+                           const operators::ConvShape& shape) {
+  std::stringstream ss;
+  ss << KernelTuner::DeviceKey() << "|conv2d/" << PrecisionToStr(precision)
+     << "/" << PrecisionToStr(out_precision) << "|ic:" << shape.ic
+     << ",oc:" << shape.oc << ",k:" << shape.kh << "x" << shape.kw
+     << ",in:" << shape.hin << "x" << shape.win << ",g:" << shape.groups
+     << ",s:" << shape.strides[0] << "x" << shape.strides[1] << ",p:";
+  for (auto pad : shape.paddings) ss << pad << ".";
+  ss << ",d:" << shape.dilations[0] << "x" << shape.dilations[1];
+  return ss.str();
+}
+
+template <PrecisionType Ptype, PrecisionType OutType>
+KernelLite<TARGET(kARM), Ptype>* CreateConvImpl(ConvAlgorithm algorithm) {
+  switch (algorithm) {
+    case ConvAlgorithm::kDepthwise:
+      return new DepthwiseConv<Ptype, OutType>;
+    case ConvAlgorithm::kWinograd:
+      return new WinogradConv<Ptype, OutType>;
+    case ConvAlgorithm::kDirect:
+      return new DirectConv<Ptype, OutType>;
+    default:
+      return new GemmLikeConv<Ptype, OutType>;
+  }
+}
+}  // namespace
+
+template <PrecisionType Ptype, PrecisionType OutType>
+void ConvCompute<Ptype, OutType>::PrepareImpl() {
+  auto& param = this->template Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto shape = GetConvShape(param);
+  auto algorithm = GetConvAlgorithm(param, Ptype, shape, ctx.has_dot());
+  // Only the gemm-like int8 conv adds the fused residual, and folds the zero
+  // point of the asymmetric int8 input into the bias.
+  bool int8_gemm_like = Ptype == PRECISION(kInt8) &&
+                        (param.second_x || param.input_zero_point != 0);
+  // Only the gemm-like fp32 conv dequantizes the weight-only int8 filter
+  // while packing it, which is kept in int8 in the scope.
+  bool weight_only = Ptype == PRECISION(kFloat) &&
+                     param.weight_quant_bits == 8 &&
+                     param.filter->precision() == PRECISION(kInt8);
+  if (int8_gemm_like || weight_only) algorithm = ConvAlgorithm::kGemmLike;
+  auto& tuner = KernelTuner::Global();
+  if (tuner.enabled() && !int8_gemm_like && !weight_only) {
+    tune_key_ = GetConvTuneKey(Ptype, OutType, shape);
+    std::string choice;
+    if (tuner.Lookup(tune_key_, &choice)) {
+      auto tuned = operators::ConvAlgorithmFromStr(choice);
+      if (operators::IsArmConvAlgorithmSupported(tuned, Ptype, shape)) {
+        algorithm = tuned;
+      }
+    } else {
+      std::vector<ConvAlgorithm> algorithms;
+      for (auto x : {ConvAlgorithm::kDepthwise,
+                     ConvAlgorithm::kWinograd,
+                     ConvAlgorithm::kDirect,
+                     ConvAlgorithm::kGemmLike}) {
+        if (operators::IsArmConvAlgorithmSupported(x, Ptype, shape)) {
+          algorithms.push_back(x);
+        }
+      }
+      if (algorithms.size() > 1) {
+        // Each candidate owns a copy of the param, since some of them update
+        // the activation param in PrepareForRun.
+        for (auto x : algorithms) {
+          std::unique_ptr<impl_t> impl(CreateConvImpl<Ptype, OutType>(x));
+          impl->SetContext(
+              ContextScheduler::Global().NewContext(TARGET(kARM)));
+          impl->SetParam(param);
+          impl->PrepareForRun();
+          candidates_.emplace_back(x, std::move(impl));
+        }
+        return;
+      }
+    }
   }
+  impl_ = CreateConvImpl<Ptype, OutType>(algorithm);
   impl_->SetContext(std::move(this->ctx_));
   impl_->SetParam(param);
   impl_->PrepareForRun();
+}
+
+template <PrecisionType Ptype, PrecisionType OutType>
+void ConvCompute<Ptype, OutType>::Tune() {
+  int repeats = KernelTuner::Global().repeats();
+  size_t best = 0;
+  uint64_t best_time = 0;
+  for (size_t i = 0; i < candidates_.size(); i++) {
+    auto& impl = candidates_[i].second;
+    impl->ReInitWhenNeeded();
+    // Warm up the caches and the workspace first.
+    impl->Run();
+    uint64_t start = Timer::GetCurrentUS();
+    for (int j = 0; j < repeats; j++) impl->Run();
+    uint64_t elapsed = Timer::GetCurrentUS() - start;
+    VLOG(4) << "conv " << operators::ConvAlgorithmToStr(candidates_[i].first)
+            << ": " << elapsed / repeats << " us";
+    if (i == 0 || elapsed < best_time) {
+      best = i;
+      best_time = elapsed;
+    }
+  }
+  auto algorithm = candidates_[best].first;
+  impl_ = candidates_[best].second.release();
+  // The output must be computed by the kept one.
+  if (best + 1 != candidates_.size()) impl_->Run();
+  candidates_.clear();
+  KernelTuner::Global().Record(tune_key_,
+                               operators::ConvAlgorithmToStr(algorithm));
+  VLOG(4) << "Tuned conv " << tune_key_ << ": "
+          << operators::ConvAlgorithmToStr(algorithm);
+}
+
+template <>
+void ConvCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
+  PrepareImpl();
   is_first_epoch_ = false;
 }
 
 template <>
 void ConvCompute<PRECISION(kInt8), PRECISION(kFloat)>::PrepareForRun() {
-  PARAM_INIT
-  if (param.groups == ic && ic == oc && kps_equal && pads_equal &&
-      no_dilation && flag_dw) {
-    impl_ = new DepthwiseConv<PRECISION(kInt8), PRECISION(kFloat)>;
-    // VLOG(3) << "Run DepthwiseConv Int8";
-  } else if (param.groups == 1 && kw == 3 && sw == 2 && sh == 2 &&
-             no_dilation && pads_equal && ks_equal && !ctx.has_dot()) {
-    impl_ = new DirectConv<PRECISION(kInt8), PRECISION(kFloat)>;
-    // VLOG(3) << "Run DirectConv Int8";
-  } else if (param.groups == 1 && kw == 3 && sw == 1 && no_dilation &&
-             pads_equal && ks_equal && !ctx.has_dot()) {
-    impl_ = new WinogradConv<PRECISION(kInt8), PRECISION(kFloat)>;
-    // VLOG(3) << "Run WinogradConv Int8";
-  } else {
-    impl_ = new GemmLikeConv<PRECISION(kInt8), PRECISION(kFloat)>;
-    // VLOG(3) << "Run GemmLikeConvInt8";
-  }
-  impl_->SetContext(std::move(this->ctx_));
-  impl_->SetParam(param);
-  impl_->PrepareForRun();
+  PrepareImpl();
   is_first_epoch_ = false;
 }
 
 template <>
 void ConvCompute<PRECISION(kInt8), PRECISION(kInt8)>::PrepareForRun() {
-  PARAM_INIT
-  if (param.groups == ic && ic == oc && kps_equal && pads_equal &&
-      no_dilation && flag_dw) {
-    impl_ = new DepthwiseConv<PRECISION(kInt8), PRECISION(kInt8)>;
-    // VLOG(3) << "Run DepthwiseConv Int8";
-  } else if (param.groups == 1 && kw == 3 && sw == 2 && sh == 2 &&
-             no_dilation && pads_equal && ks_equal && !ctx.has_dot()) {
-    impl_ = new DirectConv<PRECISION(kInt8), PRECISION(kInt8)>;
-    // VLOG(3) << "Run DirectConv Int8";
-  } else if (param.groups == 1 && kw == 3 && sw == 1 && no_dilation &&
-             pads_equal && ks_equal && !ctx.has_dot()) {
-    impl_ = new WinogradConv<PRECISION(kInt8), PRECISION(kInt8)>;
-    // VLOG(3) << "Run WinogradConv Int8";
+  PrepareImpl();
+  is_first_epoch_ = false;
+}
+
+template class ConvCompute<PRECISION(kFloat), PRECISION(kFloat)>;
+template class ConvCompute<PRECISION(kInt8), PRECISION(kFloat)>;
+template class ConvCompute<PRECISION(kInt8), PRECISION(kInt8)>;
+
+// The weights are bf16 only for the gemm-like conv on the cpus supporting the
+// bf16 instructions, the other convs decode them and run in fp32.
+template <>
+void ConvCompute<PRECISION(kBF16), PRECISION(kFloat)>::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto shape = GetConvShape(param);
+  auto algorithm =
+      GetConvAlgorithm(param, PRECISION(kBF16), shape, ctx.has_dot());
+  if (ctx.has_bf16() && algorithm == ConvAlgorithm::kGemmLike &&
+      param.second_x == nullptr &&
+      lite::arm::math::bf16::gemm_bf16_support_act(param.activation_param)) {
+    lite::arm::math::bf16::tensor_fp32_to_bf16(param.filter);
+    impl_ = new GemmLikeConv<PRECISION(kBF16), PRECISION(kFloat)>;
   } else {
-    impl_ = new GemmLikeConv<PRECISION(kInt8), PRECISION(kInt8)>;
-    // VLOG(3) << "Run GemmLikeConvInt8";
+    lite::arm::math::bf16::tensor_bf16_to_fp32(param.filter);
+    impl_ = CreateConvImpl<PRECISION(kFloat), PRECISION(kFloat)>(algorithm);
   }
   impl_->SetContext(std::move(this->ctx_));
   impl_->SetParam(param);
@@ -138,30 +236,7 @@ void ConvCompute<PRECISION(kInt8), PRECISION(kInt8)>::PrepareForRun() {
 #ifdef ENABLE_ARM_FP16
 template <>
 void ConvCompute<PRECISION(kFP16), PRECISION(kFP16)>::PrepareForRun() {
-  PARAM_INIT
-  /// select conv impl
-  auto act_param = param.activation_param;
-  auto act_type = act_param.active_type;
-  bool has_active = act_param.has_active;
-  bool pads_less = ((paddings[1] < 2) && (paddings[3] < 2));
-  bool conv_3x3_wino = (ic <= 8) || (oc <= 8);
-  bool stride_less = (sw == 1) || (sw == 2);
-  if (param.groups == ic && ic == oc && no_dilation && stride_less &&
-      ((flag_dw_5x5 && ks_equal) || (flag_dw_3x3 && kps_equal && pads_less))) {
-    impl_ = new DepthwiseConv<PRECISION(kFP16), PRECISION(kFP16)>;
-  } else if (param.groups == 1 && kw == 3 && sw == 2 && no_dilation &&
-             chin * chout < 4 * hin * win && ks_equal) {
-    impl_ = new DirectConv<PRECISION(kFP16), PRECISION(kFP16)>;
-  } else if (param.groups == 1 && kw == 3 && sw == 1 && no_dilation &&
-             ks_equal) {
-    if (conv_3x3_wino) {
-      impl_ = new DirectConv<PRECISION(kFP16), PRECISION(kFP16)>;
-    } else {
-      impl_ = new WinogradConv<PRECISION(kFP16), PRECISION(kFP16)>;
-    }
-  } else {
-    impl_ = new GemmLikeConv<PRECISION(kFP16), PRECISION(kFP16)>;
-  }
+  auto& param = this->Param<param_t>();
   // when running op python unit_test, the weight dtype is float
   auto filter_tensor = param.filter;
   if (filter_tensor->precision() != PRECISION(kFP16)) {
@@ -174,11 +249,11 @@ void ConvCompute<PRECISION(kFP16), PRECISION(kFP16)>::PrepareForRun() {
     lite::arm::math::fp16::fp32_to_fp16(
         in_data, fp_data, filter_tensor->numel());
   }
-  impl_->SetContext(std::move(this->ctx_));
-  impl_->SetParam(param);
-  impl_->PrepareForRun();
+  PrepareImpl();
   is_first_epoch_ = false;
 }
+
+template class ConvCompute<PRECISION(kFP16), PRECISION(kFP16)>;
 #endif
 }  // namespace arm
 }  // namespace kernels
@@ -194,6 +269,9 @@ typedef paddle::lite::kernels::arm::ConvCompute<PRECISION(kInt8),
 typedef paddle::lite::kernels::arm::ConvCompute<PRECISION(kInt8),
                                                 PRECISION(kInt8)>
     ConvInt8_Int8;
+typedef paddle::lite::kernels::arm::ConvCompute<PRECISION(kBF16),
+                                                PRECISION(kFloat)>
+    ConvBf16_Fp32;
 
 #ifdef ENABLE_ARM_FP16
 typedef paddle::lite::kernels::arm::ConvCompute<PRECISION(kFP16),
@@ -241,6 +319,34 @@ REGISTER_LITE_KERNEL(depthwise_conv2d, kARM, kFloat, kNCHW, ConvFp32, def)
     .BindPaddleOpVersion("depthwise_conv2d", 1)
     .Finalize();
 
+// The activations of the bf16 conv are fp32, and the filter is converted to
+// bf16 when loaded, see bf16_attribute_pass.
+REGISTER_LITE_KERNEL(conv2d, kARM, kBF16, kNCHW, ConvBf16_Fp32, def)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindInput("SecondInput",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindInput("Prelu_alpha",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kAny))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindPaddleOpVersion("conv2d", 1)
+    .Finalize();
+
+REGISTER_LITE_KERNEL(depthwise_conv2d, kARM, kBF16, kNCHW, ConvBf16_Fp32, def)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindInput("Prelu_alpha",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kAny))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindPaddleOpVersion("depthwise_conv2d", 1)
+    .Finalize();
+
 REGISTER_LITE_KERNEL(conv2d, kARM, kInt8, kNCHW, ConvInt8_Int8, int8_out)
     .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
     .BindInput("SecondInput",
@@ -13,8 +13,13 @@
 // limitations under the License.
 
 #pragma once
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 #include "lite/backends/arm/math/funcs.h"
 #include "lite/core/kernel.h"
+#include "lite/operators/conv_algorithm.h"
 #ifdef LITE_WITH_PROFILE
 #include "lite/core/profile/profiler.h"
 #endif
@@ -30,11 +35,17 @@ class ConvCompute : public KernelLite<TARGET(kARM), Ptype> {
   virtual void PrepareForRun();
 
   virtual void ReInitWhenNeeded() {
+    // The candidates are reinitialized when tuned.
+    if (!candidates_.empty()) return;
     CHECK(impl_);
     impl_->ReInitWhenNeeded();
   }
 
   virtual void Run() {
+    if (!candidates_.empty()) {
+      Tune();
+      return;
+    }
     CHECK(impl_);
     impl_->Run();
   }
@@ -54,7 +65,19 @@ class ConvCompute : public KernelLite<TARGET(kARM), Ptype> {
 
  private:
   using param_t = operators::ConvParam;
-  KernelLite<TARGET(kARM), Ptype>* impl_{nullptr};
+  // The bf16 conv may run an fp32 implementation.
+  using impl_t = KernelBase;
+
+  // Prepare the selected implementation, or all the candidates to be timed
+  // on the first run in the tune mode.
+  void PrepareImpl();
+  // Keep the fastest candidate as the implementation.
+  void Tune();
+
+  impl_t* impl_{nullptr};
+  std::vector<std::pair<operators::ConvAlgorithm, std::unique_ptr<impl_t>>>
+      candidates_;
+  std::string tune_key_;
 };
 
 }  // namespace arm
@@ -46,6 +46,8 @@ void GemmLikeConv<PRECISION(kInt8), PRECISION(kFloat)>::PrepareForRun() {
   for (auto& ws : w_scale_) {
     ws *= input_scale;
   }
+  residual_scale_ = param.second_x_scale;
+  FoldInputZeroPoint();
 }
 
 template <>
@@ -78,6 +80,8 @@ void GemmLikeConv<PRECISION(kInt8), PRECISION(kInt8)>::PrepareForRun() {
     }
     flag_trans_bias_ = true;
   }
+  FoldInputZeroPoint();
+  residual_scale_ = param.second_x_scale / output_scale;
   //! update relu6 parameter
   if (param.activation_param.active_type == lite_api::ActivationType::kRelu6) {
     param.activation_param.Relu_clipped_coef =
@@ -100,9 +104,13 @@ void GemmLikeConv<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   auto& param = this->Param<param_t>();
   auto& ctx = this->ctx_->template As<ARMContext>();
   ctx.ExtendWorkspace(workspace_size_);
-  auto weights = param.filter->data<float>();
+  const float* weights = nullptr;
   if (flag_trans_weights_) {
     weights = weights_.data<float>();
+  } else if (param.filter->precision() == PRECISION(kInt8)) {
+    weights = dequant_weights_.data<float>();
+  } else {
+    weights = param.filter->data<float>();
   }
   const float* bias = param.bias ? param.bias->data<float>() : nullptr;
   if (flag_trans_bias_) {
@@ -162,6 +170,11 @@ void GemmLikeConv<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
   int oh = o_dims[2];
   int ow = o_dims[3];
   int oc = o_dims[1];
+  // The activation is applied after adding the residual in place.
+  auto act_param = param.activation_param;
+  if (param.second_x) {
+    param.activation_param = operators::ActivationParam();
+  }
   if (flag_1x1gemm_) {
     lite::arm::math::conv1x1s1_gemm_int8(din,
                                          dout,
@@ -195,6 +208,16 @@ void GemmLikeConv<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
                                            w_scale_.data());
     KERNEL_FUNC_NAME("conv_im2col_gemm_int8")
   }
+  if (param.second_x) {
+    param.activation_param = act_param;
+    lite::arm::math::gemm_int8_add_residual(dout,
+                                            param.second_x->data<int8_t>(),
+                                            dout,
+                                            residual_scale_,
+                                            act_param,
+                                            bs * oc * oh * ow,
+                                            &ctx);
+  }
 }
 
 PROFILE_INFO(kInt8, kInt8)
@@ -226,6 +249,62 @@ void GemmLikeConv<PRECISION(kInt8), PRECISION(kInt8)>::Run() {
   int oh = o_dims[2];
   int ow = o_dims[3];
   int oc = o_dims[1];
+  if (param.second_x) {
+    // Each batch is computed into the fp32 workspace behind the one of the
+    // im2col without the activation, which is applied after adding the
+    // residual and before rounding to int8.
+    int out_size = oc * oh * ow;
+    ctx.ExtendWorkspace(workspace_size_ + out_size * sizeof(float));
+    auto act_param = param.activation_param;
+    param.activation_param = operators::ActivationParam();
+    auto residual = param.second_x->data<int8_t>();
+    for (int b = 0; b < bs; ++b) {
+      float* dout_fp32 = reinterpret_cast<float*>(
+          ctx.workspace_data<int8_t>() + ctx.llc_size() + workspace_size_);
+      const int8_t* din_batch = din + b * ic * ih * iw;
+      if (flag_1x1gemm_) {
+        lite::arm::math::conv1x1s1_gemm_int8(din_batch,
+                                             dout_fp32,
+                                             1,
+                                             oc,
+                                             oh,
+                                             ow,
+                                             ic,
+                                             ih,
+                                             iw,
+                                             weights,
+                                             bias,
+                                             param,
+                                             &ctx,
+                                             w_scale_.data());
+      } else {
+        lite::arm::math::conv_im2col_gemm_int8(din_batch,
+                                               dout_fp32,
+                                               1,
+                                               oc,
+                                               oh,
+                                               ow,
+                                               ic,
+                                               ih,
+                                               iw,
+                                               weights,
+                                               bias,
+                                               param,
+                                               &ctx,
+                                               w_scale_.data());
+      }
+      lite::arm::math::gemm_int8_add_residual(dout_fp32,
+                                              residual + b * out_size,
+                                              dout + b * out_size,
+                                              residual_scale_,
+                                              act_param,
+                                              out_size,
+                                              &ctx);
+    }
+    param.activation_param = act_param;
+    KERNEL_FUNC_NAME("conv_gemm_int8_add_residual")
+    return;
+  }
   if (flag_1x1gemm_) {
     lite::arm::math::conv1x1s1_gemm_int8(din,
                                          dout,
@@ -261,6 +340,48 @@ void GemmLikeConv<PRECISION(kInt8), PRECISION(kInt8)>::Run() {
   }
 }
 
+template <>
+void GemmLikeConv<PRECISION(kBF16), PRECISION(kFloat)>::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  CHECK(param.filter->precision() == PRECISION(kBF16))
+      << "The filter of the bf16 conv must be converted to bf16 first";
+  ReInitWhenNeeded();
+}
+
+template <>
+void GemmLikeConv<PRECISION(kBF16), PRECISION(kFloat)>::Run() {
+  auto& param = this->Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  ctx.ExtendWorkspace(workspace_size_);
+  CHECK(flag_trans_weights_);
+  auto weights = weights_.data<uint16_t>();
+  const float* bias = param.bias ? param.bias->data<float>() : nullptr;
+  auto din = param.x->data<float>();
+  auto dout = param.output->mutable_data<float>();
+
+  auto x_dims = param.x->dims();
+  auto o_dims = param.output->dims();
+
+  int iw = x_dims[3];  // nchw
+  int ih = x_dims[2];
+  int ic = x_dims[1];
+  int bs = x_dims[0];
+  int oh = o_dims[2];
+  int ow = o_dims[3];
+  int oc = o_dims[1];
+  if (flag_1x1gemm_) {
+    lite::arm::math::bf16::conv1x1s1_gemm_bf16(
+        din, dout, bs, oc, oh, ow, ic, ih, iw, weights, bias, param, &ctx);
+    KERNEL_FUNC_NAME("conv1x1s1_gemm_bf16")
+  } else {
+    lite::arm::math::bf16::conv_im2col_gemm_bf16(
+        din, dout, bs, oc, oh, ow, ic, ih, iw, weights, bias, param, &ctx);
+    KERNEL_FUNC_NAME("conv_im2col_gemm_bf16")
+  }
+}
+
+PROFILE_INFO(kBF16, kFloat)
+
 #ifdef ENABLE_ARM_FP16
 template <>
 void GemmLikeConv<PRECISION(kFP16), PRECISION(kFP16)>::PrepareForRun() {
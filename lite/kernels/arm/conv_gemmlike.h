@@ -17,11 +17,14 @@
 #include <cmath>
 #include <string>
 #include <vector>
+#include "lite/backends/arm/math/bf16/funcs_bf16.h"
 #include "lite/backends/arm/math/conv_impl.h"
 #include "lite/backends/arm/math/funcs.h"
 #include "lite/core/context.h"
 #include "lite/core/kernel.h"
+#include "lite/core/packed_weight_cache.h"
 #include "lite/core/target_wrapper.h"
+#include "lite/utils/hash.h"
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
 #endif
@@ -83,22 +86,67 @@ class GemmLikeConv : public KernelLite<TARGET(kARM), Ptype> {
       //! im2col gemmlike conv
       flag_1x1gemm_ = false;
       workspace_size_ = k * n * sizeof(float);
+      // the large im2col is computed by the bands of output rows, and the
+      // int8 gemm writes each band behind its im2col
+      int type_size = Ptype == PRECISION(kInt8)
+                          ? 1
+                          : (Ptype == PRECISION(kFP16) ? 2 : 4);
+      int rows = lite::arm::math::im2col_band_rows(
+          kh, kw, k, oh, ow, type_size, &ctx);
+      if (Ptype != PRECISION(kBF16) && rows < oh) {
+        workspace_size_ = k * rows * ow * sizeof(float);
+        if (Ptype == PRECISION(kInt8)) {
+          workspace_size_ += m * rows * ow * sizeof(float) + 16;
+        }
+      }
     }
-    if (!flag_trans_weights_ && n > 1 && m > 1) {
-      if (param.filter->precision() == PrecisionType::kFP16) {
+    // The bf16 weights are always packed, there is no bf16 gemv.
+    bool pack_weights = Ptype == PRECISION(kBF16) || (n > 1 && m > 1);
+    // The weight-only int8 filter of the fp32 conv is kept in int8 in the
+    // scope, and dequantized while packing it, or for the gemv.
+    bool weight_only = Ptype == PRECISION(kFloat) &&
+                       param.filter->precision() == PrecisionType::kInt8;
+    if (!flag_trans_weights_ && pack_weights) {
+      std::string kernel = "conv_gemmlike/" + PrecisionToStr(Ptype) +
+                           "/groups:" + std::to_string(param.groups);
+      if (weight_only) {
+        // the packed weight depends on the scales as well
+        kernel += "/int8_weight:" +
+                  std::to_string(HashBytes(
+                      param.weight_quant_scale.data(),
+                      param.weight_quant_scale.size() * sizeof(float)));
+      }
+      PackedWeightCache::Global().Pack(
+          kernel,
+          *(param.filter),
+          &weights_,
+          [&] {
+            if (param.filter->precision() == PrecisionType::kFP16) {
 #ifdef ENABLE_ARM_FP16
-        lite::arm::math::fp16::trans_gemm_weights_fp16(
-            *(param.filter), weights_, param.groups, &ctx);
+              lite::arm::math::fp16::trans_gemm_weights_fp16(
+                  *(param.filter), weights_, param.groups, &ctx);
 #else
-        LOG(FATAL) << "FP16 conv must open ENABLE_ARM_FP16";
+              LOG(FATAL) << "FP16 conv must open ENABLE_ARM_FP16";
 #endif
-      } else {
-        lite::arm::math::trans_gemm_weights<Ptype>(
-            *(param.filter), weights_, param.groups, &ctx);
-      }
+            } else if (param.filter->precision() == PrecisionType::kBF16) {
+              lite::arm::math::bf16::trans_gemm_weights_bf16(
+                  *(param.filter), weights_, param.groups, &ctx);
+            } else if (weight_only) {
+              Tensor filter;
+              DequantizeFilter(param, &filter);
+              lite::arm::math::trans_gemm_weights<PRECISION(kFloat)>(
+                  filter, weights_, param.groups, &ctx);
+            } else {
+              lite::arm::math::trans_gemm_weights<Ptype>(
+                  *(param.filter), weights_, param.groups, &ctx);
+            }
+          });
       flag_trans_weights_ = true;
-    } else if (n == 1 || m == 1) {
+    } else if (!pack_weights) {
       flag_trans_weights_ = false;
+      if (weight_only && dequant_weights_.numel() == 0) {
+        DequantizeFilter(param, &dequant_weights_);
+      }
     }
     last_shape_ = x_dims;
   }
@@ -128,14 +176,62 @@ class GemmLikeConv : public KernelLite<TARGET(kARM), Ptype> {
   /// todo, support inplace weights transform
  protected:
   using param_t = operators::ConvParam;
+
+  // out = the fp32 filter dequantized by the scale of each output channel
+  static void DequantizeFilter(const param_t& param, Tensor* out) {
+    const auto& filter = *param.filter;
+    int64_t oc = filter.dims()[0];
+    int64_t size = filter.numel() / oc;
+    CHECK_EQ(param.weight_quant_scale.size(), static_cast<size_t>(oc))
+        << "The int8 filter should have the scale of each output channel";
+    out->Resize(filter.dims());
+    auto* out_data = out->mutable_data<float>();
+    const auto* in_data = filter.data<int8_t>();
+    for (int64_t i = 0; i < oc; i++) {
+      float scale = param.weight_quant_scale[i];
+      for (int64_t j = 0; j < size; j++) {
+        out_data[i * size + j] = in_data[i * size + j] * scale;
+      }
+    }
+  }
+
+  // Fold the zero point of the asymmetric int8 input into bias_, after the
+  // w_scale_ and the bias are updated for the output.
+  void FoldInputZeroPoint() {
+    auto& param = this->template Param<param_t>();
+    if (param.input_zero_point == 0) return;
+    int oc = param.filter->dims()[0];
+    const float* bias = nullptr;
+    if (flag_trans_bias_) {
+      bias = bias_.data<float>();
+    } else if (param.bias) {
+      bias = param.bias->template data<float>();
+    }
+    if (!flag_trans_bias_) bias_.Resize({oc});
+    lite::arm::math::fold_zero_point_bias(param.filter->template data<int8_t>(),
+                                          w_scale_.data(),
+                                          bias,
+                                          bias_.mutable_data<float>(),
+                                          param.input_zero_point,
+                                          oc,
+                                          param.filter->numel() / oc,
+                                          false);
+    flag_trans_bias_ = true;
+  }
+
   DDim last_shape_;
   std::vector<float> w_scale_;
   bool flag_1x1gemm_{true};
   bool flag_trans_weights_{false};
   bool flag_trans_bias_{false};
   Tensor weights_;
+  // the dequantized weight-only int8 filter for the gemv
+  Tensor dequant_weights_;
   Tensor bias_;
   int workspace_size_{0};
+  // The scale of the int8 second_x fused by the elementwise add, which is
+  // divided by the output scale for the int8 output.
+  float residual_scale_{1.f};
 };
 
 }  // namespace arm
@@ -0,0 +1,196 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/arm/conv_resample_compute.h"
+#include <algorithm>
+#include <cstring>
+#include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/host/math/conv_resample.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+void ConvResampleCompute::PrepareForRun() {
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto& param = this->Param<param_t>();
+  auto w_dims = param.filter->dims();
+  const int ic = param.x->dims()[1];
+  const int oc = w_dims[0];
+  const int group = param.groups;
+  auto& paddings = *param.paddings;
+  auto& dilations = *param.dilations;
+  flag_depthwise_ = group == ic && group == oc && w_dims[1] == 1;
+  flag_1x1gemm_ = w_dims[2] == 1 && w_dims[3] == 1 &&
+                  param.strides[0] == 1 && param.strides[1] == 1 &&
+                  paddings[0] == 0 && paddings[1] == 0 && paddings[2] == 0 &&
+                  paddings[3] == 0 && dilations[0] == 1 && dilations[1] == 1;
+  if (flag_depthwise_) return;
+  lite::arm::math::prepackA(&weights_,
+                            *param.filter,
+                            1.f,
+                            oc / group,
+                            w_dims[1] * w_dims[2] * w_dims[3],
+                            group,
+                            false,
+                            &ctx);
+}
+
+void ConvResampleCompute::Run() {
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto& param = this->Param<param_t>();
+  auto x_dims = param.x->dims();
+  auto w_dims = param.filter->dims();
+  auto o_dims = param.output->dims();
+  const bool pool = param.resample_type == "max_pool2x2";
+  const bool gap = param.resample_type == "global_avg_pool";
+  const int num = x_dims[0];
+  const int ic = x_dims[1];
+  const int ih = x_dims[2];
+  const int iw = x_dims[3];
+  const int oc = o_dims[1];
+  const int oh = o_dims[2];
+  const int ow = o_dims[3];
+  const int kh = w_dims[2];
+  const int kw = w_dims[3];
+  auto& paddings = *param.paddings;
+  auto& dilations = *param.dilations;
+  // the size of the conv output, the rows past the last pooling window are
+  // never read
+  const int ch = (ih + paddings[0] + paddings[1] -
+                  (dilations[0] * (kh - 1) + 1)) / param.strides[0] + 1;
+  const int cw = (iw + paddings[2] + paddings[3] -
+                  (dilations[1] * (kw - 1) + 1)) / param.strides[1] + 1;
+  const int conv_rows = pool ? 2 * oh : ch;
+  const int group = param.groups;
+  const int ocg = oc / group;
+  const int k = ic / group * kh * kw;
+
+  // rows of the conv output which take half of the L2 cache, even for the
+  // pooling
+  const int band_size = ctx.l2_cache_size() / 2 / sizeof(float);
+  int band = std::max(1, std::min(conv_rows, band_size / (oc * cw)));
+  if (pool) band = std::max(2, band / 2 * 2);
+  band_buf_.Resize({oc, band * cw});
+  float* buf = band_buf_.mutable_data<float>();
+  float* col = nullptr;
+  if (!flag_depthwise_ && !flag_1x1gemm_) {
+    col_buf_.Resize({group * k, band * cw});
+    col = col_buf_.mutable_data<float>();
+  }
+  const int hblock = lite::arm::math::get_hblock(&ctx, ocg);
+  const int m_roundup = hblock * ((ocg + hblock - 1) / hblock);
+  const int group_stride = ((m_roundup * k + 15) / 16) * 16;
+
+  const float* din = param.x->data<float>();
+  const float* bias = param.bias ? param.bias->data<float>() : nullptr;
+  float* dout = param.output->mutable_data<float>();
+  for (int n = 0; n < num; ++n) {
+    const float* in = din + static_cast<int64_t>(n) * ic * ih * iw;
+    float* out = dout + static_cast<int64_t>(n) * oc * oh * ow;
+    if (gap) memset(out, 0, sizeof(float) * oc);
+    for (int r0 = 0; r0 < conv_rows; r0 += band) {
+      const int r1 = std::min(conv_rows, r0 + band);
+      const int cols = (r1 - r0) * cw;
+      if (flag_depthwise_) {
+        lite::arm::math::conv_depthwise_rows(in,
+                                             param.filter->data<float>(),
+                                             bias,
+                                             buf,
+                                             ic,
+                                             ih,
+                                             iw,
+                                             cw,
+                                             r0,
+                                             r1,
+                                             kh,
+                                             kw,
+                                             param.strides,
+                                             paddings,
+                                             dilations,
+                                             param.activation_param);
+      } else {
+        const float* b = in + r0 * cw;
+        int ldb = ih * iw;
+        if (!flag_1x1gemm_) {
+          lite::host::math::im2col_rows(in,
+                                        col,
+                                        ic,
+                                        ih,
+                                        iw,
+                                        cw,
+                                        r0,
+                                        r1,
+                                        kh,
+                                        kw,
+                                        param.strides,
+                                        paddings,
+                                        dilations);
+          b = col;
+          ldb = cols;
+        }
+        for (int g = 0; g < group; ++g) {
+          const float* g_bias = bias ? bias + g * ocg : nullptr;
+          lite::arm::math::sgemm_prepack(false,
+                                         ocg,
+                                         cols,
+                                         k,
+                                         weights_.data<float>() +
+                                             g * group_stride,
+                                         b + static_cast<int64_t>(g) * k * ldb,
+                                         ldb,
+                                         0.f,
+                                         buf + g * ocg * cols,
+                                         cols,
+                                         g_bias,
+                                         g_bias != nullptr,
+                                         param.activation_param,
+                                         &ctx);
+        }
+      }
+      if (pool) {
+        lite::host::math::max_pool2x2_rows(
+            buf, out, oc, r1 - r0, cw, r0, oh, ow);
+      } else if (gap) {
+        lite::host::math::global_sum_rows(buf, out, oc, cols);
+      } else {
+        lite::host::math::upsample_nearest2x_rows(
+            buf, out, oc, r1 - r0, cw, r0, oh, ow);
+      }
+    }
+    if (gap) {
+      const float scale = 1.f / (ch * cw);
+      for (int c = 0; c < oc; ++c) out[c] *= scale;
+    }
+  }
+}
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fusion_conv2d_resample,
+                     kARM,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::arm::ConvResampleCompute,
+                     def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Output", {LiteType::GetTensorTy(TARGET(kARM))})
+    .Finalize();
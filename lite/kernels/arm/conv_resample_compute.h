@@ -0,0 +1,50 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include "lite/core/kernel.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+// Runs the conv in bands of output rows which stay in the L2 cache, and
+// pools or upsamples each band into the output, so the full conv output is
+// never written.
+class ConvResampleCompute
+    : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::ConvResampleParam;
+
+  void PrepareForRun() override;
+
+  void Run() override;
+
+  virtual ~ConvResampleCompute() = default;
+
+ private:
+  bool flag_depthwise_{false};
+  bool flag_1x1gemm_{false};
+  // the filter packed for sgemm_prepack, per group
+  Tensor weights_;
+  Tensor band_buf_;
+  Tensor col_buf_;
+};
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
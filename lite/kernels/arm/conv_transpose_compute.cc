@@ -13,11 +13,14 @@
 // limitations under the License.
 
 #include "lite/kernels/arm/conv_transpose_compute.h"
+#include <utility>
 #include <vector>
 #include "lite/backends/arm/math/funcs.h"
 #include "lite/backends/arm/math/gemm_prepacked_int8.h"
 #include "lite/core/op_registry.h"
+#include "lite/core/parallel_defines.h"
 #include "lite/core/type_system.h"
+#include "lite/kernels/arm/conv_compute.h"
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
 #endif
@@ -62,6 +65,139 @@ namespace arm {
   din_batch, weights, chout, hout, wout, kh, kw, paddings[0], paddings[1], \
       paddings[2], paddings[3], dilations[0], dilations[1], dout_batch, &ctx
 
+namespace {
+inline int FloorDiv(int a, int b) {
+  return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+}  // namespace
+
+// The output row oy = iy * s + ky - pad_top of the deconv only takes the
+// kernel rows ky = r + j * s of the phase r = (oy + pad_top) % s, so the
+// rows of a phase are a stride-1 conv of the input with the flipped
+// sub-kernel of these rows, and the same for the cols.
+template <>
+bool Conv2DTransposeCompute<PRECISION(kFloat),
+                            PRECISION(kFloat)>::PrepareSubPixel() {
+  auto& param = this->Param<param_t>();
+  auto x_dims = param.x->dims();
+  auto w_dims = param.filter->dims();
+  auto o_dims = param.output->dims();
+  auto paddings = *param.paddings;
+  auto dilations = *param.dilations;
+  int chin = x_dims[1];
+  int chout = o_dims[1];
+  int kh = w_dims[2];
+  int kw = w_dims[3];
+  int sh = param.strides[0];
+  int sw = param.strides[1];
+  subpixel_ = false;
+  phases_.clear();
+  if (param.groups != 1 || sh < 2 || sw < 2 || kh < sh || kw < sw ||
+      dilations[0] != 1 || dilations[1] != 1) {
+    return false;
+  }
+  const int in_size[2] = {static_cast<int>(x_dims[2]),
+                          static_cast<int>(x_dims[3])};
+  const int out_size[2] = {static_cast<int>(o_dims[2]),
+                           static_cast<int>(o_dims[3])};
+  const int ksize[2] = {kh, kw};
+  const int stride[2] = {sh, sw};
+  const float* weights = param.filter->data<float>();
+  for (int ry = 0; ry < sh; ry++) {
+    for (int rx = 0; rx < sw; rx++) {
+      std::unique_ptr<SubPixelPhase> phase(new SubPixelPhase);
+      const int r[2] = {ry, rx};
+      int sub_k[2];
+      int sub_out[2];
+      int sub_pads[4];
+      int offset[2];
+      for (int d = 0; d < 2; d++) {
+        int pad = paddings[2 * d];
+        sub_k[d] = (ksize[d] - r[d] + stride[d] - 1) / stride[d];
+        // the first and the last input positions of the phase
+        int q0 = -FloorDiv(r[d] - pad, stride[d]);
+        int q1 = FloorDiv(out_size[d] - 1 + pad - r[d], stride[d]);
+        sub_out[d] = q1 - q0 + 1;
+        sub_pads[2 * d] = sub_k[d] - 1 - q0;
+        sub_pads[2 * d + 1] = q1 + 1 - in_size[d];
+        offset[d] = q0 * stride[d] + r[d] - pad;
+        if (sub_out[d] < 1 || sub_pads[2 * d] < 0 || sub_pads[2 * d + 1] < 0) {
+          phases_.clear();
+          return false;
+        }
+      }
+      phase->offset_h = offset[0];
+      phase->offset_w = offset[1];
+      phase->filter.Resize({chout, chin, sub_k[0], sub_k[1]});
+      float* sub_w = phase->filter.mutable_data<float>();
+      for (int oc = 0; oc < chout; oc++) {
+        for (int ic = 0; ic < chin; ic++) {
+          const float* w = weights + (ic * chout + oc) * kh * kw;
+          for (int j = 0; j < sub_k[0]; j++) {
+            int y = ry + (sub_k[0] - 1 - j) * sh;
+            for (int i = 0; i < sub_k[1]; i++) {
+              int x = rx + (sub_k[1] - 1 - i) * sw;
+              *sub_w++ = w[y * kw + x];
+            }
+          }
+        }
+      }
+      phase->out.Resize({x_dims[0], chout, sub_out[0], sub_out[1]});
+      phase->param = param;
+      phase->param.filter = &phase->filter;
+      phase->param.output = &phase->out;
+      phase->param.strides = {1, 1};
+      phase->param.paddings = std::make_shared<std::vector<int>>(
+          std::vector<int>(sub_pads, sub_pads + 4));
+      phase->param.dilations = std::make_shared<std::vector<int>>(
+          std::vector<int>{1, 1});
+      phase->param.conv_algorithm.clear();
+      phase->conv.reset(new ConvCompute<PRECISION(kFloat), PRECISION(kFloat)>);
+      phase->conv->SetContext(
+          ContextScheduler::Global().NewContext(TARGET(kARM)));
+      phase->conv->SetParam(phase->param);
+      phase->conv->PrepareForRun();
+      phases_.push_back(std::move(phase));
+    }
+  }
+  subpixel_ = true;
+  subpixel_shape_ = x_dims;
+  return true;
+}
+
+template <>
+void Conv2DTransposeCompute<PRECISION(kFloat),
+                            PRECISION(kFloat)>::RunSubPixel() {
+  auto& param = this->Param<param_t>();
+  auto o_dims = param.output->dims();
+  int hout = o_dims[2];
+  int wout = o_dims[3];
+  int sh = param.strides[0];
+  int sw = param.strides[1];
+  int channels = o_dims[0] * o_dims[1];
+  float* dout = param.output->mutable_data<float>();
+  for (auto& phase : phases_) {
+    phase->conv->ReInitWhenNeeded();
+    phase->conv->Run();
+    int ph = phase->out.dims()[2];
+    int pw = phase->out.dims()[3];
+    const float* pout = phase->out.data<float>();
+    float* dst = dout + phase->offset_h * wout + phase->offset_w;
+    LITE_PARALLEL_BEGIN(c, tid, channels) {
+      const float* src_c = pout + c * ph * pw;
+      float* dst_c = dst + c * hout * wout;
+      for (int i = 0; i < ph; i++) {
+        float* dst_row = dst_c + i * sh * wout;
+        for (int j = 0; j < pw; j++) {
+          dst_row[j * sw] = src_c[j];
+        }
+        src_c += pw;
+      }
+    }
+    LITE_PARALLEL_END();
+  }
+}
+
 template <>
 void Conv2DTransposeCompute<PRECISION(kFloat),
                             PRECISION(kFloat)>::PrepareForRun() {
@@ -69,8 +205,7 @@ void Conv2DTransposeCompute<PRECISION(kFloat),
 
   auto& ctx = this->ctx_->template As<ARMContext>();
   DEPTHWISE_PARAM
-  if (!depth_wise_s1 && !depth_wise_s2) {
-    lite::Tensor tmp_weights;
+  if (!depth_wise_s1 && !depth_wise_s2 && !PrepareSubPixel()) {
     flag_trans_weight_ = true;
     lite::arm::math::prepackA(
         &weights_, *(param.filter), 1.f, m, k, group, true, &ctx);
@@ -166,6 +301,16 @@ template <>
 void Conv2DTransposeCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   auto& ctx = this->ctx_->template As<ARMContext>();
   INIT_PARAM
+  if (subpixel_) {
+    if (subpixel_shape_ == x_dims || PrepareSubPixel()) {
+      RunSubPixel();
+      return;
+    }
+    // the new shape falls back to the gemm and col2im
+    flag_trans_weight_ = true;
+    lite::arm::math::prepackA(
+        &weights_, *(param.filter), 1.f, m, k, group, true, &ctx);
+  }
   ctx.ExtendWorkspace((workspace_size_ * sizeof(float)));
   bool flag_bias = (param.bias != nullptr);
   auto paddings = *param.paddings;
@@ -292,9 +437,11 @@ void Conv2DTransposeCompute<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
   int group_channel_out = chout / group;
 
   bool pads_all_qual = pads_equal && (paddings[0] == paddings[2]);
-  int hblock = lite::arm::math::get_hblock(&ctx, m);
+  // the same as the weights packed by prepackA_int8
+  int hblock = lite::arm::math::get_hblock_int8(&ctx);
   int m_roundup = hblock * ((m + hblock - 1) / hblock);
-  int group_size_weights = ((m_roundup * k + 15) / 16) * 16;
+  int k_roundup = ROUNDUP(k, lite::arm::math::get_kblock_int8(&ctx));
+  int group_size_weights = ((m_roundup * k_roundup + 15) / 16) * 16;
   bool flag_1x1s1p1 = (kw == 1) && (kh == 1) && (param.strides[0] == 1) &&
                       (param.strides[1] == 1) && pads_all_qual &&
                       (paddings[0] == 0) && (dilations[0] == 1) &&
@@ -391,9 +538,11 @@ void Conv2DTransposeCompute<PRECISION(kInt8), PRECISION(kInt8)>::Run() {
   int group_channel_out = chout / group;
 
   bool pads_all_qual = pads_equal && (paddings[0] == paddings[2]);
-  int hblock = lite::arm::math::get_hblock(&ctx, m);
+  // the same as the weights packed by prepackA_int8
+  int hblock = lite::arm::math::get_hblock_int8(&ctx);
   int m_roundup = hblock * ((m + hblock - 1) / hblock);
-  int group_size_weights = ((m_roundup * k + 15) / 16) * 16;
+  int k_roundup = ROUNDUP(k, lite::arm::math::get_kblock_int8(&ctx));
+  int group_size_weights = ((m_roundup * k_roundup + 15) / 16) * 16;
   bool flag_1x1s1p1 = (kw == 1) && (kh == 1) && (param.strides[0] == 1) &&
                       (param.strides[1] == 1) && pads_all_qual &&
                       (paddings[0] == 0) && (dilations[0] == 1) &&
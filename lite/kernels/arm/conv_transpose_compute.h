@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <memory>
 #include <string>
 #include <vector>
 #include "lite/backends/arm/math/funcs.h"
@@ -78,6 +79,22 @@ class Conv2DTransposeCompute : public KernelLite<TARGET(kARM), Ptype> {
 #endif
 
  protected:
+  // The stride-s fp32 deconv is computed by s*s convs of the sub-kernels,
+  // one for each phase of the output rows and cols, written interleaved.
+  struct SubPixelPhase {
+    // the first output row and col of the phase
+    int offset_h{0};
+    int offset_w{0};
+    Tensor filter;
+    Tensor out;
+    operators::ConvParam param;
+    std::unique_ptr<KernelBase> conv;
+  };
+  // Build the phase convs for the current shape, return false if the
+  // deconv is not supported by them.
+  bool PrepareSubPixel();
+  void RunSubPixel();
+
   int workspace_size_{0};
   bool depthwise_{false};
   bool flag_trans_bias_{false};
@@ -86,6 +103,9 @@ class Conv2DTransposeCompute : public KernelLite<TARGET(kARM), Ptype> {
   DDim last_shape_;
   Tensor bias_;
   Tensor weights_;
+  bool subpixel_{false};
+  DDim subpixel_shape_;
+  std::vector<std::unique_ptr<SubPixelPhase>> phases_;
 };
 
 }  // namespace arm
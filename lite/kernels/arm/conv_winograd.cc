@@ -15,6 +15,7 @@
 #include "lite/kernels/arm/conv_winograd.h"
 #include "lite/backends/arm/math/conv_impl.h"
 #include "lite/backends/arm/math/packed_sgemm.h"
+#include "lite/core/packed_weight_cache.h"
 
 namespace paddle {
 namespace lite {
@@ -84,31 +85,38 @@ void WinogradConv<PRECISION(kFloat), PRECISION(kFloat)>::ReInitWhenNeeded() {
   last_function_ = -1;
 
   //! update trans weights impl
-  weights_.Resize({1, 1, 1, wino_iw * wino_iw * oc_pad * ic_pad});
-  void* trans_tmp_ptr = malloc(sizeof(float) * wino_iw * wino_iw * oc * ic);
-  auto weights_data_ = weights_.mutable_data<float>();
-  memset(reinterpret_cast<char*>(weights_data_),
-         0,
-         weights_.numel() * sizeof(float));
-  switch (wino_iw) {
-    case 8:
-      lite::arm::math::weight_trans_c4_8x8(
-          weights_data_, param.filter->data<float>(), ic, oc, trans_tmp_ptr);
-      break;
-    case 6:
-      lite::arm::math::weight_trans_c4_6x6(
-          weights_data_, param.filter->data<float>(), ic, oc, trans_tmp_ptr);
-      break;
-    case 4:
-      lite::arm::math::weight_trans_c4_4x4(
-          weights_data_, param.filter->data<float>(), ic, oc, trans_tmp_ptr);
-      break;
-    default:
-      lite::arm::math::weight_trans_c4_8x8(
-          weights_data_, param.filter->data<float>(), ic, oc, trans_tmp_ptr);
-  }
+  auto pack = [&] {
+    weights_.Resize({1, 1, 1, wino_iw * wino_iw * oc_pad * ic_pad});
+    void* trans_tmp_ptr = malloc(sizeof(float) * wino_iw * wino_iw * oc * ic);
+    auto weights_data_ = weights_.mutable_data<float>();
+    memset(reinterpret_cast<char*>(weights_data_),
+           0,
+           weights_.numel() * sizeof(float));
+    switch (wino_iw) {
+      case 8:
+        lite::arm::math::weight_trans_c4_8x8(
+            weights_data_, param.filter->data<float>(), ic, oc, trans_tmp_ptr);
+        break;
+      case 6:
+        lite::arm::math::weight_trans_c4_6x6(
+            weights_data_, param.filter->data<float>(), ic, oc, trans_tmp_ptr);
+        break;
+      case 4:
+        lite::arm::math::weight_trans_c4_4x4(
+            weights_data_, param.filter->data<float>(), ic, oc, trans_tmp_ptr);
+        break;
+      default:
+        lite::arm::math::weight_trans_c4_8x8(
+            weights_data_, param.filter->data<float>(), ic, oc, trans_tmp_ptr);
+    }
 
-  free(trans_tmp_ptr);
+    free(trans_tmp_ptr);
+  };
+  PackedWeightCache::Global().Pack(
+      "conv_winograd/fp32/wino:" + std::to_string(wino_iw),
+      *param.filter,
+      &weights_,
+      pack);
 }
 
 template <>
@@ -213,28 +221,36 @@ void WinogradConv<PRECISION(kInt8), OutType>::ReInitWhenNeeded() {
     }
   }
 
+  //! update trans weights impl
+  // choose_small_ = ow * oh / (tile_block * threads) < 36 ? true : false;
+  // select best wino_unit
+  int wino_unit = ow * oh / (tile_block * threads);
+  int new_wino_iw = wino_unit < 16 ? 4 : 6;
+
+  // Only F(2,3) keeps the whole int32 output in c8, F(4,3) requantizes the
+  // tiles into the output directly.
   const int new_input_size =
       ic_pad * (ih + pad_h0 + pad_h1) * (iw + pad_w0 + pad_w1) +
-      oc_pad * oh * ow * sizeof(int32_t);
+      (new_wino_iw == 4 ? oc_pad * oh * ow * sizeof(int32_t) : 0);
   int tmp_input_thread_size_byte =
-      tile_block * ic_pad * wino_iw * wino_iw * sizeof(int16_t);
+      tile_block * ic_pad * new_wino_iw * new_wino_iw * sizeof(int16_t);
   int tmp_output_thread_size_byte =
-      tile_block * oc_pad * wino_iw * wino_iw * sizeof(int32_t);
-  int tmp_trans_size_byte = wino_iw * wino_iw * sizeof(int16_t) * 8;
-  int tmp_remain_trans_size_byte = wino_iw * wino_iw * sizeof(int8_t) * 8;
-  int tmp_trans_out_size_byte = wino_iw * (wino_iw - 2) * sizeof(int32_t) * 8;
+      tile_block * oc_pad * new_wino_iw * new_wino_iw * sizeof(int32_t);
+  int tmp_trans_size_byte = new_wino_iw * new_wino_iw * sizeof(int16_t) * 8;
+  int tmp_remain_trans_size_byte =
+      new_wino_iw * new_wino_iw * sizeof(int8_t) * 8;
+  int tmp_trans_out_size_byte =
+      new_wino_iw * (new_wino_iw - 2) * sizeof(int32_t) * 8;
   int tmp_remain_trans_out_size_byte =
-      (wino_iw - 2) * (wino_iw - 2) * sizeof(int32_t) * 8;
+      (new_wino_iw - 2) * (new_wino_iw - 2) * sizeof(int32_t) * 8;
+  // the padded channels of the last c8 block written by F(4,3)
+  int tmp_trash_size_byte = 8 * sizeof(float);
   const int temp_size = tmp_input_thread_size_byte +
                         tmp_output_thread_size_byte + tmp_trans_size_byte +
                         tmp_remain_trans_size_byte + tmp_trans_out_size_byte +
-                        tmp_remain_trans_out_size_byte;
-  workspace_size_ = (temp_size + new_input_size) * 2;
+                        tmp_remain_trans_out_size_byte + tmp_trash_size_byte;
+  workspace_size_ = (temp_size * threads + new_input_size) * 2;
 
-  //! update trans weights impl
-  // choose_small_ = ow * oh / (tile_block * threads) < 36 ? true : false;
-  // select best wino_unit
-  int wino_unit = ow * oh / (tile_block * threads);
   if (wino_unit < 16) {
     wino_iw = 4;
     if (last_function_ == 0) {
@@ -256,38 +272,45 @@ void WinogradConv<PRECISION(kInt8), OutType>::ReInitWhenNeeded() {
   }
   last_function_ = -1;
 
-  weights_.Resize({1, 1, 1, wino_iw * wino_iw * oc_pad * ic_pad});
-  void* trans_tmp_ptr = malloc(sizeof(int32_t) * wino_iw * wino_iw * oc * ic);
-  auto weights_data_ = weights_.mutable_data<int16_t>();
-  memset(reinterpret_cast<char*>(weights_data_),
-         0,
-         weights_.numel() * sizeof(int16_t));
-  switch (wino_iw) {
-    case 4:
-      lite::arm::math::weight_trans_c8_4x4_int8(
-          weights_data_,
-          param.filter->template data<int8_t>(),
-          ic,
-          oc,
-          trans_tmp_ptr);
-      break;
-    case 6:
-      lite::arm::math::weight_trans_c8_6x6_int8(
-          weights_data_,
-          param.filter->template data<int8_t>(),
-          ic,
-          oc,
-          trans_tmp_ptr);
-      break;
-    default:
-      lite::arm::math::weight_trans_c8_6x6_int8(
-          weights_data_,
-          param.filter->template data<int8_t>(),
-          ic,
-          oc,
-          trans_tmp_ptr);
-  }
-  free(trans_tmp_ptr);
+  auto pack = [&] {
+    weights_.Resize({1, 1, 1, wino_iw * wino_iw * oc_pad * ic_pad});
+    void* trans_tmp_ptr = malloc(sizeof(int32_t) * wino_iw * wino_iw * oc * ic);
+    auto weights_data_ = weights_.mutable_data<int16_t>();
+    memset(reinterpret_cast<char*>(weights_data_),
+           0,
+           weights_.numel() * sizeof(int16_t));
+    switch (wino_iw) {
+      case 4:
+        lite::arm::math::weight_trans_c8_4x4_int8(
+            weights_data_,
+            param.filter->template data<int8_t>(),
+            ic,
+            oc,
+            trans_tmp_ptr);
+        break;
+      case 6:
+        lite::arm::math::weight_trans_c8_6x6_int8(
+            weights_data_,
+            param.filter->template data<int8_t>(),
+            ic,
+            oc,
+            trans_tmp_ptr);
+        break;
+      default:
+        lite::arm::math::weight_trans_c8_6x6_int8(
+            weights_data_,
+            param.filter->template data<int8_t>(),
+            ic,
+            oc,
+            trans_tmp_ptr);
+    }
+    free(trans_tmp_ptr);
+  };
+  PackedWeightCache::Global().Pack(
+      "conv_winograd/int8/wino:" + std::to_string(wino_iw),
+      *param.filter,
+      &weights_,
+      pack);
 }
 
 template <PrecisionType OutType>
@@ -351,62 +374,70 @@ template class WinogradConv<PRECISION(kInt8), PRECISION(kFloat)>;
 template <>
 void WinogradConv<PRECISION(kFP16), PRECISION(kFP16)>::ReInitWhenNeeded() {
   WINOGRAD_INIT(8)
+  // select best wino_unit, F(6,3) only pays off its larger transforms with
+  // enough channels to amortize them
+  int wino_unit = ow * oh / (tile_block * threads);
+  int function = 0;
+  wino_iw = 4;
+  if (wino_unit >= 36 && ic >= 16 && oc >= 16) {
+    function = 2;
+    wino_iw = 8;
+  } else if (wino_unit >= 16) {
+    function = 1;
+    wino_iw = 6;
+  }
+
   const int new_input_size =
       ic_pad * (ih + pad_h0 + pad_h1) * (iw + pad_w0 + pad_w1);
   const int temp_size = (tile_block * (ic_pad + oc_pad) * wino_iw * wino_iw +
-                         8 * wino_iw * wino_iw) *
+                         2 * 8 * wino_iw * wino_iw) *
                         threads;
   workspace_size_ = (temp_size + new_input_size) * sizeof(float16_t);
-
-  // select best wino_unit
-  int wino_unit = ow * oh / (tile_block * threads);
-  if (wino_unit < 16) {
-    wino_iw = 4;
-    if (last_function_ == 0) {
-      return;
-    }
-    last_function_ = 0;
-  } else {
-    wino_iw = 6;
-    if (last_function_ == 1) {
-      return;
-    }
-    last_function_ = 1;
+  if (last_function_ == function) {
+    return;
   }
   last_function_ = -1;
 
-  weights_.Resize({1, 1, 1, wino_iw * wino_iw * oc_pad * ic_pad});
-  void* trans_tmp_ptr = malloc(sizeof(float16_t) * wino_iw * wino_iw * oc * ic);
-  auto weights_data_ = weights_.mutable_data<float16_t>();
-  memset(reinterpret_cast<char*>(weights_data_),
-         0,
-         weights_.numel() * sizeof(int16_t));
-  switch (wino_iw) {
-    case 4:
-      lite::arm::math::fp16::weight_trans_c8_4x4_fp16(
-          weights_data_,
-          param.filter->template data<float16_t>(),
-          ic,
-          oc,
-          trans_tmp_ptr);
-      break;
-    case 6:
-      lite::arm::math::fp16::weight_trans_c8_6x6_fp16(
-          weights_data_,
-          param.filter->template data<float16_t>(),
-          ic,
-          oc,
-          trans_tmp_ptr);
-      break;
-    default:
-      lite::arm::math::fp16::weight_trans_c8_6x6_fp16(
-          weights_data_,
-          param.filter->template data<float16_t>(),
-          ic,
-          oc,
-          trans_tmp_ptr);
-  }
-  free(trans_tmp_ptr);
+  auto pack = [&] {
+    weights_.Resize({1, 1, 1, wino_iw * wino_iw * oc_pad * ic_pad});
+    void* trans_tmp_ptr =
+        malloc(sizeof(float16_t) * wino_iw * wino_iw * oc * ic);
+    auto weights_data_ = weights_.mutable_data<float16_t>();
+    memset(reinterpret_cast<char*>(weights_data_),
+           0,
+           weights_.numel() * sizeof(int16_t));
+    switch (wino_iw) {
+      case 4:
+        lite::arm::math::fp16::weight_trans_c8_4x4_fp16(
+            weights_data_,
+            param.filter->template data<float16_t>(),
+            ic,
+            oc,
+            trans_tmp_ptr);
+        break;
+      case 6:
+        lite::arm::math::fp16::weight_trans_c8_6x6_fp16(
+            weights_data_,
+            param.filter->template data<float16_t>(),
+            ic,
+            oc,
+            trans_tmp_ptr);
+        break;
+      default:
+        lite::arm::math::fp16::weight_trans_c8_8x8_fp16(
+            weights_data_,
+            param.filter->template data<float16_t>(),
+            ic,
+            oc,
+            trans_tmp_ptr);
+    }
+    free(trans_tmp_ptr);
+  };
+  PackedWeightCache::Global().Pack(
+      "conv_winograd/fp16/wino:" + std::to_string(wino_iw),
+      *param.filter,
+      &weights_,
+      pack);
 }
 
 template <>
@@ -436,7 +467,10 @@ void WinogradConv<PRECISION(kFP16), PRECISION(kFP16)>::Run() {
   int ow = o_dims[3];
   int oc = o_dims[1];
 
-  if (wino_iw == 6) {
+  if (wino_iw == 8) {
+    lite::arm::math::fp16::conv_compute_6x6_3x3_fp16(FUNCS_PARAM, param, &ctx);
+    KERNEL_FUNC_NAME("conv_compute_6x6_3x3_fp16")
+  } else if (wino_iw == 6) {
     lite::arm::math::fp16::conv_compute_4x4_3x3_fp16(FUNCS_PARAM, param, &ctx);
     KERNEL_FUNC_NAME("conv_compute_4x4_3x3_fp16")
   } else {
@@ -17,6 +17,7 @@
 #include <utility>
 #include <vector>
 #include "lite/core/op_registry.h"
+#include "lite/core/parallel_defines.h"
 #include "lite/core/type_system.h"
 #include "lite/kernels/arm/conv_depthwise.h"
 #include "lite/kernels/arm/conv_direct.h"
@@ -34,124 +35,14 @@ void DeformableConvCompute<PRECISION(kFloat),
   ReInitWhenNeeded();
 }
 
-template <typename T>
-static T DmcnIm2colBilinear(const T* bottom_data,
-                            const int data_width,
-                            const int height,
-                            const int width,
-                            T h,
-                            T w) {
-  int h_low = floor(h);
-  int w_low = floor(w);
-  int h_high = h_low + 1;
-  int w_high = w_low + 1;
-
-  T lh = h - h_low;
-  T lw = w - w_low;
-  T hh = 1 - lh;
-  T hw = 1 - lw;
-
-  T v1 =
-      (h_low >= 0 && w_low >= 0) ? bottom_data[h_low * data_width + w_low] : 0;
-  T v2 = (h_low >= 0 && w_high <= width - 1)
-             ? bottom_data[h_low * data_width + w_high]
-             : 0;
-  T v3 = (h_high <= height - 1 && w_low >= 0)
-             ? bottom_data[h_high * data_width + w_low]
-             : 0;
-  T v4 = (h_high <= height - 1 && w_high <= width - 1)
-             ? bottom_data[h_high * data_width + w_high]
-             : 0;
-
-  T w1 = hh * hw;
-  T w2 = hh * lw;
-  T w3 = lh * hw;
-  T w4 = lh * lw;
-
-  return w1 * v1 + w2 * v2 + w3 * v3 + w4 * v4;
-}
-
-template <typename T>
-static void ModulatedDeformableIm2colCPUKernel(
-    const int num_kernels,
-    const T* data_im,
-    const T* data_offset,
-    const T* data_mask,
-    const int height,
-    const int width,
-    const int kernel_h,
-    const int kernel_w,
-    const int pad_h,
-    const int pad_w,
-    const int stride_h,
-    const int stride_w,
-    const int dilation_h,
-    const int dilation_w,
-    const int channel_per_deformable_group,
-    const int batch_size,
-    const int num_channels,
-    const int deformable_group,
-    const int height_col,
-    const int width_col,
-    T* data_col) {
-  for (int i = 0; i < num_kernels; i++) {
-    const int w_col = i % width_col;
-    const int h_col = (i / width_col) % height_col;
-    const int b_col = (i / width_col) / height_col % batch_size;
-    const int c_im = (i / width_col / height_col) / batch_size;
-    const int c_col = c_im * kernel_h * kernel_w;
-
-    const int deformable_group_index = c_im / channel_per_deformable_group;
-
-    const int h_in = h_col * stride_h - pad_h;
-    const int w_in = w_col * stride_w - pad_w;
-
-    T* data_col_ptr =
-        data_col +
-        ((c_col * batch_size + b_col) * height_col + h_col) * width_col + w_col;
-    const T* data_im_ptr =
-        data_im + (b_col * num_channels + c_im) * height * width;
-    const T* data_offset_ptr =
-        data_offset +
-        (b_col * deformable_group + deformable_group_index) * 2 * kernel_h *
-            kernel_w * height_col * width_col;
-    const T* data_mask_ptr =
-        data_mask +
-        (b_col * deformable_group + deformable_group_index) * kernel_h *
-            kernel_w * height_col * width_col;
-
-    for (int i = 0; i < kernel_h; ++i) {
-      for (int j = 0; j < kernel_w; ++j) {
-        const int data_offset_h_ptr =
-            ((2 * (i * kernel_w + j)) * height_col + h_col) * width_col + w_col;
-        const int data_offset_w_ptr =
-            ((2 * (i * kernel_w + j) + 1) * height_col + h_col) * width_col +
-            w_col;
-        const int data_mask_hw_ptr =
-            ((i * kernel_w + j) * height_col + h_col) * width_col + w_col;
-
-        const T offset_h = data_offset_ptr[data_offset_h_ptr];
-        const T offset_w = data_offset_ptr[data_offset_w_ptr];
-        const T mask = data_mask_ptr[data_mask_hw_ptr];
-        T val = static_cast<T>(0);
-        const T h_im = h_in + i * dilation_h + offset_h;
-        const T w_im = w_in + j * dilation_w + offset_w;
-        if (h_im > -1 && w_im > -1 && h_im < height && w_im < width) {
-          val =
-              DmcnIm2colBilinear(data_im_ptr, width, height, width, h_im, w_im);
-        }
-        *data_col_ptr = val * mask;
-        data_col_ptr += batch_size * height_col * width_col;
-      }
-    }
-  }
-}
-
-template <typename T>
-static inline void ModulatedDeformableIm2colCPU(
-    const T* data_im,
-    const T* data_offset,
-    const T* data_mask,
+// The sampling points of a deformable group and a kernel tap are shared by
+// all the channels of the group, so their bilinear offsets and weights, with
+// the mask folded in, are computed once into a table and every column row is
+// then gathered from it.
+static void ModulatedDeformableIm2colCPU(
+    const float* data_im,
+    const float* data_offset,
+    const float* data_mask,
     const std::vector<int64_t> im_shape,
     const std::vector<int64_t> col_shape,
     const std::vector<int64_t> filter_shape,
@@ -159,32 +50,76 @@ static inline void ModulatedDeformableIm2colCPU(
     const std::vector<int> strides,
     const std::vector<int> dilations,
     const int deformable_groups,
-    T* data_col) {
-  int channel_per_deformable_group = im_shape[0] / deformable_groups;
-  int num_kernels = im_shape[0] * col_shape[1] * col_shape[2] * col_shape[3];
+    Tensor* table,
+    float* data_col) {
+  const int num_channels = im_shape[0];
+  const int height = im_shape[1];
+  const int width = im_shape[2];
+  const int kernel_h = filter_shape[2];
+  const int kernel_w = filter_shape[3];
+  const int kernel_size = kernel_h * kernel_w;
+  const int batch_size = col_shape[1];
+  const int height_col = col_shape[2];
+  const int width_col = col_shape[3];
+  const int spatial_col = height_col * width_col;
+  const int col_size = batch_size * spatial_col;
+  const int channel_per_deformable_group = num_channels / deformable_groups;
+  const int table_size = lite::arm::math::bilinear_table_size(col_size);
 
-  // get outputs of im2col with offset by bilinear interpolation
-  ModulatedDeformableIm2colCPUKernel(num_kernels,
-                                     data_im,
-                                     data_offset,
-                                     data_mask,
-                                     im_shape[1],
-                                     im_shape[2],
-                                     filter_shape[2],
-                                     filter_shape[3],
-                                     paddings[0],
-                                     paddings[1],
-                                     strides[0],
-                                     strides[1],
-                                     dilations[0],
-                                     dilations[1],
-                                     channel_per_deformable_group,
-                                     col_shape[1],
-                                     im_shape[0],
-                                     deformable_groups,
-                                     col_shape[2],
-                                     col_shape[3],
-                                     data_col);
+  table->Resize({deformable_groups * kernel_size, table_size * 2});
+  int* offsets = table->mutable_data<int>();
+  float* weights = reinterpret_cast<float*>(
+      offsets + deformable_groups * kernel_size * table_size);
+
+  // one task per deformable group, kernel tap, batch and output row
+  const int table_rows = deformable_groups * kernel_size * batch_size;
+  LITE_PARALLEL_BEGIN(r, tid, table_rows * height_col) {
+    const int h_col = r % height_col;
+    const int b = r / height_col % batch_size;
+    const int tap = r / height_col / batch_size % kernel_size;
+    const int g = r / height_col / batch_size / kernel_size;
+    const int i = tap / kernel_w;
+    const int j = tap % kernel_w;
+    const int map = b * deformable_groups + g;
+    const float* offset_h_ptr =
+        data_offset + (map * 2 * kernel_size + 2 * tap) * spatial_col +
+        h_col * width_col;
+    const float* offset_w_ptr = offset_h_ptr + spatial_col;
+    const float* mask_ptr =
+        data_mask + (map * kernel_size + tap) * spatial_col + h_col * width_col;
+    int* ofs = offsets + (g * kernel_size + tap) * table_size;
+    float* wts = weights + (g * kernel_size + tap) * table_size;
+    const float h_im = h_col * strides[0] - paddings[0] + i * dilations[0];
+    const int base = b * num_channels * height * width;
+    for (int w_col = 0; w_col < width_col; ++w_col) {
+      const float w_im = w_col * strides[1] - paddings[1] + j * dilations[1];
+      lite::arm::math::bilinear_table_set(ofs,
+                                          wts,
+                                          b * spatial_col + h_col * width_col +
+                                              w_col,
+                                          w_im + offset_w_ptr[w_col],
+                                          h_im + offset_h_ptr[w_col],
+                                          width,
+                                          height,
+                                          base,
+                                          mask_ptr[w_col]);
+    }
+  }
+  LITE_PARALLEL_END()
+
+  // the column row c * kernel_size + tap samples the channel c
+  LITE_PARALLEL_BEGIN(r, tid, num_channels * kernel_size) {
+    const int c = r / kernel_size;
+    const int tap = r % kernel_size;
+    const int g = c / channel_per_deformable_group;
+    lite::arm::math::bilinear_sample(
+        data_im + c * height * width,
+        offsets + (g * kernel_size + tap) * table_size,
+        weights + (g * kernel_size + tap) * table_size,
+        data_col + r * col_size,
+        col_size);
+  }
+  LITE_PARALLEL_END()
 }
 
 template <>
@@ -261,8 +196,9 @@ void DeformableConvCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   col_buffer.mutable_data<float>();
   float* col_buffer_ptr = col_buffer.mutable_data<float>();
   int weights_size_per_group = M * K;
+  Tensor sample_table;
   for (int i = 0; i < batch_size / im2col_step; ++i) {
-    ModulatedDeformableIm2colCPU<float>(
+    ModulatedDeformableIm2colCPU(
         input_ptr + i * im2col_step * input_dim,
         offset_ptr + i * im2col_step * input_offset_dim,
         mask_ptr + i * im2col_step * input_mask_dim,
@@ -273,6 +209,7 @@ void DeformableConvCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
         strides,
         dilations,
         deformable_groups,
+        &sample_table,
         col_buffer_ptr);
     Tensor output_3d = output_4d.Slice<float>(i, i + 1);
     output_3d.Resize(DDim(output_4d.dims()).Slice(1, output_4d.dims().size()));
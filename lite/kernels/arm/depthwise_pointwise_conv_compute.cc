@@ -0,0 +1,124 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/arm/depthwise_pointwise_conv_compute.h"
+#include <algorithm>
+#include "lite/backends/arm/math/funcs.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+void DepthwisePointwiseConvCompute::PrepareForRun() {
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto& param = this->Param<param_t>();
+  auto pw_dims = param.pw_filter->dims();
+  lite::arm::math::prepackA(&pw_weights_,
+                            *param.pw_filter,
+                            1.f,
+                            pw_dims[0],
+                            pw_dims[1],
+                            1,
+                            false,
+                            &ctx);
+}
+
+void DepthwisePointwiseConvCompute::Run() {
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto& param = this->Param<param_t>();
+  auto x_dims = param.x->dims();
+  auto w_dims = param.filter->dims();
+  auto o_dims = param.output->dims();
+  const int num = x_dims[0];
+  const int ch = x_dims[1];
+  const int ih = x_dims[2];
+  const int iw = x_dims[3];
+  const int oc = o_dims[1];
+  const int oh = o_dims[2];
+  const int ow = o_dims[3];
+  const int m = oh * ow;
+  // rows of the depthwise output which take half of the L2 cache, the other
+  // half is left to the packed blocks of sgemm
+  const int band_size = ctx.l2_cache_size() / 2 / sizeof(float);
+  const int band = std::max(1, std::min(oh, band_size / (ch * ow)));
+  band_buf_.Resize({ch, band * ow});
+  float* buf = band_buf_.mutable_data<float>();
+
+  const float* din = param.x->data<float>();
+  const float* dw_w = param.filter->data<float>();
+  const float* dw_b = param.bias ? param.bias->data<float>() : nullptr;
+  const float* pw_w = pw_weights_.data<float>();
+  const float* pw_b = param.pw_bias ? param.pw_bias->data<float>() : nullptr;
+  float* dout = param.output->mutable_data<float>();
+  for (int n = 0; n < num; ++n) {
+    const float* in = din + static_cast<int64_t>(n) * ch * ih * iw;
+    float* out = dout + static_cast<int64_t>(n) * oc * m;
+    for (int r0 = 0; r0 < oh; r0 += band) {
+      const int r1 = std::min(oh, r0 + band);
+      const int cols = (r1 - r0) * ow;
+      lite::arm::math::conv_depthwise_rows(in,
+                                           dw_w,
+                                           dw_b,
+                                           buf,
+                                           ch,
+                                           ih,
+                                           iw,
+                                           ow,
+                                           r0,
+                                           r1,
+                                           w_dims[2],
+                                           w_dims[3],
+                                           param.strides,
+                                           *param.paddings,
+                                           *param.dilations,
+                                           param.activation_param);
+      // out[oc, rows of the band] = pw_filter[oc, ch] * buf[ch, cols]
+      lite::arm::math::sgemm_prepack(false,
+                                     oc,
+                                     cols,
+                                     ch,
+                                     pw_w,
+                                     buf,
+                                     cols,
+                                     0.f,
+                                     out + r0 * ow,
+                                     m,
+                                     pw_b,
+                                     pw_b != nullptr,
+                                     param.pw_activation_param,
+                                     &ctx);
+    }
+  }
+}
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fusion_depthwise_pointwise_conv2d,
+                     kARM,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::arm::DepthwisePointwiseConvCompute,
+                     def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("PwFilter", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("PwBias", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Output", {LiteType::GetTensorTy(TARGET(kARM))})
+    .Finalize();
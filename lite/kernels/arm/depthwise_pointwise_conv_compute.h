@@ -0,0 +1,47 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include "lite/core/kernel.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+// Runs the depthwise conv in bands of output rows small enough for the L2
+// cache, and the 1x1 conv gemm on each band while it is still there, so
+// the depthwise output never goes to memory as a whole feature map.
+class DepthwisePointwiseConvCompute
+    : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::DepthwisePointwiseConvParam;
+
+  void PrepareForRun() override;
+
+  void Run() override;
+
+  virtual ~DepthwisePointwiseConvCompute() = default;
+
+ private:
+  // the 1x1 filter packed for sgemm_prepack
+  Tensor pw_weights_;
+  Tensor band_buf_;
+};
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,109 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/arm/elementwise_chain_compute.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+static void fill_data(Tensor* tensor) {
+  float* data = tensor->mutable_data<float>();
+  for (int64_t i = 0; i < tensor->numel(); ++i) {
+    data[i] = static_cast<float>((i * 7) % 23 - 11) / 11.f;
+  }
+}
+
+TEST(elementwise_chain_arm, retrive_op) {
+  auto kernels = KernelRegistry::Global().Create("fusion_elementwise_chain");
+  ASSERT_FALSE(kernels.empty());
+  ASSERT_TRUE(kernels.front());
+}
+
+// ((x - bias[c]) * scale) * sigmoid(...) + y, clipped by relu6, on
+// [n, c, h, w] with the bias broadcast per channel and the scale a scalar
+TEST(elementwise_chain_arm, swish_with_broadcast) {
+  for (int n : {1, 2}) {
+    for (int c : {3, 16}) {
+      for (int hw : {1, 7, 50}) {
+        Tensor x, bias, scale, y, out;
+        x.Resize({n, c, hw, hw});
+        bias.Resize({c});
+        scale.Resize({1});
+        y.Resize({n, c, hw, hw});
+        fill_data(&x);
+        fill_data(&bias);
+        scale.mutable_data<float>()[0] = 1.5f;
+        fill_data(&y);
+        out.Resize({n, c, hw, hw});
+
+        operators::ElementwiseChainParam param;
+        param.X = {&x, &bias, &scale, &y};
+        param.Out = &out;
+        param.step_types = {"elementwise_sub",
+                            "elementwise_mul",
+                            "sigmoid",
+                            "elementwise_mul",
+                            "elementwise_add",
+                            "relu6"};
+        // the results of the steps follow the 4 inputs
+        param.operands = {1, 2, -1, 5, 3, -1};
+        param.operand_first = {0, 1, 0, 0, 0, 0};
+        param.axes = {1, -1, -1, -1, -1, -1};
+        param.alphas = {0.f, 0.f, 0.f, 0.f, 0.f, 6.f};
+        param.betas.assign(6, 0.f);
+        param.gammas.assign(6, 0.f);
+        param.x_aligned_dims = {{n, c, hw, hw},
+                                {1, c, 1, 1},
+                                {1, 1, 1, 1},
+                                {n, c, hw, hw}};
+
+        ElementwiseChainCompute chain;
+        std::unique_ptr<KernelContext> ctx(new KernelContext);
+        ctx->As<ARMContext>();
+        chain.SetContext(std::move(ctx));
+        chain.SetParam(param);
+        chain.PrepareForRun();
+        chain.Run();
+
+        const float* px = x.data<float>();
+        const float* pb = bias.data<float>();
+        const float* py = y.data<float>();
+        const float* po = out.data<float>();
+        const int size = hw * hw;
+        for (int64_t i = 0; i < x.numel(); ++i) {
+          float t = (px[i] - pb[(i / size) % c]) * 1.5f;
+          float ref = t * (1.f / (1.f + std::exp(-t))) + py[i];
+          ref = std::min(std::max(ref, 0.f), 6.f);
+          EXPECT_NEAR(po[i], ref, 1e-4);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(fusion_elementwise_chain, kARM, kFloat, kNCHW, def);
@@ -14,6 +14,7 @@
 
 #include "lite/kernels/arm/elementwise_compute.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
@@ -21,6 +22,7 @@
 #include "lite/backends/arm/math/elementwise_common_broadcast.h"
 #include "lite/backends/arm/math/elementwise_common_broadcast_config.h"
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/core/parallel_defines.h"
 #include "lite/kernels/host/elementwise_op_func.h"
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
@@ -102,48 +104,53 @@ using BinaryOpFn = lite::kernels::host::BinaryOpFn<T>;
 
 enum class OprandSwapable { NO, YES };
 
+// Runs `fn` on the batches of `batch_arg`, the batches are split into the
+// tasks of about kBatchTaskSize elements on the thread pool.
+template <class Elem_t, class DimValue_t, class Fn>
+void run_batches_parallel(
+    const lite::kernels::host::BatchElementWiseArg<Elem_t, DimValue_t>&
+        batch_arg,
+    Fn fn) {
+  constexpr int64_t kBatchTaskSize = 4096;
+  int64_t batch_num = batch_arg.BatchNum();
+  int64_t step =
+      std::max<int64_t>(1, kBatchTaskSize / batch_arg.ElemNumPerBatch());
+  int task_num = static_cast<int>((batch_num + step - 1) / step);
+  LITE_PARALLEL_BEGIN(i, tid, task_num) {
+    int64_t begin = i * step;
+    batch_arg.ForEachBatch(begin, std::min(begin + step, batch_num), fn);
+  }
+  LITE_PARALLEL_END();
+}
+
 template <class Elem_t, class DimValue_t, class NeonConfig>
 struct CommonElementWiseOpArm {
   static void Run(
-      // todo: if necessary, generate
-      //  lite::kernels::host::StaticBatchElementWiseArg by
-      //  batch_arg->ToStaticArg() before kernel launch, it will help to reduce
-      //  runtime overhead.
       const lite::kernels::host::BatchElementWiseArg<Elem_t, DimValue_t>&
           batch_arg,
       BinaryOpFn<Elem_t> op) {
-    int batch_num = batch_arg.BatchNum();
-    auto bcast_type = batch_arg.BcastType();
+    using Ptr = lite::kernels::host::BatchElementWiseArgMemPointer<Elem_t>;
     int range_length = batch_arg.ElemNumPerBatch();
-    switch (bcast_type) {
+    switch (batch_arg.BcastType()) {
       case (lite::kernels::host::BroadcastType::X_AS_CONTINUOUS): {
-        for (int batch_id = 0; batch_id < batch_num; ++batch_id) {
+        run_batches_parallel(batch_arg, [&](const Ptr& p) {
           arm_math::neon_elementwise_range_to_one<NeonConfig>(
-              batch_arg.XAtBatch(batch_id),
-              batch_arg.YAtBatch(batch_id),
-              batch_arg.ZAtBatch(batch_id),
-              range_length);
-        }
+              p.x_data, p.y_data, p.z_data, range_length);
+        });
         break;
       }
       case (lite::kernels::host::BroadcastType::Y_AS_CONTINUOUS): {
-        for (int batch_id = 0; batch_id < batch_num; ++batch_id) {
+        run_batches_parallel(batch_arg, [&](const Ptr& p) {
           arm_math::neon_elementwise_one_to_range<NeonConfig>(
-              batch_arg.XAtBatch(batch_id),
-              batch_arg.YAtBatch(batch_id),
-              batch_arg.ZAtBatch(batch_id),
-              range_length);
-        }
+              p.x_data, p.y_data, p.z_data, range_length);
+        });
         break;
       }
       case (lite::kernels::host::BroadcastType::BOTH_CONTINUOUS): {
-        for (int batch_id = 0; batch_id < batch_num; ++batch_id) {
+        run_batches_parallel(batch_arg, [&](const Ptr& p) {
           arm_math::neon_elementwise_range_to_range<NeonConfig>(
-              batch_arg.XAtBatch(batch_id),
-              batch_arg.YAtBatch(batch_id),
-              batch_arg.ZAtBatch(batch_id),
-              range_length);
-        }
+              p.x_data, p.y_data, p.z_data, range_length);
+        });
         break;
       }
       default: {
@@ -157,48 +164,31 @@ struct CommonElementWiseOpArm {
 template <class Elem_t, class DimValue_t>
 struct CommonElementWiseOpArm<Elem_t, DimValue_t, arm_math::NullNeonConfig> {
   static void Run(
-      // todo: if necessary, generate
-      //  lite::kernels::host::StaticBatchElementWiseArg by
-      //  batch_arg->ToStaticArg() before kernel launch, it will help to reduce
-      //  runtime overhead.
       const lite::kernels::host::BatchElementWiseArg<Elem_t, DimValue_t>&
           batch_arg,
       BinaryOpFn<Elem_t> op) {
-    int batch_num = batch_arg.BatchNum();
-    auto bcast_type = batch_arg.BcastType();
+    using Ptr = lite::kernels::host::BatchElementWiseArgMemPointer<Elem_t>;
     int range_length = batch_arg.ElemNumPerBatch();
-    switch (bcast_type) {
+    switch (batch_arg.BcastType()) {
       case (lite::kernels::host::BroadcastType::X_AS_CONTINUOUS): {
-        for (int batch_id = 0; batch_id < batch_num; ++batch_id) {
+        run_batches_parallel(batch_arg, [&](const Ptr& p) {
           lite::kernels::host::element_wise_range_to_one<Elem_t>(
-              batch_arg.XAtBatch(batch_id),
-              batch_arg.YAtBatch(batch_id),
-              batch_arg.ZAtBatch(batch_id),
-              range_length,
-              op);
-        }
+              p.x_data, p.y_data, p.z_data, range_length, op);
+        });
         break;
       }
       case (lite::kernels::host::BroadcastType::Y_AS_CONTINUOUS): {
-        for (int batch_id = 0; batch_id < batch_num; ++batch_id) {
+        run_batches_parallel(batch_arg, [&](const Ptr& p) {
           lite::kernels::host::element_wise_one_to_range<Elem_t>(
-              batch_arg.XAtBatch(batch_id),
-              batch_arg.YAtBatch(batch_id),
-              batch_arg.ZAtBatch(batch_id),
-              range_length,
-              op);
-        }
+              p.x_data, p.y_data, p.z_data, range_length, op);
+        });
         break;
       }
       case (lite::kernels::host::BroadcastType::BOTH_CONTINUOUS): {
-        for (int batch_id = 0; batch_id < batch_num; ++batch_id) {
+        run_batches_parallel(batch_arg, [&](const Ptr& p) {
           lite::kernels::host::element_wise_range_to_range<Elem_t>(
-              batch_arg.XAtBatch(batch_id),
-              batch_arg.YAtBatch(batch_id),
-              batch_arg.ZAtBatch(batch_id),
-              range_length,
-              op);
-        }
+              p.x_data, p.y_data, p.z_data, range_length, op);
+        });
         break;
       }
       default: {
@@ -489,10 +479,12 @@ void ElementwiseMulActivationCompute<float16_t, PRECISION(kFP16)>::Run() {
 
 template <typename T, PrecisionType PType>
 void ElementwiseSubCompute<T, PType>::Run() {
+  using NeonConfig =
+      typename arm_math::NeonConfigOf<arm_math::SubConfig<T>, T>::type;
   elementwise_compute_template<operators::ElementwiseParam,
                                T,
                                OprandSwapable::NO,
-                               arm_math::NullNeonConfig>(
+                               NeonConfig>(
       this,
       lite::arm::math::elementwise_sub_broadcast<T>,
       lite::arm::math::elementwise_sub<T>,
@@ -525,10 +517,12 @@ void ElementwiseSubActivationCompute<T, PType>::Run() {
 
 template <typename T, PrecisionType PType>
 void ElementwiseMulCompute<T, PType>::Run() {
+  using NeonConfig =
+      typename arm_math::NeonConfigOf<arm_math::MulConfig<T>, T>::type;
   elementwise_compute_template<operators::ElementwiseParam,
                                T,
                                OprandSwapable::YES,
-                               arm_math::NullNeonConfig>(
+                               NeonConfig>(
       this,
       lite::arm::math::elementwise_mul_broadcast<T>,
       lite::arm::math::elementwise_mul<T>,
@@ -560,10 +554,12 @@ void ElementwiseMulActivationCompute<T, PType>::Run() {
 }
 
 void ElementwiseMaxCompute::Run() {
+  using NeonConfig =
+      typename arm_math::NeonConfigOf<arm_math::MaxConfig<float>, float>::type;
   elementwise_compute_template<operators::ElementwiseParam,
                                float,
                                OprandSwapable::YES,
-                               arm_math::NullNeonConfig>(
+                               NeonConfig>(
       this,
       lite::arm::math::elementwise_max_broadcast<float>,
       lite::arm::math::elementwise_max<float>,
@@ -593,10 +589,12 @@ void ElementwiseMaxActivationCompute::Run() {
 }
 
 void ElementwiseMinCompute::Run() {
+  using NeonConfig =
+      typename arm_math::NeonConfigOf<arm_math::MinConfig<float>, float>::type;
   elementwise_compute_template<operators::ElementwiseParam,
                                float,
                                OprandSwapable::YES,
-                               arm_math::NullNeonConfig>(
+                               NeonConfig>(
       this,
       lite::arm::math::elementwise_min_broadcast<float>,
       lite::arm::math::elementwise_min<float>,
@@ -627,10 +625,12 @@ void ElementwiseMinActivationCompute::Run() {
 
 template <typename T, PrecisionType PType>
 void ElementwiseDivCompute<T, PType>::Run() {
+  using NeonConfig =
+      typename arm_math::NeonConfigOf<arm_math::DivConfig<T>, T>::type;
   elementwise_compute_template<operators::ElementwiseParam,
                                T,
                                OprandSwapable::NO,
-                               arm_math::NullNeonConfig>(
+                               NeonConfig>(
       this,
       lite::arm::math::elementwise_div_broadcast<T>,
       lite::arm::math::elementwise_div<T>,
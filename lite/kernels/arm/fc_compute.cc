@@ -16,10 +16,12 @@
 #include <string>
 #include <vector>
 #include "lite/api/paddle_place.h"
+#include "lite/backends/arm/math/bf16/funcs_bf16.h"
 #include "lite/backends/arm/math/funcs.h"
 #include "lite/backends/arm/math/gemm_prepacked_int8.h"
 #include "lite/backends/arm/math/gemv_arm_int8.h"
 #include "lite/core/op_registry.h"
+#include "lite/core/packed_weight_cache.h"
 #include "lite/core/type_system.h"
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
@@ -65,6 +67,12 @@ void fc_trans_weights<PRECISION(kInt8)>(const Tensor& tin, Tensor* tout) {
   naive_transpose(ptr_in, ptr_out, m, n);
 }
 
+// The bf16 weights are decoded to fp32 on the cpus without bf16.
+template <>
+void fc_trans_weights<PRECISION(kBF16)>(const Tensor& tin, Tensor* tout) {
+  fc_trans_weights<PRECISION(kFloat)>(tin, tout);
+}
+
 template <PrecisionType PType, PrecisionType OutType>
 bool check_fc_use_gemm(int m, const std::vector<float>& scale, bool has_bias) {
   return m > 1;
@@ -84,6 +92,68 @@ bool check_fc_use_gemm<PRECISION(kInt8), PRECISION(kInt8)>(
   return m > 1 && scale.size() == 1 && !has_bias;
 }
 
+// The fp32 fc, also used by the bf16 kernel on the cpus without bf16.
+void fc_compute_fp32(const operators::FcParam& param,
+                     ARMContext* ctx,
+                     const float* w_data,
+                     const float* b_data,
+                     int m,
+                     int n,
+                     int k,
+                     bool flag_gemm) {
+  auto* i_data = param.input->data<float>();
+  auto* o_data = param.output->mutable_data<float>();
+  operators::ActivationParam act_param;
+  act_param.has_active = false;
+  if (flag_gemm) {
+    lite::arm::math::sgemm(false,
+                           false,
+                           m,
+                           n,
+                           k,
+                           1.f,
+                           i_data,
+                           k,
+                           w_data,
+                           n,
+                           0.f,
+                           o_data,
+                           n,
+                           nullptr,
+                           false,
+                           act_param,
+                           ctx);
+    if (param.bias) {
+      bool flag_act = false;
+      if (param.activation_type == "relu") {
+        flag_act = true;
+      }
+      CHECK_EQ(param.bias->numel(), n);
+      lite::arm::math::fill_bias_fc(o_data, b_data, m, n, flag_act);
+    }
+  } else {
+    if (param.activation_type == "relu") {
+      act_param.active_type = lite_api::ActivationType::kRelu;
+      act_param.has_active = true;
+    }
+    for (int i = 0; i < m; ++i) {
+      auto* i_data_batch = i_data + i * k;
+      auto* o_data_batch = o_data + i * n;
+      lite::arm::math::sgemv(w_data,
+                             i_data_batch,
+                             o_data_batch,
+                             false,
+                             n,
+                             k,
+                             0.f,
+                             param.bias != nullptr,
+                             b_data,
+                             act_param,
+                             ctx);
+    }
+  }
+}
+
 template <PrecisionType PType, PrecisionType OutType>
 void FcCompute<PType, OutType>::ReInitWhenNeeded() {
   auto& param = this->template Param<operators::FcParam>();
@@ -109,20 +179,140 @@ void FcCompute<PType, OutType>::ReInitWhenNeeded() {
   CHECK_EQ(k_, w_dims[0]);
   n_ = w_dims[1];
   CHECK_EQ(k_, static_cast<int>(w_dims[0]));
+  // the weight-only quantized weight is packed once and dequantized in the
+  // inner loop of the gemm for any m
+  if (PType == PRECISION(kFloat) && param.weight_quant_bits > 0 &&
+      param.w->precision() == PRECISION(kInt8)) {
+    if (!flag_weight_only_) {
+      flag_weight_only_ = true;
+      if (param.weight_quant_bits == 4) {
+        int group_size = param.weight_group_size;
+        CHECK_EQ(param.weight_quant_scale.size(),
+                 static_cast<size_t>((k_ + group_size - 1) / group_size * n_))
+            << "The int4 weight of fc should have the scale of each group";
+        PackedWeightCache::Global().Pack(
+            "fc/int4/group:" + std::to_string(group_size),
+            *param.w,
+            &weights_,
+            [&] {
+              weights_.Resize({lite::arm::math::packed_weight_int4_size(
+                  n_, k_, group_size)});
+              lite::arm::math::pack_weight_int4(
+                  param.w->template data<int8_t>(),
+                  weights_.template mutable_data<uint8_t>(),
+                  n_,
+                  k_,
+                  group_size);
+            });
+      } else {
+        CHECK_EQ(param.weight_quant_scale.size(), static_cast<size_t>(n_))
+            << "The int8 weight of fc should have the scale of each column";
+        PackedWeightCache::Global().Pack(
+            "fc/int8_weight", *param.w, &weights_, [&] {
+              weights_.Resize({n_, k_});
+              lite::arm::math::pack_weight_int8(
+                  param.w->template data<int8_t>(),
+                  weights_.template mutable_data<int8_t>(),
+                  n_,
+                  k_);
+            });
+      }
+    }
+    return;
+  }
   flag_gemm_ = check_fc_use_gemm<PType, OutType>(
-      m_, param.weight_scale, param.bias != nullptr);
+      m_,
+      param.weight_scale,
+      param.bias != nullptr || param.input_zero_point != 0);
   if (!flag_trans_weights_ && !flag_gemm_) {
     flag_trans_weights_ = true;
-    fc_trans_weights<PType>(*param.w, &weights_);
+    // the int8 gemv with sdot reads the weights packed in the blocks of rows
+    if (PType == PRECISION(kInt8) &&
+        lite::arm::math::gemv_int8_packed_enabled(&ctx)) {
+      flag_packed_gemv_ = true;
+      PackedWeightCache::Global().Pack(
+          "fc/int8/sdot", *param.w, &weights_, [&] {
+            Tensor trans_weights;
+            fc_trans_weights<PType>(*param.w, &trans_weights);
+            weights_.Resize(
+                {lite::arm::math::gemv_packed_size_int8_sdot(n_, k_)});
+            lite::arm::math::gemv_prepack_int8_sdot(
+                trans_weights.data<int8_t>(),
+                weights_.mutable_data<int8_t>(),
+                n_,
+                k_);
+          });
+      return;
+    }
+    PackedWeightCache::Global().Pack(
+        "fc/" + PrecisionToStr(PType), *param.w, &weights_, [&] {
+          fc_trans_weights<PType>(*param.w, &weights_);
+        });
   }
 }
 
+template <PrecisionType PType, PrecisionType OutType>
+void FcCompute<PType, OutType>::FoldInputZeroPoint(float output_scale) {
+  auto& param = this->template Param<operators::FcParam>();
+  std::vector<float> scale(n_);
+  for (int i = 0; i < n_; ++i) {
+    float weight_scale = param.weight_scale.size() == 1
+                             ? param.weight_scale[0]
+                             : param.weight_scale[i];
+    scale[i] = weight_scale * param.input_scale / output_scale;
+  }
+  const float* bias = param.bias ? param.bias->template data<float>() : nullptr;
+  if (flag_trans_bias_) {
+    bias = bias_.data<float>();
+  } else {
+    bias_.Resize({n_});
+  }
+  // the weight is [k, n]
+  lite::arm::math::fold_zero_point_bias(param.w->template data<int8_t>(),
+                                        scale.data(),
+                                        bias,
+                                        bias_.mutable_data<float>(),
+                                        param.input_zero_point,
+                                        n_,
+                                        k_,
+                                        true);
+  flag_trans_bias_ = true;
+}
+
 ///  for fp32 kernel
 template <>
 void FcCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
   ReInitWhenNeeded();
 }
 
+/// for bf16 kernel with fp32 input and output
+template <>
+void FcCompute<PRECISION(kBF16), PRECISION(kFloat)>::PrepareForRun() {
+  auto& param = this->template Param<operators::FcParam>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  flag_bf16_ = ctx.has_bf16();
+  if (!flag_bf16_) {
+    lite::arm::math::bf16::tensor_bf16_to_fp32(param.w);
+    ReInitWhenNeeded();
+    return;
+  }
+  lite::arm::math::bf16::tensor_fp32_to_bf16(param.w);
+  CHECK_EQ(param.w->dims().size(), 2UL);
+  int k = param.w->dims()[0];
+  int n = param.w->dims()[1];
+  PackedWeightCache::Global().Pack(
+      "fc/" + PrecisionToStr(PRECISION(kBF16)), *param.w, &weights_, [&] {
+        weights_.Resize({lite::arm::math::bf16::get_packed_size_bf16(n, k)});
+        auto* w_packed = weights_.mutable_data<uint16_t>();
+        weights_.set_precision(PRECISION(kBF16));
+        lite::arm::math::bf16::prepackA_bf16(
+            w_packed, param.w->data<uint16_t>(), n, 0, n, 0, k, true);
+      });
+  // The packed weights are used by all the shapes.
+  flag_trans_weights_ = true;
+  ReInitWhenNeeded();
+}
+
 /// for int8 kernel with fp32 output
 template <>
 void FcCompute<PRECISION(kInt8), PRECISION(kFloat)>::PrepareForRun() {
@@ -139,6 +329,9 @@ void FcCompute<PRECISION(kInt8), PRECISION(kFloat)>::PrepareForRun() {
       scale_[i] = param.weight_scale[i] * input_scale;
     }
   }
+  if (param.input_zero_point != 0) {
+    FoldInputZeroPoint(1.f);
+  }
 }
 
 /// for int8 kernel with int8 output
@@ -163,76 +356,88 @@ void FcCompute<PRECISION(kInt8), PRECISION(kInt8)>::PrepareForRun() {
   if (param.bias) {
     bias_.Resize(param.bias->dims());
     auto* ptr = bias_.mutable_data<float>();
-    auto* ptr_in = param.bias->data<float>();
+    auto* ptr_in = param.bias->template data<float>();
     float out_scale = param.output_scale;
     for (int i = 0; i < bias_.numel(); ++i) {
       ptr[i] = ptr_in[i] / out_scale;
     }
     flag_trans_bias_ = true;
   }
+  if (param.input_zero_point != 0) {
+    FoldInputZeroPoint(output_scale);
+  }
 }
 
 template <>
 void FcCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   auto& param = this->Param<operators::FcParam>();
   auto& ctx = this->ctx_->template As<ARMContext>();
+  if (flag_weight_only_) {
+    const float* b_data = param.bias ? param.bias->data<float>() : nullptr;
+    bool flag_relu = param.activation_type == "relu";
+    if (param.weight_quant_bits == 4) {
+      lite::arm::math::gemm_int4(param.input->data<float>(),
+                                 weights_.data<uint8_t>(),
+                                 param.weight_quant_scale.data(),
+                                 b_data,
+                                 param.output->mutable_data<float>(),
+                                 m_,
+                                 n_,
+                                 k_,
+                                 param.weight_group_size,
+                                 flag_relu);
+    } else {
+      lite::arm::math::gemm_weight_int8(param.input->data<float>(),
+                                        weights_.data<int8_t>(),
+                                        param.weight_quant_scale.data(),
+                                        b_data,
+                                        param.output->mutable_data<float>(),
+                                        m_,
+                                        n_,
+                                        k_,
+                                        flag_relu);
+    }
+    return;
+  }
 
-  auto* i_data = param.input->data<float>();
-  auto* o_data = param.output->mutable_data<float>();
   auto* w_data = flag_gemm_ ? param.w->data<float>() : weights_.data<float>();
   const float* b_data = param.bias ? param.bias->data<float>() : nullptr;
   if (flag_trans_bias_) {
     b_data = bias_.data<float>();
   }
+  fc_compute_fp32(param, &ctx, w_data, b_data, m_, n_, k_, flag_gemm_);
+}
+
+template <>
+void FcCompute<PRECISION(kBF16), PRECISION(kFloat)>::Run() {
+  auto& param = this->Param<operators::FcParam>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  const float* b_data = param.bias ? param.bias->data<float>() : nullptr;
+  if (!flag_bf16_) {
+    auto* w_data =
+        flag_gemm_ ? param.w->data<float>() : weights_.data<float>();
+    fc_compute_fp32(param, &ctx, w_data, b_data, m_, n_, k_, flag_gemm_);
+    return;
+  }
+  auto* i_data = param.input->data<float>();
+  auto* o_data = param.output->mutable_data<float>();
   operators::ActivationParam act_param;
   act_param.has_active = false;
-  if (flag_gemm_) {
-    lite::arm::math::sgemm(false,
-                           false,
-                           m_,
-                           n_,
-                           k_,
-                           1.f,
-                           i_data,
-                           k_,
-                           w_data,
-                           n_,
-                           0.f,
-                           o_data,
-                           n_,
-                           nullptr,
-                           false,
-                           act_param,
-                           &ctx);
-    if (param.bias) {
-      bool flag_act = false;
-      if (param.activation_type == "relu") {
-        flag_act = true;
-      }
-      CHECK_EQ(param.bias->numel(), n_);
-      lite::arm::math::fill_bias_fc(o_data, b_data, m_, n_, flag_act);
-    }
-  } else {
-    if (param.activation_type == "relu") {
-      act_param.active_type = lite_api::ActivationType::kRelu;
-      act_param.has_active = true;
-    }
-    for (int i = 0; i < m_; ++i) {
-      auto* i_data_batch = i_data + i * k_;
-      auto* o_data_batch = o_data + i * n_;
-      lite::arm::math::sgemv(w_data,
-                             i_data_batch,
-                             o_data_batch,
-                             false,
-                             n_,
-                             k_,
-                             0.f,
-                             param.bias != nullptr,
-                             b_data,
-                             act_param,
-                             &ctx);
-    }
+  if (param.activation_type == "relu") {
+    act_param.active_type = lite_api::ActivationType::kRelu;
+    act_param.has_active = true;
   }
+  lite::arm::math::bf16::gemm_prepack_b_bf16(i_data,
+                                             weights_.data<uint16_t>(),
+                                             b_data,
+                                             o_data,
+                                             m_,
+                                             n_,
+                                             k_,
+                                             param.bias != nullptr,
+                                             false,
+                                             act_param,
+                                             &ctx);
 }
 
 template <>
@@ -270,14 +475,32 @@ void FcCompute<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
                              scale_.data(),
                              act_param,
                              &ctx);
-    if (param.bias) {
-      CHECK_EQ(param.bias->numel(), n_);
+    if (b_data) {
+      if (param.bias) CHECK_EQ(param.bias->numel(), n_);
       lite::arm::math::fill_bias_fc(o_data, b_data, m_, n_, flag_relu);
     }
   } else {
+    // the gemv applies the relu after the bias
+    if (flag_relu) {
+      act_param.has_active = true;
+      act_param.active_type = act;
+    }
     for (int i = 0; i < m_; ++i) {
       auto* i_data_batch = i_data + i * k_;
       auto* o_data_batch = o_data + i * n_;
+      if (flag_packed_gemv_) {
+        lite::arm::math::gemv_int8_packed(w_data,
+                                          i_data_batch,
+                                          o_data_batch,
+                                          n_,
+                                          k_,
+                                          scale_.data(),
+                                          b_data != nullptr,
+                                          b_data,
+                                          act_param,
+                                          &ctx);
+        continue;
+      }
       lite::arm::math::gemv_int8(w_data,
                                  i_data_batch,
                                  o_data_batch,
@@ -285,7 +508,7 @@ void FcCompute<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
                                  n_,
                                  k_,
                                  scale_.data(),
-                                 param.bias != nullptr,
+                                 b_data != nullptr,
                                  b_data,
                                  act_param,
                                  &ctx);
@@ -337,6 +560,19 @@ void FcCompute<PRECISION(kInt8), PRECISION(kInt8)>::Run() {
     for (int i = 0; i < m_; ++i) {
       auto* i_data_batch = i_data + i * k_;
       auto* o_data_batch = o_data + i * n_;
+      if (flag_packed_gemv_) {
+        lite::arm::math::gemv_int8_packed(w_data,
+                                          i_data_batch,
+                                          o_data_batch,
+                                          n_,
+                                          k_,
+                                          scale_.data(),
+                                          b_data != nullptr,
+                                          b_data,
+                                          act_param,
+                                          &ctx);
+        continue;
+      }
       lite::arm::math::gemv_int8(w_data,
                                  i_data_batch,
                                  o_data_batch,
@@ -344,7 +580,7 @@ void FcCompute<PRECISION(kInt8), PRECISION(kInt8)>::Run() {
                                  n_,
                                  k_,
                                  scale_.data(),
-                                 param.bias != nullptr,
+                                 b_data != nullptr,
                                  b_data,
                                  act_param,
                                  &ctx);
@@ -448,6 +684,9 @@ typedef paddle::lite::kernels::arm::FcCompute<PRECISION(kInt8),
 typedef paddle::lite::kernels::arm::FcCompute<PRECISION(kInt8),
                                               PRECISION(kInt8)>
     FcCompute_int8_int8;
+typedef paddle::lite::kernels::arm::FcCompute<PRECISION(kBF16),
+                                              PRECISION(kFloat)>
+    FcCompute_BF16;
 
 #ifdef ENABLE_ARM_FP16
 typedef paddle::lite::kernels::arm::FcCompute<PRECISION(kFP16),
@@ -470,6 +709,17 @@ REGISTER_LITE_KERNEL(fc, kARM, kFloat, kNCHW, FcCompute_FP32, def)
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
     .Finalize();
 
+// The W of the bf16 fc is converted to bf16 when loaded.
+REGISTER_LITE_KERNEL(fc, kARM, kBF16, kNCHW, FcCompute_BF16, def)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindInput("W", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kAny))})
+    .BindInput("Alpha",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .Finalize();
+
 REGISTER_LITE_KERNEL(fc, kARM, kInt8, kNCHW, FcCompute_int8_int8, int8out)
     .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
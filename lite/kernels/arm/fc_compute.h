@@ -36,12 +36,22 @@ class FcCompute : public KernelLite<TARGET(kARM), PType> {
   ~FcCompute() = default;
 
  private:
+  // Fold the zero point of the asymmetric int8 input into bias_.
+  void FoldInputZeroPoint(float output_scale);
+
   DDim last_shape_;
   Tensor weights_;
   Tensor bias_;
   bool flag_trans_weights_{false};
   bool flag_trans_bias_{false};
   bool flag_gemm_{true};
+  // Whether the int8 gemv runs the weights packed for the sdot.
+  bool flag_packed_gemv_{false};
+  // Whether the fp32 kernel runs the int4 or int8 weight-only quantized
+  // weight.
+  bool flag_weight_only_{false};
+  // Whether the bf16 kernel runs the bf16 gemm, or falls back to fp32.
+  bool flag_bf16_{false};
   int m_;
   int n_;
   int k_;
@@ -0,0 +1,92 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/arm/fused_embedding_seq_pool_compute.h"
+#include <vector>
+#include "lite/backends/arm/math/funcs.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/tensor.h"
+#include "lite/core/type_system.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+void FusedEmbeddingSeqPoolCompute::Run() {
+  auto& param = this->Param<param_t>();
+  auto w = param.W;
+  auto ids = param.Ids;
+  auto out = param.Out;
+
+  auto table_dim = w->dims();
+  const auto& lod = ids->lod()[ids->lod().size() - 1];
+  auto ids_data = ids->data<int64_t>();
+  auto table_data = w->data<float>();
+  auto dout = out->mutable_data<float>();
+
+  if (param.dequant) {
+    lite::arm::math::embedding_dequant_seq_pool(table_data,
+                                                ids_data,
+                                                dout,
+                                                lod,
+                                                table_dim[0],
+                                                table_dim[1],
+                                                out->dims()[1],
+                                                param.quant_bits,
+                                                param.padding_idx,
+                                                param.pool_type,
+                                                param.pad_value);
+  } else {
+    lite::arm::math::embedding_seq_pool(table_data,
+                                        ids_data,
+                                        dout,
+                                        lod,
+                                        table_dim[0],
+                                        table_dim[1],
+                                        param.padding_idx,
+                                        param.pool_type,
+                                        param.pad_value);
+  }
+
+  // the same lod as sequence_pool
+  int batch_size = lod.size() - 1;
+  std::vector<uint64_t> offset_new;
+  if (ids->lod().size() == 2) {
+    offset_new = ids->lod()[0];
+  } else {
+    offset_new.resize(batch_size + 1);
+    for (int i = 0; i <= batch_size; i++) {
+      offset_new[i] = i;
+    }
+  }
+  out->mutable_lod()->clear();
+  out->mutable_lod()->push_back(offset_new);
+}
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fused_embedding_seq_pool,
+                     kARM,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::arm::FusedEmbeddingSeqPoolCompute,
+                     def)
+    .BindInput("W", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Ids", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt64))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .Finalize();
@@ -40,11 +40,12 @@ namespace arm {
   bool align_corners = param.align_corners;           \
   int align_mode = param.align_mode;                  \
   auto scale_v = param.scale_v;                       \
-  std::string interp_method = method_name;
+  std::string interp_method = method_name;            \
+  int threads = ctx_->As<ARMContext>().threads();
 
 #define INTERP_PARAM                                                      \
   X, OutSize, SizeTensor, Scale, Out, out_h, out_w, scale, align_corners, \
-      align_mode, interp_method, scale_v
+      align_mode, interp_method, scale_v, &table_, threads
 
 template <>
 void BilinearInterpCompute<PRECISION(kFloat)>::Run() {
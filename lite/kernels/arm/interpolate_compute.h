@@ -14,6 +14,7 @@
 
 #pragma once
 #include <string>
+#include "lite/backends/arm/math/interpolate.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 
@@ -21,12 +22,29 @@ namespace paddle {
 namespace lite {
 namespace kernels {
 namespace arm {
+
+// the type of the bilinear weights computed in
+template <PrecisionType Ptype>
+struct InterpWeightType {
+  typedef float type;
+};
+
+#ifdef ENABLE_ARM_FP16
+template <>
+struct InterpWeightType<PRECISION(kFP16)> {
+  typedef float16_t type;
+};
+#endif
+
 template <PrecisionType Ptype>
 class BilinearInterpCompute : public KernelLite<TARGET(kARM), Ptype> {
  public:
   void Run() override;
 
   virtual ~BilinearInterpCompute() = default;
+
+ private:
+  lite::arm::math::InterpTable<typename InterpWeightType<Ptype>::type> table_;
 };
 
 template <PrecisionType Ptype>
@@ -35,6 +53,9 @@ class NearestInterpCompute : public KernelLite<TARGET(kARM), Ptype> {
   void Run() override;
 
   virtual ~NearestInterpCompute() = default;
+
+ private:
+  lite::arm::math::InterpTable<typename InterpWeightType<Ptype>::type> table_;
 };
 
 template <PrecisionType Ptype>
@@ -43,6 +64,9 @@ class NearestInterpComputeV2 : public KernelLite<TARGET(kARM), Ptype> {
   void Run() override;
 
   virtual ~NearestInterpComputeV2() = default;
+
+ private:
+  lite::arm::math::InterpTable<float> table_;
 };
 
 } /* namespace arm */
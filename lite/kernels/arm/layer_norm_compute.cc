@@ -14,15 +14,20 @@
 
 #include "lite/kernels/arm/layer_norm_compute.h"
 #include "lite/backends/arm/math/funcs.h"
+#ifdef ENABLE_ARM_FP16
+#include "lite/backends/arm/math/fp16/funcs_fp16.h"
+#endif
 
 namespace paddle {
 namespace lite {
 namespace kernels {
 namespace arm {
 
-void LayerNormCompute::PrepareForRun() {}
+template <typename T, PrecisionType PType>
+void LayerNormCompute<T, PType>::PrepareForRun() {}
 
-void LayerNormCompute::Run() {
+template <>
+void LayerNormCompute<float, PRECISION(kFloat)>::Run() {
   auto& param = this->Param<operators::LayerNormParam>();
 
   auto input_dims = param.X->dims();
@@ -43,21 +48,160 @@ void LayerNormCompute::Run() {
       x_data, scale, bias, o_data, mean, var, param.epsilon, left, right);
 }
 
+template <>
+void FusionElementwiseAddLayerNormCompute<float, PRECISION(kFloat)>::Run() {
+  auto& param = this->Param<param_t>();
+
+  const auto* x_data = param.X->data<float>();
+  const auto* r_data = param.Residual->data<float>();
+  const auto* scale = param.Scale ? param.Scale->data<float>() : nullptr;
+  const auto* bias = param.Bias ? param.Bias->data<float>() : nullptr;
+  auto* add_out = param.AddOut ? param.AddOut->mutable_data<float>() : nullptr;
+  auto* o_data = param.Y->mutable_data<float>();
+  auto* mean = param.Mean->mutable_data<float>();
+  auto* var = param.Variance->mutable_data<float>();
+
+  auto matrix_dim = param.X->dims().Flatten2D(param.begin_norm_axis);
+  int left = matrix_dim[0];
+  int right = matrix_dim[1];
+  int residual_rows = param.Residual->numel() / right;
+
+  lite::arm::math::matrix_add_norm_row(x_data,
+                                       r_data,
+                                       residual_rows,
+                                       scale,
+                                       bias,
+                                       add_out,
+                                       o_data,
+                                       mean,
+                                       var,
+                                       param.epsilon,
+                                       left,
+                                       right);
+}
+
+#ifdef ENABLE_ARM_FP16
+template <>
+void LayerNormCompute<float16_t, PRECISION(kFP16)>::Run() {
+  auto& param = this->Param<operators::LayerNormParam>();
+
+  const auto* x_data = param.X->data<float16_t>();
+  const auto* scale = param.Scale ? param.Scale->data<float>() : nullptr;
+  const auto* bias = param.Bias ? param.Bias->data<float>() : nullptr;
+  auto* o_data = param.Y->mutable_data<float16_t>();
+  auto* mean = param.Mean->mutable_data<float>();
+  auto* var = param.Variance->mutable_data<float>();
+
+  auto matrix_dim = param.X->dims().Flatten2D(param.begin_norm_axis);
+  int left = matrix_dim[0];
+  int right = matrix_dim[1];
+
+  lite::arm::math::fp16::matrix_norm_row(
+      x_data, scale, bias, o_data, mean, var, param.epsilon, left, right);
+}
+
+template <>
+void FusionElementwiseAddLayerNormCompute<float16_t, PRECISION(kFP16)>::Run() {
+  auto& param = this->Param<param_t>();
+
+  const auto* x_data = param.X->data<float16_t>();
+  const auto* r_data = param.Residual->data<float16_t>();
+  const auto* scale = param.Scale ? param.Scale->data<float>() : nullptr;
+  const auto* bias = param.Bias ? param.Bias->data<float>() : nullptr;
+  auto* add_out =
+      param.AddOut ? param.AddOut->mutable_data<float16_t>() : nullptr;
+  auto* o_data = param.Y->mutable_data<float16_t>();
+  auto* mean = param.Mean->mutable_data<float>();
+  auto* var = param.Variance->mutable_data<float>();
+
+  auto matrix_dim = param.X->dims().Flatten2D(param.begin_norm_axis);
+  int left = matrix_dim[0];
+  int right = matrix_dim[1];
+  int residual_rows = param.Residual->numel() / right;
+
+  lite::arm::math::fp16::matrix_add_norm_row(x_data,
+                                             r_data,
+                                             residual_rows,
+                                             scale,
+                                             bias,
+                                             add_out,
+                                             o_data,
+                                             mean,
+                                             var,
+                                             param.epsilon,
+                                             left,
+                                             right);
+}
+#endif  // ENABLE_ARM_FP16
+
 }  // namespace arm
 }  // namespace kernels
 }  // namespace lite
 }  // namespace paddle
 
-REGISTER_LITE_KERNEL(layer_norm,
+typedef paddle::lite::kernels::arm::LayerNormCompute<float, PRECISION(kFloat)>
+    LayerNormFp32;
+typedef paddle::lite::kernels::arm::
+    FusionElementwiseAddLayerNormCompute<float, PRECISION(kFloat)>
+        AddLayerNormFp32;
+
+REGISTER_LITE_KERNEL(layer_norm, kARM, kFloat, kNCHW, LayerNormFp32, def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Y", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Mean", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Variance", {LiteType::GetTensorTy(TARGET(kARM))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(fusion_elementwise_add_layer_norm,
                      kARM,
                      kFloat,
                      kNCHW,
-                     paddle::lite::kernels::arm::LayerNormCompute,
+                     AddLayerNormFp32,
                      def)
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Residual", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Y", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Mean", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Variance", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("AddOut", {LiteType::GetTensorTy(TARGET(kARM))})
+    .Finalize();
+
+#ifdef ENABLE_ARM_FP16
+typedef paddle::lite::kernels::arm::LayerNormCompute<float16_t,
+                                                     PRECISION(kFP16)>
+    LayerNormFp16;
+typedef paddle::lite::kernels::arm::
+    FusionElementwiseAddLayerNormCompute<float16_t, PRECISION(kFP16)>
+        AddLayerNormFp16;
+
+REGISTER_LITE_KERNEL(layer_norm, kARM, kFP16, kNCHW, LayerNormFp16, def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Y", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindOutput("Mean", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Variance", {LiteType::GetTensorTy(TARGET(kARM))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(fusion_elementwise_add_layer_norm,
+                     kARM,
+                     kFP16,
+                     kNCHW,
+                     AddLayerNormFp16,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindInput("Residual",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Y", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindOutput("Mean", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Variance", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("AddOut",
+                {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
     .Finalize();
+#endif  // ENABLE_ARM_FP16
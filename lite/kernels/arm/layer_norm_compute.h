@@ -23,7 +23,8 @@ namespace lite {
 namespace kernels {
 namespace arm {
 
-class LayerNormCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
+template <typename T, PrecisionType PType>
+class LayerNormCompute : public KernelLite<TARGET(kARM), PType> {
  public:
   using param_t = operators::LayerNormParam;
 
@@ -34,6 +35,18 @@ class LayerNormCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
   ~LayerNormCompute() {}
 };
 
+// The layer_norm of the sum with a residual, added row by row.
+template <typename T, PrecisionType PType>
+class FusionElementwiseAddLayerNormCompute
+    : public KernelLite<TARGET(kARM), PType> {
+ public:
+  using param_t = operators::FusionElementwiseAddLayerNormParam;
+
+  void Run() override;
+
+  ~FusionElementwiseAddLayerNormCompute() {}
+};
+
 }  // namespace arm
 }  // namespace kernels
 }  // namespace lite
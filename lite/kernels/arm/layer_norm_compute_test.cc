@@ -77,13 +77,13 @@ void LayerNormComputeRef(const operators::LayerNormParam& param) {
 }
 
 TEST(layer_norm_arm, init) {
-  LayerNormCompute layer_norm;
+  LayerNormCompute<float, PRECISION(kFloat)> layer_norm;
   ASSERT_EQ(layer_norm.precision(), PRECISION(kFloat));
   ASSERT_EQ(layer_norm.target(), TARGET(kARM));
 }
 
 TEST(layer_norm_arm, compute) {
-  LayerNormCompute layer_norm;
+  LayerNormCompute<float, PRECISION(kFloat)> layer_norm;
   operators::LayerNormParam param;
 
   lite::Tensor x;
@@ -20,6 +20,8 @@ namespace lite {
 namespace kernels {
 namespace arm {
 
+// The NHWC tensors keep the logical NCHW dims of the ops and only store the
+// images channel last, like the FPGA ones, see nhwc_compute.h.
 #define NCHWTONHWC(type)                                                 \
   auto& param = this->template Param<param_t>();                         \
   auto input = param.x->template data<type>();                           \
@@ -35,7 +37,7 @@ namespace arm {
   int c = input_dim[1];                                                  \
   int h = input_dim[2];                                                  \
   int w = input_dim[3];                                                  \
-  param.y->Resize({n, h, w, c});                                         \
+  param.y->Resize(input_dim);                                            \
   auto output = param.y->template mutable_data<type>(TARGET(kARM));      \
   if (c == 1) {                                                          \
     memcpy(output, input, sizeof(type) * n * h * w);                     \
@@ -55,10 +57,10 @@ namespace arm {
     return;                                                              \
   }                                                                      \
   int n = input_dim[0];                                                  \
-  int h = input_dim[1];                                                  \
-  int w = input_dim[2];                                                  \
-  int c = input_dim[3];                                                  \
-  param.y->Resize({n, c, h, w});                                         \
+  int c = input_dim[1];                                                  \
+  int h = input_dim[2];                                                  \
+  int w = input_dim[3];                                                  \
+  param.y->Resize(input_dim);                                            \
   auto output = param.y->template mutable_data<type>(TARGET(kARM));      \
   if (c == 1) {                                                          \
     memcpy(output, input, sizeof(type) * n * h * w);                     \
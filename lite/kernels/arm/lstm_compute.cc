@@ -27,7 +27,43 @@ namespace lite {
 namespace kernels {
 namespace arm {
 
+// gate[M,N] += h[M,K] * Weight[K,N]. A single row goes to the gemv of
+// sgemm, more rows use the weight packed in PrepareForRun.
+static void RecurrentGemm(const float* h,
+                          const Tensor& weight,
+                          const Tensor& packed_weight,
+                          int M,
+                          int N,
+                          int K,
+                          float* gate,
+                          ARMContext* ctx) {
+  if (M > 1 && packed_weight.numel() > 0) {
+    lite::arm::math::sgemm_recurrent(packed_weight, h, M, N, K, 1.f, gate, ctx);
+    return;
+  }
+  operators::ActivationParam act_param;
+  act_param.has_active = false;
+  lite::arm::math::sgemm(false,
+                         false,
+                         M,
+                         N,
+                         K,
+                         1,
+                         h,
+                         K,
+                         weight.data<float>(),
+                         N,
+                         1,
+                         gate,
+                         N,
+                         nullptr,
+                         false,
+                         act_param,
+                         ctx);
+}
+
 void LSTMComputeRun(const operators::LstmParam& param,
+                    const Tensor& packed_weight,
                     ARMContext* ctx,
                     bool enable_int8) {
   auto input = param.Input;
@@ -124,8 +160,6 @@ void LSTMComputeRun(const operators::LstmParam& param,
         lite::arm::math::row_offset(*batch_cell_pre_act, bstart);
 
     int cur_batch_size = bend - bstart;
-    operators::ActivationParam act_param;
-    act_param.has_active = false;
     lite_api::ActivationType act_type;
 
     if (n > 0) {
@@ -178,23 +212,8 @@ void LSTMComputeRun(const operators::LstmParam& param,
           gate_t[i] += o_data[i];
         }
       } else {
-        lite::arm::math::sgemm(false,
-                               false,
-                               M,
-                               N,
-                               K,
-                               1,
-                               pre_hidden_t,
-                               K,
-                               weight->data<float>(),
-                               N,
-                               1,
-                               gate_t,
-                               N,
-                               nullptr,
-                               false,
-                               act_param,
-                               ctx);
+        RecurrentGemm(
+            pre_hidden_t, *weight, packed_weight, M, N, K, gate_t, ctx);
       }
     } else if (hidden_t0) {
       // If n == 0 and there is no initialized hidden state, that is to say
@@ -209,23 +228,14 @@ void LSTMComputeRun(const operators::LstmParam& param,
       int M = bend - bstart;
       int N = matrix_width;
       int K = frame_size;
-      lite::arm::math::sgemm(false,
-                             false,
-                             M,
-                             N,
-                             K,
-                             1,
-                             ordered_h0.data<float>(),
-                             K,
-                             weight->data<float>(),
-                             N,
-                             1,
-                             gate_t,
-                             N,
-                             nullptr,
-                             false,
-                             act_param,
-                             ctx);
+      RecurrentGemm(ordered_h0.data<float>(),
+                    *weight,
+                    packed_weight,
+                    M,
+                    N,
+                    K,
+                    gate_t,
+                    ctx);
     }
 
     lstm_value.gate_value = gate_t;
@@ -254,18 +264,31 @@ void LSTMComputeRun(const operators::LstmParam& param,
   to_seq(batch_cell, cell_out);
 }
 
+template <>
+void LstmCompute<PRECISION(kFloat)>::PrepareForRun() {
+  auto& param = this->Param<operators::LstmParam>();
+  auto& ctx = this->ctx_->As<ARMContext>();
+  int K = param.Weight->dims()[0];
+  int N = param.Weight->dims()[1];
+  lite::arm::math::prepack_recurrent_weight(
+      param.Weight->data<float>(), false, N, K, &packed_weight_, &ctx);
+}
+
 template <>
 void LstmCompute<PRECISION(kFloat)>::Run() {
   auto& param = this->Param<operators::LstmParam>();
   auto& ctx = this->ctx_->As<ARMContext>();
-  LSTMComputeRun(param, &ctx, false);
+  LSTMComputeRun(param, packed_weight_, &ctx, false);
 }
 
+template <>
+void LstmCompute<PRECISION(kInt8)>::PrepareForRun() {}
+
 template <>
 void LstmCompute<PRECISION(kInt8)>::Run() {
   auto& param = this->Param<operators::LstmParam>();
   auto& ctx = this->ctx_->As<ARMContext>();
-  LSTMComputeRun(param, &ctx, true);
+  LSTMComputeRun(param, packed_weight_, &ctx, true);
 }
 
 }  // namespace arm
@@ -25,9 +25,15 @@ namespace arm {
 template <PrecisionType Ptype>
 class LstmCompute : public KernelLite<TARGET(kARM), Ptype> {
  public:
+  void PrepareForRun() override;
+
   void Run() override;
 
   virtual ~LstmCompute() = default;
+
+ private:
+  // Weight^T packed once for the per-step gemms of the float kernel
+  Tensor packed_weight_;
 };
 
 }  // namespace arm
@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include "lite/kernels/arm/matmul_compute.h"
+#include <algorithm>
 #include <vector>
+#include "lite/backends/arm/math/bf16/funcs_bf16.h"
 #include "lite/backends/arm/math/funcs.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/type_system.h"
@@ -127,11 +129,21 @@ namespace arm {
 
 template <>
 void MatMulCompute<PRECISION(kFloat), PRECISION(kFloat)>::ReInitWhenNeeded() {
+  // the strided gemms take their shapes from the transposed views
+  if (lite::host::math::has_fused_transpose(Param<param_t>())) return;
   INIT_PARAM
   last_x_shape_ = x_dims;
   last_y_shape_ = y_dims;
 }
 
+template <>
+void MatMulCompute<PRECISION(kBF16), PRECISION(kFloat)>::ReInitWhenNeeded() {
+  INIT_PARAM
+  flag_y_packed_ = false;
+  last_x_shape_ = x_dims;
+  last_y_shape_ = y_dims;
+}
+
 template <>
 void MatMulCompute<PRECISION(kInt8), PRECISION(kFloat)>::ReInitWhenNeeded() {
   INIT_PARAM
@@ -157,10 +169,15 @@ void MatMulCompute<PRECISION(kInt8), PRECISION(kFloat)>::ReInitWhenNeeded() {
   last_y_shape_ = y_dims;
 }
 
-template <>
-void MatMulCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
-  auto& param = Param<param_t>();
-
+// The fp32 matmul, also used by the bf16 kernel on the cpus without bf16.
+void matmul_compute_fp32(const operators::MatMulParam& param,
+                         ARMContext* ctx,
+                         int m,
+                         int n,
+                         int k,
+                         int lda,
+                         int ldb,
+                         int ldc) {
   const auto* x_data = param.X->data<float>();
   const auto* y_data = param.Y->data<float>();
   auto* o_data = param.Out->mutable_data<float>();
@@ -171,7 +188,6 @@ void MatMulCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   bool x_transpose = param.transpose_X;
   bool y_transpose = param.transpose_Y;
   float alpha = param.alpha;
-  auto& ctx = this->ctx_->template As<ARMContext>();
   operators::ActivationParam act_param;
   act_param.has_active = false;
 
@@ -190,61 +206,70 @@ void MatMulCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
       for (size_t i = 0; i < x_dims.count(0, x_dims.size() - 2); ++i) {
         lite::arm::math::sgemm(x_transpose,
                                y_transpose,
-                               m_,
-                               n_,
-                               k_,
+                               m,
+                               n,
+                               k,
                                alpha,
                                x_data + i * x_inner,
-                               lda_,
+                               lda,
                                y_data + i * y_inner,
-                               ldb_,
+                               ldb,
                                0.f,
                                o_data + i * out_inner,
-                               ldc_,
+                               ldc,
                                nullptr,
                                false,
                                act_param,
-                               &ctx);
+                               ctx);
+        if (param.fuse_softmax) {
+          lite::arm::math::softmax_rows(o_data + i * out_inner, m, n);
+        }
       }
     } else if (x_dims.size() > 2 && y_dims.size() == 2) {
       for (size_t i = 0; i < x_dims.count(0, x_dims.size() - 2); ++i) {
         lite::arm::math::sgemm(x_transpose,
                                y_transpose,
-                               m_,
-                               n_,
-                               k_,
+                               m,
+                               n,
+                               k,
                                alpha,
                                x_data + i * x_inner,
-                               lda_,
+                               lda,
                                y_data,
-                               ldb_,
+                               ldb,
                                0.f,
                                o_data + i * out_inner,
-                               ldc_,
+                               ldc,
                                nullptr,
                                false,
                                act_param,
-                               &ctx);
+                               ctx);
+        if (param.fuse_softmax) {
+          lite::arm::math::softmax_rows(o_data + i * out_inner, m, n);
+        }
       }
     } else if (x_dims.size() == 2 && y_dims.size() > 2) {
       for (size_t i = 0; i < y_dims.count(0, y_dims.size() - 2); ++i) {
         lite::arm::math::sgemm(x_transpose,
                                y_transpose,
-                               m_,
-                               n_,
-                               k_,
+                               m,
+                               n,
+                               k,
                                alpha,
                                x_data,
-                               lda_,
+                               lda,
                                y_data + i * y_inner,
-                               ldb_,
+                               ldb,
                                0.f,
                                o_data + i * out_inner,
-                               ldc_,
+                               ldc,
                                nullptr,
                                false,
                                act_param,
-                               &ctx);
+                               ctx);
+        if (param.fuse_softmax) {
+          lite::arm::math::softmax_rows(o_data + i * out_inner, m, n);
+        }
       }
     }
   } else if ((x_dims.size() == 2 && y_dims.size() == 2) ||
@@ -252,40 +277,40 @@ void MatMulCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
     // x: [M, K], y: [K, N], out: [M, N]
     lite::arm::math::sgemm(x_transpose,
                            y_transpose,
-                           m_,
-                           n_,
-                           k_,
+                           m,
+                           n,
+                           k,
                            alpha,
                            x_data,
-                           lda_,
+                           lda,
                            y_data,
-                           ldb_,
+                           ldb,
                            0.f,
                            o_data,
-                           ldc_,
+                           ldc,
                            nullptr,
                            false,
                            act_param,
-                           &ctx);
+                           ctx);
   } else if (x_dims.size() >= 2 && y_dims.size() == 1) {
     // x: [B, M, K], y: [K], out: [B, M]
     lite::arm::math::sgemm(x_transpose,
                            false,
-                           m_,
-                           n_,
-                           k_,
+                           m,
+                           n,
+                           k,
                            alpha,
                            x_data,
-                           lda_,
+                           lda,
                            y_data,
-                           ldb_,
+                           ldb,
                            0.f,
                            o_data,
-                           ldc_,
+                           ldc,
                            nullptr,
                            false,
                            act_param,
-                           &ctx);
+                           ctx);
   } else if (x_dims.size() == 1 && y_dims.size() == 1) {
     // x: [K], y: [K], out: [1]
     if (x_transpose == false && y_transpose == false) {
@@ -296,21 +321,21 @@ void MatMulCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
     } else if (x_transpose == true && y_transpose == true) {
       lite::arm::math::sgemm(false,
                              false,
-                             m_,
-                             n_,
-                             k_,
+                             m,
+                             n,
+                             k,
                              alpha,
                              x_data,
-                             lda_,
+                             lda,
                              y_data,
-                             ldb_,
+                             ldb,
                              0.f,
                              o_data,
-                             ldc_,
+                             ldc,
                              nullptr,
                              false,
                              act_param,
-                             &ctx);
+                             ctx);
     } else {
       LOG(FATAL) << "not supported x_dims.(" << x_dims << ") and y_dims("
                  << y_dims << ")"
@@ -321,6 +346,109 @@ void MatMulCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
     LOG(FATAL) << "not supported x_dims(" << x_dims << ") and y_dims(" << y_dims
                << ")";
   }
+  // the batched gemms above have applied it per batch
+  if (param.fuse_softmax && (x_dims.size() < 2 || y_dims.size() < 2 ||
+                             (x_dims.size() == 2 && y_dims.size() == 2))) {
+    const int cols = o_dims[o_dims.size() - 1];
+    lite::arm::math::softmax_rows(o_data, o_dims.production() / cols, cols);
+  }
+}
+
+template <>
+void MatMulCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
+  auto& param = Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  if (lite::host::math::has_fused_transpose(param)) {
+    lite::host::math::StridedMatmulArgs args;
+    lite::host::math::strided_matmul_args(param, &args);
+    auto* o_data = param.Out->mutable_data<float>();
+    lite::arm::math::sgemm_strided_batch(args,
+                                         param.alpha,
+                                         param.X->data<float>(),
+                                         param.Y->data<float>(),
+                                         o_data,
+                                         &ctx);
+    if (param.fuse_softmax) {
+      lite::arm::math::softmax_rows(
+          o_data, param.Out->numel() / args.n, args.n);
+    }
+    return;
+  }
+  matmul_compute_fp32(param, &ctx, m_, n_, k_, lda_, ldb_, ldc_);
+}
+
+// The matmuls of the matrices run the bf16 gemm, with Y packed as the
+// weights, and the vectors run in fp32.
+template <>
+void MatMulCompute<PRECISION(kBF16), PRECISION(kFloat)>::Run() {
+  auto& param = Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto x_dims = param.X->dims();
+  auto y_dims = param.Y->dims();
+  if (!ctx.has_bf16() || x_dims.size() < 2 || y_dims.size() < 2) {
+    // Y is bf16 only if it is a weight.
+    lite::arm::math::bf16::tensor_bf16_to_fp32(const_cast<Tensor*>(param.Y));
+    matmul_compute_fp32(param, &ctx, m_, n_, k_, lda_, ldb_, ldc_);
+    return;
+  }
+  bool y_transpose = param.transpose_Y;
+  int x_batch = x_dims.count(0, x_dims.size() - 2);
+  int y_batch = y_dims.count(0, y_dims.size() - 2);
+  int packed_size = lite::arm::math::bf16::get_packed_size_bf16(n_, k_);
+  if (!flag_y_packed_) {
+    y_packed_.Resize({y_batch * packed_size});
+    auto* y_packed = y_packed_.mutable_data<uint16_t>();
+    for (int i = 0; i < y_batch; i++) {
+      // Y is K x N, or N x K if transposed.
+      if (param.Y->precision() == PRECISION(kBF16)) {
+        lite::arm::math::bf16::prepackA_bf16(
+            y_packed + i * packed_size,
+            param.Y->data<uint16_t>() + i * k_ * n_,
+            ldb_,
+            0,
+            n_,
+            0,
+            k_,
+            !y_transpose);
+      } else {
+        lite::arm::math::bf16::prepackA_bf16(
+            y_packed + i * packed_size,
+            param.Y->data<float>() + i * k_ * n_,
+            ldb_,
+            0,
+            n_,
+            0,
+            k_,
+            !y_transpose);
+      }
+    }
+    flag_y_packed_ = param.Y->persistable();
+  }
+
+  const auto* x_data = param.X->data<float>();
+  const auto* y_packed = y_packed_.data<uint16_t>();
+  auto* o_data = param.Out->mutable_data<float>();
+  operators::ActivationParam act_param;
+  act_param.has_active = false;
+  int batch = std::max(x_batch, y_batch);
+  for (int i = 0; i < batch; i++) {
+    lite::arm::math::bf16::gemm_prepack_b_bf16(
+        x_data + (x_batch > 1 ? i * m_ * k_ : 0),
+        y_packed + (y_batch > 1 ? i * packed_size : 0),
+        nullptr,
+        o_data + i * m_ * n_,
+        m_,
+        n_,
+        k_,
+        false,
+        param.transpose_X,
+        act_param,
+        &ctx);
+  }
+  if (param.alpha != 1.f) {
+    int num = static_cast<int>(param.Out->numel());
+    lite::arm::math::scale<float>(o_data, o_data, num, param.alpha, 0.f);
+  }
 }
 
 void matmul_add_n_scale_bias(float* o_data, float* scale, int m, int n) {
@@ -679,6 +807,10 @@ typedef paddle::lite::kernels::arm::MatMulCompute<PRECISION(kInt8),
                                                   PRECISION(kFloat)>
     Matmul_int8_f32;
 
+typedef paddle::lite::kernels::arm::MatMulCompute<PRECISION(kBF16),
+                                                  PRECISION(kFloat)>
+    Matmul_bf16_f32;
+
 #ifdef ENABLE_ARM_FP16
 typedef paddle::lite::kernels::arm::MatMulCompute<PRECISION(kFP16),
                                                   PRECISION(kFP16)>
@@ -697,6 +829,14 @@ REGISTER_LITE_KERNEL(matmul, kARM, kFloat, kNCHW, Matmul_f32_f32, def)
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
     .Finalize();
 
+// The Y of the bf16 matmul is either the fp32 activation or the weight
+// converted to bf16 when loaded.
+REGISTER_LITE_KERNEL(matmul, kARM, kBF16, kNCHW, Matmul_bf16_f32, def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kAny))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .Finalize();
+
 REGISTER_LITE_KERNEL(matmul, kARM, kInt8, kNCHW, Matmul_int8_f32, def)
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
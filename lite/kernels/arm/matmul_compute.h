@@ -47,6 +47,9 @@ class MatMulCompute : public KernelLite<TARGET(kARM), PType> {
   std::vector<float> scale_one;
   DDim last_x_shape_;
   DDim last_y_shape_;
+  // The Y packed by the bf16 kernel, packed once if Y is persistable.
+  Tensor y_packed_;
+  bool flag_y_packed_{false};
 };
 
 }  // namespace arm
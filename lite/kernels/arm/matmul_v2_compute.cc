@@ -13,9 +13,11 @@
 // limitations under the License.
 
 #include "lite/kernels/arm/matmul_v2_compute.h"
+#include <string>
 #include <vector>
 #include "lite/backends/arm/math/funcs.h"
 #include "lite/core/op_registry.h"
+#include "lite/core/packed_weight_cache.h"
 #include "lite/core/type_system.h"
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
@@ -148,14 +150,91 @@ namespace arm {
 
 template <>
 void MatMulV2Compute<PRECISION(kFloat), PRECISION(kFloat)>::ReInitWhenNeeded() {
+  // the strided gemms take their shapes from the transposed views
+  if (lite::host::math::has_fused_transpose(Param<param_t>()) ||
+      lite::host::math::has_broadcast_batch(Param<param_t>())) {
+    return;
+  }
   INIT_PARAM
   last_x_shape_ = x_dims;
   last_y_shape_ = y_dims;
+  // the group-wise int4 weight [K, N] is packed once and dequantized in the
+  // inner loop of gemm_int4
+  if (param.weight_quant_bits == 4 &&
+      param.Y->precision() == PRECISION(kInt8) && !flag_int4_) {
+    CHECK(y_dims.size() == 2 && !x_transpose && !y_transpose)
+        << "The int4 weight of matmul_v2 should be 2-D and not transposed";
+    flag_int4_ = true;
+    int k = y_dims[0];
+    int n = y_dims[1];
+    int group_size = param.weight_group_size;
+    CHECK_EQ(param.weight_quant_scale.size(),
+             static_cast<size_t>((k + group_size - 1) / group_size * n))
+        << "The int4 weight of matmul_v2 should have the scale of each group";
+    PackedWeightCache::Global().Pack(
+        "matmul_v2/int4/group:" + std::to_string(group_size),
+        *param.Y,
+        &packed_y_,
+        [&] {
+          packed_y_.Resize(
+              {lite::arm::math::packed_weight_int4_size(n, k, group_size)});
+          lite::arm::math::pack_weight_int4(param.Y->data<int8_t>(),
+                                            packed_y_.mutable_data<uint8_t>(),
+                                            n,
+                                            k,
+                                            group_size);
+        });
+  }
 }
 
 template <>
 void MatMulV2Compute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   auto& param = Param<param_t>();
+  if (lite::host::math::has_fused_transpose(param) ||
+      lite::host::math::has_broadcast_batch(param)) {
+    auto& ctx = this->ctx_->template As<ARMContext>();
+    lite::host::math::StridedMatmulArgs args;
+    lite::host::math::strided_matmul_args(param, &args);
+    auto* o_data = param.Out->mutable_data<float>();
+    lite::arm::math::sgemm_strided_batch(args,
+                                         param.alpha,
+                                         param.X->data<float>(),
+                                         param.Y->data<float>(),
+                                         o_data,
+                                         &ctx);
+    if (param.fuse_softmax) {
+      lite::arm::math::softmax_rows(
+          o_data, param.Out->numel() / args.n, args.n);
+    }
+    return;
+  }
+  if (flag_int4_) {
+    int k = param.Y->dims()[0];
+    int n = param.Y->dims()[1];
+    int m = param.X->numel() / k;
+    lite::arm::math::gemm_int4(param.X->data<float>(),
+                               packed_y_.data<uint8_t>(),
+                               param.weight_quant_scale.data(),
+                               nullptr,
+                               param.Out->mutable_data<float>(),
+                               m,
+                               n,
+                               k,
+                               param.weight_group_size,
+                               false);
+    if (param.alpha != 1.f) {
+      float* o_data = param.Out->mutable_data<float>();
+      for (int64_t i = 0; i < param.Out->numel(); i++) {
+        o_data[i] *= param.alpha;
+      }
+    }
+    if (param.fuse_softmax) {
+      const int cols = param.Out->dims()[param.Out->dims().size() - 1];
+      lite::arm::math::softmax_rows(
+          param.Out->mutable_data<float>(), param.Out->numel() / cols, cols);
+    }
+    return;
+  }
 
   const auto* x_data = param.X->data<float>();
   const auto* y_data = param.Y->data<float>();
@@ -202,6 +281,9 @@ void MatMulV2Compute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
                                false,
                                act_param,
                                &ctx);
+        if (param.fuse_softmax) {
+          lite::arm::math::softmax_rows(o_data + i * out_inner, m_, n_);
+        }
       }
     } else if (x_dims.size() > 2 && y_dims.size() == 2) {
       for (size_t i = 0; i < x_dims.count(0, x_dims.size() - 2); ++i) {
@@ -222,6 +304,9 @@ void MatMulV2Compute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
                                false,
                                act_param,
                                &ctx);
+        if (param.fuse_softmax) {
+          lite::arm::math::softmax_rows(o_data + i * out_inner, m_, n_);
+        }
       }
     } else if (x_dims.size() == 2 && y_dims.size() > 2) {
       for (size_t i = 0; i < y_dims.count(0, y_dims.size() - 2); ++i) {
@@ -242,6 +327,9 @@ void MatMulV2Compute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
                                false,
                                act_param,
                                &ctx);
+        if (param.fuse_softmax) {
+          lite::arm::math::softmax_rows(o_data + i * out_inner, m_, n_);
+        }
       }
     }
   } else if (x_dims.size() == 2 && y_dims.size() == 2) {
@@ -336,6 +424,12 @@ void MatMulV2Compute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
     LOG(FATAL) << "not supported x_dims(" << x_dims << ") and y_dims(" << y_dims
                << ")";
   }
+  // the batched gemms above have applied it per batch
+  if (param.fuse_softmax && (x_dims.size() < 2 || y_dims.size() < 2 ||
+                             (x_dims.size() == 2 && y_dims.size() == 2))) {
+    const int cols = o_dims[o_dims.size() - 1];
+    lite::arm::math::softmax_rows(o_data, o_dims.production() / cols, cols);
+  }
 }
 
 template <>
@@ -550,8 +644,27 @@ void MatMulV2Compute<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
 }
 
 #ifdef ENABLE_ARM_FP16
+// The fp16 matmuls with batches or fused transposes run the strided gemms.
+static bool UseStridedFP16(const operators::MatMulParam& param) {
+  const auto x_rank = param.X->dims().size();
+  const auto y_rank = param.Y->dims().size();
+  return lite::host::math::has_fused_transpose(param) ||
+         (x_rank >= 2 && y_rank >= 2 && (x_rank > 2 || y_rank > 2));
+}
+
 template <>
 void MatMulV2Compute<PRECISION(kFP16), PRECISION(kFP16)>::ReInitWhenNeeded() {
+  auto& matmul_param = Param<param_t>();
+  strided_ = UseStridedFP16(matmul_param);
+  if (strided_) {
+    if (last_x_shape_ != matmul_param.X->dims() ||
+        last_y_shape_ != matmul_param.Y->dims()) {
+      lite::host::math::strided_matmul_args(matmul_param, &strided_args_);
+      last_x_shape_ = matmul_param.X->dims();
+      last_y_shape_ = matmul_param.Y->dims();
+    }
+    return;
+  }
   INIT_PARAM
   last_x_shape_ = x_dims;
   last_y_shape_ = y_dims;
@@ -564,91 +677,23 @@ void MatMulV2Compute<PRECISION(kFP16), PRECISION(kFP16)>::Run() {
   const auto* x_data = param.X->data<float16_t>();
   const auto* y_data = param.Y->data<float16_t>();
   auto* o_data = param.Out->mutable_data<float16_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  if (strided_) {
+    lite::arm::math::fp16::sgemm_fp16_strided_batch(
+        strided_args_, param.alpha, x_data, y_data, o_data, &ctx);
+    return;
+  }
 
   auto x_dims = param.X->dims();
   auto y_dims = param.Y->dims();
-  auto o_dims = param.Out->dims();
   bool x_transpose = param.transpose_X;
   bool y_transpose = param.transpose_Y;
   float alpha = param.alpha;
-  auto& ctx = this->ctx_->template As<ARMContext>();
 
   operators::ActivationParam act_param;
   act_param.has_active = false;
 
-  if ((x_dims.size() >= 2 && y_dims.size() >= 2) &&
-      (x_dims.size() != 2 || y_dims.size() != 2)) {
-    // x: [B, ..., M, K], y: [B, ..., K, N], out: [B, ..., M, N]
-    // x: [B, M, K], y: [K, N], out: [B, M, N]
-    // or
-    // x: [M, K], y: [B, ..., K, N], out: [B, ..., M, N]
-    // x: [M, K], y: [B, K, N], out: [B, M, N]
-    int x_inner = x_dims[x_dims.size() - 2] * x_dims[x_dims.size() - 1];
-    int y_inner = y_dims[y_dims.size() - 2] * y_dims[y_dims.size() - 1];
-    int out_inner = o_dims[o_dims.size() - 2] * o_dims[o_dims.size() - 1];
-
-    if (x_dims.size() > 2 && y_dims.size() > 2) {
-      for (size_t i = 0; i < x_dims.count(0, x_dims.size() - 2); ++i) {
-        lite::arm::math::fp16::sgemm_fp16(x_transpose,
-                                          y_transpose,
-                                          m_,
-                                          n_,
-                                          k_,
-                                          alpha,
-                                          x_data + i * x_inner,
-                                          lda_,
-                                          y_data + i * y_inner,
-                                          ldb_,
-                                          0.f,
-                                          o_data + i * out_inner,
-                                          ldc_,
-                                          nullptr,
-                                          false,
-                                          act_param,
-                                          &ctx);
-      }
-    } else if (x_dims.size() > 2 && y_dims.size() == 2) {
-      for (size_t i = 0; i < x_dims.count(0, x_dims.size() - 2); ++i) {
-        lite::arm::math::fp16::sgemm_fp16(x_transpose,
-                                          y_transpose,
-                                          m_,
-                                          n_,
-                                          k_,
-                                          alpha,
-                                          x_data + i * x_inner,
-                                          lda_,
-                                          y_data,
-                                          ldb_,
-                                          0.f,
-                                          o_data + i * out_inner,
-                                          ldc_,
-                                          nullptr,
-                                          false,
-                                          act_param,
-                                          &ctx);
-      }
-    } else if (x_dims.size() == 2 && y_dims.size() > 2) {
-      for (size_t i = 0; i < y_dims.count(0, y_dims.size() - 2); ++i) {
-        lite::arm::math::fp16::sgemm_fp16(x_transpose,
-                                          y_transpose,
-                                          m_,
-                                          n_,
-                                          k_,
-                                          alpha,
-                                          x_data,
-                                          lda_,
-                                          y_data + i * y_inner,
-                                          ldb_,
-                                          0.f,
-                                          o_data + i * out_inner,
-                                          ldc_,
-                                          nullptr,
-                                          false,
-                                          act_param,
-                                          &ctx);
-      }
-    }
-  } else if (x_dims.size() == 2 && y_dims.size() == 2) {
+  if (x_dims.size() == 2 && y_dims.size() == 2) {
     // x: [M, K], y: [K, N], out: [M, N]
     lite::arm::math::fp16::sgemm_fp16(x_transpose,
                                       y_transpose,
@@ -14,6 +14,7 @@
 
 #pragma once
 #include <vector>
+#include "lite/backends/host/math/strided_matmul.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -47,6 +48,12 @@ class MatMulV2Compute : public KernelLite<TARGET(kARM), PType> {
   std::vector<float> scale_one;
   DDim last_x_shape_;
   DDim last_y_shape_;
+  // the packed group-wise int4 weight of the fp32 kernel
+  Tensor packed_y_;
+  bool flag_int4_{false};
+  // the batched gemms of the fp16 kernel
+  bool strided_{false};
+  lite::host::math::StridedMatmulArgs strided_args_;
 };
 
 }  // namespace arm
@@ -197,6 +197,21 @@ void MulCompute<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
                              &ctx);
   }
   mul_add_n_scale_bias(o_data, scale_.data(), m_, n_);
+  if (param.input_zero_point != 0) {
+    if (zero_point_bias_.empty()) {
+      zero_point_bias_.resize(n_);
+      lite::arm::math::fold_zero_point_bias(y_data,
+                                            scale_.data(),
+                                            nullptr,
+                                            zero_point_bias_.data(),
+                                            param.input_zero_point,
+                                            n_,
+                                            k_,
+                                            true);
+    }
+    lite::arm::math::fill_bias_fc(
+        o_data, zero_point_bias_.data(), m_, n_, false);
+  }
 }
 #ifdef ENABLE_ARM_FP16
 template <>
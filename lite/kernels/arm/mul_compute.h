@@ -37,6 +37,8 @@ class MulCompute : public KernelLite<TARGET(kARM), PType> {
  private:
   int m_, n_, k_;
   std::vector<float> scale_, scale_one;
+  // the correction of the zero point of the asymmetric int8 input
+  std::vector<float> zero_point_bias_;
 };
 
 }  // namespace arm
@@ -0,0 +1,448 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/arm/nhwc_compute.h"
+#include <algorithm>
+#include <cstring>
+#include "lite/backends/arm/math/funcs.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+// the floats of the im2col buffer of a tile of output rows
+static constexpr int kColBufferSize = 1 << 18;
+
+// The strides of the logical dims in the memory of a tensor.
+static std::vector<int64_t> PhysicalStrides(const DDim& dims) {
+  std::vector<int64_t> strides(dims.size(), 1);
+  if (dims.size() == 4) {
+    strides[1] = 1;
+    strides[3] = dims[1];
+    strides[2] = dims[3] * strides[3];
+    strides[0] = dims[2] * strides[2];
+    return strides;
+  }
+  for (int i = static_cast<int>(dims.size()) - 2; i >= 0; --i) {
+    strides[i] = strides[i + 1] * dims[i + 1];
+  }
+  return strides;
+}
+
+// The logical dims in the order they are stored.
+static std::vector<int> PhysicalOrder(size_t rank) {
+  if (rank == 4) return {0, 2, 3, 1};
+  std::vector<int> order(rank);
+  for (size_t i = 0; i < rank; ++i) order[i] = static_cast<int>(i);
+  return order;
+}
+
+void ConvNHWCCompute::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  CHECK(param.second_x == nullptr)
+      << "the nhwc conv does not support the fused elementwise";
+  auto w_dims = param.filter->dims();
+  const int oc = w_dims[0];
+  const int icg = w_dims[1];
+  const int k = w_dims[2] * w_dims[3];
+  const int ic = param.x->dims()[1];
+  is_depthwise_ = param.groups == ic && param.groups == oc && icg == 1;
+  const float* w = param.filter->data<float>();
+  if (is_depthwise_) {
+    weights_.Resize({w_dims[2], w_dims[3], oc});
+    float* dst = weights_.mutable_data<float>();
+    for (int c = 0; c < oc; ++c) {
+      for (int i = 0; i < k; ++i) dst[i * oc + c] = w[c * k + i];
+    }
+    return;
+  }
+  weights_.Resize({oc, w_dims[2], w_dims[3], icg});
+  float* dst = weights_.mutable_data<float>();
+  for (int o = 0; o < oc; ++o) {
+    for (int ci = 0; ci < icg; ++ci) {
+      for (int i = 0; i < k; ++i) {
+        dst[(o * k + i) * icg + ci] = w[(o * icg + ci) * k + i];
+      }
+    }
+  }
+}
+
+void ConvNHWCCompute::Run() {
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto& param = this->Param<param_t>();
+  auto x_dims = param.x->dims();
+  auto o_dims = param.output->dims();
+  auto w_dims = param.filter->dims();
+  const int num = x_dims[0];
+  const int ic = x_dims[1];
+  const int ih = x_dims[2];
+  const int iw = x_dims[3];
+  const int oc = o_dims[1];
+  const int oh = o_dims[2];
+  const int ow = o_dims[3];
+  const int kh = w_dims[2];
+  const int kw = w_dims[3];
+  auto& strides = param.strides;
+  auto& paddings = *param.paddings;
+  auto& dilations = *param.dilations;
+  const float* din = param.x->data<float>();
+  float* dout = param.output->mutable_data<float>();
+  const float* bias = param.bias ? param.bias->data<float>() : nullptr;
+  const float* w = weights_.data<float>();
+  const int m = oh * ow;
+
+  if (is_depthwise_) {
+    for (int n = 0; n < num; ++n) {
+      lite::arm::math::conv_depthwise_nhwc(
+          din + static_cast<int64_t>(n) * ih * iw * ic,
+          w,
+          bias,
+          dout + static_cast<int64_t>(n) * m * oc,
+          ih,
+          iw,
+          ic,
+          oh,
+          ow,
+          kh,
+          kw,
+          strides,
+          paddings,
+          dilations,
+          param.activation_param);
+    }
+    return;
+  }
+
+  const int groups = param.groups;
+  const int icg = ic / groups;
+  const int ocg = oc / groups;
+  const int k = kh * kw * icg;
+  const bool is_1x1 = kh == 1 && kw == 1 && strides[0] == 1 &&
+                      strides[1] == 1 && groups == 1 &&
+                      *std::max_element(paddings.begin(), paddings.end()) ==
+                          0 &&
+                      *std::min_element(paddings.begin(), paddings.end()) ==
+                          0;
+  const int tile = std::max(1, std::min(m, kColBufferSize / k));
+  float* col = nullptr;
+  if (!is_1x1) {
+    col_buf_.Resize({tile, k});
+    col = col_buf_.mutable_data<float>();
+  }
+  operators::ActivationParam no_act;
+  for (int n = 0; n < num; ++n) {
+    const float* in = din + static_cast<int64_t>(n) * ih * iw * ic;
+    float* out = dout + static_cast<int64_t>(n) * m * oc;
+    if (is_1x1) {
+      // the NHWC image is the [m, ic] matrix of the patches
+      lite::arm::math::sgemm(false,
+                             true,
+                             m,
+                             oc,
+                             ic,
+                             1.f,
+                             in,
+                             ic,
+                             w,
+                             ic,
+                             0.f,
+                             out,
+                             oc,
+                             nullptr,
+                             false,
+                             no_act,
+                             &ctx);
+    } else {
+      for (int r0 = 0; r0 < m; r0 += tile) {
+        const int r1 = std::min(m, r0 + tile);
+        for (int g = 0; g < groups; ++g) {
+          lite::arm::math::im2col_nhwc(in,
+                                       col,
+                                       ih,
+                                       iw,
+                                       ic,
+                                       g * icg,
+                                       icg,
+                                       ow,
+                                       r0,
+                                       r1,
+                                       kh,
+                                       kw,
+                                       strides,
+                                       paddings,
+                                       dilations);
+          lite::arm::math::sgemm(false,
+                                 true,
+                                 r1 - r0,
+                                 ocg,
+                                 k,
+                                 1.f,
+                                 col,
+                                 k,
+                                 w + g * ocg * k,
+                                 k,
+                                 0.f,
+                                 out + static_cast<int64_t>(r0) * oc + g * ocg,
+                                 oc,
+                                 nullptr,
+                                 false,
+                                 no_act,
+                                 &ctx);
+        }
+      }
+    }
+    lite::arm::math::bias_act_nhwc(out, m, oc, bias, param.activation_param);
+  }
+}
+
+void PoolNHWCCompute::Run() {
+  auto& param = this->Param<param_t>();
+  auto x_dims = param.x->dims();
+  auto o_dims = param.output->dims();
+  std::vector<int> ksize = param.ksize;
+  std::vector<int> paddings = *param.paddings;
+  if (param.global_pooling) {
+    ksize = {static_cast<int>(x_dims[2]), static_cast<int>(x_dims[3])};
+    paddings.assign(4, 0);
+  }
+  lite::arm::math::pooling_nhwc(param.x->data<float>(),
+                                param.output->mutable_data<float>(),
+                                x_dims[0],
+                                x_dims[1],
+                                x_dims[2],
+                                x_dims[3],
+                                o_dims[2],
+                                o_dims[3],
+                                ksize,
+                                param.strides,
+                                paddings,
+                                param.pooling_type == "max",
+                                param.exclusive,
+                                param.adaptive);
+}
+
+struct AddFunctor {
+  float operator()(float a, float b) const { return a + b; }
+};
+
+struct SubFunctor {
+  float operator()(float a, float b) const { return a - b; }
+};
+
+struct MulFunctor {
+  float operator()(float a, float b) const { return a * b; }
+};
+
+struct DivFunctor {
+  float operator()(float a, float b) const { return a / b; }
+};
+
+// The strides of the dims of a tensor broadcast to the rank of the output
+// from axis on, zeros for the broadcast dims.
+static std::vector<int64_t> BroadcastStrides(const DDim& dims,
+                                             const DDim& out_dims,
+                                             int axis) {
+  std::vector<int64_t> strides(out_dims.size(), 0);
+  auto physical = PhysicalStrides(dims);
+  if (dims.size() == out_dims.size()) axis = 0;
+  for (size_t i = 0; i < dims.size(); ++i) {
+    if (dims[i] != 1) strides[i + axis] = physical[i];
+  }
+  return strides;
+}
+
+template <typename Functor>
+void ElementwiseNHWCCompute<Functor>::Run() {
+  auto& param = this->template Param<param_t>();
+  auto x_dims = param.X->dims();
+  auto y_dims = param.Y->dims();
+  auto out_dims = param.Out->dims();
+  const float* x = param.X->template data<float>();
+  const float* y = param.Y->template data<float>();
+  float* out = param.Out->template mutable_data<float>();
+  Functor f;
+  const int64_t numel = param.Out->numel();
+  if (x_dims == out_dims && y_dims == out_dims) {
+    for (int64_t i = 0; i < numel; ++i) out[i] = f(x[i], y[i]);
+    return;
+  }
+  int axis = param.axis;
+  const int rank_diff = std::abs(static_cast<int>(x_dims.size()) -
+                                 static_cast<int>(y_dims.size()));
+  if (axis == -1) axis = rank_diff;
+  auto x_strides = BroadcastStrides(x_dims, out_dims, axis);
+  auto y_strides = BroadcastStrides(y_dims, out_dims, axis);
+  const int rank = static_cast<int>(out_dims.size());
+  if (rank == 4 && x_dims == out_dims && y_strides[0] == 0 &&
+      y_strides[2] == 0 && y_strides[3] == 0) {
+    // the per channel broadcast of the NHWC rows
+    const int channel = out_dims[1];
+    const int64_t rows = numel / channel;
+    for (int64_t r = 0; r < rows; ++r) {
+      const float* px = x + r * channel;
+      float* po = out + r * channel;
+      for (int c = 0; c < channel; ++c) {
+        po[c] = f(px[c], y[c * y_strides[1]]);
+      }
+    }
+    return;
+  }
+  auto order = PhysicalOrder(rank);
+  std::vector<int64_t> index(rank, 0);
+  int64_t x_offset = 0;
+  int64_t y_offset = 0;
+  for (int64_t i = 0; i < numel; ++i) {
+    out[i] = f(x[x_offset], y[y_offset]);
+    for (int j = rank - 1; j >= 0; --j) {
+      const int d = order[j];
+      if (++index[d] < out_dims[d]) {
+        x_offset += x_strides[d];
+        y_offset += y_strides[d];
+        break;
+      }
+      x_offset -= x_strides[d] * (out_dims[d] - 1);
+      y_offset -= y_strides[d] * (out_dims[d] - 1);
+      index[d] = 0;
+    }
+  }
+}
+
+void ActivationNHWCCompute::Run() {
+  auto& param = this->Param<param_t>();
+  const float* x = param.X->data<float>();
+  float* out = param.Out->mutable_data<float>();
+  if (out != x) memcpy(out, x, sizeof(float) * param.X->numel());
+  operators::ActivationParam act = param;
+  act.has_active = true;
+  if (act.active_type == lite_api::ActivationType::kRelu6) {
+    act.Relu_clipped_coef = param.threshold;
+  }
+  // the elementwise activations do not care about the layout
+  lite::arm::math::bias_act_nhwc(out, 1, param.X->numel(), nullptr, act);
+}
+
+void ConcatNHWCCompute::Run() {
+  auto& param = this->Param<param_t>();
+  auto out_dims = param.output->dims();
+  const int rank = static_cast<int>(out_dims.size());
+  int axis = param.axis;
+  if (param.axis_tensor != nullptr) {
+    axis = param.axis_tensor->data<int>()[0];
+  }
+  if (axis < 0) axis += rank;
+  auto order = PhysicalOrder(rank);
+  const int physical_axis = static_cast<int>(
+      std::find(order.begin(), order.end(), axis) - order.begin());
+  int64_t outer = 1;
+  for (int i = 0; i < physical_axis; ++i) outer *= out_dims[order[i]];
+  const int64_t out_inner = param.output->numel() / outer;
+  float* out = param.output->mutable_data<float>();
+  int64_t offset = 0;
+  for (auto* x : param.x) {
+    const int64_t inner = x->numel() / outer;
+    const float* in = x->data<float>();
+    for (int64_t i = 0; i < outer; ++i) {
+      memcpy(out + i * out_inner + offset,
+             in + i * inner,
+             sizeof(float) * inner);
+    }
+    offset += inner;
+  }
+}
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+#define NHWC_TYPE                                             \
+  LiteType::GetTensorTy(                                      \
+      TARGET(kARM), PRECISION(kFloat), DATALAYOUT(kNHWC))
+#define NHWC_ANY_LAYOUT_TYPE                                  \
+  LiteType::GetTensorTy(                                      \
+      TARGET(kARM), PRECISION(kFloat), DATALAYOUT(kAny))
+
+typedef paddle::lite::kernels::arm::ConvNHWCCompute ConvNHWC;
+typedef paddle::lite::kernels::arm::PoolNHWCCompute PoolNHWC;
+typedef paddle::lite::kernels::arm::ActivationNHWCCompute ActNHWC;
+typedef paddle::lite::kernels::arm::ConcatNHWCCompute ConcatNHWC;
+typedef paddle::lite::kernels::arm::ElementwiseNHWCCompute<
+    paddle::lite::kernels::arm::AddFunctor>
+    AddNHWC;
+typedef paddle::lite::kernels::arm::ElementwiseNHWCCompute<
+    paddle::lite::kernels::arm::SubFunctor>
+    SubNHWC;
+typedef paddle::lite::kernels::arm::ElementwiseNHWCCompute<
+    paddle::lite::kernels::arm::MulFunctor>
+    MulNHWC;
+typedef paddle::lite::kernels::arm::ElementwiseNHWCCompute<
+    paddle::lite::kernels::arm::DivFunctor>
+    DivNHWC;
+
+// the filter and the bias are repacked by the kernel
+REGISTER_LITE_KERNEL(conv2d, kARM, kFloat, kNHWC, ConvNHWC, def)
+    .BindInput("Input", {NHWC_TYPE})
+    .BindInput("Bias", {NHWC_ANY_LAYOUT_TYPE})
+    .BindInput("Filter", {NHWC_ANY_LAYOUT_TYPE})
+    .BindOutput("Output", {NHWC_TYPE})
+    .BindPaddleOpVersion("conv2d", 1)
+    .Finalize();
+
+REGISTER_LITE_KERNEL(depthwise_conv2d, kARM, kFloat, kNHWC, ConvNHWC, def)
+    .BindInput("Input", {NHWC_TYPE})
+    .BindInput("Bias", {NHWC_ANY_LAYOUT_TYPE})
+    .BindInput("Filter", {NHWC_ANY_LAYOUT_TYPE})
+    .BindOutput("Output", {NHWC_TYPE})
+    .BindPaddleOpVersion("depthwise_conv2d", 1)
+    .Finalize();
+
+REGISTER_LITE_KERNEL(pool2d, kARM, kFloat, kNHWC, PoolNHWC, def)
+    .BindInput("X", {NHWC_TYPE})
+    .BindOutput("Out", {NHWC_TYPE})
+    .BindPaddleOpVersion("pool2d", 1)
+    .Finalize();
+
+#define REGISTER_ELEMENTWISE_NHWC(op_type, kernel)                  \
+  REGISTER_LITE_KERNEL(op_type, kARM, kFloat, kNHWC, kernel, def)   \
+      .BindInput("X", {NHWC_TYPE})                                  \
+      .BindInput("Y", {NHWC_TYPE})                                  \
+      .BindOutput("Out", {NHWC_TYPE})                               \
+      .Finalize();
+
+REGISTER_ELEMENTWISE_NHWC(elementwise_add, AddNHWC)
+REGISTER_ELEMENTWISE_NHWC(elementwise_sub, SubNHWC)
+REGISTER_ELEMENTWISE_NHWC(elementwise_mul, MulNHWC)
+REGISTER_ELEMENTWISE_NHWC(elementwise_div, DivNHWC)
+
+#define REGISTER_ACTIVATION_NHWC(op_type)                           \
+  REGISTER_LITE_KERNEL(op_type, kARM, kFloat, kNHWC, ActNHWC, def)  \
+      .BindInput("X", {NHWC_TYPE})                                  \
+      .BindOutput("Out", {NHWC_TYPE})                               \
+      .Finalize();
+
+REGISTER_ACTIVATION_NHWC(relu)
+REGISTER_ACTIVATION_NHWC(relu6)
+REGISTER_ACTIVATION_NHWC(leaky_relu)
+REGISTER_ACTIVATION_NHWC(hard_swish)
+REGISTER_ACTIVATION_NHWC(sigmoid)
+REGISTER_ACTIVATION_NHWC(tanh)
+
+REGISTER_LITE_KERNEL(concat, kARM, kFloat, kNHWC, ConcatNHWC, def)
+    .BindInput("X", {NHWC_TYPE})
+    .BindInput("AxisTensor",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt32))})
+    .BindOutput("Out", {NHWC_TYPE})
+    .Finalize();
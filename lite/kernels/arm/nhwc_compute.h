@@ -0,0 +1,90 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <vector>
+#include "lite/core/kernel.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+// The fp32 kernels of the NHWC execution path. Their tensors keep the
+// logical NCHW dims of the ops and store the 4-D images channel last, so the
+// ops infer the shapes as usual and the layout kernels convert them only
+// where the graph switches between NCHW and NHWC kernels. The tensors of
+// less than 4 dims are stored as they are.
+using NHWCKernel =
+    KernelLite<TARGET(kARM), PRECISION(kFloat), DATALAYOUT(kNHWC)>;
+
+class ConvNHWCCompute : public NHWCKernel {
+ public:
+  using param_t = operators::ConvParam;
+
+  void PrepareForRun() override;
+
+  void Run() override;
+
+  virtual ~ConvNHWCCompute() = default;
+
+ private:
+  bool is_depthwise_{false};
+  // the filter of [oc, kh, kw, ic / groups], or [kh, kw, oc] for depthwise
+  Tensor weights_;
+  Tensor col_buf_;
+};
+
+class PoolNHWCCompute : public NHWCKernel {
+ public:
+  using param_t = operators::PoolParam;
+
+  void Run() override;
+
+  virtual ~PoolNHWCCompute() = default;
+};
+
+template <typename Functor>
+class ElementwiseNHWCCompute : public NHWCKernel {
+ public:
+  using param_t = operators::ElementwiseParam;
+
+  void Run() override;
+
+  virtual ~ElementwiseNHWCCompute() = default;
+};
+
+class ActivationNHWCCompute : public NHWCKernel {
+ public:
+  using param_t = operators::ActivationParam;
+
+  void Run() override;
+
+  virtual ~ActivationNHWCCompute() = default;
+};
+
+class ConcatNHWCCompute : public NHWCKernel {
+ public:
+  using param_t = operators::ConcatParam;
+
+  void Run() override;
+
+  virtual ~ConcatNHWCCompute() = default;
+};
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,259 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/arm/nhwc_compute.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+static void fill_data(Tensor* tensor) {
+  float* data = tensor->mutable_data<float>();
+  for (int64_t i = 0; i < tensor->numel(); ++i) {
+    data[i] = static_cast<float>((i * 7) % 23 - 11) / 11.f;
+  }
+}
+
+// store an NCHW tensor of src as NHWC in dst, keeping the dims
+static void nchw_to_nhwc(const Tensor& src, Tensor* dst) {
+  auto dims = src.dims();
+  const int n = dims[0], c = dims[1], hw = dims[2] * dims[3];
+  dst->Resize(dims);
+  const float* in = src.data<float>();
+  float* out = dst->mutable_data<float>();
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < c; ++j) {
+      for (int k = 0; k < hw; ++k) {
+        out[(i * hw + k) * c + j] = in[(i * c + j) * hw + k];
+      }
+    }
+  }
+}
+
+static void expect_nhwc_near(const Tensor& ref, const Tensor& nhwc) {
+  Tensor out;
+  nchw_to_nhwc(ref, &out);
+  ASSERT_EQ(out.dims(), nhwc.dims());
+  const float* a = out.data<float>();
+  const float* b = nhwc.data<float>();
+  for (int64_t i = 0; i < out.numel(); ++i) {
+    EXPECT_NEAR(a[i], b[i], 1e-4);
+  }
+}
+
+static void conv_ref(const Tensor& x,
+                     const Tensor& w,
+                     const Tensor& bias,
+                     int groups,
+                     int stride,
+                     int pad,
+                     int dilation,
+                     bool relu,
+                     Tensor* out) {
+  auto x_dims = x.dims();
+  auto w_dims = w.dims();
+  const int n = x_dims[0], ic = x_dims[1], ih = x_dims[2], iw = x_dims[3];
+  const int oc = w_dims[0], icg = w_dims[1], kh = w_dims[2], kw = w_dims[3];
+  const int oh = (ih + 2 * pad - dilation * (kh - 1) - 1) / stride + 1;
+  const int ow = (iw + 2 * pad - dilation * (kw - 1) - 1) / stride + 1;
+  const int ocg = oc / groups;
+  out->Resize({n, oc, oh, ow});
+  const float* din = x.data<float>();
+  const float* wd = w.data<float>();
+  float* dout = out->mutable_data<float>();
+  for (int b = 0; b < n; ++b) {
+    for (int o = 0; o < oc; ++o) {
+      const int g = o / ocg;
+      for (int y = 0; y < oh; ++y) {
+        for (int x0 = 0; x0 < ow; ++x0) {
+          float sum = bias.data<float>()[o];
+          for (int ci = 0; ci < icg; ++ci) {
+            for (int ky = 0; ky < kh; ++ky) {
+              for (int kx = 0; kx < kw; ++kx) {
+                int iy = y * stride - pad + ky * dilation;
+                int ix = x0 * stride - pad + kx * dilation;
+                if (iy < 0 || iy >= ih || ix < 0 || ix >= iw) continue;
+                sum += din[((b * ic + g * icg + ci) * ih + iy) * iw + ix] *
+                       wd[((o * icg + ci) * kh + ky) * kw + kx];
+              }
+            }
+          }
+          if (relu) sum = std::max(sum, 0.f);
+          dout[((b * oc + o) * oh + y) * ow + x0] = sum;
+        }
+      }
+    }
+  }
+}
+
+TEST(nhwc_arm, conv) {
+  DeviceInfo::Init();
+  for (auto groups : {1, 2, 8}) {
+    for (auto ksize : {1, 3}) {
+      for (auto stride : {1, 2}) {
+        for (auto dilation : {1, 2}) {
+          const int pad = ksize / 2;
+          Tensor x, w, bias, x_nhwc, out, out_ref;
+          x.Resize({2, 8, 9, 7});
+          w.Resize({groups == 8 ? 8 : 12, 8 / groups, ksize, ksize});
+          bias.Resize({w.dims()[0]});
+          fill_data(&x);
+          fill_data(&w);
+          fill_data(&bias);
+          conv_ref(x, w, bias, groups, stride, pad, dilation, true, &out_ref);
+          nchw_to_nhwc(x, &x_nhwc);
+          out.Resize(out_ref.dims());
+
+          operators::ConvParam param;
+          param.x = &x_nhwc;
+          param.filter = &w;
+          param.bias = &bias;
+          param.output = &out;
+          param.groups = groups;
+          param.strides = {stride, stride};
+          param.paddings = std::make_shared<std::vector<int>>(4, pad);
+          param.dilations = std::make_shared<std::vector<int>>(2, dilation);
+          param.activation_param.has_active = true;
+          param.activation_param.active_type =
+              lite_api::ActivationType::kRelu;
+
+          ConvNHWCCompute conv;
+          std::unique_ptr<KernelContext> ctx(new KernelContext);
+          ctx->As<ARMContext>();
+          conv.SetContext(std::move(ctx));
+          conv.SetParam(param);
+          conv.PrepareForRun();
+          conv.Run();
+          expect_nhwc_near(out_ref, out);
+        }
+      }
+    }
+  }
+}
+
+TEST(nhwc_arm, pool) {
+  Tensor x, x_nhwc, out, out_ref;
+  x.Resize({1, 5, 6, 6});
+  fill_data(&x);
+  nchw_to_nhwc(x, &x_nhwc);
+  for (bool is_max : {true, false}) {
+    // 3x3 windows of stride 2 and padding 1, exclusive
+    out_ref.Resize({1, 5, 3, 3});
+    out.Resize({1, 5, 3, 3});
+    const float* din = x.data<float>();
+    float* ref = out_ref.mutable_data<float>();
+    for (int c = 0; c < 5; ++c) {
+      for (int y = 0; y < 3; ++y) {
+        for (int x0 = 0; x0 < 3; ++x0) {
+          float v = is_max ? -FLT_MAX : 0.f;
+          int count = 0;
+          for (int iy = y * 2 - 1; iy < y * 2 + 2; ++iy) {
+            for (int ix = x0 * 2 - 1; ix < x0 * 2 + 2; ++ix) {
+              if (iy < 0 || iy >= 6 || ix < 0 || ix >= 6) continue;
+              float p = din[(c * 6 + iy) * 6 + ix];
+              v = is_max ? std::max(v, p) : v + p;
+              count++;
+            }
+          }
+          ref[(c * 3 + y) * 3 + x0] = is_max ? v : v / count;
+        }
+      }
+    }
+
+    operators::PoolParam param;
+    param.x = &x_nhwc;
+    param.output = &out;
+    param.pooling_type = is_max ? "max" : "avg";
+    param.ksize = {3, 3};
+    param.strides = {2, 2};
+    param.paddings = std::make_shared<std::vector<int>>(4, 1);
+    param.exclusive = true;
+    PoolNHWCCompute pool;
+    pool.SetParam(param);
+    pool.Run();
+    expect_nhwc_near(out_ref, out);
+  }
+}
+
+TEST(nhwc_arm, elementwise_and_concat) {
+  Tensor x, y, x_nhwc, out, out_ref;
+  x.Resize({2, 6, 3, 5});
+  y.Resize({6});
+  fill_data(&x);
+  fill_data(&y);
+  nchw_to_nhwc(x, &x_nhwc);
+  out_ref.Resize(x.dims());
+  const float* din = x.data<float>();
+  float* ref = out_ref.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); ++i) {
+    ref[i] = din[i] * y.data<float>()[(i / 15) % 6];
+  }
+  out.Resize(x.dims());
+  operators::ElementwiseParam param;
+  param.X = &x_nhwc;
+  param.Y = &y;
+  param.Out = &out;
+  param.axis = 1;
+  auto kernels = KernelRegistry::Global().Create(
+      "elementwise_mul", TARGET(kARM), PRECISION(kFloat), DATALAYOUT(kNHWC));
+  ASSERT_FALSE(kernels.empty());
+  auto& mul = kernels.front();
+  mul->SetParam(param);
+  mul->Run();
+  expect_nhwc_near(out_ref, out);
+
+  // concat x with itself on the channels
+  Tensor cat, cat_ref;
+  cat_ref.Resize({2, 12, 3, 5});
+  float* cref = cat_ref.mutable_data<float>();
+  for (int n = 0; n < 2; ++n) {
+    for (int c = 0; c < 12; ++c) {
+      memcpy(cref + (n * 12 + c) * 15,
+             din + (n * 6 + c % 6) * 15,
+             sizeof(float) * 15);
+    }
+  }
+  cat.Resize(cat_ref.dims());
+  operators::ConcatParam cparam;
+  cparam.x = {&x_nhwc, &x_nhwc};
+  cparam.output = &cat;
+  cparam.axis = 1;
+  ConcatNHWCCompute concat;
+  concat.SetParam(cparam);
+  concat.Run();
+  expect_nhwc_near(cat_ref, cat);
+}
+
+TEST(nhwc_arm, retrive_op) {
+  auto conv = KernelRegistry::Global().Create(
+      "conv2d", TARGET(kARM), PRECISION(kFloat), DATALAYOUT(kNHWC));
+  ASSERT_FALSE(conv.empty());
+}
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(conv2d, kARM, kFloat, kNHWC, def);
+USE_LITE_KERNEL(elementwise_mul, kARM, kFloat, kNHWC, def);
@@ -13,8 +13,8 @@
 // limitations under the License.
 
 #include "lite/kernels/arm/reduce_mean_compute.h"
-#include <string>
-#include "lite/backends/arm/math/funcs.h"
+#include <vector>
+#include "lite/backends/arm/math/reduce.h"
 
 namespace paddle {
 namespace lite {
@@ -23,61 +23,17 @@ namespace arm {
 
 void ReduceMeanCompute::Run() {
   auto& param = Param<operators::ReduceParam>();
-  const float* input = param.X->data<float>();
-  auto x_dims = param.X->dims();
-  int x_rank = x_dims.size();
-  float* output = param.Out->mutable_data<float>();
-  bool keep_dim = param.keep_dim;
-  auto dim = param.dim;
-
-  if (!dim.empty()) {
-    for (int i = 0; i < dim.size(); i++) {
-      if (dim[i] < 0) {
-        dim[i] += x_rank;
-      }
-    }
-  }
-
-  size_t new_dims[] = {1, 1, 1, 1};
-  for (size_t j = 0; j < x_dims.size(); ++j) {
-    new_dims[j] = x_dims[j];
-  }
-  int n_in = new_dims[0];
-  int c_in = new_dims[1];
-  int h_in = new_dims[2];
-  int w_in = new_dims[3];
-  if (dim.size() == 0) {
-    lite::arm::math::reduce_mean_all(input, output, n_in, c_in, h_in, w_in);
-  } else if (dim.size() == 1) {
-    switch (dim[0]) {
-      case 0:
-        lite::arm::math::reduce_mean_n(input, output, n_in, c_in, h_in, w_in);
-        break;
-      case 1:
-        lite::arm::math::reduce_mean_c(input, output, n_in, c_in, h_in, w_in);
-        break;
-      case 2:
-        lite::arm::math::reduce_mean_h(input, output, n_in, c_in, h_in, w_in);
-        break;
-      case 3:
-        lite::arm::math::reduce_mean_w(input, output, n_in, c_in, h_in, w_in);
-        break;
-      default:
-        LOG(FATAL) << "error!!!";
-    }
-  } else if (dim.size() == 2) {
-    if (dim[0] == 0 && dim[1] == 1) {
-      lite::arm::math::reduce_mean_nc(input, output, n_in, c_in, h_in, w_in);
-    } else if (dim[0] == 1 && dim[1] == 2) {
-      lite::arm::math::reduce_mean_ch(input, output, n_in, c_in, h_in, w_in);
-    } else if (dim[0] == 2 && dim[1] == 3) {
-      lite::arm::math::reduce_mean_hw(input, output, n_in, c_in, h_in, w_in);
-    } else {
-      LOG(FATAL) << "invalid dim!!";
-    }
-  } else {
-    LOG(FATAL) << "dim's size over than 2, which is not supported now!!";
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  std::vector<int> dim;
+  if (!param.reduce_all) {
+    dim = param.dim;
   }
+  lite::arm::math::reduce(param.X->data<float>(),
+                          param.Out->mutable_data<float>(),
+                          param.X->dims().Vectorize(),
+                          dim,
+                          lite::arm::math::ReduceType::kMean,
+                          ctx.threads());
 }
 
 }  // namespace arm
@@ -13,9 +13,8 @@
 // limitations under the License.
 
 #include "lite/kernels/arm/reduce_prod_compute.h"
-#include <string>
 #include <vector>
-#include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/arm/math/reduce.h"
 
 namespace paddle {
 namespace lite {
@@ -24,63 +23,17 @@ namespace arm {
 template <typename T, PrecisionType Ptype>
 void ReduceProdCompute<T, Ptype>::Run() {
   auto& param = this->template Param<operators::ReduceParam>();
-  auto* input = param.X->template data<T>();
-  auto x_dims = param.X->dims();
-  int x_rank = x_dims.size();
-  auto* Out = param.Out->template mutable_data<T>();
-  std::vector<int> dim = param.dim;
-  bool keep_dim = param.keep_dim;
-  bool reduce_all = param.reduce_all;
-
-  if (!dim.empty()) {
-    for (int i = 0; i < dim.size(); i++) {
-      if (dim[i] < 0) {
-        dim[i] += x_rank;
-      }
-    }
-  }
-
-  if (reduce_all) {
-    lite::arm::math::reduce_prod_all(input, Out, x_dims.production());
-  } else {
-    CHECK_EQ(x_rank, 4U);
-    int n_in = x_dims[0];
-    int c_in = x_dims[1];
-    int h_in = x_dims[2];
-    int w_in = x_dims[3];
-
-    if (dim.size() == 1) {
-      switch (dim[0]) {
-        case 0:
-          lite::arm::math::reduce_prod_n(input, Out, n_in, c_in, h_in, w_in);
-          break;
-        case 1:
-          lite::arm::math::reduce_prod_c(input, Out, n_in, c_in, h_in, w_in);
-          break;
-        case 2:
-          lite::arm::math::reduce_prod_h(input, Out, n_in, c_in, h_in, w_in);
-          break;
-        case 3:
-          lite::arm::math::reduce_prod_w(input, Out, n_in, c_in, h_in, w_in);
-          break;
-        default:
-          LOG(FATAL) << "dim[0] should be less than 4.";
-      }
-    } else if (dim.size() == 2) {
-      if (dim[0] == 0 && dim[1] == 1) {
-        lite::arm::math::reduce_prod_nc(input, Out, n_in, c_in, h_in, w_in);
-      } else if (dim[0] == 1 && dim[1] == 2) {
-        lite::arm::math::reduce_prod_ch(input, Out, n_in, c_in, h_in, w_in);
-      } else if (dim[0] == 2 && dim[1] == 3) {
-        lite::arm::math::reduce_prod_hw(input, Out, n_in, c_in, h_in, w_in);
-      } else {
-        LOG(FATAL)
-            << "Only support the values of the dim are 0,1 1,2 or 2,3 for now.";
-      }
-    } else {
-      LOG(FATAL) << "dim's size over than 2, which is not supported now!!";
-    }
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  std::vector<int> dim;
+  if (!param.reduce_all) {
+    dim = param.dim;
   }
+  lite::arm::math::reduce(param.X->template data<T>(),
+                          param.Out->template mutable_data<T>(),
+                          param.X->dims().Vectorize(),
+                          dim,
+                          lite::arm::math::ReduceType::kProd,
+                          ctx.threads());
 }
 
 }  // namespace arm
@@ -44,7 +44,8 @@ namespace arm {
               &gate_value,        \
               z,                  \
               w,                  \
-              mode)
+              mode,               \
+              &packed_hh_)
 
 void reset_parameter_vector(const std::vector<Tensor*>& raw_params_vec,
                             const int& num_layers,
@@ -298,6 +299,41 @@ static void create_mask_matrix(const Tensor* sequence_length,
   TransposeNormal<float>(temp, mask_matrix, trans_vec);
 }
 
+// out[m,n] = h[m,k] * W^T for the [n,k] hidden weight W. More than one row
+// uses the copy of W packed once in RunRnnLayer.
+static void HiddenGemm(const float* h,
+                       const float* w,
+                       const Tensor& packed_hh,
+                       int m,
+                       int n,
+                       int k,
+                       float* out,
+                       ARMContext* ctx) {
+  if (m > 1 && packed_hh.numel() > 0) {
+    lite::arm::math::sgemm_recurrent(packed_hh, h, m, n, k, 0.f, out, ctx);
+    return;
+  }
+  operators::ActivationParam act_param;
+  act_param.has_active = false;
+  lite::arm::math::sgemm(false,
+                         true,
+                         m,
+                         n,
+                         k,
+                         1.f,
+                         h,
+                         k,
+                         w,
+                         k,
+                         0.f,
+                         out,
+                         n,
+                         nullptr,
+                         false,
+                         act_param,
+                         ctx);
+}
+
 static void lstm_cell(ARMContext* ctx,
                       Tensor* input,
                       Tensor* weight_hh,
@@ -307,10 +343,9 @@ static void lstm_cell(ARMContext* ctx,
                       Tensor* last_c,
                       Tensor* last_c_act,
                       Tensor* output,
-                      const Tensor* bias_hh) {
+                      const Tensor* bias_hh,
+                      const Tensor& packed_hh) {
   bool flag_act = false;
-  operators::ActivationParam act_param;
-  act_param.has_active = false;
   auto h_dims = init_h->dims();
   auto weight_input_dims = weight_hh->dims();
   int m = h_dims[0];
@@ -323,23 +358,7 @@ static void lstm_cell(ARMContext* ctx,
   Tensor tmp_gate;
   tmp_gate.Resize(input->dims());
   auto tmp_data = tmp_gate.mutable_data<float>();
-  lite::arm::math::sgemm(false,
-                         true,
-                         m,
-                         n,
-                         k,
-                         1.f,
-                         h_data,
-                         k,
-                         w_data,
-                         k,
-                         0.f,
-                         tmp_data,
-                         n,
-                         nullptr,
-                         false,
-                         act_param,
-                         ctx);
+  HiddenGemm(h_data, w_data, packed_hh, m, n, k, tmp_data, ctx);
   for (int i = 0; i < input->dims()[0] * input->dims()[1]; i++) {
     tmp_data[i] += i_data[i];
   }
@@ -394,10 +413,9 @@ static void gru_cell(ARMContext* ctx,
                      Tensor* last_c_act,
                      Tensor* output,
                      const Tensor* bias_hh,
-                     Tensor* weight_hh_gru) {
+                     Tensor* weight_hh_gru,
+                     const Tensor& packed_hh) {
   bool flag_act = false;
-  operators::ActivationParam act_param;
-  act_param.has_active = false;
   auto h_dims = init_h->dims();
   auto weight_gru_dims = weight_hh_gru->dims();
   int m = h_dims[0];
@@ -410,23 +428,7 @@ static void gru_cell(ARMContext* ctx,
   Tensor tmp_gate;
   tmp_gate.Resize(input->dims());
   auto tmp_data = tmp_gate.mutable_data<float>();
-  lite::arm::math::sgemm(false,
-                         true,
-                         m,
-                         n,
-                         k,
-                         1.f,
-                         h_data,
-                         k,
-                         w_gru,
-                         k,
-                         0.f,
-                         tmp_data,
-                         n,
-                         nullptr,
-                         false,
-                         act_param,
-                         ctx);
+  HiddenGemm(h_data, w_gru, packed_hh, m, n, k, tmp_data, ctx);
   for (int i = 0; i < input->dims()[0] * input->dims()[1]; i++) {
     tmp_data[i] += i_data[i];
   }
@@ -465,7 +467,8 @@ static void RunRnnLayer(ARMContext* ctx,
                         Tensor* gate_value,
                         bool is_bidirect,
                         int offset,
-                        std::string mode) {
+                        std::string mode,
+                        std::vector<Tensor>* packed_hh) {
   bool is_reverse = false;
   if (is_bidirect) {
     layer_idx = 2 * layer_idx + offset;
@@ -590,6 +593,21 @@ static void RunRnnLayer(ARMContext* ctx,
                 0,
                 size * sizeof(float));
   }
+  // the hidden weights are constant, pack them for the steps once
+  if (static_cast<int>(packed_hh->size()) <= layer_idx) {
+    packed_hh->resize(layer_idx + 1);
+  }
+  Tensor& packed = (*packed_hh)[layer_idx];
+  if (packed.numel() == 0 && ("LSTM" == mode || "GRU" == mode)) {
+    const Tensor& w_hh =
+        "GRU" == mode ? weight_hh_tmp : vec[1 + offset * 4];
+    lite::arm::math::prepack_recurrent_weight(w_hh.data<float>(),
+                                              true,
+                                              w_hh.dims()[0],
+                                              w_hh.dims()[1],
+                                              &packed,
+                                              ctx);
+  }
 
   for (int i = 0; i < time_step; i++) {
     bool in_mask = (reverse_flag * i) >= mask_min_length;
@@ -616,7 +634,8 @@ static void RunRnnLayer(ARMContext* ctx,
                 last_c_holder,
                 nullptr,
                 &output_tensors[i],
-                &vec[3 + offset * 4]);
+                &vec[3 + offset * 4],
+                packed);
     } else if ("GRU" == mode) {
       gru_cell(ctx,
                &input_tensors[i],
@@ -628,7 +647,8 @@ static void RunRnnLayer(ARMContext* ctx,
                nullptr,
                &output_tensors[i],
                &vec[3 + offset * 4],
-               &weight_hh_tmp);
+               &weight_hh_tmp,
+               packed);
     }
 
     /*
@@ -14,6 +14,7 @@
 
 #pragma once
 #include <algorithm>
+#include <vector>
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 
@@ -27,6 +28,10 @@ class RnnCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
   void Run() override;
 
   virtual ~RnnCompute() = default;
+
+ private:
+  // the packed hidden weight of each layer and direction
+  std::vector<Tensor> packed_hh_;
 };
 
 }  // namespace arm
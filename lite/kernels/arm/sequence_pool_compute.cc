@@ -38,7 +38,7 @@ void SequencePoolCompute<Ptype, Dtype>::Run() {
   Dtype* dout = output->template mutable_data<Dtype>();
   int64_t* max_index = param.MaxIndex->template mutable_data<int64_t>();
   const auto pool_type = param.pool_type;
-  const auto lod = param.X->lod()[param.X->lod().size() - 1];
+  const auto& lod = param.X->lod().back();
   const auto pad_value = param.pad_value;
 
   int64_t width = param.X->numel() / param.X->dims()[0];
@@ -63,19 +63,16 @@ void SequencePoolCompute<Ptype, Dtype>::Run() {
     LOG(ERROR) << " UNKNOWN sequence pool type" << pool_type;
   }
   int batch_size = lod.size() - 1;
-  std::vector<uint64_t> offset_new;
+  auto* out_lod = output->mutable_lod();
+  out_lod->resize(1);
   if (param.X->lod().size() == 2) {
-    offset_new.resize(param.X->lod()[0].size());
-    offset_new = param.X->lod()[0];
+    (*out_lod)[0] = param.X->lod()[0];
   } else {
-    offset_new.resize(batch_size + 1);
+    (*out_lod)[0].resize(batch_size + 1);
     for (int i = 0; i <= batch_size; i++) {
-      offset_new[i] = i;
+      (*out_lod)[0][i] = i;
     }
   }
-
-  output->mutable_lod()->clear();
-  output->mutable_lod()->push_back(offset_new);
 }
 
 }  // namespace arm
@@ -36,7 +36,7 @@ void SequencePoolGradCompute::Run() {
   const auto* index_grad_ptr = param.MaxIndex_Grad->data<int64_t>();
   float* x_grad_ptr = x_grad->mutable_data<float>();
   const auto pool_type = param.pool_type;
-  const auto lod = param.X->lod()[0];
+  const auto& lod = param.X->lod()[0];
   int64_t width = param.X->numel() / param.X->dims()[0];
   if (pool_type == "SUM") {
     lite::arm::math::seq_pool_sum_grad(
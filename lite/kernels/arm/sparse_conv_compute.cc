@@ -18,6 +18,10 @@
 #include "lite/backends/arm/math/sparse_semi_conv_impl.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/type_system.h"
+#ifdef ENABLE_ARM_FP16
+#include "lite/backends/arm/math/fp16/funcs_fp16.h"
+#include "lite/backends/arm/math/fp16/sparse_conv_fp16.h"
+#endif
 
 namespace paddle {
 namespace lite {
@@ -253,6 +257,90 @@ void SparseConvCompute<PRECISION(kInt8), PRECISION(kInt8)>::Run() {
   KERNEL_FUNC_NAME("sparse_conv_int8_int8_pipelined")
 }
 
+#ifdef ENABLE_ARM_FP16
+template <>
+void SparseConvCompute<PRECISION(kFP16), PRECISION(kFP16)>::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  // The weights are fp32 if they are not converted by the predictor, e.g. in
+  // the unit tests.
+  if (param.nonzero_weights->precision() != PRECISION(kFP16)) {
+    weights_.Resize(param.nonzero_weights->dims());
+    lite::arm::math::fp16::fp32_to_fp16(param.nonzero_weights->data<float>(),
+                                        weights_.mutable_data<float16_t>(),
+                                        weights_.numel());
+    flag_trans_weights_ = true;
+  }
+  if (param.bias && param.bias->precision() != PRECISION(kFP16)) {
+    bias_.Resize(param.bias->dims());
+    lite::arm::math::fp16::fp32_to_fp16(param.bias->data<float>(),
+                                        bias_.mutable_data<float16_t>(),
+                                        bias_.numel());
+    flag_trans_bias_ = true;
+  }
+  // The diffs are the byte offsets of the fp32 input.
+  diffs_.Resize(param.diffs->dims());
+  auto* diffs = diffs_.mutable_data<int32_t>();
+  auto* diffs_in = param.diffs->data<int32_t>();
+  for (int i = 0; i < diffs_.numel(); ++i) {
+    diffs[i] = diffs_in[i] / 2;
+  }
+}
+
+template <>
+void SparseConvCompute<PRECISION(kFP16), PRECISION(kFP16)>::Run() {
+  auto& param = this->Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto* input = param.x->data<float16_t>();
+  auto* nonzero_weights = flag_trans_weights_
+                              ? weights_.data<float16_t>()
+                              : param.nonzero_weights->data<float16_t>();
+  auto* diffs = diffs_.data<int32_t>();
+  auto* oc_nonzeros = param.oc_nonzeros->data<uint32_t>();
+  auto* bias = param.bias ? param.bias->data<float16_t>() : nullptr;
+  if (flag_trans_bias_) {
+    bias = bias_.data<float16_t>();
+  }
+  auto* dout = param.output->mutable_data<float16_t>();
+
+  auto x_dims = param.x->dims();
+  auto o_dims = param.output->dims();
+  int ic = x_dims[1];
+  int oh = o_dims[2];
+  int ow = o_dims[3];
+  int oc = o_dims[1];
+  int im_size = oh * ow;
+  int first_ic = param.first_ic;
+  int flag_semi = param.flag_semi;
+  auto* din = input + first_ic * im_size;
+  if (flag_semi == 1) {
+    lite::arm::math::fp16::sparse_semi_conv_fp16_pipelined(nonzero_weights,
+                                                           din,
+                                                           diffs,
+                                                           oc_nonzeros,
+                                                           bias,
+                                                           dout,
+                                                           oc,
+                                                           ic,
+                                                           im_size,
+                                                           param,
+                                                           &ctx);
+  } else {
+    lite::arm::math::fp16::sparse_conv_fp16_pipelined(nonzero_weights,
+                                                      din,
+                                                      diffs,
+                                                      oc_nonzeros,
+                                                      bias,
+                                                      dout,
+                                                      oc,
+                                                      ic,
+                                                      im_size,
+                                                      param,
+                                                      &ctx);
+  }
+  KERNEL_FUNC_NAME("sparse_conv_fp16_pipelined")
+}
+#endif
+
 }  // namespace arm
 }  // namespace kernels
 }  // namespace lite
@@ -304,3 +392,22 @@ REGISTER_LITE_KERNEL(
     .BindOutput("Output",
                 {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
     .Finalize();
+
+#ifdef ENABLE_ARM_FP16
+typedef paddle::lite::kernels::arm::SparseConvCompute<PRECISION(kFP16),
+                                                      PRECISION(kFP16)>
+    SparseConvFp16;
+
+REGISTER_LITE_KERNEL(sparse_conv2d, kARM, kFP16, kNCHW, SparseConvFp16, def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindInput("NonZeroWeights",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindInput("OcNonZeros",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt32))})
+    .BindInput("Diffs",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt32))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .Finalize();
+#endif  // ENABLE_ARM_FP16
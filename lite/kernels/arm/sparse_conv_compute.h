@@ -47,6 +47,11 @@ class SparseConvCompute : public KernelLite<TARGET(kARM), Ptype> {
   Tensor bias_;
   bool flag_trans_bias_{false};
   std::vector<float> w_scale_;
+  // The fp16 kernel only, the weights converted from fp32 and the diffs of
+  // the fp16 input.
+  Tensor weights_;
+  bool flag_trans_weights_{false};
+  Tensor diffs_;
 };
 
 }  // namespace arm
@@ -0,0 +1,454 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/arm/sparse_fc_compute.h"
+#include <algorithm>
+#include "lite/backends/arm/math/sparse_conv_impl.h"
+#include "lite/backends/arm/math/sparse_semi_conv_impl.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/type_system.h"
+#ifdef ENABLE_ARM_FP16
+#include "lite/backends/arm/math/fp16/funcs_fp16.h"
+#include "lite/backends/arm/math/fp16/sparse_conv_fp16.h"
+#endif
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+// dout[n x m] = din[m x n]^T, in the blocks of 8x8 to keep both in cache.
+template <typename T>
+static void transpose_block8(const T* din, T* dout, int m, int n) {
+  for (int i = 0; i < m; i += 8) {
+    int ie = std::min(i + 8, m);
+    for (int j = 0; j < n; j += 8) {
+      int je = std::min(j + 8, n);
+      for (int ii = i; ii < ie; ++ii) {
+        for (int jj = j; jj < je; ++jj) {
+          dout[jj * m + ii] = din[ii * n + jj];
+        }
+      }
+    }
+  }
+}
+
+// Call `compute` with the input in K x rows and the output in oc x rows,
+// which are transposed in the workspace unless there is only one row.
+template <typename Tin, typename Tout, typename Compute>
+static void sparse_fc_transposed(const Tensor* x,
+                                 Tensor* out,
+                                 int rows,
+                                 int oc,
+                                 int first_ic,
+                                 ARMContext* ctx,
+                                 Compute compute) {
+  int k = x->numel() / rows;
+  const Tin* din = x->data<Tin>();
+  Tout* dout = out->mutable_data<Tout>();
+  if (rows == 1) {
+    compute(din + first_ic, dout);
+    return;
+  }
+  size_t out_size = (oc * rows * sizeof(Tout) + 63) / 64 * 64;
+  ctx->ExtendWorkspace(out_size + k * rows * sizeof(Tin));
+  auto* dout_t = reinterpret_cast<Tout*>(ctx->workspace_data<int8_t>());
+  auto* din_t =
+      reinterpret_cast<Tin*>(ctx->workspace_data<int8_t>() + out_size);
+  transpose_block8(din, din_t, rows, k);
+  compute(din_t + first_ic * rows, dout_t);
+  transpose_block8(dout_t, dout, oc, rows);
+}
+
+template <PrecisionType Ptype, PrecisionType OutType>
+void SparseFcCompute<Ptype, OutType>::ReInitWhenNeeded() {
+  param_t& param = this->template Param<param_t>();
+  int oc = param.oc_nonzeros->dims()[0];
+  int rows = param.output->numel() / oc;
+  if (rows == rows_) return;
+  // The diffs are the byte offsets between the rows of the transposed
+  // input, in which each input channel holds `rows` elements. The ones of
+  // the fp16 kernel are built for the fp32 input.
+  int elem_ratio = Ptype == PRECISION(kFP16) ? 2 : 1;
+  diffs_.Resize(param.diffs->dims());
+  auto* diffs = diffs_.mutable_data<int32_t>();
+  auto* diffs_in = param.diffs->data<int32_t>();
+  for (int i = 0; i < diffs_.numel(); ++i) {
+    diffs[i] = diffs_in[i] / elem_ratio * rows;
+  }
+  rows_ = rows;
+}
+
+template <>
+void SparseFcCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {}
+
+template <>
+void SparseFcCompute<PRECISION(kInt8), PRECISION(kFloat)>::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  w_scale_ = param.weight_scale;
+  if (w_scale_.size() != 1 && w_scale_.size() != param.oc_nonzeros->dims()[0]) {
+    LOG(FATAL) << "weights scale size must equal to filter size";
+    return;
+  }
+  if (w_scale_.size() == 1) {
+    for (int i = 0; i < param.oc_nonzeros->dims()[0] - 1; ++i) {
+      w_scale_.push_back(w_scale_[0]);
+    }
+  }
+  float input_scale = param.input_scale;
+  for (auto& ws : w_scale_) {
+    ws *= input_scale;
+  }
+}
+
+template <>
+void SparseFcCompute<PRECISION(kInt8), PRECISION(kInt8)>::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  w_scale_ = param.weight_scale;
+  if (w_scale_.size() != 1 && w_scale_.size() != param.oc_nonzeros->dims()[0]) {
+    LOG(FATAL) << "weights scale size" << w_scale_.size()
+               << "must equal to filter size" << param.oc_nonzeros->dims()[0];
+    return;
+  }
+  if (w_scale_.size() == 1) {
+    for (int i = 0; i < param.oc_nonzeros->dims()[0] - 1; ++i) {
+      w_scale_.push_back(w_scale_[0]);
+    }
+  }
+  float input_scale = param.input_scale;
+  float output_scale = param.output_scale;
+  for (auto& ws : w_scale_) {
+    ws = ws * input_scale / output_scale;
+  }
+  if (param.bias) {
+    bias_.Resize(param.bias->dims());
+    auto* ptr = bias_.mutable_data<float>();
+    auto* ptr_in = param.bias->data<float>();
+    for (int i = 0; i < bias_.numel(); ++i) {
+      ptr[i] = ptr_in[i] / param.output_scale;
+    }
+    flag_trans_bias_ = true;
+  }
+}
+
+template <>
+void SparseFcCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
+  auto& param = this->Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  const float* nonzero_weights = param.nonzero_weights->data<float>();
+  const int32_t* diffs = diffs_.data<int32_t>();
+  const uint32_t* oc_nonzeros = param.oc_nonzeros->data<uint32_t>();
+  const float* bias = param.bias ? param.bias->data<float>() : nullptr;
+  int oc = param.oc_nonzeros->dims()[0];
+  int rows = rows_;
+  int ic = param.x->numel() / rows;
+  int flag_semi = param.flag_semi;
+  sparse_fc_transposed<float, float>(
+      param.x,
+      param.output,
+      rows,
+      oc,
+      param.first_ic,
+      &ctx,
+      [&](const float* din, float* dout) {
+        if (flag_semi == 1) {
+          lite::arm::math::sparse_semi_conv_fp32_pipelined(nonzero_weights,
+                                                           din,
+                                                           diffs,
+                                                           oc_nonzeros,
+                                                           bias,
+                                                           dout,
+                                                           oc,
+                                                           ic,
+                                                           rows,
+                                                           param,
+                                                           &ctx);
+        } else {
+          lite::arm::math::sparse_conv_fp32_pipelined(nonzero_weights,
+                                                      din,
+                                                      diffs,
+                                                      oc_nonzeros,
+                                                      bias,
+                                                      dout,
+                                                      oc,
+                                                      ic,
+                                                      rows,
+                                                      param,
+                                                      &ctx);
+        }
+      });
+  KERNEL_FUNC_NAME("sparse_fc_fp32_pipelined")
+}
+
+template <>
+void SparseFcCompute<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
+  auto& param = this->Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto* nonzero_weights = param.nonzero_weights->data<int8_t>();
+  auto* diffs = diffs_.data<int32_t>();
+  auto* oc_nonzeros = param.oc_nonzeros->data<uint32_t>();
+  auto* bias = param.bias ? param.bias->data<float>() : nullptr;
+  if (flag_trans_bias_) {
+    bias = bias_.data<float>();
+  }
+  int oc = param.oc_nonzeros->dims()[0];
+  int rows = rows_;
+  int ic = param.x->numel() / rows;
+  int flag_semi = param.flag_semi;
+  sparse_fc_transposed<int8_t, float>(
+      param.x,
+      param.output,
+      rows,
+      oc,
+      param.first_ic,
+      &ctx,
+      [&](const int8_t* din, float* dout) {
+        if (flag_semi == 1) {
+          lite::arm::math::sparse_semi_conv_int8_fp32_pipelined(
+              nonzero_weights,
+              din,
+              diffs,
+              oc_nonzeros,
+              bias,
+              w_scale_.data(),
+              dout,
+              oc,
+              ic,
+              rows,
+              param,
+              &ctx);
+        } else {
+          lite::arm::math::sparse_conv_int8_fp32_pipelined(nonzero_weights,
+                                                           din,
+                                                           diffs,
+                                                           oc_nonzeros,
+                                                           bias,
+                                                           w_scale_.data(),
+                                                           dout,
+                                                           oc,
+                                                           ic,
+                                                           rows,
+                                                           param,
+                                                           &ctx);
+        }
+      });
+  KERNEL_FUNC_NAME("sparse_fc_int8_fp32_pipelined")
+}
+
+template <>
+void SparseFcCompute<PRECISION(kInt8), PRECISION(kInt8)>::Run() {
+  auto& param = this->Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto* nonzero_weights = param.nonzero_weights->data<int8_t>();
+  auto* diffs = diffs_.data<int32_t>();
+  auto* oc_nonzeros = param.oc_nonzeros->data<uint32_t>();
+  auto* bias = param.bias ? param.bias->data<float>() : nullptr;
+  if (flag_trans_bias_) {
+    bias = bias_.data<float>();
+  }
+  int oc = param.oc_nonzeros->dims()[0];
+  int rows = rows_;
+  int ic = param.x->numel() / rows;
+  int flag_semi = param.flag_semi;
+  sparse_fc_transposed<int8_t, int8_t>(
+      param.x,
+      param.output,
+      rows,
+      oc,
+      param.first_ic,
+      &ctx,
+      [&](const int8_t* din, int8_t* dout) {
+        if (flag_semi == 1) {
+          lite::arm::math::sparse_semi_conv_int8_int8_pipelined(
+              nonzero_weights,
+              din,
+              diffs,
+              oc_nonzeros,
+              bias,
+              w_scale_.data(),
+              dout,
+              oc,
+              ic,
+              rows,
+              param,
+              &ctx);
+        } else {
+          lite::arm::math::sparse_conv_int8_int8_pipelined(nonzero_weights,
+                                                           din,
+                                                           diffs,
+                                                           oc_nonzeros,
+                                                           bias,
+                                                           w_scale_.data(),
+                                                           dout,
+                                                           oc,
+                                                           ic,
+                                                           rows,
+                                                           param,
+                                                           &ctx);
+        }
+      });
+  KERNEL_FUNC_NAME("sparse_fc_int8_int8_pipelined")
+}
+
+template class SparseFcCompute<PRECISION(kFloat), PRECISION(kFloat)>;
+template class SparseFcCompute<PRECISION(kInt8), PRECISION(kFloat)>;
+template class SparseFcCompute<PRECISION(kInt8), PRECISION(kInt8)>;
+
+#ifdef ENABLE_ARM_FP16
+template <>
+void SparseFcCompute<PRECISION(kFP16), PRECISION(kFP16)>::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  // The weights are fp32 if they are not converted by the predictor, e.g. in
+  // the unit tests.
+  if (param.nonzero_weights->precision() != PRECISION(kFP16)) {
+    weights_.Resize(param.nonzero_weights->dims());
+    lite::arm::math::fp16::fp32_to_fp16(param.nonzero_weights->data<float>(),
+                                        weights_.mutable_data<float16_t>(),
+                                        weights_.numel());
+    flag_trans_weights_ = true;
+  }
+  if (param.bias && param.bias->precision() != PRECISION(kFP16)) {
+    bias_.Resize(param.bias->dims());
+    lite::arm::math::fp16::fp32_to_fp16(param.bias->data<float>(),
+                                        bias_.mutable_data<float16_t>(),
+                                        bias_.numel());
+    flag_trans_bias_ = true;
+  }
+}
+
+template <>
+void SparseFcCompute<PRECISION(kFP16), PRECISION(kFP16)>::Run() {
+  auto& param = this->Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto* nonzero_weights = flag_trans_weights_
+                              ? weights_.data<float16_t>()
+                              : param.nonzero_weights->data<float16_t>();
+  auto* diffs = diffs_.data<int32_t>();
+  auto* oc_nonzeros = param.oc_nonzeros->data<uint32_t>();
+  auto* bias = param.bias ? param.bias->data<float16_t>() : nullptr;
+  if (flag_trans_bias_) {
+    bias = bias_.data<float16_t>();
+  }
+  int oc = param.oc_nonzeros->dims()[0];
+  int rows = rows_;
+  int ic = param.x->numel() / rows;
+  int flag_semi = param.flag_semi;
+  sparse_fc_transposed<float16_t, float16_t>(
+      param.x,
+      param.output,
+      rows,
+      oc,
+      param.first_ic,
+      &ctx,
+      [&](const float16_t* din, float16_t* dout) {
+        if (flag_semi == 1) {
+          lite::arm::math::fp16::sparse_semi_conv_fp16_pipelined(
+              nonzero_weights,
+              din,
+              diffs,
+              oc_nonzeros,
+              bias,
+              dout,
+              oc,
+              ic,
+              rows,
+              param,
+              &ctx);
+        } else {
+          lite::arm::math::fp16::sparse_conv_fp16_pipelined(nonzero_weights,
+                                                            din,
+                                                            diffs,
+                                                            oc_nonzeros,
+                                                            bias,
+                                                            dout,
+                                                            oc,
+                                                            ic,
+                                                            rows,
+                                                            param,
+                                                            &ctx);
+        }
+      });
+  KERNEL_FUNC_NAME("sparse_fc_fp16_pipelined")
+}
+
+template class SparseFcCompute<PRECISION(kFP16), PRECISION(kFP16)>;
+#endif
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+typedef paddle::lite::kernels::arm::SparseFcCompute<PRECISION(kFloat),
+                                                    PRECISION(kFloat)>
+    SparseFcFp32;
+typedef paddle::lite::kernels::arm::SparseFcCompute<PRECISION(kInt8),
+                                                    PRECISION(kFloat)>
+    SparseFcInt8Fp32;
+typedef paddle::lite::kernels::arm::SparseFcCompute<PRECISION(kInt8),
+                                                    PRECISION(kInt8)>
+    SparseFcInt8Int8;
+
+REGISTER_LITE_KERNEL(sparse_fc, kARM, kFloat, kNCHW, SparseFcFp32, def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("NonZeroWeights", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("OcNonZeros", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Diffs", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    sparse_fc, kARM, kInt8, kNCHW, SparseFcInt8Fp32, int8_fp32_out)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindInput("NonZeroWeights",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindInput("OcNonZeros",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt32))})
+    .BindInput("Diffs",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt32))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    sparse_fc, kARM, kInt8, kNCHW, SparseFcInt8Int8, int8_int8_out)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindInput("NonZeroWeights",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindInput("OcNonZeros",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt32))})
+    .BindInput("Diffs",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt32))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .Finalize();
+
+#ifdef ENABLE_ARM_FP16
+typedef paddle::lite::kernels::arm::SparseFcCompute<PRECISION(kFP16),
+                                                    PRECISION(kFP16)>
+    SparseFcFp16;
+
+REGISTER_LITE_KERNEL(sparse_fc, kARM, kFP16, kNCHW, SparseFcFp16, def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindInput("NonZeroWeights",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindInput("OcNonZeros",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt32))})
+    .BindInput("Diffs",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt32))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .Finalize();
+#endif  // ENABLE_ARM_FP16
@@ -509,59 +509,6 @@ void TransposeCompute::ReInitWhenNeeded() {
 }
 void TransposeCompute::PrepareForRun() { ReInitWhenNeeded(); }
 
-template <typename Dtype>
-void TransposeCompute_(const std::vector<int>& axis,
-                       const lite::Tensor* input,
-                       lite::Tensor* output) {
-  const Dtype* input_ptr = input->data<Dtype>();
-  Dtype* output_ptr = output->mutable_data<Dtype>();
-
-  // input and output's shape dimension must >= 2 && <= 6.
-  const DDim& in_dim = input->dims();
-  const DDim& out_dim = output->dims();
-
-  // precompute inverted output dim and strides
-  size_t rout_dim[6], strides[6];
-  int permute = axis.size();  // permute must >=2 && <= 6.
-  for (int i = 0; i < permute; ++i) {
-    int k = permute - 1 - i;
-    strides[k] = 1;
-    for (int j = axis[i] + 1; j < permute; ++j) {
-      strides[k] *= in_dim[j];
-    }
-    rout_dim[k] = out_dim[i];
-  }
-
-  // unroll the first 2 dimensions
-  int reamin_dim = 1;
-  for (int i = 2; i < out_dim.size(); ++i) {
-    reamin_dim *= out_dim[i];
-  }
-
-  for (int batch = 0; batch < out_dim[0]; ++batch) {
-    LITE_PARALLEL_BEGIN(j, tid, out_dim[1]) {
-      size_t offset = batch * strides[permute - 1] + j * strides[permute - 2];
-      Dtype* out_ptr = output_ptr + (batch * out_dim[1] + j) * reamin_dim;
-      int indics[4] = {0, 0, 0, 0};
-      for (int k = 0; k < reamin_dim; ++k) {
-        out_ptr[k] = input_ptr[offset];
-        indics[0] += 1;
-        offset += strides[0];
-        for (int p = 0; p < permute - 3; ++p) {
-          if (indics[p] == rout_dim[p]) {
-            indics[p + 1] += 1;
-            indics[p] = 0;
-            offset += strides[p + 1];
-            offset -= rout_dim[p] * strides[p];
-          } else {
-            break;
-          }
-        }
-      }
-    }
-    LITE_PARALLEL_END();
-  }
-}
 // Transpose
 void TransposeCompute::Run() {
   auto& param = Param<operators::TransposeParam>();
@@ -589,31 +536,16 @@ void TransposeCompute::Run() {
   }
 #endif
 
-  switch (input->precision()) {
-    case PRECISION(kInt8):
-      TransposeCompute_<int8_t>(axis, input, output);
-      break;
-    case PRECISION(kInt32):
-      TransposeCompute_<int32_t>(axis, input, output);
-      break;
-    case PRECISION(kInt64):
-      TransposeCompute_<int64_t>(axis, input, output);
-      break;
-#ifdef ENABLE_ARM_FP16
-    case PRECISION(kFP16):
-      TransposeCompute_<lite_api::float16_t>(axis, input, output);
-      break;
-#endif
-    case PRECISION(kFloat):
-      TransposeCompute_<float>(axis, input, output);
-      break;
-    case PRECISION(kFP64):
-      TransposeCompute_<double>(axis, input, output);
-      break;
-    default:
-      LOG(FATAL) << "Not support the dtype: "
-                 << static_cast<int>(input->precision());
-  }
+  size_t elem_size = PrecisionTypeLength(input->precision());
+  CHECK(elem_size == 1 || elem_size == 2 || elem_size == 4 || elem_size == 8)
+      << "Not support the dtype: " << static_cast<int>(input->precision());
+  output->set_precision(input->precision());
+  void* dout = output->mutable_data(input->numel() * elem_size);
+  lite::arm::math::transpose_nd(input->raw_data(),
+                                dout,
+                                elem_size,
+                                input->dims().Vectorize(),
+                                axis);
 }
 
 }  // namespace arm
@@ -198,6 +198,16 @@ __global__ void AddBiasRelu<half>(const int num, const half* bias, half* data) {
 
 template <typename T, PrecisionType PType>
 void FcCompute<T, PType>::PrepareForRun() {
+#if (CUBLAS_VER_MAJOR * 10 + CUBLAS_VER_MINOR) >= 101
+  auto& param = this->template Param<param_t>();
+  bool has_bias = param.bias != nullptr;
+  if (lite::cuda::math::LtGemm<T, T>::support_epilogue(
+          has_bias, param.activation_type)) {
+    lt_gemm_impl_.reset(new lite::cuda::math::LtGemm<T, T>);
+    lt_gemm_impl_->set_epilogue(has_bias, param.activation_type);
+    return;
+  }
+#endif
   gemm_impl_.reset(new lite::cuda::math::Gemm<T, T>);
 }
 
@@ -228,6 +238,14 @@ void FcCompute<T, PType>::Run() {
   int N = static_cast<int>(param.w->dims()[1]);
   CHECK_EQ(K, K2) << "x_w must be equal with y_h";
 
+#if (CUBLAS_VER_MAJOR * 10 + CUBLAS_VER_MINOR) >= 101
+  if (lt_gemm_impl_) {
+    CHECK(lt_gemm_impl_->init(false, false, M, N, K, &context));
+    lt_gemm_impl_->run(1.0f, 0.0f, x_data, w_data, out_data, &context, b_data);
+    return;
+  }
+#endif
+
   CHECK(gemm_impl_->init(false, false, M, N, K, &context));
   gemm_impl_->run(1.0f, 0.0f, x_data, w_data, out_data, &context);
 
@@ -292,6 +310,14 @@ void FcCompute<half, PRECISION(kFP16)>::Run() {
   int N = static_cast<int>(param.w->dims()[1]);
   CHECK_EQ(K, K2) << "x_w must be equal with y_h";
 
+#if (CUBLAS_VER_MAJOR * 10 + CUBLAS_VER_MINOR) >= 101
+  if (lt_gemm_impl_) {
+    CHECK(lt_gemm_impl_->init(false, false, M, N, K, &context));
+    lt_gemm_impl_->run(1.0f, 0.0f, x_data, w_data, out_data, &context, b_data);
+    return;
+  }
+#endif
+
   CHECK(gemm_impl_->init(false, false, M, N, K, &context));
   gemm_impl_->run(1.0f, 0.0f, x_data, w_data, out_data, &context);
 
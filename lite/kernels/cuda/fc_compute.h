@@ -37,6 +37,10 @@ class FcCompute : public KernelLite<TARGET(kCUDA), PType> {
 
  private:
   std::unique_ptr<lite::cuda::math::Gemm<T, T>> gemm_impl_{nullptr};
+#if (CUBLAS_VER_MAJOR * 10 + CUBLAS_VER_MINOR) >= 101
+  // the gemm with the bias and the activation in its epilogue
+  std::unique_ptr<lite::cuda::math::LtGemm<T, T>> lt_gemm_impl_{nullptr};
+#endif
 };
 
 }  // namespace cuda
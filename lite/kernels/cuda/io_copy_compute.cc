@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstring>
 #include "lite/backends/cuda/target_wrapper.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
@@ -40,6 +41,77 @@ void CopyToHostSync(void* target, const void* source, size_t size) {
   TargetW::MemcpySync(target, source, size, IoDirection::DtoH);
 }
 
+void CopyToHostAsync(void* target,
+                     const void* source,
+                     size_t size,
+                     TargetW::stream_t stream) {
+  TargetW::MemcpyAsync(target, source, size, IoDirection::DtoH, stream);
+}
+
+/*
+ * The pinned host buffers staging the copies of one io_copy kernel. Two
+ * buffers are used in turn, so the host fills one while the copy of the
+ * other is still in flight on the io stream.
+ */
+class PinnedStaging {
+ public:
+  PinnedStaging() = default;
+  PinnedStaging(const PinnedStaging&) = delete;
+  PinnedStaging& operator=(const PinnedStaging&) = delete;
+
+  ~PinnedStaging() {
+    for (auto& buffer : buffers_) {
+      if (buffer.recorded) TargetW::SyncEvent(buffer.event);
+      if (buffer.data) TargetW::FreeHost(buffer.data);
+      if (buffer.event) TargetW::DestroyEvent(buffer.event);
+    }
+  }
+
+  // Returns the next buffer of size bytes, after its last copy is done.
+  void* Acquire(size_t size) {
+    index_ = (index_ + 1) % kNumBuffers;
+    auto& buffer = buffers_[index_];
+    if (buffer.recorded) {
+      TargetW::SyncEvent(buffer.event);
+      buffer.recorded = false;
+    }
+    if (buffer.size < size) {
+      if (buffer.data) TargetW::FreeHost(buffer.data);
+      buffer.data = TargetW::MallocHost(size);
+      buffer.size = size;
+    }
+    if (!buffer.event) TargetW::CreateEventWithFlags(&buffer.event);
+    return buffer.data;
+  }
+
+  // Marks the end of the copies of the acquired buffer on the stream.
+  TargetW::event_t Release(const TargetW::stream_t& stream) {
+    auto& buffer = buffers_[index_];
+    TargetW::RecordEvent(buffer.event, stream);
+    buffer.recorded = true;
+    return buffer.event;
+  }
+
+ private:
+  static const int kNumBuffers = 2;
+  struct Buffer {
+    void* data{nullptr};
+    size_t size{0};
+    TargetW::event_t event{nullptr};
+    bool recorded{false};
+  };
+  Buffer buffers_[kNumBuffers];
+  int index_{0};
+};
+
+// Makes the io stream wait for the kernels queued on the exec stream.
+void WaitExecStream(CUDAContext* ctx, TargetW::event_t* event) {
+  if (ctx->io_stream() == ctx->exec_stream()) return;
+  if (!*event) TargetW::CreateEventWithFlags(event);
+  TargetW::RecordEvent(*event, ctx->exec_stream());
+  TargetW::StreamSync(ctx->io_stream(), *event);
+}
+
 /*
  * This kernel copies a tensor from host to CUDA space.
  */
@@ -50,10 +122,21 @@ class IoCopyHostToCudaCompute
     auto& param = Param<operators::IoCopyParam>();
     CHECK(param.x->target() == TARGET(kHost) ||
           param.x->target() == TARGET(kX86));
+    auto& ctx = this->ctx_->template As<CUDAContext>();
     auto mem_size = param.x->memory_size();
     VLOG(4) << "copy size " << mem_size;
     auto* data = param.y->mutable_data(TARGET(kCUDA), mem_size);
-    CopyFromHostSync(data, param.x->raw_data(), mem_size);
+    // the last run may still read the output on the exec stream
+    WaitExecStream(&ctx, &exec_event_);
+    void* staging = staging_.Acquire(mem_size);
+    std::memcpy(staging, param.x->raw_data(), mem_size);
+    CopyFromHostAsync(data, staging, mem_size, ctx.io_stream());
+    // the kernels after this one wait for the copy on the device only
+    TargetW::StreamSync(ctx.exec_stream(), staging_.Release(ctx.io_stream()));
+  }
+
+  ~IoCopyHostToCudaCompute() {
+    if (exec_event_) TargetW::DestroyEvent(exec_event_);
   }
 
   std::unique_ptr<type_infer_handler_t> GetTypeInferHandler() override {
@@ -77,6 +160,10 @@ class IoCopyHostToCudaCompute
   }
 
   std::string doc() const override { return "Copy IO from HOST to CUDA"; }
+
+ private:
+  PinnedStaging staging_;
+  TargetW::event_t exec_event_{nullptr};
 };
 
 /*
@@ -88,13 +175,54 @@ class IoCopyCudaToHostCompute
   void Run() override {
     auto& param = Param<operators::IoCopyParam>();
     CHECK(param.x->target() == TARGET(kCUDA));
+    auto& ctx = this->ctx_->template As<CUDAContext>();
     auto mem_size = param.x->memory_size();
     VLOG(4) << "io copy cuda to host " << mem_size;
     auto* data = param.y->mutable_data(TARGET(kHost), mem_size);
-    CopyToHostSync(data, param.x->raw_data(), mem_size);
+    WaitExecStream(&ctx, &exec_event_);
+    void* staging = staging_.Acquire(mem_size);
+    CopyToHostAsync(staging, param.x->raw_data(), mem_size, ctx.io_stream());
+    TargetW::SyncEvent(staging_.Release(ctx.io_stream()));
+    std::memcpy(data, staging, mem_size);
+  }
+
+  ~IoCopyCudaToHostCompute() {
+    if (exec_event_) TargetW::DestroyEvent(exec_event_);
   }
 
   std::string doc() const override { return "Copy IO from CUDA to HOST"; }
+
+ private:
+  PinnedStaging staging_;
+  TargetW::event_t exec_event_{nullptr};
+};
+
+/*
+ * io_copy_once copies the weights once, not worth the pinned buffers.
+ */
+class IoCopyHostToCudaOnceCompute : public IoCopyHostToCudaCompute {
+ public:
+  void Run() override {
+    auto& param = Param<operators::IoCopyParam>();
+    CHECK(param.x->target() == TARGET(kHost) ||
+          param.x->target() == TARGET(kX86));
+    auto mem_size = param.x->memory_size();
+    VLOG(4) << "copy size " << mem_size;
+    auto* data = param.y->mutable_data(TARGET(kCUDA), mem_size);
+    CopyFromHostSync(data, param.x->raw_data(), mem_size);
+  }
+};
+
+class IoCopyCudaToHostOnceCompute : public IoCopyCudaToHostCompute {
+ public:
+  void Run() override {
+    auto& param = Param<operators::IoCopyParam>();
+    CHECK(param.x->target() == TARGET(kCUDA));
+    auto mem_size = param.x->memory_size();
+    VLOG(4) << "io copy cuda to host " << mem_size;
+    auto* data = param.y->mutable_data(TARGET(kHost), mem_size);
+    CopyToHostSync(data, param.x->raw_data(), mem_size);
+  }
 };
 
 }  // namespace cuda
@@ -138,7 +266,7 @@ REGISTER_LITE_KERNEL(io_copy_once,
                      kCUDA,
                      kAny,
                      kAny,
-                     paddle::lite::kernels::cuda::IoCopyHostToCudaCompute,
+                     paddle::lite::kernels::cuda::IoCopyHostToCudaOnceCompute,
                      host_to_device)
     .BindInput("Input",
                {LiteType::GetTensorTy(TARGET(kHost),
@@ -154,7 +282,7 @@ REGISTER_LITE_KERNEL(io_copy_once,
                      kCUDA,
                      kAny,
                      kAny,
-                     paddle::lite::kernels::cuda::IoCopyCudaToHostCompute,
+                     paddle::lite::kernels::cuda::IoCopyCudaToHostOnceCompute,
                      device_to_host)
     .BindInput("Input",
                {LiteType::GetTensorTy(TARGET(kCUDA),
@@ -14,7 +14,6 @@
 
 #pragma once
 #include <algorithm>
-#include <utility>
 #include <vector>
 
 #include "lite/core/kernel.h"
@@ -49,33 +48,34 @@ class ArgsortCompute
     int axis_size = x_dims[axis];
     int inner_size = x_dims.count(axis + 1, dim_size);
     int sort_size = axis_size * inner_size;
-    LITE_PARALLEL_BEGIN(n, tid, outer_size) {
-      const DataType* in_data = x_data + n * sort_size;
-      DataType* out_data = out_val + n * sort_size;
-      int64_t* out_ind_data = out_ind + n * sort_size;
-      for (int i = 0; i < inner_size; i++) {
-        std::vector<std::pair<DataType, int>> vec;
-        vec.resize(axis_size);
-        for (int j = 0; j < axis_size; j++) {
-          vec[j] = std::make_pair(in_data[j * inner_size + i], j);
-        }
-        if (descending) {
-          std::sort(vec.begin(),
-                    vec.end(),
-                    [](std::pair<DataType, int> a, std::pair<DataType, int> b) {
-                      return a.first > b.first;
-                    });
-        } else {
-          std::sort(vec.begin(),
-                    vec.end(),
-                    [](std::pair<DataType, int> a, std::pair<DataType, int> b) {
-                      return a.first < b.first;
-                    });
-        }
-        for (int j = 0; j < axis_size; j++) {
-          out_data[j * inner_size + i] = vec[j].first;
-          out_ind_data[j * inner_size + i] = vec[j].second;
-        }
+    // The rows of all the outer and inner indices run in parallel. The
+    // indices of a row are sorted by the values, the ties in the order of
+    // the indices.
+    LITE_PARALLEL_BEGIN(r, tid, outer_size * inner_size) {
+      const int n = r / inner_size;
+      const int i = r % inner_size;
+      const DataType* in_data = x_data + n * sort_size + i;
+      DataType* out_data = out_val + n * sort_size + i;
+      int64_t* out_ind_data = out_ind + n * sort_size + i;
+      std::vector<DataType> values(axis_size);
+      std::vector<int> indices(axis_size);
+      for (int j = 0; j < axis_size; j++) {
+        values[j] = in_data[j * inner_size];
+        indices[j] = j;
+      }
+      const DataType* v = values.data();
+      if (descending) {
+        std::sort(indices.begin(), indices.end(), [v](int a, int b) {
+          return v[a] > v[b] || (v[a] == v[b] && a < b);
+        });
+      } else {
+        std::sort(indices.begin(), indices.end(), [v](int a, int b) {
+          return v[a] < v[b] || (v[a] == v[b] && a < b);
+        });
+      }
+      for (int j = 0; j < axis_size; j++) {
+        out_data[j * inner_size] = values[indices[j]];
+        out_ind_data[j * inner_size] = indices[j];
       }
     }
     LITE_PARALLEL_END()
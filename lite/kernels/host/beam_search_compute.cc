@@ -32,7 +32,8 @@ void BeamSearchCompute::Run() {
                                 param.level,
                                 param.beam_size,
                                 param.end_id,
-                                param.is_accumulated);
+                                param.is_accumulated,
+                                &buffer_);
 }
 
 }  // namespace host
@@ -51,30 +51,41 @@ struct BeamSearchDecoder {
    * One is all candidate sentences with word id, one is all candidate sentences
    * with word score.
    * Param:
-   *  sentence_vector_list: sentence_vector for each source sentence.
+   *  sentence_vector_list: sentence_vector for each source sentence, sorted
+   *  in place.
    *  id_tensor: result LoDTensor for sentences of id.
    *  score_tensor: result LoDTensor for sentences of score.
    *  reverse: whether ids of sentence in sentence_vector_list is reversed
    *  sort_by_score: whether to sort hypotheses of each sentence by scores.
    */
   void ConvertSentenceVectorToLodTensor(
-      std::vector<SentenceVector<T>> sentence_vector_list,
+      std::vector<SentenceVector<T>>* sentence_vector_list,
       LoDTensor* id_tensor,
       LoDTensor* score_tensor,
       bool reverse = true,
       bool sort_by_score = true) const {
-    size_t src_num = sentence_vector_list.size();
+    size_t src_num = sentence_vector_list->size();
     CHECK_GT(src_num, 0) << "src_num should not be 0";
 
     std::vector<uint64_t> source_level_lod = {0};
     std::vector<uint64_t> sentence_level_lod = {0};
-    std::vector<int64_t> id_data;
-    std::vector<T> score_data;
+    size_t word_num = 0;
+    for (const auto& sentence_vector : *sentence_vector_list) {
+      for (const auto& sentence : sentence_vector) {
+        word_num += sentence.word_ids.size();
+      }
+    }
+    // the ids and the scores are written to the tensors directly
+    id_tensor->Resize({static_cast<int64_t>(word_num)});
+    score_tensor->Resize({static_cast<int64_t>(word_num)});
+    int64_t* id_data = id_tensor->mutable_data<int64_t>();
+    T* score_data = score_tensor->mutable_data<T>();
 
     for (size_t src_idx = 0; src_idx < src_num; ++src_idx) {
+      auto& sentence_vector = sentence_vector_list->at(src_idx);
       if (sort_by_score) {
-        std::stable_sort(sentence_vector_list[src_idx].begin(),
-                         sentence_vector_list[src_idx].end(),
+        std::stable_sort(sentence_vector.begin(),
+                         sentence_vector.end(),
                          [reverse](const Sentence<T>& a, const Sentence<T>& b) {
                            if (reverse)
                              return a.scores.front() > b.scores.front();
@@ -82,27 +93,24 @@ struct BeamSearchDecoder {
                              return a.scores.back() > b.scores.back();
                          });
       }
-      for (Sentence<T>& sentence : sentence_vector_list[src_idx]) {
+      for (Sentence<T>& sentence : sentence_vector) {
         if (reverse) {
-          id_data.insert(id_data.end(),
-                         sentence.word_ids.rbegin(),
-                         sentence.word_ids.rend());
-          score_data.insert(score_data.end(),
-                            sentence.scores.rbegin(),
-                            sentence.scores.rend());
+          id_data = std::copy(
+              sentence.word_ids.rbegin(), sentence.word_ids.rend(), id_data);
+          score_data = std::copy(
+              sentence.scores.rbegin(), sentence.scores.rend(), score_data);
         } else {
-          id_data.insert(id_data.end(),
-                         sentence.word_ids.begin(),
-                         sentence.word_ids.end());
-          score_data.insert(
-              score_data.end(), sentence.scores.begin(), sentence.scores.end());
+          id_data = std::copy(
+              sentence.word_ids.begin(), sentence.word_ids.end(), id_data);
+          score_data = std::copy(
+              sentence.scores.begin(), sentence.scores.end(), score_data);
         }
 
         sentence_level_lod.push_back(sentence_level_lod.back() +
                                      sentence.word_ids.size());
       }
       source_level_lod.push_back(source_level_lod.back() +
-                                 sentence_vector_list[src_idx].size());
+                                 sentence_vector.size());
     }
 
     LoD lod;
@@ -110,21 +118,7 @@ struct BeamSearchDecoder {
     lod.push_back(sentence_level_lod);
 
     id_tensor->set_lod(lod);
-
-    id_tensor->Resize({static_cast<int64_t>(id_data.size())});
-    auto id_ptr = id_tensor->mutable_data<int64_t>();
-    TargetCopy(TARGET(kHost),
-               id_ptr,
-               id_data.data(),
-               id_data.size() * sizeof(int64_t));
-
     score_tensor->set_lod(lod);
-    score_tensor->Resize({static_cast<int64_t>(score_data.size())});
-    auto score_ptr = score_tensor->mutable_data<T>();
-    TargetCopy(TARGET(kHost),
-               score_ptr,
-               score_data.data(),
-               score_data.size() * sizeof(T));
   }
 
   /**
@@ -203,7 +197,7 @@ struct BeamSearchDecoder {
     }
 
     ConvertSentenceVectorToLodTensor(
-        sentence_vector_list, id_tensor, score_tensor, true, true);
+        &sentence_vector_list, id_tensor, score_tensor, true, true);
   }
 
   size_t beam_size_;
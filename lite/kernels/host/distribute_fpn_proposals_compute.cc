@@ -17,6 +17,7 @@
 #include <cmath>
 #include <string>
 #include <vector>
+#include "lite/backends/host/math/roi_align.h"
 
 namespace paddle {
 namespace lite {
@@ -25,24 +26,6 @@ namespace host {
 
 const int kBoxDim = 4;
 
-template <typename T>
-static inline T BBoxArea(const T* box, bool pixel_offset) {
-  if (box[2] < box[0] || box[3] < box[1]) {
-    // If coordinate values are is invalid
-    // (e.g. xmax < xmin or ymax < ymin), return 0.
-    return static_cast<T>(0.);
-  } else {
-    const T w = box[2] - box[0];
-    const T h = box[3] - box[1];
-    if (pixel_offset) {
-      // If coordinate values are not within range [0, 1].
-      return (w + 1) * (h + 1);
-    } else {
-      return w * h;
-    }
-  }
-}
-
 inline std::vector<uint64_t> GetLodFromRoisNum(const Tensor* rois_num) {
   std::vector<uint64_t> rois_lod;
   auto* rois_num_data = rois_num->data<int>();
@@ -87,11 +70,12 @@ void DistributeFpnProposalsCompute::Run() {
     const float* rois_data = fpn_rois_slice.data<float>();
     for (int j = 0; j < fpn_rois_slice.dims()[0]; ++j) {
       // get the target level of current rois
-      float roi_scale = std::sqrt(BBoxArea(rois_data, pixel_offset));
-      int tgt_lvl =
-          std::floor(log2(roi_scale / refer_scale + static_cast<float>(1e-6)) +
-                     refer_level);
-      tgt_lvl = std::min(max_level, std::max(tgt_lvl, min_level));
+      int tgt_lvl = lite::host::math::fpn_level(rois_data,
+                                                min_level,
+                                                max_level,
+                                                refer_level,
+                                                refer_scale,
+                                                pixel_offset);
       target_level.push_back(tgt_lvl);
       num_rois_level[tgt_lvl - min_level]++;
       rois_data += kBoxDim;
@@ -0,0 +1,100 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/host/distribute_fpn_roi_align_compute.h"
+#include <vector>
+#include "lite/backends/host/math/roi_align.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace host {
+
+void DistributeFpnRoiAlignCompute::Run() {
+  auto& param = Param<operators::DistributeFpnRoiAlignParam>();
+  const float* rois_data = param.FpnRois->data<float>();
+  const int rois_num = param.FpnRois->dims()[0];
+  std::vector<uint64_t> rois_lod;
+  if (param.RoisNum) {
+    const int* rois_num_data = param.RoisNum->data<int>();
+    rois_lod.push_back(0);
+    for (int i = 0; i < param.RoisNum->numel(); i++) {
+      rois_lod.push_back(rois_lod.back() + rois_num_data[i]);
+    }
+  } else {
+    CHECK(!param.FpnRois->lod().empty());
+    rois_lod = param.FpnRois->lod().back();
+  }
+  CHECK_EQ(rois_lod.back(), static_cast<uint64_t>(rois_num));
+  std::vector<int> batch_ids(rois_num);
+  for (size_t n = 0; n + 1 < rois_lod.size(); n++) {
+    for (uint64_t i = rois_lod[n]; i < rois_lod[n + 1]; i++) {
+      batch_ids[i] = n;
+    }
+  }
+
+  // Every roi is pooled from its level into its row of Out, so neither the
+  // rois of the levels nor the outputs of the levels are gathered.
+  auto x_dims = param.X[0]->dims();
+  const int channels = x_dims[1];
+  const int out_stride = channels * param.pooled_height * param.pooled_width;
+  float* out_data = param.Out->mutable_data<float>();
+  LITE_PARALLEL_BEGIN(n, tid, rois_num) {
+    const float* roi = rois_data + n * 4;
+    const int level = lite::host::math::fpn_level(roi,
+                                                  param.min_level,
+                                                  param.max_level,
+                                                  param.refer_level,
+                                                  param.refer_scale,
+                                                  param.pixel_offset) -
+                      param.min_level;
+    const auto* x = param.X[level];
+    const int height = x->dims()[2];
+    const int width = x->dims()[3];
+    lite::host::math::roi_align_one(
+        x->data<float>() + batch_ids[n] * channels * height * width,
+        roi,
+        out_data + n * out_stride,
+        channels,
+        height,
+        width,
+        param.pooled_height,
+        param.pooled_width,
+        param.spatial_scales[level],
+        param.sampling_ratio,
+        param.aligned);
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace host
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fusion_distribute_fpn_roi_align,
+                     kHost,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::host::DistributeFpnRoiAlignCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kFloat))})
+    .BindInput("FpnRois",
+               {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kFloat))})
+    .BindInput("RoisNum",
+               {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kInt32))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kFloat))})
+    .Finalize();
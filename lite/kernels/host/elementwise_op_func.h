@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstring>
 #include <functional>
 #include <utility>
@@ -231,6 +232,14 @@ struct BatchElementWiseArg {
     return z_data_ + ElemID2Offset(batch_id * continuous_length_, z_stride_);
   }
 
+  /**
+   * Calls `fn` with the pointers of the batches [begin, end) in order. Only
+   * the first batch is located from its id, the following ones are stepped
+   * to, so it is cheap even if the batches are short.
+   */
+  template <class Fn>
+  void ForEachBatch(int64_t begin, int64_t end, Fn fn) const;
+
   /**
    * @tparam Elem_t data type of element
    * @tparam DimValue_t data type of dim's value
@@ -286,6 +295,7 @@ struct BatchElementWiseArg {
   std::vector<DimValue_t> bcast_x_stride_;
   std::vector<DimValue_t> bcast_y_stride_;
   std::vector<DimValue_t> z_stride_;
+  std::vector<DimValue_t> z_dims_;
   std::vector<DimValue_t> element_id_stride_;
 
   /**
@@ -428,8 +438,45 @@ void BatchElementWiseArg<Elem_t, DimValue_t>::Update(
   bcast_x_stride_ = std::move(bcast_x_stride);
   bcast_y_stride_ = std::move(bcast_y_stride);
   z_stride_ = std::vector<DimValue_t>(z_stride, z_stride + dim_size);
+  z_dims_ = std::vector<DimValue_t>(z_dims, z_dims + dim_size);
   element_id_stride_ = std::move(element_id_stride);
 }
+
+template <class Elem_t, class DimValue_t>
+template <class Fn>
+void BatchElementWiseArg<Elem_t, DimValue_t>::ForEachBatch(int64_t begin,
+                                                           int64_t end,
+                                                           Fn fn) const {
+  if (begin >= end) return;
+  // the dims walked by the batches, the rest are inside a batch
+  int outer = dim_size_;
+  while (outer > 0 && element_id_stride_[outer - 1] < continuous_length_) {
+    --outer;
+  }
+  std::vector<int64_t> index(outer, 0);
+  BatchElementWiseArgMemPointer<Elem_t> ptr = {x_data_, y_data_, z_data_};
+  int64_t elem_id = begin * continuous_length_;
+  for (int i = 0; i < outer; ++i) {
+    index[i] = elem_id / element_id_stride_[i];
+    elem_id -= element_id_stride_[i] * index[i];
+    ptr.x_data += bcast_x_stride_[i] * index[i];
+    ptr.y_data += bcast_y_stride_[i] * index[i];
+    ptr.z_data += z_stride_[i] * index[i];
+  }
+  for (int64_t batch_id = begin; batch_id < end; ++batch_id) {
+    fn(ptr);
+    for (int i = outer - 1; i >= 0; --i) {
+      ptr.x_data += bcast_x_stride_[i];
+      ptr.y_data += bcast_y_stride_[i];
+      ptr.z_data += z_stride_[i];
+      if (++index[i] < z_dims_[i]) break;
+      ptr.x_data -= bcast_x_stride_[i] * z_dims_[i];
+      ptr.y_data -= bcast_y_stride_[i] * z_dims_[i];
+      ptr.z_data -= z_stride_[i] * z_dims_[i];
+      index[i] = 0;
+    }
+  }
+}
 template <class Elem_t, class DimValue_t>
 StaticBatchElementWiseArg
 BatchElementWiseArg<Elem_t, DimValue_t>::ToStaticArg() {
@@ -444,34 +491,34 @@ BatchElementWiseArg<Elem_t, DimValue_t>::ToStaticArg() {
   return ret;
 }
 
-template <class T>
+template <class T, class Op>
 void element_wise_one_to_range(const T *x,
                                const T *y,
                                T *z,
                                int64_t range_length,
-                               std::function<T(T, T)> op) {
+                               Op op) {
   for (int64_t i = 0; i < range_length; ++i) {
     z[i] = op(*x, y[i]);
   }
 }
 
-template <class T>
+template <class T, class Op>
 void element_wise_range_to_one(const T *x,
                                const T *y,
                                T *z,
                                int64_t range_length,
-                               std::function<T(T, T)> op) {
+                               Op op) {
   for (int64_t i = 0; i < range_length; ++i) {
     z[i] = op(x[i], *y);
   }
 }
 
-template <class T>
+template <class T, class Op>
 void element_wise_range_to_range(const T *x,
                                  const T *y,
                                  T *z,
                                  int64_t range_length,
-                                 std::function<T(T, T)> op) {
+                                 Op op) {
   for (int64_t i = 0; i < range_length; ++i) {
     z[i] = op(x[i], y[i]);
   }
@@ -588,17 +635,55 @@ void fix_x_y_dims(const Tensor *X,
   }
 }
 
+/**
+ * Merges the adjacent dims which x and y both broadcast the same way, and
+ * drops the dims of size 1, e.g. x_dims=[2,3,4,1,5] and y_dims=[1,1,4,6,5]
+ * become [6,4,1,5] and [1,4,6,5]. The odd broadcast shapes then fall into
+ * a few long batches instead of many short ones.
+ * @note dims must be of the same size, and the tensors stored continuously.
+ */
+template <class DimValue_t>
+void merge_broadcast_dims(std::vector<DimValue_t> *p_x_dims,
+                          std::vector<DimValue_t> *p_y_dims,
+                          std::vector<DimValue_t> *p_z_dims) {
+  auto &x_dims = *p_x_dims;
+  auto &y_dims = *p_y_dims;
+  auto &z_dims = *p_z_dims;
+  size_t size = 0;
+  for (size_t i = 0; i < z_dims.size(); ++i) {
+    if (z_dims[i] == 1) continue;
+    bool x_bcast = x_dims[i] == 1;
+    bool y_bcast = y_dims[i] == 1;
+    if (size > 0 && (x_dims[size - 1] == 1) == x_bcast &&
+        (y_dims[size - 1] == 1) == y_bcast) {
+      x_dims[size - 1] *= x_dims[i];
+      y_dims[size - 1] *= y_dims[i];
+      z_dims[size - 1] *= z_dims[i];
+      continue;
+    }
+    x_dims[size] = x_dims[i];
+    y_dims[size] = y_dims[i];
+    z_dims[size] = z_dims[i];
+    ++size;
+  }
+  size = std::max<size_t>(size, 1);
+  x_dims.resize(size, 1);
+  y_dims.resize(size, 1);
+  z_dims.resize(size, 1);
+}
+
 template <class T>
 BatchElementWiseArg<T, int64_t> GenBatchElementWiseArg(const lite::Tensor *X,
                                                        const lite::Tensor *Y,
                                                        lite::Tensor *Out,
                                                        int axis = -1) {
-  int out_dim_size = Out->dims().size();
   std::vector<int64_t> x_dims;
   std::vector<int64_t> y_dims;
   fix_x_y_dims<int64_t>(X, Y, Out, axis, &x_dims, &y_dims);
+  std::vector<int64_t> z_dims = Out->dims().Vectorize();
+  merge_broadcast_dims(&x_dims, &y_dims, &z_dims);
+  int out_dim_size = z_dims.size();
 
-  auto &z_dims = Out->dims().data();
   // gen stride
   std::vector<int64_t> x_stride(out_dim_size, 1);
   std::vector<int64_t> y_stride(out_dim_size, 1);
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "lite/kernels/host/gather_compute.h"
+#include "lite/backends/host/math/gather.h"
 #include <vector>
 
 namespace paddle {
@@ -27,16 +28,12 @@ void GatherFunc(const operators::GatherParam& param) {
   const IndexType* p_index = param.Index->data<IndexType>();
   auto* p_output = param.Out->mutable_data<DataType>();
 
-  int slice_size = 1;
+  int64_t slice_size = 1;
   for (size_t i = 1; i < src_dims.size(); ++i) {
     slice_size *= src_dims[i];
   }
-  for (int i = 0; i < index_size; ++i) {
-    IndexType index_ = p_index[i];
-    memcpy(p_output + i * slice_size,
-           p_src + index_ * slice_size,
-           slice_size * sizeof(DataType));
-  }
+  lite::host::math::GatherSlices(
+      p_src, p_index, p_output, 1, src_dims[0], index_size, slice_size);
 }
 
 template <typename IndexType, typename AxisType, typename DataType>
@@ -46,35 +43,23 @@ void GatherV2Func(const operators::GatherParam& param) {
   auto* out_data = param.Out->mutable_data<DataType>();
 
   int index_size = param.Index->numel();
-  int input_size = param.X->numel();
   auto input_dim = param.X->dims();
   int axis_index = param.Axis ? param.Axis->data<AxisType>()[0] : param.axis;
-  int inner_dim_size = 1;
-  int outer_dim_size = 1;
   int input_index_dim_size = input_dim[axis_index];
   for (int i = 0; i < index_size; i++) {
     CHECK_LT(index_data[i], input_index_dim_size)
         << "The element of Index must be less than the size of"
         << "dim size of axis dim";
   }
-  for (int i = 0; i < axis_index; i++) {
-    inner_dim_size *= input_dim[i];
-  }
-  for (size_t i = axis_index + 1; i < input_dim.size(); i++) {
-    outer_dim_size *= input_dim[i];
-  }
-
-  int out_index = 0;
-  for (int i = 0; i < inner_dim_size; i++) {
-    for (int j = 0; j < index_size; j++) {
-      for (int k = 0; k < outer_dim_size; k++) {
-        int index = k + index_data[j] * outer_dim_size +
-                    (i * input_size / inner_dim_size);
-        out_data[out_index] = input_data[index];
-        out_index++;
-      }
-    }
-  }
+  int64_t outer_size = input_dim.count(0, axis_index);
+  int64_t inner_size = input_dim.count(axis_index + 1, input_dim.size());
+  lite::host::math::GatherSlices(input_data,
+                                 index_data,
+                                 out_data,
+                                 outer_size,
+                                 input_index_dim_size,
+                                 index_size,
+                                 inner_size);
 }
 
 template <typename IndexType, typename AxisType>
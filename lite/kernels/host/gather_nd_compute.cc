@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "lite/kernels/host/gather_nd_compute.h"
+#include <algorithm>
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
@@ -42,17 +44,28 @@ void GatherNd(const Tensor& x, const Tensor& index, Tensor* out) {
   }
   const size_t gather_bytes = gather_size * sizeof(DataT);
 
-  for (int64_t i = 0; i < gather_time; i++) {
-    int64_t x_index = 0;
-    int64_t step = 1;
-    for (int64_t j = end_size - 1; j >= 0; j--) {
-      x_index += (index_data[i * end_size + j] * step);
-      step *= x_dims[j];
+  // the gathers split into the tasks of about 16KB
+  int64_t step =
+      std::max<int64_t>(1, 16384 / std::max<size_t>(gather_bytes, 1));
+  int task_num = static_cast<int>((gather_time + step - 1) / step);
+  LITE_PARALLEL_BEGIN(t, tid, task_num) {
+    int64_t end = std::min((t + 1) * step, gather_time);
+    for (int64_t i = t * step; i < end; i++) {
+      const IndexT* index_i = index_data + i * end_size;
+      int64_t x_index = 0;
+      for (int64_t j = 0; j < end_size; j++) {
+        x_index = x_index * x_dims[j] + index_i[j];
+      }
+      if (gather_size == 1) {
+        out_data[i] = x_data[x_index];
+      } else {
+        memcpy(out_data + i * gather_size,
+               x_data + x_index * gather_size,
+               gather_bytes);
+      }
     }
-    memcpy(out_data, x_data + x_index * gather_size, gather_bytes);
-    out_data += gather_size;
   }
-  return;
+  LITE_PARALLEL_END();
 }
 
 void GatherNdCompute::Run() {
@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "lite/core/op_registry.h"
+#include "lite/core/parallel_defines.h"
 #include "lite/core/tensor.h"
 #include "lite/core/type_system.h"
 
@@ -92,11 +93,11 @@ static std::pair<Tensor, Tensor> ProposalForOneImage(
     scores_filter.Resize(std::vector<int64_t>({1, 1}));
     bbox_sel.Resize(std::vector<int64_t>({1, 4}));
     auto *scores_filter_data = scores_filter.mutable_data<float>();
-    for (size_t i = 0; i < scores_filter.numel(); i++) {
+    for (int64_t i = 0; i < scores_filter.numel(); i++) {
       scores_filter_data[i] = 0;
     }
     auto *bbox_sel_data = bbox_sel.mutable_data<float>();
-    for (size_t i = 0; i < scores_filter.numel(); i++) {
+    for (int64_t i = 0; i < scores_filter.numel(); i++) {
       bbox_sel_data[i] = 0;
     }
     return std::make_pair(bbox_sel, scores_filter);
@@ -167,8 +168,9 @@ void GenerateProposalsV2Compute::Run() {
   std::vector<int64_t> tmp_lod;
   std::vector<int64_t> tmp_num;
 
-  int64_t num_proposals = 0;
-  for (int64_t i = 0; i < num; ++i) {
+  // The images run in parallel, and their proposals are appended in order.
+  std::vector<std::pair<Tensor, Tensor>> image_proposals(num);
+  LITE_PARALLEL_BEGIN(i, tid, num) {
     Tensor im_shape_slice = im_shape->Slice<float>(i, i + 1);
     Tensor bbox_deltas_slice = bbox_deltas_swap.Slice<float>(i, i + 1);
     Tensor scores_slice = scores_swap.Slice<float>(i, i + 1);
@@ -176,20 +178,24 @@ void GenerateProposalsV2Compute::Run() {
     bbox_deltas_slice.Resize(
         std::vector<int64_t>({c_bbox * h_bbox * w_bbox / 4, 4}));
     scores_slice.Resize(std::vector<int64_t>({c_score * h_score * w_score, 1}));
-    std::pair<Tensor, Tensor> tensor_pair =
-        ProposalForOneImage(im_shape_slice,
-                            *anchors,
-                            *variances,
-                            bbox_deltas_slice,
-                            scores_slice,
-                            pre_nms_top_n,
-                            post_nms_top_n,
-                            nms_thresh,
-                            min_size,
-                            eta,
-                            pixel_offset);
-    Tensor &proposals = tensor_pair.first;
-    Tensor &scores = tensor_pair.second;
+    image_proposals[i] = ProposalForOneImage(im_shape_slice,
+                                             *anchors,
+                                             *variances,
+                                             bbox_deltas_slice,
+                                             scores_slice,
+                                             pre_nms_top_n,
+                                             post_nms_top_n,
+                                             nms_thresh,
+                                             min_size,
+                                             eta,
+                                             pixel_offset);
+  }
+  LITE_PARALLEL_END();
+
+  int64_t num_proposals = 0;
+  for (int64_t i = 0; i < num; ++i) {
+    Tensor &proposals = image_proposals[i].first;
+    Tensor &scores = image_proposals[i].second;
     lite::host::math::AppendTensor<float>(
         rpn_rois, 4 * num_proposals, proposals);
     lite::host::math::AppendTensor<float>(rpn_roi_probs, num_proposals, scores);
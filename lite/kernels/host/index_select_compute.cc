@@ -15,6 +15,7 @@
 #include "lite/kernels/host/index_select_compute.h"
 #include <string>
 #include <vector>
+#include "lite/backends/host/math/gather.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/tensor.h"
 #include "lite/core/type_system.h"
@@ -43,13 +44,8 @@ void Index_selectCompute<T>::Run() {
   const int64_t* index_ptr = index->data<int64_t>();
   T* out_ptr = output->mutable_data<T>();
 
-  for (int i = 0; i < left; i++)
-    for (int k = 0; k < index_ddim.production(); k++)
-      for (int j = 0; j < right; j++)
-        out_ptr[i * index_ddim.production() * right + k * right + j] =
-            in_ptr[i * middle * right + index_ptr[k] * right + j];
-
-  return;
+  lite::host::math::GatherSlices(
+      in_ptr, index_ptr, out_ptr, left, middle, index_ddim.production(), right);
 }
 
 }  // namespace host
@@ -0,0 +1,65 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/host/kv_cache_append_compute.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace host {
+
+void KVCacheAppendCompute::Run() {
+  auto& param = this->Param<param_t>();
+  auto* cache = param.cache;
+  if (param.step) {
+    int64_t step = param.step->precision() == PRECISION(kInt32)
+                       ? param.step->data<int32_t>()[0]
+                       : param.step->data<int64_t>()[0];
+    if (step == 0) cache->Reset();
+  }
+  if (param.beam_idx) {
+    cache->Reorder(param.beam_idx->data<int>(), param.beam_idx->numel());
+  }
+  cache->Append(*param.k, *param.v);
+}
+
+}  // namespace host
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(kv_cache_append,
+                     kHost,
+                     kFloat,
+                     kAny,
+                     paddle::lite::kernels::host::KVCacheAppendCompute,
+                     def)
+    .BindInput("K",
+               {LiteType::GetTensorTy(TARGET(kHost),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kAny))})
+    .BindInput("V",
+               {LiteType::GetTensorTy(TARGET(kHost),
+                                      PRECISION(kFloat),
+                                      DATALAYOUT(kAny))})
+    .BindInput("BeamIdx",
+               {LiteType::GetTensorTy(TARGET(kHost),
+                                      PRECISION(kInt32),
+                                      DATALAYOUT(kAny))})
+    .BindInput("Step",
+               {LiteType::GetTensorTy(TARGET(kHost),
+                                      PRECISION(kAny),
+                                      DATALAYOUT(kAny))})
+    .BindOutput("Cache", {LiteType::GetKVCacheTy()})
+    .Finalize();
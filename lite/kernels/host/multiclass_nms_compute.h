@@ -20,6 +20,7 @@
 #include "lite/backends/host/math/nms_util.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
+#include "lite/core/parallel_defines.h"
 namespace paddle {
 namespace lite {
 namespace kernels {
@@ -81,41 +82,37 @@ void NMSFast(const Tensor& bbox,
       scores_data, score_threshold, top_k, &sorted_indices);
 
   selected_indices->clear();
-  T adaptive_threshold = nms_threshold;
   const T* bbox_data = bbox.data<T>();
+  // 4: [xmin ymin xmax ymax]
+  if (box_size == 4) {
+    lite::host::math::NMSBoxes(bbox_data,
+                               sorted_indices,
+                               nms_threshold,
+                               eta,
+                               normalized,
+                               selected_indices);
+    return;
+  }
 
-  while (sorted_indices.size() != 0) {
-    const int idx = sorted_indices.front().second;
+  T adaptive_threshold = nms_threshold;
+  for (auto& score_index : sorted_indices) {
+    const int idx = score_index.second;
     bool keep = true;
-    for (size_t k = 0; k < selected_indices->size(); ++k) {
-      if (keep) {
+    // 8: [x1 y1 x2 y2 x3 y3 x4 y4] or 16, 24, 32
+    if (box_size == 8 || box_size == 16 || box_size == 24 || box_size == 32) {
+      for (size_t k = 0; keep && k < selected_indices->size(); ++k) {
         const int kept_idx = (*selected_indices)[k];
-        T overlap = T(0.);
-        // 4: [xmin ymin xmax ymax]
-        if (box_size == 4) {
-          overlap = lite::host::math::JaccardOverlap<T>(
-              bbox_data + idx * box_size,
-              bbox_data + kept_idx * box_size,
-              normalized);
-        }
-        // 8: [x1 y1 x2 y2 x3 y3 x4 y4] or 16, 24, 32
-        if (box_size == 8 || box_size == 16 || box_size == 24 ||
-            box_size == 32) {
-          overlap =
-              lite::host::math::PolyIoU<T>(bbox_data + idx * box_size,
-                                           bbox_data + kept_idx * box_size,
-                                           box_size,
-                                           normalized);
-        }
+        T overlap =
+            lite::host::math::PolyIoU<T>(bbox_data + idx * box_size,
+                                         bbox_data + kept_idx * box_size,
+                                         box_size,
+                                         normalized);
         keep = overlap <= adaptive_threshold;
-      } else {
-        break;
       }
     }
     if (keep) {
       selected_indices->push_back(idx);
     }
-    sorted_indices.erase(sorted_indices.begin());
     if (keep && eta < 1 && adaptive_threshold > 0.5) {
       adaptive_threshold *= eta;
     }
@@ -140,35 +137,44 @@ void MultiClassNMS(const operators::MulticlassNmsParam& param,
   int num_det = 0;
 
   int64_t class_num = scores_size == 3 ? scores.dims()[0] : scores.dims()[1];
-  Tensor bbox_slice, score_slice;
+  // The classes are suppressed in parallel.
+  std::vector<std::vector<int>> class_indices(class_num);
+  LITE_PARALLEL_BEGIN(c, tid, class_num) {
+    if (c != background_label) {
+      Tensor bbox_slice, score_slice;
+      if (scores_size == 3) {
+        score_slice = scores.Slice<T>(c, c + 1);
+        bbox_slice = bboxes;
+      } else {
+        score_slice.Resize({scores.dims()[0], 1});
+        bbox_slice.Resize({scores.dims()[0], 4});
+        SliceOneClass<T>(scores, c, &score_slice);
+        SliceOneClass<T>(bboxes, c, &bbox_slice);
+      }
+      NMSFast(bbox_slice,
+              score_slice,
+              score_threshold,
+              nms_threshold,
+              nms_eta,
+              nms_top_k,
+              &class_indices[c],
+              normalized);
+      if (scores_size == 2) {
+        std::stable_sort(class_indices[c].begin(), class_indices[c].end());
+      }
+    }
+  }
+  LITE_PARALLEL_END();
   for (int64_t c = 0; c < class_num; ++c) {
     if (c == background_label) continue;
-    if (scores_size == 3) {
-      score_slice = scores.Slice<T>(c, c + 1);
-      bbox_slice = bboxes;
-    } else {
-      score_slice.Resize({scores.dims()[0], 1});
-      bbox_slice.Resize({scores.dims()[0], 4});
-      SliceOneClass<T>(scores, c, &score_slice);
-      SliceOneClass<T>(bboxes, c, &bbox_slice);
-    }
-    NMSFast(bbox_slice,
-            score_slice,
-            score_threshold,
-            nms_threshold,
-            nms_eta,
-            nms_top_k,
-            &((*indices)[c]),
-            normalized);
-    if (scores_size == 2) {
-      std::stable_sort((*indices)[c].begin(), (*indices)[c].end());
-    }
+    (*indices)[c].swap(class_indices[c]);
     num_det += (*indices)[c].size();
   }
 
   *num_nmsed_out = num_det;
   const T* scores_data = scores.data<T>();
   if (keep_top_k > -1 && num_det > keep_top_k) {
+    Tensor score_slice;
     const T* sdata;
     std::vector<std::pair<T, std::pair<int, int>>> score_index_pairs;
     for (const auto& it : *indices) {
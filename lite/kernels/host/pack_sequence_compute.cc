@@ -0,0 +1,122 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/host/pack_sequence_compute.h"
+#include <algorithm>
+#include <cstring>
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace host {
+
+void PackSequenceCompute::Run() {
+  auto& param = this->Param<param_t>();
+  const auto* x = param.x;
+  auto* out = param.out;
+  const auto& x_dims = x->dims();
+  int64_t batch = x_dims[0];
+  int64_t seq = x_dims[1];
+  size_t elem_size = PrecisionTypeLength(x->precision());
+  size_t row_size = x_dims.count(2, x_dims.size()) * elem_size;
+  int* cu_seqlens = param.cu_seqlens->mutable_data<int>();
+  const char* x_data = static_cast<const char*>(x->raw_data());
+  out->set_precision(x->precision());
+  char* out_data = static_cast<char*>(
+      out->mutable_data(TARGET(kHost), out->numel() * elem_size));
+  cu_seqlens[0] = 0;
+  for (int64_t i = 0; i < batch; i++) {
+    int64_t len = param.seq_len->precision() == PRECISION(kInt32)
+                      ? param.seq_len->data<int32_t>()[i]
+                      : param.seq_len->data<int64_t>()[i];
+    len = std::max<int64_t>(0, std::min(len, seq));
+    // The valid rows of a sequence are contiguous.
+    memcpy(out_data + cu_seqlens[i] * row_size,
+           x_data + i * seq * row_size,
+           len * row_size);
+    cu_seqlens[i + 1] = cu_seqlens[i] + static_cast<int>(len);
+  }
+}
+
+void UnpackSequenceCompute::Run() {
+  auto& param = this->Param<param_t>();
+  const auto* x = param.x;
+  auto* out = param.out;
+  const auto& out_dims = out->dims();
+  int64_t batch = out_dims[0];
+  int64_t length = out_dims[1];
+  size_t row_size = out_dims.count(2, out_dims.size()) *
+                    PrecisionTypeLength(x->precision());
+  const int* cu_seqlens = param.cu_seqlens->data<int>();
+  const char* x_data = static_cast<const char*>(x->raw_data());
+  out->set_precision(x->precision());
+  char* out_data = static_cast<char*>(
+      out->mutable_data(TARGET(kHost), batch * length * row_size));
+  for (int64_t i = 0; i < batch; i++) {
+    int64_t len =
+        std::min<int64_t>(cu_seqlens[i + 1] - cu_seqlens[i], length);
+    char* out_i = out_data + i * length * row_size;
+    memcpy(out_i, x_data + cu_seqlens[i] * row_size, len * row_size);
+    memset(out_i + len * row_size, 0, (length - len) * row_size);
+  }
+}
+
+}  // namespace host
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(pack_sequence,
+                     kHost,
+                     kAny,
+                     kAny,
+                     paddle::lite::kernels::host::PackSequenceCompute,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kHost),
+                                      PRECISION(kAny),
+                                      DATALAYOUT(kAny))})
+    .BindInput("SeqLen",
+               {LiteType::GetTensorTy(TARGET(kHost),
+                                      PRECISION(kAny),
+                                      DATALAYOUT(kAny))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kHost),
+                                       PRECISION(kAny),
+                                       DATALAYOUT(kAny))})
+    .BindOutput("CuSeqlens",
+                {LiteType::GetTensorTy(TARGET(kHost),
+                                       PRECISION(kInt32),
+                                       DATALAYOUT(kAny))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(unpack_sequence,
+                     kHost,
+                     kAny,
+                     kAny,
+                     paddle::lite::kernels::host::UnpackSequenceCompute,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kHost),
+                                      PRECISION(kAny),
+                                      DATALAYOUT(kAny))})
+    .BindInput("CuSeqlens",
+               {LiteType::GetTensorTy(TARGET(kHost),
+                                      PRECISION(kInt32),
+                                      DATALAYOUT(kAny))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kHost),
+                                       PRECISION(kAny),
+                                       DATALAYOUT(kAny))})
+    .Finalize();
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "lite/kernels/host/sequence_expand_compute.h"
+#include <cstring>
+#include <numeric>
 #include <vector>
 
 namespace paddle {
@@ -39,13 +41,12 @@ void SequenceExpandFunc(const Tensor& x,
       if (out->lod().size() == 1) {
         out_start = out->lod()[0][out_offset];
       }
+      // a sequence is a contiguous block of rows
+      const T* src = x_data + x_start * x_item_length;
+      T* dst = out_data + out_start * x_item_length;
+      size_t seq_size = x_seq_len * x_item_length;
       for (uint64_t j = 0; j < repeat_num; j++) {
-        for (uint64_t k = 0; k < x_seq_len; k++) {
-          for (int l = 0; l < x_item_length; l++) {
-            out_data[(out_start + j * x_seq_len + k) * x_item_length + l] =
-                x_data[(x_start + k) * x_item_length + l];
-          }
-        }
+        std::memcpy(dst + j * seq_size, src, seq_size * sizeof(T));
       }
     }
     out_offset += repeat_num;
@@ -59,8 +60,8 @@ void SequenceExpandCompute<T, PType>::Run() {
   auto* y = param.Y;
   auto* out = param.Out;
   int ref_level = param.ref_level;
-  auto x_lod = x->lod();
-  auto y_lod = y->lod();
+  const auto& x_lod = x->lod();
+  const auto& y_lod = y->lod();
 
   if (ref_level == -1) ref_level = y_lod.size() - 1;
 
@@ -89,15 +90,13 @@ void SequenceExpandCompute<T, PType>::Run() {
     ref_lod[0] = out_lod;
   }
 
-  std::vector<uint64_t> ref_x_lod;
-  if (x->lod().size() == 1) {
-    ref_x_lod = x->lod()[0];
+  if (x_lod.size() == 1) {
+    SequenceExpandFunc<T>(*x, x_lod[0], y_lod[ref_level], out);
   } else {
-    ref_x_lod.resize(x->dims()[0] + 1);
+    std::vector<uint64_t> ref_x_lod(x->dims()[0] + 1);
     std::iota(ref_x_lod.begin(), ref_x_lod.end(), 0);
+    SequenceExpandFunc<T>(*x, ref_x_lod, y_lod[ref_level], out);
   }
-
-  SequenceExpandFunc<T>(*x, ref_x_lod, y_lod[ref_level], out);
 }
 
 }  // namespace host
@@ -38,6 +38,24 @@ void SplitCompute<T, PType>::Run() {
     axis += static_cast<int>(param.x->dims().size());
   }
 
+#ifndef LITE_WITH_FPGA
+  // With nothing outside axis the outputs are contiguous slices of the input
+  // and are handed out as views of them.
+  if (param.zero_copy && in_dim.count(0, axis) == 1) {
+    size_t offset = param.x->offset();
+    for (auto* out : dout) {
+      size_t size = out->numel() * sizeof(T);
+      out->ShareBufferWith(*param.x, offset, size);
+      offset += size;
+    }
+    return;
+  }
+  // The views of the last run would write into the input.
+  for (auto* out : dout) {
+    if (out->IsView()) out->DetachBuffer();
+  }
+#endif
+
   lite::host::math::split(din, dout, axis, in_strides);
 }
 
@@ -15,6 +15,7 @@
 #include "lite/kernels/host/while_compute.h"
 #include <unordered_map>
 #include <utility>
+#include "lite/core/run_control.h"
 #ifdef LITE_WITH_XPU
 #include "lite/backends/xpu/target_wrapper.h"
 #include "lite/backends/xpu/xpu_header_sitter.h"
@@ -56,7 +57,8 @@ void WhileCompute::PrepareForRun() {
 void WhileCompute::Run() {
   auto &param = this->Param<param_t>();
   auto cond = param.cond;
-  while (GetCondData(cond)) {
+  // The condition is not updated by the iterations of a stopped run.
+  while (GetCondData(cond) && !RunStopped()) {
     program_->Run();
   }
 }
@@ -0,0 +1,277 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/host/yolo_box_nms_compute.h"
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+#include "lite/backends/host/math/nms_util.h"
+#include "lite/backends/host/math/yolo_box.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace host {
+
+// The boxes of an image decoded from the heads, only the ones whose
+// confidence passes conf_thresh. The others are zeros in the outputs of
+// yolo_box, which never pass the score threshold of the nms.
+struct DecodedBoxes {
+  // [xmin ymin xmax ymax] of the rows
+  std::vector<float> boxes;
+  // the scores of the classes of the rows
+  std::vector<float> scores;
+  // the indices of the rows in the boxes concatenated from the heads
+  std::vector<int> ids;
+  // the (score, row) of each class above score_threshold
+  std::vector<std::vector<std::pair<float, int>>> candidates;
+};
+
+static void DecodeBoxes(const operators::YoloBoxNmsParam& param,
+                        int n,
+                        DecodedBoxes* decoded) {
+  const int class_num = param.class_num;
+  const int* img_size = param.ImgSize->data<int>();
+  const int img_height = img_size[2 * n];
+  const int img_width = img_size[2 * n + 1];
+  decoded->candidates.assign(class_num, {});
+  const int* anchors = param.anchors.data();
+  int id_offset = 0;
+  float box[4];
+  for (size_t i = 0; i < param.X.size(); i++) {
+    const float* x_data = param.X[i]->data<float>();
+    const int h = param.X[i]->dims()[2];
+    const int w = param.X[i]->dims()[3];
+    const int an_num = param.anchor_nums[i];
+    const int input_size = param.downsample_ratios[i] * h;
+    const int stride = h * w;
+    const int an_stride = (class_num + 5) * stride;
+    const float scale = param.scales_x_y[i];
+    const float bias = static_cast<float>(-0.5 * (scale - 1.));
+    for (int j = 0; j < an_num; j++) {
+      for (int k = 0; k < h; k++) {
+        for (int l = 0; l < w; l++) {
+          int obj_idx = lite::host::math::GetEntryIndex(
+              n, j, k * w + l, an_num, an_stride, stride, 4);
+          float conf = lite::host::math::Sigmoid(x_data[obj_idx]);
+          if (conf < param.conf_thresh) continue;
+
+          int box_idx = lite::host::math::GetEntryIndex(
+              n, j, k * w + l, an_num, an_stride, stride, 0);
+          lite::host::math::GetYoloBox(box,
+                                       x_data,
+                                       anchors,
+                                       l,
+                                       k,
+                                       j,
+                                       h,
+                                       input_size,
+                                       box_idx,
+                                       stride,
+                                       img_height,
+                                       img_width,
+                                       scale,
+                                       bias);
+          const int row = static_cast<int>(decoded->ids.size());
+          decoded->boxes.resize(decoded->boxes.size() + 4);
+          lite::host::math::CalcDetectionBox(decoded->boxes.data(),
+                                             box,
+                                             row * 4,
+                                             img_height,
+                                             img_width,
+                                             param.clip_bbox);
+          decoded->ids.push_back(id_offset + j * stride + k * w + l);
+
+          int label_idx = lite::host::math::GetEntryIndex(
+              n, j, k * w + l, an_num, an_stride, stride, 5);
+          decoded->scores.resize(decoded->scores.size() + class_num);
+          lite::host::math::CalcLabelScore(decoded->scores.data(),
+                                           x_data,
+                                           label_idx,
+                                           row * class_num,
+                                           class_num,
+                                           conf,
+                                           stride);
+          for (int c = 0; c < class_num; c++) {
+            float score = decoded->scores[row * class_num + c];
+            if (c != param.background_label && score > param.score_threshold) {
+              decoded->candidates[c].emplace_back(score, row);
+            }
+          }
+        }
+      }
+    }
+    anchors += 2 * an_num;
+    id_offset += an_num * stride;
+  }
+}
+
+// The multiclass_nms of the decoded boxes, the rows kept for each class.
+static std::map<int, std::vector<int>> MultiClassNMS(
+    const operators::YoloBoxNmsParam& param, DecodedBoxes* decoded) {
+  const int class_num = param.class_num;
+  std::vector<std::vector<int>> class_indices(class_num);
+  LITE_PARALLEL_BEGIN(c, tid, class_num) {
+    if (c != param.background_label) {
+      // The rows are in the order of the indices, so are the ties.
+      auto& sorted_indices = decoded->candidates[c];
+      auto descend = [](const std::pair<float, int>& a,
+                        const std::pair<float, int>& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+      };
+      const int top_k = param.nms_top_k;
+      if (top_k > -1 && top_k < static_cast<int>(sorted_indices.size())) {
+        std::partial_sort(sorted_indices.begin(),
+                          sorted_indices.begin() + top_k,
+                          sorted_indices.end(),
+                          descend);
+        sorted_indices.resize(top_k);
+      } else {
+        std::sort(sorted_indices.begin(), sorted_indices.end(), descend);
+      }
+      lite::host::math::NMSBoxes(decoded->boxes.data(),
+                                 sorted_indices,
+                                 param.nms_threshold,
+                                 param.nms_eta,
+                                 param.normalized,
+                                 &class_indices[c]);
+    }
+  }
+  LITE_PARALLEL_END();
+
+  std::map<int, std::vector<int>> indices;
+  int num_det = 0;
+  for (int c = 0; c < class_num; c++) {
+    if (c == param.background_label) continue;
+    indices[c].swap(class_indices[c]);
+    num_det += indices[c].size();
+  }
+  if (param.keep_top_k > -1 && num_det > param.keep_top_k) {
+    std::vector<std::pair<float, std::pair<int, int>>> score_index_pairs;
+    for (const auto& it : indices) {
+      for (int row : it.second) {
+        score_index_pairs.push_back(
+            std::make_pair(decoded->scores[row * class_num + it.first],
+                           std::make_pair(it.first, row)));
+      }
+    }
+    // Keep top k results per image.
+    std::stable_sort(
+        score_index_pairs.begin(),
+        score_index_pairs.end(),
+        lite::host::math::SortScorePairDescend<std::pair<int, int>>);
+    score_index_pairs.resize(param.keep_top_k);
+    std::map<int, std::vector<int>> new_indices;
+    for (const auto& pair : score_index_pairs) {
+      new_indices[pair.second.first].push_back(pair.second.second);
+    }
+    new_indices.swap(indices);
+  }
+  return indices;
+}
+
+void YoloBoxNmsCompute::Run() {
+  auto& param = Param<operators::YoloBoxNmsParam>();
+  const int batch_size = param.X[0]->dims()[0];
+  const int class_num = param.class_num;
+  // The boxes of an image concatenated from the heads.
+  int num_boxes = 0;
+  for (size_t i = 0; i < param.X.size(); i++) {
+    auto x_dims = param.X[i]->dims();
+    num_boxes += param.anchor_nums[i] * x_dims[2] * x_dims[3];
+  }
+
+  // label, score, xmin, ymin, xmax, ymax
+  const int64_t out_dim = 6;
+  std::vector<float> detections;
+  std::vector<int> indices;
+  std::vector<uint64_t> batch_starts = {0};
+  for (int n = 0; n < batch_size; n++) {
+    DecodedBoxes decoded;
+    DecodeBoxes(param, n, &decoded);
+    auto selected = MultiClassNMS(param, &decoded);
+    for (const auto& it : selected) {
+      for (int row : it.second) {
+        detections.push_back(it.first);
+        detections.push_back(decoded.scores[row * class_num + it.first]);
+        detections.insert(detections.end(),
+                          decoded.boxes.begin() + row * 4,
+                          decoded.boxes.begin() + row * 4 + 4);
+        indices.push_back(n * num_boxes + decoded.ids[row]);
+      }
+    }
+    batch_starts.push_back(indices.size());
+  }
+
+  // The same outputs as multiclass_nms.
+  auto* outs = param.Out;
+  auto* index = param.Index;
+  uint64_t num_kept = batch_starts.back();
+  if (num_kept == 0) {
+    if (index) {
+      outs->Resize({0, out_dim});
+      index->Resize({0, 1});
+    } else {
+      outs->Resize({1, 1});
+      outs->mutable_data<float>()[0] = -1;
+      batch_starts = {0, 1};
+    }
+  } else {
+    outs->Resize({static_cast<int64_t>(num_kept), out_dim});
+    std::copy(
+        detections.begin(), detections.end(), outs->mutable_data<float>());
+    if (index) {
+      index->Resize({static_cast<int64_t>(num_kept), 1});
+      std::copy(indices.begin(), indices.end(), index->mutable_data<int>());
+    }
+  }
+
+  if (param.NmsRoisNum) {
+    param.NmsRoisNum->Resize({batch_size});
+    int* num_data = param.NmsRoisNum->mutable_data<int>();
+    for (int i = 1; i <= batch_size; i++) {
+      num_data[i - 1] = batch_starts[i] - batch_starts[i - 1];
+    }
+  }
+
+  LoD lod;
+  lod.emplace_back(batch_starts);
+  if (index) {
+    index->set_lod(lod);
+  }
+  outs->set_lod(lod);
+}
+
+}  // namespace host
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fusion_yolo_box_nms,
+                     kHost,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::host::YoloBoxNmsCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kFloat))})
+    .BindInput("ImgSize",
+               {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kInt32))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Index",
+                {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kInt32))})
+    .BindOutput("NmsRoisNum",
+                {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kInt32))})
+    .Finalize();
@@ -1,11 +1,13 @@
 // Copyright (c) 2019 Cambricon Authors. All Rights Reserved.
 
 #include <Eigen/Core>
+#include <memory>
 #include "lite/backends/mlu/target_wrapper.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/type_system.h"
+#include "lite/utils/env.h"
 
 namespace paddle {
 namespace lite {
@@ -24,6 +26,27 @@ void CopyToHostSync(void* target, const void* source, size_t size) {
   TargetW::MemcpySync(target, source, size, IoDirection::DtoH);
 }
 
+// With LITE_MLU_IO_PIPELINE, the copies run on the io queue and the exec
+// queue waits on the notifiers, instead of blocking the host for each copy.
+bool MluIoPipelineEnabled() {
+  static bool enabled = GetBoolFromEnv("LITE_MLU_IO_PIPELINE");
+  return enabled;
+}
+
+// The notifier for the io queue and the exec queue waiting on each other.
+class MluQueueNotifier {
+ public:
+  MluQueueNotifier() { TargetW::CreateNotifier(&notifier_); }
+  ~MluQueueNotifier() { TargetW::DestroyNotifier(&notifier_); }
+  void Wait(const TargetW::queue_t& queue,
+            const TargetW::queue_t& notifier_queue) {
+    TargetW::QueueWaitNotifier(queue, notifier_, notifier_queue);
+  }
+
+ private:
+  TargetW::notifier_t notifier_;
+};
+
 /*
  * This kernel copies a tensor from host to MLU space.
  */
@@ -44,6 +67,22 @@ class IoCopyHostToMluCompute
     VLOG(6) << "io_copy host to mlu] memory size: " << mem_size
             << " precision type: " << PrecisionToStr(Precision);
     param.y->set_precision(param.x->precision());
+    if (MluIoPipelineEnabled()) {
+      auto& mlu_context = this->ctx_->template As<MLUContext>();
+      if (!exec_notifier_) {
+        exec_notifier_.reset(new MluQueueNotifier);
+        io_notifier_.reset(new MluQueueNotifier);
+      }
+      // the work of the exec queue may still read the output
+      exec_notifier_->Wait(mlu_context.io_queue(), mlu_context.exec_queue());
+      TargetW::MemcpyAsync(data,
+                           param.x->raw_data(),
+                           mem_size,
+                           IoDirection::HtoD,
+                           mlu_context.io_queue());
+      io_notifier_->Wait(mlu_context.exec_queue(), mlu_context.io_queue());
+      return;
+    }
     CopyFromHostSync(data, param.x->raw_data(), mem_size);
   }
 
@@ -68,6 +107,10 @@ class IoCopyHostToMluCompute
   }
 
   std::string doc() const override { return "Copy IO from HOST to MLU"; }
+
+ private:
+  std::unique_ptr<MluQueueNotifier> exec_notifier_;
+  std::unique_ptr<MluQueueNotifier> io_notifier_;
 };
 
 /*
@@ -85,14 +128,30 @@ class IoCopyMluToHostCompute
     VLOG(6) << "io_copy mlu to host] memory size: " << mem_size
             << " precision type: " << PrecisionToStr(Precision);
 
-    // sync queue to ensure process done
     auto& mlu_context = this->ctx_->template As<MLUContext>();
+    if (MluIoPipelineEnabled()) {
+      // the io queue waits for the process, the exec queue goes on
+      if (!notifier_) notifier_.reset(new MluQueueNotifier);
+      notifier_->Wait(mlu_context.io_queue(), mlu_context.exec_queue());
+      TargetW::MemcpyAsync(data,
+                           param.x->raw_data(),
+                           mem_size,
+                           IoDirection::DtoH,
+                           mlu_context.io_queue());
+      CNRT_CALL(cnrtSyncQueue(mlu_context.io_queue()));
+      return;
+    }
+
+    // sync queue to ensure process done
     CNRT_CALL(cnrtSyncQueue(mlu_context.exec_queue()));
 
     CopyToHostSync(data, param.x->raw_data(), mem_size);
   }
 
   std::string doc() const override { return "Copy IO from MLU to HOST"; }
+
+ private:
+  std::unique_ptr<MluQueueNotifier> notifier_;
 };
 
 }  // namespace mlu
@@ -15,8 +15,13 @@
 #include "lite/kernels/nnadapter/engine.h"
 #include <sys/time.h>
 #include <time.h>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
 #include <utility>
+#include "lite/core/device_info.h"
 #include "lite/core/op_registry.h"
+#include "lite/core/runtime_stats.h"
 #include "lite/kernels/nnadapter/converter/converter.h"
 #include "lite/utils/env.h"
 #include "lite/utils/md5.h"
@@ -226,6 +231,13 @@ int Program::Execute() {
   return NNADAPTER_NO_ERROR;
 }
 
+// The device compilers are not guaranteed to be thread safe, so the programs
+// built in the background are built one by one.
+static std::mutex& BuildMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
 Engine::Engine(KernelContext* ctx,
                const cpp::BlockDesc* block_desc,
                Scope* exec_scope,
@@ -291,6 +303,19 @@ Engine::Engine(KernelContext* ctx,
   // Get the context properties from the scope
   auto context_properties =
       ctx->As<NNAdapterContext>().NNAdapterContextProperties(exec_scope_);
+#ifdef LITE_WITH_ARM
+  // Let XNNPACK use the same number of threads as the ARM kernels, its worker
+  // threads and the parked ones of lite::ThreadPool never run at the same time
+  if (std::find(device_names.begin(),
+                device_names.end(),
+                "google_xnnpack") != device_names.end() &&
+      context_properties.find("GOOGLE_XNNPACK_NUM_THREADS") ==
+          std::string::npos &&
+      !std::getenv("GOOGLE_XNNPACK_NUM_THREADS")) {
+    context_properties += "GOOGLE_XNNPACK_NUM_THREADS=" +
+                          std::to_string(DeviceInfo::Global().threads()) + ";";
+  }
+#endif
   VLOG(3) << "NNAdapter context_properties: " << context_properties;
   // Create a context with multiple devices
   NNAdapterContext_create_invoke(
@@ -299,9 +324,23 @@ Engine::Engine(KernelContext* ctx,
   model_cache_dir_ =
       ctx_->As<NNAdapterContext>().NNAdapterModelCacheDir(exec_scope_);
   VLOG(3) << "NNAdapter model_cache_dir: " << model_cache_dir_;
+  NNAdapterContext::SetNNAdapterShapeReadyFunc(
+      exec_scope_,
+      this,
+      [this](const std::map<std::string, std::vector<int64_t>>& input_shapes) {
+        return IsShapeReady(input_shapes);
+      });
+  if (NNAdapterContext::NNAdapterPrecompileDynamicShapes(exec_scope_)) {
+    PrecompileAsync();
+  }
 }
 
 Engine::~Engine() {
+  NNAdapterContext::SetNNAdapterShapeReadyFunc(exec_scope_, this, nullptr);
+  if (precompiler_.joinable()) {
+    precompiler_.join();
+  }
+  precompiled_program_.reset();
   programs_.clear();
   NNAdapterContext_destroy_invoke(context_);
   for (auto* device : devices_) {
@@ -309,7 +348,131 @@ Engine::~Engine() {
   }
 }
 
+std::string Engine::ModelCacheToken(const std::vector<Variable>& input_vars) {
+  std::vector<std::string> device_names;
+  for (auto* device : devices_) {
+    const char* name = nullptr;
+    NNAdapterDevice_getName_invoke(device, &name);
+    device_names.push_back(name);
+  }
+  return GenerateModelCacheToken(device_names, input_vars);
+}
+
+std::shared_ptr<Program> Engine::BuildProgram(
+    const std::string& model_cache_token,
+    std::vector<char>* model_cache_buffer,
+    const std::vector<Variable>& input_vars,
+    std::vector<Variable>* output_vars) {
+  std::lock_guard<std::mutex> lock(BuildMutex());
+  auto program = std::make_shared<Program>(context_);
+  // Load the compiled device program from the model cache buffer or file
+  bool cache_hit = program->LoadFromCache(
+      model_cache_token, model_cache_buffer, model_cache_dir_);
+  RuntimeStats::Global().nnadapter_model_cache.Record(cache_hit);
+  if (!cache_hit) {
+    // Compile the model online to generate the device program and cache it to
+    // the file
+    CHECK(program->BuildAndCacheToFile(block_desc_,
+                                       exec_scope_,
+                                       input_vars,
+                                       output_vars,
+                                       model_cache_token,
+                                       model_cache_dir_));
+  }
+  CHECK(program->IsValid());
+  for (auto& input_var : input_vars) {
+    if (input_var.dynamic_dimensions.empty()) {
+      program->input_dims_.push_back({input_var.value->dims().Vectorize()});
+    } else {
+      program->input_dims_.push_back(input_var.dynamic_dimensions);
+    }
+  }
+  return program;
+}
+
+void Engine::PrecompileAsync() {
+  for (auto& input_var : input_vars_) {
+    if (input_var.dynamic_dimensions.empty()) {
+      VLOG(3) << "The shape of the input '" << input_var.name
+              << "' is unknown, skip the precompilation.";
+      return;
+    }
+  }
+  // The placeholders of the inputs of the first dynamic shapes, which are
+  // assumed to be fp32 if their precisions are unknown yet.
+  auto input_vars = input_vars_;
+  precompiled_inputs_.resize(input_vars.size());
+  for (size_t i = 0; i < input_vars.size(); i++) {
+    auto& tensor = precompiled_inputs_[i];
+    tensor.Resize(input_vars[i].dynamic_dimensions[0]);
+    auto precision = input_vars[i].value->precision();
+    tensor.set_precision(precision == PRECISION(kUnk) ? PRECISION(kFloat)
+                                                      : precision);
+    input_vars[i].value = &tensor;
+  }
+  precompiled_output_vars_ = output_vars_;
+  auto model_cache_token = ModelCacheToken(input_vars);
+  auto model_cache_buffer = std::make_shared<std::vector<char>>();
+  ctx_->As<NNAdapterContext>().NNAdapterModelCacheBuffers(
+      exec_scope_, model_cache_token, model_cache_buffer.get());
+  precompiler_ = std::thread([=] {
+    auto program = BuildProgram(model_cache_token,
+                                model_cache_buffer.get(),
+                                input_vars,
+                                &precompiled_output_vars_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    precompiled_program_ = program;
+  });
+}
+
+bool Engine::IsShapeReady(
+    const std::map<std::string, std::vector<int64_t>>& input_shapes) {
+  auto is_compiled = [&](const std::shared_ptr<Program>& program) {
+    if (!program) return false;
+    for (size_t i = 0; i < input_vars_.size(); i++) {
+      auto iter = input_shapes.find(input_vars_[i].name);
+      if (iter == input_shapes.end()) continue;
+      const auto& dims = program->input_dims_[i];
+      if (std::find(dims.begin(), dims.end(), iter->second) == dims.end()) {
+        return false;
+      }
+    }
+    return true;
+  };
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (is_compiled(precompiled_program_)) return true;
+  for (auto& program : programs_) {
+    if (is_compiled(program)) return true;
+  }
+  return false;
+}
+
 bool Engine::Run() {
+  if (precompiler_.joinable()) {
+    // Wait for the program built in the background, which is used if the
+    // inputs have the precisions it assumed.
+    precompiler_.join();
+    std::shared_ptr<Program> program;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      program.swap(precompiled_program_);
+    }
+    bool matched = true;
+    for (size_t i = 0; i < input_vars_.size(); i++) {
+      matched &= input_vars_[i].value->precision() ==
+                 precompiled_inputs_[i].precision();
+    }
+    if (matched) {
+      output_vars_ = precompiled_output_vars_;
+      CHECK(program->SetInputsAndOutputs(&input_vars_, &output_vars_));
+      std::lock_guard<std::mutex> lock(mutex_);
+      programs_.push_back(program);
+    } else {
+      LOG(WARNING) << "The precisions of the inputs differ from the "
+                      "precompiled program, build it again.";
+    }
+    precompiled_inputs_.clear();
+  }
   // Try to execute all cached programs.
   for (auto program : programs_) {
     int ret = program->Execute();
@@ -327,36 +490,21 @@ bool Engine::Run() {
   // find valid program.
   VLOG(1) << "Warning: No suitable program found for current input shapes, try "
              "generating a new program online.";
-  std::vector<std::string> device_names;
-  for (auto* device : devices_) {
-    const char* name = nullptr;
-    NNAdapterDevice_getName_invoke(device, &name);
-    device_names.push_back(name);
-  }
-  auto program = std::make_shared<Program>(context_);
   // Take the model cache buffer from the scope
   std::vector<char> model_cache_buffer;
   // Generate a cache token based on the input names and shapes
-  auto model_cache_token = GenerateModelCacheToken(device_names, input_vars_);
+  auto model_cache_token = ModelCacheToken(input_vars_);
   VLOG(3) << "NNAdapter model_cache_token: " << model_cache_token;
   ctx_->As<NNAdapterContext>().NNAdapterModelCacheBuffers(
       exec_scope_, model_cache_token, &model_cache_buffer);
   VLOG(3) << "NNAdapter model_cache_buffer size: " << model_cache_buffer.size();
-  // Load the compiled device program from the model cache buffer or file
-  if (!program->LoadFromCache(
-          model_cache_token, &model_cache_buffer, model_cache_dir_)) {
-    // Compile the model online to generate the device program and cache it to
-    // the file
-    CHECK(program->BuildAndCacheToFile(block_desc_,
-                                       exec_scope_,
-                                       input_vars_,
-                                       &output_vars_,
-                                       model_cache_token,
-                                       model_cache_dir_));
-  }
-  CHECK(program->IsValid());
+  auto program = BuildProgram(
+      model_cache_token, &model_cache_buffer, input_vars_, &output_vars_);
   CHECK(program->SetInputsAndOutputs(&input_vars_, &output_vars_));
-  programs_.push_back(program);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    programs_.push_back(program);
+  }
   int ret = program->Execute();
   CHECK_EQ(ret, static_cast<int>(NNADAPTER_NO_ERROR))
       << "Program execute failed.";
@@ -16,7 +16,9 @@
 
 #include <map>
 #include <memory>
+#include <mutex>   // NOLINT
 #include <string>
+#include <thread>  // NOLINT
 #include <vector>
 #include "lite/backends/nnadapter/nnadapter_wrapper.h"
 #include "lite/core/program.h"
@@ -63,6 +65,8 @@ class Program {
   NNAdapterCompilation* compilation_{nullptr};
   NNAdapterExecution* execution_{nullptr};
   ::NNAdapterContext* context_{nullptr};
+  // The shapes of each input which the program is compiled for
+  std::vector<std::vector<std::vector<int64_t>>> input_dims_;
 };
 
 class Engine {
@@ -78,6 +82,21 @@ class Engine {
   bool Run();
 
  private:
+  // Generate the token of the model cache for the shapes of the inputs
+  std::string ModelCacheToken(const std::vector<Variable>& input_vars);
+  // Load the program from the model cache, or build it from the block
+  std::shared_ptr<Program> BuildProgram(
+      const std::string& model_cache_token,
+      std::vector<char>* model_cache_buffer,
+      const std::vector<Variable>& input_vars,
+      std::vector<Variable>* output_vars);
+  // Build the program of the dynamic shapes of the inputs in the background
+  void PrecompileAsync();
+  // Whether a program is compiled for the shapes of the inputs
+  bool IsShapeReady(
+      const std::map<std::string, std::vector<int64_t>>& input_shapes);
+
+
   KernelContext* ctx_{nullptr};
   const cpp::BlockDesc* block_desc_{nullptr};
   Scope* exec_scope_{nullptr};
@@ -87,6 +106,14 @@ class Engine {
   ::NNAdapterContext* context_{nullptr};
   std::vector<std::shared_ptr<Program>> programs_;
   std::string model_cache_dir_{""};
+  // The program built in the background, and the placeholders of the inputs
+  // and the outputs it is built with.
+  std::thread precompiler_;
+  std::shared_ptr<Program> precompiled_program_;
+  std::vector<Tensor> precompiled_inputs_;
+  std::vector<Variable> precompiled_output_vars_;
+  // Guards programs_ and precompiled_program_ for IsShapeReady
+  std::mutex mutex_;
 };
 
 }  // namespace nnadapter
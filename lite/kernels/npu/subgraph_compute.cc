@@ -399,6 +399,11 @@ bool SubgraphEngine::LaunchDeviceProgram() {
   return device_program->ZeroCopyRun(&device_itensors_, &device_otensors_);
 }
 
+void SubgraphEngine::ReleaseDeviceProgram(
+    const std::vector<std::vector<int64_t>>& idims) {
+  device_programs_.erase(idims);
+}
+
 void SubgraphCompute::PrepareForRun() {
   auto& param = this->Param<param_t>();
   engine_.reset(new SubgraphEngine(ctx_.get(),
@@ -412,7 +417,13 @@ void SubgraphCompute::PrepareForRun() {
 
 void SubgraphCompute::Run() {
   CHECK(engine_);
-  engine_->Run();
+  engine_->Launch(async_);
+  if (!async_) engine_->Wait();
+}
+
+void SubgraphCompute::Wait() {
+  CHECK(engine_);
+  engine_->Wait();
 }
 
 }  // namespace npu
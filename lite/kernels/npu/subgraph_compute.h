@@ -86,6 +86,8 @@ class SubgraphEngine : public subgraph::SubgraphEngineBase {
   bool PrepareWorkspaceForDeviceProgram() override;
   bool BuildDeviceProgram() override;
   bool LaunchDeviceProgram() override;
+  void ReleaseDeviceProgram(
+      const std::vector<std::vector<int64_t>>& idims) override;
 
   std::vector<std::shared_ptr<hiai::AiTensor>> device_itensors_{};
   std::vector<std::shared_ptr<hiai::AiTensor>> device_otensors_{};
@@ -101,10 +103,18 @@ class SubgraphCompute : public KernelLite<TARGET(kNPU), PRECISION(kAny)> {
 
   void Run() override;
 
+  bool SetAsync(bool async) override {
+    async_ = async;
+    return true;
+  }
+
+  void Wait() override;
+
   virtual ~SubgraphCompute() = default;
 
  private:
   std::unique_ptr<SubgraphEngine> engine_;
+  bool async_{false};
 };
 
 }  // namespace npu
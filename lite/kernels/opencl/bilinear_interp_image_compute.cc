@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <map>
 #include <memory>
 #include <string>
 #include "lite/backends/opencl/cl_half.h"
@@ -52,19 +53,27 @@ class BilinearInterpImageCompute
                                     build_options_,
                                     time_stamp_);
     VLOG(1) << "kernel_func_name_:" << kernel_func_name_;
+
+    STL::stringstream kernel_key;
+    kernel_key << kernel_func_name_ << build_options_ << time_stamp_;
+    kernel_ = context.cl_context()->GetKernel(kernel_key.str());
   }
 
-  void Run() override {
-    auto& context = ctx_->As<OpenCLContext>();
-    CHECK(context.cl_context() != nullptr);
+  // The scales, the work size and the arguments besides the images only
+  // depend on the shapes, so they are set again only when those change.
+  void ReInitWhenNeeded() override {
+    auto in_dims = bilinear_interp_param_->X->dims();
+    auto out_dims = bilinear_interp_param_->Out->dims();
+    if (!first_epoch_for_reinit_ && in_dims == last_in_dims_ &&
+        out_dims == last_out_dims_) {
+      return;
+    }
+    first_epoch_for_reinit_ = false;
+    last_in_dims_ = in_dims;
+    last_out_dims_ = out_dims;
 
-    auto* x = bilinear_interp_param_->X;
-    auto* out = bilinear_interp_param_->Out;
     float scale_h = 0.0;
     float scale_w = 0.0;
-    auto out_dims = out->dims();
-    auto in_dims = x->dims();
-
     if (bilinear_interp_param_->align_corners) {
       scale_h = (in_dims[2] - 1.0f) / (out_dims[2] - 1.0f);
       scale_w = (in_dims[3] - 1.0f) / (out_dims[3] - 1.0f);
@@ -83,80 +92,72 @@ class BilinearInterpImageCompute
     int out_h = out_dims[2];
     int out_w = out_dims[3];
 
+    out_image_shape_ = InitImageDimInfoWith(out_dims);
+    auto default_work_size = DefaultGlobalWorkSize(
+        out_dims,
+        DDim(std::vector<DDim::value_type>{
+            static_cast<int64_t>(out_image_shape_["width"]),
+            static_cast<int64_t>(out_image_shape_["height"])}));
+    global_work_size_ =
+        cl::NDRange{static_cast<cl::size_type>(default_work_size[0]),
+                    static_cast<cl::size_type>(default_work_size[1]),
+                    static_cast<cl::size_type>(default_work_size[2])};
+
 #ifdef LITE_WITH_LOG
-    VLOG(4) << "x->target():" << TargetToStr(x->target());
-    VLOG(4) << "out->target():" << TargetToStr(out->target());
     VLOG(4) << "x->dims():" << in_dims;
     VLOG(4) << "out->dims():" << out_dims;
-#endif
-
-    auto out_image_shape = InitImageDimInfoWith(out_dims);
-    auto* x_img = GET_DATA_GPU(x);
-    auto* out_img = MUTABLE_DATA_GPU(
-        out, out_image_shape["width"], out_image_shape["height"], nullptr);
-
-#ifdef LITE_WITH_LOG
-    // VLOG(4) << "x_image: " << x_img;
-    // VLOG(4) << "out_image: " << out_img;
-    VLOG(4) << "out_image_shape[w,h]: " << out_image_shape["width"] << " "
-            << out_image_shape["height"];
-
+    VLOG(4) << "out_image_shape[w,h]: " << out_image_shape_["width"] << " "
+            << out_image_shape_["height"];
     VLOG(4) << "scale_h: " << scale_h << ", scale_w: " << scale_w
             << ", align_delta: " << align_delta;
-    VLOG(4) << "in_h: " << in_h << ", in_w: " << in_w;
-    VLOG(4) << "out_h: " << out_h << ", out_w: " << out_w;
+    VLOG(4) << "global_work_size:[2D]:" << default_work_size[0] << " "
+            << default_work_size[1] << " " << default_work_size[2];
 #endif
 
-    STL::stringstream kernel_key;
-    kernel_key << kernel_func_name_ << build_options_ << time_stamp_;
-    auto kernel = context.cl_context()->GetKernel(kernel_key.str());
-
-    int arg_idx = 0;
-    auto default_work_size = DefaultGlobalWorkSize(
-        out_dims,
-        DDim(std::vector<DDim::value_type>{
-            static_cast<int64_t>(out_image_shape["width"]),
-            static_cast<int64_t>(out_image_shape["height"])}));
-#ifdef LITE_WITH_LOG
-    VLOG(4) << "default_work_size: " << default_work_size[0] << ", "
-            << default_work_size[1] << ", " << default_work_size[2];
-#endif
-    cl_int status = kernel.setArg(arg_idx++, *x_img);
+    int arg_idx = 2;
+    cl_int status = kernel_.setArg(arg_idx++, scale_h);
     CL_CHECK_FATAL(status);
-    status = kernel.setArg(arg_idx++, *out_img);
+    status = kernel_.setArg(arg_idx++, scale_w);
     CL_CHECK_FATAL(status);
-    status = kernel.setArg(arg_idx++, scale_h);
+    status = kernel_.setArg(arg_idx++, align_delta);
     CL_CHECK_FATAL(status);
-    status = kernel.setArg(arg_idx++, scale_w);
+    status = kernel_.setArg(arg_idx++, in_h);
     CL_CHECK_FATAL(status);
-    status = kernel.setArg(arg_idx++, align_delta);
+    status = kernel_.setArg(arg_idx++, in_w);
     CL_CHECK_FATAL(status);
-    status = kernel.setArg(arg_idx++, in_h);
+    status = kernel_.setArg(arg_idx++, out_h);
     CL_CHECK_FATAL(status);
-    status = kernel.setArg(arg_idx++, in_w);
+    status = kernel_.setArg(arg_idx++, out_w);
     CL_CHECK_FATAL(status);
-    status = kernel.setArg(arg_idx++, out_h);
+  }
+
+  void Run() override {
+    auto& context = ctx_->As<OpenCLContext>();
+    CHECK(context.cl_context() != nullptr);
+
+    auto* x = bilinear_interp_param_->X;
+    auto* out = bilinear_interp_param_->Out;
+#ifdef LITE_WITH_LOG
+    VLOG(4) << "x->target():" << TargetToStr(x->target());
+    VLOG(4) << "out->target():" << TargetToStr(out->target());
+#endif
+    auto* x_img = GET_DATA_GPU(x);
+    auto* out_img = MUTABLE_DATA_GPU(
+        out, out_image_shape_["width"], out_image_shape_["height"], nullptr);
+
+    cl_int status = kernel_.setArg(0, *x_img);
     CL_CHECK_FATAL(status);
-    status = kernel.setArg(arg_idx++, out_w);
+    status = kernel_.setArg(1, *out_img);
     CL_CHECK_FATAL(status);
 
-    auto global_work_size =
-        cl::NDRange{static_cast<cl::size_type>(default_work_size[0]),
-                    static_cast<cl::size_type>(default_work_size[1]),
-                    static_cast<cl::size_type>(default_work_size[2])};
-
     status = EnqueueNDRangeKernel(context,
-                                  kernel,
+                                  kernel_,
                                   cl::NullRange,
-                                  global_work_size,
+                                  global_work_size_,
                                   cl::NullRange,
                                   nullptr,
                                   event_);
     CL_CHECK_FATAL(status);
-#ifdef LITE_WITH_LOG
-    VLOG(4) << "global_work_size:[2D]:" << global_work_size[0] << " "
-            << global_work_size[1] << " " << global_work_size[2];
-#endif
   }
 
  protected:
@@ -164,6 +165,12 @@ class BilinearInterpImageCompute
   std::string kernel_func_name_{"bilinear_interp"};
   std::string build_options_{""};
   std::string time_stamp_{GetTimeStamp()};
+  bool first_epoch_for_reinit_{true};
+  DDim last_in_dims_;
+  DDim last_out_dims_;
+  std::map<std::string, size_t> out_image_shape_;
+  cl::Kernel kernel_;
+  cl::NDRange global_work_size_;
 };
 
 }  // namespace opencl
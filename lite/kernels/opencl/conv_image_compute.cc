@@ -27,6 +27,28 @@ namespace lite {
 namespace kernels {
 namespace opencl {
 
+void ConvImageCompute::DequantizeFilter() {
+  auto* filter = conv_param_->filter;
+  const auto& weight_scale = conv_param_->weight_scale;
+  const int oc = filter->dims()[0];
+  CHECK(weight_scale.size() == 1 ||
+        weight_scale.size() == static_cast<size_t>(oc))
+      << "The size of the filter scales of conv should be 1 or " << oc
+      << ", but got " << weight_scale.size();
+  const int inner_size = filter->numel() / oc;
+  Tensor filter_float;
+  filter_float.Resize(filter->dims());
+  auto* src = filter->data<int8_t>();
+  auto* dst = filter_float.mutable_data<float>();
+  for (int i = 0; i < oc; i++) {
+    float scale = weight_scale.size() == 1 ? weight_scale[0] : weight_scale[i];
+    for (int j = 0; j < inner_size; j++) {
+      dst[i * inner_size + j] = src[i * inner_size + j] * scale;
+    }
+  }
+  filter->CopyDataFrom(filter_float);
+}
+
 void ConvImageCompute::PrepareForRun() {
   ReInitWhenNeeded();
 
@@ -94,6 +116,9 @@ void ConvImageCompute::PrepareForRun() {
   offset_h_ = offset_;
 
   bool pad_equal = ((pad_left_ == pad_up_) && (pad_left_ == pad_right_));
+  // kernels that bounds-check the input only need equal top and left pads,
+  // the bottom and right ones may differ (e.g. a folded pad2d)
+  bool pad_origin_equal = pad_left_ == pad_up_;
   bool stride_equal = stride_h_ == stride_w_;
   bool dilation_equal = dilation_h_ == dilation_w_;
 
@@ -124,6 +149,9 @@ void ConvImageCompute::PrepareForRun() {
   /*********************************************
    * Upload filter, bias to opencl device
    *********************************************/
+  if (conv_param_->filter->precision() == PRECISION(kInt8)) {
+    DequantizeFilter();
+  }
   auto* filter_cpu = conv_param_->filter->mutable_data<float>();
   // if (is_mali && filter_tensor_h_ == 1 && filter_tensor_w_ == 1) {
   //   kernel_func_names_.push_back("conv2d_1x1_mali");
@@ -188,8 +216,7 @@ void ConvImageCompute::PrepareForRun() {
 #define DEPTH_CONV_USE_SPL
 #ifdef DEPTH_CONV_USE_SPL
     if (filter_tensor_h_ == 3 && filter_tensor_w_ == 3 &&
-        dilation_h_ == dilation_w_ && (pad_left_ == pad_up_) &&
-        (pad_left_ == pad_right_)) {
+        dilation_h_ == dilation_w_ && pad_origin_equal) {
       // depth_conv2d_3x3s1, depth_conv2d_3x3
       if (stride_equal && stride_h_ == 1 && dilation_h_ == 1) {
         kernel_func_names_.push_back("depth_conv2d_3x3s1");
@@ -208,12 +235,10 @@ void ConvImageCompute::PrepareForRun() {
       tensor_hold_filter_image_->Resize(
           {1, filter_image_w_, filter_image_h_, 4});
 
-      auto* filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
-      converter.NCHWToImage(filter_cpu, filter_image_data, filter_dims);
-      MUTABLE_DATA_GPU(filter_gpu_image_,
-                       filter_image_w_,
-                       filter_image_h_,
-                       filter_image_data);
+      converter.NCHWToDeviceImage(filter_cpu,
+                                  filter_dims,
+                                  tensor_hold_filter_image_.get(),
+                                  filter_gpu_image_.get());
     } else {
 #endif
       // common depth_conv2d
@@ -228,12 +253,10 @@ void ConvImageCompute::PrepareForRun() {
       tensor_hold_filter_image_->Resize(
           {1, filter_image_w_, filter_image_h_, 4});
 
-      auto* filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
-      converter.NCHWToImage(filter_cpu, filter_image_data, filter_dims);
-      MUTABLE_DATA_GPU(filter_gpu_image_,
-                       filter_image_w_,
-                       filter_image_h_,
-                       filter_image_data);
+      converter.NCHWToDeviceImage(filter_cpu,
+                                  filter_dims,
+                                  tensor_hold_filter_image_.get(),
+                                  filter_gpu_image_.get());
 
       impl_ = &ConvImageCompute::DepthwiseConv2d;
 #ifdef DEPTH_CONV_USE_SPL
@@ -323,16 +346,15 @@ void ConvImageCompute::PrepareForRun() {
     filter_image_h_ = filter_image_dims[1];
     filter_image_w_ = filter_image_dims[0];
     tensor_hold_filter_image_->Resize({1, filter_image_w_, filter_image_h_, 4});
-    auto* filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
-
-    converter.NCHWToImage(filter_cpu, filter_image_data, filter_dims);
-    MUTABLE_DATA_GPU(
-        filter_gpu_image_, filter_image_w_, filter_image_h_, filter_image_data);
+    converter.NCHWToDeviceImage(filter_cpu,
+                                filter_dims,
+                                tensor_hold_filter_image_.get(),
+                                filter_gpu_image_.get());
 
     filter_image_h_ = UP_DIV(filter_dims[1], 4);
     filter_image_w_ = UP_DIV(filter_dims[0], 4);
     tensor_hold_filter_image_->Resize({1, filter_image_w_, filter_image_h_, 4});
-    filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
+    auto* filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
 
     NCHW2IMG4(filter_cpu, filter_image_data, filter_dims[0], filter_dims[1], 0);
     MUTABLE_DATA_GPU(filter_gpu_image0_,
@@ -370,43 +392,16 @@ void ConvImageCompute::PrepareForRun() {
         groups_ == 1) {
       wino_v_gpu_image_ = std::unique_ptr<Tensor>(new Tensor);
       wino_m_gpu_image_ = std::unique_ptr<Tensor>(new Tensor);
-      kernel_func_names_.push_back("transform_from_input");
       if (is_mali_) {
-        kernel_func_names_.push_back("matrix_inner_product_mali");
-        kernel_func_names_.push_back("transform_to_output_mali");
         bias_buffer_flag = true;
-      } else {
-        kernel_func_names_.push_back("matrix_inner_product");
-        kernel_func_names_.push_back("transform_to_output");
       }
       kernel_func_paths_.push_back("image/conv2d_winograd_3x3s1_kernel.cl");
       is_wino_ = true;
-
-      CLImageConverterWinoTransWeight converter;
-      const DDim& filter_image_dims =
-          converter.InitImageDimInfoWith(filter_dims);
-      filter_image_h_ = filter_image_dims[1];
-      filter_image_w_ = filter_image_dims[0];
-      tensor_hold_filter_image_->Resize(
-          {1, filter_image_w_, filter_image_h_, 4});
-      auto* filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
-      converter.NCHWToImage(filter_cpu, filter_image_data, filter_dims);
-
-      // for mali
-      if (is_mali_) {
-        w_gpu_t_ = std::unique_ptr<Tensor>(new Tensor);
-        auto* w_gpu_data = w_gpu_t_->mutable_data(
-            TARGET(kOpenCL), tensor_hold_filter_image_->memory_size());
-        TargetWrapperCL::MemcpySync(w_gpu_data,
-                                    tensor_hold_filter_image_->raw_data(),
-                                    tensor_hold_filter_image_->memory_size(),
-                                    IoDirection::HtoD);
-      } else {
-        MUTABLE_DATA_GPU(filter_gpu_image_,
-                         filter_image_w_,
-                         filter_image_h_,
-                         filter_image_data);
-      }
+      // The F(4x4, 3x3) one is tried for the wide convs, or compared with the
+      // F(2x2, 3x3) one when tuning.
+      bool use_wino_4x4 = CanUseWinograd4x4() && input_tensor_c_ >= 64 &&
+                          output_tensor_c_ >= 64;
+      InitWinograd(use_wino_4x4 ? 4 : 2);
     } else if (groups_ == 1) {
       if (is_mali_ && input_tensor_n_ == 1) {
         kernel_func_names_.push_back("conv2d_3x3_opt_mali");
@@ -429,10 +424,9 @@ void ConvImageCompute::PrepareForRun() {
       filter_image_w_ = filter_image_dims[0];
       tensor_hold_filter_image_->Resize(
           {1, filter_image_w_, filter_image_h_, 4});
-      auto* filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
-      converter.NCHWToImage(filter_cpu, filter_image_data, filter_dims);
-
       if (is_mali_ && input_tensor_n_ == 1) {
+        auto* filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
+        converter.NCHWToImage(filter_cpu, filter_image_data, filter_dims);
         w_gpu_t_ = std::unique_ptr<Tensor>(new Tensor);
         auto* w_gpu_data = w_gpu_t_->mutable_data(
             TARGET(kOpenCL), tensor_hold_filter_image_->memory_size());
@@ -441,10 +435,10 @@ void ConvImageCompute::PrepareForRun() {
                                     tensor_hold_filter_image_->memory_size(),
                                     IoDirection::HtoD);
       } else {
-        MUTABLE_DATA_GPU(filter_gpu_image_,
-                         filter_image_w_,
-                         filter_image_h_,
-                         filter_image_data);
+        converter.NCHWToDeviceImage(filter_cpu,
+                                    filter_dims,
+                                    tensor_hold_filter_image_.get(),
+                                    filter_gpu_image_.get());
       }
     } else {  // groups_ > 1
       kernel_func_names_.push_back("conv2d_3x3");
@@ -458,17 +452,14 @@ void ConvImageCompute::PrepareForRun() {
       filter_image_w_ = filter_image_dims[0];
       tensor_hold_filter_image_->Resize(
           {1, filter_image_w_, filter_image_h_, 4});
-      auto* filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
-
-      converter.NCHWToImage(filter_cpu, filter_image_data, filter_dims);
-      MUTABLE_DATA_GPU(filter_gpu_image_,
-                       filter_image_w_,
-                       filter_image_h_,
-                       filter_image_data);
+      converter.NCHWToDeviceImage(filter_cpu,
+                                  filter_dims,
+                                  tensor_hold_filter_image_.get(),
+                                  filter_gpu_image_.get());
     }
-  } else if (filter_tensor_h_ == 5 && filter_tensor_w_ == 5 && pad_equal &&
-             stride_equal && dilation_equal && dilation_h_ == 1 &&
-             groups_ == 1) {
+  } else if (filter_tensor_h_ == 5 && filter_tensor_w_ == 5 &&
+             pad_origin_equal && stride_equal && dilation_equal &&
+             dilation_h_ == 1 && groups_ == 1) {
 #define CONV_5x5_OPT
 #ifndef CONV_5x5_OPT
     // conv2d_5x5
@@ -481,10 +472,10 @@ void ConvImageCompute::PrepareForRun() {
     filter_image_w_ = filter_image_dims[0];
     tensor_hold_filter_image_->Resize({1, filter_image_w_, filter_image_h_, 4});
 
-    auto* filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
-    converter.NCHWToImage(filter_cpu, filter_image_data, filter_dims);
-    MUTABLE_DATA_GPU(
-        filter_gpu_image_, filter_image_w_, filter_image_h_, filter_image_data);
+    converter.NCHWToDeviceImage(filter_cpu,
+                                filter_dims,
+                                tensor_hold_filter_image_.get(),
+                                filter_gpu_image_.get());
 
     impl_ = &ConvImageCompute::Conv2d5x5;
 #else
@@ -500,18 +491,17 @@ void ConvImageCompute::PrepareForRun() {
     filter_image_w_ = filter_image_dims[0];
     tensor_hold_filter_image_->Resize({1, filter_image_w_, filter_image_h_, 4});
 
-    auto* filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
-
-    converter.NCHWToImage(filter_cpu, filter_image_data, filter_dims);
-    MUTABLE_DATA_GPU(
-        filter_gpu_image_, filter_image_w_, filter_image_h_, filter_image_data);
+    converter.NCHWToDeviceImage(filter_cpu,
+                                filter_dims,
+                                tensor_hold_filter_image_.get(),
+                                filter_gpu_image_.get());
 
     impl_ = &ConvImageCompute::Conv2d5x5opt;
 #endif
 #undef CONV_5x5_OPT
-  } else if (filter_tensor_h_ == 7 && filter_tensor_w_ == 7 && pad_equal &&
-             stride_equal && dilation_equal && dilation_h_ == 1 &&
-             groups_ == 1) {
+  } else if (filter_tensor_h_ == 7 && filter_tensor_w_ == 7 &&
+             pad_origin_equal && stride_equal && dilation_equal &&
+             dilation_h_ == 1 && groups_ == 1) {
 #define CONV_7x7_OPT
 #ifndef CONV_7x7_OPT
     // conv2d_7x7
@@ -524,10 +514,10 @@ void ConvImageCompute::PrepareForRun() {
     filter_image_w_ = filter_image_dims[0];
     tensor_hold_filter_image_->Resize({1, filter_image_w_, filter_image_h_, 4});
 
-    auto* filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
-    converter.NCHWToImage(filter_cpu, filter_image_data, filter_dims);
-    MUTABLE_DATA_GPU(
-        filter_gpu_image_, filter_image_w_, filter_image_h_, filter_image_data);
+    converter.NCHWToDeviceImage(filter_cpu,
+                                filter_dims,
+                                tensor_hold_filter_image_.get(),
+                                filter_gpu_image_.get());
     impl_ = &ConvImageCompute::Conv2d7x7;
 
 #else
@@ -547,9 +537,9 @@ void ConvImageCompute::PrepareForRun() {
     filter_image_w_ = filter_image_dims[0];
     tensor_hold_filter_image_->Resize({1, filter_image_w_, filter_image_h_, 4});
 
-    auto* filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
-    converter.NCHWToImage(filter_cpu, filter_image_data, filter_dims);
     if (is_mali_ && input_tensor_n_ == 1) {
+      auto* filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
+      converter.NCHWToImage(filter_cpu, filter_image_data, filter_dims);
       w_gpu_t_ = std::unique_ptr<Tensor>(new Tensor);
       auto* w_gpu_data = w_gpu_t_->mutable_data(
           TARGET(kOpenCL), tensor_hold_filter_image_->memory_size());
@@ -558,10 +548,10 @@ void ConvImageCompute::PrepareForRun() {
                                   tensor_hold_filter_image_->memory_size(),
                                   IoDirection::HtoD);
     } else {
-      MUTABLE_DATA_GPU(filter_gpu_image_,
-                       filter_image_w_,
-                       filter_image_h_,
-                       filter_image_data);
+      converter.NCHWToDeviceImage(filter_cpu,
+                                  filter_dims,
+                                  tensor_hold_filter_image_.get(),
+                                  filter_gpu_image_.get());
     }
 
     impl_ = &ConvImageCompute::Conv2d7x7opt;
@@ -578,11 +568,10 @@ void ConvImageCompute::PrepareForRun() {
     filter_image_h_ = filter_image_dims[1];
     filter_image_w_ = filter_image_dims[0];
     tensor_hold_filter_image_->Resize({1, filter_image_w_, filter_image_h_, 4});
-    auto* filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
-
-    converter.NCHWToImage(filter_cpu, filter_image_data, filter_dims);
-    MUTABLE_DATA_GPU(
-        filter_gpu_image_, filter_image_w_, filter_image_h_, filter_image_data);
+    converter.NCHWToDeviceImage(filter_cpu,
+                                filter_dims,
+                                tensor_hold_filter_image_.get(),
+                                filter_gpu_image_.get());
 
   } else {
     // conv2d_common mul_group
@@ -601,11 +590,10 @@ void ConvImageCompute::PrepareForRun() {
     filter_image_h_ = filter_image_dims[1];
     filter_image_w_ = filter_image_dims[0];
     tensor_hold_filter_image_->Resize({1, filter_image_w_, filter_image_h_, 4});
-    auto* filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
-
-    converter.NCHWToImage(filter_cpu, filter_image_data, filter_dims);
-    MUTABLE_DATA_GPU(
-        filter_gpu_image_, filter_image_w_, filter_image_h_, filter_image_data);
+    converter.NCHWToDeviceImage(filter_cpu,
+                                filter_dims,
+                                tensor_hold_filter_image_.get(),
+                                filter_gpu_image_.get());
   }
   VLOG(1) << "kernel_func_names_[0]:" << kernel_func_names_[0]
           << " kernel_func_paths_[0]:" << kernel_func_paths_[0];
@@ -871,6 +859,20 @@ void ConvImageCompute::SetLocalWorkSize(size_t repeats /*=4*/) {
                                       static_cast<size_t>(tuned_in_map[4]),
                                       static_cast<size_t>(tuned_in_map[5])};
       int func_id = tuned_in_map[6];
+      if (CLRuntime::Global()->tune_shape_buckets()) {
+        // Tuned on another shape of the bucket, see GenerateTunedKey.
+        const int blk_divs[6][3] = {
+            {1, 4, 1}, {1, 5, 1}, {1, 7, 1}, {2, 3, 2}, {1, 2, 2}, {2, 2, 2}};
+        CHECK(func_id >= 0 && func_id < 6) << "unsupported kernel id : "
+                                           << func_id;
+        const int* divs = blk_divs[func_id];
+        global_work_size_ =
+            cl::NDRange{static_cast<size_t>(UP_DIV(default_c_blk_, divs[0])),
+                        static_cast<size_t>(UP_DIV(default_w_blk_, divs[1])),
+                        static_cast<size_t>(UP_DIV(default_nh_blk_, divs[2]))};
+        local_work_size_ = context.cl_context()->FitLocalWorkSize(
+            global_work_size_, local_work_size_);
+      }
       if (func_id == 0) {
         context.cl_context()->AddKernel(kernel_func_names_[0],
                                         kernel_func_paths_[0],
@@ -1096,22 +1098,39 @@ void ConvImageCompute::SetLocalWorkSize(size_t repeats /*=4*/) {
     CLRuntime::Global()->SetTunedLocalWorkSizeMap(tuned_map_key, tune_vec);
   } else if (is_wino_) {
     auto& context = ctx_->As<OpenCLContext>();
-    std::stringstream kernel_key;
-    kernel_key.str("");
-    kernel_key << kernel_func_names_[0] << build_options_[0] << time_stamp_;
-    kernel_ = context.cl_context()->GetKernel(kernel_key.str());
-    kernel_key.str("");
-    kernel_key << kernel_func_names_[1] << build_options_[0] << time_stamp_;
-    kernel_inner_product_ = context.cl_context()->GetKernel(kernel_key.str());
-    kernel_key.str("");
-    kernel_key << kernel_func_names_[2] << build_options_[0] << time_stamp_;
-    kernel_output_trans_ = context.cl_context()->GetKernel(kernel_key.str());
+    auto get_kernels = [&]() {
+      std::stringstream kernel_key;
+      kernel_key.str("");
+      kernel_key << kernel_func_names_[0] << build_options_[0] << time_stamp_;
+      kernel_ = context.cl_context()->GetKernel(kernel_key.str());
+      kernel_key.str("");
+      kernel_key << kernel_func_names_[1] << build_options_[0] << time_stamp_;
+      kernel_inner_product_ =
+          context.cl_context()->GetKernel(kernel_key.str());
+      kernel_key.str("");
+      kernel_key << kernel_func_names_[2] << build_options_[0] << time_stamp_;
+      kernel_output_trans_ = context.cl_context()->GetKernel(kernel_key.str());
+    };
+    auto switch_unit = [&](int wino_unit) {
+      if (wino_unit == wino_unit_) return;
+      InitWinograd(wino_unit);
+      for (size_t i = 0; i < kernel_func_names_.size(); i++) {
+        context.cl_context()->AddKernel(kernel_func_names_[i],
+                                        kernel_func_paths_[0],
+                                        build_options_[0],
+                                        time_stamp_);
+      }
+      SetGlobalWorkSize();
+    };
 
     auto tuned_map_key = GenerateTunedKey();
     std::vector<int> tuned_in_map;
     if (CLRuntime::Global()->HasTunedLocalWorkSizeMap(tuned_map_key,
                                                       &tuned_in_map)) {
-      CHECK_EQ(tuned_in_map.size(), 9);
+      // The ones tuned without the unit are F(2x2, 3x3).
+      CHECK(tuned_in_map.size() == 9 || tuned_in_map.size() == 10);
+      switch_unit(tuned_in_map.size() == 10 ? tuned_in_map[9] : 2);
+      get_kernels();
       local_work_size_ = cl::NDRange{static_cast<size_t>(tuned_in_map[0]),
                                      static_cast<size_t>(tuned_in_map[1]),
                                      static_cast<size_t>(tuned_in_map[2])};
@@ -1123,6 +1142,12 @@ void ConvImageCompute::SetLocalWorkSize(size_t repeats /*=4*/) {
           cl::NDRange{static_cast<size_t>(tuned_in_map[6]),
                       static_cast<size_t>(tuned_in_map[7]),
                       static_cast<size_t>(tuned_in_map[8])};
+      local_work_size_ = context.cl_context()->FitLocalWorkSize(
+          global_work_size_, local_work_size_);
+      local_work_size_wino1_ = context.cl_context()->FitLocalWorkSize(
+          global_work_size_wino1_, local_work_size_wino1_);
+      local_work_size_wino2_ = context.cl_context()->FitLocalWorkSize(
+          global_work_size_wino2_, local_work_size_wino2_);
       return;
     }
 
@@ -1130,6 +1155,36 @@ void ConvImageCompute::SetLocalWorkSize(size_t repeats /*=4*/) {
       CLRuntime::Global()->set_del_flag();
     }
 
+    // Choose the faster one of F(2x2, 3x3) and F(4x4, 3x3) by the time of
+    // the whole pipeline, before tuning the local work sizes of it.
+    if (CanUseWinograd4x4() && use_lws_ &&
+        CLRuntime::Global()->auto_tune() > 0) {
+      int min_wino_unit = wino_unit_;
+      double min_wino_time = DBL_MAX;
+      for (int wino_unit : {2, 4}) {
+        switch_unit(wino_unit);
+        get_kernels();
+        local_work_size_ = cl::NullRange;
+        local_work_size_wino1_ = cl::NullRange;
+        local_work_size_wino2_ = cl::NullRange;
+        double cur_wino_time = 0.0f;
+        for (size_t i = 0; i < repeats; ++i) {
+          Run();
+          cur_wino_time += CLRuntime::Global()->GetCommandTime(event_) +
+                           CLRuntime::Global()->GetCommandTime(event_1) +
+                           CLRuntime::Global()->GetCommandTime(event_2);
+        }
+        VLOG(4) << "winograd F(" << wino_unit << "x" << wino_unit
+                << ", 3x3) time: " << cur_wino_time / repeats;
+        if (min_wino_time > cur_wino_time) {
+          min_wino_unit = wino_unit;
+          min_wino_time = cur_wino_time;
+        }
+      }
+      switch_unit(min_wino_unit);
+    }
+    get_kernels();
+
     size_t max_work_group_size = 0;
     kernel_.getWorkGroupInfo<size_t>(CLRuntime::Global()->device(),
                                      CL_KERNEL_WORK_GROUP_SIZE,
@@ -1225,6 +1280,7 @@ void ConvImageCompute::SetLocalWorkSize(size_t repeats /*=4*/) {
     tune_vec.push_back(static_cast<int>(local_work_size_wino2_[0]));
     tune_vec.push_back(static_cast<int>(local_work_size_wino2_[1]));
     tune_vec.push_back(static_cast<int>(local_work_size_wino2_[2]));
+    tune_vec.push_back(wino_unit_);
     CLRuntime::Global()->SetTunedLocalWorkSizeMap(tuned_map_key, tune_vec);
 
   } else if (is_conv_mulgroup_) {
@@ -1255,6 +1311,12 @@ void ConvImageCompute::SetLocalWorkSize(size_t repeats /*=4*/) {
       local_work_size_cut0_ = cl::NDRange{static_cast<size_t>(tuned_in_map[6]),
                                           static_cast<size_t>(tuned_in_map[7]),
                                           static_cast<size_t>(tuned_in_map[8])};
+      local_work_size_fill0_ = context.cl_context()->FitLocalWorkSize(
+          global_work_size_fill0_, local_work_size_fill0_);
+      local_work_size_ = context.cl_context()->FitLocalWorkSize(
+          global_work_size_, local_work_size_);
+      local_work_size_cut0_ = context.cl_context()->FitLocalWorkSize(
+          global_work_size_cut0_, local_work_size_cut0_);
       return;
     }
     if (CLRuntime::Global()->tune_file_flag()) {
@@ -1370,6 +1432,8 @@ void ConvImageCompute::SetLocalWorkSize(size_t repeats /*=4*/) {
       local_work_size_ = cl::NDRange{static_cast<size_t>(tuned_in_map[0]),
                                      static_cast<size_t>(tuned_in_map[1]),
                                      static_cast<size_t>(tuned_in_map[2])};
+      local_work_size_ = context.cl_context()->FitLocalWorkSize(
+          global_work_size_, local_work_size_);
       return;
     }
 
@@ -1442,7 +1506,9 @@ std::string ConvImageCompute::GenerateTunedKey() {
   std::stringstream key;
   key << kernel_func_names_[0] << "," << build_options_[0]
       << ",x:" << input_tensor_n_ << "x" << input_tensor_c_ << "x"
-      << input_tensor_h_ << "x" << input_tensor_w_ << ",w:" << filter_tensor_n_
+      << CLRuntime::Global()->TuneBucket(input_tensor_h_) << "x"
+      << CLRuntime::Global()->TuneBucket(input_tensor_w_)
+      << ",w:" << filter_tensor_n_
       << "x" << filter_tensor_c_ << "x" << filter_tensor_h_ << "x"
       << filter_tensor_w_ << ",b:" << bias_image_h_ << "x" << bias_image_w_
       << ",pad:" << pad_up_ << pad_down_ << pad_left_ << pad_right_
@@ -1588,9 +1654,10 @@ void ConvImageCompute::SetGlobalWorkSize() {
     global_work_size_ = cl::NDRange{static_cast<size_t>(c_blk_),
                                     static_cast<size_t>(w_blk_),
                                     static_cast<size_t>(nh_blk_)};
-  } else if (kernel_func_names_[0] == "transform_from_input") {
-    const int round_up_ouptut_width = UP_DIV(output_tensor_w_, 2);
-    const int round_up_output_height = UP_DIV(output_tensor_h_, 2);
+  } else if (is_wino_) {
+    const int alpha = wino_unit_ + 2;
+    const int round_up_ouptut_width = UP_DIV(output_tensor_w_, wino_unit_);
+    const int round_up_output_height = UP_DIV(output_tensor_h_, wino_unit_);
     const int output_channel_blocks = UP_DIV(output_tensor_c_, 4);
     const int input_channel_blocks = UP_DIV(input_tensor_c_, 4);
     const int round_up_4x4_ouptut_width = UP_DIV(round_up_ouptut_width, 4);
@@ -1601,7 +1668,7 @@ void ConvImageCompute::SetGlobalWorkSize() {
         1};
     global_work_size_wino1_ = cl::NDRange{
         static_cast<size_t>(output_channel_blocks * round_up_4x4_ouptut_width),
-        static_cast<size_t>(16 * batch_round_h),
+        static_cast<size_t>(alpha * alpha * batch_round_h),
         1};
     global_work_size_wino2_ = cl::NDRange{
         static_cast<size_t>(output_channel_blocks * round_up_ouptut_width),
@@ -2024,6 +2091,10 @@ void ConvImageCompute::Conv2d3x3opt() {
   CL_CHECK_FATAL(status_);
   status_ = kernel_.setArg(16, *alpha_image_p_);
   CL_CHECK_FATAL(status_);
+  if (!fuse_eltwise_op_type_.empty()) {
+    status_ = kernel_.setArg(17, *second_input_image_p_);
+    CL_CHECK_FATAL(status_);
+  }
 }
 
 void ConvImageCompute::Conv2d5x5() {
@@ -2214,6 +2285,10 @@ void ConvImageCompute::DepthwiseConv2d3x3s1() {
   CL_CHECK_FATAL(status_);
   status_ = kernel_.setArg(15, *alpha_image_p_);
   CL_CHECK_FATAL(status_);
+  if (!fuse_eltwise_op_type_.empty()) {
+    status_ = kernel_.setArg(16, *second_input_image_p_);
+    CL_CHECK_FATAL(status_);
+  }
 }
 
 void ConvImageCompute::DepthwiseConv2d3x3() {
@@ -2252,6 +2327,10 @@ void ConvImageCompute::DepthwiseConv2d3x3() {
   CL_CHECK_FATAL(status_);
   status_ = kernel_.setArg(16, *alpha_image_p_);
   CL_CHECK_FATAL(status_);
+  if (!fuse_eltwise_op_type_.empty()) {
+    status_ = kernel_.setArg(17, *second_input_image_p_);
+    CL_CHECK_FATAL(status_);
+  }
 }
 
 void ConvImageCompute::DepthwiseConv2d() {
@@ -2354,8 +2433,9 @@ void ConvImageCompute::Run() {
 #endif
   if (is_wino_) {
     auto& context = ctx_->As<OpenCLContext>();
-    const int round_up_ouptut_width = UP_DIV(output_tensor_w_, 2);
-    const int round_up_output_height = UP_DIV(output_tensor_h_, 2);
+    const int alpha = wino_unit_ + 2;
+    const int round_up_ouptut_width = UP_DIV(output_tensor_w_, wino_unit_);
+    const int round_up_output_height = UP_DIV(output_tensor_h_, wino_unit_);
     const int output_channel_blocks = UP_DIV(output_tensor_c_, 4);
     const int input_channel_blocks = UP_DIV(input_tensor_c_, 4);
     const int round_up_4x4_ouptut_width = UP_DIV(round_up_ouptut_width, 4);
@@ -2366,12 +2446,12 @@ void ConvImageCompute::Run() {
     wino_v_image_p_ =
         MUTABLE_DATA_GPU(wino_v_gpu_image_,
                          input_channel_blocks * round_up_ouptut_width,
-                         16 * input_tensor_n_ * round_up_output_height,
+                         alpha * alpha * batch_round_h,
                          nullptr);
     wino_m_image_p_ =
         MUTABLE_DATA_GPU(wino_m_gpu_image_,
                          output_channel_blocks * round_up_ouptut_width,
-                         16 * input_tensor_n_ * round_up_output_height,
+                         alpha * alpha * batch_round_h,
                          nullptr);
     output_image_p_ = MUTABLE_DATA_GPU(
         conv_param_->output, output_image_w_, output_image_h_, nullptr);
@@ -2446,7 +2526,8 @@ void ConvImageCompute::Run() {
     status_ = kernel_inner_product_.setArg(
         idx++, output_channel_blocks * round_up_4x4_ouptut_width);
     CL_CHECK_FATAL(status_);
-    status_ = kernel_inner_product_.setArg(idx++, 16 * batch_round_h);
+    status_ =
+        kernel_inner_product_.setArg(idx++, alpha * alpha * batch_round_h);
     CL_CHECK_FATAL(status_);
     // static_cast<int>(local_work_size_wino1_[0]) != 0) mean
     // local_work_size_wino1_ !=
@@ -2498,6 +2579,11 @@ void ConvImageCompute::Run() {
     CL_CHECK_FATAL(status_);
     status_ = kernel_output_trans_.setArg(idx++, *alpha_image_p_);
     CL_CHECK_FATAL(status_);
+    if (!fuse_eltwise_op_type_.empty()) {
+      second_input_image_p_ = DATA_GPU(conv_param_->second_x);
+      status_ = kernel_output_trans_.setArg(idx++, *second_input_image_p_);
+      CL_CHECK_FATAL(status_);
+    }
     // static_cast<int>(local_work_size_wino2_[0]) != 0) mean
     // local_work_size_wino2_ !=
     // cl::NullRange
@@ -2752,6 +2838,58 @@ bool ConvImageCompute::UseFcReplaceConv() {
   return hw_is_1 && attr_valid && groups == 1;
 }
 
+bool ConvImageCompute::CanUseWinograd4x4() {
+  // The mali kernels reading the filter from buffers are F(2x2, 3x3) only,
+  // and the small outputs waste most of the 4x4 tiles.
+  return !is_mali_ && output_tensor_h_ >= 8 && output_tensor_w_ >= 8;
+}
+
+void ConvImageCompute::InitWinograd(int wino_unit) {
+  CHECK(wino_unit == 2 || (wino_unit == 4 && !is_mali_))
+      << "Unsupported winograd unit: " << wino_unit;
+  wino_unit_ = wino_unit;
+  kernel_func_names_.clear();
+  if (wino_unit_ == 4) {
+    kernel_func_names_.push_back("transform_from_input_4x4");
+    kernel_func_names_.push_back("matrix_inner_product");
+    kernel_func_names_.push_back("transform_to_output_4x4");
+  } else if (is_mali_) {
+    kernel_func_names_.push_back("transform_from_input");
+    kernel_func_names_.push_back("matrix_inner_product_mali");
+    kernel_func_names_.push_back("transform_to_output_mali");
+  } else {
+    kernel_func_names_.push_back("transform_from_input");
+    kernel_func_names_.push_back("matrix_inner_product");
+    kernel_func_names_.push_back("transform_to_output");
+  }
+
+  auto filter_dims = conv_param_->filter->dims();
+  auto* filter_cpu = conv_param_->filter->mutable_data<float>();
+  CLImageConverterWinoTransWeight converter(wino_unit_);
+  const DDim& filter_image_dims = converter.InitImageDimInfoWith(filter_dims);
+  filter_image_h_ = filter_image_dims[1];
+  filter_image_w_ = filter_image_dims[0];
+  tensor_hold_filter_image_->Resize({1, filter_image_w_, filter_image_h_, 4});
+  auto* filter_image_data = MUTABLE_DATA_CPU(tensor_hold_filter_image_);
+  converter.NCHWToImage(filter_cpu, filter_image_data, filter_dims);
+
+  // for mali
+  if (is_mali_) {
+    w_gpu_t_ = std::unique_ptr<Tensor>(new Tensor);
+    auto* w_gpu_data = w_gpu_t_->mutable_data(
+        TARGET(kOpenCL), tensor_hold_filter_image_->memory_size());
+    TargetWrapperCL::MemcpySync(w_gpu_data,
+                                tensor_hold_filter_image_->raw_data(),
+                                tensor_hold_filter_image_->memory_size(),
+                                IoDirection::HtoD);
+  } else {
+    // A new image, as the one of the other unit may be larger.
+    filter_gpu_image_ = std::unique_ptr<Tensor>(new Tensor);
+    filter_image_p_ = MUTABLE_DATA_GPU(
+        filter_gpu_image_, filter_image_w_, filter_image_h_, filter_image_data);
+  }
+}
+
 void ConvImageCompute::PrintConvInfo() {
   const bool is_element_wise_bias =
       has_bias_ && conv_param_->output->dims() == conv_param_->bias->dims();
@@ -2860,7 +2998,8 @@ REGISTER_LITE_KERNEL(conv2d,
                                       PRECISION(kFP16),
                                       DATALAYOUT(kImageDefault))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM))})
-    .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Filter",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kAny))})
     .BindInput("Prelu_alpha", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Output",
                 {LiteType::GetTensorTy(TARGET(kOpenCL),
@@ -2880,7 +3019,8 @@ REGISTER_LITE_KERNEL(depthwise_conv2d,
                                       PRECISION(kFP16),
                                       DATALAYOUT(kImageDefault))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM))})
-    .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Filter",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kAny))})
     .BindInput("Prelu_alpha", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Output",
                 {LiteType::GetTensorTy(TARGET(kOpenCL),
@@ -2905,7 +3045,8 @@ REGISTER_LITE_KERNEL(conv2d,
                                       PRECISION(kFP16),
                                       DATALAYOUT(kImageDefault))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kHost))})
-    .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("Filter",
+               {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kAny))})
     .BindInput("Prelu_alpha", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Output",
                 {LiteType::GetTensorTy(TARGET(kOpenCL),
@@ -2925,7 +3066,8 @@ REGISTER_LITE_KERNEL(depthwise_conv2d,
                                       PRECISION(kFP16),
                                       DATALAYOUT(kImageDefault))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kHost))})
-    .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("Filter",
+               {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kAny))})
     .BindInput("Prelu_alpha", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Output",
                 {LiteType::GetTensorTy(TARGET(kOpenCL),
@@ -58,9 +58,18 @@ class ConvImageCompute : public KernelLite<TARGET(kOpenCL),
 
  private:
   void PrintConvInfo();
+  // Dequantize the int8 filter of the quantized model in place, which is
+  // computed in fp16 as the float one.
+  void DequantizeFilter();
   void SetGlobalWorkSize();
   void SetLocalWorkSize(size_t repeats = 4);
   std::string GenerateTunedKey();
+  // Set the kernels and the filter of the winograd conv computing the output
+  // tiles of wino_unit x wino_unit, which is 2 or 4.
+  void InitWinograd(int wino_unit);
+  // Whether the F(4x4, 3x3) winograd is worth trying, the F(2x2, 3x3) one is
+  // used otherwise.
+  bool CanUseWinograd4x4();
   void Conv2d1x1opt();
   void Conv2d3x3();
   void Conv2d3x3opt();
@@ -184,6 +193,7 @@ class ConvImageCompute : public KernelLite<TARGET(kOpenCL),
   bool has_bias_{false};
   bool is_mali_{false};
   bool is_wino_{false};
+  int wino_unit_{2};
   bool is_conv_mulgroup_{false};
 
   int input_tensor_n_{-1};
@@ -0,0 +1,367 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/backends/host/math/elementwise_chain.h"
+#include "lite/backends/opencl/cl_image_converter.h"
+#include "lite/backends/opencl/cl_include.h"
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+#include "lite/kernels/opencl/image_helper.h"
+#include "lite/operators/op_params.h"
+#include "lite/utils/log/logging.h"
+#include "lite/utils/replace_stl/stream.h"
+#ifdef LITE_WITH_PROFILE
+#include "lite/core/profile/profiler.h"
+#endif
+#include "lite/backends/opencl/cl_utility.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace opencl {
+
+using lite::host::math::ChainOp;
+
+// Evaluates the chain in one kernel generated for the ops and the broadcast
+// of the inputs, which reads each input once and keeps the results of the
+// steps in the registers. The program is built once per source and saved in
+// the precompiled binary.
+class ElementwiseChainImageCompute
+    : public KernelLite<TARGET(kOpenCL),
+                        PRECISION(kFP16),
+                        DATALAYOUT(kImageDefault)> {
+ public:
+  using param_t = operators::ElementwiseChainParam;
+
+  std::string doc() const override {
+    return "ElementwiseChain using cl::Image2D(ImageDefault/RGBA), "
+           "generated kernel";
+  }
+
+  void PrepareForRun() override {
+    auto& param = this->Param<param_t>();
+    steps_ = lite::host::math::elementwise_chain_steps(param);
+    // the persistable inputs are converted with the dims aligned to the
+    // output, which the kernel reads like the inputs of the same rank
+    weights_images_.resize(param.X.size());
+    for (size_t i = 0; i < param.X.size(); i++) {
+      auto* x = param.X[i];
+      if (!x->persistable()) continue;
+      const DDim dims(Pad4(param.x_aligned_dims[i]));
+      CLImageConverterDefault converter;
+      const DDim image_dims = converter.InitImageDimInfoWith(dims);
+      std::unique_ptr<Tensor> cpu_image(new Tensor);
+      cpu_image->Resize({1, image_dims[0], image_dims[1], 4});
+      auto* cpu_image_data = MUTABLE_DATA_CPU(cpu_image);
+      auto* x_data = static_cast<float*>(const_cast<void*>(x->raw_data()));
+      converter.NCHWToImage(x_data, cpu_image_data, dims);
+      weights_images_[i].reset(new Tensor);
+      MUTABLE_DATA_GPU(
+          weights_images_[i], image_dims[0], image_dims[1], cpu_image_data);
+    }
+  }
+
+#ifdef LITE_WITH_PROFILE
+  void SetProfileRuntimeKernelInfo(paddle::lite::profile::OpCharacter* ch) {
+    ch->kernel_func_name = kernel_func_name_;
+    ch->global_work_size = ch->NDRangeToStr(gws_);
+    ch->cl_event =
+        event_;  // `event_` defined in `kernel.h`, valid after kernel::Run
+  }
+#endif
+
+  void ReInitWhenNeeded() override {
+    auto& param = this->Param<param_t>();
+    if (!first_epoch_for_reinit_ && param.x_aligned_dims == last_x_dims_ &&
+        param.Out->dims() == last_out_dims_) {
+      return;
+    }
+    first_epoch_for_reinit_ = false;
+    last_x_dims_ = param.x_aligned_dims;
+    last_out_dims_ = param.Out->dims();
+    CHECK_LE(last_out_dims_.size(), 4UL)
+        << "The OpenCL elementwise chain supports up to 4-D tensors";
+    out_nchw_ = Pad4(last_out_dims_.Vectorize());
+
+    // the kernel is only regenerated when the broadcast of an input changes
+    std::string source = GenerateSource();
+    if (source != source_) {
+      source_ = source;
+      auto& context = ctx_->As<OpenCLContext>();
+      STL::stringstream time_stamp;
+      time_stamp << time_stamp_ << std::hash<std::string>()(source_);
+      context.cl_context()->AddKernel(kernel_func_name_,
+                                      kernel_func_paths_,
+                                      source_,
+                                      build_options_,
+                                      time_stamp.str());
+      STL::stringstream kernel_key;
+      kernel_key << kernel_func_name_ << build_options_ << time_stamp.str();
+      kernel_ = context.cl_context()->GetKernel(kernel_key.str());
+    }
+
+    gws_ = cl::NDRange{
+        static_cast<cl::size_type>(out_nchw_[3] * maptofactor(out_nchw_[1], 4)),
+        static_cast<cl::size_type>(out_nchw_[0] * out_nchw_[2]),
+        static_cast<cl::size_type>(1)};
+  }
+
+  void Run() override {
+    auto& param = this->Param<param_t>();
+    auto& context = ctx_->As<OpenCLContext>();
+    CHECK(context.cl_context() != nullptr);
+    auto out_image_shape = InitImageDimInfoWith(DDim(out_nchw_));
+    auto* out_img = MUTABLE_DATA_GPU(param.Out,
+                                     out_image_shape["width"],
+                                     out_image_shape["height"],
+                                     nullptr);
+    int arg_idx = 0;
+    cl_int status;
+    for (size_t i = 0; i < param.X.size(); i++) {
+      const auto* x_img = weights_images_[i]
+                              ? GET_DATA_GPU(weights_images_[i])
+                              : GET_DATA_GPU(param.X[i]);
+      status = kernel_.setArg(arg_idx++, *x_img);
+      CL_CHECK_FATAL(status);
+    }
+    status = kernel_.setArg(arg_idx++, *out_img);
+    CL_CHECK_FATAL(status);
+    status = kernel_.setArg(arg_idx++, ToInt4(out_nchw_));
+    CL_CHECK_FATAL(status);
+    for (size_t i = 0; i < param.X.size(); i++) {
+      if (read_kinds_[i] != ReadKind::kGeneral) continue;
+      status = kernel_.setArg(arg_idx++, ToInt4(ImageDims(i)));
+      CL_CHECK_FATAL(status);
+      const auto aligned = Pad4(param.x_aligned_dims[i]);
+      status = kernel_.setArg(arg_idx++, ToInt4(aligned));
+      CL_CHECK_FATAL(status);
+    }
+
+    status = EnqueueNDRangeKernel(
+        context, kernel_, cl::NullRange, gws_, cl::NullRange, nullptr, event_);
+    CL_CHECK_FATAL(status);
+  }
+
+ private:
+  // How an input is read for an output pixel.
+  enum class ReadKind {
+    // the pixel of the same position, or of 0 in the broadcast dims
+    kPixel,
+    // the first channel of the pixel, for the inputs broadcast in channels
+    kChannel,
+    // the 4 channels one by one, for the inputs which the image holds in
+    // other dims than the ones aligned to the output
+    kGeneral,
+  };
+
+  static std::vector<int64_t> Pad4(std::vector<int64_t> dims) {
+    while (dims.size() < 4) {
+      dims.insert(dims.begin(), 1);
+    }
+    return dims;
+  }
+
+  static cl_int4 ToInt4(const std::vector<int64_t>& nchw) {
+    return {static_cast<int>(nchw[0]),
+            static_cast<int>(nchw[1]),
+            static_cast<int>(nchw[2]),
+            static_cast<int>(nchw[3])};
+  }
+
+  static std::string FloatLiteral(float value) {
+    CHECK(std::isfinite(value)) << "Invalid param of the elementwise chain";
+    STL::stringstream ss;
+    ss << std::scientific << std::setprecision(9) << value << "f";
+    return ss.str();
+  }
+
+  // The NCHW dims of the image of the input i.
+  std::vector<int64_t> ImageDims(size_t i) {
+    auto& param = this->Param<param_t>();
+    if (weights_images_[i]) return Pad4(param.x_aligned_dims[i]);
+    return Pad4(param.X[i]->dims().Vectorize());
+  }
+
+  // The expression of the step on the chain value a and the operand b.
+  std::string StepExpr(const lite::host::math::ElementwiseChainStep& step,
+                       const std::string& a,
+                       const std::string& b) {
+    const std::string alpha = FloatLiteral(step.alpha);
+    const std::string beta = FloatLiteral(step.beta);
+    const std::string gamma = FloatLiteral(step.gamma);
+    switch (step.op) {
+      case ChainOp::kAdd:
+        return a + " + " + b;
+      case ChainOp::kSub:
+        return a + " - " + b;
+      case ChainOp::kMul:
+        return a + " * " + b;
+      case ChainOp::kDiv:
+        return a + " / " + b;
+      case ChainOp::kMax:
+        return "fmax(" + a + ", " + b + ")";
+      case ChainOp::kMin:
+        return "fmin(" + a + ", " + b + ")";
+      case ChainOp::kRelu:
+        return "fmax(" + a + ", (float4)(0.f))";
+      case ChainOp::kRelu6:
+        return "fmin(fmax(" + a + ", (float4)(0.f)), (float4)(" + alpha + "))";
+      case ChainOp::kLeakyRelu:
+        return "select(" + a + " * " + alpha + ", " + a + ", " + a +
+               " > (float4)(0.f))";
+      case ChainOp::kSigmoid:
+        return "1.f / (1.f + exp(-" + a + "))";
+      case ChainOp::kTanh:
+        return "tanh(" + a + ")";
+      case ChainOp::kSwish:
+        return a + " / (1.f + exp(-" + alpha + " * " + a + "))";
+      case ChainOp::kHardSigmoid:
+        return "clamp(" + a + " * " + alpha + " + " + beta + ", 0.f, 1.f)";
+      case ChainOp::kHardSwish:
+        return "fmin(fmax(" + a + " + " + gamma + ", (float4)(0.f)), " +
+               "(float4)(" + alpha + ")) * " + a + " / " + beta;
+      case ChainOp::kExp:
+        return "exp(" + a + ")";
+      case ChainOp::kAbs:
+        return "fabs(" + a + ")";
+      case ChainOp::kSquare:
+        return a + " * " + a;
+      case ChainOp::kSqrt:
+        return "sqrt(" + a + ")";
+      case ChainOp::kScale:
+        if (step.gamma != 0.f) {
+          return a + " * " + alpha + " + " + beta;
+        }
+        return "(" + a + " + " + beta + ") * " + alpha;
+    }
+    LOG(FATAL) << "Unsupported op of the elementwise chain";
+    return "";
+  }
+
+  // The source of the kernel for the current dims of the inputs, which
+  // selects how each input is read. The dims themselves are the args.
+  std::string GenerateSource() {
+    auto& param = this->Param<param_t>();
+    const int num_x = static_cast<int>(param.X.size());
+    const int num_steps = static_cast<int>(steps_.size());
+    const char* dims_name[] = {"n", "c4", "h", "w"};
+    read_kinds_.assign(num_x, ReadKind::kPixel);
+
+    STL::stringstream args;
+    STL::stringstream body;
+    for (int i = 0; i < num_x; i++) {
+      args << "__read_only image2d_t x" << i << ",\n";
+    }
+    args << "__write_only image2d_t out,\nint4 out_dims";
+    body << "int cw = get_global_id(0);\nint nh = get_global_id(1);\n"
+         << "int w = cw % out_dims.w;\nint c4 = cw / out_dims.w;\n"
+         << "int h = nh % out_dims.z;\nint n = nh / out_dims.z;\n";
+    for (int i = 0; i < num_x; i++) {
+      const auto aligned = Pad4(param.x_aligned_dims[i]);
+      // the dims broadcast to the ones of the output
+      bool broadcast[4];
+      for (int d = 0; d < 4; d++) {
+        broadcast[d] = aligned[d] == 1 && out_nchw_[d] != 1;
+      }
+      if (ImageDims(i) != aligned) {
+        read_kinds_[i] = ReadKind::kGeneral;
+        args << ",\nint4 x" << i << "_dims,\nint4 x" << i << "_aligned";
+        body << "float4 v" << i << " = elementwise_chain_read_general(x" << i
+             << ", x" << i << "_dims, x" << i << "_aligned, n, c4, h, w);\n";
+        continue;
+      }
+      std::string idx[4];
+      for (int d = 0; d < 4; d++) {
+        idx[d] = broadcast[d] ? "0" : dims_name[d];
+      }
+      const std::string in_w = broadcast[3] ? "1" : "out_dims.w";
+      const std::string in_h = broadcast[2] ? "1" : "out_dims.z";
+      const std::string pos = "(int2)(" + idx[1] + " * " + in_w + " + " +
+                              idx[3] + ", " + idx[0] + " * " + in_h + " + " +
+                              idx[2] + ")";
+      const std::string read =
+          "convert_float4(READ_IMG_TYPE(CL_DTYPE_CHAR, x" + std::to_string(i) +
+          ", SAMPLER, " + pos + "))";
+      if (broadcast[1]) {
+        read_kinds_[i] = ReadKind::kChannel;
+        body << "float4 v" << i << " = (float4)(" << read << ".x);\n";
+      } else {
+        body << "float4 v" << i << " = " << read << ";\n";
+      }
+    }
+    for (int s = 0; s < num_steps; s++) {
+      const auto& step = steps_[s];
+      std::string a = "v" + std::to_string(s == 0 ? 0 : num_x + s - 1);
+      std::string b;
+      if (step.operand >= 0) {
+        b = "v" + std::to_string(step.operand);
+        if (step.operand_first) std::swap(a, b);
+      }
+      body << "float4 v" << num_x + s << " = " << StepExpr(step, a, b)
+           << ";\n";
+    }
+    body << "WRITE_IMG_TYPE(CL_DTYPE_CHAR, out, (int2)(cw, nh), "
+         << "CONVERT_TYPE_TO(v" << num_x + num_steps - 1 << ", CL_DTYPE4));\n";
+
+    STL::stringstream source;
+    source << "__kernel void " << kernel_func_name_ << "(" << args.str()
+           << ") {\n"
+           << body.str() << "}\n";
+    return source.str();
+  }
+
+  std::vector<lite::host::math::ElementwiseChainStep> steps_;
+  std::vector<std::unique_ptr<Tensor>> weights_images_;
+  std::vector<ReadKind> read_kinds_;
+  bool first_epoch_for_reinit_{true};
+  std::vector<std::vector<int64_t>> last_x_dims_;
+  DDim last_out_dims_;
+  std::vector<int64_t> out_nchw_{};
+  std::string source_{};
+  std::string kernel_func_name_{"elementwise_chain"};
+  std::string kernel_func_paths_{"image/elementwise_chain_kernel.cl"};
+  std::string build_options_{};
+  std::string time_stamp_{GetTimeStamp()};
+  cl::Kernel kernel_;
+  cl::NDRange gws_;
+};
+
+}  // namespace opencl
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+namespace ocl = paddle::lite::kernels::opencl;
+REGISTER_LITE_KERNEL(fusion_elementwise_chain,
+                     kOpenCL,
+                     kFP16,
+                     kImageDefault,
+                     ocl::ElementwiseChainImageCompute,
+                     def)
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kOpenCL),
+                                      PRECISION(kFP16),
+                                      DATALAYOUT(kImageDefault))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kOpenCL),
+                                       PRECISION(kFP16),
+                                       DATALAYOUT(kImageDefault))})
+    .Finalize();
@@ -0,0 +1,153 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "lite/backends/opencl/cl_image_converter.h"
+#include "lite/backends/opencl/target_wrapper.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/tensor.h"
+#include "lite/kernels/opencl/test_helper.h"
+
+#define FP32_ABS_DIFF (1e-4)
+#define FP16_ABS_DIFF (5e-2)
+
+namespace paddle {
+namespace lite {
+
+static void fill_data(float* data, int64_t size) {
+  for (int64_t i = 0; i < size; ++i) {
+    data[i] = static_cast<float>((i * 7) % 23 - 11) / 11.f;
+  }
+}
+
+// Uploads the NCHW data to the image of the tensor.
+static void upload(Tensor* tensor, const std::vector<float>& data) {
+  CLImageConverterDefault converter;
+  const DDim image_dims = converter.InitImageDimInfoWith(tensor->dims());
+  const size_t dtype_size =
+      CLRuntime::Global()->get_precision() == lite_api::CL_PRECISION_FP16
+          ? sizeof(half_t)
+          : sizeof(float);
+  std::vector<char> image(image_dims.production() * 4 * dtype_size);
+  converter.NCHWToImage(
+      const_cast<float*>(data.data()), image.data(), tensor->dims());
+  MUTABLE_DATA_GPU(tensor, image_dims[0], image_dims[1], image.data());
+}
+
+// ((x - bias[c]) * scale) * sigmoid(...) + y, clipped by relu6, with the
+// 1-D bias which the image holds in the width, the persistable scalar scale
+// and the y of the same dims, which are read in the 3 ways of the kernel.
+TEST(elementwise_chain_image, swish_with_broadcast) {
+  for (auto precision : {lite_api::CL_PRECISION_FP32,
+                         lite_api::CL_PRECISION_FP16}) {
+    for (int n : {1, 2}) {
+      for (int c : {3, 16}) {
+        for (int hw : {1, 7}) {
+          std::unique_ptr<KernelContext> context(new KernelContext);
+          context->As<OpenCLContext>().InitOnce();
+          CLRuntime::Global()->set_precision(precision);
+          auto kernels =
+              KernelRegistry::Global().Create("fusion_elementwise_chain",
+                                              TARGET(kOpenCL),
+                                              PRECISION(kFP16),
+                                              DATALAYOUT(kImageDefault));
+          ASSERT_FALSE(kernels.empty());
+          auto kernel = std::move(kernels.front());
+
+          const DDim dims({n, c, hw, hw});
+          Tensor x, bias, scale, y, out;
+          x.Resize(dims);
+          bias.Resize({c});
+          scale.Resize({1});
+          y.Resize(dims);
+          out.Resize(dims);
+          std::vector<float> x_data(dims.production());
+          std::vector<float> bias_data(c);
+          std::vector<float> y_data(dims.production());
+          fill_data(x_data.data(), x_data.size());
+          fill_data(bias_data.data(), bias_data.size());
+          fill_data(y_data.data(), y_data.size());
+          std::reverse(y_data.begin(), y_data.end());
+          upload(&x, x_data);
+          upload(&bias, bias_data);
+          upload(&y, y_data);
+          scale.mutable_data<float>()[0] = 1.5f;
+          scale.set_persistable(true);
+
+          operators::ElementwiseChainParam param;
+          param.X = {&x, &bias, &scale, &y};
+          param.Out = &out;
+          param.step_types = {"elementwise_sub",
+                              "elementwise_mul",
+                              "sigmoid",
+                              "elementwise_mul",
+                              "elementwise_add",
+                              "relu6"};
+          // the results of the steps follow the 4 inputs
+          param.operands = {1, 2, -1, 5, 3, -1};
+          param.operand_first = {0, 1, 0, 0, 0, 0};
+          param.axes = {1, -1, -1, -1, -1, -1};
+          param.alphas = {0.f, 0.f, 0.f, 0.f, 0.f, 6.f};
+          param.betas.assign(6, 0.f);
+          param.gammas.assign(6, 0.f);
+          param.x_aligned_dims = {
+              {n, c, hw, hw}, {1, c, 1, 1}, {1, 1, 1, 1}, {n, c, hw, hw}};
+          kernel->SetParam(param);
+          kernel->SetContext(std::move(context));
+          kernel->Launch();
+          CLRuntime::Global()->command_queue().finish();
+
+          CLImageConverterDefault converter;
+          const DDim out_image_dims = converter.InitImageDimInfoWith(dims);
+          const size_t dtype_size = precision == lite_api::CL_PRECISION_FP16
+                                        ? sizeof(half_t)
+                                        : sizeof(float);
+          std::vector<char> out_image(out_image_dims.production() * 4 *
+                                      dtype_size);
+          TargetWrapperCL::ImgcpySync(out_image.data(),
+                                      GET_DATA_GPU(&out),
+                                      out_image_dims[0],
+                                      out_image_dims[1],
+                                      0,
+                                      0,
+                                      IoDirection::DtoH);
+          std::vector<float> out_data(dims.production());
+          converter.ImageToNCHW(
+              out_image.data(), out_data.data(), out_image_dims, dims);
+
+          const int size = hw * hw;
+          const float abs_diff =
+              precision == lite_api::CL_PRECISION_FP16 ? FP16_ABS_DIFF
+                                                       : FP32_ABS_DIFF;
+          for (int64_t i = 0; i < dims.production(); ++i) {
+            float t = (x_data[i] - bias_data[(i / size) % c]) * 1.5f;
+            float ref = t * (1.f / (1.f + std::exp(-t))) + y_data[i];
+            ref = std::min(std::max(ref, 0.f), 6.f);
+            EXPECT_NEAR(out_data[i], ref, abs_diff);
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(fusion_elementwise_chain, kOpenCL, kFP16, kImageDefault, def);
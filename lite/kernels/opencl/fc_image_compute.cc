@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
+#include <string>
+#include <vector>
 #include "lite/core/op_registry.h"
 #include "lite/kernels/opencl/image_helper.h"
 
@@ -32,6 +35,16 @@ class FcImageCompute : public KernelLite<TARGET(kOpenCL),
     const auto bias_t = param.bias;
     has_bias_ = (bias_t == nullptr) ? false : true;
 
+    // The int8 weights of the quantized model are computed by the int8 dot
+    // product if the device supports it, or dequantized to the float ones.
+    const bool int8_weight = w_t->precision() == PRECISION(kInt8);
+    if (int8_weight) {
+      CHECK(!param.weight_scale.empty())
+          << "The int8 weight of fc has no scales.";
+    }
+    use_int8_ = int8_weight && param.enable_int8 && param.input_scale > 0.f &&
+                CLRuntime::Global()->support_int8_dot();
+
     // Runtime precision can be forced to fp32 to avoid the loss of accuracy
     // when K is larger than thres_k.
     // But this will increase the running time of fc because running time under
@@ -42,7 +55,7 @@ class FcImageCompute : public KernelLite<TARGET(kOpenCL),
     bool precision_forced_to_fp32 = false;
     const bool enable_fp16 =
         CLRuntime::Global()->get_precision() == lite_api::CL_PRECISION_FP16;
-    if (enable_fp16) {
+    if (enable_fp16 && !use_int8_) {
       k_ = x_dims.Slice(param.in_num_col_dims, x_dims.size()).production();
       if (k_ > thres_k) {
         CLRuntime::Global()->set_precision(lite_api::CL_PRECISION_FP32);
@@ -67,11 +80,22 @@ class FcImageCompute : public KernelLite<TARGET(kOpenCL),
     w_ext_dims[0] = ROUND_UP(w_dims[0], 4);
     w_ext_dims[1] = ROUND_UP(w_dims[1], 4);
     w_cpu_t->Resize(w_ext_dims);
-    auto* w_buffer_data = MUTABLE_DATA_CPU(w_cpu_t.get());
-    size_t buf_size = w_cpu_t->memory_size();
-
-    auto* w_cpu = param.w->mutable_data<float>();
-    OI2OIO4I4(w_cpu, w_buffer_data, w_dims[0], w_dims[1]);
+    if (use_int8_) {
+      auto* w_buffer_data = w_cpu_t->mutable_data<int8_t>();
+      OI2OIO4I4Int8(
+          param.w->data<int8_t>(), w_buffer_data, w_dims[0], w_dims[1]);
+      InitDequantScales(param, w_ext_dims[1]);
+      build_options_ += CLRuntime::Global()->int8_dot_build_options();
+    } else {
+      auto* w_buffer_data = MUTABLE_DATA_CPU(w_cpu_t.get());
+      Tensor w_float_t;
+      if (int8_weight) {
+        DequantizeWeight(*param.w, param.weight_scale, &w_float_t);
+      }
+      auto* w_cpu = int8_weight ? w_float_t.mutable_data<float>()
+                                : param.w->mutable_data<float>();
+      OI2OIO4I4(w_cpu, w_buffer_data, w_dims[0], w_dims[1]);
+    }
 
     auto* w_gpu_data =
         w_gpu_t_->mutable_data(TARGET(kOpenCL), w_cpu_t->memory_size());
@@ -162,7 +186,7 @@ class FcImageCompute : public KernelLite<TARGET(kOpenCL),
       k_blks_ = UP_DIV(k_, 4);
       n_blks_ = UP_DIV(n_, 4);
 
-      kernel_func_name_ = "fc";
+      kernel_func_name_ = use_int8_ ? "fc_int8" : "fc";
 #ifdef LITE_WITH_LOG
       VLOG(1) << "kernel_func_name_:" << kernel_func_name_;
       VLOG(4) << "x_dims:" << x_dims;
@@ -292,6 +316,10 @@ class FcImageCompute : public KernelLite<TARGET(kOpenCL),
     CL_CHECK_FATAL(status);
     status = kernel.setArg(arg_idx++, *w_buf_);
     CL_CHECK_FATAL(status);
+    if (use_int8_) {
+      status = kernel.setArg(arg_idx++, *dequant_scales_buf_);
+      CL_CHECK_FATAL(status);
+    }
     if (has_bias_) {
       status = kernel.setArg(arg_idx++, *bias_img_);
       CL_CHECK_FATAL(status);
@@ -306,6 +334,10 @@ class FcImageCompute : public KernelLite<TARGET(kOpenCL),
     CL_CHECK_FATAL(status);
     status = kernel.setArg(arg_idx++, n_blks_);
     CL_CHECK_FATAL(status);
+    if (use_int8_) {
+      status = kernel.setArg(arg_idx++, 1.f / param.input_scale);
+      CL_CHECK_FATAL(status);
+    }
 
     auto& context = ctx_->As<OpenCLContext>();
     CHECK(context.cl_context() != nullptr);
@@ -449,6 +481,71 @@ class FcImageCompute : public KernelLite<TARGET(kOpenCL),
     }
   }
 
+  // The same blocks as OI2OIO4I4 for the int8 weights, but each block is
+  // transposed, so the 4 input channels of an output channel are contiguous
+  // for the int8 dot product.
+  void OI2OIO4I4Int8(const int8_t* src, int8_t* dst, size_t O, size_t I) {
+    size_t i_blocks = UP_DIV(I, 4);
+    size_t o_blocks = UP_DIV(O, 4);
+    size_t dst_index = 0;
+    for (size_t block_y = 0; block_y < o_blocks; block_y++) {
+      for (size_t block_x = 0; block_x < i_blocks; block_x++) {
+        for (size_t x_in_block = 0; x_in_block < 4; x_in_block++) {
+          const size_t x = block_x * 4 + x_in_block;
+          for (size_t y_in_block = 0; y_in_block < 4; y_in_block++) {
+            const size_t y = block_y * 4 + y_in_block;
+            dst[dst_index++] = (y < O && x < I) ? src[y * I + x] : 0;
+          }
+        }
+      }
+    }
+  }
+
+  // The scales dequantizing the int32 sums of the output channels, padded to
+  // `n_ext` channels.
+  void InitDequantScales(const operators::FcParam& param, size_t n_ext) {
+    const auto& weight_scale = param.weight_scale;
+    size_t n = param.w->dims()[1];
+    CHECK(weight_scale.size() == 1 || weight_scale.size() == n)
+        << "The size of the weight scales of fc should be 1 or " << n
+        << ", but got " << weight_scale.size();
+    std::vector<float> scales(n_ext, 0.f);
+    for (size_t i = 0; i < n; i++) {
+      float scale =
+          weight_scale.size() == 1 ? weight_scale[0] : weight_scale[i];
+      scales[i] = param.input_scale * scale;
+    }
+    dequant_scales_gpu_t_ = std::unique_ptr<Tensor>(new Tensor);
+    auto* scales_gpu_data = dequant_scales_gpu_t_->mutable_data(
+        TARGET(kOpenCL), scales.size() * sizeof(float));
+    TargetWrapperCL::MemcpySync(scales_gpu_data,
+                                scales.data(),
+                                scales.size() * sizeof(float),
+                                IoDirection::HtoD);
+    dequant_scales_buf_ = GET_BUFFER_GPU(dequant_scales_gpu_t_);
+  }
+
+  // Dequantize the int8 weight of KxN by the scales of the output channels.
+  void DequantizeWeight(const Tensor& w,
+                        const std::vector<float>& weight_scale,
+                        Tensor* w_float) {
+    size_t k = w.dims()[0];
+    size_t n = w.dims()[1];
+    CHECK(weight_scale.size() == 1 || weight_scale.size() == n)
+        << "The size of the weight scales of fc should be 1 or " << n
+        << ", but got " << weight_scale.size();
+    w_float->Resize(w.dims());
+    auto* src = w.data<int8_t>();
+    auto* dst = w_float->mutable_data<float>();
+    for (size_t i = 0; i < k; i++) {
+      for (size_t j = 0; j < n; j++) {
+        float scale =
+            weight_scale.size() == 1 ? weight_scale[0] : weight_scale[j];
+        dst[i * n + j] = src[i * n + j] * scale;
+      }
+    }
+  }
+
  private:
   int m_, n_, k_, k_blks_, n_blks_;
   std::string kernel_func_name_{};
@@ -457,6 +554,7 @@ class FcImageCompute : public KernelLite<TARGET(kOpenCL),
   DDim last_x_dims_;
   bool first_epoch_for_reinit_{true};
   bool has_bias_{false};
+  bool use_int8_{false};
 
   cl::Kernel kernel_;
   cl::Kernel kernel_input_layout_;
@@ -466,6 +564,7 @@ class FcImageCompute : public KernelLite<TARGET(kOpenCL),
 
   std::unique_ptr<Tensor> w_gpu_t_{nullptr};
   std::unique_ptr<Tensor> bias_gpu_t_{nullptr};
+  std::unique_ptr<Tensor> dequant_scales_gpu_t_{nullptr};
   std::unique_ptr<Tensor> alpha_gpu_t_{nullptr};
   std::unique_ptr<Tensor> layout_input_image_{nullptr};
   std::unique_ptr<Tensor> layout_output_image_{nullptr};
@@ -474,6 +573,7 @@ class FcImageCompute : public KernelLite<TARGET(kOpenCL),
   cl::Image2D* out_img_src_{nullptr};
   cl::Image2D* out_img_{nullptr};
   const cl::Buffer* w_buf_{nullptr};
+  const cl::Buffer* dequant_scales_buf_{nullptr};
   cl::Image2D* bias_img_{nullptr};
   cl::Image2D* alpha_img_{nullptr};
 };
@@ -494,7 +594,7 @@ REGISTER_LITE_KERNEL(fc,
                                       PRECISION(kFP16),
                                       DATALAYOUT(kImageFolder))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kHost))})
-    .BindInput("W", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("W", {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kAny))})
     .BindInput("Alpha", {LiteType::GetTensorTy(TARGET(kHost))})
     .BindOutput("Out",
                 {LiteType::GetTensorTy(TARGET(kOpenCL),
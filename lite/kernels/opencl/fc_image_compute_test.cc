@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
 #include "lite/backends/opencl/cl_image_converter.h"
 #include "lite/backends/opencl/target_wrapper.h"
 #include "lite/core/op_registry.h"
@@ -79,14 +81,16 @@ void test(const lite_api::CLPrecisionType p,
           const bool bias_flag,
           const int m,
           const int n,
-          const int k) {
+          const int k,
+          const bool int8_flag = false) {
   std::unique_ptr<KernelContext> context(new KernelContext);
   context->As<OpenCLContext>().InitOnce();
   CLRuntime::Global()->set_precision(p);
   const bool fp16_flag = (p == lite_api::CLPrecisionType::CL_PRECISION_FP16);
   LOG(INFO) << "\n\t[  START  ] Test Precision="
             << lite_api::CLPrecisionTypeToStr(p) << " bias_flag=" << bias_flag
-            << " m=" << m << " n=" << n << " k=" << k;
+            << " m=" << m << " n=" << n << " k=" << k
+            << " int8_flag=" << int8_flag;
 
   auto kernels = KernelRegistry::Global().Create(
       "fc", TARGET(kOpenCL), PRECISION(kFP16), DATALAYOUT(kImageFolder));
@@ -102,11 +106,6 @@ void test(const lite_api::CLPrecisionType p,
   param.output = &out;
   param.in_num_col_dims = 1;
 
-  kernel->SetParam(param);
-  std::unique_ptr<KernelContext> fc_context(new KernelContext);
-  context->As<OpenCLContext>().CopySharedTo(&(fc_context->As<OpenCLContext>()));
-  kernel->SetContext(std::move(fc_context));
-
   const DDim x_dim = DDim(std::vector<DDim::value_type>{m, k});
   const DDim w_dim = DDim(std::vector<DDim::value_type>{k, n});
   const DDim bias_dim = DDim(std::vector<DDim::value_type>{n});
@@ -141,7 +140,28 @@ void test(const lite_api::CLPrecisionType p,
   auto* out_image =
       MUTABLE_DATA_GPU(&out, out_image_shape[0], out_image_shape[1], nullptr);
 
-  w.Assign<float, lite::DDim, TARGET(kARM)>(w_source.data(), w_dim);
+  if (int8_flag) {
+    // Quantize the weight by the scales of the output channels, the input in
+    // [-1, 1] is quantized by 1 / 127 in the kernel.
+    std::vector<int8_t> w_int8(w_dim.production());
+    param.weight_scale.assign(n, 0.f);
+    for (int j = 0; j < n; j++) {
+      float max_abs = 0.f;
+      for (int i = 0; i < k; i++) {
+        max_abs = std::max(max_abs, std::abs(w_source[i * n + j]));
+      }
+      param.weight_scale[j] = max_abs > 0.f ? max_abs / 127.f : 1.f;
+      for (int i = 0; i < k; i++) {
+        w_int8[i * n + j] = static_cast<int8_t>(
+            std::round(w_source[i * n + j] / param.weight_scale[j]));
+      }
+    }
+    param.enable_int8 = true;
+    param.input_scale = 1.f / 127.f;
+    w.Assign<int8_t, lite::DDim, TARGET(kARM)>(w_int8.data(), w_dim);
+  } else {
+    w.Assign<float, lite::DDim, TARGET(kARM)>(w_source.data(), w_dim);
+  }
 
   if (bias_flag) {
     bias.Resize(bias_dim);
@@ -150,6 +170,11 @@ void test(const lite_api::CLPrecisionType p,
     bias.Assign<float, lite::DDim, TARGET(kARM)>(bias_source.data(), bias_dim);
   }
 
+  kernel->SetParam(param);
+  std::unique_ptr<KernelContext> fc_context(new KernelContext);
+  context->As<OpenCLContext>().CopySharedTo(&(fc_context->As<OpenCLContext>()));
+  kernel->SetContext(std::move(fc_context));
+
   // run opencl kernel
   kernel->Launch();
   CLRuntime::Global()->command_queue().finish();
@@ -213,7 +238,7 @@ void test(const lite_api::CLPrecisionType p,
   LOG(INFO) << "\n\t[  PASSED  ] "
             << " Test Precision=" << lite_api::CLPrecisionTypeToStr(p)
             << " bias_flag=" << bias_flag << " m=" << m << " n=" << n
-            << " k=" << k;
+            << " k=" << k << " int8_flag=" << int8_flag;
 }
 
 TEST(fc, compute_basic) {
@@ -235,6 +260,25 @@ TEST(fc, compute_basic) {
   }
 }
 
+TEST(fc, compute_int8) {
+  // The int8 dot product is used if the device supports it, or the weight is
+  // dequantized to fp16.
+  for (const bool bias_flag : {false, true}) {
+    for (auto m = 1; m <= 2; m++) {
+      for (auto n = 1; n <= 9; n += 4) {
+        for (auto k = 1; k <= 33; k += 8) {
+          test(lite_api::CLPrecisionType::CL_PRECISION_FP16,
+               bias_flag,
+               m,
+               n,
+               k,
+               true);
+        }
+      }
+    }
+  }
+}
+
 }  // namespace lite
 }  // namespace paddle
 
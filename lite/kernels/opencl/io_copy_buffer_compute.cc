@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstring>
+#include <memory>
 #include "lite/backends/opencl/target_wrapper.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
@@ -99,12 +101,64 @@ class IoCopyHostToOpenCLCompute
     VLOG(2) << "param.y->dims().size():" << param.y->dims().size();
     VLOG(2) << "param.y->dims():" << param.y->dims();
 #endif
+    CHECK(param.x->raw_data());
+    if (ShareHostMemory(param.x, param.y)) return;
     auto* data = param.y->mutable_data(TARGET(kOpenCL), mem_size);
     CHECK(data);
-    CHECK(param.x->raw_data());
     h2d_duration_ = CopyFromHostSync(data, param.x->raw_data(), mem_size);
   }
 
+  // Wrap the host memory of `x` into a cl::Buffer as `y` instead of copying
+  // it, on the devices sharing the memory with the cpu. The buffer is kept
+  // while `x` stays in place, and is mapped and unmapped in each run to make
+  // the data written by the cpu visible to the gpu.
+  bool ShareHostMemory(const Tensor* x, Tensor* y) {
+    auto& device_info = CLRuntime::Global()->GetDeviceInfo();
+    if (!device_info["CL_DEVICE_HOST_UNIFIED_MEMORY"]) return false;
+    size_t alignment = device_info["CL_DEVICE_MEM_BASE_ADDR_ALIGN"] / 8;
+    auto* host_ptr = const_cast<void*>(x->raw_data());
+    auto mem_size = x->memory_size();
+    if (alignment == 0 ||
+        reinterpret_cast<uintptr_t>(host_ptr) % alignment != 0) {
+      return false;
+    }
+#ifdef LITE_WITH_PROFILE
+    lite::Timer timer;
+    timer.Start();
+#endif
+    cl_int status;
+    if (host_ptr != shared_host_ptr_ || mem_size != shared_size_) {
+      shared_buffer_.reset(
+          new cl::Buffer(CLRuntime::Global()->context(),
+                         CL_MEM_READ_ONLY | CL_MEM_USE_HOST_PTR,
+                         mem_size,
+                         host_ptr,
+                         &status));
+      CL_CHECK_FATAL(status);
+      shared_host_ptr_ = host_ptr;
+      shared_size_ = mem_size;
+    }
+    auto& queue = CLRuntime::Global()->command_queue();
+    void* mapped_ptr = queue.enqueueMapBuffer(*shared_buffer_,
+                                              CL_TRUE,
+                                              CL_MAP_WRITE,
+                                              0,
+                                              mem_size,
+                                              nullptr,
+                                              nullptr,
+                                              &status);
+    CL_CHECK_FATAL(status);
+    // The driver may map a copy instead of the host memory.
+    if (mapped_ptr != host_ptr) memcpy(mapped_ptr, host_ptr, mem_size);
+    status = queue.enqueueUnmapMemObject(*shared_buffer_, mapped_ptr);
+    CL_CHECK_FATAL(status);
+    y->ShareExternalMemory(shared_buffer_.get(), mem_size, TARGET(kOpenCL));
+#ifdef LITE_WITH_PROFILE
+    h2d_duration_ = timer.Stop();
+#endif
+    return true;
+  }
+
   std::unique_ptr<type_infer_handler_t> GetTypeInferHandler() override {
     std::unique_ptr<type_infer_handler_t> res(new type_infer_handler_t);
     *res = [](const std::map<std::string, const Type*>& inputs,
@@ -128,6 +182,9 @@ class IoCopyHostToOpenCLCompute
   std::string doc() const override { return "Copy IO from HOST to OpenCL"; }
 
   float h2d_duration_{0};
+  std::unique_ptr<cl::Buffer> shared_buffer_;
+  const void* shared_host_ptr_{nullptr};
+  size_t shared_size_{0};
 };
 
 /*
@@ -0,0 +1,151 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+#include "lite/kernels/vulkan/utils.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace vulkan {
+
+// conv2d and depthwise_conv2d by glsl/conv2d.comp, the filter and the bias
+// are uploaded once in PrepareForRun.
+class ConvCompute
+    : public KernelLite<TARGET(kVulkan), PRECISION(kFloat), DATALAYOUT(kNCHW)> {
+ public:
+  using param_t = operators::ConvParam;
+
+  struct Params {
+    int total;
+    int in_c;
+    int in_h;
+    int in_w;
+    int out_c;
+    int out_h;
+    int out_w;
+    int kernel_h;
+    int kernel_w;
+    int stride_h;
+    int stride_w;
+    int pad_h;
+    int pad_w;
+    int dilation_h;
+    int dilation_w;
+    int groups;
+    int has_bias;
+    int act_type;
+    float act_param;
+  };
+
+  void PrepareForRun() override {
+    auto& param = Param<param_t>();
+    CopyToVulkan(*param.filter, &filter_);
+    if (param.bias) {
+      CopyToVulkan(*param.bias, &bias_);
+    }
+    auto& context = ctx_->As<VulkanContext>();
+    pipeline_ = context.runtime()->GetPipeline("conv2d", 4, sizeof(Params));
+  }
+
+  void Run() override {
+    auto& param = Param<param_t>();
+    const auto& x_dims = param.x->dims();
+    const auto& filter_dims = param.filter->dims();
+    const auto& out_dims = param.output->dims();
+    const auto& paddings = *param.paddings;
+    const auto& dilations = *param.dilations;
+    CHECK_EQ(x_dims.size(), 4u);
+
+    Params params;
+    params.total = static_cast<int>(out_dims.production());
+    params.in_c = static_cast<int>(x_dims[1]);
+    params.in_h = static_cast<int>(x_dims[2]);
+    params.in_w = static_cast<int>(x_dims[3]);
+    params.out_c = static_cast<int>(out_dims[1]);
+    params.out_h = static_cast<int>(out_dims[2]);
+    params.out_w = static_cast<int>(out_dims[3]);
+    params.kernel_h = static_cast<int>(filter_dims[2]);
+    params.kernel_w = static_cast<int>(filter_dims[3]);
+    params.stride_h = param.strides[0];
+    params.stride_w = param.strides[1];
+    // paddings: [top, bottom, left, right], the bottom and right ones only
+    // affect the output dims.
+    params.pad_h = paddings[0];
+    params.pad_w = paddings[2];
+    params.dilation_h = dilations[0];
+    params.dilation_w = dilations[1];
+    params.groups = param.groups;
+    params.has_bias = param.bias ? 1 : 0;
+    const auto& act_param = param.activation_param;
+    params.act_type = act_param.has_active
+                          ? GetVulkanActType(act_param.active_type)
+                          : kVulkanActNone;
+    params.act_param =
+        act_param.active_type == lite_api::ActivationType::kLeakyRelu
+            ? act_param.Leaky_relu_alpha
+            : act_param.Relu_clipped_coef;
+
+    auto* filter_buffer = GetVKBuffer(&filter_);
+    // The filter is bound in place of the bias if there is no bias.
+    auto* bias_buffer = param.bias ? GetVKBuffer(&bias_) : filter_buffer;
+    auto& context = ctx_->As<VulkanContext>();
+    context.runtime()->Dispatch(pipeline_,
+                                {GetVKBuffer(param.x),
+                                 filter_buffer,
+                                 bias_buffer,
+                                 GetMutableVKBuffer(param.output)},
+                                &params,
+                                params.total);
+  }
+
+  std::string doc() const override { return "Conv2d using VKBuffer, kFloat"; }
+
+ private:
+  Tensor filter_;
+  Tensor bias_;
+  const VKPipeline* pipeline_{nullptr};
+};
+
+}  // namespace vulkan
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(conv2d,
+                     kVulkan,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::vulkan::ConvCompute,
+                     def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Output", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(depthwise_conv2d,
+                     kVulkan,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::vulkan::ConvCompute,
+                     def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("Filter", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Output", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
@@ -0,0 +1,174 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/backends/vulkan/target_wrapper.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/tensor.h"
+#include "lite/kernels/vulkan/utils.h"
+
+namespace paddle {
+namespace lite {
+
+void conv_compute_ref(const float* x,
+                      const float* filter,
+                      const float* bias,
+                      float* out,
+                      int ic,
+                      int ih,
+                      int iw,
+                      int oc,
+                      int oh,
+                      int ow,
+                      int kh,
+                      int kw,
+                      int stride,
+                      int pad,
+                      int groups,
+                      bool relu) {
+  int ic_per_group = ic / groups;
+  int oc_per_group = oc / groups;
+  for (int o = 0; o < oc; o++) {
+    int g = o / oc_per_group;
+    for (int y = 0; y < oh; y++) {
+      for (int z = 0; z < ow; z++) {
+        float sum = bias ? bias[o] : 0.f;
+        for (int c = 0; c < ic_per_group; c++) {
+          int ci = g * ic_per_group + c;
+          for (int i = 0; i < kh; i++) {
+            for (int j = 0; j < kw; j++) {
+              int iy = y * stride + i - pad;
+              int iz = z * stride + j - pad;
+              if (iy < 0 || iy >= ih || iz < 0 || iz >= iw) continue;
+              sum += x[(ci * ih + iy) * iw + iz] *
+                     filter[((o * ic_per_group + c) * kh + i) * kw + j];
+            }
+          }
+        }
+        out[(o * oh + y) * ow + z] = relu ? std::max(sum, 0.f) : sum;
+      }
+    }
+  }
+}
+
+void test_conv(const std::string& op_type,
+               int ic,
+               int oc,
+               int groups,
+               int stride,
+               bool has_bias,
+               bool relu) {
+  const int ih = 13, iw = 11, kh = 3, kw = 3, pad = 1;
+  const int oh = (ih + 2 * pad - kh) / stride + 1;
+  const int ow = (iw + 2 * pad - kw) / stride + 1;
+
+  auto kernels = KernelRegistry::Global().Create(
+      op_type, TARGET(kVulkan), PRECISION(kFloat), DATALAYOUT(kNCHW));
+  ASSERT_FALSE(kernels.empty());
+  auto kernel = std::move(kernels.front());
+
+  lite::Tensor x_host, x, filter, bias, out, out_host;
+  x_host.Resize({1, ic, ih, iw});
+  filter.Resize({oc, ic / groups, kh, kw});
+  bias.Resize({oc});
+  out.Resize({1, oc, oh, ow});
+
+  std::default_random_engine engine;
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+  auto* x_data = x_host.mutable_data<float>();
+  for (int64_t i = 0; i < x_host.numel(); i++) x_data[i] = dist(engine);
+  auto* filter_data = filter.mutable_data<float>();
+  for (int64_t i = 0; i < filter.numel(); i++) filter_data[i] = dist(engine);
+  auto* bias_data = bias.mutable_data<float>();
+  for (int64_t i = 0; i < bias.numel(); i++) bias_data[i] = dist(engine);
+  kernels::vulkan::CopyToVulkan(x_host, &x);
+
+  operators::ConvParam param;
+  param.x = &x;
+  param.filter = &filter;
+  param.bias = has_bias ? &bias : nullptr;
+  param.output = &out;
+  param.strides = {stride, stride};
+  param.paddings = std::make_shared<std::vector<int>>(
+      std::vector<int>{pad, pad, pad, pad});
+  param.dilations =
+      std::make_shared<std::vector<int>>(std::vector<int>{1, 1});
+  param.groups = groups;
+  if (relu) {
+    param.activation_param.has_active = true;
+    param.activation_param.active_type = lite_api::ActivationType::kRelu;
+  }
+
+  std::unique_ptr<KernelContext> context(new KernelContext);
+  context->As<VulkanContext>().InitOnce();
+  kernel->SetParam(param);
+  kernel->SetContext(std::move(context));
+  kernel->Launch();
+
+  out_host.Resize(out.dims());
+  TargetWrapperVK::MemcpySync(out_host.mutable_data<float>(),
+                              out.data<float, VKBuffer>(),
+                              out.numel() * sizeof(float),
+                              IoDirection::DtoH);
+
+  std::vector<float> ref(out.numel());
+  conv_compute_ref(x_data,
+                   filter_data,
+                   has_bias ? bias_data : nullptr,
+                   ref.data(),
+                   ic,
+                   ih,
+                   iw,
+                   oc,
+                   oh,
+                   ow,
+                   kh,
+                   kw,
+                   stride,
+                   pad,
+                   groups,
+                   relu);
+  const float* out_data = out_host.data<float>();
+  for (size_t i = 0; i < ref.size(); i++) {
+    EXPECT_NEAR(out_data[i], ref[i], 1e-4) << "at " << i;
+  }
+}
+
+TEST(conv2d_vulkan, compute) {
+  if (!VKRuntime::Global()->IsInitSuccess()) {
+    LOG(INFO) << "No Vulkan device available, skip the test.";
+    return;
+  }
+  for (int stride : {1, 2}) {
+    for (bool has_bias : {false, true}) {
+      for (bool relu : {false, true}) {
+        test_conv("conv2d", 4, 8, 1, stride, has_bias, relu);
+        test_conv("conv2d", 4, 8, 2, stride, has_bias, relu);
+        test_conv("depthwise_conv2d", 8, 8, 8, stride, has_bias, relu);
+      }
+    }
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(conv2d, kVulkan, kFloat, kNCHW, def);
+USE_LITE_KERNEL(depthwise_conv2d, kVulkan, kFloat, kNCHW, def);
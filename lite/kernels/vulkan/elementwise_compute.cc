@@ -0,0 +1,222 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+#include "lite/kernels/vulkan/utils.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace vulkan {
+
+// The op_type of glsl/elementwise.comp.
+enum ElementwiseOpType {
+  kElementwiseAdd = 0,
+  kElementwiseSub = 1,
+  kElementwiseMul = 2,
+  kElementwiseDiv = 3,
+  kElementwiseMax = 4,
+  kElementwiseMin = 5,
+};
+
+template <int OpType, typename ParamT>
+class ElementwiseCompute
+    : public KernelLite<TARGET(kVulkan), PRECISION(kFloat), DATALAYOUT(kNCHW)> {
+ public:
+  using param_t = ParamT;
+
+  struct Params {
+    int total;
+    int n;
+    int post;
+    int op_type;
+    int act_type;
+    float act_param;
+  };
+
+  void PrepareForRun() override {
+    auto& context = ctx_->As<VulkanContext>();
+    pipeline_ =
+        context.runtime()->GetPipeline("elementwise", 3, sizeof(Params));
+  }
+
+  void Run() override {
+    auto& param = Param<param_t>();
+    const auto& x_dims = param.X->dims();
+    auto y_dims = param.Y->dims().Vectorize();
+    CHECK_GE(x_dims.size(), y_dims.size())
+        << "Only the broadcast of Y is supported";
+    int axis = param.axis < 0 ? static_cast<int>(x_dims.size() - y_dims.size())
+                              : param.axis;
+    // Y is taken as the dims between its leading and trailing 1s, e.g. Y of
+    // [1, C, 1, 1] is broadcast to X of [N, C, H, W] as Y of [C] at axis 1.
+    size_t begin = 0;
+    size_t end = y_dims.size();
+    while (begin < end && y_dims[begin] == 1) {
+      begin++;
+      axis++;
+    }
+    while (end > begin && y_dims[end - 1] == 1) {
+      end--;
+    }
+    int64_t n = 1;
+    for (size_t i = begin; i < end; i++) {
+      CHECK_EQ(x_dims[axis + i - begin], y_dims[i])
+          << "Only the broadcast of the whole dims of Y is supported";
+      n *= y_dims[i];
+    }
+    int64_t post = 1;
+    for (size_t i = axis + end - begin; i < x_dims.size(); i++) {
+      post *= x_dims[i];
+    }
+
+    Params params;
+    params.total = static_cast<int>(x_dims.production());
+    params.n = static_cast<int>(n);
+    params.post = static_cast<int>(post);
+    params.op_type = OpType;
+    params.act_type = kVulkanActNone;
+    params.act_param = 0.f;
+    SetActivation(param, &params);
+    param.Out->Resize(x_dims);
+    auto& context = ctx_->As<VulkanContext>();
+    context.runtime()->Dispatch(pipeline_,
+                                {GetVKBuffer(param.X),
+                                 GetVKBuffer(param.Y),
+                                 GetMutableVKBuffer(param.Out)},
+                                &params,
+                                params.total);
+  }
+
+  std::string doc() const override {
+    return "Elementwise ops using VKBuffer, kFloat";
+  }
+
+ private:
+  void SetActivation(const operators::FusionElementwiseActivationParam& param,
+                     Params* params) {
+    params->act_type = GetVulkanActType(param.act_type);
+    params->act_param = param.alpha;
+  }
+
+  void SetActivation(const operators::ElementwiseParam& param,
+                     Params* params) {}
+
+  const VKPipeline* pipeline_{nullptr};
+};
+
+}  // namespace vulkan
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+namespace vk = paddle::lite::kernels::vulkan;
+using vk_elementwise_param = paddle::lite::operators::ElementwiseParam;
+using vk_fusion_param =
+    paddle::lite::operators::FusionElementwiseActivationParam;
+using vk_elementwise_add =
+    vk::ElementwiseCompute<vk::kElementwiseAdd, vk_elementwise_param>;
+using vk_elementwise_sub =
+    vk::ElementwiseCompute<vk::kElementwiseSub, vk_elementwise_param>;
+using vk_elementwise_mul =
+    vk::ElementwiseCompute<vk::kElementwiseMul, vk_elementwise_param>;
+using vk_elementwise_div =
+    vk::ElementwiseCompute<vk::kElementwiseDiv, vk_elementwise_param>;
+using vk_elementwise_max =
+    vk::ElementwiseCompute<vk::kElementwiseMax, vk_elementwise_param>;
+using vk_elementwise_min =
+    vk::ElementwiseCompute<vk::kElementwiseMin, vk_elementwise_param>;
+using vk_fusion_elementwise_add_activation =
+    vk::ElementwiseCompute<vk::kElementwiseAdd, vk_fusion_param>;
+using vk_fusion_elementwise_sub_activation =
+    vk::ElementwiseCompute<vk::kElementwiseSub, vk_fusion_param>;
+using vk_fusion_elementwise_mul_activation =
+    vk::ElementwiseCompute<vk::kElementwiseMul, vk_fusion_param>;
+
+REGISTER_LITE_KERNEL(
+    elementwise_add, kVulkan, kFloat, kNCHW, vk_elementwise_add, def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    elementwise_sub, kVulkan, kFloat, kNCHW, vk_elementwise_sub, def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    elementwise_mul, kVulkan, kFloat, kNCHW, vk_elementwise_mul, def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    elementwise_div, kVulkan, kFloat, kNCHW, vk_elementwise_div, def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    elementwise_max, kVulkan, kFloat, kNCHW, vk_elementwise_max, def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    elementwise_min, kVulkan, kFloat, kNCHW, vk_elementwise_min, def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(fusion_elementwise_add_activation,
+                     kVulkan,
+                     kFloat,
+                     kNCHW,
+                     vk_fusion_elementwise_add_activation,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(fusion_elementwise_sub_activation,
+                     kVulkan,
+                     kFloat,
+                     kNCHW,
+                     vk_fusion_elementwise_sub_activation,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(fusion_elementwise_mul_activation,
+                     kVulkan,
+                     kFloat,
+                     kNCHW,
+                     vk_fusion_elementwise_mul_activation,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
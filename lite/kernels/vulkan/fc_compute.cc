@@ -0,0 +1,100 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+#include "lite/kernels/vulkan/utils.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace vulkan {
+
+// The weights and the bias are uploaded once in PrepareForRun.
+class FcCompute
+    : public KernelLite<TARGET(kVulkan), PRECISION(kFloat), DATALAYOUT(kNCHW)> {
+ public:
+  using param_t = operators::FcParam;
+
+  struct Params {
+    int total;
+    int k;
+    int n;
+    int has_bias;
+    int act_type;
+    float act_param;
+  };
+
+  void PrepareForRun() override {
+    auto& param = Param<param_t>();
+    CHECK(!param.padding_weights) << "The padded weights are unsupported";
+    CHECK(param.activation_type.empty() || param.activation_type == "relu" ||
+          param.activation_type == "relu6")
+        << "Unsupported activation type " << param.activation_type;
+    CopyToVulkan(*param.w, &w_);
+    if (param.bias) {
+      CopyToVulkan(*param.bias, &bias_);
+    }
+    auto& context = ctx_->As<VulkanContext>();
+    pipeline_ = context.runtime()->GetPipeline("fc", 4, sizeof(Params));
+  }
+
+  void Run() override {
+    auto& param = Param<param_t>();
+    const auto& w_dims = param.w->dims();
+    CHECK_EQ(w_dims.size(), 2u);
+    const auto& in_dims = param.input->dims();
+    int64_t m = in_dims.Slice(0, param.in_num_col_dims).production();
+    Params params;
+    params.k = static_cast<int>(w_dims[0]);
+    params.n = static_cast<int>(w_dims[1]);
+    params.total = static_cast<int>(m * w_dims[1]);
+    params.has_bias = param.bias ? 1 : 0;
+    params.act_type = GetVulkanActType(param.activation_type);
+    params.act_param = 6.f;
+
+    auto* w_buffer = GetVKBuffer(&w_);
+    // The weights are bound in place of the bias if there is no bias.
+    auto* bias_buffer = param.bias ? GetVKBuffer(&bias_) : w_buffer;
+    auto& context = ctx_->As<VulkanContext>();
+    context.runtime()->Dispatch(pipeline_,
+                                {GetVKBuffer(param.input),
+                                 w_buffer,
+                                 bias_buffer,
+                                 GetMutableVKBuffer(param.output)},
+                                &params,
+                                params.total);
+  }
+
+  std::string doc() const override { return "Fc using VKBuffer, kFloat"; }
+
+ private:
+  Tensor w_;
+  Tensor bias_;
+  const VKPipeline* pipeline_{nullptr};
+};
+
+}  // namespace vulkan
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(
+    fc, kVulkan, kFloat, kNCHW, paddle::lite::kernels::vulkan::FcCompute, def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("W", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
@@ -0,0 +1,163 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+#include "lite/kernels/vulkan/utils.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace vulkan {
+
+class InterpolateCompute
+    : public KernelLite<TARGET(kVulkan), PRECISION(kFloat), DATALAYOUT(kNCHW)> {
+ public:
+  using param_t = operators::InterpolateParam;
+
+  struct Params {
+    int total;
+    int in_h;
+    int in_w;
+    int out_h;
+    int out_w;
+    float ratio_h;
+    float ratio_w;
+    int method;
+    int align_corners;
+    int half_pixel;
+  };
+
+  void PrepareForRun() override {
+    auto& param = Param<param_t>();
+    CHECK(param.interp_method == "Nearest" ||
+          param.interp_method == "Bilinear")
+        << "Unsupported interp method " << param.interp_method;
+    auto& context = ctx_->As<VulkanContext>();
+    pipeline_ = context.runtime()->GetPipeline("interp", 2, sizeof(Params));
+  }
+
+  void Run() override {
+    auto& param = Param<param_t>();
+    const auto& x_dims = param.X->dims();
+    const auto& out_dims = param.Out->dims();
+    CHECK_EQ(x_dims.size(), 4u);
+    int in_h = static_cast<int>(x_dims[2]);
+    int in_w = static_cast<int>(x_dims[3]);
+    int out_h = static_cast<int>(out_dims[2]);
+    int out_w = static_cast<int>(out_dims[3]);
+    bool bilinear = param.interp_method == "Bilinear";
+
+    // The output dims have been resolved from OutSize, SizeTensor or Scale
+    // by the op, so the ratios are derived from the dims alone.
+    Params params;
+    params.total = static_cast<int>(out_dims.production());
+    params.in_h = in_h;
+    params.in_w = in_w;
+    params.out_h = out_h;
+    params.out_w = out_w;
+    params.ratio_h = GetRatio(in_h, out_h, param.align_corners);
+    params.ratio_w = GetRatio(in_w, out_w, param.align_corners);
+    params.method = bilinear ? 1 : 0;
+    params.align_corners = param.align_corners ? 1 : 0;
+    params.half_pixel =
+        bilinear && param.align_mode == 0 && !param.align_corners ? 1 : 0;
+    auto& context = ctx_->As<VulkanContext>();
+    context.runtime()->Dispatch(
+        pipeline_,
+        {GetVKBuffer(param.X), GetMutableVKBuffer(param.Out)},
+        &params,
+        params.total);
+  }
+
+  std::string doc() const override {
+    return "Nearest and bilinear interp using VKBuffer, kFloat";
+  }
+
+ private:
+  static float GetRatio(int in, int out, bool align_corners) {
+    if (align_corners) {
+      return out > 1 ? static_cast<float>(in - 1) / (out - 1) : 0.f;
+    }
+    return static_cast<float>(in) / out;
+  }
+
+  const VKPipeline* pipeline_{nullptr};
+};
+
+}  // namespace vulkan
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(nearest_interp,
+                     kVulkan,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::vulkan::InterpolateCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindInput("OutSize",
+               {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kInt32))})
+    .BindInput("SizeTensor",
+               {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kInt32))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(nearest_interp_v2,
+                     kVulkan,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::vulkan::InterpolateCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindInput("OutSize",
+               {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kInt32))})
+    .BindInput("SizeTensor",
+               {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kInt32))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(bilinear_interp,
+                     kVulkan,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::vulkan::InterpolateCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindInput("OutSize",
+               {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kInt32))})
+    .BindInput("SizeTensor",
+               {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kInt32))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(bilinear_interp_v2,
+                     kVulkan,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::vulkan::InterpolateCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindInput("OutSize",
+               {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kInt32))})
+    .BindInput("SizeTensor",
+               {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kInt32))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
@@ -0,0 +1,109 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+#include "lite/kernels/vulkan/utils.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace vulkan {
+
+class PoolCompute
+    : public KernelLite<TARGET(kVulkan), PRECISION(kFloat), DATALAYOUT(kNCHW)> {
+ public:
+  using param_t = operators::PoolParam;
+
+  struct Params {
+    int total;
+    int in_h;
+    int in_w;
+    int out_h;
+    int out_w;
+    int kernel_h;
+    int kernel_w;
+    int stride_h;
+    int stride_w;
+    int pad_h;
+    int pad_w;
+    int pooling_type;
+    int exclusive;
+  };
+
+  void PrepareForRun() override {
+    auto& param = Param<param_t>();
+    CHECK(param.pooling_type == "max" || param.pooling_type == "avg")
+        << "Unsupported pooling type " << param.pooling_type;
+    CHECK(!param.adaptive) << "The adaptive pooling is unsupported";
+    auto& context = ctx_->As<VulkanContext>();
+    pipeline_ = context.runtime()->GetPipeline("pool2d", 2, sizeof(Params));
+  }
+
+  void Run() override {
+    auto& param = Param<param_t>();
+    const auto& x_dims = param.x->dims();
+    const auto& out_dims = param.output->dims();
+    CHECK_EQ(x_dims.size(), 4u);
+    std::vector<int> ksize = param.ksize;
+    std::vector<int> paddings = *param.paddings;
+    if (param.global_pooling) {
+      ksize = {static_cast<int>(x_dims[2]), static_cast<int>(x_dims[3])};
+      paddings = {0, 0, 0, 0};
+    }
+
+    Params params;
+    params.total = static_cast<int>(out_dims.production());
+    params.in_h = static_cast<int>(x_dims[2]);
+    params.in_w = static_cast<int>(x_dims[3]);
+    params.out_h = static_cast<int>(out_dims[2]);
+    params.out_w = static_cast<int>(out_dims[3]);
+    params.kernel_h = ksize[0];
+    params.kernel_w = ksize[1];
+    params.stride_h = param.strides[0];
+    params.stride_w = param.strides[1];
+    params.pad_h = paddings[0];
+    params.pad_w = paddings[2];
+    params.pooling_type = param.pooling_type == "max" ? 0 : 1;
+    params.exclusive = param.exclusive ? 1 : 0;
+    auto& context = ctx_->As<VulkanContext>();
+    context.runtime()->Dispatch(
+        pipeline_,
+        {GetVKBuffer(param.x), GetMutableVKBuffer(param.output)},
+        &params,
+        params.total);
+  }
+
+  std::string doc() const override { return "Pool2d using VKBuffer, kFloat"; }
+
+ private:
+  const VKPipeline* pipeline_{nullptr};
+};
+
+}  // namespace vulkan
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(pool2d,
+                     kVulkan,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::vulkan::PoolCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kVulkan))})
+    .Finalize();
@@ -0,0 +1,82 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include "lite/api/paddle_place.h"
+#include "lite/backends/vulkan/target_wrapper.h"
+#include "lite/core/tensor.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace vulkan {
+
+// The act_type of the shaders, see activate() in lite/backends/vulkan/glsl.
+enum VulkanActType {
+  kVulkanActNone = 0,
+  kVulkanActRelu = 1,
+  kVulkanActRelu6 = 2,
+  kVulkanActLeakyRelu = 3,
+};
+
+inline int GetVulkanActType(lite_api::ActivationType type) {
+  switch (type) {
+    case lite_api::ActivationType::kIndentity:
+      return kVulkanActNone;
+    case lite_api::ActivationType::kRelu:
+      return kVulkanActRelu;
+    case lite_api::ActivationType::kRelu6:
+      return kVulkanActRelu6;
+    case lite_api::ActivationType::kLeakyRelu:
+      return kVulkanActLeakyRelu;
+    default:
+      LOG(FATAL) << "Unsupported activation type "
+                 << lite_api::ActivationTypeToStr(type);
+  }
+  return kVulkanActNone;
+}
+
+inline int GetVulkanActType(const std::string& type) {
+  if (type.empty()) return kVulkanActNone;
+  if (type == "relu") return kVulkanActRelu;
+  if (type == "relu6") return kVulkanActRelu6;
+  if (type == "leaky_relu") return kVulkanActLeakyRelu;
+  LOG(FATAL) << "Unsupported activation type " << type;
+  return kVulkanActNone;
+}
+
+inline const VKBuffer* GetVKBuffer(const Tensor* tensor) {
+  return tensor->data<float, VKBuffer>();
+}
+
+inline VKBuffer* GetMutableVKBuffer(Tensor* tensor) {
+  return tensor->mutable_data<float, VKBuffer>(TARGET(kVulkan));
+}
+
+// Copy the host tensor into the kVulkan tensor, e.g. the weights.
+inline void CopyToVulkan(const Tensor& src, Tensor* dst) {
+  dst->Resize(src.dims());
+  TargetWrapperVK::MemcpySync(GetMutableVKBuffer(dst),
+                              src.data<float>(),
+                              src.dims().production() * sizeof(float),
+                              IoDirection::HtoD);
+}
+
+}  // namespace vulkan
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
@@ -25,6 +25,7 @@
 #include "lite/backends/x86/fluid/eigen.h"
 #include "lite/backends/x86/math/activation.h"
 #include "lite/backends/x86/math/blas.h"
+#include "lite/core/fast_math.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
@@ -176,6 +177,12 @@ class TanhCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     auto& param = *param_.get_mutable<operators::ActivationParam>();
 
     param.Out->template mutable_data<T>();
+    if (FastMath::Enabled()) {
+      lite::x86::math::tanh_fast<T>(param.X->template data<T>(),
+                                    param.Out->template mutable_data<T>(),
+                                    param.X->numel());
+      return;
+    }
     Activate<TanhFunctor<T>>(param.X, param.Out);
   }
 
@@ -221,6 +228,13 @@ class GeluCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     auto& param = *param_.get_mutable<operators::ActivationParam>();
 
     param.Out->template mutable_data<T>();
+    if (FastMath::Enabled()) {
+      lite::x86::math::gelu_fast<T>(param.X->template data<T>(),
+                                    param.Out->template mutable_data<T>(),
+                                    param.X->numel(),
+                                    param.gelu_approximate);
+      return;
+    }
     Activate<GeluFunctor<T>>(param.X, param.Out);
   }
 
@@ -265,6 +279,12 @@ class SigmoidCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   void Run() override {
     auto& param = this->Param<param_t>();
     param.Out->template mutable_data<T>();
+    if (FastMath::Enabled()) {
+      lite::x86::math::sigmoid_fast<T>(param.X->template data<T>(),
+                                       param.Out->template mutable_data<T>(),
+                                       param.X->numel());
+      return;
+    }
     Activate<SigmoidFunctor<T>>(param.X, param.Out);
   }
 
@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include "lite/kernels/x86/conv_compute.h"
+#include <algorithm>
 #include <utility>
+#include "lite/backends/host/math/conv_resample.h"
 #include "lite/backends/x86/math/fill_bias_activate.h"
 #include "lite/kernels/x86/conv_depthwise.h"
 #include "lite/kernels/x86/conv_direct.h"
@@ -22,6 +24,10 @@ namespace paddle {
 namespace lite {
 namespace kernels {
 namespace x86 {
+
+// the size of the im2col of a band of conv output rows, about a L2 cache
+static constexpr int kIm2colBandBytes = 1024 * 1024;
+
 #define INIT_PARAM                      \
   auto& param = this->Param<param_t>(); \
   auto x_dims = param.x->dims();        \
@@ -138,7 +144,6 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   bool flag_bias = (param.bias != nullptr);
   unsigned int group_size_out = m * n;
   unsigned int group_size_weights = m * k;
-  unsigned int group_size_coldata = n * k;
   unsigned int channel_in_size = chin * hin * win;
   unsigned int channel_out_size = chout * hout * wout;
   auto paddings = *param.paddings;
@@ -150,66 +155,73 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   const float* bias_ptr =
       flag_bias ? static_cast<const float*>(param.bias->data<float>())
                 : nullptr;
-  float* col_data = nullptr;
 
+  // The patches are gathered for the bands of output rows whose im2col fits
+  // kIm2colBandBytes, instead of the im2col of the whole image.
+  int band = hout;
+  float* col_data = nullptr;
   if (!flag_1x1gemm_) {
-    size_t col_size = group_size_coldata * group;
-    size_t col_data_size = static_cast<size_t>(col_size * sizeof(float));
-    col_data = static_cast<float*>(TargetMalloc(TARGET(kX86), col_data_size));
+    int row_bytes = group * k * wout * static_cast<int>(sizeof(float));
+    band = std::max(1, std::min(hout, kIm2colBandBytes / row_bytes));
+    col_buf_.Resize({group * k, band * wout});
+    col_data = col_buf_.mutable_data<float>();
   }
   auto act_param = param.activation_param;
   paddle::lite::x86::math::Blas<lite::TargetType::kX86> matmul(ctx);
   for (int i = 0; i < num; i++) {
     const float* din_batch = din + i * channel_in_size;
     float* dout_batch = dout + i * channel_out_size;
-    const float* din_data = din_batch;
-    if (!flag_1x1gemm_) {
-      lite::x86::math::im2col<float>(din_batch,
-                                     chin,
-                                     hin,
-                                     win,
-                                     w_dims[2],
-                                     w_dims[3],
-                                     paddings[0],
-                                     paddings[1],
-                                     paddings[2],
-                                     paddings[3],
-                                     param.strides[0],
-                                     param.strides[1],
-                                     dilations[0],
-                                     dilations[1],
-                                     col_data);
-      din_data = static_cast<const float*>(col_data);
-    }
-
-    for (int g = 0; g < group; g++) {
-      const float* col_data_group = din_data + g * group_size_coldata;
-      const float* weights_group = weights + g * group_size_weights;
-      float* dout_group = dout_batch + g * group_size_out;
-      if (n == 1) {
-        matmul.GEMV<float>(
-            false, m, k, 1.f, weights_group, col_data_group, 0.f, dout_group);
-      } else {
-        matmul.GEMM<float>(false,
-                           false,
-                           m,
-                           n,
-                           k,
-                           1.f,
-                           weights_group,
-                           k,
-                           col_data_group,
-                           n,
-                           0.f,
-                           dout_group,
-                           n);
+    for (int r0 = 0; r0 < hout; r0 += band) {
+      const int r1 = std::min(hout, r0 + band);
+      const int cols = flag_1x1gemm_ ? n : (r1 - r0) * wout;
+      const float* din_data = din_batch;
+      int ldb = hin * win;
+      if (!flag_1x1gemm_) {
+        lite::host::math::im2col_rows(din_batch,
+                                      col_data,
+                                      chin,
+                                      hin,
+                                      win,
+                                      wout,
+                                      r0,
+                                      r1,
+                                      kh,
+                                      kw,
+                                      param.strides,
+                                      paddings,
+                                      dilations);
+        din_data = col_data;
+        ldb = cols;
       }
+      for (int g = 0; g < group; g++) {
+        const float* col_data_group = din_data + g * k * ldb;
+        const float* weights_group = weights + g * group_size_weights;
+        float* dout_group = dout_batch + g * group_size_out + r0 * wout;
+        if (n == 1) {
+          matmul.GEMV<float>(
+              false, m, k, 1.f, weights_group, col_data_group, 0.f, dout_group);
+        } else {
+          matmul.GEMM<float>(false,
+                             false,
+                             m,
+                             cols,
+                             k,
+                             1.f,
+                             weights_group,
+                             k,
+                             col_data_group,
+                             ldb,
+                             0.f,
+                             dout_group,
+                             n);
+        }
+      }
+      if (flag_1x1gemm_) break;
     }
     //! bias and activate
     lite::x86::math::fill_bias_act(
         dout_batch, bias_ptr, chout, wout * hout, flag_bias, &act_param);
   }
-  if (!flag_1x1gemm_) TargetFree(TARGET(kX86), col_data);
 }
 
 template <>
@@ -86,6 +86,8 @@ class Conv2dCompute : public KernelLite<TARGET(kX86), Ptype> {
   std::vector<float> w_scale_;
   Tensor weights_;
   Tensor bias_;
+  // the im2col of a band of output rows of the fp32 conv
+  Tensor col_buf_;
   std::vector<lite::x86::math::generate_gemm_s8u8_x86_kern<float>*>
       gemm_s8_ptr_float_{};
   std::vector<lite::x86::math::generate_gemm_s8u8_x86_kern<int8_t>*>
@@ -92,6 +92,68 @@ TEST(conv2d_x86, run_test) {
   }
 }
 
+TEST(conv2d_x86, run_band_test) {
+  // the im2col of this input is larger than a band of output rows
+  const int ic = 8, oc = 4, h = 64, w = 64, kh = 3, kw = 3;
+  lite::Tensor x, filter, b, out;
+  x.Resize({1, ic, h, w});
+  filter.Resize({oc, ic, kh, kw});
+  b.Resize({oc});
+  out.Resize({1, oc, h, w});
+
+  auto x_data = x.mutable_data<float>();
+  auto filter_data = filter.mutable_data<float>();
+  auto b_data = b.mutable_data<float>();
+  auto out_data = out.mutable_data<float>();
+  for (int64_t i = 0; i < x.dims().production(); i++) {
+    x_data[i] = static_cast<float>(i % 13) * 0.1f - 0.6f;
+  }
+  for (int64_t i = 0; i < filter.dims().production(); i++) {
+    filter_data[i] = static_cast<float>(i % 7) * 0.1f - 0.3f;
+  }
+  for (int i = 0; i < oc; i++) {
+    b_data[i] = 0.5f * i;
+  }
+
+  Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)> conv2d;
+  operators::ConvParam param;
+  param.x = &x;
+  param.filter = &filter;
+  param.bias = &b;
+  param.output = &out;
+  param.strides = {1, 1};
+  std::vector<int> paddings = {1, 1, 1, 1};
+  param.groups = 1;
+  std::vector<int> dilations = {1, 1};
+  param.paddings = std::make_shared<std::vector<int>>(paddings);
+  param.dilations = std::make_shared<std::vector<int>>(dilations);
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  conv2d.SetContext(std::move(ctx));
+  conv2d.SetParam(param);
+  conv2d.Run();
+
+  for (int o = 0; o < oc; o++) {
+    for (int y = 0; y < h; y++) {
+      for (int z = 0; z < w; z++) {
+        float ref = b_data[o];
+        for (int c = 0; c < ic; c++) {
+          for (int i = 0; i < kh; i++) {
+            for (int j = 0; j < kw; j++) {
+              int iy = y + i - 1;
+              int iz = z + j - 1;
+              if (iy < 0 || iy >= h || iz < 0 || iz >= w) continue;
+              ref += x_data[(c * h + iy) * w + iz] *
+                     filter_data[((o * ic + c) * kh + i) * kw + j];
+            }
+          }
+        }
+        EXPECT_NEAR(out_data[(o * h + y) * w + z], ref, 1e-4);
+      }
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -0,0 +1,54 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/elementwise_chain_compute.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+void ElementwiseChainCompute::PrepareForRun() {
+  steps_ = lite::host::math::elementwise_chain_steps(this->Param<param_t>());
+}
+
+void ElementwiseChainCompute::Run() {
+  auto& param = this->Param<param_t>();
+  std::vector<const float*> x;
+  for (auto* tensor : param.X) {
+    x.push_back(tensor->data<float>());
+  }
+  lite::host::math::elementwise_chain(x,
+                                      param.x_aligned_dims,
+                                      param.Out->dims().Vectorize(),
+                                      steps_,
+                                      param.Out->mutable_data<float>(),
+                                      lite::host::math::elementwise_chain_step);
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fusion_elementwise_chain,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::ElementwiseChainCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
@@ -139,6 +139,60 @@ class FCFunctor {
   }
 };
 
+// Pack the int8 weights for AMX, and fold the input scale into the per
+// channel scales, the weight scales of size M are not supported.
+static bool PrepareAmxInt8(const operators::FcParam& param,
+                           lite::x86::math::AmxPackedB* amx_w,
+                           std::vector<float>* amx_scale) {
+  if (!lite::x86::math::AmxAvailable()) return false;
+  if (param.activation_type != "" && param.activation_type != "relu") {
+    return false;
+  }
+  auto w_dims = param.w->dims();
+  int k = w_dims[0];
+  int n = w_dims[1];
+  if (param.weight_scale.size() != 1 && param.weight_scale.size() != n) {
+    return false;
+  }
+  amx_w->PackInt8(param.w->data<int8_t>(), k, n, false);
+  amx_scale->resize(n);
+  for (int i = 0; i < n; i++) {
+    float w_scale = param.weight_scale.size() == 1 ? param.weight_scale[0]
+                                                   : param.weight_scale[i];
+    (*amx_scale)[i] = param.input_scale * w_scale;
+  }
+  return true;
+}
+
+template <>
+void FcCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
+  auto& param = *param_.get_mutable<param_t>();
+  // The padded weights are kept for the blas gemm.
+  if (param.padding_weights) return;
+  const auto& w_dims = param.w->dims();
+  int k = w_dims[0];
+  int n = w_dims[1];
+  if (lite::x86::math::AmxBF16Enabled()) {
+    amx_w_.PackBF16(param.w->template data<float>(), k, n, false);
+    use_amx_ = true;
+    return;
+  }
+#ifdef PADDLE_WITH_MKLML
+  // MKL is faster except for the skinny weights.
+  if (n > kJitGemmMaxN) return;
+#endif
+  // The gemm generated for the shape of the weights, if the cpu has avx2.
+  jit::gemm_attr_t attr(n, k, jit::gemm_block());
+  auto* code = dynamic_cast<const jit::GenBase*>(
+      jit::GetJitCode<jit::GemmTuple<float>, fluid::CPUPlace>(attr));
+  if (code == nullptr) return;
+  jit_gemm_ = code->getCode<jit::GemmTuple<float>::func_type>();
+  jit_attr_ = attr;
+  jit_w_.resize((n + attr.block - 1) / attr.block * attr.block * k);
+  jit::pack_gemm_weights(
+      param.w->template data<float>(), k, n, attr.block, jit_w_.data());
+}
+
 template <>
 void FcCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   auto& param = *param_.get_mutable<param_t>();
@@ -159,6 +213,44 @@ void FcCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   const float* w_data = w->template data<float>();
   float* output_data = output->template mutable_data<float>();
 
+  if (use_amx_) {
+    lite::x86::math::AmxGemmBF16(M,
+                                 input_data,
+                                 w_dims0,
+                                 amx_w_,
+                                 output_data,
+                                 w_dims1,
+                                 1.f,
+                                 bias ? bias->template data<float>() : nullptr,
+                                 with_relu);
+    return;
+  }
+
+  if (jit_gemm_ != nullptr) {
+    jit_gemm_(input_data, jit_w_.data(), output_data, M, &jit_attr_);
+    if (bias) {
+      auto compute =
+          with_relu
+              ? jit::KernelFuncs<jit::VAddReluTuple<float>,
+                                 fluid::CPUPlace>::Cache()
+                    .At(w_dims1)
+              : jit::KernelFuncs<jit::VAddTuple<float>,
+                                 fluid::CPUPlace>::Cache()
+                    .At(w_dims1);
+      const float* bias_data = bias->template data<float>();
+      for (int i = 0; i < M; i++) {
+        float* dst = output_data + i * w_dims1;
+        compute(bias_data, dst, dst, w_dims1);
+      }
+    } else if (with_relu) {
+      auto relu =
+          jit::KernelFuncs<jit::VReluTuple<float>, fluid::CPUPlace>::Cache()
+              .At(M * w_dims1);
+      relu(output_data, output_data, M * w_dims1);
+    }
+    return;
+  }
+
   auto& context = ctx_->As<X86Context>();
   FCFunctor<lite::TargetType::kX86, float> fc;
   fc(context,
@@ -173,6 +265,12 @@ void FcCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
      padding_weights);
 }
 
+template <>
+void FcCompute<PRECISION(kInt8), PRECISION(kInt8)>::PrepareForRun() {
+  use_amx_ = PrepareAmxInt8(
+      this->Param<operators::FcParam>(), &amx_w_, &amx_scale_);
+}
+
 template <>
 void FcCompute<PRECISION(kInt8), PRECISION(kInt8)>::Run() {
   auto& param = this->Param<operators::FcParam>();
@@ -187,6 +285,27 @@ void FcCompute<PRECISION(kInt8), PRECISION(kInt8)>::Run() {
   float input_scale = param.input_scale;
   float output_scale = param.output_scale;
   int relu_type = (param.activation_type == "relu") ? 1 : 0;
+
+  if (use_amx_) {
+    float* tmp_output =
+        static_cast<float*>(TargetMalloc(TARGET(kX86), m * n * sizeof(float)));
+    lite::x86::math::AmxGemmInt8(m,
+                                 i_data,
+                                 k,
+                                 amx_w_,
+                                 tmp_output,
+                                 n,
+                                 amx_scale_.data(),
+                                 b_data,
+                                 relu_type == 1);
+    for (int i = 0; i < m * n; i++) {
+      o_data[i] = lite::x86::math::saturate_cast<int8_t>(
+          roundf(tmp_output[i] / output_scale));
+      o_data[i] = o_data[i] < -127 ? -127 : o_data[i];
+    }
+    TargetFree(TARGET(kX86), tmp_output);
+    return;
+  }
   float* w_scale =
       static_cast<float*>(TargetMalloc(TARGET(kX86), m * sizeof(float)));
 
@@ -223,6 +342,12 @@ void FcCompute<PRECISION(kInt8), PRECISION(kInt8)>::Run() {
   TargetFree(TARGET(kX86), w_scale);
 }
 
+template <>
+void FcCompute<PRECISION(kInt8), PRECISION(kFloat)>::PrepareForRun() {
+  use_amx_ = PrepareAmxInt8(
+      this->Param<operators::FcParam>(), &amx_w_, &amx_scale_);
+}
+
 template <>
 void FcCompute<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
   auto& param = this->Param<operators::FcParam>();
@@ -235,6 +360,19 @@ void FcCompute<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
   int n = w_dims[1];
   int m = param.output->dims().production() / n;
   int relu_type = (param.activation_type == "relu") ? 1 : 0;
+
+  if (use_amx_) {
+    lite::x86::math::AmxGemmInt8(m,
+                                 i_data,
+                                 k,
+                                 amx_w_,
+                                 o_data,
+                                 n,
+                                 amx_scale_.data(),
+                                 b_data,
+                                 relu_type == 1);
+    return;
+  }
   float input_scale = param.input_scale;
   float output_scale = param.output_scale;
   float* w_scale =
@@ -19,6 +19,7 @@
 #include "lite/backends/x86/jit/kernel_base.h"
 #include "lite/backends/x86/jit/kernels.h"
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/gemm_amx.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
@@ -30,14 +31,30 @@ namespace lite {
 namespace kernels {
 namespace x86 {
 
+// The widest weights of the jit gemm when MKL is used.
+const int kJitGemmMaxN = 64;
+
 template <PrecisionType PType, PrecisionType OutType>
 class FcCompute : public KernelLite<TARGET(kX86), PType> {
  public:
   using param_t = operators::FcParam;
 
+  virtual void PrepareForRun();
+
   virtual void Run();
 
   virtual ~FcCompute() = default;
+
+ private:
+  // The weights packed for AMX by PrepareForRun if the cpu supports it, and
+  // the scales of the int8 sums of each output channel.
+  bool use_amx_{false};
+  lite::x86::math::AmxPackedB amx_w_;
+  std::vector<float> amx_scale_;
+  // The jit gemm of the shape of the weights and the weights packed for it.
+  jit::GemmTuple<float>::func_type jit_gemm_{nullptr};
+  jit::gemm_attr_t jit_attr_;
+  std::vector<float> jit_w_;
 };
 
 }  // namespace x86
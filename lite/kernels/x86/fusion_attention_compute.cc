@@ -0,0 +1,153 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/fusion_attention_compute.h"
+#include "lite/backends/x86/math/attention.h"
+#include "lite/backends/host/math/attention_mask.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+void FusionAttentionCompute::Run() {
+  auto& param = this->Param<param_t>();
+  const auto& q_dims = param.q->dims();
+  if (param.cu_seqlens) {
+    // The sequences packed without padding of [total, heads, dim].
+    lite::x86::math::fusion_attention_varlen(
+        param.q->data<float>(),
+        param.k->data<float>(),
+        param.v->data<float>(),
+        param.cu_seqlens->data<int>(),
+        param.output->mutable_data<float>(),
+        static_cast<int>(param.cu_seqlens->numel()) - 1,
+        static_cast<int>(q_dims[1]),
+        static_cast<int>(q_dims[2]),
+        static_cast<int>(param.v->dims()[2]),
+        param.scale);
+    return;
+  }
+  int rank = static_cast<int>(q_dims.size());
+  int batch = static_cast<int>(q_dims.count(0, rank - 2));
+  int heads = param.transpose_out ? static_cast<int>(q_dims[1]) : 1;
+  int seq_q = static_cast<int>(q_dims[rank - 2]);
+  int seq_k = static_cast<int>(param.k->dims()[rank - 2]);
+  int dim = static_cast<int>(q_dims[rank - 1]);
+  int dim_v = static_cast<int>(param.v->dims()[rank - 1]);
+
+  const float* mask = nullptr;
+  int mask_row_stride = 0;
+  int mask_col_stride = 0;
+  if (param.mask) {
+    mask = param.mask->data<float>();
+    lite::host::math::AttentionMaskStrides(param.mask->dims(),
+                                           q_dims,
+                                           &mask_offsets_,
+                                           &mask_row_stride,
+                                           &mask_col_stride);
+  }
+  lite::x86::math::fusion_attention(param.q->data<float>(),
+                                    param.k->data<float>(),
+                                    param.v->data<float>(),
+                                    mask,
+                                    mask_offsets_.data(),
+                                    mask_row_stride,
+                                    mask_col_stride,
+                                    param.output->mutable_data<float>(),
+                                    batch,
+                                    heads,
+                                    seq_q,
+                                    seq_k,
+                                    seq_k,
+                                    dim,
+                                    dim_v,
+                                    param.scale,
+                                    param.transpose_out);
+}
+
+void CachedAttentionCompute::Run() {
+  auto& param = this->Param<param_t>();
+  const auto* cache = param.cache;
+  CHECK_GT(cache->length(), 0) << "The kv cache should be appended first";
+  const auto& q_dims = param.q->dims();
+  int batch = static_cast<int>(q_dims[0] * q_dims[1]);
+  int heads = param.transpose_out ? static_cast<int>(q_dims[1]) : 1;
+  int seq_q = static_cast<int>(q_dims[2]);
+  int seq_k = static_cast<int>(cache->length());
+  int kv_stride = static_cast<int>(cache->capacity());
+  int dim = static_cast<int>(q_dims[3]);
+  int dim_v = static_cast<int>(cache->dim_v());
+
+  const float* mask = nullptr;
+  int mask_row_stride = 0;
+  int mask_col_stride = 0;
+  if (param.mask) {
+    mask = param.mask->data<float>();
+    lite::host::math::AttentionMaskStrides(param.mask->dims(),
+                                           q_dims,
+                                           &mask_offsets_,
+                                           &mask_row_stride,
+                                           &mask_col_stride);
+  }
+  lite::x86::math::fusion_attention(param.q->data<float>(),
+                                    cache->k_data(),
+                                    cache->v_data(),
+                                    mask,
+                                    mask_offsets_.data(),
+                                    mask_row_stride,
+                                    mask_col_stride,
+                                    param.output->mutable_data<float>(),
+                                    batch,
+                                    heads,
+                                    seq_q,
+                                    seq_k,
+                                    kv_stride,
+                                    dim,
+                                    dim_v,
+                                    param.scale,
+                                    param.transpose_out);
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fusion_attention,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::FusionAttentionCompute,
+                     def)
+    .BindInput("Q", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("K", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("V", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Mask", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("CuSeqlens",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(cached_attention,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::CachedAttentionCompute,
+                     def)
+    .BindInput("Q", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Cache", {LiteType::GetKVCacheTy()})
+    .BindInput("Mask", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
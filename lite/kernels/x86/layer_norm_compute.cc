@@ -27,3 +27,20 @@ REGISTER_LITE_KERNEL(layer_norm,
     .BindOutput("Mean", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindOutput("Variance", {LiteType::GetTensorTy(TARGET(kX86))})
     .Finalize();
+
+REGISTER_LITE_KERNEL(
+    fusion_elementwise_add_layer_norm,
+    kX86,
+    kFloat,
+    kNCHW,
+    paddle::lite::kernels::x86::FusionElementwiseAddLayerNormCompute<float>,
+    def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Residual", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Y", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Mean", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Variance", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("AddOut", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <vector>
 #include "lite/backends/x86/jit/helper.h"
 #include "lite/backends/x86/jit/kernel_base.h"
 #include "lite/backends/x86/jit/kernels.h"
@@ -85,6 +86,55 @@ class LayerNormCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   virtual ~LayerNormCompute() = default;
 };
 
+// The layer_norm of the sum with a residual, which is added and normalized
+// row by row, so the sum is still in the cache for the norm.
+template <typename T>
+class FusionElementwiseAddLayerNormCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::FusionElementwiseAddLayerNormParam;
+
+  void Run() override {
+    auto &param = *param_.get_mutable<param_t>();
+    auto matrix_dim = param.X->dims().Flatten2D(param.begin_norm_axis);
+    int left = static_cast<int>(matrix_dim[0]);
+    int right = static_cast<int>(matrix_dim[1]);
+    int residual_rows = static_cast<int>(param.Residual->numel() / right);
+
+    CHECK_EQ(param.Scale->numel(), right);
+    CHECK_EQ(param.Bias->numel(), right);
+    const T *x = param.X->template data<T>();
+    const T *residual = param.Residual->template data<T>();
+    T *out = param.Y->template mutable_data<T>();
+    T *mean = param.Mean->template mutable_data<T>();
+    T *var = param.Variance->template mutable_data<T>();
+    T *add_out =
+        param.AddOut ? param.AddOut->template mutable_data<T>() : nullptr;
+    std::vector<T> sum_row(add_out ? 0 : right);
+
+    auto ker = paddle::lite::jit::KernelFuncs<jit::LayerNormTuple<T>,
+                                              lite::fluid::CPUPlace>::Cache()
+                   .At(right);
+    for (int i = 0; i < left; i++) {
+      const T *x_row = x + i * right;
+      const T *r_row = residual + (i % residual_rows) * right;
+      T *sum = add_out ? add_out + i * right : sum_row.data();
+      for (int j = 0; j < right; j++) sum[j] = x_row[j] + r_row[j];
+      ker(sum,
+          out + i * right,
+          mean + i,
+          var + i,
+          param.Scale->template data<T>(),
+          param.Bias->template data<T>(),
+          1,
+          param.epsilon,
+          right);
+    }
+  }
+
+  virtual ~FusionElementwiseAddLayerNormCompute() = default;
+};
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -0,0 +1,58 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/lookup_table_dequant_compute.h"
+#include "lite/backends/x86/math/embedding_dequant.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+void LookupTableDequantCompute::Run() {
+  auto& param = this->Param<param_t>();
+  auto* ids = param.Ids;
+  auto* out = param.Out;
+  const auto& table_dims = param.W->dims();
+  int64_t quant_number = table_dims[1];
+  int64_t row_width =
+      param.quant_bits != 0 ? param.row_width : (quant_number - 2) * 4;
+
+  lite::x86::math::embedding_dequant(param.W->data<float>(),
+                                     ids->data<int64_t>(),
+                                     out->mutable_data<float>(),
+                                     ids->numel(),
+                                     table_dims[0],
+                                     quant_number,
+                                     row_width,
+                                     param.quant_bits,
+                                     param.padding_idx);
+  *(out->mutable_lod()) = ids->lod();
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(lookup_table_dequant,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::LookupTableDequantCompute,
+                     def)
+    .BindInput("W", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Ids", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt64))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
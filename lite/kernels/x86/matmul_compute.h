@@ -13,7 +13,11 @@
 // limitations under the License.
 #pragma once
 
+#include <type_traits>
+#include "lite/backends/host/math/strided_matmul.h"
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/gemm_amx.h"
+#include "lite/backends/x86/math/softmax.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -49,6 +53,22 @@ class MatMulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
   using param_t = operators::MatMulParam;
 
+  void PrepareForRun() override {
+    auto &param = *param_.get_mutable<operators::MatMulParam>();
+    // Only the 2-D weights are packed, once, and X is taken as the rows of K.
+    auto *y = param.Y;
+    if (!std::is_same<T, float>::value ||
+        !lite::x86::math::AmxBF16Enabled() || !y->persistable() ||
+        y->dims().size() != 2 || param.transpose_X ||
+        lite::host::math::has_fused_transpose(param)) {
+      return;
+    }
+    int k = param.transpose_Y ? y->dims()[1] : y->dims()[0];
+    int n = param.transpose_Y ? y->dims()[0] : y->dims()[1];
+    amx_y_.PackBF16(y->template data<float>(), k, n, param.transpose_Y);
+    use_amx_ = true;
+  }
+
   void Run() override {
     auto &context = ctx_->As<X86Context>();
     auto &param = *param_.get_mutable<operators::MatMulParam>();
@@ -58,16 +78,66 @@ class MatMulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     auto *out = param.Out;
     out->template mutable_data<T>();
 
-    auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
-    auto mat_dim_a = lite::x86::math::CreateMatrixDescriptor(
-        RowMatrixFromVector(x->dims()), 0, param.transpose_X);
-    auto mat_dim_b = lite::x86::math::CreateMatrixDescriptor(
-        ColumnMatrixFromVector(y->dims()), 0, param.transpose_Y);
-    auto scale = static_cast<T>(param.alpha);
-    blas.MatMul(*x, mat_dim_a, *y, mat_dim_b, scale, out, T(0));
+    if (lite::host::math::has_fused_transpose(param)) {
+      // the gemm of each batch on the transposed views of X, Y and Out
+      lite::host::math::StridedMatmulArgs args;
+      lite::host::math::strided_matmul_args(param, &args);
+      auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
+      const T *x_data = x->template data<T>();
+      const T *y_data = y->template data<T>();
+      T *out_data = out->template mutable_data<T>();
+      for (size_t b = 0; b < args.out_offsets.size(); ++b) {
+        blas.GEMM(args.trans_x,
+                  args.trans_y,
+                  args.m,
+                  args.n,
+                  args.k,
+                  static_cast<T>(param.alpha),
+                  x_data + args.x_offsets[b],
+                  args.ldx,
+                  y_data + args.y_offsets[b],
+                  args.ldy,
+                  T(0),
+                  out_data + args.out_offsets[b],
+                  args.ldout);
+      }
+    } else if (use_amx_) {
+      lite::x86::math::AmxGemmBF16(x->numel() / amx_y_.K(),
+                                   x->template data<float>(),
+                                   amx_y_.K(),
+                                   amx_y_,
+                                   out->template mutable_data<float>(),
+                                   amx_y_.N(),
+                                   param.alpha,
+                                   nullptr,
+                                   false);
+    } else {
+      auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
+      auto mat_dim_a = lite::x86::math::CreateMatrixDescriptor(
+          RowMatrixFromVector(x->dims()), 0, param.transpose_X);
+      auto mat_dim_b = lite::x86::math::CreateMatrixDescriptor(
+          ColumnMatrixFromVector(y->dims()), 0, param.transpose_Y);
+      auto scale = static_cast<T>(param.alpha);
+      blas.MatMul(*x, mat_dim_a, *y, mat_dim_b, scale, out, T(0));
+    }
+
+    if (param.fuse_softmax) {
+      // softmax over the last axis, in place as rows of the output
+      auto out_dims = out->dims();
+      const int64_t cols = out_dims[out_dims.size() - 1];
+      out->Resize({out->numel() / cols, cols});
+      lite::x86::math::SoftmaxFunctor<lite::TargetType::kX86, T, true>()(
+          context, cols, out, out);
+      out->Resize(out_dims);
+    }
   }
 
   virtual ~MatMulCompute() = default;
+
+ private:
+  // The weights rounded to bf16 and packed for AMX, see AmxBF16Enabled.
+  bool use_amx_{false};
+  lite::x86::math::AmxPackedB amx_y_;
 };
 
 }  // namespace x86
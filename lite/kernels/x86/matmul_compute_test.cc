@@ -80,6 +80,58 @@ TEST(matmul_x86, run_test) {
   }
 }
 
+// The attention scores of q and k of [batch, seq, head, dim], with the head
+// transposes of both and of the output folded into the matmul.
+TEST(matmul_x86, fused_transpose) {
+  const int batch = 2, q_seq = 3, k_seq = 4, head = 2, dim = 5;
+  lite::Tensor q, k, out;
+  q.Resize({batch, q_seq, head, dim});
+  k.Resize({batch, k_seq, head, dim});
+  out.Resize({batch, q_seq, head, k_seq});
+  auto q_data = q.mutable_data<float>();
+  auto k_data = k.mutable_data<float>();
+  for (int64_t i = 0; i < q.numel(); i++) {
+    q_data[i] = static_cast<float>(i % 7) - 3.f;
+  }
+  for (int64_t i = 0; i < k.numel(); i++) {
+    k_data[i] = static_cast<float>(i % 5) - 2.f;
+  }
+
+  MatMulCompute<float> matmul;
+  operators::MatMulParam param;
+  param.X = &q;
+  param.Y = &k;
+  param.Out = &out;
+  param.alpha = 0.5f;
+  param.fused_transpose_X = {0, 2, 1, 3};
+  param.fused_transpose_Y = {0, 2, 3, 1};
+  param.fused_transpose_Out = {0, 2, 1, 3};
+
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  matmul.SetContext(std::move(ctx));
+  matmul.SetParam(param);
+  matmul.Run();
+
+  auto out_data = out.data<float>();
+  for (int b = 0; b < batch; b++) {
+    for (int i = 0; i < q_seq; i++) {
+      for (int h = 0; h < head; h++) {
+        for (int j = 0; j < k_seq; j++) {
+          float ref = 0.f;
+          for (int d = 0; d < dim; d++) {
+            ref += q_data[((b * q_seq + i) * head + h) * dim + d] *
+                   k_data[((b * k_seq + j) * head + h) * dim + d];
+          }
+          EXPECT_NEAR(out_data[((b * q_seq + i) * head + h) * k_seq + j],
+                      0.5f * ref,
+                      1e-3);
+        }
+      }
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -13,7 +13,9 @@
 // limitations under the License.
 #pragma once
 
+#include <type_traits>
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/gemm_amx.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -39,6 +41,26 @@ class MulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
   using param_t = operators::MulParam;
 
+  void PrepareForRun() override {
+    auto& param = *param_.get_mutable<operators::MulParam>();
+    // Only the weights are packed, once.
+    if (!std::is_same<T, float>::value ||
+        !lite::x86::math::AmxBF16Enabled() || !param.y->persistable()) {
+      return;
+    }
+    Tensor y_matrix;
+    if (param.y->dims().size() > 2) {
+      y_matrix = ReshapeToMatrix(*param.y, param.y_num_col_dims);
+    } else {
+      y_matrix = *param.y;
+    }
+    amx_y_.PackBF16(y_matrix.template data<float>(),
+                    y_matrix.dims()[0],
+                    y_matrix.dims()[1],
+                    false);
+    use_amx_ = true;
+  }
+
   void Run() override {
     auto& context = ctx_->As<X86Context>();
     auto& param = *param_.get_mutable<operators::MulParam>();
@@ -70,15 +92,32 @@ class MulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
       z->Resize({x_matrix.dims()[0], y_matrix.dims()[1]});
     }
 
-    auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
-
-    blas.MatMul(x_matrix, y_matrix, z);
+    if (use_amx_) {
+      lite::x86::math::AmxGemmBF16(x_matrix.dims()[0],
+                                   x_matrix.template data<float>(),
+                                   x_matrix.dims()[1],
+                                   amx_y_,
+                                   z->template mutable_data<float>(),
+                                   y_matrix.dims()[1],
+                                   1.f,
+                                   nullptr,
+                                   false);
+    } else {
+      auto blas =
+          lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
+      blas.MatMul(x_matrix, y_matrix, z);
+    }
     if (z_dim.size() != 2) {
       z->Resize(z_dim);
     }
   }
 
   virtual ~MulCompute() = default;
+
+ private:
+  // The weights rounded to bf16 and packed for AMX, see AmxBF16Enabled.
+  bool use_amx_{false};
+  lite::x86::math::AmxPackedB amx_y_;
 };
 
 }  // namespace x86
@@ -13,17 +13,203 @@
 // limitations under the License.
 
 #include "lite/model_parser/flatbuffers/io.h"
+#include <algorithm>
 #include <cstring>
 #include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
+#include "lite/core/memory_planner.h"
 #include "lite/core/model/base/io.h"
+#include "lite/core/parallel_defines.h"
 #include "lite/model_parser/flatbuffers/traits.h"
+#include "lite/utils/compression.h"
 
 namespace paddle {
 namespace lite {
 namespace fbs {
+namespace {
+enum ParamCodec : uint32_t { kRawParam = 0, kLZ4Param = 1 };
+
+struct ParamCodecHeader {
+  uint32_t codec;
+  // The bytes of the elements are shuffled by this size before compressed.
+  uint32_t elem_size;
+  uint64_t raw_size;
+};
+static_assert(sizeof(ParamCodecHeader) == 16, "Unexpected codec header.");
+
+// The blocks are small enough to be decompressed by all the threads even for
+// the models of a few large weights.
+const size_t kParamBlockSize = 1 << 20;
+// The streamed params are decompressed once this many bytes are pending.
+const size_t kParamDecodeBatchSize = 32 << 20;
+
+// A block of the compressed param to be decompressed into the tensor, which
+// is stored raw if its size is not reduced.
+struct ParamBlock {
+  const char* src;
+  size_t src_size;
+  char* dst;
+  size_t dst_size;
+  size_t elem_size;
+};
+
+void DecodeParamBlocks(std::vector<ParamBlock>* blocks) {
+  LITE_PARALLEL_BEGIN(i, tid, static_cast<int>(blocks->size())) {
+    const ParamBlock& block = (*blocks)[i];
+    if (block.src_size == block.dst_size) {
+      std::memcpy(block.dst, block.src, block.dst_size);
+    } else if (block.elem_size <= 1) {
+      CHECK(LZ4Decompress(block.src, block.src_size, block.dst, block.dst_size))
+          << "The compressed param is broken.";
+    } else {
+      std::vector<char> shuffled(block.dst_size);
+      CHECK(LZ4Decompress(
+          block.src, block.src_size, shuffled.data(), block.dst_size))
+          << "The compressed param is broken.";
+      UnshuffleBytes(
+          shuffled.data(), block.dst_size, block.elem_size, block.dst);
+    }
+  }
+  LITE_PARALLEL_END();
+  blocks->clear();
+}
+
+void CopyTensorData(lite::Tensor* tensor,
+                    const ParamDescReadAPI& param,
+                    const void* data,
+                    size_t size) {
+  CHECK(tensor);
+  tensor->Resize(param.Dim());
+  tensor->set_precision(lite::ConvertPrecisionType(param.GetDataType()));
+  auto* dst = tensor->mutable_data(size);
+  CHECK(dst);
+  CHECK(data);
+  std::memcpy(dst, data, size);
+  tensor->set_persistable(true);
+}
+
+void ShareTensorData(lite::Tensor* tensor,
+                     const ParamDescReadAPI& param,
+                     const void* data,
+                     size_t size,
+                     const std::shared_ptr<lite::Buffer>& mapping) {
+  CHECK(tensor);
+  CHECK(mapping);
+  // The kernels may require the weights to be aligned, the unaligned ones,
+  // e.g. in the models saved by the previous versions, are copied.
+  if (reinterpret_cast<size_t>(data) % kParamAlignment != 0) {
+    CopyTensorData(tensor, param, data, size);
+    return;
+  }
+  size_t offset = static_cast<const char*>(data) -
+                  static_cast<const char*>(mapping->data());
+  tensor->Resize(param.Dim());
+  tensor->set_precision(lite::ConvertPrecisionType(param.GetDataType()));
+  tensor->ResetBuffer(
+      std::make_shared<ArenaBuffer>(mapping, offset, size, TARGET(kHost)),
+      size);
+  tensor->set_persistable(true);
+}
+
+// Set the tensor with the param of the compressed version. The raw data is
+// shared in the mapping if given, while the compressed blocks are appended to
+// `blocks`, and returns whether there are any.
+bool DecodeParam(lite::Tensor* tensor,
+                 const ParamDescReadAPI& param,
+                 const std::shared_ptr<lite::Buffer>& mapping,
+                 std::vector<ParamBlock>* blocks) {
+  CHECK_GE(param.byte_size(), sizeof(ParamCodecHeader))
+      << "The param is broken.";
+  const char* data = static_cast<const char*>(param.GetData());
+  const char* end = data + param.byte_size();
+  ParamCodecHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  data += sizeof(header);
+  if (header.codec == kRawParam) {
+    CHECK_EQ(static_cast<size_t>(end - data), header.raw_size)
+        << "The param is broken.";
+    if (mapping) {
+      ShareTensorData(tensor, param, data, header.raw_size, mapping);
+    } else {
+      CopyTensorData(tensor, param, data, header.raw_size);
+    }
+    return false;
+  }
+  CHECK_EQ(header.codec, kLZ4Param) << "Unknown codec of the param.";
+  CHECK(tensor);
+  tensor->Resize(param.Dim());
+  tensor->set_precision(lite::ConvertPrecisionType(param.GetDataType()));
+  char* dst = static_cast<char*>(tensor->mutable_data(header.raw_size));
+  tensor->set_persistable(true);
+  const size_t block_count =
+      (header.raw_size + kParamBlockSize - 1) / kParamBlockSize;
+  CHECK_GE(static_cast<size_t>(end - data), block_count * sizeof(uint32_t))
+      << "The param is broken.";
+  const char* src = data + block_count * sizeof(uint32_t);
+  for (size_t i = 0; i < block_count; ++i) {
+    uint32_t src_size;
+    std::memcpy(&src_size, data + i * sizeof(uint32_t), sizeof(src_size));
+    CHECK_LE(src_size, static_cast<size_t>(end - src))
+        << "The param is broken.";
+    size_t offset = i * kParamBlockSize;
+    size_t dst_size = std::min<size_t>(kParamBlockSize,
+                                       header.raw_size - offset);
+    blocks->push_back(
+        {src, src_size, dst + offset, dst_size, header.elem_size});
+    src += src_size;
+  }
+  return block_count > 0;
+}
+
+#ifdef LITE_WITH_FLATBUFFERS_DESC
+// Encode the data of the tensor into `out` with the codec header. The blocks
+// are compressed after the bytes shuffled by the size of the elements, and
+// the tensor is stored raw if the compression saves less than 1/8.
+void EncodeParam(const lite::Tensor& tensor, std::vector<char>* out) {
+  const char* data = static_cast<const char*>(tensor.raw_data());
+  const size_t size = tensor.memory_size();
+  size_t elem_size = lite_api::PrecisionTypeLength(tensor.precision());
+  if (elem_size != 2 && elem_size != 4 && elem_size != 8) elem_size = 1;
+  ParamCodecHeader header{kLZ4Param, static_cast<uint32_t>(elem_size), size};
+  const size_t block_count = (size + kParamBlockSize - 1) / kParamBlockSize;
+  out->assign(sizeof(header) + block_count * sizeof(uint32_t), 0);
+  std::vector<char> shuffled(std::min(size, kParamBlockSize));
+  std::vector<char> compressed(LZ4CompressBound(kParamBlockSize));
+  for (size_t i = 0; i < block_count; ++i) {
+    const char* block = data + i * kParamBlockSize;
+    const size_t block_size =
+        std::min(kParamBlockSize, size - i * kParamBlockSize);
+    const char* src = block;
+    if (elem_size > 1) {
+      ShuffleBytes(block, block_size, elem_size, shuffled.data());
+      src = shuffled.data();
+    }
+    uint32_t compressed_size = LZ4Compress(
+        src, block_size, compressed.data(), compressed.size());
+    if (compressed_size == 0 || compressed_size >= block_size) {
+      compressed_size = block_size;
+      out->insert(out->end(), block, block + block_size);
+    } else {
+      out->insert(out->end(),
+                  compressed.data(),
+                  compressed.data() + compressed_size);
+    }
+    std::memcpy(out->data() + sizeof(header) + i * sizeof(uint32_t),
+                &compressed_size,
+                sizeof(compressed_size));
+  }
+  if (out->size() - sizeof(header) > size - size / 8) {
+    header.codec = kRawParam;
+    out->resize(sizeof(header));
+    out->insert(out->end(), data, data + size);
+  }
+  std::memcpy(out->data(), &header, sizeof(header));
+}
+#endif
+}  // namespace
+
 namespace deprecated {
 void SetCombinedParamsWithScope(const lite::Scope& scope,
                                 const std::set<std::string>& param_names,
@@ -36,14 +222,19 @@ void SetCombinedParamsWithScope(const lite::Scope& scope,
 }
 
 void SetScopeWithCombinedParams(lite::Scope* scope,
-                                const CombinedParamsDescReadAPI& params) {
+                                const CombinedParamsDescReadAPI& params,
+                                const std::shared_ptr<lite::Buffer>& mapping) {
   CHECK(scope);
   for (size_t i = 0; i < params.GetParamsSize(); ++i) {
     const auto* param = params.GetParamDesc(i);
     CHECK(param);
     auto* tensor = scope->Var(param->Name())->GetMutable<lite::Tensor>();
     CHECK(tensor);
-    FillTensor(tensor, *param);
+    if (mapping) {
+      ShareTensor(tensor, *param, mapping);
+    } else {
+      FillTensor(tensor, *param);
+    }
   }
 }
 }  // namespace deprecated
@@ -59,18 +250,24 @@ void FillParam(const std::string& name,
 }
 
 void FillTensor(lite::Tensor* tensor, const ParamDescReadAPI& param) {
-  CHECK(tensor);
-  tensor->Resize(param.Dim());
-  tensor->set_precision(lite::ConvertPrecisionType(param.GetDataType()));
-  auto* dst = tensor->mutable_data(param.byte_size());
-  CHECK(dst);
-  CHECK(param.GetData());
-  std::memcpy(dst, param.GetData(), param.byte_size());
-  tensor->set_persistable(true);
+  CopyTensorData(tensor, param, param.GetData(), param.byte_size());
+}
+
+void ShareTensor(lite::Tensor* tensor,
+                 const ParamDescReadAPI& param,
+                 const std::shared_ptr<lite::Buffer>& mapping) {
+  ShareTensorData(tensor, param, param.GetData(), param.byte_size(), mapping);
 }
+
 #ifdef LITE_WITH_FLATBUFFERS_DESC
 void ParamSerializer::ForwardWrite(const lite::Scope& scope,
                                    const std::set<std::string>& param_names) {
+  std::vector<std::string> names(param_names.begin(), param_names.end());
+  ForwardWrite(scope, names);
+}
+
+void ParamSerializer::ForwardWrite(
+    const lite::Scope& scope, const std::vector<std::string>& param_names) {
   const uint16_t params_size = param_names.size();
   // meta_information
   uint32_t max_tensor_size = 0;
@@ -92,19 +289,67 @@ void ParamSerializer::ForwardWrite(const lite::Scope& scope,
   writer_->Write<uint32_t>(max_tensor_size);
 
   for (const auto& name : param_names) {
-    fbs::ParamDesc param;
     auto& tensor = scope.FindVar(name)->Get<lite::Tensor>();
-    FillParam(name, tensor, &param);
-    param.CopyDataToBuffer(buf_.get());
-
-    const size_t param_bytes = buf_->size();
+    // Pack the param with the data of the tensor directly and write the
+    // packed bytes, so that the data is copied only once.
+    if (version_ == kCompressedParamsVersion) {
+      EncodeParam(tensor, &encoded_);
+      PackParam(name, tensor, encoded_.data(), encoded_.size());
+    } else {
+      PackParam(name, tensor, tensor.raw_data(), tensor.memory_size());
+    }
+    const char* param_data =
+        reinterpret_cast<const char*>(fbb_.GetBufferPointer());
+    const size_t param_bytes = fbb_.GetSize();
     CHECK(param_bytes) << "The bytes size of param can not be zero";
-    constexpr uint32_t offset = sizeof(uint32_t);
+    // Pad before the param to align its data in the file, so that the
+    // tensor can share the data of the mapped file in place. The padding is
+    // skipped by the readers according to the offset.
+    const size_t data_offset =
+        static_cast<const char*>(
+            ParamDescView(param_data, param_bytes).GetData()) -
+        param_data;
+    size_t data_pos = writer_->current() + 2 * sizeof(uint32_t) + data_offset;
+    if (version_ == kCompressedParamsVersion) {
+      data_pos += sizeof(ParamCodecHeader);
+    }
+    const uint32_t padding_bytes =
+        (kParamAlignment - data_pos % kParamAlignment) % kParamAlignment;
+    const uint32_t offset = sizeof(uint32_t) + padding_bytes;
     const uint32_t total_size = param_bytes + offset;
     writer_->Write<uint32_t>(total_size);
     writer_->Write<uint32_t>(offset);
-    writer_->Write(buf_->data(), param_bytes);
+    for (uint32_t i = 0; i < padding_bytes; ++i) {
+      writer_->Write<uint8_t>(0U);
+    }
+    writer_->Write(param_data, param_bytes);
   }
+  // Release the memory of the largest param.
+  fbb_.Reset();
+  std::vector<char>().swap(encoded_);
+}
+
+void ParamSerializer::PackParam(const std::string& name,
+                                const lite::Tensor& tensor,
+                                const void* data_ptr,
+                                size_t size) {
+  fbb_.Clear();
+  auto data = fbb_.CreateVector(static_cast<const int8_t*>(data_ptr), size);
+  auto dim = fbb_.CreateVector(tensor.dims().Vectorize());
+  auto lod_tensor = proto::ParamDesc_::CreateLoDTensorDesc(
+      fbb_,
+      0,
+      0,
+      dim,
+      ConvertVarType(lite::ConvertPrecisionType(tensor.precision())),
+      data);
+  auto desc = proto::CreateParamDesc(
+      fbb_,
+      0,
+      fbb_.CreateString(name),
+      proto::ParamDesc_::VariableDesc_LoDTensorDesc,
+      lod_tensor.Union());
+  fbb_.Finish(desc);
 }
 
 void ParamSerializer::WriteHeader() {
@@ -124,23 +369,52 @@ void ParamDeserializer::ForwardRead(lite::Scope* scope) {
   uint32_t max_tensor_size =
       *reinterpret_cast<uint32_t const*>(data + sizeof(uint16_t));
 
-  buf_->ResetLazy(max_tensor_size);
+  auto mapping = reader_->mapping();
+  if (!mapping) buf_->ResetLazy(max_tensor_size);
+  // The compressed blocks are decompressed in parallel, directly from the
+  // mapping, or from the streamed params kept until their batch is done.
+  std::vector<ParamBlock> blocks;
+  std::vector<std::unique_ptr<model_parser::Buffer>> pending_bufs;
+  size_t pending_size = 0;
   for (size_t i = 0; i < params_size; ++i) {
     uint32_t total_size = reader_->Read<uint32_t>();
     uint32_t offset = reader_->Read<uint32_t>();
     uint32_t param_bytes = total_size - offset;
     ReadBytesToBuffer(offset - sizeof(offset));
-    ReadBytesToBuffer(param_bytes);
-    fbs::ParamDescView param(buf_.get());
-    FillTensor(scope->Var(param.Name())->GetMutable<lite::Tensor>(), param);
+    if (mapping) {
+      fbs::ParamDescView param(reader_->ReadInPlace(param_bytes), param_bytes);
+      auto* tensor = scope->Var(param.Name())->GetMutable<lite::Tensor>();
+      if (version_ == kCompressedParamsVersion) {
+        DecodeParam(tensor, param, mapping, &blocks);
+      } else {
+        ShareTensor(tensor, param, mapping);
+      }
+    } else {
+      ReadBytesToBuffer(param_bytes);
+      fbs::ParamDescView param(buf_.get());
+      auto* tensor = scope->Var(param.Name())->GetMutable<lite::Tensor>();
+      if (version_ != kCompressedParamsVersion) {
+        FillTensor(tensor, param);
+      } else if (DecodeParam(tensor, param, nullptr, &blocks)) {
+        pending_bufs.emplace_back(std::move(buf_));
+        buf_.reset(new model_parser::Buffer);
+        pending_size += param_bytes;
+        if (pending_size >= kParamDecodeBatchSize) {
+          DecodeParamBlocks(&blocks);
+          pending_bufs.clear();
+          pending_size = 0;
+        }
+      }
+    }
   }
+  DecodeParamBlocks(&blocks);
 }
 
 void ParamDeserializer::ReadHeader() {
   // 1. version id
-  uint16_t version = reader_->Read<uint16_t>();
-  CHECK_EQ(version, 0U)
-      << "File format error: The version of params must be zero.";
+  version_ = reader_->Read<uint16_t>();
+  CHECK_LE(version_, kCompressedParamsVersion)
+      << "File format error: Unsupported version of params: " << version_;
   // 2. meta version
   uint16_t meta_size = reader_->Read<uint16_t>();
   ReadBytesToBuffer(meta_size);
@@ -33,24 +33,46 @@ void FillParam(const std::string& name,
 
 void FillTensor(lite::Tensor* tensor, const ParamDescReadAPI& param);
 
+// The data of the params are aligned in the saved models.
+constexpr size_t kParamAlignment = 64;
+
+// Share the data of `param` in the `mapping` memory, or copy it if unaligned.
+void ShareTensor(lite::Tensor* tensor,
+                 const ParamDescReadAPI& param,
+                 const std::shared_ptr<lite::Buffer>& mapping);
+
+// The data of the params of this version starts with a codec header, and the
+// compressed ones are split into the blocks decompressed independently.
+constexpr uint16_t kCompressedParamsVersion = 1;
+
 #ifdef LITE_WITH_FLATBUFFERS_DESC
 class ParamSerializer {
  public:
   explicit ParamSerializer(model_parser::ByteWriter* writer,
                            uint16_t version = 0)
-      : writer_(writer), version_{version}, buf_(new model_parser::Buffer) {
+      : writer_(writer), version_{version} {
     CHECK(writer_)
         << "A valid writer should be passed in the ctor of param serializer.";
     WriteHeader();
   }
+  // The params are written in the order of `param_names`.
+  void ForwardWrite(const lite::Scope& scope,
+                    const std::vector<std::string>& param_names);
   void ForwardWrite(const lite::Scope& scope,
                     const std::set<std::string>& param_names);
 
  private:
   void WriteHeader();
+  // Pack the param with `data` of `size` bytes into fbb_.
+  void PackParam(const std::string& name,
+                 const lite::Tensor& tensor,
+                 const void* data,
+                 size_t size);
   model_parser::ByteWriter* writer_{nullptr};
   uint16_t version_{0};
-  std::unique_ptr<model_parser::Buffer> buf_;
+  flatbuffers::FlatBufferBuilder fbb_;
+  // The encoded data of the param of the compressed version.
+  std::vector<char> encoded_;
 };
 #endif
 
@@ -72,11 +94,15 @@ class ParamDeserializer {
   void ReadHeader();
   model_parser::ByteReader* reader_{nullptr};
   std::unique_ptr<model_parser::Buffer> buf_;
+  uint16_t version_{0};
 };
 
 namespace deprecated {
-void SetScopeWithCombinedParams(lite::Scope* scope,
-                                const CombinedParamsDescReadAPI& params);
+// The params share the data in `mapping` if it is given.
+void SetScopeWithCombinedParams(
+    lite::Scope* scope,
+    const CombinedParamsDescReadAPI& params,
+    const std::shared_ptr<lite::Buffer>& mapping = nullptr);
 void SetCombinedParamsWithScope(const lite::Scope& scope,
                                 const std::set<std::string>& param_names,
                                 CombinedParamsDescWriteAPI* params);
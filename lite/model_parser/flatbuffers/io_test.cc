@@ -15,6 +15,7 @@
 #include "lite/model_parser/flatbuffers/io.h"
 #include <gtest/gtest.h>
 #include <functional>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -100,6 +101,15 @@ TEST(CombinedParamsDesc, Scope) {
   /* --------- View scope ---------- */
   Scope scope_1;
   combined_param.CopyDataToBuffer(&buffer);
+  {
+    /* --------- In-place view scope ---------- */
+    Scope scope_6;
+    auto shared = std::make_shared<lite::Buffer>();
+    shared->CopyDataFrom(*buffer.raw(), buffer.size());
+    CombinedParamsDescView in_place_view(shared->data(), buffer.size());
+    deprecated::SetScopeWithCombinedParams(&scope_6, in_place_view, shared);
+    check_params(scope_6);
+  }
   CombinedParamsDescView combined_param_view(std::move(buffer));
   deprecated::SetScopeWithCombinedParams(&scope_1, combined_param_view);
   check_params(scope_1);
@@ -128,6 +138,103 @@ TEST(CombinedParamsDesc, Scope) {
     deserializer.ForwardRead(&scope_3);
     check_params(scope_3);
   }
+
+  {
+    Scope scope_5;
+    LOG(INFO) << "Load params from shared buffer...";
+    model_parser::BinaryFileReader file_reader(path);
+    auto shared = std::make_shared<lite::Buffer>();
+    shared->ResetLazy(TARGET(kHost), file_reader.length());
+    file_reader.Read(shared->data(), file_reader.length());
+    model_parser::SharedBufferReader reader(shared);
+    fbs::ParamDeserializer deserializer(&reader);
+    deserializer.ForwardRead(&scope_5);
+    check_params(scope_5);
+    shared.reset();
+    // The tensors keep the shared buffer alive.
+    check_params(scope_5);
+  }
+
+#if !defined(_WIN32)
+  {
+    Scope scope_4;
+    LOG(INFO) << "Load params from mapped file...";
+    model_parser::MappedFileReader reader(path);
+    fbs::ParamDeserializer deserializer(&reader);
+    deserializer.ForwardRead(&scope_4);
+    check_params(scope_4);
+    // The aligned params share the mapped data in place.
+    const char* begin = static_cast<const char*>(reader.mapping()->data());
+    const char* end = begin + reader.length();
+    for (auto& name : param_names) {
+      const char* data = static_cast<const char*>(
+          scope_4.FindVar(name)->Get<Tensor>().raw_data());
+      CHECK(data >= begin && data < end);
+      CHECK_EQ(reinterpret_cast<size_t>(data) % kParamAlignment, 0U);
+    }
+  }
+#endif
+}
+
+TEST(ParamSerializer, Compressed) {
+  const std::string path{"io_test.compressed.params.fbs"};
+  Scope scope;
+  // The large params are split into several blocks.
+  std::vector<std::string> param_names({"var_0", "var_1", "var_2", "var_3"});
+  set_tensor<float>(scope.Var(param_names[0])->GetMutable<Tensor>(),
+                    std::vector<int64_t>({600, 1000}));
+  set_tensor<int8_t>(scope.Var(param_names[1])->GetMutable<Tensor>(),
+                     std::vector<int64_t>({10, 1}));
+  set_tensor<int16_t>(scope.Var(param_names[2])->GetMutable<Tensor>(),
+                      std::vector<int64_t>({16, 1}));
+  // The random params are stored raw.
+  Tensor* tensor_3 = scope.Var(param_names[3])->GetMutable<Tensor>();
+  tensor_3->Resize({300, 1000});
+  tensor_3->set_persistable(true);
+  auto* data_3 = tensor_3->mutable_data<int32_t>();
+  std::mt19937 engine(1);
+  for (int64_t i = 0; i < tensor_3->numel(); ++i) {
+    data_3[i] = static_cast<int32_t>(engine());
+  }
+  {
+    model_parser::BinaryFileWriter writer{path};
+    fbs::ParamSerializer serializer{&writer, kCompressedParamsVersion};
+    serializer.ForwardWrite(scope, param_names);
+  }
+
+  auto check_params = [&](const lite::Scope& loaded) {
+    for (auto& name : param_names) {
+      Variable* var = loaded.FindVar(name);
+      CHECK(var);
+      CHECK(TensorCompareWith(scope.FindVar(name)->Get<Tensor>(),
+                              var->Get<Tensor>()));
+    }
+  };
+
+  {
+    Scope scope_0;
+    model_parser::BinaryFileReader reader(path);
+    fbs::ParamDeserializer deserializer(&reader);
+    deserializer.ForwardRead(&scope_0);
+    check_params(scope_0);
+  }
+
+#if !defined(_WIN32)
+  {
+    Scope scope_1;
+    model_parser::MappedFileReader reader(path);
+    fbs::ParamDeserializer deserializer(&reader);
+    deserializer.ForwardRead(&scope_1);
+    check_params(scope_1);
+    // The raw params still share the mapped data in place.
+    const char* begin = static_cast<const char*>(reader.mapping()->data());
+    const char* data = static_cast<const char*>(
+        scope_1.FindVar(param_names[3])->Get<Tensor>().raw_data());
+    CHECK(data >= begin && data < begin + reader.length());
+    CHECK_LT(reader.length(),
+             scope.FindVar(param_names[0])->Get<Tensor>().memory_size());
+  }
+#endif
 }
 #endif  // LITE_WITH_FLATBUFFERS_DESC
 
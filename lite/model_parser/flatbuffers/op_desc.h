@@ -20,6 +20,7 @@
 #include <utility>
 #include <vector>
 
+#include "lite/core/model/base/decoded_attrs.h"
 #include "lite/core/model/base/op_desc.h"
 #include "lite/model_parser/flatbuffers/framework_generated.h"
 #include "lite/model_parser/flatbuffers/traits.h"
@@ -136,8 +137,15 @@ class OpDescView : public OpDescAPI {
   typename lite::OpDataTypeTrait<T, Flatbuffers>::RT GetAttr(
       const std::string& name) const;
 
+  // The attributes decoded into the struct T once, see DecodedAttrsCache.
+  template <typename T>
+  const T& DecodedAttrs() const {
+    return decoded_attrs_.Get<T>(*this);
+  }
+
  private:
   proto::OpDesc const* desc_;
+  DecodedAttrsCache decoded_attrs_;
 
   // To reduce overhead, we expect to use namespace aliasing to make cpp::Desc
   // and flatbuffers::Desc replace each other. However, there is no direct
@@ -34,12 +34,16 @@ class ParamDescView : public ParamDescReadAPI {
  public:
   explicit ParamDescView(model_parser::Buffer* buf) {
     CHECK(buf) << "The pointer in buf can not be nullptr";
-    flatbuffers::Verifier verifier(static_cast<const uint8_t*>(buf->data()),
-                                   buf->size());
+    Init(buf->data(), buf->size());
+  }
+  // View the param in place, `data` should outlive the view.
+  ParamDescView(const void* data, size_t size) { Init(data, size); }
+  void Init(const void* data, size_t size) {
+    CHECK(data) << "The param data can not be nullptr";
+    flatbuffers::Verifier verifier(static_cast<const uint8_t*>(data), size);
     CHECK(verifier.VerifyBuffer<paddle::lite::fbs::proto::ParamDesc>(nullptr))
         << "Param verification failed.";
-    desc_ =
-        flatbuffers::GetRoot<paddle::lite::fbs::proto::ParamDesc>(buf->data());
+    desc_ = flatbuffers::GetRoot<paddle::lite::fbs::proto::ParamDesc>(data);
     Init();
   }
   explicit ParamDescView(proto::ParamDesc const* desc) : desc_(desc) { Init(); }
@@ -89,19 +93,24 @@ class CombinedParamsDescView : public CombinedParamsDescReadAPI {
     Init(std::forward<model_parser::Buffer>(buf));
   }
 
+  // View the params in place, `data` should outlive the view.
+  CombinedParamsDescView(const void* data, size_t size) {
+    InitParams(data, size);
+  }
+
   void Init(model_parser::Buffer&& buf) {
     CHECK(buf.data());
     buf_ = std::move(buf);
-    InitParams();
+    InitParams(buf_.data(), buf_.size());
   }
 
-  void InitParams() {
-    flatbuffers::Verifier verifier(static_cast<const uint8_t*>(buf_.data()),
-                                   buf_.size());
+  void InitParams(const void* data, size_t size) {
+    CHECK(data);
+    flatbuffers::Verifier verifier(static_cast<const uint8_t*>(data), size);
     CHECK(verifier.VerifyBuffer<paddle::lite::fbs::proto::CombinedParamsDesc>(
         nullptr))
         << "CombinedParamsDesc verification failed.";
-    desc_ = proto::GetCombinedParamsDesc(buf_.data());
+    desc_ = proto::GetCombinedParamsDesc(data);
     CHECK(desc_);
     CHECK(desc_->params());
     size_t params_size = desc_->params()->size();
@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <fstream>
 #include <limits>
+#include <memory>
 #include <set>
 #include <utility>
 
@@ -51,19 +52,35 @@ void LoadLoDTensor(model_parser::pb::LoDTensorDeserializer *loader,
   loader->ForwardRead(tensor, reader);
 }
 
-std::unique_ptr<framework::proto::ProgramDesc> LoadProgram(
-    const std::string &path, const lite_api::CxxModelBuffer &model_buffer) {
-  std::unique_ptr<framework::proto::ProgramDesc> main_program(
-      new framework::proto::ProgramDesc);
-  if (model_buffer.is_empty()) {
-    model_parser::BinaryFileReader file(path);
-    main_program->ParseFromString(file.ReadToString(file.length()));
-  } else {
+framework::proto::ProgramDesc *LoadProgram(
+    const std::string &path,
+    const lite_api::CxxModelBuffer &model_buffer,
+    google::protobuf::Arena *arena) {
+  auto *main_program =
+      google::protobuf::Arena::CreateMessage<framework::proto::ProgramDesc>(
+          arena);
+  if (!model_buffer.is_empty()) {
     main_program->ParseFromString(model_buffer.get_program());
+    return main_program;
   }
+#if !defined(_WIN32)
+  // Parse the mapped file in place instead of a copy of it.
+  model_parser::MappedFileReader file(path);
+  main_program->ParseFromArray(file.ReadInPlace(file.length()),
+                               static_cast<int>(file.length()));
+#else
+  model_parser::BinaryFileReader file(path);
+  main_program->ParseFromString(file.ReadToString(file.length()));
+#endif
   return main_program;
 }
 
+std::unique_ptr<framework::proto::ProgramDesc> LoadProgram(
+    const std::string &path, const lite_api::CxxModelBuffer &model_buffer) {
+  return std::unique_ptr<framework::proto::ProgramDesc>(
+      LoadProgram(path, model_buffer, nullptr));
+}
+
 // Load directly to CPU, and latter transfer to other devices.
 void LoadParam(const std::string &path, Variable *out) {
   model_parser::BinaryFileReader reader(path);
@@ -102,7 +119,15 @@ void LoadCombinedParamsPb(const std::string &path,
     reader.reset(
         new model_parser::StringBufferReader(model_buffer.get_params()));
   } else {
-    reader.reset(new model_parser::BinaryFileReader(path));
+#if !defined(_WIN32)
+    // Copy the tensors from the mapped file, whose pages are read ahead all
+    // together, instead of reading them through the file stream.
+    if (!paramlist.empty()) {
+      reader.reset(new model_parser::MappedFileReader(path));
+      model_parser::ReadAhead(reader->mapping()->data(), reader->length());
+    }
+#endif
+    if (!reader) reader.reset(new model_parser::BinaryFileReader(path));
   }
   model_parser::pb::LoDTensorDeserializer loader;
   if (!paramlist.empty()) {
@@ -240,9 +265,10 @@ void LoadModelPb(const std::string &model_dir,
   if (model_buffer.is_empty()) {
     OPT_LOG << "Loading topology data from " << prog_path;
   }
-  framework::proto::ProgramDesc pb_proto_prog =
-      *LoadProgram(prog_path, model_buffer);
-  pb::ProgramDesc pb_prog(&pb_proto_prog);
+  // The messages of the program are freed at once with the arena after
+  // transformed, instead of one by one.
+  google::protobuf::Arena arena;
+  pb::ProgramDesc pb_prog(LoadProgram(prog_path, model_buffer, &arena));
   // Transform to cpp::ProgramDesc
   TransformProgramDescAnyToCpp(pb_prog, cpp_prog);
   general::ssa::ConvertToSSA(cpp_prog);
@@ -496,10 +522,39 @@ void AppendToFile(const std::string &filename,
   }
   fclose(fp);
 }
+namespace {
+// The params in the order of their first use by the ops, so the weights
+// mapped from the saved model are paged in sequentially by the first run
+// instead of at random. The params unused by the ops follow by name.
+std::vector<std::string> ParamsInExecutionOrder(
+    const cpp::ProgramDesc &cpp_prog, const std::set<std::string> &params) {
+  std::vector<std::string> ordered;
+  std::set<std::string> added;
+  for (size_t block_idx = 0; block_idx < cpp_prog.BlocksSize(); ++block_idx) {
+    auto &block_desc = *cpp_prog.GetBlock<cpp::BlockDesc>(block_idx);
+    for (size_t op_idx = 0; op_idx < block_desc.OpsSize(); ++op_idx) {
+      auto &op_desc = *block_desc.GetOp<cpp::OpDesc>(op_idx);
+      for (auto &arg : op_desc.InputArgumentNames()) {
+        for (auto &name : op_desc.Input(arg)) {
+          if (params.count(name) && added.insert(name).second) {
+            ordered.push_back(name);
+          }
+        }
+      }
+    }
+  }
+  for (auto &name : params) {
+    if (added.insert(name).second) ordered.push_back(name);
+  }
+  return ordered;
+}
+}  // namespace
+
 /* ---------- Flatbuffers ---------- */
 void SaveModelNaive(const std::string &model_file,
                     const Scope &exec_scope,
-                    const cpp::ProgramDesc &cpp_prog) {
+                    const cpp::ProgramDesc &cpp_prog,
+                    bool compress_weights) {
   model_parser::Buffer buffer;
   /* 1. Save model to model.fbs */
   const std::string prog_path = model_file + ".nb";
@@ -547,6 +602,9 @@ void SaveModelNaive(const std::string &model_file,
   /* 3. Save paramdesc info into model file */
   switch (meta_version) {
     case 1: {
+      if (compress_weights) {
+        LOG(WARNING) << "The weights are not compressed in meta_version 1.";
+      }
       /* 3.1 Save combined params to params.fbs */
       fbs::CombinedParamsDesc params_prog;
       fbs::deprecated::SetCombinedParamsWithScope(
@@ -556,9 +614,12 @@ void SaveModelNaive(const std::string &model_file,
       break;
     }
     case 2: {
-      fbs::ParamSerializer serializer{&writer};
+      uint16_t params_version = 0;
+      if (compress_weights) params_version = fbs::kCompressedParamsVersion;
+      fbs::ParamSerializer serializer{&writer, params_version};
       // 3.2 Save params into naive model
-      serializer.ForwardWrite(exec_scope, unique_var_names);
+      serializer.ForwardWrite(
+          exec_scope, ParamsInExecutionOrder(cpp_prog, unique_var_names));
       break;
     }
     default: {
@@ -774,17 +835,23 @@ void LoadModelNaiveFromMemory(const std::string &model_buffer,
 
 void LoadModelNaiveFromFile(const std::string &filename,
                             Scope *scope,
-                            cpp::ProgramDesc *cpp_prog) {
+                            cpp::ProgramDesc *cpp_prog,
+                            bool use_mmap) {
   CHECK(cpp_prog);
   CHECK(scope);
   // ModelFile
   const std::string prog_path = filename;
   // Offset
-  model_parser::BinaryFileReader reader(filename, 0);
+  std::unique_ptr<model_parser::ByteReader> reader;
+  if (use_mmap) {
+    reader.reset(new model_parser::MappedFileReader(filename, 0));
+  } else {
+    reader.reset(new model_parser::BinaryFileReader(filename, 0));
+  }
 
   // (1)get meta version
   uint16_t meta_version;
-  reader.Read(&meta_version, sizeof(uint16_t));
+  reader->Read(&meta_version, sizeof(uint16_t));
   VLOG(4) << "Meta_version:" << meta_version;
 
   switch (meta_version) {
@@ -798,10 +865,10 @@ void LoadModelNaiveFromFile(const std::string &filename,
 #endif
       break;
     case 1:
-      LoadModelFbsFromFile(&reader, scope, cpp_prog, 1);
+      LoadModelFbsFromFile(reader.get(), scope, cpp_prog, 1);
       break;
     case 2:
-      LoadModelFbsFromFile(&reader, scope, cpp_prog, 2);
+      LoadModelFbsFromFile(reader.get(), scope, cpp_prog, 2);
       break;
     default:
       LOG(FATAL) << "The model format cannot be recognized. Please make sure "
@@ -866,7 +933,26 @@ void LoadModelNaiveV0FromFile(const std::string &filename,
   VLOG(4) << "Load naive buffer model in '" << filename << "' successfully";
 }
 #endif  // LITE_ON_TINY_PUBLISH
-void LoadModelFbsFromFile(model_parser::BinaryFileReader *reader,
+// The params of meta_version=1 share the data of the reader if it holds the
+// bytes in memory, or a buffer read at once.
+void LoadCombinedParamsFbs(model_parser::ByteReader *reader,
+                           size_t params_size,
+                           Scope *scope) {
+  auto mapping = reader->mapping();
+  const void *data = nullptr;
+  if (mapping) {
+    data = reader->ReadInPlace(params_size);
+  } else {
+    mapping = std::make_shared<lite::Buffer>();
+    mapping->ResetLazy(TARGET(kHost), params_size);
+    reader->Read(mapping->data(), params_size);
+    data = mapping->data();
+  }
+  fbs::CombinedParamsDescView params(data, params_size);
+  fbs::deprecated::SetScopeWithCombinedParams(scope, params, mapping);
+}
+
+void LoadModelFbsFromFile(model_parser::ByteReader *reader,
                           Scope *scope,
                           cpp::ProgramDesc *cpp_prog,
                           uint16_t meta_version) {
@@ -913,10 +999,8 @@ void LoadModelFbsFromFile(model_parser::BinaryFileReader *reader,
   switch (meta_version) {
     case 1: {
       /* load scope from param.fbs with meta_version=1 */
-      lite::model_parser::Buffer buf(reader->length() - reader->current());
-      reader->Read(buf.data(), reader->length() - reader->current());
-      fbs::CombinedParamsDescView params(std::move(buf));
-      fbs::deprecated::SetScopeWithCombinedParams(scope, params);
+      LoadCombinedParamsFbs(
+          reader, reader->length() - reader->current(), scope);
       break;
     }
     case 2: {
@@ -940,9 +1024,23 @@ void LoadModelNaiveFromMemory(const std::string &model_buffer,
 
   // (1)get meta version
   uint16_t meta_version;
-  model_parser::StringBufferReader reader(model_buffer);
-  reader.Read(&meta_version, sizeof(uint16_t));
+  model_parser::StringBufferReader string_reader(model_buffer);
+  string_reader.Read(&meta_version, sizeof(uint16_t));
   VLOG(4) << "Meta_version:" << meta_version;
+  // Copy the model once into an aligned buffer which is shared by the params,
+  // instead of copying every param, since the model buffer may be released
+  // after loading.
+  std::unique_ptr<model_parser::SharedBufferReader> reader;
+  if (meta_version == 1 || meta_version == 2) {
+    auto buffer = std::make_shared<lite::Buffer>();
+    buffer->ResetLazy(TARGET(kHost), model_buffer.size());
+    TargetCopy(TARGET(kHost),
+               buffer->data(),
+               model_buffer.data(),
+               model_buffer.size());
+    reader.reset(new model_parser::SharedBufferReader(buffer));
+    reader->Read(&meta_version, sizeof(uint16_t));
+  }
 
   switch (meta_version) {
     case 0:
@@ -955,10 +1053,10 @@ void LoadModelNaiveFromMemory(const std::string &model_buffer,
 #endif
       break;
     case 1:
-      LoadModelFbsFromMemory(&reader, scope, cpp_prog, 1);
+      LoadModelFbsFromMemory(reader.get(), scope, cpp_prog, 1);
       break;
     case 2:
-      LoadModelFbsFromMemory(&reader, scope, cpp_prog, 2);
+      LoadModelFbsFromMemory(reader.get(), scope, cpp_prog, 2);
       break;
     default:
       LOG(FATAL) << "The model format cannot be recognized. Please make sure "
@@ -1006,7 +1104,7 @@ void LoadModelNaiveV0FromMemory(const std::string &model_buffer,
 ///////////////////////////////////////////////////////////////////
 // Meta_version=1,2
 ///////////////////////////////////////////////////////////////////
-void LoadModelFbsFromMemory(model_parser::StringBufferReader *reader,
+void LoadModelFbsFromMemory(model_parser::ByteReader *reader,
                             Scope *scope,
                             cpp::ProgramDesc *cpp_prog,
                             uint16_t meta_version) {
@@ -1036,10 +1134,7 @@ void LoadModelFbsFromMemory(model_parser::StringBufferReader *reader,
     case 1: {
       size_t params_size = reader->length() - sizeof(uint16_t) -
                            paddle_version_length - sizeof(uint64_t) - prog_size;
-      model_parser::Buffer params_data(params_size);
-      reader->Read(params_data.data(), params_size);
-      fbs::CombinedParamsDescView params(std::move(params_data));
-      fbs::deprecated::SetScopeWithCombinedParams(scope, params);
+      LoadCombinedParamsFbs(reader, params_size, scope);
       break;
     }
     case 2: {
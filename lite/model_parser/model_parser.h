@@ -36,6 +36,12 @@ namespace lite {
 std::unique_ptr<framework::proto::ProgramDesc> LoadProgram(
     const std::string& path,
     const lite_api::CxxModelBuffer& model_buffer = lite_api::CxxModelBuffer());
+// Read a __model__ file into the messages allocated on `arena`, which are
+// freed together with it.
+framework::proto::ProgramDesc* LoadProgram(
+    const std::string& path,
+    const lite_api::CxxModelBuffer& model_buffer,
+    google::protobuf::Arena* arena);
 
 template <typename T>
 void ReadModelDataFromFile(T* data,
@@ -98,9 +104,12 @@ void SaveCombinedParamsNaive(const std::string& path,
                              const lite::Scope& exec_scope,
                              const cpp::ProgramDesc& cpp_prog);
 
+// The weights are compressed if `compress_weights`, which is supported by
+// the meta version 2 only.
 void SaveModelNaive(const std::string& model_dir,
                     const Scope& exec_scope,
-                    const cpp::ProgramDesc& cpp_prog);
+                    const cpp::ProgramDesc& cpp_prog,
+                    bool compress_weights = false);
 
 void SaveModelFbs(const std::string& model_dir,
                   const Scope& exec_scope,
@@ -139,19 +148,22 @@ void LoadNonCombinedParamsPb(const std::string& model_dir,
                              const lite_api::CxxModelBuffer& model_buffer,
                              Scope* scope);
 #endif  // LITE_ON_TINY_PUBLISH
-void LoadModelFbsFromFile(model_parser::BinaryFileReader* reader,
+void LoadModelFbsFromFile(model_parser::ByteReader* reader,
                           Scope* scope,
                           cpp::ProgramDesc* cpp_prog,
                           uint16_t meta_version);
 
+// With `use_mmap`, the file is mapped into memory and the params share the
+// mapped data in place, which is loaded lazily and copied on write.
 void LoadModelNaiveFromFile(const std::string& filename,
                             lite::Scope* scope,
-                            cpp::ProgramDesc* prog);
+                            cpp::ProgramDesc* prog,
+                            bool use_mmap = false);
 
 void LoadModelNaiveFromMemory(const std::string& model_buffer,
                               lite::Scope* scope,
                               cpp::ProgramDesc* cpp_prog);
-void LoadModelFbsFromMemory(model_parser::StringBufferReader* reader,
+void LoadModelFbsFromMemory(model_parser::ByteReader* reader,
                             Scope* scope,
                             cpp::ProgramDesc* cpp_prog,
                             uint16_t meta_version);
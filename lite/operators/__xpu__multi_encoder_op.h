@@ -29,6 +29,8 @@ class XPUMultiEncoderOp : public OpLite {
 
   bool InferShapeImpl() const override;
 
+  bool ShapeDependsOnInputData() const override { return true; }
+
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
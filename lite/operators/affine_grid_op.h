@@ -33,6 +33,10 @@ class AffineGridOpLite : public OpLite {
 
   bool InferShapeImpl() const override;
 
+  bool ShapeDependsOnInputData() const override {
+    return param_.output_shape.empty();
+  }
+
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
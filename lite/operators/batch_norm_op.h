@@ -32,8 +32,6 @@ class BatchNormOp : public OpLite {
 
   bool InferShapeImpl() const override;
 
-  bool InferShapeWithCache() const override { return true; }
-
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
@@ -0,0 +1,83 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/cached_attention_op.h"
+#include <algorithm>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool CachedAttentionOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.q);
+  CHECK_OR_FALSE(param_.cache);
+  CHECK_OR_FALSE(param_.output);
+  const auto& q_dims = param_.q->dims();
+  CHECK_EQ_OR_FALSE(q_dims.size(), 4UL);
+  // The cache is filled at runtime, so it is only checked once not empty.
+  const auto* cache = param_.cache;
+  if (cache->length() > 0) {
+    CHECK_EQ_OR_FALSE(cache->batch(), q_dims[0]);
+    CHECK_EQ_OR_FALSE(cache->heads(), q_dims[1]);
+    CHECK_EQ_OR_FALSE(cache->dim(), q_dims[3]);
+    if (param_.mask) {
+      const auto& mask_dims = param_.mask->dims();
+      CHECK_GE_OR_FALSE(4UL, mask_dims.size());
+      for (size_t i = 1; i <= mask_dims.size(); i++) {
+        int64_t dim = mask_dims[mask_dims.size() - i];
+        int64_t score_dim = i == 1 ? cache->length() : q_dims[4 - i];
+        CHECK_OR_FALSE(dim == 1 || dim == score_dim);
+      }
+    }
+  }
+  return true;
+}
+
+bool CachedAttentionOp::InferShapeImpl() const {
+  auto out_dims = param_.q->dims().Vectorize();
+  // The values are assumed as wide as the keys before the cache is filled.
+  if (param_.cache->length() > 0) out_dims[3] = param_.cache->dim_v();
+  if (param_.transpose_out) std::swap(out_dims[1], out_dims[2]);
+  param_.output->Resize(lite::DDim(out_dims));
+  return true;
+}
+
+bool CachedAttentionOp::AttachImpl(const cpp::OpDesc& op_desc,
+                                   lite::Scope* scope) {
+  param_.q = scope->FindVar(op_desc.Input("Q").front())->GetMutable<Tensor>();
+  param_.cache =
+      scope->FindVar(op_desc.Input("Cache").front())->GetMutable<KVCache>();
+  param_.mask = nullptr;
+  if (op_desc.HasInput("Mask") && !op_desc.Input("Mask").empty()) {
+    param_.mask =
+        scope->FindVar(op_desc.Input("Mask").front())->GetMutable<Tensor>();
+  }
+  param_.output =
+      scope->FindVar(op_desc.Output("Out").front())->GetMutable<Tensor>();
+  if (op_desc.HasAttr("scale")) {
+    param_.scale = op_desc.GetAttr<float>("scale");
+  }
+  if (op_desc.HasAttr("transpose_out")) {
+    param_.transpose_out = op_desc.GetAttr<bool>("transpose_out");
+  }
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(cached_attention, paddle::lite::operators::CachedAttentionOp);
@@ -41,6 +41,9 @@ bool CalibOpLite::AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) {
   if (opdesc.HasAttr("scale")) {
     param_.scale = opdesc.GetAttr<float>("scale");
   }
+  if (opdesc.HasAttr("zero_point")) {
+    param_.zero_point = opdesc.GetAttr<int>("zero_point");
+  }
   CHECK(param_.input) << "Input(X) of CalibOp should not be null.";
   CHECK(param_.output) << "Output(Out) of CalibOp should not be null.";
   return true;
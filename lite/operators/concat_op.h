@@ -32,7 +32,9 @@ class ConcatOpLite : public OpLite {
 
   bool InferShapeImpl() const override;
 
-  bool InferShapeWithCache() const override { return true; }
+  bool ShapeDependsOnInputData() const override {
+    return param_.axis_tensor != nullptr;
+  }
 
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
@@ -33,6 +33,9 @@ class ConditionalBlockOp : public OpLite {
 
   bool InferShapeImpl() const override;
 
+  // The shapes depend on the executed sub block.
+  bool InferShapeWithCache() const override { return false; }
+
   bool AttachImpl(const cpp::OpDesc &opdesc, Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
@@ -0,0 +1,207 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <string>
+#include <vector>
+#include "lite/api/paddle_place.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+// The implementations of the ARM conv2d kernel. The rules selecting them are
+// shared by the kernel and the opt tool, which may record the choice for a
+// target cpu into the attribute "conv_algorithm" of the optimized model.
+enum class ConvAlgorithm {
+  kAuto = 0,
+  kDepthwise = 1,
+  kWinograd = 2,
+  kDirect = 3,
+  kGemmLike = 4,
+};
+
+static const char* const kConvAlgorithmAttr = "conv_algorithm";
+
+inline std::string ConvAlgorithmToStr(ConvAlgorithm algorithm) {
+  switch (algorithm) {
+    case ConvAlgorithm::kDepthwise:
+      return "depthwise";
+    case ConvAlgorithm::kWinograd:
+      return "winograd";
+    case ConvAlgorithm::kDirect:
+      return "direct";
+    case ConvAlgorithm::kGemmLike:
+      return "gemm_like";
+    default:
+      return "auto";
+  }
+}
+
+inline ConvAlgorithm ConvAlgorithmFromStr(const std::string& algorithm) {
+  for (auto x : {ConvAlgorithm::kDepthwise,
+                 ConvAlgorithm::kWinograd,
+                 ConvAlgorithm::kDirect,
+                 ConvAlgorithm::kGemmLike}) {
+    if (algorithm == ConvAlgorithmToStr(x)) return x;
+  }
+  return ConvAlgorithm::kAuto;
+}
+
+// The shape of a conv2d in NCHW, `hin` and `win` are not positive if the
+// input shape is unknown, e.g. in the opt tool.
+struct ConvShape {
+  int ic{0};
+  int oc{0};
+  int kh{0};
+  int kw{0};
+  int hin{0};
+  int win{0};
+  int groups{1};
+  std::vector<int> strides{1, 1};
+  std::vector<int> paddings{0, 0, 0, 0};
+  std::vector<int> dilations{1, 1};
+};
+
+// Whether `algorithm` can compute the conv of `shape` in `precision`, the
+// recorded choices are checked against it before being used.
+inline bool IsArmConvAlgorithmSupported(ConvAlgorithm algorithm,
+                                        PrecisionType precision,
+                                        const ConvShape& shape) {
+  // The bf16 conv computes the activations in fp32, and only the gemm-like
+  // one uses the bf16 weights.
+  if (precision == PRECISION(kBF16)) precision = PRECISION(kFloat);
+  // The same as the conditions used by the ARM ConvCompute.
+  int stride = shape.strides[0];
+  int sh = shape.strides[1];
+  int sw = shape.strides[0];
+  const auto& paddings = shape.paddings;
+  int pad_h = paddings[0];
+  int pad_w = paddings[2];
+  int kh = shape.kh;
+  int kw = shape.kw;
+  bool pads_equal =
+      ((paddings[0] == paddings[1]) && (paddings[2] == paddings[3]));
+  bool ks_equal = (sw == sh) && (kw == kh);
+  bool no_dilation = (shape.dilations[0] == 1) && (shape.dilations[1] == 1);
+  bool kps_equal = (pad_h == pad_w) && ks_equal;
+  bool flag_dw_3x3 = (kw == 3) && (kh == 3) && (stride == 1 || stride == 2);
+  bool flag_dw_5x5 = (kw == 5) && (kh == 5) && (stride == 1 || stride == 2);
+  bool flag_dw = flag_dw_3x3 || flag_dw_5x5;
+  bool depthwise = shape.groups == shape.ic && shape.ic == shape.oc;
+  bool conv_3x3 = shape.groups == 1 && kw == 3 && no_dilation && ks_equal;
+  switch (precision) {
+    case PRECISION(kFloat):
+      switch (algorithm) {
+        case ConvAlgorithm::kDepthwise:
+          return depthwise && ks_equal && no_dilation && flag_dw;
+        case ConvAlgorithm::kWinograd:
+          return conv_3x3 && stride == 1;
+        case ConvAlgorithm::kDirect:
+          return conv_3x3 && stride == 2;
+        case ConvAlgorithm::kGemmLike:
+          return true;
+        default:
+          return false;
+      }
+    case PRECISION(kInt8):
+      switch (algorithm) {
+        case ConvAlgorithm::kDepthwise:
+          return depthwise && kps_equal && pads_equal && no_dilation &&
+                 flag_dw;
+        case ConvAlgorithm::kWinograd:
+          return conv_3x3 && sw == 1 && pads_equal;
+        case ConvAlgorithm::kDirect:
+          return conv_3x3 && sw == 2 && sh == 2 && pads_equal;
+        case ConvAlgorithm::kGemmLike:
+          return true;
+        default:
+          return false;
+      }
+    case PRECISION(kFP16): {
+      bool pads_less = ((paddings[1] < 2) && (paddings[3] < 2));
+      bool stride_less = (sw == 1) || (sw == 2);
+      switch (algorithm) {
+        case ConvAlgorithm::kDepthwise:
+          return depthwise && no_dilation && stride_less &&
+                 ((flag_dw_5x5 && ks_equal) ||
+                  (flag_dw_3x3 && kps_equal && pads_less));
+        case ConvAlgorithm::kWinograd:
+          return conv_3x3 && sw == 1;
+        case ConvAlgorithm::kDirect:
+          return conv_3x3 && (sw == 1 || sw == 2);
+        case ConvAlgorithm::kGemmLike:
+          return true;
+        default:
+          return false;
+      }
+    }
+    default:
+      return false;
+  }
+}
+
+// Select the implementation of the conv by the shape rules, returns kAuto if
+// the choice depends on the unknown input shape.
+inline ConvAlgorithm SelectArmConvAlgorithm(PrecisionType precision,
+                                            const ConvShape& shape,
+                                            bool has_dot) {
+  if (precision == PRECISION(kBF16)) precision = PRECISION(kFloat);
+  auto supported = [&](ConvAlgorithm algorithm) {
+    return IsArmConvAlgorithmSupported(algorithm, precision, shape);
+  };
+  bool known_input = shape.hin > 0 && shape.win > 0;
+  bool small_channels = shape.ic * shape.oc < 4 * shape.hin * shape.win;
+  switch (precision) {
+    case PRECISION(kFloat):
+      if (supported(ConvAlgorithm::kDepthwise)) {
+        return ConvAlgorithm::kDepthwise;
+      } else if (supported(ConvAlgorithm::kWinograd)) {
+        return ConvAlgorithm::kWinograd;
+      } else if (supported(ConvAlgorithm::kDirect)) {
+        if (!known_input) return ConvAlgorithm::kAuto;
+        return small_channels ? ConvAlgorithm::kDirect
+                              : ConvAlgorithm::kGemmLike;
+      }
+      return ConvAlgorithm::kGemmLike;
+    case PRECISION(kInt8):
+      if (supported(ConvAlgorithm::kDepthwise)) {
+        return ConvAlgorithm::kDepthwise;
+      } else if (supported(ConvAlgorithm::kDirect) && !has_dot) {
+        return ConvAlgorithm::kDirect;
+      } else if (supported(ConvAlgorithm::kWinograd) && !has_dot) {
+        return ConvAlgorithm::kWinograd;
+      }
+      return ConvAlgorithm::kGemmLike;
+    case PRECISION(kFP16):
+      if (supported(ConvAlgorithm::kDepthwise)) {
+        return ConvAlgorithm::kDepthwise;
+      } else if (supported(ConvAlgorithm::kDirect) && shape.strides[0] == 2) {
+        if (!known_input) return ConvAlgorithm::kAuto;
+        return small_channels ? ConvAlgorithm::kDirect
+                              : ConvAlgorithm::kGemmLike;
+      } else if (supported(ConvAlgorithm::kWinograd)) {
+        bool conv_3x3_wino = (shape.ic <= 8) || (shape.oc <= 8);
+        return conv_3x3_wino ? ConvAlgorithm::kDirect
+                             : ConvAlgorithm::kWinograd;
+      }
+      return ConvAlgorithm::kGemmLike;
+    default:
+      return ConvAlgorithm::kAuto;
+  }
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
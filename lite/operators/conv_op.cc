@@ -21,6 +21,97 @@ namespace paddle {
 namespace lite {
 namespace operators {
 
+ConvAttrs ConvAttrs::Decode(const cpp::OpDesc& op_desc) {
+  ConvAttrs attrs;
+  attrs.strides = op_desc.GetAttr<std::vector<int>>("strides");
+  attrs.paddings = op_desc.GetAttr<std::vector<int>>("paddings");
+  attrs.groups = op_desc.GetAttr<int>("groups");
+  attrs.dilations = op_desc.GetAttr<std::vector<int>>("dilations");
+  // conv3d: 3-pad to 6-pad, or conv2d: 2-pad to 4-pad
+  auto& paddings = attrs.paddings;
+  if (paddings.size() == 2L || paddings.size() == 3L) {
+    for (size_t i = 0; i < attrs.strides.size(); ++i) {
+      int copy_pad = *(paddings.begin() + 2 * i);
+      paddings.insert(paddings.begin() + 2 * i + 1, copy_pad);
+    }
+  } else {
+    if (paddings.size() != 4L && paddings.size() != 6L) {
+      LOG(FATAL)
+          << "Paddings size should be the same or twice as the input size.";
+    }
+  }
+
+  auto& act = attrs.activation_param;
+  if (op_desc.HasAttr("with_act") && op_desc.GetAttr<bool>("with_act")) {
+    act.has_active = true;
+    auto act_type = op_desc.GetAttr<std::string>("act_type");
+    if (act_type == "relu") {
+      act.active_type = lite_api::ActivationType::kRelu;
+      attrs.fuse_relu = true;
+    } else if (act_type == "sigmoid") {
+      act.active_type = lite_api::ActivationType::kSigmoid;
+      attrs.fuse_sigmoid = true;
+    } else if (act_type == "tanh") {
+      act.active_type = lite_api::ActivationType::kTanh;
+      attrs.fuse_tanh = true;
+    } else if (act_type == "swish") {
+      act.swish_scale = op_desc.GetAttr<float>("swish_scale");
+      act.active_type = lite_api::ActivationType::kSwish;
+      attrs.fuse_swish = true;
+    } else if (act_type == "abs") {
+      act.active_type = lite_api::ActivationType::kAbs;
+      attrs.fuse_abs = true;
+    } else if (act_type == "relu6") {
+      act.active_type = lite_api::ActivationType::kRelu6;
+      act.Relu_clipped_coef =
+          op_desc.GetAttr<float>("fuse_brelu_threshold");  // 6.f
+    } else if (act_type == "leaky_relu") {
+      act.active_type = lite_api::ActivationType::kLeakyRelu;
+      act.Leaky_relu_alpha = op_desc.GetAttr<float>("leaky_relu_alpha");
+    } else if (act_type == "hard_swish") {
+      act.active_type = lite_api::ActivationType::kHardSwish;
+      act.hard_swish_threshold = op_desc.GetAttr<float>("hard_swish_threshold");
+      act.hard_swish_scale = op_desc.GetAttr<float>("hard_swish_scale");
+      act.hard_swish_offset = op_desc.GetAttr<float>("hard_swish_offset");
+    } else if (act_type == "hard_sigmoid") {
+      act.active_type = lite_api::ActivationType::kHardSigmoid;
+      act.hard_sigmoid_slope = op_desc.GetAttr<float>("slope");
+      act.hard_sigmoid_offset = op_desc.GetAttr<float>("offset");
+    } else if (act_type == "prelu") {
+      // the alpha tensor is bound at attach
+      act.active_type = lite_api::ActivationType::kPRelu;
+      act.Prelu_mode = op_desc.GetAttr<std::string>("prelu_mode");
+    } else {
+      LOG(FATAL) << "The fused conv only supports fuse with relu, leaky "
+                    "relu, hard_swish, while the given activation type is "
+                 << act_type;
+    }
+  }
+  if (op_desc.HasAttr("scale_activation_type")) {
+    attrs.scale_activation_type =
+        op_desc.GetAttr<std::string>("scale_activation_type");
+  }
+  if (op_desc.HasAttr("fuse_elementwise_op_type")) {
+    attrs.fuse_elementwise_op_type =
+        op_desc.GetAttr<std::string>("fuse_elementwise_op_type");
+  }
+  if (op_desc.HasAttr("padding_algorithm")) {
+    attrs.padding_algorithm = op_desc.GetAttr<std::string>("padding_algorithm");
+  }
+  if (op_desc.HasAttr(kConvAlgorithmAttr)) {
+    attrs.conv_algorithm = op_desc.GetAttr<std::string>(kConvAlgorithmAttr);
+  }
+  auto filter_quant_scale = op_desc.Input("Filter").front() + "_quant_scale";
+  if (op_desc.HasAttr("quantize_weight_bits") &&
+      op_desc.GetAttr<int>("quantize_weight_bits") == 8 &&
+      op_desc.HasAttr(filter_quant_scale)) {
+    attrs.weight_quant_bits = 8;
+    attrs.weight_quant_scale =
+        op_desc.GetAttr<std::vector<float>>(filter_quant_scale);
+  }
+  return attrs;
+}
+
 bool ConvOpLite::CheckShape() const {
   CHECK_OR_FALSE(param_.x);
   CHECK_OR_FALSE(param_.output);
@@ -20,6 +20,7 @@
 #include "lite/core/op_lite.h"
 #include "lite/core/scope.h"
 #include "lite/core/tensor.h"
+#include "lite/operators/conv_algorithm.h"
 #include "lite/operators/op_params.h"
 #include "lite/utils/all.h"
 #ifdef LITE_WITH_PROFILE
@@ -30,6 +31,31 @@ namespace paddle {
 namespace lite {
 namespace operators {
 
+// The attributes of conv read from the op desc, decoded once per desc and
+// shared by the ops attached to it.
+struct ConvAttrs {
+  std::vector<int> strides;
+  // expanded to 4 (conv2d) or 6 (conv3d) values
+  std::vector<int> paddings;
+  std::vector<int> dilations;
+  int groups{1};
+  ActivationParam activation_param;
+  bool fuse_relu{false};
+  bool fuse_sigmoid{false};
+  bool fuse_tanh{false};
+  bool fuse_swish{false};
+  bool fuse_abs{false};
+  std::string scale_activation_type;
+  std::string fuse_elementwise_op_type;
+  std::string padding_algorithm;
+  std::string conv_algorithm;
+  // the channel-wise int8 filter of post_quant_dynamic
+  int weight_quant_bits{0};
+  std::vector<float> weight_quant_scale;
+
+  static ConvAttrs Decode(const cpp::OpDesc& op_desc);
+};
+
 class ConvOpLite : public OpLite {
  public:
   ConvOpLite() {}
@@ -38,7 +64,6 @@ class ConvOpLite : public OpLite {
 
   bool CheckShape() const override;
   bool InferShapeImpl() const override;
-  bool InferShapeWithCache() const override { return true; }
 
 #ifdef LITE_WITH_PROFILE
   void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter* ch) {
@@ -80,14 +105,12 @@ class ConvOpLite : public OpLite {
     CHECK(param_.x);
     CHECK(param_.filter);
     CHECK(param_.output);
-    input_tensor_ptrs_cache_.push_back(param_.x);
-    output_tensor_ptrs_cache_.push_back(param_.output);
 
-    param_.strides = op_desc.GetAttr<std::vector<int>>("strides");
-    std::vector<int> paddings = op_desc.GetAttr<std::vector<int>>("paddings");
-    param_.groups = op_desc.GetAttr<int>("groups");
-    auto dilations = op_desc.GetAttr<std::vector<int>>("dilations");
-    param_.dilations = std::make_shared<std::vector<int>>(dilations);
+    const auto& attrs = op_desc.DecodedAttrs<ConvAttrs>();
+    param_.strides = attrs.strides;
+    param_.paddings = std::make_shared<std::vector<int>>(attrs.paddings);
+    param_.groups = attrs.groups;
+    param_.dilations = std::make_shared<std::vector<int>>(attrs.dilations);
 
     // optional params
     std::vector<std::string> input_arg_names = op_desc.InputArgumentNames();
@@ -115,81 +138,33 @@ class ConvOpLite : public OpLite {
       }
     }
 
-    if (op_desc.HasAttr("with_act") && op_desc.GetAttr<bool>("with_act")) {
-      param_.activation_param.has_active = true;
-      auto act_type = op_desc.GetAttr<std::string>("act_type");
-      if (act_type == "relu") {
-        param_.activation_param.active_type = lite_api::ActivationType::kRelu;
-        param_.fuse_relu = true;
-      } else if (act_type == "sigmoid") {
-        param_.activation_param.active_type =
-            lite_api::ActivationType::kSigmoid;
-        param_.fuse_sigmoid = true;
-      } else if (act_type == "tanh") {
-        param_.activation_param.active_type = lite_api::ActivationType::kTanh;
-        param_.fuse_tanh = true;
-      } else if (act_type == "swish") {
-        param_.activation_param.swish_scale =
-            op_desc.GetAttr<float>("swish_scale");
-        param_.activation_param.active_type = lite_api::ActivationType::kSwish;
-        param_.fuse_swish = true;
-      } else if (act_type == "abs") {
-        param_.activation_param.active_type = lite_api::ActivationType::kAbs;
-        param_.fuse_abs = true;
-      } else if (act_type == "relu6") {
-        param_.activation_param.active_type = lite_api::ActivationType::kRelu6;
-        param_.activation_param.Relu_clipped_coef =
-            op_desc.GetAttr<float>("fuse_brelu_threshold");  // 6.f
-      } else if (act_type == "leaky_relu") {
-        param_.activation_param.active_type =
-            lite_api::ActivationType::kLeakyRelu;
-        param_.activation_param.Leaky_relu_alpha =
-            op_desc.GetAttr<float>("leaky_relu_alpha");
-      } else if (act_type == "hard_swish") {
-        param_.activation_param.active_type =
-            lite_api::ActivationType::kHardSwish;
-        param_.activation_param.hard_swish_threshold =
-            op_desc.GetAttr<float>("hard_swish_threshold");
-        param_.activation_param.hard_swish_scale =
-            op_desc.GetAttr<float>("hard_swish_scale");
-        param_.activation_param.hard_swish_offset =
-            op_desc.GetAttr<float>("hard_swish_offset");
-      } else if (act_type == "hard_sigmoid") {
-        param_.activation_param.active_type =
-            lite_api::ActivationType::kHardSigmoid;
-        param_.activation_param.hard_sigmoid_slope =
-            op_desc.GetAttr<float>("slope");
-        param_.activation_param.hard_sigmoid_offset =
-            op_desc.GetAttr<float>("offset");
-      } else if (act_type == "prelu") {
-        param_.activation_param.active_type = lite_api::ActivationType::kPRelu;
-        param_.activation_param.Prelu_mode =
-            op_desc.GetAttr<std::string>("prelu_mode");
+    if (attrs.activation_param.has_active) {
+      param_.activation_param = attrs.activation_param;
+      param_.fuse_relu = attrs.fuse_relu;
+      param_.fuse_sigmoid = attrs.fuse_sigmoid;
+      param_.fuse_tanh = attrs.fuse_tanh;
+      param_.fuse_swish = attrs.fuse_swish;
+      param_.fuse_abs = attrs.fuse_abs;
+      if (attrs.activation_param.active_type ==
+          lite_api::ActivationType::kPRelu) {
         auto prelu_alpha_name = op_desc.Input("Prelu_alpha").front();
         auto prelu_alpha_var = scope->FindVar(prelu_alpha_name);
         param_.activation_param.Prelu_alpha =
             const_cast<lite::Tensor*>(&(prelu_alpha_var->Get<lite::Tensor>()));
-      } else {
-        LOG(FATAL) << "The fused conv only supports fuse with relu, leaky "
-                      "relu, hard_swish, while the given activation type is "
-                   << act_type;
       }
     }
-    if (op_desc.HasAttr("scale_activation_type")) {
-      param_.scale_activation_type =
-          op_desc.GetAttr<std::string>("scale_activation_type");
-    }
-
-    if (op_desc.HasAttr("fuse_elementwise_op_type")) {
-      param_.fuse_elementwise_op_type =
-          op_desc.GetAttr<std::string>("fuse_elementwise_op_type");
+    param_.scale_activation_type = attrs.scale_activation_type;
+    param_.fuse_elementwise_op_type = attrs.fuse_elementwise_op_type;
+    if (!attrs.fuse_elementwise_op_type.empty()) {
       auto X = op_desc.Input("SecondInput").front();
       param_.second_x =
           const_cast<lite::Tensor*>(&(scope->FindVar(X)->Get<lite::Tensor>()));
     }
-
-    if (op_desc.HasAttr("padding_algorithm")) {
-      padding_algorithm_ = op_desc.GetAttr<std::string>("padding_algorithm");
+    padding_algorithm_ = attrs.padding_algorithm;
+    param_.conv_algorithm = attrs.conv_algorithm;
+    if (attrs.weight_quant_bits == 8) {
+      param_.weight_quant_bits = 8;
+      param_.weight_quant_scale = attrs.weight_quant_scale;
     }
     // For Int8
     const OpInfo* op_info = static_cast<const OpInfo*>(&op_desc);
@@ -206,6 +181,15 @@ class ConvOpLite : public OpLite {
         param_.output_scale =
             op_info->GetOutputScale(output_scale_name, true)[0];
       }
+      if (op_info->HasAttr(X + "_zero_point")) {
+        param_.input_zero_point = op_info->GetAttr<int>(X + "_zero_point");
+      }
+      auto second_x_scale_name = "SecondInput0_scale";
+      if (param_.second_x &&
+          op_info->HasInputScale(second_x_scale_name, true)) {
+        param_.second_x_scale =
+            op_info->GetInputScale(second_x_scale_name, true)[0];
+      }
     }
 
 #ifdef LITE_WITH_FPGA
@@ -232,19 +216,6 @@ class ConvOpLite : public OpLite {
     }
 #endif
 
-    // conv3d: 3-pad to 6-pad, or conv2d: 2-pad to 4-pad
-    if (paddings.size() == 2L || paddings.size() == 3L) {
-      for (size_t i = 0; i < param_.strides.size(); ++i) {
-        int copy_pad = *(paddings.begin() + 2 * i);
-        paddings.insert(paddings.begin() + 2 * i + 1, copy_pad);
-      }
-    } else {
-      if (paddings.size() != 4L && paddings.size() != 6L) {
-        LOG(FATAL)
-            << "Paddings size should be the same or twice as the input size.";
-      }
-    }
-    param_.paddings = std::make_shared<std::vector<int>>(paddings);
     return true;
   }
 
@@ -32,6 +32,10 @@ class CropTensorOpLite : public OpLite {
 
   bool InferShapeImpl() const override;
 
+  bool ShapeDependsOnInputData() const override {
+    return param_.Shape || param_.ShapeTensor;
+  }
+
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
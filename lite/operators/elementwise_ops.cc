@@ -28,9 +28,10 @@ bool ElementwiseOp::CheckShape() const {
 }
 
 bool ElementwiseOp::InferShapeImpl() const {
-  auto x_dim = param_.X->dims();
+  auto x_dim = x_->dims();
   auto y_dim = param_.Y->dims();
   if (x_dim == y_dim) {
+    SelectInplaceInput(x_, x_dim, &x_copy_, kernel_ptr_, &param_);
     param_.Out->Resize(x_dim);
     auto out_lod = param_.Out->mutable_lod();
     *out_lod = param_.X->lod();
@@ -78,6 +79,8 @@ bool ElementwiseOp::InferShapeImpl() const {
         out_dims_array[i] = (std::max)(x_dims_array[i], y_dims_array[i]);
       }
     }
+    SelectInplaceInput(
+        x_, DDim(out_dims_array), &x_copy_, kernel_ptr_, &param_);
     param_.Out->Resize(DDim(out_dims_array));
     auto out_lod = param_.Out->mutable_lod();
     *out_lod = param_.X->lod();
@@ -92,6 +95,7 @@ bool ElementwiseOp::AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) {
   auto Out_name = opdesc.Output("Out").front();
 
   param_.X = GetMutableVar<lite::Tensor>(scope, X_name);
+  x_ = param_.X;
   param_.Y = GetMutableVar<lite::Tensor>(scope, Y_name);
   param_.Out = GetMutableVar<lite::Tensor>(scope, Out_name);
   param_.axis = opdesc.GetAttr<int>("axis");
@@ -101,9 +105,6 @@ bool ElementwiseOp::AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) {
     param_.alpha = opdesc.GetAttr<float>("alpha");
     param_.bias = opdesc.GetAttr<float>("bias");
   }
-  input_tensor_ptrs_cache_.push_back(param_.X);
-  input_tensor_ptrs_cache_.push_back(param_.Y);
-  output_tensor_ptrs_cache_.push_back(param_.Out);
 
   return true;
 }
@@ -21,6 +21,26 @@ namespace paddle {
 namespace lite {
 namespace operators {
 
+// The memory optimize pass may run an elementwise op in place, with X and
+// Out sharing a buffer. If X is broadcast at runtime the output outgrows
+// it, so the kernel reads a copy of X instead.
+template <typename ParamType>
+void SelectInplaceInput(const lite::Tensor* x,
+                        const DDim& out_dims,
+                        lite::Tensor* x_copy,
+                        KernelBase* kernel,
+                        ParamType* param) {
+  const lite::Tensor* input = x;
+  if (param->Out == x && out_dims != x->dims()) {
+    x_copy->CopyDataFrom(*x);
+    input = x_copy;
+  }
+  if (param->X != input) {
+    param->X = input;
+    if (kernel) kernel->SetParam(*param);
+  }
+}
+
 class ElementwiseOp : public OpLite {
  public:
   explicit ElementwiseOp(const std::string& op_type) : OpLite(op_type) {}
@@ -29,11 +49,12 @@ class ElementwiseOp : public OpLite {
 
   bool InferShapeImpl() const override;
 
-  bool InferShapeWithCache() const override { return true; }
-
   bool AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) override;
 
-  void AttachKernel(KernelBase* kernel) override { kernel->SetParam(param_); }
+  void AttachKernel(KernelBase* kernel) override {
+    kernel_ptr_ = kernel;
+    kernel->SetParam(param_);
+  }
 
   std::string DebugString() const override { return "elementwise_op"; }
 
@@ -48,8 +69,15 @@ class ElementwiseOp : public OpLite {
   }
 #endif
 
+ protected:
+  // the copy of X is taken on every run
+  bool InferShapeWithCache() const override { return param_.Out != x_; }
+
  private:
   mutable operators::ElementwiseParam param_;
+  const lite::Tensor* x_{nullptr};
+  mutable lite::Tensor x_copy_;
+  KernelBase* kernel_ptr_{nullptr};
 };
 
 // #ifdef LITE_WITH_TRAIN
@@ -30,6 +30,10 @@ class ExpandOpLite : public OpLite {
 
   bool InferShapeImpl() const override;
 
+  bool ShapeDependsOnInputData() const override {
+    return param_.ExpandTimes || !param_.expand_times_tensor.empty();
+  }
+
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
@@ -30,6 +30,10 @@ class ExpandV2OpLite : public OpLite {
 
   bool InferShapeImpl() const override;
 
+  bool ShapeDependsOnInputData() const override {
+    return param_.Shape || !param_.expand_shapes_tensor.empty();
+  }
+
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
@@ -107,8 +107,6 @@ bool FcOpLite::AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) {
   CHECK(scope->FindVar(out));
   param_.output = scope->FindVar(out)->GetMutable<lite::Tensor>();
   param_.in_num_col_dims = op_desc.GetAttr<int>("in_num_col_dims");
-  input_tensor_ptrs_cache_.push_back(param_.input);
-  output_tensor_ptrs_cache_.push_back(param_.output);
 
   if (op_desc.HasAttr("activation_type")) {
     param_.activation_type = op_desc.GetAttr<std::string>("activation_type");
@@ -140,10 +138,27 @@ bool FcOpLite::AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) {
       param_.weight_scale = op_info->GetInputScale(weight_scale_name, true);
     if (op_info->HasOutputScale(out_scale_name, true))
       param_.output_scale = op_info->GetOutputScale(out_scale_name, true)[0];
+    if (op_info->HasAttr(input + "_zero_point")) {
+      param_.input_zero_point = op_info->GetAttr<int>(input + "_zero_point");
+    }
   }
   if (op_desc.HasAttr("op_type")) {
     param_.op_type = op_desc.GetAttr<std::string>("op_type");
   }
+  // For the int4 and int8 weight of post_quant_dynamic
+  if (op_desc.HasAttr("quantize_weight_bits") &&
+      op_desc.HasAttr(W + "_quant_scale")) {
+    int bits = op_desc.GetAttr<int>("quantize_weight_bits");
+    if (bits == 4 || bits == 8) {
+      param_.weight_quant_bits = bits;
+      param_.weight_quant_scale =
+          op_desc.GetAttr<std::vector<float>>(W + "_quant_scale");
+    }
+    if (bits == 4) {
+      param_.weight_group_size =
+          op_desc.GetAttr<int>("quantize_weight_group_size");
+    }
+  }
 
 #ifdef LITE_WITH_FPGA
   if (op_info != nullptr && op_info->HasAttr("fpga_static_quant")) {
@@ -37,8 +37,6 @@ class FcOpLite : public OpLite {
 
   bool InferShapeImpl() const override;
 
-  bool InferShapeWithCache() const override { return true; }
-
   bool AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
@@ -52,7 +50,9 @@ class FcOpLite : public OpLite {
     ch->filter_shape = ch->DimToStr(param_.w->dims());
     ch->output_shape = ch->DimToStr(param_.output->dims());
     ch->remark = (param_.bias ? "Bias" : "") + param_.activation_type;
-    ch->macs = m * param_.w->dims()[0] * param_.w->dims()[1] * 3.0f;
+    auto n = param_.w->dims()[1];
+    ch->macs = 2.0f * m * param_.w->dims()[0] * n;
+    if (param_.bias) ch->macs += 1.0f * m * n;
   }
 #endif
 
@@ -33,6 +33,10 @@ class FillConstantOp : public OpLite {
 
   bool InferShapeImpl() const override;
 
+  bool ShapeDependsOnInputData() const override {
+    return param_.shape_tensor || !param_.shape_tensor_list.empty();
+  }
+
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
@@ -0,0 +1,76 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fused_embedding_seq_pool_op.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusedEmbeddingSeqPoolOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.W)
+  CHECK_OR_FALSE(param_.Ids)
+  CHECK_OR_FALSE(param_.Out)
+  CHECK_EQ(param_.Ids->lod().empty(), false)
+      << "Input(Ids) Tensor of FusedEmbeddingSeqPoolOp does not contain "
+         "LoD information.";
+  CHECK_GE_OR_FALSE(2UL, param_.Ids->lod().size());
+
+  const auto& table_dims = param_.W->dims();
+  CHECK_EQ_OR_FALSE(table_dims.size(), 2)
+  if (param_.dequant) {
+    CHECK_GT_OR_FALSE(table_dims[1], 2)
+  }
+  CHECK_OR_FALSE(param_.pool_type == "SUM" || param_.pool_type == "AVERAGE" ||
+                 param_.pool_type == "SQRT")
+  return true;
+}
+
+bool FusedEmbeddingSeqPoolOp::InferShapeImpl() const {
+  const auto& table_dims = param_.W->dims();
+  int64_t width = table_dims[1];
+  if (param_.dequant) {
+    width = param_.quant_bits != 0 ? param_.row_width : (table_dims[1] - 2) * 4;
+  }
+  int64_t seq_num = static_cast<int64_t>(param_.Ids->lod().back().size()) - 1;
+  param_.Out->Resize({seq_num, width});
+  return true;
+}
+
+bool FusedEmbeddingSeqPoolOp::AttachImpl(const cpp::OpDesc& op_desc,
+                                         lite::Scope* scope) {
+  param_.W = scope->FindTensor(op_desc.Input("W").front());
+  param_.Ids = scope->FindTensor(op_desc.Input("Ids").front());
+  param_.Out = scope->FindMutableTensor(op_desc.Output("Out").front());
+
+  param_.padding_idx = op_desc.GetAttr<int64_t>("padding_idx");
+  param_.dequant = op_desc.GetAttr<bool>("dequant");
+  if (op_desc.HasAttr("quant_bits")) {
+    param_.quant_bits = op_desc.GetAttr<int>("quant_bits");
+    param_.row_width = op_desc.GetAttr<int64_t>("row_width");
+  }
+  param_.pool_type = op_desc.GetAttr<std::string>("pooltype");
+  if (op_desc.HasAttr("pad_value")) {
+    param_.pad_value = op_desc.GetAttr<float>("pad_value");
+  }
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fused_embedding_seq_pool,
+                 paddle::lite::operators::FusedEmbeddingSeqPoolOp);
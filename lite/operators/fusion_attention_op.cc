@@ -0,0 +1,107 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fusion_attention_op.h"
+#include <algorithm>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusionAttentionOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.q);
+  CHECK_OR_FALSE(param_.k);
+  CHECK_OR_FALSE(param_.v);
+  CHECK_OR_FALSE(param_.output);
+  const auto& q_dims = param_.q->dims();
+  const auto& k_dims = param_.k->dims();
+  const auto& v_dims = param_.v->dims();
+  size_t rank = q_dims.size();
+  if (param_.cu_seqlens) {
+    CHECK_EQ_OR_FALSE(rank, 3UL);
+    CHECK_OR_FALSE(!param_.mask);
+    CHECK_OR_FALSE(!param_.transpose_out);
+    CHECK_EQ_OR_FALSE(param_.cu_seqlens->dims().size(), 1UL);
+    CHECK_EQ_OR_FALSE(k_dims, q_dims);
+    CHECK_EQ_OR_FALSE(v_dims[0], q_dims[0]);
+    CHECK_EQ_OR_FALSE(v_dims[1], q_dims[1]);
+    return true;
+  }
+  CHECK_GE_OR_FALSE(rank, 2UL);
+  CHECK_EQ_OR_FALSE(k_dims.size(), rank);
+  CHECK_EQ_OR_FALSE(v_dims.size(), rank);
+  for (size_t i = 0; i + 2 < rank; i++) {
+    CHECK_EQ_OR_FALSE(k_dims[i], q_dims[i]);
+    CHECK_EQ_OR_FALSE(v_dims[i], q_dims[i]);
+  }
+  CHECK_EQ_OR_FALSE(k_dims[rank - 1], q_dims[rank - 1]);
+  CHECK_EQ_OR_FALSE(v_dims[rank - 2], k_dims[rank - 2]);
+  if (param_.transpose_out) {
+    CHECK_EQ_OR_FALSE(rank, 4UL);
+  }
+  if (param_.mask) {
+    // The same broadcast as the elementwise_add of axis -1.
+    const auto& mask_dims = param_.mask->dims();
+    CHECK_GE_OR_FALSE(rank, mask_dims.size());
+    for (size_t i = 1; i <= mask_dims.size(); i++) {
+      int64_t dim = mask_dims[mask_dims.size() - i];
+      int64_t score_dim = i == 1 ? k_dims[rank - 2] : q_dims[rank - i];
+      CHECK_OR_FALSE(dim == 1 || dim == score_dim);
+    }
+  }
+  return true;
+}
+
+bool FusionAttentionOp::InferShapeImpl() const {
+  auto out_dims = param_.q->dims().Vectorize();
+  size_t rank = out_dims.size();
+  out_dims[rank - 1] = param_.v->dims()[rank - 1];
+  if (param_.transpose_out) std::swap(out_dims[1], out_dims[2]);
+  param_.output->Resize(lite::DDim(out_dims));
+  return true;
+}
+
+bool FusionAttentionOp::AttachImpl(const cpp::OpDesc& op_desc,
+                                   lite::Scope* scope) {
+  param_.q = scope->FindVar(op_desc.Input("Q").front())->GetMutable<Tensor>();
+  param_.k = scope->FindVar(op_desc.Input("K").front())->GetMutable<Tensor>();
+  param_.v = scope->FindVar(op_desc.Input("V").front())->GetMutable<Tensor>();
+  param_.mask = nullptr;
+  if (op_desc.HasInput("Mask") && !op_desc.Input("Mask").empty()) {
+    param_.mask =
+        scope->FindVar(op_desc.Input("Mask").front())->GetMutable<Tensor>();
+  }
+  param_.cu_seqlens = nullptr;
+  if (op_desc.HasInput("CuSeqlens") && !op_desc.Input("CuSeqlens").empty()) {
+    param_.cu_seqlens = scope->FindVar(op_desc.Input("CuSeqlens").front())
+                            ->GetMutable<Tensor>();
+  }
+  param_.output =
+      scope->FindVar(op_desc.Output("Out").front())->GetMutable<Tensor>();
+  if (op_desc.HasAttr("scale")) {
+    param_.scale = op_desc.GetAttr<float>("scale");
+  }
+  if (op_desc.HasAttr("transpose_out")) {
+    param_.transpose_out = op_desc.GetAttr<bool>("transpose_out");
+  }
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_attention, paddle::lite::operators::FusionAttentionOp);
@@ -0,0 +1,61 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fusion_conv_resample_op.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusionConvResampleOp::CheckShape() const {
+  if (!ConvOpLite::CheckShape()) return false;
+  CHECK_EQ_OR_FALSE(param_.x->dims().size(), 4UL);
+  CHECK_OR_FALSE(fused_param_.resample_type == "max_pool2x2" ||
+                 fused_param_.resample_type == "global_avg_pool" ||
+                 fused_param_.resample_type == "nearest_up2x");
+  return true;
+}
+
+bool FusionConvResampleOp::InferShapeImpl() const {
+  ConvOpLite::InferShapeImpl();
+  auto out_dims = param_.output->dims();
+  if (fused_param_.resample_type == "max_pool2x2") {
+    out_dims[2] /= 2;
+    out_dims[3] /= 2;
+  } else if (fused_param_.resample_type == "global_avg_pool") {
+    out_dims[2] = 1;
+    out_dims[3] = 1;
+  } else {
+    out_dims[2] *= 2;
+    out_dims[3] *= 2;
+  }
+  param_.output->Resize(out_dims);
+  return true;
+}
+
+bool FusionConvResampleOp::AttachImpl(const cpp::OpDesc &op_desc,
+                                      lite::Scope *scope) {
+  ConvOpLite::AttachImpl(op_desc, scope);
+  static_cast<ConvParam &>(fused_param_) = param_;
+  fused_param_.resample_type = op_desc.GetAttr<std::string>("resample_type");
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_conv2d_resample,
+                 paddle::lite::operators::FusionConvResampleOp);
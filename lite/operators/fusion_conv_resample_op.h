@@ -0,0 +1,46 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <string>
+#include "lite/operators/conv_op.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+// The conv2d fused with the pool2d, reduce_mean or nearest_interp of its
+// output by lite_conv_resample_fuse_pass.
+class FusionConvResampleOp : public ConvOpLite {
+ public:
+  FusionConvResampleOp() {}
+  explicit FusionConvResampleOp(const std::string &type) : ConvOpLite(type) {}
+
+  bool CheckShape() const override;
+  bool InferShapeImpl() const override;
+  bool AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) override;
+  void AttachKernel(KernelBase *kernel) override {
+    kernel->SetParam(fused_param_);
+  }
+  std::string DebugString() const override {
+    return "fusion_conv2d_resample";
+  }
+
+ private:
+  mutable ConvResampleParam fused_param_;
+};
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,89 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fusion_depthwise_pointwise_conv_op.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusionDepthwisePointwiseConvOp::CheckShape() const {
+  if (!ConvOpLite::CheckShape()) return false;
+  CHECK_OR_FALSE(fused_param_.pw_filter);
+  const auto in_dims = param_.x->dims();
+  const auto filter_dims = param_.filter->dims();
+  const auto pw_dims = fused_param_.pw_filter->dims();
+  CHECK_EQ_OR_FALSE(in_dims.size(), 4UL);
+  CHECK_EQ_OR_FALSE(param_.groups, in_dims[1]);
+  CHECK_EQ_OR_FALSE(filter_dims[0], in_dims[1]);
+  CHECK_EQ_OR_FALSE(pw_dims.size(), 4UL);
+  CHECK_EQ_OR_FALSE(pw_dims[1], filter_dims[0]);
+  CHECK_OR_FALSE(pw_dims[2] == 1 && pw_dims[3] == 1);
+  return true;
+}
+
+bool FusionDepthwisePointwiseConvOp::InferShapeImpl() const {
+  // the 1x1 conv only changes the channels of the depthwise output
+  ConvOpLite::InferShapeImpl();
+  auto out_dims = param_.output->dims();
+  out_dims[1] = fused_param_.pw_filter->dims()[0];
+  param_.output->Resize(out_dims);
+  return true;
+}
+
+bool FusionDepthwisePointwiseConvOp::AttachImpl(const cpp::OpDesc &op_desc,
+                                                lite::Scope *scope) {
+  ConvOpLite::AttachImpl(op_desc, scope);
+  static_cast<ConvParam &>(fused_param_) = param_;
+  fused_param_.pw_filter =
+      scope->FindMutableTensor(op_desc.Input("PwFilter").front());
+  CHECK(fused_param_.pw_filter);
+  if (op_desc.HasInput("PwBias") && !op_desc.Input("PwBias").empty()) {
+    fused_param_.pw_bias =
+        scope->FindMutableTensor(op_desc.Input("PwBias").front());
+  }
+
+  auto &act = fused_param_.pw_activation_param;
+  if (op_desc.HasAttr("pw_with_act") && op_desc.GetAttr<bool>("pw_with_act")) {
+    act.has_active = true;
+    auto act_type = op_desc.GetAttr<std::string>("pw_act_type");
+    if (act_type == "relu") {
+      act.active_type = lite_api::ActivationType::kRelu;
+    } else if (act_type == "relu6") {
+      act.active_type = lite_api::ActivationType::kRelu6;
+      act.Relu_clipped_coef = op_desc.GetAttr<float>("pw_fuse_brelu_threshold");
+    } else if (act_type == "leaky_relu") {
+      act.active_type = lite_api::ActivationType::kLeakyRelu;
+      act.Leaky_relu_alpha = op_desc.GetAttr<float>("pw_leaky_relu_alpha");
+    } else if (act_type == "hard_swish") {
+      act.active_type = lite_api::ActivationType::kHardSwish;
+      act.hard_swish_threshold =
+          op_desc.GetAttr<float>("pw_hard_swish_threshold");
+      act.hard_swish_scale = op_desc.GetAttr<float>("pw_hard_swish_scale");
+      act.hard_swish_offset = op_desc.GetAttr<float>("pw_hard_swish_offset");
+    } else {
+      LOG(FATAL) << "unsupported activation of the fused pointwise conv: "
+                 << act_type;
+    }
+  }
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_depthwise_pointwise_conv2d,
+                 paddle::lite::operators::FusionDepthwisePointwiseConvOp);
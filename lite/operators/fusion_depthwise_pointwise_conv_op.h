@@ -0,0 +1,48 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <string>
+#include "lite/operators/conv_op.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+// The depthwise conv2d fused with the following 1x1 conv2d by
+// lite_depthwise_pointwise_conv_fuse_pass. The depthwise conv is attached
+// as a conv2d, the 1x1 conv comes as PwFilter, PwBias and the pw_ attrs.
+class FusionDepthwisePointwiseConvOp : public ConvOpLite {
+ public:
+  FusionDepthwisePointwiseConvOp() {}
+  explicit FusionDepthwisePointwiseConvOp(const std::string &type)
+      : ConvOpLite(type) {}
+
+  bool CheckShape() const override;
+  bool InferShapeImpl() const override;
+  bool AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) override;
+  void AttachKernel(KernelBase *kernel) override {
+    kernel->SetParam(fused_param_);
+  }
+  std::string DebugString() const override {
+    return "fusion_depthwise_pointwise_conv2d";
+  }
+
+ private:
+  mutable DepthwisePointwiseConvParam fused_param_;
+};
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,86 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fusion_distribute_fpn_roi_align_op.h"
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusionDistributeFpnRoiAlignOp::CheckShape() const {
+  CHECK_OR_FALSE(!param_.X.empty());
+  CHECK_OR_FALSE(param_.FpnRois);
+  CHECK_OR_FALSE(param_.Out);
+  const int num_level = param_.max_level - param_.min_level + 1;
+  CHECK_OR_FALSE(static_cast<int>(param_.X.size()) == num_level);
+  CHECK_OR_FALSE(static_cast<int>(param_.spatial_scales.size()) == num_level);
+  auto x_dims = param_.X[0]->dims();
+  CHECK_OR_FALSE(x_dims.size() == 4);
+  for (auto* x : param_.X) {
+    CHECK_OR_FALSE(x->dims().size() == 4);
+    CHECK_OR_FALSE(x->dims()[0] == x_dims[0]);
+    CHECK_OR_FALSE(x->dims()[1] == x_dims[1]);
+  }
+  auto rois_dims = param_.FpnRois->dims();
+  CHECK_OR_FALSE(rois_dims.size() == 2);
+  CHECK_OR_FALSE(rois_dims[1] == 4);
+  CHECK_OR_FALSE(param_.pooled_height > 0);
+  CHECK_OR_FALSE(param_.pooled_width > 0);
+  return true;
+}
+
+bool FusionDistributeFpnRoiAlignOp::InferShapeImpl() const {
+  auto x_dims = param_.X[0]->dims();
+  auto rois_dims = param_.FpnRois->dims();
+  param_.Out->Resize({rois_dims[0],
+                      x_dims[1],
+                      static_cast<int64_t>(param_.pooled_height),
+                      static_cast<int64_t>(param_.pooled_width)});
+  return true;
+}
+
+bool FusionDistributeFpnRoiAlignOp::AttachImpl(const cpp::OpDesc& opdesc,
+                                               lite::Scope* scope) {
+  param_.X.clear();
+  for (const auto& name : opdesc.Input("X")) {
+    param_.X.push_back(scope->FindMutableTensor(name));
+  }
+  param_.FpnRois = scope->FindTensor(opdesc.Input("FpnRois").front());
+  if (opdesc.HasInput("RoisNum") && !opdesc.Input("RoisNum").empty()) {
+    param_.RoisNum = scope->FindTensor(opdesc.Input("RoisNum").front());
+  }
+  param_.Out = scope->FindMutableTensor(opdesc.Output("Out").front());
+
+  param_.min_level = opdesc.GetAttr<int>("min_level");
+  param_.max_level = opdesc.GetAttr<int>("max_level");
+  param_.refer_level = opdesc.GetAttr<int>("refer_level");
+  param_.refer_scale = opdesc.GetAttr<int>("refer_scale");
+  param_.pixel_offset = opdesc.GetAttr<bool>("pixel_offset");
+
+  param_.spatial_scales = opdesc.GetAttr<std::vector<float>>("spatial_scales");
+  param_.pooled_height = opdesc.GetAttr<int>("pooled_height");
+  param_.pooled_width = opdesc.GetAttr<int>("pooled_width");
+  param_.sampling_ratio = opdesc.GetAttr<int>("sampling_ratio");
+  param_.aligned = opdesc.GetAttr<bool>("aligned");
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_distribute_fpn_roi_align,
+                 paddle::lite::operators::FusionDistributeFpnRoiAlignOp);
@@ -28,9 +28,10 @@ bool FusionElementwiseActivationOp::CheckShape() const {
 }
 
 bool FusionElementwiseActivationOp::InferShapeImpl() const {
-  auto x_dim = param_.X->dims();
+  auto x_dim = x_->dims();
   auto y_dim = param_.Y->dims();
   if (x_dim == y_dim) {
+    SelectInplaceInput(x_, x_dim, &x_copy_, kernel_ptr_, &param_);
     param_.Out->Resize(x_dim);
     auto out_lod = param_.Out->mutable_lod();
     *out_lod = param_.X->lod();
@@ -78,6 +79,8 @@ bool FusionElementwiseActivationOp::InferShapeImpl() const {
         out_dims_array[i] = (std::max)(x_dims_array[i], y_dims_array[i]);
       }
     }
+    SelectInplaceInput(
+        x_, DDim(out_dims_array), &x_copy_, kernel_ptr_, &param_);
     param_.Out->Resize(DDim(out_dims_array));
     auto out_lod = param_.Out->mutable_lod();
     *out_lod = param_.X->lod();
@@ -93,6 +96,7 @@ bool FusionElementwiseActivationOp::AttachImpl(const cpp::OpDesc& opdesc,
   auto Out_name = opdesc.Output("Out").front();
 
   param_.X = GetVar<lite::Tensor>(scope, X_name);
+  x_ = param_.X;
   param_.Y = GetVar<lite::Tensor>(scope, Y_name);
   param_.Out = GetMutableVar<lite::Tensor>(scope, Out_name);
   param_.axis = opdesc.GetAttr<int>("axis");
@@ -33,14 +33,24 @@ class FusionElementwiseActivationOp : public OpLite {
 
   bool AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) override;
 
-  void AttachKernel(KernelBase* kernel) override { kernel->SetParam(param_); }
+  void AttachKernel(KernelBase* kernel) override {
+    kernel_ptr_ = kernel;
+    kernel->SetParam(param_);
+  }
 
   std::string DebugString() const override {
     return "fusion_elementwise_activation_op";
   }
 
+ protected:
+  // the copy of X is taken on every run
+  bool InferShapeWithCache() const override { return param_.Out != x_; }
+
  private:
   mutable operators::FusionElementwiseActivationParam param_;
+  const lite::Tensor* x_{nullptr};
+  mutable lite::Tensor x_copy_;
+  KernelBase* kernel_ptr_{nullptr};
 };
 
 // #ifdef LITE_WITH_TRAIN
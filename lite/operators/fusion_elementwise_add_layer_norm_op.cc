@@ -0,0 +1,101 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fusion_elementwise_add_layer_norm_op.h"
+#include <algorithm>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusionElementwiseAddLayerNormOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.X);
+  CHECK_OR_FALSE(param_.Residual);
+  CHECK_OR_FALSE(param_.Y);
+  CHECK_OR_FALSE(param_.Mean);
+  CHECK_OR_FALSE(param_.Variance);
+  // The smaller one of the inputs is broadcast to the rows of the other one,
+  // the same as elementwise_add of axis -1.
+  auto x_dims = param_.X->dims();
+  auto r_dims = param_.Residual->dims();
+  if (x_dims.size() < r_dims.size()) std::swap(x_dims, r_dims);
+  CHECK_GT_OR_FALSE(x_dims.size(), static_cast<size_t>(param_.begin_norm_axis));
+  size_t offset = x_dims.size() - r_dims.size();
+  for (size_t i = 0; i < r_dims.size(); i++) {
+    if (i + offset < static_cast<size_t>(param_.begin_norm_axis) &&
+        r_dims.count(0, i + 1) == 1) {
+      continue;
+    }
+    CHECK_EQ_OR_FALSE(r_dims[i], x_dims[i + offset]);
+  }
+  // The residual covers whole rows of the normalized dims.
+  CHECK_EQ_OR_FALSE(
+      r_dims.production() % x_dims.Flatten2D(param_.begin_norm_axis)[1], 0);
+  return true;
+}
+
+bool FusionElementwiseAddLayerNormOp::InferShapeImpl() const {
+  if (param_.X->numel() < param_.Residual->numel()) {
+    std::swap(param_.X, param_.Residual);
+  }
+  auto out_dims = param_.X->dims();
+  param_.Y->Resize(out_dims);
+  if (param_.AddOut) param_.AddOut->Resize(out_dims);
+  auto inner_size = out_dims.Flatten2D(param_.begin_norm_axis)[0];
+  param_.Mean->Resize(std::vector<int64_t>({inner_size}));
+  param_.Variance->Resize(std::vector<int64_t>({inner_size}));
+
+  auto out_lod = param_.Y->mutable_lod();
+  *out_lod = param_.X->lod();
+  return true;
+}
+
+bool FusionElementwiseAddLayerNormOp::AttachImpl(const cpp::OpDesc &opdesc,
+                                                 lite::Scope *scope) {
+  param_.X =
+      scope->FindVar(opdesc.Input("X").front())->GetMutable<lite::Tensor>();
+  param_.Residual = scope->FindVar(opdesc.Input("Residual").front())
+                        ->GetMutable<lite::Tensor>();
+  param_.Y =
+      scope->FindVar(opdesc.Output("Y").front())->GetMutable<lite::Tensor>();
+  param_.Mean =
+      scope->FindVar(opdesc.Output("Mean").front())->GetMutable<lite::Tensor>();
+  param_.Variance = scope->FindVar(opdesc.Output("Variance").front())
+                        ->GetMutable<lite::Tensor>();
+  param_.AddOut = nullptr;
+  if (opdesc.HasOutput("AddOut") && !opdesc.Output("AddOut").empty()) {
+    param_.AddOut = scope->FindVar(opdesc.Output("AddOut").front())
+                        ->GetMutable<lite::Tensor>();
+  }
+  if (opdesc.HasInput("Scale")) {
+    param_.Scale = scope->FindVar(opdesc.Input("Scale").front())
+                       ->GetMutable<lite::Tensor>();
+  }
+  if (opdesc.HasInput("Bias")) {
+    param_.Bias = scope->FindVar(opdesc.Input("Bias").front())
+                      ->GetMutable<lite::Tensor>();
+  }
+  param_.begin_norm_axis = opdesc.GetAttr<int>("begin_norm_axis");
+  param_.epsilon = opdesc.GetAttr<float>("epsilon");
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_elementwise_add_layer_norm,
+                 paddle::lite::operators::FusionElementwiseAddLayerNormOp);
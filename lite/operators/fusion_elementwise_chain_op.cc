@@ -0,0 +1,125 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fusion_elementwise_chain_op.h"
+#include <algorithm>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusionElementwiseChainOp::CheckShape() const {
+  CHECK_OR_FALSE(!param_.X.empty());
+  CHECK_OR_FALSE(param_.Out);
+  const size_t num_steps = param_.step_types.size();
+  CHECK_OR_FALSE(num_steps > 0);
+  CHECK_OR_FALSE(param_.operands.size() == num_steps);
+  CHECK_OR_FALSE(param_.operand_first.size() == num_steps);
+  CHECK_OR_FALSE(param_.axes.size() == num_steps);
+  CHECK_OR_FALSE(param_.alphas.size() == num_steps);
+  CHECK_OR_FALSE(param_.betas.size() == num_steps);
+  CHECK_OR_FALSE(param_.gammas.size() == num_steps);
+  for (size_t i = 0; i < num_steps; i++) {
+    // a step reads the inputs and the results of the previous steps only
+    CHECK_OR_FALSE(param_.operands[i] <
+                   static_cast<int>(param_.X.size() + i));
+  }
+  return true;
+}
+
+// The dims padded with 1 to the rank, from the offset.
+static std::vector<int64_t> PadDims(const std::vector<int64_t>& dims,
+                                    size_t offset,
+                                    size_t rank) {
+  std::vector<int64_t> padded(rank, 1);
+  for (size_t i = 0; i < dims.size(); i++) {
+    padded[offset + i] = dims[i];
+  }
+  return padded;
+}
+
+bool FusionElementwiseChainOp::InferShapeImpl() const {
+  const int num_x = static_cast<int>(param_.X.size());
+  const int num_steps = static_cast<int>(param_.step_types.size());
+  // the dims of the inputs and the results, padded to the rank of the chain
+  // value once they are read
+  std::vector<std::vector<int64_t>> dims(num_x + num_steps);
+  std::vector<bool> padded(num_x + num_steps, false);
+  auto chain = param_.X[0]->dims().Vectorize();
+  dims[0] = chain;
+  padded[0] = true;
+  for (int s = 0; s < num_steps; s++) {
+    const int operand = param_.operands[s];
+    if (operand >= 0) {
+      auto other = padded[operand] ? dims[operand]
+                                   : param_.X[operand]->dims().Vectorize();
+      // the elementwise ops put the input of the lower rank at the axis
+      const size_t rank = std::max(chain.size(), other.size());
+      const size_t diff = rank - std::min(chain.size(), other.size());
+      const size_t offset =
+          param_.axes[s] == -1 ? diff : static_cast<size_t>(param_.axes[s]);
+      if (other.size() < rank) {
+        other = PadDims(other, offset, rank);
+      } else if (chain.size() < rank) {
+        for (int i = 0; i < num_x + s; i++) {
+          if (padded[i]) dims[i] = PadDims(dims[i], offset, rank);
+        }
+        chain = PadDims(chain, offset, rank);
+      }
+      dims[operand] = other;
+      padded[operand] = true;
+      for (size_t i = 0; i < rank; i++) {
+        CHECK_OR_FALSE(chain[i] == other[i] || chain[i] == 1 ||
+                       other[i] == 1);
+        chain[i] = std::max(chain[i], other[i]);
+      }
+    }
+    dims[num_x + s] = chain;
+    padded[num_x + s] = true;
+  }
+  param_.x_aligned_dims.assign(dims.begin(), dims.begin() + num_x);
+  for (int i = 0; i < num_x; i++) {
+    CHECK_OR_FALSE(padded[i]);
+  }
+  param_.Out->Resize(DDim(chain));
+  param_.Out->set_lod(param_.X[0]->lod());
+  return true;
+}
+
+bool FusionElementwiseChainOp::AttachImpl(const cpp::OpDesc& opdesc,
+                                          lite::Scope* scope) {
+  param_.X.clear();
+  for (const auto& name : opdesc.Input("X")) {
+    param_.X.push_back(scope->FindVar(name)->GetMutable<lite::Tensor>());
+  }
+  param_.Out = scope->FindVar(opdesc.Output("Out").front())
+                   ->GetMutable<lite::Tensor>();
+  param_.step_types = opdesc.GetAttr<std::vector<std::string>>("step_types");
+  param_.operands = opdesc.GetAttr<std::vector<int>>("operands");
+  param_.operand_first = opdesc.GetAttr<std::vector<int>>("operand_first");
+  param_.axes = opdesc.GetAttr<std::vector<int>>("axes");
+  param_.alphas = opdesc.GetAttr<std::vector<float>>("alphas");
+  param_.betas = opdesc.GetAttr<std::vector<float>>("betas");
+  param_.gammas = opdesc.GetAttr<std::vector<float>>("gammas");
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_elementwise_chain,
+                 paddle::lite::operators::FusionElementwiseChainOp);
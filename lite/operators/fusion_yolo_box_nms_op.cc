@@ -0,0 +1,96 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fusion_yolo_box_nms_op.h"
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusionYoloBoxNmsOp::CheckShape() const {
+  CHECK_OR_FALSE(!param_.X.empty());
+  CHECK_OR_FALSE(param_.ImgSize);
+  CHECK_OR_FALSE(param_.Out);
+  const size_t num_heads = param_.X.size();
+  CHECK_OR_FALSE(param_.anchor_nums.size() == num_heads);
+  CHECK_OR_FALSE(param_.downsample_ratios.size() == num_heads);
+  CHECK_OR_FALSE(param_.scales_x_y.size() == num_heads);
+  CHECK_OR_FALSE(param_.class_num > 0);
+  int num_anchors = 0;
+  for (size_t i = 0; i < num_heads; i++) {
+    auto x_dims = param_.X[i]->dims();
+    CHECK_OR_FALSE(x_dims.size() == 4);
+    CHECK_OR_FALSE(x_dims[0] == param_.X[0]->dims()[0]);
+    CHECK_OR_FALSE(x_dims[1] ==
+                   param_.anchor_nums[i] * (5 + param_.class_num));
+    num_anchors += param_.anchor_nums[i];
+  }
+  CHECK_OR_FALSE(static_cast<int>(param_.anchors.size()) == 2 * num_anchors);
+  auto img_size_dims = param_.ImgSize->dims();
+  CHECK_OR_FALSE(img_size_dims.size() == 2);
+  CHECK_OR_FALSE(img_size_dims[0] == param_.X[0]->dims()[0]);
+  CHECK_OR_FALSE(img_size_dims[1] == 2);
+  return true;
+}
+
+bool FusionYoloBoxNmsOp::InferShapeImpl() const {
+  // The dims of Out are known after the nms only.
+  return true;
+}
+
+bool FusionYoloBoxNmsOp::AttachImpl(const cpp::OpDesc& opdesc,
+                                    lite::Scope* scope) {
+  param_.X.clear();
+  for (const auto& name : opdesc.Input("X")) {
+    param_.X.push_back(scope->FindVar(name)->GetMutable<lite::Tensor>());
+  }
+  param_.ImgSize = scope->FindVar(opdesc.Input("ImgSize").front())
+                       ->GetMutable<lite::Tensor>();
+  param_.Out = scope->FindVar(opdesc.Output("Out").front())
+                   ->GetMutable<lite::Tensor>();
+  if (opdesc.HasOutput("Index") && !opdesc.Output("Index").empty()) {
+    param_.Index = scope->FindMutableTensor(opdesc.Output("Index").front());
+  }
+  if (opdesc.HasOutput("NmsRoisNum") && !opdesc.Output("NmsRoisNum").empty()) {
+    param_.NmsRoisNum =
+        scope->FindMutableTensor(opdesc.Output("NmsRoisNum").front());
+  }
+
+  param_.anchors = opdesc.GetAttr<std::vector<int>>("anchors");
+  param_.anchor_nums = opdesc.GetAttr<std::vector<int>>("anchor_nums");
+  param_.downsample_ratios =
+      opdesc.GetAttr<std::vector<int>>("downsample_ratios");
+  param_.scales_x_y = opdesc.GetAttr<std::vector<float>>("scales_x_y");
+  param_.class_num = opdesc.GetAttr<int>("class_num");
+  param_.conf_thresh = opdesc.GetAttr<float>("conf_thresh");
+  param_.clip_bbox = opdesc.GetAttr<bool>("clip_bbox");
+
+  param_.background_label = opdesc.GetAttr<int>("background_label");
+  param_.score_threshold = opdesc.GetAttr<float>("score_threshold");
+  param_.nms_top_k = opdesc.GetAttr<int>("nms_top_k");
+  param_.nms_threshold = opdesc.GetAttr<float>("nms_threshold");
+  param_.nms_eta = opdesc.GetAttr<float>("nms_eta");
+  param_.keep_top_k = opdesc.GetAttr<int>("keep_top_k");
+  param_.normalized = opdesc.GetAttr<bool>("normalized");
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_yolo_box_nms,
+                 paddle::lite::operators::FusionYoloBoxNmsOp);
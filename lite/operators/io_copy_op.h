@@ -25,6 +25,8 @@ class IoCopyOp : public OpLite {
   explicit IoCopyOp(const std::string &type) : OpLite(type) {}
   bool CheckShape() const override;
   bool InferShapeImpl() const override;
+  // The precision of the output is copied here as well.
+  bool InferShapeWithCache() const override { return false; }
   bool Run() override;
   std::string DebugString() const override;
 
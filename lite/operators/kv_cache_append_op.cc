@@ -0,0 +1,67 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/kv_cache_append_op.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool KVCacheAppendOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.k);
+  CHECK_OR_FALSE(param_.v);
+  CHECK_OR_FALSE(param_.cache);
+  const auto& k_dims = param_.k->dims();
+  const auto& v_dims = param_.v->dims();
+  CHECK_EQ_OR_FALSE(k_dims.size(), 4UL);
+  CHECK_EQ_OR_FALSE(v_dims.size(), 4UL);
+  for (size_t i = 0; i < 3; i++) {
+    CHECK_EQ_OR_FALSE(v_dims[i], k_dims[i]);
+  }
+  if (param_.beam_idx) {
+    CHECK_EQ_OR_FALSE(param_.beam_idx->numel(), k_dims[0]);
+  }
+  if (param_.step) {
+    CHECK_EQ_OR_FALSE(param_.step->numel(), 1);
+  }
+  return true;
+}
+
+bool KVCacheAppendOp::InferShapeImpl() const { return true; }
+
+bool KVCacheAppendOp::AttachImpl(const cpp::OpDesc& op_desc,
+                                 lite::Scope* scope) {
+  param_.k = scope->FindVar(op_desc.Input("K").front())->GetMutable<Tensor>();
+  param_.v = scope->FindVar(op_desc.Input("V").front())->GetMutable<Tensor>();
+  param_.beam_idx = nullptr;
+  if (op_desc.HasInput("BeamIdx") && !op_desc.Input("BeamIdx").empty()) {
+    param_.beam_idx =
+        scope->FindVar(op_desc.Input("BeamIdx").front())->GetMutable<Tensor>();
+  }
+  param_.step = nullptr;
+  if (op_desc.HasInput("Step") && !op_desc.Input("Step").empty()) {
+    param_.step =
+        scope->FindVar(op_desc.Input("Step").front())->GetMutable<Tensor>();
+  }
+  param_.cache =
+      scope->FindVar(op_desc.Output("Cache").front())->GetMutable<KVCache>();
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(kv_cache_append, paddle::lite::operators::KVCacheAppendOp);
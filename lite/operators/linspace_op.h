@@ -30,6 +30,11 @@ class LinspaceOpLite : public OpLite {
 
   bool InferShapeImpl() const override;
 
+  bool ShapeDependsOnInputData() const override { return true; }
+
+  // The precision of the output is set here as well.
+  bool InferShapeWithCache() const override { return false; }
+
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
@@ -31,8 +31,15 @@ bool LookupTableDequantOpLite::CheckShape() const {
   int ids_rank = ids_dims.size();
 
   CHECK_EQ_OR_FALSE(table_dims.size(), 2);
-  CHECK_EQ_OR_FALSE(ids_dims[ids_rank - 1], 1);
+  if (!param_.append_width) {
+    CHECK_EQ_OR_FALSE(ids_dims[ids_rank - 1], 1);
+  }
   CHECK_GT_OR_FALSE(table_dims[1], 2);
+  if (param_.quant_bits != 0) {
+    CHECK_OR_FALSE(param_.quant_bits == 8 || param_.quant_bits == 4);
+    CHECK_EQ_OR_FALSE(table_dims[1],
+                      2 + (param_.row_width * param_.quant_bits + 31) / 32);
+  }
   return true;
 }
 
@@ -40,11 +47,16 @@ bool LookupTableDequantOpLite::InferShapeImpl() const {
   const auto& table_dims = param_.W->dims();
   const auto& ids_dims = param_.Ids->dims();
 
-  auto out_dims = ids_dims;
-  int ids_rank = ids_dims.size();
-  out_dims[ids_rank - 1] = (table_dims[1] - 2) * 4;
+  int64_t row_width = param_.quant_bits != 0 ? param_.row_width
+                                              : (table_dims[1] - 2) * 4;
+  std::vector<int64_t> out_dims = ids_dims.Vectorize();
+  if (param_.append_width) {
+    out_dims.push_back(row_width);
+  } else {
+    out_dims.back() = row_width;
+  }
 
-  param_.Out->Resize(out_dims);
+  param_.Out->Resize(lite::DDim{out_dims});
   param_.Out->set_lod(param_.Ids->lod());
   return true;
 }
@@ -60,6 +72,13 @@ bool LookupTableDequantOpLite::AttachImpl(const cpp::OpDesc& op_desc,
   param_.Out = scope->FindVar(out)->GetMutable<lite::Tensor>();
 
   param_.padding_idx = op_desc.GetAttr<int64_t>("padding_idx");
+  if (op_desc.HasAttr("quant_bits")) {
+    param_.quant_bits = op_desc.GetAttr<int>("quant_bits");
+    param_.row_width = op_desc.GetAttr<int64_t>("row_width");
+  }
+  if (op_desc.HasAttr("append_width")) {
+    param_.append_width = op_desc.GetAttr<bool>("append_width");
+  }
 
   return true;
 }
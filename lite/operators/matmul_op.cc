@@ -24,8 +24,10 @@ bool MatMulOpLite::CheckShape() const {
   CHECK_OR_FALSE(param_.Y);
   CHECK_OR_FALSE(param_.Out);
 
-  const auto x_dims = param_.X->dims();
-  const auto y_dims = param_.Y->dims();
+  const auto x_dims = FusedTransposeDims(param_.X->dims(),
+                                         param_.fused_transpose_X);
+  const auto y_dims = FusedTransposeDims(param_.Y->dims(),
+                                         param_.fused_transpose_Y);
   bool x_transpose = param_.transpose_X;
   bool y_transpose = param_.transpose_Y;
 
@@ -56,8 +58,10 @@ bool MatMulOpLite::CheckShape() const {
 }
 
 bool MatMulOpLite::InferShapeImpl() const {
-  const auto x_dims = param_.X->dims();
-  const auto y_dims = param_.Y->dims();
+  const auto x_dims = FusedTransposeDims(param_.X->dims(),
+                                         param_.fused_transpose_X);
+  const auto y_dims = FusedTransposeDims(param_.Y->dims(),
+                                         param_.fused_transpose_Y);
   bool x_transpose = param_.transpose_X;
   bool y_transpose = param_.transpose_Y;
   std::vector<int64_t> dim_out_vec;
@@ -130,7 +134,7 @@ bool MatMulOpLite::InferShapeImpl() const {
   }
 
   DDim dim_out(dim_out_vec);
-  param_.Out->Resize(dim_out);
+  param_.Out->Resize(FusedTransposeDims(dim_out, param_.fused_transpose_Out));
 
   return true;
 }
@@ -150,9 +154,21 @@ bool MatMulOpLite::AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) {
   param_.transpose_X = op_desc.GetAttr<bool>("transpose_X");
   param_.transpose_Y = op_desc.GetAttr<bool>("transpose_Y");
   param_.alpha = op_desc.GetAttr<float>("alpha");
-  input_tensor_ptrs_cache_.push_back(param_.X);
-  input_tensor_ptrs_cache_.push_back(param_.Y);
-  output_tensor_ptrs_cache_.push_back(param_.Out);
+  if (op_desc.HasAttr("fuse_softmax")) {
+    param_.fuse_softmax = op_desc.GetAttr<bool>("fuse_softmax");
+  }
+  if (op_desc.HasAttr("fused_transpose_X")) {
+    param_.fused_transpose_X =
+        op_desc.GetAttr<std::vector<int>>("fused_transpose_X");
+  }
+  if (op_desc.HasAttr("fused_transpose_Y")) {
+    param_.fused_transpose_Y =
+        op_desc.GetAttr<std::vector<int>>("fused_transpose_Y");
+  }
+  if (op_desc.HasAttr("fused_transpose_Out")) {
+    param_.fused_transpose_Out =
+        op_desc.GetAttr<std::vector<int>>("fused_transpose_Out");
+  }
 
   const OpInfo *op_info = static_cast<const OpInfo *>(&op_desc);
   if (op_info != nullptr && op_info->HasAttr("enable_int8")) {
@@ -25,6 +25,17 @@ namespace paddle {
 namespace lite {
 namespace operators {
 
+// The dims of X, Y or Out of a matmul as seen through the axis of the
+// transpose2 folded into it, see MatMulParam::fused_transpose_X.
+inline DDim FusedTransposeDims(const DDim &dims, const std::vector<int> &axis) {
+  if (axis.empty()) return dims;
+  std::vector<int64_t> out(axis.size());
+  for (size_t i = 0; i < axis.size(); ++i) {
+    out[i] = dims[axis[i]];
+  }
+  return DDim(out);
+}
+
 class MatMulOpLite : public OpLite {
  public:
   MatMulOpLite() {}
@@ -35,8 +46,6 @@ class MatMulOpLite : public OpLite {
 
   bool InferShapeImpl() const override;
 
-  bool InferShapeWithCache() const override { return true; }
-
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
 
   bool AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) override;
@@ -53,18 +62,10 @@ class MatMulOpLite : public OpLite {
                  std::to_string(param_.transpose_Y);
 
     auto x_dims = param_.X->dims();
-    auto y_dims = param_.Y->dims();
-    auto m = x_dims[x_dims.size() - 2];
-    auto k = x_dims[x_dims.size() - 1];
-    auto n = y_dims[y_dims.size() - 1];
-    if (param_.transpose_X) {
-      m = x_dims[x_dims.size() - 1];
-      k = x_dims[x_dims.size() - 2];
-    }
-    if (param_.transpose_Y) {
-      n = y_dims[y_dims.size() - 2];
-    }
-    ch->macs = 3.f * m * n * k;
+    auto k = param_.transpose_X ? x_dims[x_dims.size() - 2]
+                                : x_dims[x_dims.size() - 1];
+    // Each output is a dot product of k elements, including the batches.
+    ch->macs = 2.f * param_.Out->dims().production() * k;
   }
 #endif
 
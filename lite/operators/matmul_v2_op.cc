@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include "lite/operators/matmul_v2_op.h"
+#include <algorithm>
 #include "lite/core/op_registry.h"
+#include "lite/operators/matmul_op.h"
 
 namespace paddle {
 namespace lite {
@@ -24,8 +26,10 @@ bool MatMulV2OpLite::CheckShape() const {
   CHECK_OR_FALSE(param_.Y);
   CHECK_OR_FALSE(param_.Out);
 
-  const auto x_dims = param_.X->dims();
-  const auto y_dims = param_.Y->dims();
+  const auto x_dims = FusedTransposeDims(param_.X->dims(),
+                                         param_.fused_transpose_X);
+  const auto y_dims = FusedTransposeDims(param_.Y->dims(),
+                                         param_.fused_transpose_Y);
   bool x_transpose = param_.transpose_X;
   bool y_transpose = param_.transpose_Y;
 
@@ -63,8 +67,10 @@ bool MatMulV2OpLite::CheckShape() const {
 }
 
 bool MatMulV2OpLite::InferShapeImpl() const {
-  const auto x_dims = param_.X->dims();
-  const auto y_dims = param_.Y->dims();
+  const auto x_dims = FusedTransposeDims(param_.X->dims(),
+                                         param_.fused_transpose_X);
+  const auto y_dims = FusedTransposeDims(param_.Y->dims(),
+                                         param_.fused_transpose_Y);
   bool trans_x = param_.transpose_X;
   bool trans_y = param_.transpose_Y;
   std::vector<int64_t> dim_out_vec;
@@ -97,11 +103,17 @@ bool MatMulV2OpLite::InferShapeImpl() const {
   } else {
     N = dims_y[ndims_y - 1];
   }
-  std::vector<int64_t> new_dims;
-  if (ndims_x >= ndims_y) {
-    dim_out_vec.assign(dims_x.begin(), dims_x.end() - 2);
-  } else {
-    dim_out_vec.assign(dims_y.begin(), dims_y.end() - 2);
+  // the batch dims are aligned to the last ones and broadcast
+  const int batch_rank = std::max(ndims_x, ndims_y) - 2;
+  for (int i = 0; i < batch_rank; ++i) {
+    int xi = i - (batch_rank - (ndims_x - 2));
+    int yi = i - (batch_rank - (ndims_y - 2));
+    int64_t x_dim = xi >= 0 ? dims_x[xi] : 1;
+    int64_t y_dim = yi >= 0 ? dims_y[yi] : 1;
+    CHECK(x_dim == y_dim || x_dim == 1 || y_dim == 1)
+        << "the batch dims of matmul_v2 can't be broadcast, x_dims(" << x_dims
+        << "), y_dims(" << y_dims << ")";
+    dim_out_vec.push_back(x_dim == 1 ? y_dim : x_dim);
   }
   if (!x_broadcasted) {
     dim_out_vec.push_back(M);
@@ -113,7 +125,7 @@ bool MatMulV2OpLite::InferShapeImpl() const {
     dim_out_vec.push_back(1);
   }
   DDim dim_out(dim_out_vec);
-  param_.Out->Resize(dim_out);
+  param_.Out->Resize(FusedTransposeDims(dim_out, param_.fused_transpose_Out));
 
   return true;
 }
@@ -136,9 +148,21 @@ bool MatMulV2OpLite::AttachImpl(const cpp::OpDesc &op_desc,
   if (op_desc.HasAttr("alpha")) {
     param_.alpha = op_desc.GetAttr<float>("alpha");
   }
-  input_tensor_ptrs_cache_.push_back(param_.X);
-  input_tensor_ptrs_cache_.push_back(param_.Y);
-  output_tensor_ptrs_cache_.push_back(param_.Out);
+  if (op_desc.HasAttr("fuse_softmax")) {
+    param_.fuse_softmax = op_desc.GetAttr<bool>("fuse_softmax");
+  }
+  if (op_desc.HasAttr("fused_transpose_X")) {
+    param_.fused_transpose_X =
+        op_desc.GetAttr<std::vector<int>>("fused_transpose_X");
+  }
+  if (op_desc.HasAttr("fused_transpose_Y")) {
+    param_.fused_transpose_Y =
+        op_desc.GetAttr<std::vector<int>>("fused_transpose_Y");
+  }
+  if (op_desc.HasAttr("fused_transpose_Out")) {
+    param_.fused_transpose_Out =
+        op_desc.GetAttr<std::vector<int>>("fused_transpose_Out");
+  }
   const OpInfo *op_info = static_cast<const OpInfo *>(&op_desc);
   if (op_info != nullptr && op_info->HasAttr("enable_int8")) {
     param_.enable_int8 = op_info->GetAttr<bool>("enable_int8");
@@ -152,6 +176,15 @@ bool MatMulV2OpLite::AttachImpl(const cpp::OpDesc &op_desc,
     if (op_info->HasOutputScale(out_scale_name, true))
       param_.output_scale = op_info->GetOutputScale(out_scale_name, true)[0];
   }
+  // For the group-wise int4 weight of post_quant_dynamic
+  if (op_desc.HasAttr("quantize_weight_bits") &&
+      op_desc.GetAttr<int>("quantize_weight_bits") == 4) {
+    param_.weight_quant_bits = 4;
+    param_.weight_group_size =
+        op_desc.GetAttr<int>("quantize_weight_group_size");
+    param_.weight_quant_scale =
+        op_desc.GetAttr<std::vector<float>>(Y + "_quant_scale");
+  }
   return true;
 }
 
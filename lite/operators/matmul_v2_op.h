@@ -35,8 +35,6 @@ class MatMulV2OpLite : public OpLite {
 
   bool InferShapeImpl() const override;
 
-  bool InferShapeWithCache() const override { return true; }
-
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
 
   bool AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) override;
@@ -53,18 +51,10 @@ class MatMulV2OpLite : public OpLite {
                  std::to_string(param_.transpose_Y);
 
     auto x_dims = param_.X->dims();
-    auto y_dims = param_.Y->dims();
-    auto m = x_dims[x_dims.size() - 2];
-    auto k = x_dims[x_dims.size() - 1];
-    auto n = y_dims[y_dims.size() - 1];
-    if (param_.transpose_X) {
-      m = x_dims[x_dims.size() - 1];
-      k = x_dims[x_dims.size() - 2];
-    }
-    if (param_.transpose_Y) {
-      n = y_dims[y_dims.size() - 2];
-    }
-    ch->macs = 3.f * m * n * k;
+    auto k = param_.transpose_X ? x_dims[x_dims.size() - 2]
+                                : x_dims[x_dims.size() - 1];
+    // Each output is a dot product of k elements, including the batches.
+    ch->macs = 2.f * param_.Out->dims().production() * k;
   }
 #endif
 
@@ -35,8 +35,6 @@ class MulOpLite : public OpLite {
 
   bool InferShapeImpl() const override;
 
-  bool InferShapeWithCache() const override { return true; }
-
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
   // TODO(Superjomn) replace framework::OpDesc with a lite one.
   bool AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) override {
@@ -71,10 +69,10 @@ class MulOpLite : public OpLite {
         param_.weight_scale = op_info->GetInputScale(weight_scale_name, true);
       if (op_info->HasOutputScale(out_scale_name, true))
         param_.output_scale = op_info->GetOutputScale(out_scale_name, true)[0];
+      if (op_info->HasAttr(input + "_zero_point")) {
+        param_.input_zero_point = op_info->GetAttr<int>(input + "_zero_point");
+      }
     }
-    input_tensor_ptrs_cache_.push_back(param_.x);
-    input_tensor_ptrs_cache_.push_back(param_.y);
-    output_tensor_ptrs_cache_.push_back(param_.output);
 
     return true;
   }
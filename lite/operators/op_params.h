@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "lite/api/paddle_place.h"
+#include "lite/core/kv_cache.h"
 #include "lite/core/model/base/apis.h"
 #include "lite/core/scope.h"
 #include "lite/core/tensor.h"
@@ -36,13 +37,23 @@ namespace operators {
 struct ParamBase {};
 
 using param_t = Any;
+// input_zero_point is non-zero for the asymmetric int8 input
 #define WITH_INT8_CONFIG             \
   bool enable_int8{false};           \
   float input_scale{1.0f};           \
+  int input_zero_point{0};           \
   std::vector<float> weight_scale{}; \
   float output_scale{1.0f};          \
   int bit_length{8};
 
+// the weight-only quantized weight of post_quant_dynamic, the int4 one
+// group-wise along K or the int8 one channel-wise, run without dequantizing
+// it at load by the kernels supporting it
+#define WITH_WEIGHT_ONLY_CONFIG            \
+  int weight_quant_bits{0};                \
+  int weight_group_size{0};                \
+  std::vector<float> weight_quant_scale{};
+
 /// ----------------------- Functional operators ------------------------------
 struct FeedParam : ParamBase {
   std::vector<lite::Tensor>* feed_list{};
@@ -75,6 +86,8 @@ struct CalibParam : ParamBase {
   const lite::Tensor* input{};
   lite::Tensor* output{};
   float scale;
+  // the zero point of the asymmetric int8 output of fp32 to int8
+  int zero_point{0};
 };
 
 struct SubgraphParam : ParamBase {
@@ -108,6 +121,7 @@ struct FcParam : ParamBase {
   std::string op_type{"mul"};
   // for int8
   WITH_INT8_CONFIG
+  WITH_WEIGHT_ONLY_CONFIG
 };
 
 struct SearchSeqFcParam : ParamBase {
@@ -223,6 +237,34 @@ struct YoloBoxParam : ParamBase {
   float scale_x_y{1.0f};
 };
 
+// The yolo_box ops of the heads X, the concat of their results and the
+// multiclass_nms of them, fused by lite_yolo_box_nms_fuse_pass. The anchors
+// of the heads are one after another, and anchor_nums[i] of them belong to
+// the head i.
+struct YoloBoxNmsParam : ParamBase {
+  std::vector<lite::Tensor*> X{};
+  lite::Tensor* ImgSize{};
+  lite::Tensor* Out{};
+  lite::Tensor* Index{};
+  lite::Tensor* NmsRoisNum{};
+
+  std::vector<int> anchors{};
+  std::vector<int> anchor_nums{};
+  std::vector<int> downsample_ratios{};
+  std::vector<float> scales_x_y{};
+  int class_num{0};
+  float conf_thresh{0.f};
+  bool clip_bbox{true};
+
+  int background_label{0};
+  float score_threshold{0.f};
+  int nms_top_k{-1};
+  float nms_threshold{0.3f};
+  float nms_eta{1.0f};
+  int keep_top_k{-1};
+  bool normalized{true};
+};
+
 // For Scale Op
 struct ScaleParam : ParamBase {
   lite::Tensor* x{};
@@ -259,6 +301,64 @@ struct SoftmaxParam : ParamBase {
   bool eleminate_success{false};
 };
 
+// For FusionAttention op, the scaled dot-product attention
+// softmax(q * k^T * scale + mask) * v fused from the matmul, scale,
+// elementwise_add, softmax and matmul ops.
+struct FusionAttentionParam : ParamBase {
+  const lite::Tensor* q{};
+  const lite::Tensor* k{};
+  const lite::Tensor* v{};
+  // broadcast to the attention scores [..., seq_q, seq_k] if not nullptr.
+  const lite::Tensor* mask{nullptr};
+  lite::Tensor* output{};
+  float scale{1.f};
+  // the output of [batch, head, seq_q, dim] is transposed to
+  // [batch, seq_q, head, dim].
+  bool transpose_out{false};
+  // the int32 [batch + 1] offsets of the sequences packed without padding if
+  // not nullptr, then q, k, v and output are [total, head, dim].
+  const lite::Tensor* cu_seqlens{nullptr};
+};
+
+// Pack the rows of the sequences [batch, seq, ...] padded to seq into
+// [total, ...] without the padding, whose offsets are in cu_seqlens.
+struct PackSequenceParam : ParamBase {
+  const lite::Tensor* x{};
+  // the int32 or int64 [batch] valid lengths of the sequences.
+  const lite::Tensor* seq_len{};
+  lite::Tensor* out{};
+  // the int32 [batch + 1] offsets of the sequences in out.
+  lite::Tensor* cu_seqlens{};
+};
+
+// The inverse of PackSequenceParam, the padding rows are zeros.
+struct UnpackSequenceParam : ParamBase {
+  const lite::Tensor* x{};
+  const lite::Tensor* cu_seqlens{};
+  lite::Tensor* out{};
+  // padded to the longest sequence if not positive.
+  int padded_length{-1};
+};
+
+struct KVCacheAppendParam : ParamBase {
+  const lite::Tensor* k{};
+  const lite::Tensor* v{};
+  // the parents of the beams to reorder the cache by if not nullptr.
+  const lite::Tensor* beam_idx{nullptr};
+  // the cache is reset at the step 0 if not nullptr.
+  const lite::Tensor* step{nullptr};
+  KVCache* cache{};
+};
+
+struct CachedAttentionParam : ParamBase {
+  const lite::Tensor* q{};
+  const KVCache* cache{};
+  const lite::Tensor* mask{nullptr};
+  lite::Tensor* output{};
+  float scale{1.f};
+  bool transpose_out{false};
+};
+
 // For Reshape and Reshape2 Op
 struct ReshapeParam : ParamBase {
   const lite::Tensor* x{};
@@ -281,6 +381,9 @@ struct ConcatParam : ParamBase {
   lite::Tensor* output{};
   int axis{0};
   lite::Tensor* axis_tensor{};
+  // Set by concat_split_view_pass, the inputs become views of the
+  // slices of the output when they are contiguous.
+  bool zero_copy{false};
 };
 
 /// ----------------------- activation operators ----------------------
@@ -345,6 +448,9 @@ struct SparseConvParam : ParamBase {
   std::shared_ptr<std::vector<int>> paddings;
   int groups{1};
   std::shared_ptr<std::vector<int>> dilations;
+  // only used in sparse_fc, the rows of the input are flattened from the
+  // dims before it.
+  int in_num_col_dims{1};
   // for activation
   bool fuse_relu{false};
   ActivationParam activation_param;
@@ -400,6 +506,8 @@ struct ConvParam : ParamBase {
   std::string fuse_elementwise_op_type{""};
   // support var_length or not
   bool var_length{false};
+  // the implementation selected by opt, empty for the runtime selection.
+  std::string conv_algorithm{""};
   // only used in conv_transpose.
   std::vector<int> output_size;
   std::vector<int> output_padding;
@@ -419,10 +527,28 @@ struct ConvParam : ParamBase {
 
   // for int8
   WITH_INT8_CONFIG
+  WITH_WEIGHT_ONLY_CONFIG
+  // the scale of the int8 second_x fused by the elementwise add
+  float second_x_scale{1.f};
   // for Conv2d+Scale fusion
   std::string scale_activation_type{""};
 };
 
+// A depthwise conv2d fused with the 1x1 conv2d of its output. The ConvParam
+// is the depthwise one, while output is the output of the 1x1 conv2d.
+struct DepthwisePointwiseConvParam : ConvParam {
+  lite::Tensor* pw_filter{};
+  lite::Tensor* pw_bias{nullptr};
+  ActivationParam pw_activation_param;
+};
+
+// A conv2d fused with the 2x2 stride 2 max pool2d ("max_pool2x2"), the
+// global average pooling ("global_avg_pool") or the 2x nearest interpolation
+// ("nearest_up2x") of its output, which is the output of the fused op.
+struct ConvResampleParam : ConvParam {
+  std::string resample_type{"max_pool2x2"};
+};
+
 // For BatchNorm op
 struct BatchNormParam : ParamBase {
   lite::Tensor* x{};
@@ -502,6 +628,9 @@ struct SplitParam : ParamBase {
   int axis{-1};
   int num{0};
   std::vector<int> sections;
+  // Set by concat_split_view_pass, the outputs become views of the
+  // slices of the input when they are contiguous.
+  bool zero_copy{false};
 };
 
 struct UnbindParam : ParamBase {
@@ -549,6 +678,25 @@ struct ElementwiseParam : ParamBase {
   std::string activation_type{""};
 };
 
+// A chain of elementwise and activation ops evaluated in one pass. Step i
+// reads the chain value, which is X[0] for the first step and the result of
+// step i - 1 otherwise, and the binary steps read the value operands[i] too,
+// which indexes X followed by the step results.
+struct ElementwiseChainParam : ParamBase {
+  std::vector<lite::Tensor*> X{};
+  lite::Tensor* Out{};
+  std::vector<std::string> step_types{};
+  std::vector<int> operands{};
+  // 1 if the operand is the left hand side of the step
+  std::vector<int> operand_first{};
+  std::vector<int> axes{};
+  std::vector<float> alphas{};
+  std::vector<float> betas{};
+  std::vector<float> gammas{};
+  // the dims of X padded with 1 to the rank of Out, set by InferShape
+  std::vector<std::vector<int64_t>> x_aligned_dims{};
+};
+
 struct ElementwiseGradParam : ParamBase {
   const lite::Tensor* X{};
   const lite::Tensor* Y{};
@@ -965,6 +1113,26 @@ struct LookupTableDequantParam : ParamBase {
   lite::Tensor* Ids{nullptr};
   lite::Tensor* Out{nullptr};
   int64_t padding_idx{-1};
+  // 0: the rows are [min, max, uint8 codes]
+  // 8 or 4: the rows are [scale, bias, codes] of row_width elements
+  int quant_bits{0};
+  int64_t row_width{0};
+  // append the width to the shape of Ids as lookup_table_v2
+  bool append_width{false};
+};
+
+// lookup_table or lookup_table_dequant fused with the sequence_pool of Out
+struct FusedEmbeddingSeqPoolParam : ParamBase {
+  const lite::Tensor* W{nullptr};
+  const lite::Tensor* Ids{nullptr};
+  lite::Tensor* Out{nullptr};
+  int64_t padding_idx{-1};
+  bool dequant{false};
+  // the format of the dequant table, see LookupTableDequantParam
+  int quant_bits{0};
+  int64_t row_width{0};
+  std::string pool_type{"SUM"};
+  float pad_value{0.0f};
 };
 
 struct Im2SequenceParam : ParamBase {
@@ -1000,6 +1168,14 @@ struct LayerNormParam : ParamBase {
   float epsilon{1e-5f};
 };
 
+// For FusionElementwiseAddLayerNorm op, the layer_norm of X + Residual.
+struct FusionElementwiseAddLayerNormParam : public LayerNormParam {
+  // broadcast to the rows of X if of the trailing dims of it.
+  const lite::Tensor* Residual{};
+  // the sum X + Residual, only written if used by the other ops.
+  lite::Tensor* AddOut{nullptr};
+};
+
 struct LogicalParam : ParamBase {
   const lite::Tensor* X{};
   const lite::Tensor* Y{};
@@ -1378,7 +1554,16 @@ struct MatMulParam : ParamBase {
   bool transpose_X{false};
   bool transpose_Y{false};
   float alpha{1.0f};
+  // softmax over the last axis of Out, fused by lite_matmul_softmax_fuse_pass
+  bool fuse_softmax{false};
+  // the axis of the transpose2 ops folded into X, Y and Out by
+  // lite_transpose_matmul_fuse_pass, empty if none; the matmul then reads X
+  // and Y and writes Out through them, as strided views
+  std::vector<int> fused_transpose_X;
+  std::vector<int> fused_transpose_Y;
+  std::vector<int> fused_transpose_Out;
   WITH_INT8_CONFIG
+  WITH_WEIGHT_ONLY_CONFIG
 };
 
 struct GatherNdParam : ParamBase {
@@ -1579,6 +1764,29 @@ struct DistributeFpnProposalsParam : ParamBase {
   bool pixel_offset{true};
 };
 
+// The distribute_fpn_proposals of FpnRois and the roi_align of the levels
+// of X, fused by lite_distribute_fpn_roi_align_fuse_pass. X[i] is the
+// feature map of the level min_level + i, and Out is in the order of
+// FpnRois.
+struct DistributeFpnRoiAlignParam : ParamBase {
+  std::vector<lite::Tensor*> X{};
+  const lite::Tensor* FpnRois{};
+  const lite::Tensor* RoisNum{};
+  lite::Tensor* Out{};
+
+  int min_level{};
+  int max_level{};
+  int refer_level{};
+  int refer_scale{};
+  bool pixel_offset{true};
+
+  std::vector<float> spatial_scales{};
+  int pooled_height{1};
+  int pooled_width{1};
+  int sampling_ratio{-1};
+  bool aligned{false};
+};
+
 /// --------------------- instance_norm operators --------------------
 struct InstanceNormParam : ParamBase {
   lite::Tensor* x{};
@@ -0,0 +1,110 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/pack_sequence_op.h"
+#include <algorithm>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+static int64_t SequenceLength(const Tensor* seq_len, int64_t i) {
+  return seq_len->precision() == PRECISION(kInt32)
+             ? seq_len->data<int32_t>()[i]
+             : seq_len->data<int64_t>()[i];
+}
+
+bool PackSequenceOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.x);
+  CHECK_OR_FALSE(param_.seq_len);
+  CHECK_OR_FALSE(param_.out);
+  CHECK_OR_FALSE(param_.cu_seqlens);
+  CHECK_GE_OR_FALSE(param_.x->dims().size(), 2UL);
+  CHECK_EQ_OR_FALSE(param_.seq_len->numel(), param_.x->dims()[0]);
+  return true;
+}
+
+bool PackSequenceOp::InferShapeImpl() const {
+  const auto& x_dims = param_.x->dims();
+  int64_t total = 0;
+  for (int64_t i = 0; i < x_dims[0]; i++) {
+    int64_t len = SequenceLength(param_.seq_len, i);
+    total += std::max<int64_t>(0, std::min(len, x_dims[1]));
+  }
+  std::vector<int64_t> out_dims{total};
+  for (size_t i = 2; i < x_dims.size(); i++) out_dims.push_back(x_dims[i]);
+  param_.out->Resize(out_dims);
+  param_.cu_seqlens->Resize({x_dims[0] + 1});
+  return true;
+}
+
+bool PackSequenceOp::AttachImpl(const cpp::OpDesc& op_desc,
+                                lite::Scope* scope) {
+  param_.x = scope->FindVar(op_desc.Input("X").front())->GetMutable<Tensor>();
+  param_.seq_len =
+      scope->FindVar(op_desc.Input("SeqLen").front())->GetMutable<Tensor>();
+  param_.out =
+      scope->FindVar(op_desc.Output("Out").front())->GetMutable<Tensor>();
+  param_.cu_seqlens = scope->FindVar(op_desc.Output("CuSeqlens").front())
+                          ->GetMutable<Tensor>();
+  return true;
+}
+
+bool UnpackSequenceOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.x);
+  CHECK_OR_FALSE(param_.cu_seqlens);
+  CHECK_OR_FALSE(param_.out);
+  CHECK_GE_OR_FALSE(param_.x->dims().size(), 1UL);
+  CHECK_GE_OR_FALSE(param_.cu_seqlens->numel(), 1);
+  return true;
+}
+
+bool UnpackSequenceOp::InferShapeImpl() const {
+  const auto& x_dims = param_.x->dims();
+  const int* cu_seqlens = param_.cu_seqlens->data<int>();
+  int64_t batch = param_.cu_seqlens->numel() - 1;
+  int64_t length = param_.padded_length;
+  if (length <= 0) {
+    length = 0;
+    for (int64_t i = 0; i < batch; i++) {
+      length = std::max<int64_t>(length, cu_seqlens[i + 1] - cu_seqlens[i]);
+    }
+  }
+  std::vector<int64_t> out_dims{batch, length};
+  for (size_t i = 1; i < x_dims.size(); i++) out_dims.push_back(x_dims[i]);
+  param_.out->Resize(out_dims);
+  return true;
+}
+
+bool UnpackSequenceOp::AttachImpl(const cpp::OpDesc& op_desc,
+                                  lite::Scope* scope) {
+  param_.x = scope->FindVar(op_desc.Input("X").front())->GetMutable<Tensor>();
+  param_.cu_seqlens =
+      scope->FindVar(op_desc.Input("CuSeqlens").front())->GetMutable<Tensor>();
+  param_.out =
+      scope->FindVar(op_desc.Output("Out").front())->GetMutable<Tensor>();
+  if (op_desc.HasAttr("padded_length")) {
+    param_.padded_length = op_desc.GetAttr<int>("padded_length");
+  }
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(pack_sequence, paddle::lite::operators::PackSequenceOp);
+REGISTER_LITE_OP(unpack_sequence, paddle::lite::operators::UnpackSequenceOp);
@@ -0,0 +1,80 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <string>
+#include "lite/core/op_lite.h"
+#include "lite/core/scope.h"
+#include "lite/core/tensor.h"
+#include "lite/operators/op_params.h"
+#include "lite/utils/all.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+// Pack a batch of the sequences padded to the same length, X of [batch, seq,
+// ...], into Out of [total, ...] by their lengths SeqLen, so the row-wise ops
+// (fc, layer_norm, elementwise) and fusion_attention with CuSeqlens only
+// compute the real tokens.
+class PackSequenceOp : public OpLite {
+ public:
+  PackSequenceOp() {}
+
+  explicit PackSequenceOp(const std::string& type) : OpLite(type) {}
+
+  bool CheckShape() const override;
+
+  bool InferShapeImpl() const override;
+
+  bool ShapeDependsOnInputData() const override { return true; }
+
+  bool AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) override;
+
+  void AttachKernel(KernelBase* kernel) override { kernel->SetParam(param_); }
+
+  std::string DebugString() const override { return "pack_sequence"; }
+
+ private:
+  mutable PackSequenceParam param_;
+};
+
+// Restore the packed sequences X of [total, ...] into Out of [batch,
+// padded_length, ...] padded with zeros.
+class UnpackSequenceOp : public OpLite {
+ public:
+  UnpackSequenceOp() {}
+
+  explicit UnpackSequenceOp(const std::string& type) : OpLite(type) {}
+
+  bool CheckShape() const override;
+
+  bool InferShapeImpl() const override;
+
+  bool ShapeDependsOnInputData() const override { return true; }
+
+  bool AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) override;
+
+  void AttachKernel(KernelBase* kernel) override { kernel->SetParam(param_); }
+
+  std::string DebugString() const override { return "unpack_sequence"; }
+
+ private:
+  mutable UnpackSequenceParam param_;
+};
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
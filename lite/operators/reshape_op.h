@@ -32,7 +32,9 @@ class ReshapeOp : public OpLite {
 
   bool InferShapeImpl() const override;
 
-  bool InferShapeWithCache() const override { return true; }
+  bool ShapeDependsOnInputData() const override {
+    return !param_.shape_tensor_vct.empty() || param_.shape_tensor;
+  }
 
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
@@ -66,8 +68,6 @@ class Reshape2Op : public ReshapeOp {
 
   bool InferShapeImpl() const override;
 
-  bool InferShapeWithCache() const override { return true; }
-
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
@@ -0,0 +1,114 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/sparse_fc_op.h"
+#include <algorithm>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool SparseFcOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.x);
+  CHECK_OR_FALSE(param_.output);
+  CHECK_OR_FALSE(param_.nonzero_weights);
+  CHECK_OR_FALSE(param_.oc_nonzeros);
+  CHECK_OR_FALSE(param_.diffs);
+  CHECK_GE_OR_FALSE(param_.x->dims().size(),
+                    static_cast<size_t>(param_.in_num_col_dims + 1));
+  return true;
+}
+
+bool SparseFcOp::InferShapeImpl() const {
+  const auto& in_dims = param_.x->dims();
+  int in_num_col_dims = param_.in_num_col_dims;
+  std::vector<int64_t> output_dims(in_num_col_dims + 1);
+  for (int i = 0; i < in_num_col_dims; ++i) {
+    output_dims[i] = in_dims[i];
+  }
+  output_dims[in_num_col_dims] = param_.oc_nonzeros->dims()[0];
+  param_.output->Resize(lite::DDim(output_dims));
+  param_.output->set_lod(param_.x->lod());
+  return true;
+}
+
+bool SparseFcOp::AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) {
+  auto X = op_desc.Input("Input").front();
+  auto NonZeroWeights = op_desc.Input("NonZeroWeights").front();
+  auto OcNonZeros = op_desc.Input("OcNonZeros").front();
+  auto Diffs = op_desc.Input("Diffs").front();
+  auto Out = op_desc.Output("Out").front();
+
+  param_.x = scope->FindVar(X)->GetMutable<lite::Tensor>();
+  param_.nonzero_weights =
+      scope->FindVar(NonZeroWeights)->GetMutable<lite::Tensor>();
+  param_.oc_nonzeros = scope->FindVar(OcNonZeros)->GetMutable<lite::Tensor>();
+  param_.diffs = scope->FindVar(Diffs)->GetMutable<lite::Tensor>();
+  param_.output = scope->FindVar(Out)->GetMutable<lite::Tensor>();
+  param_.in_num_col_dims = op_desc.GetAttr<int>("in_num_col_dims");
+
+  std::vector<std::string> input_arg_names = op_desc.InputArgumentNames();
+  if (std::find(input_arg_names.begin(), input_arg_names.end(), "Bias") !=
+      input_arg_names.end()) {
+    auto bias_arguments = op_desc.Input("Bias");
+    if (bias_arguments.size() > 0) {
+      auto bias_var = scope->FindVar(bias_arguments.front());
+      if (bias_var != nullptr) {
+        param_.bias = &(bias_var->Get<lite::Tensor>());
+      }
+    }
+  }
+  if (op_desc.HasAttr("activation_type")) {
+    auto act_type = op_desc.GetAttr<std::string>("activation_type");
+    if (act_type == "relu") {
+      param_.activation_param.has_active = true;
+      param_.activation_param.active_type = lite_api::ActivationType::kRelu;
+      param_.fuse_relu = true;
+    } else if (!act_type.empty()) {
+      LOG(FATAL) << "The sparse fc only supports fuse with relu, while the "
+                    "given activation type is "
+                 << act_type;
+    }
+  }
+  if (op_desc.HasAttr("first_ic")) {
+    param_.first_ic = op_desc.GetAttr<int>("first_ic");
+  }
+  if (op_desc.HasAttr("flag_semi")) {
+    param_.flag_semi = op_desc.GetAttr<int>("flag_semi");
+  }
+
+  // For Int8
+  const OpInfo* op_info = static_cast<const OpInfo*>(&op_desc);
+  if (op_info != nullptr && op_info->HasAttr("enable_int8")) {
+    param_.enable_int8 = op_info->GetAttr<bool>("enable_int8");
+    auto input_scale_name = "Input0_scale";
+    auto weight_scale_name = "W0_scale";
+    auto out_scale_name = "Out0_scale";
+    if (op_info->HasInputScale(input_scale_name, true))
+      param_.input_scale = op_info->GetInputScale(input_scale_name, true)[0];
+    if (op_info->HasInputScale(weight_scale_name, true))
+      param_.weight_scale = op_info->GetInputScale(weight_scale_name, true);
+    if (op_info->HasOutputScale(out_scale_name, true))
+      param_.output_scale = op_info->GetOutputScale(out_scale_name, true)[0];
+  }
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(sparse_fc, paddle::lite::operators::SparseFcOp);
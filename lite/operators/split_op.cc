@@ -85,6 +85,9 @@ bool SplitOp::AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) {
   param_.axis = opdesc.GetAttr<int>("axis");
   param_.num = opdesc.GetAttr<int>("num");
   param_.sections = opdesc.GetAttr<std::vector<int>>("sections");
+  if (opdesc.HasAttr("zero_copy")) {
+    param_.zero_copy = opdesc.GetAttr<bool>("zero_copy");
+  }
 
   param_.x = scope->FindTensor(opdesc.Input("X").front());
   if (opdesc.HasInput("AxisTensor") && !opdesc.Input("AxisTensor").empty()) {
@@ -102,9 +105,7 @@ bool SplitOp::AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) {
   auto outs_name = opdesc.Output("Out");
   for (auto name : outs_name) {
     param_.output.push_back(scope->FindMutableTensor(name));
-    output_tensor_ptrs_cache_.push_back(scope->FindMutableTensor(name));
   }
-  input_tensor_ptrs_cache_.push_back(param_.x);
 
   return true;
 }
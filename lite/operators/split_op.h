@@ -32,7 +32,9 @@ class SplitOp : public OpLite {
 
   bool InferShapeImpl() const override;
 
-  bool InferShapeWithCache() const override { return true; }
+  bool ShapeDependsOnInputData() const override {
+    return param_.axis_tensor || !param_.sections_tensor_list.empty();
+  }
 
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
@@ -34,6 +34,9 @@ class SubgraphOp : public OpLite {
 
   bool InferShapeImpl() const override;
 
+  // The shapes are inferred by the subgraph engine.
+  bool InferShapeWithCache() const override { return false; }
+
   bool AttachImpl(const cpp::OpDesc &op_desc, Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
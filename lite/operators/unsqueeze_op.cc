@@ -119,8 +119,6 @@ bool UnsqueezeOp::AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) {
   if (opdesc.HasAttr("inplace")) {
     param_.inplace = opdesc.GetAttr<bool>("inplace");
   }
-  input_tensor_ptrs_cache_.push_back(param_.X);
-  output_tensor_ptrs_cache_.push_back(param_.Out);
   return true;
 }
 
@@ -32,7 +32,9 @@ class UnsqueezeOp : public OpLite {
 
   bool InferShapeImpl() const override;
 
-  bool InferShapeWithCache() const override { return true; }
+  bool ShapeDependsOnInputData() const override {
+    return param_.axes_tensor || !param_.axes_tensor_vct.empty();
+  }
 
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
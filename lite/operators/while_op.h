@@ -33,6 +33,9 @@ class WhileOp : public OpLite {
 
   bool InferShapeImpl() const override;
 
+  // The shapes of the sub block change in every iteration.
+  bool InferShapeWithCache() const override { return false; }
+
   bool AttachImpl(const cpp::OpDesc &opdesc, Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
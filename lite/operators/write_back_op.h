@@ -28,6 +28,9 @@ class WriteBackOp : public OpLite {
 
   bool InferShapeImpl() const override;
 
+  // The precision of the output is copied here as well.
+  bool InferShapeWithCache() const override { return false; }
+
   bool AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) override;
 
   void AttachKernel(KernelBase *kernel) override { kernel->SetParam(param_); }
@@ -0,0 +1,110 @@
+# Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Compare the results of the google benchmark cases against a baseline.
+
+The results are written by the benchmark binaries with
+`--benchmark_out=<file> --benchmark_out_format=json`, and the cases whose
+time increases by more than `--threshold` are reported as regressions.
+"""
+from __future__ import print_function
+import sys
+import json
+import argparse
+
+
+def get_args():
+    """Get arguments.
+
+    Returns:
+        Namespace, arguments.
+    """
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        '--baseline', required=True, help='Baseline json results.')
+    parser.add_argument(
+        '--current', required=True, help='Current json results.')
+    parser.add_argument(
+        '--threshold',
+        type=float,
+        default=0.05,
+        help='Max allowed relative time increase, 0.05 by default.')
+    parser.add_argument(
+        '--update_baseline',
+        action='store_true',
+        help='Overwrite the baseline with the current results.')
+    return parser.parse_args()
+
+
+def load_times(path):
+    """Load the real time of each benchmark case.
+
+    Args:
+        path: str, path of the json results.
+
+    Returns:
+        dict, the case name to (time, time_unit).
+    """
+    with open(path) as f:
+        results = json.load(f)
+    times = {}
+    for case in results['benchmarks']:
+        # Only the means are compared if the cases are repeated.
+        if case.get('run_type') == 'aggregate' and \
+                case.get('aggregate_name') != 'mean':
+            continue
+        name = case.get('run_name', case['name'])
+        times[name] = (case['real_time'], case['time_unit'])
+    return times
+
+
+def main():
+    args = get_args()
+    baseline = load_times(args.baseline)
+    current = load_times(args.current)
+
+    regressions = []
+    print('%-80s %12s %12s %8s' % ('case', 'baseline', 'current', 'diff'))
+    for name in sorted(current):
+        time, unit = current[name]
+        if name not in baseline:
+            print('%-80s %12s %10.3f%s %8s' % (name, '-', time, unit, 'new'))
+            continue
+        base_time, base_unit = baseline[name]
+        if base_unit != unit or base_time <= 0:
+            continue
+        diff = time / base_time - 1
+        flag = ''
+        if diff > args.threshold:
+            flag = ' <- regression'
+            regressions.append(name)
+        print('%-80s %10.3f%s %10.3f%s %+7.1f%%%s' %
+              (name, base_time, unit, time, unit, diff * 100, flag))
+    for name in sorted(set(baseline) - set(current)):
+        print('%-80s %10.3f%s %12s %8s' %
+              (name, baseline[name][0], baseline[name][1], '-', 'missing'))
+
+    if args.update_baseline:
+        with open(args.current) as src, open(args.baseline, 'w') as dst:
+            dst.write(src.read())
+        print('Baseline %s is updated.' % args.baseline)
+        return 0
+    if regressions:
+        print('%d of %d cases regress by more than %.1f%%.' %
+              (len(regressions), len(current), args.threshold * 100))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
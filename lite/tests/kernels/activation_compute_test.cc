@@ -15,8 +15,10 @@
 #include <gtest/gtest.h>
 #include <cmath>
 #include <string>
+#include <utility>
 #include "lite/api/paddle_use_kernels.h"
 #include "lite/api/paddle_use_ops.h"
+#include "lite/core/fast_math.h"
 #include "lite/core/test/arena/framework.h"
 #include "lite/tests/utils/fill_data.h"
 
@@ -1022,6 +1024,42 @@ TEST(Activation_gelu, precision) {
   }
 }
 
+TEST(Activation_fast_math, precision) {
+  Place place;
+  float abs_error = 2e-5;
+#if defined(LITE_WITH_NNADAPTER) || defined(LITE_WITH_NPU)
+  return;
+#elif defined(LITE_WITH_ARM)
+  place = TARGET(kARM);
+#elif defined(LITE_WITH_X86)
+  place = TARGET(kX86);
+#else
+  return;
+#endif
+
+  FastMath::Scope fast_math_scope(true);
+  for (auto dims : std::vector<std::vector<int64_t>>{
+           {1, 3, 2, 4}, {2, 3, 4, 5}, {37}}) {
+    for (auto act : std::vector<std::pair<std::string, activation_type_test>>{
+             {"sigmoid", SIGMOID},
+             {"tanh", TANH},
+             {"swish", SWISH},
+             {"gelu", GELU}}) {
+      TestAct(place,
+              "def",
+              0.01,
+              6.,
+              "all",
+              1.5,
+              1.0,
+              DDim(dims),
+              act.first,
+              act.second,
+              abs_error);
+    }
+  }
+}
+
 TEST(Activation_mish, precision) {
   Place place;
   float abs_error = 2e-5;
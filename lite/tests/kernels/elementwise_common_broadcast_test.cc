@@ -327,6 +327,14 @@ TEST(elementwise_broadcast, compute_fp32) {
         TARGET(kARM), "def", "div", "", [](float l, float r) {
           return l / r;
         }));
+    EXPECT_TRUE(paddle::lite::RunOnRandomArgs<float>(
+        TARGET(kARM), "def", "max", "", [](float l, float r) {
+          return l > r ? l : r;
+        }));
+    EXPECT_TRUE(paddle::lite::RunOnRandomArgs<float>(
+        TARGET(kARM), "def", "min", "", [](float l, float r) {
+          return l < r ? l : r;
+        }));
   }
 }
 
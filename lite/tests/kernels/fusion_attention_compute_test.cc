@@ -0,0 +1,190 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/test/arena/framework.h"
+#include "lite/tests/utils/fill_data.h"
+
+namespace paddle {
+namespace lite {
+
+class FusionAttentionComputeTest : public arena::TestCase {
+ protected:
+  std::string q_ = "q";
+  std::string k_ = "k";
+  std::string v_ = "v";
+  std::string mask_ = "mask";
+  std::string out_ = "out";
+  // [batch, head, seq_q, dim], [batch, head, seq_k, dim] and
+  // [batch, head, seq_k, dim_v].
+  DDim q_dims_;
+  DDim k_dims_;
+  DDim v_dims_;
+  // [seq_q, seq_k] broadcast to the scores, none if empty.
+  std::vector<float> mask_data_;
+  float scale_{1.f};
+  bool transpose_out_{false};
+
+ public:
+  FusionAttentionComputeTest(const Place& place,
+                             const std::string& alias,
+                             int64_t seq_q,
+                             int64_t seq_k,
+                             const std::vector<float>& mask_data,
+                             float scale,
+                             bool transpose_out)
+      : TestCase(place, alias),
+        q_dims_({2, 3, seq_q, 16}),
+        k_dims_({2, 3, seq_k, 16}),
+        v_dims_({2, 3, seq_k, 12}),
+        mask_data_(mask_data),
+        scale_(scale),
+        transpose_out_(transpose_out) {}
+
+  void RunBaseline(Scope* scope) override {
+    auto* q = scope->FindTensor(q_)->data<float>();
+    auto* k = scope->FindTensor(k_)->data<float>();
+    auto* v = scope->FindTensor(v_)->data<float>();
+    int64_t heads = q_dims_[0] * q_dims_[1];
+    int64_t seq_q = q_dims_[2];
+    int64_t seq_k = k_dims_[2];
+    int64_t dim = q_dims_[3];
+    int64_t dim_v = v_dims_[3];
+    auto* out = scope->NewTensor(out_);
+    if (transpose_out_) {
+      out->Resize({q_dims_[0], seq_q, q_dims_[1], dim_v});
+    } else {
+      out->Resize({q_dims_[0], q_dims_[1], seq_q, dim_v});
+    }
+    auto* out_data = out->mutable_data<float>();
+    std::vector<float> scores(seq_k);
+    for (int64_t h = 0; h < heads; h++) {
+      for (int64_t i = 0; i < seq_q; i++) {
+        const float* q_row = q + (h * seq_q + i) * dim;
+        float max_val = -std::numeric_limits<float>::infinity();
+        for (int64_t j = 0; j < seq_k; j++) {
+          const float* k_row = k + (h * seq_k + j) * dim;
+          float dot = 0.f;
+          for (int64_t c = 0; c < dim; c++) dot += q_row[c] * k_row[c];
+          scores[j] = dot * scale_;
+          if (!mask_data_.empty()) scores[j] += mask_data_[i * seq_k + j];
+          max_val = std::max(max_val, scores[j]);
+        }
+        float sum = 0.f;
+        for (int64_t j = 0; j < seq_k; j++) {
+          scores[j] = std::isinf(max_val) ? 0.f : std::exp(scores[j] - max_val);
+          sum += scores[j];
+        }
+        int64_t b = h / q_dims_[1];
+        int64_t n = h % q_dims_[1];
+        float* out_row =
+            transpose_out_
+                ? out_data + ((b * seq_q + i) * q_dims_[1] + n) * dim_v
+                : out_data + (h * seq_q + i) * dim_v;
+        for (int64_t c = 0; c < dim_v; c++) {
+          float acc = 0.f;
+          for (int64_t j = 0; j < seq_k; j++) {
+            acc += scores[j] * v[(h * seq_k + j) * dim_v + c];
+          }
+          // The rows whose keys are all masked out are zeros.
+          out_row[c] = sum > 0.f ? acc / sum : 0.f;
+        }
+      }
+    }
+  }
+
+  void PrepareOpDesc(cpp::OpDesc* op_desc) {
+    op_desc->SetType("fusion_attention");
+    op_desc->SetInput("Q", {q_});
+    op_desc->SetInput("K", {k_});
+    op_desc->SetInput("V", {v_});
+    if (!mask_data_.empty()) op_desc->SetInput("Mask", {mask_});
+    op_desc->SetOutput("Out", {out_});
+    op_desc->SetAttr("scale", scale_);
+    op_desc->SetAttr("transpose_out", transpose_out_);
+  }
+
+  void PrepareData() override {
+    for (auto& item : std::vector<std::pair<std::string, DDim>>{
+             {q_, q_dims_}, {k_, k_dims_}, {v_, v_dims_}}) {
+      std::vector<float> data(item.second.production());
+      fill_data_rand<float>(data.data(), -1.f, 1.f, data.size());
+      SetCommonTensor(item.first, item.second, data.data());
+    }
+    if (!mask_data_.empty()) {
+      SetCommonTensor(
+          mask_, DDim({q_dims_[2], k_dims_[2]}), mask_data_.data());
+    }
+  }
+};
+
+// The mask of [seq_q, seq_k] hiding the keys after each query, with the row
+// `masked_row` hiding all of them if not negative.
+static std::vector<float> CausalMask(int64_t seq_q,
+                                     int64_t seq_k,
+                                     int64_t masked_row) {
+  std::vector<float> mask(seq_q * seq_k, 0.f);
+  float inf = std::numeric_limits<float>::infinity();
+  for (int64_t i = 0; i < seq_q; i++) {
+    for (int64_t j = 0; j < seq_k; j++) {
+      if (j > i || i == masked_row) mask[i * seq_k + j] = -inf;
+    }
+  }
+  return mask;
+}
+
+TEST(FusionAttention, precision) {
+  Place place;
+  float abs_error = 1e-4;
+#if defined(LITE_WITH_ARM)
+  place = TARGET(kARM);
+#elif defined(LITE_WITH_X86)
+  place = TARGET(kX86);
+#else
+  return;
+#endif
+
+  // The sequences shorter and longer than the blocks of the queries and the
+  // tiles of the keys.
+  for (auto seq : std::vector<std::pair<int64_t, int64_t>>{
+           {1, 1}, {5, 7}, {9, 70}, {70, 130}}) {
+    for (bool transpose_out : {false, true}) {
+      std::vector<std::vector<float>> masks{
+          {},
+          CausalMask(seq.first, seq.second, -1),
+          CausalMask(seq.first, seq.second, seq.first / 2)};
+      for (auto& mask : masks) {
+        std::unique_ptr<arena::TestCase> tester(
+            new FusionAttentionComputeTest(place,
+                                           "def",
+                                           seq.first,
+                                           seq.second,
+                                           mask,
+                                           0.25f,
+                                           transpose_out));
+        arena::Arena arena(std::move(tester), place, abs_error);
+        arena.TestPrecision();
+      }
+    }
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -21,6 +21,7 @@
 namespace paddle {
 namespace lite {
 
+template <typename T>
 class LayerNormComputeTest : public arena::TestCase {
  protected:
   // common attributes for this op.
@@ -71,10 +72,10 @@ class LayerNormComputeTest : public arena::TestCase {
     mean->Resize(std::vector<int64_t>{batch_size});
     variance->Resize(std::vector<int64_t>{batch_size});
 
-    auto* x_data = x->data<float>();
+    auto* x_data = x->template data<T>();
     auto* scale_data = (scale == nullptr ? nullptr : scale->data<float>());
     auto* bias_data = (bias == nullptr ? nullptr : bias->data<float>());
-    auto* y_data = y->mutable_data<float>();
+    auto* y_data = y->template mutable_data<T>();
     auto* mean_data = mean->mutable_data<float>();
     auto* variance_data = variance->mutable_data<float>();
 
@@ -85,8 +86,9 @@ class LayerNormComputeTest : public arena::TestCase {
       float mean_t = 0;
       float variance_t = 0;
       for (int j = start; j < end; ++j) {
-        mean_t += x_data[j];
-        variance_t += x_data[j] * x_data[j];
+        float x_j = static_cast<float>(x_data[j]);
+        mean_t += x_j;
+        variance_t += x_j * x_j;
       }
       mean_t /= feature_size;
       variance_t = variance_t / feature_size - mean_t * mean_t;
@@ -94,13 +96,14 @@ class LayerNormComputeTest : public arena::TestCase {
       variance_data[i] = variance_t;
       variance_t = sqrt(variance_t + epsilon_);
       for (int j = start; j < end; ++j) {
-        y_data[j] = (x_data[j] - mean_t) / variance_t;
+        float y_j = (static_cast<float>(x_data[j]) - mean_t) / variance_t;
         if (scale_data) {
-          y_data[j] *= scale_data[j - start];
+          y_j *= scale_data[j - start];
         }
         if (bias_data) {
-          y_data[j] += bias_data[j - start];
+          y_j += bias_data[j - start];
         }
+        y_data[j] = static_cast<T>(y_j);
       }
     }
   }
@@ -124,7 +127,8 @@ class LayerNormComputeTest : public arena::TestCase {
   void PrepareData() override {
     std::vector<float> x(dims_.production());
     fill_data_rand(x.data(), -1.f, 1.f, dims_.production());
-    SetCommonTensor(x_, dims_, x.data());
+    std::vector<T> x_t(x.begin(), x.end());
+    SetCommonTensor(x_, dims_, x_t.data());
 
     auto scale_bias_size =
         dims_.Slice(begin_norm_axis_, dims_.size()).production();
@@ -143,6 +147,26 @@ class LayerNormComputeTest : public arena::TestCase {
   }
 };
 
+template <typename T>
+void TestLayerNorm(Place place, float abs_error) {
+  for (auto dims :
+       std::vector<std::vector<int64_t>>{{2, 3, 4, 5}, {3, 4, 5}, {4, 5}}) {
+    for (auto epsilon : {1e-5f}) {
+      for (auto axis : {1, 2, 3}) {
+        for (bool has_bias : {true, false}) {
+          for (bool has_scale : {true, false}) {
+            if (axis >= dims.size()) continue;
+            std::unique_ptr<arena::TestCase> tester(new LayerNormComputeTest<T>(
+                place, "def", DDim(dims), epsilon, axis, has_bias, has_scale));
+            arena::Arena arena(std::move(tester), place, abs_error);
+            arena.TestPrecision({"mean", "variance"});
+          }
+        }
+      }
+    }
+  }
+}
+
 TEST(LayerNorm, precision) {
   LOG(INFO) << "test layer_norm op";
   float abs_error = 2e-5;
@@ -168,22 +192,11 @@ TEST(LayerNorm, precision) {
   return;
 #endif
 
-  for (auto dims :
-       std::vector<std::vector<int64_t>>{{2, 3, 4, 5}, {3, 4, 5}, {4, 5}}) {
-    for (auto epsilon : {1e-5f}) {
-      for (auto axis : {1, 2, 3}) {
-        for (bool has_bias : {true, false}) {
-          for (bool has_scale : {true, false}) {
-            if (axis >= dims.size()) continue;
-            std::unique_ptr<arena::TestCase> tester(new LayerNormComputeTest(
-                place, "def", DDim(dims), epsilon, axis, has_bias, has_scale));
-            arena::Arena arena(std::move(tester), place, abs_error);
-            arena.TestPrecision({"mean", "variance"});
-          }
-        }
-      }
-    }
-  }
+  TestLayerNorm<float>(place, abs_error);
+#if defined(LITE_WITH_ARM) && defined(ENABLE_ARM_FP16)
+  TestLayerNorm<lite_api::float16_t>(
+      Place(TARGET(kARM), PRECISION(kFP16)), 2e-2);
+#endif
 }
 
 }  // namespace lite
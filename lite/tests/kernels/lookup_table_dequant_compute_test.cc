@@ -34,6 +34,19 @@ void dequant(const unsigned char* in,
   }
 }
 
+// the rows of [scale, bias, codes], two codes in a byte for 4 bits
+void dequant_row_wise(const unsigned char* in,
+                      float* out,
+                      float scale,
+                      float bias,
+                      int emb_size,
+                      int quant_bits) {
+  for (int i = 0; i < emb_size; ++i) {
+    int code = quant_bits == 8 ? in[i] : (in[i / 2] >> (i % 2 * 4)) & 0x0F;
+    out[i] = scale * code + bias;
+  }
+}
+
 class LookupTableDequantComputeTest : public arena::TestCase {
  protected:
   // common attributes for this op.
@@ -44,17 +57,30 @@ class LookupTableDequantComputeTest : public arena::TestCase {
   DDim ids_dims_{{2, 1}};
   DDim w_dims_{{8, 4}};
   int64_t padding_idx_ = -1;
+  int quant_bits_ = 0;
+  int64_t row_width_ = 0;
+  bool append_width_ = false;
 
  public:
   LookupTableDequantComputeTest(const Place& place,
                                 const std::string& alias,
                                 const DDim& ids_dims,
                                 const DDim& w_dims,
-                                int64_t padding_idx)
+                                int64_t padding_idx,
+                                int quant_bits = 0,
+                                bool append_width = false)
       : TestCase(place, alias),
         ids_dims_(ids_dims),
         w_dims_(w_dims),
-        padding_idx_(padding_idx) {}
+        padding_idx_(padding_idx),
+        quant_bits_(quant_bits),
+        append_width_(append_width) {
+    if (quant_bits_ != 0) {
+      // w_dims[1] is the row width of the row-wise quantized table
+      row_width_ = w_dims_[1];
+      w_dims_[1] = 2 + (row_width_ * quant_bits_ + 31) / 32;
+    }
+  }
 
   void RunBaseline(Scope* scope) override {
     auto ids = scope->FindTensor(ids_);
@@ -66,14 +92,16 @@ class LookupTableDequantComputeTest : public arena::TestCase {
     CHECK(out);
 
     int ids_rank = ids_dims.size();
-    CHECK_EQ(ids_dims[ids_rank - 1], 1);
+    if (!append_width_) {
+      CHECK_EQ(ids_dims[ids_rank - 1], 1);
+    }
     CHECK_EQ(w_dims.size(), 2);
 
     std::vector<int64_t> out_dims;
-    for (int i = 0; i < ids_rank - 1; ++i) {
+    for (int i = 0; i < (append_width_ ? ids_rank : ids_rank - 1); ++i) {
       out_dims.push_back(ids_dims[i]);
     }
-    out_dims.push_back((w_dims[1] - 2) * 4);
+    out_dims.push_back(quant_bits_ != 0 ? row_width_ : (w_dims[1] - 2) * 4);
     out->Resize(out_dims);
     out->set_lod(ids->lod());
 
@@ -82,7 +110,7 @@ class LookupTableDequantComputeTest : public arena::TestCase {
     auto w_data = w->data<float>();
     auto w_rows = w_dims[0];
     auto quant_number = w_dims[1];
-    auto w_cols = (quant_number - 2) * 4;
+    auto w_cols = quant_bits_ != 0 ? row_width_ : (quant_number - 2) * 4;
     auto out_data = out->mutable_data<float>();
     int pow_2_bits = static_cast<int>(pow(2, 8));
 
@@ -99,8 +127,13 @@ class LookupTableDequantComputeTest : public arena::TestCase {
         int offset = ids_data[i] * quant_number + 2;
         const unsigned char* tensor_buf =
             reinterpret_cast<const unsigned char*>(w_data + offset);
-        dequant(
-            tensor_buf, out_data + i * w_cols, min, max, w_cols, pow_2_bits);
+        if (quant_bits_ != 0) {
+          dequant_row_wise(
+              tensor_buf, out_data + i * w_cols, min, max, w_cols, quant_bits_);
+        } else {
+          dequant(
+              tensor_buf, out_data + i * w_cols, min, max, w_cols, pow_2_bits);
+        }
       }
     }
   }
@@ -111,6 +144,11 @@ class LookupTableDequantComputeTest : public arena::TestCase {
     op_desc->SetInput("W", {w_});
     op_desc->SetOutput("Out", {out_});
     op_desc->SetAttr<int64_t>("padding_idx", padding_idx_);
+    if (quant_bits_ != 0) {
+      op_desc->SetAttr<int>("quant_bits", quant_bits_);
+      op_desc->SetAttr<int64_t>("row_width", row_width_);
+      op_desc->SetAttr<bool>("append_width", append_width_);
+    }
   }
 
   void PrepareData() override {
@@ -127,9 +165,13 @@ class LookupTableDequantComputeTest : public arena::TestCase {
 };
 
 TEST(LookupTableDequant, precision) {
-#ifdef LITE_WITH_ARM
+#if defined(LITE_WITH_ARM) || defined(LITE_WITH_X86)
   float abs_error = 2e-5;
+#ifdef LITE_WITH_ARM
   Place place = TARGET(kARM);
+#else
+  Place place = TARGET(kX86);
+#endif
   for (auto ids_dims :
        std::vector<std::vector<int64_t>>{{5, 2, 3, 1}, {2, 3, 1}, {3, 1}}) {
     for (auto w_dims :
@@ -143,6 +185,26 @@ TEST(LookupTableDequant, precision) {
       }
     }
   }
+  // the row-wise int8 and int4 tables of lookup_table and lookup_table_v2
+  for (auto ids_dims :
+       std::vector<std::vector<int64_t>>{{5, 2, 3, 1}, {2, 3, 1}, {3, 1}}) {
+    for (auto row_width : std::vector<int64_t>{3, 16, 37}) {
+      for (int quant_bits : {8, 4}) {
+        for (bool append_width : {false, true}) {
+          std::unique_ptr<arena::TestCase> tester(
+              new LookupTableDequantComputeTest(place,
+                                                "def",
+                                                DDim(ids_dims),
+                                                DDim({12, row_width}),
+                                                -1,
+                                                quant_bits,
+                                                append_width));
+          arena::Arena arena(std::move(tester), place, abs_error);
+          arena.TestPrecision();
+        }
+      }
+    }
+  }
 #endif
 }
 
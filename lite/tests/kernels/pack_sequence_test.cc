@@ -0,0 +1,142 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/test/arena/framework.h"
+#include "lite/tests/utils/fill_data.h"
+
+namespace paddle {
+namespace lite {
+
+class PackSequenceTester : public arena::TestCase {
+ protected:
+  std::string x_ = "x";
+  std::string seq_len_ = "seq_len";
+  std::string out_ = "out";
+  std::string cu_seqlens_ = "cu_seqlens";
+  DDim x_dims_{{4, 6, 3, 2}};
+  // The empty and over-long sequences are clipped.
+  std::vector<int64_t> seq_len_data_{2, 0, 6, 9};
+
+ public:
+  PackSequenceTester(const Place& place, const std::string& alias)
+      : TestCase(place, alias) {}
+
+  void RunBaseline(Scope* scope) override {
+    int64_t batch = x_dims_[0];
+    int64_t seq = x_dims_[1];
+    int64_t row = x_dims_.count(2, x_dims_.size());
+    auto* cu_seqlens = scope->NewTensor(cu_seqlens_);
+    cu_seqlens->Resize({batch + 1});
+    auto* cu_data = cu_seqlens->mutable_data<int>();
+    cu_data[0] = 0;
+    for (int64_t i = 0; i < batch; i++) {
+      cu_data[i + 1] =
+          cu_data[i] + static_cast<int>(std::min(seq_len_data_[i], seq));
+    }
+
+    auto* out = scope->NewTensor(out_);
+    out->Resize({cu_data[batch], x_dims_[2], x_dims_[3]});
+    auto* out_data = out->mutable_data<float>();
+    auto* x_data = scope->FindTensor(x_)->data<float>();
+    for (int64_t i = 0; i < batch; i++) {
+      memcpy(out_data + cu_data[i] * row,
+             x_data + i * seq * row,
+             sizeof(float) * (cu_data[i + 1] - cu_data[i]) * row);
+    }
+  }
+
+  void PrepareOpDesc(cpp::OpDesc* op_desc) {
+    op_desc->SetType("pack_sequence");
+    op_desc->SetInput("X", {x_});
+    op_desc->SetInput("SeqLen", {seq_len_});
+    op_desc->SetOutput("Out", {out_});
+    op_desc->SetOutput("CuSeqlens", {cu_seqlens_});
+  }
+
+  void PrepareData() override {
+    std::vector<float> x_data(x_dims_.production());
+    fill_data_rand<float>(x_data.data(), -10, 10, x_dims_.production());
+    SetCommonTensor(x_, x_dims_, x_data.data());
+    SetCommonTensor(seq_len_,
+                    DDim{{static_cast<int64_t>(seq_len_data_.size())}},
+                    seq_len_data_.data());
+  }
+};
+
+TEST(pack_sequence, precision) {
+  Place place;
+  float abs_error = 1e-5;
+#if defined(LITE_WITH_ARM) || defined(LITE_WITH_X86)
+  place = TARGET(kHost);
+#else
+  return;
+#endif
+
+  std::unique_ptr<arena::TestCase> tester(
+      new PackSequenceTester(place, "def"));
+  arena::Arena arena(std::move(tester), place, abs_error);
+  arena.TestPrecision();
+}
+
+// The shapes are inferred from the new lengths of the same batch, which is
+// too large for the data of the lengths to be compared by the shape cache.
+TEST(pack_sequence, infer_shape_of_new_lengths) {
+  const int64_t batch = 64;
+  Scope scope;
+  scope.Var("x")->GetMutable<Tensor>()->Resize({batch, 10, 4});
+  auto* seq_len = scope.Var("seq_len")->GetMutable<Tensor>();
+  seq_len->Resize({batch});
+  auto* out = scope.Var("out")->GetMutable<Tensor>();
+  auto* cu_seqlens = scope.Var("cu_seqlens")->GetMutable<Tensor>();
+  cu_seqlens->Resize({batch + 1});
+  auto* packed = scope.Var("packed")->GetMutable<Tensor>();
+
+  cpp::OpDesc pack_desc;
+  pack_desc.SetType("pack_sequence");
+  pack_desc.SetInput("X", {"x"});
+  pack_desc.SetInput("SeqLen", {"seq_len"});
+  pack_desc.SetOutput("Out", {"out"});
+  pack_desc.SetOutput("CuSeqlens", {"cu_seqlens"});
+  auto pack = LiteOpRegistry::Global().Create("pack_sequence");
+  pack->Attach(pack_desc, &scope);
+
+  cpp::OpDesc unpack_desc;
+  unpack_desc.SetType("unpack_sequence");
+  unpack_desc.SetInput("X", {"out"});
+  unpack_desc.SetInput("CuSeqlens", {"cu_seqlens"});
+  unpack_desc.SetOutput("Out", {"packed"});
+  auto unpack = LiteOpRegistry::Global().Create("unpack_sequence");
+  unpack->Attach(unpack_desc, &scope);
+
+  for (int64_t len : {5, 10, 3}) {
+    auto* seq_len_data = seq_len->mutable_data<int64_t>();
+    auto* cu_data = cu_seqlens->mutable_data<int>();
+    cu_data[0] = 0;
+    for (int64_t i = 0; i < batch; i++) {
+      seq_len_data[i] = len;
+      cu_data[i + 1] = cu_data[i] + static_cast<int>(len);
+    }
+    ASSERT_TRUE(pack->InferShape());
+    EXPECT_EQ(out->dims(), DDim(std::vector<int64_t>({batch * len, 4})));
+    ASSERT_TRUE(unpack->InferShape());
+    EXPECT_EQ(packed->dims(), DDim(std::vector<int64_t>({batch, len, 4})));
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
 #include "lite/api/paddle_use_kernels.h"
 #include "lite/api/paddle_use_ops.h"
 #include "lite/core/test/arena/framework.h"
@@ -188,6 +190,36 @@ void reduce_sum_hw(const float* src,
   reduce_sum_w(tmp_out, dst, num_in, channel_in, 1, width_in);
 }
 
+void reduce_sum_any(const float* src,
+                    float* dst,
+                    const DDim& x_dims,
+                    const std::vector<int>& dim) {
+  int rank = x_dims.size();
+  std::vector<bool> reduced(rank, false);
+  for (int d : dim) {
+    reduced[d] = true;
+  }
+  int64_t out_size = 1;
+  for (int k = 0; k < rank; k++) {
+    out_size *= reduced[k] ? 1 : x_dims[k];
+  }
+  std::fill(dst, dst + out_size, 0.f);
+  for (int64_t i = 0; i < x_dims.production(); i++) {
+    int64_t rem = i;
+    int64_t out_idx = 0;
+    int64_t stride = 1;
+    for (int k = rank - 1; k >= 0; k--) {
+      int64_t idx = rem % x_dims[k];
+      rem /= x_dims[k];
+      if (!reduced[k]) {
+        out_idx += idx * stride;
+        stride *= x_dims[k];
+      }
+    }
+    dst[out_idx] += src[i];
+  }
+}
+
 class ReduceSumComputeTester : public arena::TestCase {
  protected:
   // common attributes for this op.
@@ -287,8 +319,10 @@ class ReduceSumComputeTester : public arena::TestCase {
       } else if (dim_[0] == 2 && dim_[1] == 3) {
         reduce_sum_hw(x_data, out_data, in_n, in_c, in_h, in_w);
       } else {
-        LOG(FATAL) << "invalid dims_!!";
+        reduce_sum_any(x_data, out_data, x_dims_, dim_);
       }
+    } else {
+      reduce_sum_any(x_data, out_data, x_dims_, dim_);
     }
   }
 
@@ -370,5 +404,20 @@ TEST(ReduceSum, precision) {
   test_reduce_sum(place, abs_error, keep_dim_vec);
 }
 
+TEST(ReduceSum, multi_axis) {
+#if defined(LITE_WITH_ARM) && !defined(LITE_WITH_NNADAPTER)
+  Place place = TARGET(kARM);
+  for (auto dim : std::vector<std::vector<int>>{
+           {0, 2}, {1, 3}, {0, 1, 3}, {0, 2, 3}, {0, 1, 2, 3}}) {
+    for (bool keep_dim : {false, true}) {
+      std::unique_ptr<arena::TestCase> tester(new ReduceSumComputeTester(
+          place, "def", dim, keep_dim, false, DDim({2, 3, 4, 5})));
+      arena::Arena arena(std::move(tester), place, 2e-5);
+      arena.TestPrecision();
+    }
+  }
+#endif
+}
+
 }  // namespace lite
 }  // namespace paddle
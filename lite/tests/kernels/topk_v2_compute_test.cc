@@ -137,6 +137,16 @@ void test_topk_v2(Place place, float abs_error) {
       }
     }
   }
+#if !defined(LITE_WITH_NNADAPTER)
+  // the long rows selected by chunks
+  for (auto x_shape :
+       std::vector<std::vector<int64_t>>{{2, 40000}, {40000, 2}}) {
+    std::unique_ptr<arena::TestCase> tester(new TopkV2ComputeTester<T1, T2>(
+        place, "def", DDim(x_shape), x_shape[0] == 2 ? -1 : 0, 10));
+    arena::Arena arena(std::move(tester), place, abs_error);
+    arena.TestPrecision();
+  }
+#endif
 }
 
 TEST(Topk, precision) {
@@ -215,6 +215,19 @@ void TestTranspose4D(Place place, float abs_error) {
   }
 }
 
+void TestTranspose5D(Place place, float abs_error) {
+  // the odd sizes leave the tile and register block tails
+  DDim x_dims{{2, 9, 1, 37, 6}};
+  std::vector<std::vector<int>> axes{
+      {0, 3, 1, 4, 2}, {4, 3, 2, 1, 0}, {0, 2, 3, 1, 4}, {1, 0, 4, 2, 3}};
+  for (auto axis : axes) {
+    std::unique_ptr<arena::TestCase> tester(
+        new TransposeComputeTester(place, "def", x_dims, axis));
+    arena::Arena arena(std::move(tester), place, abs_error);
+    arena.TestPrecision({"xshape"});
+  }
+}
+
 TEST(Transpose, precision) {
   float abs_error = 2e-5;
   Place place;
@@ -239,6 +252,10 @@ TEST(Transpose, precision) {
   TestTranspose2D(place, abs_error);
   TestTranspose3D(place, abs_error);
   TestTranspose4D(place, abs_error);
+#if defined(LITE_WITH_ARM) && !defined(LITE_WITH_NNADAPTER) && \
+    !defined(LITE_WITH_NPU)
+  TestTranspose5D(place, abs_error);
+#endif
 }
 
 }  // namespace lite
@@ -515,6 +515,42 @@ TEST(TestConvRand, test_conv_rand) {
 }
 #endif  /// random param conv
 
+#if 1  /// large kernel conv
+TEST(TestConvLargeKernel, test_conv_large_kernel) {
+  if (FLAGS_basic_test) {
+    // the im2col of the large inputs exceeds the cache, and is computed by
+    // the bands of output rows
+    for (auto& cin : {3, 32}) {
+      for (auto& cout : {1, 8}) {
+        for (auto& k : {5, 7}) {
+          for (auto& stride : {1, 2}) {
+            for (auto& flag_bias : {false, true}) {
+              std::vector<DDim> dims;
+              DDim weights_dim({cout, cin, k, k});
+              for (auto& h : {15, 112}) {
+                dims.push_back(DDim({1, cin, h, h}));
+              }
+              const float leakey_relu_scale = 8.88;
+              test_conv_fp32(dims,
+                             weights_dim,
+                             1,
+                             {stride, stride},
+                             {k / 2, k / 2, k / 2, k / 2},
+                             {1, 1},
+                             flag_bias,
+                             1,
+                             {4},
+                             {FLAGS_power_mode},
+                             leakey_relu_scale);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+#endif  /// large kernel conv
+
 #if 1  /// custom
 TEST(TestConvCustom, test_conv_fp32_custom_size) {
   LOG(INFO) << "test";
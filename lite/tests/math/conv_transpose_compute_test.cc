@@ -550,6 +550,41 @@ TEST(TestConvRand, test_conv_transpose_rand) {
   }
 }
 #endif  /// random param conv
+
+// the decoder shapes computed by the sub-pixel convs
+TEST(TestConvRand, test_conv_transpose_subpixel) {
+  if (FLAGS_basic_test) {
+    for (auto& cin : {3, 16}) {
+      for (auto& cout : {5, 16}) {
+        for (auto& k : {2, 3, 4}) {
+          for (auto& stride : {2, 3}) {
+            for (auto& pad : {0, 1}) {
+              for (auto& flag_bias : {false, true}) {
+                if (k < stride) {
+                  continue;
+                }
+                std::vector<DDim> dims;
+                for (auto& h : {1, 7, 16}) {
+                  dims.push_back(DDim({2, cin, h, h + 1}));
+                }
+                test_conv_transpose_fp32(dims,
+                                         DDim({cin, cout, k, k}),
+                                         1,
+                                         {stride, stride},
+                                         {pad, pad, pad, pad},
+                                         {1, 1},
+                                         flag_bias,
+                                         flag_bias,
+                                         {1, 4},
+                                         {FLAGS_power_mode});
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
 #ifdef ENABLE_ARM_FP16
 TEST(TestConvRand, test_conv_transpose_fp16_rand) {
   if (FLAGS_basic_test) {
@@ -0,0 +1,273 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "lite/tests/utils/fill_data.h"
+#ifdef LITE_WITH_ARM
+#include "lite/backends/arm/math/bf16/funcs_bf16.h"
+#endif  // LITE_WITH_ARM
+#include "lite/core/context.h"
+#include "lite/core/profile/timer.h"
+#include "lite/core/tensor.h"
+#include "lite/operators/op_params.h"
+
+typedef paddle::lite::Tensor Tensor;
+typedef paddle::lite::operators::ActivationParam ActivationParam;
+using paddle::lite::profile::Timer;
+
+DEFINE_int32(power_mode,
+             3,
+             "power mode: "
+             "0 for POWER_HIGH;"
+             "1 for POWER_LOW;"
+             "2 for POWER_FULL;"
+             "3 for NO_BIND");
+DEFINE_int32(threads, 1, "threads num");
+DEFINE_int32(warmup, 0, "warmup times");
+DEFINE_int32(repeats, 1, "repeats times");
+
+DEFINE_bool(basic_test, true, "do all tests");
+DEFINE_bool(check_result, true, "check the result");
+
+DEFINE_int32(M, 512, "gemm: M");
+DEFINE_int32(N, 512, "gemm: N");
+DEFINE_int32(K, 512, "gemm: K");
+
+DEFINE_bool(traA, false, "gemm: A transpose");
+DEFINE_bool(traB, false, "gemm: B transpose");
+DEFINE_bool(weights_b, false, "gemm: B is the packed weights");
+
+DEFINE_bool(flag_relu, false, "do relu");
+DEFINE_bool(flag_bias, false, "with bias");
+
+#ifdef LITE_WITH_ARM
+namespace bf16 = paddle::lite::arm::math::bf16;
+
+// Round the fp32 data to bf16, the reference is computed by the rounded data.
+void round_to_bf16(float* data, int size) {
+  for (int i = 0; i < size; i++) {
+    data[i] = bf16::bf16_to_fp32(bf16::fp32_to_bf16(data[i]));
+  }
+}
+#endif
+
+// C = A * B + bias, the bias is of the rows of C, or of the cols if
+// `weights_b`, the same as gemm_prepack_bf16 and gemm_prepack_b_bf16.
+bool test_gemm_bf16(bool tra,
+                    bool trb,
+                    bool weights_b,
+                    int m,
+                    int n,
+                    int k,
+                    bool has_bias,
+                    bool has_relu,
+                    int cls,
+                    int ths) {
+#ifdef LITE_WITH_ARM
+  std::vector<float> a(m * k);
+  std::vector<float> b(k * n);
+  std::vector<float> bias(weights_b ? n : m);
+  std::vector<float> c(m * n);
+  std::vector<float> c_basic(m * n);
+  fill_data_rand<float>(a.data(), -1.f, 1.f, a.size());
+  fill_data_rand<float>(b.data(), -1.f, 1.f, b.size());
+  fill_data_rand<float>(bias.data(), -1.f, 1.f, bias.size());
+  round_to_bf16(a.data(), a.size());
+  round_to_bf16(b.data(), b.size());
+
+  LOG(INFO) << "bf16 gemm M: " << m << ", N: " << n << ", K: " << k
+            << ", transA: " << (tra ? "true" : "false")
+            << ", transB: " << (trb ? "true" : "false")
+            << ", weights B: " << (weights_b ? "true" : "false")
+            << ", relu: " << (has_relu ? "true" : "false")
+            << ", bias: " << (has_bias ? "true" : "false");
+  if (FLAGS_check_result) {
+    for (int i = 0; i < m; i++) {
+      for (int j = 0; j < n; j++) {
+        float sum = 0.f;
+        for (int s = 0; s < k; s++) {
+          float va = tra ? a[s * m + i] : a[i * k + s];
+          float vb = trb ? b[j * k + s] : b[s * n + j];
+          sum += va * vb;
+        }
+        if (has_bias) sum += weights_b ? bias[j] : bias[i];
+        if (has_relu) sum = std::max(sum, 0.f);
+        c_basic[i * n + j] = sum;
+      }
+    }
+  }
+
+  std::unique_ptr<paddle::lite::KernelContext> ctx1(
+      new paddle::lite::KernelContext);
+  auto& ctx = ctx1->As<paddle::lite::ARMContext>();
+  ctx.SetRunMode(static_cast<paddle::lite_api::PowerMode>(cls), ths);
+  ActivationParam act_param;
+  if (has_relu) {
+    act_param.has_active = true;
+    act_param.active_type = paddle::lite_api::ActivationType::kRelu;
+  }
+  //! prepack the weights, A of M x K, or B of K x N
+  Tensor tpacked;
+  std::vector<uint16_t> w(weights_b ? b.size() : a.size());
+  if (weights_b) {
+    bf16::fp32_to_bf16(b.data(), w.data(), w.size());
+    tpacked.Resize({bf16::get_packed_size_bf16(n, k)});
+    bf16::prepackA_bf16(tpacked.mutable_data<uint16_t>(),
+                        w.data(),
+                        trb ? k : n,
+                        0,
+                        n,
+                        0,
+                        k,
+                        !trb);
+  } else {
+    bf16::fp32_to_bf16(a.data(), w.data(), w.size());
+    tpacked.Resize({bf16::get_packed_size_bf16(m, k)});
+    bf16::prepackA_bf16(tpacked.mutable_data<uint16_t>(),
+                        w.data(),
+                        tra ? m : k,
+                        0,
+                        m,
+                        0,
+                        k,
+                        tra);
+  }
+  auto run = [&] {
+    if (weights_b) {
+      bf16::gemm_prepack_b_bf16(a.data(),
+                                tpacked.data<uint16_t>(),
+                                bias.data(),
+                                c.data(),
+                                m,
+                                n,
+                                k,
+                                has_bias,
+                                tra,
+                                act_param,
+                                &ctx);
+    } else {
+      bf16::gemm_prepack_bf16(tpacked.data<uint16_t>(),
+                              b.data(),
+                              bias.data(),
+                              c.data(),
+                              m,
+                              n,
+                              k,
+                              has_bias,
+                              trb,
+                              act_param,
+                              &ctx);
+    }
+  };
+  for (int j = 0; j < FLAGS_warmup; ++j) run();
+  Timer t0;
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    t0.Start();
+    run();
+    t0.Stop();
+  }
+  double ops = 2.0 * m * n * k;
+  LOG(INFO) << "M: " << m << ", N: " << n << ", K: " << k
+            << ", power_mode: " << cls << ", threads: " << ths
+            << ", has_bf16: " << ctx.has_bf16()
+            << ", avg time: " << t0.LapTimes().Avg()
+            << " ms, min time: " << t0.LapTimes().Min()
+            << " ms, mean GOPs: " << ops * 1e-6f / t0.LapTimes().Avg()
+            << " GOPs";
+  if (FLAGS_check_result) {
+    for (int i = 0; i < m * n; i++) {
+      // B of gemm_prepack_bf16 and A of gemm_prepack_b_bf16 are rounded
+      // already, so only the order of the sums differs.
+      float diff = std::fabs(c[i] - c_basic[i]);
+      if (diff > 1e-3f && diff / std::fabs(c_basic[i]) > 1e-3f) {
+        LOG(ERROR) << "bf16 gemm failed at " << i << ", basic: " << c_basic[i]
+                   << ", result: " << c[i];
+        return false;
+      }
+    }
+  }
+#endif
+  return true;
+}
+
+TEST(TestGemmBF16, test_func_gemm_bf16) {
+  if (FLAGS_basic_test) {
+#ifdef LITE_WITH_ARM
+    paddle::lite::DeviceInfo::Init();
+#endif
+    for (auto& m : {1, 3, 8, 33, 127}) {
+      for (auto& n : {1, 7, 16, 141, 256}) {
+        for (auto& k : {1, 3, 8, 59, 234}) {
+          for (auto& tra : {false, true}) {
+            for (auto& trb : {false, true}) {
+              for (auto& weights_b : {false, true}) {
+                for (auto& has_bias : {false, true}) {
+                  for (auto& has_relu : {false, true}) {
+                    auto flag = test_gemm_bf16(tra,
+                                               trb,
+                                               weights_b,
+                                               m,
+                                               n,
+                                               k,
+                                               has_bias,
+                                               has_relu,
+                                               FLAGS_power_mode,
+                                               FLAGS_threads);
+                    if (!flag) {
+                      LOG(FATAL) << "test m = " << m << ", n=" << n
+                                 << ", k=" << k << ", trans A: " << tra
+                                 << ", trans B: " << trb
+                                 << ", weights B: " << weights_b
+                                 << ", bias: " << has_bias
+                                 << ", relu: " << has_relu << " failed!!";
+                    }
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(TestGemmBF16Custom, test_func_gemm_bf16_custom) {
+#ifdef LITE_WITH_ARM
+  paddle::lite::DeviceInfo::Init();
+#endif
+  auto flag = test_gemm_bf16(FLAGS_traA,
+                             FLAGS_traB,
+                             FLAGS_weights_b,
+                             FLAGS_M,
+                             FLAGS_N,
+                             FLAGS_K,
+                             FLAGS_flag_bias,
+                             FLAGS_flag_relu,
+                             FLAGS_power_mode,
+                             FLAGS_threads);
+  if (!flag) {
+    LOG(FATAL) << "test m = " << FLAGS_M << ", n=" << FLAGS_N
+               << ", k=" << FLAGS_K << ", trans A: " << FLAGS_traA
+               << ", trans B: " << FLAGS_traB << ", bias: " << FLAGS_flag_bias
+               << ", relu: " << FLAGS_flag_relu << " failed!!";
+  }
+  LOG(INFO) << "test m = " << FLAGS_M << ", n=" << FLAGS_N << ", k=" << FLAGS_K
+            << ", trans A: " << FLAGS_traA << ", trans B: " << FLAGS_traB
+            << ", bias: " << FLAGS_flag_bias << ", relu: " << FLAGS_flag_relu
+            << " passed!!";
+}
@@ -193,7 +193,8 @@ bool test_gemm_int8(bool tra,
   Tensor tpackedA;
   int hblock = paddle::lite::arm::math::get_hblock_int8(&ctx);
   int round_up_a = ((hblock + m - 1) / hblock) * hblock;
-  int round_up_k = 4 * ((k + 3) / 4);
+  int kblock = paddle::lite::arm::math::get_kblock_int8(&ctx);
+  int round_up_k = kblock * ((k + kblock - 1) / kblock);
   tpackedA.Resize({round_up_a * round_up_k});
   auto prepack_data = tpackedA.data<int8_t>();
 
@@ -243,6 +243,51 @@ bool test_gemv_int8(bool tra,
             << " GOPs, max GOPs: " << ops * 1e-6f / t0.LapTimes().Min()
             << " GOPs";
 
+  /// the packed weights with sdot, exactly the same as gemv_int8
+  if (paddle::lite::arm::math::gemv_int8_packed_enabled(&ctx)) {
+    Tensor ta_packed;
+    Tensor tc_packed_fp32;
+    Tensor tc_packed_int8;
+    ta_packed.Resize(
+        {paddle::lite::arm::math::gemv_packed_size_int8_sdot(m, n)});
+    tc_packed_fp32.Resize({m});
+    tc_packed_int8.Resize({m});
+    auto da_packed = ta_packed.mutable_data<int8_t>();
+    paddle::lite::arm::math::gemv_prepack_int8_sdot(da, da_packed, m, n);
+    paddle::lite::arm::math::gemv_int8_packed(
+        da_packed,
+        db,
+        tc_packed_fp32.mutable_data<float>(),
+        m,
+        n,
+        scale_merge_fp32.data(),
+        has_bias,
+        dbias,
+        act_param,
+        &ctx);
+    paddle::lite::arm::math::gemv_int8_packed(
+        da_packed,
+        db,
+        tc_packed_int8.mutable_data<int8_t>(),
+        m,
+        n,
+        scale_merge_int8.data(),
+        has_bias,
+        dbias_int8,
+        act_param,
+        &ctx);
+    auto dc_packed_fp32 = tc_packed_fp32.data<float>();
+    auto dc_packed_int8 = tc_packed_int8.data<int8_t>();
+    for (int i = 0; i < m; ++i) {
+      if (dc_packed_fp32[i] != dc_fp32[i] ||
+          dc_packed_int8[i] != dc_int8[i]) {
+        LOG(ERROR) << "packed gemv_int8 diff at " << i << ": "
+                   << dc_packed_fp32[i] << " vs " << dc_fp32[i];
+        return false;
+      }
+    }
+  }
+
   if (FLAGS_check_result) {
     double max_ratio = 0;
     double max_diff = 0;
@@ -58,6 +58,10 @@ NNADAPTER_WITH_GOOGLE_XNNPACK=OFF
 NNADAPTER_GOOGLE_XNNPACK_SRC_GIT_TAG="master"
 # options of compiling OPENCL lib.
 WITH_OPENCL=OFF
+# options of compiling VULKAN lib, the shaders are compiled by glslc, which is
+# shipped in $NDK_ROOT/shader-tools.
+WITH_VULKAN=OFF
+GLSLC=""
 # options of adding training ops
 WITH_TRAIN=OFF
 # option of time profile, default is OFF
@@ -148,6 +152,21 @@ function prepare_opencl_source_code {
     python $root_dir/lite/tools/cmake_tools/gen_opencl_code.py $OPENCL_KERNELS_PATH $GEN_CODE_PATH_OPENCL/opencl_kernels_source.cc
 }
 
+# 3.2.1 prepare source code of vulkan lib
+# here we compile all glsl compute shaders into SPIR-V and bundle them into a cc file
+function prepare_vulkan_source_code {
+    local root_dir=$1
+    local glslc=$GLSLC
+    if [ -z "$glslc" ]; then
+        glslc=$(ls $NDK_ROOT/shader-tools/*/glslc 2>/dev/null | head -n 1)
+    fi
+    if [ ! -x "$glslc" ]; then
+        echo "Error: glslc is required to compile the vulkan shaders, set it by --glslc or NDK_ROOT."
+        exit 1
+    fi
+    python $root_dir/lite/tools/cmake_tools/gen_vulkan_code.py $root_dir/lite/backends/vulkan/glsl $glslc $root_dir/lite/backends/vulkan/vulkan_shaders_source.cc
+}
+
 # 3.3 prepare third_party libraries for compiling
 # here we store third_party libraries into Paddle-Lite/third-party
 function prepare_thirdparty {
@@ -213,6 +232,9 @@ function make_tiny_publish_so {
   if [ "${WITH_OPENCL}" == "ON" ]; then
       prepare_opencl_source_code $workspace $build_dir
   fi
+  if [ "${WITH_VULKAN}" == "ON" ]; then
+      prepare_vulkan_source_code $workspace
+  fi
 
   # Step3. apply cmake to generate makefiles.
   if [ "${WITH_STRIP}" == "ON" ]; then
@@ -263,6 +285,7 @@ function make_tiny_publish_so {
       -DNNADAPTER_WITH_GOOGLE_XNNPACK=$NNADAPTER_WITH_GOOGLE_XNNPACK \
       -DNNADAPTER_GOOGLE_XNNPACK_SRC_GIT_TAG=$NNADAPTER_GOOGLE_XNNPACK_SRC_GIT_TAG \
       -DLITE_WITH_OPENCL=$WITH_OPENCL \
+      -DLITE_WITH_VULKAN=$WITH_VULKAN \
       -DARM_TARGET_ARCH_ABI=$ARCH \
       -DARM_TARGET_LANG=$TOOLCHAIN \
       -DLITE_WITH_ARM82_FP16=$BUILD_ARM82_FP16 \
@@ -304,6 +327,9 @@ function make_full_publish_so {
   if [ "${WITH_OPENCL}" == "ON" ]; then
       prepare_opencl_source_code $workspace $build_dir
   fi
+  if [ "${WITH_VULKAN}" == "ON" ]; then
+      prepare_vulkan_source_code $workspace
+  fi
 
   if [ "${WITH_STRIP}" == "ON" ]; then
       WITH_EXTRA=ON
@@ -353,6 +379,7 @@ function make_full_publish_so {
       -DNNADAPTER_WITH_GOOGLE_XNNPACK=$NNADAPTER_WITH_GOOGLE_XNNPACK \
       -DNNADAPTER_GOOGLE_XNNPACK_SRC_GIT_TAG=$NNADAPTER_GOOGLE_XNNPACK_SRC_GIT_TAG \
       -DLITE_WITH_OPENCL=$WITH_OPENCL \
+      -DLITE_WITH_VULKAN=$WITH_VULKAN \
       -DARM_TARGET_ARCH_ABI=$ARCH \
       -DARM_TARGET_LANG=$TOOLCHAIN \
       -DLITE_WITH_TRAIN=$WITH_TRAIN \
@@ -433,6 +460,11 @@ function print_usage {
     echo -e "|  arguments of opencl library compiling:(armv8, gcc, c++_static)                                                                      |"
     echo -e "|     ./lite/tools/build_android.sh --with_opencl=ON                                                                                   |"
     echo -e "|     --with_opencl: (OFF|ON); controls whether to compile lib for opencl, default is OFF                                              |"
+    echo -e "|                                                                                                                                      |"
+    echo -e "|  arguments of vulkan library compiling:(armv8, clang, c++_static)                                                                    |"
+    echo -e "|     ./lite/tools/build_android.sh --with_vulkan=ON                                                                                   |"
+    echo -e "|     --with_vulkan: (OFF|ON); controls whether to compile lib for vulkan, default is OFF                                              |"
+    echo -e "|     --glslc: (path to glslc) the shader compiler, default is the one in \$NDK_ROOT/shader-tools                                       |"
     echo "----------------------------------------------------------------------------------------------------------------------------------------"
     echo
 }
@@ -524,6 +556,15 @@ function main {
                 WITH_OPENCL="${i#*=}"
                 shift
                 ;;
+            # compiling lib which can operate on vulkan and cpu.
+            --with_vulkan=*)
+                WITH_VULKAN="${i#*=}"
+                shift
+                ;;
+            --glslc=*)
+                GLSLC="${i#*=}"
+                shift
+                ;;
             # compiling lib which can operate on huawei npu.
             --with_huawei_kirin_npu=*)
                 WITH_HUAWEI_KIRIN_NPU="${i#*=}"
@@ -0,0 +1,68 @@
+# Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+''' Generate the static kernel table of a tailored build from the
+.tailored_kernels_list of the model, each line of which is
+"op_type,target,precision,layout,alias". '''
+
+from __future__ import print_function
+import sys
+import logging
+
+if len(sys.argv) != 3:
+    print("Error: gen_static_kernel_table.py requires two inputs!")
+    exit(1)
+kernels_list_path = sys.argv[1]
+dest_path = sys.argv[2]
+
+keys = set()
+with open(kernels_list_path) as fd:
+    for line in fd:
+        line = line.strip()
+        if line:
+            assert len(line.split(',')) == 5, "invalid kernel: %s" % line
+            keys.add(line)
+# StaticKernelTable::Create looks up the keys by a binary search.
+keys = sorted(keys)
+
+out_lines = [
+    '// Generated by gen_static_kernel_table.py, DO NOT EDIT.',
+    '#include <memory>',
+    '#include "lite/core/op_registry.h"',
+    '',
+]
+for key in keys:
+    out_lines.append('std::unique_ptr<paddle::lite::KernelBase> create_%s();' %
+                     key.replace(',', ''))
+out_lines.append('')
+# A zero-length array is ill-formed, keep the table empty in this case.
+if keys:
+    out_lines.append('static const paddle::lite::StaticKernelTable::Entry '
+                     'static_kernel_entries[] = {')
+    for key in keys:
+        out_lines.append('    {"%s", create_%s},' %
+                         (key, key.replace(',', '')))
+    out_lines.append('};')
+    out_lines.append('')
+    out_lines.append('static paddle::lite::StaticKernelTableRegistrar '
+                     'static_kernel_table_registrar(')
+    out_lines.append('    static_kernel_entries, %d);' % len(keys))
+    out_lines.append('')
+# Referenced by USE_STATIC_KERNEL_TABLE() to keep this file when linking
+# a static library.
+out_lines.append('int touch_static_kernel_table() { return 0; }')
+out_lines.append('')
+
+with open(dest_path, 'w') as f:
+    logging.info("write static kernel table to %s" % dest_path)
+    f.write('\n'.join(out_lines))
@@ -0,0 +1,75 @@
+#  Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+# Compile the compute shaders in lite/backends/vulkan/glsl into SPIR-V by
+# glslc(shipped in $ANDROID_NDK/shader-tools), and bundle the words into a
+# cc file keyed by the shader names.
+# usage: python gen_vulkan_code.py <glsl_dir> <glslc> <dest_cc_file>
+
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+import logging
+
+
+def compile_shader(glslc, path):
+    with tempfile.NamedTemporaryFile(suffix=".spv", delete=False) as f:
+        spv_path = f.name
+    try:
+        subprocess.check_call([
+            glslc, "-fshader-stage=compute", "--target-env=vulkan1.0", "-O",
+            path, "-o", spv_path
+        ])
+        with open(spv_path, "rb") as f:
+            content = f.read()
+    finally:
+        os.remove(spv_path)
+    assert len(content) % 4 == 0, "invalid SPIR-V of %s" % path
+    return struct.unpack("<%dI" % (len(content) // 4), content)
+
+
+def gen_vulkan_shaders(glsl_dir, glslc, dest_path):
+    source = """
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+namespace paddle {
+namespace lite {
+// shader name => SPIR-V
+extern const std::map<std::string, std::vector<uint32_t>> vulkan_shaders_spirv = {
+%s
+};
+}  // namespace lite
+}  // namespace paddle
+"""
+    entries = []
+    for filename in sorted(os.listdir(glsl_dir)):
+        if not filename.endswith(".comp"):
+            continue
+        words = compile_shader(glslc, os.path.join(glsl_dir, filename))
+        lines = []
+        for i in range(0, len(words), 8):
+            lines.append(", ".join("0x%08x" % w for w in words[i:i + 8]))
+        entries.append("    {\"%s\", {\n        %s}}" %
+                       (filename[:-len(".comp")], ",\n        ".join(lines)))
+    with open(dest_path, "w") as f:
+        logging.info("write vulkan shaders source files to %s" % dest_path)
+        f.write(source % ",\n".join(entries))
+
+
+if __name__ == "__main__":
+    gen_vulkan_shaders(sys.argv[1], sys.argv[2], sys.argv[3])
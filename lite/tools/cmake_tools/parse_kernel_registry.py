@@ -88,6 +88,9 @@ with open(faked_kernels_list_path) as f:
                     k.alias, )
                 out_lines.append(key)
 
+if tailored == "ON":
+    out_lines.append("USE_STATIC_KERNEL_TABLE();")
+
 with open(dest_path, 'w') as f:
     logging.info("write kernel list to %s" % dest_path)
     f.write('\n'.join(out_lines))
@@ -0,0 +1,180 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/compression.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+namespace {
+const size_t kMinMatch = 4;
+// The last match starts 12 bytes before the end at least, and the last 5
+// bytes are always literals, as required by the format.
+const size_t kMatchStartMargin = 12;
+const size_t kLastLiterals = 5;
+const int kHashLog = 16;
+const size_t kMaxOffset = 65535;
+
+inline uint32_t Read32(const char* p) {
+  uint32_t x;
+  std::memcpy(&x, p, sizeof(x));
+  return x;
+}
+
+inline uint32_t Hash(uint32_t x) {
+  return (x * 2654435761U) >> (32 - kHashLog);
+}
+
+// Write the length beyond the 4 bits of the token.
+inline char* WriteLength(char* op, size_t length) {
+  for (; length >= 255; length -= 255) *op++ = static_cast<char>(255);
+  *op++ = static_cast<char>(length);
+  return op;
+}
+}  // namespace
+
+size_t LZ4CompressBound(size_t size) { return size + size / 255 + 16; }
+
+size_t LZ4Compress(const char* src, size_t size, char* dst, size_t capacity) {
+  char* op = dst;
+  char* op_end = dst + capacity;
+  // Emit the literals followed by a match, or the last literals if
+  // match_length is 0.
+  auto emit = [&](const char* literals,
+                  size_t literal_length,
+                  size_t offset,
+                  size_t match_length) {
+    size_t need = 1 + literal_length / 255 + 1 + literal_length + 2 +
+                  match_length / 255 + 1;
+    if (static_cast<size_t>(op_end - op) < need) return false;
+    char* token = op++;
+    *token = static_cast<char>((literal_length < 15 ? literal_length : 15)
+                               << 4);
+    if (literal_length >= 15) op = WriteLength(op, literal_length - 15);
+    std::memcpy(op, literals, literal_length);
+    op += literal_length;
+    if (match_length == 0) return true;
+    *op++ = static_cast<char>(offset & 0xff);
+    *op++ = static_cast<char>(offset >> 8);
+    size_t length = match_length - kMinMatch;
+    *token |= static_cast<char>(length < 15 ? length : 15);
+    if (length >= 15) op = WriteLength(op, length - 15);
+    return true;
+  };
+
+  size_t anchor = 0;
+  if (size > kMatchStartMargin) {
+    std::vector<uint32_t> table(1 << kHashLog, 0);
+    const size_t match_start_limit = size - kMatchStartMargin;
+    const size_t match_end_limit = size - kLastLiterals;
+    size_t ip = 0;
+    while (ip < match_start_limit) {
+      uint32_t sequence = Read32(src + ip);
+      uint32_t hash = Hash(sequence);
+      size_t ref = table[hash];
+      table[hash] = static_cast<uint32_t>(ip);
+      if (ref >= ip || ip - ref > kMaxOffset || Read32(src + ref) != sequence) {
+        ip++;
+        continue;
+      }
+      size_t length = kMinMatch;
+      while (ip + length < match_end_limit &&
+             src[ref + length] == src[ip + length]) {
+        length++;
+      }
+      if (!emit(src + anchor, ip - anchor, ip - ref, length)) return 0;
+      ip += length;
+      anchor = ip;
+    }
+  }
+  if (!emit(src + anchor, size - anchor, 0, 0)) return 0;
+  return op - dst;
+}
+
+bool LZ4Decompress(const char* src, size_t size, char* dst, size_t dst_size) {
+  const uint8_t* ip = reinterpret_cast<const uint8_t*>(src);
+  const uint8_t* ip_end = ip + size;
+  size_t op = 0;
+  // Read the length beyond the 4 bits of the token.
+  auto read_length = [&](size_t* length) {
+    uint8_t byte;
+    do {
+      if (ip >= ip_end) return false;
+      byte = *ip++;
+      *length += byte;
+    } while (byte == 255);
+    return true;
+  };
+  while (ip < ip_end) {
+    uint8_t token = *ip++;
+    size_t literal_length = token >> 4;
+    if (literal_length == 15 && !read_length(&literal_length)) return false;
+    if (static_cast<size_t>(ip_end - ip) < literal_length ||
+        dst_size - op < literal_length) {
+      return false;
+    }
+    std::memcpy(dst + op, ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+    // The last sequence has no match.
+    if (ip == ip_end) break;
+    if (ip_end - ip < 2) return false;
+    size_t offset = ip[0] | (ip[1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > op) return false;
+    size_t match_length = token & 15;
+    if (match_length == 15 && !read_length(&match_length)) return false;
+    match_length += kMinMatch;
+    if (dst_size - op < match_length) return false;
+    // The overlapped match repeats the last `offset` bytes, which is copied
+    // by the doubling chunks of the period.
+    size_t match = op - offset;
+    while (match_length > 0) {
+      size_t n = std::min(match_length, op - match);
+      std::memcpy(dst + op, dst + match, n);
+      op += n;
+      match_length -= n;
+    }
+  }
+  return op == dst_size;
+}
+
+void ShuffleBytes(const char* src, size_t size, size_t elem_size, char* dst) {
+  size_t count = size / elem_size;
+  for (size_t b = 0; b < elem_size; b++) {
+    for (size_t i = 0; i < count; i++) {
+      dst[b * count + i] = src[i * elem_size + b];
+    }
+  }
+  size_t whole = count * elem_size;
+  std::memcpy(dst + whole, src + whole, size - whole);
+}
+
+void UnshuffleBytes(const char* src, size_t size, size_t elem_size, char* dst) {
+  size_t count = size / elem_size;
+  for (size_t b = 0; b < elem_size; b++) {
+    for (size_t i = 0; i < count; i++) {
+      dst[i * elem_size + b] = src[b * count + i];
+    }
+  }
+  size_t whole = count * elem_size;
+  std::memcpy(dst + whole, src + whole, size - whole);
+}
+
+}  // namespace lite
+}  // namespace paddle
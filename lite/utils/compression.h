@@ -0,0 +1,43 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <cstddef>
+
+namespace paddle {
+namespace lite {
+
+// A self-contained codec of the LZ4 block format, used to compress the
+// weights in the saved models without depending on the LZ4 library. The
+// compressor is the greedy one of a single hash table, while the
+// decompressor checks every bound, so a broken input is rejected instead of
+// overrunning the buffers.
+
+// The worst-case size of compressing `size` bytes.
+size_t LZ4CompressBound(size_t size);
+// Compress `size` bytes of `src` into `dst` of `capacity` bytes, returns the
+// compressed size, or 0 if it does not fit.
+size_t LZ4Compress(const char* src, size_t size, char* dst, size_t capacity);
+// Decompress `size` bytes of `src` into exactly `dst_size` bytes of `dst`,
+// returns false if the input is broken.
+bool LZ4Decompress(const char* src, size_t size, char* dst, size_t dst_size);
+
+// Group the i-th bytes of the `elem_size`-byte elements together, so the
+// exponents of the floats line up into runs which compress better. The
+// trailing bytes out of the whole elements are kept in place.
+void ShuffleBytes(const char* src, size_t size, size_t elem_size, char* dst);
+void UnshuffleBytes(const char* src, size_t size, size_t elem_size, char* dst);
+
+}  // namespace lite
+}  // namespace paddle
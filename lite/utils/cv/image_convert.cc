@@ -2073,14 +2073,17 @@ void hwc4_to_hwc1(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
 gray2bgr, gray2rgb
 */
 void hwc1_to_hwc3(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
-  for (int i = 0; i < srch; i++) {
+  LITE_PARALLEL_BEGIN(i, tid, srch) {
+    const uint8_t* src_ptr = src + i * srcw;
+    uint8_t* dst_ptr = dst + i * srcw * 3;
     for (int j = 0; j < srcw; j++) {
-      *dst++ = *src;
-      *dst++ = *src;
-      *dst++ = *src;
-      src++;
+      *dst_ptr++ = *src_ptr;
+      *dst_ptr++ = *src_ptr;
+      *dst_ptr++ = *src_ptr;
+      src_ptr++;
     }
   }
+  LITE_PARALLEL_END();
 }
 /*
 采用CV_GRAY2BGRA,转换公式B = G = R = Gray A=255
@@ -2088,84 +2091,105 @@ void hwc1_to_hwc3(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
 gray2bgra, gray2rgba
 */
 void hwc1_to_hwc4(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
-  for (int i = 0; i < srch; i++) {
+  LITE_PARALLEL_BEGIN(i, tid, srch) {
+    const uint8_t* src_ptr = src + i * srcw;
+    uint8_t* dst_ptr = dst + i * srcw * 4;
     for (int j = 0; j < srcw; j++) {
-      *dst++ = *src;
-      *dst++ = *src;
-      *dst++ = *src;
-      *dst++ = 255;
-      src++;
+      *dst_ptr++ = *src_ptr;
+      *dst_ptr++ = *src_ptr;
+      *dst_ptr++ = *src_ptr;
+      *dst_ptr++ = 255;
+      src_ptr++;
     }
   }
+  LITE_PARALLEL_END();
 }
 // bgr2bgra, rgb2rgba
 void hwc3_to_hwc4(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
-  for (int i = 0; i < srch; i++) {
+  LITE_PARALLEL_BEGIN(i, tid, srch) {
+    const uint8_t* src_ptr = src + i * srcw * 3;
+    uint8_t* dst_ptr = dst + i * srcw * 4;
     for (int j = 0; j < srcw; j++) {
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = 255;
+      *dst_ptr++ = *src_ptr++;
+      *dst_ptr++ = *src_ptr++;
+      *dst_ptr++ = *src_ptr++;
+      *dst_ptr++ = 255;
     }
   }
+  LITE_PARALLEL_END();
 }
 // bgra2bgr, rgba2rgb
 void hwc4_to_hwc3(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
-  for (int i = 0; i < srch; i++) {
+  LITE_PARALLEL_BEGIN(i, tid, srch) {
+    const uint8_t* src_ptr = src + i * srcw * 4;
+    uint8_t* dst_ptr = dst + i * srcw * 3;
     for (int j = 0; j < srcw; j++) {
-      *dst++ = *src++;
-      *dst++ = *src++;
-      *dst++ = *src++;
-      src++;
+      *dst_ptr++ = *src_ptr++;
+      *dst_ptr++ = *src_ptr++;
+      *dst_ptr++ = *src_ptr++;
+      src_ptr++;
     }
   }
+  LITE_PARALLEL_END();
 }
 // bgr2rgb, rgb2bgr
 void hwc3_trans(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
-  for (int i = 0; i < srch; i++) {
+  LITE_PARALLEL_BEGIN(i, tid, srch) {
+    const uint8_t* src_ptr = src + i * srcw * 3;
+    uint8_t* dst_ptr = dst + i * srcw * 3;
     for (int j = 0; j < srcw; j++) {
-      *dst++ = src[2];  // r
-      *dst++ = src[1];  // g
-      *dst++ = src[0];  // b
-      src += 3;
+      *dst_ptr++ = src_ptr[2];  // r
+      *dst_ptr++ = src_ptr[1];  // g
+      *dst_ptr++ = src_ptr[0];  // b
+      src_ptr += 3;
     }
   }
+  LITE_PARALLEL_END();
 }
 // bgra2rgba, rgba2bgra
 void hwc4_trans(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
-  for (int i = 0; i < srch; i++) {
+  LITE_PARALLEL_BEGIN(i, tid, srch) {
+    const uint8_t* src_ptr = src + i * srcw * 4;
+    uint8_t* dst_ptr = dst + i * srcw * 4;
     for (int j = 0; j < srcw; j++) {
-      *dst++ = src[2];  // r
-      *dst++ = src[1];  // g
-      *dst++ = src[0];  // b
-      *dst++ = src[3];  // a
-      src += 4;
+      *dst_ptr++ = src_ptr[2];  // r
+      *dst_ptr++ = src_ptr[1];  // g
+      *dst_ptr++ = src_ptr[0];  // b
+      *dst_ptr++ = src_ptr[3];  // a
+      src_ptr += 4;
     }
   }
+  LITE_PARALLEL_END();
 }
 // bgra2rgb, rgba2bgr
 void hwc4_trans_hwc3(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
-  for (int i = 0; i < srch; i++) {
+  LITE_PARALLEL_BEGIN(i, tid, srch) {
+    const uint8_t* src_ptr = src + i * srcw * 4;
+    uint8_t* dst_ptr = dst + i * srcw * 3;
     for (int j = 0; j < srcw; j++) {
-      *dst++ = src[2];  // r
-      *dst++ = src[1];  // g
-      *dst++ = src[0];  // b
-      // *dst++ = src[4];//a
-      src += 4;
+      *dst_ptr++ = src_ptr[2];  // r
+      *dst_ptr++ = src_ptr[1];  // g
+      *dst_ptr++ = src_ptr[0];  // b
+      // *dst_ptr++ = src_ptr[4];//a
+      src_ptr += 4;
     }
   }
+  LITE_PARALLEL_END();
 }
 // bgr2rgba, rgb2bga
 void hwc3_trans_hwc4(const uint8_t* src, uint8_t* dst, int srcw, int srch) {
-  for (int i = 0; i < srch; i++) {
+  LITE_PARALLEL_BEGIN(i, tid, srch) {
+    const uint8_t* src_ptr = src + i * srcw * 3;
+    uint8_t* dst_ptr = dst + i * srcw * 4;
     for (int j = 0; j < srcw; j++) {
-      *dst++ = src[2];  // r
-      *dst++ = src[1];  // g
-      *dst++ = src[0];  // b
-      *dst++ = 255;     // a
-      src += 3;
+      *dst_ptr++ = src_ptr[2];  // r
+      *dst_ptr++ = src_ptr[1];  // g
+      *dst_ptr++ = src_ptr[0];  // b
+      *dst_ptr++ = 255;     // a
+      src_ptr += 3;
     }
   }
+  LITE_PARALLEL_END();
 }
 }  // namespace cv
 }  // namespace utils
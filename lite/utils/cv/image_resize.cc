@@ -37,11 +37,18 @@
 #include <stdint.h>
 #include <string.h>
 #include <algorithm>
+#include <vector>
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
 namespace utils {
 namespace cv {
+namespace {
+// The output rows resized by a parallel task.
+const int kTileRows = 16;
+}  // namespace
+
 void ImageResize::choose(const uint8_t* src,
                          uint8_t* dst,
                          ImageFormat srcFormat,
@@ -257,115 +264,117 @@ void resize_one_channel(const uint8_t* src,
     ibeta[dy * 2 + 1] = SATURATE_CAST_SHORT(b1);
   }
 #undef SATURATE_CAST_SHORT
-  // loop body
-  int16_t* rowsbuf0 = new int16_t[w_out + 1];
-  int16_t* rowsbuf1 = new int16_t[w_out + 1];
-  int16_t* rows0 = rowsbuf0;
-  int16_t* rows1 = rowsbuf1;
+  // The output rows are resized in tiles in parallel, each of which caches
+  // its own input rows.
+  const int tiles = (h_out + kTileRows - 1) / kTileRows;
+  LITE_PARALLEL_BEGIN(t, tid, tiles) {
+    std::vector<int16_t> rowsbuf0(w_out + 1);
+    std::vector<int16_t> rowsbuf1(w_out + 1);
+    int16_t* rows0 = rowsbuf0.data();
+    int16_t* rows1 = rowsbuf1.data();
+    int prev_sy1 = -1;
+    int dy_end = std::min((t + 1) * kTileRows, h_out);
+    for (int dy = t * kTileRows; dy < dy_end; dy++) {
+      int sy = yofs[dy];
+
+      if (sy == prev_sy1) {
+        // hresize one row
+        int16_t* rows0_old = rows0;
+        rows0 = rows1;
+        rows1 = rows0_old;
+        const uint8_t* S1 = src + w_in * (sy + 1);
+        const int16_t* ialphap = ialpha;
+        int16_t* rows1p = rows1;
+        for (int dx = 0; dx < w_out; dx++) {
+          int sx = xofs[dx];
+          int16_t a0 = ialphap[0];
+          int16_t a1 = ialphap[1];
+
+          const uint8_t* S1p = S1 + sx;
+          rows1p[dx] = (S1p[0] * a0 + S1p[1] * a1) >> 4;
+
+          ialphap += 2;
+        }
+      } else {
+        // hresize two rows
+        const uint8_t* S0 = src + w_in * (sy);
+        const uint8_t* S1 = src + w_in * (sy + 1);
+
+        const int16_t* ialphap = ialpha;
+        int16_t* rows0p = rows0;
+        int16_t* rows1p = rows1;
+        for (int dx = 0; dx < w_out; dx++) {
+          int sx = xofs[dx];
+          int16_t a0 = ialphap[0];
+          int16_t a1 = ialphap[1];
+
+          const uint8_t* S0p = S0 + sx;
+          const uint8_t* S1p = S1 + sx;
+          rows0p[dx] = (S0p[0] * a0 + S0p[1] * a1) >> 4;
+          rows1p[dx] = (S1p[0] * a0 + S1p[1] * a1) >> 4;
+
+          ialphap += 2;
+        }
+      }
 
-  int prev_sy1 = -1;
-  for (int dy = 0; dy < h_out; dy++) {
-    int sy = yofs[dy];
-
-    if (sy == prev_sy1) {
-      // hresize one row
-      int16_t* rows0_old = rows0;
-      rows0 = rows1;
-      rows1 = rows0_old;
-      const uint8_t* S1 = src + w_in * (sy + 1);
-      const int16_t* ialphap = ialpha;
-      int16_t* rows1p = rows1;
-      for (int dx = 0; dx < w_out; dx++) {
-        int sx = xofs[dx];
-        int16_t a0 = ialphap[0];
-        int16_t a1 = ialphap[1];
+      prev_sy1 = sy + 1;
 
-        const uint8_t* S1p = S1 + sx;
-        rows1p[dx] = (S1p[0] * a0 + S1p[1] * a1) >> 4;
+      // vresize
+      int16_t b0 = ibeta[dy * 2];
+      int16_t b1 = ibeta[dy * 2 + 1];
 
-        ialphap += 2;
-      }
-    } else {
-      // hresize two rows
-      const uint8_t* S0 = src + w_in * (sy);
-      const uint8_t* S1 = src + w_in * (sy + 1);
-
-      const int16_t* ialphap = ialpha;
       int16_t* rows0p = rows0;
       int16_t* rows1p = rows1;
-      for (int dx = 0; dx < w_out; dx++) {
-        int sx = xofs[dx];
-        int16_t a0 = ialphap[0];
-        int16_t a1 = ialphap[1];
-
-        const uint8_t* S0p = S0 + sx;
-        const uint8_t* S1p = S1 + sx;
-        rows0p[dx] = (S0p[0] * a0 + S0p[1] * a1) >> 4;
-        rows1p[dx] = (S1p[0] * a0 + S1p[1] * a1) >> 4;
+      uint8_t* dp_ptr = dst + w_out * (dy);
 
-        ialphap += 2;
-      }
-    }
+      int cnt = w_out >> 3;
+      int remain = w_out - (cnt << 3);
+      int16x4_t _b0 = vdup_n_s16(b0);
+      int16x4_t _b1 = vdup_n_s16(b1);
+      int32x4_t _v2 = vdupq_n_s32(2);
 
-    prev_sy1 = sy + 1;
+      for (cnt = w_out >> 3; cnt > 0; cnt--) {
+        int16x4_t _rows0p_sr4 = vld1_s16(rows0p);
+        int16x4_t _rows1p_sr4 = vld1_s16(rows1p);
+        int16x4_t _rows0p_1_sr4 = vld1_s16(rows0p + 4);
+        int16x4_t _rows1p_1_sr4 = vld1_s16(rows1p + 4);
 
-    // vresize
-    int16_t b0 = ibeta[0];
-    int16_t b1 = ibeta[1];
+        int32x4_t _rows0p_sr4_mb0 = vmull_s16(_rows0p_sr4, _b0);
+        int32x4_t _rows1p_sr4_mb1 = vmull_s16(_rows1p_sr4, _b1);
+        int32x4_t _rows0p_1_sr4_mb0 = vmull_s16(_rows0p_1_sr4, _b0);
+        int32x4_t _rows1p_1_sr4_mb1 = vmull_s16(_rows1p_1_sr4, _b1);
 
-    int16_t* rows0p = rows0;
-    int16_t* rows1p = rows1;
-    uint8_t* dp_ptr = dst + w_out * (dy);
+        int32x4_t _acc = _v2;
+        _acc = vsraq_n_s32(_acc, _rows0p_sr4_mb0, 16);
+        _acc = vsraq_n_s32(_acc, _rows1p_sr4_mb1, 16);
 
-    int cnt = w_out >> 3;
-    int remain = w_out - (cnt << 3);
-    int16x4_t _b0 = vdup_n_s16(b0);
-    int16x4_t _b1 = vdup_n_s16(b1);
-    int32x4_t _v2 = vdupq_n_s32(2);
+        int32x4_t _acc_1 = _v2;
+        _acc_1 = vsraq_n_s32(_acc_1, _rows0p_1_sr4_mb0, 16);
+        _acc_1 = vsraq_n_s32(_acc_1, _rows1p_1_sr4_mb1, 16);
 
-    for (cnt = w_out >> 3; cnt > 0; cnt--) {
-      int16x4_t _rows0p_sr4 = vld1_s16(rows0p);
-      int16x4_t _rows1p_sr4 = vld1_s16(rows1p);
-      int16x4_t _rows0p_1_sr4 = vld1_s16(rows0p + 4);
-      int16x4_t _rows1p_1_sr4 = vld1_s16(rows1p + 4);
+        int16x4_t _acc16 = vshrn_n_s32(_acc, 2);
+        int16x4_t _acc16_1 = vshrn_n_s32(_acc_1, 2);
 
-      int32x4_t _rows0p_sr4_mb0 = vmull_s16(_rows0p_sr4, _b0);
-      int32x4_t _rows1p_sr4_mb1 = vmull_s16(_rows1p_sr4, _b1);
-      int32x4_t _rows0p_1_sr4_mb0 = vmull_s16(_rows0p_1_sr4, _b0);
-      int32x4_t _rows1p_1_sr4_mb1 = vmull_s16(_rows1p_1_sr4, _b1);
+        uint8x8_t _dout = vqmovun_s16(vcombine_s16(_acc16, _acc16_1));
 
-      int32x4_t _acc = _v2;
-      _acc = vsraq_n_s32(_acc, _rows0p_sr4_mb0, 16);
-      _acc = vsraq_n_s32(_acc, _rows1p_sr4_mb1, 16);
+        vst1_u8(dp_ptr, _dout);
 
-      int32x4_t _acc_1 = _v2;
-      _acc_1 = vsraq_n_s32(_acc_1, _rows0p_1_sr4_mb0, 16);
-      _acc_1 = vsraq_n_s32(_acc_1, _rows1p_1_sr4_mb1, 16);
-
-      int16x4_t _acc16 = vshrn_n_s32(_acc, 2);
-      int16x4_t _acc16_1 = vshrn_n_s32(_acc_1, 2);
-
-      uint8x8_t _dout = vqmovun_s16(vcombine_s16(_acc16, _acc16_1));
-
-      vst1_u8(dp_ptr, _dout);
-
-      dp_ptr += 8;
-      rows0p += 8;
-      rows1p += 8;
-    }
-    for (; remain; --remain) {
-      // D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS;
-      *dp_ptr++ =
-          (uint8_t)(((int16_t)((b0 * (int16_t)(*rows0p++)) >> 16) +
-                     (int16_t)((b1 * (int16_t)(*rows1p++)) >> 16) + 2) >>
-                    2);
+        dp_ptr += 8;
+        rows0p += 8;
+        rows1p += 8;
+      }
+      for (; remain; --remain) {
+        // D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS;
+        *dp_ptr++ =
+            (uint8_t)(((int16_t)((b0 * (int16_t)(*rows0p++)) >> 16) +
+                       (int16_t)((b1 * (int16_t)(*rows1p++)) >> 16) + 2) >>
+                      2);
+      }
     }
-    ibeta += 2;
   }
+  LITE_PARALLEL_END();
 
   delete[] buf;
-  delete[] rowsbuf0;
-  delete[] rowsbuf1;
 }
 
 void resize_one_channel_uv(const uint8_t* src,
@@ -447,118 +456,120 @@ void resize_one_channel_uv(const uint8_t* src,
   }
 
 #undef SATURATE_CAST_SHORT
-  // loop body
-  int16_t* rowsbuf0 = new int16_t[w_out + 1];
-  int16_t* rowsbuf1 = new int16_t[w_out + 1];
-  int16_t* rows0 = rowsbuf0;
-  int16_t* rows1 = rowsbuf1;
-
-  int prev_sy1 = -1;
-  for (int dy = 0; dy < h_out; dy++) {
-    int sy = yofs[dy];
-    if (sy == prev_sy1) {
-      // hresize one row
-      int16_t* rows0_old = rows0;
-      rows0 = rows1;
-      rows1 = rows0_old;
-      const uint8_t* S1 = src + w_in * (sy + 1);
-
-      const int16_t* ialphap = ialpha;
-      int16_t* rows1p = rows1;
-      for (int dx = 0; dx < wout; dx++) {
-        int sx = xofs[dx] * 2;
-        int16_t a0 = ialphap[0];
-        int16_t a1 = ialphap[1];
-        const uint8_t* S1p = S1 + sx;
-        int tmp = dx * 2;
-        rows1p[tmp] = (S1p[0] * a0 + S1p[2] * a1) >> 4;
-        rows1p[tmp + 1] = (S1p[1] * a0 + S1p[3] * a1) >> 4;
-
-        ialphap += 2;
+  // The output rows are resized in tiles in parallel, each of which caches
+  // its own input rows.
+  const int tiles = (h_out + kTileRows - 1) / kTileRows;
+  LITE_PARALLEL_BEGIN(t, tid, tiles) {
+    std::vector<int16_t> rowsbuf0(w_out + 1);
+    std::vector<int16_t> rowsbuf1(w_out + 1);
+    int16_t* rows0 = rowsbuf0.data();
+    int16_t* rows1 = rowsbuf1.data();
+    int prev_sy1 = -1;
+    int dy_end = std::min((t + 1) * kTileRows, h_out);
+    for (int dy = t * kTileRows; dy < dy_end; dy++) {
+      int sy = yofs[dy];
+      if (sy == prev_sy1) {
+        // hresize one row
+        int16_t* rows0_old = rows0;
+        rows0 = rows1;
+        rows1 = rows0_old;
+        const uint8_t* S1 = src + w_in * (sy + 1);
+
+        const int16_t* ialphap = ialpha;
+        int16_t* rows1p = rows1;
+        for (int dx = 0; dx < wout; dx++) {
+          int sx = xofs[dx] * 2;
+          int16_t a0 = ialphap[0];
+          int16_t a1 = ialphap[1];
+          const uint8_t* S1p = S1 + sx;
+          int tmp = dx * 2;
+          rows1p[tmp] = (S1p[0] * a0 + S1p[2] * a1) >> 4;
+          rows1p[tmp + 1] = (S1p[1] * a0 + S1p[3] * a1) >> 4;
+
+          ialphap += 2;
+        }
+      } else {
+        // hresize two rows
+        const uint8_t* S0 = src + w_in * (sy);
+        const uint8_t* S1 = src + w_in * (sy + 1);
+
+        const int16_t* ialphap = ialpha;
+        int16_t* rows0p = rows0;
+        int16_t* rows1p = rows1;
+        for (int dx = 0; dx < wout; dx++) {
+          int sx = xofs[dx] * 2;
+          int16_t a0 = ialphap[0];
+          int16_t a1 = ialphap[1];
+
+          const uint8_t* S0p = S0 + sx;
+          const uint8_t* S1p = S1 + sx;
+          int tmp = dx * 2;
+          rows0p[tmp] = (S0p[0] * a0 + S0p[2] * a1) >> 4;
+          rows1p[tmp] = (S1p[0] * a0 + S1p[2] * a1) >> 4;
+
+          rows0p[tmp + 1] = (S0p[1] * a0 + S0p[3] * a1) >> 4;
+          rows1p[tmp + 1] = (S1p[1] * a0 + S1p[3] * a1) >> 4;
+          ialphap += 2;
+        }
       }
-    } else {
-      // hresize two rows
-      const uint8_t* S0 = src + w_in * (sy);
-      const uint8_t* S1 = src + w_in * (sy + 1);
+      prev_sy1 = sy + 1;
+
+      // vresize
+      int16_t b0 = ibeta[dy * 2];
+      int16_t b1 = ibeta[dy * 2 + 1];
 
-      const int16_t* ialphap = ialpha;
       int16_t* rows0p = rows0;
       int16_t* rows1p = rows1;
-      for (int dx = 0; dx < wout; dx++) {
-        int sx = xofs[dx] * 2;
-        int16_t a0 = ialphap[0];
-        int16_t a1 = ialphap[1];
-
-        const uint8_t* S0p = S0 + sx;
-        const uint8_t* S1p = S1 + sx;
-        int tmp = dx * 2;
-        rows0p[tmp] = (S0p[0] * a0 + S0p[2] * a1) >> 4;
-        rows1p[tmp] = (S1p[0] * a0 + S1p[2] * a1) >> 4;
-
-        rows0p[tmp + 1] = (S0p[1] * a0 + S0p[3] * a1) >> 4;
-        rows1p[tmp + 1] = (S1p[1] * a0 + S1p[3] * a1) >> 4;
-        ialphap += 2;
+      uint8_t* dp_ptr = dst + w_out * (dy);
+
+      int cnt = w_out >> 3;
+      int remain = w_out - (cnt << 3);
+      int16x4_t _b0 = vdup_n_s16(b0);
+      int16x4_t _b1 = vdup_n_s16(b1);
+      int32x4_t _v2 = vdupq_n_s32(2);
+      for (cnt = w_out >> 3; cnt > 0; cnt--) {
+        int16x4_t _rows0p_sr4 = vld1_s16(rows0p);
+        int16x4_t _rows1p_sr4 = vld1_s16(rows1p);
+        int16x4_t _rows0p_1_sr4 = vld1_s16(rows0p + 4);
+        int16x4_t _rows1p_1_sr4 = vld1_s16(rows1p + 4);
+
+        int32x4_t _rows0p_sr4_mb0 = vmull_s16(_rows0p_sr4, _b0);
+        int32x4_t _rows1p_sr4_mb1 = vmull_s16(_rows1p_sr4, _b1);
+        int32x4_t _rows0p_1_sr4_mb0 = vmull_s16(_rows0p_1_sr4, _b0);
+        int32x4_t _rows1p_1_sr4_mb1 = vmull_s16(_rows1p_1_sr4, _b1);
+
+        int32x4_t _acc = _v2;
+        _acc = vsraq_n_s32(
+            _acc, _rows0p_sr4_mb0, 16);  // _acc >> 16 + _rows0p_sr4_mb0 >> 16
+        _acc = vsraq_n_s32(_acc, _rows1p_sr4_mb1, 16);
+
+        int32x4_t _acc_1 = _v2;
+        _acc_1 = vsraq_n_s32(_acc_1, _rows0p_1_sr4_mb0, 16);
+        _acc_1 = vsraq_n_s32(_acc_1, _rows1p_1_sr4_mb1, 16);
+
+        int16x4_t _acc16 = vshrn_n_s32(_acc, 2);  // _acc >> 2
+        int16x4_t _acc16_1 = vshrn_n_s32(_acc_1, 2);
+
+        uint8x8_t _dout = vqmovun_s16(vcombine_s16(_acc16, _acc16_1));
+
+        vst1_u8(dp_ptr, _dout);
+
+        dp_ptr += 8;
+        rows0p += 8;
+        rows1p += 8;
+      }
+      for (; remain; --remain) {
+        // D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS;
+        *dp_ptr++ =
+            (uint8_t)(((int16_t)((b0 * (int16_t)(*rows0p++)) >> 16) +
+                       (int16_t)((b1 * (int16_t)(*rows1p++)) >> 16) + 2) >>
+                      2);
       }
     }
-    prev_sy1 = sy + 1;
-
-    // vresize
-    int16_t b0 = ibeta[0];
-    int16_t b1 = ibeta[1];
-
-    int16_t* rows0p = rows0;
-    int16_t* rows1p = rows1;
-    uint8_t* dp_ptr = dst + w_out * (dy);
-
-    int cnt = w_out >> 3;
-    int remain = w_out - (cnt << 3);
-    int16x4_t _b0 = vdup_n_s16(b0);
-    int16x4_t _b1 = vdup_n_s16(b1);
-    int32x4_t _v2 = vdupq_n_s32(2);
-    for (cnt = w_out >> 3; cnt > 0; cnt--) {
-      int16x4_t _rows0p_sr4 = vld1_s16(rows0p);
-      int16x4_t _rows1p_sr4 = vld1_s16(rows1p);
-      int16x4_t _rows0p_1_sr4 = vld1_s16(rows0p + 4);
-      int16x4_t _rows1p_1_sr4 = vld1_s16(rows1p + 4);
-
-      int32x4_t _rows0p_sr4_mb0 = vmull_s16(_rows0p_sr4, _b0);
-      int32x4_t _rows1p_sr4_mb1 = vmull_s16(_rows1p_sr4, _b1);
-      int32x4_t _rows0p_1_sr4_mb0 = vmull_s16(_rows0p_1_sr4, _b0);
-      int32x4_t _rows1p_1_sr4_mb1 = vmull_s16(_rows1p_1_sr4, _b1);
-
-      int32x4_t _acc = _v2;
-      _acc = vsraq_n_s32(
-          _acc, _rows0p_sr4_mb0, 16);  // _acc >> 16 + _rows0p_sr4_mb0 >> 16
-      _acc = vsraq_n_s32(_acc, _rows1p_sr4_mb1, 16);
-
-      int32x4_t _acc_1 = _v2;
-      _acc_1 = vsraq_n_s32(_acc_1, _rows0p_1_sr4_mb0, 16);
-      _acc_1 = vsraq_n_s32(_acc_1, _rows1p_1_sr4_mb1, 16);
-
-      int16x4_t _acc16 = vshrn_n_s32(_acc, 2);  // _acc >> 2
-      int16x4_t _acc16_1 = vshrn_n_s32(_acc_1, 2);
-
-      uint8x8_t _dout = vqmovun_s16(vcombine_s16(_acc16, _acc16_1));
-
-      vst1_u8(dp_ptr, _dout);
-
-      dp_ptr += 8;
-      rows0p += 8;
-      rows1p += 8;
-    }
-    for (; remain; --remain) {
-      // D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS;
-      *dp_ptr++ =
-          (uint8_t)(((int16_t)((b0 * (int16_t)(*rows0p++)) >> 16) +
-                     (int16_t)((b1 * (int16_t)(*rows1p++)) >> 16) + 2) >>
-                    2);
-    }
-    ibeta += 2;
   }
+  LITE_PARALLEL_END();
 
   delete[] buf;
-  delete[] rowsbuf0;
-  delete[] rowsbuf1;
 }
 
 void resize_three_channel(const uint8_t* src,
@@ -625,104 +636,107 @@ void resize_three_channel(const uint8_t* src,
     ibeta[dy * 2 + 1] = SATURATE_CAST_SHORT(b1);
   }
 #undef SATURATE_CAST_SHORT
-  // loop body
-  int16_t* rowsbuf0 = new int16_t[w_out + 1];
-  int16_t* rowsbuf1 = new int16_t[w_out + 1];
-  int16_t* rows0 = rowsbuf0;
-  int16_t* rows1 = rowsbuf1;
-  int prev_sy1 = -1;
-  for (int dy = 0; dy < h_out; dy++) {
-    int sy = yofs[dy];
-    if (sy == prev_sy1) {
-      // hresize one row
-      int16_t* rows0_old = rows0;
-      rows0 = rows1;
-      rows1 = rows0_old;
-      const uint8_t* S1 = src + w_in * (sy + 1);
-      const int16_t* ialphap = ialpha;
-      int16_t* rows1p = rows1;
-      for (int dx = 0; dx < w_out / 3; dx++) {
-        int sx = xofs[dx];
-        int16_t a0 = ialphap[0];
-        int16_t a1 = ialphap[1];
-        const uint8_t* S1p = S1 + sx;
-        int tmp = dx * 3;
-        rows1p[tmp] = (S1p[0] * a0 + S1p[3] * a1) >> 4;
-        rows1p[tmp + 1] = (S1p[1] * a0 + S1p[4] * a1) >> 4;
-        rows1p[tmp + 2] = (S1p[2] * a0 + S1p[5] * a1) >> 4;
-        ialphap += 2;
+  // The output rows are resized in tiles in parallel, each of which caches
+  // its own input rows.
+  const int tiles = (h_out + kTileRows - 1) / kTileRows;
+  LITE_PARALLEL_BEGIN(t, tid, tiles) {
+    std::vector<int16_t> rowsbuf0(w_out + 1);
+    std::vector<int16_t> rowsbuf1(w_out + 1);
+    int16_t* rows0 = rowsbuf0.data();
+    int16_t* rows1 = rowsbuf1.data();
+    int prev_sy1 = -1;
+    int dy_end = std::min((t + 1) * kTileRows, h_out);
+    for (int dy = t * kTileRows; dy < dy_end; dy++) {
+      int sy = yofs[dy];
+      if (sy == prev_sy1) {
+        // hresize one row
+        int16_t* rows0_old = rows0;
+        rows0 = rows1;
+        rows1 = rows0_old;
+        const uint8_t* S1 = src + w_in * (sy + 1);
+        const int16_t* ialphap = ialpha;
+        int16_t* rows1p = rows1;
+        for (int dx = 0; dx < w_out / 3; dx++) {
+          int sx = xofs[dx];
+          int16_t a0 = ialphap[0];
+          int16_t a1 = ialphap[1];
+          const uint8_t* S1p = S1 + sx;
+          int tmp = dx * 3;
+          rows1p[tmp] = (S1p[0] * a0 + S1p[3] * a1) >> 4;
+          rows1p[tmp + 1] = (S1p[1] * a0 + S1p[4] * a1) >> 4;
+          rows1p[tmp + 2] = (S1p[2] * a0 + S1p[5] * a1) >> 4;
+          ialphap += 2;
+        }
+      } else {
+        // hresize two rows
+        const uint8_t* S0 = src + w_in * (sy);
+        const uint8_t* S1 = src + w_in * (sy + 1);
+        const int16_t* ialphap = ialpha;
+        int16_t* rows0p = rows0;
+        int16_t* rows1p = rows1;
+        for (int dx = 0; dx < w_out / 3; dx++) {
+          int sx = xofs[dx];
+          int16_t a0 = ialphap[0];
+          int16_t a1 = ialphap[1];
+          const uint8_t* S0p = S0 + sx;
+          const uint8_t* S1p = S1 + sx;
+          int tmp = dx * 3;
+          rows0p[tmp] = (S0p[0] * a0 + S0p[3] * a1) >> 4;
+          rows1p[tmp] = (S1p[0] * a0 + S1p[3] * a1) >> 4;
+          rows0p[tmp + 1] = (S0p[1] * a0 + S0p[4] * a1) >> 4;
+          rows1p[tmp + 1] = (S1p[1] * a0 + S1p[4] * a1) >> 4;
+          rows0p[tmp + 2] = (S0p[2] * a0 + S0p[5] * a1) >> 4;
+          rows1p[tmp + 2] = (S1p[2] * a0 + S1p[5] * a1) >> 4;
+          ialphap += 2;
+        }
       }
-    } else {
-      // hresize two rows
-      const uint8_t* S0 = src + w_in * (sy);
-      const uint8_t* S1 = src + w_in * (sy + 1);
-      const int16_t* ialphap = ialpha;
+      prev_sy1 = sy + 1;
+      // vresize
+      int16_t b0 = ibeta[dy * 2];
+      int16_t b1 = ibeta[dy * 2 + 1];
       int16_t* rows0p = rows0;
       int16_t* rows1p = rows1;
-      for (int dx = 0; dx < w_out / 3; dx++) {
-        int sx = xofs[dx];
-        int16_t a0 = ialphap[0];
-        int16_t a1 = ialphap[1];
-        const uint8_t* S0p = S0 + sx;
-        const uint8_t* S1p = S1 + sx;
-        int tmp = dx * 3;
-        rows0p[tmp] = (S0p[0] * a0 + S0p[3] * a1) >> 4;
-        rows1p[tmp] = (S1p[0] * a0 + S1p[3] * a1) >> 4;
-        rows0p[tmp + 1] = (S0p[1] * a0 + S0p[4] * a1) >> 4;
-        rows1p[tmp + 1] = (S1p[1] * a0 + S1p[4] * a1) >> 4;
-        rows0p[tmp + 2] = (S0p[2] * a0 + S0p[5] * a1) >> 4;
-        rows1p[tmp + 2] = (S1p[2] * a0 + S1p[5] * a1) >> 4;
-        ialphap += 2;
+      uint8_t* dp_ptr = dst + w_out * (dy);
+      int cnt = w_out >> 3;
+      int remain = w_out - (cnt << 3);
+      int16x4_t _b0 = vdup_n_s16(b0);
+      int16x4_t _b1 = vdup_n_s16(b1);
+      int32x4_t _v2 = vdupq_n_s32(2);
+      for (cnt = w_out >> 3; cnt > 0; cnt--) {
+        int16x4_t _rows0p_sr4 = vld1_s16(rows0p);
+        int16x4_t _rows1p_sr4 = vld1_s16(rows1p);
+        int16x4_t _rows0p_1_sr4 = vld1_s16(rows0p + 4);
+        int16x4_t _rows1p_1_sr4 = vld1_s16(rows1p + 4);
+        int32x4_t _rows0p_sr4_mb0 = vmull_s16(_rows0p_sr4, _b0);
+        int32x4_t _rows1p_sr4_mb1 = vmull_s16(_rows1p_sr4, _b1);
+        int32x4_t _rows0p_1_sr4_mb0 = vmull_s16(_rows0p_1_sr4, _b0);
+        int32x4_t _rows1p_1_sr4_mb1 = vmull_s16(_rows1p_1_sr4, _b1);
+        int32x4_t _acc = _v2;
+        _acc = vsraq_n_s32(
+            _acc, _rows0p_sr4_mb0, 16);  // _acc >> 16 + _rows0p_sr4_mb0 >> 16
+        _acc = vsraq_n_s32(_acc, _rows1p_sr4_mb1, 16);
+        int32x4_t _acc_1 = _v2;
+        _acc_1 = vsraq_n_s32(_acc_1, _rows0p_1_sr4_mb0, 16);
+        _acc_1 = vsraq_n_s32(_acc_1, _rows1p_1_sr4_mb1, 16);
+        int16x4_t _acc16 = vshrn_n_s32(_acc, 2);  // _acc >> 2
+        int16x4_t _acc16_1 = vshrn_n_s32(_acc_1, 2);
+        uint8x8_t _dout = vqmovun_s16(vcombine_s16(_acc16, _acc16_1));
+        vst1_u8(dp_ptr, _dout);
+        dp_ptr += 8;
+        rows0p += 8;
+        rows1p += 8;
+      }
+      for (; remain; --remain) {
+        // D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS;
+        *dp_ptr++ =
+            (uint8_t)(((int16_t)((b0 * (int16_t)(*rows0p++)) >> 16) +
+                       (int16_t)((b1 * (int16_t)(*rows1p++)) >> 16) + 2) >>
+                      2);
       }
     }
-    prev_sy1 = sy + 1;
-    // vresize
-    int16_t b0 = ibeta[0];
-    int16_t b1 = ibeta[1];
-    int16_t* rows0p = rows0;
-    int16_t* rows1p = rows1;
-    uint8_t* dp_ptr = dst + w_out * (dy);
-    int cnt = w_out >> 3;
-    int remain = w_out - (cnt << 3);
-    int16x4_t _b0 = vdup_n_s16(b0);
-    int16x4_t _b1 = vdup_n_s16(b1);
-    int32x4_t _v2 = vdupq_n_s32(2);
-    for (cnt = w_out >> 3; cnt > 0; cnt--) {
-      int16x4_t _rows0p_sr4 = vld1_s16(rows0p);
-      int16x4_t _rows1p_sr4 = vld1_s16(rows1p);
-      int16x4_t _rows0p_1_sr4 = vld1_s16(rows0p + 4);
-      int16x4_t _rows1p_1_sr4 = vld1_s16(rows1p + 4);
-      int32x4_t _rows0p_sr4_mb0 = vmull_s16(_rows0p_sr4, _b0);
-      int32x4_t _rows1p_sr4_mb1 = vmull_s16(_rows1p_sr4, _b1);
-      int32x4_t _rows0p_1_sr4_mb0 = vmull_s16(_rows0p_1_sr4, _b0);
-      int32x4_t _rows1p_1_sr4_mb1 = vmull_s16(_rows1p_1_sr4, _b1);
-      int32x4_t _acc = _v2;
-      _acc = vsraq_n_s32(
-          _acc, _rows0p_sr4_mb0, 16);  // _acc >> 16 + _rows0p_sr4_mb0 >> 16
-      _acc = vsraq_n_s32(_acc, _rows1p_sr4_mb1, 16);
-      int32x4_t _acc_1 = _v2;
-      _acc_1 = vsraq_n_s32(_acc_1, _rows0p_1_sr4_mb0, 16);
-      _acc_1 = vsraq_n_s32(_acc_1, _rows1p_1_sr4_mb1, 16);
-      int16x4_t _acc16 = vshrn_n_s32(_acc, 2);  // _acc >> 2
-      int16x4_t _acc16_1 = vshrn_n_s32(_acc_1, 2);
-      uint8x8_t _dout = vqmovun_s16(vcombine_s16(_acc16, _acc16_1));
-      vst1_u8(dp_ptr, _dout);
-      dp_ptr += 8;
-      rows0p += 8;
-      rows1p += 8;
-    }
-    for (; remain; --remain) {
-      // D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS;
-      *dp_ptr++ =
-          (uint8_t)(((int16_t)((b0 * (int16_t)(*rows0p++)) >> 16) +
-                     (int16_t)((b1 * (int16_t)(*rows1p++)) >> 16) + 2) >>
-                    2);
-    }
-    ibeta += 2;
   }
+  LITE_PARALLEL_END();
   delete[] buf;
-  delete[] rowsbuf0;
-  delete[] rowsbuf1;
 }
 
 void resize_four_channel(const uint8_t* src,
@@ -789,108 +803,111 @@ void resize_four_channel(const uint8_t* src,
     ibeta[dy * 2 + 1] = SATURATE_CAST_SHORT(b1);
   }
 #undef SATURATE_CAST_SHORT
-  // loop body
-  int16_t* rowsbuf0 = new int16_t[w_out + 1];
-  int16_t* rowsbuf1 = new int16_t[w_out + 1];
-  int16_t* rows0 = rowsbuf0;
-  int16_t* rows1 = rowsbuf1;
-  int prev_sy1 = -1;
-  for (int dy = 0; dy < h_out; dy++) {
-    int sy = yofs[dy];
-    if (sy == prev_sy1) {
-      // hresize one row
-      int16_t* rows0_old = rows0;
-      rows0 = rows1;
-      rows1 = rows0_old;
-      const uint8_t* S1 = src + w_in * (sy + 1);
-      const int16_t* ialphap = ialpha;
-      int16_t* rows1p = rows1;
-      for (int dx = 0; dx < wout; dx++) {
-        int sx = xofs[dx];
-        int16_t a0 = ialphap[0];
-        int16_t a1 = ialphap[1];
-        const uint8_t* S1p = S1 + sx;
-        int tmp = dx * 4;
-        rows1p[tmp] = (S1p[0] * a0 + S1p[4] * a1) >> 4;
-        rows1p[tmp + 1] = (S1p[1] * a0 + S1p[5] * a1) >> 4;
-        rows1p[tmp + 2] = (S1p[2] * a0 + S1p[6] * a1) >> 4;
-        rows1p[tmp + 3] = (S1p[3] * a0 + S1p[7] * a1) >> 4;
-        ialphap += 2;
+  // The output rows are resized in tiles in parallel, each of which caches
+  // its own input rows.
+  const int tiles = (h_out + kTileRows - 1) / kTileRows;
+  LITE_PARALLEL_BEGIN(t, tid, tiles) {
+    std::vector<int16_t> rowsbuf0(w_out + 1);
+    std::vector<int16_t> rowsbuf1(w_out + 1);
+    int16_t* rows0 = rowsbuf0.data();
+    int16_t* rows1 = rowsbuf1.data();
+    int prev_sy1 = -1;
+    int dy_end = std::min((t + 1) * kTileRows, h_out);
+    for (int dy = t * kTileRows; dy < dy_end; dy++) {
+      int sy = yofs[dy];
+      if (sy == prev_sy1) {
+        // hresize one row
+        int16_t* rows0_old = rows0;
+        rows0 = rows1;
+        rows1 = rows0_old;
+        const uint8_t* S1 = src + w_in * (sy + 1);
+        const int16_t* ialphap = ialpha;
+        int16_t* rows1p = rows1;
+        for (int dx = 0; dx < wout; dx++) {
+          int sx = xofs[dx];
+          int16_t a0 = ialphap[0];
+          int16_t a1 = ialphap[1];
+          const uint8_t* S1p = S1 + sx;
+          int tmp = dx * 4;
+          rows1p[tmp] = (S1p[0] * a0 + S1p[4] * a1) >> 4;
+          rows1p[tmp + 1] = (S1p[1] * a0 + S1p[5] * a1) >> 4;
+          rows1p[tmp + 2] = (S1p[2] * a0 + S1p[6] * a1) >> 4;
+          rows1p[tmp + 3] = (S1p[3] * a0 + S1p[7] * a1) >> 4;
+          ialphap += 2;
+        }
+      } else {
+        // hresize two rows
+        const uint8_t* S0 = src + w_in * (sy);
+        const uint8_t* S1 = src + w_in * (sy + 1);
+        const int16_t* ialphap = ialpha;
+        int16_t* rows0p = rows0;
+        int16_t* rows1p = rows1;
+        for (int dx = 0; dx < wout; dx++) {
+          int sx = xofs[dx];
+          int16_t a0 = ialphap[0];
+          int16_t a1 = ialphap[1];
+          const uint8_t* S0p = S0 + sx;
+          const uint8_t* S1p = S1 + sx;
+          int tmp = dx * 4;
+          rows0p[tmp] = (S0p[0] * a0 + S0p[4] * a1) >> 4;
+          rows1p[tmp] = (S1p[0] * a0 + S1p[4] * a1) >> 4;
+          rows0p[tmp + 1] = (S0p[1] * a0 + S0p[5] * a1) >> 4;
+          rows1p[tmp + 1] = (S1p[1] * a0 + S1p[5] * a1) >> 4;
+          rows0p[tmp + 2] = (S0p[2] * a0 + S0p[6] * a1) >> 4;
+          rows1p[tmp + 2] = (S1p[2] * a0 + S1p[6] * a1) >> 4;
+          rows0p[tmp + 3] = (S0p[3] * a0 + S0p[7] * a1) >> 4;
+          rows1p[tmp + 3] = (S1p[3] * a0 + S1p[7] * a1) >> 4;
+          ialphap += 2;
+        }
       }
-    } else {
-      // hresize two rows
-      const uint8_t* S0 = src + w_in * (sy);
-      const uint8_t* S1 = src + w_in * (sy + 1);
-      const int16_t* ialphap = ialpha;
+      prev_sy1 = sy + 1;
+      // vresize
+      int16_t b0 = ibeta[dy * 2];
+      int16_t b1 = ibeta[dy * 2 + 1];
       int16_t* rows0p = rows0;
       int16_t* rows1p = rows1;
-      for (int dx = 0; dx < wout; dx++) {
-        int sx = xofs[dx];
-        int16_t a0 = ialphap[0];
-        int16_t a1 = ialphap[1];
-        const uint8_t* S0p = S0 + sx;
-        const uint8_t* S1p = S1 + sx;
-        int tmp = dx * 4;
-        rows0p[tmp] = (S0p[0] * a0 + S0p[4] * a1) >> 4;
-        rows1p[tmp] = (S1p[0] * a0 + S1p[4] * a1) >> 4;
-        rows0p[tmp + 1] = (S0p[1] * a0 + S0p[5] * a1) >> 4;
-        rows1p[tmp + 1] = (S1p[1] * a0 + S1p[5] * a1) >> 4;
-        rows0p[tmp + 2] = (S0p[2] * a0 + S0p[6] * a1) >> 4;
-        rows1p[tmp + 2] = (S1p[2] * a0 + S1p[6] * a1) >> 4;
-        rows0p[tmp + 3] = (S0p[3] * a0 + S0p[7] * a1) >> 4;
-        rows1p[tmp + 3] = (S1p[3] * a0 + S1p[7] * a1) >> 4;
-        ialphap += 2;
+      uint8_t* dp_ptr = dst + w_out * (dy);
+      int cnt = w_out >> 3;
+      int remain = w_out - (cnt << 3);
+      int16x4_t _b0 = vdup_n_s16(b0);
+      int16x4_t _b1 = vdup_n_s16(b1);
+      int32x4_t _v2 = vdupq_n_s32(2);
+      for (cnt = w_out >> 3; cnt > 0; cnt--) {
+        int16x4_t _rows0p_sr4 = vld1_s16(rows0p);
+        int16x4_t _rows1p_sr4 = vld1_s16(rows1p);
+        int16x4_t _rows0p_1_sr4 = vld1_s16(rows0p + 4);
+        int16x4_t _rows1p_1_sr4 = vld1_s16(rows1p + 4);
+        int32x4_t _rows0p_sr4_mb0 = vmull_s16(_rows0p_sr4, _b0);
+        int32x4_t _rows1p_sr4_mb1 = vmull_s16(_rows1p_sr4, _b1);
+        int32x4_t _rows0p_1_sr4_mb0 = vmull_s16(_rows0p_1_sr4, _b0);
+        int32x4_t _rows1p_1_sr4_mb1 = vmull_s16(_rows1p_1_sr4, _b1);
+        int32x4_t _acc = _v2;
+        // _acc >> 16 + _rows0p_sr4_mb0 >> 16
+        _acc = vsraq_n_s32(_acc, _rows0p_sr4_mb0, 16);
+        _acc = vsraq_n_s32(_acc, _rows1p_sr4_mb1, 16);
+        int32x4_t _acc_1 = _v2;
+        _acc_1 = vsraq_n_s32(_acc_1, _rows0p_1_sr4_mb0, 16);
+        _acc_1 = vsraq_n_s32(_acc_1, _rows1p_1_sr4_mb1, 16);
+        // _acc >> 2
+        int16x4_t _acc16 = vshrn_n_s32(_acc, 2);
+        int16x4_t _acc16_1 = vshrn_n_s32(_acc_1, 2);
+        uint8x8_t _dout = vqmovun_s16(vcombine_s16(_acc16, _acc16_1));
+        vst1_u8(dp_ptr, _dout);
+        dp_ptr += 8;
+        rows0p += 8;
+        rows1p += 8;
+      }
+      for (; remain; --remain) {
+        // D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS;
+        *dp_ptr++ =
+            (uint8_t)(((int16_t)((b0 * (int16_t)(*rows0p++)) >> 16) +
+                       (int16_t)((b1 * (int16_t)(*rows1p++)) >> 16) + 2) >>
+                      2);
       }
     }
-    prev_sy1 = sy + 1;
-    // vresize
-    int16_t b0 = ibeta[0];
-    int16_t b1 = ibeta[1];
-    int16_t* rows0p = rows0;
-    int16_t* rows1p = rows1;
-    uint8_t* dp_ptr = dst + w_out * (dy);
-    int cnt = w_out >> 3;
-    int remain = w_out - (cnt << 3);
-    int16x4_t _b0 = vdup_n_s16(b0);
-    int16x4_t _b1 = vdup_n_s16(b1);
-    int32x4_t _v2 = vdupq_n_s32(2);
-    for (cnt = w_out >> 3; cnt > 0; cnt--) {
-      int16x4_t _rows0p_sr4 = vld1_s16(rows0p);
-      int16x4_t _rows1p_sr4 = vld1_s16(rows1p);
-      int16x4_t _rows0p_1_sr4 = vld1_s16(rows0p + 4);
-      int16x4_t _rows1p_1_sr4 = vld1_s16(rows1p + 4);
-      int32x4_t _rows0p_sr4_mb0 = vmull_s16(_rows0p_sr4, _b0);
-      int32x4_t _rows1p_sr4_mb1 = vmull_s16(_rows1p_sr4, _b1);
-      int32x4_t _rows0p_1_sr4_mb0 = vmull_s16(_rows0p_1_sr4, _b0);
-      int32x4_t _rows1p_1_sr4_mb1 = vmull_s16(_rows1p_1_sr4, _b1);
-      int32x4_t _acc = _v2;
-      // _acc >> 16 + _rows0p_sr4_mb0 >> 16
-      _acc = vsraq_n_s32(_acc, _rows0p_sr4_mb0, 16);
-      _acc = vsraq_n_s32(_acc, _rows1p_sr4_mb1, 16);
-      int32x4_t _acc_1 = _v2;
-      _acc_1 = vsraq_n_s32(_acc_1, _rows0p_1_sr4_mb0, 16);
-      _acc_1 = vsraq_n_s32(_acc_1, _rows1p_1_sr4_mb1, 16);
-      // _acc >> 2
-      int16x4_t _acc16 = vshrn_n_s32(_acc, 2);
-      int16x4_t _acc16_1 = vshrn_n_s32(_acc_1, 2);
-      uint8x8_t _dout = vqmovun_s16(vcombine_s16(_acc16, _acc16_1));
-      vst1_u8(dp_ptr, _dout);
-      dp_ptr += 8;
-      rows0p += 8;
-      rows1p += 8;
-    }
-    for (; remain; --remain) {
-      // D[x] = (rows0[x]*b0 + rows1[x]*b1) >> INTER_RESIZE_COEF_BITS;
-      *dp_ptr++ =
-          (uint8_t)(((int16_t)((b0 * (int16_t)(*rows0p++)) >> 16) +
-                     (int16_t)((b1 * (int16_t)(*rows1p++)) >> 16) + 2) >>
-                    2);
-    }
-    ibeta += 2;
   }
+  LITE_PARALLEL_END();
   delete[] buf;
-  delete[] rowsbuf0;
-  delete[] rowsbuf1;
 }
 
 // use bilinear method to resize
@@ -0,0 +1,307 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/cv/paddle_image_pipeline.h"
+#include <arm_neon.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+
+namespace {
+// The output rows processed by a task, which share the cached input rows.
+const int kTileRows = 16;
+
+// The offsets and the weights of the right (bottom) pixels of the bilinear
+// resize of `src` pixels to `dst` ones, same as image_resize.
+void BilinearMap(int src,
+                 int dst,
+                 std::vector<int>* ofs,
+                 std::vector<float>* alpha) {
+  ofs->resize(dst);
+  alpha->resize(dst);
+  double scale = static_cast<double>(src) / dst;
+  for (int d = 0; d < dst; d++) {
+    float f = static_cast<float>((d + 0.5) * scale - 0.5);
+    int s = floor(f);
+    f -= s;
+    if (s < 0) {
+      s = 0;
+      f = 0.f;
+    }
+    if (s >= src - 1) {
+      s = std::max(src - 2, 0);
+      f = src > 1 ? 1.f : 0.f;
+    }
+    (*ofs)[d] = s;
+    (*alpha)[d] = f;
+  }
+}
+
+inline int Clamp255(int x) { return std::min(std::max(x, 0), 255); }
+
+// (row - mean) * scale of dstw pixels.
+void NormalizeRow(float* row, int dstw, float mean, float scale) {
+  float32x4_t vmean = vdupq_n_f32(mean);
+  float32x4_t vscale = vdupq_n_f32(scale);
+  int x = 0;
+  for (; x + 3 < dstw; x += 4) {
+    float32x4_t v = vld1q_f32(row + x);
+    vst1q_f32(row + x, vmulq_f32(vsubq_f32(v, vmean), vscale));
+  }
+  for (; x < dstw; x++) {
+    row[x] = (row[x] - mean) * scale;
+  }
+}
+
+// out = top + (bottom - top) * alpha of dstw pixels.
+void BlendRows(const float* top,
+               const float* bottom,
+               float alpha,
+               float* out,
+               int dstw) {
+  float32x4_t valpha = vdupq_n_f32(alpha);
+  int x = 0;
+  for (; x + 3 < dstw; x += 4) {
+    float32x4_t vt = vld1q_f32(top + x);
+    float32x4_t vb = vld1q_f32(bottom + x);
+    vst1q_f32(out + x, vmlaq_f32(vt, vsubq_f32(vb, vt), valpha));
+  }
+  for (; x < dstw; x++) {
+    out[x] = top[x] + (bottom[x] - top[x]) * alpha;
+  }
+}
+}  // namespace
+
+__attribute__((visibility("default")))
+ImagePipeline::ImagePipeline(const PipelineParam& param)
+    : param_(param) {
+  if (param_.crop_w <= 0 || param_.crop_h <= 0) {
+    param_.crop_x = 0;
+    param_.crop_y = 0;
+    param_.crop_w = param_.srcw;
+    param_.crop_h = param_.srch;
+  }
+  bool src_supported = param_.srcFormat == NV21 ||
+                       param_.srcFormat == NV12 || param_.srcFormat == BGR ||
+                       param_.srcFormat == RGB || param_.srcFormat == BGRA ||
+                       param_.srcFormat == RGBA || param_.srcFormat == GRAY;
+  bool dst_supported = param_.dstFormat == BGR || param_.dstFormat == RGB ||
+                       param_.dstFormat == GRAY;
+  if (!src_supported || !dst_supported) {
+    printf("srcFormat: %d, dstFormat: %d is not supported! \n",
+           param_.srcFormat,
+           param_.dstFormat);
+    return;
+  }
+  if (param_.layout != LayoutType::kNCHW &&
+      param_.layout != LayoutType::kNHWC) {
+    printf("layout: %d is not supported! \n",
+           static_cast<int>(param_.layout));
+    return;
+  }
+  if (param_.crop_x < 0 || param_.crop_y < 0 ||
+      param_.crop_x + param_.crop_w > param_.srcw ||
+      param_.crop_y + param_.crop_h > param_.srch || param_.dstw <= 0 ||
+      param_.dsth <= 0) {
+    printf(
+        "crop: (%d, %d, %d, %d) of image: %dx%d or dst: %dx%d is invalid! \n",
+           param_.crop_x,
+           param_.crop_y,
+           param_.crop_w,
+           param_.crop_h,
+           param_.srcw,
+           param_.srch,
+           param_.dstw,
+           param_.dsth);
+    return;
+  }
+#ifndef ENABLE_ARM_FP16
+  if (param_.fp16) {
+    printf("fp16 output needs the build with arm fp16! \n");
+    return;
+  }
+#endif
+  channels_ = param_.dstFormat == GRAY ? 1 : 3;
+  BilinearMap(param_.crop_w, param_.dstw, &xofs_, &xalpha_);
+  BilinearMap(param_.crop_h, param_.dsth, &yofs_, &yalpha_);
+  valid_ = true;
+}
+
+void ImagePipeline::ResizeRow(const uint8_t* src, int sy, float* row) const {
+  const int srcw = param_.srcw;
+  const int dstw = param_.dstw;
+  const int crop_w = param_.crop_w;
+  const ImageFormat fmt = param_.srcFormat;
+  const bool to_rgb = param_.dstFormat == RGB;
+  const bool to_gray = param_.dstFormat == GRAY;
+  float* row0 = row;
+  float* row1 = row + dstw;
+  float* row2 = row + 2 * dstw;
+  sy += param_.crop_y;
+  const uint8_t* line = nullptr;
+  const uint8_t* uv_line = nullptr;
+  int bytes = 1;
+  if (fmt == NV21 || fmt == NV12) {
+    line = src + sy * srcw;
+    uv_line = src + srcw * param_.srch + (sy / 2) * srcw;
+  } else {
+    bytes = fmt == GRAY ? 1 : (fmt == BGR || fmt == RGB ? 3 : 4);
+    line = src + sy * srcw * bytes;
+  }
+  // The bgr of the input pixel `sx` of the crop.
+  auto Pixel = [&](int sx, int* b, int* g, int* r) {
+    sx += param_.crop_x;
+    if (uv_line) {
+      int y = line[sx];
+      const uint8_t* uv = uv_line + (sx & ~1);
+      int v = (fmt == NV21 ? uv[0] : uv[1]) - 128;
+      int u = (fmt == NV21 ? uv[1] : uv[0]) - 128;
+      // Same fixed point as nv21_to_bgr.
+      *r = Clamp255(y + ((179 * v) >> 7));
+      *g = Clamp255(y - ((44 * u + 91 * v) >> 7));
+      *b = Clamp255(y + ((227 * u) >> 7));
+    } else if (bytes == 1) {
+      *b = *g = *r = line[sx];
+    } else {
+      const uint8_t* p = line + sx * bytes;
+      bool rgb = fmt == RGB || fmt == RGBA;
+      *b = p[rgb ? 2 : 0];
+      *g = p[1];
+      *r = p[rgb ? 0 : 2];
+    }
+  };
+  for (int dx = 0; dx < dstw; dx++) {
+    int sx = xofs_[dx];
+    float a = xalpha_[dx];
+    int b0, g0, r0, b1, g1, r1;
+    Pixel(sx, &b0, &g0, &r0);
+    Pixel(std::min(sx + 1, crop_w - 1), &b1, &g1, &r1);
+    float b = b0 + (b1 - b0) * a;
+    float g = g0 + (g1 - g0) * a;
+    float r = r0 + (r1 - r0) * a;
+    if (to_gray) {
+      row0[dx] = 0.299f * r + 0.587f * g + 0.114f * b;
+    } else {
+      row0[dx] = to_rgb ? r : b;
+      row1[dx] = g;
+      row2[dx] = to_rgb ? b : r;
+    }
+  }
+}
+
+__attribute__((visibility("default"))) void ImagePipeline::Run(
+    const uint8_t* src, Tensor* dstTensor) const {
+  if (!valid_) return;
+  const int dstw = param_.dstw;
+  const int dsth = param_.dsth;
+  const int channels = channels_;
+  const bool nchw = param_.layout == LayoutType::kNCHW;
+  if (nchw) {
+    dstTensor->Resize({1, channels, dsth, dstw});
+  } else {
+    dstTensor->Resize({1, dsth, dstw, channels});
+  }
+  float* output = nullptr;
+#ifdef ENABLE_ARM_FP16
+  __fp16* output_fp16 = nullptr;
+  if (param_.fp16) {
+    output_fp16 = dstTensor->mutable_data<__fp16>();
+  } else {
+    output = dstTensor->mutable_data<float>();
+  }
+#else
+  output = dstTensor->mutable_data<float>();
+#endif
+  const int row_size = channels * dstw;
+  const int tiles = (dsth + kTileRows - 1) / kTileRows;
+  LITE_PARALLEL_BEGIN(t, tid, tiles) {
+    // Two cached input rows resized horizontally, and the output row, each
+    // of the planar channels.
+    std::vector<float> buffer(3 * row_size);
+    float* rows[2] = {buffer.data(), buffer.data() + row_size};
+    int row_ids[2] = {-1, -1};
+    float* out = buffer.data() + 2 * row_size;
+    auto Row = [&](int sy) -> const float* {
+      for (int k = 0; k < 2; k++) {
+        if (row_ids[k] == sy) return rows[k];
+      }
+      // Replace the row not used by the current output row.
+      int k = row_ids[0] < row_ids[1] ? 0 : 1;
+      ResizeRow(src, sy, rows[k]);
+      row_ids[k] = sy;
+      return rows[k];
+    };
+    int dy_end = std::min((t + 1) * kTileRows, dsth);
+    for (int dy = t * kTileRows; dy < dy_end; dy++) {
+      int sy = yofs_[dy];
+      const float* top = Row(sy);
+      const float* bottom = Row(std::min(sy + 1, param_.crop_h - 1));
+      for (int c = 0; c < channels; c++) {
+        float* out_c = out + c * dstw;
+        BlendRows(top + c * dstw, bottom + c * dstw, yalpha_[dy], out_c, dstw);
+        NormalizeRow(out_c, dstw, param_.means[c], param_.scales[c]);
+      }
+#ifdef ENABLE_ARM_FP16
+      if (output_fp16) {
+        for (int c = 0; c < channels; c++) {
+          const float* out_c = out + c * dstw;
+          for (int x = 0; x < dstw; x++) {
+            int index = nchw ? (c * dsth + dy) * dstw + x
+                             : (dy * dstw + x) * channels + c;
+            output_fp16[index] = static_cast<__fp16>(out_c[x]);
+          }
+        }
+        continue;
+      }
+#endif
+      if (nchw) {
+        for (int c = 0; c < channels; c++) {
+          memcpy(output + (c * dsth + dy) * dstw,
+                 out + c * dstw,
+                 sizeof(float) * dstw);
+        }
+      } else if (channels == 1) {
+        memcpy(output + dy * dstw, out, sizeof(float) * dstw);
+      } else {
+        float* dst = output + dy * dstw * 3;
+        int x = 0;
+        for (; x + 3 < dstw; x += 4) {
+          float32x4x3_t v;
+          v.val[0] = vld1q_f32(out + x);
+          v.val[1] = vld1q_f32(out + dstw + x);
+          v.val[2] = vld1q_f32(out + 2 * dstw + x);
+          vst3q_f32(dst + x * 3, v);
+        }
+        for (; x < dstw; x++) {
+          dst[x * 3] = out[x];
+          dst[x * 3 + 1] = out[dstw + x];
+          dst[x * 3 + 2] = out[2 * dstw + x];
+        }
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
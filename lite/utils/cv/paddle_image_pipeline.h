@@ -0,0 +1,83 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "lite/utils/cv/paddle_image_preprocess.h"
+
+namespace paddle {
+namespace lite {
+namespace utils {
+namespace cv {
+
+typedef struct {
+  ImageFormat srcFormat;  // NV21, NV12, BGR(RGB), BGRA(RGBA) or GRAY
+  ImageFormat dstFormat;  // channel order of the tensor: BGR, RGB or GRAY
+  int srcw;               // input image width
+  int srch;               // input image height
+  int crop_x;             // left of the crop of the input image
+  int crop_y;             // top of the crop of the input image
+  int crop_w;             // crop width, the whole image if <= 0
+  int crop_h;             // crop height, the whole image if <= 0
+  int dstw;               // output width, the crop is resized to
+  int dsth;               // output height, the crop is resized to
+  LayoutType layout;      // kNCHW or kNHWC
+  bool fp16;              // output fp16 instead of float, needs arm fp16
+  float means[3];         // means of the channels of dstFormat
+  float scales[3];        // scales of the channels of dstFormat
+} PipelineParam;
+
+/*
+ * The fused preprocessing of convert -> crop -> bilinear resize ->
+ * normalize -> image_to_tensor in one pass over the output without the
+ * intermediate images. Each output row converts and resizes only the two
+ * input rows and the columns it samples, and the rows are processed in tiles
+ * in parallel, so the cost scales with the output size instead of the input,
+ * e.g. a 1080p camera frame to a 224x224 tensor.
+ * The tensor is (pixel - mean) * scale of the channels, same as
+ * image_to_tensor, but interpolated in float instead of the fixed point of
+ * image_resize, so it may differ from the separate passes by 1 in pixel.
+ */
+class ImagePipeline {
+ public:
+  // Prepare the maps of the resize, print the error if `param` is not
+  // supported and Run() does nothing then.
+  explicit ImagePipeline(const PipelineParam& param);
+  bool valid() const { return valid_; }
+
+  /*
+  * param src: input image data
+  * param dstTensor: output tensor, resized to 1xCxHxW or 1xHxWxC
+  */
+  void Run(const uint8_t* src, Tensor* dstTensor) const;
+
+ private:
+  // Convert and horizontally resize the input row `sy` into `row` of the
+  // dst channels, each of dstw.
+  void ResizeRow(const uint8_t* src, int sy, float* row) const;
+
+  PipelineParam param_;
+  bool valid_{false};
+  int channels_{3};
+  std::vector<int> xofs_;
+  std::vector<float> xalpha_;
+  std::vector<int> yofs_;
+  std::vector<float> yalpha_;
+};
+
+}  // namespace cv
+}  // namespace utils
+}  // namespace lite
+}  // namespace paddle
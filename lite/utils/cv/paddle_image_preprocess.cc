@@ -17,6 +17,10 @@
 #include <string.h>
 #include <algorithm>
 #include <climits>
+#ifdef ARM_WITH_OMP
+#include <omp.h>
+#endif
+#include "lite/core/parallel_defines.h"
 #include "lite/utils/cv/image2tensor.h"
 #include "lite/utils/cv/image_convert.h"
 #include "lite/utils/cv/image_flip.h"
@@ -34,6 +38,14 @@ namespace cv {
 #define Degrees2Radians(degrees) ((degrees) * (SK_ScalarPI / 180))
 #define Radians2Degrees(radians) ((radians) * (180 / SK_ScalarPI))
 #define ScalarNearlyZero (1.0f / (1 << 12))
+// Run the parallel regions of the processing on the thread pool set by
+// set_threads(), or the one of the calling thread if not set.
+#ifdef LITE_USE_THREAD_POOL
+#define USE_THREAD_POOL(pool) \
+  ThreadPoolGuard thread_pool_guard(pool ? pool.get() : ThreadPool::Current())
+#else
+#define USE_THREAD_POOL(pool)
+#endif
 // init
 __attribute__((visibility("default")))
 ImagePreprocess::ImagePreprocess(ImageFormat srcFormat,
@@ -43,8 +55,18 @@ ImagePreprocess::ImagePreprocess(ImageFormat srcFormat,
   this->dstFormat_ = dstFormat;
   this->transParam_ = param;
 }
+
+__attribute__((visibility("default"))) void ImagePreprocess::set_threads(
+    int threads) {
+#ifdef LITE_USE_THREAD_POOL
+  thread_pool_ = ThreadPool::Create(threads);
+#elif defined(ARM_WITH_OMP)
+  omp_set_num_threads(threads);
+#endif
+}
 __attribute__((visibility("default"))) void ImagePreprocess::image_convert(
     const uint8_t* src, uint8_t* dst) {
+  USE_THREAD_POOL(thread_pool_);
   ImageConvert img_convert;
   img_convert.choose(src,
                      dst,
@@ -59,6 +81,7 @@ __attribute__((visibility("default"))) void ImagePreprocess::image_convert(
     uint8_t* dst,
     ImageFormat srcFormat,
     ImageFormat dstFormat) {
+  USE_THREAD_POOL(thread_pool_);
   ImageConvert img_convert;
   img_convert.choose(src,
                      dst,
@@ -75,6 +98,7 @@ __attribute__((visibility("default"))) void ImagePreprocess::image_convert(
     ImageFormat dstFormat,
     int srcw,
     int srch) {
+  USE_THREAD_POOL(thread_pool_);
   ImageConvert img_convert;
   img_convert.choose(src, dst, srcFormat, dstFormat, srcw, srch);
 }
@@ -87,12 +111,14 @@ __attribute__((visibility("default"))) void ImagePreprocess::image_resize(
     int srch,
     int dstw,
     int dsth) {
+  USE_THREAD_POOL(thread_pool_);
   ImageResize img_resize;
   img_resize.choose(src, dst, srcFormat, srcw, srch, dstw, dsth);
 }
 
 __attribute__((visibility("default"))) void ImagePreprocess::image_resize(
     const uint8_t* src, uint8_t* dst) {
+  USE_THREAD_POOL(thread_pool_);
   int srcw = this->transParam_.iw;
   int srch = this->transParam_.ih;
   int dstw = this->transParam_.ow;
@@ -109,12 +135,14 @@ __attribute__((visibility("default"))) void ImagePreprocess::image_rotate(
     int srcw,
     int srch,
     float degree) {
+  USE_THREAD_POOL(thread_pool_);
   ImageRotate img_rotate;
   img_rotate.choose(src, dst, srcFormat, srcw, srch, degree);
 }
 
 __attribute__((visibility("default"))) void ImagePreprocess::image_rotate(
     const uint8_t* src, uint8_t* dst) {
+  USE_THREAD_POOL(thread_pool_);
   auto srcw = this->transParam_.ow;
   auto srch = this->transParam_.oh;
   auto srcFormat = this->dstFormat_;
@@ -130,12 +158,14 @@ __attribute__((visibility("default"))) void ImagePreprocess::image_flip(
     int srcw,
     int srch,
     FlipParam flip_param) {
+  USE_THREAD_POOL(thread_pool_);
   ImageFlip img_flip;
   img_flip.choose(src, dst, srcFormat, srcw, srch, flip_param);
 }
 
 __attribute__((visibility("default"))) void ImagePreprocess::image_flip(
     const uint8_t* src, uint8_t* dst) {
+  USE_THREAD_POOL(thread_pool_);
   auto srcw = this->transParam_.ow;
   auto srch = this->transParam_.oh;
   auto srcFormat = this->dstFormat_;
@@ -153,6 +183,7 @@ __attribute__((visibility("default"))) void ImagePreprocess::image_to_tensor(
     LayoutType layout,
     float* means,
     float* scales) {
+  USE_THREAD_POOL(thread_pool_);
 #ifdef LITE_WITH_FPGA
   if (this->transParam_.ih > 1080) {
     printf("input image height(%d > 1080) is not supported! \n",
@@ -184,6 +215,7 @@ __attribute__((visibility("default"))) void ImagePreprocess::image_to_tensor(
     LayoutType layout,
     float* means,
     float* scales) {
+  USE_THREAD_POOL(thread_pool_);
 #ifdef LITE_WITH_FPGA
   if (this->transParam_.ih > 1080) {
     printf("input image height(%d > 1080) is not supported! \n",
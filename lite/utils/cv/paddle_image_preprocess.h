@@ -16,12 +16,14 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <memory>
 #include <vector>
 #include "lite/api/paddle_api.h"
 #include "lite/api/paddle_place.h"
 
 namespace paddle {
 namespace lite {
+class ThreadPool;
 namespace utils {
 namespace cv {
 typedef paddle::lite_api::Tensor Tensor;
@@ -67,6 +69,14 @@ class ImagePreprocess {
   ImagePreprocess(ImageFormat srcFormat,
                   ImageFormat dstFormat,
                   TransParam param);
+  /*
+  * run the processing on `threads` threads, e.g. the threads of the
+  * predictor config, by a thread pool owned by this object, so the large
+  * images are split into rows and processed in parallel. The processing runs
+  * on the threads of the calling thread by default.
+  * param threads: the number of threads
+  */
+  void set_threads(int threads);
 
   /*
   * image color convert
@@ -267,6 +277,7 @@ class ImagePreprocess {
   ImageFormat srcFormat_;
   ImageFormat dstFormat_;
   TransParam transParam_;
+  std::shared_ptr<ThreadPool> thread_pool_;
 };
 }  // namespace cv
 }  // namespace utils
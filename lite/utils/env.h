@@ -35,6 +35,11 @@
 // target device model online during the execution phase.
 #define SUBGRAPH_ONLINE_MODE "SUBGRAPH_ONLINE_MODE"
 
+// The device programs built for the different input shapes are kept by the
+// subgraph engine, and the least recently used one is released once there are
+// more than 'SUBGRAPH_DEVICE_PROGRAM_CACHE_SIZE'(default 8).
+#define SUBGRAPH_DEVICE_PROGRAM_CACHE_SIZE "SUBGRAPH_DEVICE_PROGRAM_CACHE_SIZE"
+
 // The environment variables for the quant model settings, use "QUANT_" as
 // prefix.
 // Apply the constraints for the quantized ops(such as concat) that the inputs
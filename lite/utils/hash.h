@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #pragma once
+#include <cstdint>
+#include <cstring>
 #include <functional>
 
 namespace paddle {
@@ -25,5 +27,23 @@ inline void CombineHash(const T& from, size_t* to) {
   *to ^= h(from) + 0x9e3779b9 + (*to << 6) + (*to >> 2);
 }
 
+// A fast 64-bit fingerprint of the bytes, e.g. the data of the weights, which
+// is derived from FNV-1a but mixes a word at a time.
+inline uint64_t HashBytes(const void* data, size_t size) {
+  const char* bytes = static_cast<const char*>(data);
+  uint64_t hash = 0xcbf29ce484222325ULL ^ size;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytes + i, sizeof(word));
+    hash = (hash ^ word) * 0x100000001b3ULL;
+    hash ^= hash >> 29;
+  }
+  for (; i < size; i++) {
+    hash = (hash ^ static_cast<uint8_t>(bytes[i])) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
 }  // namespace lite
 }  // namespace paddle
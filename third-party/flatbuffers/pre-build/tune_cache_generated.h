@@ -154,13 +154,16 @@ flatbuffers::Offset<TunePair> CreateTunePair(flatbuffers::FlatBufferBuilder &_fb
 struct TuneCacheT : public flatbuffers::NativeTable {
   typedef TuneCache TableType;
   std::vector<std::unique_ptr<paddle::lite::fbs::opencl::proto::TuneCache_::TunePairT>> tune_map;
-  TuneCacheT() {
+  uint32_t version;
+  TuneCacheT()
+      : version(0) {
   }
 };
 
 inline bool operator==(const TuneCacheT &lhs, const TuneCacheT &rhs) {
   return
-      (lhs.tune_map == rhs.tune_map);
+      (lhs.tune_map == rhs.tune_map) &&
+      (lhs.version == rhs.version);
 }
 
 inline bool operator!=(const TuneCacheT &lhs, const TuneCacheT &rhs) {
@@ -175,7 +178,8 @@ struct TuneCache FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     return TuneCacheTypeTable();
   }
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
-    VT_TUNE_MAP = 4
+    VT_TUNE_MAP = 4,
+    VT_VERSION = 6
   };
   const flatbuffers::Vector<flatbuffers::Offset<paddle::lite::fbs::opencl::proto::TuneCache_::TunePair>> *tune_map() const {
     return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<paddle::lite::fbs::opencl::proto::TuneCache_::TunePair>> *>(VT_TUNE_MAP);
@@ -183,11 +187,18 @@ struct TuneCache FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   flatbuffers::Vector<flatbuffers::Offset<paddle::lite::fbs::opencl::proto::TuneCache_::TunePair>> *mutable_tune_map() {
     return GetPointer<flatbuffers::Vector<flatbuffers::Offset<paddle::lite::fbs::opencl::proto::TuneCache_::TunePair>> *>(VT_TUNE_MAP);
   }
+  uint32_t version() const {
+    return GetField<uint32_t>(VT_VERSION, 0);
+  }
+  bool mutate_version(uint32_t _version) {
+    return SetField<uint32_t>(VT_VERSION, _version, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffsetRequired(verifier, VT_TUNE_MAP) &&
            verifier.VerifyVector(tune_map()) &&
            verifier.VerifyVectorOfTables(tune_map()) &&
+           VerifyField<uint32_t>(verifier, VT_VERSION) &&
            verifier.EndTable();
   }
   TuneCacheT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
@@ -202,6 +213,9 @@ struct TuneCacheBuilder {
   void add_tune_map(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<paddle::lite::fbs::opencl::proto::TuneCache_::TunePair>>> tune_map) {
     fbb_.AddOffset(TuneCache::VT_TUNE_MAP, tune_map);
   }
+  void add_version(uint32_t version) {
+    fbb_.AddElement<uint32_t>(TuneCache::VT_VERSION, version, 0);
+  }
   explicit TuneCacheBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -217,19 +231,23 @@ struct TuneCacheBuilder {
 
 inline flatbuffers::Offset<TuneCache> CreateTuneCache(
     flatbuffers::FlatBufferBuilder &_fbb,
-    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<paddle::lite::fbs::opencl::proto::TuneCache_::TunePair>>> tune_map = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<paddle::lite::fbs::opencl::proto::TuneCache_::TunePair>>> tune_map = 0,
+    uint32_t version = 0) {
   TuneCacheBuilder builder_(_fbb);
+  builder_.add_version(version);
   builder_.add_tune_map(tune_map);
   return builder_.Finish();
 }
 
 inline flatbuffers::Offset<TuneCache> CreateTuneCacheDirect(
     flatbuffers::FlatBufferBuilder &_fbb,
-    std::vector<flatbuffers::Offset<paddle::lite::fbs::opencl::proto::TuneCache_::TunePair>> *tune_map = nullptr) {
+    std::vector<flatbuffers::Offset<paddle::lite::fbs::opencl::proto::TuneCache_::TunePair>> *tune_map = nullptr,
+    uint32_t version = 0) {
   auto tune_map__ = tune_map ? _fbb.CreateVectorOfSortedTables<paddle::lite::fbs::opencl::proto::TuneCache_::TunePair>(tune_map) : 0;
   return paddle::lite::fbs::opencl::proto::CreateTuneCache(
       _fbb,
-      tune_map__);
+      tune_map__,
+      version);
 }
 
 flatbuffers::Offset<TuneCache> CreateTuneCache(flatbuffers::FlatBufferBuilder &_fbb, const TuneCacheT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
@@ -277,6 +295,7 @@ inline void TuneCache::UnPackTo(TuneCacheT *_o, const flatbuffers::resolver_func
   (void)_o;
   (void)_resolver;
   { auto _e = tune_map(); if (_e) { _o->tune_map.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->tune_map[_i] = std::unique_ptr<paddle::lite::fbs::opencl::proto::TuneCache_::TunePairT>(_e->Get(_i)->UnPack(_resolver)); } } }
+  { auto _e = version(); _o->version = _e; }
 }
 
 inline flatbuffers::Offset<TuneCache> TuneCache::Pack(flatbuffers::FlatBufferBuilder &_fbb, const TuneCacheT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -288,9 +307,11 @@ inline flatbuffers::Offset<TuneCache> CreateTuneCache(flatbuffers::FlatBufferBui
   (void)_o;
   struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const TuneCacheT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
   auto _tune_map = _fbb.CreateVector<flatbuffers::Offset<paddle::lite::fbs::opencl::proto::TuneCache_::TunePair>> (_o->tune_map.size(), [](size_t i, _VectorArgs *__va) { return CreateTunePair(*__va->__fbb, __va->__o->tune_map[i].get(), __va->__rehasher); }, &_va );
+  auto _version = _o->version;
   return paddle::lite::fbs::opencl::proto::CreateTuneCache(
       _fbb,
-      _tune_map);
+      _tune_map,
+      _version);
 }
 
 namespace TuneCache_ {
@@ -314,16 +335,18 @@ inline const flatbuffers::TypeTable *TunePairTypeTable() {
 
 inline const flatbuffers::TypeTable *TuneCacheTypeTable() {
   static const flatbuffers::TypeCode type_codes[] = {
-    { flatbuffers::ET_SEQUENCE, 1, 0 }
+    { flatbuffers::ET_SEQUENCE, 1, 0 },
+    { flatbuffers::ET_UINT, 0, -1 }
   };
   static const flatbuffers::TypeFunction type_refs[] = {
     paddle::lite::fbs::opencl::proto::TuneCache_::TunePairTypeTable
   };
   static const char * const names[] = {
-    "tune_map"
+    "tune_map",
+    "version"
   };
   static const flatbuffers::TypeTable tt = {
-    flatbuffers::ST_TABLE, 1, type_codes, type_refs, nullptr, names
+    flatbuffers::ST_TABLE, 2, type_codes, type_refs, nullptr, names
   };
   return &tt;
 }